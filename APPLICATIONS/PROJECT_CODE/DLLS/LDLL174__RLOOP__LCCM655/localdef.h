@@ -131,6 +131,17 @@ RLOOP - PI COMMUNICATIONS MODULE
 		/** enable the receiver side? */
 		#define C_LOCALDEF__LCCM656__ENABLE_RX								(1U)
 
+		/** Transmit queue depth, one frame on the wire, one being built and
+		 * the rest waiting. 2 to 8 */
+		#define C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH						(3U)
+
+		/** Queue overrun, 1 = drop the oldest waiting frame, 0 = drop the new frame */
+		#define C_LOCALDEF__LCCM656__TX_DROP_OLDEST						(1U)
+
+		/** Largest frame the node builds with every payload byte escaped, the
+		 * size of each queue buffer, a multiple of 4, the FCU telemetry template is about 260 */
+		#define C_LOCALDEF__LCCM656__TX_FRAME_SIZE						(320U)
+
 		/** Testing Options */
 		#define C_LOCALDEF__LCCM656__ENABLE_TEST_SPEC						(0U)
 
@@ -138,6 +149,157 @@ RLOOP - PI COMMUNICATIONS MODULE
 		#include <LCCM656__RLOOP__PI_COMMS/pi_comms.h>
 	#endif //#if C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE == 1U
 
+/*******************************************************************************
+RLOOP - LINKED FAULT TREES
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE == 1U
+
+		/** Journal of flag sets, streamed to ground over SafeUDP */
+		#define C_LOCALDEF__LCCM671__ENABLE_JOURNAL							(1U)
+		#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+
+			/** Number of entries kept, the oldest is overwritten */
+			#define C_LOCALDEF__LCCM671__JOURNAL_SIZE						(32U)
+
+			/** No RTI on the host */
+			#define M_LOCALDEF__LCCM671__GET_TIMESTAMP()					(0U)
+
+		#endif
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM671__ENABLE_TEST_SPEC						(1U)
+
+		/** Main include file */
+		#include <LCCM671__RLOOP__FAULT_LINK/fault_link.h>
+	#endif //#if C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE == 1U
+
+/*******************************************************************************
+RLOOP - PARAMETER SHADOW
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+
+		/** Number of parameter words kept in RAM, same as LCCM188 */
+		#define C_LOCALDEF__LCCM672__NUM_PARAMETERS							(128U)
+
+		/** Parameters per block, the unit that is marked stale and CRC'd */
+		#define C_LOCALDEF__LCCM672__BLOCK_SIZE								(16U)
+
+		/** Process passes with no new writes before a commit starts */
+		#define C_LOCALDEF__LCCM672__HOLDOFF								(100U)
+
+		/** If neither copy is good, load the image from LCCM188 */
+		#define C_LOCALDEF__LCCM672__ENABLE_MIGRATION						(1U)
+
+		/** Copies are simulated in RAM */
+		#define M_LOCALDEF__LCCM672__READ(copy,offset,pu32,count)			vPARAMSHADOW_WIN32__Read((Luint8)(copy), (Luint16)(offset), (pu32), (Luint16)(count))
+		#define M_LOCALDEF__LCCM672__WRITE(copy,offset,pu32,count)			vPARAMSHADOW_WIN32__Write((Luint8)(copy), (Luint16)(offset), (pu32), (Luint16)(count))
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM672__ENABLE_TEST_SPEC						(1U)
+
+		/** Main include file */
+		#include <LCCM672__RLOOP__PARAM_SHADOW/param_shadow.h>
+	#endif //#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+
+/*******************************************************************************
+RLOOP - STEP S-CURVE PLANNER
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+
+		/** Number of axes moved together */
+		#define C_LOCALDEF__LCCM673__NUM_AXES								(2U)
+
+		/** Simulated timebase, 20kHz */
+		#define C_LOCALDEF__LCCM673__TICK_PERIOD_S							(0.000050F)
+
+		/** Step table entries per plan */
+		#define C_LOCALDEF__LCCM673__TABLE_SIZE								(1024U)
+
+		/** Steps ahead of the ISR that a replan joins the running plan */
+		#define C_LOCALDEF__LCCM673__REPLAN_LEAD							(8U)
+
+		/** Fixed scale, 200 step motor at 10 microsteps on a 10mm lead screw */
+		#define M_LOCALDEF__LCCM673__STEPS_PER_REV(axis)					(2000U)
+		#define M_LOCALDEF__LCCM673__MICRONS_PER_REV(axis)					(10000)
+
+		/** No pins on the host, the position is all we keep */
+		#define M_LOCALDEF__LCCM673__PULSE(axis,level)						{(void)(axis); (void)(level);}
+		#define M_LOCALDEF__LCCM673__DIRECTION(axis,dir)					{(void)(axis); (void)(dir);}
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM673__ENABLE_TEST_SPEC						(1U)
+
+		/** Main include file */
+		#include <LCCM673__RLOOP__STEP_SCURVE/step_scurve.h>
+	#endif //#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+
+/*******************************************************************************
+RLOOP - IEEE1588 POD TIME
+*******************************************************************************/
+	//no timestamping PHY in the sim, TS_000 needs the loopback build
+	#define C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE							(0U)
+
+/*******************************************************************************
+RLOOP - ETHERNET TX CLASSES
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+
+		/** Requests each class can hold */
+		#define C_LOCALDEF__LCCM675__CLASS_DEPTH							(8U)
+
+		/** Most packets sent each process call */
+		#define C_LOCALDEF__LCCM675__MAX_PER_PROCESS						(4U)
+
+		//the scheduler runs against the sim clock and wire in LCCM675R0_TS_000
+		#define C_LOCALDEF__LCCM675__TICKS_PER_MS							(C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC / 1000U)
+		#define M_LOCALDEF__LCCM675__TICKS()								u32LCCM675R0_TS_000__Ticks()
+		#define M_LOCALDEF__LCCM675__LOWER_READY()							u8LCCM675R0_TS_000__Lower_Ready()
+		#define M_LOCALDEF__LCCM675__SEND(request,param)					s16LCCM675R0_TS_000__Send(request, param)
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM675__ENABLE_TEST_SPEC						(1U)
+
+		/** Main include file */
+		#include <LCCM675__RLOOP__TX_CLASS/tx_class.h>
+	#endif //#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+
+/*******************************************************************************
+RLOOP - ZERO COPY EMAC RINGS
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE == 1U
+
+		/** Pool buffers shared with the stack, more than the Rx descriptors */
+		#define C_LOCALDEF__LCCM676__POOL_BUFFERS							(20U)
+		#define C_LOCALDEF__LCCM676__TX_DESCRIPTORS							(32U)
+		#define C_LOCALDEF__LCCM676__RX_DESCRIPTORS							(8U)
+
+		//the rings run against the software EMAC in LCCM676R0_TS_000
+		#define C_LOCALDEF__LCCM676__DESC_BASE								(u32EMACZC_MOCK__Get_CPPI())
+		#define M_LOCALDEF__LCCM676__TX_HDP(addx)							vEMACZC_MOCK__Write_TxHDP(addx)
+		#define M_LOCALDEF__LCCM676__TX_CP(addx)							vEMACZC_MOCK__Write_TxCP(addx)
+		#define M_LOCALDEF__LCCM676__RX_HDP(addx)							vEMACZC_MOCK__Write_RxHDP(addx)
+		#define M_LOCALDEF__LCCM676__RX_CP(addx)							vEMACZC_MOCK__Write_RxCP(addx)
+		#define M_LOCALDEF__LCCM676__RX_PACKET(buffer,length,index)			vLCCM676R0_TS_000__Rx(buffer, length, index)
+
+		/** No interrupts in the sim */
+		#define M_LOCALDEF__LCCM676__LOCK()
+		#define M_LOCALDEF__LCCM676__UNLOCK()
+
+		/** Software EMAC for host runs */
+		#define C_LOCALDEF__LCCM676__ENABLE_MOCK							(1U)
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM676__ENABLE_TEST_SPEC						(1U)
+
+		/** Main include file */
+		#include <LCCM676__RLOOP__EMAC_ZC/emac_zc.h>
+	#endif //#if C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE == 1U
+
 /*******************************************************************************
 RLOOP - FLIGHT CONTROL UNIT - CORE
 *******************************************************************************/
@@ -169,7 +331,16 @@ RLOOP - FLIGHT CONTROL UNIT - CORE
 		#define C_LOCALDEF__LCCM655__ENABLE_THROTTLE						(0U)
 
 		/** Enable the ASI_RS485 */
-		#define C_LOCALDEF__LCCM655__ENABLE_ASI_RS485						(0U)
+		#define C_LOCALDEF__LCCM655__ENABLE_ASI_RS485						(1U)
+
+			//the ASI bus runs against the simulated RS485 bus in LCCM655R0_TS_004
+			#define C_LOCALDEF__LCCM655__ASI_SC16_INDEX							(7U)
+			#define C_LOCALDEF__LCCM655__ASI_BAUD								(115200U)
+			#define C_LOCALDEF__LCCM655__ASI_TICKS_PER_SEC						(C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC)
+			#define M_LOCALDEF__LCCM655__ASI_TIMESTAMP()						u64LCCM655R0_TS_004__Timestamp()
+			#define M_LOCALDEF__LCCM655__ASI_TX(pu8Data, u8Length)				vLCCM655R0_TS_004__Tx(pu8Data, u8Length)
+			#define M_LOCALDEF__LCCM655__ASI_RX_AVAIL()							u8LCCM655R0_TS_004__Rx_Avail()
+			#define M_LOCALDEF__LCCM655__ASI_RX_BYTE()							u8LCCM655R0_TS_004__Rx_Byte()
 
 		/** Enable the pusher detection system */
 		#define C_LOCALDEF__LCCM655__ENABLE_PUSHER							(0U)
@@ -177,6 +348,13 @@ RLOOP - FLIGHT CONTROL UNIT - CORE
 		/** Ethernet Systems */
 		#define C_LOCALDEF__LCCM655__ENABLE_ETHERNET						(1U)
 
+		/** Stream DAQ blocks to the ground station, needs LCCM667 and LCCM668 */
+		#define C_LOCALDEF__LCCM655__ENABLE_DAQ								(0U)
+
+		/** The task scheduler runs against the sim clock in LCCM655R0_TS_005 */
+		#define C_LOCALDEF__LCCM655__SCHED__TICKS_PER_MS					(C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC / 1000U)
+		#define M_LOCALDEF__LCCM655__SCHED__TICKS()							u32LCCM655R0_TS_005__Ticks()
+
 		/** Flight control specifics */
 		#define C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL					(0U)
 
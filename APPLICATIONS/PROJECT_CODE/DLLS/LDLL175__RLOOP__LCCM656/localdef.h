@@ -19,6 +19,17 @@ RLOOP - PI COMMUNICATIONS MODULE
 		#define C_LOCALDEF__LCCM656__USE_ON_WIN32							(1U)
 
 
+		/** Transmit queue depth, one frame on the wire, one being built and
+		 * the rest waiting. 2 to 8 */
+		#define C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH						(3U)
+
+		/** Queue overrun, 1 = drop the oldest waiting frame, 0 = drop the new frame */
+		#define C_LOCALDEF__LCCM656__TX_DROP_OLDEST						(1U)
+
+		/** Largest frame the node builds with every payload byte escaped, the
+		 * size of each queue buffer, a multiple of 4, TS_000 sends 120 params a frame */
+		#define C_LOCALDEF__LCCM656__TX_FRAME_SIZE						(2048U)
+
 			/** Testing Options */
 		#define C_LOCALDEF__LCCM656__ENABLE_TEST_SPEC						(0U)
 
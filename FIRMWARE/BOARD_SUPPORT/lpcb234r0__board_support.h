@@ -435,6 +435,9 @@ RTI MODULE
 		/** RTCLK1 feeds counter 1 and can be used for 64bit timing */
 		#define C_LOCALDEF__LCCM124__RTI_COUNTER1_PRESCALER					(1U)
 
+		/** Counter 1 rate, RTICLK / (CPUC1 + 1), every module tick rate on this board comes from here */
+		#define C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC				((C_LOCALDEF__LCCM124__RTI_CLK_FREQ * 1000000U) / (C_LOCALDEF__LCCM124__RTI_COUNTER1_PRESCALER + 1U))
+
 
 		//Sets up the time periods for each compare. Must be defined in microSeconds.
 		#define C_LOCALDEF__LCCM124__RTI_COMPARE_0_PERIOD_US 				(100000U)
@@ -810,5 +813,75 @@ LR Time = 160ns
  	 #endif //C_LOCALDEF__LCCM240__ENABLE_THIS_MODULE
 
 
+/*******************************************************************************
+RM4 EEPROM EMULATION
+You'll need the flash access module for this
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM230__ENABLE_THIS_MODULE							(1U)
+ 	 #if C_LOCALDEF__LCCM230__ENABLE_THIS_MODULE == 1U
+
+		//testing options
+		#define C_LOCALDEF__LCCM230__ENABLE_TEST_SPEC						(0U)
+
+ 	 	//main include
+ 	 	#include <RM4/LCCM230__RM4__EEPROM/rm4_eeprom.h>
+
+ 	 #endif //C_LOCALDEF__LCCM230__ENABLE_THIS_MODULE
+
+/*******************************************************************************
+EEPROM BASIC PARAMETERS
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM188__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM188__ENABLE_THIS_MODULE == 1U
+
+		//select your architecture
+#ifndef WIN32
+		#define C_LOCALDEF__LCCM188__USE_ON_PIC18							(0U)
+		#define C_LOCALDEF__LCCM188__USE_ON_PIC32							(0U)
+		#define C_LOCALDEF__LCCM188__USE_ON_DSPIC							(0U)
+		#define C_LOCALDEF__LCCM188__USE_ON_RM4 							(1U)
+		#define C_LOCALDEF__LCCM188__USE_ON_MSP430 							(0U)
+		#define C_LOCALDEF__LCCM188__USE_ON_WIN32 							(0U)
+#else
+		#define C_LOCALDEF__LCCM188__USE_ON_PIC18							(0U)
+		#define C_LOCALDEF__LCCM188__USE_ON_PIC32							(0U)
+		#define C_LOCALDEF__LCCM188__USE_ON_DSPIC							(0U)
+		#define C_LOCALDEF__LCCM188__USE_ON_RM4 							(0U)
+		#define C_LOCALDEF__LCCM188__USE_ON_MSP430 							(0U)
+		#define C_LOCALDEF__LCCM188__USE_ON_WIN32 							(1U)
+#endif
+
+		/** Use the EEPRARAMS module with an external FLASH */
+		#define C_LOCALDEF__LCCM188__USE_WITH_LCCM013						(0U)
+
+		/** Define the number of parameters in the system
+		 * The DS18B20 ROM cache needs 3 + (2 x MAX_DEVICES) of these */
+		#define C_LOCALDEF__LCCM188__NUM_PARAMETERS							(640U)
+
+		/** set to 1 if you want to enable CRC's across the entire paramter
+		range.  If so you will loose one paramter at the end to store theCRC
+		*/
+		#define C_LOCALDEF__LCCM188__ENABLE_CRC								(1U)
+
+		/** Offset to start in memory */
+		#define C_LOCALDEF__LCCM188__EEPROM_START_OFFSET					(0U)
+
+		/** DISABLES */
+		#define C_LOCALDEF__LCCM188__DISABLE__U16							(0U)
+		#define C_LOCALDEF__LCCM188__DISABLE__S16							(0U)
+		#define C_LOCALDEF__LCCM188__DISABLE__U32							(0U)
+		#define C_LOCALDEF__LCCM188__DISABLE__S32							(0U)
+		#define C_LOCALDEF__LCCM188__DISABLE__F32							(0U)
+		#define C_LOCALDEF__LCCM188__DISABLE__MAC							(0U)
+
+		/** Testing options */
+		#define C_LOCALDEF__LCCM188__ENABLE_TEST_SPEC						(0U)
+
+		//main include file
+		#include <MULTICORE/LCCM188__MULTICORE__EEPROM_PARAMS/eeprom_params.h>
+
+	#endif //C_LOCALDEF__LCCM188__ENABLE_THIS_MODULE
+
+
 #endif //_LPCB234R0_BOARD_SUPPORT_H_
 
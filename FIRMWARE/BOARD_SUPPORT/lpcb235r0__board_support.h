@@ -214,8 +214,8 @@ RM4 GIO MODULE
 			#define GIOA_PIN_3_ISR()										vSC16_INT__Handle_ISR(1U)
 			#define GIOA_PIN_4_ISR()										vSC16_INT__Handle_ISR(2U)
 			#define GIOA_PIN_5_ISR()										vRM4_GIO_ISR__DefaultRoutine()
-			#define GIOA_PIN_6_ISR()										vMMA8451__ISR(0U)
-			#define GIOA_PIN_7_ISR()										vMMA8451__ISR(1U)
+			#define GIOA_PIN_6_ISR()										vFCU_ACCEL__ISR(0U)
+			#define GIOA_PIN_7_ISR()										vFCU_ACCEL__ISR(1U)
 
 			#define GIOB_PIN_0_ISR()										vSC16_INT__Handle_ISR(7U)
 			#define GIOB_PIN_1_ISR()										vSC16_INT__Handle_ISR(3U)
@@ -816,6 +816,9 @@ RTI MODULE
 		/** RTCLK1 feeds counter 1 and can be used for 64bit timing */
 		#define C_LOCALDEF__LCCM124__RTI_COUNTER1_PRESCALER					(1U)
 
+		/** Counter 1 rate, RTICLK / (CPUC1 + 1), every module tick rate on this board comes from here */
+		#define C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC				((C_LOCALDEF__LCCM124__RTI_CLK_FREQ * 1000000U) / (C_LOCALDEF__LCCM124__RTI_COUNTER1_PRESCALER + 1U))
+
 		//Sets up the time periods for each compare. Must be defined in microSeconds.
 		#define C_LOCALDEF__LCCM124__RTI_COMPARE_0_PERIOD_US 				(100000U)
 		#define C_LOCALDEF__LCCM124__RTI_COMPARE_1_PERIOD_US 				(10000U)
@@ -824,9 +827,11 @@ RTI MODULE
 
 		//these are the interrupt handlers which should point
 		//to a function, otherwise leave as default
-		#define C_LOCALDEF__LCCM124__RTI_COMPARE_0_CALLBACK					vFCU__RTI_100MS_ISR()
-		#define C_LOCALDEF__LCCM124__RTI_COMPARE_1_CALLBACK					vFCU__RTI_10MS_ISR()
-		#define C_LOCALDEF__LCCM124__RTI_COMPARE_2_CALLBACK	 				vSTEPDRIVE_TIMEBASE__ISR()
+		//compare 0 and 1 are not enabled, the FCU times its 10ms and 100ms work off counter 1
+		#define C_LOCALDEF__LCCM124__RTI_COMPARE_0_CALLBACK					vRM4_RTI_INTERRUPTS__DefaultCallbackHandler()
+		#define C_LOCALDEF__LCCM124__RTI_COMPARE_1_CALLBACK					vRM4_RTI_INTERRUPTS__DefaultCallbackHandler()
+		//stepper timebase, the FCU picks the S-curve planner or LCCM231
+		#define C_LOCALDEF__LCCM124__RTI_COMPARE_2_CALLBACK	 				vFCU_BRAKES_STEP__Timebase_ISR()
 		#define C_LOCALDEF__LCCM124__RTI_COMPARE_3_CALLBACK	 				vRM4_RTI_INTERRUPTS__DefaultCallbackHandler()
 
 		//These values need to be updated if the HALCoGen file is modified
@@ -1254,8 +1259,8 @@ MMA8451 - 3 AXIS ACCELEROMETER
 
 		//define the data rate required
 		//Valid Values are: 800, 400, 200, 100, 50, 12, 6, 1
-		#define C_LOCALDEF__LCCM418__DEV0__DATA_RATE_HZ						(400U)
-		#define C_LOCALDEF__LCCM418__DEV1__DATA_RATE_HZ						(12U)
+		#define C_LOCALDEF__LCCM418__DEV0__DATA_RATE_HZ						(800U)
+		#define C_LOCALDEF__LCCM418__DEV1__DATA_RATE_HZ						(800U)
 		#define C_LOCALDEF__LCCM418__DEV2__DATA_RATE_HZ						(50U)
 		#define C_LOCALDEF__LCCM418__DEV3__DATA_RATE_HZ						(50U)
 
@@ -1366,7 +1371,9 @@ RM48 - CPU LOAD MEASUREMENT
 /*******************************************************************************
 MULTIPURPOSE DAQ MODULE
 *******************************************************************************/
-	#define C_LOCALDEF__LCCM662__ENABLE_THIS_MODULE							(1U)
+	/** Off on the FCU, the DAQ channel rings in LCCM667 replace it and use
+	 * the same 0x1210 packet types. See the LFW531 localdef. */
+	#define C_LOCALDEF__LCCM662__ENABLE_THIS_MODULE							(0U)
 	#if C_LOCALDEF__LCCM662__ENABLE_THIS_MODULE == 1U
 
 		/** Number of DAQ channels in each data format
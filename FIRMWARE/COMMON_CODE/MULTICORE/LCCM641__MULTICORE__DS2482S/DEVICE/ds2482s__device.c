@@ -478,6 +478,49 @@ Lint16 s16DS2482S_DEVICE__Read_Byte(Luint8 u8DeviceIndex, Luint8 *pu8Value)
 	return s16Return;
 }
 
+/***************************************************************************//**
+ * @brief
+ * Single shot check of the 1-Wire busy flag
+ *
+ * @note
+ * Unlike u8DS2482S_DEVICE__Wait_Busy() this never spins, it is used by callers
+ * that interleave work across several DS2482's and come back later.
+ *
+ * @param[out]		*pu8Status				Copy of the status register
+ * @param[in]		u8DeviceIndex			The I2C device index
+ * @return			1 = 1-Wire busy\n
+ *					0 = not busy\n
+ *					-ve = error
+ * @st_funcMD5
+ * @st_funcID		LCCM641R0.FILE.006.FUNC.008
+ */
+Lint16 s16DS2482S_DEVICE__Poll_Busy(Luint8 u8DeviceIndex, Luint8 *pu8Status)
+{
+	Lint16 s16Return;
+
+	//get the status
+	s16Return = s16DS2482S_DEVICE__Get_Status(u8DeviceIndex, pu8Status);
+	if(s16Return >= 0)
+	{
+		//check the 1WB bit
+		if((*pu8Status & 0x01U) == 0U)
+		{
+			s16Return = 0;
+		}
+		else
+		{
+			s16Return = 1;
+		}
+	}
+	else
+	{
+		//fall on with the error
+		*pu8Status = 0U;
+	}
+
+	return s16Return;
+}
+
 
 /*lint +e934*/
 /*lint +e960*/
@@ -691,6 +691,84 @@ Lint16 s16DS2482S_1WIRE__Skip(Luint8 u8DeviceIndex)
 	return s16Return;
 }
 
+/***************************************************************************//**
+ * @brief
+ * Start a 1-Wire reset/presence-detect cycle without waiting for it to finish
+ *
+ * @note
+ * Split transaction version of s16DS2482S_1WIRE__Generate_Reset() for callers
+ * that run several DS2482's at once. The caller must have seen 1WB = 0 via
+ * s16DS2482S_DEVICE__Poll_Busy() before calling this, and must poll again until
+ * 1WB = 0 before reading PPD/SD out of the status register.
+ * The strong pullup is not touched here, the split transaction callers never
+ * enable it.
+ *
+ * @param[in]		u8DeviceIndex			The device index on the I2C
+ * @return			0 = success\n
+ *					-ve = error
+ * @st_funcMD5
+ * @st_funcID		LCCM641R0.FILE.004.FUNC.010
+ */
+Lint16 s16DS2482S_1WIRE__Start_Reset(Luint8 u8DeviceIndex)
+{
+	Lint16 s16Return;
+
+	//write the reset command, the status pointer is left selected for polling
+	s16Return = s16DS2482S_LOWLEVEL__TxReg(u8DeviceIndex, DS2482_REGS__COMMAND_1_WIRE_RESET);
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Start a 1-Wire byte write without waiting for it to finish
+ *
+ * @note
+ * Same rules as s16DS2482S_1WIRE__Start_Reset(), 1WB must be clear before the
+ * call. The byte takes 8 time slots on the wire (approx 560us at standard speed)
+ * during which the I2C side is free to service the other DS2482's.
+ *
+ * @param[in]		u8Byte					The byte to write
+ * @param[in]		u8DeviceIndex			The device index on the I2C
+ * @return			0 = success\n
+ *					-ve = error
+ * @st_funcMD5
+ * @st_funcID		LCCM641R0.FILE.004.FUNC.011
+ */
+Lint16 s16DS2482S_1WIRE__Start_WriteByte(Luint8 u8DeviceIndex, Luint8 u8Byte)
+{
+	Lint16 s16Return;
+
+	//issue the data on the bus
+	s16Return = s16DS2482S_LOWLEVEL__WriteReg(u8DeviceIndex, DS2482_REGS__COMMAND_1_WIRE_WRITE_BYTE, u8Byte);
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Start a 1-Wire byte read without waiting for it to finish
+ *
+ * @note
+ * Once s16DS2482S_DEVICE__Poll_Busy() reports 1WB = 0 the byte is collected with
+ * s16DS2482S_DEVICE__Read_Byte().
+ *
+ * @param[in]		u8DeviceIndex			The device index on the I2C
+ * @return			0 = success\n
+ *					-ve = error
+ * @st_funcMD5
+ * @st_funcID		LCCM641R0.FILE.004.FUNC.012
+ */
+Lint16 s16DS2482S_1WIRE__Start_ReadByte(Luint8 u8DeviceIndex)
+{
+	Lint16 s16Return;
+
+	//generate the 8 read time slots
+	s16Return = s16DS2482S_LOWLEVEL__TxReg(u8DeviceIndex, DS2482_REGS__COMMAND_1_WIRE_READ_BYTE);
+
+	return s16Return;
+}
+
 /*lint +e934*/
 
 #endif //#if C_LOCALDEF__LCCM641__ENABLE_THIS_MODULE == 1U
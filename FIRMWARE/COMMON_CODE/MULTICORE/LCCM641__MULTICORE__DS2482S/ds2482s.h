@@ -83,6 +83,7 @@
 		Lint16 s16DS2482S_DEVICE__Read_ConfigRegister(Luint8 u8DeviceIndex, Luint8 *pu8Value);
 		Luint8 u8DS2482S_DEVICE__Wait_Busy(Luint8 u8DeviceIndex, Luint8 *pu8Status);
 		Lint16 s16DS2482S_DEVICE__Read_Byte(Luint8 u8DeviceIndex, Luint8 *pu8Value);
+		Lint16 s16DS2482S_DEVICE__Poll_Busy(Luint8 u8DeviceIndex, Luint8 *pu8Status);
 
 		//lowlevel
 		void vDS2482S_LOWLEVEL__Init(Luint8 u8DeviceIndex);
@@ -102,6 +103,9 @@
 		Lint16 s16DS2482S_1WIRE__ReadBit(Luint8 u8DeviceIndex, Luint8 *pu8Byte);
 		Lint16 s16DS2482S_1WIRE__SelectDevice(Luint8 u8DeviceIndex, const Luint8 *pu8Addx);
 		Lint16 s16DS2482S_1WIRE__Skip(Luint8 u8DeviceIndex);
+		Lint16 s16DS2482S_1WIRE__Start_Reset(Luint8 u8DeviceIndex);
+		Lint16 s16DS2482S_1WIRE__Start_WriteByte(Luint8 u8DeviceIndex, Luint8 u8Byte);
+		Lint16 s16DS2482S_1WIRE__Start_ReadByte(Luint8 u8DeviceIndex);
 
 		//search
 		Lint16 s16DS2482S_SEARCH__SearchFirstDevice(Luint8 u8DeviceIndex, Luint8 *pu8Addx);
@@ -0,0 +1,289 @@
+/**
+ * @file		DS18B20__ROM_CACHE.C
+ * @brief		Keeps a copy of the enumerated ROM table in the EEPROM params
+ * @author		Lachlan Grogan
+ * @copyright	This file contains proprietary and confidential information of
+ *				SIL3 Pty. Ltd. (ACN 123 529 064). This code may be distributed
+ *				under a license from SIL3 Pty. Ltd., and may be used, copied
+ *				and/or disclosed only pursuant to the terms of that license agreement.
+ *				This copyright notice must be retained as part of this file at all times.
+ * @copyright	This file is copyright SIL3 Pty. Ltd. 2003-2016, All Rights Reserved.
+ * @st_fileID	LCCM644R0.FILE.011
+ */
+/**
+ * @addtogroup MULTICORE
+ * @{ */
+/**
+ * @addtogroup DS18B20
+ * @ingroup MULTICORE
+ * @{ */
+/**
+ * @addtogroup DS18B20__ROM_CACHE
+ * @ingroup DS18B20
+ * @{ */
+
+#include "../ds18b20.h"
+#if C_LOCALDEF__LCCM644__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM644__ENABLE_ROM_CACHE == 1U
+
+/* EEPROM params layout, relative to C_LOCALDEF__LCCM644__ROM_CACHE__EEPROM_INDEX
+ * +0		CRC over +1 to the last used device word
+ * +1		Header
+ * +2		Number of devices
+ * +3+2n	ROM bytes 0..3
+ * +4+2n	ROM bytes 4..6, resolution in bits 24..27, channel in bits 28..31
+ *
+ * ROM byte 7 is the 1-wire CRC of bytes 0..6, it is rebuilt on load and acts as
+ * a second check on each entry. */
+#define C_DS18B20__ROM_CACHE__CRC							(C_LOCALDEF__LCCM644__ROM_CACHE__EEPROM_INDEX + 0U)
+#define C_DS18B20__ROM_CACHE__HEADER						(C_LOCALDEF__LCCM644__ROM_CACHE__EEPROM_INDEX + 1U)
+#define C_DS18B20__ROM_CACHE__COUNT							(C_LOCALDEF__LCCM644__ROM_CACHE__EEPROM_INDEX + 2U)
+#define C_DS18B20__ROM_CACHE__TABLE							(C_LOCALDEF__LCCM644__ROM_CACHE__EEPROM_INDEX + 3U)
+#define C_DS18B20__ROM_CACHE__HEADER_VALUE					(0x18B20C0DU)
+
+extern struct _strDS18B20 sDS18B20;
+
+//locals
+static Luint8 u8DS18B20_ROMCACHE__ROM_CRC(const Luint8 *pu8ROM);
+
+
+/***************************************************************************//**
+ * @brief
+ * Try and load the device table from the EEPROM params
+ *
+ * @note
+ * On success the search is flagged as complete, the resolutions are known and
+ * the main state machine can go straight to converting. The first full sweep
+ * after a load is used to prove the table, see vDS18B20__Process()
+ *
+ * @return			+ve = number of devices loaded\n
+ *					-1 = header or CRC fault\n
+ *					-2 = device count out of range\n
+ *					-3 = table entry fault
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.011.FUNC.001
+ */
+Lint16 s16DS18B20_ROMCACHE__Load(void)
+{
+	Lint16 s16Return;
+	Luint16 u16Count;
+	Luint16 u16Counter;
+	Luint32 u32Word0;
+	Luint32 u32Word1;
+	Luint8 u8ROM[8];
+	Luint8 u8Channel;
+	Luint8 u8Resolution;
+	Luint8 u8Test;
+
+	sDS18B20.sCache.u8Stored = 0U;
+	sDS18B20.sCache.u8Verify = 0U;
+
+	u16Count = (Luint16)u32EEPARAM__Read(C_DS18B20__ROM_CACHE__COUNT);
+
+	if(u32EEPARAM__Read(C_DS18B20__ROM_CACHE__HEADER) != C_DS18B20__ROM_CACHE__HEADER_VALUE)
+	{
+		s16Return = -1;
+	}
+	else if((u16Count == 0U) || (u16Count > C_LOCALDEF__LCCM644__MAX_DEVICES))
+	{
+		s16Return = -2;
+	}
+	else
+	{
+		//CRC only covers the used part of the table
+		u8Test = u8EEPARAM_CRC__Is_CRC_OK(	C_DS18B20__ROM_CACHE__HEADER,
+											C_DS18B20__ROM_CACHE__TABLE + (2U * u16Count) - 1U,
+											C_DS18B20__ROM_CACHE__CRC);
+		if(u8Test == 1U)
+		{
+			s16Return = (Lint16)u16Count;
+
+			u16Counter = 0U;
+			while((s16Return > 0) && (u16Counter < u16Count))
+			{
+				u32Word0 = u32EEPARAM__Read(C_DS18B20__ROM_CACHE__TABLE + (2U * u16Counter));
+				u32Word1 = u32EEPARAM__Read(C_DS18B20__ROM_CACHE__TABLE + (2U * u16Counter) + 1U);
+
+				u8ROM[0] = (Luint8)(u32Word0 & 0xFFU);
+				u8ROM[1] = (Luint8)((u32Word0 >> 8U) & 0xFFU);
+				u8ROM[2] = (Luint8)((u32Word0 >> 16U) & 0xFFU);
+				u8ROM[3] = (Luint8)((u32Word0 >> 24U) & 0xFFU);
+				u8ROM[4] = (Luint8)(u32Word1 & 0xFFU);
+				u8ROM[5] = (Luint8)((u32Word1 >> 8U) & 0xFFU);
+				u8ROM[6] = (Luint8)((u32Word1 >> 16U) & 0xFFU);
+				u8ROM[7] = u8DS18B20_ROMCACHE__ROM_CRC(&u8ROM[0]);
+
+				u8Resolution = (Luint8)((u32Word1 >> 24U) & 0x0FU);
+				u8Channel = (Luint8)((u32Word1 >> 28U) & 0x0FU);
+
+				if((u8ROM[0] != 0U) && (u8Channel < C_LOCALDEF__LCCM644__MAX_1WIRE_CHANNELS) && (u8Resolution >= 9U) && (u8Resolution <= 12U))
+				{
+					//addresses must go in from 0 to n
+					(void)s16DS18B20_ADDX__Upload_Addx((Luint8)u16Counter, u8Channel, &u8ROM[0]);
+					sDS18B20.sDevice[u16Counter].u8Resolution = u8Resolution;
+					sDS18B20.sDevice[u16Counter].f32Temperature = 127.0F;
+					u16Counter++;
+				}
+				else
+				{
+					//the EEPROM CRC was good but the entry is not, don't trust any of it
+					s16Return = -3;
+				}
+			}
+
+		}
+		else
+		{
+			s16Return = -1;
+		}
+	}
+
+	if(s16Return > 0)
+	{
+		//same as if the search had just finished
+		sDS18B20.sSearch.u8SearchCompleted = 1U;
+		sDS18B20.sCache.u8Stored = 1U;
+		sDS18B20.sCache.u8Verify = 1U;
+	}
+	else
+	{
+		//throw away anything half loaded, caller needs to search
+		sDS18B20.sEnum.u8NumDevices = 0U;
+	}
+
+	return s16Return;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Write the device table to the EEPROM params
+ *
+ * @note
+ * Call once the resolutions have been read back, they are part of the entry.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.011.FUNC.002
+ */
+void vDS18B20_ROMCACHE__Store(void)
+{
+	Luint16 u16Counter;
+	Luint16 u16Count;
+	Luint32 u32Word0;
+	Luint32 u32Word1;
+
+	u16Count = (Luint16)sDS18B20.sEnum.u8NumDevices;
+
+	if(u16Count > 0U)
+	{
+		//delay the writes until the last one
+		vEEPARAM__WriteU32(C_DS18B20__ROM_CACHE__HEADER, C_DS18B20__ROM_CACHE__HEADER_VALUE, 1U);
+		vEEPARAM__WriteU32(C_DS18B20__ROM_CACHE__COUNT, (Luint32)u16Count, 1U);
+
+		for(u16Counter = 0U; u16Counter < u16Count; u16Counter++)
+		{
+			u32Word0 = (Luint32)sDS18B20.sDevice[u16Counter].u8SerialNumber[0];
+			u32Word0 |= (Luint32)sDS18B20.sDevice[u16Counter].u8SerialNumber[1] << 8U;
+			u32Word0 |= (Luint32)sDS18B20.sDevice[u16Counter].u8SerialNumber[2] << 16U;
+			u32Word0 |= (Luint32)sDS18B20.sDevice[u16Counter].u8SerialNumber[3] << 24U;
+
+			u32Word1 = (Luint32)sDS18B20.sDevice[u16Counter].u8SerialNumber[4];
+			u32Word1 |= (Luint32)sDS18B20.sDevice[u16Counter].u8SerialNumber[5] << 8U;
+			u32Word1 |= (Luint32)sDS18B20.sDevice[u16Counter].u8SerialNumber[6] << 16U;
+			u32Word1 |= ((Luint32)sDS18B20.sDevice[u16Counter].u8Resolution & 0x0FU) << 24U;
+			u32Word1 |= ((Luint32)sDS18B20.sDevice[u16Counter].u8ChannelIndex & 0x0FU) << 28U;
+
+			vEEPARAM__WriteU32(C_DS18B20__ROM_CACHE__TABLE + (2U * u16Counter), u32Word0, 1U);
+			if(u16Counter == (u16Count - 1U))
+			{
+				//commit
+				vEEPARAM__WriteU32(C_DS18B20__ROM_CACHE__TABLE + (2U * u16Counter) + 1U, u32Word1, 0U);
+			}
+			else
+			{
+				vEEPARAM__WriteU32(C_DS18B20__ROM_CACHE__TABLE + (2U * u16Counter) + 1U, u32Word1, 1U);
+			}
+		}
+
+		vEEPARAM_CRC__Calculate_And_Store_CRC(	C_DS18B20__ROM_CACHE__HEADER,
+												C_DS18B20__ROM_CACHE__TABLE + (2U * u16Count) - 1U,
+												C_DS18B20__ROM_CACHE__CRC);
+
+		sDS18B20.sCache.u8Stored = 1U;
+	}
+	else
+	{
+		//nothing worth saving
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Kill the EEPROM copy so the next boot searches
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.011.FUNC.003
+ */
+void vDS18B20_ROMCACHE__Invalidate(void)
+{
+	vEEPARAM__WriteU32(C_DS18B20__ROM_CACHE__HEADER, 0U, 0U);
+
+	sDS18B20.sCache.u8Stored = 0U;
+	sDS18B20.sCache.u8Verify = 0U;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Compute the 1-wire ROM CRC (byte 7) from ROM bytes 0..6
+ *
+ * @note
+ * The scratchpad CRC runs over 8 bytes from a zero seed, and a leading zero
+ * byte leaves a zero seed unchanged, so prefixing the 7 ROM bytes with a zero
+ * gives the ROM CRC from the same routine.
+ *
+ * @param[in]		*pu8ROM					Pointer to the ROM bytes
+ * @return			The ROM CRC
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.011.FUNC.004
+ */
+static Luint8 u8DS18B20_ROMCACHE__ROM_CRC(const Luint8 *pu8ROM)
+{
+	Luint8 u8Buffer[9];
+	Luint8 u8Counter;
+
+	u8Buffer[0] = 0U;
+	for(u8Counter = 0U; u8Counter < 7U; u8Counter++)
+	{
+		u8Buffer[u8Counter + 1U] = pu8ROM[u8Counter];
+	}
+	u8Buffer[8] = 0U;
+
+	return u8DS18B20_SCRATCH__Compute_CRC(&u8Buffer[0]);
+}
+
+//safetys
+#ifndef C_LOCALDEF__LCCM644__ROM_CACHE__EEPROM_INDEX
+	#error
+#endif
+#ifndef C_LOCALDEF__LCCM188__ENABLE_CRC
+	#error
+#endif
+#if C_LOCALDEF__LCCM188__ENABLE_CRC != 1U
+	//the table is only trusted with a CRC
+	#error
+#endif
+#if (C_LOCALDEF__LCCM644__ROM_CACHE__EEPROM_INDEX + 3U + (2U * C_LOCALDEF__LCCM644__MAX_DEVICES)) >= C_LOCALDEF__LCCM188__NUM_PARAMETERS
+	//the table must fit below the CRC parameter
+	#error
+#endif
+
+#endif //#if C_LOCALDEF__LCCM644__ENABLE_ROM_CACHE == 1U
+#endif //#if C_LOCALDEF__LCCM644__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM644__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
@@ -0,0 +1,448 @@
+/**
+ * @file		DS18B20__SCHEDULER.C
+ * @brief		Multi channel conversion and readout scheduler
+ * @author		Lachlan Grogan
+ * @copyright	This file contains proprietary and confidential information of
+ *				SIL3 Pty. Ltd. (ACN 123 529 064). This code may be distributed
+ *				under a license from SIL3 Pty. Ltd., and may be used, copied
+ *				and/or disclosed only pursuant to the terms of that license agreement.
+ *				This copyright notice must be retained as part of this file at all times.
+ * @copyright	This file is copyright SIL3 Pty. Ltd. 2003-2016, All Rights Reserved.
+ * @st_fileID	LCCM644R0.FILE.010
+ */
+/**
+ * @addtogroup MULTICORE
+ * @{ */
+/**
+ * @addtogroup DS18B20
+ * @ingroup MULTICORE
+ * @{ */
+/**
+ * @addtogroup DS18B20__SCHEDULER
+ * @ingroup DS18B20
+ * @{ */
+
+#include "../ds18b20.h"
+#if C_LOCALDEF__LCCM644__ENABLE_THIS_MODULE == 1U
+
+/* Each 1-wire channel is its own DS2482, so while one channel is clocking out
+ * a byte (~560us at standard speed) the I2C is free to start the next byte on
+ * another channel. The scheduler keeps one small state machine per channel
+ * and every step is a single non waiting I2C transaction. A step that finds its
+ * channel still busy just moves on to the next channel. */
+
+extern struct _strDS18B20 sDS18B20;
+
+//locals
+static void vDS18B20_SCHED__Step(Luint8 u8Channel);
+static void vDS18B20_SCHED__Next_Device(Luint8 u8Channel, Luint16 u16Start);
+static void vDS18B20_SCHED__Fault(Luint8 u8Channel);
+
+
+/***************************************************************************//**
+ * @brief
+ * Init the scheduler
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.010.FUNC.001
+ */
+void vDS18B20_SCHED__Init(void)
+{
+	Luint8 u8Counter;
+
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM644__MAX_1WIRE_CHANNELS; u8Counter++)
+	{
+		sDS18B20.sSched.sBus[u8Counter].eState = DS18B20_BUS__IDLE;
+		sDS18B20.sSched.sBus[u8Counter].u8Convert = 0U;
+		sDS18B20.sSched.sBus[u8Counter].u8Byte = 0U;
+		sDS18B20.sSched.sBus[u8Counter].u16Device = 0U;
+		sDS18B20.sSched.sBus[u8Counter].u32Faults = 0U;
+	}
+
+	sDS18B20.sSched.u16PassFaults = 0U;
+	sDS18B20.sSched.u32Sweeps = 0U;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Arm a Convert-T on every 1-wire channel that has at least one device
+ *
+ * @note
+ * Reset, Skip ROM, 0x44 is issued on each channel. The channels are stepped
+ * together by u8DS18B20_SCHED__Process() so the conversions all start within
+ * a few hundred microseconds of each other.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.010.FUNC.002
+ */
+void vDS18B20_SCHED__Start_Convert(void)
+{
+	Luint8 u8Counter;
+
+	sDS18B20.sSched.u16PassFaults = 0U;
+
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM644__MAX_1WIRE_CHANNELS; u8Counter++)
+	{
+		sDS18B20.sSched.sBus[u8Counter].u8Convert = 1U;
+
+		//only arm channels that have something on them
+		vDS18B20_SCHED__Next_Device(u8Counter, 0U);
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Arm a scratchpad read of every device, all channels run in parallel
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.010.FUNC.003
+ */
+void vDS18B20_SCHED__Start_Read(void)
+{
+	Luint8 u8Counter;
+
+	sDS18B20.sSched.u16PassFaults = 0U;
+
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM644__MAX_1WIRE_CHANNELS; u8Counter++)
+	{
+		sDS18B20.sSched.sBus[u8Counter].u8Convert = 0U;
+
+		//find the first device on this channel
+		vDS18B20_SCHED__Next_Device(u8Counter, 0U);
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Step the channels round robin
+ *
+ * @note
+ * Makes at most C_LOCALDEF__LCCM644__SCHED_STEPS_PER_PROCESS channel steps.
+ *
+ * @return			1 = every channel is idle, the armed pass is complete\n
+ *					0 = still working
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.010.FUNC.004
+ */
+Luint8 u8DS18B20_SCHED__Process(void)
+{
+	Luint8 u8Channel;
+	Luint8 u8Idle;
+	Luint16 u16Steps;
+
+	u16Steps = 0U;
+	u8Idle = 0U;
+
+	while((u8Idle == 0U) && (u16Steps < C_LOCALDEF__LCCM644__SCHED_STEPS_PER_PROCESS))
+	{
+		//assume done until we find a channel that is not
+		u8Idle = 1U;
+
+		for(u8Channel = 0U; u8Channel < C_LOCALDEF__LCCM644__MAX_1WIRE_CHANNELS; u8Channel++)
+		{
+			if(sDS18B20.sSched.sBus[u8Channel].eState != DS18B20_BUS__IDLE)
+			{
+				u8Idle = 0U;
+
+				if(u16Steps < C_LOCALDEF__LCCM644__SCHED_STEPS_PER_PROCESS)
+				{
+					vDS18B20_SCHED__Step(u8Channel);
+					u16Steps++;
+				}
+				else
+				{
+					//out of steps for this call
+				}
+			}
+			else
+			{
+				//fall on
+			}
+		}
+
+	}
+
+	return u8Idle;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Run one transaction on a channel
+ *
+ * @param[in]		u8Channel				The 1-wire channel
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.010.FUNC.005
+ */
+static void vDS18B20_SCHED__Step(Luint8 u8Channel)
+{
+	Lint16 s16Return;
+	Luint8 u8Status;
+	Luint8 u8CRC;
+	Luint16 u16Device;
+
+	u16Device = sDS18B20.sSched.sBus[u8Channel].u16Device;
+
+	//everything but decode needs the DS2482 out of 1WB
+	if(sDS18B20.sSched.sBus[u8Channel].eState != DS18B20_BUS__DECODE)
+	{
+		s16Return = s16DS18B20_1WIRE__Poll_Busy(u8Channel, &u8Status);
+	}
+	else
+	{
+		s16Return = 0;
+		u8Status = 0U;
+	}
+
+	if(s16Return < 0)
+	{
+		//I2C fault, drop the device
+		vDS18B20_SCHED__Fault(u8Channel);
+	}
+	else if(s16Return == 1)
+	{
+		//still on the wire, come back next time around
+	}
+	else
+	{
+
+		switch(sDS18B20.sSched.sBus[u8Channel].eState)
+		{
+			case DS18B20_BUS__IDLE:
+				//do nothing
+				break;
+
+			case DS18B20_BUS__RESET:
+				s16Return = s16DS18B20_1WIRE__Start_Reset(u8Channel);
+				if(s16Return >= 0)
+				{
+					sDS18B20.sSched.sBus[u8Channel].eState = DS18B20_BUS__PRESENCE;
+				}
+				else
+				{
+					vDS18B20_SCHED__Fault(u8Channel);
+				}
+				break;
+
+			case DS18B20_BUS__PRESENCE:
+				//SD = 0 and PPD = 1
+				if((u8Status & 0x06U) == 0x02U)
+				{
+					if(sDS18B20.sSched.sBus[u8Channel].u8Convert == 1U)
+					{
+						sDS18B20.sSched.sBus[u8Channel].eState = DS18B20_BUS__SKIP;
+					}
+					else
+					{
+						sDS18B20.sSched.sBus[u8Channel].u8Byte = 0U;
+						sDS18B20.sSched.sBus[u8Channel].eState = DS18B20_BUS__MATCH;
+					}
+				}
+				else
+				{
+					//short or nobody home
+					vDS18B20_SCHED__Fault(u8Channel);
+				}
+				break;
+
+			case DS18B20_BUS__SKIP:
+				s16Return = s16DS18B20_1WIRE__Start_WriteByte(u8Channel, 0xCCU);
+				if(s16Return >= 0)
+				{
+					sDS18B20.sSched.sBus[u8Channel].eState = DS18B20_BUS__CONVERT;
+				}
+				else
+				{
+					vDS18B20_SCHED__Fault(u8Channel);
+				}
+				break;
+
+			case DS18B20_BUS__CONVERT:
+				s16Return = s16DS18B20_1WIRE__Start_WriteByte(u8Channel, 0x44U);
+				if(s16Return >= 0)
+				{
+					//the whole channel is converting, nothing more to do here
+					sDS18B20.sSched.sBus[u8Channel].eState = DS18B20_BUS__IDLE;
+				}
+				else
+				{
+					vDS18B20_SCHED__Fault(u8Channel);
+				}
+				break;
+
+			case DS18B20_BUS__MATCH:
+				//0x55, the 8 ROM bytes, then read scratchpad 0xBE
+				if(sDS18B20.sSched.sBus[u8Channel].u8Byte == 0U)
+				{
+					s16Return = s16DS18B20_1WIRE__Start_WriteByte(u8Channel, 0x55U);
+				}
+				else if(sDS18B20.sSched.sBus[u8Channel].u8Byte < 9U)
+				{
+					s16Return = s16DS18B20_1WIRE__Start_WriteByte(u8Channel, sDS18B20.sDevice[u16Device].u8SerialNumber[sDS18B20.sSched.sBus[u8Channel].u8Byte - 1U]);
+				}
+				else
+				{
+					s16Return = s16DS18B20_1WIRE__Start_WriteByte(u8Channel, 0xBEU);
+				}
+
+				if(s16Return >= 0)
+				{
+					sDS18B20.sSched.sBus[u8Channel].u8Byte++;
+					if(sDS18B20.sSched.sBus[u8Channel].u8Byte >= 10U)
+					{
+						sDS18B20.sSched.sBus[u8Channel].u8Byte = 0U;
+						sDS18B20.sSched.sBus[u8Channel].eState = DS18B20_BUS__READ;
+					}
+					else
+					{
+						//stay here
+					}
+				}
+				else
+				{
+					vDS18B20_SCHED__Fault(u8Channel);
+				}
+				break;
+
+			case DS18B20_BUS__READ:
+				s16Return = s16DS18B20_1WIRE__Start_ReadByte(u8Channel);
+				if(s16Return >= 0)
+				{
+					sDS18B20.sSched.sBus[u8Channel].eState = DS18B20_BUS__COLLECT;
+				}
+				else
+				{
+					vDS18B20_SCHED__Fault(u8Channel);
+				}
+				break;
+
+			case DS18B20_BUS__COLLECT:
+				s16Return = s16DS18B20_1WIRE__Collect_Byte(u8Channel, &sDS18B20.sSched.sBus[u8Channel].u8Scratch[sDS18B20.sSched.sBus[u8Channel].u8Byte]);
+				if(s16Return >= 0)
+				{
+					sDS18B20.sSched.sBus[u8Channel].u8Byte++;
+					if(sDS18B20.sSched.sBus[u8Channel].u8Byte >= 9U)
+					{
+						sDS18B20.sSched.sBus[u8Channel].eState = DS18B20_BUS__DECODE;
+					}
+					else
+					{
+						sDS18B20.sSched.sBus[u8Channel].eState = DS18B20_BUS__READ;
+					}
+				}
+				else
+				{
+					vDS18B20_SCHED__Fault(u8Channel);
+				}
+				break;
+
+			case DS18B20_BUS__DECODE:
+				u8CRC = u8DS18B20_SCRATCH__Compute_CRC(&sDS18B20.sSched.sBus[u8Channel].u8Scratch[0]);
+				if(u8CRC == sDS18B20.sSched.sBus[u8Channel].u8Scratch[8U])
+				{
+					vDS18B20_TEMP__Scratch_To_Temp((Luint8)u16Device, &sDS18B20.sSched.sBus[u8Channel].u8Scratch[0], &sDS18B20.sDevice[u16Device].f32Temperature);
+
+					//on to the next device on this channel, the next reset ends this transaction
+					vDS18B20_SCHED__Next_Device(u8Channel, u16Device + 1U);
+				}
+				else
+				{
+					//also what an absent ROM looks like, all 0xFF
+					vDS18B20_SCHED__Fault(u8Channel);
+				}
+				break;
+
+			default:
+				//recover
+				sDS18B20.sSched.sBus[u8Channel].eState = DS18B20_BUS__IDLE;
+				break;
+
+		}//switch(sDS18B20.sSched.sBus[u8Channel].eState)
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Find the next device in the table that lives on this channel
+ *
+ * @note
+ * In convert mode we only care that the channel has a device at all.
+ *
+ * @param[in]		u16Start				First table index to look at
+ * @param[in]		u8Channel				The 1-wire channel
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.010.FUNC.006
+ */
+static void vDS18B20_SCHED__Next_Device(Luint8 u8Channel, Luint16 u16Start)
+{
+	Luint16 u16Counter;
+	Luint8 u8Found;
+
+	u8Found = 0U;
+	u16Counter = u16Start;
+
+	while((u8Found == 0U) && (u16Counter < (Luint16)sDS18B20.sEnum.u8NumDevices))
+	{
+		if(sDS18B20.sDevice[u16Counter].u8ChannelIndex == u8Channel)
+		{
+			u8Found = 1U;
+		}
+		else
+		{
+			u16Counter++;
+		}
+	}
+
+	if(u8Found == 1U)
+	{
+		sDS18B20.sSched.sBus[u8Channel].u16Device = u16Counter;
+		sDS18B20.sSched.sBus[u8Channel].eState = DS18B20_BUS__RESET;
+	}
+	else
+	{
+		//channel is done
+		sDS18B20.sSched.sBus[u8Channel].eState = DS18B20_BUS__IDLE;
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Count a fault and abandon the current device on this channel
+ *
+ * @param[in]		u8Channel				The 1-wire channel
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.010.FUNC.007
+ */
+static void vDS18B20_SCHED__Fault(Luint8 u8Channel)
+{
+
+	sDS18B20.sSched.sBus[u8Channel].u32Faults++;
+	sDS18B20.sSched.u16PassFaults++;
+
+	if(sDS18B20.sSched.sBus[u8Channel].u8Convert == 1U)
+	{
+		//nothing else to convert on this channel
+		sDS18B20.sSched.sBus[u8Channel].eState = DS18B20_BUS__IDLE;
+	}
+	else
+	{
+		//keep the old temperature, move on
+		vDS18B20_SCHED__Next_Device(u8Channel, sDS18B20.sSched.sBus[u8Channel].u16Device + 1U);
+	}
+
+}
+
+
+#endif //#if C_LOCALDEF__LCCM644__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM644__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
@@ -27,9 +27,6 @@
 
 extern struct _strDS18B20 sDS18B20;
 
-//locals
-static void vDS18B20_TEMP__Scratch_To_Temp(Luint8 u8DSIndex, const Luint8 *pu8Scratch, Lfloat32 *pf32Temp);
-
 /***************************************************************************//**
  * @brief
  * Read the temperature from a device ONCE the conversion is complete
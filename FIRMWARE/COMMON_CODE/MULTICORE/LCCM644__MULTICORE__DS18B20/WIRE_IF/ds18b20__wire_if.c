@@ -188,6 +188,130 @@ Lint16 s16DS18B20_1WIRE__Skip(Luint8 u8DeviceIndex)
 	return s16Return;
 }
 
+/***************************************************************************//**
+ * @brief
+ * Single shot check of the 1-wire busy flag, does not wait
+ * 
+ * @param[out]		*pu8Status				Copy of the interface status
+ * @param[in]		u8DeviceIndex			Index of 1-wire interface
+ * @return			1 = busy\n
+ *					0 = idle\n
+ *					-ve = error
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.007.FUNC.008
+ */
+Lint16 s16DS18B20_1WIRE__Poll_Busy(Luint8 u8DeviceIndex, Luint8 *pu8Status)
+{
+	Lint16 s16Return;
+	#if C_LOCALDEF__LCCM644__CONNECT_LCCM641 == 1U
+		s16Return = s16DS2482S_DEVICE__Poll_Busy(u8DeviceIndex, pu8Status);
+	#elif C_LOCALDEF__LCCM644__CONNECT_LCCM236 == 1U
+		//the bit banged 1-wire has no split transactions
+		#error
+	#else
+		#error
+	#endif
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Start a reset / presence cycle, does not wait
+ * 
+ * @param[in]		u8DeviceIndex			Index of 1-wire interface
+ * @return			0 = success\n
+ *					-ve = error
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.007.FUNC.009
+ */
+Lint16 s16DS18B20_1WIRE__Start_Reset(Luint8 u8DeviceIndex)
+{
+	Lint16 s16Return;
+	#if C_LOCALDEF__LCCM644__CONNECT_LCCM641 == 1U
+		s16Return = s16DS2482S_1WIRE__Start_Reset(u8DeviceIndex);
+	#elif C_LOCALDEF__LCCM644__CONNECT_LCCM236 == 1U
+		//the bit banged 1-wire has no split transactions
+		#error
+	#else
+		#error
+	#endif
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Start writing a byte to the wire, does not wait
+ * 
+ * @param[in]		u8Byte					The byte value to write
+ * @param[in]		u8DeviceIndex			Index of 1-wire interface
+ * @return			0 = success\n
+ *					-ve = error
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.007.FUNC.010
+ */
+Lint16 s16DS18B20_1WIRE__Start_WriteByte(Luint8 u8DeviceIndex, Luint8 u8Byte)
+{
+	Lint16 s16Return;
+	#if C_LOCALDEF__LCCM644__CONNECT_LCCM641 == 1U
+		s16Return = s16DS2482S_1WIRE__Start_WriteByte(u8DeviceIndex, u8Byte);
+	#elif C_LOCALDEF__LCCM644__CONNECT_LCCM236 == 1U
+		//the bit banged 1-wire has no split transactions
+		#error
+	#else
+		#error
+	#endif
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Start reading a byte from the wire, does not wait
+ * 
+ * @param[in]		u8DeviceIndex			Index of 1-wire interface
+ * @return			0 = success\n
+ *					-ve = error
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.007.FUNC.011
+ */
+Lint16 s16DS18B20_1WIRE__Start_ReadByte(Luint8 u8DeviceIndex)
+{
+	Lint16 s16Return;
+	#if C_LOCALDEF__LCCM644__CONNECT_LCCM641 == 1U
+		s16Return = s16DS2482S_1WIRE__Start_ReadByte(u8DeviceIndex);
+	#elif C_LOCALDEF__LCCM644__CONNECT_LCCM236 == 1U
+		//the bit banged 1-wire has no split transactions
+		#error
+	#else
+		#error
+	#endif
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Collect the byte from a finished Start_ReadByte
+ * 
+ * @param[out]		*pu8Byte				Returned byte
+ * @param[in]		u8DeviceIndex			Index of 1-wire interface
+ * @return			0 = success\n
+ *					-ve = error
+ * @st_funcMD5
+ * @st_funcID		LCCM644R0.FILE.007.FUNC.012
+ */
+Lint16 s16DS18B20_1WIRE__Collect_Byte(Luint8 u8DeviceIndex, Luint8 *pu8Byte)
+{
+	Lint16 s16Return;
+	#if C_LOCALDEF__LCCM644__CONNECT_LCCM641 == 1U
+		s16Return = s16DS2482S_DEVICE__Read_Byte(u8DeviceIndex, pu8Byte);
+	#elif C_LOCALDEF__LCCM644__CONNECT_LCCM236 == 1U
+		//the bit banged 1-wire has no split transactions
+		#error
+	#else
+		#error
+	#endif
+	return s16Return;
+}
+
 #endif //#if C_LOCALDEF__LCCM644__ENABLE_THIS_MODULE == 1U
 //safetys
 #ifndef C_LOCALDEF__LCCM644__ENABLE_THIS_MODULE
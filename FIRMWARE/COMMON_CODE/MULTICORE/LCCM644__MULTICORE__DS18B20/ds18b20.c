@@ -53,6 +53,15 @@ void vDS18B20__Init(void)
 	//setup the vars for the address searching.
 	vDS18B20_ADDX__Init();
 
+	//multi channel conversions
+	vDS18B20_SCHED__Init();
+
+	#if C_LOCALDEF__LCCM644__ENABLE_ROM_CACHE == 1U
+		//nothing loaded or saved yet
+		sDS18B20.sCache.u8Stored = 0U;
+		sDS18B20.sCache.u8Verify = 0U;
+	#endif
+
 }
 
 /***************************************************************************//**
@@ -66,6 +75,7 @@ void vDS18B20__Init(void)
 void vDS18B20__Process(void)
 {
 	Lint16 s16Return;
+	Luint8 u8Test;
 
 	//if need be process the search functions
 	vDS18B20_ADDX__SearchSM_Process();
@@ -96,9 +106,22 @@ void vDS18B20__Process(void)
 					//clear our device counter now.
 					sDS18B20.u8MainStateCounter = 0U;
 
+				#if C_LOCALDEF__LCCM644__ENABLE_ROM_CACHE == 1U
+					if(sDS18B20.sCache.u8Verify == 1U)
+					{
+						//table and resolutions came from the EEPROM, go straight to work
+						sDS18B20.eMainState = DS18B20_STATE__START_CONVERT_ALL;
+					}
+					else
+					{
+						//setup the resolutions
+						sDS18B20.eMainState = DS18B20_STATE__READ_RESOLUTION;
+					}
+				#else
 					//setup the resolutions
 					//todo: could change to configure resoltution, BUT ONLY ONCE.
 					sDS18B20.eMainState = DS18B20_STATE__READ_RESOLUTION;
+				#endif
 				}
 				else
 				{
@@ -172,6 +195,18 @@ void vDS18B20__Process(void)
 			sDS18B20.u8MainStateCounter++;
 			if(sDS18B20.u8MainStateCounter >= sDS18B20.sEnum.u8NumDevices)
 			{
+				#if C_LOCALDEF__LCCM644__ENABLE_ROM_CACHE == 1U
+					if(sDS18B20.sCache.u8Stored == 0U)
+					{
+						//fresh search, save it so the next boot can skip it
+						vDS18B20_ROMCACHE__Store();
+					}
+					else
+					{
+						//fall on
+					}
+				#endif
+
 				sDS18B20.eMainState = DS18B20_STATE__START_CONVERT_ALL;
 			}
 			else
@@ -182,48 +217,53 @@ void vDS18B20__Process(void)
 
 		case DS18B20_STATE__START_CONVERT_ALL:
 
-			//do the conversion
+			//Convert-T on every channel that has devices, not just the first one
+			vDS18B20_SCHED__Start_Convert();
 
-			//TODO:
-			//There is going to be a big problem as we only do a request all on
-			//one BUS. IF we have devices on multiple busses we need to also do a request all on the
-			//second bus too.
-			#if C_LOCALDEF__LCCM644__USE_10MS_ISR == 0U
-				s16Return = s16DS18B20_TEMP__All_Request(0U, 1U);
-			#else
-				s16Return = s16DS18B20_TEMP__All_Request(0U, 0U);
-			#endif
-			if(s16Return >= 0)
+			sDS18B20.eMainState = DS18B20_STATE__ISSUE_CONVERT;
+			break;
+
+		case DS18B20_STATE__ISSUE_CONVERT:
+
+			//step the channels until each one has its Convert-T out
+			u8Test = u8DS18B20_SCHED__Process();
+			if(u8Test == 1U)
 			{
+				//depending if we have interrupts avail or not, either wait or go to read.
+				#if C_LOCALDEF__LCCM644__USE_10MS_ISR == 0U
+
+					#if C_LOCALDEF__LCCM644__RESOLUTION_SETTING == 9U
+						vDS18B20_DELAYS__Delay_mS(94U);
+					#elif C_LOCALDEF__LCCM644__RESOLUTION_SETTING == 10U
+						vDS18B20_DELAYS__Delay_mS(188U);
+					#elif C_LOCALDEF__LCCM644__RESOLUTION_SETTING == 11U
+						vDS18B20_DELAYS__Delay_mS(375U);
+					#else
+						vDS18B20_DELAYS__Delay_mS(750U);
+					#endif
+
+					//clear the counter
+					sDS18B20.u32ISR_Counter = 0U;
+
+					//arm the reads on all channels
+					vDS18B20_SCHED__Start_Read();
+
+					//just jump to reading the sensors are we are not using ISR's to count time.
+					sDS18B20.eMainState = DS18B20_STATE__READ_SENSORS;
+				#else
+
+					//clear the counter, the conversion time runs from here
+					sDS18B20.u32ISR_Counter = 0U;
 
+					//change state
+					sDS18B20.eMainState = DS18B20_STATE__WAIT_CONVERT;
+				#endif
 			}
 			else
 			{
-				//some error
+				//stay here
 			}
 
-			//depending if we have interrupts avail or not, either wait or go to read.
-			#if C_LOCALDEF__LCCM644__USE_10MS_ISR == 0U
-				//clear the counter
-				sDS18B20.u32ISR_Counter = 0U;
-
-				//clear our device counter now.
-				sDS18B20.u8MainStateCounter = 0U;
-
-				//just jump to reading the sensors are we are not using ISR's to count time.
-				sDS18B20.eMainState = DS18B20_STATE__READ_SENSORS;
-			#else
-
-				//clear the counter
-				sDS18B20.u32ISR_Counter = 0U;
-
-				//clear our device counter now.
-				sDS18B20.u8MainStateCounter = 0U;
-
-				//change state
-				sDS18B20.eMainState = DS18B20_STATE__WAIT_CONVERT;
-			#endif
-
 			break;
 
 		case DS18B20_STATE__WAIT_CONVERT:
@@ -232,7 +272,8 @@ void vDS18B20__Process(void)
 			#if C_LOCALDEF__LCCM644__RESOLUTION_SETTING == 9U
 				if(sDS18B20.u32ISR_Counter > 10U)
 				{
-					//go and read the sensor now
+					//go and read the sensors now, all channels together
+					vDS18B20_SCHED__Start_Read();
 					sDS18B20.eMainState = DS18B20_STATE__READ_SENSORS;
 				}
 				else
@@ -242,7 +283,8 @@ void vDS18B20__Process(void)
 			#elif C_LOCALDEF__LCCM644__RESOLUTION_SETTING == 10U
 				if(sDS18B20.u32ISR_Counter > 19U)
 				{
-					//go and read the sensor now
+					//go and read the sensors now, all channels together
+					vDS18B20_SCHED__Start_Read();
 					sDS18B20.eMainState = DS18B20_STATE__READ_SENSORS;
 				}
 				else
@@ -252,7 +294,8 @@ void vDS18B20__Process(void)
 			#elif C_LOCALDEF__LCCM644__RESOLUTION_SETTING == 11U
 				if(sDS18B20.u32ISR_Counter > 38U)
 				{
-					//go and read the sensor now
+					//go and read the sensors now, all channels together
+					vDS18B20_SCHED__Start_Read();
 					sDS18B20.eMainState = DS18B20_STATE__READ_SENSORS;
 				}
 				else
@@ -262,7 +305,8 @@ void vDS18B20__Process(void)
 			#elif C_LOCALDEF__LCCM644__RESOLUTION_SETTING == 12U
 				if(sDS18B20.u32ISR_Counter > 76U)
 				{
-					//go and read the sensor now
+					//go and read the sensors now, all channels together
+					vDS18B20_SCHED__Start_Read();
 					sDS18B20.eMainState = DS18B20_STATE__READ_SENSORS;
 				}
 				else
@@ -275,22 +319,11 @@ void vDS18B20__Process(void)
 
 		case DS18B20_STATE__READ_SENSORS:
 
-
-			//get the temp data from each sensor
-			s16Return = s16DS18B20_TEMP__Read(sDS18B20.u8MainStateCounter);
-			if(s16Return >= 0)
-			{
-				//all good.
-			}
-			else
-			{
-				//error
-			}
-
-
-			sDS18B20.u8MainStateCounter++;
-			if(sDS18B20.u8MainStateCounter >= sDS18B20.sEnum.u8NumDevices)
+			//the scratchpad reads are interleaved across the channels
+			u8Test = u8DS18B20_SCHED__Process();
+			if(u8Test == 1U)
 			{
+				sDS18B20.sSched.u32Sweeps++;
 				sDS18B20.eMainState = DS18B20_STATE__READ_DONE;
 			}
 			else
@@ -307,6 +340,36 @@ void vDS18B20__Process(void)
 
 			//go back and do more
 			sDS18B20.eMainState = DS18B20_STATE__START_CONVERT_ALL;
+
+			#if C_LOCALDEF__LCCM644__ENABLE_ROM_CACHE == 1U
+				if(sDS18B20.sCache.u8Verify == 1U)
+				{
+					if(sDS18B20.sSched.u16PassFaults == 0U)
+					{
+						//every cached ROM answered, the table is good
+						sDS18B20.sCache.u8Verify = 0U;
+					}
+					else
+					{
+						//a sensor has been swapped or lost, a missing ROM reads back
+						//as all 0xFF and fails the CRC. Drop the copy and search again.
+						vDS18B20_ROMCACHE__Invalidate();
+						sDS18B20.sSearch.u8SearchCompleted = 0U;
+						vDS18B20_ADDX__SearchSM_Start();
+						sDS18B20.eMainState = DS18B20_STATE__IDLE;
+					}
+				}
+				else
+				{
+					//fall on
+				}
+			#endif
+
+			break;
+
+		default:
+			//recover
+			sDS18B20.eMainState = DS18B20_STATE__IDLE;
 			break;
 
 	}//switch(sDS18B20.eMainState)
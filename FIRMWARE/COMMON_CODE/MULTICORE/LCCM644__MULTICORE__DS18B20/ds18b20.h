@@ -91,6 +91,55 @@
 
 			}sSearch;
 
+			/** Multi channel conversion scheduler */
+			struct
+			{
+
+				/** Per 1-wire channel transaction state */
+				struct
+				{
+					/** Current state */
+					E_DS18B20__BUS_STATES eState;
+
+					/** 1 = Convert-T pass, 0 = scratchpad read pass */
+					Luint8 u8Convert;
+
+					/** Byte counter inside the MATCH and READ/COLLECT states */
+					Luint8 u8Byte;
+
+					/** Device table index being read on this channel */
+					Luint16 u16Device;
+
+					/** Scratchpad being assembled, one per channel so channels can overlap */
+					Luint8 u8Scratch[9U];
+
+					/** Count of I2C, presence and CRC faults on this channel */
+					Luint32 u32Faults;
+
+				}sBus[C_LOCALDEF__LCCM644__MAX_1WIRE_CHANNELS];
+
+				/** Faults counted during the current pass, cleared when a pass is armed */
+				Luint16 u16PassFaults;
+
+				/** Completed read sweeps */
+				Luint32 u32Sweeps;
+
+			}sSched;
+
+		#if C_LOCALDEF__LCCM644__ENABLE_ROM_CACHE == 1U
+			/** EEPROM copy of the device table */
+			struct
+			{
+
+				/** 1 = the device table in RAM has been written to EEPROM */
+				Luint8 u8Stored;
+
+				/** 1 = the table was loaded from EEPROM and has not yet survived a full sweep */
+				Luint8 u8Verify;
+
+			}sCache;
+		#endif
+
 			//Temporaray scratch pad, save stack
 			Luint8 u8TempScratch[9U];
 
@@ -129,6 +178,7 @@
 		Lint16 s16DS18B20_TEMP__All_Request(Luint8 u8DSIndex, Luint8 u8Wait);
 		Lint16 s16DS18B20_TEMP__Set_Resolution(Luint8 u8DSIndex, Luint8 u8Resolution);
 		Lint16 s16DS18B20_TEMP__Get_Resolution(Luint8 u8DSIndex, Luint8 *pu8Resolution);
+		void vDS18B20_TEMP__Scratch_To_Temp(Luint8 u8DSIndex, const Luint8 *pu8Scratch, Lfloat32 *pf32Temp);
 
 		//alarms
 		void vDS18B20_ALARMS__Init(void);
@@ -155,6 +205,24 @@
 		Lint16 s16DS18B20_1WIRE__Skip(Luint8 u8DeviceIndex);
 		Lint16 s16DS18B20_SEARCH__SearchFirstDevice(Luint8 u8DeviceIndex, Luint8 *pu8Addx);
 		Lint16 s16DS18B20_SEARCH__SearchNextDevice(Luint8 u8DeviceIndex, Luint8 *pu8Addx);
+		Lint16 s16DS18B20_1WIRE__Poll_Busy(Luint8 u8DeviceIndex, Luint8 *pu8Status);
+		Lint16 s16DS18B20_1WIRE__Start_Reset(Luint8 u8DeviceIndex);
+		Lint16 s16DS18B20_1WIRE__Start_WriteByte(Luint8 u8DeviceIndex, Luint8 u8Byte);
+		Lint16 s16DS18B20_1WIRE__Start_ReadByte(Luint8 u8DeviceIndex);
+		Lint16 s16DS18B20_1WIRE__Collect_Byte(Luint8 u8DeviceIndex, Luint8 *pu8Byte);
+
+		//multi channel scheduler
+		void vDS18B20_SCHED__Init(void);
+		void vDS18B20_SCHED__Start_Convert(void);
+		void vDS18B20_SCHED__Start_Read(void);
+		Luint8 u8DS18B20_SCHED__Process(void);
+
+		//ROM table cache
+		#if C_LOCALDEF__LCCM644__ENABLE_ROM_CACHE == 1U
+			Lint16 s16DS18B20_ROMCACHE__Load(void);
+			void vDS18B20_ROMCACHE__Store(void);
+			void vDS18B20_ROMCACHE__Invalidate(void);
+		#endif
 		
 		//delay interface
 		void vDS18B20_DELAYS__Delay_uS(Luint32 u32Value);
@@ -167,6 +235,16 @@
 		#ifndef C_LOCALDEF__LCCM644__MAX_1WIRE_CHANNELS
 			#error
 		#endif
+		#ifndef C_LOCALDEF__LCCM644__SCHED_STEPS_PER_PROCESS
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM644__ENABLE_ROM_CACHE
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM644__MAX_1WIRE_CHANNELS > 16U
+			//the ROM cache packs the channel into a nibble
+			#error
+		#endif
 
 	#endif /*#if C_LOCALDEF__LCCM644__ENABLE_THIS_MODULE == 1U*/
 	/*safetys*/
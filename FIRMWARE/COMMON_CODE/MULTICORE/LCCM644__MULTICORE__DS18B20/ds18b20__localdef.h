@@ -51,6 +51,19 @@ DS18B20 - 1-Wire Temperature Sensor
 		 */
 		#define C_LOCALDEF__LCCM644__MAX_1WIRE_CHANNELS						(1U)
 
+		/** Upper limit on the number of scheduler steps (one I2C transaction each)
+		 * made per call to vDS18B20__Process(). Each step services the next
+		 * 1-wire channel that is not busy so the channels overlap on the wire.
+		 */
+		#define C_LOCALDEF__LCCM644__SCHED_STEPS_PER_PROCESS				(32U)
+
+		/** Keep a CRC protected copy of the device table in the EEPROM params
+		 * (LCCM188) so a warm boot can skip the ROM search.
+		 * Uses 3 + (2 x MAX_DEVICES) parameters starting at the given index.
+		 */
+		#define C_LOCALDEF__LCCM644__ENABLE_ROM_CACHE						(0U)
+		#define C_LOCALDEF__LCCM644__ROM_CACHE__EEPROM_INDEX				(0U)
+
 		/** Testing Options */
 		#define C_LOCALDEF__LCCM644__ENABLE_TEST_SPEC						(0U)
 
@@ -33,6 +33,9 @@
 		/** Start to convert all sensors */
 		DS18B20_STATE__START_CONVERT_ALL,
 
+		/** Convert-T is being issued on each 1-wire channel */
+		DS18B20_STATE__ISSUE_CONVERT,
+
 		/** Wait for the conversion to finish, if needed. */
 		DS18B20_STATE__WAIT_CONVERT,
 
@@ -67,4 +70,39 @@
 
 	}E_DS18B20_SEARCH_T;
 
+
+	/** Per 1-wire channel scheduler states. Every state other than IDLE and
+	 * DECODE needs the DS2482 to be out of 1WB before it can move */
+	typedef enum
+	{
+
+		/** Nothing left to do on this channel */
+		DS18B20_BUS__IDLE = 0U,
+
+		/** Issue the 1-wire reset */
+		DS18B20_BUS__RESET,
+
+		/** Wait for the reset, check presence / short */
+		DS18B20_BUS__PRESENCE,
+
+		/** Skip ROM ahead of a Convert-T */
+		DS18B20_BUS__SKIP,
+
+		/** Issue Convert-T to everything on the channel */
+		DS18B20_BUS__CONVERT,
+
+		/** Match ROM + the device serial + read scratchpad command */
+		DS18B20_BUS__MATCH,
+
+		/** Start a scratchpad byte read */
+		DS18B20_BUS__READ,
+
+		/** Collect the scratchpad byte */
+		DS18B20_BUS__COLLECT,
+
+		/** CRC check and convert the scratchpad, move to the next device */
+		DS18B20_BUS__DECODE
+
+	}E_DS18B20__BUS_STATES;
+
 #endif /* __DS18B20_DS18B20__STATE_TYPES_H_ */
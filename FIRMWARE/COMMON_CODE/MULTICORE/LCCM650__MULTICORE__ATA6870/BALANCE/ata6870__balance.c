@@ -1,6 +1,21 @@
 /**
  * @file		ATA6870__BALANCE.C
  * @brief		Balancing subsystem
+ *
+ * @note
+ * Pack stats are kept incrementally. Each device's min / max / sum is worked
+ * out in one pass as its burst is read and the modules are folded into the
+ * pack at the end of the sweep, nothing rescans f32Voltage[].
+ *
+ * Balancing runs in windows. With every resistor off the cells are averaged
+ * over a rest, the cells above the rest min (plus half the target) are picked,
+ * highest first, up to a per device limit that halves when the device is warm
+ * and goes to zero at the cutoff, then they bleed for the window. Only rest
+ * voltages are planned from as bleeding pulls the readings down. Done once the
+ * resting spread is inside the target.
+ *
+ * The balancer itself (Ctrl_xxx) works on any number of modules through a
+ * context so a whole pack can be simulated on the host.
  * @author		Lachlan Grogan
  * @copyright	This file contains proprietary and confidential information of
  *				SIL3 Pty. Ltd. (ACN 123 529 064). This code may be distributed
@@ -28,6 +43,11 @@
 //main structure
 extern struct _str6870 sATA6870;
 
+//locals
+static Luint8 u8ATA6870_BALANCE__Plan(const ATA6870__BALANCER_T *pCtrl, Luint16 u16Module);
+static void vATA6870_BALANCE__Pack_Fold(ATA6870__PACK_STATS_T *pPack, const ATA6870__MODULE_STATS_T *pModule, Luint16 u16Module);
+static void vATA6870_BALANCE__Pack_Finish(ATA6870__PACK_STATS_T *pPack, Luint16 u16NumModules);
+
 /***************************************************************************//**
  * @brief
  * Init any balancer systems
@@ -37,9 +57,28 @@ extern struct _str6870 sATA6870;
  */
 void vATA6870_BALANCE__Init(void)
 {
+	Luint8 u8Counter;
 
 	//init the variables
-	sATA6870.sBalance.eState = BALANCE_STATE__IDLE;
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Counter++)
+	{
+		sATA6870.sBalance.sModule[u8Counter].f32Sum = 0.0F;
+		sATA6870.sBalance.sModule[u8Counter].f32Min = 0.0F;
+		sATA6870.sBalance.sModule[u8Counter].f32Max = 0.0F;
+		sATA6870.sBalance.sModule[u8Counter].u8MinCell = 0U;
+		sATA6870.sBalance.sModule[u8Counter].u8MaxCell = 0U;
+		sATA6870.sBalance.f32TempC[u8Counter] = 0.0F;
+		sATA6870.sBalance.u8Sent[u8Counter] = 0U;
+	}
+	vATA6870_BALANCE__Pack_Stats(&sATA6870.sBalance.sModule[0], C_LOCALDEF__LCCM650__NUM_DEVICES, &sATA6870.sBalance.sPack);
+	sATA6870.sBalance.u8NewSweep = 0U;
+
+	vATA6870_BALANCE__Ctrl_Init(&sATA6870.sBalance.sCtrl,
+								C_LOCALDEF__LCCM650__NUM_DEVICES,
+								&sATA6870.f32Voltage[0],
+								&sATA6870.sBalance.f32TempC[0],
+								&sATA6870.sBalance.f32Rest[0],
+								&sATA6870.sBalance.u8Mask[0]);
 
 }
 
@@ -47,12 +86,20 @@ void vATA6870_BALANCE__Init(void)
  * @brief
  * Start the balancing process.
  * 
+ * @note
+ * Does nothing unless C_LOCALDEF__LCCM650__ENABLE_BALANCING is set, without
+ * a calibrated NTC the thermal cutoff can't be trusted.
+ *
  * @st_funcMD5		0003B1996E14215C56A9FFF33E5D0590
  * @st_funcID		LCCM650R0.FILE.012.FUNC.002
  */
 void vATA6870_BALANCE__Start(void)
 {
-	
+#if C_LOCALDEF__LCCM650__ENABLE_BALANCING == 1U
+	vATA6870_BALANCE__Ctrl_Start(&sATA6870.sBalance.sCtrl);
+#else
+	//balancing is off in the localdef
+#endif
 }
 
 
@@ -65,7 +112,8 @@ void vATA6870_BALANCE__Start(void)
  */
 void vATA6870_BALANCE__Stop(void)
 {
-
+	//the resistors go off on the next process
+	vATA6870_BALANCE__Ctrl_Stop(&sATA6870.sBalance.sCtrl);
 }
 
 /***************************************************************************//**
@@ -79,8 +127,18 @@ void vATA6870_BALANCE__Stop(void)
  */
 Luint8 u8ATA6870_BALANCE__Is_Busy(void)
 {
+	Luint8 u8Return;
 
-	return 0;
+	if(sATA6870.sBalance.sCtrl.eState == BALANCE_STATE__IDLE)
+	{
+		u8Return = 0U;
+	}
+	else
+	{
+		u8Return = 1U;
+	}
+
+	return u8Return;
 }
 
 /***************************************************************************//**
@@ -92,15 +150,621 @@ Luint8 u8ATA6870_BALANCE__Is_Busy(void)
  */
 void vATA6870_BALANCE__Process(void)
 {
+	Luint8 u8Counter;
+
+	//one step per sweep of the chain
+	if(sATA6870.sBalance.u8NewSweep == 1U)
+	{
+		sATA6870.sBalance.u8NewSweep = 0U;
+		vATA6870_BALANCE__Ctrl_Sweep(&sATA6870.sBalance.sCtrl);
+	}
+	else
+	{
+		//fall on
+	}
+
+	//only the masks that changed go to the engine
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Counter++)
+	{
+		if(sATA6870.sBalance.u8Mask[u8Counter] != sATA6870.sBalance.u8Sent[u8Counter])
+		{
+			vATA6870_RES__Set_Mask(u8Counter, sATA6870.sBalance.u8Mask[u8Counter]);
+			sATA6870.sBalance.u8Sent[u8Counter] = sATA6870.sBalance.u8Mask[u8Counter];
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Sum, min and max of a device's cells in one pass.
+ *
+ * @param[out]		*pModule				The stats
+ * @param[in]		*pf32Cells				The 6 cells
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.006
+ */
+void vATA6870_BALANCE__Module_Stats(const Lfloat32 *pf32Cells, ATA6870__MODULE_STATS_T *pModule)
+{
+	Luint8 u8Counter;
+	Lfloat32 f32Cell;
+	Lfloat32 f32Sum;
+	Lfloat32 f32Min;
+	Lfloat32 f32Max;
+	Luint8 u8MinCell;
+	Luint8 u8MaxCell;
+
+	f32Sum = pf32Cells[0];
+	f32Min = pf32Cells[0];
+	f32Max = pf32Cells[0];
+	u8MinCell = 0U;
+	u8MaxCell = 0U;
+
+	for(u8Counter = 1U; u8Counter < C_ATA6870__MAX_CELLS; u8Counter++)
+	{
+		f32Cell = pf32Cells[u8Counter];
+		f32Sum += f32Cell;
+		if(f32Cell < f32Min)
+		{
+			f32Min = f32Cell;
+			u8MinCell = u8Counter;
+		}
+		else if(f32Cell > f32Max)
+		{
+			f32Max = f32Cell;
+			u8MaxCell = u8Counter;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	pModule->f32Sum = f32Sum;
+	pModule->f32Min = f32Min;
+	pModule->f32Max = f32Max;
+	pModule->u8MinCell = u8MinCell;
+	pModule->u8MaxCell = u8MaxCell;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Fold the module stats into the pack stats.
+ *
+ * @param[out]		*pPack					The pack stats
+ * @param[in]		u16NumModules			Number of modules
+ * @param[in]		*pModules				The module stats
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.007
+ */
+void vATA6870_BALANCE__Pack_Stats(const ATA6870__MODULE_STATS_T *pModules, Luint16 u16NumModules, ATA6870__PACK_STATS_T *pPack)
+{
+	Luint16 u16Counter;
 
-	switch(sATA6870.sBalance.eState)
+	for(u16Counter = 0U; u16Counter < u16NumModules; u16Counter++)
+	{
+		vATA6870_BALANCE__Pack_Fold(pPack, &pModules[u16Counter], u16Counter);
+	}
+	vATA6870_BALANCE__Pack_Finish(pPack, u16NumModules);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * A device's burst has been unpacked, update its stats and temperature.
+ *
+ * @note
+ * Called by the engine.
+ *
+ * @param[in]		u8DeviceIndex			The device in the chain
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.008
+ */
+void vATA6870_BALANCE__Module_Update(Luint8 u8DeviceIndex)
+{
+
+	vATA6870_BALANCE__Module_Stats(&sATA6870.f32Voltage[(Luint32)u8DeviceIndex * C_ATA6870__MAX_CELLS], &sATA6870.sBalance.sModule[u8DeviceIndex]);
+#if C_LOCALDEF__LCCM650__ENABLE_BALANCING == 1U
+	sATA6870.sBalance.f32TempC[u8DeviceIndex] = M_LOCALDEF__LCCM650__NTC_TO_DEGC(sATA6870.f32NTCTemperatureReading[u8DeviceIndex]);
+#endif
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * The whole chain has been read, update the pack stats and step the balancer
+ * on the next process.
+ *
+ * @note
+ * Called by the engine.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.009
+ */
+void vATA6870_BALANCE__Sweep_Done(void)
+{
+	vATA6870_BALANCE__Pack_Stats(&sATA6870.sBalance.sModule[0], C_LOCALDEF__LCCM650__NUM_DEVICES, &sATA6870.sBalance.sPack);
+	sATA6870.sBalance.u8NewSweep = 1U;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Set up a balancer over the caller's arrays.
+ *
+ * @param[out]		*pu8Mask				Discharge masks, one per module
+ * @param[out]		*pf32Rest				Rest averages, 6 per module
+ * @param[in]		*pf32TempC				Module temperatures
+ * @param[in]		*pf32Cells				Live cells, 6 per module
+ * @param[in]		u16NumModules			Number of 6 cell modules
+ * @param[out]		*pCtrl					The balancer
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.010
+ */
+void vATA6870_BALANCE__Ctrl_Init(ATA6870__BALANCER_T *pCtrl, Luint16 u16NumModules, const Lfloat32 *pf32Cells, const Lfloat32 *pf32TempC, Lfloat32 *pf32Rest, Luint8 *pu8Mask)
+{
+	Luint32 u32Counter;
+
+	pCtrl->u16NumModules = u16NumModules;
+	pCtrl->pf32Cells = pf32Cells;
+	pCtrl->pf32TempC = pf32TempC;
+	pCtrl->pf32Rest = pf32Rest;
+	pCtrl->pu8Mask = pu8Mask;
+
+	for(u32Counter = 0U; u32Counter < ((Luint32)u16NumModules * C_ATA6870__MAX_CELLS); u32Counter++)
+	{
+		pf32Rest[u32Counter] = 0.0F;
+	}
+
+	pCtrl->f32Floor = 0.0F;
+	pCtrl->sRest.f32Sum = 0.0F;
+	pCtrl->sRest.f32Min = 0.0F;
+	pCtrl->sRest.f32Max = 0.0F;
+	pCtrl->sRest.f32Mean = 0.0F;
+	pCtrl->sRest.f32Spread = 0.0F;
+	pCtrl->sRest.u16MinCell = 0U;
+	pCtrl->sRest.u16MaxCell = 0U;
+	pCtrl->u32Windows = 0U;
+	pCtrl->u32ThermalTrips = 0U;
+	pCtrl->u8Done = 0U;
+
+	vATA6870_BALANCE__Ctrl_Stop(pCtrl);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Start balancing, the first rest begins on the next sweep.
+ *
+ * @param[in]		*pCtrl					The balancer
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.011
+ */
+void vATA6870_BALANCE__Ctrl_Start(ATA6870__BALANCER_T *pCtrl)
+{
+	Luint16 u16Counter;
+
+	for(u16Counter = 0U; u16Counter < pCtrl->u16NumModules; u16Counter++)
+	{
+		pCtrl->pu8Mask[u16Counter] = 0U;
+	}
+
+	pCtrl->u16Sweeps = 0U;
+	pCtrl->u32Windows = 0U;
+	pCtrl->u32ThermalTrips = 0U;
+	pCtrl->u8Done = 0U;
+	pCtrl->eState = BALANCE_STATE__REST;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Stop balancing, every resistor off.
+ *
+ * @param[in]		*pCtrl					The balancer
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.012
+ */
+void vATA6870_BALANCE__Ctrl_Stop(ATA6870__BALANCER_T *pCtrl)
+{
+	Luint16 u16Counter;
+
+	for(u16Counter = 0U; u16Counter < pCtrl->u16NumModules; u16Counter++)
+	{
+		pCtrl->pu8Mask[u16Counter] = 0U;
+	}
+
+	pCtrl->u16Sweeps = 0U;
+	pCtrl->eState = BALANCE_STATE__IDLE;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Step the balancer, call once per sweep after the cells and temperatures
+ * have been updated.
+ *
+ * @param[in]		*pCtrl					The balancer
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.013
+ */
+void vATA6870_BALANCE__Ctrl_Sweep(ATA6870__BALANCER_T *pCtrl)
+{
+	Luint32 u32Counter;
+	Luint32 u32NumCells;
+	Luint16 u16Module;
+	Luint8 u8Plan;
+	Lfloat32 f32Scale;
+	ATA6870__MODULE_STATS_T sModule;
+
+	u32NumCells = (Luint32)pCtrl->u16NumModules * C_ATA6870__MAX_CELLS;
+
+	switch(pCtrl->eState)
 	{
 
 		case BALANCE_STATE__IDLE:
 			//do nothing.
 			break;
 
-	}//switch(sATA6870.sBalance.eState)
+		case BALANCE_STATE__REST:
+			pCtrl->u16Sweeps++;
+
+			//the first sweep may have started with resistors on
+			if(pCtrl->u16Sweeps == 2U)
+			{
+				for(u32Counter = 0U; u32Counter < u32NumCells; u32Counter++)
+				{
+					pCtrl->pf32Rest[u32Counter] = pCtrl->pf32Cells[u32Counter];
+				}
+			}
+			else if(pCtrl->u16Sweeps > 2U)
+			{
+				for(u32Counter = 0U; u32Counter < u32NumCells; u32Counter++)
+				{
+					pCtrl->pf32Rest[u32Counter] += pCtrl->pf32Cells[u32Counter];
+				}
+			}
+			else
+			{
+				//fall on
+			}
+
+			if(pCtrl->u16Sweeps >= C_ATA6870__BALANCE_REST_SWEEPS)
+			{
+				//average and take the stats of the rest in the same pass
+				f32Scale = 1.0F / (Lfloat32)(C_ATA6870__BALANCE_REST_SWEEPS - 1U);
+				for(u16Module = 0U; u16Module < pCtrl->u16NumModules; u16Module++)
+				{
+					for(u32Counter = 0U; u32Counter < C_ATA6870__MAX_CELLS; u32Counter++)
+					{
+						pCtrl->pf32Rest[((Luint32)u16Module * C_ATA6870__MAX_CELLS) + u32Counter] *= f32Scale;
+					}
+					vATA6870_BALANCE__Module_Stats(&pCtrl->pf32Rest[(Luint32)u16Module * C_ATA6870__MAX_CELLS], &sModule);
+					vATA6870_BALANCE__Pack_Fold(&pCtrl->sRest, &sModule, u16Module);
+				}
+				vATA6870_BALANCE__Pack_Finish(&pCtrl->sRest, pCtrl->u16NumModules);
+
+				if(pCtrl->sRest.f32Spread <= C_ATA6870__BALANCE_TARGET_V)
+				{
+					//balanced, the resistors are already off
+					pCtrl->u8Done = 1U;
+					pCtrl->eState = BALANCE_STATE__IDLE;
+				}
+				else
+				{
+					//bleed everything worth bleeding
+					pCtrl->f32Floor = pCtrl->sRest.f32Min + (C_ATA6870__BALANCE_TARGET_V * 0.5F);
+					for(u16Module = 0U; u16Module < pCtrl->u16NumModules; u16Module++)
+					{
+						pCtrl->pu8Mask[u16Module] = u8ATA6870_BALANCE__Plan(pCtrl, u16Module);
+					}
+					pCtrl->u32Windows++;
+					pCtrl->eState = BALANCE_STATE__BLEED;
+				}
+				pCtrl->u16Sweeps = 0U;
+			}
+			else
+			{
+				//keep resting
+			}
+			break;
+
+		case BALANCE_STATE__BLEED:
+			pCtrl->u16Sweeps++;
+
+			if(pCtrl->u16Sweeps >= C_ATA6870__BALANCE_ON_SWEEPS)
+			{
+				//window over, all off and rest
+				for(u16Module = 0U; u16Module < pCtrl->u16NumModules; u16Module++)
+				{
+					pCtrl->pu8Mask[u16Module] = 0U;
+				}
+				pCtrl->u16Sweeps = 0U;
+				pCtrl->eState = BALANCE_STATE__REST;
+			}
+			else
+			{
+				//a device that warms up sheds its lowest cells, never picks up more
+				for(u16Module = 0U; u16Module < pCtrl->u16NumModules; u16Module++)
+				{
+					u8Plan = u8ATA6870_BALANCE__Plan(pCtrl, u16Module);
+					if((pCtrl->pu8Mask[u16Module] != 0U) && (u8Plan == 0U))
+					{
+						pCtrl->u32ThermalTrips++;
+					}
+					else
+					{
+						//fall on
+					}
+					pCtrl->pu8Mask[u16Module] &= u8Plan;
+				}
+			}
+			break;
+
+		default:
+			//not possible
+			vATA6870_BALANCE__Ctrl_Stop(pCtrl);
+			break;
+
+	}//switch(pCtrl->eState)
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Pack voltage of the last sweep.
+ *
+ * @return			Volts
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.014
+ */
+Lfloat32 f32ATA6870_BALANCE__Get_PackVolts(void)
+{
+	return sATA6870.sBalance.sPack.f32Sum;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Lowest cell of the last sweep.
+ *
+ * @return			Volts
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.015
+ */
+Lfloat32 f32ATA6870_BALANCE__Get_CellMin(void)
+{
+	return sATA6870.sBalance.sPack.f32Min;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Highest cell of the last sweep.
+ *
+ * @return			Volts
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.016
+ */
+Lfloat32 f32ATA6870_BALANCE__Get_CellMax(void)
+{
+	return sATA6870.sBalance.sPack.f32Max;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Mean cell of the last sweep.
+ *
+ * @return			Volts
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.017
+ */
+Lfloat32 f32ATA6870_BALANCE__Get_CellMean(void)
+{
+	return sATA6870.sBalance.sPack.f32Mean;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Max - min cell of the last sweep.
+ *
+ * @return			Volts
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.018
+ */
+Lfloat32 f32ATA6870_BALANCE__Get_Spread(void)
+{
+	return sATA6870.sBalance.sPack.f32Spread;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Number of discharge resistors on.
+ *
+ * @return			Resistors across the chain
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.019
+ */
+Luint16 u16ATA6870_BALANCE__Get_Bleeding(void)
+{
+	Luint8 u8Counter;
+	Luint8 u8Mask;
+	Luint16 u16Return;
+
+	u16Return = 0U;
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Counter++)
+	{
+		u8Mask = sATA6870.sBalance.u8Sent[u8Counter];
+		while(u8Mask != 0U)
+		{
+			//clear the lowest bit
+			u8Mask &= (Luint8)(u8Mask - 1U);
+			u16Return++;
+		}
+	}
+
+	return u16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Pick the cells of a module to bleed.
+ *
+ * @note
+ * Highest rest voltage first, only above the floor, as many as the device
+ * temperature allows.
+ *
+ * @param[in]		u16Module				The module
+ * @param[in]		*pCtrl					The balancer
+ * @return			Discharge mask
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.020
+ */
+static Luint8 u8ATA6870_BALANCE__Plan(const ATA6870__BALANCER_T *pCtrl, Luint16 u16Module)
+{
+	Luint8 u8Allowed;
+	Luint8 u8Mask;
+	Luint8 u8Pick;
+	Luint8 u8Cell;
+	Luint8 u8Best;
+	Luint8 u8Bit;
+	Lfloat32 f32Best;
+	Lfloat32 f32Temp;
+	const Lfloat32 *pf32Rest;
+
+	f32Temp = pCtrl->pf32TempC[u16Module];
+	if(f32Temp >= C_ATA6870__BALANCE_CUTOFF_DEGC)
+	{
+		u8Allowed = 0U;
+	}
+	else if(f32Temp >= C_ATA6870__BALANCE_DERATE_DEGC)
+	{
+		u8Allowed = (Luint8)(C_ATA6870__BALANCE_MAX_PER_DEVICE >> 1U);
+		if(u8Allowed == 0U)
+		{
+			u8Allowed = 1U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	else
+	{
+		u8Allowed = (Luint8)C_ATA6870__BALANCE_MAX_PER_DEVICE;
+	}
+
+	pf32Rest = &pCtrl->pf32Rest[(Luint32)u16Module * C_ATA6870__MAX_CELLS];
+	u8Mask = 0U;
+	for(u8Pick = 0U; u8Pick < u8Allowed; u8Pick++)
+	{
+		u8Best = 0xFFU;
+		f32Best = pCtrl->f32Floor;
+		for(u8Cell = 0U; u8Cell < C_ATA6870__MAX_CELLS; u8Cell++)
+		{
+			u8Bit = (Luint8)(1U << u8Cell);
+			if(((u8Mask & u8Bit) == 0U) && (pf32Rest[u8Cell] > f32Best))
+			{
+				f32Best = pf32Rest[u8Cell];
+				u8Best = u8Cell;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+
+		if(u8Best != 0xFFU)
+		{
+			u8Mask |= (Luint8)(1U << u8Best);
+		}
+		else
+		{
+			//nothing left above the floor
+		}
+	}
+
+	return u8Mask;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Fold one module into the pack stats, module 0 starts them.
+ *
+ * @param[in]		u16Module				Module index in the pack
+ * @param[in]		*pModule				The module stats
+ * @param[in,out]	*pPack					The pack stats
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.021
+ */
+static void vATA6870_BALANCE__Pack_Fold(ATA6870__PACK_STATS_T *pPack, const ATA6870__MODULE_STATS_T *pModule, Luint16 u16Module)
+{
+	Luint16 u16First;
+
+	u16First = (Luint16)(u16Module * C_ATA6870__MAX_CELLS);
+
+	if(u16Module == 0U)
+	{
+		pPack->f32Sum = pModule->f32Sum;
+		pPack->f32Min = pModule->f32Min;
+		pPack->f32Max = pModule->f32Max;
+		pPack->u16MinCell = u16First + (Luint16)pModule->u8MinCell;
+		pPack->u16MaxCell = u16First + (Luint16)pModule->u8MaxCell;
+	}
+	else
+	{
+		pPack->f32Sum += pModule->f32Sum;
+		if(pModule->f32Min < pPack->f32Min)
+		{
+			pPack->f32Min = pModule->f32Min;
+			pPack->u16MinCell = u16First + (Luint16)pModule->u8MinCell;
+		}
+		else
+		{
+			//fall on
+		}
+		if(pModule->f32Max > pPack->f32Max)
+		{
+			pPack->f32Max = pModule->f32Max;
+			pPack->u16MaxCell = u16First + (Luint16)pModule->u8MaxCell;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Mean and spread once every module has been folded in.
+ *
+ * @param[in]		u16NumModules			Modules folded
+ * @param[in,out]	*pPack					The pack stats
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.012.FUNC.022
+ */
+static void vATA6870_BALANCE__Pack_Finish(ATA6870__PACK_STATS_T *pPack, Luint16 u16NumModules)
+{
+
+	if(u16NumModules > 0U)
+	{
+		pPack->f32Mean = pPack->f32Sum / ((Lfloat32)u16NumModules * (Lfloat32)C_ATA6870__MAX_CELLS);
+		pPack->f32Spread = pPack->f32Max - pPack->f32Min;
+	}
+	else
+	{
+		pPack->f32Sum = 0.0F;
+		pPack->f32Min = 0.0F;
+		pPack->f32Max = 0.0F;
+		pPack->f32Mean = 0.0F;
+		pPack->f32Spread = 0.0F;
+		pPack->u16MinCell = 0U;
+		pPack->u16MaxCell = 0U;
+	}
 
 }
 
@@ -115,4 +779,3 @@ void vATA6870_BALANCE__Process(void)
 #ifndef C_LOCALDEF__LCCM650__ENABLE_THIS_MODULE
 	#error
 #endif
-
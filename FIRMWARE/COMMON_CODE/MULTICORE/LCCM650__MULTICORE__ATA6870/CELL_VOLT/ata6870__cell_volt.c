@@ -46,14 +46,6 @@ extern struct _str6870 sATA6870;
  */
 void vATA6870_CELL__Get_Voltages(Luint8 u8DeviceIndex, Lfloat32 *pf32Voltages, Lfloat32 *pF32Temperature)
 {
-	Luint8 u8Counter;
-	Lfloat32 f32Temp;
-	union
-	{
-		Luint16 u16;
-		Luint8 u8[2];
-	}unT;
-	
 	//14 bytes of local memory, reviewed.
 	//We also have to return the temperature value in this
 	Luint8 u8Buffer[C_ATA6870__BUSRT_LENGTH];
@@ -66,11 +58,39 @@ void vATA6870_CELL__Get_Voltages(Luint8 u8DeviceIndex, Lfloat32 *pf32Voltages, L
 	//review the status and make sure we did not get a tiemout or data corruption
 	
 	//do the conversions
+	vATA6870_CELL__Unpack(&u8Buffer[0], pf32Voltages, pF32Temperature);
+	
+}
+
+/***************************************************************************//**
+ * @brief
+ * Convert the 14 bytes of a burst read into cell voltages and temperature
+ * 
+ * @note
+ * Shared by the blocking read above and the acquisition engine which hands
+ * over the data part of its burst frame.
+ *
+ * @param[out]		*pF32Temperature		The returned temperature reading from the NTC
+ * @param[out]		*pf32Voltages			An array of 6 Cell voltages
+ * @param[in]		*pu8Buffer				The C_ATA6870__BUSRT_LENGTH bytes of the burst
+ * @st_funcMD5		
+ * @st_funcID		LCCM650R0.FILE.011.FUNC.003
+ */
+void vATA6870_CELL__Unpack(const Luint8 *pu8Buffer, Lfloat32 *pf32Voltages, Lfloat32 *pF32Temperature)
+{
+	Luint8 u8Counter;
+	Lfloat32 f32Temp;
+	union
+	{
+		Luint16 u16;
+		Luint8 u8[2];
+	}unT;
+
 	for(u8Counter = 0U; u8Counter < C_ATA6870__MAX_CELLS; u8Counter++)
 	{
 		//convert
-		unT.u8[0] = u8Buffer[1 + (u8Counter * 2U)];
-		unT.u8[1] = u8Buffer[0 + (u8Counter * 2U)];
+		unT.u8[0] = pu8Buffer[1 + (u8Counter * 2U)];
+		unT.u8[1] = pu8Buffer[0 + (u8Counter * 2U)];
 	
 		//unpack
 		f32Temp = (Lfloat32)unT.u16;
@@ -83,8 +103,8 @@ void vATA6870_CELL__Get_Voltages(Luint8 u8DeviceIndex, Lfloat32 *pf32Voltages, L
 	}
 
 	//last two are the temp reading, we can save this off elsewhere
-	unT.u8[0] = u8Buffer[C_ATA6870__BUSRT_LENGTH - 2U];
-	unT.u8[1] = u8Buffer[C_ATA6870__BUSRT_LENGTH - 1U];
+	unT.u8[0] = pu8Buffer[C_ATA6870__BUSRT_LENGTH - 2U];
+	unT.u8[1] = pu8Buffer[C_ATA6870__BUSRT_LENGTH - 1U];
 
 	//unpack
 	//todo, check temp value
@@ -93,7 +113,7 @@ void vATA6870_CELL__Get_Voltages(Luint8 u8DeviceIndex, Lfloat32 *pf32Voltages, L
 	
 	//assign
 	*pF32Temperature = f32Temp;
-	
+
 }
 
 
@@ -0,0 +1,613 @@
+/**
+ * @file		ATA6870__ENGINE.C
+ * @brief		Non blocking acquisition engine for the ATA6870 chain
+ *
+ * @note
+ * Every SPI frame the scan needs (ID + control + data + CRC) is built once at
+ * init for each device. The engine then hands whole frames to
+ * M_LOCALDEF__LCCM650__SPI_XFER_START() and checks
+ * M_LOCALDEF__LCCM650__SPI_XFER_BUSY() on the next pass, so with a MibSPI
+ * transfer group / DMA behind those hooks the main loop never waits on the bus.
+ *
+ * Each device runs its own cycle:
+ * CLEAR_IRQ -> START -> CONVERTING (op status polls) -> READ -> CLEAR_IRQ
+ * and is restarted the moment its burst has been read. All the devices convert
+ * at the same time, so a sweep of the chain takes one conversion time plus the
+ * transfer time rather than a fixed wait per device.
+ *
+ * Discharge mask writes for the balancer jump the queue, they are one short
+ * frame and do not change where the device is in its cycle.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	This file contains proprietary and confidential information of
+ *				SIL3 Pty. Ltd. (ACN 123 529 064). This code may be distributed
+ *				under a license from SIL3 Pty. Ltd., and may be used, copied
+ *				and/or disclosed only pursuant to the terms of that license agreement.
+ *				This copyright notice must be retained as part of this file at all times.
+ * @copyright	This file is copyright SIL3 Pty. Ltd. 2003-2016, All Rights Reserved.
+ * @st_fileID	LCCM650R0.FILE.013
+ */
+/**
+ * @addtogroup MULTICORE
+ * @{ */
+/**
+ * @addtogroup ATA6870
+ * @ingroup MULTICORE
+ * @{ */
+/**
+ * @addtogroup ATA6870__ENGINE
+ * @ingroup ATA6870
+ * @{ */
+
+#include "../ata6870.h"
+#if C_LOCALDEF__LCCM650__ENABLE_THIS_MODULE == 1U
+
+//main structure
+extern struct _str6870 sATA6870;
+
+//ID + control before the data
+#define C_ATA6870_ENGINE__HEADER_LENGTH					(3U)
+
+//the CRC byte only goes on the wire if enabled
+#if C_LOCALDEF__LCCM650__ENABLE_CRC == 1U
+	#define C_ATA6870_ENGINE__CRC_LENGTH				(1U)
+#else
+	#define C_ATA6870_ENGINE__CRC_LENGTH				(0U)
+#endif
+
+/** Data bytes of each frame type, in E_ATA6870__FRAME_T order */
+static const Luint8 u8ATA6870_ENGINE__DataLength[ATA6870_FRAME__NUM] = {1U, 1U, 1U, 1U, C_ATA6870__BUSRT_LENGTH, 1U};
+
+//locals
+static void vATA6870_ENGINE__Build_Frame(Luint8 u8DeviceIndex, E_ATA6870__FRAME_T eFrame, ATA6870_REGS_T eRegister, Luint8 u8Write, Luint8 u8Data);
+static void vATA6870_ENGINE__Next_Frame(void);
+static void vATA6870_ENGINE__Frame_Done(void);
+
+/***************************************************************************//**
+ * @brief
+ * Build the frames for every device and reset the engine.
+ *
+ * @note
+ * The CRC uses the lowlevel LFSR so the frames are byte for byte what
+ * vATA6870_LOWLEVEL__Reg_WriteU8() / Reg_ReadU8() would clock out.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.013.FUNC.001
+ */
+void vATA6870_ENGINE__Init(void)
+{
+	Luint8 u8Counter;
+
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Counter++)
+	{
+		vATA6870_ENGINE__Build_Frame(u8Counter, ATA6870_FRAME__IRQ_STATUS, ATA6870_REG__IRQ_STATUS, 0U, 0x00U);
+		vATA6870_ENGINE__Build_Frame(u8Counter, ATA6870_FRAME__OP_STATUS, ATA6870_REG__OP_STATUS, 0U, 0x00U);
+		vATA6870_ENGINE__Build_Frame(u8Counter, ATA6870_FRAME__OP_CANCEL, ATA6870_REG__OPERATION, 1U, 0x00U);
+		vATA6870_ENGINE__Build_Frame(u8Counter, ATA6870_FRAME__OP_START, ATA6870_REG__OPERATION, 1U, (Luint8)C_ATA6870__OP_START);
+		vATA6870_ENGINE__Build_Frame(u8Counter, ATA6870_FRAME__BURST, ATA6870_REG__DATA_RD16_BURST, 0U, 0x00U);
+		vATA6870_ENGINE__Build_Frame(u8Counter, ATA6870_FRAME__DISCHARGE, ATA6870_REG__CH_DISCHARGE, 1U, 0x00U);
+
+		sATA6870.sEngine.sDevice[u8Counter].eState = ATA6870_DEV__CHECK_OP;
+		sATA6870.sEngine.sDevice[u8Counter].u8Discharge = 0U;
+		sATA6870.sEngine.sDevice[u8Counter].u8DischargePending = 0U;
+		sATA6870.sDevice[u8Counter].sIRQ.u8Status = 0U;
+	}
+
+	sATA6870.sEngine.eBus = ATA6870_BUS__IDLE;
+	sATA6870.sEngine.u8Device = 0U;
+	sATA6870.sEngine.eFrame = ATA6870_FRAME__OP_STATUS;
+	sATA6870.sEngine.u8NextPoll = 0U;
+	sATA6870.sEngine.u8Guard = 0x00U;
+	sATA6870.sEngine.u32SweepMask = 0U;
+	sATA6870.sEngine.u32SweepCount = 0U;
+	sATA6870.sEngine.u32FrameCount = 0U;
+	sATA6870.sEngine.u32OpFault = 0U;
+	sATA6870.sEngine.u32Cancel = 0U;
+	sATA6870.sEngine.u8VoltageError = 0U;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * (Re)start the scan, each device checks for a stale operation first.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.013.FUNC.002
+ */
+void vATA6870_ENGINE__Start(void)
+{
+	Luint8 u8Counter;
+
+	//finish off anything on the bus against the old states
+	vATA6870_ENGINE__Bus_Acquire();
+
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Counter++)
+	{
+		sATA6870.sEngine.sDevice[u8Counter].eState = ATA6870_DEV__CHECK_OP;
+	}
+	sATA6870.sEngine.u32SweepMask = 0U;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Move the engine on, call from the main loop.
+ *
+ * @note
+ * Never waits. At most one frame is started per call, so with the polled
+ * transfer the most the main loop is held up is one burst frame and its
+ * guard byte.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.013.FUNC.003
+ */
+void vATA6870_ENGINE__Process(void)
+{
+
+	//frame finished?
+	if((sATA6870.sEngine.eBus == ATA6870_BUS__FRAME) && (M_LOCALDEF__LCCM650__SPI_XFER_BUSY() == 0U))
+	{
+		//raise nCS and act on what came back
+		vATA6870_ENGINE__Frame_Done();
+
+		//4+ clocks with nCS high before the next access
+		sATA6870.sEngine.eBus = ATA6870_BUS__GUARD;
+		M_LOCALDEF__LCCM650__SPI_XFER_START(&sATA6870.sEngine.u8Guard, &sATA6870.sEngine.u8Rx[0], 1U);
+	}
+	else
+	{
+		//fall on
+	}
+
+	//guard finished?
+	if((sATA6870.sEngine.eBus == ATA6870_BUS__GUARD) && (M_LOCALDEF__LCCM650__SPI_XFER_BUSY() == 0U))
+	{
+		sATA6870.sEngine.eBus = ATA6870_BUS__IDLE;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//bus free, there is always something to send
+	if(sATA6870.sEngine.eBus == ATA6870_BUS__IDLE)
+	{
+		vATA6870_ENGINE__Next_Frame();
+	}
+	else
+	{
+		//still on the wire
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Take the bus off the engine for a blocking lowlevel access.
+ *
+ * @note
+ * Waits for the frame on the wire to finish, which is one frame at most, and
+ * completes it. The lowlevel clocks its own guard bytes so the engine starts
+ * again from idle.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.013.FUNC.004
+ */
+void vATA6870_ENGINE__Bus_Acquire(void)
+{
+
+	if(sATA6870.sEngine.eBus != ATA6870_BUS__IDLE)
+	{
+		while(M_LOCALDEF__LCCM650__SPI_XFER_BUSY() != 0U)
+		{
+			//one frame at most
+		}
+
+		if(sATA6870.sEngine.eBus == ATA6870_BUS__FRAME)
+		{
+			vATA6870_ENGINE__Frame_Done();
+		}
+		else
+		{
+			//just the guard
+		}
+
+		sATA6870.sEngine.eBus = ATA6870_BUS__IDLE;
+	}
+	else
+	{
+		//fall on
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Frame transfer using the byte at a time SPI, for targets without DMA.
+ *
+ * @note
+ * Map M_LOCALDEF__LCCM650__SPI_XFER_START to this and XFER_BUSY to 0U. The
+ * frame is finished by the time this returns.
+ *
+ * @param[in]		u16Length				Bytes to clock
+ * @param[out]		*pu8Rx					MISO
+ * @param[in]		*pu8Tx					MOSI
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.013.FUNC.005
+ */
+void vATA6870_ENGINE__Xfer_Polled(const Luint8 *pu8Tx, Luint8 *pu8Rx, Luint16 u16Length)
+{
+	Luint16 u16Counter;
+
+	for(u16Counter = 0U; u16Counter < u16Length; u16Counter++)
+	{
+		pu8Rx[u16Counter] = M_LOCALDEF__LCCM650__SPI_TX_U8(pu8Tx[u16Counter]);
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Number of complete sweeps of the chain.
+ *
+ * @return			Sweep count, every device read once per sweep
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.013.FUNC.006
+ */
+Luint32 u32ATA6870_ENGINE__Get_SweepCount(void)
+{
+	return sATA6870.sEngine.u32SweepCount;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Queue a write of a device's discharge resistors.
+ *
+ * @note
+ * Only the mask is kept here, the frame is built as it goes on the bus so one
+ * already being clocked is never touched. A newer mask replaces one still
+ * waiting.
+ *
+ * @param[in]		u8Mask					Bit per cell, 1 = resistor on
+ * @param[in]		u8DeviceIndex			The device in the chain
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.013.FUNC.010
+ */
+void vATA6870_ENGINE__Set_Discharge(Luint8 u8DeviceIndex, Luint8 u8Mask)
+{
+
+	if(u8DeviceIndex < C_LOCALDEF__LCCM650__NUM_DEVICES)
+	{
+		sATA6870.sEngine.sDevice[u8DeviceIndex].u8Discharge = u8Mask;
+		sATA6870.sEngine.sDevice[u8DeviceIndex].u8DischargePending = 1U;
+	}
+	else
+	{
+		//not in the chain
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Build one frame for a device.
+ *
+ * @param[in]		u8Data					Data for a write, reads clock out zeros
+ * @param[in]		u8Write					1 = write, 0 = read
+ * @param[in]		eRegister				Register to access
+ * @param[in]		eFrame					Which frame slot to fill
+ * @param[in]		u8DeviceIndex			The device in the chain
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.013.FUNC.007
+ */
+static void vATA6870_ENGINE__Build_Frame(Luint8 u8DeviceIndex, E_ATA6870__FRAME_T eFrame, ATA6870_REGS_T eRegister, Luint8 u8Write, Luint8 u8Data)
+{
+	Luint8 *pu8Tx;
+	Luint16 u16Addx;
+	Luint8 u8Control;
+	Luint8 u8Length;
+	Luint8 u8Counter;
+	#if C_LOCALDEF__LCCM650__ENABLE_CRC == 1U
+		Luint8 u8CRC;
+	#endif
+
+	pu8Tx = &sATA6870.sEngine.sDevice[u8DeviceIndex].u8Tx[(Luint8)eFrame][0];
+	u8Length = u8ATA6870_ENGINE__DataLength[(Luint8)eFrame];
+
+	//device ID, upper byte first as the lowlevel sends it
+	u16Addx = 0x0001U;
+	u16Addx <<= (Luint16)u8DeviceIndex;
+	pu8Tx[0] = (Luint8)(u16Addx >> 8U);
+	pu8Tx[1] = (Luint8)(u16Addx & 0x00FFU);
+
+	//control, register and the write bit
+	u8Control = (Luint8)eRegister;
+	u8Control <<= 1U;
+	u8Control |= u8Write;
+	pu8Tx[2] = u8Control;
+
+	//data, a read clocks zeros
+	for(u8Counter = 0U; u8Counter < u8Length; u8Counter++)
+	{
+		pu8Tx[C_ATA6870_ENGINE__HEADER_LENGTH + u8Counter] = 0x00U;
+	}
+	pu8Tx[C_ATA6870_ENGINE__HEADER_LENGTH] = u8Data;
+
+	#if C_LOCALDEF__LCCM650__ENABLE_CRC == 1U
+		//over the same bytes as the lowlevel, done once here not per byte on the wire
+		u8CRC = 0U;
+		for(u8Counter = 0U; u8Counter < (C_ATA6870_ENGINE__HEADER_LENGTH + u8Length); u8Counter++)
+		{
+			u8CRC = u8ATA6870_LOWLEVEL__CRC(u8CRC, pu8Tx[u8Counter]);
+		}
+		pu8Tx[C_ATA6870_ENGINE__HEADER_LENGTH + u8Length] = u8CRC;
+	#else
+		pu8Tx[C_ATA6870_ENGINE__HEADER_LENGTH + u8Length] = 0x00U;
+	#endif
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Pick the next device and put its frame on the bus.
+ *
+ * @note
+ * Discharge writes first, then anything that moves a device on goes before
+ * an op status poll, polls go round robin so every converting device is seen.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.013.FUNC.008
+ */
+static void vATA6870_ENGINE__Next_Frame(void)
+{
+	Luint8 u8Counter;
+	Luint8 u8Device;
+	Luint8 u8Found;
+	Luint8 u8Frame;
+	E_ATA6870__FRAME_T eFrame;
+
+	u8Found = 0U;
+	u8Device = 0U;
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Counter++)
+	{
+		if((u8Found == 0U) && (sATA6870.sEngine.sDevice[u8Counter].u8DischargePending == 1U))
+		{
+			u8Device = u8Counter;
+			u8Found = 2U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Counter++)
+	{
+		if((u8Found == 0U) && (sATA6870.sEngine.sDevice[u8Counter].eState != ATA6870_DEV__CONVERTING))
+		{
+			u8Device = u8Counter;
+			u8Found = 1U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	if(u8Found == 0U)
+	{
+		//everyone is converting, poll them in turn
+		u8Device = sATA6870.sEngine.u8NextPoll;
+		sATA6870.sEngine.u8NextPoll++;
+		if(sATA6870.sEngine.u8NextPoll >= C_LOCALDEF__LCCM650__NUM_DEVICES)
+		{
+			sATA6870.sEngine.u8NextPoll = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	else
+	{
+		//fall on
+	}
+
+	switch(sATA6870.sEngine.sDevice[u8Device].eState)
+	{
+		case ATA6870_DEV__CANCEL:
+			eFrame = ATA6870_FRAME__OP_CANCEL;
+			break;
+		case ATA6870_DEV__CLEAR_IRQ:
+			eFrame = ATA6870_FRAME__IRQ_STATUS;
+			break;
+		case ATA6870_DEV__START:
+			eFrame = ATA6870_FRAME__OP_START;
+			break;
+		case ATA6870_DEV__READ:
+			eFrame = ATA6870_FRAME__BURST;
+			break;
+		case ATA6870_DEV__CHECK_OP:
+		case ATA6870_DEV__CONVERTING:
+		default:
+			eFrame = ATA6870_FRAME__OP_STATUS;
+			break;
+	}
+
+	if(u8Found == 2U)
+	{
+		//build it now, the mask may have changed since it was queued
+		eFrame = ATA6870_FRAME__DISCHARGE;
+		vATA6870_ENGINE__Build_Frame(u8Device, eFrame, ATA6870_REG__CH_DISCHARGE, 1U, sATA6870.sEngine.sDevice[u8Device].u8Discharge);
+		sATA6870.sEngine.sDevice[u8Device].u8DischargePending = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	sATA6870.sEngine.u8Device = u8Device;
+	sATA6870.sEngine.eFrame = eFrame;
+	sATA6870.sEngine.u32FrameCount++;
+	sATA6870.sEngine.eBus = ATA6870_BUS__FRAME;
+
+	u8Frame = (Luint8)eFrame;
+
+	//nCS low and away it goes
+	M_LOCALDEF__LCCM650__NCS_LATCH(0U);
+	M_LOCALDEF__LCCM650__SPI_XFER_START(&sATA6870.sEngine.sDevice[u8Device].u8Tx[u8Frame][0],
+										&sATA6870.sEngine.u8Rx[0],
+										(Luint16)C_ATA6870_ENGINE__HEADER_LENGTH + (Luint16)u8ATA6870_ENGINE__DataLength[u8Frame] + (Luint16)C_ATA6870_ENGINE__CRC_LENGTH);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * The frame on the bus has finished, raise nCS and move its device on.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.013.FUNC.009
+ */
+static void vATA6870_ENGINE__Frame_Done(void)
+{
+	Luint8 u8Device;
+	Luint8 u8Data;
+	Luint16 u16IRQ;
+
+	//raise nCS
+	M_LOCALDEF__LCCM650__NCS_LATCH(1U);
+
+	u8Device = sATA6870.sEngine.u8Device;
+
+	//the ID phase brings back the IRQ state, same as the lowlevel
+	u16IRQ = (Luint16)sATA6870.sEngine.u8Rx[0];
+	u16IRQ <<= 8U;
+	u16IRQ |= (Luint16)sATA6870.sEngine.u8Rx[1];
+	sATA6870.sDevice[u8Device].sIRQ.u16IRQ_Status = u16IRQ;
+
+	//first data byte
+	u8Data = sATA6870.sEngine.u8Rx[C_ATA6870_ENGINE__HEADER_LENGTH];
+
+	if(sATA6870.sEngine.eFrame == ATA6870_FRAME__DISCHARGE)
+	{
+		//a discharge write leaves the cycle where it was
+	}
+	else
+	{
+		switch(sATA6870.sEngine.sDevice[u8Device].eState)
+		{
+			case ATA6870_DEV__CHECK_OP:
+				if(u8Data == 1U)
+				{
+					//an old operation is still going, cancel it rather than wait
+					sATA6870.sEngine.u32Cancel++;
+					sATA6870.sEngine.sDevice[u8Device].eState = ATA6870_DEV__CANCEL;
+				}
+				else
+				{
+					sATA6870.sEngine.sDevice[u8Device].eState = ATA6870_DEV__CLEAR_IRQ;
+				}
+				break;
+
+			case ATA6870_DEV__CANCEL:
+				//poll until it has stopped
+				sATA6870.sEngine.sDevice[u8Device].eState = ATA6870_DEV__CHECK_OP;
+				break;
+
+			case ATA6870_DEV__CLEAR_IRQ:
+				sATA6870.sDevice[u8Device].sIRQ.u8Status = u8Data;
+				sATA6870.sEngine.sDevice[u8Device].eState = ATA6870_DEV__START;
+				break;
+
+			case ATA6870_DEV__START:
+				sATA6870.sEngine.sDevice[u8Device].eState = ATA6870_DEV__CONVERTING;
+				break;
+
+			case ATA6870_DEV__CONVERTING:
+				if(u8Data == 2U)
+				{
+					//finished
+					sATA6870.sEngine.sDevice[u8Device].eState = ATA6870_DEV__READ;
+				}
+				else if(u8Data == 1U)
+				{
+					//still going
+				}
+				else
+				{
+					//lost or failed, go round again
+					sATA6870.sEngine.u32OpFault++;
+					sATA6870.sEngine.sDevice[u8Device].eState = ATA6870_DEV__CHECK_OP;
+				}
+				break;
+
+			case ATA6870_DEV__READ:
+				vATA6870_CELL__Unpack(&sATA6870.sEngine.u8Rx[C_ATA6870_ENGINE__HEADER_LENGTH],
+										&sATA6870.f32Voltage[(Luint32)u8Device * C_ATA6870__MAX_CELLS],
+										&sATA6870.f32NTCTemperatureReading[u8Device]);
+
+				//stats of just these 6 cells while they are fresh
+				vATA6870_BALANCE__Module_Update(u8Device);
+
+				//no new operation is accepted until dataRdy is released
+				sATA6870.sEngine.sDevice[u8Device].eState = ATA6870_DEV__CLEAR_IRQ;
+
+				//whole chain read?
+				sATA6870.sEngine.u32SweepMask |= (0x00000001UL << (Luint32)u8Device);
+				if(sATA6870.sEngine.u32SweepMask == ((0x00000001UL << C_LOCALDEF__LCCM650__NUM_DEVICES) - 1UL))
+				{
+					//fold the modules into the pack stats, the limits come straight off them
+					vATA6870_BALANCE__Sweep_Done();
+					if(sATA6870.sBalance.sPack.f32Max > C_ATA6870_MAX_VOLTS)
+					{
+						sATA6870.sEngine.u8VoltageError = 1U;
+					}
+					else if(sATA6870.sBalance.sPack.f32Min < C_ATA6870_MIN_VOLTS)
+					{
+						sATA6870.sEngine.u8VoltageError = 2U;
+					}
+					else
+					{
+						sATA6870.sEngine.u8VoltageError = 0U;
+					}
+					sATA6870.sEngine.u32SweepMask = 0U;
+					sATA6870.sEngine.u32SweepCount++;
+				}
+				else
+				{
+					//fall on
+				}
+				break;
+
+			default:
+				//not possible
+				sATA6870.sEngine.sDevice[u8Device].eState = ATA6870_DEV__CHECK_OP;
+				break;
+		}
+	}
+
+}
+
+//safetys
+#ifndef C_LOCALDEF__LCCM650__ENABLE_CRC
+	#error
+#endif
+#ifndef M_LOCALDEF__LCCM650__SPI_XFER_START
+	#error
+#endif
+#ifndef M_LOCALDEF__LCCM650__SPI_XFER_BUSY
+	#error
+#endif
+#if C_LOCALDEF__LCCM650__NUM_DEVICES > 16U
+	#error
+#endif
+
+#endif //#if C_LOCALDEF__LCCM650__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM650__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
@@ -38,7 +38,6 @@ extern struct _str6870 sATA6870;
 //locals
 static void vATA6870_LOWLEVEL__Reset(void);
 static Luint16 u16ATA6870_LOWLEVEL__Tx_DeviceID(Luint8 u8DeviceIndex, Luint8 *pu8CRC);
-static Luint8 u8ATA6870_LOWLEVEL__CRC(Luint8 u8InitialCRC, Luint8 u8Data);
 
 /***************************************************************************//**
  * @brief
@@ -125,6 +124,10 @@ void vATA6870_LOWLEVEL__Reg_WriteU8(Luint8 u8DeviceIndex, ATA6870_REGS_T eRegist
 	CLK must be set on 4 clock cycles [at least) before SPI access starts, and must be kept on 4 clock cycles [at least)
 	after SPI access ends up. Keeping at least 4 CLK clock cycles between two consecutive SPI accesses is mandatory.
 	*/
+
+	//let any engine frame on the bus finish first
+	vATA6870_ENGINE__Bus_Acquire();
+
 	u8Temp = M_LOCALDEF__LCCM650__SPI_TX_U8(0x00U);
 	
 	//deasert the nCS
@@ -221,6 +224,10 @@ void vATA6870_LOWLEVEL__Reg_ReadU8(Luint8 u8DeviceIndex, ATA6870_REGS_T eRegiste
 	CLK must be set on 4 clock cycles [at least) before SPI access starts, and must be kept on 4 clock cycles [at least)
 	after SPI access ends up. Keeping at least 4 CLK clock cycles between two consecutive SPI accesses is mandatory.
 	*/
+
+	//let any engine frame on the bus finish first
+	vATA6870_ENGINE__Bus_Acquire();
+
 	u8Temp = M_LOCALDEF__LCCM650__SPI_TX_U8(0x00U);
 	
 	//deasert the nCS
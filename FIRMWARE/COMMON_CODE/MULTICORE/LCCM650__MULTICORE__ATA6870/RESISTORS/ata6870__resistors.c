@@ -118,6 +118,25 @@ void vATA6870_RES__TurnAllOff(Luint8 u8DeviceIndex)
 	/*lint +e934*/
 }
 
+/***************************************************************************//**
+ * @brief
+ * Set all the resistors on a device without waiting on the bus.
+ *
+ * @note
+ * The write is queued on the acquisition engine and goes out ahead of the
+ * next scan frame. This is what the balancer uses, the blocking calls above
+ * are for bench work and are overwritten by the next mask the balancer sets.
+ *
+ * @param[in]		u8Mask					Bit per cell, 1 = resistor on
+ * @param[in]		u8DeviceIndex			The BMS device index
+ * @st_funcMD5
+ * @st_funcID		LCCM650R0.FILE.008.FUNC.004
+ */
+void vATA6870_RES__Set_Mask(Luint8 u8DeviceIndex, Luint8 u8Mask)
+{
+	//only the cells we have
+	vATA6870_ENGINE__Set_Discharge(u8DeviceIndex, u8Mask & 0x3FU);
+}
 
 #endif //#if C_LOCALDEF__LCCM650__ENABLE_THIS_MODULE == 1U
 //safetys
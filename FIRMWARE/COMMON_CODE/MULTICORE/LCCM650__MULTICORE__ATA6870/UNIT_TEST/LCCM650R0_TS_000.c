@@ -0,0 +1,884 @@
+/**
+ * @file		LCCM650R0_TS_000.C
+ * @brief		Test spec for the ATA6870 acquisition engine against a mock SPI chain
+ *
+ * @note
+ * Host side. Bind the SPI hooks to the mock in the localdef:
+ * M_LOCALDEF__LCCM650__SPI_TX_U8(x)					u8LCCM650R0_TS_000__Tx_U8(x)
+ * M_LOCALDEF__LCCM650__NCS_LATCH(val)					vLCCM650R0_TS_000__NCS(val)
+ * M_LOCALDEF__LCCM650__SPI_XFER_START(ptx, prx, len)	vLCCM650R0_TS_000__Xfer_Start(ptx, prx, len)
+ * M_LOCALDEF__LCCM650__SPI_XFER_BUSY()					u8LCCM650R0_TS_000__Xfer_Busy()
+ *
+ * The mock keeps its own clock. Bytes take C_TS000__BYTE_US, a DMA style
+ * transfer runs in the background and a polled one holds up the caller, so
+ * the time spent inside vATA6870__Process() is the jitter the main loop sees.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	This file contains proprietary and confidential information of
+ *				SIL3 Pty. Ltd. (ACN 123 529 064). This code may be distributed
+ *				under a license from SIL3 Pty. Ltd., and may be used, copied
+ *				and/or disclosed only pursuant to the terms of that license agreement.
+ *				This copyright notice must be retained as part of this file at all times.
+ * @copyright	This file is copyright SIL3 Pty. Ltd. 2003-2016, All Rights Reserved.
+ * @st_fileID	LCCM650R0.FILE.014
+ */
+#include "../ata6870.h"
+
+#if C_LOCALDEF__LCCM650__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM650__ENABLE_TEST_SPEC == 1U
+
+//host side only
+#include <stdio.h>
+#include <time.h>
+
+/** One byte at 1MHz SCLK */
+#define C_TS000__BYTE_US						(8U)
+
+/** Conversion time, 8.2ms from the datasheet */
+#define C_TS000__CONV_US						(8200U)
+
+/** Everything else the main loop does per pass */
+#define C_TS000__LOOP_US						(20U)
+
+/** How long each case runs the chain for */
+#define C_TS000__RUN_US							(1000000U)
+
+/** Wire length of the frames, ID + control + data + CRC */
+#define C_TS000__CRC_LENGTH						(C_LOCALDEF__LCCM650__ENABLE_CRC)
+#define C_TS000__SHORT_FRAME					(3U + 1U + C_TS000__CRC_LENGTH)
+#define C_TS000__BURST_FRAME					(3U + C_ATA6870__BUSRT_LENGTH + C_TS000__CRC_LENGTH)
+
+/** Never finishes */
+#define C_TS000__STUCK							(0xFFFFFFFFU)
+
+void vLCCM650R0_TS_000_TCASE_001(void);
+void vLCCM650R0_TS_000_TCASE_002(void);
+void vLCCM650R0_TS_000_TCASE_003(void);
+void vLCCM650R0_TS_000_TCASE_004(void);
+static void vTS000__Reset(Luint8 u8Async);
+static void vTS000__Run(Luint32 u32Duration_us);
+static Luint8 u8TS000__Check_Voltages(void);
+static Luint32 u32TS000__Sweep_Bound(void);
+static Luint8 u8TS000__Byte(Luint8 u8Tx);
+static void vTS000__Tick(void);
+static Luint16 u16TS000__Cell_Raw(Luint8 u8Device, Luint8 u8Cell);
+
+extern struct _str6870 sATA6870;
+
+/** Mock of each ATA6870 in the chain */
+static struct
+{
+	/** 0 none, 1 running, 2 finished, 3 failed / cancelled */
+	Luint8 u8OpStatus;
+	Luint32 u32Done_us;
+
+	/** Status register, bit 0 is dataRdy */
+	Luint8 u8Status;
+
+	/** Burst data latched at the end of a conversion */
+	Luint8 u8Latched[C_ATA6870__BUSRT_LENGTH];
+	Luint8 u8Fresh;
+
+	/** Fail the next conversion */
+	Luint8 u8FailNext;
+
+	Luint32 u32Conversions;
+	Luint32 u32Reads;
+
+	/** Burst read with nothing new latched */
+	Luint32 u32Stale;
+
+	/** Operation request dropped, busy or dataRdy not released */
+	Luint32 u32Ignored;
+
+}sTS000_Dev[C_LOCALDEF__LCCM650__NUM_DEVICES];
+
+//mock bus
+static Luint8 u8TS000_Async;
+static Luint32 u32TS000_Now_us;
+static Luint32 u32TS000_BusyUntil_us;
+static Luint32 u32TS000_BusyPoll_us;
+static Luint8 u8TS000_NCS;
+static Luint8 u8TS000_Pos;
+static Luint8 u8TS000_Device;
+static Luint8 u8TS000_IDHigh;
+static Luint8 u8TS000_Control;
+static Luint32 u32TS000_Collisions;
+
+//capture of what the lowlevel clocks with nCS low
+static Luint8 u8TS000_Capture[C_ATA6870__FRAME_MAX];
+static Luint8 u8TS000_CaptureLength;
+
+//results of a run
+static Luint32 u32TS000_Calls;
+static Luint32 u32TS000_MaxBlock_us;
+static Luint32 u32TS000_TotalBlock_us;
+static Luint32 u32TS000_FirstSweep_us;
+static Luint32 u32TS000_LastSweep_us;
+static Luint32 u32TS000_Sweeps;
+static Lfloat64 f64TS000_Host_us;
+
+//Function to call the tests for this test specification
+void vLCCM650R0_TS_000(void)
+{
+	//Call the test cases
+	vLCCM650R0_TS_000_TCASE_001();
+	vLCCM650R0_TS_000_TCASE_002();
+	vLCCM650R0_TS_000_TCASE_003();
+	vLCCM650R0_TS_000_TCASE_004();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM650R0.TS.000.TCASE.001
+ * @st_test_desc
+ * DMA style transfers. Every sweep of the chain must finish inside one
+ * conversion time plus the transfer time, the cells must read back right and
+ * the main loop must never be held up by the bus.
+ *
+*/
+void vLCCM650R0_TS_000_TCASE_001(void)
+{
+	char cText[200];
+	Luint32 u32Period;
+
+	DEBUG_PRINT("START:LCCM650R0.TS.000.TCASE.001\r\n");
+
+	vTS000__Reset(1U);
+	vTS000__Run(C_TS000__RUN_US);
+
+	u32Period = 0xFFFFFFFFU;
+	if(u32TS000_Sweeps > 1U)
+	{
+		u32Period = (u32TS000_LastSweep_us - u32TS000_FirstSweep_us) / (u32TS000_Sweeps - 1U);
+	}
+	else
+	{
+		//never got going
+	}
+
+	sprintf(cText, "INFO: %u sweeps, period %u us, bound %u us, %u frames, max block %u us, host %.3f us per call\r\n",
+			u32TS000_Sweeps, u32Period, u32TS000__Sweep_Bound(), sATA6870.sEngine.u32FrameCount,
+			u32TS000_MaxBlock_us, f64TS000_Host_us / (Lfloat64)u32TS000_Calls);
+	DEBUG_PRINT(cText);
+
+	if((u32TS000_Sweeps > 2U) &&
+		(u32Period >= C_TS000__CONV_US) && (u32Period <= u32TS000__Sweep_Bound()) &&
+		(u32TS000_MaxBlock_us == 0U) &&
+		(u8TS000__Check_Voltages() == 1U) &&
+		(sATA6870.sEngine.u32OpFault == 0U) &&
+		(sATA6870.sEngine.u8VoltageError == 0U))
+	{
+		DEBUG_PRINT("PASS:LCCM650R0.TS.000.TCASE.001\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM650R0.TS.000.TCASE.001\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM650R0.TS.000.TCASE.001\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM650R0.TS.000.TCASE.002
+ * @st_test_desc
+ * Byte at a time transfers. Same throughput, but each call may only hold the
+ * main loop for one burst frame and its guard byte.
+ *
+*/
+void vLCCM650R0_TS_000_TCASE_002(void)
+{
+	char cText[200];
+	Luint32 u32Period;
+	Luint32 u32Limit;
+	Luint32 u32Blocking;
+
+	DEBUG_PRINT("START:LCCM650R0.TS.000.TCASE.002\r\n");
+
+	vTS000__Reset(0U);
+	vTS000__Run(C_TS000__RUN_US);
+
+	u32Period = 0xFFFFFFFFU;
+	if(u32TS000_Sweeps > 1U)
+	{
+		u32Period = (u32TS000_LastSweep_us - u32TS000_FirstSweep_us) / (u32TS000_Sweeps - 1U);
+	}
+	else
+	{
+		//never got going
+	}
+	u32Limit = (C_TS000__BURST_FRAME + 1U) * C_TS000__BYTE_US;
+
+	//what one blocking sweep of the chain would hold the loop for, with no waits
+	u32Blocking = C_LOCALDEF__LCCM650__NUM_DEVICES * (C_TS000__BURST_FRAME + (3U * C_TS000__SHORT_FRAME) + 8U) * C_TS000__BYTE_US;
+
+	sprintf(cText, "INFO: %u sweeps, period %u us, max block %u us (limit %u), mean %.2f us, a blocking sweep is %u us\r\n",
+			u32TS000_Sweeps, u32Period, u32TS000_MaxBlock_us, u32Limit,
+			(Lfloat64)u32TS000_TotalBlock_us / (Lfloat64)u32TS000_Calls, u32Blocking);
+	DEBUG_PRINT(cText);
+
+	if((u32TS000_Sweeps > 2U) &&
+		(u32Period <= u32TS000__Sweep_Bound()) &&
+		(u32TS000_MaxBlock_us <= u32Limit) &&
+		(u8TS000__Check_Voltages() == 1U) &&
+		(sATA6870.sEngine.u32OpFault == 0U))
+	{
+		DEBUG_PRINT("PASS:LCCM650R0.TS.000.TCASE.002\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM650R0.TS.000.TCASE.002\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM650R0.TS.000.TCASE.002\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM650R0.TS.000.TCASE.003
+ * @st_test_desc
+ * One device is stuck in an old operation, one has dataRdy left over and one
+ * fails a conversion part way. The stuck one must be cancelled without any
+ * delay, no operation request may be dropped by the devices, and the scan
+ * must keep going.
+ *
+*/
+void vLCCM650R0_TS_000_TCASE_003(void)
+{
+	char cText[200];
+	Luint8 u8Counter;
+	Luint32 u32Ignored;
+	Luint32 u32Stale;
+
+	DEBUG_PRINT("START:LCCM650R0.TS.000.TCASE.003\r\n");
+
+	vTS000__Reset(1U);
+
+	//stuck
+	sTS000_Dev[C_LOCALDEF__LCCM650__NUM_DEVICES - 1U].u8OpStatus = 1U;
+	sTS000_Dev[C_LOCALDEF__LCCM650__NUM_DEVICES - 1U].u32Done_us = C_TS000__STUCK;
+
+	//left over dataRdy
+	sTS000_Dev[0].u8Status = 0x01U;
+	sTS000_Dev[0].u8OpStatus = 2U;
+
+	vTS000__Run(C_TS000__RUN_US / 2U);
+
+	//one bad conversion
+	sTS000_Dev[0].u8FailNext = 1U;
+	vTS000__Run(C_TS000__RUN_US / 2U);
+
+	u32Ignored = 0U;
+	u32Stale = 0U;
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Counter++)
+	{
+		u32Ignored += sTS000_Dev[u8Counter].u32Ignored;
+		u32Stale += sTS000_Dev[u8Counter].u32Stale;
+	}
+
+	sprintf(cText, "INFO: %u sweeps, cancelled %u, op faults %u, ignored %u, stale %u\r\n",
+			u32TS000_Sweeps, sATA6870.sEngine.u32Cancel, sATA6870.sEngine.u32OpFault, u32Ignored, u32Stale);
+	DEBUG_PRINT(cText);
+
+	if((u32TS000_Sweeps > 50U) &&
+		(sATA6870.sEngine.u32Cancel == 1U) &&
+		(sATA6870.sEngine.u32OpFault == 1U) &&
+		(u32Ignored == 0U) && (u32Stale == 0U) &&
+		(u8TS000__Check_Voltages() == 1U))
+	{
+		DEBUG_PRINT("PASS:LCCM650R0.TS.000.TCASE.003\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM650R0.TS.000.TCASE.003\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM650R0.TS.000.TCASE.003\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM650R0.TS.000.TCASE.004
+ * @st_test_desc
+ * The precomputed frames must be byte for byte what the lowlevel clocks for
+ * the same access, and a lowlevel access in the middle of a DMA scan must
+ * wait for the frame on the wire rather than collide with it.
+ *
+*/
+void vLCCM650R0_TS_000_TCASE_004(void)
+{
+	char cText[200];
+	Luint8 u8Device;
+	Luint8 u8Counter;
+	Luint8 u8Frame;
+	Luint8 u8Data[C_ATA6870__BUSRT_LENGTH];
+	Luint8 u8Length;
+	Luint32 u32Mismatch;
+	Luint32 u32Sweeps;
+	const Luint8 *pu8Tx;
+
+	DEBUG_PRINT("START:LCCM650R0.TS.000.TCASE.004\r\n");
+
+	vTS000__Reset(0U);
+
+	u32Mismatch = 0U;
+	for(u8Device = 0U; u8Device < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Device++)
+	{
+		for(u8Frame = 0U; u8Frame < (Luint8)ATA6870_FRAME__NUM; u8Frame++)
+		{
+			u8TS000_CaptureLength = 0U;
+			switch((E_ATA6870__FRAME_T)u8Frame)
+			{
+				case ATA6870_FRAME__IRQ_STATUS:
+					vATA6870_LOWLEVEL__Reg_ReadU8(u8Device, ATA6870_REG__IRQ_STATUS, &u8Data[0], 1U);
+					u8Length = C_TS000__SHORT_FRAME;
+					break;
+				case ATA6870_FRAME__OP_STATUS:
+					vATA6870_LOWLEVEL__Reg_ReadU8(u8Device, ATA6870_REG__OP_STATUS, &u8Data[0], 1U);
+					u8Length = C_TS000__SHORT_FRAME;
+					break;
+				case ATA6870_FRAME__OP_CANCEL:
+					u8Data[0] = 0x00U;
+					vATA6870_LOWLEVEL__Reg_WriteU8(u8Device, ATA6870_REG__OPERATION, &u8Data[0], 1U);
+					u8Length = C_TS000__SHORT_FRAME;
+					break;
+				case ATA6870_FRAME__OP_START:
+					u8Data[0] = (Luint8)C_ATA6870__OP_START;
+					vATA6870_LOWLEVEL__Reg_WriteU8(u8Device, ATA6870_REG__OPERATION, &u8Data[0], 1U);
+					u8Length = C_TS000__SHORT_FRAME;
+					break;
+				case ATA6870_FRAME__DISCHARGE:
+					//as built at init, all off
+					u8Data[0] = 0x00U;
+					vATA6870_LOWLEVEL__Reg_WriteU8(u8Device, ATA6870_REG__CH_DISCHARGE, &u8Data[0], 1U);
+					u8Length = C_TS000__SHORT_FRAME;
+					break;
+				case ATA6870_FRAME__BURST:
+				default:
+					vATA6870_LOWLEVEL__Reg_ReadU8(u8Device, ATA6870_REG__DATA_RD16_BURST, &u8Data[0], C_ATA6870__BUSRT_LENGTH);
+					u8Length = C_TS000__BURST_FRAME;
+					break;
+			}
+
+			pu8Tx = &sATA6870.sEngine.sDevice[u8Device].u8Tx[u8Frame][0];
+			if(u8TS000_CaptureLength != u8Length)
+			{
+				u32Mismatch++;
+			}
+			else
+			{
+				for(u8Counter = 0U; u8Counter < u8Length; u8Counter++)
+				{
+					if(pu8Tx[u8Counter] != u8TS000_Capture[u8Counter])
+					{
+						u32Mismatch++;
+					}
+					else
+					{
+						//same
+					}
+				}
+			}
+		}
+	}
+
+	//now break into a DMA scan with lowlevel accesses
+	vTS000__Reset(1U);
+	for(u8Counter = 0U; u8Counter < 40U; u8Counter++)
+	{
+		vTS000__Run(9999U);
+		vATA6870_LOWLEVEL__Reg_ReadU8(u8Counter % C_LOCALDEF__LCCM650__NUM_DEVICES, ATA6870_REG__REV_ID, &u8Data[0], 1U);
+	}
+	u32Sweeps = sATA6870.sEngine.u32SweepCount;
+
+	sprintf(cText, "INFO: frame mismatches %u, collisions %u, sweeps with lowlevel access %u\r\n", u32Mismatch, u32TS000_Collisions, u32Sweeps);
+	DEBUG_PRINT(cText);
+
+	if((u32Mismatch == 0U) && (u32TS000_Collisions == 0U) && (u32Sweeps > 20U) &&
+		(u8TS000__Check_Voltages() == 1U))
+	{
+		DEBUG_PRINT("PASS:LCCM650R0.TS.000.TCASE.004\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM650R0.TS.000.TCASE.004\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM650R0.TS.000.TCASE.004\r\n");
+}
+
+//fresh chain and engine, bus type 1 = DMA style
+static void vTS000__Reset(Luint8 u8Async)
+{
+	Luint8 u8Device;
+	Luint8 u8Cell;
+	Luint16 u16Raw;
+
+	u8TS000_Async = u8Async;
+	u32TS000_Now_us = 0U;
+	u32TS000_BusyUntil_us = 0U;
+	u32TS000_BusyPoll_us = C_TS000__STUCK;
+	u8TS000_NCS = 1U;
+	u8TS000_Pos = 0U;
+	u8TS000_Device = 0xFFU;
+	u8TS000_IDHigh = 0U;
+	u8TS000_Control = 0U;
+	u32TS000_Collisions = 0U;
+	u8TS000_CaptureLength = 0U;
+
+	for(u8Device = 0U; u8Device < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Device++)
+	{
+		sTS000_Dev[u8Device].u8OpStatus = 0U;
+		sTS000_Dev[u8Device].u32Done_us = 0U;
+		sTS000_Dev[u8Device].u8Status = 0U;
+		sTS000_Dev[u8Device].u8Fresh = 0U;
+		sTS000_Dev[u8Device].u8FailNext = 0U;
+		sTS000_Dev[u8Device].u32Conversions = 0U;
+		sTS000_Dev[u8Device].u32Reads = 0U;
+		sTS000_Dev[u8Device].u32Stale = 0U;
+		sTS000_Dev[u8Device].u32Ignored = 0U;
+
+		//cells big endian as the device sends them, then the temperature
+		for(u8Cell = 0U; u8Cell < C_ATA6870__MAX_CELLS; u8Cell++)
+		{
+			u16Raw = u16TS000__Cell_Raw(u8Device, u8Cell);
+			sTS000_Dev[u8Device].u8Latched[u8Cell * 2U] = (Luint8)(u16Raw >> 8U);
+			sTS000_Dev[u8Device].u8Latched[(u8Cell * 2U) + 1U] = (Luint8)(u16Raw & 0xFFU);
+		}
+		sTS000_Dev[u8Device].u8Latched[C_ATA6870__BUSRT_LENGTH - 2U] = 0x20U;
+		sTS000_Dev[u8Device].u8Latched[C_ATA6870__BUSRT_LENGTH - 1U] = 0x01U;
+
+		//nothing read yet
+		sATA6870.f32Voltage[(Luint32)u8Device * C_ATA6870__MAX_CELLS] = 0.0F;
+	}
+
+	vATA6870_ENGINE__Init();
+	sATA6870.eState = ATA6870_STATE__INIT_DEVICE;
+
+	u32TS000_Calls = 0U;
+	u32TS000_MaxBlock_us = 0U;
+	u32TS000_TotalBlock_us = 0U;
+	u32TS000_FirstSweep_us = 0U;
+	u32TS000_LastSweep_us = 0U;
+	u32TS000_Sweeps = 0U;
+	f64TS000_Host_us = 0.0;
+}
+
+//run the main loop, timing each call
+static void vTS000__Run(Luint32 u32Duration_us)
+{
+	Luint32 u32End;
+	Luint32 u32Start;
+	Luint32 u32Block;
+	clock_t tStart;
+
+	u32End = u32TS000_Now_us + u32Duration_us;
+	tStart = clock();
+	while(u32TS000_Now_us < u32End)
+	{
+		u32Start = u32TS000_Now_us;
+		vATA6870__Process();
+
+		//only a polled transfer moves the clock inside the call
+		u32Block = u32TS000_Now_us - u32Start;
+		u32TS000_TotalBlock_us += u32Block;
+		if(u32Block > u32TS000_MaxBlock_us)
+		{
+			u32TS000_MaxBlock_us = u32Block;
+		}
+		else
+		{
+			//fall on
+		}
+		u32TS000_Calls++;
+
+		if(sATA6870.sEngine.u32SweepCount != u32TS000_Sweeps)
+		{
+			if(u32TS000_Sweeps == 0U)
+			{
+				u32TS000_FirstSweep_us = u32TS000_Now_us;
+			}
+			else
+			{
+				//fall on
+			}
+			u32TS000_LastSweep_us = u32TS000_Now_us;
+			u32TS000_Sweeps = sATA6870.sEngine.u32SweepCount;
+		}
+		else
+		{
+			//fall on
+		}
+
+		u32TS000_Now_us += C_TS000__LOOP_US;
+	}
+	f64TS000_Host_us += ((Lfloat64)(clock() - tStart) * 1000000.0) / (Lfloat64)CLOCKS_PER_SEC;
+}
+
+//every cell as the mock has it
+static Luint8 u8TS000__Check_Voltages(void)
+{
+	Luint8 u8Device;
+	Luint8 u8Cell;
+	Luint8 u8Return;
+	Lfloat32 f32Expect;
+	Lfloat32 f32Error;
+
+	u8Return = 1U;
+	for(u8Device = 0U; u8Device < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Device++)
+	{
+		for(u8Cell = 0U; u8Cell < C_ATA6870__MAX_CELLS; u8Cell++)
+		{
+			f32Expect = (Lfloat32)u16TS000__Cell_Raw(u8Device, u8Cell) - 410.0F;
+			f32Expect *= C_ATA6870__ADC_RES_V;
+			f32Error = sATA6870.f32Voltage[((Luint32)u8Device * C_ATA6870__MAX_CELLS) + u8Cell] - f32Expect;
+			if((f32Error > 0.0001F) || (f32Error < -0.0001F))
+			{
+				u8Return = 0U;
+			}
+			else
+			{
+				//good
+			}
+		}
+	}
+
+	return u8Return;
+}
+
+//one conversion plus every frame of a sweep, each frame rounded up to whole
+//loop passes for the frame and its guard, plus a round of op status polls
+static Luint32 u32TS000__Sweep_Bound(void)
+{
+	Luint32 u32Frames_us;
+	Luint32 u32Polls_us;
+
+	u32Frames_us = (C_TS000__BURST_FRAME + (2U * C_TS000__SHORT_FRAME)) * C_TS000__BYTE_US;
+	u32Frames_us += 3U * 3U * C_TS000__LOOP_US;
+	u32Polls_us = (C_TS000__SHORT_FRAME * C_TS000__BYTE_US) + (3U * C_TS000__LOOP_US);
+
+	return C_TS000__CONV_US + (C_LOCALDEF__LCCM650__NUM_DEVICES * (u32Frames_us + u32Polls_us));
+}
+
+//cells 3.3V up, different on each device
+static Luint16 u16TS000__Cell_Raw(Luint8 u8Device, Luint8 u8Cell)
+{
+	Lfloat32 f32Volts;
+
+	f32Volts = 3.3F + (0.05F * (Lfloat32)u8Device) + (0.01F * (Lfloat32)u8Cell);
+	return (Luint16)((f32Volts / C_ATA6870__ADC_RES_V) + 410.5F);
+}
+
+//finish any conversions that are due
+static void vTS000__Tick(void)
+{
+	Luint8 u8Device;
+
+	for(u8Device = 0U; u8Device < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Device++)
+	{
+		if((sTS000_Dev[u8Device].u8OpStatus == 1U) && (u32TS000_Now_us >= sTS000_Dev[u8Device].u32Done_us))
+		{
+			if(sTS000_Dev[u8Device].u8FailNext == 1U)
+			{
+				sTS000_Dev[u8Device].u8FailNext = 0U;
+				sTS000_Dev[u8Device].u8OpStatus = 3U;
+			}
+			else
+			{
+				sTS000_Dev[u8Device].u8OpStatus = 2U;
+				sTS000_Dev[u8Device].u8Status |= 0x01U;
+				sTS000_Dev[u8Device].u8Fresh = 1U;
+				sTS000_Dev[u8Device].u32Conversions++;
+			}
+		}
+		else
+		{
+			//fall on
+		}
+	}
+}
+
+//one byte through the chain, returns MISO
+static Luint8 u8TS000__Byte(Luint8 u8Tx)
+{
+	Luint8 u8Return;
+	Luint8 u8Device;
+	Luint8 u8Register;
+	Luint8 u8Index;
+	Luint16 u16ID;
+	Luint16 u16IRQ;
+
+	u8Return = 0x00U;
+
+	if(u8TS000_NCS == 0U)
+	{
+		vTS000__Tick();
+
+		if(u8TS000_CaptureLength < C_ATA6870__FRAME_MAX)
+		{
+			u8TS000_Capture[u8TS000_CaptureLength] = u8Tx;
+			u8TS000_CaptureLength++;
+		}
+		else
+		{
+			//fall on
+		}
+
+		//IRQ state of the chain
+		u16IRQ = 0U;
+		for(u8Device = 0U; u8Device < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Device++)
+		{
+			if(sTS000_Dev[u8Device].u8Status != 0U)
+			{
+				u16IRQ |= (Luint16)(1U << u8Device);
+			}
+			else
+			{
+				//fall on
+			}
+		}
+
+		if(u8TS000_Pos == 0U)
+		{
+			u8TS000_IDHigh = u8Tx;
+			u8Return = (Luint8)(u16IRQ >> 8U);
+		}
+		else if(u8TS000_Pos == 1U)
+		{
+			u16ID = ((Luint16)u8TS000_IDHigh << 8U) | (Luint16)u8Tx;
+			u8TS000_Device = 0xFFU;
+			for(u8Device = 0U; u8Device < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Device++)
+			{
+				if(u16ID == (Luint16)(1U << u8Device))
+				{
+					u8TS000_Device = u8Device;
+				}
+				else
+				{
+					//fall on
+				}
+			}
+			u8Return = (Luint8)(u16IRQ & 0xFFU);
+		}
+		else if(u8TS000_Pos == 2U)
+		{
+			u8TS000_Control = u8Tx;
+		}
+		else if(u8TS000_Device < C_LOCALDEF__LCCM650__NUM_DEVICES)
+		{
+			u8Device = u8TS000_Device;
+			u8Register = u8TS000_Control >> 1U;
+			u8Index = u8TS000_Pos - 3U;
+
+			if((u8TS000_Control & 0x01U) == 0x01U)
+			{
+				//write, data then CRC
+				if((u8Index == 0U) && (u8Register == (Luint8)ATA6870_REG__OPERATION))
+				{
+					if(u8Tx == 0x00U)
+					{
+						if(sTS000_Dev[u8Device].u8OpStatus == 1U)
+						{
+							sTS000_Dev[u8Device].u8OpStatus = 3U;
+						}
+						else
+						{
+							//nothing to cancel
+						}
+					}
+					else if((sTS000_Dev[u8Device].u8OpStatus == 1U) || ((sTS000_Dev[u8Device].u8Status & 0x01U) != 0U))
+					{
+						//busy or dataRdy not released, the device drops it
+						sTS000_Dev[u8Device].u32Ignored++;
+					}
+					else
+					{
+						sTS000_Dev[u8Device].u8OpStatus = 1U;
+						sTS000_Dev[u8Device].u32Done_us = u32TS000_Now_us + C_TS000__CONV_US;
+					}
+				}
+				else
+				{
+					//other registers are not modelled
+				}
+			}
+			else if(u8Register == (Luint8)ATA6870_REG__OP_STATUS)
+			{
+				u8Return = (u8Index == 0U) ? sTS000_Dev[u8Device].u8OpStatus : 0x00U;
+			}
+			else if(u8Register == (Luint8)ATA6870_REG__IRQ_STATUS)
+			{
+				if(u8Index == 0U)
+				{
+					//read clears
+					u8Return = sTS000_Dev[u8Device].u8Status;
+					sTS000_Dev[u8Device].u8Status = 0U;
+				}
+				else
+				{
+					//CRC
+				}
+			}
+			else if(u8Register == (Luint8)ATA6870_REG__DATA_RD16_BURST)
+			{
+				if(u8Index == 0U)
+				{
+					if(sTS000_Dev[u8Device].u8Fresh == 0U)
+					{
+						sTS000_Dev[u8Device].u32Stale++;
+					}
+					else
+					{
+						sTS000_Dev[u8Device].u8Fresh = 0U;
+					}
+					sTS000_Dev[u8Device].u32Reads++;
+				}
+				else
+				{
+					//fall on
+				}
+
+				if(u8Index < C_ATA6870__BUSRT_LENGTH)
+				{
+					u8Return = sTS000_Dev[u8Device].u8Latched[u8Index];
+				}
+				else
+				{
+					//CRC
+				}
+			}
+			else
+			{
+				//rev ID and the rest read as 0
+			}
+		}
+		else
+		{
+			//not addressed to anyone
+		}
+
+		u8TS000_Pos++;
+	}
+	else
+	{
+		//guard clocks
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Mock byte transfer, bind M_LOCALDEF__LCCM650__SPI_TX_U8 to this.
+ *
+ */
+Luint8 u8LCCM650R0_TS_000__Tx_U8(Luint8 u8Data)
+{
+	if(u32TS000_Now_us < u32TS000_BusyUntil_us)
+	{
+		//a byte while a DMA frame is on the wire
+		u32TS000_Collisions++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	u32TS000_Now_us += C_TS000__BYTE_US;
+	return u8TS000__Byte(u8Data);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Mock nCS, bind M_LOCALDEF__LCCM650__NCS_LATCH to this.
+ *
+ */
+void vLCCM650R0_TS_000__NCS(Luint8 u8Value)
+{
+	if((u8Value == 0U) && (u8TS000_NCS == 1U))
+	{
+		//new frame
+		u8TS000_Pos = 0U;
+		u8TS000_CaptureLength = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+	u8TS000_NCS = u8Value;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Mock frame transfer, bind M_LOCALDEF__LCCM650__SPI_XFER_START to this.
+ *
+ */
+void vLCCM650R0_TS_000__Xfer_Start(const Luint8 *pu8Tx, Luint8 *pu8Rx, Luint16 u16Length)
+{
+	Luint16 u16Counter;
+
+	if(u8TS000_Async == 1U)
+	{
+		if(u32TS000_Now_us < u32TS000_BusyUntil_us)
+		{
+			u32TS000_Collisions++;
+		}
+		else
+		{
+			//fall on
+		}
+
+		//the chain sees it now, the bus is busy until it has been clocked
+		for(u16Counter = 0U; u16Counter < u16Length; u16Counter++)
+		{
+			pu8Rx[u16Counter] = u8TS000__Byte(pu8Tx[u16Counter]);
+		}
+		u32TS000_BusyUntil_us = u32TS000_Now_us + ((Luint32)u16Length * C_TS000__BYTE_US);
+		u32TS000_BusyPoll_us = C_TS000__STUCK;
+	}
+	else
+	{
+		vATA6870_ENGINE__Xfer_Polled(pu8Tx, pu8Rx, u16Length);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Mock transfer busy, bind M_LOCALDEF__LCCM650__SPI_XFER_BUSY to this.
+ *
+ */
+Luint8 u8LCCM650R0_TS_000__Xfer_Busy(void)
+{
+	Luint8 u8Return;
+
+	if((u32TS000_Now_us < u32TS000_BusyUntil_us) && (u32TS000_BusyPoll_us == u32TS000_Now_us))
+	{
+		//asked twice with no time passing, someone is spinning on it
+		u32TS000_Now_us = u32TS000_BusyUntil_us;
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(u32TS000_Now_us < u32TS000_BusyUntil_us)
+	{
+		u32TS000_BusyPoll_us = u32TS000_Now_us;
+		u8Return = 1U;
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+#endif //C_LOCALDEF__LCCM650__ENABLE_TEST_SPEC
+#endif //#if C_LOCALDEF__LCCM650__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM650__ENABLE_THIS_MODULE
+	#error
+#endif
@@ -0,0 +1,596 @@
+/**
+ * @file		LCCM650R0_TS_001.C
+ * @brief		Test spec for the pack stats and the balancer on a simulated pack
+ *
+ * @note
+ * Host side. The pack is C_TS001__MODULES x 6 cells, more than one chain can
+ * hold, so the balancer is run through its context on our own arrays the same
+ * way vATA6870_BALANCE__Process() runs it over the chain.
+ *
+ * Each cell has a capacity, an OCV that is a straight line on SOC and an
+ * internal resistance, so readings taken while bleeding are pulled down. The
+ * readings are quantised to the ADC LSB with a one LSB dither. Each module
+ * heats with the power in its resistors and cools to ambient.
+ *
+ * The capacity is scaled down so a run is short, the convergence time is
+ * reported against the time the worst cell needs at full bleed current,
+ * which is the best any balancer with these resistors could do.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	This file contains proprietary and confidential information of
+ *				SIL3 Pty. Ltd. (ACN 123 529 064). This code may be distributed
+ *				under a license from SIL3 Pty. Ltd., and may be used, copied
+ *				and/or disclosed only pursuant to the terms of that license agreement.
+ *				This copyright notice must be retained as part of this file at all times.
+ * @copyright	This file is copyright SIL3 Pty. Ltd. 2003-2016, All Rights Reserved.
+ * @st_fileID	LCCM650R0.FILE.015
+ */
+#include "../ata6870.h"
+
+#if C_LOCALDEF__LCCM650__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM650__ENABLE_TEST_SPEC == 1U
+
+//host side only
+#include <stdio.h>
+
+/** 18 modules, 108 cells */
+#define C_TS001__MODULES						(18U)
+#define C_TS001__CELLS							(C_TS001__MODULES * C_ATA6870__MAX_CELLS)
+
+/** One sweep of the chain */
+#define C_TS001__SWEEP_S						(0.0086)
+
+/** Cell model, capacity scaled down for run time */
+#define C_TS001__CAPACITY_AH					(0.25)
+#define C_TS001__OCV_EMPTY_V					(3.4)
+#define C_TS001__OCV_SLOPE_V					(0.7)
+#define C_TS001__CELL_R_OHM						(0.05)
+
+/** Discharge resistor */
+#define C_TS001__BLEED_R_OHM					(33.0)
+
+/** Module thermal model, K/W and seconds */
+#define C_TS001__THERMAL_R						(25.0)
+#define C_TS001__THERMAL_TAU_S					(60.0)
+
+/** Starting SOC, centre and +/- span */
+#define C_TS001__SOC_CENTRE						(0.60)
+#define C_TS001__SOC_SPAN						(0.04)
+
+/** Give up after this long */
+#define C_TS001__MAX_S							(20000.0)
+
+void vLCCM650R0_TS_001_TCASE_001(void);
+void vLCCM650R0_TS_001_TCASE_002(void);
+void vLCCM650R0_TS_001_TCASE_003(void);
+void vLCCM650R0_TS_001_TCASE_004(void);
+static void vTS001__Reset(Lfloat64 f64Ambient);
+static void vTS001__Measure(void);
+static Luint8 u8TS001__Run(void);
+static Luint32 u32TS001__Rand(void);
+
+extern struct _str6870 sATA6870;
+
+/** The simulated pack */
+static struct
+{
+	Lfloat64 f64SOC[C_TS001__CELLS];
+	Lfloat64 f64TempC[C_TS001__MODULES];
+	Lfloat64 f64Ambient;
+	Lfloat64 f64Time_s;
+
+	/** Worst case bleed time to the lowest cell at the start */
+	Lfloat64 f64Ideal_s;
+
+	/** Lowest true cell voltage seen and at the start */
+	Lfloat64 f64MinStart_V;
+	Lfloat64 f64MinSeen_V;
+
+	/** Hottest module seen */
+	Lfloat64 f64MaxTemp;
+
+	/** What the balancer sees */
+	Lfloat32 f32Cells[C_TS001__CELLS];
+	Lfloat32 f32TempC[C_TS001__MODULES];
+	Lfloat32 f32Rest[C_TS001__CELLS];
+	Luint8 u8Mask[C_TS001__MODULES];
+	ATA6870__MODULE_STATS_T sModule[C_TS001__MODULES];
+	ATA6870__PACK_STATS_T sPack;
+	ATA6870__BALANCER_T sCtrl;
+
+	Luint32 u32Rand;
+
+}sTS001;
+
+//Function to call the tests for this test specification
+void vLCCM650R0_TS_001(void)
+{
+	//Call the test cases
+	vLCCM650R0_TS_001_TCASE_001();
+	vLCCM650R0_TS_001_TCASE_002();
+	vLCCM650R0_TS_001_TCASE_003();
+	vLCCM650R0_TS_001_TCASE_004();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM650R0.TS.001.TCASE.001
+ * @st_test_desc
+ * The module then pack fold must give the same min, max, their cells, sum and
+ * mean as a plain scan of every cell.
+ *
+*/
+void vLCCM650R0_TS_001_TCASE_001(void)
+{
+	char cText[200];
+	Luint32 u32Run;
+	Luint32 u32Cell;
+	Luint16 u16Module;
+	Luint32 u32Fail;
+	Lfloat64 f64Sum;
+	Lfloat32 f32Min;
+	Lfloat32 f32Max;
+	Luint16 u16MinCell;
+	Luint16 u16MaxCell;
+
+	DEBUG_PRINT("START:LCCM650R0.TS.001.TCASE.001\r\n");
+
+	vTS001__Reset(25.0);
+
+	u32Fail = 0U;
+	for(u32Run = 0U; u32Run < 1000U; u32Run++)
+	{
+		//anything from flat to wild, ties on the small spreads
+		for(u32Cell = 0U; u32Cell < C_TS001__CELLS; u32Cell++)
+		{
+			sTS001.f32Cells[u32Cell] = 3.0F + ((Lfloat32)(u32TS001__Rand() % ((u32Run % 100U) + 1U)) * 0.0015F);
+		}
+
+		for(u16Module = 0U; u16Module < C_TS001__MODULES; u16Module++)
+		{
+			vATA6870_BALANCE__Module_Stats(&sTS001.f32Cells[(Luint32)u16Module * C_ATA6870__MAX_CELLS], &sTS001.sModule[u16Module]);
+		}
+		vATA6870_BALANCE__Pack_Stats(&sTS001.sModule[0], C_TS001__MODULES, &sTS001.sPack);
+
+		//the long way, first of any tie like the fold
+		f64Sum = 0.0;
+		f32Min = sTS001.f32Cells[0];
+		f32Max = sTS001.f32Cells[0];
+		u16MinCell = 0U;
+		u16MaxCell = 0U;
+		for(u32Cell = 0U; u32Cell < C_TS001__CELLS; u32Cell++)
+		{
+			f64Sum += (Lfloat64)sTS001.f32Cells[u32Cell];
+			if(sTS001.f32Cells[u32Cell] < f32Min)
+			{
+				f32Min = sTS001.f32Cells[u32Cell];
+				u16MinCell = (Luint16)u32Cell;
+			}
+			else
+			{
+				//fall on
+			}
+			if(sTS001.f32Cells[u32Cell] > f32Max)
+			{
+				f32Max = sTS001.f32Cells[u32Cell];
+				u16MaxCell = (Luint16)u32Cell;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+
+		if((sTS001.sPack.f32Min != f32Min) || (sTS001.sPack.f32Max != f32Max) ||
+			(sTS001.sPack.u16MinCell != u16MinCell) || (sTS001.sPack.u16MaxCell != u16MaxCell) ||
+			(sTS001.sPack.f32Spread != (f32Max - f32Min)) ||
+			(((Lfloat64)sTS001.sPack.f32Sum - f64Sum) > 0.001) || ((f64Sum - (Lfloat64)sTS001.sPack.f32Sum) > 0.001) ||
+			((((Lfloat64)sTS001.sPack.f32Mean * (Lfloat64)C_TS001__CELLS) - f64Sum) > 0.001) ||
+			((f64Sum - ((Lfloat64)sTS001.sPack.f32Mean * (Lfloat64)C_TS001__CELLS)) > 0.001))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//same
+		}
+	}
+
+	sprintf(cText, "INFO: %u cells, 1000 packs, %u mismatches\r\n", C_TS001__CELLS, u32Fail);
+	DEBUG_PRINT(cText);
+
+	if(u32Fail == 0U)
+	{
+		DEBUG_PRINT("PASS:LCCM650R0.TS.001.TCASE.001\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM650R0.TS.001.TCASE.001\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM650R0.TS.001.TCASE.001\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM650R0.TS.001.TCASE.002
+ * @st_test_desc
+ * Room temperature. The pack must balance to the target spread in under twice
+ * the ideal time without taking any cell below where the lowest one started.
+ *
+*/
+void vLCCM650R0_TS_001_TCASE_002(void)
+{
+	char cText[200];
+	Luint8 u8Done;
+
+	DEBUG_PRINT("START:LCCM650R0.TS.001.TCASE.002\r\n");
+
+	vTS001__Reset(25.0);
+	u8Done = u8TS001__Run();
+
+	sprintf(cText, "INFO: %u cells, spread %.1f mV, done in %.0f s, ideal %.0f s (x%.2f), %u windows, min drop %.1f mV, max %.1f C\r\n",
+			C_TS001__CELLS, (Lfloat64)sTS001.sCtrl.sRest.f32Spread * 1000.0, sTS001.f64Time_s, sTS001.f64Ideal_s,
+			sTS001.f64Time_s / sTS001.f64Ideal_s, sTS001.sCtrl.u32Windows,
+			(sTS001.f64MinStart_V - sTS001.f64MinSeen_V) * 1000.0, sTS001.f64MaxTemp);
+	DEBUG_PRINT(cText);
+
+	if((u8Done == 1U) &&
+		(sTS001.sCtrl.sRest.f32Spread <= C_ATA6870__BALANCE_TARGET_V) &&
+		(sTS001.f64Time_s < (2.0 * sTS001.f64Ideal_s)) &&
+		(sTS001.f64MinSeen_V > (sTS001.f64MinStart_V - 0.002)) &&
+		(sTS001.f64MaxTemp < (Lfloat64)C_ATA6870__BALANCE_CUTOFF_DEGC))
+	{
+		DEBUG_PRINT("PASS:LCCM650R0.TS.001.TCASE.002\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM650R0.TS.001.TCASE.002\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM650R0.TS.001.TCASE.002\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM650R0.TS.001.TCASE.003
+ * @st_test_desc
+ * Hot pack, ambient above the derate and one resistor is enough to reach the
+ * cutoff. No module may run on past the cutoff by more than a sweep's worth
+ * and the pack must still balance.
+ *
+*/
+void vLCCM650R0_TS_001_TCASE_003(void)
+{
+	char cText[200];
+	Luint8 u8Done;
+
+	DEBUG_PRINT("START:LCCM650R0.TS.001.TCASE.003\r\n");
+
+	vTS001__Reset(52.0);
+	u8Done = u8TS001__Run();
+
+	sprintf(cText, "INFO: spread %.1f mV, done in %.0f s, ideal %.0f s (x%.2f), max %.2f C, %u thermal trips\r\n",
+			(Lfloat64)sTS001.sCtrl.sRest.f32Spread * 1000.0, sTS001.f64Time_s, sTS001.f64Ideal_s,
+			sTS001.f64Time_s / sTS001.f64Ideal_s, sTS001.f64MaxTemp, sTS001.sCtrl.u32ThermalTrips);
+	DEBUG_PRINT(cText);
+
+	if((u8Done == 1U) &&
+		(sTS001.sCtrl.sRest.f32Spread <= C_ATA6870__BALANCE_TARGET_V) &&
+		(sTS001.sCtrl.u32ThermalTrips > 0U) &&
+		(sTS001.f64MaxTemp < ((Lfloat64)C_ATA6870__BALANCE_CUTOFF_DEGC + 0.1)))
+	{
+		DEBUG_PRINT("PASS:LCCM650R0.TS.001.TCASE.003\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM650R0.TS.001.TCASE.003\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM650R0.TS.001.TCASE.003\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM650R0.TS.001.TCASE.004
+ * @st_test_desc
+ * The chain glue. Bursts landing through Module_Update / Sweep_Done must give
+ * the pack stats, a started balance must queue discharge writes on the
+ * engine after its rest, or queue none with balancing off in the localdef,
+ * and a stop must queue them all off.
+ *
+*/
+void vLCCM650R0_TS_001_TCASE_004(void)
+{
+	char cText[200];
+	Luint8 u8Device;
+	Luint8 u8Cell;
+	Luint16 u16Sweep;
+	Luint8 u8Queued;
+	Luint8 u8QueuedExpect;
+	Luint8 u8StatsOk;
+	Luint8 u8AllOff;
+
+	DEBUG_PRINT("START:LCCM650R0.TS.001.TCASE.004\r\n");
+
+	vATA6870_ENGINE__Init();
+	vATA6870_BALANCE__Init();
+
+	//last device 20mV high on cell 5, every NTC reading 25C
+	for(u8Device = 0U; u8Device < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Device++)
+	{
+		for(u8Cell = 0U; u8Cell < C_ATA6870__MAX_CELLS; u8Cell++)
+		{
+			sATA6870.f32Voltage[((Luint32)u8Device * C_ATA6870__MAX_CELLS) + u8Cell] = 3.800F;
+		}
+		sATA6870.f32NTCTemperatureReading[u8Device] = 0.9F;
+	}
+	sATA6870.f32Voltage[((C_LOCALDEF__LCCM650__NUM_DEVICES - 1U) * C_ATA6870__MAX_CELLS) + 5U] = 3.820F;
+
+	vATA6870_BALANCE__Start();
+	for(u16Sweep = 0U; u16Sweep < C_ATA6870__BALANCE_REST_SWEEPS; u16Sweep++)
+	{
+		for(u8Device = 0U; u8Device < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Device++)
+		{
+			vATA6870_BALANCE__Module_Update(u8Device);
+		}
+		vATA6870_BALANCE__Sweep_Done();
+		vATA6870_BALANCE__Process();
+	}
+
+	u8StatsOk = 0U;
+	if((sATA6870.sBalance.sPack.u16MaxCell == (Luint16)(((C_LOCALDEF__LCCM650__NUM_DEVICES - 1U) * C_ATA6870__MAX_CELLS) + 5U)) &&
+		(sATA6870.sBalance.sPack.f32Spread > 0.0199F) && (sATA6870.sBalance.sPack.f32Spread < 0.0201F) &&
+		(f32ATA6870_BALANCE__Get_PackVolts() > ((3.8F * (Lfloat32)(C_LOCALDEF__LCCM650__NUM_DEVICES * C_ATA6870__MAX_CELLS)) + 0.019F)))
+	{
+		u8StatsOk = 1U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	u8Queued = sATA6870.sEngine.sDevice[C_LOCALDEF__LCCM650__NUM_DEVICES - 1U].u8DischargePending;
+	if(sATA6870.sEngine.sDevice[C_LOCALDEF__LCCM650__NUM_DEVICES - 1U].u8Discharge != 0x20U)
+	{
+		u8Queued = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vATA6870_BALANCE__Stop();
+	vATA6870_BALANCE__Process();
+	u8AllOff = 0U;
+	if((sATA6870.sEngine.sDevice[C_LOCALDEF__LCCM650__NUM_DEVICES - 1U].u8Discharge == 0U) &&
+		(u16ATA6870_BALANCE__Get_Bleeding() == 0U) &&
+		(u8ATA6870_BALANCE__Is_Busy() == 0U))
+	{
+		u8AllOff = 1U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	sprintf(cText, "INFO: stats %u, discharge queued %u, all off %u\r\n", u8StatsOk, u8Queued, u8AllOff);
+	DEBUG_PRINT(cText);
+
+	#if C_LOCALDEF__LCCM650__ENABLE_BALANCING == 1U
+		u8QueuedExpect = 1U;
+	#else
+		//start must refuse
+		u8QueuedExpect = 0U;
+	#endif
+
+	if((u8StatsOk == 1U) && (u8Queued == u8QueuedExpect) && (u8AllOff == 1U))
+	{
+		DEBUG_PRINT("PASS:LCCM650R0.TS.001.TCASE.004\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM650R0.TS.001.TCASE.004\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM650R0.TS.001.TCASE.004\r\n");
+}
+
+/***************************************************************************//**
+ * @brief
+ * New pack, the same every time, and a stopped balancer over it.
+ *
+ */
+static void vTS001__Reset(Lfloat64 f64Ambient)
+{
+	Luint32 u32Cell;
+	Luint16 u16Module;
+	Lfloat64 f64Min;
+	Lfloat64 f64Max;
+	Lfloat64 f64Bleed_A;
+
+	sTS001.u32Rand = 0x6870U;
+	sTS001.f64Ambient = f64Ambient;
+	sTS001.f64Time_s = 0.0;
+
+	f64Min = 1.0;
+	f64Max = 0.0;
+	for(u32Cell = 0U; u32Cell < C_TS001__CELLS; u32Cell++)
+	{
+		sTS001.f64SOC[u32Cell] = C_TS001__SOC_CENTRE + ((((Lfloat64)(u32TS001__Rand() % 2001U) / 1000.0) - 1.0) * C_TS001__SOC_SPAN);
+		if(sTS001.f64SOC[u32Cell] < f64Min)
+		{
+			f64Min = sTS001.f64SOC[u32Cell];
+		}
+		else
+		{
+			//fall on
+		}
+		if(sTS001.f64SOC[u32Cell] > f64Max)
+		{
+			f64Max = sTS001.f64SOC[u32Cell];
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	//the worst cell bleeding flat out the whole time
+	f64Bleed_A = (C_TS001__OCV_EMPTY_V + (C_TS001__OCV_SLOPE_V * C_TS001__SOC_CENTRE)) / C_TS001__BLEED_R_OHM;
+	sTS001.f64Ideal_s = ((f64Max - f64Min) * C_TS001__CAPACITY_AH * 3600.0) / f64Bleed_A;
+	sTS001.f64MinStart_V = C_TS001__OCV_EMPTY_V + (C_TS001__OCV_SLOPE_V * f64Min);
+	sTS001.f64MinSeen_V = sTS001.f64MinStart_V;
+
+	for(u16Module = 0U; u16Module < C_TS001__MODULES; u16Module++)
+	{
+		sTS001.f64TempC[u16Module] = f64Ambient;
+		sTS001.u8Mask[u16Module] = 0U;
+	}
+	sTS001.f64MaxTemp = f64Ambient;
+
+	vATA6870_BALANCE__Ctrl_Init(&sTS001.sCtrl, C_TS001__MODULES, &sTS001.f32Cells[0], &sTS001.f32TempC[0], &sTS001.f32Rest[0], &sTS001.u8Mask[0]);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Take a sweep of the pack as the chain would see it.
+ *
+ */
+static void vTS001__Measure(void)
+{
+	Luint32 u32Cell;
+	Luint16 u16Module;
+	Luint8 u8Bit;
+	Lfloat64 f64Volts;
+	Lfloat64 f64Raw;
+	Lint32 s32Dither;
+
+	for(u32Cell = 0U; u32Cell < C_TS001__CELLS; u32Cell++)
+	{
+		u16Module = (Luint16)(u32Cell / C_ATA6870__MAX_CELLS);
+		u8Bit = (Luint8)(1U << (u32Cell % C_ATA6870__MAX_CELLS));
+
+		f64Volts = C_TS001__OCV_EMPTY_V + (C_TS001__OCV_SLOPE_V * sTS001.f64SOC[u32Cell]);
+		if(f64Volts < sTS001.f64MinSeen_V)
+		{
+			sTS001.f64MinSeen_V = f64Volts;
+		}
+		else
+		{
+			//fall on
+		}
+
+		//bleeding pulls the terminal down through the cell resistance
+		if((sTS001.u8Mask[u16Module] & u8Bit) != 0U)
+		{
+			f64Volts -= (f64Volts / C_TS001__BLEED_R_OHM) * C_TS001__CELL_R_OHM;
+		}
+		else
+		{
+			//fall on
+		}
+
+		//ADC LSB with a one LSB dither
+		s32Dither = (Lint32)(u32TS001__Rand() % 3U) - 1;
+		f64Raw = (f64Volts / (Lfloat64)C_ATA6870__ADC_RES_V) + 0.5;
+		sTS001.f32Cells[u32Cell] = (Lfloat32)(((Lfloat64)((Lint32)f64Raw + s32Dither)) * (Lfloat64)C_ATA6870__ADC_RES_V);
+	}
+
+	//stats as each module lands, then the pack, as the engine does
+	for(u16Module = 0U; u16Module < C_TS001__MODULES; u16Module++)
+	{
+		vATA6870_BALANCE__Module_Stats(&sTS001.f32Cells[(Luint32)u16Module * C_ATA6870__MAX_CELLS], &sTS001.sModule[u16Module]);
+		sTS001.f32TempC[u16Module] = (Lfloat32)sTS001.f64TempC[u16Module];
+	}
+	vATA6870_BALANCE__Pack_Stats(&sTS001.sModule[0], C_TS001__MODULES, &sTS001.sPack);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Balance the pack, sweep by sweep.
+ *
+ * @return			1 = balanced before the time limit
+ */
+static Luint8 u8TS001__Run(void)
+{
+	Luint32 u32Cell;
+	Luint16 u16Module;
+	Luint8 u8Bit;
+	Lfloat64 f64Volts;
+	Lfloat64 f64Power;
+	Luint8 u8Return;
+
+	u8Return = 0U;
+	vTS001__Measure();
+	vATA6870_BALANCE__Ctrl_Start(&sTS001.sCtrl);
+
+	while((sTS001.sCtrl.eState != BALANCE_STATE__IDLE) && (sTS001.f64Time_s < C_TS001__MAX_S))
+	{
+		//a sweep's worth of bleeding and heating
+		for(u16Module = 0U; u16Module < C_TS001__MODULES; u16Module++)
+		{
+			f64Power = 0.0;
+			for(u32Cell = 0U; u32Cell < C_ATA6870__MAX_CELLS; u32Cell++)
+			{
+				u8Bit = (Luint8)(1U << u32Cell);
+				if((sTS001.u8Mask[u16Module] & u8Bit) != 0U)
+				{
+					f64Volts = C_TS001__OCV_EMPTY_V + (C_TS001__OCV_SLOPE_V * sTS001.f64SOC[((Luint32)u16Module * C_ATA6870__MAX_CELLS) + u32Cell]);
+					sTS001.f64SOC[((Luint32)u16Module * C_ATA6870__MAX_CELLS) + u32Cell] -= ((f64Volts / C_TS001__BLEED_R_OHM) * C_TS001__SWEEP_S) / (C_TS001__CAPACITY_AH * 3600.0);
+					f64Power += (f64Volts * f64Volts) / C_TS001__BLEED_R_OHM;
+				}
+				else
+				{
+					//fall on
+				}
+			}
+
+			sTS001.f64TempC[u16Module] += (((sTS001.f64Ambient + (f64Power * C_TS001__THERMAL_R)) - sTS001.f64TempC[u16Module]) * C_TS001__SWEEP_S) / C_TS001__THERMAL_TAU_S;
+			if(sTS001.f64TempC[u16Module] > sTS001.f64MaxTemp)
+			{
+				sTS001.f64MaxTemp = sTS001.f64TempC[u16Module];
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		sTS001.f64Time_s += C_TS001__SWEEP_S;
+
+		vTS001__Measure();
+		vATA6870_BALANCE__Ctrl_Sweep(&sTS001.sCtrl);
+	}
+
+	if(sTS001.sCtrl.u8Done == 1U)
+	{
+		u8Return = 1U;
+	}
+	else
+	{
+		//ran out of time
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Repeatable LCG.
+ *
+ */
+static Luint32 u32TS001__Rand(void)
+{
+	sTS001.u32Rand = (sTS001.u32Rand * 1103515245U) + 12345U;
+	return (sTS001.u32Rand >> 8U);
+}
+
+#endif //C_LOCALDEF__LCCM650__ENABLE_TEST_SPEC
+#endif //#if C_LOCALDEF__LCCM650__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM650__ENABLE_THIS_MODULE
+	#error
+#endif
@@ -28,12 +28,6 @@
 //main structure
 struct _str6870 sATA6870;
 
-//locals
-static Luint8 uATA6870__GetStatus(Luint8 u8DeviceIndex);
-static Luint8 uATA6870__GetOpStatus(Luint8 u8DeviceIndex);
-static Luint8 uATA6870__BulkRead(void);
-static void vATA6870__StartConversion(Luint8 u8VoltageMode, Luint8 u8TempBit);
-
 
 /***************************************************************************//**
  * @brief
@@ -63,6 +57,9 @@ void vATA6870__Init(void)
 
 	//setup the lowlevel
 	vATA6870_LOWLEVEL__Init();
+
+	//build the frames for the acquisition engine
+	vATA6870_ENGINE__Init();
 	
 	//setup the interrupts
 	vATA6870_INT__Init();
@@ -127,27 +124,16 @@ void vATA6870__Process(void)
 			//do nothing,
 			break;
 		case ATA6870_STATE__INIT_DEVICE:
-			sATA6870.eState = ATA6870_STATE__START_CONVERSION;
+			//kick off the scan of the chain
+			vATA6870_ENGINE__Start();
+			sATA6870.eState = ATA6870_STATE__RUN;
 			break;
-		case ATA6870_STATE__START_CONVERSION:
-			vATA6870__StartConversion(1U, 1U);
-			sATA6870.eState = ATA6870_STATE__WAIT_CONVERSION;
+		case ATA6870_STATE__RUN:
+			//conversions and burst reads, one frame at a time
+			vATA6870_ENGINE__Process();
 			break;
-		case ATA6870_STATE__WAIT_CONVERSION:
-			// 8.2ms conversion time according to datasheet
-			if(sATA6870.u32ISR_Counter > 1U)
-			{
-				//go and read the voltages now
-				sATA6870.eState = ATA6870_STATE__READ_CELL_VOLTAGES;
-			}
-			else
-			{
-				//wait here.
-			}
-			break;
-		case ATA6870_STATE__READ_CELL_VOLTAGES:
-			uATA6870__BulkRead();
-			sATA6870.eState = ATA6870_STATE__START_CONVERSION;
+		default:
+			//nothing to do
 			break;
 	}
 
@@ -156,120 +142,6 @@ void vATA6870__Process(void)
 }
 
 
-/***************************************************************************//**
- * @brief
- * Start ATA6870N Conversion
- *
- * @st_funcMD5
- * @st_funcID
- */
-void vATA6870__StartConversion(Luint8 u8VoltageMode, Luint8 u8TempBit)
-{
-	Luint8 u8Counter;						// loop counter
-	Luint8 u8TempData;						// Temporary Data
-
-	// start conversion by clearing out any existing commands and issuing our own
-	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Counter++)
-	{
-		//Clear any existing interrupts
-		uATA6870__GetStatus(u8Counter);
-
-		// check and clear existing commands
-		if (uATA6870__GetOpStatus(u8Counter) != 0U)
-		{
-			//OpClear
-			u8TempData = 0x00U;
-
-			//clear existing command
-			vATA6870_LOWLEVEL__Reg_WriteU8(u8Counter, ATA6870_REG__OPERATION, &u8TempData, 1U);
-
-			vRM4_DELAYS__Delay_mS(5U);
-
-			//Get Status
-			uATA6870__GetStatus(u8Counter);
-
-			//Get Op Status
-			uATA6870__GetOpStatus(u8Counter);
-		}
-
-		//Op Req Data
-		u8TempData = (0x01 | (u8VoltageMode << 1) | (u8TempBit << 3));
-		//Start Conversion
-		vATA6870_LOWLEVEL__Reg_WriteU8(u8Counter, ATA6870_REG__OPERATION, &u8TempData, 1U);
-	}
-
-	//clear the counter
-	sATA6870.u32ISR_Counter = 0U;
-}
-
-/***************************************************************************//**
- * @brief
- * bulk read voltages: 6 voltages, 1 temperature
- *
- * @st_funcMD5
- * @st_funcID
- */
-Luint8 uATA6870__BulkRead(void)
-{
-	// volt mode = calibration or regular acquisition. 0 for calibration, 1 for regular.
-	// tempBit = temperature sensor to select. 1 for internal, 0 for external.
-
-
-	Luint8 u8Counter;						// loop counter
-	Luint8 u8VolCounter = 0U;				// number of cell voltage readings
-	Luint8 u8BulkReadError = 0U;			// error flag
-
-	// read data
-	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM650__NUM_DEVICES; u8Counter++)
-	{
-		vATA6870_CELL__Get_Voltages(u8Counter, &sATA6870.f32Voltage[u8VolCounter], &sATA6870.f32NTCTemperatureReading[u8Counter]);
-		// move to next module
-		u8VolCounter += C_ATA6870__MAX_CELLS;
-	}
-	// check if any cells are dead or out of threshold
-	u8BulkReadError = uATA6870__u8VoltageError(&sATA6870.f32Voltage[0]);
-
-	return u8BulkReadError;
-}
-
-
-/***************************************************************************//**
- * @brief
- * read the status register
- *
- * @st_funcMD5
- * @st_funcID
- */
-Luint8 uATA6870__GetStatus(Luint8 u8DeviceIndex)
-{
-	Luint8 u8Return = 0xFFU;
-	vATA6870_LOWLEVEL__Reg_WriteU8(u8DeviceIndex, ATA6870_REG__IRQ_STATUS, &u8Return, 1U);
-
-	return u8Return;
-}
-
-/***************************************************************************//**
- * @brief
- * get operation status
- *
- * @st_funcMD5
- * @st_funcID
- */
-Luint8 uATA6870__GetOpStatus(Luint8 u8DeviceIndex)
-{
-	//useage
-	// output:
-	// 0 = no operation
-	// 1 = ongoing operation
-	// 2 = operation finished
-	// 3 = operation failed/was canceled. result not available.
-
-	Luint8 u8Return = 0xFFU;
-	vATA6870_LOWLEVEL__Reg_ReadU8(u8DeviceIndex, ATA6870_REG__OP_STATUS, &u8Return, 1U);
-
-	return u8Return;
-}
-
 //*** check if a cell is above or below safe threshold ***//
 //TODO: if we use UNDER_VOLT function instead, be sure to implement
 //      an upper bound check as well for over voltage
@@ -35,16 +35,46 @@
 		/** Voltage input measurement resolution in VOLTS */
 		#define C_ATA6870__ADC_RES_V				(0.0015F)
 
+		/** Longest SPI frame, ID + control + burst + CRC */
+		#define C_ATA6870__FRAME_MAX				(2U + 1U + C_ATA6870__BUSRT_LENGTH + 1U)
+
+		/** Operation request the engine issues, start, regular acquisition, internal temp sensor */
+		#define C_ATA6870__OP_START					(0x01U | (1U << 1U) | (1U << 3U))
+
 		//** Voltage thresholds for each module, CHANGE IF NEEDED*/
 		#define C_ATA6870_MIN_VOLTS					(3.0)
 		#define C_ATA6870_MAX_VOLTS					(4.3)
 
+		/** Balancer, CHANGE IF NEEDED */
+		/** Balanced once the spread of the resting cells is under this */
+		#define C_ATA6870__BALANCE_TARGET_V			(0.005F)
+
+		/** Sweeps in each bleed window */
+		#define C_ATA6870__BALANCE_ON_SWEEPS			(1000U)
+
+		/** Sweeps with every resistor off between windows, the first is thrown away
+		 * as it may have started while bleeding, the rest are averaged. Min 2 */
+		#define C_ATA6870__BALANCE_REST_SWEEPS			(8U)
+
+		/** Resistors on at once on a device */
+		#define C_ATA6870__BALANCE_MAX_PER_DEVICE		(3U)
+
+		/** Device temperature to halve the resistors on, and to stop them */
+		#define C_ATA6870__BALANCE_DERATE_DEGC			(50.0F)
+		#define C_ATA6870__BALANCE_CUTOFF_DEGC			(60.0F)
+
 		/** Balancer Stats */
 		typedef enum
 		{
 
 			/** not doing anything, waiting for a start command*/
-			BALANCE_STATE__IDLE = 0U
+			BALANCE_STATE__IDLE = 0U,
+
+			/** Resistors off, averaging the cells for the next plan */
+			BALANCE_STATE__REST,
+
+			/** Resistors on as planned, thermal limits checked each sweep */
+			BALANCE_STATE__BLEED
 
 
 		}E_ATA6870__BALANCE_STATE_T;
@@ -55,23 +85,179 @@
 			ATA6870_STATE__IDLE = 0U,
 			ATA6870_STATE__ERROR,
 			ATA6870_STATE__INIT_DEVICE,
-			ATA6870_STATE__START_CONVERSION,
-			ATA6870_STATE__WAIT_CONVERSION,
-			ATA6870_STATE__READ_CELL_VOLTAGES,
+
+			/** The acquisition engine is scanning the chain */
+			ATA6870_STATE__RUN,
 			ATA6870_STATE__INTERRUPT,
 		}E_ATA6870_STATE_T;
 
+		/** The precomputed SPI frames held for each device */
+		typedef enum
+		{
+			/** Read the IRQ status, this releases dataRdy */
+			ATA6870_FRAME__IRQ_STATUS = 0U,
+
+			/** Read the operation status */
+			ATA6870_FRAME__OP_STATUS,
+
+			/** Write 0 to the operation register to cancel */
+			ATA6870_FRAME__OP_CANCEL,
+
+			/** Write C_ATA6870__OP_START to the operation register */
+			ATA6870_FRAME__OP_START,
+
+			/** 14 byte burst of the 6 cells and the temperature */
+			ATA6870_FRAME__BURST,
+
+			/** Write the discharge resistor mask, built when it is queued */
+			ATA6870_FRAME__DISCHARGE,
+
+			/** Number of frame types, not a frame */
+			ATA6870_FRAME__NUM
+
+		}E_ATA6870__FRAME_T;
+
+		/** Where each device is in its acquisition cycle */
+		typedef enum
+		{
+			/** Make sure the device is not still busy with an old operation */
+			ATA6870_DEV__CHECK_OP = 0U,
+
+			/** An old operation was busy, cancel it */
+			ATA6870_DEV__CANCEL,
+
+			/** Read the IRQ status so the device will accept a new operation */
+			ATA6870_DEV__CLEAR_IRQ,
+
+			/** Request the conversion */
+			ATA6870_DEV__START,
+
+			/** Conversion running, poll the op status */
+			ATA6870_DEV__CONVERTING,
+
+			/** Conversion done, burst read the results */
+			ATA6870_DEV__READ
+
+		}E_ATA6870__DEV_STATE_T;
+
+		/** What the engine has on the SPI bus */
+		typedef enum
+		{
+			/** Free, a frame can start */
+			ATA6870_BUS__IDLE = 0U,
+
+			/** A frame is being clocked with nCS low */
+			ATA6870_BUS__FRAME,
+
+			/** The guard byte after a frame with nCS high */
+			ATA6870_BUS__GUARD
+
+		}E_ATA6870__BUS_STATE_T;
+
 
 		/*******************************************************************************
 		Structures
 		*******************************************************************************/
+		/** Stats of one device's cells, one pass as its burst lands */
+		typedef struct
+		{
+			/** Module voltage */
+			Lfloat32 f32Sum;
+
+			Lfloat32 f32Min;
+			Lfloat32 f32Max;
+
+			/** Cell 0 to 5 */
+			Luint8 u8MinCell;
+			Luint8 u8MaxCell;
+
+		}ATA6870__MODULE_STATS_T;
+
+		/** Pack stats, the module stats folded together */
+		typedef struct
+		{
+			/** Pack voltage */
+			Lfloat32 f32Sum;
+
+			Lfloat32 f32Min;
+			Lfloat32 f32Max;
+			Lfloat32 f32Mean;
+
+			/** Max - Min */
+			Lfloat32 f32Spread;
+
+			/** Cell index in the pack */
+			Luint16 u16MinCell;
+			Luint16 u16MaxCell;
+
+		}ATA6870__PACK_STATS_T;
+
+		/** A balancer over any number of 6 cell modules, the caller owns the arrays */
+		typedef struct
+		{
+			E_ATA6870__BALANCE_STATE_T eState;
+
+			Luint16 u16NumModules;
+
+			/** Live cells, 6 per module, updated before each sweep call */
+			const Lfloat32 *pf32Cells;
+
+			/** Module temperatures, DegC */
+			const Lfloat32 *pf32TempC;
+
+			/** Cells averaged over the last rest, 6 per module */
+			Lfloat32 *pf32Rest;
+
+			/** Discharge mask for each module, bit per cell */
+			Luint8 *pu8Mask;
+
+			/** Sweeps in the current state */
+			Luint16 u16Sweeps;
+
+			/** Nothing above this bleeds, rest min + half the target */
+			Lfloat32 f32Floor;
+
+			/** Stats of the last rest */
+			ATA6870__PACK_STATS_T sRest;
+
+			/** Bleed windows run since the start */
+			Luint32 u32Windows;
+
+			/** Resistors held off by the cutoff temperature */
+			Luint32 u32ThermalTrips;
+
+			/** Finished with the spread in target */
+			Luint8 u8Done;
+
+		}ATA6870__BALANCER_T;
+
 		struct _str6870
 		{
 			E_ATA6870_STATE_T eState;
 			/** Balancing control state machine */
 			struct
 			{
-				E_ATA6870__BALANCE_STATE_T eState;
+				/** The balancer over our chain */
+				ATA6870__BALANCER_T sCtrl;
+
+				/** Stats of each device, refreshed as its burst is read */
+				ATA6870__MODULE_STATS_T sModule[C_LOCALDEF__LCCM650__NUM_DEVICES];
+
+				/** Pack stats of the last sweep */
+				ATA6870__PACK_STATS_T sPack;
+
+				/** Device temperatures for the thermal limits */
+				Lfloat32 f32TempC[C_LOCALDEF__LCCM650__NUM_DEVICES];
+
+				/** Rest averages */
+				Lfloat32 f32Rest[C_LOCALDEF__LCCM650__NUM_DEVICES * C_ATA6870__MAX_CELLS];
+
+				/** Discharge masks wanted, and last handed to the engine */
+				Luint8 u8Mask[C_LOCALDEF__LCCM650__NUM_DEVICES];
+				Luint8 u8Sent[C_LOCALDEF__LCCM650__NUM_DEVICES];
+
+				/** A sweep has finished since the last process */
+				Luint8 u8NewSweep;
 
 			}sBalance;
 
@@ -84,6 +270,9 @@
 					/** The status of the last device ID command where the IRQ status is returned
 					as part of the ID phase of the SPI transaction */
 					Luint16 u16IRQ_Status;
+
+					/** The last status register read by the engine */
+					Luint8 u8Status;
 				
 				}sIRQ;
 		
@@ -97,6 +286,60 @@
 
 			/** The count of 10ms ISR's*/
 			Luint32 u32ISR_Counter;
+
+			/** Non blocking acquisition engine */
+			struct
+			{
+				/** Each device in the chain */
+				struct
+				{
+					/** Frames built once at init, ID + control + data + CRC */
+					Luint8 u8Tx[ATA6870_FRAME__NUM][C_ATA6870__FRAME_MAX];
+
+					/** Where the device is in its cycle */
+					E_ATA6870__DEV_STATE_T eState;
+
+					/** Discharge mask to write, and the write is waiting */
+					Luint8 u8Discharge;
+					Luint8 u8DischargePending;
+
+				}sDevice[C_LOCALDEF__LCCM650__NUM_DEVICES];
+
+				/** What is on the bus */
+				E_ATA6870__BUS_STATE_T eBus;
+
+				/** The device and frame type on the bus */
+				Luint8 u8Device;
+				E_ATA6870__FRAME_T eFrame;
+
+				/** Round robin position for op status polls */
+				Luint8 u8NextPoll;
+
+				/** MISO of the frame on the bus */
+				Luint8 u8Rx[C_ATA6870__FRAME_MAX];
+
+				/** MOSI of the guard byte */
+				Luint8 u8Guard;
+
+				/** Devices read so far in this sweep, bit per device */
+				Luint32 u32SweepMask;
+
+				/** Completed sweeps of the whole chain */
+				Luint32 u32SweepCount;
+
+				/** Frames clocked */
+				Luint32 u32FrameCount;
+
+				/** Operations that came back not running or failed */
+				Luint32 u32OpFault;
+
+				/** Stale operations cancelled */
+				Luint32 u32Cancel;
+
+				/** Pack limits of the last sweep, 1 = a cell over, 2 = a cell under */
+				Luint8 u8VoltageError;
+
+			}sEngine;
 		};
 
 		/*******************************************************************************
@@ -112,6 +355,20 @@
 		void vATA6870_BALANCE__Stop(void);
 		Luint8 u8ATA6870_BALANCE__Is_Busy(void);
 		void vATA6870_BALANCE__Process(void);
+		void vATA6870_BALANCE__Module_Stats(const Lfloat32 *pf32Cells, ATA6870__MODULE_STATS_T *pModule);
+		void vATA6870_BALANCE__Pack_Stats(const ATA6870__MODULE_STATS_T *pModules, Luint16 u16NumModules, ATA6870__PACK_STATS_T *pPack);
+		void vATA6870_BALANCE__Module_Update(Luint8 u8DeviceIndex);
+		void vATA6870_BALANCE__Sweep_Done(void);
+		void vATA6870_BALANCE__Ctrl_Init(ATA6870__BALANCER_T *pCtrl, Luint16 u16NumModules, const Lfloat32 *pf32Cells, const Lfloat32 *pf32TempC, Lfloat32 *pf32Rest, Luint8 *pu8Mask);
+		void vATA6870_BALANCE__Ctrl_Start(ATA6870__BALANCER_T *pCtrl);
+		void vATA6870_BALANCE__Ctrl_Stop(ATA6870__BALANCER_T *pCtrl);
+		void vATA6870_BALANCE__Ctrl_Sweep(ATA6870__BALANCER_T *pCtrl);
+		Lfloat32 f32ATA6870_BALANCE__Get_PackVolts(void);
+		Lfloat32 f32ATA6870_BALANCE__Get_CellMin(void);
+		Lfloat32 f32ATA6870_BALANCE__Get_CellMax(void);
+		Lfloat32 f32ATA6870_BALANCE__Get_CellMean(void);
+		Lfloat32 f32ATA6870_BALANCE__Get_Spread(void);
+		Luint16 u16ATA6870_BALANCE__Get_Bleeding(void);
 
 		//lowlevel
 		void vATA6870_LOWLEVEL__Init(void);
@@ -120,9 +377,20 @@
 		void vATA6870_LOWLEVEL__PowerOn(void);
 		void vATA6870_LOWLEVEL__PowerOff(void);
 		Luint8 u8ATA6870_LOWLEVEL__Get_PowerAvail(void);
+		Luint8 u8ATA6870_LOWLEVEL__CRC(Luint8 u8InitialCRC, Luint8 u8Data);
+
+		//acquisition engine
+		void vATA6870_ENGINE__Init(void);
+		void vATA6870_ENGINE__Start(void);
+		void vATA6870_ENGINE__Process(void);
+		void vATA6870_ENGINE__Bus_Acquire(void);
+		void vATA6870_ENGINE__Xfer_Polled(const Luint8 *pu8Tx, Luint8 *pu8Rx, Luint16 u16Length);
+		Luint32 u32ATA6870_ENGINE__Get_SweepCount(void);
+		void vATA6870_ENGINE__Set_Discharge(Luint8 u8DeviceIndex, Luint8 u8Mask);
 
 		//cells
 		void vATA6870_CELL__Get_Voltages(Luint8 u8DeviceIndex, Lfloat32 *pf32Voltages, Lfloat32 *pF32Temperature);
+		void vATA6870_CELL__Unpack(const Luint8 *pu8Buffer, Lfloat32 *pf32Voltages, Lfloat32 *pF32Temperature);
 		
 		//device scanning
 		void vATA6870_SCAN__Start(void);
@@ -131,6 +399,7 @@
 		void vATA6870_RES__TurnOn(Luint8 u8DeviceIndex, Luint8 u8CellIndex);
 		void vATA6870_RES__TurnOff(Luint8 u8DeviceIndex, Luint8 u8CellIndex);
 		void vATA6870_RES__TurnAllOff(Luint8 u8DeviceIndex);
+		void vATA6870_RES__Set_Mask(Luint8 u8DeviceIndex, Luint8 u8Mask);
 		
 		//undervoltage detection
 		void vATA6870_UV__Set_UVTrip(Luint8 u8DeviceIndex, Lfloat32 f32Value);
@@ -145,10 +414,30 @@
 		
 		Luint8 uATA6870__u8VoltageError(Lfloat32 *pf32Voltages);
 
+		#if C_LOCALDEF__LCCM650__ENABLE_TEST_SPEC == 1U
+			DLL_DECLARATION void vLCCM650R0_TS_000(void);
+			void vLCCM650R0_TS_000__Xfer_Start(const Luint8 *pu8Tx, Luint8 *pu8Rx, Luint16 u16Length);
+			Luint8 u8LCCM650R0_TS_000__Xfer_Busy(void);
+			Luint8 u8LCCM650R0_TS_000__Tx_U8(Luint8 u8Data);
+			void vLCCM650R0_TS_000__NCS(Luint8 u8Value);
+			DLL_DECLARATION void vLCCM650R0_TS_001(void);
+		#endif
+
 	//safetys
 	#ifndef C_LOCALDEF__LCCM650__NUM_DEVICES
 		#error
 	#endif
+	#ifndef C_LOCALDEF__LCCM650__ENABLE_BALANCING
+		#error
+	#endif
+	#if C_LOCALDEF__LCCM650__ENABLE_BALANCING == 1U
+		#ifndef M_LOCALDEF__LCCM650__NTC_TO_DEGC
+			#error
+		#endif
+	#endif
+	#if C_ATA6870__BALANCE_REST_SWEEPS < 2U
+		#error
+	#endif
 		
 	#endif //#if C_LOCALDEF__LCCM650__ENABLE_THIS_MODULE == 1U
 	//safetys
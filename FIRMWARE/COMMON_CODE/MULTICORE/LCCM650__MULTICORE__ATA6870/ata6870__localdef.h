@@ -33,6 +33,21 @@ ATA6870N - BATTERY MANAGEMENT DEVICE
 		#define M_LOCALDEF__LCCM650__NCS_LATCH(val)							{}
 		#define M_LOCALDEF__LCCM650__SPI_TX_U8								{}
 
+		/** Whole frame SPI transfer for the acquisition engine. START must not
+		 * wait for the frame (MibSPI transfer group + DMA), BUSY is non zero until
+		 * it has been clocked. Without DMA use the byte at a time transfer. */
+		#define M_LOCALDEF__LCCM650__SPI_XFER_START(ptx, prx, len)			vATA6870_ENGINE__Xfer_Polled(ptx, prx, len)
+		#define M_LOCALDEF__LCCM650__SPI_XFER_BUSY()						(0U)
+
+		/** Allow cell balancing. The discharge resistors are only safe while
+		 * the thermal cutoff is, so leave this off until NTC_TO_DEGC has been
+		 * fitted to the pack NTCs and their divider. */
+		#define C_LOCALDEF__LCCM650__ENABLE_BALANCING						(0U)
+		#if C_LOCALDEF__LCCM650__ENABLE_BALANCING == 1U
+			/** f32NTCTemperatureReading (volts at the NTC input) to DegC */
+			#define M_LOCALDEF__LCCM650__NTC_TO_DEGC(v)						f32USER__NTC_To_DegC(v)
+		#endif
+
 		#define M_LOCALDEF__LCCM650__POWER_ENABLE_TRIS(x)					{if(x == 0){ vRM4_GIO__Set_BitDirection(gioPORTB, 2U, GIO_DIRECTION__OUTPUT); }else{ vRM4_GIO__Set_BitDirection(gioPORTB, 2U, GIO_DIRECTION__INPUT); }}
 		#define M_LOCALDEF__LCCM650__POWER_ENABLE_LATCH(x)					{vRM4_GIO__Set_Bit(gioPORTB, 2U, x); }
 
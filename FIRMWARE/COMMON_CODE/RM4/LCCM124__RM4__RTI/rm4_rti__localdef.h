@@ -33,6 +33,9 @@ RTI MODULE
 		/** RTCLK1 feeds counter 1 and can be used for 64bit timing */
 		#define C_LOCALDEF__LCCM124__RTI_COUNTER1_PRESCALER					(1U)
 
+		/** Counter 1 rate, RTICLK / (CPUC1 + 1), every module tick rate on this board comes from here */
+		#define C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC				((C_LOCALDEF__LCCM124__RTI_CLK_FREQ * 1000000U) / (C_LOCALDEF__LCCM124__RTI_COUNTER1_PRESCALER + 1U))
+
 
 		//Sets up the time periods for each compare. Must be defined in microSeconds.
 		#define C_LOCALDEF__LCCM124__RTI_COMPARE_0_PERIOD_US 				(15625U)
@@ -95,6 +95,17 @@ RLOOP - PI COMMUNICATIONS MODULE
 		/** enable the receiver side? */
 		#define C_LOCALDEF__LCCM656__ENABLE_RX								(1U)
 
+		/** Transmit queue depth, one frame on the wire, one being built and
+		 * the rest waiting. 2 to 8 */
+		#define C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH						(3U)
+
+		/** Queue overrun, 1 = drop the oldest waiting frame, 0 = drop the new frame */
+		#define C_LOCALDEF__LCCM656__TX_DROP_OLDEST						(1U)
+
+		/** Largest frame the node builds with every payload byte escaped, the
+		 * size of each queue buffer, a multiple of 4, the power node template is about 110 with the BMS stats */
+		#define C_LOCALDEF__LCCM656__TX_FRAME_SIZE						(128U)
+
 		/** Testing Options */
 		#define C_LOCALDEF__LCCM656__ENABLE_TEST_SPEC						(0U)
 
@@ -124,6 +135,18 @@ ATA6870N - BATTERY MANAGEMENT DEVICE
 		#define M_LOCALDEF__LCCM650__NCS_LATCH(val)							{vRM4_GIO__Set_Bit(RM4_GIO__PORT_B, 4U, val);}
 		#define M_LOCALDEF__LCCM650__SPI_TX_U8(x)							u8RM4_MIBSPI135__Tx_U8(MIBSPI135_CHANNEL__1, MIBSPI135_DATA_FORMAT__0, MIBSPI135_CS__NONE, x)
 
+		/** Whole frame SPI transfer for the acquisition engine. START must not
+		 * wait for the frame (MibSPI transfer group + DMA), BUSY is non zero until
+		 * it has been clocked. Without DMA use the byte at a time transfer. */
+		#define M_LOCALDEF__LCCM650__SPI_XFER_START(ptx, prx, len)			vATA6870_ENGINE__Xfer_Polled(ptx, prx, len)
+		#define M_LOCALDEF__LCCM650__SPI_XFER_BUSY()						(0U)
+
+		/** Cell balancing stays off until the pack NTCs and their divider have
+		 * been calibrated, the balancer thermal cutoff depends on them. Cell
+		 * stats still run. With it on, M_LOCALDEF__LCCM650__NTC_TO_DEGC(v) must
+		 * convert volts at the NTC input to DegC. */
+		#define C_LOCALDEF__LCCM650__ENABLE_BALANCING						(0U)
+
 		#define M_LOCALDEF__LCCM650__POWER_ENABLE_TRIS(x)					{if(x == 0U) vRM4_GIO__Set_BitDirection(RM4_GIO__PORT_B, 2U, GIO_DIRECTION__OUTPUT); else vRM4_GIO__Set_BitDirection(RM4_GIO__PORT_B, 2U, GIO_DIRECTION__INPUT); }
 		#define M_LOCALDEF__LCCM650__POWER_ENABLE_LATCH(x)					{vRM4_GIO__Set_Bit(RM4_GIO__PORT_B, 2U, x); }
 
@@ -233,6 +256,13 @@ DS18B20 - 1-Wire Temperature Sensor
 		 */
 		#define C_LOCALDEF__LCCM644__MAX_1WIRE_CHANNELS						(2U)
 
+		/** Upper limit on the number of scheduler steps per call to vDS18B20__Process() */
+		#define C_LOCALDEF__LCCM644__SCHED_STEPS_PER_PROCESS				(32U)
+
+		/** Keep the device table in the EEPROM params so a warm boot can skip the search */
+		#define C_LOCALDEF__LCCM644__ENABLE_ROM_CACHE						(1U)
+		#define C_LOCALDEF__LCCM644__ROM_CACHE__EEPROM_INDEX				(16U)
+
 		/** Testing Options */
 		#define C_LOCALDEF__LCCM644__ENABLE_TEST_SPEC						(0U)
 
@@ -265,6 +295,50 @@ TSYS01 - DIGITAL TEMP SENSOR
 
 	#endif //#if C_LOCALDEF__LCCM647__ENABLE_THIS_MODULE == 1U
 
+/*******************************************************************************
+RLOOP - IEEE1588 POD TIME
+*******************************************************************************/
+	//clock sync over the DP83640, slave to the FCU
+#ifndef WIN32
+	#define C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE							(1U)
+#else
+	#define C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE							(0U)
+#endif
+	#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+
+		/** 1 = grandmaster, 0 = slave */
+		#define C_LOCALDEF__LCCM674__MASTER									(0U)
+
+		/** Sync and Delay_Req interval */
+		#define C_LOCALDEF__LCCM674__SYNC_INTERVAL_MS						(125U)
+
+		/** RTI counter 1 */
+		#define C_LOCALDEF__LCCM674__LOCAL_TICKS_PER_SEC					(C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC)
+		#define M_LOCALDEF__LCCM674__LOCAL_TICKS()							u64RM4_RTI__Get_Counter1()
+
+		/** Real PHY and wire */
+		#define C_LOCALDEF__LCCM674__ENABLE_LOOPBACK						(0U)
+
+		/** DP83640 on MDIO address 1 */
+		#define M_LOCALDEF__LCCM674__PHY_INIT()								vPTP_DP83640__Init(1U)
+		#define M_LOCALDEF__LCCM674__PHY_GET_TIME()							u64PTP_DP83640__Get_Time(1U)
+		#define M_LOCALDEF__LCCM674__PHY_STEP(ns)							vPTP_DP83640__Step(1U, ns)
+		#define M_LOCALDEF__LCCM674__PHY_SET_RATE(ppb)						vPTP_DP83640__Set_Rate(1U, ppb)
+		#define M_LOCALDEF__LCCM674__PHY_TX_STAMP(pt)						s16PTP_DP83640__Get_TxTimestamp(1U, pt)
+		#define M_LOCALDEF__LCCM674__PHY_RX_STAMP(pt,ps,pm)					s16PTP_DP83640__Get_RxTimestamp(1U, pt, ps, pm)
+
+		/** Transport over LCCM325 */
+		#define M_LOCALDEF__LCCM674__TX_ALLOC(length,deadline_us)			s16ETH_FIFO__Push(length)
+		#define M_LOCALDEF__LCCM674__TX_BUFFER(index)						((Luint8 *)u32ETH_BUFFERDESC__Get_TxBufferPointer((Luint8)(index)))
+		#define M_LOCALDEF__LCCM674__TX_SEND(length,port)					vETH_UDP__Transmit(length, port, port)
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM674__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM674__RLOOP__PTP/ptp.h>
+	#endif //#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+
 /*******************************************************************************
 RLOOP - POWER NODE CORE
 *******************************************************************************/
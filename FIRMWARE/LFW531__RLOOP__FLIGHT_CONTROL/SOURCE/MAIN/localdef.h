@@ -118,6 +118,17 @@ RLOOP - PI COMMUNICATIONS MODULE
 		/** enable the receiver side? */
 		#define C_LOCALDEF__LCCM656__ENABLE_RX								(1U)
 
+		/** Transmit queue depth, one frame on the wire, one being built and
+		 * the rest waiting. 2 to 8 */
+		#define C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH						(3U)
+
+		/** Queue overrun, 1 = drop the oldest waiting frame, 0 = drop the new frame */
+		#define C_LOCALDEF__LCCM656__TX_DROP_OLDEST						(1U)
+
+		/** Largest frame the node builds with every payload byte escaped, the
+		 * size of each queue buffer, a multiple of 4, the FCU telemetry template is about 260 */
+		#define C_LOCALDEF__LCCM656__TX_FRAME_SIZE						(320U)
+
 		/** Testing Options */
 		#define C_LOCALDEF__LCCM656__ENABLE_TEST_SPEC						(0U)
 
@@ -125,6 +136,324 @@ RLOOP - PI COMMUNICATIONS MODULE
 		#include <LCCM656__RLOOP__PI_COMMS/pi_comms.h>
 	#endif //#if C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE == 1U
 
+/*******************************************************************************
+RLOOP - DAQ CHANNEL RINGS
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE == 1U
+
+		/** Number of DAQ channels in each data format
+		 * Channels are indexed in this order, U8 first, then S16, U16, S32, U32, F32
+		 * S16 0..5 are the accel X, Y, Z of each chip */
+		#define C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U8					(1U)
+		#define C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S16					(6U)
+		#define C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U16					(1U)
+		#define C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S32					(1U)
+		#define C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U32					(1U)
+		#define C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__F32					(1U)
+
+		/** Length of each channel ring in 4 byte blocks
+		* WARNING: Value must be a power of 2 and a multiple of the watermark.*/
+		#define C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS					(128U)
+
+		/** Each time a channel reaches this level one block of this size is
+		 * passed to the TX handler in place. For channels that are not 4 bytes
+		 * this value will be expanded. */
+		#define C_LOCALDEF__LCCM667__BUFFER_WATERMARK_LEVEL					(64U)
+
+		/** Enable user payload types, otherwise use the standard 0x1210+ for up
+		 * to 128 channels */
+		#define C_LOCALDEF__LCCM667__ENABLE_USER_PAYLOAD_TYPES				(0U)
+
+		/** Enable a snapshot of the core timer along with each sample */
+		#define C_LOCALDEF__LCCM667__ENABLE_TIMER_IN_DATA					(0U)
+
+		/** Transmission handler, the FCU queues blocks for SafeUDP */
+		#define M_LOCALDEF__LCCM667__TX_HANDLER(index, pbuffer, length)		s16FCU_NET_DAQ__TxHandler(index, pbuffer, length)
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM667__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM667__RLOOP__DAQ_RING/daq_ring.h>
+	#endif //#if C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE == 1U
+
+/*******************************************************************************
+RLOOP - BULK BLOCK STREAMING
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE == 1U
+
+		/** Blocks that can be queued, power of 2 */
+		#define C_LOCALDEF__LCCM668__QUEUE_DEPTH							(8U)
+
+		/** Block bytes per packet, small blocks are coalesced up to this if
+		 * they sit back to back in memory. Multiple of 4, max 1436 */
+		#define C_LOCALDEF__LCCM668__CHUNK_SIZE								(1024U)
+
+		/** Chunks sent each process call */
+		#define C_LOCALDEF__LCCM668__WINDOW									(4U)
+
+		/** SafeUDP transport */
+		#define M_LOCALDEF__LCCM668__PRECOMMIT(length, type, ppbuffer, pindex)	(Lint16)s16SAFEUDP_TX__PreCommit(length, (SAFE_UDP__PACKET_T)type, ppbuffer, pindex)
+		#define M_LOCALDEF__LCCM668__COMMIT(index, length)					vSAFEUDP_TX__Commit(index, length, C_LOCALDEF__LCCM528__ETHERNET_PORT_NUMBER, C_LOCALDEF__LCCM528__ETHERNET_PORT_NUMBER)
+
+		/** A block is finished with, (type, tag) */
+		#define M_LOCALDEF__LCCM668__TX_DONE(type, tag)						vFCU_NET_DAQ__Tx_Done(type, tag)
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM668__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM668__RLOOP__BULK_TX/bulk_tx.h>
+	#endif //#if C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE == 1U
+
+/*******************************************************************************
+RLOOP - ACCEL FIFO BURST
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+
+		/** Number of MMA8451's, same index as the driver */
+		#define C_LOCALDEF__LCCM669__NUM_DEVICES							(C_LOCALDEF__LCCM418__NUM_DEVICES)
+
+		/** Device ODR as set up by the driver, both devices run the same */
+		#define C_LOCALDEF__LCCM669__DATA_RATE_HZ							(C_LOCALDEF__LCCM418__DEV0__DATA_RATE_HZ)
+
+		/** 20ms of samples per burst, leaves 20ms before the FIFO wraps */
+		#define C_LOCALDEF__LCCM669__FIFO_WATERMARK							(16U)
+
+		/** Samples held for the consumers, power of 2 */
+		#define C_LOCALDEF__LCCM669__SAMPLE_RING_SIZE						(128U)
+
+		/** Running average length, 40ms */
+		#define C_LOCALDEF__LCCM669__AVERAGE_SAMPLES						(32U)
+
+		/** CIC decimator, 800Hz to 100Hz */
+		#define C_LOCALDEF__LCCM669__CIC_DECIMATION							(8U)
+		#define C_LOCALDEF__LCCM669__CIC_STAGES								(3U)
+
+		/** Process loops with no watermark before the FIFO is polled */
+		#define C_LOCALDEF__LCCM669__MAX_INTERRUPT_LOST_COUNT				(C_LOCALDEF__LCCM418__MAX_INTERRUPT_LOST_COUNT)
+
+		/** The driver keeps the device at least this long for a zero */
+		#define C_LOCALDEF__LCCM669__CAL_HOLD_MS							(100U)
+
+		/** RTI counter 1 stamps the samples */
+#ifndef WIN32
+		#define M_LOCALDEF__LCCM669__GET_TIMESTAMP()						u64RM4_RTI__Get_Counter1()
+#else
+		#define M_LOCALDEF__LCCM669__GET_TIMESTAMP()						(0U)
+#endif
+		#define C_LOCALDEF__LCCM669__TIMESTAMP_TICKS_PER_SEC				(C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC)
+
+		/** Device access, through the driver low level */
+		#define M_LOCALDEF__LCCM669__READ_BYTE(dev, reg, pval)				s16MMA8451_LOWLEVEL__ReadByte(dev, reg, pval)
+		#define M_LOCALDEF__LCCM669__READ_MULTIPLE(dev, reg, parr, len)		s16MMA8451_LOWLEVEL__ReadMultiple(dev, reg, parr, len)
+		#define M_LOCALDEF__LCCM669__WRITE_BYTE(dev, reg, val)				s16MMA8451_LOWLEVEL__WriteByte(dev, reg, val)
+
+		/** The driver, while it has the device for a zero */
+		#define M_LOCALDEF__LCCM669__DRIVER_PROCESS(dev)					vMMA8451__Process(dev)
+		#define M_LOCALDEF__LCCM669__DRIVER_ISR(dev)						vMMA8451__ISR(dev)
+		#define M_LOCALDEF__LCCM669__DRIVER_AUTOZERO(dev)					vMMA8451_ZERO__AutoZero(dev)
+		#define M_LOCALDEF__LCCM669__DRIVER_FINEZERO(dev, axis)				vMMA8451_ZERO__Set_FineZero(dev, (MMA8451__AXIS_E)axis)
+
+		/** 1 while the driver is zeroing or calibrating */
+		#define M_LOCALDEF__LCCM669__DRIVER_CALIBRATING(dev)				(u8MMA8451_PROCESS__Get_CalibrationState(dev) != C_MMA8451__CALSTATE__NONE)
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM669__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM669__RLOOP__ACCEL_BURST/accel_burst.h>
+	#endif //#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+
+/*******************************************************************************
+RLOOP - STREAMING FILTERS
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM670__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM670__RLOOP__STREAM_FILTER/stream_filter.h>
+	#endif //#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+
+/*******************************************************************************
+RLOOP - LINKED FAULT TREES
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE == 1U
+
+		/** Journal of flag sets, streamed to ground over SafeUDP */
+		#define C_LOCALDEF__LCCM671__ENABLE_JOURNAL							(1U)
+		#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+
+			/** Number of entries kept, the oldest is overwritten */
+			#define C_LOCALDEF__LCCM671__JOURNAL_SIZE						(32U)
+
+			/** RTI counter 1 stamps the entries */
+#ifndef WIN32
+			#define M_LOCALDEF__LCCM671__GET_TIMESTAMP()					u64RM4_RTI__Get_Counter1()
+#else
+			#define M_LOCALDEF__LCCM671__GET_TIMESTAMP()					(0U)
+#endif
+
+		#endif
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM671__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM671__RLOOP__FAULT_LINK/fault_link.h>
+	#endif //#if C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE == 1U
+
+/*******************************************************************************
+RLOOP - PARAMETER SHADOW
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+
+		/** Number of parameter words kept in RAM, same as LCCM188 */
+		#define C_LOCALDEF__LCCM672__NUM_PARAMETERS							(128U)
+
+		/** Parameters per block, the unit that is marked stale and CRC'd */
+		#define C_LOCALDEF__LCCM672__BLOCK_SIZE								(16U)
+
+		/** Process passes with no new writes before a commit starts, a pass is
+		 * 10ms on the FCU scheduler so 1s */
+		#define C_LOCALDEF__LCCM672__HOLDOFF								(100U)
+
+		/** If neither copy is good, load the image from LCCM188 */
+		#define C_LOCALDEF__LCCM672__ENABLE_MIGRATION						(1U)
+
+		/** Copy storage, copy A in bank 7 sector 1 and copy B in sector 2, clear
+		of the sector LCCM230 uses for its EEPROM emulation */
+#ifndef WIN32
+		#define M_LOCALDEF__LCCM672__READ(copy,offset,pu32,count)			vRM4_EEPROM__Read_U8Array((Luint8)(1U + (copy)), (Luint16)((offset) * 4U), (Luint8 *)(pu32), (Luint16)((count) * 4U))
+		#define M_LOCALDEF__LCCM672__WRITE(copy,offset,pu32,count)			vRM4_EEPROM__Write_U8Array((Luint8)(1U + (copy)), (Luint16)((offset) * 4U), (Luint8 *)(pu32), (Luint16)((count) * 4U))
+#else
+		#define M_LOCALDEF__LCCM672__READ(copy,offset,pu32,count)			vPARAMSHADOW_WIN32__Read((Luint8)(copy), (Luint16)(offset), (pu32), (Luint16)(count))
+		#define M_LOCALDEF__LCCM672__WRITE(copy,offset,pu32,count)			vPARAMSHADOW_WIN32__Write((Luint8)(copy), (Luint16)(offset), (pu32), (Luint16)(count))
+#endif
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM672__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM672__RLOOP__PARAM_SHADOW/param_shadow.h>
+	#endif //#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+
+/*******************************************************************************
+RLOOP - STEP S-CURVE PLANNER
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+
+		/** The two brake lead screws, same as LCCM231 */
+		#define C_LOCALDEF__LCCM673__NUM_AXES								(2U)
+
+		/** Runs off the stepper timebase on RTI compare 2 */
+		#define C_LOCALDEF__LCCM673__TICK_PERIOD_S							(C_LOCALDEF__LCCM321__MOTOR_DRIVER_TICK_VALUE_HZ)
+
+		/** Step table entries per plan */
+		#define C_LOCALDEF__LCCM673__TABLE_SIZE								(1024U)
+
+		/** Steps ahead of the ISR that a replan joins the running plan */
+		#define C_LOCALDEF__LCCM673__REPLAN_LEAD							(8U)
+
+		/** Scale from the LCCM231 memory layer */
+		#define M_LOCALDEF__LCCM673__STEPS_PER_REV(axis)					(u32STEPDRIVE_MEM__Get_StepsPerRevolution(axis) * (Luint32)u8STEPDRIVE_MEM__Get_MicroStepResolution(axis))
+		#define M_LOCALDEF__LCCM673__MICRONS_PER_REV(axis)					s32STEPDRIVE_MEM__Get_PicoMeters_PerRev(axis)
+
+		/** Pins through the LCCM231 Geko layer */
+		#define M_LOCALDEF__LCCM673__PULSE(axis,level)						{if((level) == 1U){vSTEPDRIVE_GEKO__Set_PulseHigh(axis);}else{vSTEPDRIVE_GEKO__Set_PulseLow(axis);}}
+		#define M_LOCALDEF__LCCM673__DIRECTION(axis,dir)					{if((dir) > 0){vSTEPDRIVE_GEKO__Set_RotationClockwise(axis);}else{vSTEPDRIVE_GEKO__Set_RotationCounterClockwise(axis);}}
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM673__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM673__RLOOP__STEP_SCURVE/step_scurve.h>
+	#endif //#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+
+/*******************************************************************************
+RLOOP - IEEE1588 POD TIME
+*******************************************************************************/
+	//clock sync over the DP83640, the FCU is grandmaster
+#ifndef WIN32
+	#define C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE							(1U)
+#else
+	#define C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE							(0U)
+#endif
+	#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+
+		/** 1 = grandmaster, 0 = slave */
+		#define C_LOCALDEF__LCCM674__MASTER									(1U)
+
+		/** Sync and Delay_Req interval */
+		#define C_LOCALDEF__LCCM674__SYNC_INTERVAL_MS						(125U)
+
+		/** RTI counter 1 */
+		#define C_LOCALDEF__LCCM674__LOCAL_TICKS_PER_SEC					(C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC)
+		#define M_LOCALDEF__LCCM674__LOCAL_TICKS()							u64RM4_RTI__Get_Counter1()
+
+		/** Real PHY and wire */
+		#define C_LOCALDEF__LCCM674__ENABLE_LOOPBACK						(0U)
+
+		/** DP83640 on MDIO address 1 */
+		#define M_LOCALDEF__LCCM674__PHY_INIT()								vPTP_DP83640__Init(1U)
+		#define M_LOCALDEF__LCCM674__PHY_GET_TIME()							u64PTP_DP83640__Get_Time(1U)
+		#define M_LOCALDEF__LCCM674__PHY_STEP(ns)							vPTP_DP83640__Step(1U, ns)
+		#define M_LOCALDEF__LCCM674__PHY_SET_RATE(ppb)						vPTP_DP83640__Set_Rate(1U, ppb)
+		#define M_LOCALDEF__LCCM674__PHY_TX_STAMP(pt)						s16PTP_DP83640__Get_TxTimestamp(1U, pt)
+		#define M_LOCALDEF__LCCM674__PHY_RX_STAMP(pt,ps,pm)					s16PTP_DP83640__Get_RxTimestamp(1U, pt, ps, pm)
+
+		/** Transport over LCCM325 */
+		#define M_LOCALDEF__LCCM674__TX_ALLOC(length,deadline_us)			s16ETH_FIFO__Push(length)
+		#define M_LOCALDEF__LCCM674__TX_BUFFER(index)						((Luint8 *)u32ETH_BUFFERDESC__Get_TxBufferPointer((Luint8)(index)))
+		#define M_LOCALDEF__LCCM674__TX_SEND(length,port)					vETH_UDP__Transmit(length, port, port)
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM674__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM674__RLOOP__PTP/ptp.h>
+	#endif //#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+
+/*******************************************************************************
+RLOOP - ETHERNET TX CLASSES
+*******************************************************************************/
+#ifndef WIN32
+	#define C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE							(1U)
+#else
+	#define C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE							(0U)
+#endif
+	#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+
+		/** Requests each class can hold */
+		#define C_LOCALDEF__LCCM675__CLASS_DEPTH							(8U)
+
+		/** Most packets sent each process call */
+		#define C_LOCALDEF__LCCM675__MAX_PER_PROCESS						(4U)
+
+		/** RTI counter 1 */
+		#define C_LOCALDEF__LCCM675__TICKS_PER_MS							(C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC / 1000U)
+		#define M_LOCALDEF__LCCM675__TICKS()								((Luint32)u64RM4_RTI__Get_Counter1())
+
+		/** Hand the Ethernet FIFO one packet at a time so the order is ours */
+		#define M_LOCALDEF__LCCM675__LOWER_READY()							u8ETH_FIFO__Is_Empty()
+		#define M_LOCALDEF__LCCM675__SEND(request,param)					s16FCU_NET_TX__Send_Request(request, param)
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM675__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM675__RLOOP__TX_CLASS/tx_class.h>
+	#endif //#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+
 /*******************************************************************************
 RLOOP - FLIGHT CONTROL UNIT - CORE
 *******************************************************************************/
@@ -159,12 +488,28 @@ RLOOP - FLIGHT CONTROL UNIT - CORE
 		/** Enable the ASI_RS485 */
 		#define C_LOCALDEF__LCCM655__ENABLE_ASI_RS485						(0U)
 
+			//the ASI bus, SC16 channel, baud and the 64 bit timebase it runs from
+			#define C_LOCALDEF__LCCM655__ASI_SC16_INDEX							(7U)
+			#define C_LOCALDEF__LCCM655__ASI_BAUD								(115200U)
+			#define C_LOCALDEF__LCCM655__ASI_TICKS_PER_SEC						(C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC)
+			#define M_LOCALDEF__LCCM655__ASI_TIMESTAMP()						u64RM4_RTI__Get_Counter1()
+			#define M_LOCALDEF__LCCM655__ASI_TX(pu8Data, u8Length)				vSC16__Tx_ByteArray(C_LOCALDEF__LCCM655__ASI_SC16_INDEX, pu8Data, u8Length)
+			#define M_LOCALDEF__LCCM655__ASI_RX_AVAIL()							u8SC16_USER__Get_ByteAvail(C_LOCALDEF__LCCM655__ASI_SC16_INDEX)
+			#define M_LOCALDEF__LCCM655__ASI_RX_BYTE()							u8SC16_USER__Get_Byte(C_LOCALDEF__LCCM655__ASI_SC16_INDEX)
+
 		/** Enable the pusher detection system */
 		#define C_LOCALDEF__LCCM655__ENABLE_PUSHER							(0U)
 
 		/** Ethernet Systems */
 		#define C_LOCALDEF__LCCM655__ENABLE_ETHERNET						(1U)
 
+		/** Stream DAQ blocks to the ground station, needs LCCM667 and LCCM668 */
+		#define C_LOCALDEF__LCCM655__ENABLE_DAQ								(1U)
+
+		/** Task scheduler slot clock and task timing, the free running RTI counter 1 */
+		#define C_LOCALDEF__LCCM655__SCHED__TICKS_PER_MS					(C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC / 1000U)
+		#define M_LOCALDEF__LCCM655__SCHED__TICKS()							((Luint32)u64RM4_RTI__Get_Counter1())
+
 		/** Flight control specifics */
 		#define C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL					(1U)
 
@@ -39,7 +39,8 @@ void vPWRNODE_BATTTEMP__Init(void)
 	//error decide what to do, either keep going or change to an error state
 
 	//We have a choice here to re-scan each power up or supply the addresses via the network
-	//for each sensor. For now we'll search
+	//for each sensor. If the ROM cache is enabled the table from the last search is
+	//reloaded from EEPROM and verified on the first sweep, else we search
 
 	//start the temp sensor driver
 	vDS18B20__Init();
@@ -71,6 +72,8 @@ void vPWRNODE_BATTTEMP__Process(void)
 /***************************************************************************//**
  * @brief
  * Start a search of any devices on the network
+ * If the DS18B20 ROM cache holds a valid table the search is skipped, the driver
+ * will fall back to a full search if any cached device fails to answer.
  * 
  * @st_funcMD5		44524ACD1CAC2160BEBA831938D2122E
  * @st_funcID		LCCM653R0.FILE.009.FUNC.003
@@ -78,9 +81,25 @@ void vPWRNODE_BATTTEMP__Process(void)
 void vPWRNODE_BATTTEMP__Start_Search(void)
 {
 #ifndef WIN32
+#if C_LOCALDEF__LCCM644__ENABLE_ROM_CACHE == 1U
+	Lint16 s16Return;
+
+	//try the table from the last search first
+	s16Return = s16DS18B20_ROMCACHE__Load();
+	if(s16Return <= 0)
+	{
+		//nothing usable, start the search state machine
+		vDS18B20_ADDX__SearchSM_Start();
+	}
+	else
+	{
+		//fall on, the first sweep verifies the cached devices
+	}
+#else
 	//start the search state machine
 	vDS18B20_ADDX__SearchSM_Start();
 #endif
+#endif
 }
 
 
@@ -55,6 +55,130 @@ void vPWRNODE_BMS__Process(void)
 #endif
 }
 
+/***************************************************************************//**
+ * @brief
+ * Start or stop cell balancing
+ *
+ * @param[in]		u8Start					1 = start, 0 = stop and all resistors off
+ * @st_funcMD5
+ * @st_funcID		LCCM653R0.FILE.008.FUNC.003
+ */
+void vPWRNODE_BMS__Balance_Control(Luint8 u8Start)
+{
+#ifndef WIN32
+	if(u8Start == 1U)
+	{
+		vATA6870_BALANCE__Start();
+	}
+	else
+	{
+		vATA6870_BALANCE__Stop();
+	}
+#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ * Pack voltage
+ *
+ * @return			Volts, sum of the cells of the last sweep
+ * @st_funcMD5
+ * @st_funcID		LCCM653R0.FILE.008.FUNC.004
+ */
+Lfloat32 f32PWRNODE_BMS__Get_PackVolts(void)
+{
+#ifndef WIN32
+	return f32ATA6870_BALANCE__Get_PackVolts();
+#else
+	return 0.0F;
+#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ * Lowest cell
+ *
+ * @return			Volts
+ * @st_funcMD5
+ * @st_funcID		LCCM653R0.FILE.008.FUNC.005
+ */
+Lfloat32 f32PWRNODE_BMS__Get_CellMin(void)
+{
+#ifndef WIN32
+	return f32ATA6870_BALANCE__Get_CellMin();
+#else
+	return 0.0F;
+#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ * Highest cell
+ *
+ * @return			Volts
+ * @st_funcMD5
+ * @st_funcID		LCCM653R0.FILE.008.FUNC.006
+ */
+Lfloat32 f32PWRNODE_BMS__Get_CellMax(void)
+{
+#ifndef WIN32
+	return f32ATA6870_BALANCE__Get_CellMax();
+#else
+	return 0.0F;
+#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ * Mean cell
+ *
+ * @return			Volts
+ * @st_funcMD5
+ * @st_funcID		LCCM653R0.FILE.008.FUNC.007
+ */
+Lfloat32 f32PWRNODE_BMS__Get_CellMean(void)
+{
+#ifndef WIN32
+	return f32ATA6870_BALANCE__Get_CellMean();
+#else
+	return 0.0F;
+#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ * Highest - lowest cell
+ *
+ * @return			Volts
+ * @st_funcMD5
+ * @st_funcID		LCCM653R0.FILE.008.FUNC.008
+ */
+Lfloat32 f32PWRNODE_BMS__Get_Spread(void)
+{
+#ifndef WIN32
+	return f32ATA6870_BALANCE__Get_Spread();
+#else
+	return 0.0F;
+#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ * Discharge resistors on
+ *
+ * @return			Count across the chain
+ * @st_funcMD5
+ * @st_funcID		LCCM653R0.FILE.008.FUNC.009
+ */
+Luint16 u16PWRNODE_BMS__Get_Bleeding(void)
+{
+#ifndef WIN32
+	return u16ATA6870_BALANCE__Get_Bleeding();
+#else
+	return 0U;
+#endif
+}
+
 #endif //C_LOCALDEF__LCCM653__ENABLE_BMS
 
 #endif //#if C_LOCALDEF__LCCM653__ENABLE_THIS_MODULE == 1U
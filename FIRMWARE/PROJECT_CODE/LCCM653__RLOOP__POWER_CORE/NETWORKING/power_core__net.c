@@ -10,6 +10,9 @@ void vPWRNODE_NET__Init(void)
 {
 	sPWRNODE.sEthernet.u810MS_Timer = 0U;
 	sPWRNODE.sEthernet.eMainState = NET_STATE__IDLE;
+#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+	sPWRNODE.sEthernet.u8PTP_Running = 0U;
+#endif
 
 	//SIL3 OUID
 	sPWRNODE.sEthernet.u8MACAddx[0] = 0x00;
@@ -105,6 +108,26 @@ void vPWRNODE_NET__Process(void)
 
 	}//switch(sPWRNODE.sEthernet.eMainState)
 
+#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+	//slave to the FCU, the PHY clock can only be set up once the PHY is talking
+	u8Test = u8PWRNODE_NET__Is_LinkUp();
+	if(u8Test == 1U)
+	{
+		if(sPWRNODE.sEthernet.u8PTP_Running == 0U)
+		{
+			vPTP__Init(&sPWRNODE.sEthernet.u8MACAddx[0], &sPWRNODE.sEthernet.u8IPAddx[0]);
+			sPWRNODE.sEthernet.u8PTP_Running = 1U;
+		}
+		else
+		{
+			vPTP__Process();
+		}
+	}
+	else
+	{
+		//no link
+	}
+#endif
 
 
 }
@@ -3,10 +3,22 @@
 #include "../power_core.h"
 #if C_LOCALDEF__LCCM653__ENABLE_ETHERNET == 1U
 
+extern struct _strPWRNODE sPWRNODE;
+
 //rx a standard UDP packet
 void vPWRNODE_NET_RX__RxUDP(Luint8 *pu8Buffer, Luint16 u16Length, Luint16 u16DestPort)
 {
-
+#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+	//PTP from the FCU
+	if(((u16DestPort == C_PTP__PORT_EVENT) || (u16DestPort == C_PTP__PORT_GENERAL)) && (sPWRNODE.sEthernet.u8PTP_Running == 1U))
+	{
+		vPTP__Input(pu8Buffer, u16Length, u16DestPort);
+	}
+	else
+	{
+		//not for us
+	}
+#endif
 }
 //rx a SafetyUDP
 void vPWRNODE_NET_RX__RxSafeUDP(Luint8 *pu8Payload, Luint16 u16PayloadLength, Luint16 ePacketType, Luint16 u16DestPort, Luint16 u16Fault)
@@ -23,24 +23,53 @@
 
 #include <LCCM653__RLOOP__POWER_CORE/PI_COMMS/power_core__pi_comms__types.h>
 
-//The PICOMMS RX Callbacks
-void vPWRNODE_PICOMMS__recvLuint8(Luint16 u16Index, Luint8 data);
-void vPWRNODE_PICOMMS__recvLint8(Luint16 index, Lint8 data);
-void vPWRNODE_PICOMMS__recvLuint16(Luint16 index, Luint16 data);
-void vPWRNODE_PICOMMS__recvLint16(Luint16 index, Lint16 data);
-void vPWRNODE_PICOMMS__recvLuint32(Luint16 u16Index, Luint32 u32Data);
-void vPWRNODE_PICOMMS__recvLint32(Luint16 index, Lint32 data);
-void vPWRNODE_PICOMMS__recvLuint64(Luint16 index, Luint64 data);
-void vPWRNODE_PICOMMS__recvLint64(Luint16 index, Lint64 data);
-void vPWRNODE_PICOMMS__recvLfloat32(Luint16 index, Lfloat32 data);
-void vPWRNODE_PICOMMS__recvLfloat64(Luint16 index, Lfloat64 data);
-
 //the structure
 extern struct _strPWRNODE sPWRNODE;
 
 //the main structure
 extern struct _strPICOMMS sPC;
 
+/** Our telemetry frame, must match the order of the Next_xxx calls */
+static const PICOMMS_TEMPLATE_PARAM_T sPWRNODE_PICOMMS_TxParams[] =
+{
+	{(Luint16)PI_PACKET__PWRNODE__NODE_TEMP_RETURN, (Luint8)PICOMMS_FLOAT, 0.1F},
+	{(Luint16)PI_PACKET__PWRNODE__NODE_PRESS_RETURN, (Luint8)PICOMMS_FLOAT, 0.005F}
+#if C_LOCALDEF__LCCM653__ENABLE_BMS == 1U
+	,
+	//pack stats, one ADC LSB is 1.5mV
+	{(Luint16)PI_PACKET__PWRNODE__BMS_PACK_VOLTS, (Luint8)PICOMMS_FLOAT, 0.01F},
+	{(Luint16)PI_PACKET__PWRNODE__BMS_CELL_MIN, (Luint8)PICOMMS_FLOAT, 0.0015F},
+	{(Luint16)PI_PACKET__PWRNODE__BMS_CELL_MAX, (Luint8)PICOMMS_FLOAT, 0.0015F},
+	{(Luint16)PI_PACKET__PWRNODE__BMS_CELL_MEAN, (Luint8)PICOMMS_FLOAT, 0.0015F},
+	{(Luint16)PI_PACKET__PWRNODE__BMS_CELL_SPREAD, (Luint8)PICOMMS_FLOAT, 0.0015F},
+	{(Luint16)PI_PACKET__PWRNODE__BMS_BLEEDING, (Luint8)PICOMMS_UINT16, 0.0F}
+#endif
+};
+
+static void vPWRNODE_PICOMMS__Rx_Commit(void);
+static void vPWRNODE_PICOMMS__Service_Tx(void);
+static Luint8 u8PWRNODE_PICOMMS__Check_OnOff(Luint16 u16Index, const PICOMMS_RX_VALUE_T *puValue);
+
+/** Our receive table, sorted by index, see E_PWRNODE_PICOMMS_RX__SLOT_T */
+static const PICOMMS_RX_PARAM_T sPWRNODE_PICOMMS_RxTable[PWRNODE_PICOMMS_RX__NUM_SLOTS] =
+{
+	{10001U, (Luint8)PICOMMS_INT8, &sPC.sLp.PICOMMS_LOOP_INT8, 0},
+	{10002U, (Luint8)PICOMMS_UINT16, &sPC.sLp.PICOMMS_LOOP_UINT16, 0},
+	{10003U, (Luint8)PICOMMS_INT16, &sPC.sLp.PICOMMS_LOOP_INT16, 0},
+	{10005U, (Luint8)PICOMMS_INT32, &sPC.sLp.PICOMMS_LOOP_INT32, 0},
+	{10006U, (Luint8)PICOMMS_UINT64, &sPC.sLp.PICOMMS_LOOP_UINT64, 0},
+	{10007U, (Luint8)PICOMMS_INT64, &sPC.sLp.PICOMMS_LOOP_INT64, 0},
+	{10008U, (Luint8)PICOMMS_FLOAT, &sPC.sLp.PICOMMS_LOOP_FLOAT32, 0},
+	{10009U, (Luint8)PICOMMS_DOUBLE, &sPC.sLp.PICOMMS_LOOP_FLOAT64, 0},
+
+	{(Luint16)PI_PACKET__PWRNODE__POD_SAFE_UNLOCK_KEY, (Luint8)PICOMMS_UINT32, &sPWRNODE.sPiComms.sRxCmd.u32PodSafeKey, 0},
+	{(Luint16)PI_PACKET__PWRNODE__POD_SAFE_COMMAND, (Luint8)PICOMMS_UINT32, &sPWRNODE.sPiComms.sRxCmd.u32PodSafeCommand, 0},
+
+	{(Luint16)PI_PACKET__PWRNODE__CHG_RELAY_CONTROL, (Luint8)PICOMMS_UINT8, &sPWRNODE.sPiComms.sRxCmd.u8ChargeRelay, &u8PWRNODE_PICOMMS__Check_OnOff},
+
+	{(Luint16)PI_PACKET__PWRNODE__BMS_BALANCE_CONTROL, (Luint8)PICOMMS_UINT8, &sPWRNODE.sPiComms.sRxCmd.u8Balance, &u8PWRNODE_PICOMMS__Check_OnOff}
+};
+
 /***************************************************************************//**
  * @brief
  * Init any variables
@@ -51,22 +80,19 @@ void vPWRNODE_PICOMMS__Init(void)
 
 	//default or variables
 	sPWRNODE.sPiComms.eState = PICOM_STATE__IDLE;
-	sPWRNODE.sPiComms.u8100MS_Timer = 0U;
+	sPWRNODE.sPiComms.u810MS_Timer = 0U;
 
 	//init pi comms
 	vPICOMMS__Init();
 
-	//Attach all the callbacks
-	PICOMMS_RX_recvLuint8 = &vPWRNODE_PICOMMS__recvLuint8;
-	PICOMMS_RX_recvLint8 = &vPWRNODE_PICOMMS__recvLint8;
-	PICOMMS_RX_recvLuint16 = &vPWRNODE_PICOMMS__recvLuint16;
-	PICOMMS_RX_recvLint16 = &vPWRNODE_PICOMMS__recvLint16;
-	PICOMMS_RX_recvLuint32 = &vPWRNODE_PICOMMS__recvLuint32;
-	PICOMMS_RX_recvLint32 = &vPWRNODE_PICOMMS__recvLint32;
-	PICOMMS_RX_recvLuint64 = &vPWRNODE_PICOMMS__recvLuint64;
-	PICOMMS_RX_recvLint64 = &vPWRNODE_PICOMMS__recvLint64;
-	PICOMMS_RX_recvLfloat32 = &vPWRNODE_PICOMMS__recvLfloat32;
-	PICOMMS_RX_recvLfloat64 = &vPWRNODE_PICOMMS__recvLfloat64;
+	//build our frame layout once, the headers never change
+	vPICOMMS_TEMPLATE__Compile(&sPWRNODE.sPiComms.sTxTemplate, &sPWRNODE_PICOMMS_TxParams[0], (Luint16)(sizeof(sPWRNODE_PICOMMS_TxParams) / sizeof(PICOMMS_TEMPLATE_PARAM_T)));
+
+	//only changed params are sent between keyframes
+	vPICOMMS_ENC__Set_KeyframePeriod(C_PWRNODE_PICOMMS__KEYFRAME_PERIOD);
+
+	//GS commands are written straight into sRxCmd, one commit per frame
+	vPICOMMS_RX__Register_Table(&sPWRNODE_PICOMMS_RxTable[0], (Luint16)PWRNODE_PICOMMS_RX__NUM_SLOTS, &vPWRNODE_PICOMMS__Rx_Commit);
 
 	//switch on notifications now we are ready
 	#if C_LOCALDEF__LCCM282__ENABLE_INTERRUPTS == 1U
@@ -82,9 +108,8 @@ void vPWRNODE_PICOMMS__Init(void)
  */
 void vPWRNODE_PICOMMS__Process(void)
 {
-	Luint32 u32Length;
-	Luint8 * pu8Buffer;
-	Luint8 u8Test;
+	//keep the wire busy, this is independent of building frames
+	vPWRNODE_PICOMMS__Service_Tx();
 
 	//process our state machine
 	switch(sPWRNODE.sPiComms.eState)
@@ -95,16 +120,13 @@ void vPWRNODE_PICOMMS__Process(void)
 			//todo, just for now.
 			//sPWRNODE.sPiComms.eState = PICOM_STATE__SETUP_FRAME;
 
-			if(sPWRNODE.sPiComms.u8100MS_Timer == 1U)
+			if(sPWRNODE.sPiComms.u810MS_Timer == 1U)
 			{
-				//only do a new frame the DMA is not busy
-				u8Test = u8RM4_SCI_DMA__Is_TxBusy(SCI_CHANNEL__2);
-				if(u8Test == 0U)
-				{
-					sPWRNODE.sPiComms.eState = PICOM_STATE__SETUP_FRAME;
-
-					sPWRNODE.sPiComms.u8100MS_Timer = 0U;
-				}
+				//build on the tick even while the last frame is on the wire, if
+				//the queue is full the oldest waiting frame makes way
+				sPWRNODE.sPiComms.eState = PICOM_STATE__SETUP_FRAME;
+
+				sPWRNODE.sPiComms.u810MS_Timer = 0U;
 			}
 			else
 			{
@@ -114,8 +136,8 @@ void vPWRNODE_PICOMMS__Process(void)
 			break;
 
 		case PICOM_STATE__SETUP_FRAME:
-			//start a new frame
-			PICOMMS_TX_beginFrame();
+			//start a new delta frame against our precompiled headers
+			vPICOMMS_ENC__Begin_Delta(&sPWRNODE.sPiComms.sTxTemplate);
 
 			//change states
 			sPWRNODE.sPiComms.eState = PICOM_STATE__ASSEMBLE_BUFFER;
@@ -124,266 +146,189 @@ void vPWRNODE_PICOMMS__Process(void)
 		case PICOM_STATE__ASSEMBLE_BUFFER:
 
 			//add the node temperature
-			vPICOMMS_TX__Add_F32(PI_PACKET__PWRNODE__NODE_TEMP_RETURN, f32PWRNODE_NODETEMP__Get_DegC());
+			vPICOMMS_ENC__Next_F32(f32PWRNODE_NODETEMP__Get_DegC());
 
 			//node pressure
-			vPICOMMS_TX__Add_F32(PI_PACKET__PWRNODE__NODE_PRESS_RETURN, f32PWRNODE_NODEPRESS__Get_Pressure_Bar());
+			vPICOMMS_ENC__Next_F32(f32PWRNODE_NODEPRESS__Get_Pressure_Bar());
+
+			#if C_LOCALDEF__LCCM653__ENABLE_BMS == 1U
+				//pack stats from the last sweep of the chain
+				vPICOMMS_ENC__Next_F32(f32PWRNODE_BMS__Get_PackVolts());
+				vPICOMMS_ENC__Next_F32(f32PWRNODE_BMS__Get_CellMin());
+				vPICOMMS_ENC__Next_F32(f32PWRNODE_BMS__Get_CellMax());
+				vPICOMMS_ENC__Next_F32(f32PWRNODE_BMS__Get_CellMean());
+				vPICOMMS_ENC__Next_F32(f32PWRNODE_BMS__Get_Spread());
+				vPICOMMS_ENC__Next_U16(u16PWRNODE_BMS__Get_Bleeding());
+			#endif
 
 
 			//add as many more params as you need depending on current tx state.
 
-			sPWRNODE.sPiComms.eState = PICOM_STATE__START_DMA;
+			sPWRNODE.sPiComms.eState = PICOM_STATE__QUEUE_FRAME;
 
 			break;
 
-		case PICOM_STATE__START_DMA:
-			//end the frame
-			u32Length = (Luint32)PICOMMS_TX_endFrame();
-
-			//get the buffer pointer
-			pu8Buffer = pu8I2CTx__Get_BufferPointer();
-
-			//todo, probably should check transaction is not running
-
-			//start the transaction.
-			#if C_LOCALDEF__LCCM282__ENABLE_DMA == 1U
-				vRM4_SCI_DMA__Begin_Tx(SCI_CHANNEL__2, pu8Buffer, u32Length);
-			#endif
-
-			//change state
-			sPWRNODE.sPiComms.eState = PICOM_STATE__WAIT_DMA;
-			break;
-
-		case PICOM_STATE__WAIT_DMA:
-
-			//test if the DMA is running
-			#if C_LOCALDEF__LCCM282__ENABLE_DMA == 1U
-				u8Test = u8RM4_SCI_DMA__Is_TxBusy(SCI_CHANNEL__2);
-			#else
-				u8Test = 0U;
-			#endif
-			if(u8Test == 0U)
-			{
-				//cleanup the DMA interrupts for next time.
-				vRM4_SCI_DMA__Cleanup(SCI_CHANNEL__2);
-
-				//todo, for now go back to start.
-				sPWRNODE.sPiComms.eState = PICOM_STATE__IDLE;
-			}
-			else
-			{
-				//stay in state
-			}
+		case PICOM_STATE__QUEUE_FRAME:
+			//end the frame and queue it, the DMA service picks it up when the wire is free
+			vPICOMMS_ENC__Queue_Frame();
 
+			//back to wait for the next tick
+			sPWRNODE.sPiComms.eState = PICOM_STATE__IDLE;
 			break;
 
 	}
 
 }
 
-//100ms timer tick
-void vPWRNODE_PICOMMS__100MS_ISR(void)
-{
-	//set the flag
-	sPWRNODE.sPiComms.u8100MS_Timer = 1U;
-
-}
-
 /***************************************************************************//**
  * @brief
- * Process all the UINT8 parameters sent from the GS.
+ * Service the transmit DMA, as soon as a frame has gone out start the next
+ * queued frame.
  *
  */
-void vPWRNODE_PICOMMS__recvLuint8(Luint16 u16Index, Luint8 data)
+static void vPWRNODE_PICOMMS__Service_Tx(void)
 {
-
-	switch((E_PICOMMS__PACKET_TYPES_T)u16Index)
+	Luint8 u8Test;
+	Luint8 *pu8Buffer;
+	Luint16 u16Length;
+
+	//test if the DMA is running
+	#if C_LOCALDEF__LCCM282__ENABLE_DMA == 1U
+		u8Test = u8RM4_SCI_DMA__Is_TxBusy(SCI_CHANNEL__2);
+	#else
+		u8Test = 0U;
+	#endif
+	if(u8Test == 0U)
 	{
-		case PI_PACKET__PWRNODE__NODE_PRESS_STREAM_CONTROL:
-
-			break;
-
-		case PI_PACKET__PWRNODE__NODE_TEMP_STREAM_CONTROL:
-
-			break;
-
-		case PI_PACKET__PWRNODE__CHG_RELAY_CONTROL:
-			#if C_LOCALDEF__LCCM653__ENABLE_CHARGER == 1U
-			switch(data)
-			{
-				case 0U:
-					vPWRNODE_CHG_RELAY__Off();
-					break;
-				case 1U:
-					vPWRNODE_CHG_RELAY__On();
-					break;
-				default:
-					break;
-			}//switch(data)
+		if(u8PICOMMS_TXQ__Is_OnWire() == 1U)
+		{
+			//cleanup the DMA interrupts for next time.
+			#if C_LOCALDEF__LCCM282__ENABLE_DMA == 1U
+				vRM4_SCI_DMA__Cleanup(SCI_CHANNEL__2);
 			#endif
-			break;
 
+			//free the buffer
+			vPICOMMS_TXQ__Tx_Complete();
+		}
+		else
+		{
+			//nothing was sent
+		}
+
+		//start the next frame if there is one
+		pu8Buffer = pu8PICOMMS_TXQ__Start_Next(&u16Length);
+		if(pu8Buffer != 0)
+		{
+			#if C_LOCALDEF__LCCM282__ENABLE_DMA == 1U
+				vRM4_SCI_DMA__Begin_Tx(SCI_CHANNEL__2, pu8Buffer, (Luint32)u16Length);
+			#endif
+		}
+		else
+		{
+			//queue empty
+		}
 	}
-
-/*
-	switch(index)
+	else
 	{
-		case  10000: sPC.sLp.PICOMMS_LOOP_UINT8 = data;
-				break;
+		//still sending
 	}
-*/
-
 }
 
-/***************************************************************************//**
- * @brief
- * Process all the INT8 parameters sent from the GS.
- *
- */
-void vPWRNODE_PICOMMS__recvLint8(Luint16 index, Lint8 data)
+//10ms timer tick
+void vPWRNODE_PICOMMS__10MS_ISR(void)
 {
-	switch(index)
-	{
-		case  10001: sPC.sLp.PICOMMS_LOOP_INT8 = data;
-				break;
-	}
+	//set the flag
+	sPWRNODE.sPiComms.u810MS_Timer = 1U;
+
+	//queue timebase for the idle gap stats
+	vPICOMMS_TXQ__10MS_ISR();
+
 }
 
 /***************************************************************************//**
  * @brief
- * Process all the UINT16 parameters sent from the GS.
+ * A frame from the GS has been applied to sRxCmd, act on whatever changed.
+ * The unlock is handled before the command so both can come in one frame.
  *
  */
-void vPWRNODE_PICOMMS__recvLuint16(Luint16 index, Luint16 data)
+static void vPWRNODE_PICOMMS__Rx_Commit(void)
 {
-	switch(index)
+	if(u8PICOMMS_RX__Was_Updated((Luint16)PWRNODE_PICOMMS_RX__POD_SAFE_UNLOCK_KEY) == 1U)
 	{
-		case  10002: sPC.sLp.PICOMMS_LOOP_UINT16 = data;
-				break;
+		//unlock the pod safe key
+		#if C_LOCALDEF__LCCM653__ENABLE_DC_CONVERTER == 1U
+			vPWRNODE_DC__Pod_Safe_Unlock(sPWRNODE.sPiComms.sRxCmd.u32PodSafeKey);
+		#endif
 	}
-}
-
-/***************************************************************************//**
- * @brief
- * Process all the INT16 parameters sent from the GS.
- *
- */
-void vPWRNODE_PICOMMS__recvLint16(Luint16 index, Lint16 data)
-{
-	switch(index)
+	else
 	{
-		case  10003: sPC.sLp.PICOMMS_LOOP_INT16 = data;
-				break;
+		//no change
 	}
-}
-
-/***************************************************************************//**
- * @brief
- * Process all the UINT32 parameters sent from the GS.
- *
- */
-void vPWRNODE_PICOMMS__recvLuint32(Luint16 u16Index, Luint32 u32Data)
-{
 
-	switch((E_PICOMMS__PACKET_TYPES_T)u16Index)
+	if(u8PICOMMS_RX__Was_Updated((Luint16)PWRNODE_PICOMMS_RX__POD_SAFE_COMMAND) == 1U)
 	{
-		case PI_PACKET__PWRNODE__POD_SAFE_UNLOCK_KEY:
-			//unlock the pod safe key
-			#if C_LOCALDEF__LCCM653__ENABLE_DC_CONVERTER == 1U
-				vPWRNODE_DC__Pod_Safe_Unlock(u32Data);
-			#endif
-			break;
-
-		case PI_PACKET__PWRNODE__POD_SAFE_COMMAND:
-			//execute pod safe.
-			#if C_LOCALDEF__LCCM653__ENABLE_DC_CONVERTER == 1U
-				vPWRNODE_DC__Pod_Safe_Go();
-			#endif
-			break;
-
-		default:
-			//do nothing.
-			break;
-
-	}//switch((E_PICOMMS__PACKET_TYPES_T)index)
-
-	/*
-	switch(u16Index)
+		//execute pod safe.
+		#if C_LOCALDEF__LCCM653__ENABLE_DC_CONVERTER == 1U
+			vPWRNODE_DC__Pod_Safe_Go();
+		#endif
+	}
+	else
 	{
-		case  10004: sPC.sLp.PICOMMS_LOOP_UINT32 = data;
-				break;
+		//no change
 	}
-	*/
-}
 
-/***************************************************************************//**
- * @brief
- * Process all the INT32 parameters sent from the GS.
- *
- */
-void vPWRNODE_PICOMMS__recvLint32(Luint16 index, Lint32 data)
-{
-	switch(index)
+	if(u8PICOMMS_RX__Was_Updated((Luint16)PWRNODE_PICOMMS_RX__CHG_RELAY_CONTROL) == 1U)
 	{
-		case  10005: sPC.sLp.PICOMMS_LOOP_INT32 = data;
-				break;
+		#if C_LOCALDEF__LCCM653__ENABLE_CHARGER == 1U
+			if(sPWRNODE.sPiComms.sRxCmd.u8ChargeRelay == 1U)
+			{
+				vPWRNODE_CHG_RELAY__On();
+			}
+			else
+			{
+				vPWRNODE_CHG_RELAY__Off();
+			}
+		#endif
 	}
-}
-
-/***************************************************************************//**
- * @brief
- * Process all the UINT64 parameters sent from the GS.
- *
- */
-void vPWRNODE_PICOMMS__recvLuint64(Luint16 index, Luint64 data)
-{
-	switch(index)
+	else
 	{
-		case  10006: sPC.sLp.PICOMMS_LOOP_UINT64 = data;
-				break;
+		//no change
 	}
-}
 
-/***************************************************************************//**
- * @brief
- * Process all the INT64 parameters sent from the GS.
- *
- */
-void vPWRNODE_PICOMMS__recvLint64(Luint16 index, Lint64 data)
-{
-	switch(index)
+	if(u8PICOMMS_RX__Was_Updated((Luint16)PWRNODE_PICOMMS_RX__BMS_BALANCE_CONTROL) == 1U)
 	{
-		case  10007: sPC.sLp.PICOMMS_LOOP_INT64 = data;
-				break;
+		#if C_LOCALDEF__LCCM653__ENABLE_BMS == 1U
+			vPWRNODE_BMS__Balance_Control(sPWRNODE.sPiComms.sRxCmd.u8Balance);
+		#endif
 	}
-}
-
-/***************************************************************************//**
- * @brief
- * Process all the FLOAT32 parameters sent from the GS.
- *
- */
-void vPWRNODE_PICOMMS__recvLfloat32(Luint16 index, Lfloat32 data)
-{
-	switch(index)
+	else
 	{
-		case  10008: sPC.sLp.PICOMMS_LOOP_FLOAT32 = data;
-				break;
+		//no change
 	}
 }
 
 /***************************************************************************//**
  * @brief
- * Process all the FLOAT64 parameters sent from the GS.
+ * Only 0 or 1 is a valid on / off command
  *
+ * @param[in]		u16Index				Param index
+ * @param[in]		puValue					The received value
+ * @return			1 = accept
  */
-void vPWRNODE_PICOMMS__recvLfloat64(Luint16 index, Lfloat64 data)
+static Luint8 u8PWRNODE_PICOMMS__Check_OnOff(Luint16 u16Index, const PICOMMS_RX_VALUE_T *puValue)
 {
-	switch(index)
+	Luint8 u8Return;
+
+	if(puValue->u8 <= 1U)
 	{
-		case  10009: sPC.sLp.PICOMMS_LOOP_FLOAT64 = data;
-				break;
+		u8Return = 1U;
 	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
 }
 
 #endif//C_LOCALDEF__LCCM653__ENABLE_PI_COMMS
@@ -2,6 +2,10 @@
 #ifndef __POWER__PI_COMMS__TYPES_H_
 #define __POWER__PI_COMMS__TYPES_H_
 
+	/** Telemetry frames between full keyframes, frames are sent every 10ms
+	 * when the DMA is free so this is around 1s */
+	#define C_PWRNODE_PICOMMS__KEYFRAME_PERIOD			(100U)
+
 
 	/** Pi Comms SM types*/
 	typedef enum
@@ -16,15 +20,41 @@
 		/** assemble the next buffer of data */
 		PICOM_STATE__ASSEMBLE_BUFFER,
 
-		/** Star the DMA transaction */
-		PICOM_STATE__START_DMA,
-
-		/** once started, wait for the DMA to complete */
-		PICOM_STATE__WAIT_DMA,
+		/** Close the frame and hand it to the transmit queue */
+		PICOM_STATE__QUEUE_FRAME,
 
 
 	}E_POWER_PICOM__STATE_T;
 
+	/** Slots in our receive table, must be in the same order as the table
+	 * which is sorted by packet index */
+	typedef enum
+	{
+		/** GS loopback test params */
+		PWRNODE_PICOMMS_RX__LOOP_S8 = 0U,
+		PWRNODE_PICOMMS_RX__LOOP_U16,
+		PWRNODE_PICOMMS_RX__LOOP_S16,
+		PWRNODE_PICOMMS_RX__LOOP_S32,
+		PWRNODE_PICOMMS_RX__LOOP_U64,
+		PWRNODE_PICOMMS_RX__LOOP_S64,
+		PWRNODE_PICOMMS_RX__LOOP_F32,
+		PWRNODE_PICOMMS_RX__LOOP_F64,
+
+		/** Pod safe */
+		PWRNODE_PICOMMS_RX__POD_SAFE_UNLOCK_KEY,
+		PWRNODE_PICOMMS_RX__POD_SAFE_COMMAND,
+
+		/** Charger relay */
+		PWRNODE_PICOMMS_RX__CHG_RELAY_CONTROL,
+
+		/** Cell balancing */
+		PWRNODE_PICOMMS_RX__BMS_BALANCE_CONTROL,
+
+		/** Table size */
+		PWRNODE_PICOMMS_RX__NUM_SLOTS
+
+	}E_PWRNODE_PICOMMS_RX__SLOT_T;
+
 
 
 #endif /* __POWER__PI_COMMS__TYPES_H_ */
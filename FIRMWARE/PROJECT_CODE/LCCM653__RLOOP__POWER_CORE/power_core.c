@@ -88,6 +88,10 @@ void vPWRNODE__Process(void)
 			//setup flash memory access
 			vRM4_FLASH__Init();
 
+			//EEPROM emulation and the parameter store on top of it
+			vRM4_EEPROM__Init();
+			vEEPARAM__Init();
+
 			//DMA
 			vRM4_DMA__Init();
 
@@ -360,10 +364,6 @@ void vPWRNODE__Process(void)
 //100ms timer
 void vPWRNODE__RTI_100MS_ISR(void)
 {
-	#if C_LOCALDEF__LCCM653__ENABLE_PI_COMMS == 1U
-		vPWRNODE_PICOMMS__100MS_ISR();
-	#endif
-
 	#if C_LOCALDEF__LCCM653__ENABLE_DC_CONVERTER == 1U
 		//tell the DC/DC converter about us for pod safe command.
 		vPWRNODE_DC__100MS_ISR();
@@ -374,6 +374,10 @@ void vPWRNODE__RTI_100MS_ISR(void)
 //10ms timer
 void vPWRNODE__RTI_10MS_ISR(void)
 {
+	#if C_LOCALDEF__LCCM653__ENABLE_PI_COMMS == 1U
+		vPWRNODE_PICOMMS__10MS_ISR();
+	#endif
+
 	#if C_LOCALDEF__LCCM653__ENABLE_BATT_TEMP == 1U
 		#if C_LOCALDEF__LCCM644__USE_10MS_ISR == 1U
 			vDS18B20__10MS_ISR();
@@ -90,8 +90,28 @@
 				/** the current state */
 				E_POWER_PICOM__STATE_T eState;
 
-				/** 100ms timer interrupt tick*/
-				Luint8 u8100MS_Timer;
+				/** 10ms timer interrupt tick*/
+				Luint8 u810MS_Timer;
+
+				/** Precompiled param headers for our telemetry frame */
+				struct _strPICOMMS_TEMPLATE sTxTemplate;
+
+				/** Commands from the GS, written by the Pi comms receive table */
+				struct
+				{
+					/** Pod safe unlock key */
+					Luint32 u32PodSafeKey;
+
+					/** Pod safe command, any value executes */
+					Luint32 u32PodSafeCommand;
+
+					/** Charger relay, 0 = off, 1 = on */
+					Luint8 u8ChargeRelay;
+
+					/** Cell balancing, 0 = stop, 1 = start */
+					Luint8 u8Balance;
+
+				}sRxCmd;
 
 			}sPiComms;
 
@@ -143,6 +163,11 @@
 				/** our locally assigned IP*/
 				Luint8 u8IPAddx[4];
 
+				#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+				/** PTP is started once the PHY is up */
+				Luint8 u8PTP_Running;
+				#endif
+
 				/** 10ms timer tick */
 				Luint8 u810MS_Timer;
 
@@ -203,11 +228,18 @@
 		//BMS interface layer
 		void vPWRNODE_BMS__Init(void);
 		void vPWRNODE_BMS__Process(void);
+		void vPWRNODE_BMS__Balance_Control(Luint8 u8Start);
+		Lfloat32 f32PWRNODE_BMS__Get_PackVolts(void);
+		Lfloat32 f32PWRNODE_BMS__Get_CellMin(void);
+		Lfloat32 f32PWRNODE_BMS__Get_CellMax(void);
+		Lfloat32 f32PWRNODE_BMS__Get_CellMean(void);
+		Lfloat32 f32PWRNODE_BMS__Get_Spread(void);
+		Luint16 u16PWRNODE_BMS__Get_Bleeding(void);
 
 		//pi comms interface
 		void vPWRNODE_PICOMMS__Init(void);
 		void vPWRNODE_PICOMMS__Process(void);
-		void vPWRNODE_PICOMMS__100MS_ISR(void);
+		void vPWRNODE_PICOMMS__10MS_ISR(void);
 
 			//common messaging interface
 			//for the PodSafe (DC/DC converter system)
@@ -24,6 +24,13 @@
 //the structure
 extern struct _strFCU sFCU;
 
+#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+	static void vFCU_ACCEL__Burst_Update(Luint8 u8Index);
+	#if C_LOCALDEF__LCCM655__ENABLE_DAQ == 1U
+		static void vFCU_ACCEL__Stream(Luint8 u8Index);
+	#endif
+#endif
+
 /***************************************************************************//**
  * @brief
  * Init the accel subsystem layer
@@ -56,14 +63,23 @@ void vFCU_ACCEL__Init(void)
 	//device 0
 	vMMA8451__Init(0U);
 
+	#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+		//swap over to FIFO bursts
+		vACCELBURST__Init(0U);
+		sFCU.sAccel.sChannels[0].u32SampleCursor = u32ACCELBURST__Get_Head(0U);
+	#endif
+
 	//check
 	u32Temp = u32MMA8451__Get_FaultFlags(0U);
+	#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+		u32Temp |= u32ACCELBURST__Get_FaultFlags(0U);
+	#endif
 	if(u32Temp != 0x00000000U)
 	{
 		//we had a fault with sensor 0
 		//we have a fault, so propergate the fault to our internal fault flags
-		vFAULTTREE__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__00);
-		vFAULTTREE__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__01);
+		vFAULTLINK__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__00);
+		vFAULTLINK__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__01);
 	}
 	else
 	{
@@ -84,14 +100,23 @@ void vFCU_ACCEL__Init(void)
 		//device 1
 		vMMA8451__Init(1U);
 
+		#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+			//swap over to FIFO bursts
+			vACCELBURST__Init(1U);
+			sFCU.sAccel.sChannels[1].u32SampleCursor = u32ACCELBURST__Get_Head(1U);
+		#endif
+
 		//check
 		u32Temp = u32MMA8451__Get_FaultFlags(1U);
+		#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+			u32Temp |= u32ACCELBURST__Get_FaultFlags(1U);
+		#endif
 		if(u32Temp != 0x00000000U)
 		{
 			//we had a fault with sensor 1
 			//we have a fault, so propergate the fault to our internal fault flags
-			vFAULTTREE__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__00);
-			vFAULTTREE__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__01);
+			vFAULTLINK__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__00);
+			vFAULTLINK__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__01);
 		}
 		else
 		{
@@ -116,15 +141,23 @@ void vFCU_ACCEL__Process(void)
 	Luint32 u32Temp1;
 
 	//process device 0
-	vMMA8451__Process(0U);
+	#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+		//runs the driver as well while it is zeroing
+		vACCELBURST__Process(0U);
+	#else
+		vMMA8451__Process(0U);
+	#endif
 
 	//after processing check for any fault flags
 	u32Temp0 = u32MMA8451__Get_FaultFlags(0U);
+	#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+		u32Temp0 |= u32ACCELBURST__Get_FaultFlags(0U);
+	#endif
 	if(u32Temp0 != 0x00000000U)
 	{
 		//we had a fault with sensor 0
-		vFAULTTREE__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__00);
-		vFAULTTREE__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__01);
+		vFAULTLINK__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__00);
+		vFAULTLINK__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__01);
 	}
 	else
 	{
@@ -133,15 +166,23 @@ void vFCU_ACCEL__Process(void)
 
 	#if C_LOCALDEF__LCCM418__NUM_DEVICES >= 2U
 	//do sensor 1
-	vMMA8451__Process(1U);
+	#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+		//runs the driver as well while it is zeroing
+		vACCELBURST__Process(1U);
+	#else
+		vMMA8451__Process(1U);
+	#endif
 
 	//after processing check for any fault flags
-	u32Temp1 = u32MMA8451__Get_FaultFlags(0U);
+	u32Temp1 = u32MMA8451__Get_FaultFlags(1U);
+	#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+		u32Temp1 |= u32ACCELBURST__Get_FaultFlags(1U);
+	#endif
 	if(u32Temp1 != 0x00000000U)
 	{
-		//we had a fault with sensor 0
-		vFAULTTREE__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__00);
-		vFAULTTREE__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__01);
+		//we had a fault with sensor 1
+		vFAULTLINK__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__00);
+		vFAULTLINK__Set_Flag(&sFCU.sFaults.sAccel, C_LCCM655__ACCEL__FAULT_INDEX__01);
 	}
 	else
 	{
@@ -152,14 +193,17 @@ void vFCU_ACCEL__Process(void)
 	if(u32Temp0 == 0U)
 	{
 		//no faults on sensor 0, safe to process accel data
-		sFCU.sAccel.sChannels[0].s16LastSample[0] = s16MMA8451_FILTERING__Get_Average(0U, AXIS_X);
-		sFCU.sAccel.sChannels[0].s16LastSample[1] = s16MMA8451_FILTERING__Get_Average(0U, AXIS_Y);
-		sFCU.sAccel.sChannels[0].s16LastSample[2] = s16MMA8451_FILTERING__Get_Average(0U, AXIS_Z);
-
-		sFCU.sAccel.sChannels[0].f32LastG[0] = f32MMA8451_MATH__Get_GForce(0U, AXIS_X);
-		sFCU.sAccel.sChannels[0].f32LastG[1] = f32MMA8451_MATH__Get_GForce(0U, AXIS_Y);
-		sFCU.sAccel.sChannels[0].f32LastG[2] = f32MMA8451_MATH__Get_GForce(0U, AXIS_Z);
-
+		#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+			vFCU_ACCEL__Burst_Update(0U);
+		#else
+			sFCU.sAccel.sChannels[0].s16LastSample[0] = s16MMA8451_FILTERING__Get_Average(0U, AXIS_X);
+			sFCU.sAccel.sChannels[0].s16LastSample[1] = s16MMA8451_FILTERING__Get_Average(0U, AXIS_Y);
+			sFCU.sAccel.sChannels[0].s16LastSample[2] = s16MMA8451_FILTERING__Get_Average(0U, AXIS_Z);
+
+			sFCU.sAccel.sChannels[0].f32LastG[0] = f32MMA8451_MATH__Get_GForce(0U, AXIS_X);
+			sFCU.sAccel.sChannels[0].f32LastG[1] = f32MMA8451_MATH__Get_GForce(0U, AXIS_Y);
+			sFCU.sAccel.sChannels[0].f32LastG[2] = f32MMA8451_MATH__Get_GForce(0U, AXIS_Z);
+		#endif
 
 	}
 	else
@@ -171,14 +215,18 @@ void vFCU_ACCEL__Process(void)
 	if(u32Temp1 == 0U)
 	{
 		//no faults on sensor 1, safe to process accel data
-		sFCU.sAccel.sChannels[1].s16LastSample[0] = s16MMA8451_FILTERING__Get_Average(1U, AXIS_X);
-		sFCU.sAccel.sChannels[1].s16LastSample[1] = s16MMA8451_FILTERING__Get_Average(1U, AXIS_Y);
-		sFCU.sAccel.sChannels[1].s16LastSample[2] = s16MMA8451_FILTERING__Get_Average(1U, AXIS_Z);
+		#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+			vFCU_ACCEL__Burst_Update(1U);
+		#else
+			sFCU.sAccel.sChannels[1].s16LastSample[0] = s16MMA8451_FILTERING__Get_Average(1U, AXIS_X);
+			sFCU.sAccel.sChannels[1].s16LastSample[1] = s16MMA8451_FILTERING__Get_Average(1U, AXIS_Y);
+			sFCU.sAccel.sChannels[1].s16LastSample[2] = s16MMA8451_FILTERING__Get_Average(1U, AXIS_Z);
 
 
-		sFCU.sAccel.sChannels[1].f32LastG[0] = f32MMA8451_MATH__Get_GForce(1U, AXIS_X);
-		sFCU.sAccel.sChannels[1].f32LastG[1] = f32MMA8451_MATH__Get_GForce(1U, AXIS_Y);
-		sFCU.sAccel.sChannels[1].f32LastG[2] = f32MMA8451_MATH__Get_GForce(1U, AXIS_Z);
+			sFCU.sAccel.sChannels[1].f32LastG[0] = f32MMA8451_MATH__Get_GForce(1U, AXIS_X);
+			sFCU.sAccel.sChannels[1].f32LastG[1] = f32MMA8451_MATH__Get_GForce(1U, AXIS_Y);
+			sFCU.sAccel.sChannels[1].f32LastG[2] = f32MMA8451_MATH__Get_GForce(1U, AXIS_Z);
+		#endif
 
 	}
 	else
@@ -222,6 +270,90 @@ Lfloat32 f32FCU_ACCEL__Get_LastG(Luint8 u8Index, Luint8 u8Axis)
 	return sFCU.sAccel.sChannels[u8Index].f32LastG[u8Axis];
 }
 
+/***************************************************************************//**
+ * @brief
+ * Accel device interrupt, the GIO ISR's call this
+ *
+ * @note
+ * In burst mode the FIFO watermark, which the burst layer hands to the driver
+ * while the driver is zeroing.
+ *
+ * @param[in]		u8Index					The accel device index
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.010.FUNC.006
+ */
+void vFCU_ACCEL__ISR(Luint8 u8Index)
+{
+	#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+		vACCELBURST__ISR(u8Index);
+	#else
+		vMMA8451__ISR(u8Index);
+	#endif
+}
+
+#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+/***************************************************************************//**
+ * @brief
+ * Take the latest from the burst stream for a device
+ *
+ * @note
+ * The last good values are held while the driver zeros the device and until
+ * the CIC has settled again after it.
+ *
+ * @param[in]		u8Index					The accel device index
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.010.FUNC.007
+ */
+static void vFCU_ACCEL__Burst_Update(Luint8 u8Index)
+{
+	Luint8 u8Axis;
+
+	if((u8ACCELBURST_ZERO__Get_IsCalibrating(u8Index) == 0U) &&
+		(u32ACCELBURST_FILT__Get_DecimatedCount(u8Index) >= C_LOCALDEF__LCCM669__CIC_STAGES))
+	{
+		for(u8Axis = 0U; u8Axis < 3U; u8Axis++)
+		{
+			//the CIC output is the anti aliased value at ODR / CIC_DECIMATION
+			sFCU.sAccel.sChannels[u8Index].s16LastSample[u8Axis] = s16ACCELBURST_FILT__Get_Decimated(u8Index, u8Axis);
+			sFCU.sAccel.sChannels[u8Index].f32LastG[u8Axis] = f32ACCELBURST_MATH__Get_GForce(u8Index, u8Axis);
+		}
+	}
+	else
+	{
+		//hold
+	}
+
+	#if C_LOCALDEF__LCCM655__ENABLE_DAQ == 1U
+		//every sample at full rate to the DAQ
+		vFCU_ACCEL__Stream(u8Index);
+	#endif
+}
+
+#if C_LOCALDEF__LCCM655__ENABLE_DAQ == 1U
+/***************************************************************************//**
+ * @brief
+ * Move any new burst samples for a device into its DAQ channels
+ *
+ * @param[in]		u8Index					The accel device index
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.010.FUNC.005
+ */
+static void vFCU_ACCEL__Stream(Luint8 u8Index)
+{
+	ACCELBURST__SAMPLE_T sSample;
+	Luint16 u16Channel;
+
+	u16Channel = (Luint16)C_FCU__DAQ_INDEX__ACCEL_S16 + ((Luint16)u8Index * 3U);
+	while(u8ACCELBURST__Get_Sample(u8Index, &sFCU.sAccel.sChannels[u8Index].u32SampleCursor, &sSample) == 1U)
+	{
+		vDAQRING_APPEND__S16(u16Channel, sSample.s16Axis[0]);
+		vDAQRING_APPEND__S16(u16Channel + 1U, sSample.s16Axis[1]);
+		vDAQRING_APPEND__S16(u16Channel + 2U, sSample.s16Axis[2]);
+	}
+}
+#endif //C_LOCALDEF__LCCM655__ENABLE_DAQ
+#endif //C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE
+
 #endif //C_LOCALDEF__LCCM655__ENABLE_ACCEL
 #endif //#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
 //safetys
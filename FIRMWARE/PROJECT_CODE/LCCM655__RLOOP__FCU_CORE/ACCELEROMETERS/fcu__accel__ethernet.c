@@ -22,6 +22,21 @@
 #if C_LOCALDEF__LCCM655__ENABLE_ACCEL == 1U
 #if C_LOCALDEF__LCCM655__ENABLE_ETHERNET == 1U
 
+//in burst mode the device process doesn't run, the values come from the burst layer
+#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+	#define M_FCU_ACCEL_ETH__FAULTS(dev)				(u32MMA8451__Get_FaultFlags(dev) | u32ACCELBURST__Get_FaultFlags(dev))
+	#define M_FCU_ACCEL_ETH__AVERAGE(dev, axis)			s16ACCELBURST_FILT__Get_Average(dev, (Luint8)axis)
+	#define M_FCU_ACCEL_ETH__GFORCE(dev, axis)			f32ACCELBURST_MATH__Get_GForce(dev, (Luint8)axis)
+	#define M_FCU_ACCEL_ETH__PITCH(dev)					f32ACCELBURST_MATH__Get_PitchAngle(dev)
+	#define M_FCU_ACCEL_ETH__ROLL(dev)					f32ACCELBURST_MATH__Get_RollAngle(dev)
+#else
+	#define M_FCU_ACCEL_ETH__FAULTS(dev)				u32MMA8451__Get_FaultFlags(dev)
+	#define M_FCU_ACCEL_ETH__AVERAGE(dev, axis)			s16MMA8451_FILTERING__Get_Average(dev, axis)
+	#define M_FCU_ACCEL_ETH__GFORCE(dev, axis)			f32MMA8451_MATH__Get_GForce(dev, axis)
+	#define M_FCU_ACCEL_ETH__PITCH(dev)					f32MMA8451_MATH__Get_PitchAngle(dev)
+	#define M_FCU_ACCEL_ETH__ROLL(dev)					f32MMA8451_MATH__Get_RollAngle(dev)
+#endif
+
 
 /***************************************************************************//**
  * @brief
@@ -72,39 +87,39 @@ void vFCU_ACCEL_ETH__Transmit(E_FCU_NET_PACKET_TYPES ePacketType)
 				{
 
 					//fault flags
-					vNUMERICAL_CONVERT__Array_U32(pu8Buffer, u32MMA8451__Get_FaultFlags(u8Device));
+					vNUMERICAL_CONVERT__Array_U32(pu8Buffer, M_FCU_ACCEL_ETH__FAULTS(u8Device));
 					pu8Buffer += 4U;
 
 					//X Raw
-					vNUMERICAL_CONVERT__Array_S16(pu8Buffer, s16MMA8451_FILTERING__Get_Average(u8Device, AXIS_X));
+					vNUMERICAL_CONVERT__Array_S16(pu8Buffer, M_FCU_ACCEL_ETH__AVERAGE(u8Device, AXIS_X));
 					pu8Buffer += 2U;
 
 					//Y Raw
-					vNUMERICAL_CONVERT__Array_S16(pu8Buffer, s16MMA8451_FILTERING__Get_Average(u8Device, AXIS_Y));
+					vNUMERICAL_CONVERT__Array_S16(pu8Buffer, M_FCU_ACCEL_ETH__AVERAGE(u8Device, AXIS_Y));
 					pu8Buffer += 2U;
 
 					//Z Raw
-					vNUMERICAL_CONVERT__Array_S16(pu8Buffer, s16MMA8451_FILTERING__Get_Average(u8Device, AXIS_Z));
+					vNUMERICAL_CONVERT__Array_S16(pu8Buffer, M_FCU_ACCEL_ETH__AVERAGE(u8Device, AXIS_Z));
 					pu8Buffer += 2U;
 
 					//X Accel
-					vNUMERICAL_CONVERT__Array_F32(pu8Buffer, f32MMA8451_MATH__Get_GForce(u8Device, AXIS_X));
+					vNUMERICAL_CONVERT__Array_F32(pu8Buffer, M_FCU_ACCEL_ETH__GFORCE(u8Device, AXIS_X));
 					pu8Buffer += 4U;
 
 					//Y Accel
-					vNUMERICAL_CONVERT__Array_F32(pu8Buffer, f32MMA8451_MATH__Get_GForce(u8Device, AXIS_Y));
+					vNUMERICAL_CONVERT__Array_F32(pu8Buffer, M_FCU_ACCEL_ETH__GFORCE(u8Device, AXIS_Y));
 					pu8Buffer += 4U;
 
 					//Z Accel
-					vNUMERICAL_CONVERT__Array_F32(pu8Buffer, f32MMA8451_MATH__Get_GForce(u8Device, AXIS_Z));
+					vNUMERICAL_CONVERT__Array_F32(pu8Buffer, M_FCU_ACCEL_ETH__GFORCE(u8Device, AXIS_Z));
 					pu8Buffer += 4U;
 
 					//Pitch
-					vNUMERICAL_CONVERT__Array_F32(pu8Buffer, f32MMA8451_MATH__Get_PitchAngle(u8Device));
+					vNUMERICAL_CONVERT__Array_F32(pu8Buffer, M_FCU_ACCEL_ETH__PITCH(u8Device));
 					pu8Buffer += 4U;
 
 					//Roll
-					vNUMERICAL_CONVERT__Array_F32(pu8Buffer, f32MMA8451_MATH__Get_RollAngle(u8Device));
+					vNUMERICAL_CONVERT__Array_F32(pu8Buffer, M_FCU_ACCEL_ETH__ROLL(u8Device));
 					pu8Buffer += 4U;
 
 				}//for(u8Device = 0; u8Device < 3; u8Device++)
@@ -115,19 +130,19 @@ void vFCU_ACCEL_ETH__Transmit(E_FCU_NET_PACKET_TYPES ePacketType)
 				{
 
 					//fault flags
-					vNUMERICAL_CONVERT__Array_U32(pu8Buffer, u32MMA8451__Get_FaultFlags(u8Device));
+					vNUMERICAL_CONVERT__Array_U32(pu8Buffer, M_FCU_ACCEL_ETH__FAULTS(u8Device));
 					pu8Buffer += 4U;
 
 					//X Raw
-					vNUMERICAL_CONVERT__Array_S16(pu8Buffer, s16MMA8451_FILTERING__Get_Average(u8Device, AXIS_X));
+					vNUMERICAL_CONVERT__Array_S16(pu8Buffer, M_FCU_ACCEL_ETH__AVERAGE(u8Device, AXIS_X));
 					pu8Buffer += 2U;
 
 					//Y Raw
-					vNUMERICAL_CONVERT__Array_S16(pu8Buffer, s16MMA8451_FILTERING__Get_Average(u8Device, AXIS_Y));
+					vNUMERICAL_CONVERT__Array_S16(pu8Buffer, M_FCU_ACCEL_ETH__AVERAGE(u8Device, AXIS_Y));
 					pu8Buffer += 2U;
 
 					//Z Raw
-					vNUMERICAL_CONVERT__Array_S16(pu8Buffer, s16MMA8451_FILTERING__Get_Average(u8Device, AXIS_Z));
+					vNUMERICAL_CONVERT__Array_S16(pu8Buffer, M_FCU_ACCEL_ETH__AVERAGE(u8Device, AXIS_Z));
 					pu8Buffer += 2U;
 
 				}
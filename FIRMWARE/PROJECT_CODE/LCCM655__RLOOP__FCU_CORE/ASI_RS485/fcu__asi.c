@@ -33,12 +33,12 @@ extern struct _strFCU sFCU;
  * @return			-1 = error
  * 					0 = success
  */
-Lint16 vFCU_ASI__Controller_Init(void)
+Lint16 s16FCU_ASI__Controller_Init(void)
 {
 	Lint16 i16Return = 0;
 	struct _strASICmd sCmd;
 
-	memset(sCmd,0,sizeof(struct _strASICmd));
+	memset(&sCmd,0,sizeof(struct _strASICmd));
 	// Common for all these init commands
 	sCmd.u8SlaveAddress = 0;
 	sCmd.fncCode = C_ASI__WRITE_SINGLE_REGISTER;
@@ -46,7 +46,7 @@ Lint16 vFCU_ASI__Controller_Init(void)
 	// set command control source as serial network
 	sCmd.paramAddress = C_FCU_ASI__COMMAND_SOURCE;
 	sCmd.paramValue = 0;	// sets to serial
-	if ((i16Return = vFCU_ASI__SendCommand(&sCmd)) != 0)
+	if ((i16Return = s16FCU_ASI__SendCommand(&sCmd)) != 0)
 	{
 		// report an error
 		return i16Return;
@@ -55,21 +55,21 @@ Lint16 vFCU_ASI__Controller_Init(void)
 	// set temperature thresholds
 	sCmd.paramAddress = C_FCU_ASI__OVER_TEMP_THRESHOLD;
 	sCmd.paramValue = 0;	// TODO: what value?
-	if ((i16Return = vFCU_ASI__SendCommand(&sCmd)) != 0)
+	if ((i16Return = s16FCU_ASI__SendCommand(&sCmd)) != 0)
 	{
 		// report an error
 		return i16Return;
 	}
 	sCmd.paramAddress = C_FCU_ASI__FOLDBACK_STARING_TEMP;
 	sCmd.paramValue = 0;	// TODO: what value?
-	if ((i16Return = vFCU_ASI__SendCommand(&sCmd)) != 0)
+	if ((i16Return = s16FCU_ASI__SendCommand(&sCmd)) != 0)
 	{
 		// report an error
 		return i16Return;
 	}
 	sCmd.paramAddress = C_FCU_ASI__FOLDBACK_END_TEMP;
 	sCmd.paramValue = 0;	// TODO: what value?
-	if ((i16Return = vFCU_ASI__SendCommand(&sCmd)) != 0)
+	if ((i16Return = s16FCU_ASI__SendCommand(&sCmd)) != 0)
 	{
 		// report an error
 		return i16Return;
@@ -83,50 +83,54 @@ Lint16 vFCU_ASI__Controller_Init(void)
  * @brief
  * Read motor rpm
  *
+ * @note
+ * Latest value from the telemetry poll, no bus traffic.
+ *
  * @param[in]		u8ASIDevNum		ASI controler device to communicate (1-8)
  * @param[out]		u16Rpm			Parameter to store rpm
  * @return			-1 = error
+ * 					-2 = not read yet
  * 					0 = success
  */
 Lint16 s16FCU_ASI__ReadMotorRpm(Luint8 u8ASIDevNum, Luint16 *u16Rpm)
 {
-	Lint16 s16Return = 0;
-	struct _strASICmd sCmd;
+	return s16FCU_ASI__Get_Register(u8ASIDevNum, C_FCU_ASI__MOTOR_RPM, u16Rpm);
+}
 
-	memset(sCmd,0,sizeof(struct _strASICmd));
-	sCmd.u8SlaveAddress = u8ASIDevNum;
-	sCmd.fncCode = C_ASI__READ_INPUT_REGISTER;
-	sCmd.paramAddress = C_FCU_ASI__MOTOR_RPM;
-	sCmd.paramValue = 1;	// we just want to read one register
-	sCmd.destVar = (void*)u16Rpm;
-	sCmd.eDestVarType = E_UINT16;
-	s16Return=vFCU_ASI__SendCommand(&sCmd);
-	return s16Return;
+/***************************************************************************//**
+ * @brief
+ * Read motor current
+ *
+ * @note
+ * Latest value from the telemetry poll, no bus traffic.
+ *
+ * @param[in]		u8ASIDevNum		ASI controler device to communicate (1-8)
+ * @param[out]		u16Current		Parameter to store current
+ * @return			-1 = error
+ * 					-2 = not read yet
+ * 					0 = success
+ */
+Lint16 s16FCU_ASI__ReadMotorCurrent(Luint8 u8ASIDevNum, Luint16 *u16Current)
+{
+	return s16FCU_ASI__Get_Register(u8ASIDevNum, C_FCU_ASI__MOTOR_CURRENT, u16Current);
 }
 
 /***************************************************************************//**
  * @brief
  * Read controller's base plate temperature
  *
+ * @note
+ * Latest value from the telemetry poll, no bus traffic.
+ *
  * @param[in]		u8ASIDevNum		ASI controler device to communicate (1-8)
  * @param[out]		u16Temp			Parameter to store temperature in Celsius
  * @return			-1 = error
+ * 					-2 = not read yet
  * 					0 = success
  */
 Lint16 s16FCU_ASI__ReadControllerTemperature(Luint8 u8ASIDevNum, Luint16 *u16Temp)
 {
-	Lint16 s16Return = 0;
-	struct _strASICmd sCmd;
-
-	memset(sCmd,0,sizeof(struct _strASICmd));
-	sCmd.u8SlaveAddress = u8ASIDevNum;
-	sCmd.fncCode = C_ASI__READ_INPUT_REGISTER;
-	sCmd.paramAddress = C_FCU_ASI__CONT_TEMP;
-	sCmd.paramValue = 1;	// we just want to read one register
-	sCmd.destVar = (void*)u16Temp;
-	sCmd.eDestVarType = E_UINT16;
-	s16Return = vFCU_ASI__SendCommand(&sCmd);
-	return s16Return;
+	return s16FCU_ASI__Get_Register(u8ASIDevNum, C_FCU_ASI__CONT_TEMP, u16Temp);
 }
 
 
@@ -144,12 +148,12 @@ Lint16 s16FCU_ASI__SaveSettings(Luint8 u8ASIDevNum)
 	Lint16 s16Return = 0;
 	struct _strASICmd sCmd;
 
-	memset(sCmd,0,sizeof(struct _strASICmd));
+	memset(&sCmd,0,sizeof(struct _strASICmd));
 	sCmd.u8SlaveAddress = u8ASIDevNum;
 	sCmd.fncCode = C_ASI__WRITE_SINGLE_REGISTER;
 	sCmd.paramAddress = C_FCU_ASI__SAVE_SETTINGS;
 	sCmd.paramValue = 32767;
-	s16Return = vFCU_ASI__SendCommand(&sCmd);
+	s16Return = s16FCU_ASI__SendCommand(&sCmd);
 	return s16Return;
 }
 
@@ -157,28 +161,19 @@ Lint16 s16FCU_ASI__SaveSettings(Luint8 u8ASIDevNum)
  * @brief
  * Get faults from ASI controller
  *
+ * @note
+ * Latest value from the telemetry poll, no bus traffic.
+ *
  * @param[in]		u8ASIDevNum		ASI controler device to communicate (1-8)
  * @param[out]		u16Faults		Parameter to store faults bit array
  * @return			-1 = error
+ * 					-2 = not read yet
  * 					0 = success
  */
 Lint16 s16FCU_ASI__GetFaults(Luint8 u8ASIDevNum, Luint16 *u16Faults)
 {
-	Lint16 s16Return = 0;
-	struct _strASICmd sCmd;
-
-	memset(sCmd,0,sizeof(struct _strASICmd));
-	sCmd.u8SlaveAddress = u8ASIDevNum;
-	sCmd.fncCode = C_ASI__READ_INPUT_REGISTER;
-	sCmd.paramAddress = C_FCU_ASI__FAULTS;
-	sCmd.paramValue = 1;	// we just want to read one register
-	sCmd.destVar = (void*)u16Faults;
-	sCmd.eDestVarType = E_UINT16;
-
-	s16Return = vFCU_ASI__SendCommand(&sCmd);
-
 	// TODO: create a log message with all faults, defined in fcu_core_defines.h
-	return s16Return;
+	return s16FCU_ASI__Get_Register(u8ASIDevNum, C_FCU_ASI__FAULTS, u16Faults);
 }
 
 #endif //C_LOCALDEF__LCCM655__ENABLE_ASI_RS485
@@ -6,6 +6,9 @@
 	#define C_ASI__READ_INPUT_REGISTER			(0x04)
 	#define C_ASI__WRITE_SINGLE_REGISTER		(0x06)
 
+	// set on the function code of an exception reply
+	#define C_ASI__EXCEPTION_FLAG				(0x80)
+
 
 	/** ASI command parameter register address */
 	// see ASI BAC object Dictionary document for more
@@ -17,11 +20,17 @@
 	#define C_FCU_ASI__FAULTS								(258)
 	#define C_FCU_ASI__CONT_TEMP							(259)
 	#define C_FCU_ASI__TEMPERATURE							(261)
+	#define C_FCU_ASI__MOTOR_CURRENT						(262)
 	#define C_FCU_ASI__MOTOR_RPM							(263)
 	#define C_FCU_ASI__LAST_FAULT							(269)
 	#define C_FCU_ASI__RAW_SENSOR_TEMPERATURE				(273)
 	#define C_FCU_ASI__SAVE_SETTINGS						(511)
 
+	/** Telemetry registers cached for each controller, anything on the poll
+	 * schedule has to sit inside this window */
+	#define C_FCU_ASI__CACHE_BASE							(C_FCU_ASI__CONTROLLER_STATUS)
+	#define C_FCU_ASI__CACHE_SIZE							(16U)
+
 	/** ASI controller faults bit array*/
 	#define C_FCU_ASI__CONTROLLER_OVER_VOLTAGE				(OX0001)
 	#define C_FCU_ASI__PHASE_OVER_CURRENT					(OX0002)
@@ -1,8 +1,24 @@
 /**
  * @file		FCU__ASI_RS485.C
  * @brief		RS485 interface to ASI controller
+ *
+ * @note
+ * Modbus RTU master for the eight hover engine controllers. Whole frames go to
+ * the SC16 FIFO in one SPI burst and every wait is a deadline on the 64 bit
+ * timebase, so vFCU_ASI__Process() never spins.
+ *
+ * Telemetry comes from a poll schedule. Registers on the same rate are joined
+ * into one multi register read if the gap between them is small, and each
+ * block is read from every controller in turn. Queued commands, throttle
+ * writes and the like, go ahead of the next poll.
+ *
+ * Modbus only allows one request on the bus at a time, so the pipelining is
+ * on our side: the next request, CRC and all, is built while the current one
+ * is on the bus and goes to the UART on the first pass after the 3.5 char gap.
+ *
  * @author		Lachlan Grogan
  * @copyright	rLoop Inc.
+ * @st_fileID	LCCM655R0.FILE.043
  */
 /**
  * @addtogroup RLOOP
@@ -24,166 +40,186 @@
 //the structure
 extern struct _strFCU sFCU;
 
+//locals
+static void vFCU_ASI__Build_Frame(Luint8 *pu8Frame, Luint8 u8Slave, Luint8 u8Function, Luint16 u16Register, Luint16 u16Value);
+static void vFCU_ASI__Stage_Next(void);
+static void vFCU_ASI__Transmit(Luint64 u64Now);
+static void vFCU_ASI__Receive(Luint64 u64Now);
+static void vFCU_ASI__Complete(void);
+static void vFCU_ASI__Fail(Luint64 u64Now, Luint8 u8Timeout);
+static void vFCU_ASI__SetVar(const struct _strASIXfer *pXfer, Luint16 u16Value);
+static void vFCU_ASI__Schedule_Merge(Luint8 u8Index);
+
+
 /***************************************************************************//**
  * @brief
  * Init any variables
  *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.001
  */
 void vFCU_ASI__Init(void)
 {
-	memset(sFCU.sASIComms, 0, sizeof(sFCU.sASIComms));
-
-	// TODO: lower level SC16 and MCP23 init
-	// TODO: set baud rate
-	// 3.5CharTimer and 1.5CharTimer depend on baud rate (see pg 13 of Modbus over serial line spec)
-	// assume we will set baud rate > 19200 Bps
-	// TODO: get information on micro second timer counter
-	// TODO: implement 1.5CharTimer to detect incomplete frames
-	// assuming we have a global micro second counter that we can get with getCurMicroSecTimer()
-	// assuming we have vSC16_USER__Tx_Byte(), vSC16_USER__RxIsReady() and vSC16_USER__Rx_Byte()
-	sFCU.sASIComms.timeout_3_5_char = 1750; // in microsec
-	sFCU.sASIComms.timeout_1_5_char = 750; // in microsec
-	sFCU.sASIComms.timeout_response = 3000;  // this is application specific; TODO: check this value
-
-	// ensure first frame starts with silence interval
-	sFCU.sASIComms.timer_3_5_char_start =  getCurMicroSecTimer();
+	Luint32 u32Counter;
+	Luint16 u16CRC;
+	Luint8 u8Bit;
+	Luint64 u64Now;
+
+	memset(&sFCU.sASIComms, 0, sizeof(sFCU.sASIComms));
+
+	//Modbus CRC16, poly 0xA001 LSB first
+	for(u32Counter = 0U; u32Counter < 256U; u32Counter++)
+	{
+		u16CRC = (Luint16)u32Counter;
+		for(u8Bit = 0U; u8Bit < 8U; u8Bit++)
+		{
+			if((u16CRC & 0x0001U) != 0U)
+			{
+				u16CRC = (Luint16)((u16CRC >> 1U) ^ 0xA001U);
+			}
+			else
+			{
+				u16CRC = (Luint16)(u16CRC >> 1U);
+			}
+		}
+		sFCU.sASIComms.u16CRCTable[u32Counter] = u16CRC;
+	}
+
+	//8N1 as the SC16 is set up, 10 bits a char
+	sFCU.sASIComms.u32CharTicks = (Luint32)((((Luint64)C_LOCALDEF__LCCM655__ASI_TICKS_PER_SEC * 10U) + (Luint64)C_LOCALDEF__LCCM655__ASI_BAUD - 1U) / (Luint64)C_LOCALDEF__LCCM655__ASI_BAUD);
+
+	//the spec fixes the gap at 1750us above 19200 baud (Modbus over serial line 2.5.1.1)
+	if(C_LOCALDEF__LCCM655__ASI_BAUD > 19200U)
+	{
+		sFCU.sASIComms.u32GapTicks = (Luint32)(((Luint64)C_LOCALDEF__LCCM655__ASI_TICKS_PER_SEC * 1750U) / 1000000U);
+	}
+	else
+	{
+		sFCU.sASIComms.u32GapTicks = (sFCU.sASIComms.u32CharTicks * 7U) / 2U;
+	}
+	sFCU.sASIComms.u32ResponseTicks = (Luint32)(((Luint64)C_LOCALDEF__LCCM655__ASI_TICKS_PER_SEC * C_ASI__RESPONSE_TIMEOUT_US) / 1000000U);
+	sFCU.sASIComms.u32TurnaroundTicks = (Luint32)(((Luint64)C_LOCALDEF__LCCM655__ASI_TICKS_PER_SEC * C_ASI__TURNAROUND_US) / 1000000U);
+
+	for(u32Counter = 0U; u32Counter < C_ASI__NUM_CONTROLLERS; u32Counter++)
+	{
+		sFCU.sASIComms.sSlave[u32Counter].u32Latency_Min = 0xFFFFFFFFU;
+	}
+
+	sFCU.sASIComms.sPoll.u8CoalesceGap = C_ASI__COALESCE_GAP;
+	sFCU.sASIComms.sPoll.u8NewCycle = 1U;
+
+	//ensure first frame starts with silence interval
+	u64Now = M_LOCALDEF__LCCM655__ASI_TIMESTAMP();
+	sFCU.sASIComms.u64Deadline = u64Now + sFCU.sASIComms.u32GapTicks;
+	sFCU.sASIComms.u64BusFree = sFCU.sASIComms.u64Deadline;
+	sFCU.sASIComms.eMbState = ASI_COMM_STATE__INITIAL;
+
+	//what the throttle loop needs every pass, the rest every 10th
+	(void)s16FCU_ASI__Schedule_Add(C_FCU_ASI__CONTROLLER_STATUS, 1U);
+	(void)s16FCU_ASI__Schedule_Add(C_FCU_ASI__FAULTS, 1U);
+	(void)s16FCU_ASI__Schedule_Add(C_FCU_ASI__MOTOR_CURRENT, 1U);
+	(void)s16FCU_ASI__Schedule_Add(C_FCU_ASI__MOTOR_RPM, 1U);
+	(void)s16FCU_ASI__Schedule_Add(C_FCU_ASI__CONT_TEMP, 10U);
+	(void)s16FCU_ASI__Schedule_Add(C_FCU_ASI__TEMPERATURE, 10U);
+	(void)s16FCU_ASI__Schedule_Add(C_FCU_ASI__LAST_FAULT, 10U);
 
 	// initialize all slaves
-	vFCU_ASI__Controller_Init();
+	(void)s16FCU_ASI__Controller_Init();
 }
 
 
 /***************************************************************************//**
  * @brief
  * Process any ASI tasks
- * 
+ *
+ * @note
+ * Call as often as possible, the gap and timeouts are only as good as the
+ * time between calls.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.002
  */
 void vFCU_ASI__Process(void)
 {
-	Luint8 byteIndex;
-	Luint8 bSent=0;
-	Luint8 bProcessedReply=0;
+	Luint64 u64Now;
+
+	u64Now = M_LOCALDEF__LCCM655__ASI_TIMESTAMP();
+
+	//pipeline, the next request is ready before the bus is
+	if((sFCU.sASIComms.u8NextReady == 0U) && (sFCU.sASIComms.u8Resend == 0U))
+	{
+		vFCU_ASI__Stage_Next();
+	}
+	else
+	{
+		//already have one
+	}
 
 	// modbus over serial line state machine
 	switch(sFCU.sASIComms.eMbState)
 	{
 		case ASI_COMM_STATE__INITIAL:
 			// wait for 3.5 char worth of silence time
-			if ((getCurMicroSecTimer() - sFCU.sASIComms.timer_3_5_char_start) > sFCU.sASIComms.timeout_3_5_char)
+			if(u64Now >= sFCU.sASIComms.u64Deadline)
 			{
 				sFCU.sASIComms.eMbState = ASI_COMM_STATE__IDLE;
 			}
+			else
+			{
+				//keep waiting
+			}
 			break;
 
 		case ASI_COMM_STATE__IDLE:
-			// see if we have a command to transmit in the queue
-			if (sFCU.sASIComms.qHead != sFCU.sASIComms.qTail)
+			if(((sFCU.sASIComms.u8Resend == 1U) || (sFCU.sASIComms.u8NextReady == 1U)) && (u64Now >= sFCU.sASIComms.u64BusFree))
 			{
-				if (sFCU.sASIComms.cmdQueue[sFCU.sASIComms.qTail].u8SlaveAddress == 0)
-				{
-					// we have a broadcast command
-					sFCU.sASIComms.eMbState = ASI_COMM_STATE__BROADCAST_EMISSION;
-				}
-				else
-				{
-					// we have a unicast command
-					sFCU.sASIComms.eMbState = ASI_COMM_STATE__UNICAST_EMISSION;
-				}
+				vFCU_ASI__Transmit(u64Now);
+			}
+			else
+			{
+				//nothing to send or still in the gap
 			}
 			break;
 
 		case ASI_COMM_STATE__BROADCAST_EMISSION:
-			if (bSent && (getCurMicroSecTimer() - sFCU.sASIComms.timer_turnaround_start) > sFCU.sASIComms.timeout_turnaround)
+			//no reply, just give the slaves time to act on it
+			if(u64Now >= sFCU.sASIComms.u64Deadline)
 			{
-				bSent=0;
+				sFCU.sASIComms.u64BusFree = u64Now;
 				sFCU.sASIComms.eMbState = ASI_COMM_STATE__IDLE;
 			}
-			else if (!bSent)
-			{
-				// start transmitting
-				Luint8* pByte = sFCU.sASIComms.cmdQueue[sFCU.sASIComms.qTail].framedCmd;
-				for (byteIndex=0; byteIndex < C_ASI__RW_FRAME_SIZE; byteIndex++)
-				{
-					vFCU_ASI__RTU_Tx_Byte(pByte++);
-				}
-				bSent=1;
-				// done sending all bytes, start turn around timer
-				sFCU.sASIComms.timer_turnaround_start  = getCurMicroSecTimer();
-			}
 			else
 			{
-				// stay in this state until turnaround delay passes
+				//stay in this state until turnaround delay passes
 			}
-
 			break;
 
 		case ASI_COMM_STATE__UNICAST_EMISSION:
-			if (bSent && (getCurMicroSecTimer() - sFCU.sASIComms.timer_3_5_char_start) > sFCU.sASIComms.timeout_3_5_char)
+			//request still leaving the UART
+			if(u64Now >= sFCU.sASIComms.u64Deadline)
 			{
-				bSent=0;
+				sFCU.sASIComms.u64Deadline = sFCU.sASIComms.u64TxEnd + sFCU.sASIComms.u32ResponseTicks;
 				sFCU.sASIComms.eMbState = ASI_COMM_STATE__RECEPTION;
 			}
-			else if (!bSent)
-			{
-				// start transmitting
-				Luint8* pByte = sFCU.sASIComms.cmdQueue[sFCU.sASIComms.qTail].framedCmd;
-				for (byteIndex=0; byteIndex < C_ASI__RW_FRAME_SIZE; byteIndex++)
-				{
-					vFCU_ASI__RTU_Tx_Byte(pByte++);
-				}
-				bSent=1;
-				// done sending all bytes, start 3.5 char worth silence interval and response timer
-				sFCU.sASIComms.timer_3_5_char_start =  sFCU.sASIComms.timer_response_start  = getCurMicroSecTimer();
-			}
 			else
 			{
-				// stay in this state until silence interval passes
+				//keep waiting
 			}
-
 			break;
 
 		case ASI_COMM_STATE__RECEPTION:
-			if ((getCurMicroSecTimer() - sFCU.sASIComms.timer_response_start) > sFCU.sASIComms.timeout_response)
-			{
-				// timed out waiting for response, message is left in queue, try sending again
-				sFCU.sASIComms.eMbState = ASI_COMM_STATE__IDLE;
-			}
-			else if (vFCU_ASI__RTU_RxIsReady())
-			{
-				// start receiveing
-				Luint8* pByte = sFCU.sASIComms.cmdQueue[sFCU.sASIComms.qTail].response;
-				for (byteIndex=0; byteIndex < C_ASI__RW_FRAME_SIZE; byteIndex++)
-				{
-					vFCU_ASI__RTU_Rx_Byte(pByte++);
-				}
-				// done getting all bytes, start 3.5 silence interval
-				sFCU.sASIComms.timer_3_5_char_start =  getCurMicroSecTimer();
-				sFCU.sASIComms.eMbState = ASI_COMM_STATE__CONTROL_AND_WAIT;
-			}
+			vFCU_ASI__Receive(u64Now);
 			break;
 
 		case ASI_COMM_STATE__CONTROL_AND_WAIT:
-			if (bProcessedReply && (getCurMicroSecTimer() - sFCU.sASIComms.timer_3_5_char_start) > sFCU.sASIComms.timeout_3_5_char)
-			{
-				bProcessedReply=0;
-				sFCU.sASIComms.eMbState = ASI_COMM_STATE__IDLE;
-			}
-			else if (!bProcessedReply)
-			{
-				if (vFCU_ASI__ProcessReply())
-				{
-					// there was an error
-					sFCU.sASIComms.eMbState = ASI_COMM_STATE__IDLE;
-				}
-				else
-				{
-					bProcessedReply=1;
-				}
-			}
-			else
-			{
-				// stay in this state until silence interval passes
-			}
+			//the gap is timed from the last reply byte by u64BusFree
+			vFCU_ASI__Complete();
+			break;
+
+		default:
+			//log the error
+			sFCU.sASIComms.u64BusFree = u64Now + sFCU.sASIComms.u32GapTicks;
+			sFCU.sASIComms.eMbState = ASI_COMM_STATE__IDLE;
 			break;
 	}
 
@@ -193,265 +229,802 @@ void vFCU_ASI__Process(void)
  * @brief
  * Send Read/Write register command to ASI controller
  *
+ * @note
+ * Commands go out ahead of the telemetry polls, in the order given.
+ *
  * @param[in]	sCmdParams		Command structure
  * @return			-1 = error
  * 					0 = success
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.003
  */
-Lint8 vFCU_ASI__SendCommand(struct _strASICmd *sCmdParams)
+Lint16 s16FCU_ASI__SendCommand(struct _strASICmd *sCmdParams)
 {
-	if (sCmdParams)
-	{
-		struct _strASICmd *pHead = &sFCU.sASIComms.cmdQueue[sFCU.sASIComms.qHead];
+	Lint16 s16Return;
+	Luint8 u8Next;
 
-		if ((sFCU.sASIComms.qHead + 1) == sFCU.sASIComms.qTail)
+	if(sCmdParams != 0)
+	{
+		u8Next = (Luint8)((sFCU.sASIComms.qHead + 1U) % C_ASI__COMMAND_QUEUE);
+		if(u8Next == sFCU.sASIComms.qTail)
 		{
 			// queue is backed up, can't send message
-			return -1;
+			s16Return = -1;
 		}
+		else
+		{
+			// build the frame of bytes to send for this command
+			vFCU_ASI__Build_Frame(&sCmdParams->framedCmd[0], sCmdParams->u8SlaveAddress, sCmdParams->fncCode, sCmdParams->paramAddress, sCmdParams->paramValue);
 
-		// build the frame of bytes to send for this command
-		vFCU_ASI__BuildCmdFrame(sCmdParams);
-
-		// add command to next available slot in command queue
-		memcpy(pHead,sCmdParams,sizeof(struct _strASICmd));
-
-		// adjust head pointer
-		sFCU.sASIComms.qHead++;
-		if (sFCU.sASIComms.qHead == C_ASI__RW_FRAME_SIZE)
-			sFCU.sASIComms.qHead=0;	// rollover
+			// add command to next available slot in command queue
+			memcpy(&sFCU.sASIComms.cmdQueue[sFCU.sASIComms.qHead], sCmdParams, sizeof(struct _strASICmd));
+			sFCU.sASIComms.qHead = u8Next;
+			s16Return = 0;
+		}
+	}
+	else
+	{
+		s16Return = -1;
 	}
-	return 0;
-}
 
+	return s16Return;
+}
 
 /***************************************************************************//**
  * @brief
- * Build Modbus read/write register command frame to issue to ASI controller
+ * Empty the poll schedule
  *
-  * @param[in]	sCmdParams		Command structure
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.004
  */
-void vFCU_ASI__BuildCmdFrame(struct _strASICmd *sCmdParams)
+void vFCU_ASI__Schedule_Clear(void)
 {
-	if (sCmdParams)
-	{
-		sCmdParams->framedCmd[0]=sCmdParams->u8SlaveAddress;
-		sCmdParams->framedCmd[1]=sCmdParams->fncCode;
-		sCmdParams->framedCmd[2]=(Luint8)(sCmdParams->paramAddress >> 8);				// register address Hi
-		sCmdParams->framedCmd[3]=(Luint8)(sCmdParams->paramAddress & 0x00FF);	 		// register address Lo
-		sCmdParams->framedCmd[4]=(Luint8)(sCmdParams->paramValue >> 8);  				// register value Hi
-		sCmdParams->framedCmd[5]=(Luint8)(sCmdParams->paramValue & 0x00FF);				// register value Lo
-		vFCU_ASI__AddCRC(sCmdParams->framedCmd);
-	}
+	sFCU.sASIComms.sPoll.u8NumBlocks = 0U;
+	sFCU.sASIComms.sPoll.u8Block = 0U;
+	sFCU.sASIComms.sPoll.u8Slave = 0U;
+	sFCU.sASIComms.sPoll.u32Cycle = 0U;
+	sFCU.sASIComms.sPoll.u8NewCycle = 1U;
 }
 
 /***************************************************************************//**
  * @brief
- * Compute frame CRC
+ * Add a register to the poll schedule
  *
- * @param[in]	data		framedParameter
- * @return		crc
+ * @note
+ * A register close to a block on the same rate joins that block, so one
+ * request reads both. The schedule starts again from the top.
  *
+ * @param[in]		u8Every					Read every n passes of the schedule
+ * @param[in]		u16Register				Register address, in the cache window
+ * @return			0 = added\n
+ *					-1 = register not cached or rate of 0\n
+ *					-2 = no blocks left
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.005
  */
-Luint16 vFCU_ASI__ComputeCRC(Luint8* data, Luint16 dataLen)
+Lint16 s16FCU_ASI__Schedule_Add(Luint16 u16Register, Luint8 u8Every)
 {
-	Luint16 crc = 0xffff;
-	Luint16 tempCRC;
-	Luint8 tempLSB, flag;
-	Lint8 byteIndex, bitIndex;
+	Lint16 s16Return;
+	Luint8 u8Index;
+	Luint8 u8Found;
+	Luint16 u16End;
+	Luint16 u16Gap;
+	struct _strASIPollBlock *pBlock;
 
-	if (data)
+	if((u16Register < (Luint16)C_FCU_ASI__CACHE_BASE) || (u16Register >= (Luint16)(C_FCU_ASI__CACHE_BASE + C_FCU_ASI__CACHE_SIZE)) || (u8Every == 0U))
+	{
+		s16Return = -1;
+	}
+	else
 	{
-		for (byteIndex = 0; byteIndex < dataLen - 2; byteIndex++)
+		u16Gap = (Luint16)sFCU.sASIComms.sPoll.u8CoalesceGap;
+		u8Found = 0U;
+		u8Index = 0U;
+		while((u8Found == 0U) && (u8Index < sFCU.sASIComms.sPoll.u8NumBlocks))
 		{
-			tempLSB = 0x00FF & crc;
-
-			crc = tempLSB ^ data[byteIndex];
-
-			for (bitIndex= 0; bitIndex < 8; bitIndex++)
+			pBlock = &sFCU.sASIComms.sPoll.sBlock[u8Index];
+			u16End = (Luint16)(pBlock->u16Start + pBlock->u8Count);
+			if((pBlock->u8Every == u8Every) && ((u16Register + u16Gap + 1U) >= pBlock->u16Start) && (u16Register <= (u16End + u16Gap)))
 			{
-				tempCRC = crc;
-				flag = tempCRC & 0x0001;
-				crc = crc >> 1;
-
-				if (flag)
+				if(u16Register < pBlock->u16Start)
 				{
-					crc = crc ^ 0xA001;
+					pBlock->u8Count = (Luint8)(u16End - u16Register);
+					pBlock->u16Start = u16Register;
 				}
+				else if(u16Register >= u16End)
+				{
+					pBlock->u8Count = (Luint8)((u16Register + 1U) - pBlock->u16Start);
+				}
+				else
+				{
+					//already in there
+				}
+				vFCU_ASI__Schedule_Merge(u8Index);
+				u8Found = 1U;
+			}
+			else
+			{
+				u8Index++;
 			}
 		}
+
+		if(u8Found == 1U)
+		{
+			s16Return = 0;
+		}
+		else if(sFCU.sASIComms.sPoll.u8NumBlocks < C_ASI__MAX_POLL_BLOCKS)
+		{
+			pBlock = &sFCU.sASIComms.sPoll.sBlock[sFCU.sASIComms.sPoll.u8NumBlocks];
+			pBlock->u16Start = u16Register;
+			pBlock->u8Count = 1U;
+			pBlock->u8Every = u8Every;
+			sFCU.sASIComms.sPoll.u8NumBlocks++;
+			s16Return = 0;
+		}
+		else
+		{
+			s16Return = -2;
+		}
+
+		sFCU.sASIComms.sPoll.u8Block = 0U;
+		sFCU.sASIComms.sPoll.u8Slave = 0U;
+		sFCU.sASIComms.sPoll.u32Cycle = 0U;
+		sFCU.sASIComms.sPoll.u8NewCycle = 1U;
 	}
-	return crc;
+
+	return s16Return;
 }
 
 /***************************************************************************//**
  * @brief
- * Add CRC to modbus command frame
+ * Latest value of a polled register
  *
-  * @param[in]	data		framedParameter
+ * @param[out]		*pu16Value				The value
+ * @param[in]		u16Register				Register address, in the cache window
+ * @param[in]		u8ASIDevNum				ASI controller (1-8)
+ * @return			0 = good\n
+ *					-1 = bad controller or register\n
+ *					-2 = not read yet
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.006
  */
-void vFCU_ASI__AddCRC(Luint8* data)
+Lint16 s16FCU_ASI__Get_Register(Luint8 u8ASIDevNum, Luint16 u16Register, Luint16 *pu16Value)
 {
-	if (data)
+	Lint16 s16Return;
+	Luint16 u16Index;
+	struct _strASISlave *pSlave;
+
+	if((u8ASIDevNum == 0U) || (u8ASIDevNum > C_ASI__NUM_CONTROLLERS) || (pu16Value == 0) ||
+		(u16Register < (Luint16)C_FCU_ASI__CACHE_BASE) || (u16Register >= (Luint16)(C_FCU_ASI__CACHE_BASE + C_FCU_ASI__CACHE_SIZE)))
 	{
-		Luint16 crc = vFCU_ASI__ComputeCRC(data, C_ASI__RW_FRAME_SIZE);
-		data[6]=(Luint8)(crc & 0x00ff);	// lower crc byte
-		data[7]=(Luint8)(crc >> 8);		// higher crc byte
+		s16Return = -1;
+	}
+	else
+	{
+		pSlave = &sFCU.sASIComms.sSlave[u8ASIDevNum - 1U];
+		u16Index = (Luint16)(u16Register - (Luint16)C_FCU_ASI__CACHE_BASE);
+		if((pSlave->u32Valid & ((Luint32)1U << u16Index)) == 0U)
+		{
+			s16Return = -2;
+		}
+		else
+		{
+			*pu16Value = pSlave->u16Register[u16Index];
+			s16Return = 0;
+		}
 	}
+
+	return s16Return;
 }
 
 /***************************************************************************//**
  * @brief
- * Process reply from ASI device
+ * Modbus CRC16 of a buffer
  *
- * @param[in]	sCmdParams		Command structure with read params
- * @return			-1 = crc error
- * 					0 = success
+ * @note
+ * Over a whole frame with its CRC on the end this gives 0.
+ *
+ * @param[in]		u16Length				Number of bytes
+ * @param[in]		*cpu8Data				The data
+ * @return			The CRC, low byte goes first on the wire
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.007
  */
-Lint8 vFCU_ASI__ProcessReply(void)
+Luint16 u16FCU_ASI__CRC(const Luint8 *cpu8Data, Luint16 u16Length)
 {
-	struct _strASICmd *pTail = &sFCU.sASIComms.cmdQueue[sFCU.sASIComms.qTail];
+	Luint16 u16CRC;
+	Luint16 u16Counter;
 
-	if (vFCU_ASI__CheckCRC(pTail->response, C_ASI__RW_FRAME_SIZE)) {
-		return -1;
+	u16CRC = 0xFFFFU;
+	for(u16Counter = 0U; u16Counter < u16Length; u16Counter++)
+	{
+		u16CRC = (Luint16)((u16CRC >> 8U) ^ sFCU.sASIComms.u16CRCTable[(u16CRC ^ cpu8Data[u16Counter]) & 0x00FFU]);
 	}
-	// check function code in response, if it's error reply, process error
-	if (pTail->response[2] & 0x80)
+
+	return u16CRC;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Time for the last full pass of the poll schedule
+ *
+ * @return			Microseconds, 0 until the second pass has started
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.008
+ */
+Luint32 u32FCU_ASI__Get_Refresh_us(void)
+{
+	return (Luint32)(((Luint64)sFCU.sASIComms.sPoll.u32Refresh_Last * 1000000U) / (Luint64)C_LOCALDEF__LCCM655__ASI_TICKS_PER_SEC);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Build a Modbus read/write register frame
+ *
+ * @param[in]		u16Value				Value to write, or number of registers to read
+ * @param[in]		u16Register				Register address
+ * @param[in]		u8Function				Function code
+ * @param[in]		u8Slave					Modbus address
+ * @param[out]		*pu8Frame				C_ASI__RW_FRAME_SIZE bytes
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.009
+ */
+static void vFCU_ASI__Build_Frame(Luint8 *pu8Frame, Luint8 u8Slave, Luint8 u8Function, Luint16 u16Register, Luint16 u16Value)
+{
+	Luint16 u16CRC;
+
+	pu8Frame[0] = u8Slave;
+	pu8Frame[1] = u8Function;
+	pu8Frame[2] = (Luint8)(u16Register >> 8U);
+	pu8Frame[3] = (Luint8)(u16Register & 0x00FFU);
+	pu8Frame[4] = (Luint8)(u16Value >> 8U);
+	pu8Frame[5] = (Luint8)(u16Value & 0x00FFU);
+
+	u16CRC = u16FCU_ASI__CRC(pu8Frame, C_ASI__RW_FRAME_SIZE - 2U);
+	pu8Frame[6] = (Luint8)(u16CRC & 0x00FFU);
+	pu8Frame[7] = (Luint8)(u16CRC >> 8U);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Build the next request, a queued command if there is one or the next poll
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.010
+ */
+static void vFCU_ASI__Stage_Next(void)
+{
+	struct _strASICmd *pCmd;
+	struct _strASIXfer *pNext;
+	struct _strASIPollBlock *pBlock;
+	Luint32 u32Tries;
+	Luint8 u8Found;
+
+	pNext = &sFCU.sASIComms.sNext;
+
+	if(sFCU.sASIComms.qHead != sFCU.sASIComms.qTail)
 	{
-		vFCU_ASI__ProcessError(pTail);
+		pCmd = &sFCU.sASIComms.cmdQueue[sFCU.sASIComms.qTail];
+
+		memcpy(&pNext->u8Frame[0], &pCmd->framedCmd[0], C_ASI__RW_FRAME_SIZE);
+		pNext->u8Slave = pCmd->u8SlaveAddress;
+		pNext->u8Function = pCmd->fncCode;
+		pNext->u16Register = pCmd->paramAddress;
+		pNext->u16Value = pCmd->paramValue;
+		if(pCmd->fncCode == C_ASI__READ_INPUT_REGISTER)
+		{
+			pNext->u8ReplyLength = (Luint8)(5U + (pCmd->paramValue * 2U));
+		}
+		else
+		{
+			//write single register comes back as an echo
+			pNext->u8ReplyLength = C_ASI__RW_FRAME_SIZE;
+		}
+		pNext->u8Poll = 0U;
+		pNext->u8CycleStart = 0U;
+		pNext->u8Retries = C_ASI__COMMAND_RETRIES;
+		pNext->pDest = pCmd->destVar;
+		pNext->eDestType = pCmd->eDestVarType;
+
+		//pop the command out of the queue, the retries are done from sXfer
+		sFCU.sASIComms.qTail = (Luint8)((sFCU.sASIComms.qTail + 1U) % C_ASI__COMMAND_QUEUE);
+		sFCU.sASIComms.u8NextReady = 1U;
+	}
+	else if(sFCU.sASIComms.sPoll.u8NumBlocks > 0U)
+	{
+		//find the next block due, a pass can have nothing due if every block is slow
+		u8Found = 0U;
+		u32Tries = 0U;
+		while((u8Found == 0U) && (u32Tries < ((Luint32)C_ASI__MAX_POLL_BLOCKS * 256U)))
+		{
+			pBlock = &sFCU.sASIComms.sPoll.sBlock[sFCU.sASIComms.sPoll.u8Block];
+			if((sFCU.sASIComms.sPoll.u32Cycle % pBlock->u8Every) == 0U)
+			{
+				u8Found = 1U;
+			}
+			else
+			{
+				sFCU.sASIComms.sPoll.u8Block++;
+				if(sFCU.sASIComms.sPoll.u8Block >= sFCU.sASIComms.sPoll.u8NumBlocks)
+				{
+					sFCU.sASIComms.sPoll.u8Block = 0U;
+					sFCU.sASIComms.sPoll.u32Cycle++;
+					sFCU.sASIComms.sPoll.u8NewCycle = 1U;
+				}
+				else
+				{
+					//fall on
+				}
+				u32Tries++;
+			}
+		}
+
+		if(u8Found == 1U)
+		{
+			pBlock = &sFCU.sASIComms.sPoll.sBlock[sFCU.sASIComms.sPoll.u8Block];
+
+			pNext->u8Slave = (Luint8)(sFCU.sASIComms.sPoll.u8Slave + 1U);
+			pNext->u8Function = C_ASI__READ_INPUT_REGISTER;
+			pNext->u16Register = pBlock->u16Start;
+			pNext->u16Value = pBlock->u8Count;
+			pNext->u8ReplyLength = (Luint8)(5U + ((Luint16)pBlock->u8Count * 2U));
+			pNext->u8Poll = 1U;
+			pNext->u8CycleStart = sFCU.sASIComms.sPoll.u8NewCycle;
+			pNext->u8Retries = 1U;
+			pNext->pDest = 0;
+			pNext->eDestType = E_UINT16;
+			vFCU_ASI__Build_Frame(&pNext->u8Frame[0], pNext->u8Slave, pNext->u8Function, pNext->u16Register, pNext->u16Value);
+			sFCU.sASIComms.sPoll.u8NewCycle = 0U;
+
+			//same block on every controller, then the next block
+			sFCU.sASIComms.sPoll.u8Slave++;
+			if(sFCU.sASIComms.sPoll.u8Slave >= C_ASI__NUM_CONTROLLERS)
+			{
+				sFCU.sASIComms.sPoll.u8Slave = 0U;
+				sFCU.sASIComms.sPoll.u8Block++;
+				if(sFCU.sASIComms.sPoll.u8Block >= sFCU.sASIComms.sPoll.u8NumBlocks)
+				{
+					sFCU.sASIComms.sPoll.u8Block = 0U;
+					sFCU.sASIComms.sPoll.u32Cycle++;
+					sFCU.sASIComms.sPoll.u8NewCycle = 1U;
+				}
+				else
+				{
+					//fall on
+				}
+			}
+			else
+			{
+				//fall on
+			}
+
+			sFCU.sASIComms.u8NextReady = 1U;
+		}
+		else
+		{
+			//nothing due
+		}
 	}
 	else
 	{
-		vFCU_ASI__SetVar(pTail);
+		//nothing to poll
 	}
-	// TODO: check return slave address vs sent slave address, they should match
-
-	//adjust tail pointer
-	//pop the command out of the queue because it's done being processed
-	sFCU.sASIComms.qTail++;
-	if (sFCU.sASIComms.qTail == C_ASI__RW_FRAME_SIZE)
-		sFCU.sASIComms.qTail=0;	// rollover
 
-	return 0;
 }
 
 /***************************************************************************//**
  * @brief
- * Check CRC from ASI device response
+ * Put a request on the bus
  *
- * @param[in]	rData		Response Data
- * @return			-1 = error
- * 					0 = success
+ * @param[in]		u64Now					Timestamp
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.011
  */
-Lint8 vFCU_ASI__CheckCRC(Luint8* rData, Luint8 dataLen)
+static void vFCU_ASI__Transmit(Luint64 u64Now)
 {
-	unsigned int crc;
+	Luint32 u32Refresh;
+	Luint16 u16Counter;
 
-	if (rData)
+	//anything left in the UART is not a reply to this
+	u16Counter = 0U;
+	while((M_LOCALDEF__LCCM655__ASI_RX_AVAIL() != 0U) && (u16Counter < C_ASI__MAX_FRAME_SIZE))
+	{
+		(void)M_LOCALDEF__LCCM655__ASI_RX_BYTE();
+		sFCU.sASIComms.sRx.u32Stray++;
+		u16Counter++;
+	}
+
+	if(sFCU.sASIComms.u8Resend == 1U)
+	{
+		sFCU.sASIComms.u8Resend = 0U;
+	}
+	else
 	{
-		crc = vFCU_ASI__ComputeCRC(rData, dataLen);
+		sFCU.sASIComms.sXfer = sFCU.sASIComms.sNext;
+		sFCU.sASIComms.u8NextReady = 0U;
 
-		if ( ( (rData[dataLen + 1]) != (crc >> 8) ) || ( (rData[dataLen]) != (crc & 0x00FF) ) ) {
-			return -1;
+		if(sFCU.sASIComms.sXfer.u8CycleStart == 1U)
+		{
+			if(sFCU.sASIComms.sPoll.u32Cycles > 0U)
+			{
+				u32Refresh = (Luint32)(u64Now - sFCU.sASIComms.sPoll.u64CycleStart);
+				sFCU.sASIComms.sPoll.u32Refresh_Last = u32Refresh;
+				if(u32Refresh > sFCU.sASIComms.sPoll.u32Refresh_Max)
+				{
+					sFCU.sASIComms.sPoll.u32Refresh_Max = u32Refresh;
+				}
+				else
+				{
+					//fall on
+				}
+			}
+			else
+			{
+				//first pass
+			}
+			sFCU.sASIComms.sPoll.u64CycleStart = u64Now;
+			sFCU.sASIComms.sPoll.u32Cycles++;
 		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	if((sFCU.sASIComms.sXfer.u8Slave > 0U) && (sFCU.sASIComms.sXfer.u8Slave <= C_ASI__NUM_CONTROLLERS))
+	{
+		sFCU.sASIComms.sSlave[sFCU.sASIComms.sXfer.u8Slave - 1U].u32Requests++;
 	}
 	else
-		return -1;
+	{
+		//broadcast or not one of ours
+	}
 
-	return 0;
-}
+	//whole frame into the FIFO in one go
+	M_LOCALDEF__LCCM655__ASI_TX(&sFCU.sASIComms.sXfer.u8Frame[0], C_ASI__RW_FRAME_SIZE);
+	sFCU.sASIComms.u64TxEnd = u64Now + ((Luint64)sFCU.sASIComms.u32CharTicks * C_ASI__RW_FRAME_SIZE);
+	sFCU.sASIComms.sRx.u8Length = 0U;
+
+	if(sFCU.sASIComms.sXfer.u8Slave == 0U)
+	{
+		sFCU.sASIComms.u64Deadline = sFCU.sASIComms.u64TxEnd + sFCU.sASIComms.u32TurnaroundTicks;
+		sFCU.sASIComms.eMbState = ASI_COMM_STATE__BROADCAST_EMISSION;
+	}
+	else
+	{
+		sFCU.sASIComms.u64Deadline = sFCU.sASIComms.u64TxEnd;
+		sFCU.sASIComms.eMbState = ASI_COMM_STATE__UNICAST_EMISSION;
+	}
 
+}
 
 /***************************************************************************//**
  * @brief
- * Set variable with response from ASI device
+ * Collect the reply
+ *
+ * @note
+ * The length of a good reply is known from the request, so there is no need
+ * to wait out the gap to find the end of the frame.
  *
- * @param[in]	pTail		Command being processed in command queue
+ * @param[in]		u64Now					Timestamp
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.012
  */
-void vFCU_ASI__SetVar(struct _strASICmd *pTail)
+static void vFCU_ASI__Receive(Luint64 u64Now)
 {
-	if (pTail && pTail->destVar)
+	Luint8 u8Expect;
+
+	while((M_LOCALDEF__LCCM655__ASI_RX_AVAIL() != 0U) && (sFCU.sASIComms.sRx.u8Length < (C_ASI__MAX_FRAME_SIZE - 1U)))
+	{
+		sFCU.sASIComms.sRx.u8Frame[sFCU.sASIComms.sRx.u8Length] = M_LOCALDEF__LCCM655__ASI_RX_BYTE();
+		sFCU.sASIComms.sRx.u8Length++;
+		sFCU.sASIComms.u64LastRx = u64Now;
+	}
+
+	if((sFCU.sASIComms.sRx.u8Length >= 2U) && ((sFCU.sASIComms.sRx.u8Frame[1] & C_ASI__EXCEPTION_FLAG) != 0U))
 	{
-		switch(pTail->eDestVarType)
+		//slave address, function, exception code, CRC
+		u8Expect = 5U;
+	}
+	else
+	{
+		u8Expect = sFCU.sASIComms.sXfer.u8ReplyLength;
+	}
+
+	if(sFCU.sASIComms.sRx.u8Length >= u8Expect)
+	{
+		sFCU.sASIComms.eMbState = ASI_COMM_STATE__CONTROL_AND_WAIT;
+	}
+	else if(sFCU.sASIComms.sRx.u8Length == 0U)
+	{
+		if(u64Now >= sFCU.sASIComms.u64Deadline)
 		{
-			case E_INT8:
-				*((Lint8*)pTail->destVar) = (Lint8)(pTail->response[4]);
-				break;
-			case E_UINT8:
-				*((Luint8*)pTail->destVar) = (Luint8)(pTail->response[4]);
-				break;
-			case E_INT16:
-				*((Lint16*)pTail->destVar) = (Lint16)(((Luint16)pTail->response[3] << 8) | pTail->response[4]);
-				break;
-			case E_UINT16:
-				*((Luint16*)pTail->destVar) = ((Luint16)pTail->response[3] << 8) | pTail->response[4];
-				break;
+			vFCU_ASI__Fail(u64Now, 1U);
+		}
+		else
+		{
+			//still waiting on the slave
 		}
 	}
-}
+	else if(u64Now >= (sFCU.sASIComms.u64LastRx + sFCU.sASIComms.u32GapTicks))
+	{
+		//the frame stopped short
+		vFCU_ASI__Fail(u64Now, 0U);
+	}
+	else
+	{
+		//more on the way
+	}
 
+}
 
 /***************************************************************************//**
  * @brief
- * Process error from ASI device
+ * Check the reply and put the data where it goes
  *
- * @param[in]	pTail		Command being processed in command queue
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.013
  */
-void vFCU_ASI__ProcessError(struct _strASICmd *pTail)
+static void vFCU_ASI__Complete(void)
 {
-	if (pTail)
+	struct _strASIXfer *pXfer;
+	struct _strASISlave *pSlave;
+	const Luint8 *cpu8Frame;
+	Luint32 u32Latency;
+	Luint16 u16Value;
+	Luint16 u16Index;
+	Luint16 u16Counter;
+
+	pXfer = &sFCU.sASIComms.sXfer;
+	cpu8Frame = &sFCU.sASIComms.sRx.u8Frame[0];
+
+	if((u16FCU_ASI__CRC(cpu8Frame, sFCU.sASIComms.sRx.u8Length) != 0U) || (cpu8Frame[0] != pXfer->u8Slave) ||
+		(((cpu8Frame[1] & (Luint8)(~C_ASI__EXCEPTION_FLAG)) != pXfer->u8Function)))
 	{
-		// TODO: log exception code: pTail->response[2];
+		vFCU_ASI__Fail(sFCU.sASIComms.u64LastRx, 0U);
 	}
-}
+	else
+	{
+		if((pXfer->u8Slave > 0U) && (pXfer->u8Slave <= C_ASI__NUM_CONTROLLERS))
+		{
+			pSlave = &sFCU.sASIComms.sSlave[pXfer->u8Slave - 1U];
+			if((cpu8Frame[1] & C_ASI__EXCEPTION_FLAG) != 0U)
+			{
+				pSlave->u32Exceptions++;
+				pSlave->u8LastException = cpu8Frame[2];
+			}
+			else
+			{
+				pSlave->u32Replies++;
+				pSlave->u64LastReply = sFCU.sASIComms.u64LastRx;
 
+				u32Latency = (Luint32)(sFCU.sASIComms.u64LastRx - sFCU.sASIComms.u64TxEnd);
+				pSlave->u32Latency_Last = u32Latency;
+				if(u32Latency < pSlave->u32Latency_Min)
+				{
+					pSlave->u32Latency_Min = u32Latency;
+				}
+				else
+				{
+					//fall on
+				}
+				if(u32Latency > pSlave->u32Latency_Max)
+				{
+					pSlave->u32Latency_Max = u32Latency;
+				}
+				else
+				{
+					//fall on
+				}
+
+				if((pXfer->u8Function == C_ASI__READ_INPUT_REGISTER) && ((Luint16)cpu8Frame[2] == (pXfer->u16Value * 2U)))
+				{
+					for(u16Counter = 0U; u16Counter < pXfer->u16Value; u16Counter++)
+					{
+						u16Value = (Luint16)(((Luint16)cpu8Frame[3U + (u16Counter * 2U)] << 8U) | (Luint16)cpu8Frame[4U + (u16Counter * 2U)]);
+						u16Index = (Luint16)((pXfer->u16Register + u16Counter) - (Luint16)C_FCU_ASI__CACHE_BASE);
+						if(((pXfer->u16Register + u16Counter) >= (Luint16)C_FCU_ASI__CACHE_BASE) && (u16Index < C_FCU_ASI__CACHE_SIZE))
+						{
+							pSlave->u16Register[u16Index] = u16Value;
+							pSlave->u32Valid |= ((Luint32)1U << u16Index);
+						}
+						else
+						{
+							//not one we keep
+						}
+						if(u16Counter == 0U)
+						{
+							vFCU_ASI__SetVar(pXfer, u16Value);
+						}
+						else
+						{
+							//fall on
+						}
+					}
+				}
+				else
+				{
+					//write echo, nothing to keep
+				}
+			}
+		}
+		else
+		{
+			//not one of ours, but it answered
+		}
+
+		//reply processed inside the gap
+		sFCU.sASIComms.u64BusFree = sFCU.sASIComms.u64LastRx + sFCU.sASIComms.u32GapTicks;
+		sFCU.sASIComms.eMbState = ASI_COMM_STATE__IDLE;
+	}
+
+}
 
 /***************************************************************************//**
  * @brief
- * Build RTU packet for each byte and transmit using lower level driver
+ * No reply or a bad one, count it and retry a command
  *
- * @param[in]	pByte		Byte to transmit
+ * @param[in]		u8Timeout				1 = nothing came back, 0 = bad frame
+ * @param[in]		u64Now					Time the bus went quiet
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.014
  */
-void vFCU_ASI__RTU_Tx_Byte(Luint8* pByte)
+static void vFCU_ASI__Fail(Luint64 u64Now, Luint8 u8Timeout)
 {
-	// TODO
-	// need to format byte as in p12 of Modbus over serial line documentation
-	// 11 bits per byte: add parity checking bit, start bit and stop bit
-	// start, 1, 2, 3, 4, 5, 6, 7, 8, parity, stop
-	// then call lower level driver function to transmit each bit
-	//
+	struct _strASIXfer *pXfer;
+
+	pXfer = &sFCU.sASIComms.sXfer;
+
+	if((pXfer->u8Slave > 0U) && (pXfer->u8Slave <= C_ASI__NUM_CONTROLLERS))
+	{
+		if(u8Timeout == 1U)
+		{
+			sFCU.sASIComms.sSlave[pXfer->u8Slave - 1U].u32Timeouts++;
+		}
+		else
+		{
+			sFCU.sASIComms.sSlave[pXfer->u8Slave - 1U].u32CRCErrors++;
+		}
+	}
+	else
+	{
+		//fall on
+	}
+
+	//a missed poll is picked up next pass, a command goes again
+	if(pXfer->u8Poll == 0U)
+	{
+		if(pXfer->u8Retries > 1U)
+		{
+			pXfer->u8Retries--;
+			sFCU.sASIComms.u8Resend = 1U;
+		}
+		else
+		{
+			sFCU.sASIComms.u32CommandsDropped++;
+		}
+	}
+	else
+	{
+		//fall on
+	}
+
+	sFCU.sASIComms.u64BusFree = u64Now + sFCU.sASIComms.u32GapTicks;
+	sFCU.sASIComms.eMbState = ASI_COMM_STATE__IDLE;
 }
 
 /***************************************************************************//**
  * @brief
- * Receive RTU packet using lower level drive extract data byte
+ * Set variable with response from ASI device
  *
- * @param[in]	pByte		Byte to receive
+ * @param[in]	u16Value		First register of the reply
+ * @param[in]	pXfer			Command just completed
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.015
  */
-void vFCU_ASI__RTU_Rx_Byte(Luint8* pByte)
+static void vFCU_ASI__SetVar(const struct _strASIXfer *pXfer, Luint16 u16Value)
 {
-	// TODO
-	// call lower level driver function to receive rtu packet
-	// need to extract byte as in p12 of Modbus over serial line documentation
-	// 11 bits in packet: remove parity checking bit, start bit and stop bit
-	// start, 1, 2, 3, 4, 5, 6, 7, 8, parity, stop
-
+	if(pXfer->pDest != 0)
+	{
+		switch(pXfer->eDestType)
+		{
+			case E_INT8:
+				*((Lint8*)pXfer->pDest) = (Lint8)(u16Value & 0x00FFU);
+				break;
+			case E_UINT8:
+				*((Luint8*)pXfer->pDest) = (Luint8)(u16Value & 0x00FFU);
+				break;
+			case E_INT16:
+				*((Lint16*)pXfer->pDest) = (Lint16)u16Value;
+				break;
+			case E_UINT16:
+				*((Luint16*)pXfer->pDest) = u16Value;
+				break;
+			default:
+				//only single registers
+				break;
+		}
+	}
+	else
+	{
+		//poll, the cache has it
+	}
 }
 
 /***************************************************************************//**
  * @brief
- * Check and see if we have a rtu packet to receive from a slave
+ * Join any blocks on the same rate that a grown block now reaches
  *
- * @return			1 = yes
- * 					0 = no
+ * @param[in]		u8Index					The block that grew
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.043.FUNC.016
  */
-Luint8 vFCU_ASI__RTU_RxIsReady(void)
+static void vFCU_ASI__Schedule_Merge(Luint8 u8Index)
 {
-	Luint8 isReady=0;
+	struct _strASIPollBlock *pBlock;
+	struct _strASIPollBlock *pOther;
+	Luint16 u16Start;
+	Luint16 u16End;
+	Luint16 u16OtherEnd;
+	Luint16 u16Gap;
+	Luint8 u8Other;
+	Luint8 u8Move;
 
-	// TODO
-	// call lower level driver function to figure this out
+	pBlock = &sFCU.sASIComms.sPoll.sBlock[u8Index];
+	u16Gap = (Luint16)sFCU.sASIComms.sPoll.u8CoalesceGap;
+	u8Other = 0U;
+	while(u8Other < sFCU.sASIComms.sPoll.u8NumBlocks)
+	{
+		pOther = &sFCU.sASIComms.sPoll.sBlock[u8Other];
+		u16End = (Luint16)(pBlock->u16Start + pBlock->u8Count);
+		u16OtherEnd = (Luint16)(pOther->u16Start + pOther->u8Count);
+		if((u8Other != u8Index) && (pOther->u8Every == pBlock->u8Every) &&
+			((u16OtherEnd + u16Gap) >= pBlock->u16Start) && (pOther->u16Start <= (u16End + u16Gap)))
+		{
+			if(pOther->u16Start < pBlock->u16Start)
+			{
+				u16Start = pOther->u16Start;
+			}
+			else
+			{
+				u16Start = pBlock->u16Start;
+			}
+			if(u16OtherEnd > u16End)
+			{
+				u16End = u16OtherEnd;
+			}
+			else
+			{
+				//fall on
+			}
+			pBlock->u16Start = u16Start;
+			pBlock->u8Count = (Luint8)(u16End - u16Start);
+
+			//close up the list
+			for(u8Move = u8Other; u8Move < (sFCU.sASIComms.sPoll.u8NumBlocks - 1U); u8Move++)
+			{
+				sFCU.sASIComms.sPoll.sBlock[u8Move] = sFCU.sASIComms.sPoll.sBlock[u8Move + 1U];
+			}
+			sFCU.sASIComms.sPoll.u8NumBlocks--;
+			if(u8Other < u8Index)
+			{
+				u8Index--;
+				pBlock = &sFCU.sASIComms.sPoll.sBlock[u8Index];
+			}
+			else
+			{
+				//fall on
+			}
+
+			//the bigger block may reach one already passed
+			u8Other = 0U;
+		}
+		else
+		{
+			u8Other++;
+		}
+	}
 
-	return isReady;
 }
 
 #endif //C_LOCALDEF__LCCM655__ENABLE_ASI_RS485
@@ -466,4 +1039,3 @@ Luint8 vFCU_ASI__RTU_RxIsReady(void)
 /** @} */
 /** @} */
 /** @} */
-
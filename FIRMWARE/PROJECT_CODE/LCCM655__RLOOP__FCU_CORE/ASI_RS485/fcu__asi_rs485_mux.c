@@ -29,7 +29,9 @@ void vFCU_ASI_MUX__Init(void)
 {
 
 	//init the MCP23S17
+#ifndef WIN32
 	vMCP23S17__Init(0U);
+#endif
 
 }
 
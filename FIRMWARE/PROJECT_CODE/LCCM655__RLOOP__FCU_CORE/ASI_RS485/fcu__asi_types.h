@@ -32,11 +32,86 @@
 			Luint16 paramAddress;
 			Luint16 paramValue;		// for reading, this is num of registers to read, set to 1
 			Luint8 framedCmd[C_ASI__RW_FRAME_SIZE];
-			Luint8 response[C_ASI__RW_FRAME_SIZE];	// assuming we always read only one register
 			void* destVar;
 			E_VAR_TYPE eDestVarType;
 		};
 
+		/** One transaction on the bus, either a queued command or a poll */
+		struct _strASIXfer
+		{
+			/** The request, with CRC */
+			Luint8 u8Frame[C_ASI__RW_FRAME_SIZE];
+
+			/** Modbus address, 0 = broadcast */
+			Luint8 u8Slave;
+
+			/** Function code */
+			Luint8 u8Function;
+
+			/** First register */
+			Luint16 u16Register;
+
+			/** Registers read, or the value written */
+			Luint16 u16Value;
+
+			/** Length of a good reply */
+			Luint8 u8ReplyLength;
+
+			/** 1 = from the poll schedule, 0 = from the command queue */
+			Luint8 u8Poll;
+
+			/** 1 = first poll of a schedule cycle */
+			Luint8 u8CycleStart;
+
+			/** Sends left before a command is dropped */
+			Luint8 u8Retries;
+
+			/** Where a command read goes */
+			void *pDest;
+			E_VAR_TYPE eDestType;
+		};
+
+		/** Consecutive registers read in one request */
+		struct _strASIPollBlock
+		{
+			/** First register */
+			Luint16 u16Start;
+
+			/** Number of registers */
+			Luint8 u8Count;
+
+			/** Read every n schedule cycles */
+			Luint8 u8Every;
+		};
+
+		/** Per controller telemetry and link statistics */
+		struct _strASISlave
+		{
+			/** Latest register values from C_FCU_ASI__CACHE_BASE */
+			Luint16 u16Register[C_FCU_ASI__CACHE_SIZE];
+
+			/** Bit n set once register n of the cache has been read */
+			Luint32 u32Valid;
+
+			/** Time of the last good reply */
+			Luint64 u64LastReply;
+
+			/** Requests sent, good replies, and the failures */
+			Luint32 u32Requests;
+			Luint32 u32Replies;
+			Luint32 u32Timeouts;
+			Luint32 u32CRCErrors;
+			Luint32 u32Exceptions;
+
+			/** Last exception code */
+			Luint8 u8LastException;
+
+			/** End of request to end of reply, timer ticks */
+			Luint32 u32Latency_Last;
+			Luint32 u32Latency_Min;
+			Luint32 u32Latency_Max;
+		};
+
 		/** ASI controller modbus read register response structure */
 		struct _strASIReply
 		{
@@ -80,6 +80,9 @@ void vFCU_BRAKES__Process(void)
 	//process the stepper driver if its active
 	vSTEPDRIVE__Process();
 
+	//keep the move planner going
+	vFCU_BRAKES_STEP__Process();
+
 	switch(sFCU.eBrakeStates)
 	{
 
@@ -110,7 +113,18 @@ void vFCU_BRAKES__Process(void)
 
 
 			//check to see if the curent move task is done.
+		#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+			if(u8SCURVE__Get_Busy() == 0U)
+			{
+				u8Test = 1U;
+			}
+			else
+			{
+				u8Test = 0U;
+			}
+		#else
 			u8Test = u8STEPDRIVE__Get_TaskComplete();
+		#endif
 			if(u8Test == 0U)
 			{
 				//stay in state
@@ -51,7 +51,7 @@ void vFCU_BRAKES_MLP__Init(void)
 	{
 
 		//setup the fault flags
-		vFAULTTREE__Init(&sFCU.sBrakes[u8Counter].sFaultFlags);
+		vFAULTLINK__Init(&sFCU.sBrakes[u8Counter].sFaultFlags);
 
 		//clear the current ADC sample
 		sFCU.sBrakes[u8Counter].sMLP.u16ADC_Sample = 0U;
@@ -74,6 +74,13 @@ void vFCU_BRAKES_MLP__Init(void)
 		//set higest mlp value to 0
 		sFCU.sBrakes[u8Counter].sMLP.highest_value = 0U;
 
+		#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+			//setup the filter on its window
+			vSTREAMFILT_MAVG__Init_U16(&sFCU.sBrakes[u8Counter].sMLP.sFilter, &sFCU.sBrakes[u8Counter].sMLP.u16AverageArray[0], C_MLP__MAX_AVERAGE_SIZE);
+		#else
+			sFCU.sBrakes[u8Counter].sMLP.u16AverageCounter = 0U;
+		#endif
+
 		#if C_LOCALDEF__LCCM655__ENABLE_DEBUG_BRAKES == 1U
 			//debug only
 			sFCU.sBrakes[(Luint32)u8Counter].sMLP.zero_count = 0U;
@@ -85,49 +92,49 @@ void vFCU_BRAKES_MLP__Init(void)
 	}
 
 	//check the CRC
-	u8Test = u8EEPARAM_CRC__Is_CRC_OK(	C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKES_HEADER,
+	u8Test = u8PARAMSHADOW__Is_CRC_OK(	C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKES_HEADER,
 										C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE1_SPAN,
 										C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKES_CRC);
 	if(u8Test == 1U)
 	{
 		//valid
-		sFCU.sBrakes[0].sMLP.u16ADC_Zero = u16EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE0_ZERO);
-		sFCU.sBrakes[1].sMLP.u16ADC_Zero = u16EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE1_ZERO);
+		sFCU.sBrakes[0].sMLP.u16ADC_Zero = (Luint16)u32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE0_ZERO);
+		sFCU.sBrakes[1].sMLP.u16ADC_Zero = (Luint16)u32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE1_ZERO);
 
-		sFCU.sBrakes[0].sMLP.f32SystemSpan = f32EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE0_SPAN);
-		sFCU.sBrakes[1].sMLP.f32SystemSpan = f32EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE1_SPAN);
+		sFCU.sBrakes[0].sMLP.f32SystemSpan = f32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE0_SPAN);
+		sFCU.sBrakes[1].sMLP.f32SystemSpan = f32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE1_SPAN);
 
 	}//if(u8Test == 1U)
 	else
 	{
 		//CRC is invalid
 		//rewrite.
-		vEEPARAM__WriteU32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKES_HEADER, 0xAABBCCDD, 1U);
+		vPARAMSHADOW__WriteU32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKES_HEADER, 0xAABBCCDD);
 
 		//save the zero
-		vEEPARAM__WriteU16(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE0_ZERO, 0U, 1U);
-		vEEPARAM__WriteU16(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE1_ZERO, 0U, 1U);
+		vPARAMSHADOW__WriteU32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE0_ZERO, 0U);
+		vPARAMSHADOW__WriteU32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE1_ZERO, 0U);
 
 		//do the span
-		vEEPARAM__WriteF32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE0_SPAN, 1.0F, 1U);
-		vEEPARAM__WriteF32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE1_SPAN, 1.0F, 0U);
+		vPARAMSHADOW__WriteF32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE0_SPAN, 1.0F);
+		vPARAMSHADOW__WriteF32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE1_SPAN, 1.0F);
 
 		//redo the CRC;
-		vEEPARAM_CRC__Calculate_And_Store_CRC(	C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKES_HEADER,
+		vPARAMSHADOW__Store_CRC(	C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKES_HEADER,
 												C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE1_SPAN,
 												C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKES_CRC);
 
 		//1. Reload the structures.
-		sFCU.sBrakes[0].sMLP.u16ADC_Zero = u16EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE0_ZERO);
-		sFCU.sBrakes[1].sMLP.u16ADC_Zero = u16EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE1_ZERO);
-		sFCU.sBrakes[0].sMLP.f32SystemSpan = f32EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE0_SPAN);
-		sFCU.sBrakes[1].sMLP.f32SystemSpan = f32EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE1_SPAN);
+		sFCU.sBrakes[0].sMLP.u16ADC_Zero = (Luint16)u32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE0_ZERO);
+		sFCU.sBrakes[1].sMLP.u16ADC_Zero = (Luint16)u32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE1_ZERO);
+		sFCU.sBrakes[0].sMLP.f32SystemSpan = f32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE0_SPAN);
+		sFCU.sBrakes[1].sMLP.f32SystemSpan = f32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__BRAKE1_SPAN);
 
 		//set the flags for a general fault and cal data reload fault.
-		vFAULTTREE__Set_Flag(&sFCU.sBrakes[0].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__00);
-		vFAULTTREE__Set_Flag(&sFCU.sBrakes[0].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__03);
-		vFAULTTREE__Set_Flag(&sFCU.sBrakes[1].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__00);
-		vFAULTTREE__Set_Flag(&sFCU.sBrakes[1].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__03);
+		vFAULTLINK__Set_Flag(&sFCU.sBrakes[0].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__00);
+		vFAULTLINK__Set_Flag(&sFCU.sBrakes[0].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__03);
+		vFAULTLINK__Set_Flag(&sFCU.sBrakes[1].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__00);
+		vFAULTLINK__Set_Flag(&sFCU.sBrakes[1].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__03);
 
 
 
@@ -324,10 +331,14 @@ Lint16 s16FCU_BRAKES_MLP__Filter_ADC_Value(E_FCU__BRAKE_INDEX_T eBrake)
 {
 	Lint16 s16Return;
 
-	s16Return = u16NUMERICAL_FILTERING__Add_U16(	sFCU.sBrakes[(Luint32)eBrake].sMLP.u16ADC_Sample,
-												&sFCU.sBrakes[(Luint32)eBrake].sMLP.u16AverageCounter,
-												C_MLP__MAX_AVERAGE_SIZE,
-												&sFCU.sBrakes[(Luint32)eBrake].sMLP.u16AverageArray[0]);
+	#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+		s16Return = (Lint16)u16STREAMFILT_MAVG__Add_U16(&sFCU.sBrakes[(Luint32)eBrake].sMLP.sFilter, sFCU.sBrakes[(Luint32)eBrake].sMLP.u16ADC_Sample);
+	#else
+		s16Return = u16NUMERICAL_FILTERING__Add_U16(	sFCU.sBrakes[(Luint32)eBrake].sMLP.u16ADC_Sample,
+													&sFCU.sBrakes[(Luint32)eBrake].sMLP.u16AverageCounter,
+													C_MLP__MAX_AVERAGE_SIZE,
+													&sFCU.sBrakes[(Luint32)eBrake].sMLP.u16AverageArray[0]);
+	#endif
 
 	return s16Return;
 }
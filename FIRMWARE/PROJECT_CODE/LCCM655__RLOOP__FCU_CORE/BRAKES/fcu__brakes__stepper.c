@@ -42,46 +42,53 @@ void vFCU_BRAKES_STEP__Init(void)
 
 	//reload the memory
 	//check the CRC
-	u8Test = u8EEPARAM_CRC__Is_CRC_OK(	C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_VELOC,
+	u8Test = u8PARAMSHADOW__Is_CRC_OK(	C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_VELOC,
 										C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP1_ACCEL,
 										C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP_CRC);
 	if(u8Test == 1U)
 	{
 		//valid
-		sFCU.sBrakes[0].sMove.s32LinearVeloc = s32EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_VELOC);
-		sFCU.sBrakes[0].sMove.s32LinearAccel = s32EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_ACCEL);
-		sFCU.sBrakes[1].sMove.s32LinearVeloc = s32EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP1_VELOC);
-		sFCU.sBrakes[1].sMove.s32LinearAccel = s32EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP1_ACCEL);
+		sFCU.sBrakes[0].sMove.s32LinearVeloc = s32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_VELOC);
+		sFCU.sBrakes[0].sMove.s32LinearAccel = s32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_ACCEL);
+		sFCU.sBrakes[1].sMove.s32LinearVeloc = s32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP1_VELOC);
+		sFCU.sBrakes[1].sMove.s32LinearAccel = s32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP1_ACCEL);
 
 	}//if(u8Test == 1U)
 	else
 	{
 		//CRC is invalid
-		vEEPARAM__WriteS32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_VELOC, 100U, 1U);
-		vEEPARAM__WriteS32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_ACCEL, 100U, 1U);
-		vEEPARAM__WriteS32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP1_VELOC, 100U, 1U);
-		vEEPARAM__WriteS32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP1_ACCEL, 100U, 0U);
+		vPARAMSHADOW__WriteS32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_VELOC, 100);
+		vPARAMSHADOW__WriteS32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_ACCEL, 100);
+		vPARAMSHADOW__WriteS32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP1_VELOC, 100);
+		vPARAMSHADOW__WriteS32(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP1_ACCEL, 100);
 
 		//redo the CRC;
-		vEEPARAM_CRC__Calculate_And_Store_CRC(	C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_VELOC,
+		vPARAMSHADOW__Store_CRC(	C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_VELOC,
 												C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP1_ACCEL,
 												C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP_CRC);
 
 		//1. Reload the structures.
-		sFCU.sBrakes[0].sMove.s32LinearVeloc = s32EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_VELOC);
-		sFCU.sBrakes[0].sMove.s32LinearAccel = s32EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_ACCEL);
-		sFCU.sBrakes[1].sMove.s32LinearVeloc = s32EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP1_VELOC);
-		sFCU.sBrakes[1].sMove.s32LinearAccel = s32EEPARAM__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP1_ACCEL);
+		sFCU.sBrakes[0].sMove.s32LinearVeloc = s32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_VELOC);
+		sFCU.sBrakes[0].sMove.s32LinearAccel = s32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP0_ACCEL);
+		sFCU.sBrakes[1].sMove.s32LinearVeloc = s32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP1_VELOC);
+		sFCU.sBrakes[1].sMove.s32LinearAccel = s32PARAMSHADOW__Read(C_LOCALDEF__LCCM655__EEPROM_OFFSET__STEP1_ACCEL);
 
 		//set the flags for a general fault and cal data reload fault.
-		vFAULTTREE__Set_Flag(&sFCU.sBrakes[0].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__00);
-		vFAULTTREE__Set_Flag(&sFCU.sBrakes[0].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__03);
-		vFAULTTREE__Set_Flag(&sFCU.sBrakes[1].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__00);
-		vFAULTTREE__Set_Flag(&sFCU.sBrakes[1].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__03);
+		vFAULTLINK__Set_Flag(&sFCU.sBrakes[0].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__00);
+		vFAULTLINK__Set_Flag(&sFCU.sBrakes[0].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__03);
+		vFAULTLINK__Set_Flag(&sFCU.sBrakes[1].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__00);
+		vFAULTLINK__Set_Flag(&sFCU.sBrakes[1].sFaultFlags, C_LCCM655__BRAKES__FAULT_INDEX__03);
 
 
 	}//else if(u8Test == 1U)
 
+#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+	//S-curve planner, same veloc and accel with the jerk from the accel
+	vSCURVE__Init();
+	vSCURVE__Set_Limits(0U, sFCU.sBrakes[0].sMove.s32LinearVeloc, sFCU.sBrakes[0].sMove.s32LinearAccel, sFCU.sBrakes[0].sMove.s32LinearAccel * C_FCU__BRAKES__STEP_JERK_RATIO);
+	vSCURVE__Set_Limits(1U, sFCU.sBrakes[1].sMove.s32LinearVeloc, sFCU.sBrakes[1].sMove.s32LinearAccel, sFCU.sBrakes[1].sMove.s32LinearAccel * C_FCU__BRAKES__STEP_JERK_RATIO);
+#endif
+
 }
 
 /***************************************************************************//**
@@ -93,13 +100,20 @@ void vFCU_BRAKES_STEP__Init(void)
  */
 void vFCU_BRAKES_STEP__Process(void)
 {
-
+#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+	//replans and move complete
+	vSCURVE__Process();
+#endif
 
 }
 
 /***************************************************************************//**
  * @brief
  * Returns the current position of the lead screw for the brakes
+ *
+ * @note
+ * With the S-curve planner the steps are counted there, LCCM231 does not see
+ * them, so the position has to come from the planner.
  * 
  * @param[in]		eBrake		## Desc ##
  * @st_funcMD5		3BF5E1F91C16F1F30165C47A35510773
@@ -107,13 +121,25 @@ void vFCU_BRAKES_STEP__Process(void)
  */
 Lint32 s32FCU_BRAKES__Get_CurrentPos(E_FCU__BRAKE_INDEX_T eBrake)
 {
-	return s32STEPDRIVE_POSITION__Get_Position((Luint8)eBrake);
+	Lint32 s32Return;
+
+#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+	s32Return = s32SCURVE__Get_Position((Luint8)eBrake);
+#else
+	s32Return = s32STEPDRIVE_POSITION__Get_Position((Luint8)eBrake);
+#endif
+
+	return s32Return;
 }
 
 
 /***************************************************************************//**
  * @brief
  * Move the brakes as a pair to a position based on the lead screw distance
+ *
+ * @note
+ * With the S-curve planner both screws are planned to arrive on the same tick
+ * and a new call during a move replans it from where the screws are.
  * 
  * @param[in]		s32Brake1Pos		## Desc ##
  * @param[in]		s32Brake0Pos		## Desc ##
@@ -150,18 +176,50 @@ void vFCU_BRAKES_STEP__Move(Lint32 s32Brake0Pos, Lint32 s32Brake1Pos)
 	//just a dummy task ID
 	u32TaskID = 1U;
 
+	sFCU.sBrakes[0].sMove.s32MoveToPos = s32Brake0Pos;
+	sFCU.sBrakes[1].sMove.s32MoveToPos = s32Brake1Pos;
+
+#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+	//limits can change between moves, the jerk follows the accel
+	vSCURVE__Set_Limits(0U, s32Velocity[0], s32Accel[0], s32Accel[0] * C_FCU__BRAKES__STEP_JERK_RATIO);
+	vSCURVE__Set_Limits(1U, s32Velocity[1], s32Accel[1], s32Accel[1] * C_FCU__BRAKES__STEP_JERK_RATIO);
+
+	//the step tables are built here, the ISR starts on its next tick
+	s16Return = s16SCURVE__Move(&s32Pos[0], u32TaskID);
+#else
 	//clear the prev task if needed.
 	vSTEPDRIVE__Clear_TaskComplete();
 
 	//command the stepper to actual position, it will start moving based on timer interrupts
 	//it is OK to do address of near here because we copy into the move planner in this call.
 	s16Return = s16STEPDRIVE_POSITION__Set_Position(&s32Pos[0], &s32Velocity[0], &s32Accel[0], u32TaskID);
+#endif
 
 	//check the return to see if we were able to move.
 
 
 }
 
+/***************************************************************************//**
+ * @brief
+ * Stepper timebase, from RTI compare 2
+ *
+ * @note
+ * The board file points the RTI here so it does not have to know which step
+ * engine is built in. The limit switch ISRs abort the same engine.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.025.FUNC.005
+ */
+void vFCU_BRAKES_STEP__Timebase_ISR(void)
+{
+#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+	vSCURVE__ISR();
+#else
+	vSTEPDRIVE_TIMEBASE__ISR();
+#endif
+}
+
 #endif //C_LOCALDEF__LCCM655__ENABLE_BRAKES
 #endif //#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
 //safetys
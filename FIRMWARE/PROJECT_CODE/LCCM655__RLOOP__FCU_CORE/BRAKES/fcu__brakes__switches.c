@@ -234,6 +234,10 @@ void vFCU_BRAKES_SW__Left_SwitchRetract_ISR(void)
 {
 	#if C_LOCALDEF__LCCM655__ENABLE_BRAKES == 1U
 		vSTEPDRIVE_LIMIT__Limit_ISR(0U);
+		#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+			//the S-curve planner steps on its own, stop it too
+			vSCURVE__Abort(0U);
+		#endif
 
 		sFCU.sBrakes[FCU_BRAKE__LEFT].sLimits[BRAKE_SW__RETRACT].u8EdgeSeen = 1U;
 		#if C_LOCALDEF__LCCM655__ENABLE_DEBUG_BRAKES == 1U
@@ -253,6 +257,10 @@ void vFCU_BRAKES_SW__Left_SwitchExtend_ISR(void)
 {
 	#if C_LOCALDEF__LCCM655__ENABLE_BRAKES == 1U
 		vSTEPDRIVE_LIMIT__Limit_ISR(0U);
+		#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+			//the S-curve planner steps on its own, stop it too
+			vSCURVE__Abort(0U);
+		#endif
 
 		sFCU.sBrakes[FCU_BRAKE__LEFT].sLimits[BRAKE_SW__EXTEND].u8EdgeSeen = 1U;
 		#if C_LOCALDEF__LCCM655__ENABLE_DEBUG_BRAKES == 1U
@@ -273,6 +281,10 @@ void vFCU_BRAKES_SW__Right_SwitchRetract_ISR(void)
 {
 	#if C_LOCALDEF__LCCM655__ENABLE_BRAKES == 1U
 		vSTEPDRIVE_LIMIT__Limit_ISR(1U);
+		#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+			//the S-curve planner steps on its own, stop it too
+			vSCURVE__Abort(1U);
+		#endif
 
 		sFCU.sBrakes[FCU_BRAKE__RIGHT].sLimits[BRAKE_SW__RETRACT].u8EdgeSeen = 1U;
 		#if C_LOCALDEF__LCCM655__ENABLE_DEBUG_BRAKES == 1U
@@ -292,6 +304,10 @@ void vFCU_BRAKES_SW__Right_SwitchExtend_ISR(void)
 {
 	#if C_LOCALDEF__LCCM655__ENABLE_BRAKES == 1U
 		vSTEPDRIVE_LIMIT__Limit_ISR(1U);
+		#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+			//the S-curve planner steps on its own, stop it too
+			vSCURVE__Abort(1U);
+		#endif
 
 		sFCU.sBrakes[FCU_BRAKE__RIGHT].sLimits[BRAKE_SW__EXTEND].u8EdgeSeen = 1U;
 		#if C_LOCALDEF__LCCM655__ENABLE_DEBUG_BRAKES == 1U
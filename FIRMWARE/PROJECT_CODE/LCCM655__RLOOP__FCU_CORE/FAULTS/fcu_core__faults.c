@@ -33,11 +33,59 @@ extern struct _strFCU sFCU;
  */
 void vFCU_FAULTS__Init(void)
 {
+	#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+		//start the journal empty before anything can set a flag
+		vFAULTLINK_JOURNAL__Init();
+	#endif
+
 	//init the fault tree module.
-	vFAULTTREE__Init(&sFCU.sFaults.sTopLevel);
+	vFAULTLINK__Init(&sFCU.sFaults.sTopLevel);
 
 	//accel subsystem
-	vFAULTTREE__Init(&sFCU.sFaults.sAccel);
+	vFAULTLINK__Init(&sFCU.sFaults.sAccel);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Link the subsystem fault trees under the top level tree
+ *
+ * @note
+ * Call once the subsystems have initted their trees, vFAULTLINK__Init()
+ * unlinks a tree. After this the top level fault flag covers every subsystem
+ * and u32FCU_FAULTS__Get_ChildFaults() says which ones.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.022.FUNC.005
+ */
+void vFCU_FAULTS__Link_Subsystems(void)
+{
+	#if C_LOCALDEF__LCCM655__ENABLE_BRAKES == 1U
+		Luint8 u8Counter;
+	#endif
+
+	vFAULTLINK__Set_ID(&sFCU.sFaults.sTopLevel, 0U);
+
+	vFAULTLINK__Set_ID(&sFCU.sFaults.sAccel, (Luint16)(C_FCU__FAULT_CHILD__ACCEL + 1U));
+	vFAULTLINK__Link(&sFCU.sFaults.sAccel, &sFCU.sFaults.sTopLevel, C_FCU__FAULT_CHILD__ACCEL);
+
+	#if C_LOCALDEF__LCCM655__ENABLE_BRAKES == 1U
+		for(u8Counter = 0U; u8Counter < C_FCU__NUM_BRAKES; u8Counter++)
+		{
+			vFAULTLINK__Set_ID(&sFCU.sBrakes[u8Counter].sFaultFlags, (Luint16)(C_FCU__FAULT_CHILD__BRAKES + u8Counter + 1U));
+			vFAULTLINK__Link(&sFCU.sBrakes[u8Counter].sFaultFlags, &sFCU.sFaults.sTopLevel, (Luint8)(C_FCU__FAULT_CHILD__BRAKES + u8Counter));
+		}
+	#endif
+
+	#if C_LOCALDEF__LCCM655__ENABLE_LASER_CONTRAST == 1U
+		vFAULTLINK__Set_ID(&sFCU.sContrast.sFaultFlags, (Luint16)(C_FCU__FAULT_CHILD__CONTRAST + 1U));
+		vFAULTLINK__Link(&sFCU.sContrast.sFaultFlags, &sFCU.sFaults.sTopLevel, C_FCU__FAULT_CHILD__CONTRAST);
+	#endif
+
+	#if C_LOCALDEF__LCCM655__ENABLE_FCTL_ORIENTATION == 1U
+		vFAULTLINK__Set_ID(&sFCU.sFlightControl.sOrient.sFaultFlags, (Luint16)(C_FCU__FAULT_CHILD__ORIENT + 1U));
+		vFAULTLINK__Link(&sFCU.sFlightControl.sOrient.sFaultFlags, &sFCU.sFaults.sTopLevel, C_FCU__FAULT_CHILD__ORIENT);
+	#endif
 
 }
 
@@ -53,12 +101,8 @@ void vFCU_FAULTS__Init(void)
 void vFCU_FAULTS__Process(void)
 {
 
-	//check the subsystem layers for faults.
-
-	//check the brakes layer
-
-
-
+	//the subsystem trees are linked under the top level and mark it as soon
+	//as they are set, there is nothing to poll here.
 
 }
 
@@ -86,7 +130,20 @@ Luint8 u8FCU_FAULTS__Get_IsFault(void)
  */
 Luint32 u32FCU_FAULTS__Get_FaultFlags(void)
 {
-	return sFCU.sFaults.sTopLevel.u32Flags[0];
+	return sFCU.sFaults.sTopLevel.sTree.u32Flags[0];
+}
+
+/***************************************************************************//**
+ * @brief
+ * Return which subsystems are faulted
+ *
+ * @return			Bit C_FCU__FAULT_CHILD__xxx set if that subsystem is faulted
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.022.FUNC.006
+ */
+Luint32 u32FCU_FAULTS__Get_ChildFaults(void)
+{
+	return u32FAULTLINK__Get_ChildFaults(&sFCU.sFaults.sTopLevel);
 }
 
 #endif //#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
@@ -0,0 +1,266 @@
+/**
+ * @file		FCU_CORE__FAULTS__ETHERNET.C
+ * @brief		Fault journal streaming over SafeUDP
+ *
+ * @note
+ * Ground ops get the order faults happened in from the LCCM671 journal rather
+ * than polling every fault word. With streaming on, each pass sends any entries
+ * logged since the last packet. A replay request resends from a given sequence,
+ * if that has already been overwritten we start from the oldest still held and
+ * the gap in sequence numbers shows what was lost.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM655R0.FILE.042
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FCU
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FCU_CORE__FAULTS__ETHERNET
+ * @ingroup FCU
+ * @{ */
+
+#include "../fcu_core.h"
+#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_ETHERNET == 1U
+#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+
+//the structure
+extern struct _strFCU sFCU;
+
+
+/***************************************************************************//**
+ * @brief
+ * Init the journal streaming, off until the host turns it on
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.042.FUNC.001
+ */
+void vFCU_FAULTS_ETH__Init(void)
+{
+	sFCU.sFaults.sJournalTx.u32TxSequence = 0U;
+	sFCU.sFaults.sJournalTx.u8Streaming = 0U;
+	sFCU.sFaults.sJournalTx.u8Replay = 0U;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Send journal entries the host has not had yet
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.042.FUNC.002
+ */
+void vFCU_FAULTS_ETH__Process(void)
+{
+	Luint32 u32Oldest;
+
+	if((sFCU.sFaults.sJournalTx.u8Streaming == 1U) || (sFCU.sFaults.sJournalTx.u8Replay == 1U))
+	{
+		//skip anything the ring has already dropped
+		u32Oldest = u32FAULTLINK_JOURNAL__Get_Oldest();
+		if(sFCU.sFaults.sJournalTx.u32TxSequence < u32Oldest)
+		{
+			sFCU.sFaults.sJournalTx.u32TxSequence = u32Oldest;
+		}
+		else
+		{
+			//fall on
+		}
+
+		if(sFCU.sFaults.sJournalTx.u32TxSequence < u32FAULTLINK_JOURNAL__Get_Sequence())
+		{
+			#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+				//goes with the streams, asking again while it waits does nothing
+				(void)s16TXCLASS__Request(TXCLASS__PERIODIC, 0U, (Luint16)FCU_NET_TXREQ__FAULT_JOURNAL, (Luint32)FCU_PKT__FAULTS__TX_JOURNAL);
+			#else
+				vFCU_FAULTS_ETH__Transmit(FCU_PKT__FAULTS__TX_JOURNAL);
+			#endif
+		}
+		else
+		{
+			//caught up
+			sFCU.sFaults.sJournalTx.u8Replay = 0U;
+		}
+	}
+	else
+	{
+		//not wanted
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Turn journal streaming on or off
+ *
+ * @note
+ * Turning it on starts from entries logged after this point, use a replay
+ * request to get the history.
+ *
+ * @param[in]		u32Enable				1 = stream new entries
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.042.FUNC.003
+ */
+void vFCU_FAULTS_ETH__Streaming_Control(Luint32 u32Enable)
+{
+	if(u32Enable == 1U)
+	{
+		if(sFCU.sFaults.sJournalTx.u8Replay == 0U)
+		{
+			sFCU.sFaults.sJournalTx.u32TxSequence = u32FAULTLINK_JOURNAL__Get_Sequence();
+		}
+		else
+		{
+			//a replay is running, carry on from where it is
+		}
+		sFCU.sFaults.sJournalTx.u8Streaming = 1U;
+	}
+	else
+	{
+		sFCU.sFaults.sJournalTx.u8Streaming = 0U;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Resend the journal starting at a sequence number
+ *
+ * @param[in]		u32Sequence				First sequence wanted, 0 for everything held
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.042.FUNC.004
+ */
+void vFCU_FAULTS_ETH__Request_Replay(Luint32 u32Sequence)
+{
+	sFCU.sFaults.sJournalTx.u32TxSequence = u32Sequence;
+	sFCU.sFaults.sJournalTx.u8Replay = 1U;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Transmit a block of journal entries
+ *
+ * @note
+ * Header, 16 bytes:\n
+ * U32 Next sequence to be logged\n
+ * U32 Oldest sequence still held\n
+ * U32 Top level fault flags, word 0\n
+ * U32 Faulted subsystems, bit per C_FCU__FAULT_CHILD__xxx\n
+ * Then up to C_FCU__FAULT_JOURNAL__ENTRIES_PER_PACKET entries, 16 bytes each:\n
+ * U32 Sequence\n
+ * U16 Tree ID\n
+ * U8 Flag index\n
+ * U8 Spare\n
+ * U32 Timestamp, upper\n
+ * U32 Timestamp, lower
+ *
+ * @param[in]		ePacketType				The type of packet to transmit
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.042.FUNC.005
+ */
+void vFCU_FAULTS_ETH__Transmit(E_FCU_NET_PACKET_TYPES ePacketType)
+{
+	Lint16 s16Return;
+	Luint8 * pu8Buffer;
+	Luint8 u8BufferIndex;
+	Luint16 u16Length;
+	Luint32 u32Sequence;
+	Luint32 u32Count;
+	Luint32 u32Counter;
+	Luint8 u8Test;
+	FAULTLINK__JOURNAL_ENTRY_T sEntry;
+
+	pu8Buffer = 0;
+
+	//how many entries can go in this packet
+	u32Sequence = u32FAULTLINK_JOURNAL__Get_Sequence();
+	u32Count = u32Sequence - sFCU.sFaults.sJournalTx.u32TxSequence;
+	if(u32Count > C_FCU__FAULT_JOURNAL__ENTRIES_PER_PACKET)
+	{
+		u32Count = C_FCU__FAULT_JOURNAL__ENTRIES_PER_PACKET;
+	}
+	else
+	{
+		//fall on
+	}
+	u16Length = (Luint16)(16U + (u32Count * 16U));
+
+	//pre-comit
+	s16Return = s16SAFEUDP_TX__PreCommit(u16Length, (SAFE_UDP__PACKET_T)ePacketType, &pu8Buffer, &u8BufferIndex);
+	if(s16Return == 0)
+	{
+		vNUMERICAL_CONVERT__Array_U32(pu8Buffer, u32Sequence);
+		pu8Buffer += 4U;
+
+		vNUMERICAL_CONVERT__Array_U32(pu8Buffer, u32FAULTLINK_JOURNAL__Get_Oldest());
+		pu8Buffer += 4U;
+
+		vNUMERICAL_CONVERT__Array_U32(pu8Buffer, u32FCU_FAULTS__Get_FaultFlags());
+		pu8Buffer += 4U;
+
+		vNUMERICAL_CONVERT__Array_U32(pu8Buffer, u32FCU_FAULTS__Get_ChildFaults());
+		pu8Buffer += 4U;
+
+		for(u32Counter = 0U; u32Counter < u32Count; u32Counter++)
+		{
+			u8Test = u8FAULTLINK_JOURNAL__Get_Entry(sFCU.sFaults.sJournalTx.u32TxSequence + u32Counter, &sEntry);
+			if(u8Test == 0U)
+			{
+				//overwritten since we sized the packet, send the slot as a dead entry
+				sEntry.u32Sequence = 0xFFFFFFFFU;
+				sEntry.u16TreeID = 0xFFFFU;
+				sEntry.u8FlagIndex = 0xFFU;
+				sEntry.u64Timestamp = 0U;
+			}
+			else
+			{
+				//fall on
+			}
+
+			vNUMERICAL_CONVERT__Array_U32(pu8Buffer, sEntry.u32Sequence);
+			pu8Buffer += 4U;
+
+			vNUMERICAL_CONVERT__Array_U16(pu8Buffer, sEntry.u16TreeID);
+			pu8Buffer += 2U;
+
+			pu8Buffer[0] = sEntry.u8FlagIndex;
+			pu8Buffer[1] = 0U;
+			pu8Buffer += 2U;
+
+			vNUMERICAL_CONVERT__Array_U32(pu8Buffer, (Luint32)(sEntry.u64Timestamp >> 32U));
+			pu8Buffer += 4U;
+
+			vNUMERICAL_CONVERT__Array_U32(pu8Buffer, (Luint32)(sEntry.u64Timestamp & 0xFFFFFFFFU));
+			pu8Buffer += 4U;
+		}
+
+		//send it
+		vSAFEUDP_TX__Commit(u8BufferIndex, u16Length, C_LOCALDEF__LCCM528__ETHERNET_PORT_NUMBER, C_LOCALDEF__LCCM528__ETHERNET_PORT_NUMBER);
+
+		//only move on once it has gone
+		sFCU.sFaults.sJournalTx.u32TxSequence += u32Count;
+
+	}//if(s16Return == 0)
+	else
+	{
+		//no buffer, try again next pass
+
+	}//else if(s16Return == 0)
+
+}
+
+
+#endif //C_LOCALDEF__LCCM671__ENABLE_JOURNAL
+#endif //C_LOCALDEF__LCCM655__ENABLE_ETHERNET
+#endif //#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
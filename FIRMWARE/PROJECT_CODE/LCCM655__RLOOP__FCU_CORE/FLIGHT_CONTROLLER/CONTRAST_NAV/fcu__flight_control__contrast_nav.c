@@ -30,32 +30,62 @@ extern struct _strFCU sFCU;
 void vFCU_FLIGHTCTL_CONTRASTNAV__Init(void)
 {
 
+	sFCU.sFlightControl.sContrastNav.u32Position_mm = 0U;
+	sFCU.sFlightControl.sContrastNav.u32Veloc_mms = 0U;
 
 }
 
 //process nav tasks
 void vFCU_FLIGHTCTL_CONTRASTNAV__Process(void)
 {
-
+	#if C_LOCALDEF__LCCM655__ENABLE_LASER_CONTRAST == 1U
+		//the stripe tracking is done as the edges come in, here we just carry it to now
+		sFCU.sFlightControl.sContrastNav.u32Position_mm = u32FCU_LASERCONT_TL__Get_Position_mm(u64RM4_RTI__Get_Counter1());
+		sFCU.sFlightControl.sContrastNav.u32Veloc_mms = u32FCU_LASERCONT_TL__Get_Velocity_mms();
+	#else
+		//no contrast sensors, nothing to navigate with
+	#endif
 }
 
 
 //returns our current pod position in mm
 Luint32 u32FCU_FLIGHTCTL_CONTRASTNAV__Get_Position_mm(void)
 {
-	return 0;
+	return sFCU.sFlightControl.sContrastNav.u32Position_mm;
+}
+
+//returns our current velocity in mm/s
+Luint32 u32FCU_FLIGHTCTL_CONTRASTNAV__Get_Velocity_mms(void)
+{
+	return sFCU.sFlightControl.sContrastNav.u32Veloc_mms;
 }
 
 //immediate return of a fault condition in the nav.
 Luint8 u8FCU_FLIGHTCTL_CONTRASTNAV__Get_IsFault(void)
 {
-	return 0;
+	Luint8 u8Return;
+
+	#if C_LOCALDEF__LCCM655__ENABLE_LASER_CONTRAST == 1U
+		u8Return = u8FCU_LASERCONT_TL__Get_IsFault();
+	#else
+		u8Return = 0U;
+	#endif
+
+	return u8Return;
 }
 
 //return the list of fault flag conditions.
 Luint32 u32FCU_FLIGHTCTL_CONTRASTNAV__Get_FaultFlags(void)
 {
-	return 0;
+	Luint32 u32Return;
+
+	#if C_LOCALDEF__LCCM655__ENABLE_LASER_CONTRAST == 1U
+		u32Return = u32FCU_LASERCONT_TL__Get_FaultFlags();
+	#else
+		u32Return = 0U;
+	#endif
+
+	return u32Return;
 }
 
 
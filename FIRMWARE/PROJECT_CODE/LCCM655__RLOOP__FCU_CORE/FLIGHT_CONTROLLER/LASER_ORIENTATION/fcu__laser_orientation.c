@@ -33,8 +33,9 @@
 
 	 	// trig functions used in this code (search "trig" to find all cases)
 	 		// f32NUMERICAL_Atan()
-	 		// acos() - not yet implemented
 	 		// f32NUMERICAL_Cosine()
+	 	// roll and pitch are done in fixed point by fcu__laser_orientation__solver.c
+	 	// and checked against f32NUMERICAL_Atan() there
 
  	// My code here has forced that the optoncdt's are ordered as:
  		// 0-4: Ground facing lasers
@@ -53,65 +54,86 @@
 extern struct _strFCU sFCU;
 
 //locals
-static void vFCU_FLIGHTCTL_LASERORIENT__CalcRoll(void);
-static void vFCU_FLIGHTCTL_LASERORIENT__CalcPitch(void);
-static void vFCU_FLIGHTCTL_LASERORIENT__CalcTwistRoll(void);
-static void vFCU_FLIGHTCTL_LASERORIENT__CalcTwistPitch(void);
-static Lfloat32 f32FCU_FLIGHTCTL_LASERORIENT__PointToPlaneDistance(Lfloat32 f32Position[3]);
-static void vFCU_FLIGHTCTL_LASERORIENT__CalculateGroundPlane(Luint8 u8A, Luint8 u8B, Luint8 u8C, Lfloat32 *pf32PlaneEqnCoeffs);
 static void vFCU_FLIGHTCTL_LASERORIENT__CalcYaw(void);
 static void vFCU_FLIGHTCTL_LASERORIENT__CalcLateral(void);
 
+// TODO: All positions of components need their positions measured and assigned here.
+	// blocked by installation of the components
+
+//Ground Facing Laser Positions {x,y,z}
+ // Laser.f32Position[LASER_ORIENT__Z] is the reading when pod is sitting flat
+   // (historic def: For the laser positions Z should be the reading when the HDK is sitting flat on the 4 hover engines)
+static const Lfloat32 f32FCU_LASERORIENT__GroundPos[C_FCU__NUM_LASERS_GROUND][3] =
+{
+	{8.0F, 185.0F, 35.0F},
+	{-112.0F, 18.0F, 35.0F},
+	{121.0F, -53.0F, 35.0F},
+	{0.0F, 0.0F, 0.0F}
+};
+
+// I-Beam laser positions {x,y,z}
+static const Lfloat32 f32FCU_LASERORIENT__BeamPos[C_FCU__NUM_LASERS_IBEAM][3] =
+{
+	{25.0F, 0.0F, 35.0F},
+	{25.0F, 100.0F, 35.0F}
+};
+
+//Hover Engine Positions {x,y,z} (from top view)
+//Forward TL, TR, BR, BL then Rear TL, TR, BR, BL
+static const Lfloat32 f32FCU_LASERORIENT__EnginePos[C_FCU__NUM_HOVER_ENGINES][3] =
+{
+	{61.0F, 130.0F, 0.0F},
+	{62.0F, 129.0F, 0.0F},
+	{62.0F, 126.0F, 0.0F},
+	{60.0F, 128.0F, 0.0F},
+	{0.0F, 0.0F, 0.0F},
+	{0.0F, 0.0F, 0.0F},
+	{0.0F, 0.0F, 0.0F},
+	{0.0F, 0.0F, 0.0F}
+};
 
 
 /***************************************************************************//**
  * @brief
- * Init any brakes variables, etc.
+ * Init any orientation variables, etc.
  * 
  *
  */
 void vFCU_FLIGHTCTL_LASERORIENT__Init(void)
 {
-	// TODO: All positions of components need their positions measured and assigned here.
-		// blocked by installation of the components
-
-	//Ground Facing Laser Positions
-	 // Laser.f32Position[LASER_ORIENT__Z] is the reading when pod is sitting flat
-  	   // (historic def: For the laser positions Z should be the reading when the HDK is sitting flat on the 4 hover engines)
-	sFCU.sFlightControl.sOrient.sGroundLasers[0].f32Position[3] = {8, 185, 35}; // ground laser 1 position {x,y,z}
-	sFCU.sFlightControl.sOrient.sGroundLasers[1].f32Position[3] = {-112, 18, 35}; // ground laser 2 position {x,y,z}
-	sFCU.sFlightControl.sOrient.sGroundLasers[2].f32Position[3] = {121, -53, 35}; // ground laser 3 position {x,y,z}
-	sFCU.sFlightControl.sOrient.sGroundLasers[3].f32Position[3] = {}; // ground laser 4 position {x,y,z}
-
-	// I-Beam laser positions
-	sFCU.sFlightControl.sOrient.sBeamLasers[0].f32Position[3] = {25, 0, 35};  // i-beam laser 1 position {x,y,z}
-	sFCU.sFlightControl.sOrient.sBeamLasers[1].f32Position[3] = {25, 100, 35};  //i-beam laser 2 position {x,y,z}
-
-	//Hover Engine Positions {x,y,z} (from top view)
-	sFCU.sFlightControl.sOrient.sHoverEngines[0].f32Position[3] = {61, 130, 0}; // Forward Top Left {x,y,z}
-	sFCU.sFlightControl.sOrient.sHoverEngines[1].f32Position[3] = {62, 129, 0}; // Forward Top Right {x,y,z}
-	sFCU.sFlightControl.sOrient.sHoverEngines[2].f32Position[3] = {62, 126, 0}; // Forward Bottom Right {x,y,z}
-	sFCU.sFlightControl.sOrient.sHoverEngines[3].f32Position[3] = {60, 128, 0}; // Forward Bottom Left {x,y,z}
-
-	sFCU.sFlightControl.sOrient.sHoverEngines[4].f32Position[3] = {0, 0, 0}; // Rear Top Left {x,y,z}
-	sFCU.sFlightControl.sOrient.sHoverEngines[5].f32Position[3] = {0, 0, 0}; // Rear Top Right {x,y,z}
-	sFCU.sFlightControl.sOrient.sHoverEngines[6].f32Position[3] = {0, 0, 0}; // Rear Bottom Right {x,y,z}
-	sFCU.sFlightControl.sOrient.sHoverEngines[7].f32Position[3] = {0, 0, 0}; // Rear Bottom Left {x,y,z}
-
-	Luint8 u8Counter = 0U;
-	// Init measurements and error states to zero
+	Luint8 u8Counter;
+	Luint8 u8Axis;
+
+	// Init positions, measurements and error states
 	for(u8Counter = 0U; u8Counter < C_FCU__NUM_LASERS_GROUND; u8Counter++)
 	{
+		for(u8Axis = 0U; u8Axis < 3U; u8Axis++)
+		{
+			sFCU.sFlightControl.sOrient.sGroundLasers[u8Counter].f32Position[u8Axis] = f32FCU_LASERORIENT__GroundPos[u8Counter][u8Axis];
+		}
 		sFCU.sFlightControl.sOrient.sGroundLasers[u8Counter].f32Measurement = 0.0F;
 		sFCU.sFlightControl.sOrient.sGroundLasers[u8Counter].u8Error = 0U;
 	} 
 
 	for(u8Counter = 0U; u8Counter < C_FCU__NUM_LASERS_IBEAM; u8Counter++)
 	{
+		for(u8Axis = 0U; u8Axis < 3U; u8Axis++)
+		{
+			sFCU.sFlightControl.sOrient.sBeamLasers[u8Counter].f32Position[u8Axis] = f32FCU_LASERORIENT__BeamPos[u8Counter][u8Axis];
+		}
 		sFCU.sFlightControl.sOrient.sBeamLasers[u8Counter].f32Measurement = 0.0F;
 		sFCU.sFlightControl.sOrient.sBeamLasers[u8Counter].u8Error = 0U;
 	} 
 
+	for(u8Counter = 0U; u8Counter < C_FCU__NUM_HOVER_ENGINES; u8Counter++)
+	{
+		for(u8Axis = 0U; u8Axis < 3U; u8Axis++)
+		{
+			sFCU.sFlightControl.sOrient.sHoverEngines[u8Counter].f32Position[u8Axis] = f32FCU_LASERORIENT__EnginePos[u8Counter][u8Axis];
+		}
+		sFCU.sFlightControl.sOrient.sHoverEngines[u8Counter].f32Measurement = 0.0F;
+	}
+
 	// Init PodOrientation values
 	sFCU.sFlightControl.sOrient.s16Roll = 0;
 	sFCU.sFlightControl.sOrient.s16Pitch = 0;
@@ -120,8 +142,17 @@ void vFCU_FLIGHTCTL_LASERORIENT__Init(void)
 	sFCU.sFlightControl.sOrient.s16TwistPitch = 0;
 	sFCU.sFlightControl.sOrient.s16TwistRoll = 0;
 
-	sFCU.sFlightControl.sOrient.f32PlaneCoeffs[4] = {0,0,0,0}; // ground plane coefficients
-	sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[4] = {0,0,0,0}; // 2nd ground plane coefficients; compare to latter to get twist parameters
+	// ground plane coefficients, the 2nd plane is compared to the first to get twist parameters
+	for(u8Counter = 0U; u8Counter < 4U; u8Counter++)
+	{
+		sFCU.sFlightControl.sOrient.f32PlaneCoeffs[u8Counter] = 0.0F;
+		sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[u8Counter] = 0.0F;
+		sFCU.sFlightControl.sOrient.f32PlaneNorm[u8Counter] = 0.0F;
+	}
+
+	//plane fit and engine matrix are built from the positions above
+	vFCU_FLIGHTCTL_LASERORIENT_FIT__Init();
+	vFCU_FLIGHTCTL_LASERORIENT_SOLVE__Init();
 
 	sFCU.sFlightControl.sOrient.eState = LASER_ORIENTATION_STATE__INIT;
 
@@ -135,9 +166,14 @@ void vFCU_FLIGHTCTL_LASERORIENT__Init(void)
  */
 void vFCU_FLIGHTCTL_LASERORIENT__Process(void)
 {
-	Luint8 u8OperationalLasers[C_FCU__NUM_LASERS_GROUND];
-	Luint8 u8OperationalCount = 0U;
+	Luint8 u8OperationalCount;
+	Luint8 u8Healthy;
+	Luint8 u8Used;
 	Luint8 u8Counter;
+	Luint8 u8Fault;
+	Lint16 s16TwistRoll;
+	Lint16 s16TwistPitch;
+	Lfloat32 f32TwistNorm[4];
 
 
 	//handle the state machine
@@ -171,67 +207,60 @@ void vFCU_FLIGHTCTL_LASERORIENT__Process(void)
 			break;
 
 		case LASER_ORIENTATION_STATE__RECALCULATE_PITCH_ROLL_TWIST:
-			/** count which lasers are not in the error state and append them to array */
-
+			/** mark which lasers are not in the error state */
+			u8Healthy = 0U;
 			for(u8Counter = 0U; u8Counter < C_FCU__NUM_LASERS_GROUND; u8Counter++)
 			{
 				if(sFCU.sFlightControl.sOrient.sGroundLasers[u8Counter].u8Error != 1U)
 				{
-					// Laser works, store its index in the array
-					u8OperationalLasers[u8OperationalCount] = u8Counter; 
-					// increment count of operational lasers
-					u8OperationalCount += 1U; 
+					u8Healthy |= (Luint8)(1U << u8Counter);
 				}
 				else
 				{
-					// bad laser; dont append its index to array
+					// bad laser; leave it out of the fit
 				}
 			}
 
-			/** Calculate as many of the pods orientation parameters as possible based on the number of operational lasers */
-			if(u8OperationalCount == 4U)
+			/** least squares through whatever is left, fewer lasers just means a less certain plane */
+			u8Used = u8FCU_FLIGHTCTL_LASERORIENT_FIT__Update(u8Healthy, &sFCU.sFlightControl.sOrient.f32PlaneCoeffs[0]);
+			if(u8Used != 0U)
 			{
-				// calculate pitch, roll, and twist of the pod
-				// 1st triplet of ground lasers
-			    vFCU_FLIGHTCTL_LASERORIENT__CalculateGroundPlane(0U, 1U, 2U, &sFCU.sFlightControl.sOrient.f32PlaneCoeffs[0]);
-
-			    // 2nd triplet of ground lasers
-			    vFCU_FLIGHTCTL_LASERORIENT__CalculateGroundPlane(1U, 2U, 3U, &sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[0]);
-
-			    for(u8Counter = 0U; u8Counter < C_FCU__NUM_HOVER_ENGINES; u8Counter++)
-			    {
-			    	// Calc the position of each hover engine
-					sFCU.sFlightControl.sOrient.sHoverEngines[u8Counter].f32Measurement = f32FCU_FLIGHTCTL_LASERORIENT__PointToPlaneDistance(&sFCU.sFlightControl.sOrient.sHoverEngines[u8Counter].f32Position[0]);
+				//normalise once, the angles and all the engine heights come off the same plane
+				u8Fault = u8FCU_FLIGHTCTL_LASERORIENT_SOLVE__Plane(&sFCU.sFlightControl.sOrient.f32PlaneCoeffs[0], &sFCU.sFlightControl.sOrient.f32PlaneNorm[0], &sFCU.sFlightControl.sOrient.s16Roll, &sFCU.sFlightControl.sOrient.s16Pitch);
+				if(u8Fault == 0U)
+				{
+					vFCU_FLIGHTCTL_LASERORIENT_SOLVE__Heights(&sFCU.sFlightControl.sOrient.f32PlaneNorm[0]);
 				}
-
-				vFCU_FLIGHTCTL_LASERORIENT__CalcRoll();
-				vFCU_FLIGHTCTL_LASERORIENT__CalcPitch();
-
-				vFCU_FLIGHTCTL_LASERORIENT__CalcTwistRoll();
-				vFCU_FLIGHTCTL_LASERORIENT__CalcTwistPitch();
-			}
-			else if(u8OperationalCount == 3U)
-			{ 
-				// calculate pitch and roll. cannot calculate twist.
-			    vFCU_FLIGHTCTL_LASERORIENT__CalculateGroundPlane(u8OperationalLasers[0], u8OperationalLasers[1], u8OperationalLasers[2], &sFCU.sFlightControl.sOrient.f32PlaneCoeffs[0]);
-
-			    for(u8Counter = 0U; u8Counter < C_FCU__NUM_HOVER_ENGINES; u8Counter++)
-			    {
-			    	// Calc the position of each hover engine
-					sFCU.sFlightControl.sOrient.sHoverEngines[u8Counter].f32Measurement = f32FCU_FLIGHTCTL_LASERORIENT__PointToPlaneDistance(&sFCU.sFlightControl.sOrient.sHoverEngines[u8Counter].f32Position[0]);
+				else
+				{
+					//fault is latched in the solver, keep the last good heights
 				}
 
-				vFCU_FLIGHTCTL_LASERORIENT__CalcPitch();
-				vFCU_FLIGHTCTL_LASERORIENT__CalcRoll();
-			}
-			else if(u8OperationalCount == 2U)
-			{
-				// there are 2 operable lasers; can't compute any of the orientation parameters directly, but can infer information from what we have.
-				// TODO write code to infer orientation parameters
+				if((u8Used == (Luint8)(C_FCU__LASER_ORIENT__NUM_FIT_MASKS - 1U)) && (u8Fault == 0U))
+				{
+					// every laser agreed with the fit, the plane through all but the first
+					// compared to it gives the twisting of the pod structure // TODO: check signs
+					vFCU_FLIGHTCTL_LASERORIENT_FIT__Mask(u8Used & 0xFEU, &sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[0]);
+
+					u8Fault = u8FCU_FLIGHTCTL_LASERORIENT_SOLVE__Plane(&sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[0], &f32TwistNorm[0], &s16TwistRoll, &s16TwistPitch);
+					if(u8Fault == 0U)
+					{
+						sFCU.sFlightControl.sOrient.s16TwistRoll = s16TwistRoll - sFCU.sFlightControl.sOrient.s16Roll;
+						sFCU.sFlightControl.sOrient.s16TwistPitch = s16TwistPitch - sFCU.sFlightControl.sOrient.s16Pitch;
+					}
+					else
+					{
+						//keep the last good twist
+					}
+				}
+				else
+				{
+					//cannot calculate twist.
+				}
 			}
 			else
 			{
-				// there is 1 or fewer operable lasers; can't compute twist/pitch/roll/HE heights.
+				// no operable lasers; can't compute twist/pitch/roll/HE heights.
 			}
 
 			sFCU.sFlightControl.sOrient.eState = LASER_ORIENTATION_STATE__RECALCULATE_YAW_AND_LATERAL;
@@ -239,31 +268,27 @@ void vFCU_FLIGHTCTL_LASERORIENT__Process(void)
 
 		case LASER_ORIENTATION_STATE__RECALCULATE_YAW_AND_LATERAL:
 
-			/** count which lasers are not in the error state and append them to array. */
-			Luint8 u8OperationalCount = 0U;
-			Luint8 u8OperationalLasers[C_FCU__NUM_LASERS_IBEAM];
-
-			for(Luint8 u8Counter = 0U; u8Counter < C_FCU__NUM_LASERS_IBEAM; u8Counter++)
+			/** count which lasers are not in the error state. */
+			u8OperationalCount = 0U;
+			for(u8Counter = 0U; u8Counter < C_FCU__NUM_LASERS_IBEAM; u8Counter++)
 			{
 				if(sFCU.sFlightControl.sOrient.sBeamLasers[u8Counter].u8Error != 1U)
 				{
-					// Laser works, store its index in the array
-					u8OperationalLasers[u8OperationalCount] = u8Counter; 
 					// increment count of operational lasers
 					u8OperationalCount += 1U; 
 				}
 				else
 				{
-					// bad laser; dont append its index to array
+					// bad laser
 				}
 			}
 
 			/** Calculate as many of the pods orientation parameters as possible based on the number of operational lasers */
 			if(u8OperationalCount == 2U)
 			{
-				vFCU_FLIGHTCTL_LASERORIENT__RecalcYaw();
+				vFCU_FLIGHTCTL_LASERORIENT__CalcYaw();
 
-				vFCU_FLIGHTCTL_LASERORIENT__RecalcLateral();
+				vFCU_FLIGHTCTL_LASERORIENT__CalcLateral();
 
 			}
 			else if(u8OperationalCount == 1U)
@@ -286,114 +311,16 @@ void vFCU_FLIGHTCTL_LASERORIENT__Process(void)
 		case LASER_ORIENTATION_STATE__ERROR:
 			//some error has happened 
 			break;
-	}
-}
-
 
-/** Return the least distance between a point and the plane */
-Lfloat32 f32FCU_FLIGHTCTL_LASERORIENT__PointToPlaneDistance(Lfloat32 f32Position[3]) // TODO add a * since it's now called with ref &?
-{
-	return 
-	(
-		(sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__A] * f32Position[LASER_ORIENT__X] + sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__B] * f32Position[LASER_ORIENT__Y] + sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__C] * f32Position[LASER_ORIENT__Z] + sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__D]) /
-		sqrt((double)(sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__A] * sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__A] + sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__B] * sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__B] + sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__C] * sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__C]))
-	);
-}
-
-
-/** The angle between two planes that yield the roll */
-void vFCU_FLIGHTCTL_LASERORIENT__CalcRoll(void)
-{
-	//Normal vector of the other plane
-	Lfloat32 f32vec1x = 1, f32vec1y = 0, f32vec1z = 0;
-
-	//Angle between two planes // TODO: Need to find a Lachlan func for this and account for floating point errors 
-	sFCU.sFlightControl.sOrient.s16Roll = (Lint16)(acos((double)((f32vec1x * sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__A] + f32vec1y * sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__B] + f32vec1z * sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__C]) / sqrt((double)(sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__A] * sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__A] + sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__B] * sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__B] + sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__C] * sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__C])))) * 10000);  // TODO: Trig
-}
-
-
-/** The angle between two planes that yields the pitch */
-void vFCU_FLIGHTCTL_LASERORIENT__CalcPitch(void)
-{
-	//Normal vector of the other plane
-	Lfloat32 f32vec1x = 0, f32vec1y = 1, f32vec1z = 0;
-
-	//Angle between two planes // TODO: Need to find a Lachlan func for this
-	sFCU.sFlightControl.sOrient.s16Pitch = (Lint16)(acos((double)((f32vec1x * sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__A] + f32vec1y * sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__B] + f32vec1z * sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__C]) / sqrt((double)(sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__A] * sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__A] + sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__B] * sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__B] + sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__C] * sFCU.sFlightControl.sOrient.f32PlaneCoeffs[LASER_ORIENT__C])))) * 10000);  // TODO: Trig
-}
-
-
-/** Calculate the pod's twisting due to the lack of perfect rigidity of the substructure: Roll Twisting */
-void vFCU_FLIGHTCTL_LASERORIENT__CalcTwistRoll(void)
-{
-	//Normal vector of the other plane
-	Lfloat32 f32vec1x = 1, f32vec1y = 0, f32vec1z = 0;
-
-	//Angle between two planes // TODO: Need to find a Lachlan func for this and account for floating point errors 
-	sFCU.sFlightControl.sOrient.s16TwistRoll = (Lint16)(acos((double)((f32vec1x * sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__A] + f32vec1y * sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__B] + f32vec1z * sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__C]) / sqrt((double)(sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__A] * sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__A] + sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__B] * sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__B] + sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__C] * sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__C])))) * 10000);  // TODO: Trig
-	// the discrepancy in roll measured by two triplets of lasers gives the twisting of the pod structure // TODO: check signs
-	sFCU.sFlightControl.sOrient.s16TwistRoll -= sFCU.sFlightControl.sOrient.s16Roll;
-}
-
-
-/** Calculate the pod's twisting due to the lack of perfect rigidity of the substructure: Bending */
-void vFCU_FLIGHTCTL_LASERORIENT__CalcTwistPitch(void)
-{
-	//Normal vector of the other plane
-	Lfloat32 f32vec1x = 0, f32vec1y = 1, f32vec1z = 0;
-
-	//Angle between two planes // TODO: Need to find a Lachlan func for this
-	sFCU.sFlightControl.sOrient.s16TwistPitch = (Lint16)(acos((double)((f32vec1x * sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__A] + f32vec1y * sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__B] + f32vec1z * sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__C]) / sqrt((double)(sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__A] * sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__A] + sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__B] * sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__B] + sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__C] * sFCU.sFlightControl.sOrient.f32TwistPlaneCoeffs[LASER_ORIENT__C])))) * 10000);  // TODO: Trig
-	// the discrepancy in pitch measured by two triplets of lasers gives the bending of the pod structure // TODO: check signs
-	sFCU.sFlightControl.sOrient.s16TwistPitch -= sFCU.sFlightControl.sOrient.s16Pitch;
-}
-
-
-/** Calculate the ground plane given three points */
-// uses plane eqn: Ax + By + Cz + D = 0
-void vFCU_FLIGHTCTL_LASERORIENT__CalculateGroundPlane(Luint8 u8A, Luint8 u8B, Luint8 u8C, Lfloat32 *pf32PlaneEqnCoeffs)
-{
-	Lfloat32 f32Vec1X, f32Vec1Y, f32Vec1Z;
-	Lfloat32 f32Vec2X, f32Vec2Y, f32Vec2Z;
-	Lfloat32 f32XProductX, f32XProductY, f32XProductZ;
-
-	//Calculate two vectors in the plane
-	f32Vec1X = sFCU.sFlightControl.sOrient.sGroundLasers[u8A].f32Position[LASER_ORIENT__X] - sFCU.sFlightControl.sOrient.sGroundLasers[u8B].f32Position[LASER_ORIENT__X];
-	f32Vec1Y = sFCU.sFlightControl.sOrient.sGroundLasers[u8A].f32Position[LASER_ORIENT__Y] - sFCU.sFlightControl.sOrient.sGroundLasers[u8B].f32Position[LASER_ORIENT__Y];
-	f32Vec1Z = (sFCU.sFlightControl.sOrient.sGroundLasers[u8A].f32Position[LASER_ORIENT__Z] - sFCU.sFlightControl.sOrient.sGroundLasers[u8A].f32Measurement) - (sFCU.sFlightControl.sOrient.sGroundLasers[u8B].f32Position[LASER_ORIENT__Z] - sFCU.sFlightControl.sOrient.sGroundLasers[u8B].f32Measurement);
-	f32Vec2X = sFCU.sFlightControl.sOrient.sGroundLasers[u8B].f32Position[LASER_ORIENT__X] - sFCU.sFlightControl.sOrient.sGroundLasers[u8C].f32Position[LASER_ORIENT__X];
-	f32Vec2Y = sFCU.sFlightControl.sOrient.sGroundLasers[u8B].f32Position[LASER_ORIENT__Y] - sFCU.sFlightControl.sOrient.sGroundLasers[u8C].f32Position[LASER_ORIENT__Y];
-	f32Vec2Z = (sFCU.sFlightControl.sOrient.sGroundLasers[u8B].f32Position[LASER_ORIENT__Z] - sFCU.sFlightControl.sOrient.sGroundLasers[u8B].f32Measurement) - (sFCU.sFlightControl.sOrient.sGroundLasers[u8C].f32Position[LASER_ORIENT__Z] - sFCU.sFlightControl.sOrient.sGroundLasers[u8C].f32Measurement);
-
-	//Calculate the cross product of the vectors
-	//to get a vector normal to the plane
-	f32XProductX = f32Vec1Y*f32Vec2Z - f32Vec1Z*f32Vec2Y;
-	f32XProductY = f32Vec1Z*f32Vec2X - f32Vec1X*f32Vec2Z;
-	f32XProductZ = f32Vec1X*f32Vec2Y - f32Vec1Y*f32Vec2X;
-
-	//The normal vector should be pointed in the +Z direction
-	//It affects which side of the plane has negative distances
-	if(f32XProductZ < 0)
-	{
-		f32XProductX *= -1;
-		f32XProductY *= -1;
-		f32XProductZ *= -1;
+		default:
+			//fall on
+			break;
 	}
-
-	//Plane in 3D: Ax + By + Cz + D = 0
-	//A, B, C is the vector normal to the plane
-	//Use one of our original points to calculate D
-	pf32PlaneEqnCoeffs[LASER_ORIENT__A] = f32XProductX;
-	pf32PlaneEqnCoeffs[LASER_ORIENT__B] = f32XProductY;
-	pf32PlaneEqnCoeffs[LASER_ORIENT__C] = f32XProductZ;
-
-	pf32PlaneEqnCoeffs[LASER_ORIENT__D] = -1 * (pf32PlaneEqnCoeffs[LASER_ORIENT__A] * sFCU.sFlightControl.sOrient.sGroundLasers[u8A].f32Position[LASER_ORIENT__X] + pf32PlaneEqnCoeffs[LASER_ORIENT__B] * sFCU.sFlightControl.sOrient.sGroundLasers[u8A].f32Position[LASER_ORIENT__Y] + pf32PlaneEqnCoeffs[LASER_ORIENT__C] * sFCU.sFlightControl.sOrient.sGroundLasers[u8A].f32Position[LASER_ORIENT__Z]);
-
 }
 
 
 /** Calculate the pod's yaw */
-void vFCU_FLIGHTCTL_LASERORIENT__CalcYaw(void)
+static void vFCU_FLIGHTCTL_LASERORIENT__CalcYaw(void)
 {
   Lfloat32 f32SDif = (Lfloat32)(sFCU.sFlightControl.sOrient.sBeamLasers[0].f32Measurement - sFCU.sFlightControl.sOrient.sBeamLasers[1].f32Measurement);
 
@@ -406,7 +333,7 @@ void vFCU_FLIGHTCTL_LASERORIENT__CalcYaw(void)
 
 
 /** Calculate the pod's lateral translation */
-void vFCU_FLIGHTCTL_LASERORIENT__CalcLateral(void) 
+static void vFCU_FLIGHTCTL_LASERORIENT__CalcLateral(void)
 {
   Lfloat32 f32XDif = (Lfloat32)(sFCU.sFlightControl.sOrient.sBeamLasers[0].f32Position[LASER_ORIENT__Z] - sFCU.sFlightControl.sOrient.sBeamLasers[1].f32Position[LASER_ORIENT__Z]);
 
@@ -414,7 +341,7 @@ void vFCU_FLIGHTCTL_LASERORIENT__CalcLateral(void)
       ((Lfloat32)(sFCU.sFlightControl.sOrient.sBeamLasers[1].f32Position[LASER_ORIENT__Z]) / f32XDif * sFCU.sFlightControl.sOrient.sBeamLasers[0].f32Measurement) -
       ((Lfloat32)(sFCU.sFlightControl.sOrient.sBeamLasers[0].f32Position[LASER_ORIENT__Z]) / f32XDif * sFCU.sFlightControl.sOrient.sBeamLasers[1].f32Measurement);
 
-  sFCU.sFlightControl.sOrient.f32Lateral = f32Coef* f32NUMERICAL_Cosine((Lfloat32)(sFCU.sFlightControl.sOrient.s16Yaw) / 10000.0);  // TODO: Trig
+  sFCU.sFlightControl.sOrient.f32Lateral = f32Coef* f32NUMERICAL_Cosine((Lfloat32)(sFCU.sFlightControl.sOrient.s16Yaw) / 10000.0F);  // TODO: Trig
 }
 
 
@@ -422,39 +349,51 @@ void vFCU_FLIGHTCTL_LASERORIENT__CalcLateral(void)
 /** Functions to retrieve orientation parameters, to be called from other files */
 
 /** Get pod's current Roll */
-Lint16 s16FCU_FLIGHTCTL_LASERORIENT__Get_Roll()
+Lint16 s16FCU_FLIGHTCTL_LASERORIENT__Get_Roll(void)
 {
-	return sFCU.sFlightControl.sOrient.s16Roll
+	return sFCU.sFlightControl.sOrient.s16Roll;
 }
 
 /** Get pod's current Pitch */
-Lint16 s16FCU_FLIGHTCTL_LASERORIENT__Get_Pitch()
+Lint16 s16FCU_FLIGHTCTL_LASERORIENT__Get_Pitch(void)
 {
-	return sFCU.sFlightControl.sOrient.s16Pitch
+	return sFCU.sFlightControl.sOrient.s16Pitch;
 }
 
 /** Get pod's current Yaw */
-Lint16 s16FCU_FLIGHTCTL_LASERORIENT__Get_Yaw()
+Lint16 s16FCU_FLIGHTCTL_LASERORIENT__Get_Yaw(void)
 {
-	return sFCU.sFlightControl.sOrient.s16Yaw
+	return sFCU.sFlightControl.sOrient.s16Yaw;
 }
 
 /** Get Lateral translation parameter */
-Lfloat32 f32FCU_FLIGHTCTL_LASERORIENT__Get_Lateral()
+Lfloat32 f32FCU_FLIGHTCTL_LASERORIENT__Get_Lateral(void)
 {
-	return sFCU.sFlightControl.sOrient.f32Lateral
+	return sFCU.sFlightControl.sOrient.f32Lateral;
 }
 
 /** Get pitch due to lack of perfect structural rigidity */
-Lint16 s16FCU_FLIGHTCTL_LASERORIENT__Get_TwistPitch()
+Lint16 s16FCU_FLIGHTCTL_LASERORIENT__Get_TwistPitch(void)
 {
-	return sFCU.sFlightControl.sOrient.s16TwistPitch
+	return sFCU.sFlightControl.sOrient.s16TwistPitch;
 }
 
 /** Get roll due to lack of perfect structural rigidity */
-Lint16 s16FCU_FLIGHTCTL_LASERORIENT__Get_TwistRoll()
+Lint16 s16FCU_FLIGHTCTL_LASERORIENT__Get_TwistRoll(void)
+{
+	return sFCU.sFlightControl.sOrient.s16TwistRoll;
+}
+
+/** Immediate return of a fault condition in the orientation solver */
+Luint8 u8FCU_FLIGHTCTL_LASERORIENT__Get_IsFault(void)
+{
+	return sFCU.sFlightControl.sOrient.sFaultFlags.u8FaultFlag;
+}
+
+/** Return the list of fault flag conditions */
+Luint32 u32FCU_FLIGHTCTL_LASERORIENT__Get_FaultFlags(void)
 {
-	return sFCU.sFlightControl.sOrient.s16TwistRoll
+	return sFCU.sFlightControl.sOrient.sFaultFlags.sTree.u32Flags[0];
 }
 
 
@@ -0,0 +1,43 @@
+#ifndef _LCCM655__05__FAULT_FLAGS_H_
+#define _LCCM655__05__FAULT_FLAGS_H_
+/*
+ * @fault_index
+ * 00
+ * 
+ * @brief
+ * GENERAL FAULT
+ * 
+ * A general fault has occurred in the laser orientation subsystem, check the
+ * other flags for more information. 
+*/
+#define C_LCCM655__LASER_ORIENT__FAULT_INDEX__00				0x00000000U
+#define C_LCCM655__LASER_ORIENT__FAULT_INDEX_MASK__00			0x00000001U
+
+/*
+ * @fault_index
+ * 01
+ * 
+ * @brief
+ * CROSS CHECK FAULT 
+ * 
+ * The fixed point angle solution and the floating point angle solution 
+ * disagree by more than C_FCU__LASER_ORIENT__XCHECK_LIMIT. 
+*/
+#define C_LCCM655__LASER_ORIENT__FAULT_INDEX__01				0x00000001U
+#define C_LCCM655__LASER_ORIENT__FAULT_INDEX_MASK__01			0x00000002U
+
+/*
+ * @fault_index
+ * 02
+ * 
+ * @brief
+ * GROUND PLANE FAULT 
+ * 
+ * The ground plane normal was zero length or did not point up, the lasers 
+ * are probably reporting garbage. 
+*/
+#define C_LCCM655__LASER_ORIENT__FAULT_INDEX__02				0x00000002U
+#define C_LCCM655__LASER_ORIENT__FAULT_INDEX_MASK__02			0x00000004U
+
+#endif //#ifndef _LCCM655__05__FAULT_FLAGS_H_
+
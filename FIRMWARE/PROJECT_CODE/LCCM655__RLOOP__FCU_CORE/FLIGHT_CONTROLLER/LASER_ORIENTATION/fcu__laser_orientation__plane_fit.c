@@ -0,0 +1,422 @@
+/**
+ * @file		FCU__LASER_ORIENTATION__PLANE_FIT.C
+ * @brief		Least squares ground plane through the healthy height lasers
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM655R0.FILE.039
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FCU
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FCU__FLIGHT_CTL__LASER_ORIENT_FIT
+ * @ingroup FCU
+ * @{ */
+
+// Each ground laser gives a point on the ground at {x, y, Zpos - measurement}.
+// We fit z = a + bx + cy through them.
+//
+// The laser positions never move, so the normal equations for every
+// combination of healthy lasers are solved once at init. An update is then
+// {a, b, c} = Gain[mask] * z + Prior[mask] * {a, b, c}last, which is a 3x4
+// and a 3x3 multiply.
+//
+// Masks that can't see both slopes (fewer than 3 lasers, or all in a line)
+// are regularised towards the last slopes, so we keep tracking height and
+// whatever slope the remaining lasers can see instead of dropping out.
+
+#include "../../fcu_core.h"
+
+#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_FCTL_ORIENTATION == 1U
+
+//the structure
+extern struct _strFCU sFCU;
+
+/** A 3 laser mask whose determinant is this small relative to its diagonal is a line */
+#define C_LASERORIENT_FIT__COLLINEAR					(1.0E-4F)
+
+//masks are a Luint8
+#if C_FCU__NUM_LASERS_GROUND > 7U
+	#error
+#endif
+
+static void vFCU_FLIGHTCTL_LASERORIENT_FIT__Ground(Lfloat32 *pf32Z);
+static void vFCU_FLIGHTCTL_LASERORIENT_FIT__Solve(Luint8 u8Mask, const Lfloat32 *pf32Z, Lfloat32 *pf32Coeffs);
+static void vFCU_FLIGHTCTL_LASERORIENT_FIT__To_Plane(const Lfloat32 *pf32Coeffs, Lfloat32 *pf32Plane);
+
+
+/***************************************************************************//**
+ * @brief
+ * Solve the normal equations for every laser mask.
+ * Call after the ground laser positions are loaded.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.039.FUNC.001
+ */
+void vFCU_FLIGHTCTL_LASERORIENT_FIT__Init(void)
+{
+	Luint8 u8Mask;
+	Luint8 u8Laser;
+	Luint8 u8Row;
+	Luint8 u8Col;
+	Luint8 u8Count;
+	Luint8 u8Regularise;
+	Lfloat32 f32M[3][3];
+	Lfloat32 f32Inv[3][3];
+	Lfloat32 f32Point[3];
+	Lfloat32 f32Det;
+	Lfloat32 f32Scale;
+	Lfloat32 f32Sum;
+
+	for(u8Mask = 0U; u8Mask < C_FCU__LASER_ORIENT__NUM_FIT_MASKS; u8Mask++)
+	{
+		//M = sum of {1, x, y}{1, x, y}' over the mask
+		for(u8Row = 0U; u8Row < 3U; u8Row++)
+		{
+			for(u8Col = 0U; u8Col < 3U; u8Col++)
+			{
+				f32M[u8Row][u8Col] = 0.0F;
+			}
+		}
+
+		u8Count = 0U;
+		for(u8Laser = 0U; u8Laser < C_FCU__NUM_LASERS_GROUND; u8Laser++)
+		{
+			if((u8Mask & (1U << u8Laser)) != 0U)
+			{
+				f32Point[0] = 1.0F;
+				f32Point[1] = sFCU.sFlightControl.sOrient.sGroundLasers[u8Laser].f32Position[LASER_ORIENT__X];
+				f32Point[2] = sFCU.sFlightControl.sOrient.sGroundLasers[u8Laser].f32Position[LASER_ORIENT__Y];
+				for(u8Row = 0U; u8Row < 3U; u8Row++)
+				{
+					for(u8Col = 0U; u8Col < 3U; u8Col++)
+					{
+						f32M[u8Row][u8Col] += f32Point[u8Row] * f32Point[u8Col];
+					}
+				}
+				u8Count++;
+			}
+			else
+			{
+				//not in this mask
+			}
+		}
+
+		f32Det = (f32M[0][0] * ((f32M[1][1] * f32M[2][2]) - (f32M[1][2] * f32M[2][1]))) -
+					(f32M[0][1] * ((f32M[1][0] * f32M[2][2]) - (f32M[1][2] * f32M[2][0]))) +
+					(f32M[0][2] * ((f32M[1][0] * f32M[2][1]) - (f32M[1][1] * f32M[2][0])));
+		f32Scale = f32M[0][0] * f32M[1][1] * f32M[2][2];
+
+		if((u8Count >= 3U) && (f32Det > (f32Scale * C_LASERORIENT_FIT__COLLINEAR)))
+		{
+			u8Regularise = 0U;
+		}
+		else
+		{
+			//hold the slopes we can't see
+			f32M[1][1] += C_FCU__LASER_ORIENT__PRIOR_WEIGHT;
+			f32M[2][2] += C_FCU__LASER_ORIENT__PRIOR_WEIGHT;
+			f32Det = (f32M[0][0] * ((f32M[1][1] * f32M[2][2]) - (f32M[1][2] * f32M[2][1]))) -
+						(f32M[0][1] * ((f32M[1][0] * f32M[2][2]) - (f32M[1][2] * f32M[2][0]))) +
+						(f32M[0][2] * ((f32M[1][0] * f32M[2][1]) - (f32M[1][1] * f32M[2][0])));
+			u8Regularise = 1U;
+		}
+
+		if(u8Count == 0U)
+		{
+			//nothing to fit, Update() checks the count
+			f32Det = 1.0F;
+		}
+		else
+		{
+			//fall on
+		}
+
+		//M is symmetric so the adjugate is too
+		f32Inv[0][0] = ((f32M[1][1] * f32M[2][2]) - (f32M[1][2] * f32M[2][1])) / f32Det;
+		f32Inv[0][1] = ((f32M[0][2] * f32M[2][1]) - (f32M[0][1] * f32M[2][2])) / f32Det;
+		f32Inv[0][2] = ((f32M[0][1] * f32M[1][2]) - (f32M[0][2] * f32M[1][1])) / f32Det;
+		f32Inv[1][1] = ((f32M[0][0] * f32M[2][2]) - (f32M[0][2] * f32M[2][0])) / f32Det;
+		f32Inv[1][2] = ((f32M[0][2] * f32M[1][0]) - (f32M[0][0] * f32M[1][2])) / f32Det;
+		f32Inv[2][2] = ((f32M[0][0] * f32M[1][1]) - (f32M[0][1] * f32M[1][0])) / f32Det;
+		f32Inv[1][0] = f32Inv[0][1];
+		f32Inv[2][0] = f32Inv[0][2];
+		f32Inv[2][1] = f32Inv[1][2];
+
+		//Gain = inv(M) * {1, x, y} for each laser in the mask
+		for(u8Laser = 0U; u8Laser < C_FCU__NUM_LASERS_GROUND; u8Laser++)
+		{
+			f32Point[0] = 1.0F;
+			f32Point[1] = sFCU.sFlightControl.sOrient.sGroundLasers[u8Laser].f32Position[LASER_ORIENT__X];
+			f32Point[2] = sFCU.sFlightControl.sOrient.sGroundLasers[u8Laser].f32Position[LASER_ORIENT__Y];
+			for(u8Row = 0U; u8Row < 3U; u8Row++)
+			{
+				if(((u8Mask & (1U << u8Laser)) != 0U) && (u8Count != 0U))
+				{
+					f32Sum = (f32Inv[u8Row][0] * f32Point[0]) + (f32Inv[u8Row][1] * f32Point[1]) + (f32Inv[u8Row][2] * f32Point[2]);
+				}
+				else
+				{
+					f32Sum = 0.0F;
+				}
+				sFCU.sFlightControl.sOrient.sFit.f32Gain[u8Mask][u8Row][u8Laser] = f32Sum;
+			}
+		}
+
+		//Prior = inv(M) * diag(0, w, w)
+		for(u8Row = 0U; u8Row < 3U; u8Row++)
+		{
+			sFCU.sFlightControl.sOrient.sFit.f32Prior[u8Mask][u8Row][0] = 0.0F;
+			if((u8Regularise == 1U) && (u8Count != 0U))
+			{
+				sFCU.sFlightControl.sOrient.sFit.f32Prior[u8Mask][u8Row][1] = f32Inv[u8Row][1] * C_FCU__LASER_ORIENT__PRIOR_WEIGHT;
+				sFCU.sFlightControl.sOrient.sFit.f32Prior[u8Mask][u8Row][2] = f32Inv[u8Row][2] * C_FCU__LASER_ORIENT__PRIOR_WEIGHT;
+			}
+			else
+			{
+				sFCU.sFlightControl.sOrient.sFit.f32Prior[u8Mask][u8Row][1] = 0.0F;
+				sFCU.sFlightControl.sOrient.sFit.f32Prior[u8Mask][u8Row][2] = 0.0F;
+			}
+		}
+
+		sFCU.sFlightControl.sOrient.sFit.u8Count[u8Mask] = u8Count;
+	}
+
+	//start from the pod sitting flat
+	sFCU.sFlightControl.sOrient.sFit.f32Coeffs[0] = 0.0F;
+	sFCU.sFlightControl.sOrient.sFit.f32Coeffs[1] = 0.0F;
+	sFCU.sFlightControl.sOrient.sFit.f32Coeffs[2] = 0.0F;
+	sFCU.sFlightControl.sOrient.sFit.u8Mask = 0U;
+	for(u8Laser = 0U; u8Laser < C_FCU__NUM_LASERS_GROUND; u8Laser++)
+	{
+		sFCU.sFlightControl.sOrient.sFit.f32Residual[u8Laser] = 0.0F;
+		sFCU.sFlightControl.sOrient.sFit.u32Rejected[u8Laser] = 0U;
+	}
+}
+
+
+/***************************************************************************//**
+ * @brief
+ * Fit the ground plane through the healthy lasers.
+ *
+ * While there are more lasers than unknowns and the fit doesn't agree with
+ * every laser to within C_FCU__LASER_ORIENT__OUTLIER_MM, the laser that has
+ * moved furthest from the last plane is dropped and the fit is redone.
+ * With 4 lasers the residuals alone can't say which laser is wrong, so the
+ * last plane is what picks it.
+ *
+ * @param[in]		u8Healthy				Bit per ground laser that is working
+ * @param[out]		*pf32Plane				Plane A, B, C, D with C > 0
+ * @return			Mask of the lasers in the fit, 0 = no fit, plane not updated
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.039.FUNC.002
+ */
+Luint8 u8FCU_FLIGHTCTL_LASERORIENT_FIT__Update(Luint8 u8Healthy, Lfloat32 *pf32Plane)
+{
+	Lfloat32 f32Z[C_FCU__NUM_LASERS_GROUND];
+	Lfloat32 f32Coeffs[3];
+	Lfloat32 f32Error;
+	Lfloat32 f32WorstResidual;
+	Lfloat32 f32WorstMove;
+	Luint8 u8Mask;
+	Luint8 u8Laser;
+	Luint8 u8Worst;
+	Luint8 u8Stop;
+
+	u8Mask = u8Healthy & (Luint8)(C_FCU__LASER_ORIENT__NUM_FIT_MASKS - 1U);
+
+	if(sFCU.sFlightControl.sOrient.sFit.u8Count[u8Mask] != 0U)
+	{
+		vFCU_FLIGHTCTL_LASERORIENT_FIT__Ground(&f32Z[0]);
+
+		u8Stop = 0U;
+		while(u8Stop == 0U)
+		{
+			vFCU_FLIGHTCTL_LASERORIENT_FIT__Solve(u8Mask, &f32Z[0], &f32Coeffs[0]);
+
+			f32WorstResidual = 0.0F;
+			f32WorstMove = -1.0F;
+			u8Worst = 0U;
+			for(u8Laser = 0U; u8Laser < C_FCU__NUM_LASERS_GROUND; u8Laser++)
+			{
+				if((u8Mask & (1U << u8Laser)) != 0U)
+				{
+					f32Error = f32Z[u8Laser] - (f32Coeffs[0] +
+								(f32Coeffs[1] * sFCU.sFlightControl.sOrient.sGroundLasers[u8Laser].f32Position[LASER_ORIENT__X]) +
+								(f32Coeffs[2] * sFCU.sFlightControl.sOrient.sGroundLasers[u8Laser].f32Position[LASER_ORIENT__Y]));
+					sFCU.sFlightControl.sOrient.sFit.f32Residual[u8Laser] = f32Error;
+					f32Error = f32NUMERICAL_FLOAT__ABS(f32Error);
+					if(f32Error > f32WorstResidual)
+					{
+						f32WorstResidual = f32Error;
+					}
+					else
+					{
+						//fall on
+					}
+
+					//distance from the last plane
+					f32Error = f32Z[u8Laser] - (sFCU.sFlightControl.sOrient.sFit.f32Coeffs[0] +
+								(sFCU.sFlightControl.sOrient.sFit.f32Coeffs[1] * sFCU.sFlightControl.sOrient.sGroundLasers[u8Laser].f32Position[LASER_ORIENT__X]) +
+								(sFCU.sFlightControl.sOrient.sFit.f32Coeffs[2] * sFCU.sFlightControl.sOrient.sGroundLasers[u8Laser].f32Position[LASER_ORIENT__Y]));
+					f32Error = f32NUMERICAL_FLOAT__ABS(f32Error);
+					if(f32Error > f32WorstMove)
+					{
+						f32WorstMove = f32Error;
+						u8Worst = u8Laser;
+					}
+					else
+					{
+						//fall on
+					}
+				}
+				else
+				{
+					sFCU.sFlightControl.sOrient.sFit.f32Residual[u8Laser] = 0.0F;
+				}
+			}
+
+			if((sFCU.sFlightControl.sOrient.sFit.u8Count[u8Mask] > 3U) && (f32WorstResidual > C_FCU__LASER_ORIENT__OUTLIER_MM))
+			{
+				u8Mask &= (Luint8)(~(1U << u8Worst));
+				sFCU.sFlightControl.sOrient.sFit.u32Rejected[u8Worst]++;
+			}
+			else
+			{
+				//can't do any better
+				u8Stop = 1U;
+			}
+		}
+
+		sFCU.sFlightControl.sOrient.sFit.f32Coeffs[0] = f32Coeffs[0];
+		sFCU.sFlightControl.sOrient.sFit.f32Coeffs[1] = f32Coeffs[1];
+		sFCU.sFlightControl.sOrient.sFit.f32Coeffs[2] = f32Coeffs[2];
+		vFCU_FLIGHTCTL_LASERORIENT_FIT__To_Plane(&f32Coeffs[0], pf32Plane);
+	}
+	else
+	{
+		//no lasers
+		u8Mask = 0U;
+	}
+
+	sFCU.sFlightControl.sOrient.sFit.u8Mask = u8Mask;
+
+	return u8Mask;
+}
+
+
+/***************************************************************************//**
+ * @brief
+ * Fit a plane through a fixed set of lasers, no outlier rejection and the
+ * main fit is left alone. Used for the twist plane.
+ *
+ * @param[in]		u8Mask					Lasers to fit, must have a count
+ * @param[out]		*pf32Plane				Plane A, B, C, D with C > 0
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.039.FUNC.003
+ */
+void vFCU_FLIGHTCTL_LASERORIENT_FIT__Mask(Luint8 u8Mask, Lfloat32 *pf32Plane)
+{
+	Lfloat32 f32Z[C_FCU__NUM_LASERS_GROUND];
+	Lfloat32 f32Coeffs[3];
+
+	vFCU_FLIGHTCTL_LASERORIENT_FIT__Ground(&f32Z[0]);
+	vFCU_FLIGHTCTL_LASERORIENT_FIT__Solve(u8Mask & (Luint8)(C_FCU__LASER_ORIENT__NUM_FIT_MASKS - 1U), &f32Z[0], &f32Coeffs[0]);
+	vFCU_FLIGHTCTL_LASERORIENT_FIT__To_Plane(&f32Coeffs[0], pf32Plane);
+}
+
+
+/***************************************************************************//**
+ * @brief
+ * Height of the ground under each laser.
+ *
+ * @param[out]		*pf32Z					Ground z per laser
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.039.FUNC.004
+ */
+static void vFCU_FLIGHTCTL_LASERORIENT_FIT__Ground(Lfloat32 *pf32Z)
+{
+	Luint8 u8Laser;
+
+	for(u8Laser = 0U; u8Laser < C_FCU__NUM_LASERS_GROUND; u8Laser++)
+	{
+		pf32Z[u8Laser] = sFCU.sFlightControl.sOrient.sGroundLasers[u8Laser].f32Position[LASER_ORIENT__Z] - sFCU.sFlightControl.sOrient.sGroundLasers[u8Laser].f32Measurement;
+	}
+}
+
+
+/***************************************************************************//**
+ * @brief
+ * {a, b, c} = Gain * z + Prior * {a, b, c}last
+ *
+ * @param[in]		u8Mask					Lasers in the fit
+ * @param[in]		*pf32Z					Ground z per laser
+ * @param[out]		*pf32Coeffs				{a, b, c}
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.039.FUNC.005
+ */
+static void vFCU_FLIGHTCTL_LASERORIENT_FIT__Solve(Luint8 u8Mask, const Lfloat32 *pf32Z, Lfloat32 *pf32Coeffs)
+{
+	Luint8 u8Row;
+	Luint8 u8Laser;
+	Lfloat32 f32Sum;
+
+	for(u8Row = 0U; u8Row < 3U; u8Row++)
+	{
+		//lasers outside the mask have a zero gain
+		f32Sum = 0.0F;
+		for(u8Laser = 0U; u8Laser < C_FCU__NUM_LASERS_GROUND; u8Laser++)
+		{
+			f32Sum += sFCU.sFlightControl.sOrient.sFit.f32Gain[u8Mask][u8Row][u8Laser] * pf32Z[u8Laser];
+		}
+
+		//the intercept column of the prior is always zero
+		f32Sum += sFCU.sFlightControl.sOrient.sFit.f32Prior[u8Mask][u8Row][1] * sFCU.sFlightControl.sOrient.sFit.f32Coeffs[1];
+		f32Sum += sFCU.sFlightControl.sOrient.sFit.f32Prior[u8Mask][u8Row][2] * sFCU.sFlightControl.sOrient.sFit.f32Coeffs[2];
+
+		pf32Coeffs[u8Row] = f32Sum;
+	}
+}
+
+
+/***************************************************************************//**
+ * @brief
+ * z = a + bx + cy as Ax + By + Cz + D = 0 with the normal pointing up
+ *
+ * @param[in]		*pf32Coeffs				{a, b, c}
+ * @param[out]		*pf32Plane				A, B, C, D
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.039.FUNC.006
+ */
+static void vFCU_FLIGHTCTL_LASERORIENT_FIT__To_Plane(const Lfloat32 *pf32Coeffs, Lfloat32 *pf32Plane)
+{
+	pf32Plane[LASER_ORIENT__A] = -pf32Coeffs[1];
+	pf32Plane[LASER_ORIENT__B] = -pf32Coeffs[2];
+	pf32Plane[LASER_ORIENT__C] = 1.0F;
+	pf32Plane[LASER_ORIENT__D] = -pf32Coeffs[0];
+}
+
+
+#endif //C_LOCALDEF__LCCM655__ENABLE_FCTL_ORIENTATION
+#ifndef C_LOCALDEF__LCCM655__ENABLE_FCTL_ORIENTATION
+	#error
+#endif
+#endif //C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL
+#ifndef C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL
+	#error
+#endif
+#endif //#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
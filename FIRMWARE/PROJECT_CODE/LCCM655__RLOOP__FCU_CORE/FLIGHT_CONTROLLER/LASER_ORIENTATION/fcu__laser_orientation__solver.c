@@ -0,0 +1,329 @@
+/**
+ * @file		FCU__LASER_ORIENTATION__SOLVER.C
+ * @brief		Ground plane solver, fixed point angles with a float cross check
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM655R0.FILE.037
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FCU
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FCU__FLIGHT_CTL__LASER_ORIENT_SOLVE
+ * @ingroup FCU
+ * @{ */
+
+// The plane is normalised once per solve, everything after that is a
+// multiply-add. Roll and pitch come out of a table driven integer atan2 which
+// is the answer we use, the float atan is only there to check it.
+//
+// Angles are radians x 10000 to match the rest of sOrient:
+// roll = atan2(B, C), rotation about +x
+// pitch = atan2(A, C), rotation about +y
+// both are zero when the pod sits level.
+
+#include "../../fcu_core.h"
+
+#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_FCTL_ORIENTATION == 1U
+
+//the structure
+extern struct _strFCU sFCU;
+
+/** atan(k/64) for k = 0..64, radians Q16 */
+static const Luint16 u16FCU_LASERORIENT_SOLVE__AtanTable[65U] =
+{
+	     0U,   1024U,   2047U,   3070U,   4091U,   5110U,   6126U,   7140U,
+	  8150U,   9156U,  10158U,  11155U,  12147U,  13133U,  14114U,  15088U,
+	 16055U,  17015U,  17968U,  18913U,  19850U,  20779U,  21699U,  22610U,
+	 23512U,  24406U,  25289U,  26163U,  27028U,  27882U,  28727U,  29561U,
+	 30386U,  31200U,  32003U,  32797U,  33580U,  34353U,  35115U,  35867U,
+	 36608U,  37340U,  38060U,  38771U,  39472U,  40162U,  40842U,  41512U,
+	 42172U,  42823U,  43464U,  44095U,  44716U,  45328U,  45931U,  46525U,
+	 47109U,  47685U,  48251U,  48809U,  49359U,  49899U,  50432U,  50956U,
+	 51472U
+};
+
+/** pi/2 and pi in radians Q16 */
+#define C_LASERORIENT_SOLVE__HALF_PI_Q16			(102944U)
+#define C_LASERORIENT_SOLVE__PI_Q16					(205887U)
+
+/** Smallest |n|^2 we will normalise, below this the lasers are coincident */
+#define C_LASERORIENT_SOLVE__MIN_MAG2				(1.0E-6F)
+
+static void vFCU_FLIGHTCTL_LASERORIENT_SOLVE__Fault(Luint32 u32Index);
+
+
+/***************************************************************************//**
+ * @brief
+ * Pack the hover engine positions into the {x, y, z, 1} matrix the height
+ * batch runs over. Call after the positions are loaded.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.037.FUNC.001
+ */
+void vFCU_FLIGHTCTL_LASERORIENT_SOLVE__Init(void)
+{
+	Luint8 u8Counter;
+
+	for(u8Counter = 0U; u8Counter < C_FCU__NUM_HOVER_ENGINES; u8Counter++)
+	{
+		sFCU.sFlightControl.sOrient.f32EngineMatrix[u8Counter][LASER_ORIENT__X] = sFCU.sFlightControl.sOrient.sHoverEngines[u8Counter].f32Position[LASER_ORIENT__X];
+		sFCU.sFlightControl.sOrient.f32EngineMatrix[u8Counter][LASER_ORIENT__Y] = sFCU.sFlightControl.sOrient.sHoverEngines[u8Counter].f32Position[LASER_ORIENT__Y];
+		sFCU.sFlightControl.sOrient.f32EngineMatrix[u8Counter][LASER_ORIENT__Z] = sFCU.sFlightControl.sOrient.sHoverEngines[u8Counter].f32Position[LASER_ORIENT__Z];
+		sFCU.sFlightControl.sOrient.f32EngineMatrix[u8Counter][3] = 1.0F;
+	}
+
+	sFCU.sFlightControl.sOrient.sCrossCheck.s16FloatRoll = 0;
+	sFCU.sFlightControl.sOrient.sCrossCheck.s16FloatPitch = 0;
+	sFCU.sFlightControl.sOrient.sCrossCheck.u16WorstError = 0U;
+	sFCU.sFlightControl.sOrient.sCrossCheck.u32Fails = 0U;
+
+	vFAULTLINK__Init(&sFCU.sFlightControl.sOrient.sFaultFlags);
+}
+
+
+/***************************************************************************//**
+ * @brief
+ * Normalise a ground plane and solve its roll and pitch.
+ *
+ * The fixed point angles are returned, the float angles are kept in
+ * sCrossCheck and a fault is raised if the two disagree.
+ *
+ * @param[in]		*pf32Plane				Plane A, B, C, D from the lasers
+ * @param[out]		*pf32Norm				Plane scaled to a unit normal
+ * @param[out]		*ps16Roll				Roll, radians x 10000
+ * @param[out]		*ps16Pitch				Pitch, radians x 10000
+ * @return			0 = solved\n
+ * 					1 = fault, angles not updated
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.037.FUNC.002
+ */
+Luint8 u8FCU_FLIGHTCTL_LASERORIENT_SOLVE__Plane(const Lfloat32 *pf32Plane, Lfloat32 *pf32Norm, Lint16 *ps16Roll, Lint16 *ps16Pitch)
+{
+	Lfloat32 f32Mag2;
+	Lfloat32 f32InvMag;
+	Lint32 s32A;
+	Lint32 s32B;
+	Lint32 s32C;
+	Lint16 s16Roll;
+	Lint16 s16Pitch;
+	Lint16 s16FloatRoll;
+	Lint16 s16FloatPitch;
+	Luint16 u16ErrRoll;
+	Luint16 u16ErrPitch;
+	Luint8 u8Return;
+
+	f32Mag2 = (pf32Plane[LASER_ORIENT__A] * pf32Plane[LASER_ORIENT__A]) +
+				(pf32Plane[LASER_ORIENT__B] * pf32Plane[LASER_ORIENT__B]) +
+				(pf32Plane[LASER_ORIENT__C] * pf32Plane[LASER_ORIENT__C]);
+
+	//the plane solver points the normal up, if it doesn't the fit is junk
+	if((f32Mag2 > C_LASERORIENT_SOLVE__MIN_MAG2) && (pf32Plane[LASER_ORIENT__C] > 0.0F))
+	{
+		//the only sqrt and divide of the solve
+		f32InvMag = 1.0F / f32NUMERICAL_FLOAT__SQRT(f32Mag2);
+		pf32Norm[LASER_ORIENT__A] = pf32Plane[LASER_ORIENT__A] * f32InvMag;
+		pf32Norm[LASER_ORIENT__B] = pf32Plane[LASER_ORIENT__B] * f32InvMag;
+		pf32Norm[LASER_ORIENT__C] = pf32Plane[LASER_ORIENT__C] * f32InvMag;
+		pf32Norm[LASER_ORIENT__D] = pf32Plane[LASER_ORIENT__D] * f32InvMag;
+
+		//unit normal into Q15, |n| <= 1 so these are bounded to +/-32768
+		s32A = (Lint32)(pf32Norm[LASER_ORIENT__A] * 32768.0F);
+		s32B = (Lint32)(pf32Norm[LASER_ORIENT__B] * 32768.0F);
+		s32C = (Lint32)(pf32Norm[LASER_ORIENT__C] * 32768.0F);
+
+		s16Roll = s16FCU_FLIGHTCTL_LASERORIENT_SOLVE__Atan2(s32B, s32C);
+		s16Pitch = s16FCU_FLIGHTCTL_LASERORIENT_SOLVE__Atan2(s32A, s32C);
+
+		//float path, C > 0 here so atan(y/x) is atan2(y, x)
+		s16FloatRoll = (Lint16)(f32NUMERICAL_Atan(pf32Norm[LASER_ORIENT__B] / pf32Norm[LASER_ORIENT__C]) * 10000.0F);
+		s16FloatPitch = (Lint16)(f32NUMERICAL_Atan(pf32Norm[LASER_ORIENT__A] / pf32Norm[LASER_ORIENT__C]) * 10000.0F);
+
+		sFCU.sFlightControl.sOrient.sCrossCheck.s16FloatRoll = s16FloatRoll;
+		sFCU.sFlightControl.sOrient.sCrossCheck.s16FloatPitch = s16FloatPitch;
+
+		u16ErrRoll = (Luint16)s32NUMERICAL__ABS((Lint32)s16Roll - (Lint32)s16FloatRoll);
+		u16ErrPitch = (Luint16)s32NUMERICAL__ABS((Lint32)s16Pitch - (Lint32)s16FloatPitch);
+		if(u16ErrPitch > u16ErrRoll)
+		{
+			u16ErrRoll = u16ErrPitch;
+		}
+		else
+		{
+			//roll is the worst
+		}
+
+		if(u16ErrRoll > sFCU.sFlightControl.sOrient.sCrossCheck.u16WorstError)
+		{
+			sFCU.sFlightControl.sOrient.sCrossCheck.u16WorstError = u16ErrRoll;
+		}
+		else
+		{
+			//fall on
+		}
+
+		if(u16ErrRoll > C_FCU__LASER_ORIENT__XCHECK_LIMIT)
+		{
+			//one of the two paths is wrong and we can't tell which
+			sFCU.sFlightControl.sOrient.sCrossCheck.u32Fails++;
+			vFCU_FLIGHTCTL_LASERORIENT_SOLVE__Fault(C_LCCM655__LASER_ORIENT__FAULT_INDEX__01);
+			u8Return = 1U;
+		}
+		else
+		{
+			*ps16Roll = s16Roll;
+			*ps16Pitch = s16Pitch;
+			u8Return = 0U;
+		}
+	}
+	else
+	{
+		vFCU_FLIGHTCTL_LASERORIENT_SOLVE__Fault(C_LCCM655__LASER_ORIENT__FAULT_INDEX__02);
+		u8Return = 1U;
+	}
+
+	return u8Return;
+}
+
+
+/***************************************************************************//**
+ * @brief
+ * Hover engine heights above a normalised plane.
+ *
+ * One pass over the 8x4 engine matrix, each height is the dot product of
+ * {x, y, z, 1} with {A, B, C, D}.
+ *
+ * @param[in]		*pf32Norm				Plane from u8FCU_FLIGHTCTL_LASERORIENT_SOLVE__Plane()
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.037.FUNC.003
+ */
+void vFCU_FLIGHTCTL_LASERORIENT_SOLVE__Heights(const Lfloat32 *pf32Norm)
+{
+	Luint8 u8Counter;
+	Lfloat32 f32A;
+	Lfloat32 f32B;
+	Lfloat32 f32C;
+	Lfloat32 f32D;
+	const Lfloat32 *pf32Row;
+
+	//keep the plane in registers for the whole batch
+	f32A = pf32Norm[LASER_ORIENT__A];
+	f32B = pf32Norm[LASER_ORIENT__B];
+	f32C = pf32Norm[LASER_ORIENT__C];
+	f32D = pf32Norm[LASER_ORIENT__D];
+
+	for(u8Counter = 0U; u8Counter < C_FCU__NUM_HOVER_ENGINES; u8Counter++)
+	{
+		pf32Row = &sFCU.sFlightControl.sOrient.f32EngineMatrix[u8Counter][0];
+		sFCU.sFlightControl.sOrient.sHoverEngines[u8Counter].f32Measurement = (pf32Row[0] * f32A) + (pf32Row[1] * f32B) + (pf32Row[2] * f32C) + (pf32Row[3] * f32D);
+	}
+}
+
+
+/***************************************************************************//**
+ * @brief
+ * Integer atan2.
+ *
+ * The octant is folded with masks rather than branches, the first octant
+ * comes from a 64 segment table with linear interpolation. Worst case error
+ * is about 0.5 of an output count.
+ *
+ * @param[in]		s32Y					Y, Q15, |Y| <= 32768
+ * @param[in]		s32X					X, Q15, |X| <= 32768
+ * @return			atan2(Y, X) in radians x 10000
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.037.FUNC.004
+ */
+Lint16 s16FCU_FLIGHTCTL_LASERORIENT_SOLVE__Atan2(Lint32 s32Y, Lint32 s32X)
+{
+	Luint32 u32SignY;
+	Luint32 u32SignX;
+	Luint32 u32AbsY;
+	Luint32 u32AbsX;
+	Luint32 u32Swap;
+	Luint32 u32Min;
+	Luint32 u32Max;
+	Luint32 u32Ratio;
+	Luint32 u32Index;
+	Luint32 u32Frac;
+	Luint32 u32Angle;
+	Lint32 s32Return;
+
+	//all ones if negative
+	u32SignY = 0U - ((Luint32)s32Y >> 31U);
+	u32SignX = 0U - ((Luint32)s32X >> 31U);
+	u32AbsY = ((Luint32)s32Y ^ u32SignY) - u32SignY;
+	u32AbsX = ((Luint32)s32X ^ u32SignX) - u32SignX;
+
+	//all ones if we are above the diagonal
+	u32Swap = 0U - (Luint32)(u32AbsY > u32AbsX);
+	u32Min = u32AbsY ^ ((u32AbsY ^ u32AbsX) & u32Swap);
+	u32Max = u32AbsX ^ ((u32AbsY ^ u32AbsX) & u32Swap);
+
+	//atan2(0, 0) comes out as 0
+	u32Max += (Luint32)(u32Max == 0U);
+
+	//min/max in Q15, 0..32768
+	u32Ratio = (u32Min << 15U) / u32Max;
+	u32Index = u32Ratio >> 9U;
+	u32Frac = u32Ratio & 0x1FFU;
+
+	//the last segment would read past the table when ratio is exactly 1
+	u32Index -= (Luint32)(u32Index == 64U);
+	u32Frac += (Luint32)(u32Ratio == 32768U) << 9U;
+
+	u32Angle = (Luint32)u16FCU_LASERORIENT_SOLVE__AtanTable[u32Index];
+	u32Angle += (((Luint32)u16FCU_LASERORIENT_SOLVE__AtanTable[u32Index + 1U] - u32Angle) * u32Frac) >> 9U;
+
+	//unfold: above the diagonal is pi/2 - a, left half plane is pi - a
+	u32Angle += (C_LASERORIENT_SOLVE__HALF_PI_Q16 - (u32Angle << 1U)) & u32Swap;
+	u32Angle += (C_LASERORIENT_SOLVE__PI_Q16 - (u32Angle << 1U)) & u32SignX;
+
+	//Q16 to x 10000, pi x 10000 x 65536 still fits
+	u32Angle = ((u32Angle * 10000U) + 32768U) >> 16U;
+
+	//negative Y is the lower half plane
+	s32Return = (Lint32)((u32Angle ^ u32SignY) - u32SignY);
+
+	return (Lint16)s32Return;
+}
+
+
+/***************************************************************************//**
+ * @brief
+ * Latch an orientation fault
+ *
+ * @param[in]		u32Index				C_LCCM655__LASER_ORIENT__FAULT_INDEX__xx
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.037.FUNC.005
+ */
+static void vFCU_FLIGHTCTL_LASERORIENT_SOLVE__Fault(Luint32 u32Index)
+{
+	vFAULTLINK__Set_Flag(&sFCU.sFlightControl.sOrient.sFaultFlags, C_LCCM655__LASER_ORIENT__FAULT_INDEX__00);
+	vFAULTLINK__Set_Flag(&sFCU.sFlightControl.sOrient.sFaultFlags, u32Index);
+}
+
+
+#endif //C_LOCALDEF__LCCM655__ENABLE_FCTL_ORIENTATION
+#ifndef C_LOCALDEF__LCCM655__ENABLE_FCTL_ORIENTATION
+	#error
+#endif
+#endif //C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL
+#ifndef C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL
+	#error
+#endif
+#endif //#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
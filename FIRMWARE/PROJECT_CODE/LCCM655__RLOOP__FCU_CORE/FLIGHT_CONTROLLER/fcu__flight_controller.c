@@ -36,7 +36,7 @@ void vFCU_FLIGHTCTL__Init(void)
 
 	#if C_LOCALDEF__LCCM655__ENABLE_FCTL_ORIENTATION == 1U
 		//setup laser orientation module
-		vFCU_FLIGHTCLT_LASERORIENT__Init();
+		vFCU_FLIGHTCTL_LASERORIENT__Init();
 	#endif
 
 	#if C_LOCALDEF__LCCM655__ENABLE_FCTL_CONTRAST_NAV == 1U
@@ -58,7 +58,7 @@ void vFCU_FLIGHTCTL__Process(void)
 {
 
 	#if C_LOCALDEF__LCCM655__ENABLE_FCTL_ORIENTATION == 1U
-		vFCU_FLIGHTCLT_LASERORIENT__Process();
+		vFCU_FLIGHTCTL_LASERORIENT__Process();
 	#endif
 
 	#if C_LOCALDEF__LCCM655__ENABLE_FCTL_CONTRAST_NAV == 1U
@@ -3,6 +3,11 @@
  * @brief		Management of a timing list based on edges.
  * 				Purpose of this module is to maintian a timing list of
  * 				rising and falling edges of a sensor
+ *
+ * 				The ISR only timestamps the edge into a ring. The main loop
+ * 				drains the ring and for each edge works out if it is a real
+ * 				stripe, how many stripes it covers, and the velocity, all at
+ * 				a fixed cost per edge.
  * @author		Lachlan Grogan
  * @copyright	rLoop Inc.
  */
@@ -22,8 +27,33 @@
 #include "../../fcu_core.h"
 #if C_LOCALDEF__LCCM655__ENABLE_LASER_CONTRAST == 1U
 
+#if (C_FCU__LASER_CONTRAST__RING_SIZE & (C_FCU__LASER_CONTRAST__RING_SIZE - 1U)) != 0U
+	#error "C_FCU__LASER_CONTRAST__RING_SIZE must be a power of 2"
+#endif
+
+/** Shortest real stripe interval, one pitch at the max velocity */
+#define C_LASERCONT_TL__MIN_TICKS		((C_FCU__LASER_CONTRAST__STRIPE_MM * (C_FCU__LASER_CONTRAST__TICKS_PER_SEC / 1000U)) / (C_FCU__LASER_CONTRAST__MAX_VELOC_MMS / 1000U))
+
 extern struct _strFCU sFCU;
 
+/** Distance of each sensor behind the FWD sensor */
+static const Luint32 u32LASERCONT_TL__Offset_mm[LASER_CONT__MAX] =
+{
+	0U,
+	C_FCU__LASER_CONTRAST__MID_OFFSET_MM,
+	C_FCU__LASER_CONTRAST__AFT_OFFSET_MM
+};
+
+//locals
+static void vFCU_LASERCONT_TL__Rising(Luint8 u8Laser, Luint64 u64Time);
+static void vFCU_LASERCONT_TL__Falling(Luint8 u8Laser, Luint64 u64Time);
+static Luint8 u8FCU_LASERCONT_TL__Classify(Luint8 u8Laser, Luint32 u32Interval);
+static void vFCU_LASERCONT_TL__Window(Lfloat32 f32Veloc, Lfloat32 f32Spread, Lfloat32 f32Distance, Lfloat32 *pf32Min, Lfloat32 *pf32Max);
+static Lint32 s32FCU_LASERCONT_TL__First_Stripe(Luint8 u8Laser);
+static void vFCU_LASERCONT_TL__Cross(Luint8 u8Laser, Luint64 u64Time);
+static Lint32 s32FCU_LASERCONT_TL__Estimate(Luint8 u8Laser, Luint64 u64Time);
+static void vFCU_LASERCONT_TL__Fault(Luint32 u32Index);
+
 /***************************************************************************//**
  * @brief
  * Init the timing list
@@ -32,44 +62,80 @@ extern struct _strFCU sFCU;
 void vFCU_LASERCONT_TL__Init(void)
 {
 	Luint8 u8LaserCount;
-	Luint32 u32ListCount;
+
+	//empty ring
+	sFCU.sContrast.sRing.u16Head = 0U;
+	sFCU.sContrast.sRing.u16Tail = 0U;
+	sFCU.sContrast.sRing.u32Overflow = 0U;
 
 	//clear the lists
 	for(u8LaserCount = 0U; u8LaserCount < (Luint8)LASER_CONT__MAX; u8LaserCount++)
 	{
-		//clear the stripe counters.
-		for(u32ListCount = 0U; u32ListCount < C_FCU__LASER_CONTRAST__MAX_STRIPES; u32ListCount++)
-		{
-			sFCU.sContrast.sTimingList[u8LaserCount].u64RisingList[u32ListCount] = 0U;
-			sFCU.sContrast.sTimingList[u8LaserCount].u64FallingList[u32ListCount] = 0U;
-		}
+		sFCU.sContrast.sTimingList[u8LaserCount].u64LastRising = 0U;
+		sFCU.sContrast.sTimingList[u8LaserCount].u64LastFalling = 0U;
+		sFCU.sContrast.sTimingList[u8LaserCount].u32Interval = 0U;
+		sFCU.sContrast.sTimingList[u8LaserCount].u32Width = 0U;
+		sFCU.sContrast.sTimingList[u8LaserCount].s32Stripe = 0;
+		sFCU.sContrast.sTimingList[u8LaserCount].u32Veloc_mms = 0U;
 
 		//clear the counts
 		sFCU.sContrast.sTimingList[u8LaserCount].u16RisingCount = 0U;
 		sFCU.sContrast.sTimingList[u8LaserCount].u16FallingCount = 0U;
+		sFCU.sContrast.sTimingList[u8LaserCount].u32Glitches = 0U;
+		sFCU.sContrast.sTimingList[u8LaserCount].u32Missed = 0U;
+		sFCU.sContrast.sTimingList[u8LaserCount].u32Resync = 0U;
 
 	}
 
+	sFCU.sContrast.sVeloc.u32Cross_mms = 0U;
+	sFCU.sContrast.sVeloc.u32Veloc_mms = 0U;
+	sFCU.sContrast.sVeloc.u32Mismatch = 0U;
+
+	vFAULTLINK__Init(&sFCU.sContrast.sFaultFlags);
+
 }
 
 /***************************************************************************//**
  * @brief
  * Process the laser contrast list system
  *
+ * Drains every edge the ISR has queued since the last call.
+ *
  */
 void vFCU_LASERCONT_TL__Process(void)
 {
+	Luint16 u16Head;
+	Luint16 u16Pos;
 
-	//We need to do a couple of tasks here
+	//edges the ISR couldn't store are gone, the counts will be short
+	if(sFCU.sContrast.sRing.u32Overflow != 0U)
+	{
+		vFCU_LASERCONT_TL__Fault(C_LCCM655__LASER_CONT__FAULT_INDEX__01);
+	}
+	else
+	{
+		//fall on
+	}
 
-	//1.See if we got a new edge
+	//take one look at the head, anything the ISR adds after this waits for the next call
+	u16Head = sFCU.sContrast.sRing.u16Head;
 
-	//2.Compute the time distance between the stripes
-	//This could be run constantly so as we keep a consistent CPU load.
+	while(sFCU.sContrast.sRing.u16Tail != u16Head)
+	{
+		u16Pos = sFCU.sContrast.sRing.u16Tail & (Luint16)(C_FCU__LASER_CONTRAST__RING_SIZE - 1U);
 
-	//3. Update a rolling database of markers passed
+		if(sFCU.sContrast.sRing.sEdge[u16Pos].u8Rising == 1U)
+		{
+			vFCU_LASERCONT_TL__Rising(sFCU.sContrast.sRing.sEdge[u16Pos].u8Laser, sFCU.sContrast.sRing.sEdge[u16Pos].u64Time);
+		}
+		else
+		{
+			vFCU_LASERCONT_TL__Falling(sFCU.sContrast.sRing.sEdge[u16Pos].u8Laser, sFCU.sContrast.sRing.sEdge[u16Pos].u64Time);
+		}
 
-	//4. Handle any error rejection.
+		//release the slot back to the ISR
+		sFCU.sContrast.sRing.u16Tail++;
+	}
 }
 
 /***************************************************************************//**
@@ -93,17 +159,17 @@ void vFCU_LASERCONT_TL__ISR(E_FCU__LASER_CONT_INDEX_T eLaser, Luint32 u32Registe
 	{
 		case LASER_CONT__FWD:
 			//generate the mask for this laser
-			u32Mask = (1U << 6U) ^ 0xFFFFFFFFU;
+			u32Mask = 1U << 6U;
 			break;
 
 		case LASER_CONT__MID:
 			//generate the mask for this laser
-			u32Mask = (1U << 7U) ^ 0xFFFFFFFFU;
+			u32Mask = 1U << 7U;
 			break;
 
 		case LASER_CONT__AFT:
 			//generate the mask for this laser
-			u32Mask = (1U << 13U) ^ 0xFFFFFFFFU;
+			u32Mask = 1U << 13U;
 			break;
 
 		default:
@@ -114,39 +180,495 @@ void vFCU_LASERCONT_TL__ISR(E_FCU__LASER_CONT_INDEX_T eLaser, Luint32 u32Registe
 
 	if(eLaser < LASER_CONT__MAX)
 	{
-		//here all we can do is save off the next list item and then increment.
-		//rising or falling
+		//here all we can do is save off the edge, the pin is low after a falling edge
 		if((u32Register & u32Mask) == 0U)
 		{
-			//falling
-			//make sure we are safe
-			if(sFCU.sContrast.sTimingList[(Luint8)eLaser].u16FallingCount < C_FCU__LASER_CONTRAST__MAX_STRIPES)
+			vFCU_LASERCONT_TL__Add_Edge(eLaser, 0U, u64RM4_RTI__Get_Counter1());
+		}
+		else
+		{
+			vFCU_LASERCONT_TL__Add_Edge(eLaser, 1U, u64RM4_RTI__Get_Counter1());
+		}
+	}
+	else
+	{
+		//big error
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Queue one edge for the main loop
+ *
+ * @note
+ * Called from the ISR, the ring tail is only read here.
+ *
+ * @param[in]		u64Time					RTI counter 1 at the edge
+ * @param[in]		u8Rising				1 for a rising edge
+ * @param[in]		eLaser					The laser index
+ */
+void vFCU_LASERCONT_TL__Add_Edge(E_FCU__LASER_CONT_INDEX_T eLaser, Luint8 u8Rising, Luint64 u64Time)
+{
+	Luint16 u16Head;
+	Luint16 u16Pos;
+
+	u16Head = sFCU.sContrast.sRing.u16Head;
+
+	if((Luint16)(u16Head - sFCU.sContrast.sRing.u16Tail) < (Luint16)C_FCU__LASER_CONTRAST__RING_SIZE)
+	{
+		u16Pos = u16Head & (Luint16)(C_FCU__LASER_CONTRAST__RING_SIZE - 1U);
+		sFCU.sContrast.sRing.sEdge[u16Pos].u64Time = u64Time;
+		sFCU.sContrast.sRing.sEdge[u16Pos].u8Laser = (Luint8)eLaser;
+		sFCU.sContrast.sRing.sEdge[u16Pos].u8Rising = u8Rising;
+
+		//publish once the slot is full
+		sFCU.sContrast.sRing.u16Head = (Luint16)(u16Head + 1U);
+	}
+	else
+	{
+		//main loop has stalled, the edge is lost
+		sFCU.sContrast.sRing.u32Overflow++;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Where the FWD sensor is at a given time, mm past the first stripe
+ *
+ * With all three sensors tracking the median is used so one sensor with a
+ * bad count can't move us, otherwise the furthest along.
+ *
+ * @param[in]		u64Time					RTI counter 1 time to estimate at
+ * @return			Position in mm, 0 before the first stripe
+ */
+Luint32 u32FCU_LASERCONT_TL__Get_Position_mm(Luint64 u64Time)
+{
+	Lint32 s32Pos[LASER_CONT__MAX];
+	Lint32 s32Swap;
+	Luint8 u8Count;
+	Luint8 u8Laser;
+	Luint32 u32Return;
+
+	u8Count = 0U;
+	for(u8Laser = 0U; u8Laser < (Luint8)LASER_CONT__MAX; u8Laser++)
+	{
+		if(sFCU.sContrast.sTimingList[u8Laser].u16RisingCount != 0U)
+		{
+			s32Pos[u8Count] = s32FCU_LASERCONT_TL__Estimate(u8Laser, u64Time);
+			u8Count++;
+		}
+		else
+		{
+			//not seen anything yet
+		}
+	}
+
+	//order the first two, then the third gives the median or the max
+	if((u8Count > 1U) && (s32Pos[0] > s32Pos[1]))
+	{
+		s32Swap = s32Pos[0];
+		s32Pos[0] = s32Pos[1];
+		s32Pos[1] = s32Swap;
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(u8Count == 3U)
+	{
+		if(s32Pos[2] < s32Pos[0])
+		{
+			s32Pos[1] = s32Pos[0];
+		}
+		else if(s32Pos[2] < s32Pos[1])
+		{
+			s32Pos[1] = s32Pos[2];
+		}
+		else
+		{
+			//s32Pos[1] is the middle already
+		}
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(u8Count == 0U)
+	{
+		u32Return = 0U;
+	}
+	else if(u8Count == 1U)
+	{
+		u32Return = (Luint32)s32Pos[0];
+	}
+	else
+	{
+		u32Return = (Luint32)s32Pos[1];
+	}
+
+	return u32Return;
+}
+
+/** Most recent velocity from either the stripe interval or the cross sensor time, mm/s */
+Luint32 u32FCU_LASERCONT_TL__Get_Velocity_mms(void)
+{
+	return sFCU.sContrast.sVeloc.u32Veloc_mms;
+}
+
+/** Immediate return of a fault condition in the contrast sensors */
+Luint8 u8FCU_LASERCONT_TL__Get_IsFault(void)
+{
+	return sFCU.sContrast.sFaultFlags.u8FaultFlag;
+}
+
+/** Return the list of fault flag conditions */
+Luint32 u32FCU_LASERCONT_TL__Get_FaultFlags(void)
+{
+	return sFCU.sContrast.sFaultFlags.sTree.u32Flags[0];
+}
+
+/***************************************************************************//**
+ * @brief
+ * Handle a rising edge, the leading edge of a stripe
+ *
+ * @param[in]		u64Time					RTI counter 1 at the edge
+ * @param[in]		u8Laser					The laser index
+ */
+static void vFCU_LASERCONT_TL__Rising(Luint8 u8Laser, Luint64 u64Time)
+{
+	Luint32 u32Interval;
+	Luint32 u32Last;
+	Luint8 u8Stripes;
+
+	u32Last = sFCU.sContrast.sTimingList[u8Laser].u32Interval;
+
+	if(sFCU.sContrast.sTimingList[u8Laser].u16RisingCount == 0U)
+	{
+		//first stripe for this sensor, line it up with the others
+		sFCU.sContrast.sTimingList[u8Laser].s32Stripe = s32FCU_LASERCONT_TL__First_Stripe(u8Laser);
+		u32Interval = 0U;
+		u8Stripes = 1U;
+	}
+	else
+	{
+		u32Interval = (Luint32)(u64Time - sFCU.sContrast.sTimingList[u8Laser].u64LastRising);
+		u8Stripes = u8FCU_LASERCONT_TL__Classify(u8Laser, u32Interval);
+		sFCU.sContrast.sTimingList[u8Laser].s32Stripe += (Lint32)u8Stripes;
+	}
+
+	if(u8Stripes != 0U)
+	{
+		sFCU.sContrast.sTimingList[u8Laser].u16RisingCount++;
+		sFCU.sContrast.sTimingList[u8Laser].u64LastRising = u64Time;
+
+		//only time a pitch we trust
+		if((u32Interval != 0U) && (u32Last == 0U))
+		{
+			//second stripe, or the one after a resync, only checked against the max velocity
+			sFCU.sContrast.sTimingList[u8Laser].u32Interval = u32Interval;
+		}
+		else if((u32Interval != 0U) && (sFCU.sContrast.sTimingList[u8Laser].u32Interval != 0U))
+		{
+			sFCU.sContrast.sTimingList[u8Laser].u32Interval = u32Interval / (Luint32)u8Stripes;
+		}
+		else
+		{
+			//first stripe or a resync, wait for the next one
+		}
+
+		if(sFCU.sContrast.sTimingList[u8Laser].u32Interval != 0U)
+		{
+			sFCU.sContrast.sTimingList[u8Laser].u32Veloc_mms = (Luint32)(((Lfloat32)C_FCU__LASER_CONTRAST__STRIPE_MM * (Lfloat32)C_FCU__LASER_CONTRAST__TICKS_PER_SEC) /
+					(Lfloat32)sFCU.sContrast.sTimingList[u8Laser].u32Interval);
+			sFCU.sContrast.sVeloc.u32Veloc_mms = sFCU.sContrast.sTimingList[u8Laser].u32Veloc_mms;
+		}
+		else
+		{
+			//fall on
+		}
+
+		vFCU_LASERCONT_TL__Cross(u8Laser, u64Time);
+	}
+	else
+	{
+		//glitch, the last good edge stays the reference
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Handle a falling edge, gives how long the stripe was under the sensor
+ *
+ * @param[in]		u64Time					RTI counter 1 at the edge
+ * @param[in]		u8Laser					The laser index
+ */
+static void vFCU_LASERCONT_TL__Falling(Luint8 u8Laser, Luint64 u64Time)
+{
+	if((sFCU.sContrast.sTimingList[u8Laser].u16RisingCount != 0U) && (u64Time > sFCU.sContrast.sTimingList[u8Laser].u64LastRising))
+	{
+		sFCU.sContrast.sTimingList[u8Laser].u32Width = (Luint32)(u64Time - sFCU.sContrast.sTimingList[u8Laser].u64LastRising);
+	}
+	else
+	{
+		//no stripe to measure
+	}
+
+	sFCU.sContrast.sTimingList[u8Laser].u64LastFalling = u64Time;
+	sFCU.sContrast.sTimingList[u8Laser].u16FallingCount++;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Work out how many stripe pitches an interval covers
+ *
+ * From the speed over the last pitch and the max acceleration we know the
+ * earliest and latest the next stripe can turn up. Anything earlier is a
+ * glitch, anything that fits two pitches means a stripe was missed.
+ *
+ * @param[in]		u32Interval				Ticks since the last good stripe
+ * @param[in]		u8Laser					The laser index
+ * @return			0 = glitch, 1 = next stripe, 2 = missed one stripe
+ */
+static Luint8 u8FCU_LASERCONT_TL__Classify(Luint8 u8Laser, Luint32 u32Interval)
+{
+	Lfloat32 f32Last;
+	Lfloat32 f32Time;
+	Lfloat32 f32Veloc;
+	Lfloat32 f32Spread;
+	Lfloat32 f32Min;
+	Lfloat32 f32Max;
+	Luint8 u8Return;
+
+	if(u32Interval < C_LASERCONT_TL__MIN_TICKS)
+	{
+		//faster than we can go
+		sFCU.sContrast.sTimingList[u8Laser].u32Glitches++;
+		u8Return = 0U;
+	}
+	else if(sFCU.sContrast.sTimingList[u8Laser].u32Interval == 0U)
+	{
+		//nothing to predict from
+		u8Return = 1U;
+	}
+	else
+	{
+		f32Last = (Lfloat32)sFCU.sContrast.sTimingList[u8Laser].u32Interval / (Lfloat32)C_FCU__LASER_CONTRAST__TICKS_PER_SEC;
+		f32Time = (Lfloat32)u32Interval / (Lfloat32)C_FCU__LASER_CONTRAST__TICKS_PER_SEC;
+
+		//mean speed over the last pitch, the speed now is within A.T of it
+		f32Veloc = (Lfloat32)C_FCU__LASER_CONTRAST__STRIPE_MM / f32Last;
+		f32Spread = (Lfloat32)C_FCU__LASER_CONTRAST__MAX_ACCEL_MMS2 * f32Last;
+
+		vFCU_LASERCONT_TL__Window(f32Veloc, f32Spread, (Lfloat32)C_FCU__LASER_CONTRAST__STRIPE_MM, &f32Min, &f32Max);
+		if(f32Time < f32Min)
+		{
+			sFCU.sContrast.sTimingList[u8Laser].u32Glitches++;
+			u8Return = 0U;
+		}
+		else if(f32Time <= f32Max)
+		{
+			u8Return = 1U;
+		}
+		else
+		{
+			vFCU_LASERCONT_TL__Window(f32Veloc, f32Spread, 2.0F * (Lfloat32)C_FCU__LASER_CONTRAST__STRIPE_MM, &f32Min, &f32Max);
+			if((f32Time >= f32Min) && (f32Time <= f32Max))
 			{
-				sFCU.sContrast.sTimingList[(Luint8)eLaser].u64FallingList[sFCU.sContrast.sTimingList[(Luint8)eLaser].u16FallingCount] = u64RM4_RTI__Get_Counter1();
+				sFCU.sContrast.sTimingList[u8Laser].u32Missed++;
+				u8Return = 2U;
 			}
 			else
 			{
-				//BIG ISSUE!
+				//fits nothing, count one and start the interval again
+				sFCU.sContrast.sTimingList[u8Laser].u32Resync++;
+				sFCU.sContrast.sTimingList[u8Laser].u32Interval = 0U;
+				u8Return = 1U;
 			}
 		}
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Earliest and latest time to cover a distance
+ *
+ * Solves d = vt +/- at^2/2 written so there is no cancellation at speed.
+ *
+ * @param[out]		*pf32Max				Latest arrival, s, very large if we could stop
+ * @param[out]		*pf32Min				Earliest arrival, s
+ * @param[in]		f32Distance				mm
+ * @param[in]		f32Spread				How far the speed may be from f32Veloc, mm/s
+ * @param[in]		f32Veloc				mm/s
+ */
+static void vFCU_LASERCONT_TL__Window(Lfloat32 f32Veloc, Lfloat32 f32Spread, Lfloat32 f32Distance, Lfloat32 *pf32Min, Lfloat32 *pf32Max)
+{
+	Lfloat32 f32Fast;
+	Lfloat32 f32Slow;
+	Lfloat32 f32Root;
+	Lfloat32 f32Accel2D;
+
+	f32Accel2D = 2.0F * (Lfloat32)C_FCU__LASER_CONTRAST__MAX_ACCEL_MMS2 * f32Distance;
+
+	//arriving at the max speed and still accelerating
+	f32Fast = f32Veloc + f32Spread;
+	f32Root = f32NUMERICAL_FLOAT__SQRT((f32Fast * f32Fast) + f32Accel2D);
+	*pf32Min = (2.0F * f32Distance) / (f32Fast + f32Root);
+
+	//arriving at the min speed and still braking
+	f32Slow = f32Veloc - f32Spread;
+	if((f32Slow > 0.0F) && ((f32Slow * f32Slow) > f32Accel2D))
+	{
+		f32Root = f32NUMERICAL_FLOAT__SQRT((f32Slow * f32Slow) - f32Accel2D);
+		*pf32Max = (2.0F * f32Distance) / (f32Slow + f32Root);
+	}
+	else
+	{
+		//we could stop before getting there
+		*pf32Max = 1.0E9F;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Stripe index for a sensor's first stripe
+ *
+ * A sensor ahead of us has already crossed the stripe we are on, a sensor
+ * behind us hasn't got to it yet. Works while the sensors are less than half
+ * a stripe pitch apart.
+ *
+ * @param[in]		u8Laser					The laser index
+ * @return			Stripe index, 0 if no sensor has seen a stripe
+ */
+static Lint32 s32FCU_LASERCONT_TL__First_Stripe(Luint8 u8Laser)
+{
+	Lint32 s32Return;
+	Luint8 u8Other;
+	Luint8 u8Found;
+
+	s32Return = 0;
+	u8Found = 0U;
+	u8Other = 0U;
+	while((u8Found == 0U) && (u8Other < (Luint8)LASER_CONT__MAX))
+	{
+		if((u8Other != u8Laser) && (sFCU.sContrast.sTimingList[u8Other].u16RisingCount != 0U))
+		{
+			if(u8Other < u8Laser)
+			{
+				s32Return = sFCU.sContrast.sTimingList[u8Other].s32Stripe;
+			}
+			else
+			{
+				s32Return = sFCU.sContrast.sTimingList[u8Other].s32Stripe + 1;
+			}
+			u8Found = 1U;
+		}
 		else
 		{
-			//rising
-			//make sure we are safe
-			if(sFCU.sContrast.sTimingList[(Luint8)eLaser].u16RisingCount < C_FCU__LASER_CONTRAST__MAX_STRIPES)
+			u8Other++;
+		}
+	}
+
+	return s32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Velocity from a trailing sensor reaching the stripe the lead sensor crossed
+ *
+ * @param[in]		u64Time					RTI counter 1 at the edge
+ * @param[in]		u8Laser					The laser index
+ */
+static void vFCU_LASERCONT_TL__Cross(Luint8 u8Laser, Luint64 u64Time)
+{
+	Luint32 u32Baseline;
+	Luint32 u32Ticks;
+	Luint8 u8Ref;
+	Luint8 u8Stop;
+
+	u8Stop = 0U;
+	u8Ref = 0U;
+	while((u8Stop == 0U) && (u8Ref < u8Laser))
+	{
+		if(sFCU.sContrast.sTimingList[u8Ref].u16RisingCount != 0U)
+		{
+			u32Baseline = u32LASERCONT_TL__Offset_mm[u8Laser] - u32LASERCONT_TL__Offset_mm[u8Ref];
+			u32Ticks = (Luint32)(u64Time - sFCU.sContrast.sTimingList[u8Ref].u64LastRising);
+
+			//same stripe and no faster than we can go
+			if((sFCU.sContrast.sTimingList[u8Ref].s32Stripe == sFCU.sContrast.sTimingList[u8Laser].s32Stripe) &&
+				(((Lfloat32)u32Ticks * (Lfloat32)C_FCU__LASER_CONTRAST__MAX_VELOC_MMS) >= ((Lfloat32)u32Baseline * (Lfloat32)C_FCU__LASER_CONTRAST__TICKS_PER_SEC)))
 			{
-				sFCU.sContrast.sTimingList[(Luint8)eLaser].u64RisingList[sFCU.sContrast.sTimingList[(Luint8)eLaser].u16RisingCount] = u64RM4_RTI__Get_Counter1();
+				sFCU.sContrast.sVeloc.u32Cross_mms = (Luint32)(((Lfloat32)u32Baseline * (Lfloat32)C_FCU__LASER_CONTRAST__TICKS_PER_SEC) / (Lfloat32)u32Ticks);
+				sFCU.sContrast.sVeloc.u32Veloc_mms = sFCU.sContrast.sVeloc.u32Cross_mms;
 			}
 			else
 			{
-				//BIG ISSUE!
+				sFCU.sContrast.sVeloc.u32Mismatch++;
+				vFCU_LASERCONT_TL__Fault(C_LCCM655__LASER_CONT__FAULT_INDEX__02);
 			}
+			u8Stop = 1U;
+		}
+		else
+		{
+			u8Ref++;
 		}
 	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Position of the FWD sensor from one sensor's last stripe
+ *
+ * Carried forward at the current velocity, but never more than one pitch.
+ *
+ * @param[in]		u64Time					RTI counter 1 time to estimate at
+ * @param[in]		u8Laser					The laser index
+ * @return			mm past the first stripe
+ */
+static Lint32 s32FCU_LASERCONT_TL__Estimate(Luint8 u8Laser, Luint64 u64Time)
+{
+	Lint32 s32Return;
+	Lfloat32 f32Ahead;
+
+	s32Return = sFCU.sContrast.sTimingList[u8Laser].s32Stripe * (Lint32)C_FCU__LASER_CONTRAST__STRIPE_MM;
+	s32Return += (Lint32)u32LASERCONT_TL__Offset_mm[u8Laser];
+
+	if(u64Time > sFCU.sContrast.sTimingList[u8Laser].u64LastRising)
+	{
+		f32Ahead = ((Lfloat32)sFCU.sContrast.sVeloc.u32Veloc_mms * (Lfloat32)(u64Time - sFCU.sContrast.sTimingList[u8Laser].u64LastRising)) /
+					(Lfloat32)C_FCU__LASER_CONTRAST__TICKS_PER_SEC;
+		if(f32Ahead > (Lfloat32)C_FCU__LASER_CONTRAST__STRIPE_MM)
+		{
+			f32Ahead = (Lfloat32)C_FCU__LASER_CONTRAST__STRIPE_MM;
+		}
+		else
+		{
+			//fall on
+		}
+		s32Return += (Lint32)f32Ahead;
+	}
 	else
 	{
-		//big error
+		//at the stripe
 	}
+
+	return s32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Raise a contrast fault along with the general flag
+ *
+ * @param[in]		u32Index				Fault index
+ */
+static void vFCU_LASERCONT_TL__Fault(Luint32 u32Index)
+{
+	vFAULTLINK__Set_Flag(&sFCU.sContrast.sFaultFlags, C_LCCM655__LASER_CONT__FAULT_INDEX__00);
+	vFAULTLINK__Set_Flag(&sFCU.sContrast.sFaultFlags, u32Index);
 }
 
 
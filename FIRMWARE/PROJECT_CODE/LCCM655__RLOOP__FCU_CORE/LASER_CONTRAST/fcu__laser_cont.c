@@ -38,6 +38,9 @@ void vFCU_LASERCONT__Init(void)
 	//at the entry point here the N2HET should have created 3 programs for either
 	//edge capture, or HTU.
 
+	//edge ring and stripe tracking
+	vFCU_LASERCONT_TL__Init();
+
 }
 
 /***************************************************************************//**
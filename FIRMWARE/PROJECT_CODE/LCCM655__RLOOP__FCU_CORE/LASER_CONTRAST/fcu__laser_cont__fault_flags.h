@@ -0,0 +1,44 @@
+#ifndef _LCCM655__06__FAULT_FLAGS_H_
+#define _LCCM655__06__FAULT_FLAGS_H_
+/*
+ * @fault_index
+ * 00
+ *
+ * @brief
+ * GENERAL FAULT
+ *
+ * A general fault has occurred in the contrast sensor subsystem, check the
+ * other flags for more information.
+*/
+#define C_LCCM655__LASER_CONT__FAULT_INDEX__00					0x00000000U
+#define C_LCCM655__LASER_CONT__FAULT_INDEX_MASK__00				0x00000001U
+
+/*
+ * @fault_index
+ * 01
+ *
+ * @brief
+ * EDGE RING OVERFLOW
+ *
+ * The ISR found the edge ring full and had to drop an edge, the main loop is
+ * not draining the ring fast enough.
+*/
+#define C_LCCM655__LASER_CONT__FAULT_INDEX__01					0x00000001U
+#define C_LCCM655__LASER_CONT__FAULT_INDEX_MASK__01				0x00000002U
+
+/*
+ * @fault_index
+ * 02
+ *
+ * @brief
+ * SENSOR MISMATCH
+ *
+ * A trailing sensor crossed a stripe that the sensor ahead of it had not, or
+ * the time between them gave an impossible velocity. The stripe counts of
+ * the sensors no longer agree.
+*/
+#define C_LCCM655__LASER_CONT__FAULT_INDEX__02					0x00000002U
+#define C_LCCM655__LASER_CONT__FAULT_INDEX_MASK__02				0x00000004U
+
+#endif //#ifndef _LCCM655__06__FAULT_FLAGS_H_
+
@@ -41,7 +41,7 @@ void vFCU_LASERDIST__Init(void)
 	sFCU.sLaserDist.eRxState = LASERDIST_RX__BYTE_1;
 	sFCU.sLaserDist.u8NewPacket = 0U;
 	sFCU.sLaserDist.u8NewDistanceAvail = 0U;
-	sFCU.sLaserDist.u32LaserPOR_Counter = 0U;
+	sFCU.sLaserDist.u32LaserPOR_ms = 0U;
 	//just set to some obscene distance
 	sFCU.sLaserDist.f32Distance = 99999.9F;
 
@@ -68,7 +68,7 @@ void vFCU_LASERDIST__Process(void)
 		case LASERDIST_STATE__RESET:
 			//just fresh out of reset.
 
-			sFCU.sLaserDist.u32LaserPOR_Counter = 0U;
+			sFCU.sLaserDist.u32LaserPOR_ms = u32FCU_SCHED__Get_Now_ms();
 
 			//setup the lasers
 			sFCU.sLaserDist.eLaserState = LASERDIST_STATE__WAIT_LASER_RESET;
@@ -77,7 +77,7 @@ void vFCU_LASERDIST__Process(void)
 		case LASERDIST_STATE__WAIT_LASER_RESET:
 
 			//wait here until the lasers are out of rest.
-			if(sFCU.sLaserDist.u32LaserPOR_Counter > 50U)
+			if((u32FCU_SCHED__Get_Now_ms() - sFCU.sLaserDist.u32LaserPOR_ms) > C_FCU__LASER__POR_WAIT_MS)
 			{
 				sFCU.sLaserDist.eLaserState = LASERDIST_STATE__INIT_LASER;
 			}
@@ -285,20 +285,6 @@ void vFCU_LASERDIST__Append_Byte(Luint8 u8Value)
 }
 
 
-/***************************************************************************//**
- * @brief
- * 100ms Timer interrupt.
- * 
- * @st_funcMD5		D7AC2E42B341C67C3BC9659D2E8CEC02
- * @st_funcID		LCCM655R0.FILE.033.FUNC.006
- */
-void vFCU_LASERDIST__100MS_ISR(void)
-{
-
-	sFCU.sLaserDist.u32LaserPOR_Counter++;
-}
-
-
 #endif
 /** @} */
 /** @} */
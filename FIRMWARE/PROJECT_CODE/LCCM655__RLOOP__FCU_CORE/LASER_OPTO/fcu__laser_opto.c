@@ -82,7 +82,7 @@ void vFCU_LASEROPTO__Process(void)
 		case OPTOLASER_STATE__RESET:
 			//just fresh out of reset.
 
-			sFCU.sLaserOpto.u32LaserPOR_Counter = 0U;
+			sFCU.sLaserOpto.u32LaserPOR_ms = u32FCU_SCHED__Get_Now_ms();
 
 			//setup the lasers
 			sFCU.sLaserOpto.eOptoNCDTState = OPTOLASER_STATE__WAIT_LASER_RESET;
@@ -91,7 +91,7 @@ void vFCU_LASEROPTO__Process(void)
 		case OPTOLASER_STATE__WAIT_LASER_RESET:
 
 			//wait here until the lasers are out of rest.
-			if(sFCU.sLaserOpto.u32LaserPOR_Counter > 50U)
+			if((u32FCU_SCHED__Get_Now_ms() - sFCU.sLaserOpto.u32LaserPOR_ms) > C_FCU__LASER__POR_WAIT_MS)
 			{
 				sFCU.sLaserOpto.eOptoNCDTState = OPTOLASER_STATE__INIT_LASER;
 			}
@@ -374,21 +374,6 @@ void vFCU_LASEROPTO__Append_Byte(Luint8 u8LaserIndex, Luint8 u8Value)
 	}
 }
 
-/***************************************************************************//**
- * @brief
- * 100MS ISR point
- * 
- * @st_funcMD5		E23807C52369107D55D0953516ED2BFB
- * @st_funcID		LCCM655R0.FILE.021.FUNC.006
- */
-void vFCU_LASEROPTO__100MS_ISR(void)
-{
-
-	sFCU.sLaserOpto.u32LaserPOR_Counter++;
-}
-
-
-
 
 #endif //C_LOCALDEF__LCCM655__ENABLE_LASER_OPTONCDT
 
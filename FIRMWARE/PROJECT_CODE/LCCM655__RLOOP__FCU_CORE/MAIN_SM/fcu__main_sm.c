@@ -23,6 +23,17 @@
 //the structure
 extern struct _strFCU sFCU;
 
+//locals
+static void vFCU_MAINSM__Add_Tasks(void);
+static void vFCU_MAINSM__SC16_Task(void);
+#if C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL == 1U
+static void vFCU_MAINSM__FlightCtl_Task(void);
+#endif
+#if C_LOCALDEF__LCCM655__ENABLE_THROTTLE == 1U
+static void vFCU_MAINSM__AMC7812_Task(void);
+static void vFCU_MAINSM__Throttle_Task(void);
+#endif
+
 /***************************************************************************//**
  * @brief
  * Init any variables as is needed by the main state machine
@@ -49,7 +60,6 @@ void vFCU_MAINSM__Init(void)
  */
 void vFCU_MAINSM__Process(void)
 {
-	Luint8 u8Counter;
 	Luint8 u8Test;
 
 	//hande the state machine.
@@ -72,12 +82,12 @@ void vFCU_MAINSM__Process(void)
 			#endif
 
 			//laser contrast sensors
-			#if C_LOCALDEF__LCCM655__ENABLE_LASER_CONT == 1U
+			#if C_LOCALDEF__LCCM655__ENABLE_LASER_CONTRAST == 1U
 				vFCU_LASERCONT__Init();
 			#endif
 
 			#if C_LOCALDEF__LCCM655__ENABLE_LASER_DISTANCE == 1U
-				vFCU_LASERDIST__Process();
+				vFCU_LASERDIST__Init();
 			#endif
 			//init the brake systems
 			#if C_LOCALDEF__LCCM655__ENABLE_BRAKES == 1U
@@ -118,6 +128,12 @@ void vFCU_MAINSM__Process(void)
 				vFCU_FLIGHTCTL__Init();
 			#endif
 
+			//hang the subsystem fault trees off the top level now they are initted
+			vFCU_FAULTS__Link_Subsystems();
+
+			//each subsystem runs as its own task from here
+			vFCU_MAINSM__Add_Tasks();
+
 			//put the flight computer into startup mode now that everything has been initted.
 			sFCU.eRunState = RUN_STATE__STARTUP_MODE;
 
@@ -155,21 +171,7 @@ void vFCU_MAINSM__Process(void)
 		case RUN_STATE__FLIGHT_MODE:
 			//this is the flight mode controller
 			//if we are in this state, we are ready for flight
-
-			#if C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL == 1U
-				vFCU_FLIGHTCTL__Process();
-			#endif
-
-			// process the AMC7812
-			#if C_LOCALDEF__LCCM655__ENABLE_THROTTLE == 1U
-				vAMC7812__Process();
-			#endif
-
-			// process the throttles
-			#if C_LOCALDEF__LCCM655__ENABLE_THROTTLE == 1U
-				vFCU_THROTTLE__Process();
-			#endif
-
+			//the flight controller and throttle tasks only do anything in here
 			break;
 
 		case RUN_STATE__FLIGHT_ABORT:
@@ -185,62 +187,157 @@ void vFCU_MAINSM__Process(void)
 	//always process these items after we have been initted
 	if(sFCU.eRunState > RUN_STATE__INIT_SYSTEMS)
 	{
+		//process auto-sequence control
+		vFCU_MAINSM_AUTO__Process();
+	}
+	else
+	{
+		//do nothing.
+	}
 
-		//process the SC16IS interface always
-		for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM487__NUM_DEVICES; u8Counter++)
-		{
-			vSC16__Process(u8Counter);
-		}
-
-		#if C_LOCALDEF__LCCM655__ENABLE_LASER_OPTONCDT == 1U
-			vFCU_LASEROPTO__Process();
-		#endif
-
-		//laser orientation
-		#if C_LOCALDEF__LCCM655__ENABLE_ORIENTATION == 1U
-			vFCU_LASER_ORIENTATION__Process();
-		#endif
-
-		#if C_LOCALDEF__LCCM655__ENABLE_LASER_CONT == 1U
-			vFCU_LASERCONT__Process();
-		#endif
-
-		#if C_LOCALDEF__LCCM655__ENABLE_LASER_DISTANCE == 1U
-			vFCU_LASERDIST__Process();
-		#endif
-
-		#if C_LOCALDEF__LCCM655__ENABLE_PUSHER == 1U
-			vFCU_PUSHER__Pusher();
-		#endif
-
-		//process the brakes.
-		#if C_LOCALDEF__LCCM655__ENABLE_BRAKES == 1U
-			vFCU_BRAKES__Process();
-		#endif
+}
 
-		//process the accel channels
-		#if C_LOCALDEF__LCCM655__ENABLE_ACCEL == 1U
-			vFCU_ACCEL__Process();
-		#endif
+/***************************************************************************//**
+ * @brief
+ * Put the subsystems into the scheduler once they are initted, each with its
+ * own period and budget.
+ *
+ * @note
+ * Same priority runs in the order added, so the SC16 goes ahead of everything
+ * that reads bytes out of it.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.020.FUNC.003
+ */
+static void vFCU_MAINSM__Add_Tasks(void)
+{
 
-		//process any Pi Comms
-		#if C_LOCALDEF__LCCM655__ENABLE_PI_COMMS == 1U
-			vFCU_PICOMMS__Process();
-		#endif
+	//the SC16IS UARTs always
+	(void)s16FCU_SCHED__Add(&vFCU_MAINSM__SC16_Task, C_FCU__SCHED__PERIOD_MS__SC16, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__SC16);
+
+	//ASI bus poller
+	#if C_LOCALDEF__LCCM655__ENABLE_ASI_RS485 == 1U
+		(void)s16FCU_SCHED__Add(&vFCU_ASI__Process, C_FCU__SCHED__PERIOD_MS__ASI, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__ASI);
+	#endif
+
+	#if C_LOCALDEF__LCCM655__ENABLE_LASER_OPTONCDT == 1U
+		(void)s16FCU_SCHED__Add(&vFCU_LASEROPTO__Process, C_FCU__SCHED__PERIOD_MS__LASEROPTO, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__LASEROPTO);
+	#endif
+
+	#if C_LOCALDEF__LCCM655__ENABLE_LASER_CONTRAST == 1U
+		(void)s16FCU_SCHED__Add(&vFCU_LASERCONT__Process, C_FCU__SCHED__PERIOD_MS__LASERCONT, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__LASERCONT);
+	#endif
+
+	#if C_LOCALDEF__LCCM655__ENABLE_LASER_DISTANCE == 1U
+		(void)s16FCU_SCHED__Add(&vFCU_LASERDIST__Process, C_FCU__SCHED__PERIOD_MS__LASERDIST, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__LASERDIST);
+	#endif
+
+	#if C_LOCALDEF__LCCM655__ENABLE_BRAKES == 1U
+		(void)s16FCU_SCHED__Add(&vFCU_BRAKES__Process, C_FCU__SCHED__PERIOD_MS__BRAKES, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__BRAKES);
+	#endif
+
+	#if C_LOCALDEF__LCCM655__ENABLE_ACCEL == 1U
+		(void)s16FCU_SCHED__Add(&vFCU_ACCEL__Process, C_FCU__SCHED__PERIOD_MS__ACCEL, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__ACCEL);
+	#endif
+
+	//keeps the UART DMA busy, the 10ms frame timer is its own
+	#if C_LOCALDEF__LCCM655__ENABLE_PI_COMMS == 1U
+		(void)s16FCU_SCHED__Add(&vFCU_PICOMMS__Process, C_FCU__SCHED__PERIOD_MS__PICOMMS, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__PICOMMS);
+	#endif
+
+	//flight mode only, the orientation solver runs inside the flight controller
+	#if C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL == 1U
+		(void)s16FCU_SCHED__Add(&vFCU_MAINSM__FlightCtl_Task, C_FCU__SCHED__PERIOD_MS__FLIGHTCTL, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__FLIGHTCTL);
+	#endif
+	#if C_LOCALDEF__LCCM655__ENABLE_THROTTLE == 1U
+		(void)s16FCU_SCHED__Add(&vFCU_MAINSM__AMC7812_Task, C_FCU__SCHED__PERIOD_MS__AMC7812, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__AMC7812);
+		(void)s16FCU_SCHED__Add(&vFCU_MAINSM__Throttle_Task, C_FCU__SCHED__PERIOD_MS__THROTTLE, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__10MS, C_FCU__SCHED__BUDGET_US__THROTTLE);
+	#endif
+
+	//switch debounce, times itself off the slot clock
+	#if C_LOCALDEF__LCCM655__ENABLE_PUSHER == 1U
+		(void)s16FCU_SCHED__Add(&vFCU_PUSHER__Process, C_FCU__SCHED__PERIOD_MS__PUSHER, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__10MS, C_FCU__SCHED__BUDGET_US__PUSHER);
+	#endif
 
-		//process auto-sequence control
-		vFCU_MAINSM_AUTO__Process();
+}
 
+/***************************************************************************//**
+ * @brief
+ * Move the bytes on every SC16IS device
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.020.FUNC.004
+ */
+static void vFCU_MAINSM__SC16_Task(void)
+{
+	Luint8 u8Counter;
 
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM487__NUM_DEVICES; u8Counter++)
+	{
+		vSC16__Process(u8Counter);
+	}
+}
 
+#if C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL == 1U
+/***************************************************************************//**
+ * @brief
+ * Flight controller, while in flight mode
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.020.FUNC.005
+ */
+static void vFCU_MAINSM__FlightCtl_Task(void)
+{
+	if(sFCU.eRunState == RUN_STATE__FLIGHT_MODE)
+	{
+		vFCU_FLIGHTCTL__Process();
 	}
 	else
 	{
-		//do nothing.
+		//not flying
 	}
+}
+#endif
 
+#if C_LOCALDEF__LCCM655__ENABLE_THROTTLE == 1U
+/***************************************************************************//**
+ * @brief
+ * Throttle DAC, while in flight mode
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.020.FUNC.006
+ */
+static void vFCU_MAINSM__AMC7812_Task(void)
+{
+	if(sFCU.eRunState == RUN_STATE__FLIGHT_MODE)
+	{
+		vAMC7812__Process();
+	}
+	else
+	{
+		//not flying
+	}
+}
 
+/***************************************************************************//**
+ * @brief
+ * Throttles, while in flight mode
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.020.FUNC.007
+ */
+static void vFCU_MAINSM__Throttle_Task(void)
+{
+	if(sFCU.eRunState == RUN_STATE__FLIGHT_MODE)
+	{
+		vFCU_THROTTLE__Process();
+	}
+	else
+	{
+		//not flying
+	}
 }
+#endif
 
 
 #endif //#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
@@ -24,8 +24,9 @@ extern struct _strFCU sFCU;
 //init the spaceX timed network transmission process
 void vFCU_NET_SPACEX_TX__Init(void)
 {
-	//Clear the timer flag
-	sFCU.sSpaceX.u8100MS_Flag = 0U;
+	//first packet on the next 100ms mark
+	sFCU.sSpaceX.u32Next_ms = u32FCU_SCHED__Get_Now_ms() + C_FCU__NET__SPACEX_PERIOD_MS;
+	sFCU.sSpaceX.u8Pending = 0U;
 
 }
 
@@ -33,58 +34,52 @@ void vFCU_NET_SPACEX_TX__Init(void)
 //do the transmission
 void vFCU_NET_SPACEX_TX__Process(void)
 {
-	Luint8 u8Test;
-	Luint16 u16PacketLength;
 	Lint16 s16Return;
-	Luint32 u32Buffer;
-	Luint8 *pu8Return;
+#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 0U
+	Luint8 u8Test;
+#endif
 
-	//do we have a timer flag?
-	if(sFCU.sSpaceX.u8100MS_Flag == 1U)
+	//on the 100ms mark
+	if(u8FCU_SCHED__Timer_Due(&sFCU.sSpaceX.u32Next_ms, C_FCU__NET__SPACEX_PERIOD_MS) == 1U)
 	{
-		//send the UDP stream
-		//see if we have space to transmit
-		u8Test = u8ETH_FIFO__Is_Empty();
-		if(u8Test == 1U)
-		{
+		sFCU.sSpaceX.u8Pending = 1U;
+	}
+	else
+	{
+		//fall on
+	}
 
-			//add space for the network packet
-			u16PacketLength = 32U;
-			s16Return = s16ETH_FIFO__Push(u16PacketLength);
-			if(s16Return >= 0)
+	if(sFCU.sSpaceX.u8Pending == 1U)
+	{
+		#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+			//the Tx class scheduler sends it once the FIFO has drained, the
+			//packet is built then so the data is as fresh as it can be
+			s16Return = s16TXCLASS__Request(TXCLASS__TELEMETRY, C_FCU__NET__SPACEX_DEADLINE_US, (Luint16)FCU_NET_TXREQ__SPACEX, 0U);
+		#else
+			//send the UDP stream
+			//see if we have space to transmit
+			u8Test = u8ETH_FIFO__Is_Empty();
+			if(u8Test == 1U)
 			{
-
-				//get a pointer to the buffer
-				u32Buffer = u32ETH_BUFFERDESC__Get_TxBufferPointer((Luint8)s16Return);
-				pu8Return = (Luint8 *)u32Buffer;
-
-				//append some data
-				//Todo:
-				vNUMERICAL_CONVERT__Array_U32(pu8Return, 0U);
-				pu8Return += 4U;
-
-				//send it
-				vETH_UDP__Transmit(u16PacketLength, 3000, 3000);
-
-				//clear the flag only after a send because im sure SpX want the data
-				//on the 100ms mark.
-				sFCU.sSpaceX.u8100MS_Flag = 0U;
-
-			}//if(s16Return >= 0)
+				s16Return = s16FCU_NET_SPACEX_TX__Transmit();
+			}
 			else
 			{
-				//FIFO error
-
-			}//else if(s16Return >= 0)
+				//mo more space
+				s16Return = -1;
+			}
+		#endif
 
-		}//if(u8Test == 1U)
+		if(s16Return >= 0)
+		{
+			//clear the flag only after a send because im sure SpX want the data
+			//on the 100ms mark.
+			sFCU.sSpaceX.u8Pending = 0U;
+		}
 		else
 		{
-			//mo more space
-
-		}//else if(u8Test == 1U)
-
-
+			//try again next time
+		}
 
 	}
 	else
@@ -95,18 +90,50 @@ void vFCU_NET_SPACEX_TX__Process(void)
 
 }
 
-
 /***************************************************************************//**
  * @brief
- * To be called from the 10ms timer routine
- * Sets a flag to allow this module to determine that 10ms has elapsed
+ * Build the SpaceX packet and send it
  *
- * @st_funcMD5		3A00D72EA0E8E8896C26BBDFA0E4F006
- * @st_funcID		LCCM655R0.FILE.019.FUNC.003
+ * @return			-1 = no FIFO space\n
+ *					0 = sent
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.019.FUNC.005
  */
-void vFCU_NET_SPACEX_TX__100MS_ISR(void)
+Lint16 s16FCU_NET_SPACEX_TX__Transmit(void)
 {
-	sFCU.sSpaceX.u8100MS_Flag = 1U;
+	Luint16 u16PacketLength;
+	Lint16 s16Return;
+	Luint32 u32Buffer;
+	Luint8 *pu8Return;
+
+	//add space for the network packet
+	u16PacketLength = 32U;
+	s16Return = s16ETH_FIFO__Push(u16PacketLength);
+	if(s16Return >= 0)
+	{
+
+		//get a pointer to the buffer
+		u32Buffer = u32ETH_BUFFERDESC__Get_TxBufferPointer((Luint8)s16Return);
+		pu8Return = (Luint8 *)u32Buffer;
+
+		//append some data
+		//Todo:
+		vNUMERICAL_CONVERT__Array_U32(pu8Return, 0U);
+		pu8Return += 4U;
+
+		//send it
+		vETH_UDP__Transmit(u16PacketLength, 3000, 3000);
+
+		s16Return = 0;
+
+	}//if(s16Return >= 0)
+	else
+	{
+		//FIFO error
+
+	}//else if(s16Return >= 0)
+
+	return s16Return;
 }
 
 #endif //C_LOCALDEF__LCCM653__ENABLE_ETHERNET
@@ -51,6 +51,22 @@ void vFCU_NET__Init(void)
 	//init our systems
 	vFCU_NET_TX__Init();
 
+	#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+		vTXCLASS__Init();
+	#endif
+
+	#if C_LOCALDEF__LCCM655__ENABLE_DAQ == 1U
+		vFCU_NET_DAQ__Init();
+	#endif
+
+	#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+		vFCU_FAULTS_ETH__Init();
+	#endif
+
+	#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+		sFCU.sEthernet.u8PTP_Running = 0U;
+	#endif
+
 #ifndef WIN32
 	//init the EMAC via its link setup routine.
 	vRM4_EMAC_LINK__Init(&sFCU.sEthernet.u8MACAddx[0], &sFCU.sEthernet.u8IPAddx[0]);
@@ -92,6 +108,34 @@ void vFCU_NET__Process(void)
 		//process anything that needs to be transmitted
 		vFCU_NET_TX__Process();
 
+		#if C_LOCALDEF__LCCM655__ENABLE_DAQ == 1U
+			//bulk DAQ streaming
+			vFCU_NET_DAQ__Process();
+		#endif
+
+		#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+			//new fault journal entries
+			vFCU_FAULTS_ETH__Process();
+		#endif
+
+		#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+			//send what has been asked for, earliest deadline first
+			vTXCLASS__Process();
+		#endif
+
+		#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+			//grandmaster, the PHY clock can only be set up once the PHY is talking
+			if(sFCU.sEthernet.u8PTP_Running == 0U)
+			{
+				vPTP__Init(&sFCU.sEthernet.u8MACAddx[0], &sFCU.sEthernet.u8IPAddx[0]);
+				sFCU.sEthernet.u8PTP_Running = 1U;
+			}
+			else
+			{
+				vPTP__Process();
+			}
+		#endif
+
 	}
 	else
 	{
@@ -0,0 +1,139 @@
+/**
+ * @file		FCU_CORE__NET__DAQ.C
+ * @brief		DAQ block streaming to the ground station over SafeUDP
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM655R0.FILE.036
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FCU
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FCU__CORE_NET_DAQ
+ * @ingroup FCU
+ * @{ */
+
+#include "../fcu_core.h"
+#if C_LOCALDEF__LCCM655__ENABLE_ETHERNET == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_DAQ == 1U
+
+/***************************************************************************//**
+ * @brief
+ * Init the DAQ and the bulk transmitter, streaming stays off until the
+ * ground station asks for it.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.036.FUNC.001
+ */
+void vFCU_NET_DAQ__Init(void)
+{
+	vDAQRING__Init();
+	vBULKTX__Init();
+}
+
+/***************************************************************************//**
+ * @brief
+ * Hand full DAQ blocks to the bulk transmitter and keep it moving.
+ * Call from the network process once the link is up.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.036.FUNC.002
+ */
+void vFCU_NET_DAQ__Process(void)
+{
+	//send first so any blocks it finishes are free for the DAQ
+	vBULKTX__Process();
+	vDAQRING__Process();
+}
+
+/***************************************************************************//**
+ * @brief
+ * Streaming control from the ground station
+ *
+ * @param[in]		u32Enable				1 = stream, anything else = stop
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.036.FUNC.003
+ */
+void vFCU_NET_DAQ__Streaming_Control(Luint32 u32Enable)
+{
+	if(u32Enable == 1U)
+	{
+		vDAQRING__Streaming_On();
+	}
+	else
+	{
+		vDAQRING__Streaming_Off();
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * LCCM667 transmit handler, the block is queued in place and held by the DAQ
+ * until the bulk transmitter has it on the wire.
+ *
+ * @param[in]		u16Length				Block length in bytes
+ * @param[in]		*pu8Buffer				The block in the DAQ ring
+ * @param[in]		u16Index				DAQ channel index
+ * @return			C_DAQRING__TX_HELD, or -1 if the queue is full
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.036.FUNC.004
+ */
+Lint16 s16FCU_NET_DAQ__TxHandler(Luint16 u16Index, Luint8 *pu8Buffer, Luint16 u16Length)
+{
+	Lint16 s16Return;
+	Luint32 u32Stamp;
+	#if C_LOCALDEF__LCCM667__ENABLE_TIMER_IN_DATA == 1U
+		Luint32 *pu32Timers;
+	#endif
+
+	//stamp the block with its first sample if we have them
+	#if C_LOCALDEF__LCCM667__ENABLE_TIMER_IN_DATA == 1U
+		pu32Timers = pu32DAQRING__Get_Block_Timers(u16Index);
+		u32Stamp = pu32Timers[0];
+	#else
+		u32Stamp = u32DAQRING__Get_SystemTimer();
+	#endif
+
+	//the channel index comes back as the tag so we know which ring to release
+	s16Return = s16BULKTX__Queue(u16DAQRING__Get_PacketType(u16Index), u16Index, (const Luint8 *)pu8Buffer, (Luint32)u16Length, u32Stamp);
+	if(s16Return == 0)
+	{
+		s16Return = C_DAQRING__TX_HELD;
+	}
+	else
+	{
+		//DAQ retries next time round
+		s16Return = -1;
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Bulk transmitter has finished with a block, give it back to the DAQ
+ *
+ * @param[in]		u16Tag					DAQ channel index
+ * @param[in]		u16PacketType			Packet type the block went as
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.036.FUNC.005
+ */
+void vFCU_NET_DAQ__Tx_Done(Luint16 u16PacketType, Luint16 u16Tag)
+{
+	//blocks finish in the order they were queued, which is the order the DAQ holds them
+	vDAQRING__Release_Block(u16Tag);
+}
+
+#endif //C_LOCALDEF__LCCM655__ENABLE_DAQ
+#endif //C_LOCALDEF__LCCM655__ENABLE_ETHERNET
+#ifndef C_LOCALDEF__LCCM655__ENABLE_ETHERNET
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
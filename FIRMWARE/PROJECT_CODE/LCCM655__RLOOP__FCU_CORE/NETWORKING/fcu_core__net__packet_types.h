@@ -52,7 +52,19 @@
 		FCU_PKT__ACCEL__AUTO_CALIBRATE = 0x1004U,
 
 		/** Fine adjustment on Any */
-		FCU_PKT__ACCEL__FINE_ZERO_ADJUSTMENT = 0x1005U
+		FCU_PKT__ACCEL__FINE_ZERO_ADJUSTMENT = 0x1005U,
+
+		/** Fault journal streaming on / off */
+		FCU_PKT__FAULTS__JOURNAL_STREAMING_CONTROL = 0x1100U,
+
+		/** Host wants the fault journal resent from a sequence number */
+		FCU_PKT__FAULTS__REQUEST_JOURNAL = 0x1101U,
+
+		/** Transmit fault journal entries to the host */
+		FCU_PKT__FAULTS__TX_JOURNAL = 0x1102U,
+
+		/** DAQ streaming on / off, same as the SafeUDP DAQ type */
+		FCU_PKT__DAQ__STREAMING_CONTROL = 0x1200U
 
 
 	}E_FCU_NET_PACKET_TYPES;
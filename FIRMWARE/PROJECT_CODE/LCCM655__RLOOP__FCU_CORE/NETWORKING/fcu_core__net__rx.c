@@ -34,7 +34,17 @@ extern struct _strFCU sFCU;
  */
 void vFCU_NET_RX__RxUDP(Luint8 *pu8Buffer, Luint16 u16Length, Luint16 u16DestPort)
 {
-
+#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+	//PTP event and general messages
+	if(((u16DestPort == C_PTP__PORT_EVENT) || (u16DestPort == C_PTP__PORT_GENERAL)) && (sFCU.sEthernet.u8PTP_Running == 1U))
+	{
+		vPTP__Input(pu8Buffer, u16Length, u16DestPort);
+	}
+	else
+	{
+		//not for us
+	}
+#endif
 }
 
 /***************************************************************************//**
@@ -87,14 +97,44 @@ void vFCU_NET_RX__RxSafeUDP(Luint8 *pu8Payload, Luint16 u16PayloadLength, Luint1
 			case FCU_PKT__ACCEL__AUTO_CALIBRATE:
 				//enter auto calibration mode
 				//block 0 = device
-				vMMA8451_ZERO__AutoZero((Luint8)u32Block[0]);
+				#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+					//takes the device out of burst mode for the driver
+					vACCELBURST_ZERO__AutoZero((Luint8)u32Block[0]);
+				#else
+					vMMA8451_ZERO__AutoZero((Luint8)u32Block[0]);
+				#endif
 				break;
 
 			case FCU_PKT__ACCEL__FINE_ZERO_ADJUSTMENT:
 				//Fine Zero adjustment on a particular axis
 				//block 0 = device
 				//block 1 = axis
-				vMMA8451_ZERO__Set_FineZero((Luint8)u32Block[0], (MMA8451__AXIS_E)u32Block[1]);
+				#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+					vACCELBURST_ZERO__Set_FineZero((Luint8)u32Block[0], (Luint8)u32Block[1]);
+				#else
+					vMMA8451_ZERO__Set_FineZero((Luint8)u32Block[0], (MMA8451__AXIS_E)u32Block[1]);
+				#endif
+				break;
+
+			case FCU_PKT__FAULTS__JOURNAL_STREAMING_CONTROL:
+				//block 0 = 1 to stream
+				#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+					vFCU_FAULTS_ETH__Streaming_Control(u32Block[0]);
+				#endif
+				break;
+
+			case FCU_PKT__FAULTS__REQUEST_JOURNAL:
+				//block 0 = first sequence number wanted
+				#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+					vFCU_FAULTS_ETH__Request_Replay(u32Block[0]);
+				#endif
+				break;
+
+			case FCU_PKT__DAQ__STREAMING_CONTROL:
+				//block 0 = 1 to stream
+				#if C_LOCALDEF__LCCM655__ENABLE_DAQ == 1U
+					vFCU_NET_DAQ__Streaming_Control(u32Block[0]);
+				#endif
 				break;
 
 			default:
@@ -31,8 +31,8 @@ extern struct _strFCU sFCU;
  */
 void vFCU_NET_TX__Init(void)
 {
-	//Clear the timer flag
-	sFCU.sUDPDiag.u810MS_Flag = 0U;
+	//first stream packet from now
+	sFCU.sUDPDiag.u32NextStream_ms = u32FCU_SCHED__Get_Now_ms();
 
 	//set our default packet types
 	sFCU.sUDPDiag.eTxPacketType = FCU_PKT__NONE;
@@ -57,14 +57,11 @@ void vFCU_NET_TX__Process(void)
 	{
 		//yes we do
 
-		//do we have a timer flag?
-		if(sFCU.sUDPDiag.u810MS_Flag == 1U)
+		//is the next one due?
+		if(u8FCU_SCHED__Timer_Due(&sFCU.sUDPDiag.u32NextStream_ms, C_FCU__NET__STREAM_PERIOD_MS) == 1U)
 		{
 			//set it
 			eType = sFCU.sUDPDiag.eTxStreamingType;
-
-			//clear the flag now
-			sFCU.sUDPDiag.u810MS_Flag = 0U;
 		}
 		else
 		{
@@ -87,7 +84,12 @@ void vFCU_NET_TX__Process(void)
 	{
 		case FCU_PKT__ACCEL__TX_CAL_DATA:
 			#if C_LOCALDEF__LCCM655__ENABLE_ACCEL == 1U
-				vFCU_ACCEL_ETH__Transmit(FCU_PKT__ACCEL__TX_CAL_DATA);
+				#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+					//stale once the next one is due
+					(void)s16TXCLASS__Request(TXCLASS__PERIODIC, C_FCU__NET__STREAM_DEADLINE_US, (Luint16)FCU_NET_TXREQ__ACCEL, (Luint32)FCU_PKT__ACCEL__TX_CAL_DATA);
+				#else
+					vFCU_ACCEL_ETH__Transmit(FCU_PKT__ACCEL__TX_CAL_DATA);
+				#endif
 			#endif
 
 			sFCU.sUDPDiag.eTxPacketType = FCU_PKT__NONE;
@@ -95,7 +97,12 @@ void vFCU_NET_TX__Process(void)
 
 		case FCU_PKT__ACCEL__TX_FULL_DATA:
 			#if C_LOCALDEF__LCCM655__ENABLE_ACCEL == 1U
-				vFCU_ACCEL_ETH__Transmit(FCU_PKT__ACCEL__TX_FULL_DATA);
+				#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+					//stale once the next one is due
+					(void)s16TXCLASS__Request(TXCLASS__PERIODIC, C_FCU__NET__STREAM_DEADLINE_US, (Luint16)FCU_NET_TXREQ__ACCEL, (Luint32)FCU_PKT__ACCEL__TX_FULL_DATA);
+				#else
+					vFCU_ACCEL_ETH__Transmit(FCU_PKT__ACCEL__TX_FULL_DATA);
+				#endif
 			#endif
 
 			sFCU.sUDPDiag.eTxPacketType = FCU_PKT__NONE;
@@ -109,18 +116,57 @@ void vFCU_NET_TX__Process(void)
 }
 
 
+#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
 /***************************************************************************//**
  * @brief
- * To be called from the 10ms timer routine
- * Sets a flag to allow this module to determine that 10ms has elapsed
- * 
- * @st_funcMD5		3A00D72EA0E8E8896C26BBDFA0E4F006
- * @st_funcID		LCCM655R0.FILE.019.FUNC.003
+ * Build and send a packet the Tx class scheduler has picked, the packet goes
+ * straight into the Tx buffer with the data as it is now.
+ *
+ * @note
+ * Only called once the Ethernet FIFO has drained, the SafeUDP senders can not
+ * say when they had no buffer so they are taken as sent.
+ *
+ * @param[in]		u32Param				Request parameter
+ * @param[in]		u16Request				E_FCU_NET_TXREQ_T
+ * @return			-1 = no buffer, ask again later\n
+ *					0 = sent
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.019.FUNC.004
  */
-void vFCU_NET_TX__10MS_ISR(void)
+Lint16 s16FCU_NET_TX__Send_Request(Luint16 u16Request, Luint32 u32Param)
 {
-	sFCU.sUDPDiag.u810MS_Flag = 1U;
+	Lint16 s16Return;
+
+	switch((E_FCU_NET_TXREQ_T)u16Request)
+	{
+		case FCU_NET_TXREQ__SPACEX:
+			s16Return = s16FCU_NET_SPACEX_TX__Transmit();
+			break;
+
+		case FCU_NET_TXREQ__ACCEL:
+			#if C_LOCALDEF__LCCM655__ENABLE_ACCEL == 1U
+				vFCU_ACCEL_ETH__Transmit((E_FCU_NET_PACKET_TYPES)u32Param);
+			#endif
+			s16Return = 0;
+			break;
+
+		case FCU_NET_TXREQ__FAULT_JOURNAL:
+			#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+				vFCU_FAULTS_ETH__Transmit((E_FCU_NET_PACKET_TYPES)u32Param);
+			#endif
+			s16Return = 0;
+			break;
+
+		default:
+			//not ours, drop it
+			s16Return = 0;
+			break;
+
+	}//switch((E_FCU_NET_TXREQ_T)u16Request)
+
+	return s16Return;
 }
+#endif
 
 #endif //C_LOCALDEF__LCCM653__ENABLE_ETHERNET
 /** @} */
@@ -21,17 +21,13 @@
 #if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
 #if C_LOCALDEF__LCCM655__ENABLE_PI_COMMS == 1U
 
-//The PICOMMS RX Callbacks
-void vFCU_PICOMMS__recvLuint8(Luint16 u16Index, Luint8 data);
-void vFCU_PICOMMS__recvLint8(Luint16 index, Lint8 data);
-void vFCU_PICOMMS__recvLuint16(Luint16 index, Luint16 data);
-void vFCU_PICOMMS__recvLint16(Luint16 index, Lint16 data);
-void vFCU_PICOMMS__recvLuint32(Luint16 u16Index, Luint32 u32Data);
-void vFCU_PICOMMS__recvLint32(Luint16 index, Lint32 data);
-void vFCU_PICOMMS__recvLuint64(Luint16 index, Luint64 data);
-void vFCU_PICOMMS__recvLint64(Luint16 index, Lint64 data);
-void vFCU_PICOMMS__recvLfloat32(Luint16 index, Lfloat32 data);
-void vFCU_PICOMMS__recvLfloat64(Luint16 index, Lfloat64 data);
+//locals
+static void vFCU_PICOMMS__Compile_Template(void);
+static void vFCU_PICOMMS__Add_TemplateParam(Luint16 u16Index, Luint8 u8Type, Lfloat32 f32Deadband);
+
+/** Transmit param list, only used while we compile the template */
+static PICOMMS_TEMPLATE_PARAM_T sFCU_PICOMMS_TxParams[C_PICOMMS_TEMPLATE__MAX_PARAMS];
+static Luint16 u16FCU_PICOMMS_NumTxParams;
 
 //the structure
 extern struct _strFCU sFCU;
@@ -39,6 +35,33 @@ extern struct _strFCU sFCU;
 //the main structure
 extern struct _strPICOMMS sPC;
 
+static void vFCU_PICOMMS__Rx_Commit(void);
+static void vFCU_PICOMMS__Service_Tx(void);
+static Luint8 u8FCU_PICOMMS__Check_MicroSteps(Luint16 u16Index, const PICOMMS_RX_VALUE_T *puValue);
+
+/** Our receive table, sorted by index, see E_FCU_PICOMMS_RX__SLOT_T */
+static const PICOMMS_RX_PARAM_T sFCU_PICOMMS_RxTable[FCU_PICOMMS_RX__NUM_SLOTS] =
+{
+	{10001U, (Luint8)PICOMMS_INT8, &sPC.sLp.PICOMMS_LOOP_INT8, 0},
+	{10002U, (Luint8)PICOMMS_UINT16, &sPC.sLp.PICOMMS_LOOP_UINT16, 0},
+	{10003U, (Luint8)PICOMMS_INT16, &sPC.sLp.PICOMMS_LOOP_INT16, 0},
+	{10006U, (Luint8)PICOMMS_UINT64, &sPC.sLp.PICOMMS_LOOP_UINT64, 0},
+	{10007U, (Luint8)PICOMMS_INT64, &sPC.sLp.PICOMMS_LOOP_INT64, 0},
+	{10009U, (Luint8)PICOMMS_DOUBLE, &sPC.sLp.PICOMMS_LOOP_FLOAT64, 0},
+
+	{(Luint16)PI_PACKET__FCU_BRAKES__SET_IBEAM_DIST, (Luint8)PICOMMS_FLOAT, &sFCU.sPiComms.sRxCmd.f32IBeamDist, 0},
+
+	{(Luint16)PI_PACKET__FCU_BRAKES__SET_LEFTMOTOR__MICROSTEPS, (Luint8)PICOMMS_UINT32, &sFCU.sPiComms.sRxCmd.u32MicroSteps[0], &u8FCU_PICOMMS__Check_MicroSteps},
+	{(Luint16)PI_PACKET__FCU_BRAKES__SET_LEFTMOTOR__MAX_ACCEL, (Luint8)PICOMMS_INT32, &sFCU.sPiComms.sRxCmd.s32MaxAccel[0], 0},
+	{(Luint16)PI_PACKET__FCU_BRAKES__SET_LEFTMOTOR__MICRO_REV, (Luint8)PICOMMS_INT32, &sFCU.sPiComms.sRxCmd.s32MicroRev[0], 0},
+	{(Luint16)PI_PACKET__FCU_BRAKES__SET_LEFTMOTOR__MAX_VELOC, (Luint8)PICOMMS_INT32, &sFCU.sPiComms.sRxCmd.s32MaxVeloc[0], 0},
+
+	{(Luint16)PI_PACKET__FCU_BRAKES__SET_RIGHTMOTOR__MICROSTEPS, (Luint8)PICOMMS_UINT32, &sFCU.sPiComms.sRxCmd.u32MicroSteps[1], &u8FCU_PICOMMS__Check_MicroSteps},
+	{(Luint16)PI_PACKET__FCU_BRAKES__SET_RIGHTMOTOR__MAX_ACCEL, (Luint8)PICOMMS_INT32, &sFCU.sPiComms.sRxCmd.s32MaxAccel[1], 0},
+	{(Luint16)PI_PACKET__FCU_BRAKES__SET_RIGHTMOTOR__MICRO_REV, (Luint8)PICOMMS_INT32, &sFCU.sPiComms.sRxCmd.s32MicroRev[1], 0},
+	{(Luint16)PI_PACKET__FCU_BRAKES__SET_RIGHTMOTOR__MAX_VELOC, (Luint8)PICOMMS_INT32, &sFCU.sPiComms.sRxCmd.s32MaxVeloc[1], 0}
+};
+
 /***************************************************************************//**
  * @brief
  * Init any variables
@@ -49,22 +72,19 @@ void vFCU_PICOMMS__Init(void)
 
 	//default or variables
 	sFCU.sPiComms.eState = PICOM_STATE__IDLE;
-	sFCU.sPiComms.u8100MS_Timer = 0U;
+	sFCU.sPiComms.u32NextFrame_ms = u32FCU_SCHED__Get_Now_ms();
 
 	//init pi comms
 	vPICOMMS__Init();
 
-	//Attach all the callbacks
-	PICOMMS_RX_recvLuint8 = &vFCU_PICOMMS__recvLuint8;
-	PICOMMS_RX_recvLint8 = &vFCU_PICOMMS__recvLint8;
-	PICOMMS_RX_recvLuint16 = &vFCU_PICOMMS__recvLuint16;
-	PICOMMS_RX_recvLint16 = &vFCU_PICOMMS__recvLint16;
-	PICOMMS_RX_recvLuint32 = &vFCU_PICOMMS__recvLuint32;
-	PICOMMS_RX_recvLint32 = &vFCU_PICOMMS__recvLint32;
-	PICOMMS_RX_recvLuint64 = &vFCU_PICOMMS__recvLuint64;
-	PICOMMS_RX_recvLint64 = &vFCU_PICOMMS__recvLint64;
-	PICOMMS_RX_recvLfloat32 = &vFCU_PICOMMS__recvLfloat32;
-	PICOMMS_RX_recvLfloat64 = &vFCU_PICOMMS__recvLfloat64;
+	//build our frame layout once, the headers never change
+	vFCU_PICOMMS__Compile_Template();
+
+	//only changed params are sent between keyframes
+	vPICOMMS_ENC__Set_KeyframePeriod(C_FCU_PICOMMS__KEYFRAME_PERIOD);
+
+	//GS commands are written straight into sRxCmd, one commit per frame
+	vPICOMMS_RX__Register_Table(&sFCU_PICOMMS_RxTable[0], (Luint16)FCU_PICOMMS_RX__NUM_SLOTS, &vFCU_PICOMMS__Rx_Commit);
 
 	//switch on notifications now we are ready
 	#if C_LOCALDEF__LCCM282__ENABLE_INTERRUPTS == 1U
@@ -81,28 +101,26 @@ void vFCU_PICOMMS__Init(void)
  */
 void vFCU_PICOMMS__Process(void)
 {
-	Luint32 u32Length;
-	Luint8 * pu8Buffer;
-	Luint8 u8Test;
 	Luint8 u8Counter;
 
+	//keep the wire busy, this is independent of building frames
+	vFCU_PICOMMS__Service_Tx();
+
 	//process our state machine
 	switch(sFCU.sPiComms.eState)
 	{
 
 		case PICOM_STATE__IDLE:
 
-			//check the timer state
-			if(sFCU.sPiComms.u8100MS_Timer == 1U)
+			//check the frame timer
+			if(u8FCU_SCHED__Timer_Due(&sFCU.sPiComms.u32NextFrame_ms, C_FCU__PICOMMS__FRAME_PERIOD_MS) == 1U)
 			{
-				//only do a new frame the DMA is not busy
-				u8Test = u8RM4_SCI_DMA__Is_TxBusy(SCI_CHANNEL__2);
-				if(u8Test == 0U)
-				{
-					sFCU.sPiComms.eState = PICOM_STATE__SETUP_FRAME;
+				//queue timebase for the idle gap stats
+				vPICOMMS_TXQ__10MS_ISR();
 
-					sFCU.sPiComms.u8100MS_Timer = 0U;
-				}
+				//build on the tick even while the last frame is on the wire, if
+				//the queue is full the oldest waiting frame makes way
+				sFCU.sPiComms.eState = PICOM_STATE__SETUP_FRAME;
 			}
 			else
 			{
@@ -112,8 +130,8 @@ void vFCU_PICOMMS__Process(void)
 			break;
 
 		case PICOM_STATE__SETUP_FRAME:
-			//start a new frame
-			PICOMMS_TX_beginFrame();
+			//start a new delta frame against our precompiled headers
+			vPICOMMS_ENC__Begin_Delta(&sFCU.sPiComms.sTxTemplate);
 
 			//change states
 			sFCU.sPiComms.eState = PICOM_STATE__ASSEMBLE_BUFFER;
@@ -122,28 +140,28 @@ void vFCU_PICOMMS__Process(void)
 		case PICOM_STATE__ASSEMBLE_BUFFER:
 
 			#if C_LOCALDEF__LCCM655__ENABLE_BRAKES == 1U
-				vPICOMMS_TX__Add_F32(PI_PACKET__FCU_BRAKES__LEFT__SCREW_POS, f32FCU_BRAKES__Get_ScrewPos(FCU_BRAKE__LEFT));
-				vPICOMMS_TX__Add_F32(PI_PACKET__FCU_BRAKES__RIGHT__SCREW_POS, f32FCU_BRAKES__Get_ScrewPos(FCU_BRAKE__RIGHT));
+				vPICOMMS_ENC__Next_F32(f32FCU_BRAKES__Get_ScrewPos(FCU_BRAKE__LEFT));
+				vPICOMMS_ENC__Next_F32(f32FCU_BRAKES__Get_ScrewPos(FCU_BRAKE__RIGHT));
 
-				vPICOMMS_TX__Add_U8(PI_PACKET__FCU_BRAKES__LEFT__LIMIT_EXTEND, (Luint8)eFCU_BRAKES__Get_SwtichState(FCU_BRAKE__LEFT, BRAKE_SW__EXTEND));
-				vPICOMMS_TX__Add_U8(PI_PACKET__FCU_BRAKES__RIGHT__LIMIT_EXTEND, (Luint8)eFCU_BRAKES__Get_SwtichState(FCU_BRAKE__RIGHT, BRAKE_SW__EXTEND));
-				vPICOMMS_TX__Add_U8(PI_PACKET__FCU_BRAKES__LEFT__LIMIT_RETRACT, (Luint8)eFCU_BRAKES__Get_SwtichState(FCU_BRAKE__LEFT, BRAKE_SW__RETRACT));
-				vPICOMMS_TX__Add_U8(PI_PACKET__FCU_BRAKES__RIGHT__LIMIT_RETRACT, (Luint8)eFCU_BRAKES__Get_SwtichState(FCU_BRAKE__RIGHT, BRAKE_SW__RETRACT));
+				vPICOMMS_ENC__Next_U8((Luint8)eFCU_BRAKES__Get_SwtichState(FCU_BRAKE__LEFT, BRAKE_SW__EXTEND));
+				vPICOMMS_ENC__Next_U8((Luint8)eFCU_BRAKES__Get_SwtichState(FCU_BRAKE__RIGHT, BRAKE_SW__EXTEND));
+				vPICOMMS_ENC__Next_U8((Luint8)eFCU_BRAKES__Get_SwtichState(FCU_BRAKE__LEFT, BRAKE_SW__RETRACT));
+				vPICOMMS_ENC__Next_U8((Luint8)eFCU_BRAKES__Get_SwtichState(FCU_BRAKE__RIGHT, BRAKE_SW__RETRACT));
 
-				vPICOMMS_TX__Add_F32(PI_PACKET__FCU_BRAKES__LEFT__IBEAM_DIST, f32FCU_BRAKES__Get_IBeam_mm(FCU_BRAKE__LEFT));
-				vPICOMMS_TX__Add_F32(PI_PACKET__FCU_BRAKES__RIGHT__IBEAM_DIST, f32FCU_BRAKES__Get_IBeam_mm(FCU_BRAKE__RIGHT));
+				vPICOMMS_ENC__Next_F32(f32FCU_BRAKES__Get_IBeam_mm(FCU_BRAKE__LEFT));
+				vPICOMMS_ENC__Next_F32(f32FCU_BRAKES__Get_IBeam_mm(FCU_BRAKE__RIGHT));
 
-				vPICOMMS_TX__Add_U16(PI_PACKET__FCU_BRAKES__LEFT__ADC_RAW, u16FCU_BRAKES__Get_ADC_Raw(FCU_BRAKE__LEFT));
-				vPICOMMS_TX__Add_U16(PI_PACKET__FCU_BRAKES__RIGHT__ADC_RAW, u16FCU_BRAKES__Get_ADC_Raw(FCU_BRAKE__RIGHT));
+				vPICOMMS_ENC__Next_U16(u16FCU_BRAKES__Get_ADC_Raw(FCU_BRAKE__LEFT));
+				vPICOMMS_ENC__Next_U16(u16FCU_BRAKES__Get_ADC_Raw(FCU_BRAKE__RIGHT));
 
-				vPICOMMS_TX__Add_F32(PI_PACKET__FCU_BRAKES__LEFT__MLP_SCALED, f32FCU_BRAKES__Get_MLP_mm(FCU_BRAKE__LEFT));
-				vPICOMMS_TX__Add_F32(PI_PACKET__FCU__BRAKES__RIGHT__MLP_SCALED, f32FCU_BRAKES__Get_MLP_mm(FCU_BRAKE__RIGHT));
+				vPICOMMS_ENC__Next_F32(f32FCU_BRAKES__Get_MLP_mm(FCU_BRAKE__LEFT));
+				vPICOMMS_ENC__Next_F32(f32FCU_BRAKES__Get_MLP_mm(FCU_BRAKE__RIGHT));
 			#endif //C_LOCALDEF__LCCM655__ENABLE_BRAKES
 
 			#if C_LOCALDEF__LCCM655__ENABLE_LASER_OPTONCDT == 1U
 				for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM655__NUM_LASER_OPTONCDT; u8Counter++)
 				{
-					vPICOMMS_TX__Add_F32(PI_PACKET__FCU__LASER__PITCH_FL + u8Counter, f32FCU_LASEROPTO__Get_Distance(u8Counter));
+					vPICOMMS_ENC__Next_F32(f32FCU_LASEROPTO__Get_Distance(u8Counter));
 				}
 				/*
 				vPICOMMS_TX__Add_F32(PI_PACKET__FCU__LASER__PITCH_FR, 0.0F);
@@ -155,310 +173,263 @@ void vFCU_PICOMMS__Process(void)
 			#endif
 
 			#if C_LOCALDEF__LCCM655__ENABLE_PUSHER == 1U
-				vPICOMMS_TX__Add_U8(PI_PACKET__FCU__PUSHER_SW_A, u8FCU_PUSHER__Get_Switch(0U));
-				vPICOMMS_TX__Add_U8(PI_PACKET__FCU__PUSHER_SW_B, u8FCU_PUSHER__Get_Switch(1U));
-				vPICOMMS_TX__Add_U8(PI_PACKET__FCU__PUSHER_STATE, u8FCU_PUSHER__Get_PusherState());
+				vPICOMMS_ENC__Next_U8(u8FCU_PUSHER__Get_Switch(0U));
+				vPICOMMS_ENC__Next_U8(u8FCU_PUSHER__Get_Switch(1U));
+				vPICOMMS_ENC__Next_U8(u8FCU_PUSHER__Get_PusherState());
 			#endif
 
 			#if C_LOCALDEF__LCCM655__ENABLE_ACCEL == 1U
-				vPICOMMS_TX__Add_S16(PI_PACKET__FCU__ACCEL1_X, s16FCU_ACCEL__Get_LastSample(0U, 0U));
-				vPICOMMS_TX__Add_S16(PI_PACKET__FCU__ACCEL1_Y, s16FCU_ACCEL__Get_LastSample(0U, 1U));
-				vPICOMMS_TX__Add_S16(PI_PACKET__FCU__ACCEL1_Z, s16FCU_ACCEL__Get_LastSample(0U, 2U));
+				vPICOMMS_ENC__Next_S16(s16FCU_ACCEL__Get_LastSample(0U, 0U));
+				vPICOMMS_ENC__Next_S16(s16FCU_ACCEL__Get_LastSample(0U, 1U));
+				vPICOMMS_ENC__Next_S16(s16FCU_ACCEL__Get_LastSample(0U, 2U));
 
-				vPICOMMS_TX__Add_F32(PI_PACKET__FCU__ACCEL1_GFORCE_X, f32FCU_ACCEL__Get_LastG(0U, 0U));
-				vPICOMMS_TX__Add_F32(PI_PACKET__FCU__ACCEL1_GFORCE_Y, f32FCU_ACCEL__Get_LastG(0U, 1U));
-				vPICOMMS_TX__Add_F32(PI_PACKET__FCU__ACCEL1_GFORCE_Z, f32FCU_ACCEL__Get_LastG(0U, 2U));
+				vPICOMMS_ENC__Next_F32(f32FCU_ACCEL__Get_LastG(0U, 0U));
+				vPICOMMS_ENC__Next_F32(f32FCU_ACCEL__Get_LastG(0U, 1U));
+				vPICOMMS_ENC__Next_F32(f32FCU_ACCEL__Get_LastG(0U, 2U));
 
 			#endif
 
 
 			//move to transmit
-			sFCU.sPiComms.eState = PICOM_STATE__START_DMA;
-
-			break;
-
-		case PICOM_STATE__START_DMA:
-			//end the frame
-			u32Length = (Luint32)PICOMMS_TX_endFrame();
-
-			//get the buffer pointer
-			pu8Buffer = pu8I2CTx__Get_BufferPointer();
-
-			//todo, probably should check transaction is not running
+			sFCU.sPiComms.eState = PICOM_STATE__QUEUE_FRAME;
 
-			//start the transaction.
-			#if C_LOCALDEF__LCCM282__ENABLE_DMA == 1U
-				vRM4_SCI_DMA__Begin_Tx(SCI_CHANNEL__2, pu8Buffer, u32Length);
-			#endif
-
-			//change state
-				sFCU.sPiComms.eState = PICOM_STATE__WAIT_DMA;
 			break;
 
-		case PICOM_STATE__WAIT_DMA:
-
-			//test if the DMA is running
-			#if C_LOCALDEF__LCCM282__ENABLE_DMA == 1U
-				u8Test = u8RM4_SCI_DMA__Is_TxBusy(SCI_CHANNEL__2);
-			#else
-				u8Test = 0U;
-			#endif
-			if(u8Test == 0U)
-			{
-				//cleanup the DMA interrupts for next time.
-				vRM4_SCI_DMA__Cleanup(SCI_CHANNEL__2);
-
-				//todo, for now go back to start.
-				sFCU.sPiComms.eState = PICOM_STATE__IDLE;
-			}
-			else
-			{
-				//stay in state
-			}
+		case PICOM_STATE__QUEUE_FRAME:
+			//end the frame and queue it, the DMA service picks it up when the wire is free
+			vPICOMMS_ENC__Queue_Frame();
 
+			//back to wait for the next tick
+			sFCU.sPiComms.eState = PICOM_STATE__IDLE;
 			break;
 
 	}
 
 }
 
-//100ms timer tick
-void vFCU_PICOMMS__100MS_ISR(void)
-{
-	//set the flag
-	sFCU.sPiComms.u8100MS_Timer = 1U;
-
-}
-
 /***************************************************************************//**
  * @brief
- * Process all the UINT8 parameters sent from the GS.
+ * Service the transmit DMA. When the last frame has left the wire hand the
+ * next queued frame straight to the DMA so there is no gap waiting for the
+ * next 10ms frame build.
  *
  */
-void vFCU_PICOMMS__recvLuint8(Luint16 u16Index, Luint8 data)
+static void vFCU_PICOMMS__Service_Tx(void)
 {
-
-	switch((E_PICOMMS__PACKET_TYPES_T)u16Index)
+	Luint8 u8Test;
+	Luint8 *pu8Buffer;
+	Luint16 u16Length;
+
+	//test if the DMA is running
+	#if C_LOCALDEF__LCCM282__ENABLE_DMA == 1U
+		u8Test = u8RM4_SCI_DMA__Is_TxBusy(SCI_CHANNEL__2);
+	#else
+		u8Test = 0U;
+	#endif
+	if(u8Test == 0U)
 	{
-//		case PI_PACKET__PWRNODE__NODE_PRESS_STREAM_CONTROL:
-//			break;
-
+		if(u8PICOMMS_TXQ__Is_OnWire() == 1U)
+		{
+			//cleanup the DMA interrupts for next time.
+			#if C_LOCALDEF__LCCM282__ENABLE_DMA == 1U
+				vRM4_SCI_DMA__Cleanup(SCI_CHANNEL__2);
+			#endif
 
+			//free the buffer
+			vPICOMMS_TXQ__Tx_Complete();
+		}
+		else
+		{
+			//nothing was sent
+		}
+
+		//start the next frame if there is one
+		pu8Buffer = pu8PICOMMS_TXQ__Start_Next(&u16Length);
+		if(pu8Buffer != 0)
+		{
+			#if C_LOCALDEF__LCCM282__ENABLE_DMA == 1U
+				vRM4_SCI_DMA__Begin_Tx(SCI_CHANNEL__2, pu8Buffer, (Luint32)u16Length);
+			#endif
+		}
+		else
+		{
+			//queue empty, the idle gap is recorded by the queue
+		}
 	}
-
-/*
-	switch(index)
+	else
 	{
-		case  10000: sPC.sLp.PICOMMS_LOOP_UINT8 = data;
-				break;
+		//still sending
 	}
-*/
-
 }
 
 /***************************************************************************//**
  * @brief
- * Process all the INT8 parameters sent from the GS.
+ * Compile the telemetry frame template. The order here must match the
+ * order of the Next_xxx calls in PICOM_STATE__ASSEMBLE_BUFFER, any mismatch
+ * is counted in the PiComms template faults.
  *
  */
-void vFCU_PICOMMS__recvLint8(Luint16 index, Lint8 data)
+static void vFCU_PICOMMS__Compile_Template(void)
 {
-	switch(index)
-	{
-		case  10001: sPC.sLp.PICOMMS_LOOP_INT8 = data;
-				break;
-	}
-}
+	Luint8 u8Counter;
 
-/***************************************************************************//**
- * @brief
- * Process all the UINT16 parameters sent from the GS.
- *
- */
-void vFCU_PICOMMS__recvLuint16(Luint16 index, Luint16 data)
-{
-	switch(index)
-	{
-		case  10002: sPC.sLp.PICOMMS_LOOP_UINT16 = data;
-				break;
-	}
-}
+	u16FCU_PICOMMS_NumTxParams = 0U;
 
-/***************************************************************************//**
- * @brief
- * Process all the INT16 parameters sent from the GS.
- *
- */
-void vFCU_PICOMMS__recvLint16(Luint16 index, Lint16 data)
-{
-	switch(index)
-	{
-		case  10003: sPC.sLp.PICOMMS_LOOP_INT16 = data;
-				break;
-	}
-}
+	#if C_LOCALDEF__LCCM655__ENABLE_BRAKES == 1U
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU_BRAKES__LEFT__SCREW_POS, (Luint8)PICOMMS_FLOAT, 0.01F);
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU_BRAKES__RIGHT__SCREW_POS, (Luint8)PICOMMS_FLOAT, 0.01F);
 
-/***************************************************************************//**
- * @brief
- * Process all the UINT32 parameters sent from the GS.
- *
- */
-void vFCU_PICOMMS__recvLuint32(Luint16 u16Index, Luint32 u32Data)
-{
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU_BRAKES__LEFT__LIMIT_EXTEND, (Luint8)PICOMMS_UINT8, 0.0F);
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU_BRAKES__RIGHT__LIMIT_EXTEND, (Luint8)PICOMMS_UINT8, 0.0F);
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU_BRAKES__LEFT__LIMIT_RETRACT, (Luint8)PICOMMS_UINT8, 0.0F);
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU_BRAKES__RIGHT__LIMIT_RETRACT, (Luint8)PICOMMS_UINT8, 0.0F);
 
-	switch((E_PICOMMS__PACKET_TYPES_T)u16Index)
-	{
-
-		case PI_PACKET__PWRNODE__POD_STOP_UNLOCK_KEY:
-			break;
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU_BRAKES__LEFT__IBEAM_DIST, (Luint8)PICOMMS_FLOAT, 0.01F);
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU_BRAKES__RIGHT__IBEAM_DIST, (Luint8)PICOMMS_FLOAT, 0.01F);
 
-		case PI_PACKET__PWRNODE__POD_STOP_COMMAND:
-			break;
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU_BRAKES__LEFT__ADC_RAW, (Luint8)PICOMMS_UINT16, 2.0F);
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU_BRAKES__RIGHT__ADC_RAW, (Luint8)PICOMMS_UINT16, 2.0F);
 
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU_BRAKES__LEFT__MLP_SCALED, (Luint8)PICOMMS_FLOAT, 0.01F);
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU__BRAKES__RIGHT__MLP_SCALED, (Luint8)PICOMMS_FLOAT, 0.01F);
+	#endif //C_LOCALDEF__LCCM655__ENABLE_BRAKES
 
-		case PI_PACKET__FCU_BRAKES__SET_LEFTMOTOR__MICROSTEPS:
-			vSTEPDRIVE_MEM__Set_MicroStepResolution(0U, (Luint8)u32Data);
-			break;
-		case PI_PACKET__FCU_BRAKES__SET_LEFTMOTOR__STEPS_REV:
-			//hard coded
-			break;
+	#if C_LOCALDEF__LCCM655__ENABLE_LASER_OPTONCDT == 1U
+		for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM655__NUM_LASER_OPTONCDT; u8Counter++)
+		{
+			vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU__LASER__PITCH_FL + u8Counter, (Luint8)PICOMMS_FLOAT, 0.01F);
+		}
+	#endif
 
-		case PI_PACKET__FCU_BRAKES__SET_RIGHTMOTOR__MICROSTEPS:
-			vSTEPDRIVE_MEM__Set_MicroStepResolution(1U, (Luint8)u32Data);
-			break;
-		case PI_PACKET__FCU_BRAKES__SET_RIGHTMOTOR__STEPS_REV:
-			//hard coded
-			break;
+	#if C_LOCALDEF__LCCM655__ENABLE_PUSHER == 1U
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU__PUSHER_SW_A, (Luint8)PICOMMS_UINT8, 0.0F);
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU__PUSHER_SW_B, (Luint8)PICOMMS_UINT8, 0.0F);
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU__PUSHER_STATE, (Luint8)PICOMMS_UINT8, 0.0F);
+	#endif
 
-		default:
-			//do nothing.
-			break;
+	#if C_LOCALDEF__LCCM655__ENABLE_ACCEL == 1U
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU__ACCEL1_X, (Luint8)PICOMMS_INT16, 4.0F);
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU__ACCEL1_Y, (Luint8)PICOMMS_INT16, 4.0F);
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU__ACCEL1_Z, (Luint8)PICOMMS_INT16, 4.0F);
 
-	}//switch((E_PICOMMS__PACKET_TYPES_T)index)
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU__ACCEL1_GFORCE_X, (Luint8)PICOMMS_FLOAT, 0.005F);
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU__ACCEL1_GFORCE_Y, (Luint8)PICOMMS_FLOAT, 0.005F);
+		vFCU_PICOMMS__Add_TemplateParam(PI_PACKET__FCU__ACCEL1_GFORCE_Z, (Luint8)PICOMMS_FLOAT, 0.005F);
+	#endif
 
-	/*
-	switch(u16Index)
-	{
-		case  10004: sPC.sLp.PICOMMS_LOOP_UINT32 = data;
-				break;
-	}
-	*/
+	//build the escaped headers
+	vPICOMMS_TEMPLATE__Compile(&sFCU.sPiComms.sTxTemplate, &sFCU_PICOMMS_TxParams[0], u16FCU_PICOMMS_NumTxParams);
 }
 
 /***************************************************************************//**
  * @brief
- * Process all the INT32 parameters sent from the GS.
+ * Add one param to the template list
  *
+ * @param[in]		u16Index				Param index
+ * @param[in]		u8Type					Param type
+ * @param[in]		f32Deadband				Change needed before a delta frame resends it
  */
-void vFCU_PICOMMS__recvLint32(Luint16 u16Index, Lint32 s32Data)
+static void vFCU_PICOMMS__Add_TemplateParam(Luint16 u16Index, Luint8 u8Type, Lfloat32 f32Deadband)
 {
-
-	switch((E_PICOMMS__PACKET_TYPES_T)u16Index)
+	if(u16FCU_PICOMMS_NumTxParams < C_PICOMMS_TEMPLATE__MAX_PARAMS)
 	{
-
-		case PI_PACKET__FCU_BRAKES__SET_LEFTMOTOR__MAX_ACCEL:
-			vSTEPDRIVE_MEM__Set_MaxAngularAccel(0U, s32Data);
-			break;
-		case PI_PACKET__FCU_BRAKES__SET_LEFTMOTOR__MICRO_REV:
-			vSTEPDRIVE_MEM__Set_PicoMeters_PerRev(0U, s32Data);
-			break;
-		case PI_PACKET__FCU_BRAKES__SET_LEFTMOTOR__MAX_VELOC:
-			vSTEPDRIVE_MEM__Set_MaxRPM(0U, s32Data);
-			break;
-
-		case PI_PACKET__FCU_BRAKES__SET_RIGHTMOTOR__MAX_ACCEL:
-			vSTEPDRIVE_MEM__Set_MaxAngularAccel(1U, s32Data);
-			break;
-		case PI_PACKET__FCU_BRAKES__SET_RIGHTMOTOR__MICRO_REV:
-			vSTEPDRIVE_MEM__Set_PicoMeters_PerRev(1U, s32Data);
-			break;
-		case PI_PACKET__FCU_BRAKES__SET_RIGHTMOTOR__MAX_VELOC:
-			vSTEPDRIVE_MEM__Set_MaxRPM(1U, s32Data);
-			break;
-
-
-		default:
-			//do nothing.
-			break;
-
-	}//switch((E_PICOMMS__PACKET_TYPES_T)index)
-	/*
-	switch(index)
+		sFCU_PICOMMS_TxParams[u16FCU_PICOMMS_NumTxParams].u16Index = u16Index;
+		sFCU_PICOMMS_TxParams[u16FCU_PICOMMS_NumTxParams].u8Type = u8Type;
+		sFCU_PICOMMS_TxParams[u16FCU_PICOMMS_NumTxParams].f32Deadband = f32Deadband;
+		u16FCU_PICOMMS_NumTxParams++;
+	}
+	else
 	{
-		case  10005: sPC.sLp.PICOMMS_LOOP_INT32 = data;
-				break;
+		//too many params, the extra ones will be flagged as template faults
 	}
-	*/
 }
 
 /***************************************************************************//**
  * @brief
- * Process all the UINT64 parameters sent from the GS.
+ * A frame from the GS has been applied to sRxCmd, act on whatever changed.
  *
  */
-void vFCU_PICOMMS__recvLuint64(Luint16 index, Luint64 data)
+static void vFCU_PICOMMS__Rx_Commit(void)
 {
-	switch(index)
+	Luint8 u8Motor;
+	Luint16 u16Slot;
+
+	if(u8PICOMMS_RX__Was_Updated((Luint16)FCU_PICOMMS_RX__IBEAM_DIST) == 1U)
 	{
-		case  10006: sPC.sLp.PICOMMS_LOOP_UINT64 = data;
-				break;
+		#if C_LOCALDEF__LCCM655__ENABLE_BRAKES == 1U
+			vFCU_BRAKES__Move_IBeam_Distance_mm(sFCU.sPiComms.sRxCmd.f32IBeamDist);
+		#endif
+	}
+	else
+	{
+		//no change
 	}
-}
 
-/***************************************************************************//**
- * @brief
- * Process all the INT64 parameters sent from the GS.
- *
- */
-void vFCU_PICOMMS__recvLint64(Luint16 index, Lint64 data)
-{
-	switch(index)
+	for(u8Motor = 0U; u8Motor < 2U; u8Motor++)
 	{
-		case  10007: sPC.sLp.PICOMMS_LOOP_INT64 = data;
-				break;
+		//the right motor slots follow the left
+		u16Slot = (Luint16)FCU_PICOMMS_RX__LEFT_MICROSTEPS + ((Luint16)u8Motor * 4U);
+
+		if(u8PICOMMS_RX__Was_Updated(u16Slot) == 1U)
+		{
+			vSTEPDRIVE_MEM__Set_MicroStepResolution(u8Motor, (Luint8)sFCU.sPiComms.sRxCmd.u32MicroSteps[u8Motor]);
+		}
+		else
+		{
+			//no change
+		}
+
+		if(u8PICOMMS_RX__Was_Updated(u16Slot + 1U) == 1U)
+		{
+			vSTEPDRIVE_MEM__Set_MaxAngularAccel(u8Motor, sFCU.sPiComms.sRxCmd.s32MaxAccel[u8Motor]);
+		}
+		else
+		{
+			//no change
+		}
+
+		if(u8PICOMMS_RX__Was_Updated(u16Slot + 2U) == 1U)
+		{
+			vSTEPDRIVE_MEM__Set_PicoMeters_PerRev(u8Motor, sFCU.sPiComms.sRxCmd.s32MicroRev[u8Motor]);
+		}
+		else
+		{
+			//no change
+		}
+
+		if(u8PICOMMS_RX__Was_Updated(u16Slot + 3U) == 1U)
+		{
+			vSTEPDRIVE_MEM__Set_MaxRPM(u8Motor, sFCU.sPiComms.sRxCmd.s32MaxVeloc[u8Motor]);
+		}
+		else
+		{
+			//no change
+		}
 	}
 }
 
 /***************************************************************************//**
  * @brief
- * Process all the FLOAT32 parameters sent from the GS.
+ * Microstep resolution is stored as a U8 by the stepper layer
  *
+ * @param[in]		u16Index				Param index
+ * @param[in]		puValue					The received value
+ * @return			1 = accept
  */
-void vFCU_PICOMMS__recvLfloat32(Luint16 u16Index, Lfloat32 f32Data)
+static Luint8 u8FCU_PICOMMS__Check_MicroSteps(Luint16 u16Index, const PICOMMS_RX_VALUE_T *puValue)
 {
+	Luint8 u8Return;
 
-	switch((E_PICOMMS__PACKET_TYPES_T)u16Index)
+	if(puValue->u32 <= 0xFFU)
 	{
-		case PI_PACKET__FCU_BRAKES__SET_IBEAM_DIST:
-			#if C_LOCALDEF__LCCM655__ENABLE_BRAKES == 1U
-				vFCU_BRAKES__Move_IBeam_Distance_mm(f32Data);
-			#endif
-			break;
-
+		u8Return = 1U;
 	}
-
-/*
-
-	switch(index)
+	else
 	{
-		case  10008: sPC.sLp.PICOMMS_LOOP_FLOAT32 = data;
-				break;
+		u8Return = 0U;
 	}
-*/
-}
 
-/***************************************************************************//**
- * @brief
- * Process all the FLOAT64 parameters sent from the GS.
- *
- */
-void vFCU_PICOMMS__recvLfloat64(Luint16 index, Lfloat64 data)
-{
-	switch(index)
-	{
-		case  10009: sPC.sLp.PICOMMS_LOOP_FLOAT64 = data;
-				break;
-	}
+	return u8Return;
 }
 
 #endif //C_LOCALDEF__LCCM655__ENABLE_PI_COMMS
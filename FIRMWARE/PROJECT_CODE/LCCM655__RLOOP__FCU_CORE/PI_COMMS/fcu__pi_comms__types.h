@@ -2,6 +2,10 @@
 #ifndef RLOOP_LCCM655__RLOOP__FCU_CORE_PI_COMMS_FCU__PI_COMMS__TYPES_H_
 #define RLOOP_LCCM655__RLOOP__FCU_CORE_PI_COMMS_FCU__PI_COMMS__TYPES_H_
 
+	/** Telemetry frames between full keyframes, frames are sent every 10ms
+	 * when the DMA is free so this is around 0.5s */
+	#define C_FCU_PICOMMS__KEYFRAME_PERIOD				(50U)
+
 
 	/** Pi Comms SM types*/
 	typedef enum
@@ -16,15 +20,44 @@
 		/** assemble the next buffer of data */
 		PICOM_STATE__ASSEMBLE_BUFFER,
 
-		/** Star the DMA transaction */
-		PICOM_STATE__START_DMA,
-
-		/** once started, wait for the DMA to complete */
-		PICOM_STATE__WAIT_DMA,
+		/** Close the frame and hand it to the transmit queue */
+		PICOM_STATE__QUEUE_FRAME,
 
 
 	}E_FCU_PICOM__STATE_T;
 
+	/** Slots in our receive table, must be in the same order as the table
+	 * which is sorted by packet index */
+	typedef enum
+	{
+		/** GS loopback test params */
+		FCU_PICOMMS_RX__LOOP_S8 = 0U,
+		FCU_PICOMMS_RX__LOOP_U16,
+		FCU_PICOMMS_RX__LOOP_S16,
+		FCU_PICOMMS_RX__LOOP_U64,
+		FCU_PICOMMS_RX__LOOP_S64,
+		FCU_PICOMMS_RX__LOOP_F64,
+
+		/** Brakes I-Beam distance */
+		FCU_PICOMMS_RX__IBEAM_DIST,
+
+		/** Left motor, the right motor follows in the same order */
+		FCU_PICOMMS_RX__LEFT_MICROSTEPS,
+		FCU_PICOMMS_RX__LEFT_MAX_ACCEL,
+		FCU_PICOMMS_RX__LEFT_MICRO_REV,
+		FCU_PICOMMS_RX__LEFT_MAX_VELOC,
+
+		/** Right motor */
+		FCU_PICOMMS_RX__RIGHT_MICROSTEPS,
+		FCU_PICOMMS_RX__RIGHT_MAX_ACCEL,
+		FCU_PICOMMS_RX__RIGHT_MICRO_REV,
+		FCU_PICOMMS_RX__RIGHT_MAX_VELOC,
+
+		/** Table size */
+		FCU_PICOMMS_RX__NUM_SLOTS
+
+	}E_FCU_PICOMMS_RX__SLOT_T;
+
 
 
 #endif /* RLOOP_LCCM655__RLOOP__FCU_CORE_PI_COMMS_FCU__PI_COMMS__TYPES_H_ */
@@ -45,7 +45,7 @@ void vFCU_PUSHER__Init(void)
 	sFCU.sPusher.sSwitches[1].u8EdgeFlag = 0U;
 	sFCU.sPusher.sSwitches[0].u8SwitchState = 0U;
 	sFCU.sPusher.sSwitches[1].u8SwitchState = 0U;
-	sFCU.sPusher.u32SwtichTimer = 0U;
+	sFCU.sPusher.u32SwitchEdge_ms = 0U;
 	sFCU.sPusher.u32Guard1 = 0x12344321U;
 	sFCU.sPusher.u32Guard2 = 0x01020304U;
 
@@ -110,7 +110,7 @@ void vFCU_PUSHER__Process(void)
 				sFCU.sPusher.sSwitches[0].u8EdgeFlag = 0U;
 
 				//lets do a state change
-				sFCU.sPusher.u32SwtichTimer = 0U;
+				sFCU.sPusher.u32SwitchEdge_ms = u32FCU_SCHED__Get_Now_ms();
 				sFCU.sPusher.eState = PUSH_STATE__WAIT_SW_STABLE;
 			}
 			else
@@ -134,7 +134,7 @@ void vFCU_PUSHER__Process(void)
 				sFCU.sPusher.sSwitches[1].u8EdgeFlag = 0U;
 
 				//lets do a state change
-				sFCU.sPusher.u32SwtichTimer = 0U;
+				sFCU.sPusher.u32SwitchEdge_ms = u32FCU_SCHED__Get_Now_ms();
 				sFCU.sPusher.eState = PUSH_STATE__WAIT_SW_STABLE;
 			}
 			else
@@ -158,9 +158,8 @@ void vFCU_PUSHER__Process(void)
 			//we can treat both switches the same in ensuring some time elapses, however if we get a new
 			//state transition during this time
 
-			//wait for 100ms, could be +/-10ms tho due to the relationship of interrupt timing to our
-			//state machine
-			if(sFCU.sPusher.u32SwtichTimer > 10U)
+			//wait for 100ms, could be +10ms tho as we run every 10ms
+			if((u32FCU_SCHED__Get_Now_ms() - sFCU.sPusher.u32SwitchEdge_ms) >= C_FCU__PUSHER__SWITCH_SETTLE_MS)
 			{
 				//we have waited 100ms
 				//change state.
@@ -342,28 +341,6 @@ Luint8 u8FCU_PUSHER__Get_InterlockB(void)
 }
 #endif //C_LOCALDEF__LCCM655__ENABLE_PUSHER
 
-/***************************************************************************//**
- * @brief
- * 10ms interrupt function, coming from FCU Core indicating that a new
- * 10mS event has occurred.
- *
- */
-/***************************************************************************//**
- * @brief
- * ToDo
- * 
- * @st_funcMD5		D970044779CEE3EA4596DB4D7FFBA79F
- * @st_funcID		LCCM655R0.FILE.012.FUNC.009
- */
-void vFCU_PUSHER__10MS_ISR(void)
-{
-	#if C_LOCALDEF__LCCM655__ENABLE_PUSHER == 1U
-		//increment the timer always. Dont be concerned with rollover as we manage the timer
-		//in the state machine.
-		sFCU.sPusher.u32SwtichTimer++;
-	#endif
-}
-
 #ifndef C_LOCALDEF__LCCM655__ENABLE_PUSHER
 	#error
 #endif
@@ -0,0 +1,652 @@
+/**
+ * @file		FCU__SCHEDULER.C
+ * @brief		Time triggered cooperative task scheduler
+ *
+ * @note
+ * Time is cut into 1ms slots off M_LOCALDEF__LCCM655__SCHED__TICKS(). A task
+ * is due in every slot where (slot - phase) is a multiple of its period, and
+ * when several are due they run in priority order. The clock is looked at
+ * again after each task so something more urgent that came due goes next.
+ * Period 0 tasks are the old superloop, they run once per pass after the
+ * timed ones.
+ *
+ * Nothing is preempted, a task that runs long holds up everything behind it,
+ * so every task is timed against its worst case budget. Going over sets the
+ * TASK_OVERRUN fault, a release that comes round again before the last one
+ * ran is counted as late.
+ *
+ * With the phase left to us (C_FCU__SCHED__PHASE_AUTO) a task goes in the slot
+ * that has the least budget already due in it, so the 100ms group ends up
+ * spread over different slots rather than all landing on one.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM655R0.FILE.045
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FCU
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FCU__SCHEDULER
+ * @ingroup FCU
+ * @{ */
+
+#include "../fcu_core.h"
+
+#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
+
+//the structure
+extern struct _strFCU sFCU;
+
+//locals
+static void vFCU_SCHED__Update(void);
+static void vFCU_SCHED__Release(Luint32 u32Slot);
+static void vFCU_SCHED__Run(Luint8 u8Task);
+static Luint16 u16FCU_SCHED__Auto_Phase(Luint16 u16Period_ms);
+
+
+/***************************************************************************//**
+ * @brief
+ * Empty the task table
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.001
+ */
+void vFCU_SCHED__Init(void)
+{
+	sFCU.sSched.u8NumTasks = 0U;
+	sFCU.sSched.u32Now_ms = 0U;
+	sFCU.sSched.u32SlotTicks = 0U;
+	sFCU.sSched.sReplay.u32Length_ms = 0U;
+	vFCU_SCHED__Clear_Stats();
+}
+
+/***************************************************************************//**
+ * @brief
+ * Add a task to the table
+ *
+ * @note
+ * Tasks with the same priority run in the order they were added.
+ *
+ * @param[in]		u32Budget_us			Worst case run time, 0 = don't check
+ * @param[in]		u8Priority				Lowest runs first
+ * @param[in]		u16Phase_ms				First slot, < period, or C_FCU__SCHED__PHASE_AUTO
+ * @param[in]		u16Period_ms			Period, 0 = every pass
+ * @param[in]		pFunc					Entry point
+ * @return			-1 = table full or bad phase\n
+ *					else the task index for the stats
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.002
+ */
+Lint16 s16FCU_SCHED__Add(void (*pFunc)(void), Luint16 u16Period_ms, Luint16 u16Phase_ms, Luint8 u8Priority, Luint32 u32Budget_us)
+{
+	Lint16 s16Return;
+	Luint8 u8Task;
+	Luint8 u8Pos;
+	Luint8 u8Counter;
+
+	if((sFCU.sSched.u8NumTasks >= C_FCU__SCHED__MAX_TASKS) || (pFunc == 0) ||
+		((u16Period_ms != 0U) && (u16Phase_ms != C_FCU__SCHED__PHASE_AUTO) && (u16Phase_ms >= u16Period_ms)))
+	{
+		s16Return = -1;
+	}
+	else
+	{
+		if(u16Period_ms == 0U)
+		{
+			u16Phase_ms = 0U;
+		}
+		else if(u16Phase_ms == C_FCU__SCHED__PHASE_AUTO)
+		{
+			u16Phase_ms = u16FCU_SCHED__Auto_Phase(u16Period_ms);
+		}
+		else
+		{
+			//fixed
+		}
+
+		u8Task = sFCU.sSched.u8NumTasks;
+		sFCU.sSched.sTask[u8Task].pFunc = pFunc;
+		sFCU.sSched.sTask[u8Task].u16Period_ms = u16Period_ms;
+		sFCU.sSched.sTask[u8Task].u16Phase_ms = u16Phase_ms;
+		sFCU.sSched.sTask[u8Task].u8Priority = u8Priority;
+		sFCU.sSched.sTask[u8Task].u32Budget_us = u32Budget_us;
+		sFCU.sSched.sTask[u8Task].u8Pending = 0U;
+
+		//first slot from now in its phase
+		if(u16Period_ms != 0U)
+		{
+			sFCU.sSched.sTask[u8Task].u32Next_ms = (sFCU.sSched.u32Now_ms - (sFCU.sSched.u32Now_ms % u16Period_ms)) + u16Phase_ms;
+			if((Lint32)(sFCU.sSched.u32Now_ms - sFCU.sSched.sTask[u8Task].u32Next_ms) > 0)
+			{
+				sFCU.sSched.sTask[u8Task].u32Next_ms += u16Period_ms;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		else
+		{
+			sFCU.sSched.sTask[u8Task].u32Next_ms = 0U;
+		}
+
+		sFCU.sSched.sTask[u8Task].sStats.u32Runs = 0U;
+		sFCU.sSched.sTask[u8Task].sStats.u32Overruns = 0U;
+		sFCU.sSched.sTask[u8Task].sStats.u32Late = 0U;
+		sFCU.sSched.sTask[u8Task].sStats.u32Exec_Last_us = 0U;
+		sFCU.sSched.sTask[u8Task].sStats.u32Exec_Max_us = 0U;
+		sFCU.sSched.sTask[u8Task].sStats.u64Exec_Total_us = 0U;
+		sFCU.sSched.sTask[u8Task].sStats.u32Delay_Max_ms = 0U;
+		sFCU.sSched.sTask[u8Task].sReplay.u32Response_Max_us = 0U;
+		sFCU.sSched.sTask[u8Task].sReplay.u32Misses = 0U;
+
+		//into the run order behind anything of the same priority
+		u8Pos = u8Task;
+		for(u8Counter = u8Task; u8Counter > 0U; u8Counter--)
+		{
+			if(sFCU.sSched.sTask[sFCU.sSched.u8Order[u8Counter - 1U]].u8Priority > u8Priority)
+			{
+				sFCU.sSched.u8Order[u8Counter] = sFCU.sSched.u8Order[u8Counter - 1U];
+				u8Pos = u8Counter - 1U;
+			}
+			else
+			{
+				//stays ahead of us
+			}
+		}
+		sFCU.sSched.u8Order[u8Pos] = u8Task;
+
+		sFCU.sSched.u8NumTasks++;
+		s16Return = (Lint16)u8Task;
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Start the clock, once the timebase is running
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.003
+ */
+void vFCU_SCHED__Start(void)
+{
+	sFCU.sSched.u32SlotTicks = M_LOCALDEF__LCCM655__SCHED__TICKS();
+	vFCU_SCHED__Release(sFCU.sSched.u32Now_ms);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Run whatever is due then the background tasks, call from the main loop
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.004
+ */
+void vFCU_SCHED__Process(void)
+{
+	Luint8 u8Run;
+	Luint8 u8Counter;
+	Luint8 u8Task;
+	Luint8 u8Found;
+	Luint32 u32Delay;
+
+	sFCU.sSched.u32Passes++;
+	vFCU_SCHED__Update();
+
+	//timed tasks, most urgent first. No more runs than there are tasks so a
+	//task that is always due can't hold the background off
+	u8Found = 1U;
+	for(u8Run = 0U; (u8Run < sFCU.sSched.u8NumTasks) && (u8Found == 1U); u8Run++)
+	{
+		u8Found = 0U;
+		for(u8Counter = 0U; (u8Counter < sFCU.sSched.u8NumTasks) && (u8Found == 0U); u8Counter++)
+		{
+			u8Task = sFCU.sSched.u8Order[u8Counter];
+			if(sFCU.sSched.sTask[u8Task].u8Pending == 1U)
+			{
+				u8Found = 1U;
+				sFCU.sSched.sTask[u8Task].u8Pending = 0U;
+
+				//from the latest release
+				u32Delay = (sFCU.sSched.u32Now_ms + sFCU.sSched.sTask[u8Task].u16Period_ms) - sFCU.sSched.sTask[u8Task].u32Next_ms;
+				if(u32Delay > sFCU.sSched.sTask[u8Task].sStats.u32Delay_Max_ms)
+				{
+					sFCU.sSched.sTask[u8Task].sStats.u32Delay_Max_ms = u32Delay;
+				}
+				else
+				{
+					//fall on
+				}
+
+				vFCU_SCHED__Run(u8Task);
+				vFCU_SCHED__Update();
+			}
+			else
+			{
+				//not due
+			}
+		}
+	}
+
+	//then the background once
+	for(u8Counter = 0U; u8Counter < sFCU.sSched.u8NumTasks; u8Counter++)
+	{
+		u8Task = sFCU.sSched.u8Order[u8Counter];
+		if(sFCU.sSched.sTask[u8Task].u16Period_ms == 0U)
+		{
+			vFCU_SCHED__Run(u8Task);
+		}
+		else
+		{
+			//timed
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Move the slot on to the clock and release anything that came due
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.005
+ */
+static void vFCU_SCHED__Update(void)
+{
+	Luint32 u32Slots;
+
+	u32Slots = (M_LOCALDEF__LCCM655__SCHED__TICKS() - sFCU.sSched.u32SlotTicks) / C_LOCALDEF__LCCM655__SCHED__TICKS_PER_MS;
+	if(u32Slots > 0U)
+	{
+		sFCU.sSched.u32SlotTicks += u32Slots * C_LOCALDEF__LCCM655__SCHED__TICKS_PER_MS;
+		sFCU.sSched.u32Now_ms += u32Slots;
+		sFCU.sSched.u32SlotsDropped += u32Slots - 1U;
+
+		vFCU_SCHED__Release(sFCU.sSched.u32Now_ms);
+	}
+	else
+	{
+		//same slot
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Release the tasks due by a slot
+ *
+ * @param[in]		u32Slot					Slot
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.006
+ */
+static void vFCU_SCHED__Release(Luint32 u32Slot)
+{
+	Luint8 u8Task;
+
+	for(u8Task = 0U; u8Task < sFCU.sSched.u8NumTasks; u8Task++)
+	{
+		if((sFCU.sSched.sTask[u8Task].u16Period_ms != 0U) && ((Lint32)(u32Slot - sFCU.sSched.sTask[u8Task].u32Next_ms) >= 0))
+		{
+			if(sFCU.sSched.sTask[u8Task].u8Pending == 1U)
+			{
+				//still waiting from last time
+				sFCU.sSched.sTask[u8Task].sStats.u32Late++;
+			}
+			else
+			{
+				sFCU.sSched.sTask[u8Task].u8Pending = 1U;
+			}
+			sFCU.sSched.sTask[u8Task].u32Next_ms += sFCU.sSched.sTask[u8Task].u16Period_ms;
+
+			//slots we never saw
+			while((Lint32)(u32Slot - sFCU.sSched.sTask[u8Task].u32Next_ms) >= 0)
+			{
+				sFCU.sSched.sTask[u8Task].sStats.u32Late++;
+				sFCU.sSched.sTask[u8Task].u32Next_ms += sFCU.sSched.sTask[u8Task].u16Period_ms;
+			}
+		}
+		else
+		{
+			//not yet, or background
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Run a task and time it
+ *
+ * @param[in]		u8Task					Task index
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.007
+ */
+static void vFCU_SCHED__Run(Luint8 u8Task)
+{
+	Luint32 u32Start;
+	Luint32 u32Exec;
+
+	u32Start = M_LOCALDEF__LCCM655__SCHED__TICKS();
+	sFCU.sSched.sTask[u8Task].pFunc();
+	u32Exec = M_LOCALDEF__LCCM655__SCHED__TICKS() - u32Start;
+	u32Exec = (Luint32)(((Luint64)u32Exec * 1000U) / C_LOCALDEF__LCCM655__SCHED__TICKS_PER_MS);
+
+	sFCU.sSched.sTask[u8Task].sStats.u32Runs++;
+	sFCU.sSched.sTask[u8Task].sStats.u32Exec_Last_us = u32Exec;
+	sFCU.sSched.sTask[u8Task].sStats.u64Exec_Total_us += u32Exec;
+	if(u32Exec > sFCU.sSched.sTask[u8Task].sStats.u32Exec_Max_us)
+	{
+		sFCU.sSched.sTask[u8Task].sStats.u32Exec_Max_us = u32Exec;
+	}
+	else
+	{
+		//fall on
+	}
+
+	if((sFCU.sSched.sTask[u8Task].u32Budget_us != 0U) && (u32Exec > sFCU.sSched.sTask[u8Task].u32Budget_us))
+	{
+		sFCU.sSched.sTask[u8Task].sStats.u32Overruns++;
+		vFAULTLINK__Set_Flag(&sFCU.sFaults.sTopLevel, C_LCCM655__CORE__FAULT_INDEX__00);
+		vFAULTLINK__Set_Flag(&sFCU.sFaults.sTopLevel, C_LCCM655__CORE__FAULT_INDEX__02);
+	}
+	else
+	{
+		//in time
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Pick the phase whose busiest slot carries the least budget
+ *
+ * @note
+ * A task with no budget still counts as 1us so those get spread out too.
+ *
+ * @param[in]		u16Period_ms			Period of the new task
+ * @return			Phase
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.008
+ */
+static Luint16 u16FCU_SCHED__Auto_Phase(Luint16 u16Period_ms)
+{
+	Luint16 u16Return;
+	Luint16 u16Phase;
+	Luint32 u32Horizon;
+	Luint32 u32Slot;
+	Luint32 u32Load;
+	Luint32 u32Worst;
+	Luint32 u32Best;
+	Luint8 u8Task;
+
+	u32Horizon = C_FCU__SCHED__HORIZON_MS;
+	if(u32Horizon < u16Period_ms)
+	{
+		u32Horizon = u16Period_ms;
+	}
+	else
+	{
+		//fall on
+	}
+
+	u16Return = 0U;
+	u32Best = 0xFFFFFFFFU;
+	for(u16Phase = 0U; u16Phase < u16Period_ms; u16Phase++)
+	{
+		u32Worst = 0U;
+		for(u32Slot = u16Phase; u32Slot < u32Horizon; u32Slot += u16Period_ms)
+		{
+			u32Load = 0U;
+			for(u8Task = 0U; u8Task < sFCU.sSched.u8NumTasks; u8Task++)
+			{
+				if((sFCU.sSched.sTask[u8Task].u16Period_ms != 0U) && ((u32Slot % sFCU.sSched.sTask[u8Task].u16Period_ms) == sFCU.sSched.sTask[u8Task].u16Phase_ms))
+				{
+					u32Load += sFCU.sSched.sTask[u8Task].u32Budget_us + 1U;
+				}
+				else
+				{
+					//not in this slot
+				}
+			}
+
+			if(u32Load > u32Worst)
+			{
+				u32Worst = u32Load;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+
+		if(u32Worst < u32Best)
+		{
+			u32Best = u32Worst;
+			u16Return = u16Phase;
+		}
+		else
+		{
+			//first one wins a tie
+		}
+	}
+
+	return u16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Zero the run stats of every task
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.009
+ */
+void vFCU_SCHED__Clear_Stats(void)
+{
+	Luint8 u8Task;
+
+	for(u8Task = 0U; u8Task < sFCU.sSched.u8NumTasks; u8Task++)
+	{
+		sFCU.sSched.sTask[u8Task].sStats.u32Runs = 0U;
+		sFCU.sSched.sTask[u8Task].sStats.u32Overruns = 0U;
+		sFCU.sSched.sTask[u8Task].sStats.u32Late = 0U;
+		sFCU.sSched.sTask[u8Task].sStats.u32Exec_Last_us = 0U;
+		sFCU.sSched.sTask[u8Task].sStats.u32Exec_Max_us = 0U;
+		sFCU.sSched.sTask[u8Task].sStats.u64Exec_Total_us = 0U;
+		sFCU.sSched.sTask[u8Task].sStats.u32Delay_Max_ms = 0U;
+	}
+	sFCU.sSched.u32SlotsDropped = 0U;
+	sFCU.sSched.u32Passes = 0U;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Tasks in the table
+ *
+ * @return			Count
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.010
+ */
+Luint8 u8FCU_SCHED__Get_NumTasks(void)
+{
+	return sFCU.sSched.u8NumTasks;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Phase a task ended up with
+ *
+ * @param[in]		u8Task					Task index
+ * @return			Phase
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.011
+ */
+Luint16 u16FCU_SCHED__Get_Phase_ms(Luint8 u8Task)
+{
+	return sFCU.sSched.sTask[u8Task].u16Phase_ms;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Times a task has run
+ *
+ * @param[in]		u8Task					Task index
+ * @return			Runs
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.012
+ */
+Luint32 u32FCU_SCHED__Get_Runs(Luint8 u8Task)
+{
+	return sFCU.sSched.sTask[u8Task].sStats.u32Runs;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Times a task went over its budget
+ *
+ * @param[in]		u8Task					Task index
+ * @return			Overruns
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.013
+ */
+Luint32 u32FCU_SCHED__Get_Overruns(Luint8 u8Task)
+{
+	return sFCU.sSched.sTask[u8Task].sStats.u32Overruns;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Releases a task lost by not running in time
+ *
+ * @param[in]		u8Task					Task index
+ * @return			Late releases
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.014
+ */
+Luint32 u32FCU_SCHED__Get_Late(Luint8 u8Task)
+{
+	return sFCU.sSched.sTask[u8Task].sStats.u32Late;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Longest a task has taken
+ *
+ * @param[in]		u8Task					Task index
+ * @return			Run time, us
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.015
+ */
+Luint32 u32FCU_SCHED__Get_ExecMax_us(Luint8 u8Task)
+{
+	return sFCU.sSched.sTask[u8Task].sStats.u32Exec_Max_us;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Mean run time of a task
+ *
+ * @param[in]		u8Task					Task index
+ * @return			Run time, us
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.016
+ */
+Lfloat32 f32FCU_SCHED__Get_ExecMean_us(Luint8 u8Task)
+{
+	Lfloat32 f32Return;
+
+	if(sFCU.sSched.sTask[u8Task].sStats.u32Runs > 0U)
+	{
+		f32Return = (Lfloat32)sFCU.sSched.sTask[u8Task].sStats.u64Exec_Total_us / (Lfloat32)sFCU.sSched.sTask[u8Task].sStats.u32Runs;
+	}
+	else
+	{
+		f32Return = 0.0F;
+	}
+
+	return f32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Load a worst case measured on the pod, for a replay on the host
+ *
+ * @param[in]		u32Exec_us				Run time
+ * @param[in]		u8Task					Task index
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.017
+ */
+void vFCU_SCHED__Set_ExecMax_us(Luint8 u8Task, Luint32 u32Exec_us)
+{
+	if(u8Task < sFCU.sSched.u8NumTasks)
+	{
+		sFCU.sSched.sTask[u8Task].sStats.u32Exec_Max_us = u32Exec_us;
+	}
+	else
+	{
+		//not a task
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * The slot clock, for module timers
+ *
+ * @return			ms since the scheduler started
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.018
+ */
+Luint32 u32FCU_SCHED__Get_Now_ms(void)
+{
+	return sFCU.sSched.u32Now_ms;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Periodic timer for work inside a task that is slower than the task, takes
+ * the place of the flags the RTI used to set.
+ *
+ * @note
+ * A timer that has fallen more than a period behind starts again from now
+ * rather than firing back to back.
+ *
+ * @param[in]		u16Period_ms			Period
+ * @param[in,out]	pu32Due_ms				Next due, start it at u32FCU_SCHED__Get_Now_ms()
+ * @return			1 = a period is up
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.045.FUNC.019
+ */
+Luint8 u8FCU_SCHED__Timer_Due(Luint32 *pu32Due_ms, Luint16 u16Period_ms)
+{
+	Luint8 u8Return;
+
+	if((Lint32)(sFCU.sSched.u32Now_ms - *pu32Due_ms) >= 0)
+	{
+		*pu32Due_ms += u16Period_ms;
+		if((Lint32)(sFCU.sSched.u32Now_ms - *pu32Due_ms) >= 0)
+		{
+			*pu32Due_ms = sFCU.sSched.u32Now_ms + u16Period_ms;
+		}
+		else
+		{
+			//on time
+		}
+		u8Return = 1U;
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+#endif //#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
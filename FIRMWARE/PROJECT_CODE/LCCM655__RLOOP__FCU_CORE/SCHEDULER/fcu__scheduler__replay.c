@@ -0,0 +1,325 @@
+/**
+ * @file		FCU__SCHEDULER__REPLAY.C
+ * @brief		Timing analysis of the scheduler table
+ *
+ * @note
+ * Walks the task table the same way vFCU_SCHED__Process() does but on a sim
+ * clock, each task costing the larger of its budget and the worst run time
+ * seen. Nothing is called, so on the host the table built by the FCU init can
+ * be replayed, with worst cases loaded from the pod by
+ * vFCU_SCHED__Set_ExecMax_us(), to get the response time of every task, the
+ * misses and the busiest slot before it flies.
+ *
+ * The background tasks are one pass of fixed cost that can't be cut short,
+ * so the worst response of a timed task includes one whole pass.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM655R0.FILE.046
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FCU
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FCU__SCHEDULER
+ * @ingroup FCU
+ * @{ */
+
+#include "../fcu_core.h"
+
+#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
+
+//the structure
+extern struct _strFCU sFCU;
+
+//locals
+static Luint32 u32FCU_SCHED_REPLAY__Cost_us(Luint8 u8Task);
+static void vFCU_SCHED_REPLAY__Release(Luint32 u32Slot);
+
+
+/***************************************************************************//**
+ * @brief
+ * Replay the table on a sim clock
+ *
+ * @param[in]		u32Length_ms			Time to replay, a multiple of the
+ *											longest period to see every slot
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.046.FUNC.001
+ */
+void vFCU_SCHED__Replay(Luint32 u32Length_ms)
+{
+	Luint64 u64Time_us;
+	Luint64 u64End_us;
+	Luint32 u32Slot;
+	Luint32 u32Response;
+	Luint8 u8Counter;
+	Luint8 u8Task;
+	Luint8 u8Found;
+	Luint8 u8Runs;
+
+	sFCU.sSched.sReplay.u32Length_ms = u32Length_ms;
+	sFCU.sSched.sReplay.u32PeakSlot_us = 0U;
+	sFCU.sSched.sReplay.u32PeakSlot_ms = 0U;
+	sFCU.sSched.sReplay.u64Busy_us = 0U;
+	sFCU.sSched.sReplay.u32Background_us = 0U;
+	sFCU.sSched.sReplay.u32Misses = 0U;
+
+	for(u8Task = 0U; u8Task < sFCU.sSched.u8NumTasks; u8Task++)
+	{
+		sFCU.sSched.sTask[u8Task].sReplay.u32Next_ms = sFCU.sSched.sTask[u8Task].u16Phase_ms;
+		sFCU.sSched.sTask[u8Task].sReplay.u32Release_us = 0U;
+		sFCU.sSched.sTask[u8Task].sReplay.u8Pending = 0U;
+		sFCU.sSched.sTask[u8Task].sReplay.u32Response_Max_us = 0U;
+		sFCU.sSched.sTask[u8Task].sReplay.u32Misses = 0U;
+
+		if(sFCU.sSched.sTask[u8Task].u16Period_ms == 0U)
+		{
+			sFCU.sSched.sReplay.u32Background_us += u32FCU_SCHED_REPLAY__Cost_us(u8Task);
+		}
+		else
+		{
+			//timed
+		}
+	}
+
+	u64Time_us = 0U;
+	u64End_us = (Luint64)u32Length_ms * 1000U;
+	u32Slot = 0U;
+	u8Runs = 0U;
+	while(u64Time_us < u64End_us)
+	{
+		//every slot that has started by now
+		while((u32Slot < u32Length_ms) && (((Luint64)u32Slot * 1000U) <= u64Time_us))
+		{
+			vFCU_SCHED_REPLAY__Release(u32Slot);
+			u32Slot++;
+		}
+
+		//most urgent, same limit on runs per pass as the real thing
+		u8Found = 0U;
+		if(u8Runs < sFCU.sSched.u8NumTasks)
+		{
+			for(u8Counter = 0U; (u8Counter < sFCU.sSched.u8NumTasks) && (u8Found == 0U); u8Counter++)
+			{
+				u8Task = sFCU.sSched.u8Order[u8Counter];
+				if(sFCU.sSched.sTask[u8Task].sReplay.u8Pending == 1U)
+				{
+					u8Found = 1U;
+					sFCU.sSched.sTask[u8Task].sReplay.u8Pending = 0U;
+					u64Time_us += u32FCU_SCHED_REPLAY__Cost_us(u8Task);
+					sFCU.sSched.sReplay.u64Busy_us += u32FCU_SCHED_REPLAY__Cost_us(u8Task);
+
+					u32Response = (Luint32)(u64Time_us - sFCU.sSched.sTask[u8Task].sReplay.u32Release_us);
+					if(u32Response > sFCU.sSched.sTask[u8Task].sReplay.u32Response_Max_us)
+					{
+						sFCU.sSched.sTask[u8Task].sReplay.u32Response_Max_us = u32Response;
+					}
+					else
+					{
+						//fall on
+					}
+					if(u32Response > ((Luint32)sFCU.sSched.sTask[u8Task].u16Period_ms * 1000U))
+					{
+						sFCU.sSched.sTask[u8Task].sReplay.u32Misses++;
+					}
+					else
+					{
+						//made it
+					}
+				}
+				else
+				{
+					//not due
+				}
+			}
+		}
+		else
+		{
+			//pass is full
+		}
+
+		if(u8Found == 1U)
+		{
+			u8Runs++;
+		}
+		else
+		{
+			//background pass, or idle to the next slot if there isn't one
+			u8Runs = 0U;
+			if(sFCU.sSched.sReplay.u32Background_us > 0U)
+			{
+				u64Time_us += sFCU.sSched.sReplay.u32Background_us;
+			}
+			else
+			{
+				u64Time_us = (Luint64)u32Slot * 1000U;
+				if(u32Slot >= u32Length_ms)
+				{
+					u64Time_us = u64End_us;
+				}
+				else
+				{
+					//fall on
+				}
+			}
+		}
+	}
+
+	for(u8Task = 0U; u8Task < sFCU.sSched.u8NumTasks; u8Task++)
+	{
+		sFCU.sSched.sReplay.u32Misses += sFCU.sSched.sTask[u8Task].sReplay.u32Misses;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Release the tasks due in a replay slot and keep the busiest slot
+ *
+ * @param[in]		u32Slot					Slot
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.046.FUNC.002
+ */
+static void vFCU_SCHED_REPLAY__Release(Luint32 u32Slot)
+{
+	Luint8 u8Task;
+	Luint32 u32Load;
+
+	u32Load = 0U;
+	for(u8Task = 0U; u8Task < sFCU.sSched.u8NumTasks; u8Task++)
+	{
+		if((sFCU.sSched.sTask[u8Task].u16Period_ms != 0U) && (sFCU.sSched.sTask[u8Task].sReplay.u32Next_ms == u32Slot))
+		{
+			if(sFCU.sSched.sTask[u8Task].sReplay.u8Pending == 1U)
+			{
+				//never started, dropped like the real one
+				sFCU.sSched.sTask[u8Task].sReplay.u32Misses++;
+			}
+			else
+			{
+				sFCU.sSched.sTask[u8Task].sReplay.u8Pending = 1U;
+			}
+			sFCU.sSched.sTask[u8Task].sReplay.u32Release_us = u32Slot * 1000U;
+			sFCU.sSched.sTask[u8Task].sReplay.u32Next_ms += sFCU.sSched.sTask[u8Task].u16Period_ms;
+			u32Load += u32FCU_SCHED_REPLAY__Cost_us(u8Task);
+		}
+		else
+		{
+			//not this slot
+		}
+	}
+
+	if(u32Load > sFCU.sSched.sReplay.u32PeakSlot_us)
+	{
+		sFCU.sSched.sReplay.u32PeakSlot_us = u32Load;
+		sFCU.sSched.sReplay.u32PeakSlot_ms = u32Slot;
+	}
+	else
+	{
+		//fall on
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * What a task costs in the replay
+ *
+ * @param[in]		u8Task					Task index
+ * @return			Budget or the worst seen, whichever is more, us
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.046.FUNC.003
+ */
+static Luint32 u32FCU_SCHED_REPLAY__Cost_us(Luint8 u8Task)
+{
+	Luint32 u32Return;
+
+	u32Return = sFCU.sSched.sTask[u8Task].u32Budget_us;
+	if(sFCU.sSched.sTask[u8Task].sStats.u32Exec_Max_us > u32Return)
+	{
+		u32Return = sFCU.sSched.sTask[u8Task].sStats.u32Exec_Max_us;
+	}
+	else
+	{
+		//fall on
+	}
+
+	return u32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Worst release to finish time of a task in the last replay
+ *
+ * @param[in]		u8Task					Task index
+ * @return			Response, us
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.046.FUNC.004
+ */
+Luint32 u32FCU_SCHED__Get_ReplayResponse_us(Luint8 u8Task)
+{
+	return sFCU.sSched.sTask[u8Task].sReplay.u32Response_Max_us;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Releases of a task not done by the time it was due again
+ *
+ * @param[in]		u8Task					Task index
+ * @return			Misses
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.046.FUNC.005
+ */
+Luint32 u32FCU_SCHED__Get_ReplayMisses(Luint8 u8Task)
+{
+	return sFCU.sSched.sTask[u8Task].sReplay.u32Misses;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Most timed task budget released in one slot
+ *
+ * @return			Budget, us
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.046.FUNC.006
+ */
+Luint32 u32FCU_SCHED__Get_ReplayPeak_us(void)
+{
+	return sFCU.sSched.sReplay.u32PeakSlot_us;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Share of the replay spent in timed tasks
+ *
+ * @return			0.0 to 1.0
+ * @st_funcMD5
+ * @st_funcID		LCCM655R0.FILE.046.FUNC.007
+ */
+Lfloat32 f32FCU_SCHED__Get_ReplayLoad(void)
+{
+	Lfloat32 f32Return;
+
+	if(sFCU.sSched.sReplay.u32Length_ms > 0U)
+	{
+		f32Return = (Lfloat32)sFCU.sSched.sReplay.u64Busy_us / ((Lfloat32)sFCU.sSched.sReplay.u32Length_ms * 1000.0F);
+	}
+	else
+	{
+		f32Return = 0.0F;
+	}
+
+	return f32Return;
+}
+
+
+#endif //#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
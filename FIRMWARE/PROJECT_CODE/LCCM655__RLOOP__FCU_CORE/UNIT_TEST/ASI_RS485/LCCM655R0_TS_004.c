@@ -0,0 +1,829 @@
+/**
+ * @file		LCCM655R0_TS_004.C
+ * @brief		Test spec for the ASI Modbus poller against a simulated RS485 bus
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM655R0.FILE.044
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_ASI_RS485 == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_TEST_SPEC == 1U
+
+//host side only
+#include <stdio.h>
+
+/** Sim clock, the same rate as the ASI timebase */
+#define C_TS004__TICKS_PER_US					(C_LOCALDEF__LCCM655__ASI_TICKS_PER_SEC / 1000000U)
+
+/** Time between calls to vFCU_ASI__Process(), ticks (20us) */
+#define C_TS004__STEP							(20U * C_TS004__TICKS_PER_US)
+
+/** Slave reply latency, ticks (300us), plus C_TS004__LATENCY_SLAVE (50us) per address */
+#define C_TS004__LATENCY_BASE					(300U * C_TS004__TICKS_PER_US)
+#define C_TS004__LATENCY_SLAVE					(50U * C_TS004__TICKS_PER_US)
+
+/** Longest reply the sim will build */
+#define C_TS004__MAX_REPLY						(64U)
+
+/** Writes remembered in order */
+#define C_TS004__MAX_WRITES						(32U)
+
+void vLCCM655R0_TS_004_TCASE_001(void);
+void vLCCM655R0_TS_004_TCASE_002(void);
+void vLCCM655R0_TS_004_TCASE_003(void);
+static void vTS004__Reset(void);
+static void vTS004__Run(Luint32 u32Ticks);
+static void vTS004__Run_Cycles(Luint32 u32Cycles);
+static Luint8 u8TS004__Check_Cache(Luint8 u8Slave);
+static void vTS004__Print_Stats(void);
+
+/** The bus and the slaves on it */
+static struct
+{
+	/** Sim clock, ticks */
+	Luint64 u64Now;
+
+	/** Ticks per char on the wire */
+	Luint64 u64Char;
+
+	/** Last byte from anyone finished on the wire */
+	Luint64 u64WireFree;
+
+	/** Earliest the next request may go after a broadcast */
+	Luint64 u64AfterBroadcast;
+
+	/** Reply on its way back, each byte with the time it lands in the UART */
+	Luint8 u8Reply[C_TS004__MAX_REPLY];
+	Luint64 u64Arrive[C_TS004__MAX_REPLY];
+	Luint8 u8ReplyLength;
+	Luint8 u8ReplyPos;
+
+	/** Slave faults, bit n = address n */
+	Luint16 u16Dead;
+	Luint16 u16Corrupt;
+	Luint16 u16Exception;
+
+	/** Requests seen */
+	Luint32 u32Frames;
+	Luint32 u32Broadcasts;
+	Luint32 u32BadRequests;
+
+	/** Rule breaks */
+	Luint32 u32GapViolations;
+	Luint32 u32TurnaroundViolations;
+
+	/** Writes seen, in order */
+	Luint8 u8WriteSlave[C_TS004__MAX_WRITES];
+	Luint16 u16WriteReg[C_TS004__MAX_WRITES];
+	Luint16 u16WriteValue[C_TS004__MAX_WRITES];
+	Luint32 u32WriteFrame[C_TS004__MAX_WRITES];
+	Luint8 u8Writes;
+
+}sTS004;
+
+//Function to call the tests for this test specification
+void vLCCM655R0_TS_004(void)
+{
+	//Call the test cases
+	vLCCM655R0_TS_004_TCASE_001();
+	vLCCM655R0_TS_004_TCASE_002();
+	vLCCM655R0_TS_004_TCASE_003();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.004.TCASE.001
+ * @st_test_desc
+ * CRC against the Modbus check value and a bitwise CRC, poll schedule
+ * coalescing and merging, and the bad argument returns.
+ *
+*/
+void vLCCM655R0_TS_004_TCASE_001(void)
+{
+	Luint8 u8Test;
+	Luint32 u32Counter;
+	Luint16 u16CRC;
+	Luint16 u16Value;
+	Luint8 u8Bit;
+	Luint8 u8Data[64];
+	static const Luint8 u8Check[9] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+	DEBUG_PRINT("START:LCCM655R0.TS.004.TCASE.001\r\n");
+
+	u8Test = 1U;
+	vTS004__Reset();
+	vFCU_ASI__Init();
+
+	if(u16FCU_ASI__CRC(&u8Check[0], 9U) != 0x4B37U)
+	{
+		DEBUG_PRINT("FAIL: check value\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//table against bit at a time
+	for(u32Counter = 0U; u32Counter < 64U; u32Counter++)
+	{
+		u8Data[u32Counter] = (Luint8)((u32Counter * 37U) + 11U);
+	}
+	u16CRC = 0xFFFFU;
+	for(u32Counter = 0U; u32Counter < 64U; u32Counter++)
+	{
+		u16CRC ^= u8Data[u32Counter];
+		for(u8Bit = 0U; u8Bit < 8U; u8Bit++)
+		{
+			if((u16CRC & 0x0001U) != 0U)
+			{
+				u16CRC = (Luint16)((u16CRC >> 1U) ^ 0xA001U);
+			}
+			else
+			{
+				u16CRC = (Luint16)(u16CRC >> 1U);
+			}
+		}
+	}
+	if(u16FCU_ASI__CRC(&u8Data[0], 64U) != u16CRC)
+	{
+		DEBUG_PRINT("FAIL: table CRC\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//the default schedule is two reads, status to rpm every pass, temp to last fault every 10th
+	if((sFCU.sASIComms.sPoll.u8NumBlocks != 2U) ||
+		(sFCU.sASIComms.sPoll.sBlock[0].u16Start != C_FCU_ASI__CONTROLLER_STATUS) || (sFCU.sASIComms.sPoll.sBlock[0].u8Count != 7U) || (sFCU.sASIComms.sPoll.sBlock[0].u8Every != 1U) ||
+		(sFCU.sASIComms.sPoll.sBlock[1].u16Start != C_FCU_ASI__CONT_TEMP) || (sFCU.sASIComms.sPoll.sBlock[1].u8Count != 11U) || (sFCU.sASIComms.sPoll.sBlock[1].u8Every != 10U))
+	{
+		DEBUG_PRINT("FAIL: default schedule\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//no coalescing, fill every block then join two by filling the hole
+	vFCU_ASI__Schedule_Clear();
+	sFCU.sASIComms.sPoll.u8CoalesceGap = 0U;
+	for(u32Counter = 0U; u32Counter < C_ASI__MAX_POLL_BLOCKS; u32Counter++)
+	{
+		if(s16FCU_ASI__Schedule_Add((Luint16)(257U + (u32Counter * 2U)), 1U) != 0)
+		{
+			u8Test = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	if((sFCU.sASIComms.sPoll.u8NumBlocks != C_ASI__MAX_POLL_BLOCKS) || (s16FCU_ASI__Schedule_Add(272U, 2U) != -2))
+	{
+		DEBUG_PRINT("FAIL: schedule full\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+	if((s16FCU_ASI__Schedule_Add(258U, 1U) != 0) || (sFCU.sASIComms.sPoll.u8NumBlocks != (C_ASI__MAX_POLL_BLOCKS - 1U)) ||
+		(sFCU.sASIComms.sPoll.sBlock[0].u16Start != 257U) || (sFCU.sASIComms.sPoll.sBlock[0].u8Count != 3U))
+	{
+		DEBUG_PRINT("FAIL: schedule merge\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//bad args
+	if((s16FCU_ASI__Schedule_Add(256U, 1U) != -1) ||
+		(s16FCU_ASI__Schedule_Add((Luint16)(C_FCU_ASI__CACHE_BASE + C_FCU_ASI__CACHE_SIZE), 1U) != -1) ||
+		(s16FCU_ASI__Schedule_Add(257U, 0U) != -1) ||
+		(s16FCU_ASI__Get_Register(0U, 257U, &u16Value) != -1) ||
+		(s16FCU_ASI__Get_Register(C_ASI__NUM_CONTROLLERS + 1U, 257U, &u16Value) != -1) ||
+		(s16FCU_ASI__Get_Register(1U, 511U, &u16Value) != -1) ||
+		(s16FCU_ASI__Get_Register(1U, 257U, 0) != -1) ||
+		(s16FCU_ASI__Get_Register(1U, 257U, &u16Value) != -2) ||
+		(s16FCU_ASI__SendCommand(0) != -1))
+	{
+		DEBUG_PRINT("FAIL: bad args\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(u8Test == 1U)
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.004.TCASE.001\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.004.TCASE.001\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.004.TCASE.001\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.004.TCASE.002
+ * @st_test_desc
+ * Eight healthy controllers. Every polled register lands in the cache, the
+ * init broadcasts get their turnaround, no request breaks the 3.5 char gap,
+ * and the coalesced schedule refreshes faster than one read per rate group.
+ *
+*/
+void vLCCM655R0_TS_004_TCASE_002(void)
+{
+	Luint8 u8Test;
+	Luint8 u8Slave;
+	Luint16 u16Value;
+	Luint32 u32Coalesced;
+	Luint32 u32Single;
+	char cText[200];
+
+	DEBUG_PRINT("START:LCCM655R0.TS.004.TCASE.002\r\n");
+
+	u8Test = 1U;
+	vTS004__Reset();
+	vFCU_ASI__Init();
+	vTS004__Run_Cycles(22U);
+
+	for(u8Slave = 1U; u8Slave <= C_ASI__NUM_CONTROLLERS; u8Slave++)
+	{
+		if((u8TS004__Check_Cache(u8Slave) == 0U) || (sFCU.sASIComms.sSlave[u8Slave - 1U].u32Timeouts != 0U) ||
+			(sFCU.sASIComms.sSlave[u8Slave - 1U].u32CRCErrors != 0U))
+		{
+			u8Test = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	if((s16FCU_ASI__ReadMotorRpm(4U, &u16Value) != 0) || (u16Value != (4000U + C_FCU_ASI__MOTOR_RPM)))
+	{
+		DEBUG_PRINT("FAIL: rpm\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//the 4 init writes went to everyone first
+	if((sTS004.u32Broadcasts != 4U) || (sTS004.u8Writes < 4U) || (sTS004.u32WriteFrame[3] != 4U))
+	{
+		DEBUG_PRINT("FAIL: init broadcasts\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	u32Coalesced = sFCU.sASIComms.sPoll.u32Refresh_Last;
+	vTS004__Print_Stats();
+
+	//let the bus go quiet, then the same again with a read per group of neighbours
+	sTS004.u64Now += 20000U * C_TS004__TICKS_PER_US;
+	sTS004.u8ReplyLength = 0U;
+	vFCU_ASI__Init();
+	vFCU_ASI__Schedule_Clear();
+	sFCU.sASIComms.sPoll.u8CoalesceGap = 0U;
+	(void)s16FCU_ASI__Schedule_Add(C_FCU_ASI__CONTROLLER_STATUS, 1U);
+	(void)s16FCU_ASI__Schedule_Add(C_FCU_ASI__FAULTS, 1U);
+	(void)s16FCU_ASI__Schedule_Add(C_FCU_ASI__MOTOR_CURRENT, 1U);
+	(void)s16FCU_ASI__Schedule_Add(C_FCU_ASI__MOTOR_RPM, 1U);
+	(void)s16FCU_ASI__Schedule_Add(C_FCU_ASI__CONT_TEMP, 10U);
+	(void)s16FCU_ASI__Schedule_Add(C_FCU_ASI__TEMPERATURE, 10U);
+	(void)s16FCU_ASI__Schedule_Add(C_FCU_ASI__LAST_FAULT, 10U);
+	vTS004__Run_Cycles(22U);
+	u32Single = sFCU.sASIComms.sPoll.u32Refresh_Last;
+
+	sprintf(cText, "INFO: refresh %u us coalesced, %u us uncoalesced, %u blocks\r\n",
+			(unsigned int)((u32Coalesced * 1000000ULL) / C_LOCALDEF__LCCM655__ASI_TICKS_PER_SEC),
+			(unsigned int)((u32Single * 1000000ULL) / C_LOCALDEF__LCCM655__ASI_TICKS_PER_SEC),
+			(unsigned int)sFCU.sASIComms.sPoll.u8NumBlocks);
+	DEBUG_PRINT(cText);
+
+	if((u32Coalesced == 0U) || (u32Single <= u32Coalesced) || (sFCU.sASIComms.sPoll.u8NumBlocks != 5U) ||
+		(u8TS004__Check_Cache(8U) == 0U) || (sTS004.u32GapViolations != 0U) ||
+		(sTS004.u32TurnaroundViolations != 0U) || (sTS004.u32BadRequests != 0U))
+	{
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(u8Test == 1U)
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.004.TCASE.002\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.004.TCASE.002\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.004.TCASE.002\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.004.TCASE.003
+ * @st_test_desc
+ * Controller 3 dead, controller 5 sending bad CRCs and controller 6 answering
+ * with an exception. The rest are still polled on time. A queued write goes
+ * ahead of the polls, a write to the dead controller is retried then dropped,
+ * and a full queue is refused.
+ *
+*/
+void vLCCM655R0_TS_004_TCASE_003(void)
+{
+	Luint8 u8Test;
+	Luint8 u8Slave;
+	Luint8 u8Counter;
+	Luint8 u8Writes;
+	Luint32 u32Frames;
+	Luint16 u16Value;
+	struct _strASICmd sCmd;
+	struct _strASISlave *pSlave;
+
+	DEBUG_PRINT("START:LCCM655R0.TS.004.TCASE.003\r\n");
+
+	u8Test = 1U;
+	vTS004__Reset();
+	sTS004.u16Dead = (Luint16)(1U << 3U);
+	sTS004.u16Corrupt = (Luint16)(1U << 5U);
+	sTS004.u16Exception = (Luint16)(1U << 6U);
+	vFCU_ASI__Init();
+	vTS004__Run_Cycles(12U);
+
+	for(u8Slave = 1U; u8Slave <= C_ASI__NUM_CONTROLLERS; u8Slave++)
+	{
+		pSlave = &sFCU.sASIComms.sSlave[u8Slave - 1U];
+		if(u8Slave == 3U)
+		{
+			if((pSlave->u32Timeouts < 12U) || (pSlave->u32Replies != 0U) || (s16FCU_ASI__Get_Register(3U, C_FCU_ASI__FAULTS, &u16Value) != -2))
+			{
+				DEBUG_PRINT("FAIL: dead controller\r\n");
+				u8Test = 0U;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		else if(u8Slave == 5U)
+		{
+			if((pSlave->u32CRCErrors < 12U) || (pSlave->u32Replies != 0U) || (pSlave->u32Valid != 0U))
+			{
+				DEBUG_PRINT("FAIL: bad CRC controller\r\n");
+				u8Test = 0U;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		else if(u8Slave == 6U)
+		{
+			if((pSlave->u32Exceptions < 12U) || (pSlave->u8LastException != 0x02U) || (pSlave->u32Valid != 0U))
+			{
+				DEBUG_PRINT("FAIL: exception controller\r\n");
+				u8Test = 0U;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		else
+		{
+			if((u8TS004__Check_Cache(u8Slave) == 0U) || (pSlave->u32Timeouts != 0U) || (pSlave->u32CRCErrors != 0U))
+			{
+				u8Test = 0U;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+	}
+
+	//one write in the middle of the polls, at most the poll on the bus and the one staged go first
+	memset(&sCmd, 0, sizeof(sCmd));
+	sCmd.u8SlaveAddress = 2U;
+	sCmd.fncCode = C_ASI__WRITE_SINGLE_REGISTER;
+	sCmd.paramAddress = 500U;
+	sCmd.paramValue = 1234U;
+	vTS004__Run(600U * C_TS004__TICKS_PER_US);
+	u32Frames = sTS004.u32Frames;
+	u8Writes = sTS004.u8Writes;
+	if(s16FCU_ASI__SendCommand(&sCmd) != 0)
+	{
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+	vTS004__Run(20000U * C_TS004__TICKS_PER_US);
+	if((sTS004.u8Writes != (u8Writes + 1U)) || (sTS004.u8WriteSlave[u8Writes] != 2U) || (sTS004.u16WriteValue[u8Writes] != 1234U) ||
+		((sTS004.u32WriteFrame[u8Writes] - u32Frames) > 3U))
+	{
+		DEBUG_PRINT("FAIL: write priority\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//write to the dead one, 3 tries then dropped
+	u8Writes = sTS004.u8Writes;
+	sCmd.u8SlaveAddress = 3U;
+	(void)s16FCU_ASI__SendCommand(&sCmd);
+	vTS004__Run(100000U * C_TS004__TICKS_PER_US);
+	if((sTS004.u8Writes != (u8Writes + C_ASI__COMMAND_RETRIES)) || (sFCU.sASIComms.u32CommandsDropped != 1U))
+	{
+		DEBUG_PRINT("FAIL: retries\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//fill the queue, one slot is always free
+	u8Writes = sTS004.u8Writes;
+	sCmd.u8SlaveAddress = 1U;
+	for(u8Counter = 0U; u8Counter < (C_ASI__COMMAND_QUEUE - 1U); u8Counter++)
+	{
+		sCmd.paramValue = u8Counter;
+		if(s16FCU_ASI__SendCommand(&sCmd) != 0)
+		{
+			u8Test = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	if(s16FCU_ASI__SendCommand(&sCmd) != -1)
+	{
+		DEBUG_PRINT("FAIL: queue full\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+	vTS004__Run(200000U * C_TS004__TICKS_PER_US);
+	if(sTS004.u8Writes != (u8Writes + C_ASI__COMMAND_QUEUE - 1U))
+	{
+		DEBUG_PRINT("FAIL: queue drain\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		for(u8Counter = 0U; u8Counter < (C_ASI__COMMAND_QUEUE - 1U); u8Counter++)
+		{
+			if(sTS004.u16WriteValue[u8Writes + u8Counter] != u8Counter)
+			{
+				DEBUG_PRINT("FAIL: queue order\r\n");
+				u8Test = 0U;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+	}
+
+	vTS004__Print_Stats();
+
+	if((sTS004.u32GapViolations != 0U) || (sTS004.u32TurnaroundViolations != 0U) || (sTS004.u32BadRequests != 0U))
+	{
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(u8Test == 1U)
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.004.TCASE.003\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.004.TCASE.003\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.004.TCASE.003\r\n");
+}
+
+/***************************************************************************//**
+ * @brief
+ * Timestamp hook, the sim clock
+ */
+Luint64 u64LCCM655R0_TS_004__Timestamp(void)
+{
+	return sTS004.u64Now;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Transmit hook, the slaves see the request and queue up their reply
+ */
+void vLCCM655R0_TS_004__Tx(const Luint8 *cpu8Data, Luint8 u8Length)
+{
+	Luint8 u8Slave;
+	Luint8 u8Function;
+	Luint16 u16Register;
+	Luint16 u16Value;
+	Luint16 u16CRC;
+	Luint16 u16Counter;
+	Luint8 u8Pos;
+	Luint64 u64TxEnd;
+	Luint64 u64Time;
+
+	sTS004.u32Frames++;
+
+	if(sTS004.u64Now < (sTS004.u64WireFree + sFCU.sASIComms.u32GapTicks))
+	{
+		sTS004.u32GapViolations++;
+	}
+	else
+	{
+		//fall on
+	}
+	if(sTS004.u64Now < sTS004.u64AfterBroadcast)
+	{
+		sTS004.u32TurnaroundViolations++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	u64TxEnd = sTS004.u64Now + (sTS004.u64Char * u8Length);
+	sTS004.u64WireFree = u64TxEnd;
+	sTS004.u8ReplyLength = 0U;
+	sTS004.u8ReplyPos = 0U;
+
+	if((u8Length != C_ASI__RW_FRAME_SIZE) || (u16FCU_ASI__CRC(cpu8Data, u8Length) != 0U))
+	{
+		sTS004.u32BadRequests++;
+	}
+	else
+	{
+		u8Slave = cpu8Data[0];
+		u8Function = cpu8Data[1];
+		u16Register = (Luint16)(((Luint16)cpu8Data[2] << 8U) | cpu8Data[3]);
+		u16Value = (Luint16)(((Luint16)cpu8Data[4] << 8U) | cpu8Data[5]);
+
+		if(u8Function == C_ASI__WRITE_SINGLE_REGISTER)
+		{
+			if(sTS004.u8Writes < C_TS004__MAX_WRITES)
+			{
+				sTS004.u8WriteSlave[sTS004.u8Writes] = u8Slave;
+				sTS004.u16WriteReg[sTS004.u8Writes] = u16Register;
+				sTS004.u16WriteValue[sTS004.u8Writes] = u16Value;
+				sTS004.u32WriteFrame[sTS004.u8Writes] = sTS004.u32Frames;
+				sTS004.u8Writes++;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		else
+		{
+			//fall on
+		}
+
+		if(u8Slave == 0U)
+		{
+			sTS004.u32Broadcasts++;
+			sTS004.u64AfterBroadcast = u64TxEnd + sFCU.sASIComms.u32TurnaroundTicks;
+		}
+		else if((u8Slave > C_ASI__NUM_CONTROLLERS) || ((sTS004.u16Dead & (1U << u8Slave)) != 0U))
+		{
+			//nobody home
+		}
+		else
+		{
+			u8Pos = 0U;
+			sTS004.u8Reply[u8Pos++] = u8Slave;
+			if((sTS004.u16Exception & (1U << u8Slave)) != 0U)
+			{
+				//illegal data address
+				sTS004.u8Reply[u8Pos++] = (Luint8)(u8Function | C_ASI__EXCEPTION_FLAG);
+				sTS004.u8Reply[u8Pos++] = 0x02U;
+			}
+			else if(u8Function == C_ASI__READ_INPUT_REGISTER)
+			{
+				sTS004.u8Reply[u8Pos++] = u8Function;
+				sTS004.u8Reply[u8Pos++] = (Luint8)(u16Value * 2U);
+				for(u16Counter = 0U; u16Counter < u16Value; u16Counter++)
+				{
+					u16CRC = (Luint16)(((Luint16)u8Slave * 1000U) + u16Register + u16Counter);
+					sTS004.u8Reply[u8Pos++] = (Luint8)(u16CRC >> 8U);
+					sTS004.u8Reply[u8Pos++] = (Luint8)(u16CRC & 0x00FFU);
+				}
+			}
+			else
+			{
+				//echo
+				for(u16Counter = 1U; u16Counter < 6U; u16Counter++)
+				{
+					sTS004.u8Reply[u8Pos++] = cpu8Data[u16Counter];
+				}
+			}
+			u16CRC = u16FCU_ASI__CRC(&sTS004.u8Reply[0], u8Pos);
+			sTS004.u8Reply[u8Pos++] = (Luint8)(u16CRC & 0x00FFU);
+			sTS004.u8Reply[u8Pos++] = (Luint8)(u16CRC >> 8U);
+			if((sTS004.u16Corrupt & (1U << u8Slave)) != 0U)
+			{
+				sTS004.u8Reply[u8Pos - 1U] ^= 0x5AU;
+			}
+			else
+			{
+				//fall on
+			}
+
+			u64Time = u64TxEnd + C_TS004__LATENCY_BASE + ((Luint64)C_TS004__LATENCY_SLAVE * u8Slave);
+			for(u16Counter = 0U; u16Counter < u8Pos; u16Counter++)
+			{
+				u64Time += sTS004.u64Char;
+				sTS004.u64Arrive[u16Counter] = u64Time;
+			}
+			sTS004.u8ReplyLength = u8Pos;
+			sTS004.u64WireFree = u64Time;
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Rx hooks, a byte is there once it has finished arriving
+ */
+Luint8 u8LCCM655R0_TS_004__Rx_Avail(void)
+{
+	Luint8 u8Return;
+
+	if((sTS004.u8ReplyPos < sTS004.u8ReplyLength) && (sTS004.u64Arrive[sTS004.u8ReplyPos] <= sTS004.u64Now))
+	{
+		u8Return = 1U;
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+Luint8 u8LCCM655R0_TS_004__Rx_Byte(void)
+{
+	Luint8 u8Return;
+
+	if(sTS004.u8ReplyPos < sTS004.u8ReplyLength)
+	{
+		u8Return = sTS004.u8Reply[sTS004.u8ReplyPos];
+		sTS004.u8ReplyPos++;
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Quiet bus, healthy slaves
+ */
+static void vTS004__Reset(void)
+{
+	memset(&sTS004, 0, sizeof(sTS004));
+	sTS004.u64Now = 1000U;
+	sTS004.u64Char = ((10ULL * C_LOCALDEF__LCCM655__ASI_TICKS_PER_SEC) + C_LOCALDEF__LCCM655__ASI_BAUD - 1U) / C_LOCALDEF__LCCM655__ASI_BAUD;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Step the clock and the poller
+ */
+static void vTS004__Run(Luint32 u32Ticks)
+{
+	Luint64 u64End;
+
+	u64End = sTS004.u64Now + u32Ticks;
+	while(sTS004.u64Now < u64End)
+	{
+		sTS004.u64Now += C_TS004__STEP;
+		vFCU_ASI__Process();
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Run until the schedule has been through n more times
+ */
+static void vTS004__Run_Cycles(Luint32 u32Cycles)
+{
+	Luint32 u32Target;
+	Luint32 u32Guard;
+
+	u32Target = sFCU.sASIComms.sPoll.u32Cycles + u32Cycles;
+	u32Guard = 0U;
+	while((sFCU.sASIComms.sPoll.u32Cycles < u32Target) && (u32Guard < 10000000U))
+	{
+		vTS004__Run(C_TS004__STEP);
+		u32Guard++;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Every scheduled register of a controller holds what the slave sent
+ */
+static Luint8 u8TS004__Check_Cache(Luint8 u8Slave)
+{
+	Luint8 u8Return;
+	Luint8 u8Counter;
+	Luint16 u16Value;
+	char cText[100];
+	static const Luint16 u16Regs[7] =
+	{
+		C_FCU_ASI__CONTROLLER_STATUS, C_FCU_ASI__FAULTS, C_FCU_ASI__CONT_TEMP, C_FCU_ASI__TEMPERATURE,
+		C_FCU_ASI__MOTOR_CURRENT, C_FCU_ASI__MOTOR_RPM, C_FCU_ASI__LAST_FAULT
+	};
+
+	u8Return = 1U;
+	for(u8Counter = 0U; u8Counter < 7U; u8Counter++)
+	{
+		if((s16FCU_ASI__Get_Register(u8Slave, u16Regs[u8Counter], &u16Value) != 0) ||
+			(u16Value != (Luint16)(((Luint16)u8Slave * 1000U) + u16Regs[u8Counter])))
+		{
+			sprintf(cText, "FAIL: controller %u register %u\r\n", (unsigned int)u8Slave, (unsigned int)u16Regs[u8Counter]);
+			DEBUG_PRINT(cText);
+			u8Return = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Per controller link stats
+ */
+static void vTS004__Print_Stats(void)
+{
+	Luint8 u8Counter;
+	struct _strASISlave *pSlave;
+	char cText[200];
+
+	for(u8Counter = 0U; u8Counter < C_ASI__NUM_CONTROLLERS; u8Counter++)
+	{
+		pSlave = &sFCU.sASIComms.sSlave[u8Counter];
+		sprintf(cText, "INFO: ctrl %u req %u ok %u tmo %u crc %u exc %u latency min %u max %u us\r\n",
+				(unsigned int)(u8Counter + 1U), (unsigned int)pSlave->u32Requests, (unsigned int)pSlave->u32Replies,
+				(unsigned int)pSlave->u32Timeouts, (unsigned int)pSlave->u32CRCErrors, (unsigned int)pSlave->u32Exceptions,
+				(unsigned int)(((Luint64)pSlave->u32Latency_Min * 1000000U) / C_LOCALDEF__LCCM655__ASI_TICKS_PER_SEC),
+				(unsigned int)(((Luint64)pSlave->u32Latency_Max * 1000000U) / C_LOCALDEF__LCCM655__ASI_TICKS_PER_SEC));
+		DEBUG_PRINT(cText);
+	}
+}
+
+#endif //C_LOCALDEF__LCCM655__ENABLE_TEST_SPEC
+#endif //C_LOCALDEF__LCCM655__ENABLE_ASI_RS485
+#endif //C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
@@ -0,0 +1,480 @@
+/**
+ * @file		LCCM655R0_TS_003.C
+ * @brief		Test spec for the contrast sensor edge ring and stripe tracking
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM655R0.FILE.041
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_LASER_CONTRAST == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_TEST_SPEC == 1U
+
+//host side only
+#include <stdio.h>
+#include <math.h>
+
+/** Most edges one run can make, rising on all three sensors plus FWD falling */
+#define C_TS003__MAX_EDGES						(4U * 32U)
+
+/** Stripe tape width, mm */
+#define C_TS003__TAPE_MM						(101.6)
+
+/** Edges queued between each call to the main loop side */
+#define C_TS003__BATCH							(7U)
+
+void vLCCM655R0_TS_003_TCASE_001(void);
+void vLCCM655R0_TS_003_TCASE_002(void);
+void vLCCM655R0_TS_003_TCASE_003(void);
+void vLCCM655R0_TS_003_TCASE_004(void);
+void vLCCM655R0_TS_003_TCASE_005(void);
+void vLCCM655R0_TS_003_TCASE_006(void);
+static void vTS003__Run(Lfloat64 f64Start, Lfloat64 f64V0, Lfloat64 f64A, Luint8 u8Stripes, Luint8 u8Glitch, Luint8 u8Drop);
+static Lfloat64 f64TS003__Time_At(Lfloat64 f64X);
+static Lfloat64 f64TS003__X_At(Lfloat64 f64T);
+static Luint8 u8TS003__Check(Luint8 u8Stripes, Lfloat64 f64VelocLimit);
+
+/** Replay profile, x is the FWD sensor past stripe 0, mm */
+static struct
+{
+	Lfloat64 f64Start;
+	Lfloat64 f64V0;
+	Lfloat64 f64A;
+
+	/** Time of the last edge replayed, s */
+	Lfloat64 f64LastTime;
+
+}sTS003;
+
+/** Edge list for one run, kept in time order */
+static struct _strTS003_Edge
+{
+	Luint64 u64Time;
+	Luint8 u8Laser;
+	Luint8 u8Rising;
+}sTS003_Edge[C_TS003__MAX_EDGES];
+
+static const Lfloat64 f64TS003_Offset[LASER_CONT__MAX] =
+{
+	0.0,
+	(Lfloat64)C_FCU__LASER_CONTRAST__MID_OFFSET_MM,
+	(Lfloat64)C_FCU__LASER_CONTRAST__AFT_OFFSET_MM
+};
+
+//Function to call the tests for this test specification
+void vLCCM655R0_TS_003(void)
+{
+	//Call the test cases
+	vLCCM655R0_TS_003_TCASE_001();
+	vLCCM655R0_TS_003_TCASE_002();
+	vLCCM655R0_TS_003_TCASE_003();
+	vLCCM655R0_TS_003_TCASE_004();
+	vLCCM655R0_TS_003_TCASE_005();
+	vLCCM655R0_TS_003_TCASE_006();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.003.TCASE.001
+ * @st_test_desc
+ * 120m/s cruise over 20 stripes, FWD sensor reaches the first stripe first.
+ * Every stripe is counted on every sensor and the velocity and position
+ * match the profile.
+ *
+*/
+void vLCCM655R0_TS_003_TCASE_001(void)
+{
+	DEBUG_PRINT("START:LCCM655R0.TS.003.TCASE.001\r\n");
+
+	vTS003__Run(-500.0, 120000.0, 0.0, 20U, 0U, 0U);
+
+	if(u8TS003__Check(20U, 0.001) == 1U)
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.003.TCASE.001\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.003.TCASE.001\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.003.TCASE.001\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.003.TCASE.002
+ * @st_test_desc
+ * 100m/s starting with the first stripe between the FWD and MID sensors, so
+ * the FWD sensor never sees stripe 0. The sensors must still agree on the
+ * stripe numbering.
+ *
+*/
+void vLCCM655R0_TS_003_TCASE_002(void)
+{
+	DEBUG_PRINT("START:LCCM655R0.TS.003.TCASE.002\r\n");
+
+	vTS003__Run(500.0, 100000.0, 0.0, 20U, 0U, 0U);
+
+	if((u8TS003__Check(20U, 0.001) == 1U) &&
+		(sFCU.sContrast.sTimingList[LASER_CONT__FWD].u16RisingCount == 19U) &&
+		(sFCU.sContrast.sTimingList[LASER_CONT__FWD].s32Stripe == 19))
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.003.TCASE.002\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.003.TCASE.002\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.003.TCASE.002\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.003.TCASE.003
+ * @st_test_desc
+ * 110m/s with a spurious edge on the MID sensor between stripes 5 and 6 and
+ * the AFT sensor missing stripe 8. The glitch is thrown out, the missed
+ * stripe is counted, and the stripe numbering is unchanged.
+ *
+*/
+void vLCCM655R0_TS_003_TCASE_003(void)
+{
+	DEBUG_PRINT("START:LCCM655R0.TS.003.TCASE.003\r\n");
+
+	vTS003__Run(-500.0, 110000.0, 0.0, 20U, 5U, 8U);
+
+	if((u8TS003__Check(20U, 0.001) == 1U) &&
+		(sFCU.sContrast.sTimingList[LASER_CONT__MID].u32Glitches == 1U) &&
+		(sFCU.sContrast.sTimingList[LASER_CONT__AFT].u32Missed == 1U) &&
+		(sFCU.sContrast.sTimingList[LASER_CONT__AFT].u16RisingCount == 19U))
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.003.TCASE.003\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.003.TCASE.003\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.003.TCASE.003\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.003.TCASE.004
+ * @st_test_desc
+ * Braking at 1g from 140m/s over 20 stripes. The shrinking speed stays in
+ * the windows and the velocity follows it.
+ *
+*/
+void vLCCM655R0_TS_003_TCASE_004(void)
+{
+	DEBUG_PRINT("START:LCCM655R0.TS.003.TCASE.004\r\n");
+
+	vTS003__Run(-500.0, 140000.0, -9810.0, 20U, 0U, 0U);
+
+	if(u8TS003__Check(20U, 0.005) == 1U)
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.003.TCASE.004\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.003.TCASE.004\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.003.TCASE.004\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.003.TCASE.005
+ * @st_test_desc
+ * Main loop stalls, the ISR fills the ring. Edges past the ring size are
+ * counted as lost and the overflow fault is raised once the main loop runs.
+ *
+*/
+void vLCCM655R0_TS_003_TCASE_005(void)
+{
+	Luint32 u32Counter;
+
+	DEBUG_PRINT("START:LCCM655R0.TS.003.TCASE.005\r\n");
+
+	vFCU_LASERCONT_TL__Init();
+	for(u32Counter = 0U; u32Counter < (C_FCU__LASER_CONTRAST__RING_SIZE + 3U); u32Counter++)
+	{
+		//one a stripe every 300ms from 1s
+		vFCU_LASERCONT_TL__Add_Edge(LASER_CONT__MID, 1U, (Luint64)C_FCU__LASER_CONTRAST__TICKS_PER_SEC + (((Luint64)u32Counter * (Luint64)C_FCU__LASER_CONTRAST__TICKS_PER_SEC * 3U) / 10U));
+	}
+	vFCU_LASERCONT_TL__Process();
+
+	if((sFCU.sContrast.sRing.u32Overflow == 3U) &&
+		(sFCU.sContrast.sRing.u16Head == sFCU.sContrast.sRing.u16Tail) &&
+		(sFCU.sContrast.sTimingList[LASER_CONT__MID].u16RisingCount == C_FCU__LASER_CONTRAST__RING_SIZE) &&
+		((u32FCU_LASERCONT_TL__Get_FaultFlags() & C_LCCM655__LASER_CONT__FAULT_INDEX_MASK__01) != 0U))
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.003.TCASE.005\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.003.TCASE.005\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.003.TCASE.005\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.003.TCASE.006
+ * @st_test_desc
+ * Pushed from 3m/s at about 2.4g over 12 stripes. The intervals shrink by
+ * more than half at the start and must not be taken as glitches.
+ *
+*/
+void vLCCM655R0_TS_003_TCASE_006(void)
+{
+	DEBUG_PRINT("START:LCCM655R0.TS.003.TCASE.006\r\n");
+
+	vTS003__Run(-500.0, 3000.0, 24000.0, 12U, 0U, 0U);
+
+	if((u8TS003__Check(12U, 0.005) == 1U) &&
+		(sFCU.sContrast.sTimingList[LASER_CONT__FWD].u32Glitches == 0U))
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.003.TCASE.006\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.003.TCASE.006\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.003.TCASE.006\r\n");
+}
+
+/***************************************************************************//**
+ * @brief
+ * Build the edges for a run and feed them through the ISR side in batches
+ *
+ * @param[in]		u8Drop					AFT misses this stripe, 0 for none
+ * @param[in]		u8Glitch				MID sees a false edge after this stripe, 0 for none
+ * @param[in]		u8Stripes				Stripes to pass
+ * @param[in]		f64A					Acceleration, mm/s^2
+ * @param[in]		f64V0					Starting velocity, mm/s
+ * @param[in]		f64Start				Where the FWD sensor starts relative to stripe 0, mm
+ */
+static void vTS003__Run(Lfloat64 f64Start, Lfloat64 f64V0, Lfloat64 f64A, Luint8 u8Stripes, Luint8 u8Glitch, Luint8 u8Drop)
+{
+	struct _strTS003_Edge sSwap;
+	Luint32 u32Count;
+	Luint32 u32Pos;
+	Luint32 u32Counter;
+	Luint8 u8Stripe;
+	Luint8 u8Laser;
+	Lfloat64 f64Stripe;
+	Lfloat64 f64Time;
+
+	sTS003.f64Start = f64Start;
+	sTS003.f64V0 = f64V0;
+	sTS003.f64A = f64A;
+	sTS003.f64LastTime = 0.0;
+
+	u32Count = 0U;
+	for(u8Stripe = 0U; u8Stripe < u8Stripes; u8Stripe++)
+	{
+		f64Stripe = (Lfloat64)u8Stripe * (Lfloat64)C_FCU__LASER_CONTRAST__STRIPE_MM;
+		for(u8Laser = 0U; u8Laser < (Luint8)LASER_CONT__MAX; u8Laser++)
+		{
+			//sensor has to reach the stripe from where it started
+			if(((f64Stripe + f64TS003_Offset[u8Laser]) > f64Start) && ((u8Laser != (Luint8)LASER_CONT__AFT) || (u8Stripe != u8Drop) || (u8Drop == 0U)))
+			{
+				f64Time = f64TS003__Time_At(f64Stripe + f64TS003_Offset[u8Laser]);
+				sTS003_Edge[u32Count].u64Time = (Luint64)(f64Time * (Lfloat64)C_FCU__LASER_CONTRAST__TICKS_PER_SEC);
+				sTS003_Edge[u32Count].u8Laser = u8Laser;
+				sTS003_Edge[u32Count].u8Rising = 1U;
+				u32Count++;
+
+				if(f64Time > sTS003.f64LastTime)
+				{
+					sTS003.f64LastTime = f64Time;
+				}
+				else
+				{
+					//fall on
+				}
+
+				//FWD is on both edges
+				if(u8Laser == (Luint8)LASER_CONT__FWD)
+				{
+					f64Time = f64TS003__Time_At(f64Stripe + C_TS003__TAPE_MM);
+					sTS003_Edge[u32Count].u64Time = (Luint64)(f64Time * (Lfloat64)C_FCU__LASER_CONTRAST__TICKS_PER_SEC);
+					sTS003_Edge[u32Count].u8Laser = u8Laser;
+					sTS003_Edge[u32Count].u8Rising = 0U;
+					u32Count++;
+				}
+				else
+				{
+					//rising only
+				}
+			}
+			else
+			{
+				//not crossed
+			}
+		}
+
+		//a false edge partway to the next stripe
+		if((u8Glitch != 0U) && (u8Stripe == u8Glitch))
+		{
+			f64Time = f64TS003__Time_At(f64Stripe + f64TS003_Offset[LASER_CONT__MID] + ((Lfloat64)C_FCU__LASER_CONTRAST__STRIPE_MM * 0.4));
+			sTS003_Edge[u32Count].u64Time = (Luint64)(f64Time * (Lfloat64)C_FCU__LASER_CONTRAST__TICKS_PER_SEC);
+			sTS003_Edge[u32Count].u8Laser = (Luint8)LASER_CONT__MID;
+			sTS003_Edge[u32Count].u8Rising = 1U;
+			u32Count++;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	//the ISR sees them in time order
+	for(u32Counter = 1U; u32Counter < u32Count; u32Counter++)
+	{
+		u32Pos = u32Counter;
+		while((u32Pos > 0U) && (sTS003_Edge[u32Pos - 1U].u64Time > sTS003_Edge[u32Pos].u64Time))
+		{
+			sSwap = sTS003_Edge[u32Pos];
+			sTS003_Edge[u32Pos] = sTS003_Edge[u32Pos - 1U];
+			sTS003_Edge[u32Pos - 1U] = sSwap;
+			u32Pos--;
+		}
+	}
+
+	vFCU_LASERCONT_TL__Init();
+	for(u32Counter = 0U; u32Counter < u32Count; u32Counter++)
+	{
+		vFCU_LASERCONT_TL__Add_Edge((E_FCU__LASER_CONT_INDEX_T)sTS003_Edge[u32Counter].u8Laser, sTS003_Edge[u32Counter].u8Rising, sTS003_Edge[u32Counter].u64Time);
+		if((u32Counter % C_TS003__BATCH) == (C_TS003__BATCH - 1U))
+		{
+			vFCU_LASERCONT_TL__Process();
+		}
+		else
+		{
+			//let a few build up
+		}
+	}
+	vFCU_LASERCONT_TL__Process();
+}
+
+/***************************************************************************//**
+ * @brief
+ * When the FWD sensor gets to x, s
+ *
+ */
+static Lfloat64 f64TS003__Time_At(Lfloat64 f64X)
+{
+	Lfloat64 f64Dist;
+	Lfloat64 f64Return;
+
+	f64Dist = f64X - sTS003.f64Start;
+	if(sTS003.f64A == 0.0)
+	{
+		f64Return = f64Dist / sTS003.f64V0;
+	}
+	else
+	{
+		f64Return = (2.0 * f64Dist) / (sTS003.f64V0 + sqrt((sTS003.f64V0 * sTS003.f64V0) + (2.0 * sTS003.f64A * f64Dist)));
+	}
+
+	//counter is well clear of zero
+	return f64Return + 1.0;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Where the FWD sensor is at time t, mm past stripe 0
+ *
+ */
+static Lfloat64 f64TS003__X_At(Lfloat64 f64T)
+{
+	Lfloat64 f64Run;
+
+	f64Run = f64T - 1.0;
+	return sTS003.f64Start + (sTS003.f64V0 * f64Run) + (0.5 * sTS003.f64A * f64Run * f64Run);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Compare the tracking with the profile at the last edge and a little after
+ *
+ * @param[in]		f64VelocLimit			Allowed relative velocity error
+ * @param[in]		u8Stripes				Stripes that were passed
+ * @return			1 if it all matches
+ */
+static Luint8 u8TS003__Check(Luint8 u8Stripes, Lfloat64 f64VelocLimit)
+{
+	Lfloat64 f64Veloc;
+	Lfloat64 f64Pos;
+	Lfloat64 f64Ahead;
+	Lfloat64 f64Time;
+	Luint8 u8Laser;
+	Luint8 u8Return;
+	char cText[200];
+
+	u8Return = 1U;
+
+	//all on the last stripe
+	for(u8Laser = 0U; u8Laser < (Luint8)LASER_CONT__MAX; u8Laser++)
+	{
+		if((sFCU.sContrast.sTimingList[u8Laser].s32Stripe != (Lint32)u8Stripes - 1) ||
+			(sFCU.sContrast.sTimingList[u8Laser].u32Resync != 0U))
+		{
+			u8Return = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	//speed at the last edge, which is the AFT sensor
+	f64Veloc = sTS003.f64V0 + (sTS003.f64A * (sTS003.f64LastTime - 1.0));
+	f64Time = (Lfloat64)((Luint64)(sTS003.f64LastTime * (Lfloat64)C_FCU__LASER_CONTRAST__TICKS_PER_SEC)) / (Lfloat64)C_FCU__LASER_CONTRAST__TICKS_PER_SEC;
+	f64Pos = (Lfloat64)u32FCU_LASERCONT_TL__Get_Position_mm((Luint64)(f64Time * (Lfloat64)C_FCU__LASER_CONTRAST__TICKS_PER_SEC)) - f64TS003__X_At(f64Time);
+
+	//50ms on with no edges
+	f64Time += 0.05;
+	f64Ahead = (Lfloat64)u32FCU_LASERCONT_TL__Get_Position_mm((Luint64)(f64Time * (Lfloat64)C_FCU__LASER_CONTRAST__TICKS_PER_SEC)) - f64TS003__X_At(f64Time);
+
+	sprintf(cText, "INFO: veloc %u mm/s (true %.0f), cross %u, pos err %.1f mm, +50ms %.1f mm, mismatch %u\r\n",
+			(unsigned int)u32FCU_LASERCONT_TL__Get_Velocity_mms(), f64Veloc,
+			(unsigned int)sFCU.sContrast.sVeloc.u32Cross_mms, f64Pos, f64Ahead,
+			(unsigned int)sFCU.sContrast.sVeloc.u32Mismatch);
+	DEBUG_PRINT(cText);
+
+	//carried forward at a constant speed that is itself a few ms old, so allow
+	//for the change in speed over the 50ms and the lag of the measurement
+	if((fabs(((Lfloat64)u32FCU_LASERCONT_TL__Get_Velocity_mms() - f64Veloc) / f64Veloc) > f64VelocLimit) ||
+		(fabs(f64Pos) > 2.0) ||
+		(fabs(f64Ahead) > (2.0 + (fabs(sTS003.f64A) * 0.05 * 0.04))) ||
+		(sFCU.sContrast.sVeloc.u32Mismatch != 0U) ||
+		(u8FCU_LASERCONT_TL__Get_IsFault() != 0U))
+	{
+		u8Return = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	return u8Return;
+}
+
+#endif //C_LOCALDEF__LCCM655__ENABLE_TEST_SPEC
+#endif //C_LOCALDEF__LCCM655__ENABLE_LASER_CONTRAST
+#endif //C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
+
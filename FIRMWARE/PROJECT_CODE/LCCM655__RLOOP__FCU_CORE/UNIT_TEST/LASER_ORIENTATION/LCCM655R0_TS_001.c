@@ -0,0 +1,437 @@
+/**
+ * @file		LCCM655R0_TS_001.C
+ * @brief		Test spec for the laser orientation solver
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM655R0.FILE.038
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_FCTL_ORIENTATION == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_TEST_SPEC == 1U
+
+//host side only
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+/** Number of plane updates to time */
+#define C_TS001__BENCH_LOOPS					(200000U)
+
+/** Worst atan2 error we accept, radians x 10000 */
+#define C_TS001__ATAN2_LIMIT					(1)
+
+/** Worst height error we accept, mm */
+#define C_TS001__HEIGHT_LIMIT					(0.01)
+
+void vLCCM655R0_TS_001_TCASE_001(void);
+void vLCCM655R0_TS_001_TCASE_002(void);
+void vLCCM655R0_TS_001_TCASE_003(void);
+void vLCCM655R0_TS_001_TCASE_004(void);
+static void vTS001__Make_Plane(Lfloat64 f64Roll, Lfloat64 f64Pitch, Lfloat64 f64Height, Lfloat64 f64Scale, Lfloat32 *pf32Plane);
+static void vTS001__Legacy_Update(const Lfloat32 *pf32Plane, const Lfloat32 *pf32TwistPlane);
+static Lint16 s16TS001__Legacy_Angle(const Lfloat32 *pf32Plane, Lfloat32 f32VecX, Lfloat32 f32VecY);
+static Lfloat32 f32TS001__Legacy_Distance(const Lfloat32 *pf32Plane, const Lfloat32 *pf32Position);
+
+//the legacy outputs, kept so the compiler can't drop the work
+static Lint16 s16TS001_LegacyAngles[4];
+static Lfloat32 f32TS001_LegacyHeights[C_FCU__NUM_HOVER_ENGINES];
+
+//Function to call the tests for this test specification
+void vLCCM655R0_TS_001(void)
+{
+	//Call the test cases
+	vLCCM655R0_TS_001_TCASE_001();
+	vLCCM655R0_TS_001_TCASE_002();
+	vLCCM655R0_TS_001_TCASE_003();
+	vLCCM655R0_TS_001_TCASE_004();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.001.TCASE.001
+ * @st_test_desc
+ * Integer atan2 against the C library all the way round the circle, at
+ * full scale and at small magnitudes where the ratio loses bits.
+ *
+*/
+void vLCCM655R0_TS_001_TCASE_001(void)
+{
+	Luint32 u32Step;
+	Luint32 u32Radius;
+	Lfloat64 f64Angle;
+	Lint32 s32Y;
+	Lint32 s32X;
+	Lint32 s32Expected;
+	Lint32 s32Error;
+	Lint32 s32Worst;
+	Lint16 s16Zero;
+	const Luint32 u32Radii[3U] = {32768U, 20000U, 2000U};
+	char cText[160];
+
+	DEBUG_PRINT("START:LCCM655R0.TS.001.TCASE.001\r\n");
+
+	s32Worst = 0;
+	for(u32Radius = 0U; u32Radius < 3U; u32Radius++)
+	{
+		for(u32Step = 0U; u32Step < 7200U; u32Step++)
+		{
+			f64Angle = (((Lfloat64)u32Step / 7200.0) * 2.0 * 3.14159265358979) - 3.14159265358979;
+			s32Y = (Lint32)floor((sin(f64Angle) * (Lfloat64)u32Radii[u32Radius]) + 0.5);
+			s32X = (Lint32)floor((cos(f64Angle) * (Lfloat64)u32Radii[u32Radius]) + 0.5);
+
+			//the answer for the rounded inputs, not the sweep angle
+			s32Expected = (Lint32)floor((atan2((Lfloat64)s32Y, (Lfloat64)s32X) * 10000.0) + 0.5);
+			s32Error = (Lint32)s16FCU_FLIGHTCTL_LASERORIENT_SOLVE__Atan2(s32Y, s32X) - s32Expected;
+
+			//+pi and -pi are the same place
+			if((s32Error > 60000) || (s32Error < -60000))
+			{
+				s32Error = 0;
+			}
+			else
+			{
+				//fall on
+			}
+
+			if(s32Error < 0)
+			{
+				s32Error = -s32Error;
+			}
+			else
+			{
+				//fall on
+			}
+
+			if(s32Error > s32Worst)
+			{
+				s32Worst = s32Error;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+	}
+
+	s16Zero = s16FCU_FLIGHTCTL_LASERORIENT_SOLVE__Atan2(0, 0);
+
+	sprintf(cText, "INFO: worst atan2 error %d x 1E-4 rad\r\n", s32Worst);
+	DEBUG_PRINT(cText);
+
+	if((s32Worst <= C_TS001__ATAN2_LIMIT) && (s16Zero == 0))
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.001.TCASE.001\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.001.TCASE.001\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.001.TCASE.001\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.001.TCASE.002
+ * @st_test_desc
+ * Solve tilted, unnormalised planes. Angles must match the float answer and
+ * every engine height must match a double precision point to plane distance
+ * with no fault raised.
+ *
+*/
+void vLCCM655R0_TS_001_TCASE_002(void)
+{
+	Lfloat32 f32Plane[4];
+	Lfloat32 f32Norm[4];
+	Lint16 s16Roll;
+	Lint16 s16Pitch;
+	Lint32 s32Case;
+	Lint32 s32Error;
+	Lint32 s32Worst;
+	Luint8 u8Counter;
+	Luint8 u8Return;
+	Luint32 u32Fails;
+	Lfloat64 f64Roll;
+	Lfloat64 f64Pitch;
+	Lfloat64 f64Mag;
+	Lfloat64 f64Expected;
+	Lfloat64 f64HeightError;
+	const Lfloat32 *pf32Pos;
+	char cText[160];
+
+	DEBUG_PRINT("START:LCCM655R0.TS.001.TCASE.002\r\n");
+
+	vFCU_FLIGHTCTL_LASERORIENT__Init();
+
+	s32Worst = 0;
+	f64HeightError = 0.0;
+	u32Fails = 0U;
+	for(s32Case = -20; s32Case <= 20; s32Case++)
+	{
+		//+/-0.1 rad roll, pitch on a different pattern so they don't track
+		f64Roll = (Lfloat64)s32Case * 0.005;
+		f64Pitch = (Lfloat64)((s32Case * 7) % 20) * 0.004;
+		vTS001__Make_Plane(f64Roll, f64Pitch, 12.5 + (Lfloat64)s32Case, 300.0 + ((Lfloat64)s32Case * 7.0), &f32Plane[0]);
+
+		u8Return = u8FCU_FLIGHTCTL_LASERORIENT_SOLVE__Plane(&f32Plane[0], &f32Norm[0], &s16Roll, &s16Pitch);
+		if(u8Return != 0U)
+		{
+			u32Fails++;
+		}
+		else
+		{
+			//fall on
+		}
+
+		s32Error = (Lint32)s16Roll - (Lint32)floor((atan2((Lfloat64)f32Plane[1], (Lfloat64)f32Plane[2]) * 10000.0) + 0.5);
+		if(s32Error < 0)
+		{
+			s32Error = -s32Error;
+		}
+		else
+		{
+			//fall on
+		}
+		if(s32Error > s32Worst)
+		{
+			s32Worst = s32Error;
+		}
+		else
+		{
+			//fall on
+		}
+
+		s32Error = (Lint32)s16Pitch - (Lint32)floor((atan2((Lfloat64)f32Plane[0], (Lfloat64)f32Plane[2]) * 10000.0) + 0.5);
+		if(s32Error < 0)
+		{
+			s32Error = -s32Error;
+		}
+		else
+		{
+			//fall on
+		}
+		if(s32Error > s32Worst)
+		{
+			s32Worst = s32Error;
+		}
+		else
+		{
+			//fall on
+		}
+
+		vFCU_FLIGHTCTL_LASERORIENT_SOLVE__Heights(&f32Norm[0]);
+
+		f64Mag = sqrt(((Lfloat64)f32Plane[0] * (Lfloat64)f32Plane[0]) + ((Lfloat64)f32Plane[1] * (Lfloat64)f32Plane[1]) + ((Lfloat64)f32Plane[2] * (Lfloat64)f32Plane[2]));
+		for(u8Counter = 0U; u8Counter < C_FCU__NUM_HOVER_ENGINES; u8Counter++)
+		{
+			pf32Pos = &sFCU.sFlightControl.sOrient.sHoverEngines[u8Counter].f32Position[0];
+			f64Expected = (((Lfloat64)f32Plane[0] * (Lfloat64)pf32Pos[0]) + ((Lfloat64)f32Plane[1] * (Lfloat64)pf32Pos[1]) + ((Lfloat64)f32Plane[2] * (Lfloat64)pf32Pos[2]) + (Lfloat64)f32Plane[3]) / f64Mag;
+			f64Expected = fabs(f64Expected - (Lfloat64)sFCU.sFlightControl.sOrient.sHoverEngines[u8Counter].f32Measurement);
+			if(f64Expected > f64HeightError)
+			{
+				f64HeightError = f64Expected;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+	}
+
+	sprintf(cText, "INFO: worst angle error %d x 1E-4 rad, worst height error %.5f mm, worst cross check %u\r\n",
+			s32Worst, f64HeightError, (Luint32)sFCU.sFlightControl.sOrient.sCrossCheck.u16WorstError);
+	DEBUG_PRINT(cText);
+
+	if((u32Fails == 0U) &&
+		(s32Worst <= C_TS001__ATAN2_LIMIT) &&
+		(f64HeightError < C_TS001__HEIGHT_LIMIT) &&
+		(u8FCU_FLIGHTCTL_LASERORIENT__Get_IsFault() == 0U))
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.001.TCASE.002\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.001.TCASE.002\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.001.TCASE.002\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.001.TCASE.003
+ * @st_test_desc
+ * A plane with a zero or downward normal is rejected, the angles are left
+ * alone and the ground plane fault latches.
+ *
+*/
+void vLCCM655R0_TS_001_TCASE_003(void)
+{
+	Lfloat32 f32Plane[4];
+	Lfloat32 f32Norm[4];
+	Lint16 s16Roll;
+	Lint16 s16Pitch;
+	Luint8 u8Return1;
+	Luint8 u8Return2;
+
+	DEBUG_PRINT("START:LCCM655R0.TS.001.TCASE.003\r\n");
+
+	vFCU_FLIGHTCTL_LASERORIENT__Init();
+	s16Roll = 123;
+	s16Pitch = -321;
+
+	//lasers all reading the same point
+	f32Plane[0] = 0.0F;
+	f32Plane[1] = 0.0F;
+	f32Plane[2] = 0.0F;
+	f32Plane[3] = 5.0F;
+	u8Return1 = u8FCU_FLIGHTCTL_LASERORIENT_SOLVE__Plane(&f32Plane[0], &f32Norm[0], &s16Roll, &s16Pitch);
+
+	//upside down
+	vTS001__Make_Plane(0.01, 0.02, 10.0, -50.0, &f32Plane[0]);
+	u8Return2 = u8FCU_FLIGHTCTL_LASERORIENT_SOLVE__Plane(&f32Plane[0], &f32Norm[0], &s16Roll, &s16Pitch);
+
+	if((u8Return1 == 1U) && (u8Return2 == 1U) &&
+		(s16Roll == 123) && (s16Pitch == -321) &&
+		(u8FCU_FLIGHTCTL_LASERORIENT__Get_IsFault() == 1U) &&
+		(u32FCU_FLIGHTCTL_LASERORIENT__Get_FaultFlags() == (C_LCCM655__LASER_ORIENT__FAULT_INDEX_MASK__00 | C_LCCM655__LASER_ORIENT__FAULT_INDEX_MASK__02)))
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.001.TCASE.003\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.001.TCASE.003\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.001.TCASE.003\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.001.TCASE.004
+ * @st_test_desc
+ * Time per update, main and twist planes plus 8 engine heights. The legacy
+ * path is the double precision acos/sqrt code the solver replaced.
+ *
+*/
+void vLCCM655R0_TS_001_TCASE_004(void)
+{
+	Lfloat32 f32Plane[4];
+	Lfloat32 f32Twist[4];
+	Lfloat32 f32Norm[4];
+	Lfloat32 f32TwistNorm[4];
+	Lint16 s16Roll;
+	Lint16 s16Pitch;
+	Luint32 u32Loop;
+	Luint32 u32Fails;
+	clock_t tStart;
+	Lfloat64 f64Legacy;
+	Lfloat64 f64Solver;
+	char cText[160];
+
+	DEBUG_PRINT("START:LCCM655R0.TS.001.TCASE.004\r\n");
+
+	vFCU_FLIGHTCTL_LASERORIENT__Init();
+	vTS001__Make_Plane(0.03, -0.02, 15.0, 850.0, &f32Plane[0]);
+	vTS001__Make_Plane(0.031, -0.018, 15.1, 910.0, &f32Twist[0]);
+
+	tStart = clock();
+	for(u32Loop = 0U; u32Loop < C_TS001__BENCH_LOOPS; u32Loop++)
+	{
+		//move the planes a little so nothing is hoisted out of the loop
+		f32Plane[0] += 1.0E-6F;
+		f32Twist[1] += 1.0E-6F;
+		vTS001__Legacy_Update(&f32Plane[0], &f32Twist[0]);
+	}
+	f64Legacy = ((Lfloat64)(clock() - tStart + 1) / (Lfloat64)CLOCKS_PER_SEC) * 1.0E9 / (Lfloat64)C_TS001__BENCH_LOOPS;
+
+	vTS001__Make_Plane(0.03, -0.02, 15.0, 850.0, &f32Plane[0]);
+	vTS001__Make_Plane(0.031, -0.018, 15.1, 910.0, &f32Twist[0]);
+	u32Fails = 0U;
+	tStart = clock();
+	for(u32Loop = 0U; u32Loop < C_TS001__BENCH_LOOPS; u32Loop++)
+	{
+		f32Plane[0] += 1.0E-6F;
+		f32Twist[1] += 1.0E-6F;
+		u32Fails += (Luint32)u8FCU_FLIGHTCTL_LASERORIENT_SOLVE__Plane(&f32Plane[0], &f32Norm[0], &s16Roll, &s16Pitch);
+		vFCU_FLIGHTCTL_LASERORIENT_SOLVE__Heights(&f32Norm[0]);
+		u32Fails += (Luint32)u8FCU_FLIGHTCTL_LASERORIENT_SOLVE__Plane(&f32Twist[0], &f32TwistNorm[0], &s16Roll, &s16Pitch);
+	}
+	f64Solver = ((Lfloat64)(clock() - tStart + 1) / (Lfloat64)CLOCKS_PER_SEC) * 1.0E9 / (Lfloat64)C_TS001__BENCH_LOOPS;
+
+	sprintf(cText, "INFO: legacy %.1f ns/update, solver %.1f ns/update, %.2fx\r\n", f64Legacy, f64Solver, f64Legacy / f64Solver);
+	DEBUG_PRINT(cText);
+	sprintf(cText, "INFO: legacy roll %d pitch %d, engine 0 %.3f mm\r\n", s16TS001_LegacyAngles[0], s16TS001_LegacyAngles[1], f32TS001_LegacyHeights[0]);
+	DEBUG_PRINT(cText);
+
+	if(u32Fails == 0U)
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.001.TCASE.004\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.001.TCASE.004\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.001.TCASE.004\r\n");
+}
+
+/***************************************************************************//**
+ * @brief
+ * Build the plane z = h + x.tan(pitch) + y.tan(roll), pointing up, then
+ * scale it the way an unnormalised cross product would be.
+ *
+*/
+static void vTS001__Make_Plane(Lfloat64 f64Roll, Lfloat64 f64Pitch, Lfloat64 f64Height, Lfloat64 f64Scale, Lfloat32 *pf32Plane)
+{
+	//-z + x.tan(p) + y.tan(r) + h = 0, flipped so the normal is +z
+	pf32Plane[0] = (Lfloat32)(-tan(f64Pitch) * f64Scale);
+	pf32Plane[1] = (Lfloat32)(-tan(f64Roll) * f64Scale);
+	pf32Plane[2] = (Lfloat32)f64Scale;
+	pf32Plane[3] = (Lfloat32)(-f64Height * f64Scale);
+}
+
+/***************************************************************************//**
+ * @brief
+ * The update as it was done before the solver, kept here only to benchmark.
+ *
+*/
+static void vTS001__Legacy_Update(const Lfloat32 *pf32Plane, const Lfloat32 *pf32TwistPlane)
+{
+	Luint8 u8Counter;
+
+	for(u8Counter = 0U; u8Counter < C_FCU__NUM_HOVER_ENGINES; u8Counter++)
+	{
+		f32TS001_LegacyHeights[u8Counter] = f32TS001__Legacy_Distance(pf32Plane, &sFCU.sFlightControl.sOrient.sHoverEngines[u8Counter].f32Position[0]);
+	}
+
+	s16TS001_LegacyAngles[0] = s16TS001__Legacy_Angle(pf32Plane, 1.0F, 0.0F);
+	s16TS001_LegacyAngles[1] = s16TS001__Legacy_Angle(pf32Plane, 0.0F, 1.0F);
+	s16TS001_LegacyAngles[2] = s16TS001__Legacy_Angle(pf32TwistPlane, 1.0F, 0.0F) - s16TS001_LegacyAngles[0];
+	s16TS001_LegacyAngles[3] = s16TS001__Legacy_Angle(pf32TwistPlane, 0.0F, 1.0F) - s16TS001_LegacyAngles[1];
+}
+
+static Lint16 s16TS001__Legacy_Angle(const Lfloat32 *pf32Plane, Lfloat32 f32VecX, Lfloat32 f32VecY)
+{
+	return (Lint16)(acos((double)((f32VecX * pf32Plane[0] + f32VecY * pf32Plane[1]) / sqrt((double)(pf32Plane[0] * pf32Plane[0] + pf32Plane[1] * pf32Plane[1] + pf32Plane[2] * pf32Plane[2])))) * 10000);
+}
+
+static Lfloat32 f32TS001__Legacy_Distance(const Lfloat32 *pf32Plane, const Lfloat32 *pf32Position)
+{
+	return (Lfloat32)((pf32Plane[0] * pf32Position[0] + pf32Plane[1] * pf32Position[1] + pf32Plane[2] * pf32Position[2] + pf32Plane[3]) /
+		sqrt((double)(pf32Plane[0] * pf32Plane[0] + pf32Plane[1] * pf32Plane[1] + pf32Plane[2] * pf32Plane[2])));
+}
+
+#endif //C_LOCALDEF__LCCM655__ENABLE_TEST_SPEC
+#endif //C_LOCALDEF__LCCM655__ENABLE_FCTL_ORIENTATION
+#endif //C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL
+#endif //C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
+
@@ -0,0 +1,316 @@
+/**
+ * @file		LCCM655R0_TS_002.C
+ * @brief		Test spec for the least squares ground plane fit
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM655R0.FILE.040
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_FCTL_ORIENTATION == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_TEST_SPEC == 1U
+
+//host side only
+#include <stdio.h>
+#include <math.h>
+
+/** How close a fit has to be to the plane the lasers were set from */
+#define C_TS002__COEFF_LIMIT					(1.0E-3)
+
+void vLCCM655R0_TS_002_TCASE_001(void);
+void vLCCM655R0_TS_002_TCASE_002(void);
+void vLCCM655R0_TS_002_TCASE_003(void);
+void vLCCM655R0_TS_002_TCASE_004(void);
+static void vTS002__Setup(void);
+static void vTS002__Set_Ground(Lfloat64 f64A, Lfloat64 f64B, Lfloat64 f64C);
+static Luint8 u8TS002__Check(Lfloat64 f64A, Lfloat64 f64B, Lfloat64 f64C, Lfloat64 f64Limit);
+
+//the lasers sit on a rectangle, Z is the reading when flat
+static const Lfloat32 f32TS002_Pos[C_FCU__NUM_LASERS_GROUND][3] =
+{
+	{100.0F, 80.0F, 35.0F},
+	{-100.0F, 80.0F, 35.0F},
+	{-100.0F, -80.0F, 35.0F},
+	{100.0F, -80.0F, 35.0F}
+};
+
+//Function to call the tests for this test specification
+void vLCCM655R0_TS_002(void)
+{
+	//Call the test cases
+	vLCCM655R0_TS_002_TCASE_001();
+	vLCCM655R0_TS_002_TCASE_002();
+	vLCCM655R0_TS_002_TCASE_003();
+	vLCCM655R0_TS_002_TCASE_004();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.002.TCASE.001
+ * @st_test_desc
+ * All four lasers on a tilted plane, the fit recovers it and the plane handed
+ * to the solver points up.
+ *
+*/
+void vLCCM655R0_TS_002_TCASE_001(void)
+{
+	Lfloat32 f32Plane[4];
+	Luint8 u8Mask;
+
+	DEBUG_PRINT("START:LCCM655R0.TS.002.TCASE.001\r\n");
+
+	vTS002__Setup();
+	vTS002__Set_Ground(-12.0, 0.02, -0.015);
+	u8Mask = u8FCU_FLIGHTCTL_LASERORIENT_FIT__Update(0x0FU, &f32Plane[0]);
+
+	if((u8Mask == 0x0FU) &&
+		(u8TS002__Check(-12.0, 0.02, -0.015, C_TS002__COEFF_LIMIT) == 1U) &&
+		(f32Plane[LASER_ORIENT__C] > 0.0F) &&
+		(fabs((Lfloat64)f32Plane[LASER_ORIENT__A] + 0.02) < C_TS002__COEFF_LIMIT))
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.002.TCASE.001\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.002.TCASE.001\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.002.TCASE.001\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.002.TCASE.002
+ * @st_test_desc
+ * One laser jumps 20mm. It is thrown out, counted, and the other three
+ * still give the real plane.
+ *
+*/
+void vLCCM655R0_TS_002_TCASE_002(void)
+{
+	Lfloat32 f32Plane[4];
+	Luint8 u8Mask;
+	Luint8 u8Laser;
+	Luint8 u8Pass;
+
+	DEBUG_PRINT("START:LCCM655R0.TS.002.TCASE.002\r\n");
+
+	u8Pass = 1U;
+	for(u8Laser = 0U; u8Laser < C_FCU__NUM_LASERS_GROUND; u8Laser++)
+	{
+		vTS002__Setup();
+		vTS002__Set_Ground(-10.0, 0.01, 0.005);
+		(void)u8FCU_FLIGHTCTL_LASERORIENT_FIT__Update(0x0FU, &f32Plane[0]);
+
+		//the pod moves a little, one laser sees a glint
+		vTS002__Set_Ground(-10.5, 0.012, 0.004);
+		sFCU.sFlightControl.sOrient.sGroundLasers[u8Laser].f32Measurement += 20.0F;
+		u8Mask = u8FCU_FLIGHTCTL_LASERORIENT_FIT__Update(0x0FU, &f32Plane[0]);
+
+		if((u8Mask != (Luint8)(0x0FU & ~(1U << u8Laser))) ||
+			(sFCU.sFlightControl.sOrient.sFit.u32Rejected[u8Laser] != 1U) ||
+			(u8TS002__Check(-10.5, 0.012, 0.004, C_TS002__COEFF_LIMIT) == 0U))
+		{
+			u8Pass = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	if(u8Pass == 1U)
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.002.TCASE.002\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.002.TCASE.002\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.002.TCASE.002\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.002.TCASE.003
+ * @st_test_desc
+ * Down to two lasers. The height and the slope along the two lasers are
+ * still tracked, the slope across them holds its last value.
+ *
+*/
+void vLCCM655R0_TS_002_TCASE_003(void)
+{
+	Lfloat32 f32Plane[4];
+	Luint8 u8Mask1;
+	Luint8 u8Mask2;
+	Luint8 u8Mask0;
+	char cText[160];
+
+	DEBUG_PRINT("START:LCCM655R0.TS.002.TCASE.003\r\n");
+
+	vTS002__Setup();
+	vTS002__Set_Ground(-10.0, 0.01, 0.005);
+	(void)u8FCU_FLIGHTCTL_LASERORIENT_FIT__Update(0x0FU, &f32Plane[0]);
+
+	//lasers 0 and 1 are on y = 80, they see the x slope but not the y slope
+	vTS002__Set_Ground(-13.0, 0.02, 0.005);
+	u8Mask1 = u8FCU_FLIGHTCTL_LASERORIENT_FIT__Update(0x03U, &f32Plane[0]);
+
+	sprintf(cText, "INFO: two lasers a %.4f b %.5f c %.5f\r\n",
+			(Lfloat64)sFCU.sFlightControl.sOrient.sFit.f32Coeffs[0],
+			(Lfloat64)sFCU.sFlightControl.sOrient.sFit.f32Coeffs[1],
+			(Lfloat64)sFCU.sFlightControl.sOrient.sFit.f32Coeffs[2]);
+	DEBUG_PRINT(cText);
+
+	//one laser left, height only
+	vTS002__Set_Ground(-14.0, 0.02, 0.005);
+	u8Mask2 = u8FCU_FLIGHTCTL_LASERORIENT_FIT__Update(0x01U, &f32Plane[0]);
+
+	//none left, nothing changes
+	u8Mask0 = u8FCU_FLIGHTCTL_LASERORIENT_FIT__Update(0x00U, &f32Plane[0]);
+
+	if((u8Mask1 == 0x03U) && (u8Mask2 == 0x01U) && (u8Mask0 == 0x00U) &&
+		(u8TS002__Check(-14.0, 0.02, 0.005, 1.0E-2) == 1U))
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.002.TCASE.003\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.002.TCASE.003\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.002.TCASE.003\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.002.TCASE.004
+ * @st_test_desc
+ * Three lasers leave no residual, the fit is the plane through the three
+ * points and matches the cross product the old code used.
+ *
+*/
+void vLCCM655R0_TS_002_TCASE_004(void)
+{
+	Lfloat32 f32Plane[4];
+	Lfloat64 f64Z[3];
+	Lfloat64 f64V1[3];
+	Lfloat64 f64V2[3];
+	Lfloat64 f64N[3];
+	Luint8 u8Mask;
+	Luint8 u8Counter;
+
+	DEBUG_PRINT("START:LCCM655R0.TS.002.TCASE.004\r\n");
+
+	vTS002__Setup();
+	vTS002__Set_Ground(-10.0, 0.0, 0.0);
+
+	//uneven ground under lasers 1, 2 and 3
+	sFCU.sFlightControl.sOrient.sGroundLasers[1].f32Measurement += 1.5F;
+	sFCU.sFlightControl.sOrient.sGroundLasers[2].f32Measurement -= 0.7F;
+	sFCU.sFlightControl.sOrient.sGroundLasers[3].f32Measurement += 0.2F;
+	u8Mask = u8FCU_FLIGHTCTL_LASERORIENT_FIT__Update(0x0EU, &f32Plane[0]);
+
+	for(u8Counter = 0U; u8Counter < 3U; u8Counter++)
+	{
+		f64Z[u8Counter] = (Lfloat64)f32TS002_Pos[u8Counter + 1U][2] - (Lfloat64)sFCU.sFlightControl.sOrient.sGroundLasers[u8Counter + 1U].f32Measurement;
+	}
+	f64V1[0] = (Lfloat64)f32TS002_Pos[1][0] - (Lfloat64)f32TS002_Pos[2][0];
+	f64V1[1] = (Lfloat64)f32TS002_Pos[1][1] - (Lfloat64)f32TS002_Pos[2][1];
+	f64V1[2] = f64Z[0] - f64Z[1];
+	f64V2[0] = (Lfloat64)f32TS002_Pos[2][0] - (Lfloat64)f32TS002_Pos[3][0];
+	f64V2[1] = (Lfloat64)f32TS002_Pos[2][1] - (Lfloat64)f32TS002_Pos[3][1];
+	f64V2[2] = f64Z[1] - f64Z[2];
+	f64N[0] = (f64V1[1] * f64V2[2]) - (f64V1[2] * f64V2[1]);
+	f64N[1] = (f64V1[2] * f64V2[0]) - (f64V1[0] * f64V2[2]);
+	f64N[2] = (f64V1[0] * f64V2[1]) - (f64V1[1] * f64V2[0]);
+
+	//z = a + bx + cy from the normal
+	if((u8Mask == 0x0EU) &&
+		(u8TS002__Check(f64Z[0] + ((f64N[0] * (Lfloat64)f32TS002_Pos[1][0]) + (f64N[1] * (Lfloat64)f32TS002_Pos[1][1])) / f64N[2], -f64N[0] / f64N[2], -f64N[1] / f64N[2], C_TS002__COEFF_LIMIT) == 1U) &&
+		(fabs((Lfloat64)sFCU.sFlightControl.sOrient.sFit.f32Residual[1]) < C_TS002__COEFF_LIMIT))
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.002.TCASE.004\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.002.TCASE.004\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.002.TCASE.004\r\n");
+}
+
+/***************************************************************************//**
+ * @brief
+ * Load the test laser positions and rebuild the fit tables
+ *
+*/
+static void vTS002__Setup(void)
+{
+	Luint8 u8Laser;
+	Luint8 u8Axis;
+
+	vFCU_FLIGHTCTL_LASERORIENT__Init();
+	for(u8Laser = 0U; u8Laser < C_FCU__NUM_LASERS_GROUND; u8Laser++)
+	{
+		for(u8Axis = 0U; u8Axis < 3U; u8Axis++)
+		{
+			sFCU.sFlightControl.sOrient.sGroundLasers[u8Laser].f32Position[u8Axis] = f32TS002_Pos[u8Laser][u8Axis];
+		}
+	}
+	vFCU_FLIGHTCTL_LASERORIENT_FIT__Init();
+}
+
+/***************************************************************************//**
+ * @brief
+ * Set each laser reading so it sees the ground z = a + bx + cy
+ *
+*/
+static void vTS002__Set_Ground(Lfloat64 f64A, Lfloat64 f64B, Lfloat64 f64C)
+{
+	Luint8 u8Laser;
+
+	for(u8Laser = 0U; u8Laser < C_FCU__NUM_LASERS_GROUND; u8Laser++)
+	{
+		sFCU.sFlightControl.sOrient.sGroundLasers[u8Laser].f32Measurement = (Lfloat32)((Lfloat64)f32TS002_Pos[u8Laser][2] -
+				(f64A + (f64B * (Lfloat64)f32TS002_Pos[u8Laser][0]) + (f64C * (Lfloat64)f32TS002_Pos[u8Laser][1])));
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * 1 if the last fit is within the limit of {a, b, c}
+ *
+*/
+static Luint8 u8TS002__Check(Lfloat64 f64A, Lfloat64 f64B, Lfloat64 f64C, Lfloat64 f64Limit)
+{
+	Luint8 u8Return;
+
+	//slopes are per mm, scale them to mm across the pod before comparing
+	if((fabs((Lfloat64)sFCU.sFlightControl.sOrient.sFit.f32Coeffs[0] - f64A) < f64Limit) &&
+		((fabs((Lfloat64)sFCU.sFlightControl.sOrient.sFit.f32Coeffs[1] - f64B) * 100.0) < f64Limit) &&
+		((fabs((Lfloat64)sFCU.sFlightControl.sOrient.sFit.f32Coeffs[2] - f64C) * 100.0) < f64Limit))
+	{
+		u8Return = 1U;
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+#endif //C_LOCALDEF__LCCM655__ENABLE_TEST_SPEC
+#endif //C_LOCALDEF__LCCM655__ENABLE_FCTL_ORIENTATION
+#endif //C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL
+#endif //C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
+
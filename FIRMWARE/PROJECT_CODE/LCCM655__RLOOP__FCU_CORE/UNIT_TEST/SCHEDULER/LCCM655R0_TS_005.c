@@ -0,0 +1,954 @@
+/**
+ * @file		LCCM655R0_TS_005.C
+ * @brief		Test spec for the FCU task scheduler against a simulated clock
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM655R0.FILE.047
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM655__ENABLE_TEST_SPEC == 1U
+
+//host side only
+#include <stdio.h>
+
+/** Sim tasks, 3 x 10ms, 3 x 100ms, background, then the FCU table */
+#define C_TS005__NUM_TASKS						(23U)
+#define C_TS005__BACKGROUND						(6U)
+#define C_TS005__ADC							(7U)
+#define C_TS005__NET							(8U)
+#define C_TS005__MAINSM							(9U)
+#define C_TS005__PARAMSHADOW					(10U)
+#define C_TS005__SC16							(11U)
+#define C_TS005__ASI							(12U)
+#define C_TS005__LASEROPTO						(13U)
+#define C_TS005__LASERCONT						(14U)
+#define C_TS005__LASERDIST						(15U)
+#define C_TS005__BRAKES							(16U)
+#define C_TS005__ACCEL							(17U)
+#define C_TS005__PICOMMS						(18U)
+#define C_TS005__FLIGHTCTL						(19U)
+#define C_TS005__AMC7812						(20U)
+#define C_TS005__THROTTLE						(21U)
+#define C_TS005__PUSHER							(22U)
+
+/** Sim ticks per us */
+#define C_TS005__TICKS_PER_US					(C_LOCALDEF__LCCM655__SCHED__TICKS_PER_MS / 1000U)
+
+/** Main loop overhead outside the scheduler, ticks */
+#define C_TS005__LOOP_TICKS						(50U)
+
+void vLCCM655R0_TS_005_TCASE_001(void);
+void vLCCM655R0_TS_005_TCASE_002(void);
+void vLCCM655R0_TS_005_TCASE_003(void);
+void vLCCM655R0_TS_005_TCASE_004(void);
+void vLCCM655R0_TS_005_TCASE_005(void);
+static void vTS005__Reset(void);
+static void vTS005__Add_All(Luint16 u16Phase_ms);
+static void vTS005__Add_FCU(void);
+static void vTS005__Run_ms(Luint32 u32Length_ms);
+static void vTS005__Task(Luint8 u8Task);
+static void vTS005__Task_0(void);
+static void vTS005__Task_1(void);
+static void vTS005__Task_2(void);
+static void vTS005__Task_3(void);
+static void vTS005__Task_4(void);
+static void vTS005__Task_5(void);
+static void vTS005__Task_6(void);
+static void vTS005__Task_7(void);
+static void vTS005__Task_8(void);
+static void vTS005__Task_9(void);
+static void vTS005__Task_10(void);
+static void vTS005__Task_11(void);
+static void vTS005__Task_12(void);
+static void vTS005__Task_13(void);
+static void vTS005__Task_14(void);
+static void vTS005__Task_15(void);
+static void vTS005__Task_16(void);
+static void vTS005__Task_17(void);
+static void vTS005__Task_18(void);
+static void vTS005__Task_19(void);
+static void vTS005__Task_20(void);
+static void vTS005__Task_21(void);
+static void vTS005__Task_22(void);
+static void vTS005__Timer_Task(void);
+static void vTS005__Print_Stats(void);
+
+/** The clock and what each task costs on it */
+static struct
+{
+	/** Sim clock, ticks */
+	Luint32 u32Ticks;
+
+	/** Run time of each task, us */
+	Luint32 u32Cost_us[C_TS005__NUM_TASKS];
+
+	/** Calls seen */
+	Luint32 u32Calls[C_TS005__NUM_TASKS];
+
+	/** Task index the scheduler handed back */
+	Lint16 s16Index[C_TS005__NUM_TASKS];
+
+	/** Module timer under test */
+	Luint32 u32TimerDue_ms;
+	Luint32 u32TimerFires;
+
+}sTS005;
+
+//Function to call the tests for this test specification
+void vLCCM655R0_TS_005(void)
+{
+	//Call the test cases
+	vLCCM655R0_TS_005_TCASE_001();
+	vLCCM655R0_TS_005_TCASE_002();
+	vLCCM655R0_TS_005_TCASE_003();
+	vLCCM655R0_TS_005_TCASE_004();
+	vLCCM655R0_TS_005_TCASE_005();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.005.TCASE.001
+ * @st_test_desc
+ * Table building: the bad argument returns, run order by priority, and the
+ * auto phase spreading the 10ms and 100ms groups so no slot carries more than
+ * one task where all on phase 0 put six in the same slot.
+ *
+*/
+void vLCCM655R0_TS_005_TCASE_001(void)
+{
+	Luint8 u8Test;
+	Luint8 u8Counter;
+	Lint16 s16Index;
+	char cText[200];
+
+	DEBUG_PRINT("START:LCCM655R0.TS.005.TCASE.001\r\n");
+
+	u8Test = 1U;
+	vTS005__Reset();
+
+	//phase past the period, no function
+	if((s16FCU_SCHED__Add(&vTS005__Task_0, 10U, 10U, C_FCU__SCHED__PRIO__10MS, 20U) != -1) ||
+		(s16FCU_SCHED__Add(0, 10U, 0U, C_FCU__SCHED__PRIO__10MS, 20U) != -1) ||
+		(u8FCU_SCHED__Get_NumTasks() != 0U))
+	{
+		DEBUG_PRINT("FAIL: bad arguments taken\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//full table
+	for(u8Counter = 0U; u8Counter < C_FCU__SCHED__MAX_TASKS; u8Counter++)
+	{
+		s16Index = s16FCU_SCHED__Add(&vTS005__Task_6, 0U, 0U, C_FCU__SCHED__PRIO__BACKGROUND, 0U);
+		if(s16Index != (Lint16)u8Counter)
+		{
+			DEBUG_PRINT("FAIL: table fill\r\n");
+			u8Test = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	if(s16FCU_SCHED__Add(&vTS005__Task_6, 0U, 0U, C_FCU__SCHED__PRIO__BACKGROUND, 0U) != -1)
+	{
+		DEBUG_PRINT("FAIL: table overfilled\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//everything on phase 0, one slot carries all six
+	vTS005__Reset();
+	vTS005__Add_All(0U);
+	vFCU_SCHED__Replay(1000U);
+	if(u32FCU_SCHED__Get_ReplayPeak_us() != (6U * 20U))
+	{
+		sprintf(cText, "FAIL: phase 0 peak %u us\r\n", (unsigned int)u32FCU_SCHED__Get_ReplayPeak_us());
+		DEBUG_PRINT(cText);
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//background added first still runs after the timed ones
+	if((sFCU.sSched.u8Order[0] != (Luint8)sTS005.s16Index[0]) ||
+		(sFCU.sSched.u8Order[3] != (Luint8)sTS005.s16Index[3]) ||
+		(sFCU.sSched.u8Order[6] != (Luint8)sTS005.s16Index[C_TS005__BACKGROUND]))
+	{
+		DEBUG_PRINT("FAIL: run order\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//left to the scheduler, the 10ms group first then the 100ms group in the gaps
+	vTS005__Reset();
+	vTS005__Add_All(C_FCU__SCHED__PHASE_AUTO);
+	for(u8Counter = 0U; u8Counter < 6U; u8Counter++)
+	{
+		if(u16FCU_SCHED__Get_Phase_ms((Luint8)sTS005.s16Index[u8Counter]) != (Luint16)u8Counter)
+		{
+			sprintf(cText, "FAIL: task %u phase %u\r\n", (unsigned int)u8Counter, (unsigned int)u16FCU_SCHED__Get_Phase_ms((Luint8)sTS005.s16Index[u8Counter]));
+			DEBUG_PRINT(cText);
+			u8Test = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	vFCU_SCHED__Replay(1000U);
+	if(u32FCU_SCHED__Get_ReplayPeak_us() != 20U)
+	{
+		sprintf(cText, "FAIL: auto phase peak %u us\r\n", (unsigned int)u32FCU_SCHED__Get_ReplayPeak_us());
+		DEBUG_PRINT(cText);
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(u8Test == 1U)
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.005.TCASE.001\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.005.TCASE.001\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.005.TCASE.001\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.005.TCASE.002
+ * @st_test_desc
+ * A second of main loop: every task runs once per period with nothing late,
+ * the task over its budget is counted and raises TASK_OVERRUN, the measured
+ * run times come back. Then a background pass longer than a 10ms period makes
+ * the 10ms group late and drops slots.
+ *
+*/
+void vLCCM655R0_TS_005_TCASE_002(void)
+{
+	Luint8 u8Test;
+	Luint8 u8Counter;
+	Luint8 u8Task;
+	Luint32 u32Expect;
+	char cText[200];
+
+	DEBUG_PRINT("START:LCCM655R0.TS.005.TCASE.002\r\n");
+
+	u8Test = 1U;
+	vTS005__Reset();
+	vTS005__Add_All(C_FCU__SCHED__PHASE_AUTO);
+
+	//one 100ms task runs over its 20us
+	sTS005.u32Cost_us[5] = 40U;
+	sTS005.u32Cost_us[C_TS005__BACKGROUND] = 100U;
+
+	if((u32FCU_FAULTS__Get_FaultFlags() & C_LCCM655__CORE__FAULT_INDEX_MASK__02) != 0U)
+	{
+		DEBUG_PRINT("FAIL: overrun before start\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vFCU_SCHED__Start();
+	vTS005__Run_ms(1000U);
+	vTS005__Print_Stats();
+
+	for(u8Counter = 0U; u8Counter < 6U; u8Counter++)
+	{
+		u8Task = (Luint8)sTS005.s16Index[u8Counter];
+		if(u8Counter < 3U)
+		{
+			u32Expect = 100U;
+		}
+		else
+		{
+			u32Expect = 10U;
+		}
+
+		if((u32FCU_SCHED__Get_Runs(u8Task) != u32Expect) || (sTS005.u32Calls[u8Counter] != u32Expect) ||
+			(u32FCU_SCHED__Get_Late(u8Task) != 0U))
+		{
+			sprintf(cText, "FAIL: task %u runs %u late %u\r\n", (unsigned int)u8Counter, (unsigned int)u32FCU_SCHED__Get_Runs(u8Task), (unsigned int)u32FCU_SCHED__Get_Late(u8Task));
+			DEBUG_PRINT(cText);
+			u8Test = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+
+		if(u32FCU_SCHED__Get_ExecMax_us(u8Task) != sTS005.u32Cost_us[u8Counter])
+		{
+			sprintf(cText, "FAIL: task %u exec max %u\r\n", (unsigned int)u8Counter, (unsigned int)u32FCU_SCHED__Get_ExecMax_us(u8Task));
+			DEBUG_PRINT(cText);
+			u8Test = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	if((u32FCU_SCHED__Get_Overruns((Luint8)sTS005.s16Index[5]) != 10U) || (u32FCU_SCHED__Get_Overruns((Luint8)sTS005.s16Index[0]) != 0U) ||
+		((u32FCU_FAULTS__Get_FaultFlags() & C_LCCM655__CORE__FAULT_INDEX_MASK__02) == 0U))
+	{
+		DEBUG_PRINT("FAIL: overrun not seen\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	if((f32FCU_SCHED__Get_ExecMean_us((Luint8)sTS005.s16Index[0]) != 15.0F) || (sFCU.sSched.u32SlotsDropped != 0U) ||
+		(u32FCU_SCHED__Get_Runs((Luint8)sTS005.s16Index[C_TS005__BACKGROUND]) < 1000U))
+	{
+		DEBUG_PRINT("FAIL: mean or background\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//background hogs the loop for 25ms a pass
+	vFCU_SCHED__Clear_Stats();
+	sTS005.u32Cost_us[C_TS005__BACKGROUND] = 25000U;
+	vTS005__Run_ms(200U);
+	vTS005__Print_Stats();
+	if((u32FCU_SCHED__Get_Late((Luint8)sTS005.s16Index[0]) == 0U) || (sFCU.sSched.u32SlotsDropped == 0U))
+	{
+		DEBUG_PRINT("FAIL: hog not seen\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(u8Test == 1U)
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.005.TCASE.002\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.005.TCASE.002\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.005.TCASE.002\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.005.TCASE.003
+ * @st_test_desc
+ * Replay of the table without calling it: a short background pass keeps every
+ * task inside its period with the response bound to one pass plus the task,
+ * the load matches the budgets, and a background worst case longer than the
+ * 10ms period shows up as misses.
+ *
+*/
+void vLCCM655R0_TS_005_TCASE_003(void)
+{
+	Luint8 u8Test;
+	Luint8 u8Counter;
+	Luint8 u8Task;
+	Lfloat32 f32Load;
+	char cText[200];
+
+	DEBUG_PRINT("START:LCCM655R0.TS.005.TCASE.003\r\n");
+
+	u8Test = 1U;
+	vTS005__Reset();
+	vTS005__Add_All(C_FCU__SCHED__PHASE_AUTO);
+
+	//worst background pass from the pod
+	vFCU_SCHED__Set_ExecMax_us((Luint8)sTS005.s16Index[C_TS005__BACKGROUND], 500U);
+	vFCU_SCHED__Replay(1000U);
+
+	for(u8Counter = 0U; u8Counter < 6U; u8Counter++)
+	{
+		u8Task = (Luint8)sTS005.s16Index[u8Counter];
+		if((u32FCU_SCHED__Get_ReplayMisses(u8Task) != 0U) || (u32FCU_SCHED__Get_ReplayResponse_us(u8Task) < 20U) ||
+			(u32FCU_SCHED__Get_ReplayResponse_us(u8Task) > (500U + 20U)))
+		{
+			sprintf(cText, "FAIL: task %u response %u us misses %u\r\n", (unsigned int)u8Counter,
+					(unsigned int)u32FCU_SCHED__Get_ReplayResponse_us(u8Task), (unsigned int)u32FCU_SCHED__Get_ReplayMisses(u8Task));
+			DEBUG_PRINT(cText);
+			u8Test = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	//3 x 100 + 3 x 10 runs of 20us in a second
+	f32Load = f32FCU_SCHED__Get_ReplayLoad();
+	if((f32Load < 0.0065F) || (f32Load > 0.0067F) || (sFCU.sSched.sReplay.u32Misses != 0U))
+	{
+		DEBUG_PRINT("FAIL: replay load\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//12ms background, the 10ms tasks can't keep up but the 100ms ones can
+	vFCU_SCHED__Set_ExecMax_us((Luint8)sTS005.s16Index[C_TS005__BACKGROUND], 12000U);
+	vFCU_SCHED__Replay(1000U);
+	if((u32FCU_SCHED__Get_ReplayMisses((Luint8)sTS005.s16Index[0]) == 0U) ||
+		(u32FCU_SCHED__Get_ReplayMisses((Luint8)sTS005.s16Index[3]) != 0U) ||
+		(u32FCU_SCHED__Get_ReplayResponse_us((Luint8)sTS005.s16Index[3]) <= 10000U))
+	{
+		DEBUG_PRINT("FAIL: long background not seen\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//never called
+	for(u8Counter = 0U; u8Counter < C_TS005__NUM_TASKS; u8Counter++)
+	{
+		if(sTS005.u32Calls[u8Counter] != 0U)
+		{
+			DEBUG_PRINT("FAIL: replay called a task\r\n");
+			u8Test = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	if(u8Test == 1U)
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.005.TCASE.003\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.005.TCASE.003\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.005.TCASE.003\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.005.TCASE.004
+ * @st_test_desc
+ * The FCU table with every subsystem task in: with each at its budget the replay
+ * fits each slot and a second of main loop has no overrun and nothing late.
+ * The main state machine one us over its budget is caught on every run and
+ * raises TASK_OVERRUN while the others stay clean, and a pass longer than a
+ * slot makes it late and starves the 10ms group behind it.
+ *
+*/
+void vLCCM655R0_TS_005_TCASE_004(void)
+{
+	Luint8 u8Test;
+	Luint8 u8Counter;
+	Luint8 u8Task;
+	Luint32 u32Expect;
+	char cText[200];
+
+	DEBUG_PRINT("START:LCCM655R0.TS.005.TCASE.004\r\n");
+
+	u8Test = 1U;
+	vTS005__Reset();
+	vTS005__Add_FCU();
+
+	//budgets in the same slot can't add up past it
+	vFCU_SCHED__Replay(1000U);
+	if((u32FCU_SCHED__Get_ReplayPeak_us() >= 1000U) || (sFCU.sSched.sReplay.u32Misses != 0U))
+	{
+		sprintf(cText, "FAIL: FCU table peak %u us misses %u\r\n", (unsigned int)u32FCU_SCHED__Get_ReplayPeak_us(), (unsigned int)sFCU.sSched.sReplay.u32Misses);
+		DEBUG_PRINT(cText);
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//every task takes its whole budget
+	vFCU_SCHED__Start();
+	vTS005__Run_ms(1000U);
+	vTS005__Print_Stats();
+
+	for(u8Counter = 0U; u8Counter < C_TS005__NUM_TASKS; u8Counter++)
+	{
+		if(sTS005.s16Index[u8Counter] >= 0)
+		{
+			u8Task = (Luint8)sTS005.s16Index[u8Counter];
+			u32Expect = 1000U / (Luint32)sFCU.sSched.sTask[u8Task].u16Period_ms;
+
+			if((u32FCU_SCHED__Get_Runs(u8Task) != u32Expect) || (u32FCU_SCHED__Get_Late(u8Task) != 0U) ||
+				(u32FCU_SCHED__Get_Overruns(u8Task) != 0U))
+			{
+				sprintf(cText, "FAIL: task %u runs %u late %u over %u\r\n", (unsigned int)u8Counter, (unsigned int)u32FCU_SCHED__Get_Runs(u8Task),
+						(unsigned int)u32FCU_SCHED__Get_Late(u8Task), (unsigned int)u32FCU_SCHED__Get_Overruns(u8Task));
+				DEBUG_PRINT(cText);
+				u8Test = 0U;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		else
+		{
+			//not added
+		}
+	}
+
+	if(((u32FCU_FAULTS__Get_FaultFlags() & C_LCCM655__CORE__FAULT_INDEX_MASK__02) != 0U) || (sFCU.sSched.u32SlotsDropped != 0U))
+	{
+		DEBUG_PRINT("FAIL: overrun at budget\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//main state machine 1us over
+	vFCU_SCHED__Clear_Stats();
+	sTS005.u32Cost_us[C_TS005__MAINSM] = C_FCU__SCHED__BUDGET_US__MAINSM + 1U;
+	vTS005__Run_ms(100U);
+	vTS005__Print_Stats();
+
+	u8Task = (Luint8)sTS005.s16Index[C_TS005__MAINSM];
+	if((u32FCU_SCHED__Get_Runs(u8Task) == 0U) || (u32FCU_SCHED__Get_Overruns(u8Task) != u32FCU_SCHED__Get_Runs(u8Task)) ||
+		(u32FCU_SCHED__Get_ExecMax_us(u8Task) != (C_FCU__SCHED__BUDGET_US__MAINSM + 1U)) ||
+		((u32FCU_FAULTS__Get_FaultFlags() & C_LCCM655__CORE__FAULT_INDEX_MASK__02) == 0U))
+	{
+		sprintf(cText, "FAIL: main SM runs %u over %u\r\n", (unsigned int)u32FCU_SCHED__Get_Runs(u8Task), (unsigned int)u32FCU_SCHED__Get_Overruns(u8Task));
+		DEBUG_PRINT(cText);
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//the one overrun is put down to the right task
+	for(u8Counter = 0U; u8Counter < C_TS005__NUM_TASKS; u8Counter++)
+	{
+		if((sTS005.s16Index[u8Counter] >= 0) && (u8Counter != C_TS005__MAINSM))
+		{
+			if(u32FCU_SCHED__Get_Overruns((Luint8)sTS005.s16Index[u8Counter]) != 0U)
+			{
+				sprintf(cText, "FAIL: task %u overrun\r\n", (unsigned int)u8Counter);
+				DEBUG_PRINT(cText);
+				u8Test = 0U;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	//longer than a slot, it can't keep up and the 10ms group never gets in
+	vFCU_SCHED__Clear_Stats();
+	sTS005.u32Cost_us[C_TS005__MAINSM] = 1500U;
+	vTS005__Run_ms(100U);
+	vTS005__Print_Stats();
+	if((u32FCU_SCHED__Get_Late((Luint8)sTS005.s16Index[C_TS005__MAINSM]) == 0U) || (u32FCU_SCHED__Get_Late((Luint8)sTS005.s16Index[C_TS005__PUSHER]) == 0U))
+	{
+		DEBUG_PRINT("FAIL: long pass not seen\r\n");
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(u8Test == 1U)
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.005.TCASE.004\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.005.TCASE.004\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.005.TCASE.004\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM655R0.TS.005.TCASE.005
+ * @st_test_desc
+ * A 10ms module timer inside a 1ms task fires once every 10 slots. After a
+ * 35ms stall it fires once, not for every period it missed, and is next due
+ * a period from then.
+ *
+*/
+void vLCCM655R0_TS_005_TCASE_005(void)
+{
+	Luint8 u8Test;
+	char cText[200];
+
+	DEBUG_PRINT("START:LCCM655R0.TS.005.TCASE.005\r\n");
+
+	u8Test = 1U;
+	vTS005__Reset();
+	sTS005.u32TimerFires = 0U;
+	sTS005.s16Index[0] = s16FCU_SCHED__Add(&vTS005__Timer_Task, 1U, 0U, C_FCU__SCHED__PRIO__1MS, 0U);
+	vFCU_SCHED__Start();
+	sTS005.u32TimerDue_ms = u32FCU_SCHED__Get_Now_ms();
+
+	vTS005__Run_ms(100U);
+	if(sTS005.u32TimerFires != 10U)
+	{
+		sprintf(cText, "FAIL: timer fired %u in 100ms\r\n", (unsigned int)sTS005.u32TimerFires);
+		DEBUG_PRINT(cText);
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//stall, one pass picks it up
+	sTS005.u32Ticks += 35U * C_LOCALDEF__LCCM655__SCHED__TICKS_PER_MS;
+	vFCU_SCHED__Process();
+	if((sTS005.u32TimerFires != 11U) || (sTS005.u32TimerDue_ms != (u32FCU_SCHED__Get_Now_ms() + 10U)))
+	{
+		sprintf(cText, "FAIL: after stall fired %u due %u now %u\r\n", (unsigned int)sTS005.u32TimerFires,
+				(unsigned int)sTS005.u32TimerDue_ms, (unsigned int)u32FCU_SCHED__Get_Now_ms());
+		DEBUG_PRINT(cText);
+		u8Test = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(u8Test == 1U)
+	{
+		DEBUG_PRINT("PASS:LCCM655R0.TS.005.TCASE.005\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM655R0.TS.005.TCASE.005\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM655R0.TS.005.TCASE.005\r\n");
+}
+
+/***************************************************************************//**
+ * @brief
+ * Sim clock for M_LOCALDEF__LCCM655__SCHED__TICKS()
+ *
+ * @return			Ticks
+ */
+Luint32 u32LCCM655R0_TS_005__Ticks(void)
+{
+	return sTS005.u32Ticks;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Empty table and fault flags, clock part way to its wrap
+ */
+static void vTS005__Reset(void)
+{
+	Luint8 u8Counter;
+
+	sTS005.u32Ticks = 0xFFFFFFFFU - (500U * C_LOCALDEF__LCCM655__SCHED__TICKS_PER_MS);
+	for(u8Counter = 0U; u8Counter < C_TS005__NUM_TASKS; u8Counter++)
+	{
+		sTS005.u32Cost_us[u8Counter] = 15U;
+		sTS005.u32Calls[u8Counter] = 0U;
+		sTS005.s16Index[u8Counter] = -1;
+	}
+
+	vFCU_FAULTS__Init();
+	vFCU_SCHED__Init();
+}
+
+/***************************************************************************//**
+ * @brief
+ * Background first, then the 10ms and 100ms groups with 20us budgets
+ *
+ * @param[in]		u16Phase_ms				Phase for every timed task
+ */
+static void vTS005__Add_All(Luint16 u16Phase_ms)
+{
+	sTS005.s16Index[C_TS005__BACKGROUND] = s16FCU_SCHED__Add(&vTS005__Task_6, 0U, 0U, C_FCU__SCHED__PRIO__BACKGROUND, 0U);
+	sTS005.s16Index[0] = s16FCU_SCHED__Add(&vTS005__Task_0, 10U, u16Phase_ms, C_FCU__SCHED__PRIO__10MS, 20U);
+	sTS005.s16Index[1] = s16FCU_SCHED__Add(&vTS005__Task_1, 10U, u16Phase_ms, C_FCU__SCHED__PRIO__10MS, 20U);
+	sTS005.s16Index[2] = s16FCU_SCHED__Add(&vTS005__Task_2, 10U, u16Phase_ms, C_FCU__SCHED__PRIO__10MS, 20U);
+	sTS005.s16Index[3] = s16FCU_SCHED__Add(&vTS005__Task_3, 100U, u16Phase_ms, C_FCU__SCHED__PRIO__100MS, 20U);
+	sTS005.s16Index[4] = s16FCU_SCHED__Add(&vTS005__Task_4, 100U, u16Phase_ms, C_FCU__SCHED__PRIO__100MS, 20U);
+	sTS005.s16Index[5] = s16FCU_SCHED__Add(&vTS005__Task_5, 100U, u16Phase_ms, C_FCU__SCHED__PRIO__100MS, 20U);
+}
+
+/***************************************************************************//**
+ * @brief
+ * The table as vFCU__Process() then vFCU_MAINSM__Process() add it, with every
+ * subsystem on and each task costing its budget
+ */
+static void vTS005__Add_FCU(void)
+{
+	Luint8 u8Counter;
+
+	sTS005.s16Index[C_TS005__ADC] = s16FCU_SCHED__Add(&vTS005__Task_7, C_FCU__SCHED__PERIOD_MS__ADC, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__ADC);
+	sTS005.s16Index[C_TS005__NET] = s16FCU_SCHED__Add(&vTS005__Task_8, C_FCU__SCHED__PERIOD_MS__NET, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__NET);
+	sTS005.s16Index[C_TS005__MAINSM] = s16FCU_SCHED__Add(&vTS005__Task_9, C_FCU__SCHED__PERIOD_MS__MAINSM, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__MAINSM);
+	sTS005.s16Index[C_TS005__PARAMSHADOW] = s16FCU_SCHED__Add(&vTS005__Task_10, C_FCU__SCHED__PERIOD_MS__PARAMSHADOW, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__10MS, C_FCU__SCHED__BUDGET_US__PARAMSHADOW);
+	sTS005.s16Index[C_TS005__SC16] = s16FCU_SCHED__Add(&vTS005__Task_11, C_FCU__SCHED__PERIOD_MS__SC16, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__SC16);
+	sTS005.s16Index[C_TS005__ASI] = s16FCU_SCHED__Add(&vTS005__Task_12, C_FCU__SCHED__PERIOD_MS__ASI, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__ASI);
+	sTS005.s16Index[C_TS005__LASEROPTO] = s16FCU_SCHED__Add(&vTS005__Task_13, C_FCU__SCHED__PERIOD_MS__LASEROPTO, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__LASEROPTO);
+	sTS005.s16Index[C_TS005__LASERCONT] = s16FCU_SCHED__Add(&vTS005__Task_14, C_FCU__SCHED__PERIOD_MS__LASERCONT, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__LASERCONT);
+	sTS005.s16Index[C_TS005__LASERDIST] = s16FCU_SCHED__Add(&vTS005__Task_15, C_FCU__SCHED__PERIOD_MS__LASERDIST, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__LASERDIST);
+	sTS005.s16Index[C_TS005__BRAKES] = s16FCU_SCHED__Add(&vTS005__Task_16, C_FCU__SCHED__PERIOD_MS__BRAKES, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__BRAKES);
+	sTS005.s16Index[C_TS005__ACCEL] = s16FCU_SCHED__Add(&vTS005__Task_17, C_FCU__SCHED__PERIOD_MS__ACCEL, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__ACCEL);
+	sTS005.s16Index[C_TS005__PICOMMS] = s16FCU_SCHED__Add(&vTS005__Task_18, C_FCU__SCHED__PERIOD_MS__PICOMMS, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__PICOMMS);
+	sTS005.s16Index[C_TS005__FLIGHTCTL] = s16FCU_SCHED__Add(&vTS005__Task_19, C_FCU__SCHED__PERIOD_MS__FLIGHTCTL, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__FLIGHTCTL);
+	sTS005.s16Index[C_TS005__AMC7812] = s16FCU_SCHED__Add(&vTS005__Task_20, C_FCU__SCHED__PERIOD_MS__AMC7812, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__AMC7812);
+	sTS005.s16Index[C_TS005__THROTTLE] = s16FCU_SCHED__Add(&vTS005__Task_21, C_FCU__SCHED__PERIOD_MS__THROTTLE, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__10MS, C_FCU__SCHED__BUDGET_US__THROTTLE);
+	sTS005.s16Index[C_TS005__PUSHER] = s16FCU_SCHED__Add(&vTS005__Task_22, C_FCU__SCHED__PERIOD_MS__PUSHER, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__10MS, C_FCU__SCHED__BUDGET_US__PUSHER);
+
+	for(u8Counter = 0U; u8Counter < C_TS005__NUM_TASKS; u8Counter++)
+	{
+		if(sTS005.s16Index[u8Counter] >= 0)
+		{
+			sTS005.u32Cost_us[u8Counter] = sFCU.sSched.sTask[sTS005.s16Index[u8Counter]].u32Budget_us;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Spin the main loop
+ *
+ * @param[in]		u32Length_ms			Sim time
+ */
+static void vTS005__Run_ms(Luint32 u32Length_ms)
+{
+	Luint32 u32Start;
+
+	u32Start = sTS005.u32Ticks;
+	while((sTS005.u32Ticks - u32Start) < (u32Length_ms * C_LOCALDEF__LCCM655__SCHED__TICKS_PER_MS))
+	{
+		vFCU_SCHED__Process();
+		sTS005.u32Ticks += C_TS005__LOOP_TICKS;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * A task taking its set time on the sim clock
+ *
+ * @param[in]		u8Task					Sim task
+ */
+static void vTS005__Task(Luint8 u8Task)
+{
+	sTS005.u32Calls[u8Task]++;
+	sTS005.u32Ticks += sTS005.u32Cost_us[u8Task] * C_TS005__TICKS_PER_US;
+}
+
+static void vTS005__Task_0(void)
+{
+	vTS005__Task(0U);
+}
+
+static void vTS005__Task_1(void)
+{
+	vTS005__Task(1U);
+}
+
+static void vTS005__Task_2(void)
+{
+	vTS005__Task(2U);
+}
+
+static void vTS005__Task_3(void)
+{
+	vTS005__Task(3U);
+}
+
+static void vTS005__Task_4(void)
+{
+	vTS005__Task(4U);
+}
+
+static void vTS005__Task_5(void)
+{
+	vTS005__Task(5U);
+}
+
+static void vTS005__Task_6(void)
+{
+	vTS005__Task(C_TS005__BACKGROUND);
+}
+
+static void vTS005__Task_7(void)
+{
+	vTS005__Task(C_TS005__ADC);
+}
+
+static void vTS005__Task_8(void)
+{
+	vTS005__Task(C_TS005__NET);
+}
+
+static void vTS005__Task_9(void)
+{
+	vTS005__Task(C_TS005__MAINSM);
+}
+
+static void vTS005__Task_10(void)
+{
+	vTS005__Task(C_TS005__PARAMSHADOW);
+}
+
+static void vTS005__Task_11(void)
+{
+	vTS005__Task(C_TS005__SC16);
+}
+
+static void vTS005__Task_12(void)
+{
+	vTS005__Task(C_TS005__ASI);
+}
+
+static void vTS005__Task_13(void)
+{
+	vTS005__Task(C_TS005__LASEROPTO);
+}
+
+static void vTS005__Task_14(void)
+{
+	vTS005__Task(C_TS005__LASERCONT);
+}
+
+static void vTS005__Task_15(void)
+{
+	vTS005__Task(C_TS005__LASERDIST);
+}
+
+static void vTS005__Task_16(void)
+{
+	vTS005__Task(C_TS005__BRAKES);
+}
+
+static void vTS005__Task_17(void)
+{
+	vTS005__Task(C_TS005__ACCEL);
+}
+
+static void vTS005__Task_18(void)
+{
+	vTS005__Task(C_TS005__PICOMMS);
+}
+
+static void vTS005__Task_19(void)
+{
+	vTS005__Task(C_TS005__FLIGHTCTL);
+}
+
+static void vTS005__Task_20(void)
+{
+	vTS005__Task(C_TS005__AMC7812);
+}
+
+static void vTS005__Task_21(void)
+{
+	vTS005__Task(C_TS005__THROTTLE);
+}
+
+static void vTS005__Task_22(void)
+{
+	vTS005__Task(C_TS005__PUSHER);
+}
+
+/***************************************************************************//**
+ * @brief
+ * A 1ms task with a 10ms timer in it, the way the modules use one
+ */
+static void vTS005__Timer_Task(void)
+{
+	if(u8FCU_SCHED__Timer_Due(&sTS005.u32TimerDue_ms, 10U) == 1U)
+	{
+		sTS005.u32TimerFires++;
+	}
+	else
+	{
+		//not yet
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Per task stats, the ones in the table
+ */
+static void vTS005__Print_Stats(void)
+{
+	Luint8 u8Counter;
+	Luint8 u8Task;
+	char cText[200];
+
+	for(u8Counter = 0U; u8Counter < C_TS005__NUM_TASKS; u8Counter++)
+	{
+		if(sTS005.s16Index[u8Counter] >= 0)
+		{
+			u8Task = (Luint8)sTS005.s16Index[u8Counter];
+			sprintf(cText, "INFO: task %u phase %u runs %u late %u over %u exec max %u us delay max %u ms\r\n",
+					(unsigned int)u8Counter, (unsigned int)u16FCU_SCHED__Get_Phase_ms(u8Task),
+					(unsigned int)u32FCU_SCHED__Get_Runs(u8Task), (unsigned int)u32FCU_SCHED__Get_Late(u8Task),
+					(unsigned int)u32FCU_SCHED__Get_Overruns(u8Task), (unsigned int)u32FCU_SCHED__Get_ExecMax_us(u8Task),
+					(unsigned int)sFCU.sSched.sTask[u8Task].sStats.u32Delay_Max_ms);
+			DEBUG_PRINT(cText);
+		}
+		else
+		{
+			//not added
+		}
+	}
+}
+
+#endif //C_LOCALDEF__LCCM655__ENABLE_TEST_SPEC
+#endif //C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
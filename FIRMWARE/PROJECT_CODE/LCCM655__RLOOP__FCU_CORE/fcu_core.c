@@ -44,6 +44,9 @@ void vFCU__Init(void)
 	//setup the fault flags
 	vFCU_FAULTS__Init();
 
+	//empty task table, the modules go in once they are up
+	vFCU_SCHED__Init();
+
 }
 
 
@@ -62,8 +65,8 @@ void vFCU__Process(void)
 	if(sFCU.u32Guard1 != 0xAABBCCDDU)
 	{
 		//guarding error fault
-		vFAULTTREE__Set_Flag(&sFCU.sFaults.sTopLevel, C_LCCM655__CORE__FAULT_INDEX__00);
-		vFAULTTREE__Set_Flag(&sFCU.sFaults.sTopLevel, C_LCCM655__CORE__FAULT_INDEX__01);
+		vFAULTLINK__Set_Flag(&sFCU.sFaults.sTopLevel, C_LCCM655__CORE__FAULT_INDEX__00);
+		vFAULTLINK__Set_Flag(&sFCU.sFaults.sTopLevel, C_LCCM655__CORE__FAULT_INDEX__01);
 	}
 	else
 	{
@@ -73,8 +76,8 @@ void vFCU__Process(void)
 	if(sFCU.u32Guard2 != 0x12345678U)
 	{
 		//guarding error fault
-		vFAULTTREE__Set_Flag(&sFCU.sFaults.sTopLevel, C_LCCM655__CORE__FAULT_INDEX__00);
-		vFAULTTREE__Set_Flag(&sFCU.sFaults.sTopLevel, C_LCCM655__CORE__FAULT_INDEX__01);
+		vFAULTLINK__Set_Flag(&sFCU.sFaults.sTopLevel, C_LCCM655__CORE__FAULT_INDEX__00);
+		vFAULTLINK__Set_Flag(&sFCU.sFaults.sTopLevel, C_LCCM655__CORE__FAULT_INDEX__01);
 	}
 	else
 	{
@@ -98,6 +101,9 @@ void vFCU__Process(void)
 			//init the EEPROM Params
 			vEEPARAM__Init();
 
+			//load the parameter image into RAM, before anything reads a parameter
+			vPARAMSHADOW__Init();
+
 #ifndef WIN32
 			//init the DMA
 			vRM4_DMA__Init();
@@ -108,6 +114,7 @@ void vFCU__Process(void)
 			//Setup the ADC
 			vRM4_ADC_USER__Init();
 #endif
+
 			//CPU load monitoring
 			vRM4_CPULOAD__Init();
 
@@ -292,6 +299,11 @@ void vFCU__Process(void)
 				vSC16_INT__Enable_Rx_DataAvalibleInterupt(u8Counter, 1U);
 			}
 
+			//the ASI controllers run faster than the default to keep the poll cycle short
+			#if C_LOCALDEF__LCCM655__ENABLE_ASI_RS485 == 1U
+				vSC16_BAUD__Set_BaudRate(C_LOCALDEF__LCCM655__ASI_SC16_INDEX, 1U, C_LOCALDEF__LCCM655__ASI_BAUD, 1U);
+			#endif
+
 			//todo:
 			//setup the baud for the lasers only
 
@@ -311,6 +323,19 @@ void vFCU__Process(void)
 			//get our main SM operational
 			vFCU_MAINSM__Init();
 
+			//the main loop work, every slot with a budget so an overrun is caught.
+			//The subsystems go in from the main state machine once they are up.
+#ifndef WIN32
+			(void)s16FCU_SCHED__Add(&vRM4_ADC_USER__Process, C_FCU__SCHED__PERIOD_MS__ADC, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__ADC);
+#endif //WIN32
+			#if C_LOCALDEF__LCCM655__ENABLE_ETHERNET == 1U
+				(void)s16FCU_SCHED__Add(&vFCU_NET__Process, C_FCU__SCHED__PERIOD_MS__NET, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__NET);
+			#endif
+			(void)s16FCU_SCHED__Add(&vFCU_MAINSM__Process, C_FCU__SCHED__PERIOD_MS__MAINSM, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__1MS, C_FCU__SCHED__BUDGET_US__MAINSM);
+
+			//commits wait for a quiet spell, the slot with the least in it
+			(void)s16FCU_SCHED__Add(&vPARAMSHADOW__Process, C_FCU__SCHED__PERIOD_MS__PARAMSHADOW, C_FCU__SCHED__PHASE_AUTO, C_FCU__SCHED__PRIO__10MS, C_FCU__SCHED__BUDGET_US__PARAMSHADOW);
+
 			sFCU.eInitStates = INIT_STATE__START_TIMERS;
 			break;
 
@@ -321,11 +346,8 @@ void vFCU__Process(void)
 			//int the RTI
 			vRM4_RTI__Init();
 
-			//start the relevant RTI interrupts going.
-			//100ms timer
-			vRTI_COMPARE__Enable_CompareInterrupt(0U);
-			//10ms timer
-			vRTI_COMPARE__Enable_CompareInterrupt(1U);
+			//start the relevant RTI interrupts going, the 10ms and 100ms work is
+			//timed by the scheduler off counter 1
 			//10uS timer for the stepper system
 			vRTI_COMPARE__Enable_CompareInterrupt(2U);
 
@@ -337,6 +359,8 @@ void vFCU__Process(void)
 			vRM4_RTI__Start_Counter(1U);
 #endif //WIN32
 
+			//first slot from here, the counter is running
+			vFCU_SCHED__Start();
 
 			//move state
 			sFCU.eInitStates = INIT_STATE__RUN;
@@ -350,18 +374,8 @@ void vFCU__Process(void)
 			//start of while entry point
 			vRM4_CPULOAD__While_Entry();
 
-#ifndef WIN32
-			//Handle the ADC conversions
-			vRM4_ADC_USER__Process();
-#endif //WIN32
-
-			//process networking
-			#if C_LOCALDEF__LCCM655__ENABLE_ETHERNET == 1U
-				vFCU_NET__Process();
-			#endif
-
-			//process the main state machine
-			vFCU_MAINSM__Process();
+			//everything that is due, most urgent first
+			vFCU_SCHED__Process();
 
 			//end of while loop
 			vRM4_CPULOAD__While_Exit();
@@ -372,50 +386,6 @@ void vFCU__Process(void)
 
 }
 
-/***************************************************************************//**
- * @brief
- * 100ms timer
- * 
- * @st_funcMD5		29FA796863975C61E514D3ED94ED79CA
- * @st_funcID		LCCM655R0.FILE.000.FUNC.003
- */
-void vFCU__RTI_100MS_ISR(void)
-{
-	#if C_LOCALDEF__LCCM655__ENABLE_PI_COMMS == 1U
-		vFCU_PICOMMS__100MS_ISR();
-	#endif
-	#if C_LOCALDEF__LCCM655__ENABLE_LASER_OPTONCDT == 1U
-		vFCU_LASEROPTO__100MS_ISR();
-	#endif
-	#if C_LOCALDEF__LCCM655__ENABLE_LASER_DISTANCE == 1U
-		vFCU_LASERDIST__100MS_ISR();
-	#endif
-	#if C_LOCALDEF__LCCM655__ENABLE_ETHERNET == 1U
-		vFCU_NET_SPACEX_TX__100MS_ISR();
-	#endif
-}
-
-
-/***************************************************************************//**
- * @brief
- * 10ms timer
- * 
- * @st_funcMD5		132920CE083F2C05C9100CBC35DA7876
- * @st_funcID		LCCM655R0.FILE.000.FUNC.004
- */
-void vFCU__RTI_10MS_ISR(void)
-{
-
-	#if C_LOCALDEF__LCCM655__ENABLE_ETHERNET == 1U
-		vFCU_NET_TX__10MS_ISR();
-	#endif
-
-	#if C_LOCALDEF__LCCM655__ENABLE_PUSHER == 1U
-		//tell the pusher interface about us.
-		vFCU_PUSHER__10MS_ISR();
-	#endif
-}
-
 #endif //#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
 //safetys
 #ifndef C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
@@ -22,20 +22,31 @@
 		#include <LCCM655__RLOOP__FCU_CORE/fcu_core__fault_flags.h>
 		#include <LCCM655__RLOOP__FCU_CORE/BRAKES/fcu__brakes__fault_flags.h>
 		#include <LCCM655__RLOOP__FCU_CORE/ACCELEROMETERS/fcu__accel__fault_flags.h>
+		#include <LCCM655__RLOOP__FCU_CORE/FLIGHT_CONTROLLER/LASER_ORIENTATION/fcu__laser_orientation__fault_flags.h>
+		#include <LCCM655__RLOOP__FCU_CORE/LASER_CONTRAST/fcu__laser_cont__fault_flags.h>
 
 		#include <LCCM655__RLOOP__FCU_CORE/ASI_RS485/fcu__asi_defines.h>
 		#include <LCCM655__RLOOP__FCU_CORE/ASI_RS485/fcu__asi_types.h>
 
 		#include <LCCM655__RLOOP__FCU_CORE/NETWORKING/fcu_core__net__packet_types.h>
 
-		//for software fault tree handling
-		#include <MULTICORE/LCCM284__MULTICORE__FAULT_TREE/fault_tree__public.h>
+		//for software fault tree handling, linked under the top level
+		#include <LCCM671__RLOOP__FAULT_LINK/fault_link.h>
+
+		//calibration and brake parameters, held in RAM and committed in the background
+		#include <LCCM672__RLOOP__PARAM_SHADOW/param_shadow.h>
+
+		//brake lead screw moves, aborted from the limit switches
+		#include <LCCM673__RLOOP__STEP_SCURVE/step_scurve.h>
 
 		/*******************************************************************************
 		Defines
 		*******************************************************************************/
 		#define C_MLP__MAX_AVERAGE_SIZE				(8U)
 
+		/** Brake stepper jerk limit as a multiple of the accel limit, full accel in 1/20s */
+		#define C_FCU__BRAKES__STEP_JERK_RATIO		(20)
+
 
 		// number of ASI commands waiting in queue
 		#define C_ASI__COMMAND_QUEUE				(8)
@@ -43,6 +54,25 @@
 		// max modbus frame size
 		#define C_ASI__MAX_FRAME_SIZE				(256)
 
+		// ASI controllers on the bus, modbus addresses 1 to N
+		#define C_ASI__NUM_CONTROLLERS				(8U)
+
+		// blocks of registers on the poll schedule
+		#define C_ASI__MAX_POLL_BLOCKS				(8U)
+
+		// unwanted registers that can be read to join two reads into one,
+		// each costs 2 chars against ~20 chars and the slave latency for a request
+		#define C_ASI__COALESCE_GAP					(8U)
+
+		// end of request to first reply byte
+		#define C_ASI__RESPONSE_TIMEOUT_US			(5000U)
+
+		// quiet time after a broadcast so the slaves can act on it
+		#define C_ASI__TURNAROUND_US				(20000U)
+
+		// times a queued command is sent before it is dropped
+		#define C_ASI__COMMAND_RETRIES				(3U)
+
 		/*******************************************************************************
 		Structures
 		*******************************************************************************/
@@ -68,11 +98,28 @@
 			struct
 			{
 				/** top level fault tree subsystem for the flight controller */
-				FAULT_TREE__PUBLIC_T sTopLevel;
+				FAULTLINK__NODE_T sTopLevel;
 
 				/** Accel subsystem faults */
-				FAULT_TREE__PUBLIC_T sAccel;
+				FAULTLINK__NODE_T sAccel;
 
+				#if C_LOCALDEF__LCCM655__ENABLE_ETHERNET == 1U
+				#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+				/** Fault journal streaming to the ground station */
+				struct
+				{
+					/** Next journal sequence to send */
+					Luint32 u32TxSequence;
+
+					/** 1 = send new entries as they are logged */
+					Luint8 u8Streaming;
+
+					/** 1 = the host asked for a replay, send until we catch up */
+					Luint8 u8Replay;
+
+				}sJournalTx;
+				#endif
+				#endif
 
 			}sFaults;
 
@@ -127,8 +174,13 @@
 					/** Percent of braking from 0.0 to 100.0*/
 					Lfloat32 f32BrakePosition_Percent;
 
-					/** Average Counter	for MLP filter function				 */
-					Luint16 u16AverageCounter;
+					#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+						/** Running sum average for MLP filter function	 */
+						STREAMFILT__MAVG_U16_T sFilter;
+					#else
+						/** Average Counter	for MLP filter function			 */
+						Luint16 u16AverageCounter;
+					#endif
 
 					/** Average Array for MLP filter function				 */
 					Luint16 u16AverageArray[C_MLP__MAX_AVERAGE_SIZE];
@@ -186,7 +238,7 @@
 
 
 				/** individual brake fault flags */
-				FAULT_TREE__PUBLIC_T sFaultFlags;
+				FAULTLINK__NODE_T sFaultFlags;
 
 				Luint8 u8BrakeSWErr;
 
@@ -206,6 +258,11 @@
 					/** Last sample of the G-Force*/
 					Lfloat32 f32LastG[3];
 
+					#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+						/** Our place in the burst sample ring */
+						Luint32 u32SampleCursor;
+					#endif
+
 				}sChannels[C_LOCALDEF__LCCM418__NUM_DEVICES];
 
 			}sAccel;
@@ -217,8 +274,25 @@
 				//the current state
 				E_FCU_PICOM__STATE_T eState;
 
-				/** 100ms timer tick */
-				Luint8 u8100MS_Timer;
+				/** Next telemetry frame, scheduler ms */
+				Luint32 u32NextFrame_ms;
+
+				/** Precompiled param headers for our telemetry frame */
+				struct _strPICOMMS_TEMPLATE sTxTemplate;
+
+				/** Commands from the GS, written by the Pi comms receive table */
+				struct
+				{
+					/** Brakes I-Beam distance, mm */
+					Lfloat32 f32IBeamDist;
+
+					/** Per motor stepper settings */
+					Luint32 u32MicroSteps[2];
+					Lint32 s32MaxAccel[2];
+					Lint32 s32MicroRev[2];
+					Lint32 s32MaxVeloc[2];
+
+				}sRxCmd;
 
 			}sPiComms;
 
@@ -237,8 +311,8 @@
 
 
 
-				/** Timer of 10ms ticks used for switch state timing */
-				Luint32 u32SwtichTimer;
+				/** Scheduler ms at the last switch edge, for the settle time */
+				Luint32 u32SwitchEdge_ms;
 
 				/** Switch interfaces */
 				struct
@@ -265,8 +339,8 @@
 				/** state machine for processing the OptoNCDT systems */
 				E_FCU_OPTOLASER__STATE_T eOptoNCDTState;
 
-				/** A 100ms counter to wait until the lasers have powered up*/
-				Luint32 u32LaserPOR_Counter;
+				/** Scheduler ms at reset, to wait until the lasers have powered up */
+				Luint32 u32LaserPOR_ms;
 
 				/** The opto NCDT laser interfaces */
 				struct
@@ -303,8 +377,8 @@
 				/** RX byte state machine */
 				E_LASERDIST__RX_STATE_T eRxState;
 
-				/** A 100ms counter to wait until the lasers have powered up*/
-				Luint32 u32LaserPOR_Counter;
+				/** Scheduler ms at reset, to wait until the lasers have powered up */
+				Luint32 u32LaserPOR_ms;
 
 				/** A new packet is available for distance processing */
 				Luint8 u8NewPacket;
@@ -340,7 +414,57 @@
 					//Basically the vehicle is a static reference and we recalculate the orientation
 					//of the ground plane relative to the vehicle and the hover engines
 					Lfloat32 f32PlaneCoeffs[4]; //TODO: Check this size   // ordered as: A, B, C, D, decreasing polynomial terms
-					Lfloat32 f32TwistPlaneCoeffs[4]; //TODO: Check this size   // ordered as: A, B, C, D, decreasing polynomial terms // to be built with vCalculateGroundPlane() using the second laser triplet
+					Lfloat32 f32TwistPlaneCoeffs[4]; //TODO: Check this size   // ordered as: A, B, C, D, decreasing polynomial terms // fit through every ground laser but laser 0
+
+					/** f32PlaneCoeffs scaled to a unit normal, D is then the signed distance to the origin */
+					Lfloat32 f32PlaneNorm[4];
+
+					/** hover engine positions as {x, y, z, 1} rows, heights are one pass of dot products against f32PlaneNorm */
+					Lfloat32 f32EngineMatrix[C_FCU__NUM_HOVER_ENGINES][4];
+
+					/** float solution of the angles, checked against the fixed point answer */
+					struct
+					{
+						/** last float roll and pitch, radians x 10000 */
+						Lint16 s16FloatRoll;
+						Lint16 s16FloatPitch;
+
+						/** worst disagreement seen, radians x 10000 */
+						Luint16 u16WorstError;
+
+						/** number of solves that failed the check */
+						Luint32 u32Fails;
+
+					}sCrossCheck;
+
+					/** least squares ground plane, z = a + bx + cy through the laser ground points */
+					struct
+					{
+						/** per healthy laser mask, maps the ground point heights to {a, b, c} */
+						Lfloat32 f32Gain[C_FCU__LASER_ORIENT__NUM_FIT_MASKS][3][C_FCU__NUM_LASERS_GROUND];
+
+						/** per mask, maps the last {a, b, c} into the new one, zero unless the mask can't see both slopes */
+						Lfloat32 f32Prior[C_FCU__LASER_ORIENT__NUM_FIT_MASKS][3][3];
+
+						/** number of lasers in each mask */
+						Luint8 u8Count[C_FCU__LASER_ORIENT__NUM_FIT_MASKS];
+
+						/** last fit {a, b, c} */
+						Lfloat32 f32Coeffs[3];
+
+						/** ground point minus fit for each laser in the last fit, mm */
+						Lfloat32 f32Residual[C_FCU__NUM_LASERS_GROUND];
+
+						/** lasers used in the last fit */
+						Luint8 u8Mask;
+
+						/** times each laser has been thrown out as an outlier */
+						Luint32 u32Rejected[C_FCU__NUM_LASERS_GROUND];
+
+					}sFit;
+
+					/** orientation fault flags */
+					FAULTLINK__NODE_T sFaultFlags;
 
 					/** sub-structure for ground lasers and their measurements*/
 					struct
@@ -374,6 +498,19 @@
 					Luint8 u8Dummy;
 				#endif
 
+				#if C_LOCALDEF__LCCM655__ENABLE_FCTL_CONTRAST_NAV == 1U
+				/** Contrast sensor navigation */
+				struct
+				{
+					/** Distance of the FWD contrast sensor past the first stripe, mm */
+					Luint32 u32Position_mm;
+
+					/** Current velocity, mm/s */
+					Luint32 u32Veloc_mms;
+
+				}sContrastNav;
+				#endif
+
 			}sFlightControl;
 
 
@@ -395,24 +532,96 @@
 
 				}sSensors[LASER_CONT__MAX];
 
-				/** a timing based list to store the rising and falling edges of each laser */
+				/** Edge ring between the N2HET ISR and the main loop.
+				 * Head is only ever written by the ISR and tail only by
+				 * vFCU_LASERCONT_TL__Process() so no interlock is needed.
+				 * Both are free running and masked on use. */
 				struct
 				{
+					/** Edges in the order they arrived */
+					struct
+					{
+						/** RTI counter 1 at the edge */
+						Luint64 u64Time;
+
+						/** E_FCU__LASER_CONT_INDEX_T */
+						Luint8 u8Laser;
+
+						/** 1 = rising (start of a stripe), 0 = falling */
+						Luint8 u8Rising;
+
+					}sEdge[C_FCU__LASER_CONTRAST__RING_SIZE];
+
+					/** Next edge to write, owned by the ISR */
+					volatile Luint16 u16Head;
+
+					/** Next edge to read, owned by the main loop */
+					volatile Luint16 u16Tail;
+
+					/** Edges dropped because the ring was full, owned by the ISR */
+					volatile Luint32 u32Overflow;
+
+				}sRing;
+
+				/** Per sensor stripe tracking, built from the ring */
+				struct
+				{
+
+					/** Time of the last accepted stripe rising edge */
+					Luint64 u64LastRising;
 
-					/** Rising edge time stamp */
-					Luint64 u64RisingList[C_FCU__LASER_CONTRAST__MAX_STRIPES];
+					/** Time of the last falling edge */
+					Luint64 u64LastFalling;
 
-					/** Falling edge time stamp */
-					Luint64 u64FallingList[C_FCU__LASER_CONTRAST__MAX_STRIPES];
+					/** Time for one stripe pitch, 0 until two stripes are seen */
+					Luint32 u32Interval;
 
-					/** Rising edge count */
+					/** How long the last stripe was under the sensor */
+					Luint32 u32Width;
+
+					/** Index of the last stripe crossed, stripe 0 is the first
+					 * stripe any sensor saw */
+					Lint32 s32Stripe;
+
+					/** Speed over the last stripe interval, mm/s */
+					Luint32 u32Veloc_mms;
+
+					/** Rising edge count, accepted stripes only */
 					Luint16 u16RisingCount;
 
 					/** Falling edge count */
 					Luint16 u16FallingCount;
 
+					/** Edges thrown out as too early for any real stripe */
+					Luint32 u32Glitches;
+
+					/** Stripes we worked out were missed */
+					Luint32 u32Missed;
+
+					/** Intervals that fit no window, tracking restarted */
+					Luint32 u32Resync;
+
 				}sTimingList[LASER_CONT__MAX];
 
+				/** Fused velocity */
+				struct
+				{
+
+					/** Last velocity from a trailing sensor crossing the same
+					 * stripe as a sensor ahead of it, mm/s */
+					Luint32 u32Cross_mms;
+
+					/** Most recent velocity from either method, mm/s */
+					Luint32 u32Veloc_mms;
+
+					/** Number of cross sensor checks that failed */
+					Luint32 u32Mismatch;
+
+				}sVeloc;
+
+				/** Contrast sensor fault flags */
+				FAULTLINK__NODE_T sFaultFlags;
+
 				Luint32 u32Guard2;
 
 			}sContrast;
@@ -428,6 +637,11 @@
 				/** our locally assigned IP*/
 				Luint8 u8IPAddx[4];
 
+				#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+				/** PTP is started once the PHY is up */
+				Luint8 u8PTP_Running;
+				#endif
+
 			}sEthernet;
 
 
@@ -435,8 +649,8 @@
 			struct
 			{
 
-				/** A flag to indicate 10ms has elapsed if we are using timed packets */
-				Luint8 u810MS_Flag;
+				/** Next streaming packet, scheduler ms */
+				Luint32 u32NextStream_ms;
 
 				/** The next packet type to transmit */
 				E_FCU_NET_PACKET_TYPES eTxPacketType;
@@ -450,8 +664,11 @@
 			/** SpaceX required transmission */
 			struct
 			{
-				/** A flag to indicate 10ms has elapsed if we are using timed packets */
-				Luint8 u8100MS_Flag;
+				/** Next packet due, scheduler ms */
+				Luint32 u32Next_ms;
+
+				/** The last one is still to go */
+				Luint8 u8Pending;
 
 			}sSpaceX;
 
@@ -468,24 +685,191 @@
 				struct _strASICmd cmdQueue[C_ASI__COMMAND_QUEUE];
 
 				/** command queue head index*/
-				Lint8 qHead;
+				Luint8 qHead;
 
 				/** command queue tail index*/
-				Lint8 qTail;
-
-				/** a set of timers to control tx timeouts */
-				Luint64 timeout_3_5_char;
-				Luint64 timeout_1_5_char;
-				Luint64 timeout_response;
-				Luint64 timeout_turnaround;
-				Luint64 timer_3_5_char_start;
-				Luint64 timer_1_5_char_start;
-				Luint64 timer_response_start;
-				Luint64 timer_turnaround_start;
+				Luint8 qTail;
+
+				/** Modbus CRC16 byte table */
+				Luint16 u16CRCTable[256];
+
+				/** bus timing in M_LOCALDEF__LCCM655__ASI_TIMESTAMP() ticks */
+				Luint32 u32CharTicks;
+				Luint32 u32GapTicks;
+				Luint32 u32ResponseTicks;
+				Luint32 u32TurnaroundTicks;
+
+				/** end of the wait in the current state */
+				Luint64 u64Deadline;
+
+				/** when the bus is next free for us to transmit */
+				Luint64 u64BusFree;
+
+				/** when the last request finished leaving the UART */
+				Luint64 u64TxEnd;
+
+				/** when the last reply byte was seen */
+				Luint64 u64LastRx;
+
+				/** the transaction on the bus */
+				struct _strASIXfer sXfer;
+
+				/** the next transaction, built while the bus is busy */
+				struct _strASIXfer sNext;
+				Luint8 u8NextReady;
+
+				/** send sXfer again rather than sNext */
+				Luint8 u8Resend;
+
+				/** the reply */
+				struct
+				{
+					Luint8 u8Frame[C_ASI__MAX_FRAME_SIZE];
+					Luint8 u8Length;
+
+					/** bytes seen outside a reply */
+					Luint32 u32Stray;
+
+				}sRx;
+
+				/** telemetry poll schedule */
+				struct
+				{
+					struct _strASIPollBlock sBlock[C_ASI__MAX_POLL_BLOCKS];
+					Luint8 u8NumBlocks;
+
+					/** registers that can be read past to join two blocks */
+					Luint8 u8CoalesceGap;
+
+					/** where the next poll comes from */
+					Luint8 u8Block;
+					Luint8 u8Slave;
+					Luint32 u32Cycle;
+
+					/** the next poll staged starts a cycle */
+					Luint8 u8NewCycle;
+
+					/** start of the last cycle */
+					Luint64 u64CycleStart;
+
+					/** time for the last full pass of the schedule, ticks */
+					Luint32 u32Refresh_Last;
+					Luint32 u32Refresh_Max;
+
+					/** full passes done */
+					Luint32 u32Cycles;
+
+				}sPoll;
+
+				/** each controller */
+				struct _strASISlave sSlave[C_ASI__NUM_CONTROLLERS];
+
+				/** commands dropped after all retries */
+				Luint32 u32CommandsDropped;
 
 			}sASIComms;
 			#endif
 
+			/** Time triggered task scheduler, 1ms slots */
+			struct
+			{
+				/** The task table, in the order added */
+				struct
+				{
+					/** The module entry point */
+					void (*pFunc)(void);
+
+					/** Period, 0 = background, every pass */
+					Luint16 u16Period_ms;
+
+					/** First slot it is due in */
+					Luint16 u16Phase_ms;
+
+					Luint8 u8Priority;
+
+					/** Worst case, 0 = measured only */
+					Luint32 u32Budget_us;
+
+					/** Slot it is next due in */
+					Luint32 u32Next_ms;
+
+					/** Released and waiting to run */
+					Luint8 u8Pending;
+
+					struct
+					{
+						Luint32 u32Runs;
+
+						/** Ran over its budget */
+						Luint32 u32Overruns;
+
+						/** Due again before it got to run, one release lost */
+						Luint32 u32Late;
+
+						Luint32 u32Exec_Last_us;
+						Luint32 u32Exec_Max_us;
+						Luint64 u64Exec_Total_us;
+
+						/** Release to start, slots */
+						Luint32 u32Delay_Max_ms;
+
+					}sStats;
+
+					/** What vFCU_SCHED__Replay() found */
+					struct
+					{
+						Luint32 u32Next_ms;
+						Luint32 u32Release_us;
+						Luint8 u8Pending;
+
+						/** Release to finish, worst case */
+						Luint32 u32Response_Max_us;
+
+						/** Not done by the time it was due again */
+						Luint32 u32Misses;
+
+					}sReplay;
+
+				}sTask[C_FCU__SCHED__MAX_TASKS];
+
+				Luint8 u8NumTasks;
+
+				/** Task indexes by priority */
+				Luint8 u8Order[C_FCU__SCHED__MAX_TASKS];
+
+				/** Current slot */
+				Luint32 u32Now_ms;
+
+				/** Clock at the start of the current slot */
+				Luint32 u32SlotTicks;
+
+				/** Slots not run, we got too far behind */
+				Luint32 u32SlotsDropped;
+
+				/** Passes through vFCU_SCHED__Process() */
+				Luint32 u32Passes;
+
+				struct
+				{
+					Luint32 u32Length_ms;
+
+					/** Most budget released in one slot and where */
+					Luint32 u32PeakSlot_us;
+					Luint32 u32PeakSlot_ms;
+
+					/** Timed task time over the replay */
+					Luint64 u64Busy_us;
+
+					/** One background pass */
+					Luint32 u32Background_us;
+
+					/** Every task's misses */
+					Luint32 u32Misses;
+
+				}sReplay;
+
+			}sSched;
+
 			/** Structure guard 2*/
 			Luint32 u32Guard2;
 			
@@ -497,8 +881,30 @@
 		//core
 		DLL_DECLARATION void vFCU__Init(void);
 		DLL_DECLARATION void vFCU__Process(void);
-		void vFCU__RTI_100MS_ISR(void);
-		void vFCU__RTI_10MS_ISR(void);
+
+		//task scheduler
+		DLL_DECLARATION void vFCU_SCHED__Init(void);
+		Lint16 s16FCU_SCHED__Add(void (*pFunc)(void), Luint16 u16Period_ms, Luint16 u16Phase_ms, Luint8 u8Priority, Luint32 u32Budget_us);
+		void vFCU_SCHED__Start(void);
+		void vFCU_SCHED__Process(void);
+		DLL_DECLARATION void vFCU_SCHED__Clear_Stats(void);
+		DLL_DECLARATION Luint8 u8FCU_SCHED__Get_NumTasks(void);
+		DLL_DECLARATION Luint16 u16FCU_SCHED__Get_Phase_ms(Luint8 u8Task);
+		DLL_DECLARATION Luint32 u32FCU_SCHED__Get_Runs(Luint8 u8Task);
+		DLL_DECLARATION Luint32 u32FCU_SCHED__Get_Overruns(Luint8 u8Task);
+		DLL_DECLARATION Luint32 u32FCU_SCHED__Get_Late(Luint8 u8Task);
+		DLL_DECLARATION Luint32 u32FCU_SCHED__Get_ExecMax_us(Luint8 u8Task);
+		DLL_DECLARATION Lfloat32 f32FCU_SCHED__Get_ExecMean_us(Luint8 u8Task);
+		DLL_DECLARATION void vFCU_SCHED__Set_ExecMax_us(Luint8 u8Task, Luint32 u32Exec_us);
+		Luint32 u32FCU_SCHED__Get_Now_ms(void);
+		Luint8 u8FCU_SCHED__Timer_Due(Luint32 *pu32Due_ms, Luint16 u16Period_ms);
+
+		//timing analysis
+		DLL_DECLARATION void vFCU_SCHED__Replay(Luint32 u32Length_ms);
+		DLL_DECLARATION Luint32 u32FCU_SCHED__Get_ReplayResponse_us(Luint8 u8Task);
+		DLL_DECLARATION Luint32 u32FCU_SCHED__Get_ReplayMisses(Luint8 u8Task);
+		DLL_DECLARATION Luint32 u32FCU_SCHED__Get_ReplayPeak_us(void);
+		DLL_DECLARATION Lfloat32 f32FCU_SCHED__Get_ReplayLoad(void);
 
 		//flight controller
 		void vFCU_FLIGHTCTL__Init(void);
@@ -513,11 +919,21 @@
 			Lfloat32 f32FCU_FLIGHTCTL_LASERORIENT__Get_Lateral(void);
 			Lint16 s16FCU_FLIGHTCTL_LASERORIENT__Get_TwistRoll(void);
 			Lint16 s16FCU_FLIGHTCTL_LASERORIENT__Get_TwistPitch(void);
+			Luint8 u8FCU_FLIGHTCTL_LASERORIENT__Get_IsFault(void);
+			Luint32 u32FCU_FLIGHTCTL_LASERORIENT__Get_FaultFlags(void);
+			void vFCU_FLIGHTCTL_LASERORIENT_SOLVE__Init(void);
+			Luint8 u8FCU_FLIGHTCTL_LASERORIENT_SOLVE__Plane(const Lfloat32 *pf32Plane, Lfloat32 *pf32Norm, Lint16 *ps16Roll, Lint16 *ps16Pitch);
+			void vFCU_FLIGHTCTL_LASERORIENT_SOLVE__Heights(const Lfloat32 *pf32Norm);
+			Lint16 s16FCU_FLIGHTCTL_LASERORIENT_SOLVE__Atan2(Lint32 s32Y, Lint32 s32X);
+			void vFCU_FLIGHTCTL_LASERORIENT_FIT__Init(void);
+			Luint8 u8FCU_FLIGHTCTL_LASERORIENT_FIT__Update(Luint8 u8Healthy, Lfloat32 *pf32Plane);
+			void vFCU_FLIGHTCTL_LASERORIENT_FIT__Mask(Luint8 u8Mask, Lfloat32 *pf32Plane);
 
 			//contrast sensor nav
 			void vFCU_FLIGHTCTL_CONTRASTNAV__Init(void);
 			void vFCU_FLIGHTCTL_CONTRASTNAV__Process(void);
 			Luint32 u32FCU_FLIGHTCTL_CONTRASTNAV__Get_Position_mm(void);
+			Luint32 u32FCU_FLIGHTCTL_CONTRASTNAV__Get_Velocity_mms(void);
 			Luint8 u8FCU_FLIGHTCTL_CONTRASTNAV__Get_IsFault(void);
 			Luint32 u32FCU_FLIGHTCTL_CONTRASTNAV__Get_FaultFlags(void);
 
@@ -531,18 +947,40 @@
 			//transmit
 			void vFCU_NET_TX__Init(void);
 			void vFCU_NET_TX__Process(void);
-			void vFCU_NET_TX__10MS_ISR(void);
+			#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+				Lint16 s16FCU_NET_TX__Send_Request(Luint16 u16Request, Luint32 u32Param);
+			#endif
 
 			//spaceX specific
 			void vFCU_NET_SPACEX_TX__Init(void);
 			void vFCU_NET_SPACEX_TX__Process(void);
-			void vFCU_NET_SPACEX_TX__100MS_ISR(void);
+			Lint16 s16FCU_NET_SPACEX_TX__Transmit(void);
+
+			//DAQ streaming
+			void vFCU_NET_DAQ__Init(void);
+			void vFCU_NET_DAQ__Process(void);
+			void vFCU_NET_DAQ__Streaming_Control(Luint32 u32Enable);
+			Lint16 s16FCU_NET_DAQ__TxHandler(Luint16 u16Index, Luint8 *pu8Buffer, Luint16 u16Length);
+			void vFCU_NET_DAQ__Tx_Done(Luint16 u16PacketType, Luint16 u16Tag);
 
 		//fault handling layer
 		void vFCU_FAULTS__Init(void);
 		void vFCU_FAULTS__Process(void);
 		Luint8 u8FCU_FAULTS__Get_IsFault(void);
 		Luint32 u32FCU_FAULTS__Get_FaultFlags(void);
+		void vFCU_FAULTS__Link_Subsystems(void);
+		Luint32 u32FCU_FAULTS__Get_ChildFaults(void);
+
+			//journal streaming
+			#if C_LOCALDEF__LCCM655__ENABLE_ETHERNET == 1U
+			#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+				void vFCU_FAULTS_ETH__Init(void);
+				void vFCU_FAULTS_ETH__Process(void);
+				void vFCU_FAULTS_ETH__Streaming_Control(Luint32 u32Enable);
+				void vFCU_FAULTS_ETH__Request_Replay(Luint32 u32Sequence);
+				void vFCU_FAULTS_ETH__Transmit(E_FCU_NET_PACKET_TYPES ePacketType);
+			#endif
+			#endif
 
 		//laser contrast sensors
 		void vFCU_LASERCONT__Init(void);
@@ -553,12 +991,16 @@
 			void vFCU_LASERCONT_TL__Init(void);
 			void vFCU_LASERCONT_TL__Process(void);
 			DLL_DECLARATION void vFCU_LASERCONT_TL__ISR(E_FCU__LASER_CONT_INDEX_T eLaser, Luint32 u32Register);
+			void vFCU_LASERCONT_TL__Add_Edge(E_FCU__LASER_CONT_INDEX_T eLaser, Luint8 u8Rising, Luint64 u64Time);
+			Luint32 u32FCU_LASERCONT_TL__Get_Position_mm(Luint64 u64Time);
+			Luint32 u32FCU_LASERCONT_TL__Get_Velocity_mms(void);
+			Luint8 u8FCU_LASERCONT_TL__Get_IsFault(void);
+			Luint32 u32FCU_LASERCONT_TL__Get_FaultFlags(void);
 
 		//Laser distance
 		void vFCU_LASERDIST__Init(void);
 		void vFCU_LASERDIST__Process(void);
 		Lfloat32 f32FCU_LASERDIST__Get_Distance(void);
-		void vFCU_LASERDIST__100MS_ISR(void);
 
 
 		//main state machine
@@ -577,13 +1019,11 @@
 		void vFCU_LASEROPTO__Process(void);
 		Lfloat32 f32FCU_LASEROPTO__Get_Distance(Luint8 u8LaserIndex);
 		Luint8 u8FCU_LASEROPTO__Get_Error(Luint8 u8LaserIndex);
-		void vFCU_LASEROPTO__100MS_ISR(void);
 
 
 		//pi comms
 		void vFCU_PICOMMS__Init(void);
 		void vFCU_PICOMMS__Process(void);
-		void vFCU_PICOMMS__100MS_ISR(void);
 
 		//brakes
 		void vFCU_BRAKES__Init(void);
@@ -600,6 +1040,7 @@
 		void vFCU_BRAKES_STEP__Process(void);
 		void vFCU_BRAKES_STEP__Move(Lint32 s32Brake0Pos, Lint32 s32Brake1Pos);
 		Lint32 s32FCU_BRAKES__Get_CurrentPos(E_FCU__BRAKE_INDEX_T eBrake);
+		void vFCU_BRAKES_STEP__Timebase_ISR(void);
 
 		//brake switches
 		void vFCU_BRAKES_SW__Init(void);
@@ -619,6 +1060,7 @@
 		//accelerometer layer
 		void vFCU_ACCEL__Init(void);
 		void vFCU_ACCEL__Process(void);
+		void vFCU_ACCEL__ISR(Luint8 u8Index);
 		Lint16 s16FCU_ACCEL__Get_LastSample(Luint8 u8Index, Luint8 u8Axis);
 		Lfloat32 f32FCU_ACCEL__Get_LastG(Luint8 u8Index, Luint8 u8Axis);
 		void vFCU_ACCEL_ETH__Transmit(E_FCU_NET_PACKET_TYPES ePacketType);
@@ -630,16 +1072,29 @@
 		void vFCU_PUSHER__InterlockB_ISR(void);
 		Luint8 u8FCU_PUSHER__Get_InterlockA(void);
 		Luint8 u8FCU_PUSHER__Get_InterlockB(void);
-		void vFCU_PUSHER__10MS_ISR(void);
 		Luint8 u8FCU_PUSHER__Get_Switch(Luint8 u8Switch);
 		Luint8 u8FCU_PUSHER__Get_PusherState(void);
 
 
 		//ASI interface
 		void vFCU_ASI__Init(void);
+		void vFCU_ASI__Process(void);
+		Lint16 s16FCU_ASI__SendCommand(struct _strASICmd *sCmdParams);
+		void vFCU_ASI__Schedule_Clear(void);
+		Lint16 s16FCU_ASI__Schedule_Add(Luint16 u16Register, Luint8 u8Every);
+		Lint16 s16FCU_ASI__Get_Register(Luint8 u8ASIDevNum, Luint16 u16Register, Luint16 *pu16Value);
+		Luint16 u16FCU_ASI__CRC(const Luint8 *cpu8Data, Luint16 u16Length);
+		Luint32 u32FCU_ASI__Get_Refresh_us(void);
+		Lint16 s16FCU_ASI__Controller_Init(void);
+		Lint16 s16FCU_ASI__ReadMotorRpm(Luint8 u8ASIDevNum, Luint16 *u16Rpm);
+		Lint16 s16FCU_ASI__ReadMotorCurrent(Luint8 u8ASIDevNum, Luint16 *u16Current);
+		Lint16 s16FCU_ASI__ReadControllerTemperature(Luint8 u8ASIDevNum, Luint16 *u16Temp);
+		Lint16 s16FCU_ASI__SaveSettings(Luint8 u8ASIDevNum);
+		Lint16 s16FCU_ASI__GetFaults(Luint8 u8ASIDevNum, Luint16 *u16Faults);
 
 		//throttle layer
 		void vFCU_THROTTLE__Init(void);
+		void vFCU_THROTTLE__Process(void);
 
 		#if C_LOCALDEF__LCCM655__ENABLE_TEST_SPEC == 1U
 
@@ -647,9 +1102,51 @@
 			extern struct _strFCU sFCU;
 
 			DLL_DECLARATION void vLCCM655R0_TS_000(void);
+			DLL_DECLARATION void vLCCM655R0_TS_001(void);
+			DLL_DECLARATION void vLCCM655R0_TS_002(void);
+			DLL_DECLARATION void vLCCM655R0_TS_003(void);
+			DLL_DECLARATION void vLCCM655R0_TS_004(void);
+			void vLCCM655R0_TS_004__Tx(const Luint8 *cpu8Data, Luint8 u8Length);
+			Luint8 u8LCCM655R0_TS_004__Rx_Avail(void);
+			Luint8 u8LCCM655R0_TS_004__Rx_Byte(void);
+			Luint64 u64LCCM655R0_TS_004__Timestamp(void);
+			DLL_DECLARATION void vLCCM655R0_TS_005(void);
+			Luint32 u32LCCM655R0_TS_005__Ticks(void);
 		#endif
 
 
+		//safetys
+		#ifndef C_LOCALDEF__LCCM655__SCHED__TICKS_PER_MS
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM655__ENABLE_DAQ
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE != 1U
+			#error "FCU fault trees need LCCM671"
+		#endif
+		#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE != 1U
+			#error "FCU parameters need LCCM672"
+		#endif
+		#if C_LOCALDEF__LCCM655__ENABLE_DAQ == 1U
+			#if C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE != 1U
+				#error "DAQ streaming needs LCCM667"
+			#endif
+			#if C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE != 1U
+				#error "DAQ streaming needs LCCM668"
+			#endif
+			#if C_LOCALDEF__LCCM655__ENABLE_ACCEL == 1U
+				#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+					#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S16 < (C_FCU__NUM_ACCEL_CHIPS * 3U)
+						#error "Not enough S16 DAQ channels for the accel axes"
+					#endif
+				#endif
+			#endif
+		#endif
+
 	#endif //#if C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE == 1U
 	//safetys
 	#ifndef C_LOCALDEF__LCCM655__ENABLE_THIS_MODULE
@@ -15,6 +15,9 @@
 	/** 2 Accel devices on the PCB - DO NOT CHANGE */
 	#define C_FCU__NUM_ACCEL_CHIPS							(2U)
 
+	/** First DAQ channel for the full rate accel samples, X, Y, Z for each chip */
+	#define C_FCU__DAQ_INDEX__ACCEL_S16						(M_DAQRING__S16_OFFSET)
+
 	/** Hover Engines */
 	#define C_FCU__NUM_HOVER_ENGINES						(8U)
 
@@ -33,6 +36,21 @@
 	/** number of lasers for the i-beam */
 	#define C_FCU__NUM_LASERS_IBEAM							(2U)
 
+	/** Max disagreement between the fixed point and float orientation angles
+	 * radians x 10000, 20 = 2mrad */
+	#define C_FCU__LASER_ORIENT__XCHECK_LIMIT				(20U)
+
+	/** Every combination of healthy ground lasers gets its own precomputed fit */
+	#define C_FCU__LASER_ORIENT__NUM_FIT_MASKS				(1U << C_FCU__NUM_LASERS_GROUND)
+
+	/** Worst fit residual before a ground laser is dropped, mm. With four lasers
+	 * on a rectangle a single bad laser only shows a quarter of its error here */
+	#define C_FCU__LASER_ORIENT__OUTLIER_MM					(2.0F)
+
+	/** Weight holding the slopes at their last value when the healthy lasers
+	 * can't see them, mm^2. About the same pull as one laser 10mm off axis. */
+	#define C_FCU__LASER_ORIENT__PRIOR_WEIGHT				(100.0F)
+
 
 	/** The max number of contrast laser stripes in the tube
 	 * 1 Mile Tube = 5280ft
@@ -41,5 +59,103 @@
 	 *  */
 	#define C_FCU__LASER_CONTRAST__MAX_STRIPES				(100U)
 
+	/** Edges held between the contrast ISR and the main loop, must be a power of 2 */
+	#define C_FCU__LASER_CONTRAST__RING_SIZE				(64U)
+
+	/** RTI counter 1 rate, the time base for contrast edges */
+	#define C_FCU__LASER_CONTRAST__TICKS_PER_SEC			(C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC)
+
+	/** Stripe pitch, 100ft in mm */
+	#define C_FCU__LASER_CONTRAST__STRIPE_MM				(30480U)
+
+	/** How far the MID and AFT sensors sit behind the FWD sensor, mm.
+	 * Must be less than half a stripe pitch. */
+	#define C_FCU__LASER_CONTRAST__MID_OFFSET_MM			(1000U)
+	#define C_FCU__LASER_CONTRAST__AFT_OFFSET_MM			(2000U)
+
+	/** Nothing real crosses a stripe faster than this, mm/s */
+	#define C_FCU__LASER_CONTRAST__MAX_VELOC_MMS			(150000U)
+
+	/** Worst acceleration or braking the pod can see, mm/s^2. Sets how far
+	 * the next stripe interval can move from the last one. */
+	#define C_FCU__LASER_CONTRAST__MAX_ACCEL_MMS2			(30000U)
+
+
+	/** Slots in sFaults.sTopLevel for the subsystem fault trees. The journal
+	 * tree ID of a subsystem is its slot + 1, the top level is ID 0 */
+	#define C_FCU__FAULT_CHILD__ACCEL						(0U)
+	#define C_FCU__FAULT_CHILD__BRAKES						(1U)
+	#define C_FCU__FAULT_CHILD__CONTRAST					(C_FCU__FAULT_CHILD__BRAKES + C_FCU__NUM_BRAKES)
+	#define C_FCU__FAULT_CHILD__ORIENT						(C_FCU__FAULT_CHILD__CONTRAST + 1U)
+
+	/** Fault journal entries per SafeUDP packet */
+	#define C_FCU__FAULT_JOURNAL__ENTRIES_PER_PACKET		(8U)
+
+	/** Tx class deadlines (LCCM675), a stream packet is worthless once the next
+	 * one is due, the SpaceX packet should be out well inside its 100ms slot */
+	#define C_FCU__NET__STREAM_DEADLINE_US					(10000U)
+	#define C_FCU__NET__SPACEX_DEADLINE_US					(5000U)
+
+	/** Scheduler table size, one per module entry point */
+	#define C_FCU__SCHED__MAX_TASKS							(24U)
+
+	/** Phase for the scheduler to pick, the slot carrying the least budget */
+	#define C_FCU__SCHED__PHASE_AUTO						(0xFFFFU)
+
+	/** Slots looked at when placing an auto phase task, a multiple of every period */
+	#define C_FCU__SCHED__HORIZON_MS						(1000U)
+
+	/** Run order when tasks are due together, lowest first. Background tasks
+	 * (period 0) run once a pass after the timed ones. */
+	#define C_FCU__SCHED__PRIO__1MS							(5U)
+	#define C_FCU__SCHED__PRIO__10MS						(10U)
+	#define C_FCU__SCHED__PRIO__100MS						(20U)
+	#define C_FCU__SCHED__PRIO__BACKGROUND					(100U)
+
+	/** Task periods. The 1ms group is due in every slot so their budgets plus
+	 * the parameter commit have to fit in one. The serial drivers only move
+	 * a few bytes a call so anything reading the SC16 stays at 1ms. */
+	#define C_FCU__SCHED__PERIOD_MS__ADC					(1U)
+	#define C_FCU__SCHED__PERIOD_MS__NET					(1U)
+	#define C_FCU__SCHED__PERIOD_MS__MAINSM					(1U)
+	#define C_FCU__SCHED__PERIOD_MS__PARAMSHADOW			(10U)
+	#define C_FCU__SCHED__PERIOD_MS__SC16					(1U)
+	#define C_FCU__SCHED__PERIOD_MS__ASI					(1U)
+	#define C_FCU__SCHED__PERIOD_MS__LASEROPTO				(1U)
+	#define C_FCU__SCHED__PERIOD_MS__LASERCONT				(1U)
+	#define C_FCU__SCHED__PERIOD_MS__LASERDIST				(1U)
+	#define C_FCU__SCHED__PERIOD_MS__BRAKES					(1U)
+	#define C_FCU__SCHED__PERIOD_MS__ACCEL					(1U)
+	#define C_FCU__SCHED__PERIOD_MS__PICOMMS				(1U)
+	#define C_FCU__SCHED__PERIOD_MS__FLIGHTCTL				(1U)
+	#define C_FCU__SCHED__PERIOD_MS__AMC7812				(1U)
+	#define C_FCU__SCHED__PERIOD_MS__PUSHER					(10U)
+	#define C_FCU__SCHED__PERIOD_MS__THROTTLE				(10U)
+
+	/** Worst case run times, set these from u32FCU_SCHED__Get_ExecMax_us()
+	 * on the pod when they move */
+	#define C_FCU__SCHED__BUDGET_US__ADC					(50U)
+	#define C_FCU__SCHED__BUDGET_US__NET					(150U)
+	#define C_FCU__SCHED__BUDGET_US__MAINSM					(20U)
+	#define C_FCU__SCHED__BUDGET_US__PARAMSHADOW			(400U)
+	#define C_FCU__SCHED__BUDGET_US__SC16					(40U)
+	#define C_FCU__SCHED__BUDGET_US__ASI					(20U)
+	#define C_FCU__SCHED__BUDGET_US__LASEROPTO				(30U)
+	#define C_FCU__SCHED__BUDGET_US__LASERCONT				(20U)
+	#define C_FCU__SCHED__BUDGET_US__LASERDIST				(20U)
+	#define C_FCU__SCHED__BUDGET_US__BRAKES					(30U)
+	#define C_FCU__SCHED__BUDGET_US__ACCEL					(30U)
+	#define C_FCU__SCHED__BUDGET_US__PICOMMS				(30U)
+	#define C_FCU__SCHED__BUDGET_US__FLIGHTCTL				(30U)
+	#define C_FCU__SCHED__BUDGET_US__AMC7812				(10U)
+	#define C_FCU__SCHED__BUDGET_US__PUSHER					(20U)
+	#define C_FCU__SCHED__BUDGET_US__THROTTLE				(30U)
+
+	/** Module timers off the scheduler clock */
+	#define C_FCU__PICOMMS__FRAME_PERIOD_MS					(10U)
+	#define C_FCU__NET__STREAM_PERIOD_MS					(10U)
+	#define C_FCU__NET__SPACEX_PERIOD_MS					(100U)
+	#define C_FCU__PUSHER__SWITCH_SETTLE_MS					(100U)
+	#define C_FCU__LASER__POR_WAIT_MS						(5000U)
 
 #endif /* RLOOP_LCCM655__RLOOP__FCU_CORE_FCU_CORE__DEFINES_H_ */
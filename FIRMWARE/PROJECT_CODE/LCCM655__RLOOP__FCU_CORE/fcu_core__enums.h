@@ -134,4 +134,19 @@
 	} E_THROTTLE_STATES_T;
 
 
+	/** Packets the Tx class scheduler (LCCM675) asks us to build */
+	typedef enum
+	{
+		/** SpaceX telemetry */
+		FCU_NET_TXREQ__SPACEX = 0U,
+
+		/** Accel stream, param is the packet type */
+		FCU_NET_TXREQ__ACCEL,
+
+		/** Next block of the fault journal */
+		FCU_NET_TXREQ__FAULT_JOURNAL
+
+	}E_FCU_NET_TXREQ_T;
+
+
 #endif /* RLOOP_LCCM655__RLOOP__FCU_CORE_FCU_CORE__ENUMS_H_ */
@@ -26,5 +26,18 @@
 #define C_LCCM655__CORE__FAULT_INDEX__01				0x00000001U
 #define C_LCCM655__CORE__FAULT_INDEX_MASK__01			0x00000002U
 
+/*
+ * @fault_index
+ * 02
+ *
+ * @brief
+ * TASK_OVERRUN
+ *
+ * A scheduled task ran longer than its worst case budget, the timing of the
+ * tasks after it can't be relied on.
+*/
+#define C_LCCM655__CORE__FAULT_INDEX__02				0x00000002U
+#define C_LCCM655__CORE__FAULT_INDEX_MASK__02			0x00000004U
+
 #endif //#ifndef _LCCM655__FAULT_FLAGS_H_
 
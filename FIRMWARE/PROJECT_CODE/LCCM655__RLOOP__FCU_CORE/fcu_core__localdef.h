@@ -43,12 +43,28 @@ RLOOP - FLIGHT CONTROL UNIT - CORE
 		/** Enable the ASI_RS485 */
 		#define C_LOCALDEF__LCCM655__ENABLE_ASI_RS485						(0U)
 
+			//the ASI bus, SC16 channel, baud and the 64 bit timebase it runs from
+			#define C_LOCALDEF__LCCM655__ASI_SC16_INDEX							(7U)
+			#define C_LOCALDEF__LCCM655__ASI_BAUD								(115200U)
+			#define C_LOCALDEF__LCCM655__ASI_TICKS_PER_SEC						(C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC)
+			#define M_LOCALDEF__LCCM655__ASI_TIMESTAMP()						u64RM4_RTI__Get_Counter1()
+			#define M_LOCALDEF__LCCM655__ASI_TX(pu8Data, u8Length)				vSC16__Tx_ByteArray(C_LOCALDEF__LCCM655__ASI_SC16_INDEX, pu8Data, u8Length)
+			#define M_LOCALDEF__LCCM655__ASI_RX_AVAIL()							u8SC16_USER__Get_ByteAvail(C_LOCALDEF__LCCM655__ASI_SC16_INDEX)
+			#define M_LOCALDEF__LCCM655__ASI_RX_BYTE()							u8SC16_USER__Get_Byte(C_LOCALDEF__LCCM655__ASI_SC16_INDEX)
+
 		/** Enable the pusher detection system */
 		#define C_LOCALDEF__LCCM655__ENABLE_PUSHER							(0U)
 
 		/** Ethernet Systems */
 		#define C_LOCALDEF__LCCM655__ENABLE_ETHERNET						(1U)
 
+		/** Stream DAQ blocks to the ground station, needs LCCM667 and LCCM668 */
+		#define C_LOCALDEF__LCCM655__ENABLE_DAQ								(1U)
+
+		/** Task scheduler slot clock and task timing, the free running RTI counter 1 */
+		#define C_LOCALDEF__LCCM655__SCHED__TICKS_PER_MS					(C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC / 1000U)
+		#define M_LOCALDEF__LCCM655__SCHED__TICKS()							((Luint32)u64RM4_RTI__Get_Counter1())
+
 		/** Flight control specifics */
 		#define C_LOCALDEF__LCCM655__ENABLE_FLIGHT_CONTROL					(1U)
 
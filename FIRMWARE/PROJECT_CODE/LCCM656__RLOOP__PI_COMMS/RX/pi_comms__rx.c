@@ -37,16 +37,55 @@ void (*PICOMMS_RX_recvLint64) (Luint16 index, Lint64 data);
 void (*PICOMMS_RX_recvLfloat32) (Luint16 index, Lfloat32 data);
 void (*PICOMMS_RX_recvLfloat64) (Luint16 index, Lfloat64 data);
 
-void vPICOMMS_RX__ProcessBuffer();
-Luint16 u16PICOMMS_RX__ProcessFrame(Luint8 *frameBuffer, Luint16 length);
+//the ring is indexed with a mask
+#if ((C_PICOMMS_RX__RING_SIZE & C_PICOMMS_RX__RING_MASK) != 0U)
+	#error "C_PICOMMS_RX__RING_SIZE must be a power of two"
+#endif
+
+static void vPICOMMS_RX__Parse_Byte(Luint8 u8Byte);
+static void vPICOMMS_RX__Control(Luint8 u8Byte);
+static void vPICOMMS_RX__Literal(Luint8 u8Byte);
+static void vPICOMMS_RX__Start_Frame(void);
+static void vPICOMMS_RX__Resync(void);
+static void vPICOMMS_RX__Ring_Write(Luint8 u8Byte);
+static void vPICOMMS_RX__Commit_Frame(void);
+static Luint16 u16PICOMMS_RX__Read_Param(Luint16 u16Pos, Luint8 *pu8Type, Luint16 *pu16Index, Luint64 *pu64Raw);
+static Luint16 u16PICOMMS_RX__Find_Slot(Luint16 u16Index);
+static void vPICOMMS_RX__Decode(Luint8 u8Type, Luint64 u64Raw, PICOMMS_RX_VALUE_T *puValue);
+static void vPICOMMS_RX__Store(Luint8 u8Type, const PICOMMS_RX_VALUE_T *puValue, void *pvDest);
 void vPICOMMS_RX__ReceiveParam(Luint8 u8Type, Luint16 u16Index, Luint64 u64RawData);
 
 
 void vPICOMMS_RX__Init()
 {
-	sPC.sRx.bufferLength = 0;
-	sPC.sRx.bufferBegin = 0;
-	sPC.sRx.u32Faults = 0U;
+	Luint8 u8Counter;
+
+	sPC.sRx.eState = PICOMMS_RX_STATE__HUNT;
+	sPC.sRx.u8Escape = 0U;
+	sPC.sRx.u8Checksum = 0U;
+	sPC.sRx.u8DataRemain = 0U;
+	sPC.sRx.u16Length = 0U;
+	sPC.sRx.u16PayloadRaw = 0U;
+	sPC.sRx.u16FrameRaw = 0U;
+	sPC.sRx.u16Head = 0U;
+	sPC.sRx.u16Tail = 0U;
+	sPC.sRx.u32Frames = 0U;
+	sPC.sRx.u32Resyncs = 0U;
+	sPC.sRx.u32ChecksumFaults = 0U;
+	sPC.sRx.u32DroppedBytes = 0U;
+	sPC.sRx.u32RejectedFrames = 0U;
+	sPC.sRx.u32Rejected = 0U;
+	sPC.sRx.u32TypeFaults = 0U;
+	sPC.sRx.u32TableFaults = 0U;
+
+	//no table until a node registers one
+	sPC.sRx.pTable = 0;
+	sPC.sRx.u16TableSize = 0U;
+	sPC.sRx.pCommitCB = 0;
+	for(u8Counter = 0U; u8Counter < (C_PICOMMS_RX__MAX_TABLE / 32U); u8Counter++)
+	{
+		sPC.sRx.u32UpdateMask[u8Counter] = 0U;
+	}
 
 
 	PICOMMS_RX_frameRXBeginCB = 0;
@@ -63,309 +102,730 @@ void vPICOMMS_RX__Init()
 	PICOMMS_RX_frameRXEndCB = 0;
 }
 
+/***************************************************************************//**
+ * @brief
+ * Feed received bytes into the parser. Any size piece can be passed, the
+ * parser state is kept between calls so nothing is rescanned.
+ *
+ * @param[in]		data					Pointer to the bytes
+ * @param[in]		length					Number of bytes
+ */
 void vPICOMMS_RX__Receive_Bytes(Luint8 *data, Luint16 length)
 {
-	int i = 0;
+	Luint16 u16Counter;
 
-	if (length > RPOD_PICOMMS_BUFFER_SIZE)
+	for(u16Counter = 0U; u16Counter < length; u16Counter++)
 	{
-		//todo: Flags?
-		//somehthing's not right, drop this data and hope we catch up
-		return;
-	}
-	else
-	{
-		//All is well, continue on
+		vPICOMMS_RX__Parse_Byte(data[u16Counter]);
 	}
+}
 
-	//Got some bad data at some point
-	if (sPC.sRx.bufferLength + length > RPOD_PICOMMS_BUFFER_SIZE)
+/***************************************************************************//**
+ * @brief
+ * Step the parser by one raw byte
+ *
+ * @param[in]		u8Byte					The raw byte
+ */
+static void vPICOMMS_RX__Parse_Byte(Luint8 u8Byte)
+{
+	Luint8 u8Parse;
+
+	u8Parse = 1U;
+	if(sPC.sRx.eState == PICOMMS_RX_STATE__PAD)
 	{
-		sPC.sRx.bufferLength = 0;
-		sPC.sRx.bufferBegin = 0;
+		//a missing pad may be the start of the next frame, so only a zero is eaten
+		sPC.sRx.eState = PICOMMS_RX_STATE__HUNT;
+		if(u8Byte == 0x00U)
+		{
+			u8Parse = 0U;
+		}
+		else
+		{
+			//fall on and parse it
+		}
 	}
 	else
 	{
-		//todo: what to do?
+		//fall on
 	}
 
-	if((sPC.sRx.bufferBegin + sPC.sRx.bufferLength) < RPOD_PICOMMS_BUFFER_SIZE)
+	if(u8Parse == 0U)
+	{
+		//pad consumed
+	}
+	else if(sPC.sRx.eState == PICOMMS_RX_STATE__CHECKSUM)
 	{
-		for (i = 0; i < length; i++)
+		//the checksum is sent unescaped
+		if(u8Byte == sPC.sRx.u8Checksum)
 		{
-			sPC.sRx.u8Buffer[(i + sPC.sRx.bufferBegin + sPC.sRx.bufferLength) % RPOD_PICOMMS_BUFFER_SIZE] = data[i];
+			vPICOMMS_RX__Commit_Frame();
 		}
+		else
+		{
+			sPC.sRx.u32ChecksumFaults++;
+			sPC.sRx.u32DroppedBytes += (Luint32)sPC.sRx.u16FrameRaw + 1U;
+		}
+
+		//release the frame from the ring
+		sPC.sRx.u16Tail = sPC.sRx.u16Head;
+		sPC.sRx.u16FrameRaw = 0U;
+		sPC.sRx.eState = PICOMMS_RX_STATE__PAD;
 	}
 	else
 	{
-		sPC.sRx.u32Faults++;
-	}
+		//payload bytes are counted raw so we can check the frame length
+		if(sPC.sRx.eState >= PICOMMS_RX_STATE__PARAM_CONTROL)
+		{
+			sPC.sRx.u16PayloadRaw++;
+			if(sPC.sRx.u16PayloadRaw > (sPC.sRx.u16Length - 2U))
+			{
+				//ran past the length plus the EOF pair
+				vPICOMMS_RX__Resync();
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		else
+		{
+			//header or hunting
+		}
 
-	sPC.sRx.bufferLength += length;
+		if(sPC.sRx.eState != PICOMMS_RX_STATE__HUNT)
+		{
+			sPC.sRx.u16FrameRaw++;
+			sPC.sRx.u8Checksum ^= u8Byte;
+		}
+		else
+		{
+			//not in a frame
+		}
 
-	//See if there's enough data for a full frame
-	if (sPC.sRx.bufferLength >= 8)
-	{
-		//todo: really call this every time?
-		vPICOMMS_RX__ProcessBuffer();
-	}
-	else
-	{
-		//Not enough data for a full frame, do nothing
+		if(sPC.sRx.u8Escape == 1U)
+		{
+			sPC.sRx.u8Escape = 0U;
+			if(u8Byte == RPOD_PICOMMS_CONTROL_CHAR)
+			{
+				//escaped data byte
+				vPICOMMS_RX__Literal(u8Byte);
+			}
+			else
+			{
+				vPICOMMS_RX__Control(u8Byte);
+			}
+		}
+		else if(u8Byte == RPOD_PICOMMS_CONTROL_CHAR)
+		{
+			//wait for the next byte to know what this is
+			sPC.sRx.u8Escape = 1U;
+		}
+		else
+		{
+			vPICOMMS_RX__Literal(u8Byte);
+		}
 	}
-
 }
 
-void vPICOMMS_RX__ProcessBuffer(void)
+/***************************************************************************//**
+ * @brief
+ * Handle a control char pair
+ *
+ * @param[in]		u8Byte					The byte after the control char
+ */
+static void vPICOMMS_RX__Control(Luint8 u8Byte)
 {
-
-	int i = 0;
-	int bufferBeginJump = 0;
-
-	//Search for a full frame
-	for (i = 0; i < (sPC.sRx.bufferLength - 1); i++)
+	switch(u8Byte)
 	{
-		//Is this a start code?
-		if (sPC.sRx.u8Buffer[(sPC.sRx.bufferBegin + i) % RPOD_PICOMMS_BUFFER_SIZE] == RPOD_PICOMMS_CONTROL_CHAR && sPC.sRx.u8Buffer[((sPC.sRx.bufferBegin + i + 1) % RPOD_PICOMMS_BUFFER_SIZE)] == RPOD_PICOMMS_FRAME_START)
-		{
+		case RPOD_PICOMMS_FRAME_START:
+			if(sPC.sRx.eState != PICOMMS_RX_STATE__HUNT)
+			{
+				//new frame before the last one finished, the SOF pair belongs to the new frame
+				sPC.sRx.u16FrameRaw -= 2U;
+				vPICOMMS_RX__Resync();
+			}
+			else
+			{
+				//normal
+			}
+			vPICOMMS_RX__Start_Frame();
+			break;
 
-			//See if we should have the whole header yet
-			if ((i + 5) < sPC.sRx.bufferLength)
+		case RPOD_PICOMMS_PARAMETER_START:
+			if(sPC.sRx.eState == PICOMMS_RX_STATE__PARAM_CONTROL)
+			{
+				sPC.sRx.eState = PICOMMS_RX_STATE__PARAM_TYPE;
+			}
+			else if(sPC.sRx.eState == PICOMMS_RX_STATE__HUNT)
+			{
+				sPC.sRx.u32DroppedBytes += 2U;
+			}
+			else
 			{
+				vPICOMMS_RX__Resync();
+			}
+			break;
 
-				//Grab the length of the frame from the header
-				Luint16 u16FrameLength = sPC.sRx.u8Buffer[(sPC.sRx.bufferBegin + i + 2) % RPOD_PICOMMS_BUFFER_SIZE];
-				int headerLength = 4;
-				if (u16FrameLength == RPOD_PICOMMS_CONTROL_CHAR)
+		case RPOD_PICOMMS_FRAME_END:
+			if(sPC.sRx.eState == PICOMMS_RX_STATE__PARAM_CONTROL)
+			{
+				//the EOF control char is not part of the checksum or the length
+				sPC.sRx.u8Checksum ^= (Luint8)(RPOD_PICOMMS_CONTROL_CHAR ^ RPOD_PICOMMS_FRAME_END);
+				if((sPC.sRx.u16PayloadRaw - 2U) == (sPC.sRx.u16Length - 4U))
 				{
-					u16FrameLength = u16FrameLength * 256 + sPC.sRx.u8Buffer[(sPC.sRx.bufferBegin + i + 4) % RPOD_PICOMMS_BUFFER_SIZE];
-					headerLength++;
-
-					if (sPC.sRx.u8Buffer[(sPC.sRx.bufferBegin + i + 4) % RPOD_PICOMMS_BUFFER_SIZE] == RPOD_PICOMMS_CONTROL_CHAR)
-					{
-						headerLength++;
-					}
+					sPC.sRx.eState = PICOMMS_RX_STATE__CHECKSUM;
 				}
 				else
 				{
-					u16FrameLength = u16FrameLength * 256 + sPC.sRx.u8Buffer[(sPC.sRx.bufferBegin + i + 3) % RPOD_PICOMMS_BUFFER_SIZE];
+					vPICOMMS_RX__Resync();
 				}
+			}
+			else if(sPC.sRx.eState == PICOMMS_RX_STATE__HUNT)
+			{
+				sPC.sRx.u32DroppedBytes += 2U;
+			}
+			else
+			{
+				vPICOMMS_RX__Resync();
+			}
+			break;
 
-				//See if we have the end of the frame in the buffer yet
-				if (i + headerLength + u16FrameLength <= sPC.sRx.bufferLength)
-				{
-					//Copy the frame into a flat buffer
-					//This step isn't 100% necessary but it does make processing the frame a bit easier to follow
-					int x;
-					if((u16FrameLength + headerLength) < RPOD_PICOMMS_BUFFER_SIZE)
-					{
-						for (x = 0; x < (u16FrameLength + headerLength); x++)
-						{
+		default:
+			//not a valid pair
+			if(sPC.sRx.eState == PICOMMS_RX_STATE__HUNT)
+			{
+				sPC.sRx.u32DroppedBytes += 2U;
+			}
+			else
+			{
+				vPICOMMS_RX__Resync();
+			}
+			break;
+	}
+}
 
-							sPC.sRx.u8TempFrameBuffer[x] = sPC.sRx.u8Buffer[((x + i) + sPC.sRx.bufferBegin) % RPOD_PICOMMS_BUFFER_SIZE];
-						}
-					}
-					else
-					{
-						//major fault.
-						sPC.sRx.u32Faults++;
-					}
+/***************************************************************************//**
+ * @brief
+ * Handle a data byte, already unescaped
+ *
+ * @param[in]		u8Byte					The data byte
+ */
+static void vPICOMMS_RX__Literal(Luint8 u8Byte)
+{
+	Luint8 u8Size;
 
+	switch(sPC.sRx.eState)
+	{
+		case PICOMMS_RX_STATE__HUNT:
+			if(u8Byte == RPOD_PICOMMS_CONTROL_CHAR)
+			{
+				//escaped pair outside a frame
+				sPC.sRx.u32DroppedBytes += 2U;
+			}
+			else
+			{
+				sPC.sRx.u32DroppedBytes++;
+			}
+			break;
 
-					//Process the frame!
-					if (u16PICOMMS_RX__ProcessFrame(&sPC.sRx.u8TempFrameBuffer[0], u16FrameLength + 4))
-					{
-						i += u16FrameLength + headerLength;
-						bufferBeginJump += headerLength + u16FrameLength;
-					}
-				}
-				else
-				{
+		case PICOMMS_RX_STATE__LENGTH_HI:
+			//the checksum is over the wire bytes, an escaped length byte
+			//has already cancelled itself out there like any other
+			sPC.sRx.u16Length = (Luint16)u8Byte << 8U;
+			sPC.sRx.eState = PICOMMS_RX_STATE__LENGTH_LO;
+			break;
 
-					//We have a start code, but not enough data for a full frame yet
-					i = sPC.sRx.bufferLength;
-				}
+		case PICOMMS_RX_STATE__LENGTH_LO:
+			sPC.sRx.u16Length |= (Luint16)u8Byte;
 
+			//length covers the header and the escaped payload
+			if((sPC.sRx.u16Length >= 4U) && (sPC.sRx.u16Length <= RPOD_PICOMMS_BUFFER_SIZE))
+			{
+				sPC.sRx.u16PayloadRaw = 0U;
+				sPC.sRx.eState = PICOMMS_RX_STATE__PARAM_CONTROL;
 			}
 			else
 			{
-				//Don't have the full header yet, nothing to do for now
-				i = sPC.sRx.bufferLength - 1;
+				vPICOMMS_RX__Resync();
 			}
-		}
-		else
-		{
-			//Not sure what we got sent, but it's not a start code so advance the buffer.
-			bufferBeginJump++;
-		}
-	}
+			break;
+
+		case PICOMMS_RX_STATE__PARAM_TYPE:
+			//upper nibble is the size, lower is int / uint / float
+			u8Size = u8Byte >> 4U;
+			if(((u8Size == 1U) || (u8Size == 2U) || (u8Size == 4U) || (u8Size == 8U)) && ((u8Byte & 0x0FU) >= 1U) && ((u8Byte & 0x0FU) <= 3U))
+			{
+				sPC.sRx.u8DataRemain = u8Size;
+				vPICOMMS_RX__Ring_Write(u8Byte);
+				sPC.sRx.eState = PICOMMS_RX_STATE__PARAM_INDEX_HI;
+			}
+			else
+			{
+				vPICOMMS_RX__Resync();
+			}
+			break;
+
+		case PICOMMS_RX_STATE__PARAM_INDEX_HI:
+			vPICOMMS_RX__Ring_Write(u8Byte);
+			sPC.sRx.eState = PICOMMS_RX_STATE__PARAM_INDEX_LO;
+			break;
 
-	//tod: check that this is not an error
-	sPC.sRx.bufferBegin += bufferBeginJump;
-	sPC.sRx.bufferBegin = sPC.sRx.bufferBegin % RPOD_PICOMMS_BUFFER_SIZE;
-	sPC.sRx.bufferLength -= bufferBeginJump;
+		case PICOMMS_RX_STATE__PARAM_INDEX_LO:
+			vPICOMMS_RX__Ring_Write(u8Byte);
+			sPC.sRx.eState = PICOMMS_RX_STATE__PARAM_DATA;
+			break;
+
+		case PICOMMS_RX_STATE__PARAM_DATA:
+			vPICOMMS_RX__Ring_Write(u8Byte);
+			sPC.sRx.u8DataRemain--;
+			if(sPC.sRx.u8DataRemain == 0U)
+			{
+				sPC.sRx.eState = PICOMMS_RX_STATE__PARAM_CONTROL;
+			}
+			else
+			{
+				//more to come
+			}
+			break;
 
+		default:
+			//data where we wanted a control char
+			vPICOMMS_RX__Resync();
+			break;
+	}
 }
 
-Luint16 u16PICOMMS_RX__ProcessFrame(Luint8 *frameBuffer, Luint16 length)
+/***************************************************************************//**
+ * @brief
+ * Control + SOF seen, start a new frame
+ *
+ */
+static void vPICOMMS_RX__Start_Frame(void)
 {
-	int i = 0;
-	Luint8 checksum = 0;
+	sPC.sRx.u8Checksum = (Luint8)(RPOD_PICOMMS_CONTROL_CHAR ^ RPOD_PICOMMS_FRAME_START);
+	sPC.sRx.u16FrameRaw = 2U;
+	sPC.sRx.u16PayloadRaw = 0U;
+	sPC.sRx.u16Tail = sPC.sRx.u16Head;
+	sPC.sRx.eState = PICOMMS_RX_STATE__LENGTH_HI;
+}
 
-	//Check the start and end headers
+/***************************************************************************//**
+ * @brief
+ * Give up on the current frame and go back to hunting. Only what has been
+ * seen of this frame is dropped, the next SOF is picked up straight away.
+ *
+ */
+static void vPICOMMS_RX__Resync(void)
+{
+	sPC.sRx.u32Resyncs++;
+	sPC.sRx.u32DroppedBytes += (Luint32)sPC.sRx.u16FrameRaw;
+	sPC.sRx.u16FrameRaw = 0U;
+	sPC.sRx.u16PayloadRaw = 0U;
+	sPC.sRx.u16Head = sPC.sRx.u16Tail;
+	sPC.sRx.eState = PICOMMS_RX_STATE__HUNT;
+}
 
-	//Check the start of the buffer for the sof control code
-	//Check the end of the frame for the eof control code
-	if (frameBuffer[0] != RPOD_PICOMMS_CONTROL_CHAR || frameBuffer[1] != RPOD_PICOMMS_FRAME_START || frameBuffer[length - 4] != RPOD_PICOMMS_CONTROL_CHAR || frameBuffer[length - 3] != RPOD_PICOMMS_FRAME_END)
+/***************************************************************************//**
+ * @brief
+ * Store a decoded byte of the current frame
+ *
+ * @param[in]		u8Byte					The decoded byte
+ */
+static void vPICOMMS_RX__Ring_Write(Luint8 u8Byte)
+{
+	if((Luint16)(sPC.sRx.u16Head - sPC.sRx.u16Tail) < C_PICOMMS_RX__RING_SIZE)
 	{
-		//Improper packet framing, get out of here
-		return 0;
-
+		sPC.sRx.u8Ring[sPC.sRx.u16Head & C_PICOMMS_RX__RING_MASK] = u8Byte;
+		sPC.sRx.u16Head++;
 	}
 	else
 	{
-		//Proper packet framing so all is well, continue on
-	}
-
-	//Simple checkum on the packet, should implement a better scheme
-
-	for (i = 0; i < length-4; i++)
-	{
-		checksum ^= frameBuffer[i];
+		//frame will not fit, the length check should stop us getting here
+		vPICOMMS_RX__Resync();
 	}
+}
 
-	if (frameBuffer[length - 2] != checksum)
+/***************************************************************************//**
+ * @brief
+ * Checksum passed. Any table params are checked first so a frame is applied
+ * in full or not at all, then each param in the ring is handed up.
+ *
+ */
+static void vPICOMMS_RX__Commit_Frame(void)
+{
+	Luint16 u16Pos;
+	Luint16 u16Index;
+	Luint16 u16Slot;
+	Luint64 u64Raw;
+	Luint8 u8Type;
+	Luint8 u8Accept;
+	Luint8 u8Counter;
+	PICOMMS_RX_VALUE_T uValue;
+	const PICOMMS_RX_PARAM_T *pEntry;
+
+	//pass 1, check the table params before any destination is touched
+	u8Accept = 1U;
+	if(sPC.sRx.pTable != 0)
 	{
-		//Bad checksum, abort
-		return 0;
+		u16Pos = sPC.sRx.u16Tail;
+		while(u16Pos != sPC.sRx.u16Head)
+		{
+			u16Pos = u16PICOMMS_RX__Read_Param(u16Pos, &u8Type, &u16Index, &u64Raw);
+			u16Slot = u16PICOMMS_RX__Find_Slot(u16Index);
+			if(u16Slot < sPC.sRx.u16TableSize)
+			{
+				pEntry = &sPC.sRx.pTable[u16Slot];
+				if(pEntry->u8Type != u8Type)
+				{
+					sPC.sRx.u32TypeFaults++;
+					u8Accept = 0U;
+				}
+				else if(pEntry->pu8Validate != 0)
+				{
+					vPICOMMS_RX__Decode(u8Type, u64Raw, &uValue);
+					if(pEntry->pu8Validate(u16Index, &uValue) == 0U)
+					{
+						sPC.sRx.u32Rejected++;
+						u8Accept = 0U;
+					}
+					else
+					{
+						//accepted
+					}
+				}
+				else
+				{
+					//no validator
+				}
+			}
+			else
+			{
+				//not ours, goes to the typed callbacks
+			}
+		}
 	}
 	else
 	{
-		//Checksum is valid, continue on
+		//no table registered
 	}
 
-
-	//Call user code to indicate we're starting to process a new frame
-	if (PICOMMS_RX_frameRXBeginCB != 0)
+	if(u8Accept == 1U)
 	{
-		PICOMMS_RX_frameRXBeginCB();
-	}
+		sPC.sRx.u32Frames++;
 
+		for(u8Counter = 0U; u8Counter < (C_PICOMMS_RX__MAX_TABLE / 32U); u8Counter++)
+		{
+			sPC.sRx.u32UpdateMask[u8Counter] = 0U;
+		}
 
-	//Shorten any escaped data now that we've isolated a single frame
-	//So any {RPOD_PICOMMS_CONTROL_CHAR,RPOD_PICOMMS_CONTROL_CHAR}  becomes simply {RPOD_PICOMMS_CONTROL_CHAR}
-	for (i = 2; i < length-1; i++)
-	{
-		if (frameBuffer[i] == RPOD_PICOMMS_CONTROL_CHAR && frameBuffer[i + 1] == RPOD_PICOMMS_CONTROL_CHAR)
+		//Call user code to indicate we're starting to process a new frame
+		if(PICOMMS_RX_frameRXBeginCB != 0)
 		{
-			int x;
+			PICOMMS_RX_frameRXBeginCB();
+		}
+		else
+		{
+			//No callback to make
+		}
 
-			if((i + 1 + length) < RPOD_PICOMMS_BUFFER_SIZE)
+		//pass 2, apply
+		u16Pos = sPC.sRx.u16Tail;
+		while(u16Pos != sPC.sRx.u16Head)
+		{
+			u16Pos = u16PICOMMS_RX__Read_Param(u16Pos, &u8Type, &u16Index, &u64Raw);
+			u16Slot = u16PICOMMS_RX__Find_Slot(u16Index);
+			if(u16Slot < sPC.sRx.u16TableSize)
 			{
-
-				for (x = i + 1; x < length - 1; x++)
-				{
-					frameBuffer[x] = frameBuffer[x + 1];
-				}
-
-				frameBuffer[length - 1] = 0x00;
+				//straight into the users structure
+				vPICOMMS_RX__Decode(u8Type, u64Raw, &uValue);
+				vPICOMMS_RX__Store(u8Type, &uValue, sPC.sRx.pTable[u16Slot].pvDest);
+				sPC.sRx.u32UpdateMask[u16Slot >> 5U] |= (Luint32)1U << (u16Slot & 0x1FU);
 			}
 			else
 			{
-				sPC.sRx.u32Faults++;
+				vPICOMMS_RX__ReceiveParam(u8Type, u16Index, u64Raw);
 			}
 		}
+
+		if(PICOMMS_RX_frameRXEndCB != 0)
+		{
+			PICOMMS_RX_frameRXEndCB();
+		}
 		else
 		{
-			//no escaped data here, continue on.
+			//No callback to make
 		}
-	}
-
-	Luint16 position = 4;
-	Luint64 rawData;
 
-	//Scan the whole packet for data
-	while (position < length)
-	{
-		//Found a control character
-		if (frameBuffer[position] == RPOD_PICOMMS_CONTROL_CHAR)
+		//one call per frame, the user acts on whatever was updated
+		if(sPC.sRx.pCommitCB != 0)
 		{
-			position++;
-
-			//See which control character we've got
-			switch (frameBuffer[position])
-			{
-
-				//Found a data parameter in the packet
-				case RPOD_PICOMMS_PARAMETER_START:
-				{
-					position++;
-
-					//Figure out which type of data we're being given
-					int dataType = frameBuffer[position] & 0x0F;
-					Luint8 dataSize = (frameBuffer[position] & 0xF0) / 16;
-
-					//Copy the parameter data into a buffer and pass it along for processing by user code
-					if (dataType == 1 || dataType == 2 || dataType == 3)
-					{
+			sPC.sRx.pCommitCB();
+		}
+		else
+		{
+			//No callback to make
+		}
+	}
+	else
+	{
+		//nothing applied
+		sPC.sRx.u32RejectedFrames++;
+	}
+}
 
-						//Copy data from the packet buffer to a 64 bit buffer and swap the endianess in the process
-						rawData = frameBuffer[position+3];
+/***************************************************************************//**
+ * @brief
+ * Read one decoded param out of the ring
+ *
+ * @param[in]		u16Pos					Ring position of the param
+ * @param[out]		pu8Type					Param type
+ * @param[out]		pu16Index				Param index
+ * @param[out]		pu64Raw					Raw value, right aligned
+ * @return			Ring position of the next param
+ */
+static Luint16 u16PICOMMS_RX__Read_Param(Luint16 u16Pos, Luint8 *pu8Type, Luint16 *pu16Index, Luint64 *pu64Raw)
+{
+	Luint8 u8Size;
+	Luint8 u8Counter;
+	Luint64 u64Raw;
+
+	*pu8Type = sPC.sRx.u8Ring[u16Pos & C_PICOMMS_RX__RING_MASK];
+	*pu16Index = (Luint16)((Luint16)sPC.sRx.u8Ring[(Luint16)(u16Pos + 1U) & C_PICOMMS_RX__RING_MASK] << 8U);
+	*pu16Index |= (Luint16)sPC.sRx.u8Ring[(Luint16)(u16Pos + 2U) & C_PICOMMS_RX__RING_MASK];
+	u16Pos += 3U;
+
+	//big endian on the wire
+	u8Size = *pu8Type >> 4U;
+	u64Raw = 0U;
+	for(u8Counter = 0U; u8Counter < u8Size; u8Counter++)
+	{
+		u64Raw = (u64Raw << 8U) | (Luint64)sPC.sRx.u8Ring[u16Pos & C_PICOMMS_RX__RING_MASK];
+		u16Pos++;
+	}
+	*pu64Raw = u64Raw;
 
-						Luint8 i; //Put this somewhere else?
-						for(i = 1; i <dataSize; i++)
-						{
-							rawData *= 256;
-							rawData += frameBuffer[position+3 + i];
-						}
+	return u16Pos;
+}
 
-						//TODO Add code and defines to not swap endianess on big endian CPUs
+/***************************************************************************//**
+ * @brief
+ * Binary search of the registered table
+ *
+ * @param[in]		u16Index				Param index
+ * @return			Table slot, or the table size if not found
+ */
+static Luint16 u16PICOMMS_RX__Find_Slot(Luint16 u16Index)
+{
+	Luint16 u16Low;
+	Luint16 u16High;
+	Luint16 u16Mid;
+	Luint16 u16Return;
+
+	u16Return = sPC.sRx.u16TableSize;
+	u16Low = 0U;
+	u16High = sPC.sRx.u16TableSize;
+	while(u16Low < u16High)
+	{
+		u16Mid = (Luint16)((u16Low + u16High) >> 1U);
+		if(sPC.sRx.pTable[u16Mid].u16Index < u16Index)
+		{
+			u16Low = u16Mid + 1U;
+		}
+		else
+		{
+			u16High = u16Mid;
+		}
+	}
 
-						vPICOMMS_RX__ReceiveParam(frameBuffer[position], frameBuffer[position + 1] * 256 + frameBuffer[position+2], rawData);
+	if(u16Low < sPC.sRx.u16TableSize)
+	{
+		if(sPC.sRx.pTable[u16Low].u16Index == u16Index)
+		{
+			u16Return = u16Low;
+		}
+		else
+		{
+			//not in the table
+		}
+	}
+	else
+	{
+		//past the end
+	}
 
-					}
-					else if (dataType == 0)
-					{
+	return u16Return;
+}
 
-					}
-					else
-					{
+/***************************************************************************//**
+ * @brief
+ * Convert the raw value into its type
+ *
+ * @param[in]		u8Type					Param type
+ * @param[in]		u64Raw					Raw value, right aligned
+ * @param[out]		puValue					The typed value
+ */
+static void vPICOMMS_RX__Decode(Luint8 u8Type, Luint64 u64Raw, PICOMMS_RX_VALUE_T *puValue)
+{
+	switch(u8Type)
+	{
+		case PICOMMS_INT8:
+		case PICOMMS_UINT8:
+			puValue->u8 = (Luint8)u64Raw;
+			break;
+		case PICOMMS_INT16:
+		case PICOMMS_UINT16:
+			puValue->u16 = (Luint16)u64Raw;
+			break;
+		case PICOMMS_INT32:
+		case PICOMMS_UINT32:
+		case PICOMMS_FLOAT:
+			//float is carried as its bit pattern
+			puValue->u32 = (Luint32)u64Raw;
+			break;
+		default:
+			puValue->u64 = u64Raw;
+			break;
+	}
+}
 
-					}
+/***************************************************************************//**
+ * @brief
+ * Write a typed value to the users destination
+ *
+ * @param[in]		u8Type					Param type
+ * @param[in]		puValue					The typed value
+ * @param[in]		pvDest					Destination, must be the size of the type
+ */
+static void vPICOMMS_RX__Store(Luint8 u8Type, const PICOMMS_RX_VALUE_T *puValue, void *pvDest)
+{
+	switch(u8Type)
+	{
+		case PICOMMS_INT8:
+		case PICOMMS_UINT8:
+			*(Luint8 *)pvDest = puValue->u8;
+			break;
+		case PICOMMS_INT16:
+		case PICOMMS_UINT16:
+			*(Luint16 *)pvDest = puValue->u16;
+			break;
+		case PICOMMS_INT32:
+		case PICOMMS_UINT32:
+			*(Luint32 *)pvDest = puValue->u32;
+			break;
+		case PICOMMS_FLOAT:
+			*(Lfloat32 *)pvDest = puValue->f32;
+			break;
+		case PICOMMS_DOUBLE:
+			*(Lfloat64 *)pvDest = puValue->f64;
+			break;
+		default:
+			*(Luint64 *)pvDest = puValue->u64;
+			break;
+	}
+}
 
-					position += dataSize+3;
-				}
-				break;
+/***************************************************************************//**
+ * @brief
+ * Register a nodes receive table. Params in the table are written straight
+ * to their destination and a single commit callback is made per frame,
+ * anything else still goes to the typed callbacks.
+ *
+ * @param[in]		pTable					Table, sorted by index, no duplicates
+ * @param[in]		u16Size					Number of entries
+ * @param[in]		pCommitCB				Called once per applied frame, may be 0
+ */
+void vPICOMMS_RX__Register_Table(const PICOMMS_RX_PARAM_T *pTable, Luint16 u16Size, void (*pCommitCB)(void))
+{
+	Luint16 u16Counter;
+	Luint8 u8Valid;
 
-			case RPOD_PICOMMS_FRAME_END:
-				if (PICOMMS_RX_frameRXEndCB != 0)
-				{
-					PICOMMS_RX_frameRXEndCB();
-				}
-				return 1;
-			}
-		}
-		else
+	u8Valid = 1U;
+	if((pTable == 0) || (u16Size > C_PICOMMS_RX__MAX_TABLE))
+	{
+		u8Valid = 0U;
+	}
+	else
+	{
+		//the lookup is a binary search so the order must be strict
+		for(u16Counter = 1U; u16Counter < u16Size; u16Counter++)
 		{
-			//Should report an error
-			position++;
+			if(pTable[u16Counter].u16Index <= pTable[u16Counter - 1U].u16Index)
+			{
+				u8Valid = 0U;
+			}
+			else
+			{
+				//in order
+			}
 		}
 	}
 
-	if(PICOMMS_RX_frameRXEndCB != 0)
+	if(u8Valid == 1U)
 	{
-		PICOMMS_RX_frameRXEndCB();
+		sPC.sRx.pTable = pTable;
+		sPC.sRx.u16TableSize = u16Size;
+		sPC.sRx.pCommitCB = pCommitCB;
+	}
+	else
+	{
+		//leave the old table in place
+		sPC.sRx.u32TableFaults++;
+	}
+}
 
+/***************************************************************************//**
+ * @brief
+ * Was a table slot written by the last applied frame, for use in the
+ * commit callback.
+ *
+ * @param[in]		u16Slot					Table slot
+ * @return			1 = updated
+ */
+Luint8 u8PICOMMS_RX__Was_Updated(Luint16 u16Slot)
+{
+	Luint8 u8Return;
+
+	if(u16Slot < C_PICOMMS_RX__MAX_TABLE)
+	{
+		u8Return = (Luint8)((sPC.sRx.u32UpdateMask[u16Slot >> 5U] >> (u16Slot & 0x1FU)) & 0x01U);
 	}
 	else
 	{
-		//No callback to make
+		u8Return = 0U;
 	}
-		return 1;
+
+	return u8Return;
+}
+
+Luint32 u32PICOMMS_RX__Get_Frames(void)
+{
+	return sPC.sRx.u32Frames;
+}
+
+Luint32 u32PICOMMS_RX__Get_Resyncs(void)
+{
+	return sPC.sRx.u32Resyncs;
 }
 
+Luint32 u32PICOMMS_RX__Get_ChecksumFaults(void)
+{
+	return sPC.sRx.u32ChecksumFaults;
+}
+
+Luint32 u32PICOMMS_RX__Get_DroppedBytes(void)
+{
+	return sPC.sRx.u32DroppedBytes;
+}
 
+Luint32 u32PICOMMS_RX__Get_RejectedFrames(void)
+{
+	return sPC.sRx.u32RejectedFrames;
+}
 
+Luint32 u32PICOMMS_RX__Get_TableFaults(void)
+{
+	return sPC.sRx.u32TableFaults;
+}
 
 void vPICOMMS_RX__ReceiveParam(Luint8 u8Type, Luint16 u16Index, Luint64 u64RawData)
 {
@@ -25,7 +25,11 @@ extern struct _strPICOMMS sPC;
 
 void vPICOMMS_TX__Init(void)
 {
+	//init the transmit queue before the encoder that writes into it
+	vPICOMMS_TXQ__Init();
 
+	//init the zero shift encoder
+	vPICOMMS_ENC__Init();
 }
 
 void PICOMMS_TX_beginFrame()
@@ -51,7 +55,7 @@ void PICOMMS_TX_calculateChecksum(Luint16 lastByte)
 void PICOMMS_TX_add_checked_byte(Luint8 byte)
 {
 
-	if(sPC.sTx.PICOMMS_TX_bufferPos < (RPOD_PICOMMS_BUFFER_SIZE - 2))
+	if(sPC.sTx.PICOMMS_TX_bufferPos < (C_LOCALDEF__LCCM656__TX_FRAME_SIZE - 2))
 	{
 		sPC.sTx.PICOMMS_TX_buffer[sPC.sTx.PICOMMS_TX_bufferPos++] = byte;
 
@@ -64,7 +68,7 @@ void PICOMMS_TX_add_checked_byte(Luint8 byte)
 
 void PICOMMS_TX_add_unchecked_byte(Luint8 byte)
 {
-	if(sPC.sTx.PICOMMS_TX_bufferPos < (RPOD_PICOMMS_BUFFER_SIZE - 2))
+	if(sPC.sTx.PICOMMS_TX_bufferPos < (C_LOCALDEF__LCCM656__TX_FRAME_SIZE - 2))
 	{
 		sPC.sTx.PICOMMS_TX_buffer[sPC.sTx.PICOMMS_TX_bufferPos++] = byte;
 	}
@@ -0,0 +1,1314 @@
+/**
+ * @file		PI_COMMS__TX__ENCODER.C
+ * @brief		Zero shift, table driven frame encoder from host to Pi.
+ * @note
+ * Produces exactly the same frame format as PI_COMMS__TX.C but:
+ * 1. Reserves the worst case header up front so the buffer is never shifted
+ * 2. Keeps a running XOR so there is no second pass for the checksum
+ * 3. Checks 4 bytes at a time for the control char instead of per byte
+ * 4. Supports precompiled templates so only the payload is serialised
+ * 5. Template frames can be sent as deltas, only params that have moved
+ *    outside their deadband are sent with a full keyframe every N frames
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM656R0.FILE.007
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PI_COMMS
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PI_COMMS__TX_ENCODER
+ * @ingroup PI_COMMS
+ * @{ */
+
+#include "../pi_comms.h"
+#if C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE == 1U
+
+//the main structure
+extern struct _strPICOMMS sPC;
+
+/** Local copy of the write cursor */
+struct _strPICOMMS_ENC_CURSOR
+{
+	/** Base of the transmit buffer */
+	Luint8 *pu8Buffer;
+
+	/** Write position */
+	Luint16 u16Pos;
+
+	/** Running XOR */
+	Luint8 u8Checksum;
+};
+
+//locals
+static Luint8 u8PICOMMS_ENC__Reserve(struct _strPICOMMS_ENC_CURSOR *pC, Luint16 u16Bytes);
+static void vPICOMMS_ENC__Commit(const struct _strPICOMMS_ENC_CURSOR *pC);
+static void vPICOMMS_ENC__Write_Escaped(struct _strPICOMMS_ENC_CURSOR *pC, Luint8 u8Byte);
+static void vPICOMMS_ENC__Write_Word(struct _strPICOMMS_ENC_CURSOR *pC, Luint32 u32Word);
+static void vPICOMMS_ENC__Write_Header(struct _strPICOMMS_ENC_CURSOR *pC, Luint8 u8Type, Luint16 u16Index);
+static void vPICOMMS_ENC__Write_Slot(struct _strPICOMMS_ENC_CURSOR *pC, Luint8 u8Type);
+static Luint8 u8PICOMMS_ENC__Delta_Skip_Int(Luint8 u8Type, Lint64 s64Value);
+static Luint8 u8PICOMMS_ENC__Delta_Skip_Float(Luint8 u8Type, Lfloat64 f64Value);
+static void vPICOMMS_ENC__Delta_Skipped(void);
+
+/** Control char replicated into each byte lane */
+#define C_PICOMMS_ENC__CTRL_WORD				(0xD5D5D5D5U)
+
+/** Payload worst case for a 64bit param, every byte escaped */
+#define C_PICOMMS_ENC__MAX_PAYLOAD				(16U)
+
+/***************************************************************************//**
+ * @brief
+ * Init the encoder
+ *
+ */
+void vPICOMMS_ENC__Init(void)
+{
+	//until the first frame is started
+	sPC.sTx.sEnc.pu8Buffer = &sPC.sTx.PICOMMS_TX_buffer[0];
+	sPC.sTx.sEnc.u16Pos = C_PICOMMS_ENC__HEADER_RESERVE;
+	sPC.sTx.sEnc.u8Checksum = 0U;
+	sPC.sTx.sEnc.u16FrameStart = 0U;
+	sPC.sTx.sEnc.u16FrameLength = 0U;
+	sPC.sTx.sEnc.pTemplate = 0;
+	sPC.sTx.sEnc.u16Slot = 0U;
+	sPC.sTx.sEnc.u32Overflows = 0U;
+	sPC.sTx.sEnc.u32TemplateFaults = 0U;
+
+	//delta mode, the first delta frame is always a keyframe
+	sPC.sTx.sDelta.u8Active = 0U;
+	sPC.sTx.sDelta.u8Keyframe = 0U;
+	sPC.sTx.sDelta.u8ForceKeyframe = 1U;
+	sPC.sTx.sDelta.pTemplate = 0;
+	sPC.sTx.sDelta.u16KeyframePeriod = C_PICOMMS_DELTA__DEFAULT_KEYFRAME;
+	sPC.sTx.sDelta.u16FramesSinceKey = 0U;
+	sPC.sTx.sDelta.u16KeyframeInterval = 0U;
+	sPC.sTx.sDelta.u32BytesSaved = 0U;
+	sPC.sTx.sDelta.u32Keyframes = 0U;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Start a new frame. The header is not written until the end, the payload
+ * is written straight after the reserved header space.
+ *
+ */
+void vPICOMMS_ENC__Begin_Frame(void)
+{
+	//write straight into the next free queue buffer
+	sPC.sTx.sEnc.pu8Buffer = pu8PICOMMS_TXQ__Acquire();
+
+	//start the payload after the worst case header
+	sPC.sTx.sEnc.u16Pos = C_PICOMMS_ENC__HEADER_RESERVE;
+
+	//clear the running checksum
+	sPC.sTx.sEnc.u8Checksum = 0U;
+
+	//no template unless the user starts one
+	sPC.sTx.sEnc.pTemplate = 0;
+	sPC.sTx.sEnc.u16Slot = 0U;
+
+	//full frame unless the user starts a delta
+	sPC.sTx.sDelta.u8Active = 0U;
+	sPC.sTx.sDelta.u8Keyframe = 0U;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Start a new frame using a precompiled template.
+ * Call the vPICOMMS_ENC__Next_xxx functions in template order.
+ *
+ * @param[in]		pTemplate				A template from vPICOMMS_TEMPLATE__Compile
+ */
+void vPICOMMS_ENC__Begin_Template(const struct _strPICOMMS_TEMPLATE *pTemplate)
+{
+	//normal frame setup
+	vPICOMMS_ENC__Begin_Frame();
+
+	//attach the template
+	sPC.sTx.sEnc.pTemplate = pTemplate;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Start a new delta frame using a precompiled template.
+ * Call the vPICOMMS_ENC__Next_xxx functions in template order as normal, any
+ * param still inside its deadband of the last sent value is left out.
+ * Every keyframe period, on a template change or after a forced keyframe
+ * all params are sent so the Pi can resync.
+ *
+ * @param[in]		pTemplate				A template from vPICOMMS_TEMPLATE__Compile
+ */
+void vPICOMMS_ENC__Begin_Delta(const struct _strPICOMMS_TEMPLATE *pTemplate)
+{
+	//normal template setup
+	vPICOMMS_ENC__Begin_Template(pTemplate);
+
+	//the shadows only make sense against the template they came from
+	if(pTemplate != sPC.sTx.sDelta.pTemplate)
+	{
+		sPC.sTx.sDelta.pTemplate = pTemplate;
+		sPC.sTx.sDelta.u8ForceKeyframe = 1U;
+	}
+	else
+	{
+		//same template
+	}
+
+	if((sPC.sTx.sDelta.u8ForceKeyframe == 1U) || (sPC.sTx.sDelta.u16FramesSinceKey >= sPC.sTx.sDelta.u16KeyframePeriod))
+	{
+		//keyframe, every param is sent and reloads its shadow
+		sPC.sTx.sDelta.u8Keyframe = 1U;
+		sPC.sTx.sDelta.u8ForceKeyframe = 0U;
+		sPC.sTx.sDelta.u16KeyframeInterval = sPC.sTx.sDelta.u16FramesSinceKey;
+		sPC.sTx.sDelta.u16FramesSinceKey = 0U;
+		sPC.sTx.sDelta.u32Keyframes++;
+	}
+	else
+	{
+		sPC.sTx.sDelta.u8Keyframe = 0U;
+	}
+
+	//count this frame towards the next keyframe
+	sPC.sTx.sDelta.u16FramesSinceKey++;
+
+	if(pTemplate != 0)
+	{
+		sPC.sTx.sDelta.u8Active = 1U;
+	}
+	else
+	{
+		//nothing to delta against, Next_xxx will count template faults
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Set the number of frames between keyframes.
+ *
+ * @param[in]		u16Frames				Keyframe period, 1 = every frame is a keyframe
+ */
+void vPICOMMS_ENC__Set_KeyframePeriod(Luint16 u16Frames)
+{
+	if(u16Frames == 0U)
+	{
+		//zero would never send a delta, treat as every frame
+		sPC.sTx.sDelta.u16KeyframePeriod = 1U;
+	}
+	else
+	{
+		sPC.sTx.sDelta.u16KeyframePeriod = u16Frames;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Make the next delta frame a keyframe, i.e. if we know the Pi has lost sync.
+ *
+ */
+void vPICOMMS_ENC__Force_Keyframe(void)
+{
+	sPC.sTx.sDelta.u8ForceKeyframe = 1U;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Is the current delta frame a keyframe
+ *
+ * @return			1 = keyframe
+ */
+Luint8 u8PICOMMS_ENC__Is_Keyframe(void)
+{
+	return sPC.sTx.sDelta.u8Keyframe;
+}
+
+Luint32 u32PICOMMS_ENC__Get_BytesSaved(void)
+{
+	return sPC.sTx.sDelta.u32BytesSaved;
+}
+
+Luint32 u32PICOMMS_ENC__Get_Keyframes(void)
+{
+	return sPC.sTx.sDelta.u32Keyframes;
+}
+
+Luint16 u16PICOMMS_ENC__Get_KeyframeInterval(void)
+{
+	return sPC.sTx.sDelta.u16KeyframeInterval;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Finish the frame, the length is written into the reserved header space
+ * right aligned against the payload and the trailer appended.
+ *
+ * @return			The total frame length in bytes
+ */
+Luint16 u16PICOMMS_ENC__End_Frame(void)
+{
+	Luint16 u16Length;
+	Luint16 u16Start;
+	Luint8 u8Length1;
+	Luint8 u8Length2;
+	Luint8 u8Checksum;
+	Luint8 *pu8Buffer;
+
+	//check the caller used the whole template
+	if(sPC.sTx.sEnc.pTemplate != 0)
+	{
+		if(sPC.sTx.sEnc.u16Slot != sPC.sTx.sEnc.pTemplate->u16NumParams)
+		{
+			sPC.sTx.sEnc.u32TemplateFaults++;
+		}
+		else
+		{
+			//all good
+		}
+	}
+	else
+	{
+		//no template
+	}
+
+	pu8Buffer = sPC.sTx.sEnc.pu8Buffer;
+	if(pu8Buffer != 0)
+	{
+		//the length field covers the 4 byte un-escaped header plus the payload
+		u16Length = (sPC.sTx.sEnc.u16Pos - C_PICOMMS_ENC__HEADER_RESERVE) + 4U;
+		u8Length1 = (Luint8)(u16Length >> 8U);
+		u8Length2 = (Luint8)(u16Length & 0xFFU);
+
+		//work backwards from the end of the reserved space
+		u16Start = C_PICOMMS_ENC__HEADER_RESERVE;
+
+		//the checksum is the XOR of the bytes on the wire, same as the payload
+		//an escaped length byte goes out as a pair that cancels
+		u8Checksum = sPC.sTx.sEnc.u8Checksum;
+
+		//low byte, escaped if needed
+		u16Start--;
+		pu8Buffer[u16Start] = u8Length2;
+		if(u8Length2 == RPOD_PICOMMS_CONTROL_CHAR)
+		{
+			u16Start--;
+			pu8Buffer[u16Start] = u8Length2;
+		}
+		else
+		{
+			u8Checksum ^= u8Length2;
+		}
+
+		//high byte, escaped if needed
+		u16Start--;
+		pu8Buffer[u16Start] = u8Length1;
+		if(u8Length1 == RPOD_PICOMMS_CONTROL_CHAR)
+		{
+			u16Start--;
+			pu8Buffer[u16Start] = u8Length1;
+		}
+		else
+		{
+			u8Checksum ^= u8Length1;
+		}
+
+		//SOF
+		u16Start--;
+		pu8Buffer[u16Start] = RPOD_PICOMMS_FRAME_START;
+		u16Start--;
+		pu8Buffer[u16Start] = RPOD_PICOMMS_CONTROL_CHAR;
+		u8Checksum ^= RPOD_PICOMMS_CONTROL_CHAR;
+		u8Checksum ^= RPOD_PICOMMS_FRAME_START;
+
+		//trailer, we always reserve room for this when adding params
+		pu8Buffer[sPC.sTx.sEnc.u16Pos] = RPOD_PICOMMS_CONTROL_CHAR;
+		pu8Buffer[sPC.sTx.sEnc.u16Pos + 1U] = RPOD_PICOMMS_FRAME_END;
+		pu8Buffer[sPC.sTx.sEnc.u16Pos + 2U] = u8Checksum;
+		pu8Buffer[sPC.sTx.sEnc.u16Pos + 3U] = 0x00U;
+
+		//save off
+		sPC.sTx.sEnc.u16FrameStart = u16Start;
+		sPC.sTx.sEnc.u16FrameLength = (sPC.sTx.sEnc.u16Pos + C_PICOMMS_ENC__TRAILER_SIZE) - u16Start;
+	}
+	else
+	{
+		//dropped, there was no queue buffer
+		sPC.sTx.sEnc.u16FrameStart = 0U;
+		sPC.sTx.sEnc.u16FrameLength = 0U;
+	}
+
+	return sPC.sTx.sEnc.u16FrameLength;
+}
+
+/***************************************************************************//**
+ * @brief
+ * End the frame and hand it to the transmit queue, the DMA side picks it
+ * up with pu8PICOMMS_TXQ__Start_Next().
+ *
+ */
+void vPICOMMS_ENC__Queue_Frame(void)
+{
+	Luint16 u16Length;
+
+	u16Length = u16PICOMMS_ENC__End_Frame();
+	vPICOMMS_TXQ__Push(sPC.sTx.sEnc.u16FrameStart, u16Length);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the start of the last ended frame, use this for the DMA instead of
+ * pu8I2CTx__Get_BufferPointer() as the frame may not start at zero, or
+ * use vPICOMMS_ENC__Queue_Frame() instead.
+ *
+ * @return			Pointer to the SOF, 0 if the frame was dropped
+ */
+Luint8 * pu8PICOMMS_ENC__Get_FramePointer(void)
+{
+	Luint8 *pu8Return;
+
+	if(sPC.sTx.sEnc.pu8Buffer != 0)
+	{
+		pu8Return = &sPC.sTx.sEnc.pu8Buffer[sPC.sTx.sEnc.u16FrameStart];
+	}
+	else
+	{
+		pu8Return = 0;
+	}
+
+	return pu8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Build a template from a list of index/type pairs. The param headers are
+ * escaped here once rather than on every frame. A template whose worst case
+ * frame, every payload byte escaped, is bigger than a transmit queue buffer
+ * is counted as a template fault, params off the end would be dropped.
+ *
+ * @param[out]		pTemplate				The template to fill
+ * @param[in]		pParams					List of params in transmit order
+ * @param[in]		u16NumParams			Number of entries in pParams
+ */
+void vPICOMMS_TEMPLATE__Compile(struct _strPICOMMS_TEMPLATE *pTemplate, const PICOMMS_TEMPLATE_PARAM_T *pParams, Luint16 u16NumParams)
+{
+	Luint16 u16Counter;
+	Luint8 u8Length;
+	Luint8 u8XOR;
+	Luint8 u8Byte;
+	Luint32 u32Worst;
+
+	//clamp to our storage
+	if(u16NumParams > C_PICOMMS_TEMPLATE__MAX_PARAMS)
+	{
+		u16NumParams = C_PICOMMS_TEMPLATE__MAX_PARAMS;
+	}
+	else
+	{
+		//fine
+	}
+
+	u32Worst = (Luint32)C_PICOMMS_ENC__HEADER_RESERVE + (Luint32)C_PICOMMS_ENC__TRAILER_SIZE;
+	for(u16Counter = 0U; u16Counter < u16NumParams; u16Counter++)
+	{
+		u8Length = 0U;
+
+		//control + param start, never escaped
+		pTemplate->sSlot[u16Counter].u8Header[u8Length] = RPOD_PICOMMS_CONTROL_CHAR;
+		u8Length++;
+		pTemplate->sSlot[u16Counter].u8Header[u8Length] = RPOD_PICOMMS_PARAMETER_START;
+		u8Length++;
+
+		//type, none of the types collide with the control char
+		pTemplate->sSlot[u16Counter].u8Header[u8Length] = pParams[u16Counter].u8Type;
+		u8Length++;
+
+		//checksum over the header as sent, escaped pairs cancel
+		u8XOR = RPOD_PICOMMS_CONTROL_CHAR;
+		u8XOR ^= RPOD_PICOMMS_PARAMETER_START;
+		u8XOR ^= pParams[u16Counter].u8Type;
+
+		//index high
+		u8Byte = (Luint8)(pParams[u16Counter].u16Index >> 8U);
+		pTemplate->sSlot[u16Counter].u8Header[u8Length] = u8Byte;
+		u8Length++;
+		if(u8Byte == RPOD_PICOMMS_CONTROL_CHAR)
+		{
+			pTemplate->sSlot[u16Counter].u8Header[u8Length] = u8Byte;
+			u8Length++;
+		}
+		else
+		{
+			u8XOR ^= u8Byte;
+		}
+
+		//index low
+		u8Byte = (Luint8)(pParams[u16Counter].u16Index & 0xFFU);
+		pTemplate->sSlot[u16Counter].u8Header[u8Length] = u8Byte;
+		u8Length++;
+		if(u8Byte == RPOD_PICOMMS_CONTROL_CHAR)
+		{
+			pTemplate->sSlot[u16Counter].u8Header[u8Length] = u8Byte;
+			u8Length++;
+		}
+		else
+		{
+			u8XOR ^= u8Byte;
+		}
+
+		//save off
+		pTemplate->sSlot[u16Counter].u8HeaderLength = u8Length;
+		pTemplate->sSlot[u16Counter].u8HeaderXOR = u8XOR;
+		pTemplate->sSlot[u16Counter].u8Type = pParams[u16Counter].u8Type;
+		pTemplate->sSlot[u16Counter].u16Index = pParams[u16Counter].u16Index;
+		pTemplate->sSlot[u16Counter].f32Deadband = pParams[u16Counter].f32Deadband;
+
+		//the type's top nibble is its size in bytes
+		u32Worst += (Luint32)u8Length + ((Luint32)(pParams[u16Counter].u8Type >> 4U) * 2U);
+	}
+
+	pTemplate->u16NumParams = u16NumParams;
+
+	if(u32Worst > (Luint32)C_LOCALDEF__LCCM656__TX_FRAME_SIZE)
+	{
+		sPC.sTx.sEnc.u32TemplateFaults++;
+	}
+	else
+	{
+		//fits
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Template slots out of step with the caller, or a template too big for a
+ * transmit queue buffer
+ *
+ * @return			Faults seen
+ */
+Luint32 u32PICOMMS_ENC__Get_TemplateFaults(void)
+{
+	return sPC.sTx.sEnc.u32TemplateFaults;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Load the write cursor into a local so the compiler can keep it in registers,
+ * byte stores into the buffer would otherwise force a reload every byte.
+ * Also checks there is room for a worst case write plus the trailer.
+ *
+ * @param[out]		pC						The local cursor
+ * @param[in]		u16Bytes				Worst case bytes about to be written
+ * @return			1 = room available, 0 = no room, the overflow is counted
+ */
+static Luint8 u8PICOMMS_ENC__Reserve(struct _strPICOMMS_ENC_CURSOR *pC, Luint16 u16Bytes)
+{
+	Luint8 u8Return;
+	Luint32 u32End;
+
+	//take a copy
+	pC->pu8Buffer = sPC.sTx.sEnc.pu8Buffer;
+	pC->u16Pos = sPC.sTx.sEnc.u16Pos;
+	pC->u8Checksum = sPC.sTx.sEnc.u8Checksum;
+
+	u32End = (Luint32)pC->u16Pos + (Luint32)u16Bytes + (Luint32)C_PICOMMS_ENC__TRAILER_SIZE;
+	if(pC->pu8Buffer == 0)
+	{
+		//no queue buffer, Push() counts the frame as dropped
+		u8Return = 0U;
+	}
+	else if(u32End <= (Luint32)C_LOCALDEF__LCCM656__TX_FRAME_SIZE)
+	{
+		u8Return = 1U;
+	}
+	else
+	{
+		//drop the whole param rather than truncate it
+		sPC.sTx.sEnc.u32Overflows++;
+
+		//a delta shadow may now be ahead of the Pi
+		sPC.sTx.sDelta.u8ForceKeyframe = 1U;
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Write the local cursor back once the param is complete.
+ *
+ * @param[in]		pC						The local cursor
+ */
+static void vPICOMMS_ENC__Commit(const struct _strPICOMMS_ENC_CURSOR *pC)
+{
+	sPC.sTx.sEnc.u16Pos = pC->u16Pos;
+	sPC.sTx.sEnc.u8Checksum = pC->u8Checksum;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Write one payload byte, escaping the control char.
+ *
+ * @param[in]		pC						The local cursor
+ * @param[in]		u8Byte					The byte
+ */
+static void vPICOMMS_ENC__Write_Escaped(struct _strPICOMMS_ENC_CURSOR *pC, Luint8 u8Byte)
+{
+	Luint16 u16Pos;
+
+	//byte stores alias the cursor, so work on a local position
+	u16Pos = pC->u16Pos;
+	pC->pu8Buffer[u16Pos] = u8Byte;
+	u16Pos++;
+
+	if(u8Byte == RPOD_PICOMMS_CONTROL_CHAR)
+	{
+		//escaped pair, XOR of the pair is zero so the checksum is unchanged
+		pC->pu8Buffer[u16Pos] = u8Byte;
+		u16Pos++;
+	}
+	else
+	{
+		pC->u8Checksum ^= u8Byte;
+	}
+
+	pC->u16Pos = u16Pos;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Write a 32bit word big endian. The whole word is tested for the control
+ * char in one go, only if a lane matches do we drop to the byte path.
+ *
+ * @param[in]		pC						The local cursor
+ * @param[in]		u32Word					The word
+ */
+static void vPICOMMS_ENC__Write_Word(struct _strPICOMMS_ENC_CURSOR *pC, Luint32 u32Word)
+{
+	Luint32 u32Test;
+	Luint32 u32Fold;
+	Luint8 *pu8Dest;
+
+	//any lane that equals the control char becomes zero
+	u32Test = u32Word ^ C_PICOMMS_ENC__CTRL_WORD;
+
+	//classic has-zero-byte test, exact for the has/has not decision
+	u32Test = (u32Test - 0x01010101U) & (~u32Test) & 0x80808080U;
+
+	if(u32Test == 0U)
+	{
+		//fast path, no escaping needed
+		pu8Dest = &pC->pu8Buffer[pC->u16Pos];
+		pu8Dest[0] = (Luint8)(u32Word >> 24U);
+		pu8Dest[1] = (Luint8)(u32Word >> 16U);
+		pu8Dest[2] = (Luint8)(u32Word >> 8U);
+		pu8Dest[3] = (Luint8)(u32Word);
+		pC->u16Pos += 4U;
+
+		//fold the 4 lanes into one for the checksum
+		u32Fold = u32Word ^ (u32Word >> 16U);
+		u32Fold ^= (u32Fold >> 8U);
+		pC->u8Checksum ^= (Luint8)(u32Fold & 0xFFU);
+	}
+	else
+	{
+		//slow path, at least one lane needs escaping
+		vPICOMMS_ENC__Write_Escaped(pC, (Luint8)(u32Word >> 24U));
+		vPICOMMS_ENC__Write_Escaped(pC, (Luint8)(u32Word >> 16U));
+		vPICOMMS_ENC__Write_Escaped(pC, (Luint8)(u32Word >> 8U));
+		vPICOMMS_ENC__Write_Escaped(pC, (Luint8)(u32Word));
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Build a param header on the fly, used when there is no template.
+ *
+ * @param[in]		pC						The local cursor
+ * @param[in]		u8Type					Param type
+ * @param[in]		u16Index				Param index
+ */
+static void vPICOMMS_ENC__Write_Header(struct _strPICOMMS_ENC_CURSOR *pC, Luint8 u8Type, Luint16 u16Index)
+{
+	Luint8 *pu8Dest;
+
+	//control char is never escaped here, param start and type never collide with it
+	pu8Dest = &pC->pu8Buffer[pC->u16Pos];
+	pu8Dest[0] = RPOD_PICOMMS_CONTROL_CHAR;
+	pu8Dest[1] = RPOD_PICOMMS_PARAMETER_START;
+	pu8Dest[2] = u8Type;
+	pC->u16Pos += 3U;
+	pC->u8Checksum ^= (Luint8)(RPOD_PICOMMS_CONTROL_CHAR ^ RPOD_PICOMMS_PARAMETER_START ^ u8Type);
+
+	//the index is checked
+	vPICOMMS_ENC__Write_Escaped(pC, (Luint8)(u16Index >> 8U));
+	vPICOMMS_ENC__Write_Escaped(pC, (Luint8)(u16Index & 0xFFU));
+}
+
+/***************************************************************************//**
+ * @brief
+ * Copy the next precompiled header from the active template.
+ *
+ * @param[in]		pC						The local cursor
+ * @param[in]		u8Type					The type the caller is about to write
+ */
+static void vPICOMMS_ENC__Write_Slot(struct _strPICOMMS_ENC_CURSOR *pC, Luint8 u8Type)
+{
+	const struct _strPICOMMS_TEMPLATE *pTemplate;
+	Luint8 u8Counter;
+	Luint8 u8Length;
+	Luint16 u16Slot;
+	Luint8 *pu8Dest;
+
+	pTemplate = sPC.sTx.sEnc.pTemplate;
+	u16Slot = sPC.sTx.sEnc.u16Slot;
+
+	if(pTemplate == 0)
+	{
+		//Next_xxx without Begin_Template
+		sPC.sTx.sEnc.u32TemplateFaults++;
+		vPICOMMS_ENC__Write_Header(pC, u8Type, 0xFFFFU);
+	}
+	else if(u16Slot < pTemplate->u16NumParams)
+	{
+		if(pTemplate->sSlot[u16Slot].u8Type == u8Type)
+		{
+			//straight copy of the escaped header
+			u8Length = pTemplate->sSlot[u16Slot].u8HeaderLength;
+			pu8Dest = &pC->pu8Buffer[pC->u16Pos];
+			for(u8Counter = 0U; u8Counter < u8Length; u8Counter++)
+			{
+				pu8Dest[u8Counter] = pTemplate->sSlot[u16Slot].u8Header[u8Counter];
+			}
+			pC->u16Pos += u8Length;
+			pC->u8Checksum ^= pTemplate->sSlot[u16Slot].u8HeaderXOR;
+		}
+		else
+		{
+			//caller is out of step with the template, keep the frame valid
+			//by building the header with the callers type
+			sPC.sTx.sEnc.u32TemplateFaults++;
+			vPICOMMS_ENC__Write_Header(pC, u8Type, pTemplate->sSlot[u16Slot].u16Index);
+		}
+	}
+	else
+	{
+		//more params than the template, nothing sensible we can index with
+		sPC.sTx.sEnc.u32TemplateFaults++;
+		vPICOMMS_ENC__Write_Header(pC, u8Type, 0xFFFFU);
+	}
+
+	sPC.sTx.sEnc.u16Slot++;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Delta mode check for an integer param. If the param is inside its deadband
+ * it is skipped, otherwise its shadow is updated and the caller sends it.
+ *
+ * @param[in]		u8Type					The type the caller is about to write
+ * @param[in]		s64Value				The value, all our integer types fit
+ * @return			1 = skip the param, 0 = send it
+ */
+static Luint8 u8PICOMMS_ENC__Delta_Skip_Int(Luint8 u8Type, Lint64 s64Value)
+{
+	Luint8 u8Return;
+	Luint16 u16Slot;
+	Lint64 s64Diff;
+
+	u8Return = 0U;
+	u16Slot = sPC.sTx.sEnc.u16Slot;
+
+	//out of step params are always sent and left to Write_Slot to count
+	if((sPC.sTx.sDelta.u8Active == 1U) && (u16Slot < sPC.sTx.sEnc.pTemplate->u16NumParams) &&
+		(sPC.sTx.sEnc.pTemplate->sSlot[u16Slot].u8Type == u8Type))
+	{
+		if(sPC.sTx.sDelta.u8Keyframe == 0U)
+		{
+			s64Diff = s64Value - sPC.sTx.sDelta.uShadow[u16Slot].s64;
+			if(s64Diff < 0)
+			{
+				s64Diff = -s64Diff;
+			}
+			else
+			{
+				//fall on
+			}
+
+			if((Lfloat64)s64Diff <= (Lfloat64)sPC.sTx.sEnc.pTemplate->sSlot[u16Slot].f32Deadband)
+			{
+				u8Return = 1U;
+			}
+			else
+			{
+				//moved
+			}
+		}
+		else
+		{
+			//keyframe, always send
+		}
+
+		if(u8Return == 1U)
+		{
+			vPICOMMS_ENC__Delta_Skipped();
+		}
+		else
+		{
+			sPC.sTx.sDelta.uShadow[u16Slot].s64 = s64Value;
+		}
+	}
+	else
+	{
+		//full frame
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Delta mode check for a floating point param. NaN always compares as moved
+ * so it is always sent.
+ *
+ * @param[in]		u8Type					The type the caller is about to write
+ * @param[in]		f64Value				The value
+ * @return			1 = skip the param, 0 = send it
+ */
+static Luint8 u8PICOMMS_ENC__Delta_Skip_Float(Luint8 u8Type, Lfloat64 f64Value)
+{
+	Luint8 u8Return;
+	Luint16 u16Slot;
+	Lfloat64 f64Diff;
+
+	u8Return = 0U;
+	u16Slot = sPC.sTx.sEnc.u16Slot;
+
+	if((sPC.sTx.sDelta.u8Active == 1U) && (u16Slot < sPC.sTx.sEnc.pTemplate->u16NumParams) &&
+		(sPC.sTx.sEnc.pTemplate->sSlot[u16Slot].u8Type == u8Type))
+	{
+		if(sPC.sTx.sDelta.u8Keyframe == 0U)
+		{
+			f64Diff = f64Value - sPC.sTx.sDelta.uShadow[u16Slot].f64;
+			if(f64Diff < 0.0)
+			{
+				f64Diff = -f64Diff;
+			}
+			else
+			{
+				//fall on
+			}
+
+			if(f64Diff <= (Lfloat64)sPC.sTx.sEnc.pTemplate->sSlot[u16Slot].f32Deadband)
+			{
+				u8Return = 1U;
+			}
+			else
+			{
+				//moved
+			}
+		}
+		else
+		{
+			//keyframe, always send
+		}
+
+		if(u8Return == 1U)
+		{
+			vPICOMMS_ENC__Delta_Skipped();
+		}
+		else
+		{
+			sPC.sTx.sDelta.uShadow[u16Slot].f64 = f64Value;
+		}
+	}
+	else
+	{
+		//full frame
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Account for a skipped delta param and move on to the next template slot.
+ *
+ */
+static void vPICOMMS_ENC__Delta_Skipped(void)
+{
+	const struct _strPICOMMS_TEMPLATE *pTemplate;
+	Luint16 u16Slot;
+
+	pTemplate = sPC.sTx.sEnc.pTemplate;
+	u16Slot = sPC.sTx.sEnc.u16Slot;
+
+	//header plus the un-escaped payload, the upper nibble of the type is the size
+	sPC.sTx.sDelta.u32BytesSaved += (Luint32)pTemplate->sSlot[u16Slot].u8HeaderLength + (Luint32)(pTemplate->sSlot[u16Slot].u8Type >> 4U);
+
+	//keep in step with the template
+	sPC.sTx.sEnc.u16Slot++;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Add params with an explicit index
+ *
+ * @param[in]		u16Index				Param index
+ * @param[in]		xValue					Value to send
+ */
+void vPICOMMS_ENC__Add_U8(Luint16 u16Index, Luint8 u8Value)
+{
+	Luint8 u8Test;
+	struct _strPICOMMS_ENC_CURSOR sC;
+
+	u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + 2U);
+	if(u8Test == 1U)
+	{
+		vPICOMMS_ENC__Write_Header(&sC, (Luint8)PICOMMS_UINT8, u16Index);
+		vPICOMMS_ENC__Write_Escaped(&sC, u8Value);
+		vPICOMMS_ENC__Commit(&sC);
+	}
+	else
+	{
+		//overflow counted
+	}
+}
+
+void vPICOMMS_ENC__Add_S8(Luint16 u16Index, Lint8 s8Value)
+{
+	Luint8 u8Test;
+	struct _strPICOMMS_ENC_CURSOR sC;
+
+	u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + 2U);
+	if(u8Test == 1U)
+	{
+		vPICOMMS_ENC__Write_Header(&sC, (Luint8)PICOMMS_INT8, u16Index);
+		vPICOMMS_ENC__Write_Escaped(&sC, (Luint8)s8Value);
+		vPICOMMS_ENC__Commit(&sC);
+	}
+	else
+	{
+		//overflow counted
+	}
+}
+
+void vPICOMMS_ENC__Add_U16(Luint16 u16Index, Luint16 u16Value)
+{
+	Luint8 u8Test;
+	struct _strPICOMMS_ENC_CURSOR sC;
+
+	u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + 4U);
+	if(u8Test == 1U)
+	{
+		vPICOMMS_ENC__Write_Header(&sC, (Luint8)PICOMMS_UINT16, u16Index);
+		vPICOMMS_ENC__Write_Escaped(&sC, (Luint8)(u16Value >> 8U));
+		vPICOMMS_ENC__Write_Escaped(&sC, (Luint8)(u16Value & 0xFFU));
+		vPICOMMS_ENC__Commit(&sC);
+	}
+	else
+	{
+		//overflow counted
+	}
+}
+
+void vPICOMMS_ENC__Add_S16(Luint16 u16Index, Lint16 s16Value)
+{
+	Luint8 u8Test;
+	struct _strPICOMMS_ENC_CURSOR sC;
+
+	u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + 4U);
+	if(u8Test == 1U)
+	{
+		vPICOMMS_ENC__Write_Header(&sC, (Luint8)PICOMMS_INT16, u16Index);
+		vPICOMMS_ENC__Write_Escaped(&sC, (Luint8)((Luint16)s16Value >> 8U));
+		vPICOMMS_ENC__Write_Escaped(&sC, (Luint8)((Luint16)s16Value & 0xFFU));
+		vPICOMMS_ENC__Commit(&sC);
+	}
+	else
+	{
+		//overflow counted
+	}
+}
+
+void vPICOMMS_ENC__Add_U32(Luint16 u16Index, Luint32 u32Value)
+{
+	Luint8 u8Test;
+	struct _strPICOMMS_ENC_CURSOR sC;
+
+	u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + 8U);
+	if(u8Test == 1U)
+	{
+		vPICOMMS_ENC__Write_Header(&sC, (Luint8)PICOMMS_UINT32, u16Index);
+		vPICOMMS_ENC__Write_Word(&sC, u32Value);
+		vPICOMMS_ENC__Commit(&sC);
+	}
+	else
+	{
+		//overflow counted
+	}
+}
+
+void vPICOMMS_ENC__Add_S32(Luint16 u16Index, Lint32 s32Value)
+{
+	Luint8 u8Test;
+	struct _strPICOMMS_ENC_CURSOR sC;
+
+	u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + 8U);
+	if(u8Test == 1U)
+	{
+		vPICOMMS_ENC__Write_Header(&sC, (Luint8)PICOMMS_INT32, u16Index);
+		vPICOMMS_ENC__Write_Word(&sC, (Luint32)s32Value);
+		vPICOMMS_ENC__Commit(&sC);
+	}
+	else
+	{
+		//overflow counted
+	}
+}
+
+void vPICOMMS_ENC__Add_U64(Luint16 u16Index, Luint64 u64Value)
+{
+	Luint8 u8Test;
+	struct _strPICOMMS_ENC_CURSOR sC;
+
+	u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + C_PICOMMS_ENC__MAX_PAYLOAD);
+	if(u8Test == 1U)
+	{
+		vPICOMMS_ENC__Write_Header(&sC, (Luint8)PICOMMS_UINT64, u16Index);
+		vPICOMMS_ENC__Write_Word(&sC, (Luint32)(u64Value >> 32U));
+		vPICOMMS_ENC__Write_Word(&sC, (Luint32)(u64Value & 0xFFFFFFFFU));
+		vPICOMMS_ENC__Commit(&sC);
+	}
+	else
+	{
+		//overflow counted
+	}
+}
+
+void vPICOMMS_ENC__Add_S64(Luint16 u16Index, Lint64 s64Value)
+{
+	Luint8 u8Test;
+	struct _strPICOMMS_ENC_CURSOR sC;
+
+	u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + C_PICOMMS_ENC__MAX_PAYLOAD);
+	if(u8Test == 1U)
+	{
+		vPICOMMS_ENC__Write_Header(&sC, (Luint8)PICOMMS_INT64, u16Index);
+		vPICOMMS_ENC__Write_Word(&sC, (Luint32)((Luint64)s64Value >> 32U));
+		vPICOMMS_ENC__Write_Word(&sC, (Luint32)((Luint64)s64Value & 0xFFFFFFFFU));
+		vPICOMMS_ENC__Commit(&sC);
+	}
+	else
+	{
+		//overflow counted
+	}
+}
+
+void vPICOMMS_ENC__Add_F32(Luint16 u16Index, Lfloat32 f32Value)
+{
+	Luint8 u8Test;
+	struct _strPICOMMS_ENC_CURSOR sC;
+	union
+	{
+		Lfloat32 f32;
+		Luint32 u32;
+	}unT;
+
+	u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + 8U);
+	if(u8Test == 1U)
+	{
+		unT.f32 = f32Value;
+		vPICOMMS_ENC__Write_Header(&sC, (Luint8)PICOMMS_FLOAT, u16Index);
+		vPICOMMS_ENC__Write_Word(&sC, unT.u32);
+		vPICOMMS_ENC__Commit(&sC);
+	}
+	else
+	{
+		//overflow counted
+	}
+}
+
+void vPICOMMS_ENC__Add_F64(Luint16 u16Index, Lfloat64 f64Value)
+{
+	Luint8 u8Test;
+	struct _strPICOMMS_ENC_CURSOR sC;
+	union
+	{
+		Lfloat64 f64;
+		Luint64 u64;
+	}unT;
+
+	u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + C_PICOMMS_ENC__MAX_PAYLOAD);
+	if(u8Test == 1U)
+	{
+		unT.f64 = f64Value;
+		vPICOMMS_ENC__Write_Header(&sC, (Luint8)PICOMMS_DOUBLE, u16Index);
+		vPICOMMS_ENC__Write_Word(&sC, (Luint32)(unT.u64 >> 32U));
+		vPICOMMS_ENC__Write_Word(&sC, (Luint32)(unT.u64 & 0xFFFFFFFFU));
+		vPICOMMS_ENC__Commit(&sC);
+	}
+	else
+	{
+		//overflow counted
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Add the next template param, the index comes from the template.
+ *
+ * @param[in]		xValue					Value to send
+ */
+void vPICOMMS_ENC__Next_U8(Luint8 u8Value)
+{
+	Luint8 u8Test;
+	Luint8 u8Skip;
+	struct _strPICOMMS_ENC_CURSOR sC;
+
+	//delta frames leave out params inside their deadband
+	u8Skip = u8PICOMMS_ENC__Delta_Skip_Int((Luint8)PICOMMS_UINT8, (Lint64)u8Value);
+	if(u8Skip == 0U)
+	{
+		u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + 2U);
+		if(u8Test == 1U)
+		{
+			vPICOMMS_ENC__Write_Slot(&sC, (Luint8)PICOMMS_UINT8);
+			vPICOMMS_ENC__Write_Escaped(&sC, u8Value);
+			vPICOMMS_ENC__Commit(&sC);
+		}
+		else
+		{
+			//keep in step with the template
+			sPC.sTx.sEnc.u16Slot++;
+		}
+	}
+	else
+	{
+		//skipped, slot already moved on
+	}
+}
+
+void vPICOMMS_ENC__Next_S8(Lint8 s8Value)
+{
+	Luint8 u8Test;
+	Luint8 u8Skip;
+	struct _strPICOMMS_ENC_CURSOR sC;
+
+	//delta frames leave out params inside their deadband
+	u8Skip = u8PICOMMS_ENC__Delta_Skip_Int((Luint8)PICOMMS_INT8, (Lint64)s8Value);
+	if(u8Skip == 0U)
+	{
+		u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + 2U);
+		if(u8Test == 1U)
+		{
+			vPICOMMS_ENC__Write_Slot(&sC, (Luint8)PICOMMS_INT8);
+			vPICOMMS_ENC__Write_Escaped(&sC, (Luint8)s8Value);
+			vPICOMMS_ENC__Commit(&sC);
+		}
+		else
+		{
+			sPC.sTx.sEnc.u16Slot++;
+		}
+	}
+	else
+	{
+		//skipped, slot already moved on
+	}
+}
+
+void vPICOMMS_ENC__Next_U16(Luint16 u16Value)
+{
+	Luint8 u8Test;
+	Luint8 u8Skip;
+	struct _strPICOMMS_ENC_CURSOR sC;
+
+	//delta frames leave out params inside their deadband
+	u8Skip = u8PICOMMS_ENC__Delta_Skip_Int((Luint8)PICOMMS_UINT16, (Lint64)u16Value);
+	if(u8Skip == 0U)
+	{
+		u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + 4U);
+		if(u8Test == 1U)
+		{
+			vPICOMMS_ENC__Write_Slot(&sC, (Luint8)PICOMMS_UINT16);
+			vPICOMMS_ENC__Write_Escaped(&sC, (Luint8)(u16Value >> 8U));
+			vPICOMMS_ENC__Write_Escaped(&sC, (Luint8)(u16Value & 0xFFU));
+			vPICOMMS_ENC__Commit(&sC);
+		}
+		else
+		{
+			sPC.sTx.sEnc.u16Slot++;
+		}
+	}
+	else
+	{
+		//skipped, slot already moved on
+	}
+}
+
+void vPICOMMS_ENC__Next_S16(Lint16 s16Value)
+{
+	Luint8 u8Test;
+	Luint8 u8Skip;
+	struct _strPICOMMS_ENC_CURSOR sC;
+
+	//delta frames leave out params inside their deadband
+	u8Skip = u8PICOMMS_ENC__Delta_Skip_Int((Luint8)PICOMMS_INT16, (Lint64)s16Value);
+	if(u8Skip == 0U)
+	{
+		u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + 4U);
+		if(u8Test == 1U)
+		{
+			vPICOMMS_ENC__Write_Slot(&sC, (Luint8)PICOMMS_INT16);
+			vPICOMMS_ENC__Write_Escaped(&sC, (Luint8)((Luint16)s16Value >> 8U));
+			vPICOMMS_ENC__Write_Escaped(&sC, (Luint8)((Luint16)s16Value & 0xFFU));
+			vPICOMMS_ENC__Commit(&sC);
+		}
+		else
+		{
+			sPC.sTx.sEnc.u16Slot++;
+		}
+	}
+	else
+	{
+		//skipped, slot already moved on
+	}
+}
+
+void vPICOMMS_ENC__Next_U32(Luint32 u32Value)
+{
+	Luint8 u8Test;
+	Luint8 u8Skip;
+	struct _strPICOMMS_ENC_CURSOR sC;
+
+	//delta frames leave out params inside their deadband
+	u8Skip = u8PICOMMS_ENC__Delta_Skip_Int((Luint8)PICOMMS_UINT32, (Lint64)u32Value);
+	if(u8Skip == 0U)
+	{
+		u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + 8U);
+		if(u8Test == 1U)
+		{
+			vPICOMMS_ENC__Write_Slot(&sC, (Luint8)PICOMMS_UINT32);
+			vPICOMMS_ENC__Write_Word(&sC, u32Value);
+			vPICOMMS_ENC__Commit(&sC);
+		}
+		else
+		{
+			sPC.sTx.sEnc.u16Slot++;
+		}
+	}
+	else
+	{
+		//skipped, slot already moved on
+	}
+}
+
+void vPICOMMS_ENC__Next_S32(Lint32 s32Value)
+{
+	Luint8 u8Test;
+	Luint8 u8Skip;
+	struct _strPICOMMS_ENC_CURSOR sC;
+
+	//delta frames leave out params inside their deadband
+	u8Skip = u8PICOMMS_ENC__Delta_Skip_Int((Luint8)PICOMMS_INT32, (Lint64)s32Value);
+	if(u8Skip == 0U)
+	{
+		u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + 8U);
+		if(u8Test == 1U)
+		{
+			vPICOMMS_ENC__Write_Slot(&sC, (Luint8)PICOMMS_INT32);
+			vPICOMMS_ENC__Write_Word(&sC, (Luint32)s32Value);
+			vPICOMMS_ENC__Commit(&sC);
+		}
+		else
+		{
+			sPC.sTx.sEnc.u16Slot++;
+		}
+	}
+	else
+	{
+		//skipped, slot already moved on
+	}
+}
+
+void vPICOMMS_ENC__Next_F32(Lfloat32 f32Value)
+{
+	Luint8 u8Test;
+	Luint8 u8Skip;
+	struct _strPICOMMS_ENC_CURSOR sC;
+	union
+	{
+		Lfloat32 f32;
+		Luint32 u32;
+	}unT;
+
+	//delta frames leave out params inside their deadband
+	u8Skip = u8PICOMMS_ENC__Delta_Skip_Float((Luint8)PICOMMS_FLOAT, (Lfloat64)f32Value);
+	if(u8Skip == 0U)
+	{
+		u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + 8U);
+		if(u8Test == 1U)
+		{
+			unT.f32 = f32Value;
+			vPICOMMS_ENC__Write_Slot(&sC, (Luint8)PICOMMS_FLOAT);
+			vPICOMMS_ENC__Write_Word(&sC, unT.u32);
+			vPICOMMS_ENC__Commit(&sC);
+		}
+		else
+		{
+			sPC.sTx.sEnc.u16Slot++;
+		}
+	}
+	else
+	{
+		//skipped, slot already moved on
+	}
+}
+
+void vPICOMMS_ENC__Next_F64(Lfloat64 f64Value)
+{
+	Luint8 u8Test;
+	Luint8 u8Skip;
+	struct _strPICOMMS_ENC_CURSOR sC;
+	union
+	{
+		Lfloat64 f64;
+		Luint64 u64;
+	}unT;
+
+	//delta frames leave out params inside their deadband
+	u8Skip = u8PICOMMS_ENC__Delta_Skip_Float((Luint8)PICOMMS_DOUBLE, f64Value);
+	if(u8Skip == 0U)
+	{
+		u8Test = u8PICOMMS_ENC__Reserve(&sC, C_PICOMMS_ENC__MAX_PARAM_HEADER + C_PICOMMS_ENC__MAX_PAYLOAD);
+		if(u8Test == 1U)
+		{
+			unT.f64 = f64Value;
+			vPICOMMS_ENC__Write_Slot(&sC, (Luint8)PICOMMS_DOUBLE);
+			vPICOMMS_ENC__Write_Word(&sC, (Luint32)(unT.u64 >> 32U));
+			vPICOMMS_ENC__Write_Word(&sC, (Luint32)(unT.u64 & 0xFFFFFFFFU));
+			vPICOMMS_ENC__Commit(&sC);
+		}
+		else
+		{
+			sPC.sTx.sEnc.u16Slot++;
+		}
+	}
+	else
+	{
+		//skipped, slot already moved on
+	}
+}
+
+#endif //#if C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
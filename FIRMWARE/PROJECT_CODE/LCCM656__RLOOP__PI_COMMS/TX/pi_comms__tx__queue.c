@@ -0,0 +1,425 @@
+/**
+ * @file		PI_COMMS__TX__QUEUE.C
+ * @brief		N deep transmit queue for frames from host to Pi.
+ * @note
+ * The encoder writes each frame straight into a queue buffer so the next
+ * frame can be built while the last one is still going out on the DMA.
+ * Completed frames are handed to the DMA oldest first. Buffer 0 is the
+ * original PICOMMS_TX_buffer, the others are in sQueue, all sized to the
+ * largest frame the node builds.
+ *
+ * Push() is called from the frame builder, Start_Next() and Tx_Complete()
+ * from wherever the DMA is serviced. If the DMA done interrupt is used to
+ * call them, the builder must not be interrupted inside Acquire() or Push().
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM656R0.FILE.010
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PI_COMMS
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PI_COMMS__TX_QUEUE
+ * @ingroup PI_COMMS
+ * @{ */
+
+#include "../pi_comms.h"
+#if C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE == 1U
+
+//the main structure
+extern struct _strPICOMMS sPC;
+
+//locals
+static void vPICOMMS_TXQ__Update_HighWater(void);
+static Luint8 * pu8PICOMMS_TXQ__Get_Buffer(Luint8 u8Slot);
+
+/***************************************************************************//**
+ * @brief
+ * Init the queue, all buffers free and nothing on the wire
+ *
+ */
+void vPICOMMS_TXQ__Init(void)
+{
+	Luint8 u8Counter;
+
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH; u8Counter++)
+	{
+		sPC.sTx.sQueue.u16Start[u8Counter] = 0U;
+		sPC.sTx.sQueue.u16Length[u8Counter] = 0U;
+		sPC.sTx.sQueue.u8Fifo[u8Counter] = C_PICOMMS_TXQ__NO_SLOT;
+	}
+
+	sPC.sTx.sQueue.u32UsedMask = 0U;
+	sPC.sTx.sQueue.u8FifoOut = 0U;
+	sPC.sTx.sQueue.u8FifoCount = 0U;
+	sPC.sTx.sQueue.u8WriteSlot = C_PICOMMS_TXQ__NO_SLOT;
+	sPC.sTx.sQueue.u8WireSlot = C_PICOMMS_TXQ__NO_SLOT;
+	sPC.sTx.sQueue.u8HighWater = 0U;
+	sPC.sTx.sQueue.u32Pushed = 0U;
+	sPC.sTx.sQueue.u32Sent = 0U;
+	sPC.sTx.sQueue.u32DroppedOldest = 0U;
+	sPC.sTx.sQueue.u32DroppedNewest = 0U;
+	sPC.sTx.sQueue.u32Ticks = 0U;
+	sPC.sTx.sQueue.u8Idle = 0U;
+	sPC.sTx.sQueue.u32IdleStart = 0U;
+	sPC.sTx.sQueue.u32IdleGaps = 0U;
+	sPC.sTx.sQueue.u32IdleTicks = 0U;
+	sPC.sTx.sQueue.u32MaxIdleTicks = 0U;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get a buffer for the next frame. Called by the encoder at the start of
+ * each frame, calling it again before Push() returns the same buffer.
+ *
+ * If every buffer is in use the overrun policy applies, either the oldest
+ * waiting frame gives up its buffer or there is no buffer and Push() counts
+ * the new frame as dropped. Either way the next delta frame is forced to a
+ * keyframe as the Pi has missed something.
+ *
+ * @return			Buffer to encode into, 0 = the frame is dropped
+ */
+Luint8 * pu8PICOMMS_TXQ__Acquire(void)
+{
+	Luint8 *pu8Return;
+	Luint8 u8Slot;
+	Luint8 u8Counter;
+
+	u8Slot = sPC.sTx.sQueue.u8WriteSlot;
+
+	if(u8Slot == C_PICOMMS_TXQ__NO_SLOT)
+	{
+		//find a free buffer
+		for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH; u8Counter++)
+		{
+			if((u8Slot == C_PICOMMS_TXQ__NO_SLOT) && ((sPC.sTx.sQueue.u32UsedMask & (1UL << u8Counter)) == 0U))
+			{
+				u8Slot = u8Counter;
+			}
+			else
+			{
+				//in use or already found
+			}
+		}
+
+		if(u8Slot == C_PICOMMS_TXQ__NO_SLOT)
+		{
+			#if C_LOCALDEF__LCCM656__TX_DROP_OLDEST == 1U
+				//take the buffer from the oldest frame that is not on the wire
+				if(sPC.sTx.sQueue.u8FifoCount > 0U)
+				{
+					u8Slot = sPC.sTx.sQueue.u8Fifo[sPC.sTx.sQueue.u8FifoOut];
+					sPC.sTx.sQueue.u8FifoOut = (Luint8)((sPC.sTx.sQueue.u8FifoOut + 1U) % C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH);
+					sPC.sTx.sQueue.u8FifoCount--;
+					sPC.sTx.sQueue.u32DroppedOldest++;
+				}
+				else
+				{
+					//can only happen if every buffer is on the wire, drop the new frame
+				}
+			#endif
+
+			//the Pi has or will miss a frame
+			vPICOMMS_ENC__Force_Keyframe();
+		}
+		else
+		{
+			//got one
+		}
+
+		if(u8Slot != C_PICOMMS_TXQ__NO_SLOT)
+		{
+			sPC.sTx.sQueue.u32UsedMask |= (1UL << u8Slot);
+		}
+		else
+		{
+			//frame will be dropped in Push()
+		}
+
+		sPC.sTx.sQueue.u8WriteSlot = u8Slot;
+	}
+	else
+	{
+		//restarting the frame in the buffer we already have
+	}
+
+	if(u8Slot != C_PICOMMS_TXQ__NO_SLOT)
+	{
+		pu8Return = pu8PICOMMS_TXQ__Get_Buffer(u8Slot);
+	}
+	else
+	{
+		//the encoder writes nothing
+		pu8Return = 0;
+	}
+
+	return pu8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Queue the frame in the buffer from Acquire()
+ *
+ * @param[in]		u16Start				Offset of the SOF in the buffer
+ * @param[in]		u16Length				Frame length
+ */
+void vPICOMMS_TXQ__Push(Luint16 u16Start, Luint16 u16Length)
+{
+	Luint8 u8Slot;
+	Luint8 u8In;
+
+	u8Slot = sPC.sTx.sQueue.u8WriteSlot;
+
+	if(u8Slot != C_PICOMMS_TXQ__NO_SLOT)
+	{
+		sPC.sTx.sQueue.u16Start[u8Slot] = u16Start;
+		sPC.sTx.sQueue.u16Length[u8Slot] = u16Length;
+
+		//add to the back
+		u8In = (Luint8)((sPC.sTx.sQueue.u8FifoOut + sPC.sTx.sQueue.u8FifoCount) % C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH);
+		sPC.sTx.sQueue.u8Fifo[u8In] = u8Slot;
+		sPC.sTx.sQueue.u8FifoCount++;
+		sPC.sTx.sQueue.u32Pushed++;
+
+		vPICOMMS_TXQ__Update_HighWater();
+	}
+	else
+	{
+		//no buffer was free, keyframe already forced
+		sPC.sTx.sQueue.u32DroppedNewest++;
+	}
+
+	sPC.sTx.sQueue.u8WriteSlot = C_PICOMMS_TXQ__NO_SLOT;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Check if there is a free buffer, the frame builder should hold off rather
+ * than rely on the overrun policy.
+ *
+ * @return			1 = every buffer is in use
+ */
+Luint8 u8PICOMMS_TXQ__Is_Full(void)
+{
+	Luint8 u8Return;
+
+	if(sPC.sTx.sQueue.u32UsedMask == ((1UL << C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH) - 1UL))
+	{
+		u8Return = 1U;
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * If the wire is free, move the oldest queued frame onto it.
+ *
+ * @param[out]		pu16Length				Frame length, 0 if nothing to send
+ * @return			Start of the frame for the DMA, or 0 if nothing to send
+ */
+Luint8 * pu8PICOMMS_TXQ__Start_Next(Luint16 *pu16Length)
+{
+	Luint8 *pu8Return;
+	Luint8 u8Slot;
+	Luint32 u32Gap;
+
+	pu8Return = 0;
+	*pu16Length = 0U;
+
+	if(sPC.sTx.sQueue.u8WireSlot == C_PICOMMS_TXQ__NO_SLOT)
+	{
+		if(sPC.sTx.sQueue.u8FifoCount > 0U)
+		{
+			//take from the front
+			u8Slot = sPC.sTx.sQueue.u8Fifo[sPC.sTx.sQueue.u8FifoOut];
+			sPC.sTx.sQueue.u8FifoOut = (Luint8)((sPC.sTx.sQueue.u8FifoOut + 1U) % C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH);
+			sPC.sTx.sQueue.u8FifoCount--;
+			sPC.sTx.sQueue.u8WireSlot = u8Slot;
+
+			*pu16Length = sPC.sTx.sQueue.u16Length[u8Slot];
+			pu8Return = pu8PICOMMS_TXQ__Get_Buffer(u8Slot) + sPC.sTx.sQueue.u16Start[u8Slot];
+
+			//close off any idle gap
+			if(sPC.sTx.sQueue.u8Idle == 1U)
+			{
+				u32Gap = sPC.sTx.sQueue.u32Ticks - sPC.sTx.sQueue.u32IdleStart;
+				sPC.sTx.sQueue.u32IdleGaps++;
+				sPC.sTx.sQueue.u32IdleTicks += u32Gap;
+				if(u32Gap > sPC.sTx.sQueue.u32MaxIdleTicks)
+				{
+					sPC.sTx.sQueue.u32MaxIdleTicks = u32Gap;
+				}
+				else
+				{
+					//fall on
+				}
+				sPC.sTx.sQueue.u8Idle = 0U;
+			}
+			else
+			{
+				//back to back
+			}
+		}
+		else
+		{
+			//the wire has gone idle, don't count the time before the first frame
+			if((sPC.sTx.sQueue.u8Idle == 0U) && (sPC.sTx.sQueue.u32Sent > 0U))
+			{
+				sPC.sTx.sQueue.u8Idle = 1U;
+				sPC.sTx.sQueue.u32IdleStart = sPC.sTx.sQueue.u32Ticks;
+			}
+			else
+			{
+				//already idle
+			}
+		}
+	}
+	else
+	{
+		//DMA still has the last frame
+	}
+
+	return pu8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * The DMA has finished the frame on the wire, free its buffer.
+ *
+ */
+void vPICOMMS_TXQ__Tx_Complete(void)
+{
+	Luint8 u8Slot;
+
+	u8Slot = sPC.sTx.sQueue.u8WireSlot;
+	if(u8Slot != C_PICOMMS_TXQ__NO_SLOT)
+	{
+		sPC.sTx.sQueue.u32UsedMask &= ~(1UL << u8Slot);
+		sPC.sTx.sQueue.u8WireSlot = C_PICOMMS_TXQ__NO_SLOT;
+		sPC.sTx.sQueue.u32Sent++;
+	}
+	else
+	{
+		//spurious
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Is a frame on the wire
+ *
+ * @return			1 = DMA has a frame
+ */
+Luint8 u8PICOMMS_TXQ__Is_OnWire(void)
+{
+	Luint8 u8Return;
+
+	if(sPC.sTx.sQueue.u8WireSlot != C_PICOMMS_TXQ__NO_SLOT)
+	{
+		u8Return = 1U;
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+//10ms timebase for the idle gaps
+void vPICOMMS_TXQ__10MS_ISR(void)
+{
+	sPC.sTx.sQueue.u32Ticks++;
+}
+
+Luint8 u8PICOMMS_TXQ__Get_HighWater(void)
+{
+	return sPC.sTx.sQueue.u8HighWater;
+}
+
+Luint32 u32PICOMMS_TXQ__Get_Dropped(void)
+{
+	return sPC.sTx.sQueue.u32DroppedOldest + sPC.sTx.sQueue.u32DroppedNewest;
+}
+
+Luint32 u32PICOMMS_TXQ__Get_IdleGaps(void)
+{
+	return sPC.sTx.sQueue.u32IdleGaps;
+}
+
+Luint32 u32PICOMMS_TXQ__Get_MaxIdleTicks(void)
+{
+	return sPC.sTx.sQueue.u32MaxIdleTicks;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Track the most frames waiting or on the wire
+ *
+ */
+static void vPICOMMS_TXQ__Update_HighWater(void)
+{
+	Luint8 u8Depth;
+
+	u8Depth = sPC.sTx.sQueue.u8FifoCount;
+	if(sPC.sTx.sQueue.u8WireSlot != C_PICOMMS_TXQ__NO_SLOT)
+	{
+		u8Depth++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(u8Depth > sPC.sTx.sQueue.u8HighWater)
+	{
+		sPC.sTx.sQueue.u8HighWater = u8Depth;
+	}
+	else
+	{
+		//fall on
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Where a queue buffer lives
+ *
+ * @param[in]		u8Slot					Buffer index
+ * @return			Start of the buffer
+ */
+static Luint8 * pu8PICOMMS_TXQ__Get_Buffer(Luint8 u8Slot)
+{
+	Luint8 *pu8Return;
+
+	if(u8Slot == 0U)
+	{
+		pu8Return = &sPC.sTx.PICOMMS_TX_buffer[0];
+	}
+	else
+	{
+		pu8Return = &sPC.sTx.sQueue.u8Buffer[u8Slot - 1U][0];
+	}
+
+	return pu8Return;
+}
+
+#endif //#if C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
@@ -0,0 +1,763 @@
+/**
+ * @file		LCCM656R0_TS_001.C
+ * @brief		Test spec for the streaming receive parser
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM656R0.FILE.009
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM656__ENABLE_RX == 1U
+#if C_LOCALDEF__LCCM656__ENABLE_TEST_SPEC == 1U
+
+//host side only, for the timing
+#include <stdio.h>
+#include <time.h>
+
+/** Frames in a test stream */
+#define C_TS001__NUM_FRAMES						(2000U)
+
+/** Max params in a test frame */
+#define C_TS001__MAX_PARAMS						(40U)
+
+/** Every Nth frame has a byte corrupted */
+#define C_TS001__CORRUPT_EVERY					(5U)
+
+/** Stream buffer size */
+#define C_TS001__STREAM_SIZE					(0x200000U)
+
+/** Times the stream is fed for the throughput test */
+#define C_TS001__BENCH_LOOPS					(20U)
+
+extern struct _strPICOMMS sPC;
+
+void vLCCM656R0_TS_001_TCASE_001(void);
+void vLCCM656R0_TS_001_TCASE_002(void);
+void vLCCM656R0_TS_001_TCASE_003(void);
+void vLCCM656R0_TS_001_TCASE_004(void);
+void vLCCM656R0_TS_001_TCASE_005(void);
+static void vTS001__Feed_Frame(void);
+static void vTS001__Commit(void);
+static Luint8 u8TS001__Check_Limit(Luint16 u16Index, const PICOMMS_RX_VALUE_T *puValue);
+static void vTS001__Build_Stream(Luint8 u8Corrupt);
+static void vTS001__Feed_Fragmented(void);
+static void vTS001__Attach(void);
+static Luint32 u32TS001__Random(void);
+static Luint64 u64TS001__Hash(Luint64 u64Hash, Luint16 u16Index, Luint64 u64Value);
+static void vTS001__FrameBegin(void);
+static void vTS001__FrameEnd(void);
+static void vTS001__Rx_U8(Luint16 u16Index, Luint8 u8Value);
+static void vTS001__Rx_S8(Luint16 u16Index, Lint8 s8Value);
+static void vTS001__Rx_U16(Luint16 u16Index, Luint16 u16Value);
+static void vTS001__Rx_S16(Luint16 u16Index, Lint16 s16Value);
+static void vTS001__Rx_U32(Luint16 u16Index, Luint32 u32Value);
+static void vTS001__Rx_S32(Luint16 u16Index, Lint32 s32Value);
+static void vTS001__Rx_U64(Luint16 u16Index, Luint64 u64Value);
+static void vTS001__Rx_S64(Luint16 u16Index, Lint64 s64Value);
+static void vTS001__Rx_F32(Luint16 u16Index, Lfloat32 f32Value);
+static void vTS001__Rx_F64(Luint16 u16Index, Lfloat64 f64Value);
+
+//the encoded test stream
+static Luint8 u8TS001_Stream[C_TS001__STREAM_SIZE];
+static Luint32 u32TS001_StreamLength;
+
+//what we expect to see
+static Luint32 u32TS001_ExpectedFrames;
+static Luint64 u64TS001_ExpectedSum;
+static Luint32 u32TS001_JunkBytes;
+
+//what we actually saw
+static Luint64 u64TS001_FrameHash;
+static Luint64 u64TS001_ReceivedSum;
+
+static Luint32 u32TS001_Seed;
+
+//receive table destinations
+static Luint8 u8TS001_Dest;
+static Lint32 s32TS001_Dest;
+static Lfloat32 f32TS001_Dest;
+static Luint32 u32TS001_Commits;
+static Luint8 u8TS001_CommitMask;
+
+//sorted receive table for TCASE 004
+static const PICOMMS_RX_PARAM_T sTS001_Table[] =
+{
+	{0x0100U, (Luint8)PICOMMS_UINT8, &u8TS001_Dest, &u8TS001__Check_Limit},
+	{0x0200U, (Luint8)PICOMMS_INT32, &s32TS001_Dest, 0},
+	{0xD5D5U, (Luint8)PICOMMS_FLOAT, &f32TS001_Dest, 0}
+};
+
+//same entries out of order, must be refused
+static const PICOMMS_RX_PARAM_T sTS001_BadTable[] =
+{
+	{0x0200U, (Luint8)PICOMMS_INT32, &s32TS001_Dest, 0},
+	{0x0100U, (Luint8)PICOMMS_UINT8, &u8TS001_Dest, 0}
+};
+
+//a frame as the Pi sends it, length 213 so the low length byte goes out as
+//an escaped pair. 21 U32s at 0x0400+n of 0x11220000 + n * 0x101, then a U8
+//0xD5 at 0x0500, a U16 0x1234 at 0x0501 and a U8 7 at 0x0502.
+static Luint8 u8TS001_PiFrame[] =
+{
+	0xD5U, 0xD0U, 0x00U, 0xD5U, 0xD5U, 0xD5U, 0xD3U, 0x42U, 0x04U, 0x00U, 0x11U, 0x22U,
+	0x00U, 0x00U, 0xD5U, 0xD3U, 0x42U, 0x04U, 0x01U, 0x11U, 0x22U, 0x01U, 0x01U, 0xD5U,
+	0xD3U, 0x42U, 0x04U, 0x02U, 0x11U, 0x22U, 0x02U, 0x02U, 0xD5U, 0xD3U, 0x42U, 0x04U,
+	0x03U, 0x11U, 0x22U, 0x03U, 0x03U, 0xD5U, 0xD3U, 0x42U, 0x04U, 0x04U, 0x11U, 0x22U,
+	0x04U, 0x04U, 0xD5U, 0xD3U, 0x42U, 0x04U, 0x05U, 0x11U, 0x22U, 0x05U, 0x05U, 0xD5U,
+	0xD3U, 0x42U, 0x04U, 0x06U, 0x11U, 0x22U, 0x06U, 0x06U, 0xD5U, 0xD3U, 0x42U, 0x04U,
+	0x07U, 0x11U, 0x22U, 0x07U, 0x07U, 0xD5U, 0xD3U, 0x42U, 0x04U, 0x08U, 0x11U, 0x22U,
+	0x08U, 0x08U, 0xD5U, 0xD3U, 0x42U, 0x04U, 0x09U, 0x11U, 0x22U, 0x09U, 0x09U, 0xD5U,
+	0xD3U, 0x42U, 0x04U, 0x0AU, 0x11U, 0x22U, 0x0AU, 0x0AU, 0xD5U, 0xD3U, 0x42U, 0x04U,
+	0x0BU, 0x11U, 0x22U, 0x0BU, 0x0BU, 0xD5U, 0xD3U, 0x42U, 0x04U, 0x0CU, 0x11U, 0x22U,
+	0x0CU, 0x0CU, 0xD5U, 0xD3U, 0x42U, 0x04U, 0x0DU, 0x11U, 0x22U, 0x0DU, 0x0DU, 0xD5U,
+	0xD3U, 0x42U, 0x04U, 0x0EU, 0x11U, 0x22U, 0x0EU, 0x0EU, 0xD5U, 0xD3U, 0x42U, 0x04U,
+	0x0FU, 0x11U, 0x22U, 0x0FU, 0x0FU, 0xD5U, 0xD3U, 0x42U, 0x04U, 0x10U, 0x11U, 0x22U,
+	0x10U, 0x10U, 0xD5U, 0xD3U, 0x42U, 0x04U, 0x11U, 0x11U, 0x22U, 0x11U, 0x11U, 0xD5U,
+	0xD3U, 0x42U, 0x04U, 0x12U, 0x11U, 0x22U, 0x12U, 0x12U, 0xD5U, 0xD3U, 0x42U, 0x04U,
+	0x13U, 0x11U, 0x22U, 0x13U, 0x13U, 0xD5U, 0xD3U, 0x42U, 0x04U, 0x14U, 0x11U, 0x22U,
+	0x14U, 0x14U, 0xD5U, 0xD3U, 0x12U, 0x05U, 0x00U, 0xD5U, 0xD5U, 0xD5U, 0xD3U, 0x22U,
+	0x05U, 0x01U, 0x12U, 0x34U, 0xD5U, 0xD3U, 0x12U, 0x05U, 0x02U, 0x07U, 0xD5U, 0xD8U,
+	0x61U, 0x00U
+};
+
+//Function to call the tests for this test specification
+void vLCCM656R0_TS_001(void)
+{
+	//Call the test cases
+	vLCCM656R0_TS_001_TCASE_001();
+	vLCCM656R0_TS_001_TCASE_002();
+	vLCCM656R0_TS_001_TCASE_003();
+	vLCCM656R0_TS_001_TCASE_004();
+	vLCCM656R0_TS_001_TCASE_005();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM656R0.TS.001.TCASE.001
+ * @st_test_desc
+ * Back to back frames of every param type fed in random size pieces must all
+ * arrive with no resyncs or dropped bytes.
+ *
+*/
+void vLCCM656R0_TS_001_TCASE_001(void)
+{
+	char cText[160];
+
+	DEBUG_PRINT("START:LCCM656R0.TS.001.TCASE.001\r\n");
+
+	vPICOMMS__Init();
+	vTS001__Attach();
+	u32TS001_Seed = 0x600DF00DU;
+	vTS001__Build_Stream(0U);
+	vTS001__Feed_Fragmented();
+
+	sprintf(cText, "INFO: frames %u/%u, resyncs %u, dropped %u\r\n", u32PICOMMS_RX__Get_Frames(), u32TS001_ExpectedFrames, u32PICOMMS_RX__Get_Resyncs(), u32PICOMMS_RX__Get_DroppedBytes());
+	DEBUG_PRINT(cText);
+
+	if((u32PICOMMS_RX__Get_Frames() == u32TS001_ExpectedFrames) &&
+		(u64TS001_ReceivedSum == u64TS001_ExpectedSum) &&
+		(u32PICOMMS_RX__Get_Resyncs() == 0U) &&
+		(u32PICOMMS_RX__Get_ChecksumFaults() == 0U) &&
+		(u32PICOMMS_RX__Get_DroppedBytes() == 0U))
+	{
+		DEBUG_PRINT("PASS:LCCM656R0.TS.001.TCASE.001\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM656R0.TS.001.TCASE.001\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM656R0.TS.001.TCASE.001\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM656R0.TS.001.TCASE.002
+ * @st_test_desc
+ * Junk between frames and one corrupted byte in every 5th frame. Only the
+ * corrupted frames may be lost, the parser must pick up the very next frame.
+ *
+*/
+void vLCCM656R0_TS_001_TCASE_002(void)
+{
+	Luint32 u32Lost;
+	char cText[160];
+
+	DEBUG_PRINT("START:LCCM656R0.TS.001.TCASE.002\r\n");
+
+	vPICOMMS__Init();
+	vTS001__Attach();
+	u32TS001_Seed = 0xBADC0DE5U;
+	vTS001__Build_Stream(1U);
+	vTS001__Feed_Fragmented();
+
+	u32Lost = u32PICOMMS_RX__Get_Resyncs() + u32PICOMMS_RX__Get_ChecksumFaults();
+	sprintf(cText, "INFO: frames %u/%u, resyncs %u, checksum %u, dropped %u, junk %u\r\n", u32PICOMMS_RX__Get_Frames(), u32TS001_ExpectedFrames,
+			u32PICOMMS_RX__Get_Resyncs(), u32PICOMMS_RX__Get_ChecksumFaults(), u32PICOMMS_RX__Get_DroppedBytes(), u32TS001_JunkBytes);
+	DEBUG_PRINT(cText);
+
+	if((u32PICOMMS_RX__Get_Frames() == u32TS001_ExpectedFrames) &&
+		(u64TS001_ReceivedSum == u64TS001_ExpectedSum) &&
+		(u32Lost > 0U) &&
+		(u32PICOMMS_RX__Get_DroppedBytes() > u32TS001_JunkBytes))
+	{
+		DEBUG_PRINT("PASS:LCCM656R0.TS.001.TCASE.002\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM656R0.TS.001.TCASE.002\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM656R0.TS.001.TCASE.002\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM656R0.TS.001.TCASE.003
+ * @st_test_desc
+ * Throughput, one byte at a time as the SCI interrupt does and in 64 byte
+ * blocks as the WIN32 UDP side does.
+ *
+*/
+void vLCCM656R0_TS_001_TCASE_003(void)
+{
+	Luint32 u32Loop;
+	Luint32 u32Pos;
+	clock_t tStart;
+	Lfloat64 f64Bytes;
+	Lfloat64 f64Single;
+	Lfloat64 f64Block;
+	Luint16 u16Chunk;
+	char cText[160];
+
+	DEBUG_PRINT("START:LCCM656R0.TS.001.TCASE.003\r\n");
+
+	vPICOMMS__Init();
+	vTS001__Attach();
+	u32TS001_Seed = 0x5EED1234U;
+	vTS001__Build_Stream(0U);
+	f64Bytes = (Lfloat64)u32TS001_StreamLength * (Lfloat64)C_TS001__BENCH_LOOPS;
+
+	//byte at a time
+	tStart = clock();
+	for(u32Loop = 0U; u32Loop < C_TS001__BENCH_LOOPS; u32Loop++)
+	{
+		for(u32Pos = 0U; u32Pos < u32TS001_StreamLength; u32Pos++)
+		{
+			vPICOMMS_RX__Receive_Bytes(&u8TS001_Stream[u32Pos], 1U);
+		}
+	}
+	f64Single = f64Bytes / ((Lfloat64)(clock() - tStart + 1) / (Lfloat64)CLOCKS_PER_SEC);
+
+	//blocks
+	tStart = clock();
+	for(u32Loop = 0U; u32Loop < C_TS001__BENCH_LOOPS; u32Loop++)
+	{
+		for(u32Pos = 0U; u32Pos < u32TS001_StreamLength; u32Pos += u16Chunk)
+		{
+			u16Chunk = 64U;
+			if((u32Pos + u16Chunk) > u32TS001_StreamLength)
+			{
+				u16Chunk = (Luint16)(u32TS001_StreamLength - u32Pos);
+			}
+			else
+			{
+				//full block
+			}
+			vPICOMMS_RX__Receive_Bytes(&u8TS001_Stream[u32Pos], u16Chunk);
+		}
+	}
+	f64Block = f64Bytes / ((Lfloat64)(clock() - tStart + 1) / (Lfloat64)CLOCKS_PER_SEC);
+
+	sprintf(cText, "INFO: %u bytes/pass, single byte %.1f MB/s, 64 byte blocks %.1f MB/s\r\n", u32TS001_StreamLength, f64Single / 1.0E6, f64Block / 1.0E6);
+	DEBUG_PRINT(cText);
+
+	if((u32PICOMMS_RX__Get_Frames() == (u32TS001_ExpectedFrames * C_TS001__BENCH_LOOPS * 2U)) &&
+		(u32PICOMMS_RX__Get_DroppedBytes() == 0U))
+	{
+		DEBUG_PRINT("PASS:LCCM656R0.TS.001.TCASE.003\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM656R0.TS.001.TCASE.003\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM656R0.TS.001.TCASE.003\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM656R0.TS.001.TCASE.004
+ * @st_test_desc
+ * Receive table dispatch. Table params land in their destination with one
+ * commit per frame, params not in the table still reach the typed callbacks,
+ * a validator or type fault rejects the whole frame and an unsorted table is
+ * refused.
+ *
+*/
+void vLCCM656R0_TS_001_TCASE_004(void)
+{
+	Luint8 u8Pass;
+	char cText[160];
+
+	DEBUG_PRINT("START:LCCM656R0.TS.001.TCASE.004\r\n");
+
+	vPICOMMS__Init();
+	vTS001__Attach();
+	u64TS001_ReceivedSum = 0U;
+	u32TS001_Commits = 0U;
+	u8TS001_Dest = 0U;
+	s32TS001_Dest = 0;
+	f32TS001_Dest = 0.0F;
+	u8Pass = 1U;
+
+	vPICOMMS_RX__Register_Table(&sTS001_BadTable[0], 2U, &vTS001__Commit);
+	vPICOMMS_RX__Register_Table(&sTS001_Table[0], 3U, &vTS001__Commit);
+	if(u32PICOMMS_RX__Get_TableFaults() != 1U)
+	{
+		u8Pass = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//good frame, table params and one for the legacy callback
+	vPICOMMS_ENC__Begin_Frame();
+	vPICOMMS_ENC__Add_U8(0x0100U, 7U);
+	vPICOMMS_ENC__Add_S32(0x0200U, -123456);
+	vPICOMMS_ENC__Add_F32(0xD5D5U, 1.5F);
+	vPICOMMS_ENC__Add_U16(0x0300U, 0xD5D5U);
+	vTS001__Feed_Frame();
+	if((u32TS001_Commits != 1U) || (u8TS001_CommitMask != 0x07U) || (u8TS001_Dest != 7U) ||
+		(s32TS001_Dest != -123456) || (f32TS001_Dest != 1.5F) || (u64TS001_ReceivedSum == 0U))
+	{
+		u8Pass = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//one table param only
+	vPICOMMS_ENC__Begin_Frame();
+	vPICOMMS_ENC__Add_S32(0x0200U, 99);
+	vTS001__Feed_Frame();
+	if((u32TS001_Commits != 2U) || (u8TS001_CommitMask != 0x02U) || (s32TS001_Dest != 99))
+	{
+		u8Pass = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//validator reject, nothing in the frame may be applied
+	vPICOMMS_ENC__Begin_Frame();
+	vPICOMMS_ENC__Add_S32(0x0200U, 5);
+	vPICOMMS_ENC__Add_U8(0x0100U, 200U);
+	vTS001__Feed_Frame();
+
+	//wrong type for a table index
+	vPICOMMS_ENC__Begin_Frame();
+	vPICOMMS_ENC__Add_U32(0x0200U, 5U);
+	vTS001__Feed_Frame();
+	if((u32TS001_Commits != 2U) || (u8TS001_Dest != 7U) || (s32TS001_Dest != 99) ||
+		(u32PICOMMS_RX__Get_RejectedFrames() != 2U) || (u32PICOMMS_RX__Get_Frames() != 2U))
+	{
+		u8Pass = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	sprintf(cText, "INFO: frames %u, commits %u, rejected %u, table faults %u\r\n", u32PICOMMS_RX__Get_Frames(), u32TS001_Commits,
+			u32PICOMMS_RX__Get_RejectedFrames(), u32PICOMMS_RX__Get_TableFaults());
+	DEBUG_PRINT(cText);
+
+	if(u8Pass == 1U)
+	{
+		DEBUG_PRINT("PASS:LCCM656R0.TS.001.TCASE.004\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM656R0.TS.001.TCASE.004\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM656R0.TS.001.TCASE.004\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM656R0.TS.001.TCASE.005
+ * @st_test_desc
+ * A frame from the Pi with an escaped length byte. The Pi checksums the
+ * length as sent, so the escaped pair cancels, and the frame must be
+ * accepted whole, fed in one go and a byte at a time.
+ *
+*/
+void vLCCM656R0_TS_001_TCASE_005(void)
+{
+	Luint64 u64Expected;
+	Luint16 u16Counter;
+	char cText[160];
+
+	DEBUG_PRINT("START:LCCM656R0.TS.001.TCASE.005\r\n");
+
+	vPICOMMS__Init();
+	vTS001__Attach();
+	u64TS001_ReceivedSum = 0U;
+
+	//what the frame carries
+	u64Expected = 0U;
+	for(u16Counter = 0U; u16Counter < 21U; u16Counter++)
+	{
+		u64Expected = u64TS001__Hash(u64Expected, 0x0400U + u16Counter, 0x11220000U + ((Luint32)u16Counter * 0x101U));
+	}
+	u64Expected = u64TS001__Hash(u64Expected, 0x0500U, 0xD5U);
+	u64Expected = u64TS001__Hash(u64Expected, 0x0501U, 0x1234U);
+	u64Expected = u64TS001__Hash(u64Expected, 0x0502U, 0x07U);
+	u64Expected *= 2U;
+
+	vPICOMMS_RX__Receive_Bytes(&u8TS001_PiFrame[0], (Luint16)sizeof(u8TS001_PiFrame));
+	for(u16Counter = 0U; u16Counter < (Luint16)sizeof(u8TS001_PiFrame); u16Counter++)
+	{
+		vPICOMMS_RX__Receive_Bytes(&u8TS001_PiFrame[u16Counter], 1U);
+	}
+
+	sprintf(cText, "INFO: frames %u, checksum %u, resyncs %u, dropped %u\r\n", u32PICOMMS_RX__Get_Frames(), u32PICOMMS_RX__Get_ChecksumFaults(),
+			u32PICOMMS_RX__Get_Resyncs(), u32PICOMMS_RX__Get_DroppedBytes());
+	DEBUG_PRINT(cText);
+
+	if((u32PICOMMS_RX__Get_Frames() == 2U) &&
+		(u64TS001_ReceivedSum == u64Expected) &&
+		(u32PICOMMS_RX__Get_ChecksumFaults() == 0U) &&
+		(u32PICOMMS_RX__Get_Resyncs() == 0U) &&
+		(u32PICOMMS_RX__Get_DroppedBytes() == 0U))
+	{
+		DEBUG_PRINT("PASS:LCCM656R0.TS.001.TCASE.005\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM656R0.TS.001.TCASE.005\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM656R0.TS.001.TCASE.005\r\n");
+}
+
+//finish the encoder frame and push it through the parser in one go
+static void vTS001__Feed_Frame(void)
+{
+	Luint16 u16Length;
+
+	u16Length = u16PICOMMS_ENC__End_Frame();
+	vPICOMMS_RX__Receive_Bytes(pu8PICOMMS_ENC__Get_FramePointer(), u16Length);
+}
+
+//receive table commit, record which slots changed
+static void vTS001__Commit(void)
+{
+	Luint16 u16Slot;
+
+	u32TS001_Commits++;
+	u8TS001_CommitMask = 0U;
+	for(u16Slot = 0U; u16Slot < 3U; u16Slot++)
+	{
+		u8TS001_CommitMask |= (Luint8)(u8PICOMMS_RX__Was_Updated(u16Slot) << u16Slot);
+	}
+}
+
+//accept 0..100 only
+static Luint8 u8TS001__Check_Limit(Luint16 u16Index, const PICOMMS_RX_VALUE_T *puValue)
+{
+	Luint8 u8Return;
+
+	//same limit for every index
+	(void)u16Index;
+
+	if(puValue->u8 <= 100U)
+	{
+		u8Return = 1U;
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+//encode a stream of random frames with the TX encoder
+static void vTS001__Build_Stream(Luint8 u8Corrupt)
+{
+	Luint32 u32Frame;
+	Luint32 u32Counter;
+	Luint32 u32Value;
+	Luint64 u64Value;
+	Luint64 u64Hash;
+	Luint16 u16Index;
+	Luint16 u16Length;
+	Luint16 u16Pos;
+	Luint8 u8NumParams;
+	Luint8 u8Param;
+	Luint8 u8Junk;
+	Luint8 *pu8Frame;
+	union
+	{
+		Lfloat32 f32;
+		Luint32 u32;
+	}unT32;
+	union
+	{
+		Lfloat64 f64;
+		Luint64 u64;
+	}unT64;
+
+	u32TS001_StreamLength = 0U;
+	u32TS001_ExpectedFrames = 0U;
+	u64TS001_ExpectedSum = 0U;
+	u32TS001_JunkBytes = 0U;
+	u64TS001_ReceivedSum = 0U;
+
+	for(u32Frame = 0U; u32Frame < C_TS001__NUM_FRAMES; u32Frame++)
+	{
+		vPICOMMS_ENC__Begin_Frame();
+		u64Hash = 0U;
+		u8NumParams = (Luint8)(u32TS001__Random() % C_TS001__MAX_PARAMS);
+		for(u8Param = 0U; u8Param < u8NumParams; u8Param++)
+		{
+			u16Index = (Luint16)u32TS001__Random();
+			u32Value = u32TS001__Random();
+			if((u32Value & 0x07U) == 0U)
+			{
+				//plenty of control chars
+				u32Value |= 0xD5D500D5U;
+			}
+			u64Value = ((Luint64)u32TS001__Random() << 32U) | (Luint64)u32Value;
+
+			switch(u32TS001__Random() % 10U)
+			{
+				case 0U:
+					vPICOMMS_ENC__Add_U8(u16Index, (Luint8)u32Value);
+					u64Hash = u64TS001__Hash(u64Hash, u16Index, (Luint8)u32Value);
+					break;
+				case 1U:
+					vPICOMMS_ENC__Add_S8(u16Index, (Lint8)u32Value);
+					u64Hash = u64TS001__Hash(u64Hash, u16Index, (Luint8)u32Value);
+					break;
+				case 2U:
+					vPICOMMS_ENC__Add_U16(u16Index, (Luint16)u32Value);
+					u64Hash = u64TS001__Hash(u64Hash, u16Index, (Luint16)u32Value);
+					break;
+				case 3U:
+					vPICOMMS_ENC__Add_S16(u16Index, (Lint16)u32Value);
+					u64Hash = u64TS001__Hash(u64Hash, u16Index, (Luint16)u32Value);
+					break;
+				case 4U:
+					vPICOMMS_ENC__Add_U32(u16Index, u32Value);
+					u64Hash = u64TS001__Hash(u64Hash, u16Index, u32Value);
+					break;
+				case 5U:
+					vPICOMMS_ENC__Add_S32(u16Index, (Lint32)u32Value);
+					u64Hash = u64TS001__Hash(u64Hash, u16Index, u32Value);
+					break;
+				case 6U:
+					vPICOMMS_ENC__Add_U64(u16Index, u64Value);
+					u64Hash = u64TS001__Hash(u64Hash, u16Index, u64Value);
+					break;
+				case 7U:
+					vPICOMMS_ENC__Add_S64(u16Index, (Lint64)u64Value);
+					u64Hash = u64TS001__Hash(u64Hash, u16Index, u64Value);
+					break;
+				case 8U:
+					unT32.u32 = u32Value;
+					vPICOMMS_ENC__Add_F32(u16Index, unT32.f32);
+					u64Hash = u64TS001__Hash(u64Hash, u16Index, unT32.u32);
+					break;
+				default:
+					unT64.u64 = u64Value;
+					vPICOMMS_ENC__Add_F64(u16Index, unT64.f64);
+					u64Hash = u64TS001__Hash(u64Hash, u16Index, unT64.u64);
+					break;
+			}
+		}
+		u16Length = u16PICOMMS_ENC__End_Frame();
+		pu8Frame = pu8PICOMMS_ENC__Get_FramePointer();
+
+		for(u16Pos = 0U; u16Pos < u16Length; u16Pos++)
+		{
+			u8TS001_Stream[u32TS001_StreamLength + u16Pos] = pu8Frame[u16Pos];
+		}
+
+		if((u8Corrupt == 1U) && ((u32Frame % C_TS001__CORRUPT_EVERY) == 0U))
+		{
+			//any byte but the pad, always a real change
+			u16Pos = (Luint16)(u32TS001__Random() % (Luint32)(u16Length - 1U));
+			u8TS001_Stream[u32TS001_StreamLength + u16Pos] ^= (Luint8)(1U + (u32TS001__Random() % 255U));
+		}
+		else
+		{
+			u32TS001_ExpectedFrames++;
+			u64TS001_ExpectedSum += u64Hash;
+		}
+		u32TS001_StreamLength += u16Length;
+
+		if(u8Corrupt == 1U)
+		{
+			//line noise between frames, never the control char
+			u8Junk = (Luint8)(u32TS001__Random() % 8U);
+			for(u32Counter = 0U; u32Counter < u8Junk; u32Counter++)
+			{
+				u8TS001_Stream[u32TS001_StreamLength] = (Luint8)(u32TS001__Random() % RPOD_PICOMMS_CONTROL_CHAR);
+				u32TS001_StreamLength++;
+				u32TS001_JunkBytes++;
+			}
+		}
+		else
+		{
+			//back to back
+		}
+	}
+}
+
+//feed the stream in random size pieces
+static void vTS001__Feed_Fragmented(void)
+{
+	Luint32 u32Pos;
+	Luint16 u16Chunk;
+
+	u32Pos = 0U;
+	while(u32Pos < u32TS001_StreamLength)
+	{
+		u16Chunk = (Luint16)(1U + (u32TS001__Random() % 97U));
+		if((u32Pos + u16Chunk) > u32TS001_StreamLength)
+		{
+			u16Chunk = (Luint16)(u32TS001_StreamLength - u32Pos);
+		}
+		else
+		{
+			//fall on
+		}
+		vPICOMMS_RX__Receive_Bytes(&u8TS001_Stream[u32Pos], u16Chunk);
+		u32Pos += u16Chunk;
+	}
+}
+
+//hook up our callbacks
+static void vTS001__Attach(void)
+{
+	PICOMMS_RX_frameRXBeginCB = &vTS001__FrameBegin;
+	PICOMMS_RX_frameRXEndCB = &vTS001__FrameEnd;
+	PICOMMS_RX_recvLuint8 = &vTS001__Rx_U8;
+	PICOMMS_RX_recvLint8 = &vTS001__Rx_S8;
+	PICOMMS_RX_recvLuint16 = &vTS001__Rx_U16;
+	PICOMMS_RX_recvLint16 = &vTS001__Rx_S16;
+	PICOMMS_RX_recvLuint32 = &vTS001__Rx_U32;
+	PICOMMS_RX_recvLint32 = &vTS001__Rx_S32;
+	PICOMMS_RX_recvLuint64 = &vTS001__Rx_U64;
+	PICOMMS_RX_recvLint64 = &vTS001__Rx_S64;
+	PICOMMS_RX_recvLfloat32 = &vTS001__Rx_F32;
+	PICOMMS_RX_recvLfloat64 = &vTS001__Rx_F64;
+}
+
+//simple LCG, we want repeatable streams
+static Luint32 u32TS001__Random(void)
+{
+	u32TS001_Seed = (u32TS001_Seed * 1664525U) + 1013904223U;
+	return u32TS001_Seed;
+}
+
+//order dependent hash of a param
+static Luint64 u64TS001__Hash(Luint64 u64Hash, Luint16 u16Index, Luint64 u64Value)
+{
+	return (u64Hash * 1099511628211ULL) ^ ((Luint64)u16Index << 48U) ^ u64Value;
+}
+
+static void vTS001__FrameBegin(void)
+{
+	u64TS001_FrameHash = 0U;
+}
+
+static void vTS001__FrameEnd(void)
+{
+	u64TS001_ReceivedSum += u64TS001_FrameHash;
+}
+
+static void vTS001__Rx_U8(Luint16 u16Index, Luint8 u8Value)
+{
+	u64TS001_FrameHash = u64TS001__Hash(u64TS001_FrameHash, u16Index, u8Value);
+}
+
+static void vTS001__Rx_S8(Luint16 u16Index, Lint8 s8Value)
+{
+	u64TS001_FrameHash = u64TS001__Hash(u64TS001_FrameHash, u16Index, (Luint8)s8Value);
+}
+
+static void vTS001__Rx_U16(Luint16 u16Index, Luint16 u16Value)
+{
+	u64TS001_FrameHash = u64TS001__Hash(u64TS001_FrameHash, u16Index, u16Value);
+}
+
+static void vTS001__Rx_S16(Luint16 u16Index, Lint16 s16Value)
+{
+	u64TS001_FrameHash = u64TS001__Hash(u64TS001_FrameHash, u16Index, (Luint16)s16Value);
+}
+
+static void vTS001__Rx_U32(Luint16 u16Index, Luint32 u32Value)
+{
+	u64TS001_FrameHash = u64TS001__Hash(u64TS001_FrameHash, u16Index, u32Value);
+}
+
+static void vTS001__Rx_S32(Luint16 u16Index, Lint32 s32Value)
+{
+	u64TS001_FrameHash = u64TS001__Hash(u64TS001_FrameHash, u16Index, (Luint32)s32Value);
+}
+
+static void vTS001__Rx_U64(Luint16 u16Index, Luint64 u64Value)
+{
+	u64TS001_FrameHash = u64TS001__Hash(u64TS001_FrameHash, u16Index, u64Value);
+}
+
+static void vTS001__Rx_S64(Luint16 u16Index, Lint64 s64Value)
+{
+	u64TS001_FrameHash = u64TS001__Hash(u64TS001_FrameHash, u16Index, (Luint64)s64Value);
+}
+
+static void vTS001__Rx_F32(Luint16 u16Index, Lfloat32 f32Value)
+{
+	union
+	{
+		Lfloat32 f32;
+		Luint32 u32;
+	}unT;
+
+	unT.f32 = f32Value;
+	u64TS001_FrameHash = u64TS001__Hash(u64TS001_FrameHash, u16Index, unT.u32);
+}
+
+static void vTS001__Rx_F64(Luint16 u16Index, Lfloat64 f64Value)
+{
+	union
+	{
+		Lfloat64 f64;
+		Luint64 u64;
+	}unT;
+
+	unT.f64 = f64Value;
+	u64TS001_FrameHash = u64TS001__Hash(u64TS001_FrameHash, u16Index, unT.u64);
+}
+
+#endif //C_LOCALDEF__LCCM656__ENABLE_TEST_SPEC
+#ifndef C_LOCALDEF__LCCM656__ENABLE_TEST_SPEC
+	#error
+#endif
+
+#endif //C_LOCALDEF__LCCM656__ENABLE_RX
+#endif //C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE
@@ -0,0 +1,786 @@
+/**
+ * @file		LCCM656R0_TS_000.C
+ * @brief		Test spec for the zero shift encoder against the original encoder
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM656R0.FILE.008
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM656__ENABLE_TEST_SPEC == 1U
+
+//host side only, for the timing
+#include <stdio.h>
+#include <time.h>
+
+/** Number of params in our test frame, about the size of the FCU frame */
+#define C_TS000__NUM_PARAMS						(120U)
+
+/** Number of frames to encode for the benchmark */
+#define C_TS000__BENCH_FRAMES					(20000U)
+
+/** Number of benchmark rounds, best round is reported */
+#define C_TS000__BENCH_ROUNDS					(7U)
+
+/** Number of random frames for the bit identical check */
+#define C_TS000__CHECK_FRAMES					(500U)
+
+/** Delta test, params, frames and keyframe period */
+#define C_TS000__DELTA_PARAMS					(24U)
+#define C_TS000__DELTA_FRAMES					(1000U)
+#define C_TS000__DELTA_KEYFRAME					(25U)
+
+extern struct _strPICOMMS sPC;
+
+void vLCCM656R0_TS_000_TCASE_001(void);
+void vLCCM656R0_TS_000_TCASE_002(void);
+void vLCCM656R0_TS_000_TCASE_003(void);
+static void vTS000__Setup_Params(void);
+static Luint32 u32TS000__Random(void);
+static void vTS000__Old_Params(void);
+static Luint16 u16TS000__Old_Frame(void);
+static Luint16 u16TS000__Ref_Frame(void);
+static void vTS000__Ref_Byte(Luint16 *pu16Pos, Luint8 u8Byte);
+static void vTS000__Steer_Length(void);
+static Luint16 u16TS000__New_Frame(void);
+static Luint16 u16TS000__Template_Frame(void);
+#if C_LOCALDEF__LCCM656__ENABLE_RX == 1U
+static Luint16 u16TS000__Delta_Frame(void);
+static void vTS000__Rx_U8(Luint16 u16Index, Luint8 u8Value);
+static void vTS000__Rx_S16(Luint16 u16Index, Lint16 s16Value);
+static void vTS000__Rx_F32(Luint16 u16Index, Lfloat32 f32Value);
+#endif
+
+//test param list
+static PICOMMS_TEMPLATE_PARAM_T sTS000_Params[C_TS000__NUM_PARAMS];
+static struct _strPICOMMS_TEMPLATE sTS000_Template;
+
+//values for the current frame
+static Luint32 u32TS000_Values[C_TS000__NUM_PARAMS];
+static Luint32 u32TS000_Seed;
+
+//copy of the reference frame and its length field
+static Luint8 u8TS000_Ref[RPOD_PICOMMS_BUFFER_SIZE];
+static Luint16 u16TS000_RefField;
+
+#if C_LOCALDEF__LCCM656__ENABLE_RX == 1U
+//delta test, what the node has and what the Pi has decoded
+static PICOMMS_TEMPLATE_PARAM_T sTS000_DeltaParams[C_TS000__DELTA_PARAMS];
+static struct _strPICOMMS_TEMPLATE sTS000_DeltaTemplate;
+static Lfloat64 f64TS000_Truth[C_TS000__DELTA_PARAMS];
+static Lfloat64 f64TS000_Mirror[C_TS000__DELTA_PARAMS];
+#endif
+
+//Function to call the tests for this test specification
+void vLCCM656R0_TS_000(void)
+{
+	//setup the param list
+	vTS000__Setup_Params();
+
+	//Call the test cases
+	vLCCM656R0_TS_000_TCASE_001();
+	vLCCM656R0_TS_000_TCASE_002();
+	vLCCM656R0_TS_000_TCASE_003();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM656R0.TS.000.TCASE.001
+ * @st_test_desc
+ * Random frames through the new encoder and the template encoder must be bit
+ * identical to a reference built to the wire format, the payload from the old
+ * encoder and the header and checksum as the Pi checks them. Every 8th frame
+ * is steered onto a length with an escaped low byte. The old encoder's own
+ * frame must match too, except where it has to escape a length byte as it
+ * shifts the buffer the wrong way in that case.
+ *
+*/
+void vLCCM656R0_TS_000_TCASE_001(void)
+{
+	Luint32 u32Frame;
+	Luint32 u32Fails;
+	Luint32 u32Escaped;
+	Luint16 u16RefLength;
+	Luint16 u16NewLength;
+	Luint16 u16Counter;
+	Luint8 u8Pass;
+	Luint8 u8Escaped;
+	Luint8 *pu8Frame;
+	char cText[128];
+
+	DEBUG_PRINT("START:LCCM656R0.TS.000.TCASE.001\r\n");
+
+	vPICOMMS__Init();
+	u32TS000_Seed = 0x12345678U;
+	u32Fails = 0U;
+	u32Escaped = 0U;
+
+	for(u32Frame = 0U; u32Frame < C_TS000__CHECK_FRAMES; u32Frame++)
+	{
+		//new random payload, force some control chars in
+		for(u16Counter = 0U; u16Counter < C_TS000__NUM_PARAMS; u16Counter++)
+		{
+			u32TS000_Values[u16Counter] = u32TS000__Random();
+			if((u32TS000_Values[u16Counter] & 0x0FU) == 0U)
+			{
+				u32TS000_Values[u16Counter] |= 0x0000D500U;
+			}
+		}
+
+		if((u32Frame & 0x07U) == 0U)
+		{
+			vTS000__Steer_Length();
+		}
+		else
+		{
+			//as it came
+		}
+
+		//reference
+		u16RefLength = u16TS000__Ref_Frame();
+		u8Pass = 1U;
+		if((((u16TS000_RefField >> 8U) & 0xFFU) == RPOD_PICOMMS_CONTROL_CHAR) || ((u16TS000_RefField & 0xFFU) == RPOD_PICOMMS_CONTROL_CHAR))
+		{
+			u8Escaped = 1U;
+			u32Escaped++;
+		}
+		else
+		{
+			u8Escaped = 0U;
+		}
+
+		//original encoder, only right when the length needs no escape
+		if(u8Escaped == 0U)
+		{
+			if(u16TS000__Old_Frame() != u16RefLength)
+			{
+				u8Pass = 0U;
+			}
+			else
+			{
+				for(u16Counter = 0U; u16Counter < u16RefLength; u16Counter++)
+				{
+					if(sPC.sTx.PICOMMS_TX_buffer[u16Counter] != u8TS000_Ref[u16Counter])
+					{
+						u8Pass = 0U;
+					}
+				}
+			}
+		}
+		else
+		{
+			//known bad
+		}
+
+		//explicit index encoder
+		u16NewLength = u16TS000__New_Frame();
+		pu8Frame = pu8PICOMMS_ENC__Get_FramePointer();
+		if(u16NewLength != u16RefLength)
+		{
+			u8Pass = 0U;
+		}
+		else
+		{
+			for(u16Counter = 0U; u16Counter < u16RefLength; u16Counter++)
+			{
+				if(pu8Frame[u16Counter] != u8TS000_Ref[u16Counter])
+				{
+					u8Pass = 0U;
+				}
+			}
+		}
+
+		//template encoder
+		u16NewLength = u16TS000__Template_Frame();
+		pu8Frame = pu8PICOMMS_ENC__Get_FramePointer();
+		if(u16NewLength != u16RefLength)
+		{
+			u8Pass = 0U;
+		}
+		else
+		{
+			for(u16Counter = 0U; u16Counter < u16RefLength; u16Counter++)
+			{
+				if(pu8Frame[u16Counter] != u8TS000_Ref[u16Counter])
+				{
+					u8Pass = 0U;
+				}
+			}
+		}
+
+		if(u8Pass == 0U)
+		{
+			u32Fails++;
+		}
+	}
+
+	sprintf(cText, "INFO: %u frames, %u mismatches, %u with an escaped length\r\n", C_TS000__CHECK_FRAMES, u32Fails, u32Escaped);
+	DEBUG_PRINT(cText);
+
+	if((u32Fails == 0U) && (u32Escaped > 0U) && (sPC.sTx.sEnc.u32TemplateFaults == 0U))
+	{
+		DEBUG_PRINT("PASS:LCCM656R0.TS.000.TCASE.001\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM656R0.TS.000.TCASE.001\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM656R0.TS.000.TCASE.001\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM656R0.TS.000.TCASE.002
+ * @st_test_desc
+ * Benchmark, bytes per second through each encoder.
+ *
+*/
+void vLCCM656R0_TS_000_TCASE_002(void)
+{
+	Luint32 u32Frame;
+	Luint32 u32Round;
+	Luint32 u32Bytes;
+	clock_t tStart;
+	Lfloat64 f64Rate;
+	Lfloat64 f64Old;
+	Lfloat64 f64New;
+	Lfloat64 f64Template;
+	char cText[160];
+
+	DEBUG_PRINT("START:LCCM656R0.TS.000.TCASE.002\r\n");
+
+	vPICOMMS__Init();
+	u32TS000_Seed = 0xCAFEF00DU;
+	for(u32Frame = 0U; u32Frame < C_TS000__NUM_PARAMS; u32Frame++)
+	{
+		u32TS000_Values[u32Frame] = u32TS000__Random();
+	}
+
+	//interleave the encoders and keep the best round of each, the host
+	//shares the core with everything else so single runs are noisy
+	f64Old = 0.0;
+	f64New = 0.0;
+	f64Template = 0.0;
+	for(u32Round = 0U; u32Round < C_TS000__BENCH_ROUNDS; u32Round++)
+	{
+		//original encoder
+		u32Bytes = 0U;
+		tStart = clock();
+		for(u32Frame = 0U; u32Frame < C_TS000__BENCH_FRAMES; u32Frame++)
+		{
+			u32TS000_Values[0] = u32Frame;
+			u32Bytes += u16TS000__Old_Frame();
+		}
+		f64Rate = (Lfloat64)u32Bytes / ((Lfloat64)(clock() - tStart + 1) / (Lfloat64)CLOCKS_PER_SEC);
+		if(f64Rate > f64Old)
+		{
+			f64Old = f64Rate;
+		}
+		else
+		{
+			//fall on
+		}
+
+		//explicit index encoder
+		u32Bytes = 0U;
+		tStart = clock();
+		for(u32Frame = 0U; u32Frame < C_TS000__BENCH_FRAMES; u32Frame++)
+		{
+			u32TS000_Values[0] = u32Frame;
+			u32Bytes += u16TS000__New_Frame();
+		}
+		f64Rate = (Lfloat64)u32Bytes / ((Lfloat64)(clock() - tStart + 1) / (Lfloat64)CLOCKS_PER_SEC);
+		if(f64Rate > f64New)
+		{
+			f64New = f64Rate;
+		}
+		else
+		{
+			//fall on
+		}
+
+		//template encoder
+		u32Bytes = 0U;
+		tStart = clock();
+		for(u32Frame = 0U; u32Frame < C_TS000__BENCH_FRAMES; u32Frame++)
+		{
+			u32TS000_Values[0] = u32Frame;
+			u32Bytes += u16TS000__Template_Frame();
+		}
+		f64Rate = (Lfloat64)u32Bytes / ((Lfloat64)(clock() - tStart + 1) / (Lfloat64)CLOCKS_PER_SEC);
+		if(f64Rate > f64Template)
+		{
+			f64Template = f64Rate;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	sprintf(cText, "INFO: old %.1f MB/s, new %.1f MB/s, template %.1f MB/s\r\n", f64Old / 1.0E6, f64New / 1.0E6, f64Template / 1.0E6);
+	DEBUG_PRINT(cText);
+
+	if(f64Template > f64Old)
+	{
+		DEBUG_PRINT("PASS:LCCM656R0.TS.000.TCASE.002\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM656R0.TS.000.TCASE.002\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM656R0.TS.000.TCASE.002\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM656R0.TS.000.TCASE.003
+ * @st_test_desc
+ * Delta frames of slowly moving telemetry decoded by the RX side. After every
+ * frame each param the Pi holds must be within its deadband of the real value,
+ * keyframes must restore it exactly and come at the keyframe period.
+ *
+*/
+void vLCCM656R0_TS_000_TCASE_003(void)
+{
+#if C_LOCALDEF__LCCM656__ENABLE_RX == 1U
+	Luint32 u32Frame;
+	Luint32 u32Fails;
+	Luint32 u32Sent;
+	Luint32 u32Full;
+	Luint16 u16Counter;
+	Lfloat64 f64Diff;
+	char cText[160];
+
+	DEBUG_PRINT("START:LCCM656R0.TS.000.TCASE.003\r\n");
+
+	vPICOMMS__Init();
+	PICOMMS_RX_recvLuint8 = &vTS000__Rx_U8;
+	PICOMMS_RX_recvLint16 = &vTS000__Rx_S16;
+	PICOMMS_RX_recvLfloat32 = &vTS000__Rx_F32;
+	vPICOMMS_ENC__Set_KeyframePeriod(C_TS000__DELTA_KEYFRAME);
+
+	//a third each of switches, raw accel and scaled floats
+	for(u16Counter = 0U; u16Counter < C_TS000__DELTA_PARAMS; u16Counter++)
+	{
+		sTS000_DeltaParams[u16Counter].u16Index = 0x6000U + u16Counter;
+		switch(u16Counter % 3U)
+		{
+			case 0U:
+				sTS000_DeltaParams[u16Counter].u8Type = (Luint8)PICOMMS_UINT8;
+				sTS000_DeltaParams[u16Counter].f32Deadband = 0.0F;
+				break;
+			case 1U:
+				sTS000_DeltaParams[u16Counter].u8Type = (Luint8)PICOMMS_INT16;
+				sTS000_DeltaParams[u16Counter].f32Deadband = 4.0F;
+				break;
+			default:
+				sTS000_DeltaParams[u16Counter].u8Type = (Luint8)PICOMMS_FLOAT;
+				sTS000_DeltaParams[u16Counter].f32Deadband = 0.05F;
+				break;
+		}
+		f64TS000_Truth[u16Counter] = 0.0;
+		f64TS000_Mirror[u16Counter] = -1.0E9;
+	}
+	vPICOMMS_TEMPLATE__Compile(&sTS000_DeltaTemplate, &sTS000_DeltaParams[0], C_TS000__DELTA_PARAMS);
+
+	u32TS000_Seed = 0xDE17A000U;
+	u32Fails = 0U;
+	u32Sent = 0U;
+	u32Full = 0U;
+	for(u32Frame = 0U; u32Frame < C_TS000__DELTA_FRAMES; u32Frame++)
+	{
+		//move the signals, switches rarely, the rest a little each frame
+		for(u16Counter = 0U; u16Counter < C_TS000__DELTA_PARAMS; u16Counter++)
+		{
+			switch(u16Counter % 3U)
+			{
+				case 0U:
+					if((u32TS000__Random() % 50U) == 0U)
+					{
+						f64TS000_Truth[u16Counter] = (Lfloat64)(1U - (Luint8)f64TS000_Truth[u16Counter]);
+					}
+					else
+					{
+						//no change
+					}
+					break;
+				case 1U:
+					f64TS000_Truth[u16Counter] += (Lfloat64)((Lint32)(u32TS000__Random() % 5U) - 2);
+					break;
+				default:
+					f64TS000_Truth[u16Counter] = (Lfloat64)(Lfloat32)(f64TS000_Truth[u16Counter] + ((Lfloat64)((Lint32)(u32TS000__Random() % 21U) - 10) * 0.002));
+					break;
+			}
+		}
+
+		u32Sent += u16TS000__Delta_Frame();
+		vPICOMMS_RX__Receive_Bytes(pu8PICOMMS_ENC__Get_FramePointer(), sPC.sTx.sEnc.u16FrameLength);
+
+		//check what the Pi now has
+		for(u16Counter = 0U; u16Counter < C_TS000__DELTA_PARAMS; u16Counter++)
+		{
+			f64Diff = f64TS000_Truth[u16Counter] - f64TS000_Mirror[u16Counter];
+			if(f64Diff < 0.0)
+			{
+				f64Diff = -f64Diff;
+			}
+			else
+			{
+				//fall on
+			}
+
+			if((f64Diff > (Lfloat64)sTS000_DeltaParams[u16Counter].f32Deadband) ||
+				((u8PICOMMS_ENC__Is_Keyframe() == 1U) && (f64Diff != 0.0)))
+			{
+				u32Fails++;
+			}
+			else
+			{
+				//in band
+			}
+		}
+
+		//what the same frame would have cost in full
+		u32Full += sPC.sTx.sEnc.u16FrameLength;
+	}
+	u32Full += u32PICOMMS_ENC__Get_BytesSaved();
+
+	sprintf(cText, "INFO: %u bytes sent of %u, saved %u, keyframes %u every %u, fails %u\r\n", u32Sent, u32Full, u32PICOMMS_ENC__Get_BytesSaved(),
+			u32PICOMMS_ENC__Get_Keyframes(), u16PICOMMS_ENC__Get_KeyframeInterval(), u32Fails);
+	DEBUG_PRINT(cText);
+
+	if((u32Fails == 0U) &&
+		(u32PICOMMS_ENC__Get_Keyframes() == (C_TS000__DELTA_FRAMES / C_TS000__DELTA_KEYFRAME)) &&
+		(u16PICOMMS_ENC__Get_KeyframeInterval() == C_TS000__DELTA_KEYFRAME) &&
+		(u32PICOMMS_RX__Get_Frames() == C_TS000__DELTA_FRAMES) &&
+		((u32Sent * 2U) < u32Full))
+	{
+		DEBUG_PRINT("PASS:LCCM656R0.TS.000.TCASE.003\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM656R0.TS.000.TCASE.003\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM656R0.TS.000.TCASE.003\r\n");
+#endif //C_LOCALDEF__LCCM656__ENABLE_RX
+}
+
+//build a param list with every type and some escaped indexes
+static void vTS000__Setup_Params(void)
+{
+	Luint16 u16Counter;
+	const Luint8 u8Types[] = {PICOMMS_FLOAT, PICOMMS_UINT8, PICOMMS_INT16, PICOMMS_UINT16, PICOMMS_UINT32, PICOMMS_INT32, PICOMMS_INT8, PICOMMS_FLOAT};
+
+	for(u16Counter = 0U; u16Counter < C_TS000__NUM_PARAMS; u16Counter++)
+	{
+		sTS000_Params[u16Counter].u16Index = 0x5200U + u16Counter;
+		sTS000_Params[u16Counter].u8Type = u8Types[u16Counter & 0x07U];
+	}
+
+	//indexes that need escaping
+	sTS000_Params[3].u16Index = 0x52D5U;
+	sTS000_Params[4].u16Index = 0xD5D5U;
+	sTS000_Params[5].u16Index = 0xD501U;
+
+	vPICOMMS_TEMPLATE__Compile(&sTS000_Template, &sTS000_Params[0], C_TS000__NUM_PARAMS);
+}
+
+//simple LCG, we want repeatable frames
+static Luint32 u32TS000__Random(void)
+{
+	u32TS000_Seed = (u32TS000_Seed * 1664525U) + 1013904223U;
+	return u32TS000_Seed;
+}
+
+//the params through the original encoder, up to the end of frame
+static void vTS000__Old_Params(void)
+{
+	Luint16 u16Counter;
+	Luint32 u32Value;
+	union
+	{
+		Lfloat32 f32;
+		Luint32 u32;
+	}unT;
+
+	PICOMMS_TX_beginFrame();
+	for(u16Counter = 0U; u16Counter < C_TS000__NUM_PARAMS; u16Counter++)
+	{
+		u32Value = u32TS000_Values[u16Counter];
+		switch(sTS000_Params[u16Counter].u8Type)
+		{
+			case PICOMMS_FLOAT:
+				unT.u32 = u32Value;
+				vPICOMMS_TX__Add_F32(sTS000_Params[u16Counter].u16Index, unT.f32);
+				break;
+			case PICOMMS_UINT8:
+				vPICOMMS_TX__Add_U8(sTS000_Params[u16Counter].u16Index, (Luint8)u32Value);
+				break;
+			case PICOMMS_INT8:
+				PICOMMS_TX_addParameter_int8(sTS000_Params[u16Counter].u16Index, (Lint8)u32Value);
+				break;
+			case PICOMMS_INT16:
+				vPICOMMS_TX__Add_S16(sTS000_Params[u16Counter].u16Index, (Lint16)u32Value);
+				break;
+			case PICOMMS_UINT16:
+				vPICOMMS_TX__Add_U16(sTS000_Params[u16Counter].u16Index, (Luint16)u32Value);
+				break;
+			case PICOMMS_UINT32:
+				vPICOMMS_TX__Add_U32(sTS000_Params[u16Counter].u16Index, u32Value);
+				break;
+			case PICOMMS_INT32:
+				PICOMMS_TX_addParameter_int32(sTS000_Params[u16Counter].u16Index, (Lint32)u32Value);
+				break;
+			default:
+				//not used
+				break;
+		}
+	}
+}
+
+//one frame through the original encoder
+static Luint16 u16TS000__Old_Frame(void)
+{
+	vTS000__Old_Params();
+	return PICOMMS_TX_endFrame();
+}
+
+//one frame to the wire format, the escaped payload from the original encoder
+//and the header and checksum built here. The checksum is the XOR of every
+//byte sent up to the trailer, so an escaped pair adds nothing.
+static Luint16 u16TS000__Ref_Frame(void)
+{
+	Luint16 u16Pos;
+	Luint16 u16Counter;
+	Luint8 u8Checksum;
+
+	vTS000__Old_Params();
+	u16TS000_RefField = sPC.sTx.PICOMMS_TX_bufferPos;
+
+	u16Pos = 0U;
+	u8TS000_Ref[u16Pos] = RPOD_PICOMMS_CONTROL_CHAR;
+	u16Pos++;
+	u8TS000_Ref[u16Pos] = RPOD_PICOMMS_FRAME_START;
+	u16Pos++;
+	vTS000__Ref_Byte(&u16Pos, (Luint8)(u16TS000_RefField >> 8U));
+	vTS000__Ref_Byte(&u16Pos, (Luint8)(u16TS000_RefField & 0xFFU));
+	for(u16Counter = 4U; u16Counter < sPC.sTx.PICOMMS_TX_bufferPos; u16Counter++)
+	{
+		u8TS000_Ref[u16Pos] = sPC.sTx.PICOMMS_TX_buffer[u16Counter];
+		u16Pos++;
+	}
+
+	u8Checksum = 0U;
+	for(u16Counter = 0U; u16Counter < u16Pos; u16Counter++)
+	{
+		u8Checksum ^= u8TS000_Ref[u16Counter];
+	}
+
+	u8TS000_Ref[u16Pos] = RPOD_PICOMMS_CONTROL_CHAR;
+	u8TS000_Ref[u16Pos + 1U] = RPOD_PICOMMS_FRAME_END;
+	u8TS000_Ref[u16Pos + 2U] = u8Checksum;
+	u8TS000_Ref[u16Pos + 3U] = 0x00U;
+
+	return u16Pos + 4U;
+}
+
+//one header byte, escaped
+static void vTS000__Ref_Byte(Luint16 *pu16Pos, Luint8 u8Byte)
+{
+	u8TS000_Ref[*pu16Pos] = u8Byte;
+	*pu16Pos += 1U;
+	if(u8Byte == RPOD_PICOMMS_CONTROL_CHAR)
+	{
+		u8TS000_Ref[*pu16Pos] = u8Byte;
+		*pu16Pos += 1U;
+	}
+	else
+	{
+		//no escape
+	}
+}
+
+//escape more value bytes until the length field low byte is the control char,
+//each value byte turned into the control char adds one to the length
+static void vTS000__Steer_Length(void)
+{
+	Luint16 u16Need;
+	Luint16 u16Param;
+	Luint8 u8Lane;
+	Luint8 u8Lanes;
+	Luint32 u32Mask;
+
+	(void)u16TS000__Ref_Frame();
+	u16Need = (Luint16)(((Luint16)RPOD_PICOMMS_CONTROL_CHAR - (u16TS000_RefField & 0xFFU)) & 0xFFU);
+
+	for(u16Param = 0U; (u16Param < C_TS000__NUM_PARAMS) && (u16Need > 0U); u16Param++)
+	{
+		//value bytes on the wire, the upper nibble of the type is the size
+		u8Lanes = (Luint8)(sTS000_Params[u16Param].u8Type >> 4U);
+		for(u8Lane = 0U; (u8Lane < u8Lanes) && (u16Need > 0U); u8Lane++)
+		{
+			u32Mask = (Luint32)0xFFU << (8U * u8Lane);
+			if((u32TS000_Values[u16Param] & u32Mask) != ((Luint32)RPOD_PICOMMS_CONTROL_CHAR << (8U * u8Lane)))
+			{
+				u32TS000_Values[u16Param] = (u32TS000_Values[u16Param] & ~u32Mask) | ((Luint32)RPOD_PICOMMS_CONTROL_CHAR << (8U * u8Lane));
+				u16Need--;
+			}
+			else
+			{
+				//already escaped
+			}
+		}
+	}
+}
+
+//one frame through the explicit index encoder
+static Luint16 u16TS000__New_Frame(void)
+{
+	Luint16 u16Counter;
+	Luint32 u32Value;
+	union
+	{
+		Lfloat32 f32;
+		Luint32 u32;
+	}unT;
+
+	vPICOMMS_ENC__Begin_Frame();
+	for(u16Counter = 0U; u16Counter < C_TS000__NUM_PARAMS; u16Counter++)
+	{
+		u32Value = u32TS000_Values[u16Counter];
+		switch(sTS000_Params[u16Counter].u8Type)
+		{
+			case PICOMMS_FLOAT:
+				unT.u32 = u32Value;
+				vPICOMMS_ENC__Add_F32(sTS000_Params[u16Counter].u16Index, unT.f32);
+				break;
+			case PICOMMS_UINT8:
+				vPICOMMS_ENC__Add_U8(sTS000_Params[u16Counter].u16Index, (Luint8)u32Value);
+				break;
+			case PICOMMS_INT8:
+				vPICOMMS_ENC__Add_S8(sTS000_Params[u16Counter].u16Index, (Lint8)u32Value);
+				break;
+			case PICOMMS_INT16:
+				vPICOMMS_ENC__Add_S16(sTS000_Params[u16Counter].u16Index, (Lint16)u32Value);
+				break;
+			case PICOMMS_UINT16:
+				vPICOMMS_ENC__Add_U16(sTS000_Params[u16Counter].u16Index, (Luint16)u32Value);
+				break;
+			case PICOMMS_UINT32:
+				vPICOMMS_ENC__Add_U32(sTS000_Params[u16Counter].u16Index, u32Value);
+				break;
+			case PICOMMS_INT32:
+				vPICOMMS_ENC__Add_S32(sTS000_Params[u16Counter].u16Index, (Lint32)u32Value);
+				break;
+			default:
+				//not used
+				break;
+		}
+	}
+	return u16PICOMMS_ENC__End_Frame();
+}
+
+//one frame through the template encoder
+static Luint16 u16TS000__Template_Frame(void)
+{
+	Luint16 u16Counter;
+	Luint32 u32Value;
+	union
+	{
+		Lfloat32 f32;
+		Luint32 u32;
+	}unT;
+
+	vPICOMMS_ENC__Begin_Template(&sTS000_Template);
+	for(u16Counter = 0U; u16Counter < C_TS000__NUM_PARAMS; u16Counter++)
+	{
+		u32Value = u32TS000_Values[u16Counter];
+		switch(sTS000_Params[u16Counter].u8Type)
+		{
+			case PICOMMS_FLOAT:
+				unT.u32 = u32Value;
+				vPICOMMS_ENC__Next_F32(unT.f32);
+				break;
+			case PICOMMS_UINT8:
+				vPICOMMS_ENC__Next_U8((Luint8)u32Value);
+				break;
+			case PICOMMS_INT8:
+				vPICOMMS_ENC__Next_S8((Lint8)u32Value);
+				break;
+			case PICOMMS_INT16:
+				vPICOMMS_ENC__Next_S16((Lint16)u32Value);
+				break;
+			case PICOMMS_UINT16:
+				vPICOMMS_ENC__Next_U16((Luint16)u32Value);
+				break;
+			case PICOMMS_UINT32:
+				vPICOMMS_ENC__Next_U32(u32Value);
+				break;
+			case PICOMMS_INT32:
+				vPICOMMS_ENC__Next_S32((Lint32)u32Value);
+				break;
+			default:
+				//not used
+				break;
+		}
+	}
+	return u16PICOMMS_ENC__End_Frame();
+}
+
+#if C_LOCALDEF__LCCM656__ENABLE_RX == 1U
+//one delta frame of the current truth
+static Luint16 u16TS000__Delta_Frame(void)
+{
+	Luint16 u16Counter;
+
+	vPICOMMS_ENC__Begin_Delta(&sTS000_DeltaTemplate);
+	for(u16Counter = 0U; u16Counter < C_TS000__DELTA_PARAMS; u16Counter++)
+	{
+		switch(sTS000_DeltaParams[u16Counter].u8Type)
+		{
+			case PICOMMS_UINT8:
+				vPICOMMS_ENC__Next_U8((Luint8)f64TS000_Truth[u16Counter]);
+				break;
+			case PICOMMS_INT16:
+				vPICOMMS_ENC__Next_S16((Lint16)f64TS000_Truth[u16Counter]);
+				break;
+			default:
+				vPICOMMS_ENC__Next_F32((Lfloat32)f64TS000_Truth[u16Counter]);
+				break;
+		}
+	}
+	return u16PICOMMS_ENC__End_Frame();
+}
+
+static void vTS000__Rx_U8(Luint16 u16Index, Luint8 u8Value)
+{
+	f64TS000_Mirror[u16Index - 0x6000U] = (Lfloat64)u8Value;
+}
+
+static void vTS000__Rx_S16(Luint16 u16Index, Lint16 s16Value)
+{
+	f64TS000_Mirror[u16Index - 0x6000U] = (Lfloat64)s16Value;
+}
+
+static void vTS000__Rx_F32(Luint16 u16Index, Lfloat32 f32Value)
+{
+	f64TS000_Mirror[u16Index - 0x6000U] = (Lfloat64)f32Value;
+}
+#endif //C_LOCALDEF__LCCM656__ENABLE_RX
+
+#endif //C_LOCALDEF__LCCM656__ENABLE_TEST_SPEC
+#ifndef C_LOCALDEF__LCCM656__ENABLE_TEST_SPEC
+	#error
+#endif
+
+#endif //C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE
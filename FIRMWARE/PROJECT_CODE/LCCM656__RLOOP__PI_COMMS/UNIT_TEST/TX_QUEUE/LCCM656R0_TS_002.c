@@ -0,0 +1,323 @@
+/**
+ * @file		LCCM656R0_TS_002.C
+ * @brief		Test spec for the transmit queue against a simulated UART DMA
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM656R0.FILE.011
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM656__ENABLE_RX == 1U
+#if C_LOCALDEF__LCCM656__ENABLE_TEST_SPEC == 1U
+
+//host side only
+#include <stdio.h>
+
+/** Number of 10ms ticks to run each case for */
+#define C_TS002__TICKS							(2000U)
+
+/** Bytes the UART moves per tick, 57600 baud is about 57 */
+#define C_TS002__BYTES_PER_TICK					(57U)
+
+/** Filler params per frame, sets the frame size */
+#define C_TS002__FILL_PARAMS					(8U)
+
+/** Sequence number param index */
+#define C_TS002__SEQ_INDEX						(0x7000U)
+
+void vLCCM656R0_TS_002_TCASE_001(void);
+void vLCCM656R0_TS_002_TCASE_002(void);
+void vLCCM656R0_TS_002_TCASE_003(void);
+static void vTS002__Reset(void);
+static void vTS002__Build_Frame(void);
+static void vTS002__Service_DMA(void);
+static void vTS002__Rx_U32(Luint16 u16Index, Luint32 u32Value);
+
+extern struct _strPICOMMS sPC;
+
+//simulated DMA
+static Luint8 *pu8TS002_Wire;
+static Luint16 u16TS002_WireLength;
+static Luint16 u16TS002_WirePos;
+
+//sequence numbers built and received
+static Luint32 u32TS002_Built;
+static Luint32 u32TS002_LastRx;
+static Luint32 u32TS002_Received;
+static Luint32 u32TS002_OutOfOrder;
+
+//frames built while another was on the wire
+static Luint32 u32TS002_Overlapped;
+
+//Function to call the tests for this test specification
+void vLCCM656R0_TS_002(void)
+{
+	//Call the test cases
+	vLCCM656R0_TS_002_TCASE_001();
+	vLCCM656R0_TS_002_TCASE_002();
+	vLCCM656R0_TS_002_TCASE_003();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM656R0.TS.002.TCASE.001
+ * @st_test_desc
+ * Producer holds off while the queue is full. Every frame must arrive in
+ * order, with frames built while the last one is still on the wire.
+ *
+*/
+void vLCCM656R0_TS_002_TCASE_001(void)
+{
+	Luint32 u32Tick;
+	char cText[160];
+
+	DEBUG_PRINT("START:LCCM656R0.TS.002.TCASE.001\r\n");
+
+	vTS002__Reset();
+	for(u32Tick = 0U; u32Tick < C_TS002__TICKS; u32Tick++)
+	{
+		vPICOMMS_TXQ__10MS_ISR();
+		if(u8PICOMMS_TXQ__Is_Full() == 0U)
+		{
+			vTS002__Build_Frame();
+		}
+		else
+		{
+			//back pressure
+		}
+		vTS002__Service_DMA();
+	}
+
+	sprintf(cText, "INFO: built %u, received %u, overlapped %u, high water %u, dropped %u\r\n", u32TS002_Built, u32TS002_Received,
+			u32TS002_Overlapped, u8PICOMMS_TXQ__Get_HighWater(), u32PICOMMS_TXQ__Get_Dropped());
+	DEBUG_PRINT(cText);
+
+	//up to a full queue may still be waiting or on the wire
+	if((u32PICOMMS_TXQ__Get_Dropped() == 0U) &&
+		(u32TS002_OutOfOrder == 0U) &&
+		((u32TS002_Built - u32TS002_Received) <= C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH) &&
+		(u32TS002_Overlapped > 0U) &&
+		(u8PICOMMS_TXQ__Get_HighWater() == C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH))
+	{
+		DEBUG_PRINT("PASS:LCCM656R0.TS.002.TCASE.001\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM656R0.TS.002.TCASE.001\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM656R0.TS.002.TCASE.001\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM656R0.TS.002.TCASE.002
+ * @st_test_desc
+ * Producer ignores the queue and overruns it. Frames may be lost as per the
+ * overrun policy but what arrives must be in order, the drops must be counted
+ * and a drop must force the next delta frame to be a keyframe.
+ *
+*/
+void vLCCM656R0_TS_002_TCASE_002(void)
+{
+	Luint32 u32Tick;
+	char cText[160];
+
+	DEBUG_PRINT("START:LCCM656R0.TS.002.TCASE.002\r\n");
+
+	vTS002__Reset();
+	for(u32Tick = 0U; u32Tick < C_TS002__TICKS; u32Tick++)
+	{
+		vPICOMMS_TXQ__10MS_ISR();
+		vTS002__Build_Frame();
+		vTS002__Service_DMA();
+	}
+
+	sprintf(cText, "INFO: built %u, received %u, dropped %u\r\n", u32TS002_Built, u32TS002_Received, u32PICOMMS_TXQ__Get_Dropped());
+	DEBUG_PRINT(cText);
+
+	if((u32PICOMMS_TXQ__Get_Dropped() > 0U) &&
+		(u32TS002_OutOfOrder == 0U) &&
+		((u32TS002_Received + u32PICOMMS_TXQ__Get_Dropped() + C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH) >= u32TS002_Built) &&
+		(sPC.sTx.sDelta.u8ForceKeyframe == 1U))
+	{
+		DEBUG_PRINT("PASS:LCCM656R0.TS.002.TCASE.002\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM656R0.TS.002.TCASE.002\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM656R0.TS.002.TCASE.002\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM656R0.TS.002.TCASE.003
+ * @st_test_desc
+ * Producer only builds every 10th tick so the wire goes idle, the idle gaps
+ * must be counted and the longest must be under the producer period.
+ *
+*/
+void vLCCM656R0_TS_002_TCASE_003(void)
+{
+	Luint32 u32Tick;
+	char cText[160];
+
+	DEBUG_PRINT("START:LCCM656R0.TS.002.TCASE.003\r\n");
+
+	vTS002__Reset();
+	for(u32Tick = 0U; u32Tick < C_TS002__TICKS; u32Tick++)
+	{
+		vPICOMMS_TXQ__10MS_ISR();
+		if((u32Tick % 10U) == 0U)
+		{
+			vTS002__Build_Frame();
+		}
+		else
+		{
+			//quiet
+		}
+		vTS002__Service_DMA();
+	}
+
+	sprintf(cText, "INFO: received %u, idle gaps %u, longest %u ticks\r\n", u32TS002_Received, u32PICOMMS_TXQ__Get_IdleGaps(), u32PICOMMS_TXQ__Get_MaxIdleTicks());
+	DEBUG_PRINT(cText);
+
+	if((u32TS002_Received == u32TS002_Built) &&
+		(u32PICOMMS_TXQ__Get_IdleGaps() == (u32TS002_Built - 1U)) &&
+		(u32PICOMMS_TXQ__Get_MaxIdleTicks() < 10U) &&
+		(u8PICOMMS_TXQ__Get_HighWater() == 1U))
+	{
+		DEBUG_PRINT("PASS:LCCM656R0.TS.002.TCASE.003\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM656R0.TS.002.TCASE.003\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM656R0.TS.002.TCASE.003\r\n");
+}
+
+//fresh module and counters
+static void vTS002__Reset(void)
+{
+	vPICOMMS__Init();
+	PICOMMS_RX_recvLuint32 = &vTS002__Rx_U32;
+
+	pu8TS002_Wire = 0;
+	u16TS002_WireLength = 0U;
+	u16TS002_WirePos = 0U;
+	u32TS002_Built = 0U;
+	u32TS002_LastRx = 0U;
+	u32TS002_Received = 0U;
+	u32TS002_OutOfOrder = 0U;
+	u32TS002_Overlapped = 0U;
+}
+
+//a frame with a sequence number and some filler, about 90 bytes
+static void vTS002__Build_Frame(void)
+{
+	Luint16 u16Counter;
+
+	if(u8PICOMMS_TXQ__Is_OnWire() == 1U)
+	{
+		u32TS002_Overlapped++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	u32TS002_Built++;
+	vPICOMMS_ENC__Begin_Frame();
+	vPICOMMS_ENC__Add_U32(C_TS002__SEQ_INDEX, u32TS002_Built);
+	for(u16Counter = 0U; u16Counter < C_TS002__FILL_PARAMS; u16Counter++)
+	{
+		vPICOMMS_ENC__Add_U16(0x7100U + u16Counter, (Luint16)u32TS002_Built);
+	}
+	vPICOMMS_ENC__Queue_Frame();
+}
+
+//move a ticks worth of bytes, then hand off like the node does
+static void vTS002__Service_DMA(void)
+{
+	Luint16 u16Chunk;
+
+	if(pu8TS002_Wire != 0)
+	{
+		u16Chunk = u16TS002_WireLength - u16TS002_WirePos;
+		if(u16Chunk > C_TS002__BYTES_PER_TICK)
+		{
+			u16Chunk = C_TS002__BYTES_PER_TICK;
+		}
+		else
+		{
+			//last of the frame
+		}
+
+		vPICOMMS_RX__Receive_Bytes(&pu8TS002_Wire[u16TS002_WirePos], u16Chunk);
+		u16TS002_WirePos += u16Chunk;
+
+		if(u16TS002_WirePos == u16TS002_WireLength)
+		{
+			//DMA done
+			pu8TS002_Wire = 0;
+			vPICOMMS_TXQ__Tx_Complete();
+		}
+		else
+		{
+			//still busy
+		}
+	}
+	else
+	{
+		//idle
+	}
+
+	if(pu8TS002_Wire == 0)
+	{
+		pu8TS002_Wire = pu8PICOMMS_TXQ__Start_Next(&u16TS002_WireLength);
+		u16TS002_WirePos = 0U;
+	}
+	else
+	{
+		//busy
+	}
+}
+
+static void vTS002__Rx_U32(Luint16 u16Index, Luint32 u32Value)
+{
+	if(u16Index == C_TS002__SEQ_INDEX)
+	{
+		if(u32Value <= u32TS002_LastRx)
+		{
+			u32TS002_OutOfOrder++;
+		}
+		else
+		{
+			//in order
+		}
+		u32TS002_LastRx = u32Value;
+		u32TS002_Received++;
+	}
+	else
+	{
+		//not ours
+	}
+}
+
+#endif //C_LOCALDEF__LCCM656__ENABLE_TEST_SPEC
+#ifndef C_LOCALDEF__LCCM656__ENABLE_TEST_SPEC
+	#error
+#endif
+
+#endif //C_LOCALDEF__LCCM656__ENABLE_RX
+#endif //C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE
+
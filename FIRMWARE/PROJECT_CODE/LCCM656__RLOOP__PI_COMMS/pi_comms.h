@@ -13,6 +13,23 @@
 		//our default packet types.
 		#include <LCCM656__RLOOP__PI_COMMS/pi_comms__packet_types.h>
 
+		//tx queue options
+		#ifndef C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM656__TX_DROP_OLDEST
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM656__TX_FRAME_SIZE
+			#error
+		#endif
+		#if (C_LOCALDEF__LCCM656__TX_FRAME_SIZE & 0x03U) != 0U
+			#error "TX frame size must be a multiple of 4"
+		#endif
+		#if (C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH < 2U) || (C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH > 8U)
+			#error "TX queue depth must be 2 to 8"
+		#endif
+
 		/*******************************************************************************
 		Defines
 		*******************************************************************************/
@@ -22,6 +39,34 @@
 		#define RPOD_PICOMMS_PARAMETER_START 		0xD3U
 		#define RPOD_PICOMMS_FRAME_END 				0xD8U
 
+		/** Worst case frame header, SOF + length bytes where both length bytes
+		 * may need escaping. The encoder writes the payload after this so the
+		 * header never has to be shifted in. */
+		#define C_PICOMMS_ENC__HEADER_RESERVE		(6U)
+
+		/** Frame trailer, control + EOF + checksum + pad */
+		#define C_PICOMMS_ENC__TRAILER_SIZE			(4U)
+
+		/** Worst case param header, control + param start + type + 2x escaped index */
+		#define C_PICOMMS_ENC__MAX_PARAM_HEADER		(7U)
+
+		/** Max params in a precompiled frame template */
+		#define C_PICOMMS_TEMPLATE__MAX_PARAMS		(128U)
+
+		/** Frames from one keyframe to the next unless the node sets its own period */
+		#define C_PICOMMS_DELTA__DEFAULT_KEYFRAME	(10U)
+
+		/** Transmit queue slot markers */
+		#define C_PICOMMS_TXQ__NO_SLOT				(0xFFU)
+
+		/** Rx ring of decoded params, must be a power of two and larger than
+		 * the biggest frame we will accept */
+		#define C_PICOMMS_RX__RING_SIZE				(4096U)
+		#define C_PICOMMS_RX__RING_MASK				(C_PICOMMS_RX__RING_SIZE - 1U)
+
+		/** Max entries in a nodes receive table, multiple of 32 */
+		#define C_PICOMMS_RX__MAX_TABLE				(64U)
+
 		extern void (*PICOMMS_RX_frameRXBeginCB) ();
 
 		extern void (*PICOMMS_RX_recvLuint8) (Luint16 index, Luint8 data);
@@ -52,6 +97,122 @@
 			PICOMMS_DOUBLE = 0x83
 		};
 
+		/** Rx parser states, one byte is consumed per step */
+		typedef enum
+		{
+			/** Looking for the control + SOF pair */
+			PICOMMS_RX_STATE__HUNT = 0U,
+
+			/** Length MSB */
+			PICOMMS_RX_STATE__LENGTH_HI,
+
+			/** Length LSB */
+			PICOMMS_RX_STATE__LENGTH_LO,
+
+			/** Expecting the control char of a param start or the frame end */
+			PICOMMS_RX_STATE__PARAM_CONTROL,
+
+			/** Param type */
+			PICOMMS_RX_STATE__PARAM_TYPE,
+
+			/** Param index MSB */
+			PICOMMS_RX_STATE__PARAM_INDEX_HI,
+
+			/** Param index LSB */
+			PICOMMS_RX_STATE__PARAM_INDEX_LO,
+
+			/** Param data bytes */
+			PICOMMS_RX_STATE__PARAM_DATA,
+
+			/** Unescaped checksum after the EOF */
+			PICOMMS_RX_STATE__CHECKSUM,
+
+			/** Trailing pad byte */
+			PICOMMS_RX_STATE__PAD
+
+		}E_PICOMMS_RX__STATE_T;
+
+		/** A received value in its native type */
+		typedef union
+		{
+			Luint8 u8;
+			Lint8 s8;
+			Luint16 u16;
+			Lint16 s16;
+			Luint32 u32;
+			Lint32 s32;
+			Luint64 u64;
+			Lint64 s64;
+			Lfloat32 f32;
+			Lfloat64 f64;
+
+		}PICOMMS_RX_VALUE_T;
+
+		/** An entry in a nodes receive table, the table must be sorted by index */
+		typedef struct
+		{
+			/** Param index */
+			Luint16 u16Index;
+
+			/** Expected type, see PICOMMS_paramTypes. A mismatch rejects the frame */
+			Luint8 u8Type;
+
+			/** Where the value is written, must be the size of the type */
+			void *pvDest;
+
+			/** Optional check, return 1 to accept. A reject drops the whole frame */
+			Luint8 (*pu8Validate)(Luint16 u16Index, const PICOMMS_RX_VALUE_T *puValue);
+
+		}PICOMMS_RX_PARAM_T;
+
+		/** A single entry in a users frame template list */
+		typedef struct
+		{
+			/** The parameter index */
+			Luint16 u16Index;
+
+			/** The parameter type, see PICOMMS_paramTypes */
+			Luint8 u8Type;
+
+			/** Delta mode only, the param is not resent until it has moved more
+			 * than this from the last sent value. 0 = send on any change */
+			Lfloat32 f32Deadband;
+
+		}PICOMMS_TEMPLATE_PARAM_T;
+
+		/** A precompiled frame template.
+		 * The param headers (including any escaping of the index) are built
+		 * once at compile time so only the payload is serialised each frame. */
+		struct _strPICOMMS_TEMPLATE
+		{
+			/** Precompiled param slots */
+			struct
+			{
+				/** The escaped header bytes */
+				Luint8 u8Header[C_PICOMMS_ENC__MAX_PARAM_HEADER];
+
+				/** Number of valid header bytes */
+				Luint8 u8HeaderLength;
+
+				/** XOR of the header bytes for the running checksum */
+				Luint8 u8HeaderXOR;
+
+				/** The param type, used to check the caller is in step */
+				Luint8 u8Type;
+
+				/** The raw index, used if we need to fall back */
+				Luint16 u16Index;
+
+				/** Delta mode deadband */
+				Lfloat32 f32Deadband;
+
+			}sSlot[C_PICOMMS_TEMPLATE__MAX_PARAMS];
+
+			/** Number of slots in use */
+			Luint16 u16NumParams;
+
+		};
+
 
 		/*******************************************************************************
 		Structures
@@ -68,36 +229,217 @@
 			struct
 			{
 			
-				/** Support multiple transmit buffers so as we can
-				* implement double or tripple buffering */
-				Luint8 u8BufferIndex;
-			
+				/** Original encoder buffer, also transmit queue buffer 0 */
 				#ifndef WIN32
-				Luint8 PICOMMS_TX_buffer[RPOD_PICOMMS_BUFFER_SIZE] __attribute__((aligned(0x04)));
+				Luint8 PICOMMS_TX_buffer[C_LOCALDEF__LCCM656__TX_FRAME_SIZE] __attribute__((aligned(0x04)));
 				#else
-				Luint8 PICOMMS_TX_buffer[RPOD_PICOMMS_BUFFER_SIZE];
+				Luint8 PICOMMS_TX_buffer[C_LOCALDEF__LCCM656__TX_FRAME_SIZE];
 				#endif
 				Luint16 PICOMMS_TX_bufferPos;
 				Luint16 PICOMMS_TX_frameLength;
 				Luint8 u8Checksum;
-				
+
+				/** Zero shift encoder, writes into the transmit queue */
+				struct
+				{
+					/** Buffer being written, a transmit queue buffer or 0 if the
+					 * frame is being dropped */
+					Luint8 *pu8Buffer;
+
+					/** Current write position, payload starts at C_PICOMMS_ENC__HEADER_RESERVE */
+					Luint16 u16Pos;
+
+					/** Running XOR of everything written after the header */
+					Luint8 u8Checksum;
+
+					/** Offset of the SOF once the frame has been ended */
+					Luint16 u16FrameStart;
+
+					/** Total frame length once ended */
+					Luint16 u16FrameLength;
+
+					/** Active template, or 0 */
+					const struct _strPICOMMS_TEMPLATE *pTemplate;
+
+					/** The next template slot to be written */
+					Luint16 u16Slot;
+
+					/** Params dropped as they would not fit */
+					Luint32 u32Overflows;
+
+					/** Template slot type or count mismatches */
+					Luint32 u32TemplateFaults;
+
+				}sEnc;
+
+				/** Delta (change only) mode for template frames */
+				struct
+				{
+					/** 1 = the current frame is a delta frame */
+					Luint8 u8Active;
+
+					/** 1 = the current frame is a keyframe, everything is sent */
+					Luint8 u8Keyframe;
+
+					/** Set to force the next frame to be a keyframe */
+					Luint8 u8ForceKeyframe;
+
+					/** Template the shadows belong to */
+					const struct _strPICOMMS_TEMPLATE *pTemplate;
+
+					/** Frames from one keyframe to the next */
+					Luint16 u16KeyframePeriod;
+
+					/** Frames sent since the last keyframe, including it */
+					Luint16 u16FramesSinceKey;
+
+					/** Frames between the last two keyframes */
+					Luint16 u16KeyframeInterval;
+
+					/** Last sent value of each template slot */
+					union
+					{
+						Lint64 s64;
+						Lfloat64 f64;
+					}uShadow[C_PICOMMS_TEMPLATE__MAX_PARAMS];
+
+					/** Bytes not sent as the param was inside its deadband */
+					Luint32 u32BytesSaved;
+
+					/** Keyframes sent */
+					Luint32 u32Keyframes;
+
+				}sDelta;
+
+				/** N deep transmit queue, the next frame is built while the
+				 * last is still on the wire */
+				struct
+				{
+					/** Frame buffers 1 onwards, the encoder writes straight into these */
+					#ifndef WIN32
+					Luint8 u8Buffer[C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH - 1U][C_LOCALDEF__LCCM656__TX_FRAME_SIZE] __attribute__((aligned(0x04)));
+					#else
+					Luint8 u8Buffer[C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH - 1U][C_LOCALDEF__LCCM656__TX_FRAME_SIZE];
+					#endif
+
+					/** Start and length of the frame in each buffer */
+					Luint16 u16Start[C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH];
+					Luint16 u16Length[C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH];
+
+					/** Buffers in use, bit per buffer */
+					Luint32 u32UsedMask;
+
+					/** Queued buffers, oldest first */
+					Luint8 u8Fifo[C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH];
+					Luint8 u8FifoOut;
+					Luint8 u8FifoCount;
+
+					/** Buffer being written, or C_PICOMMS_TXQ__NO_SLOT if the
+					 * frame is going to be dropped */
+					Luint8 u8WriteSlot;
+
+					/** Buffer on the wire, or C_PICOMMS_TXQ__NO_SLOT */
+					Luint8 u8WireSlot;
+
+					/** Most frames queued or on the wire at once */
+					Luint8 u8HighWater;
+
+					/** Frames pushed and fully sent */
+					Luint32 u32Pushed;
+					Luint32 u32Sent;
+
+					/** Overruns */
+					Luint32 u32DroppedOldest;
+					Luint32 u32DroppedNewest;
+
+					/** 10ms ticks, for the idle gap timing */
+					Luint32 u32Ticks;
+
+					/** 1 = the wire is idle with nothing queued */
+					Luint8 u8Idle;
+					Luint32 u32IdleStart;
+
+					/** Idle gaps, count, total and longest in 10ms ticks */
+					Luint32 u32IdleGaps;
+					Luint32 u32IdleTicks;
+					Luint32 u32MaxIdleTicks;
+
+				}sQueue;
+
 			}sTx;
 
 			/** Receive side */
 			struct
 			{
+				/** Parser state, kept between calls so frames can arrive in any size pieces */
+				E_PICOMMS_RX__STATE_T eState;
+
+				/** Previous byte was an unpaired control char */
+				Luint8 u8Escape;
+
+				/** Running XOR of the frame */
+				Luint8 u8Checksum;
+
+				/** Data bytes left in the current param */
+				Luint8 u8DataRemain;
+
+				/** Length from the frame header */
+				Luint16 u16Length;
+
+				/** Raw bytes seen between the header and the trailer */
+				Luint16 u16PayloadRaw;
 
-				Luint16 bufferBegin;
-				Luint16 bufferLength;
+				/** Raw bytes seen since the SOF, dropped if the frame fails */
+				Luint16 u16FrameRaw;
+
+				/** Ring write index, free running, masked on access */
+				Luint16 u16Head;
+
+				/** Start of the frame being built, free running */
+				Luint16 u16Tail;
+
+				/** Decoded params: type, index MSB, index LSB, data MSB first */
 				#ifndef WIN32
-				Luint8 u8Buffer[RPOD_PICOMMS_BUFFER_SIZE] __attribute__((aligned(0x04)));
-				Luint8 u8TempFrameBuffer[RPOD_PICOMMS_BUFFER_SIZE] __attribute__((aligned(0x04)));
+				Luint8 u8Ring[C_PICOMMS_RX__RING_SIZE] __attribute__((aligned(0x04)));
 				#else
-				Luint8 u8Buffer[RPOD_PICOMMS_BUFFER_SIZE];
-				Luint8 u8TempFrameBuffer[RPOD_PICOMMS_BUFFER_SIZE];
+				Luint8 u8Ring[C_PICOMMS_RX__RING_SIZE];
 				#endif
-				//quick and nasty fault counter
-				Luint32 u32Faults;
+
+				/** Frames passed up to the user */
+				Luint32 u32Frames;
+
+				/** Frames abandoned part way through (bad escape, length or ring space) */
+				Luint32 u32Resyncs;
+
+				/** Frames with a bad checksum */
+				Luint32 u32ChecksumFaults;
+
+				/** Bytes thrown away while hunting or from failed frames */
+				Luint32 u32DroppedBytes;
+
+				/** Registered receive table, sorted by index */
+				const PICOMMS_RX_PARAM_T *pTable;
+
+				/** Entries in the table */
+				Luint16 u16TableSize;
+
+				/** Called once per applied frame */
+				void (*pCommitCB)(void);
+
+				/** Table slots written by the last applied frame */
+				Luint32 u32UpdateMask[C_PICOMMS_RX__MAX_TABLE / 32U];
+
+				/** Good frames not applied due to a type mismatch or a validator */
+				Luint32 u32RejectedFrames;
+
+				/** Values refused by a validator */
+				Luint32 u32Rejected;
+
+				/** Table params received with the wrong type */
+				Luint32 u32TypeFaults;
+
+				/** Tables refused at registration (unsorted or too big) */
+				Luint32 u32TableFaults;
 
 			}sRx;
 
@@ -143,11 +485,68 @@
 		void vPICOMMS_TX__Add_U32(Luint16 u16Index, Luint32 data);
 		void vPICOMMS_TX__Add_F32(Luint16 u16Index, Lfloat32 data);
 		void PICOMMS_TX_addParameter_double(Luint16 u16Index, Lfloat64 data);
-		
+
+		//tx encoder
+		void vPICOMMS_ENC__Init(void);
+		void vPICOMMS_ENC__Begin_Frame(void);
+		Luint16 u16PICOMMS_ENC__End_Frame(void);
+		Luint8 * pu8PICOMMS_ENC__Get_FramePointer(void);
+		void vPICOMMS_ENC__Queue_Frame(void);
+		void vPICOMMS_ENC__Add_U8(Luint16 u16Index, Luint8 u8Value);
+		void vPICOMMS_ENC__Add_S8(Luint16 u16Index, Lint8 s8Value);
+		void vPICOMMS_ENC__Add_U16(Luint16 u16Index, Luint16 u16Value);
+		void vPICOMMS_ENC__Add_S16(Luint16 u16Index, Lint16 s16Value);
+		void vPICOMMS_ENC__Add_U32(Luint16 u16Index, Luint32 u32Value);
+		void vPICOMMS_ENC__Add_S32(Luint16 u16Index, Lint32 s32Value);
+		void vPICOMMS_ENC__Add_U64(Luint16 u16Index, Luint64 u64Value);
+		void vPICOMMS_ENC__Add_S64(Luint16 u16Index, Lint64 s64Value);
+		void vPICOMMS_ENC__Add_F32(Luint16 u16Index, Lfloat32 f32Value);
+		void vPICOMMS_ENC__Add_F64(Luint16 u16Index, Lfloat64 f64Value);
+		void vPICOMMS_ENC__Begin_Template(const struct _strPICOMMS_TEMPLATE *pTemplate);
+		void vPICOMMS_ENC__Next_U8(Luint8 u8Value);
+		void vPICOMMS_ENC__Next_S8(Lint8 s8Value);
+		void vPICOMMS_ENC__Next_U16(Luint16 u16Value);
+		void vPICOMMS_ENC__Next_S16(Lint16 s16Value);
+		void vPICOMMS_ENC__Next_U32(Luint32 u32Value);
+		void vPICOMMS_ENC__Next_S32(Lint32 s32Value);
+		void vPICOMMS_ENC__Next_F32(Lfloat32 f32Value);
+		void vPICOMMS_ENC__Next_F64(Lfloat64 f64Value);
+		void vPICOMMS_ENC__Begin_Delta(const struct _strPICOMMS_TEMPLATE *pTemplate);
+		void vPICOMMS_ENC__Set_KeyframePeriod(Luint16 u16Frames);
+		void vPICOMMS_ENC__Force_Keyframe(void);
+		Luint8 u8PICOMMS_ENC__Is_Keyframe(void);
+		Luint32 u32PICOMMS_ENC__Get_BytesSaved(void);
+		Luint32 u32PICOMMS_ENC__Get_Keyframes(void);
+		Luint16 u16PICOMMS_ENC__Get_KeyframeInterval(void);
+		void vPICOMMS_TEMPLATE__Compile(struct _strPICOMMS_TEMPLATE *pTemplate, const PICOMMS_TEMPLATE_PARAM_T *pParams, Luint16 u16NumParams);
+		Luint32 u32PICOMMS_ENC__Get_TemplateFaults(void);
+
+
+		//tx queue
+		void vPICOMMS_TXQ__Init(void);
+		Luint8 * pu8PICOMMS_TXQ__Acquire(void);
+		void vPICOMMS_TXQ__Push(Luint16 u16Start, Luint16 u16Length);
+		Luint8 u8PICOMMS_TXQ__Is_Full(void);
+		Luint8 * pu8PICOMMS_TXQ__Start_Next(Luint16 *pu16Length);
+		void vPICOMMS_TXQ__Tx_Complete(void);
+		Luint8 u8PICOMMS_TXQ__Is_OnWire(void);
+		void vPICOMMS_TXQ__10MS_ISR(void);
+		Luint8 u8PICOMMS_TXQ__Get_HighWater(void);
+		Luint32 u32PICOMMS_TXQ__Get_Dropped(void);
+		Luint32 u32PICOMMS_TXQ__Get_IdleGaps(void);
+		Luint32 u32PICOMMS_TXQ__Get_MaxIdleTicks(void);
 
 		//Rx system
 		void vPICOMMS_RX__Init();
 		void vPICOMMS_RX__Receive_Bytes(Luint8* data, Luint16 length);
+		Luint32 u32PICOMMS_RX__Get_Frames(void);
+		Luint32 u32PICOMMS_RX__Get_Resyncs(void);
+		Luint32 u32PICOMMS_RX__Get_ChecksumFaults(void);
+		Luint32 u32PICOMMS_RX__Get_DroppedBytes(void);
+		Luint32 u32PICOMMS_RX__Get_RejectedFrames(void);
+		Luint32 u32PICOMMS_RX__Get_TableFaults(void);
+		void vPICOMMS_RX__Register_Table(const PICOMMS_RX_PARAM_T *pTable, Luint16 u16Size, void (*pCommitCB)(void));
+		Luint8 u8PICOMMS_RX__Was_Updated(Luint16 u16Slot);
 
 
 		//win32 support
@@ -160,6 +559,12 @@
 			DLL_DECLARATION void vPICOMMS_WIN32__Test1(void);
 		#endif
 
+		#if C_LOCALDEF__LCCM656__ENABLE_TEST_SPEC == 1U
+			DLL_DECLARATION void vLCCM656R0_TS_000(void);
+			DLL_DECLARATION void vLCCM656R0_TS_001(void);
+			DLL_DECLARATION void vLCCM656R0_TS_002(void);
+		#endif
+
 	#endif //#if C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE == 1U
 	//safetys
 	#ifndef C_LOCALDEF__LCCM656__ENABLE_THIS_MODULE
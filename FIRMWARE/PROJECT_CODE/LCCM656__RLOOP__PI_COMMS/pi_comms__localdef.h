@@ -21,6 +21,17 @@ RLOOP - PI COMMUNICATIONS MODULE
 		/** enable the receiver side? */
 		#define C_LOCALDEF__LCCM656__ENABLE_RX								(0U)
 
+		/** Transmit queue depth, one frame on the wire, one being built and
+		 * the rest waiting. 2 to 8 */
+		#define C_LOCALDEF__LCCM656__TX_QUEUE_DEPTH						(3U)
+
+		/** Queue overrun, 1 = drop the oldest waiting frame, 0 = drop the new frame */
+		#define C_LOCALDEF__LCCM656__TX_DROP_OLDEST						(1U)
+
+		/** Largest frame the node builds with every payload byte escaped, the
+		 * size of each queue buffer, a multiple of 4 */
+		#define C_LOCALDEF__LCCM656__TX_FRAME_SIZE						(512U)
+
 		/** Testing Options */
 		#define C_LOCALDEF__LCCM656__ENABLE_TEST_SPEC						(0U)
 		
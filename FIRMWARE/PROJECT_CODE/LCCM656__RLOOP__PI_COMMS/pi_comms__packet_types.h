@@ -104,6 +104,29 @@
 		PI_PACKET__PWRNODE__CHG_RELAY_CONTROL = 0xA300U,
 
 
+		/** Cell balancing, 0 = stop, 1 = start
+		 * U8 */
+		PI_PACKET__PWRNODE__BMS_BALANCE_CONTROL = 0xA400U,
+
+		/** Pack voltage, sum of the cells
+		 * F32, Volts */
+		PI_PACKET__PWRNODE__BMS_PACK_VOLTS = 0xA401U,
+
+		/** Lowest, highest and mean cell
+		 * F32, Volts */
+		PI_PACKET__PWRNODE__BMS_CELL_MIN = 0xA402U,
+		PI_PACKET__PWRNODE__BMS_CELL_MAX = 0xA403U,
+		PI_PACKET__PWRNODE__BMS_CELL_MEAN = 0xA404U,
+
+		/** Highest - lowest cell
+		 * F32, Volts */
+		PI_PACKET__PWRNODE__BMS_CELL_SPREAD = 0xA405U,
+
+		/** Discharge resistors on
+		 * U16 */
+		PI_PACKET__PWRNODE__BMS_BLEEDING = 0xA406U,
+
+
 
 	}E_PICOMMS__PACKET_TYPES_T;
 
@@ -0,0 +1,468 @@
+/**
+ * @file		DAQ_RING__APPEND.C
+ * @brief		Append samples to the channel rings, safe to call from an ISR
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM667R0.FILE.001
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup DAQ_RING
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup DAQ_RING__APPEND
+ * @ingroup DAQ_RING
+ * @{ */
+
+#include "../daq_ring.h"
+#if C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE == 1U
+
+extern struct _strDAQRING sDAQRING;
+
+/** Reserve results */
+#define C_DAQRING_APPEND__STOPPED					(0U)
+#define C_DAQRING_APPEND__OK						(1U)
+#define C_DAQRING_APPEND__FULL						(2U)
+
+//locals
+static Luint8 u8DAQRING_APPEND__Reserve(Luint16 u16Index, Luint16 *pu16Pos);
+static void vDAQRING_APPEND__Commit(Luint16 u16Index, Luint16 u16Pos);
+
+/***************************************************************************//**
+ * @brief
+ * Setup the rings, each channel has MAX_DAQ_BUFFER_BLOCKS * 4 bytes of data
+ * and the watermark is scaled to the same number of bytes.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.001.FUNC.001
+ */
+void vDAQRING_APPEND__Init(void)
+{
+	Luint16 u16Counter;
+
+	for(u16Counter = 0U; u16Counter < M_DAQRING__NUM_CHANNELS; u16Counter++)
+	{
+		if(u16Counter < M_DAQRING__S16_OFFSET)
+		{
+			sDAQRING.u8SizeMultiplier[u16Counter] = 4U;
+		}
+		else if(u16Counter < M_DAQRING__S32_OFFSET)
+		{
+			sDAQRING.u8SizeMultiplier[u16Counter] = 2U;
+		}
+		else
+		{
+			sDAQRING.u8SizeMultiplier[u16Counter] = 1U;
+		}
+
+		sDAQRING.sRing[u16Counter].u16Head = 0U;
+		sDAQRING.sRing[u16Counter].u16Tail = 0U;
+		sDAQRING.sRing[u16Counter].u16Size = (Luint16)(C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS * sDAQRING.u8SizeMultiplier[u16Counter]);
+		sDAQRING.sRing[u16Counter].u16Mask = sDAQRING.sRing[u16Counter].u16Size - 1U;
+		sDAQRING.u16WatermarkLevel[u16Counter] = (Luint16)(C_LOCALDEF__LCCM667__BUFFER_WATERMARK_LEVEL * sDAQRING.u8SizeMultiplier[u16Counter]);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Main loop side of the append layer. While streaming is off any part filled
+ * data is dropped so the next run starts clean.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.001.FUNC.002
+ */
+void vDAQRING_APPEND__Process(void)
+{
+	Luint16 u16Counter;
+
+	if(sDAQRING.u8StreamingOn == 0U)
+	{
+		for(u16Counter = 0U; u16Counter < M_DAQRING__NUM_CHANNELS; u16Counter++)
+		{
+			//can't pull the rug from a held block
+			if(sDAQRING.u8BlockHeld[u16Counter] == 0U)
+			{
+				//consumer owns the tail, producers have stopped
+				sDAQRING.sRing[u16Counter].u16Tail = sDAQRING.sRing[u16Counter].u16Head;
+			}
+			else
+			{
+				//wait for release
+			}
+		}
+	}
+	else
+	{
+		//streaming
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Reserve the next ring position for a channel. Only reads the tail so it
+ * can run in an ISR against vDAQRING__Process() in the main loop.
+ *
+ * @param[out]		pu16Pos					Masked ring position to write
+ * @param[in]		u16Index				DAQ channel index
+ * @return			C_DAQRING_APPEND__OK, C_DAQRING_APPEND__FULL or C_DAQRING_APPEND__STOPPED
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.001.FUNC.003
+ */
+static Luint8 u8DAQRING_APPEND__Reserve(Luint16 u16Index, Luint16 *pu16Pos)
+{
+	Luint8 u8Return;
+	Luint16 u16Head;
+
+	if(sDAQRING.u8StreamingOn == 1U)
+	{
+		u16Head = sDAQRING.sRing[u16Index].u16Head;
+		if((Luint16)(u16Head - sDAQRING.sRing[u16Index].u16Tail) < sDAQRING.sRing[u16Index].u16Size)
+		{
+			*pu16Pos = u16Head & sDAQRING.sRing[u16Index].u16Mask;
+			u8Return = C_DAQRING_APPEND__OK;
+		}
+		else
+		{
+			//consumer has fallen behind, lose the new sample
+			sDAQRING.sStats.u32Overflow[u16Index]++;
+			u8Return = C_DAQRING_APPEND__FULL;
+		}
+	}
+	else
+	{
+		u8Return = C_DAQRING_APPEND__STOPPED;
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Stamp and publish a sample. The data has already been written through a
+ * volatile access so the head can't be seen to move before the data lands.
+ *
+ * @param[in]		u16Pos					Masked ring position written
+ * @param[in]		u16Index				DAQ channel index
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.001.FUNC.004
+ */
+static void vDAQRING_APPEND__Commit(Luint16 u16Index, Luint16 u16Pos)
+{
+	#if C_LOCALDEF__LCCM667__ENABLE_TIMER_IN_DATA == 1U
+		((volatile Luint32 *)sDAQRING.sBuffers.u32Timer[u16Index])[u16Pos] = u32DAQRING__Get_SystemTimer();
+	#endif
+
+	//publish, the producer is the only writer of the head
+	sDAQRING.sRing[u16Index].u16Head = (Luint16)(sDAQRING.sRing[u16Index].u16Head + 1U);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Append a U8 sample
+ *
+ * @param[in]		u8Value					Sample
+ * @param[in]		u16Index				DAQ channel index
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.001.FUNC.005
+ */
+void vDAQRING_APPEND__U8(Luint16 u16Index, Luint8 u8Value)
+{
+	#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U8 > 0U
+		Luint16 u16Pos;
+		Luint8 u8Test;
+
+		if(u16Index < M_DAQRING__S16_OFFSET)
+		{
+			u8Test = u8DAQRING_APPEND__Reserve(u16Index, &u16Pos);
+			if(u8Test == C_DAQRING_APPEND__OK)
+			{
+				((volatile Luint8 *)sDAQRING.sBuffers.u8Buffer[u16Index - M_DAQRING__U8_OFFSET])[u16Pos] = u8Value;
+				vDAQRING_APPEND__Commit(u16Index, u16Pos);
+			}
+			else if(u8Test == C_DAQRING_APPEND__FULL)
+			{
+				sDAQRING.sStats.u32FIFO_U8FullCount++;
+			}
+			else
+			{
+				//not streaming
+			}
+		}
+		else
+		{
+			//wrong type for this index
+		}
+	#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ * Append a S16 sample
+ *
+ * @param[in]		s16Value				Sample
+ * @param[in]		u16Index				DAQ channel index
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.001.FUNC.006
+ */
+void vDAQRING_APPEND__S16(Luint16 u16Index, Lint16 s16Value)
+{
+	#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S16 > 0U
+		Luint16 u16Pos;
+		Luint8 u8Test;
+
+		if((u16Index >= M_DAQRING__S16_OFFSET) && (u16Index < M_DAQRING__U16_OFFSET))
+		{
+			u8Test = u8DAQRING_APPEND__Reserve(u16Index, &u16Pos);
+			if(u8Test == C_DAQRING_APPEND__OK)
+			{
+				((volatile Lint16 *)sDAQRING.sBuffers.s16Buffer[u16Index - M_DAQRING__S16_OFFSET])[u16Pos] = s16Value;
+				vDAQRING_APPEND__Commit(u16Index, u16Pos);
+			}
+			else if(u8Test == C_DAQRING_APPEND__FULL)
+			{
+				sDAQRING.sStats.u32FIFO_S16FullCount++;
+			}
+			else
+			{
+				//not streaming
+			}
+		}
+		else
+		{
+			//wrong type for this index
+		}
+	#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ * Append a U16 sample
+ *
+ * @param[in]		u16Value				Sample
+ * @param[in]		u16Index				DAQ channel index
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.001.FUNC.007
+ */
+void vDAQRING_APPEND__U16(Luint16 u16Index, Luint16 u16Value)
+{
+	#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U16 > 0U
+		Luint16 u16Pos;
+		Luint8 u8Test;
+
+		if((u16Index >= M_DAQRING__U16_OFFSET) && (u16Index < M_DAQRING__S32_OFFSET))
+		{
+			u8Test = u8DAQRING_APPEND__Reserve(u16Index, &u16Pos);
+			if(u8Test == C_DAQRING_APPEND__OK)
+			{
+				((volatile Luint16 *)sDAQRING.sBuffers.u16Buffer[u16Index - M_DAQRING__U16_OFFSET])[u16Pos] = u16Value;
+				vDAQRING_APPEND__Commit(u16Index, u16Pos);
+			}
+			else if(u8Test == C_DAQRING_APPEND__FULL)
+			{
+				sDAQRING.sStats.u32FIFO_U16FullCount++;
+			}
+			else
+			{
+				//not streaming
+			}
+		}
+		else
+		{
+			//wrong type for this index
+		}
+	#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ * Append a S32 sample
+ *
+ * @param[in]		s32Value				Sample
+ * @param[in]		u16Index				DAQ channel index
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.001.FUNC.008
+ */
+void vDAQRING_APPEND__S32(Luint16 u16Index, Lint32 s32Value)
+{
+	#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S32 > 0U
+		Luint16 u16Pos;
+		Luint8 u8Test;
+
+		if((u16Index >= M_DAQRING__S32_OFFSET) && (u16Index < M_DAQRING__U32_OFFSET))
+		{
+			u8Test = u8DAQRING_APPEND__Reserve(u16Index, &u16Pos);
+			if(u8Test == C_DAQRING_APPEND__OK)
+			{
+				((volatile Lint32 *)sDAQRING.sBuffers.s32Buffer[u16Index - M_DAQRING__S32_OFFSET])[u16Pos] = s32Value;
+				vDAQRING_APPEND__Commit(u16Index, u16Pos);
+			}
+			else if(u8Test == C_DAQRING_APPEND__FULL)
+			{
+				sDAQRING.sStats.u32FIFO_S32FullCount++;
+			}
+			else
+			{
+				//not streaming
+			}
+		}
+		else
+		{
+			//wrong type for this index
+		}
+	#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ * Append a U32 sample
+ *
+ * @param[in]		u32Value				Sample
+ * @param[in]		u16Index				DAQ channel index
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.001.FUNC.009
+ */
+void vDAQRING_APPEND__U32(Luint16 u16Index, Luint32 u32Value)
+{
+	#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U32 > 0U
+		Luint16 u16Pos;
+		Luint8 u8Test;
+
+		if((u16Index >= M_DAQRING__U32_OFFSET) && (u16Index < M_DAQRING__F32_OFFSET))
+		{
+			u8Test = u8DAQRING_APPEND__Reserve(u16Index, &u16Pos);
+			if(u8Test == C_DAQRING_APPEND__OK)
+			{
+				((volatile Luint32 *)sDAQRING.sBuffers.u32Buffer[u16Index - M_DAQRING__U32_OFFSET])[u16Pos] = u32Value;
+				vDAQRING_APPEND__Commit(u16Index, u16Pos);
+			}
+			else if(u8Test == C_DAQRING_APPEND__FULL)
+			{
+				sDAQRING.sStats.u32FIFO_U32FullCount++;
+			}
+			else
+			{
+				//not streaming
+			}
+		}
+		else
+		{
+			//wrong type for this index
+		}
+	#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ * Append a F32 sample
+ *
+ * @param[in]		f32Value				Sample
+ * @param[in]		u16Index				DAQ channel index
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.001.FUNC.010
+ */
+void vDAQRING_APPEND__F32(Luint16 u16Index, Lfloat32 f32Value)
+{
+	#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__F32 > 0U
+		Luint16 u16Pos;
+		Luint8 u8Test;
+
+		if((u16Index >= M_DAQRING__F32_OFFSET) && (u16Index < M_DAQRING__NUM_CHANNELS))
+		{
+			u8Test = u8DAQRING_APPEND__Reserve(u16Index, &u16Pos);
+			if(u8Test == C_DAQRING_APPEND__OK)
+			{
+				((volatile Lfloat32 *)sDAQRING.sBuffers.f32Buffer[u16Index - M_DAQRING__F32_OFFSET])[u16Pos] = f32Value;
+				vDAQRING_APPEND__Commit(u16Index, u16Pos);
+			}
+			else if(u8Test == C_DAQRING_APPEND__FULL)
+			{
+				sDAQRING.sStats.u32FIFO_F32FullCount++;
+			}
+			else
+			{
+				//not streaming
+			}
+		}
+		else
+		{
+			//wrong type for this index
+		}
+	#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the start of a channels ring as a byte pointer
+ *
+ * @param[out]		pu8Buffer				Start of the ring
+ * @param[in]		u16Index				DAQ channel index
+ * @return			Bytes per sample, or -1 for a bad index
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.001.FUNC.011
+ */
+Lint16 s16DAQRING_APPEND__Index_to_BufferPointer(Luint16 u16Index, Luint8 **pu8Buffer)
+{
+	Lint16 s16Return;
+
+	s16Return = -1;
+	*pu8Buffer = 0;
+
+	#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U8 > 0U
+		if(u16Index < M_DAQRING__S16_OFFSET)
+		{
+			*pu8Buffer = &sDAQRING.sBuffers.u8Buffer[u16Index - M_DAQRING__U8_OFFSET][0];
+			s16Return = 1;
+		}
+	#endif
+	#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S16 > 0U
+		if((u16Index >= M_DAQRING__S16_OFFSET) && (u16Index < M_DAQRING__U16_OFFSET))
+		{
+			*pu8Buffer = (Luint8 *)&sDAQRING.sBuffers.s16Buffer[u16Index - M_DAQRING__S16_OFFSET][0];
+			s16Return = 2;
+		}
+	#endif
+	#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U16 > 0U
+		if((u16Index >= M_DAQRING__U16_OFFSET) && (u16Index < M_DAQRING__S32_OFFSET))
+		{
+			*pu8Buffer = (Luint8 *)&sDAQRING.sBuffers.u16Buffer[u16Index - M_DAQRING__U16_OFFSET][0];
+			s16Return = 2;
+		}
+	#endif
+	#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S32 > 0U
+		if((u16Index >= M_DAQRING__S32_OFFSET) && (u16Index < M_DAQRING__U32_OFFSET))
+		{
+			*pu8Buffer = (Luint8 *)&sDAQRING.sBuffers.s32Buffer[u16Index - M_DAQRING__S32_OFFSET][0];
+			s16Return = 4;
+		}
+	#endif
+	#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U32 > 0U
+		if((u16Index >= M_DAQRING__U32_OFFSET) && (u16Index < M_DAQRING__F32_OFFSET))
+		{
+			*pu8Buffer = (Luint8 *)&sDAQRING.sBuffers.u32Buffer[u16Index - M_DAQRING__U32_OFFSET][0];
+			s16Return = 4;
+		}
+	#endif
+	#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__F32 > 0U
+		if((u16Index >= M_DAQRING__F32_OFFSET) && (u16Index < M_DAQRING__NUM_CHANNELS))
+		{
+			*pu8Buffer = (Luint8 *)&sDAQRING.sBuffers.f32Buffer[u16Index - M_DAQRING__F32_OFFSET][0];
+			s16Return = 4;
+		}
+	#endif
+
+	return s16Return;
+}
+
+
+#endif //#if C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
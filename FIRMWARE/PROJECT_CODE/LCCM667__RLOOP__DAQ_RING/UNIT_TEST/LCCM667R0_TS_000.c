@@ -0,0 +1,399 @@
+/**
+ * @file		LCCM667R0_TS_000.C
+ * @brief		Test spec for the DAQ channel rings and block streaming
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM667R0.FILE.004
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM667__ENABLE_TEST_SPEC == 1U
+
+//host side only
+#include <stdio.h>
+
+/** Samples appended per channel in each case */
+#define C_TS000__SAMPLES						(20000U)
+
+/** Test channels, first S16 and first F32 */
+#define C_TS000__CH_S16							(M_DAQRING__S16_OFFSET)
+#define C_TS000__CH_F32							(M_DAQRING__F32_OFFSET)
+
+/** What the handler does with each block */
+typedef enum
+{
+	TS000_MODE__DONE = 0U,
+	TS000_MODE__HOLD,
+	TS000_MODE__BUSY_ONCE
+
+}E_TS000__MODE_T;
+
+void vLCCM667R0_TS_000_TCASE_001(void);
+void vLCCM667R0_TS_000_TCASE_002(void);
+void vLCCM667R0_TS_000_TCASE_003(void);
+static void vTS000__Reset(E_TS000__MODE_T eMode);
+static void vTS000__Run(Luint16 u16SamplesPerProcess, Luint8 u8ReleaseEvery);
+static void vTS000__Release_All(void);
+
+extern struct _strDAQRING sDAQRING;
+
+static E_TS000__MODE_T eTS000_Mode;
+static Luint8 u8TS000_Busy;
+
+//what we expect next on each test channel, and what went wrong
+static Lint16 s16TS000_NextS16;
+static Lfloat32 f32TS000_NextF32;
+static Luint32 u32TS000_RxS16;
+static Luint32 u32TS000_RxF32;
+static Luint32 u32TS000_Gaps;
+static Luint32 u32TS000_Errors;
+static Luint32 u32TS000_TimerErrors;
+static Luint32 u32TS000_LastTimer;
+static Luint8 u8TS000_Held[M_DAQRING__NUM_CHANNELS];
+
+//Function to call the tests for this test specification
+void vLCCM667R0_TS_000(void)
+{
+	//Call the test cases
+	vLCCM667R0_TS_000_TCASE_001();
+	vLCCM667R0_TS_000_TCASE_002();
+	vLCCM667R0_TS_000_TCASE_003();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM667R0.TS.000.TCASE.001
+ * @st_test_desc
+ * Samples arrive faster than the streaming process runs. Every block must be
+ * a whole watermark, in place in the ring, in order with no gaps, and with
+ * per sample timestamps in order when enabled.
+ *
+*/
+void vLCCM667R0_TS_000_TCASE_001(void)
+{
+	char cText[160];
+	Luint32 u32Left;
+
+	DEBUG_PRINT("START:LCCM667R0.TS.000.TCASE.001\r\n");
+
+	vTS000__Reset(TS000_MODE__DONE);
+	vTS000__Run(10U, 0U);
+
+	//anything short of a block stays in the ring
+	u32Left = C_TS000__SAMPLES - u32TS000_RxS16;
+
+	sprintf(cText, "INFO: S16 %u F32 %u of %u, gaps %u, errors %u, timer errors %u\r\n", u32TS000_RxS16, u32TS000_RxF32, C_TS000__SAMPLES,
+			u32TS000_Gaps, u32TS000_Errors, u32TS000_TimerErrors);
+	DEBUG_PRINT(cText);
+
+	if((u32TS000_Errors == 0U) && (u32TS000_Gaps == 0U) && (u32TS000_TimerErrors == 0U) &&
+		(u32Left < sDAQRING.u16WatermarkLevel[C_TS000__CH_S16]) &&
+		(u32Left == u16DAQRING__Get_FIFO_Level(C_TS000__CH_S16)) &&
+		(u32DAQRING__Get_Overflows(C_TS000__CH_S16) == 0U))
+	{
+		DEBUG_PRINT("PASS:LCCM667R0.TS.000.TCASE.001\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM667R0.TS.000.TCASE.001\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM667R0.TS.000.TCASE.001\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM667R0.TS.000.TCASE.002
+ * @st_test_desc
+ * The transmit layer holds blocks and releases them slowly so the rings
+ * overflow. New samples must be dropped and counted, never the held block,
+ * and everything appended must be accounted for.
+ *
+*/
+void vLCCM667R0_TS_000_TCASE_002(void)
+{
+	char cText[160];
+	Luint32 u32Total;
+
+	DEBUG_PRINT("START:LCCM667R0.TS.000.TCASE.002\r\n");
+
+	vTS000__Reset(TS000_MODE__HOLD);
+	vTS000__Run(40U, 8U);
+
+	//held blocks are still in the level count
+	u32Total = u32TS000_RxS16 + u32DAQRING__Get_Overflows(C_TS000__CH_S16) + (Luint32)u16DAQRING__Get_FIFO_Level(C_TS000__CH_S16);
+	u32Total -= (Luint32)sDAQRING.u8BlockHeld[C_TS000__CH_S16] * (Luint32)sDAQRING.u16WatermarkLevel[C_TS000__CH_S16];
+
+	sprintf(cText, "INFO: received %u, lost %u, accounted %u of %u, errors %u\r\n", u32TS000_RxS16, u32DAQRING__Get_Overflows(C_TS000__CH_S16),
+			u32Total, C_TS000__SAMPLES, u32TS000_Errors);
+	DEBUG_PRINT(cText);
+
+	if((u32TS000_Errors == 0U) &&
+		(u32DAQRING__Get_Overflows(C_TS000__CH_S16) > 0U) &&
+		(sDAQRING.sStats.u32FIFO_S16FullCount == u32DAQRING__Get_Overflows(C_TS000__CH_S16)) &&
+		(u32Total == C_TS000__SAMPLES))
+	{
+		DEBUG_PRINT("PASS:LCCM667R0.TS.000.TCASE.002\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM667R0.TS.000.TCASE.002\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM667R0.TS.000.TCASE.002\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM667R0.TS.000.TCASE.003
+ * @st_test_desc
+ * The transmit layer is busy the first time each block is offered. The block
+ * must be offered again and nothing lost, and nothing may be appended once
+ * streaming is off.
+ *
+*/
+void vLCCM667R0_TS_000_TCASE_003(void)
+{
+	char cText[160];
+	Luint16 u16Level;
+
+	DEBUG_PRINT("START:LCCM667R0.TS.000.TCASE.003\r\n");
+
+	vTS000__Reset(TS000_MODE__BUSY_ONCE);
+	vTS000__Run(4U, 0U);
+
+	//stop, the part block is dropped and new samples ignored
+	vDAQRING__Streaming_Off();
+	vDAQRING__Process();
+	vDAQRING_APPEND__S16(C_TS000__CH_S16, 1);
+	u16Level = u16DAQRING__Get_FIFO_Level(C_TS000__CH_S16);
+
+	sprintf(cText, "INFO: received %u, retries %u, gaps %u, level after stop %u\r\n", u32TS000_RxS16, sDAQRING.sStats.u32TxRetry, u32TS000_Gaps, u16Level);
+	DEBUG_PRINT(cText);
+
+	if((u32TS000_Errors == 0U) && (u32TS000_Gaps == 0U) &&
+		(sDAQRING.sStats.u32TxRetry > 0U) &&
+		((C_TS000__SAMPLES - u32TS000_RxS16) < sDAQRING.u16WatermarkLevel[C_TS000__CH_S16]) &&
+		(u16Level == 0U))
+	{
+		DEBUG_PRINT("PASS:LCCM667R0.TS.000.TCASE.003\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM667R0.TS.000.TCASE.003\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM667R0.TS.000.TCASE.003\r\n");
+}
+
+//fresh DAQ and checker
+static void vTS000__Reset(E_TS000__MODE_T eMode)
+{
+	Luint16 u16Counter;
+
+	vDAQRING__Init();
+	vDAQRING__Streaming_On();
+
+	eTS000_Mode = eMode;
+	u8TS000_Busy = 0U;
+	s16TS000_NextS16 = 0;
+	f32TS000_NextF32 = 0.0F;
+	u32TS000_RxS16 = 0U;
+	u32TS000_RxF32 = 0U;
+	u32TS000_Gaps = 0U;
+	u32TS000_Errors = 0U;
+	u32TS000_TimerErrors = 0U;
+	u32TS000_LastTimer = 0U;
+	for(u16Counter = 0U; u16Counter < M_DAQRING__NUM_CHANNELS; u16Counter++)
+	{
+		u8TS000_Held[u16Counter] = 0U;
+	}
+}
+
+//append ramps as a sensor ISR would, running the stream process in between
+static void vTS000__Run(Luint16 u16SamplesPerProcess, Luint8 u8ReleaseEvery)
+{
+	Luint32 u32Sample;
+	Luint32 u32Loop;
+
+	u32Loop = 0U;
+	for(u32Sample = 0U; u32Sample < C_TS000__SAMPLES; u32Sample++)
+	{
+		vDAQRING_APPEND__S16(C_TS000__CH_S16, (Lint16)u32Sample);
+		vDAQRING_APPEND__F32(C_TS000__CH_F32, (Lfloat32)u32Sample);
+
+		if((u32Sample % u16SamplesPerProcess) == 0U)
+		{
+			vDAQRING__Process();
+			u32Loop++;
+
+			//transmit layer gives held blocks back when its done
+			if((u8ReleaseEvery > 0U) && ((u32Loop % u8ReleaseEvery) == 0U))
+			{
+				vTS000__Release_All();
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		else
+		{
+			//sensor rate is above the loop rate
+		}
+	}
+
+	//drain whole blocks
+	for(u32Loop = 0U; u32Loop < 64U; u32Loop++)
+	{
+		vDAQRING__Process();
+		vTS000__Release_All();
+	}
+}
+
+//hand back anything the transmit layer is holding
+static void vTS000__Release_All(void)
+{
+	Luint16 u16Counter;
+
+	for(u16Counter = 0U; u16Counter < M_DAQRING__NUM_CHANNELS; u16Counter++)
+	{
+		//oldest first
+		while(u8TS000_Held[u16Counter] > 0U)
+		{
+			vDAQRING__Release_Block(u16Counter);
+			u8TS000_Held[u16Counter]--;
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Transmit handler for the test spec, set M_LOCALDEF__LCCM667__TX_HANDLER to
+ * this when ENABLE_TEST_SPEC is on.
+ *
+ */
+Lint16 s16LCCM667R0_TS_000__TxHandler(Luint16 u16Index, Luint8 *pu8Buffer, Luint16 u16Length)
+{
+	Lint16 s16Return;
+	Luint16 u16Counter;
+	Luint16 u16Samples;
+	Luint8 *pu8Ring;
+	const Lint16 *ps16Data;
+	const Lfloat32 *pf32Data;
+	Lint16 s16Size;
+	#if C_LOCALDEF__LCCM667__ENABLE_TIMER_IN_DATA == 1U
+		const Luint32 *pu32Timers;
+	#endif
+
+	s16Return = C_DAQRING__TX_DONE;
+
+	//must be a whole block inside the ring
+	s16Size = s16DAQRING_APPEND__Index_to_BufferPointer(u16Index, &pu8Ring);
+	u16Samples = u16Length / (Luint16)s16Size;
+	if((u16Samples != sDAQRING.u16WatermarkLevel[u16Index]) ||
+		(pu8Buffer < pu8Ring) ||
+		((pu8Buffer + u16Length) > (pu8Ring + (C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS * 4U))))
+	{
+		u32TS000_Errors++;
+	}
+	else if((eTS000_Mode == TS000_MODE__BUSY_ONCE) && (u8TS000_Busy == 0U))
+	{
+		//say no the first time
+		u8TS000_Busy = 1U;
+		s16Return = -1;
+	}
+	else
+	{
+		u8TS000_Busy = 0U;
+
+		if(u16Index == C_TS000__CH_S16)
+		{
+			ps16Data = (const Lint16 *)pu8Buffer;
+			for(u16Counter = 0U; u16Counter < u16Samples; u16Counter++)
+			{
+				if(ps16Data[u16Counter] < s16TS000_NextS16)
+				{
+					//going backwards is corruption
+					u32TS000_Errors++;
+				}
+				else if(ps16Data[u16Counter] > s16TS000_NextS16)
+				{
+					//lost samples
+					u32TS000_Gaps++;
+				}
+				else
+				{
+					//spot on
+				}
+				s16TS000_NextS16 = ps16Data[u16Counter] + 1;
+			}
+			u32TS000_RxS16 += u16Samples;
+
+			#if C_LOCALDEF__LCCM667__ENABLE_TIMER_IN_DATA == 1U
+				pu32Timers = pu32DAQRING__Get_Block_Timers(u16Index);
+				for(u16Counter = 0U; u16Counter < u16Samples; u16Counter++)
+				{
+					if(pu32Timers[u16Counter] < u32TS000_LastTimer)
+					{
+						u32TS000_TimerErrors++;
+					}
+					else
+					{
+						//in order
+					}
+					u32TS000_LastTimer = pu32Timers[u16Counter];
+				}
+			#endif
+		}
+		else if(u16Index == C_TS000__CH_F32)
+		{
+			pf32Data = (const Lfloat32 *)pu8Buffer;
+			for(u16Counter = 0U; u16Counter < u16Samples; u16Counter++)
+			{
+				if(pf32Data[u16Counter] < f32TS000_NextF32)
+				{
+					u32TS000_Errors++;
+				}
+				else
+				{
+					//in order
+				}
+				f32TS000_NextF32 = pf32Data[u16Counter] + 1.0F;
+			}
+			u32TS000_RxF32 += u16Samples;
+		}
+		else
+		{
+			//nothing else is fed
+			u32TS000_Errors++;
+		}
+
+		if(eTS000_Mode == TS000_MODE__HOLD)
+		{
+			//give it back later, like a DMA would
+			u8TS000_Held[u16Index]++;
+			s16Return = C_DAQRING__TX_HELD;
+		}
+		else
+		{
+			//done with it
+		}
+	}
+
+	return s16Return;
+}
+
+#endif //C_LOCALDEF__LCCM667__ENABLE_TEST_SPEC
+#endif //#if C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE
+	#error
+#endif
+
@@ -0,0 +1,68 @@
+/**
+ * @file		DAQ_RING__WIN32.C
+ * @brief		WIN32 Emulation Layer
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM667R0.FILE.003
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup DAQ_RING
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup DAQ_RING__WIN32
+ * @ingroup DAQ_RING
+ * @{ */
+
+#include "../daq_ring.h"
+#if C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE == 1U
+#ifdef WIN32
+
+extern struct _strDAQRING sDAQRING;
+
+/***************************************************************************//**
+ * @brief
+ * Transmit handler for the simulations, copies the last block from each of the
+ * first 10 channels out so the GUI can pick it up.
+ *
+ * @param[in]		u16Length				Block length in bytes
+ * @param[in]		*pu8Buffer				Start of the block
+ * @param[in]		u16Index				DAQ channel index
+ * @return			C_DAQRING__TX_DONE
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.003.FUNC.001
+ */
+Lint16 s16DAQRING_WIN32__TxHandler(Luint16 u16Index, Luint8 *pu8Buffer, Luint16 u16Length)
+{
+	Luint16 u16Counter;
+
+	if((u16Index < 10U) && (u16Length <= 1500U))
+	{
+		for(u16Counter = 0U; u16Counter < u16Length; u16Counter++)
+		{
+			sDAQRING.sWIN32.u8LastArray[u16Index][u16Counter] = pu8Buffer[u16Counter];
+		}
+		sDAQRING.sWIN32.u16LastPacketType[u16Index] = C_DAQRING__PACKET_TYPE_START + u16Index;
+		sDAQRING.sWIN32.u8NewPacket[u16Index] = 1U;
+	}
+	else
+	{
+		//not mirrored
+	}
+
+	return C_DAQRING__TX_DONE;
+}
+
+#endif //WIN32
+#endif //#if C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
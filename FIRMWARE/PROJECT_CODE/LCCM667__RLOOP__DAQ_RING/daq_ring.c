@@ -0,0 +1,498 @@
+/**
+ * @file		DAQ_RING.C
+ * @brief		DAQ core, block streaming from the channel rings
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM667R0.FILE.000
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup DAQ_RING
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup DAQ_RING__CORE
+ * @ingroup DAQ_RING
+ * @{ */
+
+#include "daq_ring.h"
+#if C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE == 1U
+
+//main structure
+struct _strDAQRING sDAQRING;
+
+#ifdef WIN32
+//free running timer for the simulations
+static Luint32 u32DAQRING_WIN32_Timer;
+#endif
+
+/***************************************************************************//**
+ * @brief
+ * Init the DAQ module, streaming is off until vDAQRING__Streaming_On()
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.000.FUNC.001
+ */
+void vDAQRING__Init(void)
+{
+	Luint16 u16Counter;
+
+	sDAQRING.eMainState = DAQRING_STATE__IDLE;
+	sDAQRING.u16ProcessPoint = 0U;
+	sDAQRING.u8StreamingOn = 0U;
+
+	sDAQRING.sStats.u32FIFO_U8FullCount = 0U;
+	sDAQRING.sStats.u32FIFO_S16FullCount = 0U;
+	sDAQRING.sStats.u32FIFO_U16FullCount = 0U;
+	sDAQRING.sStats.u32FIFO_S32FullCount = 0U;
+	sDAQRING.sStats.u32FIFO_U32FullCount = 0U;
+	sDAQRING.sStats.u32FIFO_F32FullCount = 0U;
+	sDAQRING.sStats.u32TxRetry = 0U;
+
+	for(u16Counter = 0U; u16Counter < M_DAQRING__NUM_CHANNELS; u16Counter++)
+	{
+		sDAQRING.sStats.u32Overflow[u16Counter] = 0U;
+		sDAQRING.sStats.u32Blocks[u16Counter] = 0U;
+		sDAQRING.u8BlockHeld[u16Counter] = 0U;
+		sDAQRING.u8WatermarkFlag[u16Counter] = 0U;
+
+		#if C_LOCALDEF__LCCM667__ENABLE_USER_PAYLOAD_TYPES == 1U
+			sDAQRING.u16User_PacketType[u16Counter] = 0U;
+		#endif
+	}
+
+	#ifdef WIN32
+		u32DAQRING_WIN32_Timer = 0U;
+		for(u16Counter = 0U; u16Counter < 10U; u16Counter++)
+		{
+			sDAQRING.sWIN32.u8NewPacket[u16Counter] = 0U;
+			sDAQRING.sWIN32.u16LastPacketType[u16Counter] = 0U;
+		}
+	#endif
+
+	//setup the rings and sizes
+	vDAQRING_APPEND__Init();
+
+}
+
+
+/***************************************************************************//**
+ * @brief
+ * Process the DAQ, call from the main loop only. Any channel that has a full
+ * watermark block is handed to the transmit handler in place, one block
+ * per call so the loop time is bounded.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.000.FUNC.002
+ */
+void vDAQRING__Process(void)
+{
+	Luint16 u16Counter;
+	Luint16 u16Index;
+	Luint16 u16Level;
+	Luint16 u16Tail;
+	Luint16 u16Length;
+	Luint8 *pu8Buffer;
+	Lint16 s16Size;
+	Lint16 s16Return;
+	Luint8 u8Found;
+
+	//let the append layer tidy up
+	vDAQRING_APPEND__Process();
+
+	//the states run on into each other in one call, only the send is limited to one block
+	if(sDAQRING.eMainState == DAQRING_STATE__IDLE)
+	{
+		if(sDAQRING.u8StreamingOn == 1U)
+		{
+			sDAQRING.eMainState = DAQRING_STATE__CHECK_FILL;
+		}
+		else
+		{
+			//stay here
+		}
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(sDAQRING.eMainState == DAQRING_STATE__CHECK_FILL)
+	{
+		//flag every channel with a whole block behind the ones already out
+		for(u16Index = 0U; u16Index < M_DAQRING__NUM_CHANNELS; u16Index++)
+		{
+			u16Level = (Luint16)(sDAQRING.sRing[u16Index].u16Head - sDAQRING.sRing[u16Index].u16Tail);
+			u16Level -= (Luint16)sDAQRING.u8BlockHeld[u16Index] * sDAQRING.u16WatermarkLevel[u16Index];
+			if(u16Level >= sDAQRING.u16WatermarkLevel[u16Index])
+			{
+				sDAQRING.u8WatermarkFlag[u16Index] = 1U;
+			}
+			else
+			{
+				sDAQRING.u8WatermarkFlag[u16Index] = 0U;
+			}
+		}
+
+		sDAQRING.eMainState = DAQRING_STATE__PROCESS_FILL;
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(sDAQRING.eMainState == DAQRING_STATE__PROCESS_FILL)
+	{
+		//round robin from where we finished last time so a busy channel can't starve the rest
+		u16Index = sDAQRING.u16ProcessPoint;
+		u8Found = 0U;
+		u16Counter = 0U;
+		while((u8Found == 0U) && (u16Counter < M_DAQRING__NUM_CHANNELS))
+		{
+			//the flag may be stale if streaming stopped and the ring was dropped
+			u16Level = (Luint16)(sDAQRING.sRing[u16Index].u16Head - sDAQRING.sRing[u16Index].u16Tail);
+			u16Level -= (Luint16)sDAQRING.u8BlockHeld[u16Index] * sDAQRING.u16WatermarkLevel[u16Index];
+			if((sDAQRING.u8WatermarkFlag[u16Index] == 1U) && (u16Level >= sDAQRING.u16WatermarkLevel[u16Index]))
+			{
+				u8Found = 1U;
+			}
+			else
+			{
+				sDAQRING.u8WatermarkFlag[u16Index] = 0U;
+				u16Index++;
+				if(u16Index >= M_DAQRING__NUM_CHANNELS)
+				{
+					u16Index = 0U;
+				}
+				else
+				{
+					//fall on
+				}
+				u16Counter++;
+			}
+		}
+
+		if(u8Found == 1U)
+		{
+			//the block starts after any that are held, blocks are aligned so it never wraps
+			s16Size = s16DAQRING_APPEND__Index_to_BufferPointer(u16Index, &pu8Buffer);
+			u16Tail = (Luint16)(sDAQRING.sRing[u16Index].u16Tail + ((Luint16)sDAQRING.u8BlockHeld[u16Index] * sDAQRING.u16WatermarkLevel[u16Index]));
+			u16Tail &= sDAQRING.sRing[u16Index].u16Mask;
+			pu8Buffer += (Luint32)u16Tail * (Luint32)s16Size;
+			u16Length = sDAQRING.u16WatermarkLevel[u16Index] * (Luint16)s16Size;
+
+			//hold it before the handler in case it releases from inside
+			sDAQRING.u8BlockHeld[u16Index]++;
+			s16Return = M_LOCALDEF__LCCM667__TX_HANDLER(u16Index, pu8Buffer, u16Length);
+			if(s16Return == C_DAQRING__TX_DONE)
+			{
+				sDAQRING.sStats.u32Blocks[u16Index]++;
+				vDAQRING__Release_Block(u16Index);
+			}
+			else if(s16Return == C_DAQRING__TX_HELD)
+			{
+				//transmit layer owns it until vDAQRING__Release_Block()
+				sDAQRING.sStats.u32Blocks[u16Index]++;
+			}
+			else
+			{
+				//busy, try again next time round
+				sDAQRING.u8BlockHeld[u16Index]--;
+				sDAQRING.sStats.u32TxRetry++;
+			}
+
+			sDAQRING.u8WatermarkFlag[u16Index] = 0U;
+
+			//next channel gets first go
+			u16Index++;
+			if(u16Index >= M_DAQRING__NUM_CHANNELS)
+			{
+				u16Index = 0U;
+			}
+			else
+			{
+				//fall on
+			}
+			sDAQRING.u16ProcessPoint = u16Index;
+
+			//stay here while there are flagged channels
+		}
+		else
+		{
+			//nothing left, check again next time
+			sDAQRING.eMainState = DAQRING_STATE__IDLE;
+		}
+	}
+	else
+	{
+		//fall on
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Release the oldest held block of a channel back to the producer.
+ * Call once the transmit layer is done with a block it held, blocks must be
+ * released in the order they were handed out.
+ *
+ * @param[in]		u16Index				DAQ channel index
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.000.FUNC.003
+ */
+void vDAQRING__Release_Block(Luint16 u16Index)
+{
+	if(u16Index < M_DAQRING__NUM_CHANNELS)
+	{
+		if(sDAQRING.u8BlockHeld[u16Index] > 0U)
+		{
+			//only the consumer writes the tail
+			sDAQRING.sRing[u16Index].u16Tail = (Luint16)(sDAQRING.sRing[u16Index].u16Tail + sDAQRING.u16WatermarkLevel[u16Index]);
+			sDAQRING.u8BlockHeld[u16Index]--;
+		}
+		else
+		{
+			//nothing out
+		}
+	}
+	else
+	{
+		//error
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the timestamps that go with the block that was last handed to the
+ * transmit handler, or the tail if nothing is held.
+ *
+ * @param[in]		u16Index				DAQ channel index
+ * @return			Pointer to WatermarkLevel timestamps, or 0 if not enabled
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.000.FUNC.004
+ */
+Luint32 * pu32DAQRING__Get_Block_Timers(Luint16 u16Index)
+{
+	Luint32 *pu32Return;
+	#if C_LOCALDEF__LCCM667__ENABLE_TIMER_IN_DATA == 1U
+		Luint16 u16Pos;
+	#endif
+
+	#if C_LOCALDEF__LCCM667__ENABLE_TIMER_IN_DATA == 1U
+		if(u16Index < M_DAQRING__NUM_CHANNELS)
+		{
+			u16Pos = sDAQRING.sRing[u16Index].u16Tail;
+			if(sDAQRING.u8BlockHeld[u16Index] > 0U)
+			{
+				u16Pos += (Luint16)(sDAQRING.u8BlockHeld[u16Index] - 1U) * sDAQRING.u16WatermarkLevel[u16Index];
+			}
+			else
+			{
+				//fall on
+			}
+			pu32Return = &sDAQRING.sBuffers.u32Timer[u16Index][u16Pos & sDAQRING.sRing[u16Index].u16Mask];
+		}
+		else
+		{
+			pu32Return = 0;
+		}
+	#else
+		pu32Return = 0;
+	#endif
+
+	return pu32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Free running timer used to stamp each sample
+ *
+ * @return			Timer count
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.000.FUNC.005
+ */
+Luint32 u32DAQRING__Get_SystemTimer(void)
+{
+	Luint32 u32Return;
+
+	#ifndef WIN32
+		#if C_LOCALDEF__LCCM124__ENABLE_THIS_MODULE == 1U
+			u32Return = (Luint32)u64RM4_RTI__Get_Counter1();
+		#else
+			u32Return = 0U;
+		#endif
+	#else
+		//one count per call is enough to order the samples in a simulation
+		u32DAQRING_WIN32_Timer++;
+		u32Return = u32DAQRING_WIN32_Timer;
+	#endif
+
+	return u32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the current fill level of a channel
+ *
+ * @param[in]		u16Index				DAQ channel index
+ * @return			Number of samples waiting
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.000.FUNC.006
+ */
+Luint16 u16DAQRING__Get_FIFO_Level(Luint16 u16Index)
+{
+	Luint16 u16Return;
+
+	if(u16Index < M_DAQRING__NUM_CHANNELS)
+	{
+		u16Return = (Luint16)(sDAQRING.sRing[u16Index].u16Head - sDAQRING.sRing[u16Index].u16Tail);
+	}
+	else
+	{
+		u16Return = 0U;
+	}
+
+	return u16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the size of a channels ring
+ *
+ * @param[in]		u16Index				DAQ channel index
+ * @return			Ring size in samples
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.000.FUNC.007
+ */
+Luint16 u16DAQRING__Get_FIFO_Max(Luint16 u16Index)
+{
+	Luint16 u16Return;
+
+	if(u16Index < M_DAQRING__NUM_CHANNELS)
+	{
+		u16Return = sDAQRING.sRing[u16Index].u16Size;
+	}
+	else
+	{
+		u16Return = 0U;
+	}
+
+	return u16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the number of samples lost on a channel because its ring was full
+ *
+ * @param[in]		u16Index				DAQ channel index
+ * @return			Lost samples
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.000.FUNC.008
+ */
+Luint32 u32DAQRING__Get_Overflows(Luint16 u16Index)
+{
+	Luint32 u32Return;
+
+	if(u16Index < M_DAQRING__NUM_CHANNELS)
+	{
+		u32Return = sDAQRING.sStats.u32Overflow[u16Index];
+	}
+	else
+	{
+		u32Return = 0U;
+	}
+
+	return u32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Set the packet type a channel is transmitted with
+ *
+ * @param[in]		u16Type					Packet type
+ * @param[in]		u16Index				DAQ channel index
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.000.FUNC.009
+ */
+void vDAQRING__Config_UserPacketType(Luint16 u16Index, Luint16 u16Type)
+{
+	#if C_LOCALDEF__LCCM667__ENABLE_USER_PAYLOAD_TYPES == 1U
+		if(u16Index < M_DAQRING__NUM_CHANNELS)
+		{
+			sDAQRING.u16User_PacketType[u16Index] = u16Type;
+		}
+		else
+		{
+			//error
+		}
+	#else
+		//not used
+	#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the packet type a channel is transmitted with
+ *
+ * @param[in]		u16Index				DAQ channel index
+ * @return			The user type if enabled, else the standard type
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.000.FUNC.012
+ */
+Luint16 u16DAQRING__Get_PacketType(Luint16 u16Index)
+{
+	Luint16 u16Return;
+
+	#if C_LOCALDEF__LCCM667__ENABLE_USER_PAYLOAD_TYPES == 1U
+		if(u16Index < M_DAQRING__NUM_CHANNELS)
+		{
+			u16Return = sDAQRING.u16User_PacketType[u16Index];
+		}
+		else
+		{
+			//error
+			u16Return = 0U;
+		}
+	#else
+		u16Return = C_DAQRING__PACKET_TYPE_START + u16Index;
+	#endif
+
+	return u16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Start accepting samples
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.000.FUNC.010
+ */
+void vDAQRING__Streaming_On(void)
+{
+	sDAQRING.u8StreamingOn = 1U;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Stop accepting samples, anything part filled is thrown away
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM667R0.FILE.000.FUNC.011
+ */
+void vDAQRING__Streaming_Off(void)
+{
+	sDAQRING.u8StreamingOn = 0U;
+}
+
+
+#endif //#if C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
@@ -0,0 +1,258 @@
+/**
+ * @file		DAQ_RING.H
+ * @brief		Main header for the DAQ channel rings
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ */
+
+
+#ifndef _DAQ_RING_H_
+#define _DAQ_RING_H_
+	#include <localdef.h>
+	#if C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE == 1U
+
+		/*******************************************************************************
+		Defines
+		*******************************************************************************/
+
+		#define M_DAQRING__U8_OFFSET		(0U)
+		#define M_DAQRING__S16_OFFSET		(C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U8)
+
+		#define M_DAQRING__U16_OFFSET		(C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U8 + \
+										C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S16)
+
+		#define M_DAQRING__S32_OFFSET		(C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U8 + \
+										C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S16 + \
+										C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U16)
+
+		#define M_DAQRING__U32_OFFSET		(C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U8 + \
+										C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S16 + \
+										C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U16 + \
+										C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S32)
+
+		#define M_DAQRING__F32_OFFSET		(C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U8 + \
+										C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S16 + \
+										C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U16 + \
+										C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S32 + \
+										C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U32)
+		
+		#define M_DAQRING__NUM_CHANNELS 	(C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U8 + \
+										C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S16 + \
+										C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U16 + \
+										C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S32 + \
+										C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U32 + \
+										C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__F32)
+		
+		/** Samples in each channel ring, a ring is always MAX_DAQ_BUFFER_BLOCKS * 4 bytes */
+		#define M_DAQRING__RING_SIZE_U8		(C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS * 4U)
+		#define M_DAQRING__RING_SIZE_16		(C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS * 2U)
+		#define M_DAQRING__RING_SIZE_32		(C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS)
+
+		/** Timestamp ring depth, sized for the deepest data ring in use */
+		#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U8 > 0U
+			#define M_DAQRING__TIMER_DEPTH	(M_DAQRING__RING_SIZE_U8)
+		#elif (C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S16 + C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U16) > 0U
+			#define M_DAQRING__TIMER_DEPTH	(M_DAQRING__RING_SIZE_16)
+		#else
+			#define M_DAQRING__TIMER_DEPTH	(M_DAQRING__RING_SIZE_32)
+		#endif
+
+		/** Standard packet type of channel 0, one type per channel after that */
+		#define C_DAQRING__PACKET_TYPE_START	(0x1210U)
+
+		/** Transmit handler return, the block has been sent and can be reused */
+		#define C_DAQRING__TX_DONE			(0)
+
+		/** Transmit handler return, the transmit layer is still using the block
+		 * and will call vDAQRING__Release_Block() when done */
+		#define C_DAQRING__TX_HELD			(1)
+
+		/** Main DAQ States */
+		typedef enum
+		{
+			/** Do nothing */
+			DAQRING_STATE__IDLE = 0U,
+			
+			/** Check the fill level */
+			DAQRING_STATE__CHECK_FILL,
+			
+			/** Process Fill */
+			DAQRING_STATE__PROCESS_FILL
+		
+		}E_DAQRING__MAIN_STATES;
+
+		/** Single producer / single consumer ring control for one channel.
+		 * Head is only ever written by the appending side (ISR or main loop)
+		 * and tail only by vDAQRING__Process() so no interlock is needed.
+		 * Both are free running and masked on use. */
+		typedef struct
+		{
+			/** Next sample to write, owned by the producer */
+			volatile Luint16 u16Head;
+
+			/** Oldest sample not yet released, owned by the consumer */
+			volatile Luint16 u16Tail;
+
+			/** Ring size in samples, always a power of 2 */
+			Luint16 u16Size;
+
+			/** Size - 1 */
+			Luint16 u16Mask;
+
+		}DAQRING__RING_T;
+		
+		
+		/*******************************************************************************
+		Structures
+		*******************************************************************************/
+		struct _strDAQRING
+		{
+			/** These are the buffers to hold the FIFO data */
+			struct
+			{
+				#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U8 > 0U
+				Luint8 u8Buffer[C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U8][C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS * 4U];
+				#endif
+				#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S16 > 0U
+				Lint16 s16Buffer[C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S16][C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS * 2U];
+				#endif
+				#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U16 > 0U
+				Luint16 u16Buffer[C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U16][C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS * 2U];
+				#endif
+				#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S32 > 0U
+				Lint32 s32Buffer[C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S32][C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS];
+				#endif
+				#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U32 > 0U
+				Luint32 u32Buffer[C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U32][C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS];
+				#endif
+				#if C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__F32 > 0U
+				Lfloat32 f32Buffer[C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__F32][C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS];
+				#endif				
+				
+				#if C_LOCALDEF__LCCM667__ENABLE_TIMER_IN_DATA == 1U
+				/** One timestamp per sample, same ring position as the data */
+				Luint32 u32Timer[M_DAQRING__NUM_CHANNELS][M_DAQRING__TIMER_DEPTH];
+				#endif
+				
+			}sBuffers;
+
+			/** Statistics Module */
+			struct
+			{
+				Luint32 u32FIFO_U8FullCount;
+				Luint32 u32FIFO_S16FullCount;
+				Luint32 u32FIFO_U16FullCount;
+				Luint32 u32FIFO_S32FullCount;
+				Luint32 u32FIFO_U32FullCount;
+				Luint32 u32FIFO_F32FullCount;
+
+				/** Samples lost per channel because the ring was full */
+				Luint32 u32Overflow[M_DAQRING__NUM_CHANNELS];
+
+				/** Blocks handed to the transmit layer per channel */
+				Luint32 u32Blocks[M_DAQRING__NUM_CHANNELS];
+
+				/** Times the transmit layer was busy and we had to retry */
+				Luint32 u32TxRetry;
+
+			}sStats;
+		
+			/** the per channel rings */
+			DAQRING__RING_T sRing[M_DAQRING__NUM_CHANNELS];
+
+			/** Number of blocks out with the transmit layer, oldest first from the tail */
+			Luint8 u8BlockHeld[M_DAQRING__NUM_CHANNELS];
+		
+			#if C_LOCALDEF__LCCM667__ENABLE_USER_PAYLOAD_TYPES == 1U
+				/** user configurable packet type for transmission purposes */
+				Luint16 u16User_PacketType[M_DAQRING__NUM_CHANNELS];
+			#endif
+
+			/** DAQ state machine */
+			E_DAQRING__MAIN_STATES eMainState;
+			
+			/** Watermark Fill Flag */
+			Luint8 u8WatermarkFlag[M_DAQRING__NUM_CHANNELS];
+		
+			/** Watermark Fill Level */
+			Luint16 u16WatermarkLevel[M_DAQRING__NUM_CHANNELS];
+
+			/** The size multiplier */
+			Luint8 u8SizeMultiplier[M_DAQRING__NUM_CHANNELS];
+
+			/** Process fill check point */
+			Luint16 u16ProcessPoint;
+
+			/** Are we streaming, and if so can we append safely?*/
+			Luint8 u8StreamingOn;
+
+			#ifdef WIN32
+			struct
+			{
+				/** Signal a new packet */
+				Luint8 u8NewPacket[10];
+				Luint16 u16LastPacketType[10];
+				Luint8 u8LastArray[10][1500];
+			}sWIN32;
+			#endif
+		
+		};
+
+		/*******************************************************************************
+		Function Prototypes
+		*******************************************************************************/
+		void vDAQRING__Init(void);
+		void vDAQRING__Process(void);
+		Luint32 u32DAQRING__Get_SystemTimer(void);
+		DLL_DECLARATION Luint16 u16DAQRING__Get_FIFO_Level(Luint16 u16Index);
+		DLL_DECLARATION Luint16 u16DAQRING__Get_FIFO_Max(Luint16 u16Index);
+		void vDAQRING__Config_UserPacketType(Luint16 u16Index, Luint16 u16Type);
+		Luint16 u16DAQRING__Get_PacketType(Luint16 u16Index);
+		void vDAQRING__Streaming_On(void);
+		void vDAQRING__Streaming_Off(void);
+		void vDAQRING__Release_Block(Luint16 u16Index);
+		Luint32 * pu32DAQRING__Get_Block_Timers(Luint16 u16Index);
+		Luint32 u32DAQRING__Get_Overflows(Luint16 u16Index);
+
+		//append
+		void vDAQRING_APPEND__Init(void);
+		void vDAQRING_APPEND__Process(void);
+		DLL_DECLARATION void vDAQRING_APPEND__U8(Luint16 u16Index, Luint8 u8Value);
+		DLL_DECLARATION void vDAQRING_APPEND__S16(Luint16 u16Index, Lint16 s16Value);
+		DLL_DECLARATION void vDAQRING_APPEND__U16(Luint16 u16Index, Luint16 u16Value);
+		DLL_DECLARATION void vDAQRING_APPEND__S32(Luint16 u16Index, Lint32 s32Value);
+		DLL_DECLARATION void vDAQRING_APPEND__U32(Luint16 u16Index, Luint32 u32Value);
+		DLL_DECLARATION void vDAQRING_APPEND__F32(Luint16 u16Index, Lfloat32 f32Value);
+		Lint16 s16DAQRING_APPEND__Index_to_BufferPointer(Luint16 u16Index, Luint8 **pu8Buffer);
+		
+		#ifdef WIN32
+			Lint16 s16DAQRING_WIN32__TxHandler(Luint16 u16Index, Luint8 *pu8Buffer, Luint16 u16Length);
+		#endif
+
+
+		#if C_LOCALDEF__LCCM667__ENABLE_TEST_SPEC == 1U
+			DLL_DECLARATION void vLCCM667R0_TS_000(void);
+			Lint16 s16LCCM667R0_TS_000__TxHandler(Luint16 u16Index, Luint8 *pu8Buffer, Luint16 u16Length);
+		#endif
+
+		//safetys
+		#if (C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS & (C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS - 1U)) != 0U
+			//rings are masked, must be a power of 2
+			#error
+		#endif
+		#if (C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS % C_LOCALDEF__LCCM667__BUFFER_WATERMARK_LEVEL) != 0U
+			//blocks must never wrap the ring so they can be sent in place
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS > 8192U
+			//free running 16 bit ring counters
+			#error
+		#endif
+
+	#endif //#if C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE == 1U
+	//safetys
+	#ifndef C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE
+		#error
+	#endif
+#endif //_DAQ_RING_H_
+
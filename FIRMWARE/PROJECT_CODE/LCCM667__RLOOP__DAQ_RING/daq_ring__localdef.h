@@ -0,0 +1,55 @@
+/**
+ * @file		DAQ_RING__LOCALDEF.H
+ * @brief		Localdef template
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM667R0.FILE.002
+ */
+
+#if 0
+
+/*******************************************************************************
+RLOOP - DAQ CHANNEL RINGS
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE == 1U
+
+		/** Number of DAQ channels in each data format
+		 * Channels are indexed in this order, U8 first, then S16, U16, S32, U32, F32 */
+		#define C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U8					(1U)
+		#define C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S16					(1U)
+		#define C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U16					(1U)
+		#define C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__S32					(1U)
+		#define C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__U32					(1U)
+		#define C_LOCALDEF__LCCM667__NUM_DAQ_CHANNELS__F32					(1U)
+
+		/** Length of each channel ring in 4 byte blocks
+		* WARNING: Value must be a power of 2 and a multiple of the watermark.*/
+		#define C_LOCALDEF__LCCM667__MAX_DAQ_BUFFER_BLOCKS					(128U)
+
+		/** Each time a channel reaches this level one block of this size is
+		 * passed to the TX handler in place. For channels that are not 4 bytes
+		 * this value will be expanded. */
+		#define C_LOCALDEF__LCCM667__BUFFER_WATERMARK_LEVEL					(64U)
+
+		/** Enable user payload types, otherwise use the standard 0x1210+ for up
+		 * to 128 channels */
+		#define C_LOCALDEF__LCCM667__ENABLE_USER_PAYLOAD_TYPES				(0U)
+
+		/** Enable a snapshot of the core timer along with each sample, see
+		* pu32DAQRING__Get_Block_Timers(). This chews 4 bytes per sample per channel and
+		* will have a slight performance penalty */
+		#define C_LOCALDEF__LCCM667__ENABLE_TIMER_IN_DATA					(0U)
+
+		/** Transmission handler, return C_DAQRING__TX_DONE, C_DAQRING__TX_HELD or -1 if busy */
+		#define M_LOCALDEF__LCCM667__TX_HANDLER(index, pbuffer, length)		s16DAQRING_WIN32__TxHandler(index, pbuffer, length)
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM667__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM667__RLOOP__DAQ_RING/daq_ring.h>
+	#endif //#if C_LOCALDEF__LCCM667__ENABLE_THIS_MODULE == 1U
+
+#endif //#if 0
+
@@ -0,0 +1,512 @@
+/**
+ * @file		LCCM668R0_TS_000.C
+ * @brief		Test spec for bulk block streaming
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM668R0.FILE.002
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM668__ENABLE_TEST_SPEC == 1U
+
+//host side only
+#include <stdio.h>
+
+/** Blocks streamed in each case */
+#define C_TS000__BLOCKS							(800U)
+
+/** Every 8 blocks take this much memory, see vTS000__Reset() */
+#define C_TS000__ARENA_SIZE						((C_TS000__BLOCKS / 8U) * 5208U)
+
+/** Tx buffers the mock transport has */
+#define C_TS000__BUFFERS						(6U)
+#define C_TS000__BUFFER_SIZE					(1500U)
+
+/** Gives up after this many process calls */
+#define C_TS000__MAX_CALLS						(20000U)
+
+void vLCCM668R0_TS_000_TCASE_001(void);
+void vLCCM668R0_TS_000_TCASE_002(void);
+void vLCCM668R0_TS_000_TCASE_003(void);
+static void vTS000__Reset(Luint8 u8FailEvery);
+static Luint32 u32TS000__Run(Luint8 u8WireRate);
+static void vTS000__Wire(Luint8 u8Frames);
+static void vTS000__Check(const Luint8 *pu8Header, Luint16 u16HeaderLength, const Luint8 *pu8Data, Luint32 u32DataLength);
+static Luint8 u8TS000__Pattern(Luint32 u32Block, Luint32 u32Offset);
+
+//the blocks, back to back in the arena
+static Luint8 u8TS000_Arena[C_TS000__ARENA_SIZE];
+static Luint32 u32TS000_BlockOffset[C_TS000__BLOCKS];
+static Luint32 u32TS000_BlockLength[C_TS000__BLOCKS];
+static Luint16 u16TS000_BlockType[C_TS000__BLOCKS];
+static Luint32 u32TS000_NextQueue;
+
+//mock transport, committed buffers go out in order
+static Luint8 u8TS000_Tx[C_TS000__BUFFERS][C_TS000__BUFFER_SIZE];
+static Luint8 u8TS000_TxUsed[C_TS000__BUFFERS];
+static Luint16 u16TS000_TxLength[C_TS000__BUFFERS];
+static Luint8 u8TS000_Wire[C_TS000__BUFFERS];
+static Luint32 u32TS000_WireHead;
+static Luint32 u32TS000_WireTail;
+static Luint8 u8TS000_FailEvery;
+static Luint32 u32TS000_PreCommits;
+static Luint8 u8TS000_PerCall;
+static Luint8 u8TS000_MaxPerCall;
+
+//what the far end saw
+static Luint32 u32TS000_NextChunk;
+static Luint32 u32TS000_RxBlock;
+static Luint32 u32TS000_RxOffset;
+static Luint32 u32TS000_RxBytes;
+static Luint32 u32TS000_NextDone;
+static Luint32 u32TS000_Errors;
+static Luint32 u32TS000_DataErrors;
+
+//Function to call the tests for this test specification
+void vLCCM668R0_TS_000(void)
+{
+	//Call the test cases
+	vLCCM668R0_TS_000_TCASE_001();
+	vLCCM668R0_TS_000_TCASE_002();
+	vLCCM668R0_TS_000_TCASE_003();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM668R0.TS.000.TCASE.001
+ * @st_test_desc
+ * Stream a mix of big, small and back to back blocks from two streams. Every
+ * chunk must be in sequence with a good header, the far end must be able to
+ * rebuild every block byte for byte, and every block must be handed back once,
+ * in order, only once all of it is in a Tx buffer.
+ *
+*/
+void vLCCM668R0_TS_000_TCASE_001(void)
+{
+	char cText[160];
+	Luint32 u32Calls;
+	Luint32 u32Bytes;
+	Luint32 u32Counter;
+
+	DEBUG_PRINT("START:LCCM668R0.TS.000.TCASE.001\r\n");
+
+	vTS000__Reset(0U);
+	u32Calls = u32TS000__Run(2U);
+
+	u32Bytes = 0U;
+	for(u32Counter = 0U; u32Counter < C_TS000__BLOCKS; u32Counter++)
+	{
+		u32Bytes += u32TS000_BlockLength[u32Counter];
+	}
+
+	sprintf(cText, "INFO: %u blocks in %u chunks over %u calls, %u bytes, errors %u, data errors %u\r\n", u32TS000_NextDone, u32TS000_NextChunk, u32Calls,
+			u32TS000_RxBytes, u32TS000_Errors, u32TS000_DataErrors);
+	DEBUG_PRINT(cText);
+
+	if((u32TS000_Errors == 0U) && (u32TS000_DataErrors == 0U) &&
+		(u32TS000_NextDone == C_TS000__BLOCKS) && (u32TS000_RxBlock == C_TS000__BLOCKS) &&
+		(u32TS000_RxBytes == u32Bytes) && (u32BULKTX__Get_Bytes() == u32Bytes) &&
+		(u32TS000_NextChunk < C_TS000__BLOCKS) && (u8BULKTX__Is_Busy() == 0U))
+	{
+		DEBUG_PRINT("PASS:LCCM668R0.TS.000.TCASE.001\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM668R0.TS.000.TCASE.001\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM668R0.TS.000.TCASE.001\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM668R0.TS.000.TCASE.002
+ * @st_test_desc
+ * The wire takes a whole window each call. A full window of chunks must go
+ * out in one process call but never more.
+ *
+*/
+void vLCCM668R0_TS_000_TCASE_002(void)
+{
+	char cText[160];
+	Luint32 u32Calls;
+
+	DEBUG_PRINT("START:LCCM668R0.TS.000.TCASE.002\r\n");
+
+	vTS000__Reset(0U);
+	u32Calls = u32TS000__Run(C_LOCALDEF__LCCM668__WINDOW);
+
+	sprintf(cText, "INFO: %u chunks over %u calls, most in a call %u, errors %u\r\n", u32TS000_NextChunk, u32Calls,
+			u8TS000_MaxPerCall, u32TS000_Errors + u32TS000_DataErrors);
+	DEBUG_PRINT(cText);
+
+	if((u32TS000_Errors == 0U) && (u32TS000_DataErrors == 0U) &&
+		(u32TS000_NextDone == C_TS000__BLOCKS) &&
+		(u8TS000_MaxPerCall == C_LOCALDEF__LCCM668__WINDOW) &&
+		(u32Calls < (u32TS000_NextChunk / 2U)))
+	{
+		DEBUG_PRINT("PASS:LCCM668R0.TS.000.TCASE.002\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM668R0.TS.000.TCASE.002\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM668R0.TS.000.TCASE.002\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM668R0.TS.000.TCASE.003
+ * @st_test_desc
+ * The transport refuses every third buffer and the wire is slow. Nothing may
+ * be lost, repeated or handed back early, and the waits must be counted.
+ *
+*/
+void vLCCM668R0_TS_000_TCASE_003(void)
+{
+	char cText[160];
+	Luint32 u32Calls;
+
+	DEBUG_PRINT("START:LCCM668R0.TS.000.TCASE.003\r\n");
+
+	vTS000__Reset(3U);
+	u32Calls = u32TS000__Run(1U);
+
+	sprintf(cText, "INFO: %u blocks in %u chunks over %u calls, no buffer %u, errors %u, data errors %u\r\n", u32TS000_NextDone, u32TS000_NextChunk, u32Calls,
+			u32BULKTX__Get_NoBuffer(), u32TS000_Errors, u32TS000_DataErrors);
+	DEBUG_PRINT(cText);
+
+	if((u32TS000_Errors == 0U) && (u32TS000_DataErrors == 0U) &&
+		(u32TS000_NextDone == C_TS000__BLOCKS) && (u32TS000_RxBlock == C_TS000__BLOCKS) &&
+		(u32BULKTX__Get_NoBuffer() > 0U))
+	{
+		DEBUG_PRINT("PASS:LCCM668R0.TS.000.TCASE.003\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM668R0.TS.000.TCASE.003\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM668R0.TS.000.TCASE.003\r\n");
+}
+
+/***************************************************************************//**
+ * @brief
+ * Lay the blocks out and start again. Every 8 blocks are four 256 byte
+ * blocks that coalesce, one that splits into three chunks, and small blocks
+ * from a second stream between them.
+ *
+ * @param[in]		u8FailEvery				Refuse every n'th buffer, 0 = never
+ */
+static void vTS000__Reset(Luint8 u8FailEvery)
+{
+	Luint32 u32Counter;
+	Luint32 u32Offset;
+	Luint32 u32Byte;
+
+	u32Offset = 0U;
+	for(u32Counter = 0U; u32Counter < C_TS000__BLOCKS; u32Counter++)
+	{
+		if((u32Counter % 8U) == 4U)
+		{
+			u32TS000_BlockLength[u32Counter] = 3000U;
+			u16TS000_BlockType[u32Counter] = 0x1210U;
+		}
+		else if((u32Counter % 8U) == 5U)
+		{
+			u32TS000_BlockLength[u32Counter] = 100U;
+			u16TS000_BlockType[u32Counter] = 0x1211U;
+		}
+		else if((u32Counter % 8U) == 6U)
+		{
+			u32TS000_BlockLength[u32Counter] = 1024U;
+			u16TS000_BlockType[u32Counter] = 0x1210U;
+		}
+		else if((u32Counter % 8U) == 7U)
+		{
+			u32TS000_BlockLength[u32Counter] = 60U;
+			u16TS000_BlockType[u32Counter] = 0x1211U;
+		}
+		else
+		{
+			u32TS000_BlockLength[u32Counter] = 256U;
+			u16TS000_BlockType[u32Counter] = 0x1210U;
+		}
+		u32TS000_BlockOffset[u32Counter] = u32Offset;
+		for(u32Byte = 0U; u32Byte < u32TS000_BlockLength[u32Counter]; u32Byte++)
+		{
+			u8TS000_Arena[u32Offset + u32Byte] = u8TS000__Pattern(u32Counter, u32Byte);
+		}
+		u32Offset += u32TS000_BlockLength[u32Counter];
+	}
+
+	for(u32Counter = 0U; u32Counter < C_TS000__BUFFERS; u32Counter++)
+	{
+		u8TS000_TxUsed[u32Counter] = 0U;
+	}
+	u32TS000_WireHead = 0U;
+	u32TS000_WireTail = 0U;
+	u8TS000_FailEvery = u8FailEvery;
+	u32TS000_PreCommits = 0U;
+	u8TS000_MaxPerCall = 0U;
+
+	u32TS000_NextQueue = 0U;
+	u32TS000_NextChunk = 0U;
+	u32TS000_RxBlock = 0U;
+	u32TS000_RxOffset = 0U;
+	u32TS000_RxBytes = 0U;
+	u32TS000_NextDone = 0U;
+	u32TS000_Errors = 0U;
+	u32TS000_DataErrors = 0U;
+
+	vBULKTX__Init();
+}
+
+/***************************************************************************//**
+ * @brief
+ * Queue what will fit and process until every block is handed back
+ *
+ * @param[in]		u8WireRate				Frames the wire takes each call
+ * @return			Process calls it took
+ */
+static Luint32 u32TS000__Run(Luint8 u8WireRate)
+{
+	Luint32 u32Calls;
+	Luint8 u8Stop;
+
+	u32Calls = 0U;
+	while((u32TS000_NextDone < C_TS000__BLOCKS) && (u32Calls < C_TS000__MAX_CALLS))
+	{
+		u8Stop = 0U;
+		while((u8Stop == 0U) && (u32TS000_NextQueue < C_TS000__BLOCKS))
+		{
+			if(s16BULKTX__Queue(u16TS000_BlockType[u32TS000_NextQueue], (Luint16)u32TS000_NextQueue, &u8TS000_Arena[u32TS000_BlockOffset[u32TS000_NextQueue]],
+								u32TS000_BlockLength[u32TS000_NextQueue], u32TS000_NextQueue * 3U) == 0)
+			{
+				u32TS000_NextQueue++;
+			}
+			else
+			{
+				u8Stop = 1U;
+			}
+		}
+
+		u8TS000_PerCall = 0U;
+		vBULKTX__Process();
+		if(u8TS000_PerCall > u8TS000_MaxPerCall)
+		{
+			u8TS000_MaxPerCall = u8TS000_PerCall;
+		}
+		else
+		{
+			//fall on
+		}
+
+		vTS000__Wire(u8WireRate);
+		u32Calls++;
+	}
+
+	//blocks are handed back before their frames go, let the wire finish
+	vTS000__Wire(C_TS000__BUFFERS);
+
+	return u32Calls;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Put committed frames on the wire, the far end checks them as they arrive
+ *
+ * @param[in]		u8Frames				Most frames to send
+ */
+static void vTS000__Wire(Luint8 u8Frames)
+{
+	Luint8 u8Counter;
+	Luint8 u8Index;
+
+	for(u8Counter = 0U; (u8Counter < u8Frames) && (u32TS000_WireTail != u32TS000_WireHead); u8Counter++)
+	{
+		u8Index = u8TS000_Wire[u32TS000_WireTail % C_TS000__BUFFERS];
+		u32TS000_WireTail++;
+
+		vTS000__Check(&u8TS000_Tx[u8Index][0], C_BULKTX__HEADER_SIZE, &u8TS000_Tx[u8Index][C_BULKTX__HEADER_SIZE], (Luint32)u16TS000_TxLength[u8Index] - C_BULKTX__HEADER_SIZE);
+
+		u8TS000_TxUsed[u8Index] = 0U;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * The far end, check a chunk and place its data against the blocks
+ *
+ * @param[in]		u32DataLength			Block data bytes
+ * @param[in]		*pu8Data				Block data
+ * @param[in]		u16HeaderLength			Bytes in the Tx buffer
+ * @param[in]		*pu8Header				Tx buffer
+ */
+static void vTS000__Check(const Luint8 *pu8Header, Luint16 u16HeaderLength, const Luint8 *pu8Data, Luint32 u32DataLength)
+{
+	Luint32 u32Counter;
+	Luint16 u16BlockCount;
+
+	if((u16HeaderLength != C_BULKTX__HEADER_SIZE) ||
+		(u16SWCRC__CRC(pu8Header, C_BULKTX__HEADER_SIZE - 2U) != u16NUMERICAL_CONVERT__Array((const Luint8 *)(pu8Header + 24U))) ||
+		(u32NUMERICAL_CONVERT__Array((const Luint8 *)pu8Header) != u32TS000_NextChunk) ||
+		((Luint32)u16NUMERICAL_CONVERT__Array((const Luint8 *)(pu8Header + 6U)) != u32DataLength) ||
+		(u32TS000_RxBlock >= C_TS000__BLOCKS) ||
+		(u16NUMERICAL_CONVERT__Array((const Luint8 *)(pu8Header + 4U)) != u16TS000_BlockType[u32TS000_RxBlock]) ||
+		(u32NUMERICAL_CONVERT__Array((const Luint8 *)(pu8Header + 8U)) != u32TS000_RxBlock) ||
+		(u32NUMERICAL_CONVERT__Array((const Luint8 *)(pu8Header + 12U)) != u32TS000_RxOffset) ||
+		(u32NUMERICAL_CONVERT__Array((const Luint8 *)(pu8Header + 16U)) != (u32TS000_RxBlock * 3U)))
+	{
+		//lost our place, can't check the data
+		u32TS000_Errors++;
+	}
+	else
+	{
+		u16BlockCount = 0U;
+		for(u32Counter = 0U; u32Counter < u32DataLength; u32Counter++)
+		{
+			if((u32TS000_RxBlock >= C_TS000__BLOCKS) || (pu8Data[u32Counter] != u8TS000__Pattern(u32TS000_RxBlock, u32TS000_RxOffset)))
+			{
+				u32TS000_DataErrors++;
+			}
+			else
+			{
+				//fall on
+			}
+
+			u32TS000_RxOffset++;
+			if((u32TS000_RxBlock < C_TS000__BLOCKS) && (u32TS000_RxOffset >= u32TS000_BlockLength[u32TS000_RxBlock]))
+			{
+				u32TS000_RxBlock++;
+				u32TS000_RxOffset = 0U;
+				u16BlockCount++;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+
+		if(u16BlockCount != u16NUMERICAL_CONVERT__Array((const Luint8 *)(pu8Header + 22U)))
+		{
+			u32TS000_Errors++;
+		}
+		else
+		{
+			//fall on
+		}
+
+		u32TS000_RxBytes += u32DataLength;
+	}
+
+	u32TS000_NextChunk++;
+}
+
+/***************************************************************************//**
+ * @brief
+ * What a block byte should be
+ *
+ * @param[in]		u32Offset				Byte in the block
+ * @param[in]		u32Block				Block number
+ * @return			The byte
+ */
+static Luint8 u8TS000__Pattern(Luint32 u32Block, Luint32 u32Offset)
+{
+	return (Luint8)((u32Block * 7U) + (u32Offset * 13U) + (u32Offset >> 8U) + 1U);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Mock transport, hand out a Tx buffer
+ */
+Lint16 s16LCCM668R0_TS_000__PreCommit(Luint16 u16Length, Luint16 u16PacketType, Luint8 **ppu8Buffer, Luint8 *pu8BufferIndex)
+{
+	Lint16 s16Return;
+	Luint8 u8Counter;
+
+	(void)u16PacketType;
+
+	s16Return = -1;
+	u32TS000_PreCommits++;
+	if((u8TS000_FailEvery != 0U) && ((u32TS000_PreCommits % u8TS000_FailEvery) == 0U))
+	{
+		//refused
+	}
+	else if(u16Length > C_TS000__BUFFER_SIZE)
+	{
+		u32TS000_Errors++;
+	}
+	else
+	{
+		for(u8Counter = 0U; (u8Counter < C_TS000__BUFFERS) && (s16Return != 0); u8Counter++)
+		{
+			if(u8TS000_TxUsed[u8Counter] == 0U)
+			{
+				u8TS000_TxUsed[u8Counter] = 1U;
+				*ppu8Buffer = &u8TS000_Tx[u8Counter][0];
+				*pu8BufferIndex = u8Counter;
+				s16Return = 0;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Mock transport, send a Tx buffer
+ */
+void vLCCM668R0_TS_000__Commit(Luint8 u8BufferIndex, Luint16 u16Length)
+{
+	if(u8TS000_TxUsed[u8BufferIndex] != 1U)
+	{
+		u32TS000_Errors++;
+	}
+	else
+	{
+		u8TS000_TxUsed[u8BufferIndex] = 2U;
+		u16TS000_TxLength[u8BufferIndex] = u16Length;
+		u8TS000_Wire[u32TS000_WireHead % C_TS000__BUFFERS] = u8BufferIndex;
+		u32TS000_WireHead++;
+		u8TS000_PerCall++;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * A block is handed back, it must be the oldest and the producer reuses it
+ * straight away
+ */
+void vLCCM668R0_TS_000__Done(Luint16 u16PacketType, Luint16 u16Tag)
+{
+	Luint32 u32Counter;
+
+	if(((Luint32)u16Tag != u32TS000_NextDone) || (u16PacketType != u16TS000_BlockType[u16Tag]))
+	{
+		u32TS000_Errors++;
+	}
+	else
+	{
+		for(u32Counter = 0U; u32Counter < u32TS000_BlockLength[u16Tag]; u32Counter++)
+		{
+			u8TS000_Arena[u32TS000_BlockOffset[u16Tag] + u32Counter] = 0xEEU;
+		}
+	}
+	u32TS000_NextDone++;
+}
+
+#endif //#if C_LOCALDEF__LCCM668__ENABLE_TEST_SPEC == 1U
+#endif //#if C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE == 1U
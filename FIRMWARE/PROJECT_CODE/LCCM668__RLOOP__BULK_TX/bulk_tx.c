@@ -0,0 +1,342 @@
+/**
+ * @file		BULK_TX.C
+ * @brief		Bulk block streaming over SafeUDP
+ *
+ * @note
+ * Callers queue blocks by address, the blocks go out as numbered chunks each
+ * with a small header so the far end can place them. Blocks bigger than a
+ * chunk are split, small blocks of one stream that sit back to back in
+ * memory are coalesced up to a chunk.
+ *
+ * Up to C_LOCALDEF__LCCM668__WINDOW chunks are sent each time round. SafeUDP
+ * on the RM4 can't chain a payload, so the chunk data is copied into the Tx
+ * buffer behind the header and its blocks are handed back straight away.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM668R0.FILE.000
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup BULKTX
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup BULKTX__CORE
+ * @ingroup BULKTX
+ * @{ */
+
+#include "bulk_tx.h"
+#if C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE == 1U
+
+#include <string.h>
+
+struct _strBULKTX sBULKTX;
+
+//locals
+static void vBULKTX__Retire(Luint8 u8Blocks);
+
+
+/***************************************************************************//**
+ * @brief
+ * Init the bulk transmitter, anything queued is forgotten
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM668R0.FILE.000.FUNC.001
+ */
+void vBULKTX__Init(void)
+{
+	sBULKTX.u8Head = 0U;
+	sBULKTX.u8Send = 0U;
+	sBULKTX.u8Tail = 0U;
+	sBULKTX.u32SendOffset = 0U;
+	sBULKTX.u16SendChunk = 0U;
+	sBULKTX.u32Committed = 0U;
+	sBULKTX.u32BlockSeq = 0U;
+
+	sBULKTX.sStats.u32Chunks = 0U;
+	sBULKTX.sStats.u32Bytes = 0U;
+	sBULKTX.sStats.u32Blocks = 0U;
+	sBULKTX.sStats.u32NoBuffer = 0U;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Queue a block for sending. The block is not copied here, it must not change
+ * until M_LOCALDEF__LCCM668__TX_DONE() is called with the same type and tag.
+ * That is as soon as the last of it is copied into a Tx buffer.
+ *
+ * @param[in]		u32Stamp				Stamp sent with the block, eg a timer
+ * @param[in]		u32Length				Block length in bytes
+ * @param[in]		*pu8Block				The block in memory
+ * @param[in]		u16Tag					Handed back when the block is done
+ * @param[in]		u16PacketType			SafeUDP packet type of the stream
+ * @return			0 = queued\n
+ *					-1 = queue full, try later\n
+ *					-2 = nothing to send
+ * @st_funcMD5
+ * @st_funcID		LCCM668R0.FILE.000.FUNC.002
+ */
+Lint16 s16BULKTX__Queue(Luint16 u16PacketType, Luint16 u16Tag, const Luint8 *pu8Block, Luint32 u32Length, Luint32 u32Stamp)
+{
+	Lint16 s16Return;
+	Luint8 u8Pos;
+
+	if((pu8Block == 0) || (u32Length == 0U))
+	{
+		s16Return = -2;
+	}
+	else if((Luint8)(sBULKTX.u8Head - sBULKTX.u8Tail) >= C_LOCALDEF__LCCM668__QUEUE_DEPTH)
+	{
+		//caller keeps the block and tries later
+		s16Return = -1;
+	}
+	else
+	{
+		u8Pos = sBULKTX.u8Head & (C_LOCALDEF__LCCM668__QUEUE_DEPTH - 1U);
+		sBULKTX.sQueue[u8Pos].u32Addx = (Luint32)pu8Block;
+		sBULKTX.sQueue[u8Pos].u32Length = u32Length;
+		sBULKTX.sQueue[u8Pos].u32Stamp = u32Stamp;
+		sBULKTX.sQueue[u8Pos].u32Sequence = sBULKTX.u32BlockSeq;
+		sBULKTX.sQueue[u8Pos].u16PacketType = u16PacketType;
+		sBULKTX.sQueue[u8Pos].u16Tag = u16Tag;
+
+		sBULKTX.u32BlockSeq++;
+		sBULKTX.u8Head++;
+		s16Return = 0;
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Process the bulk transmitter, call from the main loop once the link is up.
+ * Sends up to a window of chunks, stopping early if the transport has no
+ * buffer.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM668R0.FILE.000.FUNC.003
+ */
+void vBULKTX__Process(void)
+{
+	Lint16 s16Return;
+	Luint8 *pu8Buffer;
+	Luint8 u8BufferIndex;
+	Luint8 u8Pos;
+	Luint8 u8Next;
+	Luint8 u8Blocks;
+	Luint8 u8Sent;
+	Luint8 u8Stop;
+	Luint8 u8Coalesce;
+	Luint32 u32Addx;
+	Luint32 u32Length;
+	Luint32 u32EndOffset;
+	Luint16 u16PacketType;
+
+	u8Sent = 0U;
+	u8Stop = 0U;
+	while(u8Stop == 0U)
+	{
+		if(sBULKTX.u8Send == sBULKTX.u8Head)
+		{
+			//nothing left to send
+			u8Stop = 1U;
+		}
+		else
+		{
+			//start where the last chunk left the send block
+			u8Pos = sBULKTX.u8Send & (C_LOCALDEF__LCCM668__QUEUE_DEPTH - 1U);
+			u32Addx = sBULKTX.sQueue[u8Pos].u32Addx + sBULKTX.u32SendOffset;
+			u32Length = sBULKTX.sQueue[u8Pos].u32Length - sBULKTX.u32SendOffset;
+			u16PacketType = sBULKTX.sQueue[u8Pos].u16PacketType;
+
+			if(u32Length > C_LOCALDEF__LCCM668__CHUNK_SIZE)
+			{
+				//big block, take a chunk off the front of what is left
+				u32Length = C_LOCALDEF__LCCM668__CHUNK_SIZE;
+				u8Blocks = 0U;
+				u32EndOffset = sBULKTX.u32SendOffset + C_LOCALDEF__LCCM668__CHUNK_SIZE;
+			}
+			else
+			{
+				//finishes the send block
+				u8Blocks = 1U;
+				u32EndOffset = 0U;
+
+				//coalesce whole blocks of the same stream that follow on in memory
+				u8Coalesce = 1U;
+				u8Next = (Luint8)(sBULKTX.u8Send + 1U);
+				while((u8Coalesce == 1U) && (u8Next != sBULKTX.u8Head))
+				{
+					u8Pos = u8Next & (C_LOCALDEF__LCCM668__QUEUE_DEPTH - 1U);
+					if((sBULKTX.sQueue[u8Pos].u16PacketType == u16PacketType) &&
+						(sBULKTX.sQueue[u8Pos].u32Addx == (u32Addx + u32Length)) &&
+						((u32Length + sBULKTX.sQueue[u8Pos].u32Length) <= C_LOCALDEF__LCCM668__CHUNK_SIZE))
+					{
+						u32Length += sBULKTX.sQueue[u8Pos].u32Length;
+						u8Blocks++;
+						u8Next++;
+					}
+					else
+					{
+						//wrapped, another stream, or too big
+						u8Coalesce = 0U;
+					}
+				}
+			}
+
+			u8Pos = sBULKTX.u8Send & (C_LOCALDEF__LCCM668__QUEUE_DEPTH - 1U);
+			s16Return = M_LOCALDEF__LCCM668__PRECOMMIT((Luint16)(C_BULKTX__HEADER_SIZE + u32Length), u16PacketType, &pu8Buffer, &u8BufferIndex);
+			if(s16Return == 0)
+			{
+				sBULKTX.sHeader.u32Sequence = sBULKTX.u32Committed;
+				sBULKTX.sHeader.u16PacketType = u16PacketType;
+				sBULKTX.sHeader.u16PayloadLength = (Luint16)u32Length;
+				sBULKTX.sHeader.u32BlockSequence = sBULKTX.sQueue[u8Pos].u32Sequence;
+				sBULKTX.sHeader.u32BlockOffset = sBULKTX.u32SendOffset;
+				sBULKTX.sHeader.u32BlockStamp = sBULKTX.sQueue[u8Pos].u32Stamp;
+				sBULKTX.sHeader.u16ChunkIndex = sBULKTX.u16SendChunk;
+				sBULKTX.sHeader.u16BlockCount = u8Blocks;
+
+				vNUMERICAL_CONVERT__Array_U32(pu8Buffer, sBULKTX.sHeader.u32Sequence);
+				vNUMERICAL_CONVERT__Array_U16(pu8Buffer + 4U, sBULKTX.sHeader.u16PacketType);
+				vNUMERICAL_CONVERT__Array_U16(pu8Buffer + 6U, sBULKTX.sHeader.u16PayloadLength);
+				vNUMERICAL_CONVERT__Array_U32(pu8Buffer + 8U, sBULKTX.sHeader.u32BlockSequence);
+				vNUMERICAL_CONVERT__Array_U32(pu8Buffer + 12U, sBULKTX.sHeader.u32BlockOffset);
+				vNUMERICAL_CONVERT__Array_U32(pu8Buffer + 16U, sBULKTX.sHeader.u32BlockStamp);
+				vNUMERICAL_CONVERT__Array_U16(pu8Buffer + 20U, sBULKTX.sHeader.u16ChunkIndex);
+				vNUMERICAL_CONVERT__Array_U16(pu8Buffer + 22U, sBULKTX.sHeader.u16BlockCount);
+
+				//the header CRC lets the far end trust the header before it places the data
+				sBULKTX.sHeader.u16HeaderCRC = u16SWCRC__CRC((const Luint8 *)pu8Buffer, C_BULKTX__HEADER_SIZE - 2U);
+				vNUMERICAL_CONVERT__Array_U16(pu8Buffer + 24U, sBULKTX.sHeader.u16HeaderCRC);
+
+				sBULKTX.u32Committed++;
+				sBULKTX.u8Send = (Luint8)(sBULKTX.u8Send + u8Blocks);
+				sBULKTX.u32SendOffset = u32EndOffset;
+				if(u8Blocks > 0U)
+				{
+					sBULKTX.u16SendChunk = 0U;
+				}
+				else
+				{
+					//still working through a big block
+					sBULKTX.u16SendChunk++;
+				}
+
+				memcpy(pu8Buffer + C_BULKTX__HEADER_SIZE, (const void *)u32Addx, u32Length);
+				M_LOCALDEF__LCCM668__COMMIT(u8BufferIndex, (Luint16)(C_BULKTX__HEADER_SIZE + u32Length));
+
+				sBULKTX.sStats.u32Chunks++;
+				sBULKTX.sStats.u32Bytes += u32Length;
+
+				//the data is in the Tx buffer, the blocks it finished are free now
+				vBULKTX__Retire(u8Blocks);
+
+				u8Sent++;
+				if(u8Sent >= C_LOCALDEF__LCCM668__WINDOW)
+				{
+					//leave the Tx buffers for everyone else
+					u8Stop = 1U;
+				}
+				else
+				{
+					//fall on
+				}
+			}
+			else
+			{
+				//no Tx buffer, the chunk is built again next time round
+				sBULKTX.sStats.u32NoBuffer++;
+				u8Stop = 1U;
+			}
+		}
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Hand back the oldest blocks, a chunk has finished them
+ *
+ * @param[in]		u8Blocks				Whole blocks the chunk finished
+ * @st_funcMD5
+ * @st_funcID		LCCM668R0.FILE.000.FUNC.004
+ */
+static void vBULKTX__Retire(Luint8 u8Blocks)
+{
+	Luint8 u8Counter;
+	Luint8 u8Pos;
+
+	//oldest first, the order the caller queued them
+	for(u8Counter = 0U; u8Counter < u8Blocks; u8Counter++)
+	{
+		u8Pos = sBULKTX.u8Tail & (C_LOCALDEF__LCCM668__QUEUE_DEPTH - 1U);
+		sBULKTX.u8Tail++;
+		sBULKTX.sStats.u32Blocks++;
+		M_LOCALDEF__LCCM668__TX_DONE(sBULKTX.sQueue[u8Pos].u16PacketType, sBULKTX.sQueue[u8Pos].u16Tag);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Is anything queued or part sent
+ *
+ * @return			0 = idle\n
+ *					1 = busy
+ * @st_funcMD5
+ * @st_funcID		LCCM668R0.FILE.000.FUNC.005
+ */
+Luint8 u8BULKTX__Is_Busy(void)
+{
+	Luint8 u8Return;
+
+	if(sBULKTX.u8Head != sBULKTX.u8Tail)
+	{
+		u8Return = 1U;
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Total block bytes sent
+ *
+ * @return			Byte count
+ * @st_funcMD5
+ * @st_funcID		LCCM668R0.FILE.000.FUNC.006
+ */
+Luint32 u32BULKTX__Get_Bytes(void)
+{
+	return sBULKTX.sStats.u32Bytes;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Number of times a chunk had to wait for a Tx buffer
+ *
+ * @return			Wait count
+ * @st_funcMD5
+ * @st_funcID		LCCM668R0.FILE.000.FUNC.007
+ */
+Luint32 u32BULKTX__Get_NoBuffer(void)
+{
+	return sBULKTX.sStats.u32NoBuffer;
+}
+
+#endif //#if C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
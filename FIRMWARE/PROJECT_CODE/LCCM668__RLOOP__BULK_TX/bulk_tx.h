@@ -0,0 +1,159 @@
+/**
+ * @file		BULK_TX.H
+ * @brief		Main header for bulk block streaming over SafeUDP
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ */
+
+
+#ifndef _BULK_TX_H_
+#define _BULK_TX_H_
+	#include <localdef.h>
+	#if C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE == 1U
+
+		/*******************************************************************************
+		Defines
+		*******************************************************************************/
+
+		/** Largest SafeUDP payload that fits a 1500 byte IP packet once the IP,
+		 * UDP, SafeUDP header and CRC are taken out */
+		#define C_BULKTX__MAX_PAYLOAD					(1500U - 20U - 8U - 8U - 2U)
+
+		/** Bytes of chunk header ahead of the block data */
+		#define C_BULKTX__HEADER_SIZE					(26U)
+
+		/** bulk chunk header, the block data follows it in the packet */
+		typedef struct
+		{
+
+			/** Running chunk number over all bulk streams */
+			Luint32 u32Sequence;
+			Luint16 u16PacketType;
+
+			/** Block data bytes after the header */
+			Luint16 u16PayloadLength;
+
+			/** Sequence number of the first block in the chunk */
+			Luint32 u32BlockSequence;
+
+			/** Byte offset of the chunk into its first block */
+			Luint32 u32BlockOffset;
+
+			/** Callers stamp on the first block */
+			Luint32 u32BlockStamp;
+
+			/** Chunk number within the first block */
+			Luint16 u16ChunkIndex;
+
+			/** Number of blocks the chunk covers */
+			Luint16 u16BlockCount;
+			Luint16 u16HeaderCRC;
+
+		}S_BULKTX__HEADER_T;
+
+
+		/*******************************************************************************
+		Structures
+		*******************************************************************************/
+		struct _strBULKTX
+		{
+
+			/** Blocks waiting or on the wire, oldest at the tail */
+			struct
+			{
+				/** Linear address of the block */
+				Luint32 u32Addx;
+
+				/** Block length in bytes */
+				Luint32 u32Length;
+
+				/** Callers stamp, sent in the header */
+				Luint32 u32Stamp;
+
+				/** Our block number */
+				Luint32 u32Sequence;
+
+				Luint16 u16PacketType;
+
+				/** Handed back in the done callback */
+				Luint16 u16Tag;
+
+			}sQueue[C_LOCALDEF__LCCM668__QUEUE_DEPTH];
+
+			/** Free running queue counters. The tail to the send position is
+			 * the block part sent, the send position to the head are still to go. */
+			Luint8 u8Head;
+			Luint8 u8Send;
+			Luint8 u8Tail;
+
+			/** Bytes of the send block already in chunks and chunks taken from it */
+			Luint32 u32SendOffset;
+			Luint16 u16SendChunk;
+
+			/** Chunks committed, the next chunk number */
+			Luint32 u32Committed;
+
+			/** Header of the chunk being built */
+			S_BULKTX__HEADER_T sHeader;
+
+			Luint32 u32BlockSeq;
+
+			struct
+			{
+				/** Totals sent */
+				Luint32 u32Chunks;
+				Luint32 u32Bytes;
+				Luint32 u32Blocks;
+
+				/** Times we had to wait for a Tx buffer */
+				Luint32 u32NoBuffer;
+
+			}sStats;
+
+		};
+
+
+		/*******************************************************************************
+		Function Prototypes
+		*******************************************************************************/
+		void vBULKTX__Init(void);
+		void vBULKTX__Process(void);
+		Lint16 s16BULKTX__Queue(Luint16 u16PacketType, Luint16 u16Tag, const Luint8 *pu8Block, Luint32 u32Length, Luint32 u32Stamp);
+		Luint8 u8BULKTX__Is_Busy(void);
+		Luint32 u32BULKTX__Get_Bytes(void);
+		Luint32 u32BULKTX__Get_NoBuffer(void);
+
+		//testing
+		#if C_LOCALDEF__LCCM668__ENABLE_TEST_SPEC == 1U
+			DLL_DECLARATION void vLCCM668R0_TS_000(void);
+			Lint16 s16LCCM668R0_TS_000__PreCommit(Luint16 u16Length, Luint16 u16PacketType, Luint8 **ppu8Buffer, Luint8 *pu8BufferIndex);
+			void vLCCM668R0_TS_000__Commit(Luint8 u8BufferIndex, Luint16 u16Length);
+			void vLCCM668R0_TS_000__Done(Luint16 u16PacketType, Luint16 u16Tag);
+		#endif
+
+		//safetys
+		#if C_LOCALDEF__LCCM668__CHUNK_SIZE > (C_BULKTX__MAX_PAYLOAD - C_BULKTX__HEADER_SIZE)
+			//a chunk must fit one frame
+			#error
+		#endif
+		#if (C_LOCALDEF__LCCM668__CHUNK_SIZE % 4U) != 0U
+			#error
+		#endif
+		#if (C_LOCALDEF__LCCM668__QUEUE_DEPTH & (C_LOCALDEF__LCCM668__QUEUE_DEPTH - 1U)) != 0U
+			//queue is masked, must be a power of 2
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM668__QUEUE_DEPTH > 128U
+			//free running 8 bit queue counters
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM668__WINDOW == 0U
+			#error
+		#endif
+
+	#endif //#if C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE == 1U
+	//safetys
+	#ifndef C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE
+		#error
+	#endif
+#endif //_BULK_TX_H_
@@ -0,0 +1,44 @@
+/**
+ * @file		BULK_TX__LOCALDEF.H
+ * @brief		Localdef template
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM668R0.FILE.001
+ */
+
+#if 0
+
+/*******************************************************************************
+RLOOP - BULK BLOCK STREAMING
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE == 1U
+
+		/** Blocks that can be queued, power of 2 */
+		#define C_LOCALDEF__LCCM668__QUEUE_DEPTH							(8U)
+
+		/** Block bytes per packet, small blocks are coalesced up to this if
+		 * they sit back to back in memory. Multiple of 4, max 1436 */
+		#define C_LOCALDEF__LCCM668__CHUNK_SIZE								(1024U)
+
+		/** Chunks sent each process call */
+		#define C_LOCALDEF__LCCM668__WINDOW									(4U)
+
+		/** Get a Tx buffer for a packet of this many bytes, 0 = got one */
+		#define M_LOCALDEF__LCCM668__PRECOMMIT(length, type, ppbuffer, pindex)	(Lint16)s16SAFEUDP_TX__PreCommit(length, (SAFE_UDP__PACKET_T)type, ppbuffer, pindex)
+
+		/** Send a Tx buffer */
+		#define M_LOCALDEF__LCCM668__COMMIT(index, length)					vSAFEUDP_TX__Commit(index, length, C_LOCALDEF__LCCM528__ETHERNET_PORT_NUMBER, C_LOCALDEF__LCCM528__ETHERNET_PORT_NUMBER)
+
+		/** A block is finished with, (type, tag) */
+		#define M_LOCALDEF__LCCM668__TX_DONE(type, tag)						vUSER__BulkTx_Done(type, tag)
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM668__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM668__RLOOP__BULK_TX/bulk_tx.h>
+	#endif //#if C_LOCALDEF__LCCM668__ENABLE_THIS_MODULE == 1U
+
+#endif //#if 0
+
@@ -0,0 +1,288 @@
+/**
+ * @file		ACCEL_BURST__FILTERS.C
+ * @brief		Constant time filters for the burst sample stream
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM669R0.FILE.001
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup ACCELBURST
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup ACCELBURST__FILTERS
+ * @ingroup ACCELBURST
+ * @{ */
+
+#include "../accel_burst.h"
+#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+
+/* Every sample costs the same whatever the filter lengths:
+ * Running sum: add the new sample, subtract the one it replaces.
+ * CIC: one add per stage per sample, one subtract per stage per output.
+ * The CIC gain is DECIMATION ^ STAGES which is divided out of the output. */
+
+#if C_LOCALDEF__LCCM669__CIC_STAGES == 1U
+	#define C_ACCELBURST__CIC_GAIN		(C_LOCALDEF__LCCM669__CIC_DECIMATION)
+#elif C_LOCALDEF__LCCM669__CIC_STAGES == 2U
+	#define C_ACCELBURST__CIC_GAIN		(C_LOCALDEF__LCCM669__CIC_DECIMATION * C_LOCALDEF__LCCM669__CIC_DECIMATION)
+#elif C_LOCALDEF__LCCM669__CIC_STAGES == 3U
+	#define C_ACCELBURST__CIC_GAIN		(C_LOCALDEF__LCCM669__CIC_DECIMATION * C_LOCALDEF__LCCM669__CIC_DECIMATION * C_LOCALDEF__LCCM669__CIC_DECIMATION)
+#else
+	#define C_ACCELBURST__CIC_GAIN		(C_LOCALDEF__LCCM669__CIC_DECIMATION * C_LOCALDEF__LCCM669__CIC_DECIMATION * C_LOCALDEF__LCCM669__CIC_DECIMATION * C_LOCALDEF__LCCM669__CIC_DECIMATION)
+#endif
+
+extern struct _strACCELBURST sACCELBURST[];
+
+
+/***************************************************************************//**
+ * @brief
+ * Clear the filters for a device
+ *
+ * @param[in]		u8DeviceIndex			The device index
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.001.FUNC.001
+ */
+void vACCELBURST_FILT__Init(Luint8 u8DeviceIndex)
+{
+	Luint8 u8Axis;
+	Luint8 u8Stage;
+	Luint16 u16Counter;
+
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		for(u8Axis = 0U; u8Axis < 3U; u8Axis++)
+		{
+			for(u16Counter = 0U; u16Counter < C_LOCALDEF__LCCM669__AVERAGE_SAMPLES; u16Counter++)
+			{
+				sACCELBURST[u8DeviceIndex].sAverage.s16Window[u8Axis][u16Counter] = 0;
+			}
+			sACCELBURST[u8DeviceIndex].sAverage.s32Sum[u8Axis] = 0;
+
+			for(u8Stage = 0U; u8Stage < C_LOCALDEF__LCCM669__CIC_STAGES; u8Stage++)
+			{
+				sACCELBURST[u8DeviceIndex].sCIC.u32Integrator[u8Axis][u8Stage] = 0U;
+				sACCELBURST[u8DeviceIndex].sCIC.u32Comb[u8Axis][u8Stage] = 0U;
+			}
+			sACCELBURST[u8DeviceIndex].sCIC.s16Output[u8Axis] = 0;
+		}
+
+		sACCELBURST[u8DeviceIndex].sAverage.u16Position = 0U;
+		sACCELBURST[u8DeviceIndex].sAverage.u16Fill = 0U;
+		sACCELBURST[u8DeviceIndex].sCIC.u8Phase = 0U;
+		sACCELBURST[u8DeviceIndex].sCIC.u32Count = 0U;
+	}
+	else
+	{
+		//index fault
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Run one XYZ sample through the filters
+ *
+ * @param[in]		*ps16XYZ				X, Y, Z raw sample
+ * @param[in]		u8DeviceIndex			The device index
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.001.FUNC.002
+ */
+void vACCELBURST_FILT__Add(Luint8 u8DeviceIndex, const Lint16 *ps16XYZ)
+{
+	Luint8 u8Axis;
+	Luint8 u8Stage;
+	Luint16 u16Pos;
+	Luint32 u32Acc;
+	Luint32 u32Prev;
+	Luint8 u8Output;
+
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		//running sum
+		u16Pos = sACCELBURST[u8DeviceIndex].sAverage.u16Position;
+		for(u8Axis = 0U; u8Axis < 3U; u8Axis++)
+		{
+			sACCELBURST[u8DeviceIndex].sAverage.s32Sum[u8Axis] -= (Lint32)sACCELBURST[u8DeviceIndex].sAverage.s16Window[u8Axis][u16Pos];
+			sACCELBURST[u8DeviceIndex].sAverage.s32Sum[u8Axis] += (Lint32)ps16XYZ[u8Axis];
+			sACCELBURST[u8DeviceIndex].sAverage.s16Window[u8Axis][u16Pos] = ps16XYZ[u8Axis];
+		}
+
+		u16Pos++;
+		if(u16Pos >= C_LOCALDEF__LCCM669__AVERAGE_SAMPLES)
+		{
+			u16Pos = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+		sACCELBURST[u8DeviceIndex].sAverage.u16Position = u16Pos;
+
+		if(sACCELBURST[u8DeviceIndex].sAverage.u16Fill < C_LOCALDEF__LCCM669__AVERAGE_SAMPLES)
+		{
+			sACCELBURST[u8DeviceIndex].sAverage.u16Fill++;
+		}
+		else
+		{
+			//full
+		}
+
+		//CIC
+		sACCELBURST[u8DeviceIndex].sCIC.u8Phase++;
+		if(sACCELBURST[u8DeviceIndex].sCIC.u8Phase >= C_LOCALDEF__LCCM669__CIC_DECIMATION)
+		{
+			sACCELBURST[u8DeviceIndex].sCIC.u8Phase = 0U;
+			u8Output = 1U;
+		}
+		else
+		{
+			u8Output = 0U;
+		}
+
+		for(u8Axis = 0U; u8Axis < 3U; u8Axis++)
+		{
+			//integrators
+			u32Acc = (Luint32)((Lint32)ps16XYZ[u8Axis]);
+			for(u8Stage = 0U; u8Stage < C_LOCALDEF__LCCM669__CIC_STAGES; u8Stage++)
+			{
+				sACCELBURST[u8DeviceIndex].sCIC.u32Integrator[u8Axis][u8Stage] += u32Acc;
+				u32Acc = sACCELBURST[u8DeviceIndex].sCIC.u32Integrator[u8Axis][u8Stage];
+			}
+
+			if(u8Output == 1U)
+			{
+				//combs, differential delay of 1
+				for(u8Stage = 0U; u8Stage < C_LOCALDEF__LCCM669__CIC_STAGES; u8Stage++)
+				{
+					u32Prev = sACCELBURST[u8DeviceIndex].sCIC.u32Comb[u8Axis][u8Stage];
+					sACCELBURST[u8DeviceIndex].sCIC.u32Comb[u8Axis][u8Stage] = u32Acc;
+					u32Acc -= u32Prev;
+				}
+
+				sACCELBURST[u8DeviceIndex].sCIC.s16Output[u8Axis] = (Lint16)((Lint32)u32Acc / (Lint32)C_ACCELBURST__CIC_GAIN);
+			}
+			else
+			{
+				//integrate only
+			}
+		}
+
+		if(u8Output == 1U)
+		{
+			sACCELBURST[u8DeviceIndex].sCIC.u32Count++;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	else
+	{
+		//index fault
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the running average
+ *
+ * @param[in]		u8Axis					The axis, C_ACCELBURST__AXIS_x
+ * @param[in]		u8DeviceIndex			The device index
+ * @return			Average of the last BURST_AVERAGE_SAMPLES raw samples
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.001.FUNC.003
+ */
+Lint16 s16ACCELBURST_FILT__Get_Average(Luint8 u8DeviceIndex, Luint8 u8Axis)
+{
+	Lint16 s16Return;
+
+	if((u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES) && (u8Axis < 3U))
+	{
+		if(sACCELBURST[u8DeviceIndex].sAverage.u16Fill > 0U)
+		{
+			s16Return = (Lint16)(sACCELBURST[u8DeviceIndex].sAverage.s32Sum[u8Axis] / (Lint32)sACCELBURST[u8DeviceIndex].sAverage.u16Fill);
+		}
+		else
+		{
+			s16Return = 0;
+		}
+	}
+	else
+	{
+		s16Return = 0;
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the last CIC output, ODR / CIC_DECIMATION
+ *
+ * @param[in]		u8Axis					The axis, C_ACCELBURST__AXIS_x
+ * @param[in]		u8DeviceIndex			The device index
+ * @return			Decimated sample, raw units
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.001.FUNC.004
+ */
+Lint16 s16ACCELBURST_FILT__Get_Decimated(Luint8 u8DeviceIndex, Luint8 u8Axis)
+{
+	Lint16 s16Return;
+
+	if((u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES) && (u8Axis < 3U))
+	{
+		s16Return = sACCELBURST[u8DeviceIndex].sCIC.s16Output[u8Axis];
+	}
+	else
+	{
+		s16Return = 0;
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the number of CIC outputs so far, a consumer can tell when a new one
+ * is ready from a change in the count.
+ *
+ * @param[in]		u8DeviceIndex			The device index
+ * @return			Free running output count
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.001.FUNC.005
+ */
+Luint32 u32ACCELBURST_FILT__Get_DecimatedCount(Luint8 u8DeviceIndex)
+{
+	Luint32 u32Return;
+
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		u32Return = sACCELBURST[u8DeviceIndex].sCIC.u32Count;
+	}
+	else
+	{
+		u32Return = 0U;
+	}
+
+	return u32Return;
+}
+
+//safetys
+#if C_ACCELBURST__CIC_GAIN > 131072U
+	//14 bit input, the integrators must not grow past 31 bits
+	#error
+#endif
+
+#endif //#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
@@ -0,0 +1,181 @@
+/**
+ * @file		ACCEL_BURST__MATH.C
+ * @brief		G-Force and angles from the decimated burst stream
+ *
+ * @note
+ * Worked out once per CIC output, not per sample, so the cost follows the
+ * decimated rate.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM669R0.FILE.002
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup ACCELBURST
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup ACCELBURST__MATH
+ * @ingroup ACCELBURST
+ * @{ */
+
+#include "../accel_burst.h"
+#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+
+extern struct _strACCELBURST sACCELBURST[];
+
+
+/***************************************************************************//**
+ * @brief
+ * Clear the results for a device
+ *
+ * @param[in]		u8DeviceIndex			The device index
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.002.FUNC.001
+ */
+void vACCELBURST_MATH__Init(Luint8 u8DeviceIndex)
+{
+	Luint8 u8Axis;
+
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		for(u8Axis = 0U; u8Axis < 3U; u8Axis++)
+		{
+			sACCELBURST[u8DeviceIndex].sMath.f32GForce[u8Axis] = 0.0F;
+		}
+		sACCELBURST[u8DeviceIndex].sMath.f32Pitch = 0.0F;
+		sACCELBURST[u8DeviceIndex].sMath.f32Roll = 0.0F;
+	}
+	else
+	{
+		//index fault
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Work out G-Force, pitch and roll from the last CIC output
+ *
+ * @param[in]		u8DeviceIndex			The device index
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.002.FUNC.002
+ */
+void vACCELBURST_MATH__Update(Luint8 u8DeviceIndex)
+{
+	Luint8 u8Axis;
+	Lfloat32 f32G[3];
+	Lfloat32 f32Temp;
+
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		for(u8Axis = 0U; u8Axis < 3U; u8Axis++)
+		{
+			f32G[u8Axis] = (Lfloat32)s16ACCELBURST_FILT__Get_Decimated(u8DeviceIndex, u8Axis);
+			f32G[u8Axis] /= (Lfloat32)C_ACCELBURST__ONE_G;
+			sACCELBURST[u8DeviceIndex].sMath.f32GForce[u8Axis] = f32G[u8Axis];
+		}
+
+		//pitch against the whole of the YZ vector so it holds with roll
+		f32Temp = (f32G[C_ACCELBURST__AXIS_Y] * f32G[C_ACCELBURST__AXIS_Y]) + (f32G[C_ACCELBURST__AXIS_Z] * f32G[C_ACCELBURST__AXIS_Z]);
+		f32Temp = f32NUMERICAL_FLOAT__SQRT(f32Temp);
+		f32Temp = f32NUMERICAL_Atan2(f32G[C_ACCELBURST__AXIS_X], f32Temp);
+		sACCELBURST[u8DeviceIndex].sMath.f32Pitch = f32Temp * C_NUMERICAL__RADIANS_TO_DEGREES;
+
+		f32Temp = f32NUMERICAL_Atan2(f32G[C_ACCELBURST__AXIS_Y], f32G[C_ACCELBURST__AXIS_Z]);
+		sACCELBURST[u8DeviceIndex].sMath.f32Roll = f32Temp * C_NUMERICAL__RADIANS_TO_DEGREES;
+	}
+	else
+	{
+		//index fault
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * G-Force from the CIC output
+ *
+ * @param[in]		u8Axis					The axis, C_ACCELBURST__AXIS_x
+ * @param[in]		u8DeviceIndex			The device index
+ * @return			G-Force
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.002.FUNC.003
+ */
+Lfloat32 f32ACCELBURST_MATH__Get_GForce(Luint8 u8DeviceIndex, Luint8 u8Axis)
+{
+	Lfloat32 f32Return;
+
+	if((u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES) && (u8Axis < 3U))
+	{
+		f32Return = sACCELBURST[u8DeviceIndex].sMath.f32GForce[u8Axis];
+	}
+	else
+	{
+		f32Return = 0.0F;
+	}
+
+	return f32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Pitch, +ve nose up
+ *
+ * @param[in]		u8DeviceIndex			The device index
+ * @return			Pitch in degrees
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.002.FUNC.004
+ */
+Lfloat32 f32ACCELBURST_MATH__Get_PitchAngle(Luint8 u8DeviceIndex)
+{
+	Lfloat32 f32Return;
+
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		f32Return = sACCELBURST[u8DeviceIndex].sMath.f32Pitch;
+	}
+	else
+	{
+		f32Return = 0.0F;
+	}
+
+	return f32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Roll about X
+ *
+ * @param[in]		u8DeviceIndex			The device index
+ * @return			Roll in degrees
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.002.FUNC.005
+ */
+Lfloat32 f32ACCELBURST_MATH__Get_RollAngle(Luint8 u8DeviceIndex)
+{
+	Lfloat32 f32Return;
+
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		f32Return = sACCELBURST[u8DeviceIndex].sMath.f32Roll;
+	}
+	else
+	{
+		f32Return = 0.0F;
+	}
+
+	return f32Return;
+}
+
+#endif //#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
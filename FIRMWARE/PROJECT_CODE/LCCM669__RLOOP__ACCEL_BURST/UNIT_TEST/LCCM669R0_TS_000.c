@@ -0,0 +1,616 @@
+/**
+ * @file		LCCM669R0_TS_000.C
+ * @brief		Test spec for MMA8451 FIFO burst acquisition
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM669R0.FILE.005
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM669__ENABLE_TEST_SPEC == 1U
+
+//host side only
+#include <stdio.h>
+
+/** Timer ticks between samples */
+#define C_TS000__PERIOD							(C_LOCALDEF__LCCM669__TIMESTAMP_TICKS_PER_SEC / C_LOCALDEF__LCCM669__DATA_RATE_HZ)
+
+/** Data ready samples the mock driver averages for a zero */
+#define C_TS000__ZERO_SAMPLES					(16U)
+
+/** The acceleration the mock devices see, counts */
+#define C_TS000__TRUE_X							(200)
+#define C_TS000__TRUE_Y							(-100)
+#define C_TS000__TRUE_Z							(1000)
+
+void vLCCM669R0_TS_000_TCASE_001(void);
+void vLCCM669R0_TS_000_TCASE_002(void);
+void vLCCM669R0_TS_000_TCASE_003(void);
+static void vTS000__Reset(void);
+static void vTS000__Step(Luint32 u32Steps);
+static Lint16 s16TS000__Output(Luint8 u8DeviceIndex, Luint8 u8Axis);
+static Luint8 u8TS000__Near(Lfloat32 f32Value, Lfloat32 f32Expected, Lfloat32 f32Limit);
+
+extern struct _strACCELBURST sACCELBURST[];
+
+//mock devices, the registers we use plus the FIFO and the offsets
+static Luint8 u8TS000_Reg[C_LOCALDEF__LCCM669__NUM_DEVICES][0x40U];
+static Lint16 s16TS000_Fifo[C_LOCALDEF__LCCM669__NUM_DEVICES][C_ACCELBURST__FIFO_DEPTH][3U];
+static Luint8 u8TS000_FifoRead[C_LOCALDEF__LCCM669__NUM_DEVICES];
+static Luint8 u8TS000_FifoCount[C_LOCALDEF__LCCM669__NUM_DEVICES];
+static Luint8 u8TS000_FifoOverflow[C_LOCALDEF__LCCM669__NUM_DEVICES];
+static Lint16 s16TS000_True[C_LOCALDEF__LCCM669__NUM_DEVICES][3U];
+static Luint64 u64TS000_Time;
+static Luint8 u8TS000_Running;
+static Luint8 u8TS000_DropISR;
+static Luint32 u32TS000_I2CWrites;
+
+//mock driver
+static Luint8 u8TS000_DrvZeroing[C_LOCALDEF__LCCM669__NUM_DEVICES];
+static Luint8 u8TS000_DrvAxisMask[C_LOCALDEF__LCCM669__NUM_DEVICES];
+static Luint32 u32TS000_DrvSamples[C_LOCALDEF__LCCM669__NUM_DEVICES];
+static Lint32 s32TS000_DrvSum[C_LOCALDEF__LCCM669__NUM_DEVICES][3U];
+static Luint32 u32TS000_DrvISR;
+static Luint32 u32TS000_DrvProcess;
+static Luint32 u32TS000_FifoWhileZeroing;
+
+//Function to call the tests for this test specification
+void vLCCM669R0_TS_000(void)
+{
+	//Call the test cases
+	vLCCM669R0_TS_000_TCASE_001();
+	vLCCM669R0_TS_000_TCASE_002();
+	vLCCM669R0_TS_000_TCASE_003();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM669R0.TS.000.TCASE.001
+ * @st_test_desc
+ * Run both devices in burst mode. Every sample must reach the ring in order
+ * with the time it was taken, the FIFO must be read once per watermark, and
+ * the decimated G-Force, pitch and roll must match the device.
+ *
+*/
+void vLCCM669R0_TS_000_TCASE_001(void)
+{
+	char cText[160];
+	Luint8 u8Burst;
+	Luint32 u32Cursor;
+	Luint32 u32Count;
+	Luint32 u32Errors;
+	ACCELBURST__SAMPLE_T sSample;
+	Lfloat32 f32Pitch;
+	Lfloat32 f32Roll;
+
+	DEBUG_PRINT("START:LCCM669R0.TS.000.TCASE.001\r\n");
+
+	vTS000__Reset();
+	u32Cursor = u32ACCELBURST__Get_Head(0U);
+
+	//16 bursts, read after each
+	u32Count = 0U;
+	u32Errors = 0U;
+	for(u8Burst = 0U; u8Burst < 16U; u8Burst++)
+	{
+		vTS000__Step(C_LOCALDEF__LCCM669__FIFO_WATERMARK);
+		while(u8ACCELBURST__Get_Sample(0U, &u32Cursor, &sSample) == 1U)
+		{
+			//sample n was made at step n + 1
+			if((sSample.u64Timestamp != ((Luint64)(u32Count + 1U) * (Luint64)C_TS000__PERIOD)) ||
+				(sSample.s16Axis[0] != C_TS000__TRUE_X) || (sSample.s16Axis[1] != C_TS000__TRUE_Y) || (sSample.s16Axis[2] != C_TS000__TRUE_Z))
+			{
+				u32Errors++;
+			}
+			else
+			{
+				//fall on
+			}
+			u32Count++;
+		}
+	}
+
+	//atan2(200, |(-100, 1000)|) and atan2(-100, 1000)
+	f32Pitch = f32ACCELBURST_MATH__Get_PitchAngle(0U);
+	f32Roll = f32ACCELBURST_MATH__Get_RollAngle(0U);
+
+	sprintf(cText, "INFO: %u samples, %u errors, %u bursts, G %.3f %.3f %.3f, pitch %.2f roll %.2f\r\n", u32Count, u32Errors,
+			sACCELBURST[0].sStats.u32Bursts, (double)f32ACCELBURST_MATH__Get_GForce(0U, C_ACCELBURST__AXIS_X),
+			(double)f32ACCELBURST_MATH__Get_GForce(0U, C_ACCELBURST__AXIS_Y), (double)f32ACCELBURST_MATH__Get_GForce(0U, C_ACCELBURST__AXIS_Z),
+			(double)f32Pitch, (double)f32Roll);
+	DEBUG_PRINT(cText);
+
+	if((u32Count == (C_LOCALDEF__LCCM669__FIFO_WATERMARK * 16U)) && (u32Errors == 0U) &&
+		(sACCELBURST[0].sStats.u32Bursts == 16U) && (sACCELBURST[1].sStats.u32Bursts == 16U) &&
+		(u32ACCELBURST__Get_Head(1U) == (C_LOCALDEF__LCCM669__FIFO_WATERMARK * 16U)) &&
+		(s16ACCELBURST_FILT__Get_Average(0U, C_ACCELBURST__AXIS_Z) == C_TS000__TRUE_Z) &&
+		(s16ACCELBURST_FILT__Get_Decimated(0U, C_ACCELBURST__AXIS_Y) == C_TS000__TRUE_Y) &&
+		(u8TS000__Near(f32ACCELBURST_MATH__Get_GForce(0U, C_ACCELBURST__AXIS_Z), 1000.0F / 1024.0F, 0.001F) == 1U) &&
+		(u8TS000__Near(f32Pitch, 11.252F, 0.01F) == 1U) && (u8TS000__Near(f32Roll, -5.711F, 0.01F) == 1U) &&
+		(sACCELBURST[0].sStats.u32ConsumerLost == 0U) && (u32ACCELBURST__Get_FaultFlags(0U) == 0U) && (u32ACCELBURST__Get_FaultFlags(1U) == 0U))
+	{
+		DEBUG_PRINT("PASS:LCCM669R0.TS.000.TCASE.001\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM669R0.TS.000.TCASE.001\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM669R0.TS.000.TCASE.001\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM669R0.TS.000.TCASE.002
+ * @st_test_desc
+ * Auto zero while bursting. The device must go back to data ready with the
+ * interrupt on the same pin and the driver must get the ISR's and process
+ * calls until it is done. Burst mode must come back on its own and the burst
+ * data must then read 0G on X and Y and 1G on Z.
+ *
+*/
+void vLCCM669R0_TS_000_TCASE_002(void)
+{
+	char cText[160];
+	Luint8 u8DuringZero;
+	Luint8 u8AfterZero;
+	Luint32 u32Head;
+
+	DEBUG_PRINT("START:LCCM669R0.TS.000.TCASE.002\r\n");
+
+	vTS000__Reset();
+	vTS000__Step(C_LOCALDEF__LCCM669__FIFO_WATERMARK * 4U);
+
+	vACCELBURST_ZERO__AutoZero(0U);
+	vTS000__Step(4U);
+
+	//FIFO off, data ready on INT1 where the FIFO was
+	u8DuringZero = 0U;
+	if((u8ACCELBURST_ZERO__Get_IsCalibrating(0U) == 1U) && (u8TS000_Reg[0][C_ACCELBURST__REG__F_SETUP] == 0U) &&
+		(u8TS000_Reg[0][C_ACCELBURST__REG__CTRL_REG4] == C_ACCELBURST__CTRL_INT__DRDY) &&
+		(u8TS000_Reg[0][C_ACCELBURST__REG__CTRL_REG5] == C_ACCELBURST__CTRL_INT__DRDY) &&
+		(u8TS000_Reg[1][C_ACCELBURST__REG__F_SETUP] != 0U))
+	{
+		u8DuringZero = 1U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//the zero and the hold, then two CIC outputs of fresh data
+	vTS000__Step(C_TS000__ZERO_SAMPLES + C_LOCALDEF__LCCM669__FIFO_WATERMARK * 2U);
+	u32Head = u32ACCELBURST__Get_Head(0U);
+	vTS000__Step(C_LOCALDEF__LCCM669__FIFO_WATERMARK * 2U);
+
+	u8AfterZero = 0U;
+	if((u8ACCELBURST_ZERO__Get_IsCalibrating(0U) == 0U) &&
+		(u8TS000_Reg[0][C_ACCELBURST__REG__F_SETUP] == (C_ACCELBURST__F_SETUP__MODE_CIRCULAR | C_LOCALDEF__LCCM669__FIFO_WATERMARK)) &&
+		(u8TS000_Reg[0][C_ACCELBURST__REG__CTRL_REG4] == C_ACCELBURST__CTRL_INT__FIFO) &&
+		(u8TS000_Reg[0][C_ACCELBURST__REG__CTRL_REG5] == C_ACCELBURST__CTRL_INT__FIFO) &&
+		(u32ACCELBURST__Get_Head(0U) == (u32Head + (C_LOCALDEF__LCCM669__FIFO_WATERMARK * 2U))))
+	{
+		u8AfterZero = 1U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	sprintf(cText, "INFO: during %u after %u, driver ISR %u process %u, FIFO reads while zeroing %u, decimated %d %d %d, G %.3f %.3f %.3f\r\n",
+			u8DuringZero, u8AfterZero, u32TS000_DrvISR, u32TS000_DrvProcess, u32TS000_FifoWhileZeroing,
+			s16ACCELBURST_FILT__Get_Decimated(0U, C_ACCELBURST__AXIS_X), s16ACCELBURST_FILT__Get_Decimated(0U, C_ACCELBURST__AXIS_Y),
+			s16ACCELBURST_FILT__Get_Decimated(0U, C_ACCELBURST__AXIS_Z),
+			(double)f32ACCELBURST_MATH__Get_GForce(0U, C_ACCELBURST__AXIS_X), (double)f32ACCELBURST_MATH__Get_GForce(0U, C_ACCELBURST__AXIS_Y),
+			(double)f32ACCELBURST_MATH__Get_GForce(0U, C_ACCELBURST__AXIS_Z));
+	DEBUG_PRINT(cText);
+
+	if((u8DuringZero == 1U) && (u8AfterZero == 1U) &&
+		(u32TS000_DrvISR >= C_TS000__ZERO_SAMPLES) && (u32TS000_DrvProcess > 0U) && (u32TS000_FifoWhileZeroing == 0U) &&
+		(s16ACCELBURST_FILT__Get_Decimated(0U, C_ACCELBURST__AXIS_X) == 0) &&
+		(s16ACCELBURST_FILT__Get_Decimated(0U, C_ACCELBURST__AXIS_Y) == 0) &&
+		(s16ACCELBURST_FILT__Get_Decimated(0U, C_ACCELBURST__AXIS_Z) == C_ACCELBURST__ONE_G) &&
+		(u8TS000__Near(f32ACCELBURST_MATH__Get_PitchAngle(0U), 0.0F, 0.01F) == 1U) &&
+		(u8TS000__Near(f32ACCELBURST_MATH__Get_RollAngle(0U), 0.0F, 0.01F) == 1U) &&
+		(sACCELBURST[1].sZero.u32Count == 0U) && (u32ACCELBURST__Get_FaultFlags(0U) == 0U))
+	{
+		DEBUG_PRINT("PASS:LCCM669R0.TS.000.TCASE.002\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM669R0.TS.000.TCASE.002\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM669R0.TS.000.TCASE.002\r\n");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM669R0.TS.000.TCASE.003
+ * @st_test_desc
+ * Fine zero one axis on device 1, only that axis may move. Then lose the
+ * watermark interrupts, the FIFO must be found by polling and stamped from
+ * the poll, and once the device stops the device stopped fault is raised.
+ *
+*/
+void vLCCM669R0_TS_000_TCASE_003(void)
+{
+	char cText[160];
+	Luint8 u8Zero;
+	Luint8 u8Recovered;
+	Luint32 u32Cursor;
+	ACCELBURST__SAMPLE_T sSample;
+
+	DEBUG_PRINT("START:LCCM669R0.TS.000.TCASE.003\r\n");
+
+	vTS000__Reset();
+	vTS000__Step(C_LOCALDEF__LCCM669__FIFO_WATERMARK);
+
+	vACCELBURST_ZERO__Set_FineZero(1U, C_ACCELBURST__AXIS_X);
+	vTS000__Step(C_TS000__ZERO_SAMPLES + C_LOCALDEF__LCCM669__FIFO_WATERMARK * 4U);
+
+	u8Zero = 0U;
+	if((u8ACCELBURST_ZERO__Get_IsCalibrating(1U) == 0U) &&
+		(s16ACCELBURST_FILT__Get_Decimated(1U, C_ACCELBURST__AXIS_X) == 0) &&
+		(s16ACCELBURST_FILT__Get_Decimated(1U, C_ACCELBURST__AXIS_Y) == C_TS000__TRUE_Y) &&
+		(s16ACCELBURST_FILT__Get_Decimated(1U, C_ACCELBURST__AXIS_Z) == C_TS000__TRUE_Z))
+	{
+		u8Zero = 1U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//no more watermark edges, the poll takes over
+	u8TS000_DropISR = 1U;
+	u32Cursor = u32ACCELBURST__Get_Head(0U);
+	vTS000__Step(C_LOCALDEF__LCCM669__MAX_INTERRUPT_LOST_COUNT);
+
+	//stamped back from the poll, which is the newest sample
+	u8Recovered = 0U;
+	if((sACCELBURST[0].sStats.u32Recovered == 1U) &&
+		(u32ACCELBURST__Get_Head(0U) == (u32Cursor + C_LOCALDEF__LCCM669__MAX_INTERRUPT_LOST_COUNT)))
+	{
+		u8Recovered = 1U;
+		while(u8ACCELBURST__Get_Sample(0U, &u32Cursor, &sSample) == 1U)
+		{
+			//fall on to the last
+		}
+		if(sSample.u64Timestamp != u64TS000_Time)
+		{
+			u8Recovered = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	else
+	{
+		//fall on
+	}
+
+	//the device stops, the next poll finds nothing
+	u8TS000_Running = 0U;
+	vTS000__Step(C_LOCALDEF__LCCM669__MAX_INTERRUPT_LOST_COUNT);
+
+	sprintf(cText, "INFO: fine zero %u, X %d, recovered %u, faults 0x%08X\r\n", u8Zero, s16ACCELBURST_FILT__Get_Decimated(1U, C_ACCELBURST__AXIS_X),
+			u8Recovered, u32ACCELBURST__Get_FaultFlags(0U));
+	DEBUG_PRINT(cText);
+
+	if((u8Zero == 1U) && (u8Recovered == 1U) && (u32TS000_FifoWhileZeroing == 0U) &&
+		(u32ACCELBURST__Get_FaultFlags(0U) == (C_LCCM669__CORE__FAULT_INDEX_MASK__00 | C_LCCM669__CORE__FAULT_INDEX_MASK__04)))
+	{
+		DEBUG_PRINT("PASS:LCCM669R0.TS.000.TCASE.003\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM669R0.TS.000.TCASE.003\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM669R0.TS.000.TCASE.003\r\n");
+}
+
+//power on both devices as the driver would leave them, data ready on INT1, then burst mode
+static void vTS000__Reset(void)
+{
+	Luint8 u8Device;
+	Luint8 u8Counter;
+
+	u64TS000_Time = 0U;
+	u8TS000_Running = 1U;
+	u8TS000_DropISR = 0U;
+	u32TS000_I2CWrites = 0U;
+	u32TS000_DrvISR = 0U;
+	u32TS000_DrvProcess = 0U;
+	u32TS000_FifoWhileZeroing = 0U;
+
+	for(u8Device = 0U; u8Device < C_LOCALDEF__LCCM669__NUM_DEVICES; u8Device++)
+	{
+		for(u8Counter = 0U; u8Counter < 0x40U; u8Counter++)
+		{
+			u8TS000_Reg[u8Device][u8Counter] = 0U;
+		}
+		u8TS000_Reg[u8Device][C_ACCELBURST__REG__CTRL_REG1] = C_ACCELBURST__CTRL_REG1__ACTIVE;
+		u8TS000_Reg[u8Device][C_ACCELBURST__REG__CTRL_REG4] = C_ACCELBURST__CTRL_INT__DRDY;
+		u8TS000_Reg[u8Device][C_ACCELBURST__REG__CTRL_REG5] = C_ACCELBURST__CTRL_INT__DRDY;
+		u8TS000_FifoRead[u8Device] = 0U;
+		u8TS000_FifoCount[u8Device] = 0U;
+		u8TS000_FifoOverflow[u8Device] = 0U;
+		s16TS000_True[u8Device][0] = C_TS000__TRUE_X;
+		s16TS000_True[u8Device][1] = C_TS000__TRUE_Y;
+		s16TS000_True[u8Device][2] = C_TS000__TRUE_Z;
+		u8TS000_DrvZeroing[u8Device] = 0U;
+
+		vACCELBURST__Init(u8Device);
+	}
+}
+
+//one step is one sample period on both devices, then a main loop
+static void vTS000__Step(Luint32 u32Steps)
+{
+	Luint32 u32Step;
+	Luint8 u8Device;
+	Luint8 u8Axis;
+	Luint8 u8Pos;
+	Luint8 u8FifoOn;
+
+	for(u32Step = 0U; u32Step < u32Steps; u32Step++)
+	{
+		u64TS000_Time += C_TS000__PERIOD;
+
+		for(u8Device = 0U; u8Device < C_LOCALDEF__LCCM669__NUM_DEVICES; u8Device++)
+		{
+			u8FifoOn = 0U;
+			if((u8TS000_Reg[u8Device][C_ACCELBURST__REG__F_SETUP] & 0xC0U) != 0U)
+			{
+				u8FifoOn = 1U;
+			}
+			else
+			{
+				//fall on
+			}
+
+			if((u8TS000_Running == 1U) && ((u8TS000_Reg[u8Device][C_ACCELBURST__REG__CTRL_REG1] & C_ACCELBURST__CTRL_REG1__ACTIVE) != 0U))
+			{
+				if(u8FifoOn == 1U)
+				{
+					//circular, the oldest goes
+					if(u8TS000_FifoCount[u8Device] == C_ACCELBURST__FIFO_DEPTH)
+					{
+						u8TS000_FifoRead[u8Device] = (Luint8)((u8TS000_FifoRead[u8Device] + 1U) % C_ACCELBURST__FIFO_DEPTH);
+						u8TS000_FifoCount[u8Device]--;
+						u8TS000_FifoOverflow[u8Device] = 1U;
+					}
+					else
+					{
+						//fall on
+					}
+					u8Pos = (Luint8)((u8TS000_FifoRead[u8Device] + u8TS000_FifoCount[u8Device]) % C_ACCELBURST__FIFO_DEPTH);
+					for(u8Axis = 0U; u8Axis < 3U; u8Axis++)
+					{
+						s16TS000_Fifo[u8Device][u8Pos][u8Axis] = s16TS000__Output(u8Device, u8Axis);
+					}
+					u8TS000_FifoCount[u8Device]++;
+
+					if((u8TS000_FifoCount[u8Device] == C_LOCALDEF__LCCM669__FIFO_WATERMARK) &&
+						((u8TS000_Reg[u8Device][C_ACCELBURST__REG__CTRL_REG4] & C_ACCELBURST__CTRL_INT__FIFO) != 0U) && (u8TS000_DropISR == 0U))
+					{
+						vACCELBURST__ISR(u8Device);
+					}
+					else
+					{
+						//fall on
+					}
+				}
+				else if((u8TS000_Reg[u8Device][C_ACCELBURST__REG__CTRL_REG4] & C_ACCELBURST__CTRL_INT__DRDY) != 0U)
+				{
+					vACCELBURST__ISR(u8Device);
+				}
+				else
+				{
+					//no interrupt
+				}
+			}
+			else
+			{
+				//stopped
+			}
+
+			vACCELBURST__Process(u8Device);
+		}
+	}
+}
+
+//what the device outputs on an axis, the offset registers are 2 counts per LSB
+static Lint16 s16TS000__Output(Luint8 u8DeviceIndex, Luint8 u8Axis)
+{
+	return (Lint16)(s16TS000_True[u8DeviceIndex][u8Axis] + ((Lint16)((Lint8)u8TS000_Reg[u8DeviceIndex][0x2FU + u8Axis]) * 2));
+}
+
+static Luint8 u8TS000__Near(Lfloat32 f32Value, Lfloat32 f32Expected, Lfloat32 f32Limit)
+{
+	Luint8 u8Return;
+
+	if(((f32Value - f32Expected) < f32Limit) && ((f32Expected - f32Value) < f32Limit))
+	{
+		u8Return = 1U;
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+Lint16 s16LCCM669R0_TS_000__ReadByte(Luint8 u8DeviceIndex, Luint8 u8Register, Luint8 *pu8Value)
+{
+	if(u8Register == C_ACCELBURST__REG__STATUS)
+	{
+		*pu8Value = u8TS000_FifoCount[u8DeviceIndex];
+		if(u8TS000_FifoOverflow[u8DeviceIndex] == 1U)
+		{
+			*pu8Value |= C_ACCELBURST__F_STATUS__OVF;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	else
+	{
+		*pu8Value = u8TS000_Reg[u8DeviceIndex][u8Register & 0x3FU];
+	}
+	return 0;
+}
+
+Lint16 s16LCCM669R0_TS_000__ReadMultiple(Luint8 u8DeviceIndex, Luint8 u8Register, Luint8 *pu8Array, Luint8 u8Length)
+{
+	Lint16 s16Return;
+	Luint8 u8Counter;
+	Luint8 u8Axis;
+	Luint16 u16Raw;
+
+	if((u8Register != C_ACCELBURST__REG__OUT_X_MSB) || ((u8Length % 6U) != 0U) || ((u8Length / 6U) > u8TS000_FifoCount[u8DeviceIndex]) ||
+		(u8ACCELBURST_ZERO__Get_IsCalibrating(u8DeviceIndex) == 1U))
+	{
+		u32TS000_FifoWhileZeroing++;
+		s16Return = -1;
+	}
+	else
+	{
+		for(u8Counter = 0U; u8Counter < (u8Length / 6U); u8Counter++)
+		{
+			for(u8Axis = 0U; u8Axis < 3U; u8Axis++)
+			{
+				//14 bit left justified
+				u16Raw = (Luint16)((Lint16)(s16TS000_Fifo[u8DeviceIndex][u8TS000_FifoRead[u8DeviceIndex]][u8Axis] * 4));
+				pu8Array[0] = (Luint8)(u16Raw >> 8U);
+				pu8Array[1] = (Luint8)(u16Raw & 0xFFU);
+				pu8Array += 2U;
+			}
+			u8TS000_FifoRead[u8DeviceIndex] = (Luint8)((u8TS000_FifoRead[u8DeviceIndex] + 1U) % C_ACCELBURST__FIFO_DEPTH);
+			u8TS000_FifoCount[u8DeviceIndex]--;
+		}
+		u8TS000_FifoOverflow[u8DeviceIndex] = 0U;
+		s16Return = 0;
+	}
+	return s16Return;
+}
+
+Lint16 s16LCCM669R0_TS_000__WriteByte(Luint8 u8DeviceIndex, Luint8 u8Register, Luint8 u8Value)
+{
+	u32TS000_I2CWrites++;
+	u8TS000_Reg[u8DeviceIndex][u8Register & 0x3FU] = u8Value;
+	if(u8Register == C_ACCELBURST__REG__F_SETUP)
+	{
+		//a new FIFO mode empties it
+		u8TS000_FifoRead[u8DeviceIndex] = 0U;
+		u8TS000_FifoCount[u8DeviceIndex] = 0U;
+		u8TS000_FifoOverflow[u8DeviceIndex] = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+	return 0;
+}
+
+Luint64 u64LCCM669R0_TS_000__Get_Time(void)
+{
+	return u64TS000_Time;
+}
+
+//the driver process, work out the offsets once it has enough samples
+void vLCCM669R0_TS_000__Driver_Process(Luint8 u8DeviceIndex)
+{
+	Luint8 u8Axis;
+	Lint32 s32Target;
+	Lint32 s32Offset;
+
+	u32TS000_DrvProcess++;
+	if((u8TS000_DrvZeroing[u8DeviceIndex] == 1U) && (u32TS000_DrvSamples[u8DeviceIndex] >= C_TS000__ZERO_SAMPLES))
+	{
+		for(u8Axis = 0U; u8Axis < 3U; u8Axis++)
+		{
+			if((u8TS000_DrvAxisMask[u8DeviceIndex] & (1U << u8Axis)) != 0U)
+			{
+				if(u8Axis == C_ACCELBURST__AXIS_Z)
+				{
+					s32Target = C_ACCELBURST__ONE_G;
+				}
+				else
+				{
+					s32Target = 0;
+				}
+				s32Offset = (Lint32)((Lint8)u8TS000_Reg[u8DeviceIndex][0x2FU + u8Axis]);
+				s32Offset += (s32Target - (s32TS000_DrvSum[u8DeviceIndex][u8Axis] / (Lint32)u32TS000_DrvSamples[u8DeviceIndex])) / 2;
+				u8TS000_Reg[u8DeviceIndex][0x2FU + u8Axis] = (Luint8)((Lint8)s32Offset);
+			}
+			else
+			{
+				//not this axis
+			}
+		}
+		u8TS000_DrvZeroing[u8DeviceIndex] = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+}
+
+//the driver data ready ISR, it reads the data registers
+void vLCCM669R0_TS_000__Driver_ISR(Luint8 u8DeviceIndex)
+{
+	Luint8 u8Axis;
+
+	u32TS000_DrvISR++;
+	if(u8TS000_DrvZeroing[u8DeviceIndex] == 1U)
+	{
+		for(u8Axis = 0U; u8Axis < 3U; u8Axis++)
+		{
+			s32TS000_DrvSum[u8DeviceIndex][u8Axis] += (Lint32)s16TS000__Output(u8DeviceIndex, u8Axis);
+		}
+		u32TS000_DrvSamples[u8DeviceIndex]++;
+	}
+	else
+	{
+		//fall on
+	}
+}
+
+void vLCCM669R0_TS_000__Driver_AutoZero(Luint8 u8DeviceIndex)
+{
+	vLCCM669R0_TS_000__Driver_FineZero(u8DeviceIndex, C_ACCELBURST__AXIS_X);
+	u8TS000_DrvAxisMask[u8DeviceIndex] = 0x07U;
+}
+
+void vLCCM669R0_TS_000__Driver_FineZero(Luint8 u8DeviceIndex, Luint8 u8Axis)
+{
+	Luint8 u8Counter;
+
+	for(u8Counter = 0U; u8Counter < 3U; u8Counter++)
+	{
+		s32TS000_DrvSum[u8DeviceIndex][u8Counter] = 0;
+	}
+	u32TS000_DrvSamples[u8DeviceIndex] = 0U;
+	u8TS000_DrvAxisMask[u8DeviceIndex] = (Luint8)(1U << u8Axis);
+	u8TS000_DrvZeroing[u8DeviceIndex] = 1U;
+}
+
+Luint8 u8LCCM669R0_TS_000__Driver_IsCalibrating(Luint8 u8DeviceIndex)
+{
+	return u8TS000_DrvZeroing[u8DeviceIndex];
+}
+
+#endif //#if C_LOCALDEF__LCCM669__ENABLE_TEST_SPEC == 1U
+#endif //#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
@@ -0,0 +1,236 @@
+/**
+ * @file		ACCEL_BURST__ZERO.C
+ * @brief		Hand the device to the MMA8451 driver to zero it
+ *
+ * @note
+ * The driver zeros and calibrates against data ready samples and writes the
+ * result into the device offset registers. The offset registers apply to the
+ * FIFO data as well, so the burst stream only needs the device for as long
+ * as the driver is working:
+ * 		FIFO off, data ready back on the same pin, the ISR goes to the driver.
+ * 		The driver runs from vACCELBURST__Process() until it is done.
+ * 		After CAL_HOLD_MS the FIFO goes back on and the filters restart so
+ * 		nothing from before the zero is averaged in.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM669R0.FILE.003
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup ACCELBURST
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup ACCELBURST__ZERO
+ * @ingroup ACCELBURST
+ * @{ */
+
+#include "../accel_burst.h"
+#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+
+extern struct _strACCELBURST sACCELBURST[];
+
+//locals
+static Lint16 s16ACCELBURST_ZERO__Handover(Luint8 u8DeviceIndex);
+
+
+/***************************************************************************//**
+ * @brief
+ * Zero all axis, X and Y to 0G and Z to 1G
+ *
+ * @param[in]		u8DeviceIndex			The device index
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.003.FUNC.001
+ */
+void vACCELBURST_ZERO__AutoZero(Luint8 u8DeviceIndex)
+{
+	Lint16 s16Return;
+
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		s16Return = s16ACCELBURST_ZERO__Handover(u8DeviceIndex);
+		if(s16Return >= 0)
+		{
+			M_LOCALDEF__LCCM669__DRIVER_AUTOZERO(u8DeviceIndex);
+		}
+		else
+		{
+			//handover has flagged it
+		}
+	}
+	else
+	{
+		//index fault
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Fine zero one axis
+ *
+ * @param[in]		u8Axis					The axis, C_ACCELBURST__AXIS_x
+ * @param[in]		u8DeviceIndex			The device index
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.003.FUNC.002
+ */
+void vACCELBURST_ZERO__Set_FineZero(Luint8 u8DeviceIndex, Luint8 u8Axis)
+{
+	Lint16 s16Return;
+
+	if((u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES) && (u8Axis < 3U))
+	{
+		s16Return = s16ACCELBURST_ZERO__Handover(u8DeviceIndex);
+		if(s16Return >= 0)
+		{
+			M_LOCALDEF__LCCM669__DRIVER_FINEZERO(u8DeviceIndex, u8Axis);
+		}
+		else
+		{
+			//handover has flagged it
+		}
+	}
+	else
+	{
+		//index or axis fault
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Run the driver while it has the device, take it back once the zero is done
+ *
+ * @param[in]		u8DeviceIndex			The device index
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.003.FUNC.003
+ */
+void vACCELBURST_ZERO__Process(Luint8 u8DeviceIndex)
+{
+	Lint16 s16Return;
+	Luint64 u64Elapsed;
+
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		M_LOCALDEF__LCCM669__DRIVER_PROCESS(u8DeviceIndex);
+
+		u64Elapsed = M_LOCALDEF__LCCM669__GET_TIMESTAMP() - sACCELBURST[u8DeviceIndex].sZero.u64Start;
+		if(M_LOCALDEF__LCCM669__DRIVER_CALIBRATING(u8DeviceIndex) == 1U)
+		{
+			//still going
+		}
+		else if(u64Elapsed < (((Luint64)C_LOCALDEF__LCCM669__TIMESTAMP_TICKS_PER_SEC * (Luint64)C_LOCALDEF__LCCM669__CAL_HOLD_MS) / 1000U))
+		{
+			//give the driver time to start before believing it is done
+		}
+		else
+		{
+			s16Return = s16ACCELBURST__Configure(u8DeviceIndex, 1U);
+			if(s16Return >= 0)
+			{
+				//nothing from before the zero
+				vACCELBURST_FILT__Init(u8DeviceIndex);
+				vACCELBURST_MATH__Init(u8DeviceIndex);
+				sACCELBURST[u8DeviceIndex].u8Watermark = 0U;
+				sACCELBURST[u8DeviceIndex].u32LoopCount = 0U;
+			}
+			else
+			{
+				vFAULTTREE__Set_Flag(&sACCELBURST[u8DeviceIndex].sFaultFlags, C_LCCM669__CORE__FAULT_INDEX__00);
+				vFAULTTREE__Set_Flag(&sACCELBURST[u8DeviceIndex].sFaultFlags, C_LCCM669__CORE__FAULT_INDEX__02);
+			}
+
+			//a failed swap leaves burst mode faulted, not the driver running
+			sACCELBURST[u8DeviceIndex].eMode = ACCELBURST_MODE__BURST;
+		}
+	}
+	else
+	{
+		//index fault
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Is the driver zeroing the device
+ *
+ * @param[in]		u8DeviceIndex			The device index
+ * @return			1 = zeroing, no burst data\n
+ *					0 = burst mode
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.003.FUNC.004
+ */
+Luint8 u8ACCELBURST_ZERO__Get_IsCalibrating(Luint8 u8DeviceIndex)
+{
+	Luint8 u8Return;
+
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		if(sACCELBURST[u8DeviceIndex].eMode == ACCELBURST_MODE__CALIBRATE)
+		{
+			u8Return = 1U;
+		}
+		else
+		{
+			u8Return = 0U;
+		}
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Put the device back to data ready and give it to the driver
+ *
+ * @param[in]		u8DeviceIndex			The device index
+ * @return			0 = the driver has the device\n
+ *					-ve = I2C error, burst mode faulted
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.003.FUNC.005
+ */
+static Lint16 s16ACCELBURST_ZERO__Handover(Luint8 u8DeviceIndex)
+{
+	Lint16 s16Return;
+
+	if(sACCELBURST[u8DeviceIndex].eMode == ACCELBURST_MODE__CALIBRATE)
+	{
+		//already with the driver, restart the hold
+		s16Return = 0;
+	}
+	else
+	{
+		s16Return = s16ACCELBURST__Configure(u8DeviceIndex, 0U);
+	}
+
+	if(s16Return >= 0)
+	{
+		sACCELBURST[u8DeviceIndex].eMode = ACCELBURST_MODE__CALIBRATE;
+		sACCELBURST[u8DeviceIndex].sZero.u64Start = M_LOCALDEF__LCCM669__GET_TIMESTAMP();
+		sACCELBURST[u8DeviceIndex].sZero.u32Count++;
+	}
+	else
+	{
+		vFAULTTREE__Set_Flag(&sACCELBURST[u8DeviceIndex].sFaultFlags, C_LCCM669__CORE__FAULT_INDEX__00);
+		vFAULTTREE__Set_Flag(&sACCELBURST[u8DeviceIndex].sFaultFlags, C_LCCM669__CORE__FAULT_INDEX__02);
+	}
+
+	return s16Return;
+}
+
+#endif //#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
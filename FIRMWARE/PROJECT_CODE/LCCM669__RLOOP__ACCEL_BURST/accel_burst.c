@@ -0,0 +1,604 @@
+/**
+ * @file		ACCEL_BURST.C
+ * @brief		MMA8451 FIFO burst acquisition
+ *
+ * @note
+ * In burst mode the device buffers up to 32 samples itself. The watermark ISR
+ * only stamps the time, the main loop then reads F_STATUS for the count and
+ * pulls every waiting sample in one I2C transaction. With F_READ clear the
+ * register pointer wraps from OUT_Z_LSB back to OUT_X_MSB so a single read
+ * of 6 x count bytes from OUT_X_MSB walks the FIFO oldest first.
+ *
+ * The MMA8451 driver still owns the device setup, zeroing and calibration.
+ * When a zero is asked for the device is put back to data ready and handed
+ * to the driver until it is done, see accel_burst__zero.c
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM669R0.FILE.000
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup ACCELBURST
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup ACCELBURST__CORE
+ * @ingroup ACCELBURST
+ * @{ */
+
+#include "accel_burst.h"
+#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+
+//the burst structures
+struct _strACCELBURST sACCELBURST[C_LOCALDEF__LCCM669__NUM_DEVICES];
+
+//locals
+static Lint16 s16ACCELBURST__Drain(Luint8 u8DeviceIndex, Luint8 u8Anchored, Luint64 u64Time);
+
+
+/***************************************************************************//**
+ * @brief
+ * Switch a device over to FIFO burst mode
+ *
+ * @note
+ * Call after the MMA8451 driver init has set the range, ODR and offsets.
+ *
+ * @param[in]		u8DeviceIndex			The device index
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.000.FUNC.001
+ */
+void vACCELBURST__Init(Luint8 u8DeviceIndex)
+{
+	Lint16 s16Return;
+
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		vFAULTTREE__Init(&sACCELBURST[u8DeviceIndex].sFaultFlags);
+		sACCELBURST[u8DeviceIndex].eMode = ACCELBURST_MODE__BURST;
+		sACCELBURST[u8DeviceIndex].u8Watermark = 0U;
+		sACCELBURST[u8DeviceIndex].u64WatermarkTime = 0U;
+		sACCELBURST[u8DeviceIndex].u32LoopCount = 0U;
+		sACCELBURST[u8DeviceIndex].u32PeriodTicks = C_LOCALDEF__LCCM669__TIMESTAMP_TICKS_PER_SEC / C_LOCALDEF__LCCM669__DATA_RATE_HZ;
+		sACCELBURST[u8DeviceIndex].sRing.u32Head = 0U;
+		sACCELBURST[u8DeviceIndex].sZero.u64Start = 0U;
+		sACCELBURST[u8DeviceIndex].sZero.u32Count = 0U;
+		sACCELBURST[u8DeviceIndex].sStats.u32Bursts = 0U;
+		sACCELBURST[u8DeviceIndex].sStats.u32Overflows = 0U;
+		sACCELBURST[u8DeviceIndex].sStats.u32Recovered = 0U;
+		sACCELBURST[u8DeviceIndex].sStats.u32ConsumerLost = 0U;
+		sACCELBURST[u8DeviceIndex].sStats.u8MaxCount = 0U;
+
+		vACCELBURST_FILT__Init(u8DeviceIndex);
+		vACCELBURST_MATH__Init(u8DeviceIndex);
+
+		s16Return = s16ACCELBURST__Configure(u8DeviceIndex, 1U);
+		if(s16Return < 0)
+		{
+			//device did not take the config
+			vFAULTTREE__Set_Flag(&sACCELBURST[u8DeviceIndex].sFaultFlags, C_LCCM669__CORE__FAULT_INDEX__00);
+			vFAULTTREE__Set_Flag(&sACCELBURST[u8DeviceIndex].sFaultFlags, C_LCCM669__CORE__FAULT_INDEX__02);
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	else
+	{
+		//index fault, no structure to flag it in
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Drain the FIFO once the watermark ISR has fired.
+ * Call as fast as possible from the main loop.
+ *
+ * @note
+ * The GIO interrupt is edge triggered, if an edge is ever missed the level
+ * stays asserted and no more edges come. After MAX_INTERRUPT_LOST_COUNT loops
+ * with no ISR the FIFO is polled, if it is empty as well the device has
+ * stopped sampling and the device stopped fault is raised.
+ *
+ * While the driver has the device for a zero this runs the driver instead.
+ *
+ * @param[in]		u8DeviceIndex			The device index
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.000.FUNC.002
+ */
+void vACCELBURST__Process(Luint8 u8DeviceIndex)
+{
+	Lint16 s16Return;
+
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		if(sACCELBURST[u8DeviceIndex].eMode == ACCELBURST_MODE__CALIBRATE)
+		{
+			//the driver has the device until the zero is done
+			vACCELBURST_ZERO__Process(u8DeviceIndex);
+		}
+		else if(sACCELBURST[u8DeviceIndex].sFaultFlags.u8FaultFlag == 0U)
+		{
+			if(sACCELBURST[u8DeviceIndex].u8Watermark == 1U)
+			{
+				sACCELBURST[u8DeviceIndex].u8Watermark = 0U;
+				sACCELBURST[u8DeviceIndex].u32LoopCount = 0U;
+
+				//the ISR stamped the watermark sample
+				s16Return = s16ACCELBURST__Drain(u8DeviceIndex, 1U, sACCELBURST[u8DeviceIndex].u64WatermarkTime);
+			}
+			else
+			{
+				sACCELBURST[u8DeviceIndex].u32LoopCount++;
+				if(sACCELBURST[u8DeviceIndex].u32LoopCount >= C_LOCALDEF__LCCM669__MAX_INTERRUPT_LOST_COUNT)
+				{
+					sACCELBURST[u8DeviceIndex].u32LoopCount = 0U;
+
+					//no stamp from the ISR, the newest sample is now
+					s16Return = s16ACCELBURST__Drain(u8DeviceIndex, 0U, M_LOCALDEF__LCCM669__GET_TIMESTAMP());
+					if(s16Return > 0)
+					{
+						sACCELBURST[u8DeviceIndex].sStats.u32Recovered++;
+					}
+					else if(s16Return == 0)
+					{
+						vFAULTTREE__Set_Flag(&sACCELBURST[u8DeviceIndex].sFaultFlags, C_LCCM669__CORE__FAULT_INDEX__00);
+						vFAULTTREE__Set_Flag(&sACCELBURST[u8DeviceIndex].sFaultFlags, C_LCCM669__CORE__FAULT_INDEX__04);
+					}
+					else
+					{
+						//drain has flagged it
+					}
+				}
+				else
+				{
+					//keep waiting
+				}
+			}
+		}
+		else
+		{
+			//faulted, leave the device alone
+		}
+	}
+	else
+	{
+		//index fault
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Device interrupt, call from the GIO ISR for the device.
+ * FIFO watermark in burst mode, data ready to the driver while it has the device.
+ *
+ * @param[in]		u8DeviceIndex			The device index
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.000.FUNC.003
+ */
+void vACCELBURST__ISR(Luint8 u8DeviceIndex)
+{
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		if(sACCELBURST[u8DeviceIndex].eMode == ACCELBURST_MODE__CALIBRATE)
+		{
+			M_LOCALDEF__LCCM669__DRIVER_ISR(u8DeviceIndex);
+		}
+		else
+		{
+			sACCELBURST[u8DeviceIndex].u64WatermarkTime = M_LOCALDEF__LCCM669__GET_TIMESTAMP();
+			sACCELBURST[u8DeviceIndex].u8Watermark = 1U;
+		}
+	}
+	else
+	{
+		//index fault
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Put the device in FIFO burst mode or back to data ready for the driver
+ *
+ * @note
+ * F_SETUP and the interrupt registers can only be changed in standby. The
+ * interrupt being enabled goes on the same pin as the one it replaces.
+ *
+ * @param[in]		u8Burst					1 = FIFO on, watermark interrupt\n
+ *											0 = FIFO off, data ready interrupt
+ * @param[in]		u8DeviceIndex			The device index
+ * @return			0 = success\n
+ *					-ve = I2C error
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.000.FUNC.004
+ */
+Lint16 s16ACCELBURST__Configure(Luint8 u8DeviceIndex, Luint8 u8Burst)
+{
+	Lint16 s16Return;
+	Luint8 u8Ctrl1;
+	Luint8 u8Temp;
+	Luint8 u8On;
+	Luint8 u8Off;
+
+	if(u8Burst == 1U)
+	{
+		u8On = C_ACCELBURST__CTRL_INT__FIFO;
+		u8Off = C_ACCELBURST__CTRL_INT__DRDY;
+	}
+	else
+	{
+		u8On = C_ACCELBURST__CTRL_INT__DRDY;
+		u8Off = C_ACCELBURST__CTRL_INT__FIFO;
+	}
+
+	//standby
+	u8Ctrl1 = 0U;
+	s16Return = M_LOCALDEF__LCCM669__READ_BYTE(u8DeviceIndex, C_ACCELBURST__REG__CTRL_REG1, &u8Ctrl1);
+	if(s16Return >= 0)
+	{
+		//fast read would drop the LSB's out of the FIFO
+		u8Ctrl1 &= (Luint8)(~(C_ACCELBURST__CTRL_REG1__ACTIVE | C_ACCELBURST__CTRL_REG1__F_READ));
+		s16Return = M_LOCALDEF__LCCM669__WRITE_BYTE(u8DeviceIndex, C_ACCELBURST__REG__CTRL_REG1, u8Ctrl1);
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(s16Return >= 0)
+	{
+		if(u8Burst == 1U)
+		{
+			//circular, keep the newest samples if we are late
+			u8Temp = C_ACCELBURST__F_SETUP__MODE_CIRCULAR | (C_LOCALDEF__LCCM669__FIFO_WATERMARK & C_ACCELBURST__F_SETUP__WMRK_MASK);
+		}
+		else
+		{
+			//FIFO off
+			u8Temp = 0U;
+		}
+		s16Return = M_LOCALDEF__LCCM669__WRITE_BYTE(u8DeviceIndex, C_ACCELBURST__REG__F_SETUP, u8Temp);
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(s16Return >= 0)
+	{
+		//swap the interrupt enable
+		u8Temp = 0U;
+		s16Return = M_LOCALDEF__LCCM669__READ_BYTE(u8DeviceIndex, C_ACCELBURST__REG__CTRL_REG4, &u8Temp);
+		if(s16Return >= 0)
+		{
+			u8Temp &= (Luint8)(~u8Off);
+			u8Temp |= u8On;
+			s16Return = M_LOCALDEF__LCCM669__WRITE_BYTE(u8DeviceIndex, C_ACCELBURST__REG__CTRL_REG4, u8Temp);
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(s16Return >= 0)
+	{
+		//route the new interrupt to whichever pin the old one was on
+		u8Temp = 0U;
+		s16Return = M_LOCALDEF__LCCM669__READ_BYTE(u8DeviceIndex, C_ACCELBURST__REG__CTRL_REG5, &u8Temp);
+		if(s16Return >= 0)
+		{
+			if((u8Temp & u8Off) != 0U)
+			{
+				u8Temp |= u8On;
+			}
+			else
+			{
+				u8Temp &= (Luint8)(~u8On);
+			}
+			u8Temp &= (Luint8)(~u8Off);
+			s16Return = M_LOCALDEF__LCCM669__WRITE_BYTE(u8DeviceIndex, C_ACCELBURST__REG__CTRL_REG5, u8Temp);
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(s16Return >= 0)
+	{
+		//back to active, the FIFO starts empty
+		s16Return = M_LOCALDEF__LCCM669__WRITE_BYTE(u8DeviceIndex, C_ACCELBURST__REG__CTRL_REG1, u8Ctrl1 | C_ACCELBURST__CTRL_REG1__ACTIVE);
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(s16Return >= 0)
+	{
+		s16Return = 0;
+	}
+	else
+	{
+		//fall on
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the next sample for a consumer
+ *
+ * @note
+ * Each consumer keeps its own cursor so the FCU, the DAQ and anything else
+ * can read the ring at their own pace. Start a cursor from
+ * u32ACCELBURST__Get_Head(). A consumer that falls more than a ring
+ * behind is moved up to the oldest sample still held.
+ *
+ * @param[out]		*pSample				Where to copy the sample
+ * @param[in,out]	*pu32Cursor				The consumers cursor, advanced on a copy
+ * @param[in]		u8DeviceIndex			The device index
+ * @return			1 = sample copied\n
+ *					0 = nothing new
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.000.FUNC.005
+ */
+Luint8 u8ACCELBURST__Get_Sample(Luint8 u8DeviceIndex, Luint32 *pu32Cursor, ACCELBURST__SAMPLE_T *pSample)
+{
+	Luint8 u8Return;
+	Luint32 u32Head;
+	Luint32 u32Pos;
+
+	u8Return = 0U;
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		u32Head = sACCELBURST[u8DeviceIndex].sRing.u32Head;
+		if(*pu32Cursor != u32Head)
+		{
+			if((u32Head - *pu32Cursor) > C_LOCALDEF__LCCM669__SAMPLE_RING_SIZE)
+			{
+				//overwritten, skip to the oldest we still have
+				*pu32Cursor = u32Head - C_LOCALDEF__LCCM669__SAMPLE_RING_SIZE;
+				sACCELBURST[u8DeviceIndex].sStats.u32ConsumerLost++;
+			}
+			else
+			{
+				//fall on
+			}
+
+			u32Pos = *pu32Cursor & (C_LOCALDEF__LCCM669__SAMPLE_RING_SIZE - 1U);
+			pSample->s16Axis[0] = sACCELBURST[u8DeviceIndex].sRing.sSample[u32Pos].s16Axis[0];
+			pSample->s16Axis[1] = sACCELBURST[u8DeviceIndex].sRing.sSample[u32Pos].s16Axis[1];
+			pSample->s16Axis[2] = sACCELBURST[u8DeviceIndex].sRing.sSample[u32Pos].s16Axis[2];
+			pSample->u64Timestamp = sACCELBURST[u8DeviceIndex].sRing.sSample[u32Pos].u64Timestamp;
+			*pu32Cursor += 1U;
+
+			u8Return = 1U;
+		}
+		else
+		{
+			//up to date
+		}
+	}
+	else
+	{
+		//index fault
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the ring head, the number of samples written so far
+ *
+ * @param[in]		u8DeviceIndex			The device index
+ * @return			Free running sample count
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.000.FUNC.006
+ */
+Luint32 u32ACCELBURST__Get_Head(Luint8 u8DeviceIndex)
+{
+	Luint32 u32Return;
+
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		u32Return = sACCELBURST[u8DeviceIndex].sRing.u32Head;
+	}
+	else
+	{
+		u32Return = 0U;
+	}
+
+	return u32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the burst mode fault flags
+ *
+ * @param[in]		u8DeviceIndex			The device index
+ * @return			Fault flags, C_LCCM669__CORE__FAULT_INDEX__xx
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.000.FUNC.007
+ */
+Luint32 u32ACCELBURST__Get_FaultFlags(Luint8 u8DeviceIndex)
+{
+	Luint32 u32Return;
+
+	if(u8DeviceIndex < C_LOCALDEF__LCCM669__NUM_DEVICES)
+	{
+		u32Return = sACCELBURST[u8DeviceIndex].sFaultFlags.u32Flags[0];
+	}
+	else
+	{
+		u32Return = C_LCCM669__CORE__FAULT_INDEX_MASK__00 | C_LCCM669__CORE__FAULT_INDEX_MASK__01;
+	}
+
+	return u32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Read everything in the FIFO, stamp it and hand it to the ring and filters
+ *
+ * @note
+ * Anchored: u64Time is the watermark ISR, which is when sample WATERMARK - 1
+ * arrived. Otherwise u64Time is taken as the newest sample.
+ *
+ * @param[in]		u64Time					Timer value for the anchor sample
+ * @param[in]		u8Anchored				1 = u64Time is from the watermark ISR
+ * @param[in]		u8DeviceIndex			The device index
+ * @return			Number of samples read\n
+ *					-ve on I2C fault
+ * @st_funcMD5
+ * @st_funcID		LCCM669R0.FILE.000.FUNC.008
+ */
+static Lint16 s16ACCELBURST__Drain(Luint8 u8DeviceIndex, Luint8 u8Anchored, Luint64 u64Time)
+{
+	Lint16 s16Return;
+	Luint8 u8Status;
+	Luint8 u8Count;
+	Luint8 u8Sample;
+	Luint8 u8Axis;
+	Luint8 *pu8Data;
+	Luint64 u64First;
+	Luint32 u32Pos;
+	Luint32 u32Decimated;
+	Lint16 s16XYZ[3];
+
+	u8Status = 0U;
+	s16Return = M_LOCALDEF__LCCM669__READ_BYTE(u8DeviceIndex, C_ACCELBURST__REG__STATUS, &u8Status);
+	if(s16Return >= 0)
+	{
+		u8Count = u8Status & C_ACCELBURST__F_STATUS__CNT_MASK;
+		if((u8Status & C_ACCELBURST__F_STATUS__OVF) != 0U)
+		{
+			//the oldest samples were lost
+			sACCELBURST[u8DeviceIndex].sStats.u32Overflows++;
+		}
+		else
+		{
+			//fall on
+		}
+
+		if(u8Count > C_ACCELBURST__FIFO_DEPTH)
+		{
+			//can't be, don't run off the buffer
+			u8Count = C_ACCELBURST__FIFO_DEPTH;
+		}
+		else
+		{
+			//fall on
+		}
+
+		if(u8Count > 0U)
+		{
+			//one transaction for the lot
+			s16Return = M_LOCALDEF__LCCM669__READ_MULTIPLE(u8DeviceIndex, C_ACCELBURST__REG__OUT_X_MSB, &sACCELBURST[u8DeviceIndex].u8Buffer[0], (Luint8)(u8Count * 6U));
+		}
+		else
+		{
+			//nothing waiting
+		}
+	}
+	else
+	{
+		u8Count = 0U;
+	}
+
+	if(s16Return >= 0)
+	{
+		sACCELBURST[u8DeviceIndex].sStats.u32Bursts++;
+		if(u8Count > sACCELBURST[u8DeviceIndex].sStats.u8MaxCount)
+		{
+			sACCELBURST[u8DeviceIndex].sStats.u8MaxCount = u8Count;
+		}
+		else
+		{
+			//fall on
+		}
+
+		//time of the oldest sample in the burst
+		if(u8Anchored == 1U)
+		{
+			u64First = u64Time - ((Luint64)sACCELBURST[u8DeviceIndex].u32PeriodTicks * (Luint64)(C_LOCALDEF__LCCM669__FIFO_WATERMARK - 1U));
+		}
+		else
+		{
+			if(u8Count > 0U)
+			{
+				u64First = u64Time - ((Luint64)sACCELBURST[u8DeviceIndex].u32PeriodTicks * (Luint64)(u8Count - 1U));
+			}
+			else
+			{
+				u64First = u64Time;
+			}
+		}
+
+		u32Decimated = u32ACCELBURST_FILT__Get_DecimatedCount(u8DeviceIndex);
+
+		pu8Data = &sACCELBURST[u8DeviceIndex].u8Buffer[0];
+		for(u8Sample = 0U; u8Sample < u8Count; u8Sample++)
+		{
+			for(u8Axis = 0U; u8Axis < 3U; u8Axis++)
+			{
+				//14 bit left justified, bottom two bits are always 0 so the divide is exact
+				s16XYZ[u8Axis] = (Lint16)(((Luint16)pu8Data[0] << 8U) | (Luint16)pu8Data[1]) / 4;
+				pu8Data += 2U;
+			}
+
+			u32Pos = sACCELBURST[u8DeviceIndex].sRing.u32Head & (C_LOCALDEF__LCCM669__SAMPLE_RING_SIZE - 1U);
+			sACCELBURST[u8DeviceIndex].sRing.sSample[u32Pos].s16Axis[0] = s16XYZ[0];
+			sACCELBURST[u8DeviceIndex].sRing.sSample[u32Pos].s16Axis[1] = s16XYZ[1];
+			sACCELBURST[u8DeviceIndex].sRing.sSample[u32Pos].s16Axis[2] = s16XYZ[2];
+			sACCELBURST[u8DeviceIndex].sRing.sSample[u32Pos].u64Timestamp = u64First + ((Luint64)sACCELBURST[u8DeviceIndex].u32PeriodTicks * (Luint64)u8Sample);
+			sACCELBURST[u8DeviceIndex].sRing.u32Head++;
+
+			vACCELBURST_FILT__Add(u8DeviceIndex, &s16XYZ[0]);
+		}
+
+		//only the latest CIC output matters to the angles
+		if(u32ACCELBURST_FILT__Get_DecimatedCount(u8DeviceIndex) != u32Decimated)
+		{
+			vACCELBURST_MATH__Update(u8DeviceIndex);
+		}
+		else
+		{
+			//fall on
+		}
+
+		s16Return = (Lint16)u8Count;
+	}
+	else
+	{
+		vFAULTTREE__Set_Flag(&sACCELBURST[u8DeviceIndex].sFaultFlags, C_LCCM669__CORE__FAULT_INDEX__00);
+		vFAULTTREE__Set_Flag(&sACCELBURST[u8DeviceIndex].sFaultFlags, C_LCCM669__CORE__FAULT_INDEX__03);
+	}
+
+	return s16Return;
+}
+
+#endif //#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
@@ -0,0 +1,265 @@
+/**
+ * @file		ACCEL_BURST.H
+ * @brief		Main header for MMA8451 FIFO burst acquisition
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ */
+
+
+#ifndef _ACCEL_BURST_H_
+#define _ACCEL_BURST_H_
+	#include <localdef.h>
+	#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+
+		//fault flags
+		#include <LCCM669__RLOOP__ACCEL_BURST/accel_burst__fault_flags.h>
+
+		/*******************************************************************************
+		Defines
+		*******************************************************************************/
+
+		/** Depth of the device FIFO in XYZ samples */
+		#define C_ACCELBURST__FIFO_DEPTH						(32U)
+
+		/** In 14 bit, 8G mode 1G = 1024 counts */
+		#define C_ACCELBURST__ONE_G								(1024)
+
+		/** MMA8451 registers we touch */
+		#define C_ACCELBURST__REG__STATUS						(0x00U)
+		#define C_ACCELBURST__REG__OUT_X_MSB					(0x01U)
+		#define C_ACCELBURST__REG__F_SETUP						(0x09U)
+		#define C_ACCELBURST__REG__CTRL_REG1					(0x2AU)
+		#define C_ACCELBURST__REG__CTRL_REG4					(0x2DU)
+		#define C_ACCELBURST__REG__CTRL_REG5					(0x2EU)
+
+		/** F_SETUP fields */
+		#define C_ACCELBURST__F_SETUP__MODE_CIRCULAR			(0x40U)
+		#define C_ACCELBURST__F_SETUP__WMRK_MASK				(0x3FU)
+
+		/** F_STATUS (STATUS when the FIFO is on) fields */
+		#define C_ACCELBURST__F_STATUS__OVF						(0x80U)
+		#define C_ACCELBURST__F_STATUS__CNT_MASK				(0x3FU)
+
+		/** CTRL_REG1 fields */
+		#define C_ACCELBURST__CTRL_REG1__ACTIVE					(0x01U)
+		#define C_ACCELBURST__CTRL_REG1__F_READ					(0x02U)
+
+		/** CTRL_REG4 / CTRL_REG5 interrupt enable and pin routing, 1 = INT1 in REG5 */
+		#define C_ACCELBURST__CTRL_INT__DRDY					(0x01U)
+		#define C_ACCELBURST__CTRL_INT__FIFO					(0x40U)
+
+		/** Axis index */
+		#define C_ACCELBURST__AXIS_X							(0U)
+		#define C_ACCELBURST__AXIS_Y							(1U)
+		#define C_ACCELBURST__AXIS_Z							(2U)
+
+		/** Who has the device */
+		typedef enum
+		{
+			/** FIFO bursts through this module */
+			ACCELBURST_MODE__BURST = 0U,
+
+			/** Handed back to the MMA8451 driver while it zeros or calibrates */
+			ACCELBURST_MODE__CALIBRATE
+
+		}E_ACCELBURST__MODE_T;
+
+		/** One timestamped XYZ sample out of the FIFO */
+		typedef struct
+		{
+			/** Raw 14 bit value for each axis */
+			Lint16 s16Axis[3U];
+
+			/** When the sample was taken, in M_LOCALDEF__LCCM669__GET_TIMESTAMP() units */
+			Luint64 u64Timestamp;
+
+		}ACCELBURST__SAMPLE_T;
+
+
+		/*******************************************************************************
+		Structures
+		*******************************************************************************/
+		/** FIFO burst mode, one per device */
+		struct _strACCELBURST
+		{
+			/** Faults seen in burst mode */
+			FAULT_TREE__PUBLIC_T sFaultFlags;
+
+			/** Burst, or handed to the driver for a zero */
+			E_ACCELBURST__MODE_T eMode;
+
+			/** Set by the watermark ISR, cleared when the FIFO is drained */
+			volatile Luint8 u8Watermark;
+
+			/** Timer at the watermark ISR */
+			volatile Luint64 u64WatermarkTime;
+
+			/** Process loops since the last watermark */
+			Luint32 u32LoopCount;
+
+			/** Timer ticks between samples at the device ODR */
+			Luint32 u32PeriodTicks;
+
+			/** The whole FIFO as it comes off the I2C */
+			Luint8 u8Buffer[C_ACCELBURST__FIFO_DEPTH * 6U];
+
+			/** Samples at full ODR for the consumers */
+			struct
+			{
+				ACCELBURST__SAMPLE_T sSample[C_LOCALDEF__LCCM669__SAMPLE_RING_SIZE];
+
+				/** Free running count of samples written */
+				Luint32 u32Head;
+
+			}sRing;
+
+			/** Running sum average, the sum is updated, never recomputed */
+			struct
+			{
+				Lint16 s16Window[3U][C_LOCALDEF__LCCM669__AVERAGE_SAMPLES];
+
+				Lint32 s32Sum[3U];
+
+				/** Next slot to replace */
+				Luint16 u16Position;
+
+				/** Number of valid slots, until the window has filled */
+				Luint16 u16Fill;
+
+			}sAverage;
+
+			/** CIC decimator, integrators at the ODR and combs at the output rate
+			 * Unsigned so the integrator wrap is defined, the combs undo it. */
+			struct
+			{
+				Luint32 u32Integrator[3U][C_LOCALDEF__LCCM669__CIC_STAGES];
+
+				Luint32 u32Comb[3U][C_LOCALDEF__LCCM669__CIC_STAGES];
+
+				/** Inputs since the last output */
+				Luint8 u8Phase;
+
+				/** Last output, gain removed */
+				Lint16 s16Output[3U];
+
+				/** Number of outputs so far */
+				Luint32 u32Count;
+
+			}sCIC;
+
+			/** Worked out from each CIC output */
+			struct
+			{
+				/** G-Force on each axis */
+				Lfloat32 f32GForce[3U];
+
+				/** Pitch about Y, +ve nose (X) up, degrees */
+				Lfloat32 f32Pitch;
+
+				/** Roll about X, degrees */
+				Lfloat32 f32Roll;
+
+			}sMath;
+
+			/** Zero or calibration handed to the driver */
+			struct
+			{
+				/** Timer when the device was handed over */
+				Luint64 u64Start;
+
+				/** Number of handovers */
+				Luint32 u32Count;
+
+			}sZero;
+
+			/** Diagnostics */
+			struct
+			{
+				/** FIFO reads */
+				Luint32 u32Bursts;
+
+				/** The FIFO wrapped before we got to it */
+				Luint32 u32Overflows;
+
+				/** Watermark found by the lost interrupt poll */
+				Luint32 u32Recovered;
+
+				/** A consumer fell more than a ring behind */
+				Luint32 u32ConsumerLost;
+
+				/** Most samples seen in one burst */
+				Luint8 u8MaxCount;
+
+			}sStats;
+
+		};
+
+
+		/*******************************************************************************
+		Function Prototypes
+		*******************************************************************************/
+		void vACCELBURST__Init(Luint8 u8DeviceIndex);
+		void vACCELBURST__Process(Luint8 u8DeviceIndex);
+		void vACCELBURST__ISR(Luint8 u8DeviceIndex);
+		Lint16 s16ACCELBURST__Configure(Luint8 u8DeviceIndex, Luint8 u8Burst);
+		Luint8 u8ACCELBURST__Get_Sample(Luint8 u8DeviceIndex, Luint32 *pu32Cursor, ACCELBURST__SAMPLE_T *pSample);
+		Luint32 u32ACCELBURST__Get_Head(Luint8 u8DeviceIndex);
+		Luint32 u32ACCELBURST__Get_FaultFlags(Luint8 u8DeviceIndex);
+
+		//filters
+		void vACCELBURST_FILT__Init(Luint8 u8DeviceIndex);
+		void vACCELBURST_FILT__Add(Luint8 u8DeviceIndex, const Lint16 *ps16XYZ);
+		Lint16 s16ACCELBURST_FILT__Get_Average(Luint8 u8DeviceIndex, Luint8 u8Axis);
+		Lint16 s16ACCELBURST_FILT__Get_Decimated(Luint8 u8DeviceIndex, Luint8 u8Axis);
+		Luint32 u32ACCELBURST_FILT__Get_DecimatedCount(Luint8 u8DeviceIndex);
+
+		//math
+		void vACCELBURST_MATH__Init(Luint8 u8DeviceIndex);
+		void vACCELBURST_MATH__Update(Luint8 u8DeviceIndex);
+		Lfloat32 f32ACCELBURST_MATH__Get_GForce(Luint8 u8DeviceIndex, Luint8 u8Axis);
+		Lfloat32 f32ACCELBURST_MATH__Get_PitchAngle(Luint8 u8DeviceIndex);
+		Lfloat32 f32ACCELBURST_MATH__Get_RollAngle(Luint8 u8DeviceIndex);
+
+		//zero
+		void vACCELBURST_ZERO__AutoZero(Luint8 u8DeviceIndex);
+		void vACCELBURST_ZERO__Set_FineZero(Luint8 u8DeviceIndex, Luint8 u8Axis);
+		void vACCELBURST_ZERO__Process(Luint8 u8DeviceIndex);
+		Luint8 u8ACCELBURST_ZERO__Get_IsCalibrating(Luint8 u8DeviceIndex);
+
+		//testing
+		#if C_LOCALDEF__LCCM669__ENABLE_TEST_SPEC == 1U
+			DLL_DECLARATION void vLCCM669R0_TS_000(void);
+			Lint16 s16LCCM669R0_TS_000__ReadByte(Luint8 u8DeviceIndex, Luint8 u8Register, Luint8 *pu8Value);
+			Lint16 s16LCCM669R0_TS_000__ReadMultiple(Luint8 u8DeviceIndex, Luint8 u8Register, Luint8 *pu8Array, Luint8 u8Length);
+			Lint16 s16LCCM669R0_TS_000__WriteByte(Luint8 u8DeviceIndex, Luint8 u8Register, Luint8 u8Value);
+			Luint64 u64LCCM669R0_TS_000__Get_Time(void);
+			void vLCCM669R0_TS_000__Driver_Process(Luint8 u8DeviceIndex);
+			void vLCCM669R0_TS_000__Driver_ISR(Luint8 u8DeviceIndex);
+			void vLCCM669R0_TS_000__Driver_AutoZero(Luint8 u8DeviceIndex);
+			void vLCCM669R0_TS_000__Driver_FineZero(Luint8 u8DeviceIndex, Luint8 u8Axis);
+			Luint8 u8LCCM669R0_TS_000__Driver_IsCalibrating(Luint8 u8DeviceIndex);
+		#endif
+
+		//safetys
+		#if (C_LOCALDEF__LCCM669__FIFO_WATERMARK == 0U) || (C_LOCALDEF__LCCM669__FIFO_WATERMARK >= C_ACCELBURST__FIFO_DEPTH)
+			#error
+		#endif
+		#if (C_LOCALDEF__LCCM669__SAMPLE_RING_SIZE & (C_LOCALDEF__LCCM669__SAMPLE_RING_SIZE - 1U)) != 0U
+			#error "Sample ring must be a power of 2"
+		#endif
+		#if (C_LOCALDEF__LCCM669__CIC_STAGES == 0U) || (C_LOCALDEF__LCCM669__CIC_STAGES > 4U)
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM669__CIC_DECIMATION > 255U
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM669__DATA_RATE_HZ == 0U
+			#error
+		#endif
+
+	#endif //#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+	//safetys
+	#ifndef C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE
+		#error
+	#endif
+#endif //_ACCEL_BURST_H_
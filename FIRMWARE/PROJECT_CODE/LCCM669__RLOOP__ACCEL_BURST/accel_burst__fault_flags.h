@@ -0,0 +1,67 @@
+#ifndef _LCCM669__00__FAULT_FLAGS_H_
+#define _LCCM669__00__FAULT_FLAGS_H_
+/*
+ * @fault_index
+ * 00
+ *
+ * @brief
+ * GENERAL FAULT
+ *
+ * A general fault has occurred in FIFO burst mode.
+*/
+#define C_LCCM669__CORE__FAULT_INDEX__00				0x00000000U
+#define C_LCCM669__CORE__FAULT_INDEX_MASK__00			0x00000001U
+
+/*
+ * @fault_index
+ * 01
+ *
+ * @brief
+ * DEVICE INDEX FAULT
+ *
+ * The software tried to address a device whos index was not found.
+ * This is a programming fault.
+*/
+#define C_LCCM669__CORE__FAULT_INDEX__01				0x00000001U
+#define C_LCCM669__CORE__FAULT_INDEX_MASK__01			0x00000002U
+
+/*
+ * @fault_index
+ * 02
+ *
+ * @brief
+ * CONFIG FAULT
+ *
+ * The device would not take the FIFO or data ready setup when swapping
+ * between burst mode and the driver.
+*/
+#define C_LCCM669__CORE__FAULT_INDEX__02				0x00000002U
+#define C_LCCM669__CORE__FAULT_INDEX_MASK__02			0x00000004U
+
+/*
+ * @fault_index
+ * 03
+ *
+ * @brief
+ * FIFO READ FAIL
+ *
+ * The FIFO status or the FIFO itself could not be read, due to an I2C
+ * timeout or other device problem.
+*/
+#define C_LCCM669__CORE__FAULT_INDEX__03				0x00000003U
+#define C_LCCM669__CORE__FAULT_INDEX_MASK__03			0x00000008U
+
+/*
+ * @fault_index
+ * 04
+ *
+ * @brief
+ * DEVICE STOPPED
+ *
+ * No watermark interrupt and nothing in the FIFO when polled, the device
+ * has stopped sampling.
+*/
+#define C_LCCM669__CORE__FAULT_INDEX__04				0x00000004U
+#define C_LCCM669__CORE__FAULT_INDEX_MASK__04			0x00000010U
+
+#endif //#ifndef _LCCM669__00__FAULT_FLAGS_H_
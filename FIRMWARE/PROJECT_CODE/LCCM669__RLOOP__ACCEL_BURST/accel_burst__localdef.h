@@ -0,0 +1,68 @@
+/**
+ * @file		ACCEL_BURST__LOCALDEF.H
+ * @brief		Localdef template
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM669R0.FILE.004
+ */
+
+#if 0
+
+/*******************************************************************************
+RLOOP - ACCEL FIFO BURST
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+
+		/** Number of MMA8451's, same index as the driver */
+		#define C_LOCALDEF__LCCM669__NUM_DEVICES							(2U)
+
+		/** Device ODR as set up by the driver, used to stamp each sample */
+		#define C_LOCALDEF__LCCM669__DATA_RATE_HZ							(800U)
+
+		/** FIFO samples before the watermark interrupt, 1 to 31 */
+		#define C_LOCALDEF__LCCM669__FIFO_WATERMARK							(16U)
+
+		/** Samples held for the consumers, power of 2 */
+		#define C_LOCALDEF__LCCM669__SAMPLE_RING_SIZE						(128U)
+
+		/** Running average length */
+		#define C_LOCALDEF__LCCM669__AVERAGE_SAMPLES						(32U)
+
+		/** CIC decimator, DECIMATION ^ STAGES must be <= 131072 */
+		#define C_LOCALDEF__LCCM669__CIC_DECIMATION							(8U)
+		#define C_LOCALDEF__LCCM669__CIC_STAGES								(3U)
+
+		/** Process loops with no watermark before the FIFO is polled */
+		#define C_LOCALDEF__LCCM669__MAX_INTERRUPT_LOST_COUNT				(2000000U)
+
+		/** The driver keeps the device at least this long for a zero */
+		#define C_LOCALDEF__LCCM669__CAL_HOLD_MS							(100U)
+
+		/** Timestamp for each sample, RTI counter 1 */
+		#define M_LOCALDEF__LCCM669__GET_TIMESTAMP()						u64RM4_RTI__Get_Counter1()
+		#define C_LOCALDEF__LCCM669__TIMESTAMP_TICKS_PER_SEC				(C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC)
+
+		/** Device access, through the driver low level */
+		#define M_LOCALDEF__LCCM669__READ_BYTE(dev, reg, pval)				s16MMA8451_LOWLEVEL__ReadByte(dev, reg, pval)
+		#define M_LOCALDEF__LCCM669__READ_MULTIPLE(dev, reg, parr, len)		s16MMA8451_LOWLEVEL__ReadMultiple(dev, reg, parr, len)
+		#define M_LOCALDEF__LCCM669__WRITE_BYTE(dev, reg, val)				s16MMA8451_LOWLEVEL__WriteByte(dev, reg, val)
+
+		/** The driver, while it has the device for a zero */
+		#define M_LOCALDEF__LCCM669__DRIVER_PROCESS(dev)					vMMA8451__Process(dev)
+		#define M_LOCALDEF__LCCM669__DRIVER_ISR(dev)						vMMA8451__ISR(dev)
+		#define M_LOCALDEF__LCCM669__DRIVER_AUTOZERO(dev)					vMMA8451_ZERO__AutoZero(dev)
+		#define M_LOCALDEF__LCCM669__DRIVER_FINEZERO(dev, axis)				vMMA8451_ZERO__Set_FineZero(dev, (MMA8451__AXIS_E)axis)
+
+		/** 1 while the driver is zeroing or calibrating */
+		#define M_LOCALDEF__LCCM669__DRIVER_CALIBRATING(dev)				(u8MMA8451_PROCESS__Get_CalibrationState(dev) != C_MMA8451__CALSTATE__NONE)
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM669__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM669__RLOOP__ACCEL_BURST/accel_burst.h>
+	#endif //#if C_LOCALDEF__LCCM669__ENABLE_THIS_MODULE == 1U
+
+#endif //#if 0
+
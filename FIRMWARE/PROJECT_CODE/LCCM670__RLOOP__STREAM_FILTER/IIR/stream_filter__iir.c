@@ -0,0 +1,500 @@
+/**
+ * @file		STREAM_FILTER__IIR.C
+ * @brief		Exponential and biquad IIR filters
+ *
+ * @note
+ * The fixed point versions work on S16 samples.
+ * Exponential: alpha is Q15 and the state carries 16 fraction bits so a
+ * small alpha still tracks a one LSB step.
+ * Biquad: coefficients are Q14 which covers -2.0 to +1.99994, enough for
+ * a normalised second order section as long as a1 does not reach -2.0, i.e.
+ * the corner is not right down at DC. The accumulator is 64 bit and the
+ * output saturates. The fraction dropped by each output is carried into the
+ * next (first order error feedback) so the output settles on the input rather
+ * than anywhere inside the rounding dead band.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM670R0.FILE.001
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup STREAMFILT
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup STREAMFILT__IIR
+ * @ingroup STREAMFILT
+ * @{ */
+
+#include "../stream_filter.h"
+#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+
+/** Q14 one */
+#define C_STREAMFILT__Q14_ONE						(16384)
+
+static Lint16 s16STREAMFILT__Saturate_S16(Lint64 s64Value);
+static Lint16 s16STREAMFILT__Float_To_Q14(Lfloat32 f32Value, Luint8 *pu8Clipped);
+
+
+/***************************************************************************//**
+ * @brief
+ * Setup a fixed point exponential filter
+ *
+ * @param[in]		s16Alpha_Q15			Smoothing factor in Q15, limited to 1..32767
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.001.FUNC.001
+ */
+void vSTREAMFILT_EMA__Init_S16(STREAMFILT__EMA_S16_T *pFilter, Lint16 s16Alpha_Q15)
+{
+
+	if(s16Alpha_Q15 < 1)
+	{
+		//an alpha of 0 would never move
+		pFilter->s16Alpha_Q15 = 1;
+	}
+	else
+	{
+		pFilter->s16Alpha_Q15 = s16Alpha_Q15;
+	}
+
+	pFilter->s32State_Q16 = 0;
+	pFilter->u8Primed = 0U;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Add a sample to a fixed point exponential filter
+ *
+ * @param[in]		s16Sample				The new sample
+ * @param[in]		*pFilter				The filter
+ * @return			The filtered value, rounded to the nearest
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.001.FUNC.002
+ */
+Lint16 s16STREAMFILT_EMA__Add_S16(STREAMFILT__EMA_S16_T *pFilter, Lint16 s16Sample)
+{
+	Lint64 s64Diff;
+	Lint64 s64State;
+	Lint16 s16Return;
+
+	if(pFilter->u8Primed == 0U)
+	{
+		//start from the first sample, not from zero
+		pFilter->s32State_Q16 = (Lint32)s16Sample * 65536;
+		pFilter->u8Primed = 1U;
+	}
+	else
+	{
+		//y += alpha * (x - y), the difference needs 33 bits
+		s64Diff = ((Lint64)s16Sample * 65536) - (Lint64)pFilter->s32State_Q16;
+		s64Diff *= (Lint64)pFilter->s16Alpha_Q15;
+		pFilter->s32State_Q16 += (Lint32)(s64Diff / 32768);
+	}
+
+	//round to the nearest, symmetrically about zero
+	s64State = (Lint64)pFilter->s32State_Q16;
+	if(s64State >= 0)
+	{
+		s16Return = (Lint16)((s64State + 32768) / 65536);
+	}
+	else
+	{
+		s16Return = (Lint16)((s64State - 32768) / 65536);
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Filter a block through a fixed point exponential filter
+ *
+ * @param[in]		u32Count				Number of samples
+ * @param[out]		*ps16Out				Filtered samples, may be the input buffer
+ * @param[in]		*ps16In					The samples
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.001.FUNC.003
+ */
+void vSTREAMFILT_EMA__Block_S16(STREAMFILT__EMA_S16_T *pFilter, const Lint16 *ps16In, Lint16 *ps16Out, Luint32 u32Count)
+{
+	Luint32 u32Counter;
+
+	for(u32Counter = 0U; u32Counter < u32Count; u32Counter++)
+	{
+		ps16Out[u32Counter] = s16STREAMFILT_EMA__Add_S16(pFilter, ps16In[u32Counter]);
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Setup a float exponential filter
+ *
+ * @param[in]		f32Alpha				Smoothing factor, 0.0 to 1.0
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.001.FUNC.004
+ */
+void vSTREAMFILT_EMA__Init_F32(STREAMFILT__EMA_F32_T *pFilter, Lfloat32 f32Alpha)
+{
+
+	if(f32Alpha > 1.0F)
+	{
+		pFilter->f32Alpha = 1.0F;
+	}
+	else
+	{
+		if(f32Alpha < 0.0F)
+		{
+			pFilter->f32Alpha = 0.0F;
+		}
+		else
+		{
+			pFilter->f32Alpha = f32Alpha;
+		}
+	}
+
+	pFilter->f32State = 0.0F;
+	pFilter->u8Primed = 0U;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Add a sample to a float exponential filter
+ *
+ * @param[in]		f32Sample				The new sample
+ * @param[in]		*pFilter				The filter
+ * @return			The filtered value
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.001.FUNC.005
+ */
+Lfloat32 f32STREAMFILT_EMA__Add_F32(STREAMFILT__EMA_F32_T *pFilter, Lfloat32 f32Sample)
+{
+
+	if(pFilter->u8Primed == 0U)
+	{
+		pFilter->f32State = f32Sample;
+		pFilter->u8Primed = 1U;
+	}
+	else
+	{
+		pFilter->f32State += pFilter->f32Alpha * (f32Sample - pFilter->f32State);
+	}
+
+	return pFilter->f32State;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Filter a block through a float exponential filter
+ *
+ * @param[in]		u32Count				Number of samples
+ * @param[out]		*pf32Out				Filtered samples, may be the input buffer
+ * @param[in]		*pf32In					The samples
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.001.FUNC.006
+ */
+void vSTREAMFILT_EMA__Block_F32(STREAMFILT__EMA_F32_T *pFilter, const Lfloat32 *pf32In, Lfloat32 *pf32Out, Luint32 u32Count)
+{
+	Luint32 u32Counter;
+
+	for(u32Counter = 0U; u32Counter < u32Count; u32Counter++)
+	{
+		pf32Out[u32Counter] = f32STREAMFILT_EMA__Add_F32(pFilter, pf32In[u32Counter]);
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Setup a fixed point biquad from float coefficients
+ *
+ * @note
+ * The coefficients are normalised so that a0 is 1.
+ *
+ * @param[in]		*pf32A					a1, a2
+ * @param[in]		*pf32B					b0, b1, b2
+ * @param[in]		*pFilter				The filter
+ * @return			-1 = a coefficient was outside the Q14 range and was clipped\n
+ *					0 = success
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.001.FUNC.007
+ */
+Lint16 s16STREAMFILT_BIQUAD__Init_S16(STREAMFILT__BIQUAD_S16_T *pFilter, const Lfloat32 *pf32B, const Lfloat32 *pf32A)
+{
+	Luint8 u8Counter;
+	Luint8 u8Clipped;
+	Lint16 s16Return;
+
+	u8Clipped = 0U;
+
+	for(u8Counter = 0U; u8Counter < 3U; u8Counter++)
+	{
+		pFilter->s16B_Q14[u8Counter] = s16STREAMFILT__Float_To_Q14(pf32B[u8Counter], &u8Clipped);
+	}
+	for(u8Counter = 0U; u8Counter < 2U; u8Counter++)
+	{
+		pFilter->s16A_Q14[u8Counter] = s16STREAMFILT__Float_To_Q14(pf32A[u8Counter], &u8Clipped);
+		pFilter->s16X[u8Counter] = 0;
+		pFilter->s16Y[u8Counter] = 0;
+	}
+	pFilter->s32Residual = 0;
+
+	if(u8Clipped == 0U)
+	{
+		s16Return = 0;
+	}
+	else
+	{
+		s16Return = -1;
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Add a sample to a fixed point biquad
+ *
+ * @param[in]		s16Sample				The new sample
+ * @param[in]		*pFilter				The filter
+ * @return			The filtered value, saturated
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.001.FUNC.008
+ */
+Lint16 s16STREAMFILT_BIQUAD__Add_S16(STREAMFILT__BIQUAD_S16_T *pFilter, Lint16 s16Sample)
+{
+	Lint64 s64Acc;
+	Lint64 s64Out;
+	Lint64 s64Rem;
+	Lint16 s16Return;
+
+	s64Acc  = (Lint64)pFilter->s16B_Q14[0] * (Lint64)s16Sample;
+	s64Acc += (Lint64)pFilter->s16B_Q14[1] * (Lint64)pFilter->s16X[0];
+	s64Acc += (Lint64)pFilter->s16B_Q14[2] * (Lint64)pFilter->s16X[1];
+	s64Acc -= (Lint64)pFilter->s16A_Q14[0] * (Lint64)pFilter->s16Y[0];
+	s64Acc -= (Lint64)pFilter->s16A_Q14[1] * (Lint64)pFilter->s16Y[1];
+
+	//back to Q0, floor, keeping what was dropped for next time
+	s64Acc += (Lint64)pFilter->s32Residual;
+	s64Out = s64Acc / C_STREAMFILT__Q14_ONE;
+	s64Rem = s64Acc - (s64Out * C_STREAMFILT__Q14_ONE);
+	if(s64Rem < 0)
+	{
+		s64Out -= 1;
+		s64Rem += C_STREAMFILT__Q14_ONE;
+	}
+	else
+	{
+		//fall on
+	}
+	pFilter->s32Residual = (Lint32)s64Rem;
+	s16Return = s16STREAMFILT__Saturate_S16(s64Out);
+
+	pFilter->s16X[1] = pFilter->s16X[0];
+	pFilter->s16X[0] = s16Sample;
+	pFilter->s16Y[1] = pFilter->s16Y[0];
+	pFilter->s16Y[0] = s16Return;
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Filter a block through a fixed point biquad
+ *
+ * @param[in]		u32Count				Number of samples
+ * @param[out]		*ps16Out				Filtered samples, may be the input buffer
+ * @param[in]		*ps16In					The samples
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.001.FUNC.009
+ */
+void vSTREAMFILT_BIQUAD__Block_S16(STREAMFILT__BIQUAD_S16_T *pFilter, const Lint16 *ps16In, Lint16 *ps16Out, Luint32 u32Count)
+{
+	Luint32 u32Counter;
+
+	for(u32Counter = 0U; u32Counter < u32Count; u32Counter++)
+	{
+		ps16Out[u32Counter] = s16STREAMFILT_BIQUAD__Add_S16(pFilter, ps16In[u32Counter]);
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Setup a float biquad
+ *
+ * @param[in]		*pf32A					a1, a2 with a0 normalised to 1
+ * @param[in]		*pf32B					b0, b1, b2
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.001.FUNC.010
+ */
+void vSTREAMFILT_BIQUAD__Init_F32(STREAMFILT__BIQUAD_F32_T *pFilter, const Lfloat32 *pf32B, const Lfloat32 *pf32A)
+{
+
+	pFilter->f32B[0] = pf32B[0];
+	pFilter->f32B[1] = pf32B[1];
+	pFilter->f32B[2] = pf32B[2];
+	pFilter->f32A[0] = pf32A[0];
+	pFilter->f32A[1] = pf32A[1];
+	pFilter->f32Z[0] = 0.0F;
+	pFilter->f32Z[1] = 0.0F;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Add a sample to a float biquad
+ *
+ * @param[in]		f32Sample				The new sample
+ * @param[in]		*pFilter				The filter
+ * @return			The filtered value
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.001.FUNC.011
+ */
+Lfloat32 f32STREAMFILT_BIQUAD__Add_F32(STREAMFILT__BIQUAD_F32_T *pFilter, Lfloat32 f32Sample)
+{
+	Lfloat32 f32Return;
+
+	//transposed direct form II, two states instead of four
+	f32Return = (pFilter->f32B[0] * f32Sample) + pFilter->f32Z[0];
+	pFilter->f32Z[0] = (pFilter->f32B[1] * f32Sample) - (pFilter->f32A[0] * f32Return) + pFilter->f32Z[1];
+	pFilter->f32Z[1] = (pFilter->f32B[2] * f32Sample) - (pFilter->f32A[1] * f32Return);
+
+	return f32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Filter a block through a float biquad
+ *
+ * @param[in]		u32Count				Number of samples
+ * @param[out]		*pf32Out				Filtered samples, may be the input buffer
+ * @param[in]		*pf32In					The samples
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.001.FUNC.012
+ */
+void vSTREAMFILT_BIQUAD__Block_F32(STREAMFILT__BIQUAD_F32_T *pFilter, const Lfloat32 *pf32In, Lfloat32 *pf32Out, Luint32 u32Count)
+{
+	Luint32 u32Counter;
+	Lfloat32 f32Z0;
+	Lfloat32 f32Z1;
+	Lfloat32 f32X;
+	Lfloat32 f32Y;
+
+	//keep the states in registers over the block
+	f32Z0 = pFilter->f32Z[0];
+	f32Z1 = pFilter->f32Z[1];
+
+	for(u32Counter = 0U; u32Counter < u32Count; u32Counter++)
+	{
+		f32X = pf32In[u32Counter];
+		f32Y = (pFilter->f32B[0] * f32X) + f32Z0;
+		f32Z0 = (pFilter->f32B[1] * f32X) - (pFilter->f32A[0] * f32Y) + f32Z1;
+		f32Z1 = (pFilter->f32B[2] * f32X) - (pFilter->f32A[1] * f32Y);
+		pf32Out[u32Counter] = f32Y;
+	}
+
+	pFilter->f32Z[0] = f32Z0;
+	pFilter->f32Z[1] = f32Z1;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Saturate to S16
+ *
+ * @param[in]		s64Value				The value
+ * @return			The value limited to -32768..32767
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.001.FUNC.013
+ */
+static Lint16 s16STREAMFILT__Saturate_S16(Lint64 s64Value)
+{
+	Lint16 s16Return;
+
+	if(s64Value > 32767)
+	{
+		s16Return = 32767;
+	}
+	else
+	{
+		if(s64Value < -32768)
+		{
+			s16Return = -32768;
+		}
+		else
+		{
+			s16Return = (Lint16)s64Value;
+		}
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Convert a coefficient to Q14, rounding to the nearest
+ *
+ * @param[out]		*pu8Clipped				Set to 1 if the value did not fit
+ * @param[in]		f32Value				The coefficient
+ * @return			The coefficient in Q14
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.001.FUNC.014
+ */
+static Lint16 s16STREAMFILT__Float_To_Q14(Lfloat32 f32Value, Luint8 *pu8Clipped)
+{
+	Lfloat32 f32Temp;
+	Lint16 s16Return;
+
+	f32Temp = f32Value * (Lfloat32)C_STREAMFILT__Q14_ONE;
+
+	if(f32Temp >= 32767.5F)
+	{
+		s16Return = 32767;
+		*pu8Clipped = 1U;
+	}
+	else
+	{
+		if(f32Temp <= -32768.5F)
+		{
+			s16Return = -32768;
+			*pu8Clipped = 1U;
+		}
+		else
+		{
+			if(f32Temp >= 0.0F)
+			{
+				s16Return = (Lint16)(f32Temp + 0.5F);
+			}
+			else
+			{
+				s16Return = (Lint16)(f32Temp - 0.5F);
+			}
+		}
+	}
+
+	return s16Return;
+}
+
+
+#endif //#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
@@ -0,0 +1,571 @@
+/**
+ * @file		STREAM_FILTER__MAVG.C
+ * @brief		Running sum moving averages
+ *
+ * @note
+ * The window lives in a caller buffer. Each sample replaces the oldest one in
+ * the window and the running sum is corrected by the difference, so the cost
+ * per sample does not depend on the window length. Until the window has filled
+ * the result is the average of the samples seen so far. Once full the result is
+ * the same as the NUMERICAL_FILTERING__Add_xxx() average over the same window.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM670R0.FILE.000
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup STREAMFILT
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup STREAMFILT__MAVG
+ * @ingroup STREAMFILT
+ * @{ */
+
+#include "../stream_filter.h"
+#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+
+
+/***************************************************************************//**
+ * @brief
+ * Setup a S16 moving average on a caller buffer
+ *
+ * @param[in]		u16Size					Window length, the buffer must hold this many
+ * @param[in]		*ps16Buffer				The window buffer
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.000.FUNC.001
+ */
+void vSTREAMFILT_MAVG__Init_S16(STREAMFILT__MAVG_S16_T *pFilter, Lint16 *ps16Buffer, Luint16 u16Size)
+{
+	Luint16 u16Counter;
+
+	pFilter->ps16Buffer = ps16Buffer;
+	pFilter->u16Size = u16Size;
+	pFilter->u16Position = 0U;
+	pFilter->u16Fill = 0U;
+	pFilter->s32Sum = 0;
+
+	for(u16Counter = 0U; u16Counter < u16Size; u16Counter++)
+	{
+		ps16Buffer[u16Counter] = 0;
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Add a sample and return the average of the window
+ *
+ * @param[in]		s16Sample				The new sample
+ * @param[in]		*pFilter				The filter
+ * @return			The average, or the sample if the window length is 0
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.000.FUNC.002
+ */
+Lint16 s16STREAMFILT_MAVG__Add_S16(STREAMFILT__MAVG_S16_T *pFilter, Lint16 s16Sample)
+{
+	Lint16 s16Return;
+	Luint16 u16Pos;
+
+	if(pFilter->u16Size > 0U)
+	{
+		u16Pos = pFilter->u16Position;
+
+		if(pFilter->u16Fill < pFilter->u16Size)
+		{
+			pFilter->u16Fill++;
+		}
+		else
+		{
+			//drop the oldest
+			pFilter->s32Sum -= (Lint32)pFilter->ps16Buffer[u16Pos];
+		}
+
+		pFilter->ps16Buffer[u16Pos] = s16Sample;
+		pFilter->s32Sum += (Lint32)s16Sample;
+
+		u16Pos++;
+		if(u16Pos >= pFilter->u16Size)
+		{
+			u16Pos = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+		pFilter->u16Position = u16Pos;
+
+		s16Return = (Lint16)(pFilter->s32Sum / (Lint32)pFilter->u16Fill);
+	}
+	else
+	{
+		//no window
+		s16Return = s16Sample;
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Filter a block of samples
+ *
+ * @note
+ * The output may be the input buffer.
+ *
+ * @param[in]		u32Count				Number of samples
+ * @param[out]		*ps16Out					The average after each sample
+ * @param[in]		*ps16In					The samples
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.000.FUNC.003
+ */
+void vSTREAMFILT_MAVG__Block_S16(STREAMFILT__MAVG_S16_T *pFilter, const Lint16 *ps16In, Lint16 *ps16Out, Luint32 u32Count)
+{
+	Luint32 u32Counter;
+
+	for(u32Counter = 0U; u32Counter < u32Count; u32Counter++)
+	{
+		ps16Out[u32Counter] = s16STREAMFILT_MAVG__Add_S16(pFilter, ps16In[u32Counter]);
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Setup a U16 moving average on a caller buffer
+ *
+ * @param[in]		u16Size					Window length, the buffer must hold this many
+ * @param[in]		*pu16Buffer				The window buffer
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.000.FUNC.004
+ */
+void vSTREAMFILT_MAVG__Init_U16(STREAMFILT__MAVG_U16_T *pFilter, Luint16 *pu16Buffer, Luint16 u16Size)
+{
+	Luint16 u16Counter;
+
+	pFilter->pu16Buffer = pu16Buffer;
+	pFilter->u16Size = u16Size;
+	pFilter->u16Position = 0U;
+	pFilter->u16Fill = 0U;
+	pFilter->u32Sum = 0U;
+
+	for(u16Counter = 0U; u16Counter < u16Size; u16Counter++)
+	{
+		pu16Buffer[u16Counter] = 0U;
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Add a sample and return the average of the window
+ *
+ * @param[in]		u16Sample				The new sample
+ * @param[in]		*pFilter				The filter
+ * @return			The average, or the sample if the window length is 0
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.000.FUNC.005
+ */
+Luint16 u16STREAMFILT_MAVG__Add_U16(STREAMFILT__MAVG_U16_T *pFilter, Luint16 u16Sample)
+{
+	Luint16 u16Return;
+	Luint16 u16Pos;
+
+	if(pFilter->u16Size > 0U)
+	{
+		u16Pos = pFilter->u16Position;
+
+		if(pFilter->u16Fill < pFilter->u16Size)
+		{
+			pFilter->u16Fill++;
+		}
+		else
+		{
+			//drop the oldest
+			pFilter->u32Sum -= (Luint32)pFilter->pu16Buffer[u16Pos];
+		}
+
+		pFilter->pu16Buffer[u16Pos] = u16Sample;
+		pFilter->u32Sum += (Luint32)u16Sample;
+
+		u16Pos++;
+		if(u16Pos >= pFilter->u16Size)
+		{
+			u16Pos = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+		pFilter->u16Position = u16Pos;
+
+		u16Return = (Luint16)(pFilter->u32Sum / (Luint32)pFilter->u16Fill);
+	}
+	else
+	{
+		//no window
+		u16Return = u16Sample;
+	}
+
+	return u16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Filter a block of samples
+ *
+ * @note
+ * The output may be the input buffer.
+ *
+ * @param[in]		u32Count				Number of samples
+ * @param[out]		*pu16Out					The average after each sample
+ * @param[in]		*pu16In					The samples
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.000.FUNC.006
+ */
+void vSTREAMFILT_MAVG__Block_U16(STREAMFILT__MAVG_U16_T *pFilter, const Luint16 *pu16In, Luint16 *pu16Out, Luint32 u32Count)
+{
+	Luint32 u32Counter;
+
+	for(u32Counter = 0U; u32Counter < u32Count; u32Counter++)
+	{
+		pu16Out[u32Counter] = u16STREAMFILT_MAVG__Add_U16(pFilter, pu16In[u32Counter]);
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Setup a S32 moving average on a caller buffer
+ *
+ * @param[in]		u16Size					Window length, the buffer must hold this many
+ * @param[in]		*ps32Buffer				The window buffer
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.000.FUNC.007
+ */
+void vSTREAMFILT_MAVG__Init_S32(STREAMFILT__MAVG_S32_T *pFilter, Lint32 *ps32Buffer, Luint16 u16Size)
+{
+	Luint16 u16Counter;
+
+	pFilter->ps32Buffer = ps32Buffer;
+	pFilter->u16Size = u16Size;
+	pFilter->u16Position = 0U;
+	pFilter->u16Fill = 0U;
+	pFilter->s64Sum = 0;
+
+	for(u16Counter = 0U; u16Counter < u16Size; u16Counter++)
+	{
+		ps32Buffer[u16Counter] = 0;
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Add a sample and return the average of the window
+ *
+ * @param[in]		s32Sample				The new sample
+ * @param[in]		*pFilter				The filter
+ * @return			The average, or the sample if the window length is 0
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.000.FUNC.008
+ */
+Lint32 s32STREAMFILT_MAVG__Add_S32(STREAMFILT__MAVG_S32_T *pFilter, Lint32 s32Sample)
+{
+	Lint32 s32Return;
+	Luint16 u16Pos;
+
+	if(pFilter->u16Size > 0U)
+	{
+		u16Pos = pFilter->u16Position;
+
+		if(pFilter->u16Fill < pFilter->u16Size)
+		{
+			pFilter->u16Fill++;
+		}
+		else
+		{
+			//drop the oldest
+			pFilter->s64Sum -= (Lint64)pFilter->ps32Buffer[u16Pos];
+		}
+
+		pFilter->ps32Buffer[u16Pos] = s32Sample;
+		pFilter->s64Sum += (Lint64)s32Sample;
+
+		u16Pos++;
+		if(u16Pos >= pFilter->u16Size)
+		{
+			u16Pos = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+		pFilter->u16Position = u16Pos;
+
+		s32Return = (Lint32)(pFilter->s64Sum / (Lint64)pFilter->u16Fill);
+	}
+	else
+	{
+		//no window
+		s32Return = s32Sample;
+	}
+
+	return s32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Filter a block of samples
+ *
+ * @note
+ * The output may be the input buffer.
+ *
+ * @param[in]		u32Count				Number of samples
+ * @param[out]		*ps32Out					The average after each sample
+ * @param[in]		*ps32In					The samples
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.000.FUNC.009
+ */
+void vSTREAMFILT_MAVG__Block_S32(STREAMFILT__MAVG_S32_T *pFilter, const Lint32 *ps32In, Lint32 *ps32Out, Luint32 u32Count)
+{
+	Luint32 u32Counter;
+
+	for(u32Counter = 0U; u32Counter < u32Count; u32Counter++)
+	{
+		ps32Out[u32Counter] = s32STREAMFILT_MAVG__Add_S32(pFilter, ps32In[u32Counter]);
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Setup a U32 moving average on a caller buffer
+ *
+ * @param[in]		u16Size					Window length, the buffer must hold this many
+ * @param[in]		*pu32Buffer				The window buffer
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.000.FUNC.010
+ */
+void vSTREAMFILT_MAVG__Init_U32(STREAMFILT__MAVG_U32_T *pFilter, Luint32 *pu32Buffer, Luint16 u16Size)
+{
+	Luint16 u16Counter;
+
+	pFilter->pu32Buffer = pu32Buffer;
+	pFilter->u16Size = u16Size;
+	pFilter->u16Position = 0U;
+	pFilter->u16Fill = 0U;
+	pFilter->u64Sum = 0U;
+
+	for(u16Counter = 0U; u16Counter < u16Size; u16Counter++)
+	{
+		pu32Buffer[u16Counter] = 0U;
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Add a sample and return the average of the window
+ *
+ * @param[in]		u32Sample				The new sample
+ * @param[in]		*pFilter				The filter
+ * @return			The average, or the sample if the window length is 0
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.000.FUNC.011
+ */
+Luint32 u32STREAMFILT_MAVG__Add_U32(STREAMFILT__MAVG_U32_T *pFilter, Luint32 u32Sample)
+{
+	Luint32 u32Return;
+	Luint16 u16Pos;
+
+	if(pFilter->u16Size > 0U)
+	{
+		u16Pos = pFilter->u16Position;
+
+		if(pFilter->u16Fill < pFilter->u16Size)
+		{
+			pFilter->u16Fill++;
+		}
+		else
+		{
+			//drop the oldest
+			pFilter->u64Sum -= (Luint64)pFilter->pu32Buffer[u16Pos];
+		}
+
+		pFilter->pu32Buffer[u16Pos] = u32Sample;
+		pFilter->u64Sum += (Luint64)u32Sample;
+
+		u16Pos++;
+		if(u16Pos >= pFilter->u16Size)
+		{
+			u16Pos = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+		pFilter->u16Position = u16Pos;
+
+		u32Return = (Luint32)(pFilter->u64Sum / (Luint64)pFilter->u16Fill);
+	}
+	else
+	{
+		//no window
+		u32Return = u32Sample;
+	}
+
+	return u32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Filter a block of samples
+ *
+ * @note
+ * The output may be the input buffer.
+ *
+ * @param[in]		u32Count				Number of samples
+ * @param[out]		*pu32Out					The average after each sample
+ * @param[in]		*pu32In					The samples
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.000.FUNC.012
+ */
+void vSTREAMFILT_MAVG__Block_U32(STREAMFILT__MAVG_U32_T *pFilter, const Luint32 *pu32In, Luint32 *pu32Out, Luint32 u32Count)
+{
+	Luint32 u32Counter;
+
+	for(u32Counter = 0U; u32Counter < u32Count; u32Counter++)
+	{
+		pu32Out[u32Counter] = u32STREAMFILT_MAVG__Add_U32(pFilter, pu32In[u32Counter]);
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Setup a F32 moving average on a caller buffer
+ *
+ * @param[in]		u16Size					Window length, the buffer must hold this many
+ * @param[in]		*pf32Buffer				The window buffer
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.000.FUNC.013
+ */
+void vSTREAMFILT_MAVG__Init_F32(STREAMFILT__MAVG_F32_T *pFilter, Lfloat32 *pf32Buffer, Luint16 u16Size)
+{
+	Luint16 u16Counter;
+
+	pFilter->pf32Buffer = pf32Buffer;
+	pFilter->u16Size = u16Size;
+	pFilter->u16Position = 0U;
+	pFilter->u16Fill = 0U;
+	pFilter->f64Sum = 0.0;
+
+	for(u16Counter = 0U; u16Counter < u16Size; u16Counter++)
+	{
+		pf32Buffer[u16Counter] = 0.0F;
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Add a sample and return the average of the window
+ *
+ * @param[in]		f32Sample				The new sample
+ * @param[in]		*pFilter				The filter
+ * @return			The average, or the sample if the window length is 0
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.000.FUNC.014
+ */
+Lfloat32 f32STREAMFILT_MAVG__Add_F32(STREAMFILT__MAVG_F32_T *pFilter, Lfloat32 f32Sample)
+{
+	Lfloat32 f32Return;
+	Luint16 u16Pos;
+
+	if(pFilter->u16Size > 0U)
+	{
+		u16Pos = pFilter->u16Position;
+
+		if(pFilter->u16Fill < pFilter->u16Size)
+		{
+			pFilter->u16Fill++;
+		}
+		else
+		{
+			//drop the oldest
+			pFilter->f64Sum -= (Lfloat64)pFilter->pf32Buffer[u16Pos];
+		}
+
+		pFilter->pf32Buffer[u16Pos] = f32Sample;
+		pFilter->f64Sum += (Lfloat64)f32Sample;
+
+		u16Pos++;
+		if(u16Pos >= pFilter->u16Size)
+		{
+			u16Pos = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+		pFilter->u16Position = u16Pos;
+
+		f32Return = (Lfloat32)(pFilter->f64Sum / (Lfloat64)pFilter->u16Fill);
+	}
+	else
+	{
+		//no window
+		f32Return = f32Sample;
+	}
+
+	return f32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Filter a block of samples
+ *
+ * @note
+ * The output may be the input buffer.
+ *
+ * @param[in]		u32Count				Number of samples
+ * @param[out]		*pf32Out					The average after each sample
+ * @param[in]		*pf32In					The samples
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.000.FUNC.015
+ */
+void vSTREAMFILT_MAVG__Block_F32(STREAMFILT__MAVG_F32_T *pFilter, const Lfloat32 *pf32In, Lfloat32 *pf32Out, Luint32 u32Count)
+{
+	Luint32 u32Counter;
+
+	for(u32Counter = 0U; u32Counter < u32Count; u32Counter++)
+	{
+		pf32Out[u32Counter] = f32STREAMFILT_MAVG__Add_F32(pFilter, pf32In[u32Counter]);
+	}
+
+}
+
+
+#endif //#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
@@ -0,0 +1,326 @@
+/**
+ * @file		STREAM_FILTER__MEDIAN.C
+ * @brief		Median of N spike rejection
+ *
+ * @note
+ * The window is kept twice, in arrival order and sorted. Each sample removes
+ * the oldest value from the sorted copy and inserts the new one, one pass of
+ * at most N moves each, rather than sorting the window every sample. Until the
+ * window has filled the median is over the samples seen so far, for an even
+ * count the upper of the two middle values.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM670R0.FILE.002
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup STREAMFILT
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup STREAMFILT__MEDIAN
+ * @ingroup STREAMFILT
+ * @{ */
+
+#include "../stream_filter.h"
+#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+
+
+/***************************************************************************//**
+ * @brief
+ * Setup an S16 median filter
+ *
+ * @param[in]		u8Size					Window length, 1 to C_STREAMFILT__MEDIAN_MAX_SIZE, odd is best
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.002.FUNC.001
+ */
+void vSTREAMFILT_MEDIAN__Init_S16(STREAMFILT__MEDIAN_S16_T *pFilter, Luint8 u8Size)
+{
+	Luint8 u8Counter;
+
+	if(u8Size > C_STREAMFILT__MEDIAN_MAX_SIZE)
+	{
+		pFilter->u8Size = C_STREAMFILT__MEDIAN_MAX_SIZE;
+	}
+	else
+	{
+		if(u8Size == 0U)
+		{
+			pFilter->u8Size = 1U;
+		}
+		else
+		{
+			pFilter->u8Size = u8Size;
+		}
+	}
+
+	for(u8Counter = 0U; u8Counter < C_STREAMFILT__MEDIAN_MAX_SIZE; u8Counter++)
+	{
+		pFilter->s16Ring[u8Counter] = 0;
+		pFilter->s16Sorted[u8Counter] = 0;
+	}
+	pFilter->u8Position = 0U;
+	pFilter->u8Fill = 0U;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Add a sample to an S16 median filter
+ *
+ * @param[in]		s16Sample				The new sample
+ * @param[in]		*pFilter				The filter
+ * @return			The median of the window
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.002.FUNC.002
+ */
+Lint16 s16STREAMFILT_MEDIAN__Add_S16(STREAMFILT__MEDIAN_S16_T *pFilter, Lint16 s16Sample)
+{
+	Luint8 u8Counter;
+	Luint8 u8Hole;
+	Luint8 u8Found;
+	Lint16 s16Oldest;
+
+	if(pFilter->u8Fill < pFilter->u8Size)
+	{
+		//not full, open a hole at the end
+		u8Hole = pFilter->u8Fill;
+		pFilter->u8Fill++;
+	}
+	else
+	{
+		//full, the hole is where the oldest sample sits
+		s16Oldest = pFilter->s16Ring[pFilter->u8Position];
+		u8Hole = 0U;
+		u8Found = 0U;
+		for(u8Counter = 0U; u8Counter < pFilter->u8Fill; u8Counter++)
+		{
+			if((u8Found == 0U) && (pFilter->s16Sorted[u8Counter] == s16Oldest))
+			{
+				u8Hole = u8Counter;
+				u8Found = 1U;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+	}
+
+	//slide the hole down while the value below is bigger
+	while((u8Hole > 0U) && (pFilter->s16Sorted[u8Hole - 1U] > s16Sample))
+	{
+		pFilter->s16Sorted[u8Hole] = pFilter->s16Sorted[u8Hole - 1U];
+		u8Hole--;
+	}
+
+	//slide the hole up while the value above is smaller
+	while(((u8Hole + 1U) < pFilter->u8Fill) && (pFilter->s16Sorted[u8Hole + 1U] < s16Sample))
+	{
+		pFilter->s16Sorted[u8Hole] = pFilter->s16Sorted[u8Hole + 1U];
+		u8Hole++;
+	}
+	pFilter->s16Sorted[u8Hole] = s16Sample;
+
+	pFilter->s16Ring[pFilter->u8Position] = s16Sample;
+	pFilter->u8Position++;
+	if(pFilter->u8Position >= pFilter->u8Size)
+	{
+		pFilter->u8Position = 0U;
+	}
+	else
+	{
+		//fall on
+	}
+
+	return pFilter->s16Sorted[pFilter->u8Fill / 2U];
+}
+
+/***************************************************************************//**
+ * @brief
+ * Filter a block through an S16 median filter
+ *
+ * @param[in]		u32Count				Number of samples
+ * @param[out]		*ps16Out				Filtered samples, may be the input buffer
+ * @param[in]		*ps16In					The samples
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.002.FUNC.003
+ */
+void vSTREAMFILT_MEDIAN__Block_S16(STREAMFILT__MEDIAN_S16_T *pFilter, const Lint16 *ps16In, Lint16 *ps16Out, Luint32 u32Count)
+{
+	Luint32 u32Counter;
+
+	for(u32Counter = 0U; u32Counter < u32Count; u32Counter++)
+	{
+		ps16Out[u32Counter] = s16STREAMFILT_MEDIAN__Add_S16(pFilter, ps16In[u32Counter]);
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Setup an F32 median filter
+ *
+ * @param[in]		u8Size					Window length, 1 to C_STREAMFILT__MEDIAN_MAX_SIZE, odd is best
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.002.FUNC.004
+ */
+void vSTREAMFILT_MEDIAN__Init_F32(STREAMFILT__MEDIAN_F32_T *pFilter, Luint8 u8Size)
+{
+	Luint8 u8Counter;
+
+	if(u8Size > C_STREAMFILT__MEDIAN_MAX_SIZE)
+	{
+		pFilter->u8Size = C_STREAMFILT__MEDIAN_MAX_SIZE;
+	}
+	else
+	{
+		if(u8Size == 0U)
+		{
+			pFilter->u8Size = 1U;
+		}
+		else
+		{
+			pFilter->u8Size = u8Size;
+		}
+	}
+
+	for(u8Counter = 0U; u8Counter < C_STREAMFILT__MEDIAN_MAX_SIZE; u8Counter++)
+	{
+		pFilter->f32Ring[u8Counter] = 0.0F;
+		pFilter->f32Sorted[u8Counter] = 0.0F;
+	}
+	pFilter->u8Position = 0U;
+	pFilter->u8Fill = 0U;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Add a sample to an F32 median filter
+ *
+ * @note
+ * The oldest sample is found by exact compare, it is the same bit pattern that
+ * went in. A NaN will never match, so it is rejected at the input.
+ *
+ * @param[in]		f32Sample				The new sample
+ * @param[in]		*pFilter				The filter
+ * @return			The median of the window
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.002.FUNC.005
+ */
+Lfloat32 f32STREAMFILT_MEDIAN__Add_F32(STREAMFILT__MEDIAN_F32_T *pFilter, Lfloat32 f32Sample)
+{
+	Luint8 u8Counter;
+	Luint8 u8Hole;
+	Luint8 u8Found;
+	Lfloat32 f32Oldest;
+	Lfloat32 f32Return;
+
+	//a NaN is not equal to itself
+	if(f32Sample == f32Sample)
+	{
+		if(pFilter->u8Fill < pFilter->u8Size)
+		{
+			u8Hole = pFilter->u8Fill;
+			pFilter->u8Fill++;
+		}
+		else
+		{
+			f32Oldest = pFilter->f32Ring[pFilter->u8Position];
+			u8Hole = 0U;
+			u8Found = 0U;
+			for(u8Counter = 0U; u8Counter < pFilter->u8Fill; u8Counter++)
+			{
+				if((u8Found == 0U) && (pFilter->f32Sorted[u8Counter] == f32Oldest))
+				{
+					u8Hole = u8Counter;
+					u8Found = 1U;
+				}
+				else
+				{
+					//fall on
+				}
+			}
+		}
+
+		while((u8Hole > 0U) && (pFilter->f32Sorted[u8Hole - 1U] > f32Sample))
+		{
+			pFilter->f32Sorted[u8Hole] = pFilter->f32Sorted[u8Hole - 1U];
+			u8Hole--;
+		}
+
+		while(((u8Hole + 1U) < pFilter->u8Fill) && (pFilter->f32Sorted[u8Hole + 1U] < f32Sample))
+		{
+			pFilter->f32Sorted[u8Hole] = pFilter->f32Sorted[u8Hole + 1U];
+			u8Hole++;
+		}
+		pFilter->f32Sorted[u8Hole] = f32Sample;
+
+		pFilter->f32Ring[pFilter->u8Position] = f32Sample;
+		pFilter->u8Position++;
+		if(pFilter->u8Position >= pFilter->u8Size)
+		{
+			pFilter->u8Position = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	else
+	{
+		//NaN, leave the window alone
+	}
+
+	if(pFilter->u8Fill > 0U)
+	{
+		f32Return = pFilter->f32Sorted[pFilter->u8Fill / 2U];
+	}
+	else
+	{
+		//only NaN's so far
+		f32Return = f32Sample;
+	}
+
+	return f32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Filter a block through an F32 median filter
+ *
+ * @param[in]		u32Count				Number of samples
+ * @param[out]		*pf32Out				Filtered samples, may be the input buffer
+ * @param[in]		*pf32In					The samples
+ * @param[in]		*pFilter				The filter
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.002.FUNC.006
+ */
+void vSTREAMFILT_MEDIAN__Block_F32(STREAMFILT__MEDIAN_F32_T *pFilter, const Lfloat32 *pf32In, Lfloat32 *pf32Out, Luint32 u32Count)
+{
+	Luint32 u32Counter;
+
+	for(u32Counter = 0U; u32Counter < u32Count; u32Counter++)
+	{
+		pf32Out[u32Counter] = f32STREAMFILT_MEDIAN__Add_F32(pFilter, pf32In[u32Counter]);
+	}
+
+}
+
+
+#endif //#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
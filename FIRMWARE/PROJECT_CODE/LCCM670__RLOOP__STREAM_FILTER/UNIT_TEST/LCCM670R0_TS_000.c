@@ -0,0 +1,789 @@
+/**
+ * @file		LCCM670R0_TS_000.C
+ * @brief		Test spec for the streaming filters
+ *
+ * @note
+ * The golden vectors are the NUMERICAL_FILTERING__Add_xxx() results on the same
+ * pseudo random input. Those average over the whole window every sample; the
+ * running sum versions must give the same answer once the window has filled.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM670R0.FILE.004
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM670__ENABLE_TEST_SPEC == 1U
+
+//host side only
+#include <stdio.h>
+
+/** Samples per run */
+#define C_TS000__SAMPLES						(2000U)
+
+/** Longest window tried */
+#define C_TS000__MAX_WINDOW						(64U)
+
+/** 50Hz low pass at 1kHz, Q = 0.707 */
+#define C_TS000__LP_B0							(0.0200833310F)
+#define C_TS000__LP_B1							(0.0401666621F)
+#define C_TS000__LP_B2							(0.0200833310F)
+#define C_TS000__LP_A1							(-1.5610153913F)
+#define C_TS000__LP_A2							(0.6413487154F)
+
+void vLCCM670R0_TS_000_TCASE_001(void);
+void vLCCM670R0_TS_000_TCASE_002(void);
+void vLCCM670R0_TS_000_TCASE_003(void);
+void vLCCM670R0_TS_000_TCASE_004(void);
+void vLCCM670R0_TS_000_TCASE_005(void);
+static Luint32 u32TS000__Rand(void);
+static void vTS000__Result(Luint32 u32Fail, const char *pcCase);
+
+static struct
+{
+	Luint32 u32Rand;
+
+	Lint16 s16In[C_TS000__SAMPLES];
+	Lint16 s16Out[C_TS000__SAMPLES];
+	Lfloat32 f32In[C_TS000__SAMPLES];
+	Lfloat32 f32Out[C_TS000__SAMPLES];
+
+	/** Legacy filter arrays */
+	Lint16 s16Legacy[C_TS000__MAX_WINDOW];
+	Luint16 u16Legacy[C_TS000__MAX_WINDOW];
+	Lint32 s32Legacy[C_TS000__MAX_WINDOW];
+	Luint32 u32Legacy[C_TS000__MAX_WINDOW];
+	Lfloat32 f32Legacy[C_TS000__MAX_WINDOW];
+
+	/** Running sum windows */
+	Lint16 s16Window[C_TS000__MAX_WINDOW];
+	Luint16 u16Window[C_TS000__MAX_WINDOW];
+	Lint32 s32Window[C_TS000__MAX_WINDOW];
+	Luint32 u32Window[C_TS000__MAX_WINDOW];
+	Lfloat32 f32Window[C_TS000__MAX_WINDOW];
+
+}sTS000;
+
+/** Window lengths tried against the legacy filters */
+static const Luint16 u16TS000__Windows[] = {1U, 2U, 8U, 33U, 64U};
+
+//Function to call the tests for this test specification
+void vLCCM670R0_TS_000(void)
+{
+	sTS000.u32Rand = 0x1234567U;
+
+	//Call the test cases
+	vLCCM670R0_TS_000_TCASE_001();
+	vLCCM670R0_TS_000_TCASE_002();
+	vLCCM670R0_TS_000_TCASE_003();
+	vLCCM670R0_TS_000_TCASE_004();
+	vLCCM670R0_TS_000_TCASE_005();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM670R0.TS.000.TCASE.001
+ * @st_test_desc
+ * Each running sum moving average against the legacy filter of the same type
+ * and window, full scale random input. Once the window is full the integer
+ * types must match exactly and F32 to within 1 part in 10^5 of full scale.
+ *
+*/
+void vLCCM670R0_TS_000_TCASE_001(void)
+{
+	char cText[200];
+	Luint32 u32Fail;
+	Luint32 u32Compared;
+	Luint32 u32Counter;
+	Luint8 u8Window;
+	Luint16 u16Size;
+	Luint16 u16Count[5];
+	Luint32 u32Sample;
+	Lfloat32 f32A;
+	Lfloat32 f32B;
+	STREAMFILT__MAVG_S16_T sS16;
+	STREAMFILT__MAVG_U16_T sU16;
+	STREAMFILT__MAVG_S32_T sS32;
+	STREAMFILT__MAVG_U32_T sU32;
+	STREAMFILT__MAVG_F32_T sF32;
+
+	DEBUG_PRINT("START:LCCM670R0.TS.000.TCASE.001\r\n");
+
+	u32Fail = 0U;
+	u32Compared = 0U;
+	for(u8Window = 0U; u8Window < (Luint8)(sizeof(u16TS000__Windows) / sizeof(u16TS000__Windows[0])); u8Window++)
+	{
+		u16Size = u16TS000__Windows[u8Window];
+
+		//the legacy filters average the whole array, start it clear
+		for(u32Counter = 0U; u32Counter < C_TS000__MAX_WINDOW; u32Counter++)
+		{
+			sTS000.s16Legacy[u32Counter] = 0;
+			sTS000.u16Legacy[u32Counter] = 0U;
+			sTS000.s32Legacy[u32Counter] = 0;
+			sTS000.u32Legacy[u32Counter] = 0U;
+			sTS000.f32Legacy[u32Counter] = 0.0F;
+		}
+		for(u32Counter = 0U; u32Counter < 5U; u32Counter++)
+		{
+			u16Count[u32Counter] = 0U;
+		}
+
+		vSTREAMFILT_MAVG__Init_S16(&sS16, &sTS000.s16Window[0], u16Size);
+		vSTREAMFILT_MAVG__Init_U16(&sU16, &sTS000.u16Window[0], u16Size);
+		vSTREAMFILT_MAVG__Init_S32(&sS32, &sTS000.s32Window[0], u16Size);
+		vSTREAMFILT_MAVG__Init_U32(&sU32, &sTS000.u32Window[0], u16Size);
+		vSTREAMFILT_MAVG__Init_F32(&sF32, &sTS000.f32Window[0], u16Size);
+
+		for(u32Counter = 0U; u32Counter < C_TS000__SAMPLES; u32Counter++)
+		{
+			u32Sample = u32TS000__Rand();
+
+			if(s16STREAMFILT_MAVG__Add_S16(&sS16, (Lint16)(u32Sample & 0xFFFFU)) !=
+				s16NUMERICAL_FILTERING__Add_S16((Lint16)(u32Sample & 0xFFFFU), &u16Count[0], u16Size, &sTS000.s16Legacy[0]))
+			{
+				if(u32Counter >= (Luint32)(u16Size - 1U))
+				{
+					u32Fail++;
+				}
+				else
+				{
+					//still filling
+				}
+			}
+			else
+			{
+				//same
+			}
+
+			if(u16STREAMFILT_MAVG__Add_U16(&sU16, (Luint16)(u32Sample >> 16U)) !=
+				u16NUMERICAL_FILTERING__Add_U16((Luint16)(u32Sample >> 16U), &u16Count[1], u16Size, &sTS000.u16Legacy[0]))
+			{
+				if(u32Counter >= (Luint32)(u16Size - 1U))
+				{
+					u32Fail++;
+				}
+				else
+				{
+					//still filling
+				}
+			}
+			else
+			{
+				//same
+			}
+
+			//keep the 32 bit sums inside what the legacy filters can hold
+			if(s32STREAMFILT_MAVG__Add_S32(&sS32, (Lint32)u32Sample / 256) !=
+				s32NUMERICAL_FILTERING__Add_S32((Lint32)u32Sample / 256, &u16Count[2], u16Size, &sTS000.s32Legacy[0]))
+			{
+				if(u32Counter >= (Luint32)(u16Size - 1U))
+				{
+					u32Fail++;
+				}
+				else
+				{
+					//still filling
+				}
+			}
+			else
+			{
+				//same
+			}
+
+			if(u32STREAMFILT_MAVG__Add_U32(&sU32, u32Sample >> 8U) !=
+				u32NUMERICAL_FILTERING__Add_U32(u32Sample >> 8U, &u16Count[3], u16Size, &sTS000.u32Legacy[0]))
+			{
+				if(u32Counter >= (Luint32)(u16Size - 1U))
+				{
+					u32Fail++;
+				}
+				else
+				{
+					//still filling
+				}
+			}
+			else
+			{
+				//same
+			}
+
+			f32A = f32STREAMFILT_MAVG__Add_F32(&sF32, (Lfloat32)(Lint16)(u32Sample & 0xFFFFU));
+			f32B = f32NUMERICAL_FILTERING__Add_F32((Lfloat32)(Lint16)(u32Sample & 0xFFFFU), &u16Count[4], u16Size, &sTS000.f32Legacy[0]);
+			if(((f32A - f32B) > 0.33F) || ((f32B - f32A) > 0.33F))
+			{
+				if(u32Counter >= (Luint32)(u16Size - 1U))
+				{
+					u32Fail++;
+				}
+				else
+				{
+					//still filling
+				}
+			}
+			else
+			{
+				//same
+			}
+
+			if(u32Counter >= (Luint32)(u16Size - 1U))
+			{
+				u32Compared += 5U;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+	}
+
+	sprintf(cText, "INFO: %u compared, %u mismatches\r\n", u32Compared, u32Fail);
+	DEBUG_PRINT(cText);
+
+	vTS000__Result(u32Fail, "LCCM670R0.TS.000.TCASE.001");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM670R0.TS.000.TCASE.002
+ * @st_test_desc
+ * The block calls must give the same output as the same samples one at a time,
+ * including when the output is written over the input.
+ *
+*/
+void vLCCM670R0_TS_000_TCASE_002(void)
+{
+	Luint32 u32Fail;
+	Luint32 u32Counter;
+	Lfloat32 f32B[3];
+	Lfloat32 f32A[2];
+	STREAMFILT__MAVG_S16_T sMavg[2];
+	STREAMFILT__EMA_S16_T sEma[2];
+	STREAMFILT__BIQUAD_S16_T sBiquad[2];
+	STREAMFILT__BIQUAD_F32_T sBiquadF[2];
+	STREAMFILT__MEDIAN_S16_T sMedian[2];
+	STREAMFILT__MEDIAN_F32_T sMedianF[2];
+	Lint16 s16Window[2][16];
+
+	DEBUG_PRINT("START:LCCM670R0.TS.000.TCASE.002\r\n");
+
+	f32B[0] = C_TS000__LP_B0;
+	f32B[1] = C_TS000__LP_B1;
+	f32B[2] = C_TS000__LP_B2;
+	f32A[0] = C_TS000__LP_A1;
+	f32A[1] = C_TS000__LP_A2;
+
+	for(u32Counter = 0U; u32Counter < C_TS000__SAMPLES; u32Counter++)
+	{
+		sTS000.s16In[u32Counter] = (Lint16)(u32TS000__Rand() & 0x3FFFU);
+	}
+
+	u32Fail = 0U;
+
+	//moving average, in place
+	vSTREAMFILT_MAVG__Init_S16(&sMavg[0], &s16Window[0][0], 16U);
+	vSTREAMFILT_MAVG__Init_S16(&sMavg[1], &s16Window[1][0], 16U);
+	for(u32Counter = 0U; u32Counter < C_TS000__SAMPLES; u32Counter++)
+	{
+		sTS000.s16Out[u32Counter] = sTS000.s16In[u32Counter];
+	}
+	vSTREAMFILT_MAVG__Block_S16(&sMavg[0], &sTS000.s16Out[0], &sTS000.s16Out[0], C_TS000__SAMPLES);
+	for(u32Counter = 0U; u32Counter < C_TS000__SAMPLES; u32Counter++)
+	{
+		if(sTS000.s16Out[u32Counter] != s16STREAMFILT_MAVG__Add_S16(&sMavg[1], sTS000.s16In[u32Counter]))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//same
+		}
+	}
+
+	//exponential
+	vSTREAMFILT_EMA__Init_S16(&sEma[0], 1000);
+	vSTREAMFILT_EMA__Init_S16(&sEma[1], 1000);
+	vSTREAMFILT_EMA__Block_S16(&sEma[0], &sTS000.s16In[0], &sTS000.s16Out[0], C_TS000__SAMPLES);
+	for(u32Counter = 0U; u32Counter < C_TS000__SAMPLES; u32Counter++)
+	{
+		if(sTS000.s16Out[u32Counter] != s16STREAMFILT_EMA__Add_S16(&sEma[1], sTS000.s16In[u32Counter]))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//same
+		}
+	}
+
+	//biquad, the float block keeps its states local so check it bit for bit
+	(void)s16STREAMFILT_BIQUAD__Init_S16(&sBiquad[0], &f32B[0], &f32A[0]);
+	(void)s16STREAMFILT_BIQUAD__Init_S16(&sBiquad[1], &f32B[0], &f32A[0]);
+	vSTREAMFILT_BIQUAD__Block_S16(&sBiquad[0], &sTS000.s16In[0], &sTS000.s16Out[0], C_TS000__SAMPLES);
+	vSTREAMFILT_BIQUAD__Init_F32(&sBiquadF[0], &f32B[0], &f32A[0]);
+	vSTREAMFILT_BIQUAD__Init_F32(&sBiquadF[1], &f32B[0], &f32A[0]);
+	for(u32Counter = 0U; u32Counter < C_TS000__SAMPLES; u32Counter++)
+	{
+		sTS000.f32In[u32Counter] = (Lfloat32)sTS000.s16In[u32Counter];
+	}
+	//split the block to check the states carry over
+	vSTREAMFILT_BIQUAD__Block_F32(&sBiquadF[0], &sTS000.f32In[0], &sTS000.f32Out[0], 777U);
+	vSTREAMFILT_BIQUAD__Block_F32(&sBiquadF[0], &sTS000.f32In[777], &sTS000.f32Out[777], C_TS000__SAMPLES - 777U);
+	for(u32Counter = 0U; u32Counter < C_TS000__SAMPLES; u32Counter++)
+	{
+		if(sTS000.s16Out[u32Counter] != s16STREAMFILT_BIQUAD__Add_S16(&sBiquad[1], sTS000.s16In[u32Counter]))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//same
+		}
+		if(sTS000.f32Out[u32Counter] != f32STREAMFILT_BIQUAD__Add_F32(&sBiquadF[1], sTS000.f32In[u32Counter]))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//same
+		}
+	}
+
+	//median
+	vSTREAMFILT_MEDIAN__Init_S16(&sMedian[0], 7U);
+	vSTREAMFILT_MEDIAN__Init_S16(&sMedian[1], 7U);
+	vSTREAMFILT_MEDIAN__Block_S16(&sMedian[0], &sTS000.s16In[0], &sTS000.s16Out[0], C_TS000__SAMPLES);
+	vSTREAMFILT_MEDIAN__Init_F32(&sMedianF[0], 7U);
+	vSTREAMFILT_MEDIAN__Init_F32(&sMedianF[1], 7U);
+	vSTREAMFILT_MEDIAN__Block_F32(&sMedianF[0], &sTS000.f32In[0], &sTS000.f32Out[0], C_TS000__SAMPLES);
+	for(u32Counter = 0U; u32Counter < C_TS000__SAMPLES; u32Counter++)
+	{
+		if(sTS000.s16Out[u32Counter] != s16STREAMFILT_MEDIAN__Add_S16(&sMedian[1], sTS000.s16In[u32Counter]))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//same
+		}
+		if(sTS000.f32Out[u32Counter] != f32STREAMFILT_MEDIAN__Add_F32(&sMedianF[1], sTS000.f32In[u32Counter]))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//same
+		}
+	}
+
+	vTS000__Result(u32Fail, "LCCM670R0.TS.000.TCASE.002");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM670R0.TS.000.TCASE.003
+ * @st_test_desc
+ * Exponential step response. With alpha = 0.01 the Q15 filter must rise
+ * without overshoot, settle on the step exactly, and stay within 1 LSB of the
+ * float filter all the way up and all the way back down.
+ *
+*/
+void vLCCM670R0_TS_000_TCASE_003(void)
+{
+	char cText[200];
+	Luint32 u32Fail;
+	Luint32 u32Counter;
+	Lint16 s16In;
+	Lint16 s16Out;
+	Lint16 s16Last;
+	Lfloat32 f32Out;
+	Lfloat32 f32Diff;
+	Lfloat32 f32Worst;
+	STREAMFILT__EMA_S16_T sEma;
+	STREAMFILT__EMA_F32_T sEmaF;
+
+	DEBUG_PRINT("START:LCCM670R0.TS.000.TCASE.003\r\n");
+
+	vSTREAMFILT_EMA__Init_S16(&sEma, 328);
+	vSTREAMFILT_EMA__Init_F32(&sEmaF, 328.0F / 32768.0F);
+
+	u32Fail = 0U;
+	f32Worst = 0.0F;
+	s16Last = -1000;
+	for(u32Counter = 0U; u32Counter < 8000U; u32Counter++)
+	{
+		//-1000 for one sample to prime, up to +1000, back to -1000 half way
+		if((u32Counter == 0U) || (u32Counter >= 4000U))
+		{
+			s16In = -1000;
+		}
+		else
+		{
+			s16In = 1000;
+		}
+
+		s16Out = s16STREAMFILT_EMA__Add_S16(&sEma, s16In);
+		f32Out = f32STREAMFILT_EMA__Add_F32(&sEmaF, (Lfloat32)s16In);
+
+		f32Diff = (Lfloat32)s16Out - f32Out;
+		if(f32Diff < 0.0F)
+		{
+			f32Diff = -f32Diff;
+		}
+		else
+		{
+			//fall on
+		}
+		if(f32Diff > f32Worst)
+		{
+			f32Worst = f32Diff;
+		}
+		else
+		{
+			//fall on
+		}
+
+		//no overshoot, no going backwards
+		if((s16Out > 1000) || (s16Out < -1000))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+		if(((u32Counter < 4000U) && (s16Out < s16Last)) || ((u32Counter >= 4000U) && (s16Out > s16Last)))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+		s16Last = s16Out;
+
+		//settled exactly
+		if(((u32Counter == 3999U) && (s16Out != 1000)) || ((u32Counter == 7999U) && (s16Out != -1000)))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	if(f32Worst > 1.0F)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	sprintf(cText, "INFO: worst Q15 to float %f LSB\r\n", f32Worst);
+	DEBUG_PRINT(cText);
+
+	vTS000__Result(u32Fail, "LCCM670R0.TS.000.TCASE.003");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM670R0.TS.000.TCASE.004
+ * @st_test_desc
+ * 50Hz low pass biquad. Both versions must settle on a DC input, the Q14
+ * version must track the float version on noise, and a full scale square wave
+ * must saturate rather than wrap.
+ *
+*/
+void vLCCM670R0_TS_000_TCASE_004(void)
+{
+	char cText[200];
+	Luint32 u32Fail;
+	Luint32 u32Counter;
+	Lint16 s16In;
+	Lint16 s16Out;
+	Lfloat32 f32Out;
+	Lfloat32 f32Diff;
+	Lfloat32 f32Worst;
+	Lfloat32 f32B[3];
+	Lfloat32 f32A[2];
+	STREAMFILT__BIQUAD_S16_T sBiquad;
+	STREAMFILT__BIQUAD_F32_T sBiquadF;
+
+	DEBUG_PRINT("START:LCCM670R0.TS.000.TCASE.004\r\n");
+
+	f32B[0] = C_TS000__LP_B0;
+	f32B[1] = C_TS000__LP_B1;
+	f32B[2] = C_TS000__LP_B2;
+	f32A[0] = C_TS000__LP_A1;
+	f32A[1] = C_TS000__LP_A2;
+
+	u32Fail = 0U;
+	if(s16STREAMFILT_BIQUAD__Init_S16(&sBiquad, &f32B[0], &f32A[0]) != 0)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	vSTREAMFILT_BIQUAD__Init_F32(&sBiquadF, &f32B[0], &f32A[0]);
+
+	//DC
+	s16Out = 0;
+	f32Out = 0.0F;
+	for(u32Counter = 0U; u32Counter < 500U; u32Counter++)
+	{
+		s16Out = s16STREAMFILT_BIQUAD__Add_S16(&sBiquad, 12345);
+		f32Out = f32STREAMFILT_BIQUAD__Add_F32(&sBiquadF, 12345.0F);
+	}
+	if((s16Out != 12345) || (f32Out < 12344.9F) || (f32Out > 12345.1F))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//noise around the DC, same states
+	f32Worst = 0.0F;
+	for(u32Counter = 0U; u32Counter < C_TS000__SAMPLES; u32Counter++)
+	{
+		s16In = (Lint16)((Lint32)(u32TS000__Rand() & 0x3FFFU) - 8192);
+		s16Out = s16STREAMFILT_BIQUAD__Add_S16(&sBiquad, s16In);
+		f32Out = f32STREAMFILT_BIQUAD__Add_F32(&sBiquadF, (Lfloat32)s16In);
+		f32Diff = (Lfloat32)s16Out - f32Out;
+		if(f32Diff < 0.0F)
+		{
+			f32Diff = -f32Diff;
+		}
+		else
+		{
+			//fall on
+		}
+		if(f32Diff > f32Worst)
+		{
+			f32Worst = f32Diff;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	//a few LSB for the quantised coefficients and rounding
+	if(f32Worst > 8.0F)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	sprintf(cText, "INFO: worst Q14 to float %f LSB\r\n", f32Worst);
+	DEBUG_PRINT(cText);
+
+	//full scale square wave, the overshoot must clip at the rails
+	for(u32Counter = 0U; u32Counter < 1000U; u32Counter++)
+	{
+		if(((u32Counter / 100U) & 1U) == 0U)
+		{
+			s16In = 32767;
+		}
+		else
+		{
+			s16In = -32768;
+		}
+		s16Out = s16STREAMFILT_BIQUAD__Add_S16(&sBiquad, s16In);
+
+		//20 samples after an edge the output must be well on the new side
+		if((u32Counter % 100U) >= 20U)
+		{
+			if(((s16In > 0) && (s16Out < 16384)) || ((s16In < 0) && (s16Out > -16384)))
+			{
+				u32Fail++;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	vTS000__Result(u32Fail, "LCCM670R0.TS.000.TCASE.004");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM670R0.TS.000.TCASE.005
+ * @st_test_desc
+ * Median of 5. Single and double sample spikes on a slow ramp must never reach
+ * the output, and on random data the result must match a full sort of the
+ * window every sample.
+ *
+*/
+void vLCCM670R0_TS_000_TCASE_005(void)
+{
+	Luint32 u32Fail;
+	Luint32 u32Counter;
+	Luint32 u32Sort;
+	Luint32 u32Inner;
+	Lint16 s16In;
+	Lint16 s16Out;
+	Lint16 s16Temp;
+	Lint16 s16Sorted[5];
+	Luint32 u32Fill;
+	STREAMFILT__MEDIAN_S16_T sMedian;
+	STREAMFILT__MEDIAN_F32_T sMedianF;
+
+	DEBUG_PRINT("START:LCCM670R0.TS.000.TCASE.005\r\n");
+
+	u32Fail = 0U;
+
+	//spikes
+	vSTREAMFILT_MEDIAN__Init_S16(&sMedian, 5U);
+	vSTREAMFILT_MEDIAN__Init_F32(&sMedianF, 5U);
+	for(u32Counter = 0U; u32Counter < C_TS000__SAMPLES; u32Counter++)
+	{
+		if((u32Counter % 11U) == 5U)
+		{
+			s16In = 30000;
+		}
+		else
+		{
+			if(((u32Counter % 17U) == 3U) || ((u32Counter % 17U) == 4U))
+			{
+				s16In = -30000;
+			}
+			else
+			{
+				s16In = (Lint16)(u32Counter / 4U);
+			}
+		}
+
+		s16Out = s16STREAMFILT_MEDIAN__Add_S16(&sMedian, s16In);
+		if((s16Out > 1000) || (s16Out < 0))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+		if(f32STREAMFILT_MEDIAN__Add_F32(&sMedianF, (Lfloat32)s16In) != (Lfloat32)s16Out)
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	//random with plenty of ties, against a full sort
+	vSTREAMFILT_MEDIAN__Init_S16(&sMedian, 5U);
+	for(u32Counter = 0U; u32Counter < C_TS000__SAMPLES; u32Counter++)
+	{
+		sTS000.s16In[u32Counter] = (Lint16)((Lint32)(u32TS000__Rand() % 21U) - 10);
+		s16Out = s16STREAMFILT_MEDIAN__Add_S16(&sMedian, sTS000.s16In[u32Counter]);
+
+		if(u32Counter < 4U)
+		{
+			u32Fill = u32Counter + 1U;
+		}
+		else
+		{
+			u32Fill = 5U;
+		}
+		for(u32Sort = 0U; u32Sort < u32Fill; u32Sort++)
+		{
+			s16Sorted[u32Sort] = sTS000.s16In[(u32Counter + 1U) - u32Fill + u32Sort];
+		}
+		for(u32Sort = 1U; u32Sort < u32Fill; u32Sort++)
+		{
+			for(u32Inner = u32Sort; (u32Inner > 0U) && (s16Sorted[u32Inner - 1U] > s16Sorted[u32Inner]); u32Inner--)
+			{
+				s16Temp = s16Sorted[u32Inner];
+				s16Sorted[u32Inner] = s16Sorted[u32Inner - 1U];
+				s16Sorted[u32Inner - 1U] = s16Temp;
+			}
+		}
+
+		if(s16Out != s16Sorted[u32Fill / 2U])
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	vTS000__Result(u32Fail, "LCCM670R0.TS.000.TCASE.005");
+}
+
+/***************************************************************************//**
+ * @brief
+ * Print the result of a test case
+ *
+ * @param[in]		*pcCase					The test case ID
+ * @param[in]		u32Fail					Number of failures
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.004.FUNC.001
+ */
+static void vTS000__Result(Luint32 u32Fail, const char *pcCase)
+{
+	char cText[200];
+
+	if(u32Fail == 0U)
+	{
+		sprintf(cText, "PASS:%s\r\n", pcCase);
+	}
+	else
+	{
+		sprintf(cText, "FAIL:%s (%u)\r\n", pcCase, u32Fail);
+	}
+	DEBUG_PRINT(cText);
+
+	sprintf(cText, "END:%s\r\n", pcCase);
+	DEBUG_PRINT(cText);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Repeatable pseudo random numbers, xorshift32
+ *
+ * @return			The next number
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.004.FUNC.002
+ */
+static Luint32 u32TS000__Rand(void)
+{
+	Luint32 u32X;
+
+	u32X = sTS000.u32Rand;
+	u32X ^= u32X << 13U;
+	u32X ^= u32X >> 17U;
+	u32X ^= u32X << 5U;
+	sTS000.u32Rand = u32X;
+
+	return u32X;
+}
+
+#endif //#if C_LOCALDEF__LCCM670__ENABLE_TEST_SPEC == 1U
+#endif //#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
@@ -0,0 +1,304 @@
+/**
+ * @file		LCCM670R0_TS_001.C
+ * @brief		Host benchmark for the streaming filters
+ *
+ * @note
+ * Host side. Reports the cost per sample of each filter against the legacy
+ * NUMERICAL_FILTERING__Add_xxx() averages at a few window lengths. On x86 the
+ * time stamp counter is read so the figures are cycles, anywhere else clock()
+ * is used and the figures are nanoseconds. The host figures rank the filters
+ * and show the scaling with window length, they are not RM4 cycle counts.
+ *
+ * The only pass/fail is the scaling: the running sum average at the longest
+ * window must cost less than twice what it costs at the shortest.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM670R0.FILE.005
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM670__ENABLE_TEST_SPEC == 1U
+
+//host side only
+#include <stdio.h>
+#if defined(_MSC_VER)
+	#include <intrin.h>
+	#define M_TS001__NOW()						((Luint64)__rdtsc())
+	#define C_TS001__UNITS						"cycles"
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#include <x86intrin.h>
+	#define M_TS001__NOW()						((Luint64)__rdtsc())
+	#define C_TS001__UNITS						"cycles"
+#else
+	#include <time.h>
+	#define M_TS001__NOW()						((Luint64)clock() * (1000000000U / CLOCKS_PER_SEC))
+	#define C_TS001__UNITS						"ns"
+#endif
+
+/** Samples per timed run */
+#define C_TS001__SAMPLES						(4096U)
+
+/** Timed runs, the fastest is kept */
+#define C_TS001__RUNS							(20U)
+
+/** Longest window */
+#define C_TS001__MAX_WINDOW						(256U)
+
+typedef enum
+{
+	TS001__LEGACY_S16 = 0U,
+	TS001__LEGACY_F32,
+	TS001__MAVG_S16,
+	TS001__MAVG_F32,
+	TS001__EMA_S16,
+	TS001__EMA_F32,
+	TS001__BIQUAD_S16,
+	TS001__BIQUAD_F32,
+	TS001__MEDIAN_S16,
+	TS001__MEDIAN_F32,
+	TS001__MAX
+
+}TS001__FILTER_E;
+
+void vLCCM670R0_TS_001_TCASE_001(void);
+static Lfloat32 f32TS001__Time(TS001__FILTER_E eFilter, Luint16 u16Window);
+
+static const char * const cTS001__Names[TS001__MAX] =
+{
+	"legacy S16", "legacy F32", "mavg S16", "mavg F32", "ema S16", "ema F32",
+	"biquad S16", "biquad F32", "median S16", "median F32"
+};
+
+/** Window lengths, the median is limited to C_STREAMFILT__MEDIAN_MAX_SIZE */
+static const Luint16 u16TS001__Windows[] = {8U, 64U, 256U};
+
+static struct
+{
+	Lint16 s16In[C_TS001__SAMPLES];
+	Lint16 s16Out[C_TS001__SAMPLES];
+	Lfloat32 f32In[C_TS001__SAMPLES];
+	Lfloat32 f32Out[C_TS001__SAMPLES];
+	Lint16 s16Window[C_TS001__MAX_WINDOW];
+	Lfloat32 f32Window[C_TS001__MAX_WINDOW];
+
+	/** Stops the compiler dropping the legacy calls */
+	volatile Luint32 u32Sink;
+
+}sTS001;
+
+//Function to call the tests for this test specification
+void vLCCM670R0_TS_001(void)
+{
+	//Call the test cases
+	vLCCM670R0_TS_001_TCASE_001();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM670R0.TS.001.TCASE.001
+ * @st_test_desc
+ * Cost per sample of every filter at each window length.
+ *
+*/
+void vLCCM670R0_TS_001_TCASE_001(void)
+{
+	char cText[200];
+	Luint32 u32Counter;
+	Luint32 u32Rand;
+	Luint8 u8Window;
+	Luint8 u8Filter;
+	Lfloat32 f32Cost[3];
+	Lfloat32 f32Short;
+	Lfloat32 f32Long;
+
+	DEBUG_PRINT("START:LCCM670R0.TS.001.TCASE.001\r\n");
+
+	f32Short = 0.0F;
+	f32Long = 0.0F;
+	u32Rand = 0x2468ACEU;
+	for(u32Counter = 0U; u32Counter < C_TS001__SAMPLES; u32Counter++)
+	{
+		u32Rand = (u32Rand * 1103515245U) + 12345U;
+		sTS001.s16In[u32Counter] = (Lint16)((u32Rand >> 16U) & 0x3FFFU);
+		sTS001.f32In[u32Counter] = (Lfloat32)sTS001.s16In[u32Counter];
+	}
+
+	sprintf(cText, "INFO: %s per sample, windows %u / %u / %u\r\n", C_TS001__UNITS,
+			u16TS001__Windows[0], u16TS001__Windows[1], u16TS001__Windows[2]);
+	DEBUG_PRINT(cText);
+
+	for(u8Filter = 0U; u8Filter < (Luint8)TS001__MAX; u8Filter++)
+	{
+		for(u8Window = 0U; u8Window < 3U; u8Window++)
+		{
+			f32Cost[u8Window] = f32TS001__Time((TS001__FILTER_E)u8Filter, u16TS001__Windows[u8Window]);
+		}
+
+		sprintf(cText, "INFO: %-12s %8.1f %8.1f %8.1f\r\n", cTS001__Names[u8Filter],
+				(Lfloat64)f32Cost[0], (Lfloat64)f32Cost[1], (Lfloat64)f32Cost[2]);
+		DEBUG_PRINT(cText);
+
+		if(u8Filter == (Luint8)TS001__MAVG_S16)
+		{
+			f32Short = f32Cost[0];
+			f32Long = f32Cost[2];
+		}
+		else
+		{
+			//report only
+		}
+	}
+
+	if(f32Long < (2.0F * f32Short))
+	{
+		DEBUG_PRINT("PASS:LCCM670R0.TS.001.TCASE.001\r\n");
+	}
+	else
+	{
+		DEBUG_PRINT("FAIL:LCCM670R0.TS.001.TCASE.001\r\n");
+	}
+
+	DEBUG_PRINT("END:LCCM670R0.TS.001.TCASE.001\r\n");
+}
+
+/***************************************************************************//**
+ * @brief
+ * Time one filter, best of C_TS001__RUNS
+ *
+ * @param[in]		u16Window				Window length where the filter has one
+ * @param[in]		eFilter					The filter
+ * @return			Cost per sample
+ * @st_funcMD5
+ * @st_funcID		LCCM670R0.FILE.005.FUNC.001
+ */
+static Lfloat32 f32TS001__Time(TS001__FILTER_E eFilter, Luint16 u16Window)
+{
+	Luint32 u32Run;
+	Luint32 u32Counter;
+	Luint16 u16Count;
+	Luint64 u64Start;
+	Luint64 u64Time;
+	Luint64 u64Best;
+	Lfloat32 f32B[3];
+	Lfloat32 f32A[2];
+	Luint8 u8Median;
+	STREAMFILT__MAVG_S16_T sMavg;
+	STREAMFILT__MAVG_F32_T sMavgF;
+	STREAMFILT__EMA_S16_T sEma;
+	STREAMFILT__EMA_F32_T sEmaF;
+	STREAMFILT__BIQUAD_S16_T sBiquad;
+	STREAMFILT__BIQUAD_F32_T sBiquadF;
+	STREAMFILT__MEDIAN_S16_T sMedian;
+	STREAMFILT__MEDIAN_F32_T sMedianF;
+
+	f32B[0] = 0.0200833F;
+	f32B[1] = 0.0401667F;
+	f32B[2] = 0.0200833F;
+	f32A[0] = -1.5610154F;
+	f32A[1] = 0.6413487F;
+
+	if(u16Window > C_STREAMFILT__MEDIAN_MAX_SIZE)
+	{
+		u8Median = C_STREAMFILT__MEDIAN_MAX_SIZE;
+	}
+	else
+	{
+		u8Median = (Luint8)u16Window;
+	}
+
+	u64Best = 0xFFFFFFFFFFFFFFFFULL;
+	for(u32Run = 0U; u32Run < C_TS001__RUNS; u32Run++)
+	{
+		//set up outside the timing
+		for(u32Counter = 0U; u32Counter < C_TS001__MAX_WINDOW; u32Counter++)
+		{
+			sTS001.s16Window[u32Counter] = 0;
+			sTS001.f32Window[u32Counter] = 0.0F;
+		}
+		u16Count = 0U;
+		vSTREAMFILT_MAVG__Init_S16(&sMavg, &sTS001.s16Window[0], u16Window);
+		vSTREAMFILT_MAVG__Init_F32(&sMavgF, &sTS001.f32Window[0], u16Window);
+		vSTREAMFILT_EMA__Init_S16(&sEma, 1000);
+		vSTREAMFILT_EMA__Init_F32(&sEmaF, 0.03F);
+		(void)s16STREAMFILT_BIQUAD__Init_S16(&sBiquad, &f32B[0], &f32A[0]);
+		vSTREAMFILT_BIQUAD__Init_F32(&sBiquadF, &f32B[0], &f32A[0]);
+		vSTREAMFILT_MEDIAN__Init_S16(&sMedian, u8Median);
+		vSTREAMFILT_MEDIAN__Init_F32(&sMedianF, u8Median);
+
+		u64Start = M_TS001__NOW();
+		switch(eFilter)
+		{
+			case TS001__LEGACY_S16:
+				for(u32Counter = 0U; u32Counter < C_TS001__SAMPLES; u32Counter++)
+				{
+					sTS001.u32Sink += (Luint32)(Lint32)s16NUMERICAL_FILTERING__Add_S16(sTS001.s16In[u32Counter], &u16Count, u16Window, &sTS001.s16Window[0]);
+				}
+				break;
+
+			case TS001__LEGACY_F32:
+				for(u32Counter = 0U; u32Counter < C_TS001__SAMPLES; u32Counter++)
+				{
+					sTS001.u32Sink += (Luint32)(Lint32)f32NUMERICAL_FILTERING__Add_F32(sTS001.f32In[u32Counter], &u16Count, u16Window, &sTS001.f32Window[0]);
+				}
+				break;
+
+			case TS001__MAVG_S16:
+				vSTREAMFILT_MAVG__Block_S16(&sMavg, &sTS001.s16In[0], &sTS001.s16Out[0], C_TS001__SAMPLES);
+				break;
+
+			case TS001__MAVG_F32:
+				vSTREAMFILT_MAVG__Block_F32(&sMavgF, &sTS001.f32In[0], &sTS001.f32Out[0], C_TS001__SAMPLES);
+				break;
+
+			case TS001__EMA_S16:
+				vSTREAMFILT_EMA__Block_S16(&sEma, &sTS001.s16In[0], &sTS001.s16Out[0], C_TS001__SAMPLES);
+				break;
+
+			case TS001__EMA_F32:
+				vSTREAMFILT_EMA__Block_F32(&sEmaF, &sTS001.f32In[0], &sTS001.f32Out[0], C_TS001__SAMPLES);
+				break;
+
+			case TS001__BIQUAD_S16:
+				vSTREAMFILT_BIQUAD__Block_S16(&sBiquad, &sTS001.s16In[0], &sTS001.s16Out[0], C_TS001__SAMPLES);
+				break;
+
+			case TS001__BIQUAD_F32:
+				vSTREAMFILT_BIQUAD__Block_F32(&sBiquadF, &sTS001.f32In[0], &sTS001.f32Out[0], C_TS001__SAMPLES);
+				break;
+
+			case TS001__MEDIAN_S16:
+				vSTREAMFILT_MEDIAN__Block_S16(&sMedian, &sTS001.s16In[0], &sTS001.s16Out[0], C_TS001__SAMPLES);
+				break;
+
+			case TS001__MEDIAN_F32:
+				vSTREAMFILT_MEDIAN__Block_F32(&sMedianF, &sTS001.f32In[0], &sTS001.f32Out[0], C_TS001__SAMPLES);
+				break;
+
+			default:
+				//do nothing
+				break;
+		}
+		u64Time = M_TS001__NOW() - u64Start;
+
+		if(u64Time < u64Best)
+		{
+			u64Best = u64Time;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	return (Lfloat32)u64Best / (Lfloat32)C_TS001__SAMPLES;
+}
+
+#endif //#if C_LOCALDEF__LCCM670__ENABLE_TEST_SPEC == 1U
+#endif //#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
@@ -0,0 +1,228 @@
+/**
+ * @file		STREAM_FILTER.H
+ * @brief		Main header for the constant time streaming filters
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ */
+
+
+#ifndef _STREAM_FILTER_H_
+#define _STREAM_FILTER_H_
+	#include <localdef.h>
+	#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+
+		/*******************************************************************************
+		Defines
+		*******************************************************************************/
+
+		/** Largest median window */
+		#define C_STREAMFILT__MEDIAN_MAX_SIZE					(15U)
+
+
+		/*******************************************************************************
+		Structures
+		The caller owns the filter and, for the moving averages, the sample buffer.
+		Every filter costs the same per sample whatever its length, except the median
+		which is O(N) in its (small) window.
+		*******************************************************************************/
+
+		/** Moving average, S16 */
+		typedef struct
+		{
+			/** Caller supplied window of u16Size samples */
+			Lint16 *ps16Buffer;
+			Luint16 u16Size;
+			Luint16 u16Position;
+
+			/** Samples held, the average is over these until the window fills */
+			Luint16 u16Fill;
+
+			/** Running sum of the window */
+			Lint32 s32Sum;
+
+		}STREAMFILT__MAVG_S16_T;
+
+		/** Moving average, U16 */
+		typedef struct
+		{
+			Luint16 *pu16Buffer;
+			Luint16 u16Size;
+			Luint16 u16Position;
+			Luint16 u16Fill;
+			Luint32 u32Sum;
+
+		}STREAMFILT__MAVG_U16_T;
+
+		/** Moving average, S32 */
+		typedef struct
+		{
+			Lint32 *ps32Buffer;
+			Luint16 u16Size;
+			Luint16 u16Position;
+			Luint16 u16Fill;
+			Lint64 s64Sum;
+
+		}STREAMFILT__MAVG_S32_T;
+
+		/** Moving average, U32 */
+		typedef struct
+		{
+			Luint32 *pu32Buffer;
+			Luint16 u16Size;
+			Luint16 u16Position;
+			Luint16 u16Fill;
+			Luint64 u64Sum;
+
+		}STREAMFILT__MAVG_U32_T;
+
+		/** Moving average, F32 */
+		typedef struct
+		{
+			Lfloat32 *pf32Buffer;
+			Luint16 u16Size;
+			Luint16 u16Position;
+			Luint16 u16Fill;
+
+			/** Held in double so the add/subtract does not drift */
+			Lfloat64 f64Sum;
+
+		}STREAMFILT__MAVG_F32_T;
+
+		/** Exponential filter, S16 with a Q15 smoothing factor */
+		typedef struct
+		{
+			/** y += alpha * (x - y), alpha in Q15, 1 to 32767 */
+			Lint16 s16Alpha_Q15;
+
+			/** State with 16 fraction bits so small steps are not lost */
+			Lint32 s32State_Q16;
+
+			/** The first sample loads the state */
+			Luint8 u8Primed;
+
+		}STREAMFILT__EMA_S16_T;
+
+		/** Exponential filter, F32 */
+		typedef struct
+		{
+			Lfloat32 f32Alpha;
+			Lfloat32 f32State;
+			Luint8 u8Primed;
+
+		}STREAMFILT__EMA_F32_T;
+
+		/** Biquad, S16 samples with Q14 coefficients, direct form I */
+		typedef struct
+		{
+			/** b0, b1, b2 in Q14 */
+			Lint16 s16B_Q14[3];
+
+			/** a1, a2 in Q14, a0 is 1 */
+			Lint16 s16A_Q14[2];
+
+			/** x[n-1], x[n-2] */
+			Lint16 s16X[2];
+
+			/** y[n-1], y[n-2] */
+			Lint16 s16Y[2];
+
+			/** Fraction dropped by the last output, fed back into the next so
+			 * the rounding does not leave a dead band around the settled value */
+			Lint32 s32Residual;
+
+		}STREAMFILT__BIQUAD_S16_T;
+
+		/** Biquad, F32, transposed direct form II */
+		typedef struct
+		{
+			Lfloat32 f32B[3];
+			Lfloat32 f32A[2];
+
+			/** The two delay elements */
+			Lfloat32 f32Z[2];
+
+		}STREAMFILT__BIQUAD_F32_T;
+
+		/** Median of N, S16 */
+		typedef struct
+		{
+			/** Samples in arrival order */
+			Lint16 s16Ring[C_STREAMFILT__MEDIAN_MAX_SIZE];
+
+			/** The same samples kept sorted */
+			Lint16 s16Sorted[C_STREAMFILT__MEDIAN_MAX_SIZE];
+
+			Luint8 u8Size;
+			Luint8 u8Position;
+			Luint8 u8Fill;
+
+		}STREAMFILT__MEDIAN_S16_T;
+
+		/** Median of N, F32 */
+		typedef struct
+		{
+			Lfloat32 f32Ring[C_STREAMFILT__MEDIAN_MAX_SIZE];
+			Lfloat32 f32Sorted[C_STREAMFILT__MEDIAN_MAX_SIZE];
+			Luint8 u8Size;
+			Luint8 u8Position;
+			Luint8 u8Fill;
+
+		}STREAMFILT__MEDIAN_F32_T;
+
+
+		/*******************************************************************************
+		Function Prototypes
+		*******************************************************************************/
+		//moving average
+		void vSTREAMFILT_MAVG__Init_S16(STREAMFILT__MAVG_S16_T *pFilter, Lint16 *ps16Buffer, Luint16 u16Size);
+		Lint16 s16STREAMFILT_MAVG__Add_S16(STREAMFILT__MAVG_S16_T *pFilter, Lint16 s16Sample);
+		void vSTREAMFILT_MAVG__Block_S16(STREAMFILT__MAVG_S16_T *pFilter, const Lint16 *ps16In, Lint16 *ps16Out, Luint32 u32Count);
+		void vSTREAMFILT_MAVG__Init_U16(STREAMFILT__MAVG_U16_T *pFilter, Luint16 *pu16Buffer, Luint16 u16Size);
+		Luint16 u16STREAMFILT_MAVG__Add_U16(STREAMFILT__MAVG_U16_T *pFilter, Luint16 u16Sample);
+		void vSTREAMFILT_MAVG__Block_U16(STREAMFILT__MAVG_U16_T *pFilter, const Luint16 *pu16In, Luint16 *pu16Out, Luint32 u32Count);
+		void vSTREAMFILT_MAVG__Init_S32(STREAMFILT__MAVG_S32_T *pFilter, Lint32 *ps32Buffer, Luint16 u16Size);
+		Lint32 s32STREAMFILT_MAVG__Add_S32(STREAMFILT__MAVG_S32_T *pFilter, Lint32 s32Sample);
+		void vSTREAMFILT_MAVG__Block_S32(STREAMFILT__MAVG_S32_T *pFilter, const Lint32 *ps32In, Lint32 *ps32Out, Luint32 u32Count);
+		void vSTREAMFILT_MAVG__Init_U32(STREAMFILT__MAVG_U32_T *pFilter, Luint32 *pu32Buffer, Luint16 u16Size);
+		Luint32 u32STREAMFILT_MAVG__Add_U32(STREAMFILT__MAVG_U32_T *pFilter, Luint32 u32Sample);
+		void vSTREAMFILT_MAVG__Block_U32(STREAMFILT__MAVG_U32_T *pFilter, const Luint32 *pu32In, Luint32 *pu32Out, Luint32 u32Count);
+		void vSTREAMFILT_MAVG__Init_F32(STREAMFILT__MAVG_F32_T *pFilter, Lfloat32 *pf32Buffer, Luint16 u16Size);
+		Lfloat32 f32STREAMFILT_MAVG__Add_F32(STREAMFILT__MAVG_F32_T *pFilter, Lfloat32 f32Sample);
+		void vSTREAMFILT_MAVG__Block_F32(STREAMFILT__MAVG_F32_T *pFilter, const Lfloat32 *pf32In, Lfloat32 *pf32Out, Luint32 u32Count);
+
+		//exponential
+		void vSTREAMFILT_EMA__Init_S16(STREAMFILT__EMA_S16_T *pFilter, Lint16 s16Alpha_Q15);
+		Lint16 s16STREAMFILT_EMA__Add_S16(STREAMFILT__EMA_S16_T *pFilter, Lint16 s16Sample);
+		void vSTREAMFILT_EMA__Block_S16(STREAMFILT__EMA_S16_T *pFilter, const Lint16 *ps16In, Lint16 *ps16Out, Luint32 u32Count);
+		void vSTREAMFILT_EMA__Init_F32(STREAMFILT__EMA_F32_T *pFilter, Lfloat32 f32Alpha);
+		Lfloat32 f32STREAMFILT_EMA__Add_F32(STREAMFILT__EMA_F32_T *pFilter, Lfloat32 f32Sample);
+		void vSTREAMFILT_EMA__Block_F32(STREAMFILT__EMA_F32_T *pFilter, const Lfloat32 *pf32In, Lfloat32 *pf32Out, Luint32 u32Count);
+
+		//biquad
+		Lint16 s16STREAMFILT_BIQUAD__Init_S16(STREAMFILT__BIQUAD_S16_T *pFilter, const Lfloat32 *pf32B, const Lfloat32 *pf32A);
+		Lint16 s16STREAMFILT_BIQUAD__Add_S16(STREAMFILT__BIQUAD_S16_T *pFilter, Lint16 s16Sample);
+		void vSTREAMFILT_BIQUAD__Block_S16(STREAMFILT__BIQUAD_S16_T *pFilter, const Lint16 *ps16In, Lint16 *ps16Out, Luint32 u32Count);
+		void vSTREAMFILT_BIQUAD__Init_F32(STREAMFILT__BIQUAD_F32_T *pFilter, const Lfloat32 *pf32B, const Lfloat32 *pf32A);
+		Lfloat32 f32STREAMFILT_BIQUAD__Add_F32(STREAMFILT__BIQUAD_F32_T *pFilter, Lfloat32 f32Sample);
+		void vSTREAMFILT_BIQUAD__Block_F32(STREAMFILT__BIQUAD_F32_T *pFilter, const Lfloat32 *pf32In, Lfloat32 *pf32Out, Luint32 u32Count);
+
+		//median
+		void vSTREAMFILT_MEDIAN__Init_S16(STREAMFILT__MEDIAN_S16_T *pFilter, Luint8 u8Size);
+		Lint16 s16STREAMFILT_MEDIAN__Add_S16(STREAMFILT__MEDIAN_S16_T *pFilter, Lint16 s16Sample);
+		void vSTREAMFILT_MEDIAN__Block_S16(STREAMFILT__MEDIAN_S16_T *pFilter, const Lint16 *ps16In, Lint16 *ps16Out, Luint32 u32Count);
+		void vSTREAMFILT_MEDIAN__Init_F32(STREAMFILT__MEDIAN_F32_T *pFilter, Luint8 u8Size);
+		Lfloat32 f32STREAMFILT_MEDIAN__Add_F32(STREAMFILT__MEDIAN_F32_T *pFilter, Lfloat32 f32Sample);
+		void vSTREAMFILT_MEDIAN__Block_F32(STREAMFILT__MEDIAN_F32_T *pFilter, const Lfloat32 *pf32In, Lfloat32 *pf32Out, Luint32 u32Count);
+
+		//testing
+		#if C_LOCALDEF__LCCM670__ENABLE_TEST_SPEC == 1U
+			DLL_DECLARATION void vLCCM670R0_TS_000(void);
+			DLL_DECLARATION void vLCCM670R0_TS_001(void);
+		#endif
+
+	#endif //#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+	//safetys
+	#ifndef C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE
+		#error
+	#endif
+#endif //_STREAM_FILTER_H_
@@ -0,0 +1,25 @@
+/**
+ * @file		STREAM_FILTER__LOCALDEF.H
+ * @brief		Localdef template
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM670R0.FILE.003
+ */
+
+#if 0
+
+/*******************************************************************************
+RLOOP - STREAMING FILTERS
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM670__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM670__RLOOP__STREAM_FILTER/stream_filter.h>
+	#endif //#if C_LOCALDEF__LCCM670__ENABLE_THIS_MODULE == 1U
+
+#endif //#if 0
+
@@ -0,0 +1,193 @@
+/**
+ * @file		FAULT_LINK__JOURNAL.C
+ * @brief		Timestamped journal of fault flag sets
+ *
+ * @note
+ * Every flag that goes from clear to set is logged with the tree ID, flag index,
+ * a timestamp and a running sequence number. The journal is a fixed ring, once
+ * full the oldest entry is overwritten. A reader remembers the last sequence it
+ * has seen and asks for the ones after it, a gap in the sequence means the ring
+ * wrapped before they were read.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM671R0.FILE.001
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FAULTLINK
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FAULTLINK__JOURNAL
+ * @ingroup FAULTLINK
+ * @{ */
+
+#include "../fault_link.h"
+#if C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+
+//the journal
+struct _strFAULTLINK_JOURNAL sFAULTLINK_JOURNAL;
+
+
+/***************************************************************************//**
+ * @brief
+ * Empty the journal
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.001.FUNC.001
+ */
+void vFAULTLINK_JOURNAL__Init(void)
+{
+	Luint16 u16Counter;
+
+	for(u16Counter = 0U; u16Counter < C_LOCALDEF__LCCM671__JOURNAL_SIZE; u16Counter++)
+	{
+		sFAULTLINK_JOURNAL.sEntries[u16Counter].u64Timestamp = 0U;
+		sFAULTLINK_JOURNAL.sEntries[u16Counter].u32Sequence = 0U;
+		sFAULTLINK_JOURNAL.sEntries[u16Counter].u16TreeID = 0U;
+		sFAULTLINK_JOURNAL.sEntries[u16Counter].u8FlagIndex = 0U;
+	}
+	sFAULTLINK_JOURNAL.u16WritePos = 0U;
+	sFAULTLINK_JOURNAL.u32Sequence = 0U;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Log a flag set, called by vFAULTLINK__Set_Flag()
+ *
+ * @param[in]		u8FlagIndex				The flag index
+ * @param[in]		u16TreeID				Tree ID of the tree
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.001.FUNC.002
+ */
+void vFAULTLINK_JOURNAL__Add(Luint16 u16TreeID, Luint8 u8FlagIndex)
+{
+	Luint16 u16Pos;
+	Luint32 u32Sequence;
+
+	//claim the slot and sequence before filling, keeps them in step if an ISR gets in
+	u16Pos = sFAULTLINK_JOURNAL.u16WritePos;
+	u32Sequence = sFAULTLINK_JOURNAL.u32Sequence;
+	sFAULTLINK_JOURNAL.u32Sequence = u32Sequence + 1U;
+	if((u16Pos + 1U) >= C_LOCALDEF__LCCM671__JOURNAL_SIZE)
+	{
+		sFAULTLINK_JOURNAL.u16WritePos = 0U;
+	}
+	else
+	{
+		sFAULTLINK_JOURNAL.u16WritePos = u16Pos + 1U;
+	}
+
+	sFAULTLINK_JOURNAL.sEntries[u16Pos].u64Timestamp = M_LOCALDEF__LCCM671__GET_TIMESTAMP();
+	sFAULTLINK_JOURNAL.sEntries[u16Pos].u16TreeID = u16TreeID;
+	sFAULTLINK_JOURNAL.sEntries[u16Pos].u8FlagIndex = u8FlagIndex;
+	sFAULTLINK_JOURNAL.sEntries[u16Pos].u32Sequence = u32Sequence;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the sequence number the next entry will have
+ *
+ * @return			Total number of entries ever logged
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.001.FUNC.003
+ */
+Luint32 u32FAULTLINK_JOURNAL__Get_Sequence(void)
+{
+	return sFAULTLINK_JOURNAL.u32Sequence;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the sequence number of the oldest entry still held
+ *
+ * @return			The oldest sequence, equal to the next sequence if empty
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.001.FUNC.004
+ */
+Luint32 u32FAULTLINK_JOURNAL__Get_Oldest(void)
+{
+	Luint32 u32Return;
+
+	if(sFAULTLINK_JOURNAL.u32Sequence > C_LOCALDEF__LCCM671__JOURNAL_SIZE)
+	{
+		u32Return = sFAULTLINK_JOURNAL.u32Sequence - C_LOCALDEF__LCCM671__JOURNAL_SIZE;
+	}
+	else
+	{
+		u32Return = 0U;
+	}
+
+	return u32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Read back an entry by its sequence number
+ *
+ * @param[out]		*pEntry					Copy of the entry
+ * @param[in]		u32Sequence				The sequence number wanted
+ * @return			1 = entry copied\n
+ *					0 = not logged yet, or already overwritten
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.001.FUNC.005
+ */
+Luint8 u8FAULTLINK_JOURNAL__Get_Entry(Luint32 u32Sequence, FAULTLINK__JOURNAL_ENTRY_T *pEntry)
+{
+	Luint8 u8Return;
+	Luint32 u32Back;
+	Luint32 u32Pos;
+
+	if((u32Sequence < sFAULTLINK_JOURNAL.u32Sequence) && (u32Sequence >= u32FAULTLINK_JOURNAL__Get_Oldest()))
+	{
+		//how far back from the write position
+		u32Back = sFAULTLINK_JOURNAL.u32Sequence - u32Sequence;
+		if(u32Back > (Luint32)sFAULTLINK_JOURNAL.u16WritePos)
+		{
+			u32Pos = ((Luint32)sFAULTLINK_JOURNAL.u16WritePos + C_LOCALDEF__LCCM671__JOURNAL_SIZE) - u32Back;
+		}
+		else
+		{
+			u32Pos = (Luint32)sFAULTLINK_JOURNAL.u16WritePos - u32Back;
+		}
+
+		pEntry->u64Timestamp = sFAULTLINK_JOURNAL.sEntries[u32Pos].u64Timestamp;
+		pEntry->u32Sequence = sFAULTLINK_JOURNAL.sEntries[u32Pos].u32Sequence;
+		pEntry->u16TreeID = sFAULTLINK_JOURNAL.sEntries[u32Pos].u16TreeID;
+		pEntry->u8FlagIndex = sFAULTLINK_JOURNAL.sEntries[u32Pos].u8FlagIndex;
+
+		//a set from an ISR could have overwritten the slot while we copied
+		if(pEntry->u32Sequence == u32Sequence)
+		{
+			u8Return = 1U;
+		}
+		else
+		{
+			u8Return = 0U;
+		}
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+
+#endif //#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+#endif //#if C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
@@ -0,0 +1,432 @@
+/**
+ * @file		LCCM671R0_TS_000.C
+ * @brief		Test spec for linked fault trees and the fault journal
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM671R0.FILE.003
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM671__ENABLE_TEST_SPEC == 1U
+
+//host side only
+#include <stdio.h>
+
+void vLCCM671R0_TS_000_TCASE_001(void);
+void vLCCM671R0_TS_000_TCASE_002(void);
+void vLCCM671R0_TS_000_TCASE_003(void);
+void vLCCM671R0_TS_000_TCASE_004(void);
+static void vTS000__Result(Luint32 u32Fail, const char *pcCase);
+
+/** top, two middle and one bottom node */
+static FAULTLINK__NODE_T sTS000_Top;
+static FAULTLINK__NODE_T sTS000_MidA;
+static FAULTLINK__NODE_T sTS000_MidB;
+static FAULTLINK__NODE_T sTS000_Leaf;
+
+//Function to call the tests for this test specification
+void vLCCM671R0_TS_000(void)
+{
+	//Call the test cases
+	vLCCM671R0_TS_000_TCASE_001();
+	vLCCM671R0_TS_000_TCASE_002();
+	vLCCM671R0_TS_000_TCASE_003();
+	vLCCM671R0_TS_000_TCASE_004();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM671R0.TS.000.TCASE.001
+ * @st_test_desc
+ * Leaf -> MidA -> Top and MidB -> Top. A flag set in the leaf must show in the
+ * fault flag of every tree above it and nowhere else. Clearing must only drop
+ * a parent once nothing else below it is faulted.
+ *
+*/
+void vLCCM671R0_TS_000_TCASE_001(void)
+{
+	Luint32 u32Fail;
+
+	DEBUG_PRINT("START:LCCM671R0.TS.000.TCASE.001\r\n");
+	u32Fail = 0U;
+
+	vFAULTLINK__Init(&sTS000_Top);
+	vFAULTLINK__Init(&sTS000_MidA);
+	vFAULTLINK__Init(&sTS000_MidB);
+	vFAULTLINK__Init(&sTS000_Leaf);
+	vFAULTLINK__Link(&sTS000_MidA, &sTS000_Top, 0U);
+	vFAULTLINK__Link(&sTS000_MidB, &sTS000_Top, 5U);
+	vFAULTLINK__Link(&sTS000_Leaf, &sTS000_MidA, 31U);
+
+	//leaf fault goes all the way up
+	vFAULTLINK__Set_Flag(&sTS000_Leaf, 40U);
+	if((sTS000_Leaf.u8FaultFlag != 1U) || (sTS000_MidA.u8FaultFlag != 1U) || (sTS000_Top.u8FaultFlag != 1U) || (sTS000_MidB.u8FaultFlag != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	if((sTS000_MidA.u32ChildFaults != 0x80000000U) || (sTS000_Top.u32ChildFaults != 0x00000001U) || (sTS000_Leaf.sTree.u32Flags[1] != 0x00000100U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//second source of fault on the top
+	vFAULTLINK__Set_Flag(&sTS000_MidB, 0U);
+	vFAULTLINK__Set_Flag(&sTS000_MidB, 0U);
+	if(sTS000_Top.u32ChildFaults != 0x00000021U)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//clear the leaf, top stays faulted by MidB
+	vFAULTLINK__Clear_Flag(&sTS000_Leaf, 40U);
+	if((sTS000_Leaf.u8FaultFlag != 0U) || (sTS000_MidA.u8FaultFlag != 0U) || (sTS000_Top.u8FaultFlag != 1U) || (sTS000_Top.u32ChildFaults != 0x00000020U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//own flag on the top holds it after MidB clears
+	vFAULTLINK__Set_Flag(&sTS000_Top, 3U);
+	vFAULTLINK__Clear_Flag(&sTS000_MidB, 0U);
+	if((sTS000_Top.u8FaultFlag != 1U) || (sTS000_Top.u32ChildFaults != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	vFAULTLINK__Clear_Flag(&sTS000_Top, 3U);
+	if(u8FAULTLINK__Get_IsFault(&sTS000_Top) != 0U)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//out of range does nothing
+	vFAULTLINK__Set_Flag(&sTS000_Leaf, 64U);
+	if((sTS000_Leaf.u8FaultFlag != 0U) || (u8FAULTLINK__Get_Fault(&sTS000_Leaf, 64U) != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM671R0.TS.000.TCASE.001");
+
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM671R0.TS.000.TCASE.002
+ * @st_test_desc
+ * Linking a tree that is already faulted marks the new parent, relinking moves
+ * the fault from the old parent to the new one, unlinking clears it.
+ *
+*/
+void vLCCM671R0_TS_000_TCASE_002(void)
+{
+	Luint32 u32Fail;
+
+	DEBUG_PRINT("START:LCCM671R0.TS.000.TCASE.002\r\n");
+	u32Fail = 0U;
+
+	vFAULTLINK__Init(&sTS000_Top);
+	vFAULTLINK__Init(&sTS000_MidA);
+	vFAULTLINK__Init(&sTS000_MidB);
+	vFAULTLINK__Init(&sTS000_Leaf);
+	vFAULTLINK__Link(&sTS000_MidA, &sTS000_Top, 1U);
+	vFAULTLINK__Link(&sTS000_MidB, &sTS000_Top, 2U);
+
+	vFAULTLINK__Set_Flag(&sTS000_Leaf, 7U);
+	vFAULTLINK__Link(&sTS000_Leaf, &sTS000_MidA, 4U);
+	if((sTS000_MidA.u8FaultFlag != 1U) || (sTS000_Top.u32ChildFaults != 0x00000002U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vFAULTLINK__Link(&sTS000_Leaf, &sTS000_MidB, 4U);
+	if((sTS000_MidA.u8FaultFlag != 0U) || (sTS000_MidB.u8FaultFlag != 1U) || (sTS000_Top.u32ChildFaults != 0x00000004U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vFAULTLINK__Link(&sTS000_Leaf, 0, 0U);
+	if((sTS000_MidB.u8FaultFlag != 0U) || (sTS000_Top.u8FaultFlag != 0U) || (sTS000_Leaf.u8FaultFlag != 1U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//no linking to ourselves
+	vFAULTLINK__Link(&sTS000_Leaf, &sTS000_Leaf, 0U);
+	if(sTS000_Leaf.pParent != 0)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM671R0.TS.000.TCASE.002");
+
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM671R0.TS.000.TCASE.003
+ * @st_test_desc
+ * Each new flag is journaled once in the order set, repeats are not. After
+ * the ring wraps only the newest C_LOCALDEF__LCCM671__JOURNAL_SIZE entries
+ * can be read back and the sequence numbers have no gaps. Needs a journal of
+ * at least 2 entries.
+ *
+*/
+void vLCCM671R0_TS_000_TCASE_003(void)
+{
+#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+	Luint32 u32Fail;
+	Luint32 u32Counter;
+	Luint32 u32Seq;
+	Luint8 u8Test;
+	FAULTLINK__JOURNAL_ENTRY_T sEntry;
+
+	DEBUG_PRINT("START:LCCM671R0.TS.000.TCASE.003\r\n");
+	u32Fail = 0U;
+
+	vFAULTLINK_JOURNAL__Init();
+	vFAULTLINK__Init(&sTS000_Top);
+	vFAULTLINK__Init(&sTS000_Leaf);
+	vFAULTLINK__Set_ID(&sTS000_Top, 0x0100U);
+	vFAULTLINK__Set_ID(&sTS000_Leaf, 0x0200U);
+	vFAULTLINK__Link(&sTS000_Leaf, &sTS000_Top, 0U);
+
+	vFAULTLINK__Set_Flag(&sTS000_Leaf, 2U);
+	vFAULTLINK__Set_Flag(&sTS000_Leaf, 2U);
+	vFAULTLINK__Set_Flag(&sTS000_Top, 63U);
+	vFAULTLINK__Set_Flag(&sTS000_Leaf, 2U);
+
+	//two entries, in order, the propagation to the top is not a flag set
+	if(u32FAULTLINK_JOURNAL__Get_Sequence() != 2U)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	u8Test = u8FAULTLINK_JOURNAL__Get_Entry(0U, &sEntry);
+	if((u8Test != 1U) || (sEntry.u16TreeID != 0x0200U) || (sEntry.u8FlagIndex != 2U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	u8Test = u8FAULTLINK_JOURNAL__Get_Entry(1U, &sEntry);
+	if((u8Test != 1U) || (sEntry.u16TreeID != 0x0100U) || (sEntry.u8FlagIndex != 63U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	u8Test = u8FAULTLINK_JOURNAL__Get_Entry(2U, &sEntry);
+	if(u8Test != 0U)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//wrap the ring, set and clear so every set is new
+	vFAULTLINK__Clear_Flag(&sTS000_Leaf, 2U);
+	for(u32Counter = 0U; u32Counter < (C_LOCALDEF__LCCM671__JOURNAL_SIZE * 3U); u32Counter++)
+	{
+		vFAULTLINK__Set_Flag(&sTS000_Leaf, u32Counter & 0x3FU);
+		vFAULTLINK__Clear_Flag(&sTS000_Leaf, u32Counter & 0x3FU);
+	}
+	u32Seq = u32FAULTLINK_JOURNAL__Get_Sequence();
+	if((u32Seq != ((C_LOCALDEF__LCCM671__JOURNAL_SIZE * 3U) + 2U)) || (u32FAULTLINK_JOURNAL__Get_Oldest() != (u32Seq - C_LOCALDEF__LCCM671__JOURNAL_SIZE)))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	u8Test = u8FAULTLINK_JOURNAL__Get_Entry(u32FAULTLINK_JOURNAL__Get_Oldest() - 1U, &sEntry);
+	if(u8Test != 0U)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	for(u32Counter = u32FAULTLINK_JOURNAL__Get_Oldest(); u32Counter < u32Seq; u32Counter++)
+	{
+		u8Test = u8FAULTLINK_JOURNAL__Get_Entry(u32Counter, &sEntry);
+		if((u8Test != 1U) || (sEntry.u32Sequence != u32Counter) || ((Luint32)sEntry.u8FlagIndex != ((u32Counter - 2U) & 0x3FU)))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	vTS000__Result(u32Fail, "LCCM671R0.TS.000.TCASE.003");
+#endif
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM671R0.TS.000.TCASE.004
+ * @st_test_desc
+ * Re-initing a faulted child that is still linked must take its bit out of the
+ * parent, and the parent must drop its fault if nothing else holds it. A
+ * parent with its own flag stays faulted.
+ *
+*/
+void vLCCM671R0_TS_000_TCASE_004(void)
+{
+	Luint32 u32Fail;
+
+	DEBUG_PRINT("START:LCCM671R0.TS.000.TCASE.004\r\n");
+	u32Fail = 0U;
+
+	vFAULTLINK__Init(&sTS000_Top);
+	vFAULTLINK__Init(&sTS000_MidA);
+	vFAULTLINK__Init(&sTS000_MidB);
+	vFAULTLINK__Init(&sTS000_Leaf);
+	vFAULTLINK__Link(&sTS000_MidA, &sTS000_Top, 0U);
+	vFAULTLINK__Link(&sTS000_MidB, &sTS000_Top, 1U);
+	vFAULTLINK__Link(&sTS000_Leaf, &sTS000_MidA, 2U);
+
+	//leaf faults the whole chain, init of the leaf clears it all
+	vFAULTLINK__Set_Flag(&sTS000_Leaf, 9U);
+	vFAULTLINK__Init(&sTS000_Leaf);
+	if((sTS000_Leaf.u8FaultFlag != 0U) || (sTS000_Leaf.pParent != 0) || (sTS000_Leaf.sTree.u32Flags[0] != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	if((sTS000_MidA.u8FaultFlag != 0U) || (sTS000_MidA.u32ChildFaults != 0U) || (sTS000_Top.u8FaultFlag != 0U) || (sTS000_Top.u32ChildFaults != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//MidA holds its own flag, only the top bit for MidB goes
+	vFAULTLINK__Set_Flag(&sTS000_MidA, 1U);
+	vFAULTLINK__Set_Flag(&sTS000_MidB, 1U);
+	vFAULTLINK__Init(&sTS000_MidB);
+	if((sTS000_Top.u8FaultFlag != 1U) || (sTS000_Top.u32ChildFaults != 0x00000001U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//a re-inited node can be linked and faulted again
+	vFAULTLINK__Link(&sTS000_MidB, &sTS000_Top, 1U);
+	vFAULTLINK__Set_Flag(&sTS000_MidB, 1U);
+	if(sTS000_Top.u32ChildFaults != 0x00000003U)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM671R0.TS.000.TCASE.004");
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Print the result of a test case
+ *
+ * @param[in]		*pcCase					Test case ID
+ * @param[in]		u32Fail					Number of failed checks
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.003.FUNC.001
+ */
+static void vTS000__Result(Luint32 u32Fail, const char *pcCase)
+{
+	char cText[200];
+
+	if(u32Fail == 0U)
+	{
+		sprintf(cText, "PASS:%s\r\n", pcCase);
+	}
+	else
+	{
+		sprintf(cText, "FAIL:%s (%u)\r\n", pcCase, u32Fail);
+	}
+	DEBUG_PRINT(cText);
+
+	sprintf(cText, "END:%s\r\n", pcCase);
+	DEBUG_PRINT(cText);
+
+}
+
+#endif //#if C_LOCALDEF__LCCM671__ENABLE_TEST_SPEC == 1U
+#endif //#if C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE
+	#error
+#endif
@@ -0,0 +1,374 @@
+/**
+ * @file		FAULT_LINK.C
+ * @brief		Fault trees linked into a hierarchy
+ *
+ * @note
+ * Each node wraps an LCCM284 fault tree. The flags themselves are set and
+ * cleared through LCCM284, this layer adds the parent link. Each child owns
+ * one bit in its parents u32ChildFaults, so the parents u8FaultFlag answers
+ * "is anything below me faulted" with a single load, no polling of the children.
+ *
+ * Propagation only happens when a nodes fault flag changes. Setting a flag that
+ * is already set is a test and return, so it is safe to call from every pass of
+ * a process loop.
+ *
+ * Flags are not interrupt safe, if a node is set from an ISR and the main loop
+ * the caller has to handle the locking.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM671R0.FILE.000
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FAULTLINK
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup FAULTLINK__CORE
+ * @ingroup FAULTLINK
+ * @{ */
+
+#include "fault_link.h"
+#if C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE == 1U
+
+//locals
+static void vFAULTLINK__Propagate_Set(FAULTLINK__NODE_T *pNode);
+static void vFAULTLINK__Propagate_Clear(FAULTLINK__NODE_T *pNode);
+
+
+/***************************************************************************//**
+ * @brief
+ * Init a node
+ *
+ * @note
+ * Clears all flags and unlinks the node from its parent, so link the node
+ * after the subsystem that owns it has been initted. A node that was faulted
+ * while linked is taken out of its parents child faults first, so a re-init
+ * does not leave the parent stuck in fault.
+ *
+ * @param[in]		*pNode					The node
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.000.FUNC.001
+ */
+void vFAULTLINK__Init(FAULTLINK__NODE_T *pNode)
+{
+
+	if(pNode->u8FaultFlag == 1U)
+	{
+		pNode->u8FaultFlag = 0U;
+		vFAULTLINK__Propagate_Clear(pNode);
+	}
+	else
+	{
+		//fall on
+	}
+
+	vFAULTTREE__Init(&pNode->sTree);
+	pNode->u8FaultFlag = 0U;
+	pNode->u32ChildFaults = 0U;
+	pNode->u32ParentMask = 0U;
+	pNode->pParent = 0;
+	pNode->u16TreeID = 0U;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Set a fault flag
+ *
+ * @note
+ * A flag that is already set returns straight away. A new flag is logged in
+ * the journal and, if the node was clear, marks each parent up the chain
+ * until one is found that already had a fault.
+ *
+ * @param[in]		u32FlagIndex			Flag index, 0 to 63
+ * @param[in]		*pNode					The node
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.000.FUNC.002
+ */
+void vFAULTLINK__Set_Flag(FAULTLINK__NODE_T *pNode, Luint32 u32FlagIndex)
+{
+
+	if(u32FlagIndex < C_FAULTLINK__MAX_FLAGS)
+	{
+		if((pNode->sTree.u32Flags[u32FlagIndex >> 5U] & (1U << (u32FlagIndex & 0x1FU))) == 0U)
+		{
+			vFAULTTREE__Set_Flag(&pNode->sTree, u32FlagIndex);
+
+			#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+				vFAULTLINK_JOURNAL__Add(pNode->u16TreeID, (Luint8)u32FlagIndex);
+			#endif
+
+			if(pNode->u8FaultFlag == 0U)
+			{
+				pNode->u8FaultFlag = 1U;
+				vFAULTLINK__Propagate_Set(pNode);
+			}
+			else
+			{
+				//parents already know
+			}
+		}
+		else
+		{
+			//already set, nothing changes
+		}
+	}
+	else
+	{
+		//out of range
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Clear a fault flag
+ *
+ * @note
+ * If this leaves the node with no flags and no faulted children the fault flag
+ * drops and the parents are re-checked.
+ *
+ * @param[in]		u32FlagIndex			Flag index, 0 to 63
+ * @param[in]		*pNode					The node
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.000.FUNC.003
+ */
+void vFAULTLINK__Clear_Flag(FAULTLINK__NODE_T *pNode, Luint32 u32FlagIndex)
+{
+
+	if(u32FlagIndex < C_FAULTLINK__MAX_FLAGS)
+	{
+		if((pNode->sTree.u32Flags[u32FlagIndex >> 5U] & (1U << (u32FlagIndex & 0x1FU))) != 0U)
+		{
+			vFAULTTREE__Clear_Flag(&pNode->sTree, u32FlagIndex);
+
+			if((pNode->sTree.u32Flags[0] | pNode->sTree.u32Flags[1] | pNode->u32ChildFaults) == 0U)
+			{
+				pNode->u8FaultFlag = 0U;
+				vFAULTLINK__Propagate_Clear(pNode);
+			}
+			else
+			{
+				//still faulted
+			}
+		}
+		else
+		{
+			//not set
+		}
+	}
+	else
+	{
+		//out of range
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the state of a single fault flag
+ *
+ * @param[in]		u32FlagIndex			Flag index, 0 to 63
+ * @param[in]		*pNode					The node
+ * @return			1 = flag set\n
+ *					0 = flag clear or out of range
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.000.FUNC.004
+ */
+Luint8 u8FAULTLINK__Get_Fault(const FAULTLINK__NODE_T *pNode, Luint32 u32FlagIndex)
+{
+	Luint8 u8Return;
+
+	if(u32FlagIndex < C_FAULTLINK__MAX_FLAGS)
+	{
+		u8Return = u8FAULTTREE__Get_Fault(&pNode->sTree, u32FlagIndex);
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Link a child node to a parent node
+ *
+ * @note
+ * A child that is already faulted marks the parent straight away. Relinking
+ * removes the child from its old parent first. Pass a 0 parent to unlink.
+ *
+ * @param[in]		u8ChildIndex			The childs bit in the parent, 0 to 31
+ * @param[in]		*pParent				The parent node, or 0
+ * @param[in]		*pChild					The child node
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.000.FUNC.005
+ */
+void vFAULTLINK__Link(FAULTLINK__NODE_T *pChild, FAULTLINK__NODE_T *pParent, Luint8 u8ChildIndex)
+{
+
+	if((u8ChildIndex < C_FAULTLINK__MAX_CHILDREN) && (pChild != pParent))
+	{
+		//take the child out of the old parent
+		if(pChild->u8FaultFlag == 1U)
+		{
+			vFAULTLINK__Propagate_Clear(pChild);
+		}
+		else
+		{
+			//fall on
+		}
+
+		pChild->pParent = pParent;
+		if(pParent != 0)
+		{
+			pChild->u32ParentMask = 1U << u8ChildIndex;
+		}
+		else
+		{
+			pChild->u32ParentMask = 0U;
+		}
+
+		//bring the new parent up to date
+		if(pChild->u8FaultFlag == 1U)
+		{
+			vFAULTLINK__Propagate_Set(pChild);
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	else
+	{
+		//bad index, or linking to ourselves
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Set the ID that identifies this node in the journal
+ *
+ * @param[in]		u16TreeID				The tree ID
+ * @param[in]		*pNode					The node
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.000.FUNC.006
+ */
+void vFAULTLINK__Set_ID(FAULTLINK__NODE_T *pNode, Luint16 u16TreeID)
+{
+	pNode->u16TreeID = u16TreeID;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Is this node, or any node linked below it, faulted
+ *
+ * @param[in]		*pNode					The node
+ * @return			1 = faulted
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.000.FUNC.007
+ */
+Luint8 u8FAULTLINK__Get_IsFault(const FAULTLINK__NODE_T *pNode)
+{
+	return pNode->u8FaultFlag;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the mask of linked children that are faulted
+ *
+ * @param[in]		*pNode					The node
+ * @return			Bit n set if the child linked at index n is faulted
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.000.FUNC.008
+ */
+Luint32 u32FAULTLINK__Get_ChildFaults(const FAULTLINK__NODE_T *pNode)
+{
+	return pNode->u32ChildFaults;
+}
+
+/***************************************************************************//**
+ * @brief
+ * A node has just become faulted, mark the parents
+ *
+ * @param[in]		*pNode					The node that became faulted
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.000.FUNC.009
+ */
+static void vFAULTLINK__Propagate_Set(FAULTLINK__NODE_T *pNode)
+{
+	FAULTLINK__NODE_T *pParent;
+	Luint32 u32Mask;
+
+	pParent = pNode->pParent;
+	u32Mask = pNode->u32ParentMask;
+	while(pParent != 0)
+	{
+		pParent->u32ChildFaults |= u32Mask;
+		if(pParent->u8FaultFlag == 0U)
+		{
+			pParent->u8FaultFlag = 1U;
+
+			//keep going up
+			u32Mask = pParent->u32ParentMask;
+			pParent = pParent->pParent;
+		}
+		else
+		{
+			//already faulted, everything above knows
+			pParent = 0;
+		}
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * A node has just become clear, remove it from the parents
+ *
+ * @param[in]		*pNode					The node that became clear
+ * @st_funcMD5
+ * @st_funcID		LCCM671R0.FILE.000.FUNC.010
+ */
+static void vFAULTLINK__Propagate_Clear(FAULTLINK__NODE_T *pNode)
+{
+	FAULTLINK__NODE_T *pParent;
+	Luint32 u32Mask;
+
+	pParent = pNode->pParent;
+	u32Mask = pNode->u32ParentMask;
+	while(pParent != 0)
+	{
+		pParent->u32ChildFaults &= ~u32Mask;
+		if((pParent->u8FaultFlag == 1U) && ((pParent->sTree.u32Flags[0] | pParent->sTree.u32Flags[1] | pParent->u32ChildFaults) == 0U))
+		{
+			pParent->u8FaultFlag = 0U;
+
+			//keep going up
+			u32Mask = pParent->u32ParentMask;
+			pParent = pParent->pParent;
+		}
+		else
+		{
+			//parent still faulted by something else
+			pParent = 0;
+		}
+	}
+
+}
+
+
+#endif //#if C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
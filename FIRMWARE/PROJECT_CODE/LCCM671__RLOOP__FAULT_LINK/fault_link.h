@@ -0,0 +1,137 @@
+/**
+ * @file		FAULT_LINK.H
+ * @brief		Main header for linked fault trees and the fault journal
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ */
+
+
+#ifndef _FAULT_LINK_H_
+#define _FAULT_LINK_H_
+	#include <localdef.h>
+	#if C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE == 1U
+
+		/*******************************************************************************
+		Defines
+		*******************************************************************************/
+
+		/** Max number of children that can link to one parent */
+		#define C_FAULTLINK__MAX_CHILDREN									(32U)
+
+		/** Max number of flags in a tree, the size of FAULT_TREE__PUBLIC_T */
+		#define C_FAULTLINK__MAX_FLAGS										(64U)
+
+
+		/*******************************************************************************
+		Structures
+		*******************************************************************************/
+
+		/** A fault tree that can be linked under a parent */
+		typedef struct _strFAULTLINK__NODE
+		{
+
+			/** The flags, the tree can still be read with the LCCM284 functions */
+			FAULT_TREE__PUBLIC_T sTree;
+
+			/** Set if any of our flags are set, or any linked child is faulted */
+			Luint8 u8FaultFlag;
+
+			/** One bit per linked child that currently has a fault */
+			Luint32 u32ChildFaults;
+
+			/** Our bit in the parents u32ChildFaults */
+			Luint32 u32ParentMask;
+
+			/** The parent, 0 if we are a top level tree */
+			struct _strFAULTLINK__NODE *pParent;
+
+			/** Identifies this tree in the fault journal */
+			Luint16 u16TreeID;
+
+		}FAULTLINK__NODE_T;
+
+
+		/** One entry in the fault journal, a flag that went from clear to set */
+		typedef struct
+		{
+
+			/** Timestamp of the set, from the localdef timestamp source */
+			Luint64 u64Timestamp;
+
+			/** Running count of journal entries, ground can spot any it missed */
+			Luint32 u32Sequence;
+
+			/** Tree ID of the tree the flag was set in */
+			Luint16 u16TreeID;
+
+			/** The flag index, 0 to 63 */
+			Luint8 u8FlagIndex;
+
+		}FAULTLINK__JOURNAL_ENTRY_T;
+
+
+		#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+			/** The fault journal, a ring of the most recent flag sets */
+			struct _strFAULTLINK_JOURNAL
+			{
+				/** The entries, oldest is overwritten first */
+				FAULTLINK__JOURNAL_ENTRY_T sEntries[C_LOCALDEF__LCCM671__JOURNAL_SIZE];
+
+				/** Where the next entry goes */
+				Luint16 u16WritePos;
+
+				/** Total entries ever added, also the sequence of the next one */
+				Luint32 u32Sequence;
+
+			};
+		#endif
+
+
+		/*******************************************************************************
+		Function Prototypes
+		*******************************************************************************/
+		void vFAULTLINK__Init(FAULTLINK__NODE_T *pNode);
+		void vFAULTLINK__Set_Flag(FAULTLINK__NODE_T *pNode, Luint32 u32FlagIndex);
+		void vFAULTLINK__Clear_Flag(FAULTLINK__NODE_T *pNode, Luint32 u32FlagIndex);
+		Luint8 u8FAULTLINK__Get_Fault(const FAULTLINK__NODE_T *pNode, Luint32 u32FlagIndex);
+		void vFAULTLINK__Link(FAULTLINK__NODE_T *pChild, FAULTLINK__NODE_T *pParent, Luint8 u8ChildIndex);
+		void vFAULTLINK__Set_ID(FAULTLINK__NODE_T *pNode, Luint16 u16TreeID);
+		Luint8 u8FAULTLINK__Get_IsFault(const FAULTLINK__NODE_T *pNode);
+		Luint32 u32FAULTLINK__Get_ChildFaults(const FAULTLINK__NODE_T *pNode);
+
+		//journal
+		#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+			void vFAULTLINK_JOURNAL__Init(void);
+			void vFAULTLINK_JOURNAL__Add(Luint16 u16TreeID, Luint8 u8FlagIndex);
+			Luint32 u32FAULTLINK_JOURNAL__Get_Sequence(void);
+			Luint32 u32FAULTLINK_JOURNAL__Get_Oldest(void);
+			Luint8 u8FAULTLINK_JOURNAL__Get_Entry(Luint32 u32Sequence, FAULTLINK__JOURNAL_ENTRY_T *pEntry);
+		#endif
+
+		//testing
+		#if C_LOCALDEF__LCCM671__ENABLE_TEST_SPEC == 1U
+			DLL_DECLARATION void vLCCM671R0_TS_000(void);
+		#endif
+
+		//safetys
+		#if C_LOCALDEF__LCCM284__ENABLE_THIS_MODULE != 1U
+			#error "Linked fault trees need LCCM284"
+		#endif
+		#ifndef C_LOCALDEF__LCCM671__ENABLE_JOURNAL
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+			#ifndef C_LOCALDEF__LCCM671__JOURNAL_SIZE
+				#error
+			#endif
+			#if C_LOCALDEF__LCCM671__JOURNAL_SIZE == 0U
+				#error
+			#endif
+		#endif
+
+	#endif //#if C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE == 1U
+	//safetys
+	#ifndef C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE
+		#error
+	#endif
+#endif //_FAULT_LINK_H_
@@ -0,0 +1,37 @@
+/**
+ * @file		FAULT_LINK__LOCALDEF.H
+ * @brief		Localdef template
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM671R0.FILE.002
+ */
+
+#if 0
+
+/*******************************************************************************
+RLOOP - LINKED FAULT TREES
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE == 1U
+
+		/** Journal of flag sets, streamed to ground over SafeUDP */
+		#define C_LOCALDEF__LCCM671__ENABLE_JOURNAL							(1U)
+		#if C_LOCALDEF__LCCM671__ENABLE_JOURNAL == 1U
+
+			/** Number of entries kept, the oldest is overwritten */
+			#define C_LOCALDEF__LCCM671__JOURNAL_SIZE						(32U)
+
+			/** RTI counter 1 stamps the entries */
+			#define M_LOCALDEF__LCCM671__GET_TIMESTAMP()					u64RM4_RTI__Get_Counter1()
+
+		#endif
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM671__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM671__RLOOP__FAULT_LINK/fault_link.h>
+	#endif //#if C_LOCALDEF__LCCM671__ENABLE_THIS_MODULE == 1U
+
+#endif //#if 0
+
@@ -0,0 +1,223 @@
+/**
+ * @file		PARAM_SHADOW__CRC.C
+ * @brief		Table driven CRC16 for the shadow headers, blocks and ranges
+ *
+ * @note
+ * CRC-16/CCITT (poly 0x1021, start 0xFFFF, no reflection, no final XOR).
+ * The shadow only ever CRCs whole words, so the CRC is taken over each word
+ * most significant byte first and four bytes are done per step with four
+ * 256 entry tables (slice by 4). That makes the result the same on either
+ * endian and lets a word go through in one pass of the loop.
+ *
+ * The tables are const so they stay in flash, 2KB in all.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM672R0.FILE.004
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PARAMSHADOW
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PARAMSHADOW__CRC
+ * @ingroup PARAMSHADOW
+ * @{ */
+
+#include "../param_shadow.h"
+#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+
+/** [0] is the plain bytewise table, [n] is a byte followed by n more bytes */
+static const Luint16 u16PARAMSHADOW_CRC__Table[4U][256U] =
+{
+	//byte 3, the last byte of a word
+	{
+		0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+		0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+		0x1231U, 0x0210U, 0x3273U, 0x2252U, 0x52B5U, 0x4294U, 0x72F7U, 0x62D6U,
+		0x9339U, 0x8318U, 0xB37BU, 0xA35AU, 0xD3BDU, 0xC39CU, 0xF3FFU, 0xE3DEU,
+		0x2462U, 0x3443U, 0x0420U, 0x1401U, 0x64E6U, 0x74C7U, 0x44A4U, 0x5485U,
+		0xA56AU, 0xB54BU, 0x8528U, 0x9509U, 0xE5EEU, 0xF5CFU, 0xC5ACU, 0xD58DU,
+		0x3653U, 0x2672U, 0x1611U, 0x0630U, 0x76D7U, 0x66F6U, 0x5695U, 0x46B4U,
+		0xB75BU, 0xA77AU, 0x9719U, 0x8738U, 0xF7DFU, 0xE7FEU, 0xD79DU, 0xC7BCU,
+		0x48C4U, 0x58E5U, 0x6886U, 0x78A7U, 0x0840U, 0x1861U, 0x2802U, 0x3823U,
+		0xC9CCU, 0xD9EDU, 0xE98EU, 0xF9AFU, 0x8948U, 0x9969U, 0xA90AU, 0xB92BU,
+		0x5AF5U, 0x4AD4U, 0x7AB7U, 0x6A96U, 0x1A71U, 0x0A50U, 0x3A33U, 0x2A12U,
+		0xDBFDU, 0xCBDCU, 0xFBBFU, 0xEB9EU, 0x9B79U, 0x8B58U, 0xBB3BU, 0xAB1AU,
+		0x6CA6U, 0x7C87U, 0x4CE4U, 0x5CC5U, 0x2C22U, 0x3C03U, 0x0C60U, 0x1C41U,
+		0xEDAEU, 0xFD8FU, 0xCDECU, 0xDDCDU, 0xAD2AU, 0xBD0BU, 0x8D68U, 0x9D49U,
+		0x7E97U, 0x6EB6U, 0x5ED5U, 0x4EF4U, 0x3E13U, 0x2E32U, 0x1E51U, 0x0E70U,
+		0xFF9FU, 0xEFBEU, 0xDFDDU, 0xCFFCU, 0xBF1BU, 0xAF3AU, 0x9F59U, 0x8F78U,
+		0x9188U, 0x81A9U, 0xB1CAU, 0xA1EBU, 0xD10CU, 0xC12DU, 0xF14EU, 0xE16FU,
+		0x1080U, 0x00A1U, 0x30C2U, 0x20E3U, 0x5004U, 0x4025U, 0x7046U, 0x6067U,
+		0x83B9U, 0x9398U, 0xA3FBU, 0xB3DAU, 0xC33DU, 0xD31CU, 0xE37FU, 0xF35EU,
+		0x02B1U, 0x1290U, 0x22F3U, 0x32D2U, 0x4235U, 0x5214U, 0x6277U, 0x7256U,
+		0xB5EAU, 0xA5CBU, 0x95A8U, 0x8589U, 0xF56EU, 0xE54FU, 0xD52CU, 0xC50DU,
+		0x34E2U, 0x24C3U, 0x14A0U, 0x0481U, 0x7466U, 0x6447U, 0x5424U, 0x4405U,
+		0xA7DBU, 0xB7FAU, 0x8799U, 0x97B8U, 0xE75FU, 0xF77EU, 0xC71DU, 0xD73CU,
+		0x26D3U, 0x36F2U, 0x0691U, 0x16B0U, 0x6657U, 0x7676U, 0x4615U, 0x5634U,
+		0xD94CU, 0xC96DU, 0xF90EU, 0xE92FU, 0x99C8U, 0x89E9U, 0xB98AU, 0xA9ABU,
+		0x5844U, 0x4865U, 0x7806U, 0x6827U, 0x18C0U, 0x08E1U, 0x3882U, 0x28A3U,
+		0xCB7DU, 0xDB5CU, 0xEB3FU, 0xFB1EU, 0x8BF9U, 0x9BD8U, 0xABBBU, 0xBB9AU,
+		0x4A75U, 0x5A54U, 0x6A37U, 0x7A16U, 0x0AF1U, 0x1AD0U, 0x2AB3U, 0x3A92U,
+		0xFD2EU, 0xED0FU, 0xDD6CU, 0xCD4DU, 0xBDAAU, 0xAD8BU, 0x9DE8U, 0x8DC9U,
+		0x7C26U, 0x6C07U, 0x5C64U, 0x4C45U, 0x3CA2U, 0x2C83U, 0x1CE0U, 0x0CC1U,
+		0xEF1FU, 0xFF3EU, 0xCF5DU, 0xDF7CU, 0xAF9BU, 0xBFBAU, 0x8FD9U, 0x9FF8U,
+		0x6E17U, 0x7E36U, 0x4E55U, 0x5E74U, 0x2E93U, 0x3EB2U, 0x0ED1U, 0x1EF0U
+	},
+	//byte 2
+	{
+		0x0000U, 0x3331U, 0x6662U, 0x5553U, 0xCCC4U, 0xFFF5U, 0xAAA6U, 0x9997U,
+		0x89A9U, 0xBA98U, 0xEFCBU, 0xDCFAU, 0x456DU, 0x765CU, 0x230FU, 0x103EU,
+		0x0373U, 0x3042U, 0x6511U, 0x5620U, 0xCFB7U, 0xFC86U, 0xA9D5U, 0x9AE4U,
+		0x8ADAU, 0xB9EBU, 0xECB8U, 0xDF89U, 0x461EU, 0x752FU, 0x207CU, 0x134DU,
+		0x06E6U, 0x35D7U, 0x6084U, 0x53B5U, 0xCA22U, 0xF913U, 0xAC40U, 0x9F71U,
+		0x8F4FU, 0xBC7EU, 0xE92DU, 0xDA1CU, 0x438BU, 0x70BAU, 0x25E9U, 0x16D8U,
+		0x0595U, 0x36A4U, 0x63F7U, 0x50C6U, 0xC951U, 0xFA60U, 0xAF33U, 0x9C02U,
+		0x8C3CU, 0xBF0DU, 0xEA5EU, 0xD96FU, 0x40F8U, 0x73C9U, 0x269AU, 0x15ABU,
+		0x0DCCU, 0x3EFDU, 0x6BAEU, 0x589FU, 0xC108U, 0xF239U, 0xA76AU, 0x945BU,
+		0x8465U, 0xB754U, 0xE207U, 0xD136U, 0x48A1U, 0x7B90U, 0x2EC3U, 0x1DF2U,
+		0x0EBFU, 0x3D8EU, 0x68DDU, 0x5BECU, 0xC27BU, 0xF14AU, 0xA419U, 0x9728U,
+		0x8716U, 0xB427U, 0xE174U, 0xD245U, 0x4BD2U, 0x78E3U, 0x2DB0U, 0x1E81U,
+		0x0B2AU, 0x381BU, 0x6D48U, 0x5E79U, 0xC7EEU, 0xF4DFU, 0xA18CU, 0x92BDU,
+		0x8283U, 0xB1B2U, 0xE4E1U, 0xD7D0U, 0x4E47U, 0x7D76U, 0x2825U, 0x1B14U,
+		0x0859U, 0x3B68U, 0x6E3BU, 0x5D0AU, 0xC49DU, 0xF7ACU, 0xA2FFU, 0x91CEU,
+		0x81F0U, 0xB2C1U, 0xE792U, 0xD4A3U, 0x4D34U, 0x7E05U, 0x2B56U, 0x1867U,
+		0x1B98U, 0x28A9U, 0x7DFAU, 0x4ECBU, 0xD75CU, 0xE46DU, 0xB13EU, 0x820FU,
+		0x9231U, 0xA100U, 0xF453U, 0xC762U, 0x5EF5U, 0x6DC4U, 0x3897U, 0x0BA6U,
+		0x18EBU, 0x2BDAU, 0x7E89U, 0x4DB8U, 0xD42FU, 0xE71EU, 0xB24DU, 0x817CU,
+		0x9142U, 0xA273U, 0xF720U, 0xC411U, 0x5D86U, 0x6EB7U, 0x3BE4U, 0x08D5U,
+		0x1D7EU, 0x2E4FU, 0x7B1CU, 0x482DU, 0xD1BAU, 0xE28BU, 0xB7D8U, 0x84E9U,
+		0x94D7U, 0xA7E6U, 0xF2B5U, 0xC184U, 0x5813U, 0x6B22U, 0x3E71U, 0x0D40U,
+		0x1E0DU, 0x2D3CU, 0x786FU, 0x4B5EU, 0xD2C9U, 0xE1F8U, 0xB4ABU, 0x879AU,
+		0x97A4U, 0xA495U, 0xF1C6U, 0xC2F7U, 0x5B60U, 0x6851U, 0x3D02U, 0x0E33U,
+		0x1654U, 0x2565U, 0x7036U, 0x4307U, 0xDA90U, 0xE9A1U, 0xBCF2U, 0x8FC3U,
+		0x9FFDU, 0xACCCU, 0xF99FU, 0xCAAEU, 0x5339U, 0x6008U, 0x355BU, 0x066AU,
+		0x1527U, 0x2616U, 0x7345U, 0x4074U, 0xD9E3U, 0xEAD2U, 0xBF81U, 0x8CB0U,
+		0x9C8EU, 0xAFBFU, 0xFAECU, 0xC9DDU, 0x504AU, 0x637BU, 0x3628U, 0x0519U,
+		0x10B2U, 0x2383U, 0x76D0U, 0x45E1U, 0xDC76U, 0xEF47U, 0xBA14U, 0x8925U,
+		0x991BU, 0xAA2AU, 0xFF79U, 0xCC48U, 0x55DFU, 0x66EEU, 0x33BDU, 0x008CU,
+		0x13C1U, 0x20F0U, 0x75A3U, 0x4692U, 0xDF05U, 0xEC34U, 0xB967U, 0x8A56U,
+		0x9A68U, 0xA959U, 0xFC0AU, 0xCF3BU, 0x56ACU, 0x659DU, 0x30CEU, 0x03FFU
+	},
+	//byte 1
+	{
+		0x0000U, 0x3730U, 0x6E60U, 0x5950U, 0xDCC0U, 0xEBF0U, 0xB2A0U, 0x8590U,
+		0xA9A1U, 0x9E91U, 0xC7C1U, 0xF0F1U, 0x7561U, 0x4251U, 0x1B01U, 0x2C31U,
+		0x4363U, 0x7453U, 0x2D03U, 0x1A33U, 0x9FA3U, 0xA893U, 0xF1C3U, 0xC6F3U,
+		0xEAC2U, 0xDDF2U, 0x84A2U, 0xB392U, 0x3602U, 0x0132U, 0x5862U, 0x6F52U,
+		0x86C6U, 0xB1F6U, 0xE8A6U, 0xDF96U, 0x5A06U, 0x6D36U, 0x3466U, 0x0356U,
+		0x2F67U, 0x1857U, 0x4107U, 0x7637U, 0xF3A7U, 0xC497U, 0x9DC7U, 0xAAF7U,
+		0xC5A5U, 0xF295U, 0xABC5U, 0x9CF5U, 0x1965U, 0x2E55U, 0x7705U, 0x4035U,
+		0x6C04U, 0x5B34U, 0x0264U, 0x3554U, 0xB0C4U, 0x87F4U, 0xDEA4U, 0xE994U,
+		0x1DADU, 0x2A9DU, 0x73CDU, 0x44FDU, 0xC16DU, 0xF65DU, 0xAF0DU, 0x983DU,
+		0xB40CU, 0x833CU, 0xDA6CU, 0xED5CU, 0x68CCU, 0x5FFCU, 0x06ACU, 0x319CU,
+		0x5ECEU, 0x69FEU, 0x30AEU, 0x079EU, 0x820EU, 0xB53EU, 0xEC6EU, 0xDB5EU,
+		0xF76FU, 0xC05FU, 0x990FU, 0xAE3FU, 0x2BAFU, 0x1C9FU, 0x45CFU, 0x72FFU,
+		0x9B6BU, 0xAC5BU, 0xF50BU, 0xC23BU, 0x47ABU, 0x709BU, 0x29CBU, 0x1EFBU,
+		0x32CAU, 0x05FAU, 0x5CAAU, 0x6B9AU, 0xEE0AU, 0xD93AU, 0x806AU, 0xB75AU,
+		0xD808U, 0xEF38U, 0xB668U, 0x8158U, 0x04C8U, 0x33F8U, 0x6AA8U, 0x5D98U,
+		0x71A9U, 0x4699U, 0x1FC9U, 0x28F9U, 0xAD69U, 0x9A59U, 0xC309U, 0xF439U,
+		0x3B5AU, 0x0C6AU, 0x553AU, 0x620AU, 0xE79AU, 0xD0AAU, 0x89FAU, 0xBECAU,
+		0x92FBU, 0xA5CBU, 0xFC9BU, 0xCBABU, 0x4E3BU, 0x790BU, 0x205BU, 0x176BU,
+		0x7839U, 0x4F09U, 0x1659U, 0x2169U, 0xA4F9U, 0x93C9U, 0xCA99U, 0xFDA9U,
+		0xD198U, 0xE6A8U, 0xBFF8U, 0x88C8U, 0x0D58U, 0x3A68U, 0x6338U, 0x5408U,
+		0xBD9CU, 0x8AACU, 0xD3FCU, 0xE4CCU, 0x615CU, 0x566CU, 0x0F3CU, 0x380CU,
+		0x143DU, 0x230DU, 0x7A5DU, 0x4D6DU, 0xC8FDU, 0xFFCDU, 0xA69DU, 0x91ADU,
+		0xFEFFU, 0xC9CFU, 0x909FU, 0xA7AFU, 0x223FU, 0x150FU, 0x4C5FU, 0x7B6FU,
+		0x575EU, 0x606EU, 0x393EU, 0x0E0EU, 0x8B9EU, 0xBCAEU, 0xE5FEU, 0xD2CEU,
+		0x26F7U, 0x11C7U, 0x4897U, 0x7FA7U, 0xFA37U, 0xCD07U, 0x9457U, 0xA367U,
+		0x8F56U, 0xB866U, 0xE136U, 0xD606U, 0x5396U, 0x64A6U, 0x3DF6U, 0x0AC6U,
+		0x6594U, 0x52A4U, 0x0BF4U, 0x3CC4U, 0xB954U, 0x8E64U, 0xD734U, 0xE004U,
+		0xCC35U, 0xFB05U, 0xA255U, 0x9565U, 0x10F5U, 0x27C5U, 0x7E95U, 0x49A5U,
+		0xA031U, 0x9701U, 0xCE51U, 0xF961U, 0x7CF1U, 0x4BC1U, 0x1291U, 0x25A1U,
+		0x0990U, 0x3EA0U, 0x67F0U, 0x50C0U, 0xD550U, 0xE260U, 0xBB30U, 0x8C00U,
+		0xE352U, 0xD462U, 0x8D32U, 0xBA02U, 0x3F92U, 0x08A2U, 0x51F2U, 0x66C2U,
+		0x4AF3U, 0x7DC3U, 0x2493U, 0x13A3U, 0x9633U, 0xA103U, 0xF853U, 0xCF63U
+	},
+	//byte 0, the first byte of a word
+	{
+		0x0000U, 0x76B4U, 0xED68U, 0x9BDCU, 0xCAF1U, 0xBC45U, 0x2799U, 0x512DU,
+		0x85C3U, 0xF377U, 0x68ABU, 0x1E1FU, 0x4F32U, 0x3986U, 0xA25AU, 0xD4EEU,
+		0x1BA7U, 0x6D13U, 0xF6CFU, 0x807BU, 0xD156U, 0xA7E2U, 0x3C3EU, 0x4A8AU,
+		0x9E64U, 0xE8D0U, 0x730CU, 0x05B8U, 0x5495U, 0x2221U, 0xB9FDU, 0xCF49U,
+		0x374EU, 0x41FAU, 0xDA26U, 0xAC92U, 0xFDBFU, 0x8B0BU, 0x10D7U, 0x6663U,
+		0xB28DU, 0xC439U, 0x5FE5U, 0x2951U, 0x787CU, 0x0EC8U, 0x9514U, 0xE3A0U,
+		0x2CE9U, 0x5A5DU, 0xC181U, 0xB735U, 0xE618U, 0x90ACU, 0x0B70U, 0x7DC4U,
+		0xA92AU, 0xDF9EU, 0x4442U, 0x32F6U, 0x63DBU, 0x156FU, 0x8EB3U, 0xF807U,
+		0x6E9CU, 0x1828U, 0x83F4U, 0xF540U, 0xA46DU, 0xD2D9U, 0x4905U, 0x3FB1U,
+		0xEB5FU, 0x9DEBU, 0x0637U, 0x7083U, 0x21AEU, 0x571AU, 0xCCC6U, 0xBA72U,
+		0x753BU, 0x038FU, 0x9853U, 0xEEE7U, 0xBFCAU, 0xC97EU, 0x52A2U, 0x2416U,
+		0xF0F8U, 0x864CU, 0x1D90U, 0x6B24U, 0x3A09U, 0x4CBDU, 0xD761U, 0xA1D5U,
+		0x59D2U, 0x2F66U, 0xB4BAU, 0xC20EU, 0x9323U, 0xE597U, 0x7E4BU, 0x08FFU,
+		0xDC11U, 0xAAA5U, 0x3179U, 0x47CDU, 0x16E0U, 0x6054U, 0xFB88U, 0x8D3CU,
+		0x4275U, 0x34C1U, 0xAF1DU, 0xD9A9U, 0x8884U, 0xFE30U, 0x65ECU, 0x1358U,
+		0xC7B6U, 0xB102U, 0x2ADEU, 0x5C6AU, 0x0D47U, 0x7BF3U, 0xE02FU, 0x969BU,
+		0xDD38U, 0xAB8CU, 0x3050U, 0x46E4U, 0x17C9U, 0x617DU, 0xFAA1U, 0x8C15U,
+		0x58FBU, 0x2E4FU, 0xB593U, 0xC327U, 0x920AU, 0xE4BEU, 0x7F62U, 0x09D6U,
+		0xC69FU, 0xB02BU, 0x2BF7U, 0x5D43U, 0x0C6EU, 0x7ADAU, 0xE106U, 0x97B2U,
+		0x435CU, 0x35E8U, 0xAE34U, 0xD880U, 0x89ADU, 0xFF19U, 0x64C5U, 0x1271U,
+		0xEA76U, 0x9CC2U, 0x071EU, 0x71AAU, 0x2087U, 0x5633U, 0xCDEFU, 0xBB5BU,
+		0x6FB5U, 0x1901U, 0x82DDU, 0xF469U, 0xA544U, 0xD3F0U, 0x482CU, 0x3E98U,
+		0xF1D1U, 0x8765U, 0x1CB9U, 0x6A0DU, 0x3B20U, 0x4D94U, 0xD648U, 0xA0FCU,
+		0x7412U, 0x02A6U, 0x997AU, 0xEFCEU, 0xBEE3U, 0xC857U, 0x538BU, 0x253FU,
+		0xB3A4U, 0xC510U, 0x5ECCU, 0x2878U, 0x7955U, 0x0FE1U, 0x943DU, 0xE289U,
+		0x3667U, 0x40D3U, 0xDB0FU, 0xADBBU, 0xFC96U, 0x8A22U, 0x11FEU, 0x674AU,
+		0xA803U, 0xDEB7U, 0x456BU, 0x33DFU, 0x62F2U, 0x1446U, 0x8F9AU, 0xF92EU,
+		0x2DC0U, 0x5B74U, 0xC0A8U, 0xB61CU, 0xE731U, 0x9185U, 0x0A59U, 0x7CEDU,
+		0x84EAU, 0xF25EU, 0x6982U, 0x1F36U, 0x4E1BU, 0x38AFU, 0xA373U, 0xD5C7U,
+		0x0129U, 0x779DU, 0xEC41U, 0x9AF5U, 0xCBD8U, 0xBD6CU, 0x26B0U, 0x5004U,
+		0x9F4DU, 0xE9F9U, 0x7225U, 0x0491U, 0x55BCU, 0x2308U, 0xB8D4U, 0xCE60U,
+		0x1A8EU, 0x6C3AU, 0xF7E6U, 0x8152U, 0xD07FU, 0xA6CBU, 0x3D17U, 0x4BA3U
+	}
+};
+
+/***************************************************************************//**
+ * @brief
+ * CRC16 over a run of words
+ *
+ * @note
+ * Same CRC as running the bytewise CCITT over the words written out most
+ * significant byte first, so "12345678" as 0x31323334, 0x35363738 gives
+ * 0xA12B.
+ *
+ * @param[in]		u32Count				Number of words
+ * @param[in]		*pu32Words				The words
+ * @return			The CRC
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.004.FUNC.001
+ */
+Luint16 u16PARAMSHADOW_CRC__Words(const Luint32 *pu32Words, Luint32 u32Count)
+{
+	Luint32 u32Counter;
+	Luint32 u32Temp;
+	Luint16 u16CRC;
+
+	u16CRC = 0xFFFFU;
+	for(u32Counter = 0U; u32Counter < u32Count; u32Counter++)
+	{
+		//the CRC only reaches the top two bytes
+		u32Temp = pu32Words[u32Counter] ^ ((Luint32)u16CRC << 16U);
+
+		u16CRC = u16PARAMSHADOW_CRC__Table[3U][(u32Temp >> 24U) & 0xFFU];
+		u16CRC ^= u16PARAMSHADOW_CRC__Table[2U][(u32Temp >> 16U) & 0xFFU];
+		u16CRC ^= u16PARAMSHADOW_CRC__Table[1U][(u32Temp >> 8U) & 0xFFU];
+		u16CRC ^= u16PARAMSHADOW_CRC__Table[0U][u32Temp & 0xFFU];
+	}
+
+	return u16CRC;
+}
+
+
+#endif //#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
@@ -0,0 +1,642 @@
+/**
+ * @file		LCCM672R0_TS_000.C
+ * @brief		Test spec for the parameter shadow and its alternating commits
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM672R0.FILE.003
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM672__ENABLE_TEST_SPEC == 1U
+#if C_LOCALDEF__LCCM672__ENABLE_MIGRATION == 1U
+#ifdef WIN32
+
+//host side only
+#include <stdio.h>
+#include <time.h>
+
+extern struct _strPARAMSHADOW sPARAMSHADOW;
+
+void vLCCM672R0_TS_000_TCASE_001(void);
+void vLCCM672R0_TS_000_TCASE_002(void);
+void vLCCM672R0_TS_000_TCASE_003(void);
+void vLCCM672R0_TS_000_TCASE_004(void);
+void vLCCM672R0_TS_000_TCASE_005(void);
+void vLCCM672R0_TS_000_TCASE_006(void);
+static void vTS000__Erase(void);
+static Luint32 u32TS000__Generation(Luint8 u8Copy);
+static void vTS000__Run_Until(E_PARAMSHADOW_STATES eState);
+static void vTS000__Result(Luint32 u32Fail, const char *pcCase);
+static Luint16 u16TS000__Bitwise_CRC(const Luint32 *pu32Words, Luint32 u32Count);
+
+/** parameter used by the tests, in block 0 */
+#define C_TS000__PARAM							(3U)
+
+/** CRC protected range used by TCASE 005, start, end and CRC word */
+#define C_TS000__RANGE_START					(20U)
+#define C_TS000__RANGE_END						(24U)
+#define C_TS000__RANGE_CRC						(25U)
+
+/** words in the CRC test buffer, and passes over it for the timing */
+#define C_TS000__CRC_WORDS						(256U)
+#define C_TS000__CRC_LOOPS						(2000U)
+
+//Function to call the tests for this test specification
+void vLCCM672R0_TS_000(void)
+{
+	//Call the test cases
+	vLCCM672R0_TS_000_TCASE_001();
+	vLCCM672R0_TS_000_TCASE_002();
+	vLCCM672R0_TS_000_TCASE_003();
+	vLCCM672R0_TS_000_TCASE_004();
+	vLCCM672R0_TS_000_TCASE_005();
+	vLCCM672R0_TS_000_TCASE_006();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM672R0.TS.000.TCASE.001
+ * @st_test_desc
+ * With both copies blank the image must come from LCCM188 and be committed
+ * straight away, to copy A only. A reboot must then load copy A with nothing
+ * waiting.
+ *
+*/
+void vLCCM672R0_TS_000_TCASE_001(void)
+{
+	Luint32 u32Fail;
+	Luint32 u32Header[C_PARAMSHADOW__HEADER_WORDS];
+
+	DEBUG_PRINT("START:LCCM672R0.TS.000.TCASE.001\r\n");
+	u32Fail = 0U;
+
+	vTS000__Erase();
+	vEEPARAM__WriteU32(C_TS000__PARAM, 0x12345678U, 0U);
+
+	vPARAMSHADOW__Init();
+	if((sPARAMSHADOW.u8Source != C_PARAMSHADOW__SOURCE_LEGACY) || (u32PARAMSHADOW__Read(C_TS000__PARAM) != 0x12345678U) || (u8PARAMSHADOW__Is_Busy() != 1U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vPARAMSHADOW__Flush();
+	vPARAMSHADOW_WIN32__Read(1U, 0U, &u32Header[0], C_PARAMSHADOW__HEADER_WORDS);
+	if((sPARAMSHADOW.u32Commits != 1U) || (sPARAMSHADOW.u8Newest != 0U) || (u32Header[0] != 0xFFFFFFFFU) || (u8PARAMSHADOW__Is_Busy() != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//reboot
+	vPARAMSHADOW__Init();
+	if((sPARAMSHADOW.u8Source != C_PARAMSHADOW__SOURCE_COPY_A) || (u32PARAMSHADOW__Read(C_TS000__PARAM) != 0x12345678U) || (u8PARAMSHADOW__Is_Busy() != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM672R0.TS.000.TCASE.001");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM672R0.TS.000.TCASE.002
+ * @st_test_desc
+ * Rewriting a value must not start a commit. A run of writes must wait for
+ * the holdoff and go out as one commit. Each commit must go to the copy that
+ * was not newest, leave the other copy untouched and raise the generation by
+ * one, and a reboot must load the newest copy.
+ *
+*/
+void vLCCM672R0_TS_000_TCASE_002(void)
+{
+	Luint32 u32Fail;
+	Luint32 u32Counter;
+	Luint32 u32Gen;
+	Luint32 u32Other[C_PARAMSHADOW__COPY_WORDS];
+	Luint32 u32After[C_PARAMSHADOW__COPY_WORDS];
+	Luint8 u8Expect;
+	Luint8 u8Pass;
+
+	DEBUG_PRINT("START:LCCM672R0.TS.000.TCASE.002\r\n");
+	u32Fail = 0U;
+
+	vPARAMSHADOW__Init();
+	vPARAMSHADOW__WriteU32(C_TS000__PARAM, u32PARAMSHADOW__Read(C_TS000__PARAM));
+	if(u8PARAMSHADOW__Is_Busy() != 0U)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	for(u8Pass = 0U; u8Pass < 4U; u8Pass++)
+	{
+		u32Gen = sPARAMSHADOW.u32Generation;
+		u8Expect = 1U - sPARAMSHADOW.u8Newest;
+		vPARAMSHADOW_WIN32__Read(sPARAMSHADOW.u8Newest, 0U, &u32Other[0], C_PARAMSHADOW__COPY_WORDS);
+
+		//a run of writes, first and last block, interleaved with passes
+		for(u32Counter = 0U; u32Counter < 10U; u32Counter++)
+		{
+			vPARAMSHADOW__WriteU32((Luint16)u32Counter, 0xA0000000U + (u8Pass * 0x100U) + u32Counter);
+			vPARAMSHADOW__WriteF32(C_LOCALDEF__LCCM672__NUM_PARAMETERS - 1U, (Lfloat32)(u32Counter + u8Pass) * 0.5F);
+			vPARAMSHADOW__Process();
+			if(sPARAMSHADOW.eState != PARAMSHADOW_STATE__IDLE)
+			{
+				u32Fail++;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+
+		//passes until the commit starts, counting the one after the last write
+		u32Counter = 1U;
+		while((sPARAMSHADOW.eState == PARAMSHADOW_STATE__IDLE) && (u32Counter < (C_LOCALDEF__LCCM672__HOLDOFF * 2U)))
+		{
+			vPARAMSHADOW__Process();
+			u32Counter++;
+		}
+		if((u32Counter < C_LOCALDEF__LCCM672__HOLDOFF) || (sPARAMSHADOW.eState != PARAMSHADOW_STATE__WRITE) || (sPARAMSHADOW.u8Target != u8Expect))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+		vTS000__Run_Until(PARAMSHADOW_STATE__IDLE);
+
+		//the copy that was newest must not have been touched
+		vPARAMSHADOW_WIN32__Read(1U - u8Expect, 0U, &u32After[0], C_PARAMSHADOW__COPY_WORDS);
+		for(u32Counter = 0U; u32Counter < C_PARAMSHADOW__COPY_WORDS; u32Counter++)
+		{
+			if(u32After[u32Counter] != u32Other[u32Counter])
+			{
+				u32Fail++;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+
+		if((sPARAMSHADOW.u32Generation != (u32Gen + 1U)) || (sPARAMSHADOW.u8Newest != u8Expect) || (u32TS000__Generation(u8Expect) != (u32Gen + 1U)) || (u8PARAMSHADOW__Is_Busy() != 0U))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+
+		//reboot
+		vPARAMSHADOW__Init();
+		if((sPARAMSHADOW.u8Source != u8Expect) || (u32PARAMSHADOW__Read(9U) != (0xA0000009U + (u8Pass * 0x100U))) || (f32PARAMSHADOW__Read(C_LOCALDEF__LCCM672__NUM_PARAMETERS - 1U) != ((Lfloat32)(9U + u8Pass) * 0.5F)) || (u8PARAMSHADOW__Is_Busy() != 0U))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	vTS000__Result(u32Fail, "LCCM672R0.TS.000.TCASE.002");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM672R0.TS.000.TCASE.003
+ * @st_test_desc
+ * Power loss after the target copy's blocks but before its header must boot
+ * the last commit from the other copy, and the next commit must go back to the
+ * damaged copy. Power loss after the header must boot the new value.
+ *
+*/
+void vLCCM672R0_TS_000_TCASE_003(void)
+{
+	Luint32 u32Fail;
+	Luint32 u32Old;
+	Luint8 u8Newest;
+
+	DEBUG_PRINT("START:LCCM672R0.TS.000.TCASE.003\r\n");
+	u32Fail = 0U;
+
+	vPARAMSHADOW__Init();
+	u32Old = u32PARAMSHADOW__Read(C_TS000__PARAM);
+	u8Newest = sPARAMSHADOW.u8Newest;
+
+	//loss before the header
+	vPARAMSHADOW__WriteU32(C_TS000__PARAM, u32Old + 1U);
+	sPARAMSHADOW.u8Flush = 1U;
+	vTS000__Run_Until(PARAMSHADOW_STATE__HEADER);
+	vPARAMSHADOW__Init();
+	if((sPARAMSHADOW.u8Source != u8Newest) || (u32PARAMSHADOW__Read(C_TS000__PARAM) != u32Old) || (u8PARAMSHADOW__Is_Busy() != 0U) || ((sPARAMSHADOW.u8Stale[0] & (Luint8)(1U << (1U - u8Newest))) == 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//next commit goes to the copy that was damaged
+	vPARAMSHADOW__WriteU32(C_TS000__PARAM, u32Old + 2U);
+	vPARAMSHADOW__Flush();
+	if(sPARAMSHADOW.u8Newest != (1U - u8Newest))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//loss straight after the header
+	u8Newest = sPARAMSHADOW.u8Newest;
+	vPARAMSHADOW__WriteU32(C_TS000__PARAM, u32Old + 3U);
+	sPARAMSHADOW.u8Flush = 1U;
+	vTS000__Run_Until(PARAMSHADOW_STATE__IDLE);
+	vPARAMSHADOW__Init();
+	if((sPARAMSHADOW.u8Source != (1U - u8Newest)) || (u32PARAMSHADOW__Read(C_TS000__PARAM) != (u32Old + 3U)) || (u8PARAMSHADOW__Is_Busy() != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM672R0.TS.000.TCASE.003");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM672R0.TS.000.TCASE.004
+ * @st_test_desc
+ * A damaged word in the newest copy must fail that block's CRC and boot the
+ * generation before from the other copy. The next commit must rewrite the
+ * damaged copy with a generation above both, and boot from it.
+ *
+*/
+void vLCCM672R0_TS_000_TCASE_004(void)
+{
+	Luint32 u32Fail;
+	Luint32 u32Word;
+	Luint32 u32Old;
+	Luint32 u32Gen;
+	Luint8 u8Newest;
+
+	DEBUG_PRINT("START:LCCM672R0.TS.000.TCASE.004\r\n");
+	u32Fail = 0U;
+
+	//two commits so each copy holds a different value
+	vPARAMSHADOW__Init();
+	u32Old = u32PARAMSHADOW__Read(C_TS000__PARAM) + 10U;
+	vPARAMSHADOW__WriteU32(C_TS000__PARAM, u32Old);
+	vPARAMSHADOW__Flush();
+	vPARAMSHADOW__WriteU32(C_TS000__PARAM, u32Old + 1U);
+	vPARAMSHADOW__Flush();
+	u8Newest = sPARAMSHADOW.u8Newest;
+	u32Gen = sPARAMSHADOW.u32Generation;
+
+	//flip a bit in the parameter in the newest copy, block 0
+	vPARAMSHADOW_WIN32__Read(u8Newest, C_PARAMSHADOW__HEADER_WORDS + 1U + C_TS000__PARAM, &u32Word, 1U);
+	u32Word ^= 0x00010000U;
+	vPARAMSHADOW_WIN32__Write(u8Newest, C_PARAMSHADOW__HEADER_WORDS + 1U + C_TS000__PARAM, &u32Word, 1U);
+
+	vPARAMSHADOW__Init();
+	if((sPARAMSHADOW.u8Source != (1U - u8Newest)) || (u32PARAMSHADOW__Read(C_TS000__PARAM) != u32Old) || (sPARAMSHADOW.u32Generation != u32Gen))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vPARAMSHADOW__WriteU32(C_TS000__PARAM, u32Old + 5U);
+	vPARAMSHADOW__Flush();
+	vPARAMSHADOW__Init();
+	if((sPARAMSHADOW.u8Source != u8Newest) || (sPARAMSHADOW.u32Generation != (u32Gen + 1U)) || (u32PARAMSHADOW__Read(C_TS000__PARAM) != (u32Old + 5U)) || (u8PARAMSHADOW__Is_Busy() != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM672R0.TS.000.TCASE.004");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM672R0.TS.000.TCASE.005
+ * @st_test_desc
+ * A range with a good LCCM188 CRC must pass straight after migration and be
+ * restamped with our CRC, so it still passes once booted from a copy. A range
+ * with a bad CRC in both must fail.
+ *
+*/
+void vLCCM672R0_TS_000_TCASE_005(void)
+{
+	Luint32 u32Fail;
+	Luint16 u16Counter;
+
+	DEBUG_PRINT("START:LCCM672R0.TS.000.TCASE.005\r\n");
+	u32Fail = 0U;
+
+	vTS000__Erase();
+	for(u16Counter = C_TS000__RANGE_START; u16Counter <= C_TS000__RANGE_END; u16Counter++)
+	{
+		vEEPARAM__WriteU32(u16Counter, 0x1000U + u16Counter, 0U);
+	}
+	vEEPARAM_CRC__Calculate_And_Store_CRC(C_TS000__RANGE_START, C_TS000__RANGE_END, C_TS000__RANGE_CRC);
+
+	//a second range with a CRC that is wrong everywhere
+	vEEPARAM__WriteU32(C_TS000__RANGE_CRC + 1U, 0x55U, 0U);
+	vEEPARAM__WriteU32(C_TS000__RANGE_CRC + 2U, 0xDEADU, 0U);
+
+	vPARAMSHADOW__Init();
+	if((u8PARAMSHADOW__Is_CRC_OK(C_TS000__RANGE_START, C_TS000__RANGE_END, C_TS000__RANGE_CRC) != 1U) || (u8PARAMSHADOW__Is_CRC_OK(C_TS000__RANGE_CRC + 1U, C_TS000__RANGE_CRC + 1U, C_TS000__RANGE_CRC + 2U) != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vPARAMSHADOW__Flush();
+	vPARAMSHADOW__Init();
+	if((sPARAMSHADOW.u8Source != C_PARAMSHADOW__SOURCE_COPY_A) || (u8PARAMSHADOW__Is_CRC_OK(C_TS000__RANGE_START, C_TS000__RANGE_END, C_TS000__RANGE_CRC) != 1U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//a write in the range breaks it until the CRC is stored again
+	vPARAMSHADOW__WriteU32(C_TS000__RANGE_START + 1U, 0x77U);
+	if(u8PARAMSHADOW__Is_CRC_OK(C_TS000__RANGE_START, C_TS000__RANGE_END, C_TS000__RANGE_CRC) != 0U)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	vPARAMSHADOW__Store_CRC(C_TS000__RANGE_START, C_TS000__RANGE_END, C_TS000__RANGE_CRC);
+	if(u8PARAMSHADOW__Is_CRC_OK(C_TS000__RANGE_START, C_TS000__RANGE_END, C_TS000__RANGE_CRC) != 1U)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM672R0.TS.000.TCASE.005");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM672R0.TS.000.TCASE.006
+ * @st_test_desc
+ * The slice by 4 CRC must give the CCITT check value for "12345678" and
+ * match a bit by bit CCITT for every length up to the test buffer. The time
+ * for both is printed.
+ *
+*/
+void vLCCM672R0_TS_000_TCASE_006(void)
+{
+	Luint32 u32Fail;
+	Luint32 u32Counter;
+	Luint32 u32Loop;
+	Luint32 u32Words[C_TS000__CRC_WORDS];
+	Luint32 u32Check[2];
+	Luint16 u16Sink;
+	clock_t tStart;
+	Lfloat64 f64Bitwise;
+	Lfloat64 f64Slice;
+	char cText[160];
+
+	DEBUG_PRINT("START:LCCM672R0.TS.000.TCASE.006\r\n");
+	u32Fail = 0U;
+
+	//"12345678"
+	u32Check[0] = 0x31323334U;
+	u32Check[1] = 0x35363738U;
+	if((u16PARAMSHADOW_CRC__Words(&u32Check[0], 2U) != 0xA12BU) || (u16PARAMSHADOW_CRC__Words(&u32Check[0], 0U) != 0xFFFFU))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	u32Words[0] = 0x9E3779B9U;
+	for(u32Counter = 1U; u32Counter < C_TS000__CRC_WORDS; u32Counter++)
+	{
+		u32Words[u32Counter] = (u32Words[u32Counter - 1U] * 1664525U) + 1013904223U;
+	}
+	for(u32Counter = 0U; u32Counter <= C_TS000__CRC_WORDS; u32Counter++)
+	{
+		if(u16PARAMSHADOW_CRC__Words(&u32Words[0], u32Counter) != u16TS000__Bitwise_CRC(&u32Words[0], u32Counter))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	u16Sink = 0U;
+	tStart = clock();
+	for(u32Loop = 0U; u32Loop < C_TS000__CRC_LOOPS; u32Loop++)
+	{
+		//feed the last CRC back in so nothing is hoisted out of the loop
+		u32Words[0] += (Luint32)u16Sink;
+		u16Sink = u16TS000__Bitwise_CRC(&u32Words[0], C_TS000__CRC_WORDS);
+	}
+	f64Bitwise = (Lfloat64)(clock() - tStart + 1) / (Lfloat64)CLOCKS_PER_SEC;
+
+	tStart = clock();
+	for(u32Loop = 0U; u32Loop < C_TS000__CRC_LOOPS; u32Loop++)
+	{
+		u32Words[0] += (Luint32)u16Sink;
+		u16Sink = u16PARAMSHADOW_CRC__Words(&u32Words[0], C_TS000__CRC_WORDS);
+	}
+	f64Slice = (Lfloat64)(clock() - tStart + 1) / (Lfloat64)CLOCKS_PER_SEC;
+
+	sprintf(cText, "INFO: bitwise %.1f MB/s, slice by 4 %.1f MB/s, %.2fx (%04X)\r\n",
+			((Lfloat64)C_TS000__CRC_LOOPS * C_TS000__CRC_WORDS * 4.0) / (f64Bitwise * 1.0E6),
+			((Lfloat64)C_TS000__CRC_LOOPS * C_TS000__CRC_WORDS * 4.0) / (f64Slice * 1.0E6),
+			f64Bitwise / f64Slice, (Luint32)u16Sink);
+	DEBUG_PRINT(cText);
+
+	vTS000__Result(u32Fail, "LCCM672R0.TS.000.TCASE.006");
+}
+
+/***************************************************************************//**
+ * @brief
+ * Blank both simulated copies
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.003.FUNC.001
+ */
+static void vTS000__Erase(void)
+{
+	Luint32 u32Blank[C_PARAMSHADOW__HEADER_WORDS];
+	Luint32 u32Counter;
+
+	for(u32Counter = 0U; u32Counter < C_PARAMSHADOW__HEADER_WORDS; u32Counter++)
+	{
+		u32Blank[u32Counter] = 0xFFFFFFFFU;
+	}
+	vPARAMSHADOW_WIN32__Write(0U, 0U, &u32Blank[0], C_PARAMSHADOW__HEADER_WORDS);
+	vPARAMSHADOW_WIN32__Write(1U, 0U, &u32Blank[0], C_PARAMSHADOW__HEADER_WORDS);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Get the generation from a simulated copy header
+ *
+ * @param[in]		u8Copy					0 = A, 1 = B
+ * @return			The generation word
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.003.FUNC.002
+ */
+static Luint32 u32TS000__Generation(Luint8 u8Copy)
+{
+	Luint32 u32Header[C_PARAMSHADOW__HEADER_WORDS];
+
+	vPARAMSHADOW_WIN32__Read(u8Copy, 0U, &u32Header[0], C_PARAMSHADOW__HEADER_WORDS);
+
+	return u32Header[1];
+}
+
+/***************************************************************************//**
+ * @brief
+ * Run process passes until the commit reaches a state
+ *
+ * @param[in]		eState					State to stop in
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.003.FUNC.003
+ */
+static void vTS000__Run_Until(E_PARAMSHADOW_STATES eState)
+{
+	Luint32 u32Guard;
+
+	//always at least one pass, so IDLE means the next IDLE
+	u32Guard = 0U;
+	do
+	{
+		vPARAMSHADOW__Process();
+		u32Guard++;
+	}while((sPARAMSHADOW.eState != eState) && (u32Guard < 10000U));
+}
+
+/***************************************************************************//**
+ * @brief
+ * Print the result of a test case
+ *
+ * @param[in]		*pcCase					Test case ID
+ * @param[in]		u32Fail					Number of failed checks
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.003.FUNC.004
+ */
+static void vTS000__Result(Luint32 u32Fail, const char *pcCase)
+{
+	char cText[200];
+
+	if(u32Fail == 0U)
+	{
+		sprintf(cText, "PASS:%s\r\n", pcCase);
+	}
+	else
+	{
+		sprintf(cText, "FAIL:%s (%u)\r\n", pcCase, u32Fail);
+	}
+	DEBUG_PRINT(cText);
+
+	sprintf(cText, "END:%s\r\n", pcCase);
+	DEBUG_PRINT(cText);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Bit by bit CCITT over words, most significant byte first, to check the
+ * table version against
+ *
+ * @param[in]		u32Count				Number of words
+ * @param[in]		*pu32Words				The words
+ * @return			The CRC
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.003.FUNC.005
+ */
+static Luint16 u16TS000__Bitwise_CRC(const Luint32 *pu32Words, Luint32 u32Count)
+{
+	Luint32 u32Counter;
+	Luint32 u32Byte;
+	Luint32 u32Bit;
+	Luint16 u16CRC;
+
+	u16CRC = 0xFFFFU;
+	for(u32Counter = 0U; u32Counter < u32Count; u32Counter++)
+	{
+		for(u32Byte = 0U; u32Byte < 4U; u32Byte++)
+		{
+			u16CRC ^= (Luint16)(((pu32Words[u32Counter] >> (24U - (u32Byte * 8U))) & 0xFFU) << 8U);
+			for(u32Bit = 0U; u32Bit < 8U; u32Bit++)
+			{
+				if((u16CRC & 0x8000U) != 0U)
+				{
+					u16CRC = (Luint16)((u16CRC << 1U) ^ 0x1021U);
+				}
+				else
+				{
+					u16CRC = (Luint16)(u16CRC << 1U);
+				}
+			}
+		}
+	}
+
+	return u16CRC;
+}
+
+#endif //WIN32
+#endif //#if C_LOCALDEF__LCCM672__ENABLE_MIGRATION == 1U
+#endif //#if C_LOCALDEF__LCCM672__ENABLE_TEST_SPEC == 1U
+#endif //#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE
+	#error
+#endif
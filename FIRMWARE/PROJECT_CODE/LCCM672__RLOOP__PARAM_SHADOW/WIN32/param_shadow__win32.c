@@ -0,0 +1,92 @@
+/**
+ * @file		PARAM_SHADOW__WIN32.C
+ * @brief		WIN32 Emulation Layer, the two copies are simulated in RAM
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM672R0.FILE.001
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PARAMSHADOW
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PARAMSHADOW__WIN32
+ * @ingroup PARAMSHADOW
+ * @{ */
+
+#include "../param_shadow.h"
+#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+#ifdef WIN32
+
+//simulated memory for the two copies
+static Luint32 u32PARAMSHADOW_WIN32__Copy[2][C_PARAMSHADOW__COPY_WORDS];
+
+/***************************************************************************//**
+ * @brief
+ * Read words from a simulated copy
+ *
+ * @param[in]		u16Count				Number of words
+ * @param[out]		*pu32Words				Words read
+ * @param[in]		u16Offset				Word offset in the copy
+ * @param[in]		u8Copy					0 = A, 1 = B
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.001.FUNC.001
+ */
+void vPARAMSHADOW_WIN32__Read(Luint8 u8Copy, Luint16 u16Offset, Luint32 *pu32Words, Luint16 u16Count)
+{
+	Luint16 u16Counter;
+
+	if((u8Copy < 2U) && (((Luint32)u16Offset + (Luint32)u16Count) <= C_PARAMSHADOW__COPY_WORDS))
+	{
+		for(u16Counter = 0U; u16Counter < u16Count; u16Counter++)
+		{
+			pu32Words[u16Counter] = u32PARAMSHADOW_WIN32__Copy[u8Copy][u16Offset + u16Counter];
+		}
+	}
+	else
+	{
+		//out of range
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Write words to a simulated copy
+ *
+ * @param[in]		u16Count				Number of words
+ * @param[in]		*pu32Words				Words to write
+ * @param[in]		u16Offset				Word offset in the copy
+ * @param[in]		u8Copy					0 = A, 1 = B
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.001.FUNC.002
+ */
+void vPARAMSHADOW_WIN32__Write(Luint8 u8Copy, Luint16 u16Offset, const Luint32 *pu32Words, Luint16 u16Count)
+{
+	Luint16 u16Counter;
+
+	if((u8Copy < 2U) && (((Luint32)u16Offset + (Luint32)u16Count) <= C_PARAMSHADOW__COPY_WORDS))
+	{
+		for(u16Counter = 0U; u16Counter < u16Count; u16Counter++)
+		{
+			u32PARAMSHADOW_WIN32__Copy[u8Copy][u16Offset + u16Counter] = pu32Words[u16Counter];
+		}
+	}
+	else
+	{
+		//out of range
+	}
+}
+
+#endif //WIN32
+#endif //#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
@@ -0,0 +1,791 @@
+/**
+ * @file		PARAM_SHADOW.C
+ * @brief		RAM shadow of the parameter store with alternating A/B commits
+ *
+ * @note
+ * The whole parameter image is read into RAM once at boot. After that every
+ * read comes from RAM and every write just updates RAM and marks its block
+ * stale in both copies. Nothing touches the memory until vPARAMSHADOW__Process()
+ * has seen no new writes for C_LOCALDEF__LCCM672__HOLDOFF passes, so a run of
+ * writes (calibration, a set of defaults and its CRC) ends up as one commit.
+ *
+ * Two copies are kept, A and B, each in its own erase unit. A commit only goes
+ * to one copy, the one that does NOT hold the newest generation, so the two
+ * copies take turns. The commit writes every block that copy is stale on, one
+ * memory write per pass, then the copy header with the next generation number.
+ * Blocks that changed in the previous commit are still stale on this copy, so
+ * it always ends up holding the whole image.
+ *
+ * Each block record carries its own CRC and the generation of the commit that
+ * wrote it. A copy is only good if its header is good and no block in it is
+ * newer than the header, so a copy with half a commit in it is rejected. The
+ * copy that was not being written still holds the generation before, and at
+ * boot the good copy with the highest generation wins.
+ *
+ * If neither copy is good at boot (first boot with the shadow, or both lost)
+ * the image is migrated from LCCM188, or starts blank if migration is off.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM672R0.FILE.000
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PARAMSHADOW
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PARAMSHADOW__CORE
+ * @ingroup PARAMSHADOW
+ * @{ */
+
+#include "param_shadow.h"
+#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+
+#ifndef WIN32
+	#if (C_PARAMSHADOW__COPY_WORDS * 4U) > C_LCCM320__FLASH_SECTOR_SIZE_BYTES
+		//a copy has to fit in one sector
+		#error
+	#endif
+#endif
+
+//the shadow
+struct _strPARAMSHADOW sPARAMSHADOW;
+
+//locals
+static Luint8 u8PARAMSHADOW__Read_Header(Luint8 u8Copy, Luint32 *pu32Generation);
+static Luint8 u8PARAMSHADOW__Check_Copy(Luint8 u8Copy, Luint32 u32Generation, Luint8 u8Load);
+static void vPARAMSHADOW__Write_Block(Luint8 u8Copy, Luint16 u16Block);
+static void vPARAMSHADOW__Write_Header(Luint8 u8Copy);
+static Luint16 u16PARAMSHADOW__Next_Block(Luint16 u16Start);
+static Luint16 u16PARAMSHADOW__Range_CRC(Luint16 u16StartIndex, Luint16 u16EndIndex);
+
+
+/***************************************************************************//**
+ * @brief
+ * Load the parameter image into RAM
+ *
+ * @note
+ * With migration on, call after vEEPARAM__Init(). Anything that reads a
+ * parameter before this gets 0.
+ *
+ * The newest good copy is loaded. The other copy is compared block by block
+ * and anything it does not hold is marked stale for it, so the next commit,
+ * which goes to that copy, brings it up to date. Nothing is written at boot
+ * unless there was no good copy at all.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.001
+ */
+void vPARAMSHADOW__Init(void)
+{
+	Luint8 u8Valid[2];
+	Luint32 u32Gen[2];
+	Luint8 u8First;
+	Luint8 u8Other;
+	Luint8 u8Loaded;
+	Luint16 u16Counter;
+
+	sPARAMSHADOW.eState = PARAMSHADOW_STATE__IDLE;
+	sPARAMSHADOW.u16Block = 0U;
+	sPARAMSHADOW.u8Target = 0U;
+	sPARAMSHADOW.u32Holdoff = 0U;
+	sPARAMSHADOW.u8Flush = 0U;
+	sPARAMSHADOW.u8NewWrites = 0U;
+	sPARAMSHADOW.u32Pending = 0U;
+	sPARAMSHADOW.u32Commits = 0U;
+	for(u16Counter = 0U; u16Counter < C_PARAMSHADOW__NUM_BLOCKS; u16Counter++)
+	{
+		sPARAMSHADOW.u8Stale[u16Counter] = 0U;
+		sPARAMSHADOW.u8Commit[u16Counter] = 0U;
+	}
+
+	u8Valid[0] = u8PARAMSHADOW__Read_Header(0U, &u32Gen[0]);
+	u8Valid[1] = u8PARAMSHADOW__Read_Header(1U, &u32Gen[1]);
+
+	//always count up from the highest header that survived, even one whose
+	//blocks are bad, so the copy that gets rewritten comes out newest
+	sPARAMSHADOW.u32Generation = 0U;
+	if((u8Valid[0] == 1U) && (u32Gen[0] > sPARAMSHADOW.u32Generation))
+	{
+		sPARAMSHADOW.u32Generation = u32Gen[0];
+	}
+	else
+	{
+		//fall on
+	}
+	if((u8Valid[1] == 1U) && (u32Gen[1] > sPARAMSHADOW.u32Generation))
+	{
+		sPARAMSHADOW.u32Generation = u32Gen[1];
+	}
+	else
+	{
+		//fall on
+	}
+
+	//newest first
+	if((u8Valid[1] == 1U) && ((u8Valid[0] == 0U) || (u32Gen[1] > u32Gen[0])))
+	{
+		u8First = 1U;
+	}
+	else
+	{
+		u8First = 0U;
+	}
+	u8Other = 1U - u8First;
+
+	u8Loaded = 0U;
+	if(u8Valid[u8First] == 1U)
+	{
+		u8Loaded = u8PARAMSHADOW__Check_Copy(u8First, u32Gen[u8First], 1U);
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(u8Loaded == 0U)
+	{
+		//newest was bad, fall back to the other
+		u8First = u8Other;
+		u8Other = 1U - u8First;
+		if(u8Valid[u8First] == 1U)
+		{
+			u8Loaded = u8PARAMSHADOW__Check_Copy(u8First, u32Gen[u8First], 1U);
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(u8Loaded == 1U)
+	{
+		sPARAMSHADOW.u8Source = u8First;
+		sPARAMSHADOW.u8Newest = u8First;
+
+		//find what the other copy is missing
+		if(u8Valid[u8Other] == 1U)
+		{
+			(void)u8PARAMSHADOW__Check_Copy(u8Other, u32Gen[u8Other], 0U);
+		}
+		else
+		{
+			for(u16Counter = 0U; u16Counter < C_PARAMSHADOW__NUM_BLOCKS; u16Counter++)
+			{
+				sPARAMSHADOW.u8Stale[u16Counter] = (Luint8)(1U << u8Other);
+			}
+		}
+	}
+	else
+	{
+		for(u16Counter = 0U; u16Counter < (C_PARAMSHADOW__NUM_BLOCKS * C_LOCALDEF__LCCM672__BLOCK_SIZE); u16Counter++)
+		{
+			#if C_LOCALDEF__LCCM672__ENABLE_MIGRATION == 1U
+				if(u16Counter < C_LOCALDEF__LCCM672__NUM_PARAMETERS)
+				{
+					sPARAMSHADOW.u32Image[u16Counter] = u32EEPARAM__Read(u16Counter);
+				}
+				else
+				{
+					sPARAMSHADOW.u32Image[u16Counter] = 0U;
+				}
+			#else
+				sPARAMSHADOW.u32Image[u16Counter] = 0U;
+			#endif
+		}
+		#if C_LOCALDEF__LCCM672__ENABLE_MIGRATION == 1U
+			sPARAMSHADOW.u8Source = C_PARAMSHADOW__SOURCE_LEGACY;
+		#else
+			sPARAMSHADOW.u8Source = C_PARAMSHADOW__SOURCE_BLANK;
+		#endif
+
+		//neither copy holds anything, commit to A straight away
+		sPARAMSHADOW.u8Newest = 1U;
+		for(u16Counter = 0U; u16Counter < C_PARAMSHADOW__NUM_BLOCKS; u16Counter++)
+		{
+			sPARAMSHADOW.u8Stale[u16Counter] = 0x03U;
+		}
+		sPARAMSHADOW.u8NewWrites = 1U;
+		sPARAMSHADOW.u8Flush = 1U;
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Background commit, call from the main loop
+ *
+ * @note
+ * Does at most one memory write per call. Each commit goes to the copy that
+ * does not hold the newest generation.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.002
+ */
+void vPARAMSHADOW__Process(void)
+{
+	Luint16 u16Counter;
+	Luint8 u8Mask;
+
+	switch(sPARAMSHADOW.eState)
+	{
+		case PARAMSHADOW_STATE__IDLE:
+			if(sPARAMSHADOW.u8NewWrites == 1U)
+			{
+				if((sPARAMSHADOW.u32Holdoff >= C_LOCALDEF__LCCM672__HOLDOFF) || (sPARAMSHADOW.u8Flush == 1U))
+				{
+					//latch what this copy is missing, writes from here on go in the next commit
+					sPARAMSHADOW.u8Target = 1U - sPARAMSHADOW.u8Newest;
+					u8Mask = (Luint8)(1U << sPARAMSHADOW.u8Target);
+					for(u16Counter = 0U; u16Counter < C_PARAMSHADOW__NUM_BLOCKS; u16Counter++)
+					{
+						sPARAMSHADOW.u8Commit[u16Counter] = sPARAMSHADOW.u8Stale[u16Counter] & u8Mask;
+						sPARAMSHADOW.u8Stale[u16Counter] &= (Luint8)(~u8Mask);
+					}
+					sPARAMSHADOW.u8NewWrites = 0U;
+					sPARAMSHADOW.u8Flush = 0U;
+
+					sPARAMSHADOW.u32Pending = sPARAMSHADOW.u32Generation + 1U;
+					sPARAMSHADOW.u16Block = u16PARAMSHADOW__Next_Block(0U);
+					sPARAMSHADOW.eState = PARAMSHADOW_STATE__WRITE;
+				}
+				else
+				{
+					//still waiting for the writes to settle
+					sPARAMSHADOW.u32Holdoff++;
+				}
+			}
+			else
+			{
+				//nothing to do
+			}
+			break;
+
+		case PARAMSHADOW_STATE__WRITE:
+			vPARAMSHADOW__Write_Block(sPARAMSHADOW.u8Target, sPARAMSHADOW.u16Block);
+			sPARAMSHADOW.u16Block = u16PARAMSHADOW__Next_Block(sPARAMSHADOW.u16Block + 1U);
+			if(sPARAMSHADOW.u16Block >= C_PARAMSHADOW__NUM_BLOCKS)
+			{
+				sPARAMSHADOW.eState = PARAMSHADOW_STATE__HEADER;
+			}
+			else
+			{
+				//more to do
+			}
+			break;
+
+		case PARAMSHADOW_STATE__HEADER:
+			//the target copy now holds the newest generation
+			vPARAMSHADOW__Write_Header(sPARAMSHADOW.u8Target);
+			for(u16Counter = 0U; u16Counter < C_PARAMSHADOW__NUM_BLOCKS; u16Counter++)
+			{
+				sPARAMSHADOW.u8Commit[u16Counter] = 0U;
+			}
+			sPARAMSHADOW.u32Generation = sPARAMSHADOW.u32Pending;
+			sPARAMSHADOW.u8Newest = sPARAMSHADOW.u8Target;
+			sPARAMSHADOW.u32Commits++;
+			sPARAMSHADOW.eState = PARAMSHADOW_STATE__IDLE;
+			break;
+
+		default:
+			//should not get here
+			sPARAMSHADOW.eState = PARAMSHADOW_STATE__IDLE;
+			break;
+
+	}//switch(sPARAMSHADOW.eState)
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Commit any new writes now and wait for it
+ *
+ * @note
+ * Blocks until the commit is written, use before a reset. Only one copy is
+ * written, the other keeps the generation before.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.003
+ */
+void vPARAMSHADOW__Flush(void)
+{
+	while((sPARAMSHADOW.eState != PARAMSHADOW_STATE__IDLE) || (sPARAMSHADOW.u8NewWrites == 1U))
+	{
+		sPARAMSHADOW.u8Flush = 1U;
+		vPARAMSHADOW__Process();
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Is anything waiting to be committed
+ *
+ * @return			1 = new writes or a commit running
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.004
+ */
+Luint8 u8PARAMSHADOW__Is_Busy(void)
+{
+	Luint8 u8Return;
+
+	if((sPARAMSHADOW.eState != PARAMSHADOW_STATE__IDLE) || (sPARAMSHADOW.u8NewWrites == 1U))
+	{
+		u8Return = 1U;
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Read a parameter word from RAM
+ *
+ * @param[in]		u16Index				Parameter index
+ * @return			The word, 0 if out of range
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.005
+ */
+Luint32 u32PARAMSHADOW__Read(Luint16 u16Index)
+{
+	Luint32 u32Return;
+
+	if(u16Index < C_LOCALDEF__LCCM672__NUM_PARAMETERS)
+	{
+		u32Return = sPARAMSHADOW.u32Image[u16Index];
+	}
+	else
+	{
+		u32Return = 0U;
+	}
+
+	return u32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Read a signed parameter from RAM
+ *
+ * @param[in]		u16Index				Parameter index
+ * @return			The value, 0 if out of range
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.006
+ */
+Lint32 s32PARAMSHADOW__Read(Luint16 u16Index)
+{
+	return (Lint32)u32PARAMSHADOW__Read(u16Index);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Read a float parameter from RAM
+ *
+ * @param[in]		u16Index				Parameter index
+ * @return			The float
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.007
+ */
+Lfloat32 f32PARAMSHADOW__Read(Luint16 u16Index)
+{
+	union
+	{
+		Lfloat32 f32;
+		Luint32 u32;
+	}unT;
+
+	unT.u32 = u32PARAMSHADOW__Read(u16Index);
+
+	return unT.f32;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Write a parameter word
+ *
+ * @note
+ * Writing the value that is already there does nothing, so callers can rewrite
+ * a whole set without causing a commit.
+ *
+ * @param[in]		u32Value				New value
+ * @param[in]		u16Index				Parameter index
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.008
+ */
+void vPARAMSHADOW__WriteU32(Luint16 u16Index, Luint32 u32Value)
+{
+	Luint16 u16Block;
+
+	if(u16Index < C_LOCALDEF__LCCM672__NUM_PARAMETERS)
+	{
+		if(sPARAMSHADOW.u32Image[u16Index] != u32Value)
+		{
+			sPARAMSHADOW.u32Image[u16Index] = u32Value;
+
+			//both copies are now out of date on this block
+			u16Block = u16Index / C_LOCALDEF__LCCM672__BLOCK_SIZE;
+			sPARAMSHADOW.u8Stale[u16Block] = 0x03U;
+			sPARAMSHADOW.u8NewWrites = 1U;
+
+			//restart the holdoff
+			sPARAMSHADOW.u32Holdoff = 0U;
+		}
+		else
+		{
+			//no change
+		}
+	}
+	else
+	{
+		//out of range
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Write a signed parameter
+ *
+ * @param[in]		s32Value				New value
+ * @param[in]		u16Index				Parameter index
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.009
+ */
+void vPARAMSHADOW__WriteS32(Luint16 u16Index, Lint32 s32Value)
+{
+	vPARAMSHADOW__WriteU32(u16Index, (Luint32)s32Value);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Write a float parameter
+ *
+ * @param[in]		f32Value				New value
+ * @param[in]		u16Index				Parameter index
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.010
+ */
+void vPARAMSHADOW__WriteF32(Luint16 u16Index, Lfloat32 f32Value)
+{
+	union
+	{
+		Lfloat32 f32;
+		Luint32 u32;
+	}unT;
+
+	unT.f32 = f32Value;
+	vPARAMSHADOW__WriteU32(u16Index, unT.u32);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Check the CRC over a range of parameters
+ *
+ * @note
+ * Same use as the LCCM188 range CRCs, the CRC word holds a CRC16 of the words
+ * from the start to the end index inclusive.
+ *
+ * Straight after a migration the CRC words still hold LCCM188 CRCs. If our
+ * CRC fails then, the range is checked in LCCM188 instead and, if good, the
+ * range is restamped with our CRC so the image is self consistent from the
+ * next commit on. Check a range before writing to it.
+ *
+ * @param[in]		u16CRCIndex				Index of the CRC word
+ * @param[in]		u16EndIndex				Last index in the range
+ * @param[in]		u16StartIndex			First index in the range
+ * @return			1 = CRC good
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.011
+ */
+Luint8 u8PARAMSHADOW__Is_CRC_OK(Luint16 u16StartIndex, Luint16 u16EndIndex, Luint16 u16CRCIndex)
+{
+	Luint8 u8Return;
+
+	if((u16StartIndex <= u16EndIndex) && (u16EndIndex < C_LOCALDEF__LCCM672__NUM_PARAMETERS) && (u16CRCIndex < C_LOCALDEF__LCCM672__NUM_PARAMETERS))
+	{
+		if(sPARAMSHADOW.u32Image[u16CRCIndex] == (Luint32)u16PARAMSHADOW__Range_CRC(u16StartIndex, u16EndIndex))
+		{
+			u8Return = 1U;
+		}
+		else
+		{
+			u8Return = 0U;
+
+			#if C_LOCALDEF__LCCM672__ENABLE_MIGRATION == 1U
+				if(sPARAMSHADOW.u8Source == C_PARAMSHADOW__SOURCE_LEGACY)
+				{
+					u8Return = u8EEPARAM_CRC__Is_CRC_OK(u16StartIndex, u16EndIndex, u16CRCIndex);
+					if(u8Return == 1U)
+					{
+						vPARAMSHADOW__Store_CRC(u16StartIndex, u16EndIndex, u16CRCIndex);
+					}
+					else
+					{
+						//bad in the old store too
+					}
+				}
+				else
+				{
+					//fall on
+				}
+			#endif
+		}
+	}
+	else
+	{
+		//bad range
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Calculate and store the CRC over a range of parameters
+ *
+ * @param[in]		u16CRCIndex				Index of the CRC word
+ * @param[in]		u16EndIndex				Last index in the range
+ * @param[in]		u16StartIndex			First index in the range
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.012
+ */
+void vPARAMSHADOW__Store_CRC(Luint16 u16StartIndex, Luint16 u16EndIndex, Luint16 u16CRCIndex)
+{
+
+	if((u16StartIndex <= u16EndIndex) && (u16EndIndex < C_LOCALDEF__LCCM672__NUM_PARAMETERS))
+	{
+		vPARAMSHADOW__WriteU32(u16CRCIndex, (Luint32)u16PARAMSHADOW__Range_CRC(u16StartIndex, u16EndIndex));
+	}
+	else
+	{
+		//bad range
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Read and check a copy header
+ *
+ * @param[out]		*pu32Generation			Generation in the header
+ * @param[in]		u8Copy					0 = A, 1 = B
+ * @return			1 = header good
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.013
+ */
+static Luint8 u8PARAMSHADOW__Read_Header(Luint8 u8Copy, Luint32 *pu32Generation)
+{
+	Luint8 u8Return;
+	Luint32 u32Header[C_PARAMSHADOW__HEADER_WORDS];
+	Luint16 u16CRC;
+
+	M_LOCALDEF__LCCM672__READ(u8Copy, 0U, &u32Header[0], C_PARAMSHADOW__HEADER_WORDS);
+	u16CRC = u16PARAMSHADOW_CRC__Words(&u32Header[0], 2U);
+
+	if((u32Header[0] == ((C_PARAMSHADOW__MAGIC << 16U) | C_PARAMSHADOW__NUM_BLOCKS)) && (u32Header[2] == (Luint32)u16CRC))
+	{
+		*pu32Generation = u32Header[1];
+		u8Return = 1U;
+	}
+	else
+	{
+		//blank, another layout or damaged
+		*pu32Generation = 0U;
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Check every block in a copy, either loading it or comparing it to RAM
+ *
+ * @note
+ * A block is good if its CRC is right, it is in the right place and it was not
+ * written after the header, ie. it is not part of an unfinished commit.
+ *
+ * Loading needs every block good. Comparing marks each block that is bad, or
+ * does not match the image, as stale for this copy.
+ *
+ * @param[in]		u8Load					1 = load into the image, 0 = compare
+ * @param[in]		u32Generation			Generation from the copy header
+ * @param[in]		u8Copy					0 = A, 1 = B
+ * @return			1 = every block good
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.014
+ */
+static Luint8 u8PARAMSHADOW__Check_Copy(Luint8 u8Copy, Luint32 u32Generation, Luint8 u8Load)
+{
+	Luint8 u8Return;
+	Luint8 u8Same;
+	Luint16 u16Block;
+	Luint16 u16Counter;
+	Luint16 u16CRC;
+	Luint32 *pu32Record;
+	Luint32 *pu32Image;
+
+	pu32Record = &sPARAMSHADOW.u32Record[0];
+	u8Return = 1U;
+	for(u16Block = 0U; u16Block < C_PARAMSHADOW__NUM_BLOCKS; u16Block++)
+	{
+		M_LOCALDEF__LCCM672__READ(u8Copy, C_PARAMSHADOW__HEADER_WORDS + (u16Block * C_PARAMSHADOW__RECORD_WORDS), pu32Record, C_PARAMSHADOW__RECORD_WORDS);
+		u16CRC = u16PARAMSHADOW_CRC__Words(pu32Record, C_LOCALDEF__LCCM672__BLOCK_SIZE + 1U);
+		pu32Image = &sPARAMSHADOW.u32Image[u16Block * C_LOCALDEF__LCCM672__BLOCK_SIZE];
+
+		if((pu32Record[C_PARAMSHADOW__RECORD_WORDS - 1U] == (((Luint32)u16Block << 16U) | (Luint32)u16CRC)) && (pu32Record[0] <= u32Generation))
+		{
+			if(u8Load == 1U)
+			{
+				for(u16Counter = 0U; u16Counter < C_LOCALDEF__LCCM672__BLOCK_SIZE; u16Counter++)
+				{
+					pu32Image[u16Counter] = pu32Record[1U + u16Counter];
+				}
+			}
+			else
+			{
+				u8Same = 1U;
+				for(u16Counter = 0U; u16Counter < C_LOCALDEF__LCCM672__BLOCK_SIZE; u16Counter++)
+				{
+					if(pu32Image[u16Counter] != pu32Record[1U + u16Counter])
+					{
+						u8Same = 0U;
+					}
+					else
+					{
+						//fall on
+					}
+				}
+				if(u8Same == 0U)
+				{
+					sPARAMSHADOW.u8Stale[u16Block] |= (Luint8)(1U << u8Copy);
+				}
+				else
+				{
+					//this copy already holds it
+				}
+			}
+		}
+		else
+		{
+			//carry on so the loop time is fixed, the copy is no good
+			u8Return = 0U;
+			sPARAMSHADOW.u8Stale[u16Block] |= (Luint8)(1U << u8Copy);
+		}
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Write one block record to a copy
+ *
+ * @param[in]		u16Block				Block index
+ * @param[in]		u8Copy					0 = A, 1 = B
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.015
+ */
+static void vPARAMSHADOW__Write_Block(Luint8 u8Copy, Luint16 u16Block)
+{
+	Luint16 u16Counter;
+	Luint16 u16CRC;
+	Luint32 *pu32Record;
+
+	if(u16Block < C_PARAMSHADOW__NUM_BLOCKS)
+	{
+		pu32Record = &sPARAMSHADOW.u32Record[0];
+
+		pu32Record[0] = sPARAMSHADOW.u32Pending;
+		for(u16Counter = 0U; u16Counter < C_LOCALDEF__LCCM672__BLOCK_SIZE; u16Counter++)
+		{
+			pu32Record[1U + u16Counter] = sPARAMSHADOW.u32Image[(u16Block * C_LOCALDEF__LCCM672__BLOCK_SIZE) + u16Counter];
+		}
+		u16CRC = u16PARAMSHADOW_CRC__Words(pu32Record, C_LOCALDEF__LCCM672__BLOCK_SIZE + 1U);
+		pu32Record[C_PARAMSHADOW__RECORD_WORDS - 1U] = ((Luint32)u16Block << 16U) | (Luint32)u16CRC;
+
+		M_LOCALDEF__LCCM672__WRITE(u8Copy, C_PARAMSHADOW__HEADER_WORDS + (u16Block * C_PARAMSHADOW__RECORD_WORDS), pu32Record, C_PARAMSHADOW__RECORD_WORDS);
+	}
+	else
+	{
+		//nothing in this commit
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Write a copy header for the commit that is running
+ *
+ * @param[in]		u8Copy					0 = A, 1 = B
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.016
+ */
+static void vPARAMSHADOW__Write_Header(Luint8 u8Copy)
+{
+	Luint32 u32Header[C_PARAMSHADOW__HEADER_WORDS];
+
+	u32Header[0] = (C_PARAMSHADOW__MAGIC << 16U) | C_PARAMSHADOW__NUM_BLOCKS;
+	u32Header[1] = sPARAMSHADOW.u32Pending;
+	u32Header[2] = (Luint32)u16PARAMSHADOW_CRC__Words(&u32Header[0], 2U);
+
+	M_LOCALDEF__LCCM672__WRITE(u8Copy, 0U, &u32Header[0], C_PARAMSHADOW__HEADER_WORDS);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Find the next block in the running commit
+ *
+ * @param[in]		u16Start				First block to look at
+ * @return			The block, or C_PARAMSHADOW__NUM_BLOCKS if none left
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.017
+ */
+static Luint16 u16PARAMSHADOW__Next_Block(Luint16 u16Start)
+{
+	Luint16 u16Block;
+
+	u16Block = u16Start;
+	while((u16Block < C_PARAMSHADOW__NUM_BLOCKS) && (sPARAMSHADOW.u8Commit[u16Block] == 0U))
+	{
+		u16Block++;
+	}
+
+	return u16Block;
+}
+
+/***************************************************************************//**
+ * @brief
+ * CRC16 over a range of the image
+ *
+ * @param[in]		u16EndIndex				Last index in the range
+ * @param[in]		u16StartIndex			First index in the range
+ * @return			The CRC
+ * @st_funcMD5
+ * @st_funcID		LCCM672R0.FILE.000.FUNC.018
+ */
+static Luint16 u16PARAMSHADOW__Range_CRC(Luint16 u16StartIndex, Luint16 u16EndIndex)
+{
+	return u16PARAMSHADOW_CRC__Words(&sPARAMSHADOW.u32Image[u16StartIndex], (Luint32)u16EndIndex - (Luint32)u16StartIndex + 1U);
+}
+
+
+#endif //#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
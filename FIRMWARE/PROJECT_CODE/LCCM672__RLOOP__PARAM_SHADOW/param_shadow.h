@@ -0,0 +1,174 @@
+/**
+ * @file		PARAM_SHADOW.H
+ * @brief		Main header for the RAM shadowed parameter store
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ */
+
+
+#ifndef _PARAM_SHADOW_H_
+#define _PARAM_SHADOW_H_
+	#include <localdef.h>
+	#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+
+		/*******************************************************************************
+		Defines
+		*******************************************************************************/
+
+		/** Number of blocks the parameters are split into */
+		#define C_PARAMSHADOW__NUM_BLOCKS					((C_LOCALDEF__LCCM672__NUM_PARAMETERS + C_LOCALDEF__LCCM672__BLOCK_SIZE - 1U) / C_LOCALDEF__LCCM672__BLOCK_SIZE)
+
+		/** Copy header: magic and block count, generation, CRC */
+		#define C_PARAMSHADOW__HEADER_WORDS					(3U)
+
+		/** Block record: generation, the parameters, block index and CRC */
+		#define C_PARAMSHADOW__RECORD_WORDS					(C_LOCALDEF__LCCM672__BLOCK_SIZE + 2U)
+
+		/** Size of one whole copy in memory */
+		#define C_PARAMSHADOW__COPY_WORDS					(C_PARAMSHADOW__HEADER_WORDS + (C_PARAMSHADOW__NUM_BLOCKS * C_PARAMSHADOW__RECORD_WORDS))
+
+		/** Marks a copy header */
+		#define C_PARAMSHADOW__MAGIC						(0x5348U)
+
+		/** Where the image in RAM came from at boot */
+		#define C_PARAMSHADOW__SOURCE_COPY_A				(0U)
+		#define C_PARAMSHADOW__SOURCE_COPY_B				(1U)
+		#define C_PARAMSHADOW__SOURCE_LEGACY				(2U)
+		#define C_PARAMSHADOW__SOURCE_BLANK					(3U)
+
+
+		/*******************************************************************************
+		Structures
+		*******************************************************************************/
+
+		/** Commit states */
+		typedef enum
+		{
+			/** Waiting for new writes */
+			PARAMSHADOW_STATE__IDLE = 0U,
+
+			/** Writing blocks to the target copy */
+			PARAMSHADOW_STATE__WRITE,
+
+			/** Blocks done, the header makes them count */
+			PARAMSHADOW_STATE__HEADER
+
+		}E_PARAMSHADOW_STATES;
+
+
+		/** RAM shadow of the parameter store */
+		struct _strPARAMSHADOW
+		{
+			/** The parameters, padded to a whole number of blocks */
+			Luint32 u32Image[C_PARAMSHADOW__NUM_BLOCKS * C_LOCALDEF__LCCM672__BLOCK_SIZE];
+
+			/** Per block, bit 0 = copy A is out of date, bit 1 = copy B is out of date */
+			Luint8 u8Stale[C_PARAMSHADOW__NUM_BLOCKS];
+
+			/** Blocks in the commit that is running */
+			Luint8 u8Commit[C_PARAMSHADOW__NUM_BLOCKS];
+
+			/** Set by a write that changed the image, cleared when a commit is latched */
+			Luint8 u8NewWrites;
+
+			/** Commit as soon as possible, skip the holdoff */
+			Luint8 u8Flush;
+
+			/** Process passes since the last write */
+			Luint32 u32Holdoff;
+
+			/** Commit state */
+			E_PARAMSHADOW_STATES eState;
+
+			/** Copy the running commit goes to, 0 = A, 1 = B */
+			Luint8 u8Target;
+
+			/** Copy holding the newest generation, 0 = A, 1 = B */
+			Luint8 u8Newest;
+
+			/** Next block to write in this commit */
+			Luint16 u16Block;
+
+			/** Generation of the newest finished commit */
+			Luint32 u32Generation;
+
+			/** Generation of the commit that is running */
+			Luint32 u32Pending;
+
+			/** C_PARAMSHADOW__SOURCE_xxx */
+			Luint8 u8Source;
+
+			/** Commits done since boot */
+			Luint32 u32Commits;
+
+			/** Record being read or written */
+			Luint32 u32Record[C_PARAMSHADOW__RECORD_WORDS];
+
+		};
+
+
+		/*******************************************************************************
+		Function Prototypes
+		*******************************************************************************/
+		void vPARAMSHADOW__Init(void);
+		void vPARAMSHADOW__Process(void);
+		void vPARAMSHADOW__Flush(void);
+		Luint8 u8PARAMSHADOW__Is_Busy(void);
+		Luint32 u32PARAMSHADOW__Read(Luint16 u16Index);
+		Lint32 s32PARAMSHADOW__Read(Luint16 u16Index);
+		Lfloat32 f32PARAMSHADOW__Read(Luint16 u16Index);
+		void vPARAMSHADOW__WriteU32(Luint16 u16Index, Luint32 u32Value);
+		void vPARAMSHADOW__WriteS32(Luint16 u16Index, Lint32 s32Value);
+		void vPARAMSHADOW__WriteF32(Luint16 u16Index, Lfloat32 f32Value);
+		Luint8 u8PARAMSHADOW__Is_CRC_OK(Luint16 u16StartIndex, Luint16 u16EndIndex, Luint16 u16CRCIndex);
+		void vPARAMSHADOW__Store_CRC(Luint16 u16StartIndex, Luint16 u16EndIndex, Luint16 u16CRCIndex);
+
+		//crc
+		Luint16 u16PARAMSHADOW_CRC__Words(const Luint32 *pu32Words, Luint32 u32Count);
+
+		//win32
+		#ifdef WIN32
+			void vPARAMSHADOW_WIN32__Read(Luint8 u8Copy, Luint16 u16Offset, Luint32 *pu32Words, Luint16 u16Count);
+			void vPARAMSHADOW_WIN32__Write(Luint8 u8Copy, Luint16 u16Offset, const Luint32 *pu32Words, Luint16 u16Count);
+		#endif
+
+		//testing
+		#if C_LOCALDEF__LCCM672__ENABLE_TEST_SPEC == 1U
+			DLL_DECLARATION void vLCCM672R0_TS_000(void);
+		#endif
+
+		//safetys
+		#ifndef C_LOCALDEF__LCCM672__NUM_PARAMETERS
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM672__BLOCK_SIZE
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM672__BLOCK_SIZE == 0U
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM672__HOLDOFF
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM672__ENABLE_MIGRATION
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM672__ENABLE_MIGRATION == 1U
+			#if C_LOCALDEF__LCCM188__ENABLE_THIS_MODULE != 1U
+				#error "Migrating the parameters needs LCCM188"
+			#endif
+			#if C_LOCALDEF__LCCM188__ENABLE_CRC != 1U
+				#error "Migrating the parameters needs the LCCM188 range CRCs"
+			#endif
+			#if C_LOCALDEF__LCCM672__NUM_PARAMETERS > C_LOCALDEF__LCCM188__NUM_PARAMETERS
+				#error "More shadow parameters than there are in LCCM188"
+			#endif
+		#endif
+
+	#endif //#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+	//safetys
+	#ifndef C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE
+		#error
+	#endif
+#endif //_PARAM_SHADOW_H_
+
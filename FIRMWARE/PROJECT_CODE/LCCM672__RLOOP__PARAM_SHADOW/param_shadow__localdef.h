@@ -0,0 +1,47 @@
+/**
+ * @file		PARAM_SHADOW__LOCALDEF.H
+ * @brief		Localdef template
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM672R0.FILE.002
+ */
+
+#if 0
+
+/*******************************************************************************
+RLOOP - PARAMETER SHADOW
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+
+		/** Number of parameter words kept in RAM */
+		#define C_LOCALDEF__LCCM672__NUM_PARAMETERS							(128U)
+
+		/** Parameters per block, the unit that is marked stale and CRC'd */
+		#define C_LOCALDEF__LCCM672__BLOCK_SIZE								(16U)
+
+		/** Process passes with no new writes before a commit starts, lets a
+		run of writes land in one commit */
+		#define C_LOCALDEF__LCCM672__HOLDOFF								(100U)
+
+		/** If neither copy is good, load the image from LCCM188 */
+		#define C_LOCALDEF__LCCM672__ENABLE_MIGRATION						(1U)
+
+		/** Copy storage, copy A in bank 7 sector 1 and copy B in sector 2, clear
+		of the sector LCCM230 uses for its EEPROM emulation */
+		#ifndef WIN32
+			#define M_LOCALDEF__LCCM672__READ(copy,offset,pu32,count)		vRM4_EEPROM__Read_U8Array((Luint8)(1U + (copy)), (Luint16)((offset) * 4U), (Luint8 *)(pu32), (Luint16)((count) * 4U))
+			#define M_LOCALDEF__LCCM672__WRITE(copy,offset,pu32,count)		vRM4_EEPROM__Write_U8Array((Luint8)(1U + (copy)), (Luint16)((offset) * 4U), (Luint8 *)(pu32), (Luint16)((count) * 4U))
+		#else
+			#define M_LOCALDEF__LCCM672__READ(copy,offset,pu32,count)		vPARAMSHADOW_WIN32__Read((Luint8)(copy), (Luint16)(offset), (pu32), (Luint16)(count))
+			#define M_LOCALDEF__LCCM672__WRITE(copy,offset,pu32,count)		vPARAMSHADOW_WIN32__Write((Luint8)(copy), (Luint16)(offset), (pu32), (Luint16)(count))
+		#endif
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM672__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM672__RLOOP__PARAM_SHADOW/param_shadow.h>
+	#endif //#if C_LOCALDEF__LCCM672__ENABLE_THIS_MODULE == 1U
+
+#endif //#if 0
@@ -0,0 +1,658 @@
+/**
+ * @file		LCCM673R0_TS_000.C
+ * @brief		Test spec for the S-curve planner, a host simulation of the timebase
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM673R0.FILE.002
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM673__ENABLE_TEST_SPEC == 1U
+
+#include <stdio.h>
+#ifdef WIN32
+	//host side only
+	#include <time.h>
+#endif
+
+void vLCCM673R0_TS_000_TCASE_001(void);
+void vLCCM673R0_TS_000_TCASE_002(void);
+void vLCCM673R0_TS_000_TCASE_003(void);
+#ifdef WIN32
+void vLCCM673R0_TS_000_TCASE_004(void);
+#endif
+static Luint32 u32TS000__Run(Luint32 u32MaxTicks);
+static Luint32 u32TS000__Check(const Lint32 *cps32Target);
+static void vTS000__Result(Luint32 u32Fail, const char *pcCase);
+
+/** Limits for the sim, a 25mm/s screw reaching full accel in 20ms */
+#define C_TS000__VELOC							(25000)
+#define C_TS000__ACCEL							(500000)
+#define C_TS000__JERK							(25000000)
+
+/** Timebase ticks per main loop pass */
+#define C_TS000__LOOP_TICKS						(20U)
+
+/** Give up on a move after this */
+#define C_TS000__MAX_TICKS						(200000U)
+
+/** Both axes in within this many ticks of each other */
+#define C_TS000__SYNC_TICKS						(3U)
+
+extern struct _strSCURVE sSCURVE;
+
+//what the sim saw
+static Luint32 u32TS000_MinGap;
+static Luint32 u32TS000_Steps;
+
+//Function to call the tests for this test specification
+void vLCCM673R0_TS_000(void)
+{
+	Luint8 u8Axis;
+
+	vSCURVE__Init();
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		vSCURVE__Set_Limits(u8Axis, C_TS000__VELOC, C_TS000__ACCEL, C_TS000__JERK);
+	}
+
+	//Call the test cases
+	vLCCM673R0_TS_000_TCASE_001();
+	vLCCM673R0_TS_000_TCASE_002();
+	vLCCM673R0_TS_000_TCASE_003();
+#ifdef WIN32
+	vLCCM673R0_TS_000_TCASE_004();
+#endif
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM673R0.TS.000.TCASE.001
+ * @st_test_desc
+ * Two axes of different lengths from rest. Both must land on their targets
+ * within C_TS000__SYNC_TICKS of each other, no two steps closer than the
+ * shortest interval, and a move with no limits must be refused.
+ *
+*/
+void vLCCM673R0_TS_000_TCASE_001(void)
+{
+	Luint32 u32Fail;
+	Luint32 u32Ticks;
+	Lint32 s32Target[C_LOCALDEF__LCCM673__NUM_AXES];
+	Luint8 u8Axis;
+	char cText[200];
+
+	DEBUG_PRINT("START:LCCM673R0.TS.000.TCASE.001\r\n");
+	u32Fail = 0U;
+
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		s32Target[u8Axis] = 20000 - ((Lint32)u8Axis * 7500);
+	}
+
+	if(s16SCURVE__Move(&s32Target[0], 1U) != 0)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	u32Ticks = u32TS000__Run(C_TS000__MAX_TICKS);
+	u32Fail += u32TS000__Check(&s32Target[0]);
+
+	if(u32TS000_MinGap < C_SCURVE__MIN_TICKS)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	sprintf(cText, "INFO:%u steps, time to position %u ticks (%.1f ms), shortest gap %u ticks\r\n",
+				u32TS000_Steps, u32SCURVE__Get_MoveTicks(),
+				(Lfloat64)u32SCURVE__Get_MoveTicks() * (Lfloat64)C_LOCALDEF__LCCM673__TICK_PERIOD_S * 1000.0,
+				u32TS000_MinGap);
+	DEBUG_PRINT(cText);
+	if(u32Ticks >= C_TS000__MAX_TICKS)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//no limits, no move
+	vSCURVE__Set_Limits(0U, 0, C_TS000__ACCEL, C_TS000__JERK);
+	if((s16SCURVE__Move(&s32Target[0], 2U) != -1) || (u8SCURVE__Get_Busy() != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	vSCURVE__Set_Limits(0U, C_TS000__VELOC, C_TS000__ACCEL, C_TS000__JERK);
+
+	vTS000__Result(u32Fail, "LCCM673R0.TS.000.TCASE.001");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM673R0.TS.000.TCASE.002
+ * @st_test_desc
+ * Replanning. A move is cut short part way and must end on the new target
+ * in sync, then a move is turned round part way, which has to stop first and
+ * come back.
+ *
+*/
+void vLCCM673R0_TS_000_TCASE_002(void)
+{
+	Luint32 u32Fail;
+	Luint32 u32Replans;
+	Lint32 s32Target[C_LOCALDEF__LCCM673__NUM_AXES];
+	Luint8 u8Axis;
+	char cText[200];
+
+	DEBUG_PRINT("START:LCCM673R0.TS.000.TCASE.002\r\n");
+	u32Fail = 0U;
+	u32Replans = sSCURVE.u32Replans;
+
+	//out to 45mm, cut back to 35/30mm on the way
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		s32Target[u8Axis] = 45000;
+	}
+	(void)s16SCURVE__Move(&s32Target[0], 3U);
+	(void)u32TS000__Run(20000U);
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		s32Target[u8Axis] = 35000 - ((Lint32)u8Axis * 5000);
+	}
+	(void)s16SCURVE__Move(&s32Target[0], 4U);
+	(void)u32TS000__Run(C_TS000__MAX_TICKS);
+	u32Fail += u32TS000__Check(&s32Target[0]);
+	if(sSCURVE.u32Replans == u32Replans)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	sprintf(cText, "INFO:cut short, time to position %.1f ms\r\n",
+				(Lfloat64)u32SCURVE__Get_MoveTicks() * (Lfloat64)C_LOCALDEF__LCCM673__TICK_PERIOD_S * 1000.0);
+	DEBUG_PRINT(cText);
+
+	//head out, then come back behind the start
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		s32Target[u8Axis] = 60000;
+	}
+	(void)s16SCURVE__Move(&s32Target[0], 5U);
+	(void)u32TS000__Run(15000U);
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		s32Target[u8Axis] = 10000 + ((Lint32)u8Axis * 2000);
+	}
+	(void)s16SCURVE__Move(&s32Target[0], 6U);
+	(void)u32TS000__Run(C_TS000__MAX_TICKS);
+	u32Fail += u32TS000__Check(&s32Target[0]);
+	if(u32TS000_MinGap < C_SCURVE__MIN_TICKS)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	sprintf(cText, "INFO:reversed, time to position %.1f ms, replans %u, sync misses %u\r\n",
+				(Lfloat64)u32SCURVE__Get_MoveTicks() * (Lfloat64)C_LOCALDEF__LCCM673__TICK_PERIOD_S * 1000.0,
+				sSCURVE.u32Replans, sSCURVE.u32SyncMisses);
+	DEBUG_PRINT(cText);
+
+	vTS000__Result(u32Fail, "LCCM673R0.TS.000.TCASE.002");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM673R0.TS.000.TCASE.003
+ * @st_test_desc
+ * A limit hit mid profile. The abort must drop the pulses and take no more
+ * steps however long the timebase runs, the main loop then clears the move.
+ * An abort while a replan is armed must not take the swap, and a new move
+ * from where the axes stopped must reach its target in sync.
+ *
+*/
+void vLCCM673R0_TS_000_TCASE_003(void)
+{
+	Luint32 u32Fail;
+	Luint32 u32Aborts;
+	Luint32 u32Tick;
+	Luint8 u8Running;
+	Luint8 u8Active[C_LOCALDEF__LCCM673__NUM_AXES];
+	Lint32 s32Target[C_LOCALDEF__LCCM673__NUM_AXES];
+	Lint32 s32Pos[C_LOCALDEF__LCCM673__NUM_AXES];
+	Luint8 u8Axis;
+
+	DEBUG_PRINT("START:LCCM673R0.TS.000.TCASE.003\r\n");
+	u32Fail = 0U;
+	u32Aborts = u32SCURVE__Get_Aborts();
+
+	//out to 40mm, hit the limit in the cruise
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		s32Target[u8Axis] = 40000;
+	}
+	(void)s16SCURVE__Move(&s32Target[0], 8U);
+	(void)u32TS000__Run(10000U);
+
+	u8Running = 0U;
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		u8Running |= sSCURVE.sAxis[u8Axis].u8Running;
+	}
+	if(u8Running == 0U)
+	{
+		//the sim never got going, the rest proves nothing
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vSCURVE__Abort(0U);
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		if((sSCURVE.sAxis[u8Axis].u8PulseHigh != 0U) || (sSCURVE.sAxis[u8Axis].u8Running != 0U))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+		s32Pos[u8Axis] = sSCURVE.sAxis[u8Axis].s32Position;
+	}
+
+	//the main loop is held off, the timebase runs on
+	for(u32Tick = 0U; u32Tick < 5000U; u32Tick++)
+	{
+		vSCURVE__ISR();
+	}
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		if((sSCURVE.sAxis[u8Axis].s32Position != s32Pos[u8Axis]) || (sSCURVE.sAxis[u8Axis].u8PulseHigh != 0U))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	vSCURVE__Process();
+	if((u8SCURVE__Get_Busy() != 0U) || (sSCURVE.u8Abort != 0U) || (u32SCURVE__Get_Aborts() != (u32Aborts + 1U)))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//out again, cut it short and hit the limit before the swap
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		s32Target[u8Axis] = 60000;
+	}
+	(void)s16SCURVE__Move(&s32Target[0], 9U);
+	(void)u32TS000__Run(8000U);
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		s32Target[u8Axis] = s32SCURVE__Get_Position(u8Axis) + 8000;
+	}
+	(void)s16SCURVE__Move(&s32Target[0], 10U);
+	if(sSCURVE.u8SwapArmed != 1U)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vSCURVE__Abort(1U);
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		u8Active[u8Axis] = sSCURVE.sAxis[u8Axis].u8Active;
+		s32Pos[u8Axis] = sSCURVE.sAxis[u8Axis].s32Position;
+	}
+	for(u32Tick = 0U; u32Tick < 5000U; u32Tick++)
+	{
+		vSCURVE__ISR();
+	}
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		if((sSCURVE.sAxis[u8Axis].u8Active != u8Active[u8Axis]) || (sSCURVE.sAxis[u8Axis].s32Position != s32Pos[u8Axis]))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	if((sSCURVE.u8AbortAxis != 1U) || (u32SCURVE__Get_Aborts() != (u32Aborts + 2U)))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//straight into a new move, the move clears the latch itself
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		s32Target[u8Axis] = 5000 + ((Lint32)u8Axis * 3000);
+	}
+	if(s16SCURVE__Move(&s32Target[0], 11U) != 0)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	(void)u32TS000__Run(C_TS000__MAX_TICKS);
+	u32Fail += u32TS000__Check(&s32Target[0]);
+	if(sSCURVE.u8Abort != 0U)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM673R0.TS.000.TCASE.003");
+}
+
+#ifdef WIN32
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM673R0.TS.000.TCASE.004
+ * @st_test_desc
+ * Host cost. Prints the planning time of a move and the ISR time per tick
+ * and per step. Information only, fails only if the move does not finish.
+ *
+*/
+void vLCCM673R0_TS_000_TCASE_004(void)
+{
+	Luint32 u32Fail;
+	Luint32 u32Ticks;
+	Luint32 u32Loops;
+	Luint32 u32Pass;
+	Luint32 u32Tick;
+	Lint32 s32Target[C_LOCALDEF__LCCM673__NUM_AXES];
+	Lint32 s32Start[C_LOCALDEF__LCCM673__NUM_AXES];
+	Luint8 u8Axis;
+	clock_t tStart;
+	Lfloat64 f64Plan;
+	Lfloat64 f64ISR;
+	char cText[200];
+
+	DEBUG_PRINT("START:LCCM673R0.TS.000.TCASE.004\r\n");
+	u32Fail = 0U;
+	u32Loops = 200U;
+	f64Plan = 0.0;
+	f64ISR = 0.0;
+	u32Ticks = 0U;
+	u32TS000_Steps = 0U;
+
+	for(u32Pass = 0U; u32Pass < u32Loops; u32Pass++)
+	{
+		//back and forth over 25mm
+		for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+		{
+			s32Target[u8Axis] = (Lint32)(u32Pass & 0x01U) * 25000;
+			s32Start[u8Axis] = sSCURVE.sAxis[u8Axis].s32Position;
+		}
+
+		tStart = clock();
+		(void)s16SCURVE__Move(&s32Target[0], 7U);
+		f64Plan += (Lfloat64)(clock() - tStart) / (Lfloat64)CLOCKS_PER_SEC;
+
+		//ISR only, the sim bookkeeping stays out of the timing
+		tStart = clock();
+		while((u8SCURVE__Get_Busy() == 1U) && (u32Ticks < (u32Loops * C_TS000__MAX_TICKS)))
+		{
+			for(u32Tick = 0U; u32Tick < C_TS000__LOOP_TICKS; u32Tick++)
+			{
+				vSCURVE__ISR();
+			}
+			u32Ticks += C_TS000__LOOP_TICKS;
+			vSCURVE__Process();
+		}
+		f64ISR += (Lfloat64)(clock() - tStart) / (Lfloat64)CLOCKS_PER_SEC;
+
+		for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+		{
+			if(sSCURVE.sAxis[u8Axis].s32Position > s32Start[u8Axis])
+			{
+				u32TS000_Steps += (Luint32)(sSCURVE.sAxis[u8Axis].s32Position - s32Start[u8Axis]);
+			}
+			else
+			{
+				u32TS000_Steps += (Luint32)(s32Start[u8Axis] - sSCURVE.sAxis[u8Axis].s32Position);
+			}
+		}
+	}
+
+	if(u32Ticks >= (u32Loops * C_TS000__MAX_TICKS))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	sprintf(cText, "INFO:plan %.1f us per move\r\n", (f64Plan * 1.0E6) / (Lfloat64)u32Loops);
+	DEBUG_PRINT(cText);
+	sprintf(cText, "INFO:ISR %.1f ns per tick, %.1f ns per step over %u axes\r\n",
+				(f64ISR * 1.0E9) / (Lfloat64)u32Ticks,
+				(f64ISR * 1.0E9) / ((Lfloat64)u32TS000_Steps + 1.0),
+				C_LOCALDEF__LCCM673__NUM_AXES);
+	DEBUG_PRINT(cText);
+
+	vTS000__Result(u32Fail, "LCCM673R0.TS.000.TCASE.004");
+}
+#endif //WIN32
+
+/***************************************************************************//**
+ * @brief
+ * Run the timebase and main loop until the move is done
+ *
+ * @param[in]		u32MaxTicks				Stop after this many ticks
+ * @return			Ticks run
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.002.FUNC.001
+ */
+static Luint32 u32TS000__Run(Luint32 u32MaxTicks)
+{
+	Luint32 u32Ticks;
+	Luint32 u32Last[C_LOCALDEF__LCCM673__NUM_AXES];
+	Lint32 s32Pos[C_LOCALDEF__LCCM673__NUM_AXES];
+	Luint8 u8Axis;
+
+	u32TS000_MinGap = 0xFFFFFFFFU;
+	u32TS000_Steps = 0U;
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		u32Last[u8Axis] = 0U;
+		s32Pos[u8Axis] = sSCURVE.sAxis[u8Axis].s32Position;
+	}
+
+	u32Ticks = 0U;
+	while((u8SCURVE__Get_Busy() == 1U) && (u32Ticks < u32MaxTicks))
+	{
+		vSCURVE__ISR();
+		u32Ticks++;
+
+		for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+		{
+			if(sSCURVE.sAxis[u8Axis].s32Position != s32Pos[u8Axis])
+			{
+				//gap since the last step, the first one has nothing to measure to
+				if((u32Last[u8Axis] != 0U) && ((u32Ticks - u32Last[u8Axis]) < u32TS000_MinGap))
+				{
+					u32TS000_MinGap = u32Ticks - u32Last[u8Axis];
+				}
+				else
+				{
+					//fall on
+				}
+				u32Last[u8Axis] = u32Ticks;
+				s32Pos[u8Axis] = sSCURVE.sAxis[u8Axis].s32Position;
+				u32TS000_Steps++;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+
+		if((u32Ticks % C_TS000__LOOP_TICKS) == 0U)
+		{
+			vSCURVE__Process();
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	return u32Ticks;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Check each axis is on its target and they arrived together
+ *
+ * @param[in]		*cps32Target			Targets in microns
+ * @return			Number of failed checks
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.002.FUNC.002
+ */
+static Luint32 u32TS000__Check(const Lint32 *cps32Target)
+{
+	Luint32 u32Fail;
+	Luint32 u32First;
+	Luint32 u32Last;
+	Lint32 s32Error;
+	Lint32 s32Step;
+	Luint8 u8Axis;
+
+	u32Fail = 0U;
+	u32First = 0xFFFFFFFFU;
+	u32Last = 0U;
+
+	if(u8SCURVE__Get_Busy() != 0U)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		//within a step
+		s32Step = (Lint32)(1.0F / sSCURVE.sAxis[u8Axis].fStepsPerMicron) + 1;
+		s32Error = s32SCURVE__Get_Position(u8Axis) - cps32Target[u8Axis];
+		if((s32Error > s32Step) || (s32Error < -s32Step))
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+
+		if(sSCURVE.sAxis[u8Axis].u32ArriveTick < u32First)
+		{
+			u32First = sSCURVE.sAxis[u8Axis].u32ArriveTick;
+		}
+		else
+		{
+			//fall on
+		}
+		if(sSCURVE.sAxis[u8Axis].u32ArriveTick > u32Last)
+		{
+			u32Last = sSCURVE.sAxis[u8Axis].u32ArriveTick;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	if((u32Last - u32First) > C_TS000__SYNC_TICKS)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	return u32Fail;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Print the result of a test case
+ *
+ * @param[in]		*pcCase					Test case ID
+ * @param[in]		u32Fail					Number of failed checks
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.002.FUNC.003
+ */
+static void vTS000__Result(Luint32 u32Fail, const char *pcCase)
+{
+	char cText[200];
+
+	if(u32Fail == 0U)
+	{
+		sprintf(cText, "PASS:%s\r\n", pcCase);
+	}
+	else
+	{
+		sprintf(cText, "FAIL:%s (%u)\r\n", pcCase, u32Fail);
+	}
+	DEBUG_PRINT(cText);
+
+	sprintf(cText, "END:%s\r\n", pcCase);
+	DEBUG_PRINT(cText);
+
+}
+
+#endif //#if C_LOCALDEF__LCCM673__ENABLE_TEST_SPEC == 1U
+#endif //#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE
+	#error
+#endif
@@ -0,0 +1,1601 @@
+/**
+ * @file		STEP_SCURVE.C
+ * @brief		Jerk limited move planner with precomputed step tables
+ *
+ * @note
+ * A move is planned up front in the main loop as a double S profile per axis
+ * (jerk, accel and veloc limited) and turned into a table of timebase ticks
+ * between steps. The ramps are stored, the cruise is a 16.16 interval so a long
+ * move does not need a long table. vSCURVE__ISR() then only counts down and
+ * indexes the table, there is no math per pulse.
+ *
+ * All axes in a move are planned to arrive on the same tick, the faster axes
+ * have their cruise veloc brought down until their time matches the slowest.
+ *
+ * A new target during a move is planned from a step C_LOCALDEF__LCCM673__REPLAN_LEAD
+ * ahead of where the ISR is, from the veloc the old plan has there, into the
+ * spare buffer. The ISR takes the new plan over when it reaches that step. The
+ * old plan is at some accel at that point and the new one starts at 0 so there
+ * is one accel step at the join, bounded by the accel limit. If an axis can not
+ * get to the new target without reversing or overshooting, all axes are first
+ * brought to rest and the target is planned again from there.
+ *
+ * A limit switch calls vSCURVE__Abort() from its ISR. That stops every axis on
+ * the spot and latches, the timebase ISR then only drops pulses, so a plan that
+ * the abort interrupted can't start the screws again. The next call to
+ * vSCURVE__Process() or s16SCURVE__Move() clears the move away from the main
+ * loop and releases the latch.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM673R0.FILE.000
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup SCURVE
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup SCURVE__CORE
+ * @ingroup SCURVE
+ * @{ */
+
+#include "step_scurve.h"
+#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+
+#include <math.h>
+
+//the planner
+struct _strSCURVE sSCURVE;
+
+//locals
+static void vSCURVE__Clear_Abort(void);
+static Lint16 s16SCURVE__Solve(SCURVE__PROFILE_T *pProfile, Lfloat32 fH, Lfloat32 fV0, Lfloat32 fVmax, Lfloat32 fAmax, Lfloat32 fJmax);
+static Lint16 s16SCURVE__Fit(Luint8 u8Axis, SCURVE__PROFILE_T *pProfile, Lfloat32 fH, Lfloat32 fV0, Lfloat32 fVmax);
+static Lfloat32 fSCURVE__Position(const SCURVE__PROFILE_T *pProfile, Lfloat32 fTime);
+static Lfloat32 fSCURVE__Velocity(const SCURVE__PROFILE_T *pProfile, Lfloat32 fTime);
+static Lfloat32 fSCURVE__Time_At(const SCURVE__PROFILE_T *pProfile, Lfloat32 fPos, Lfloat32 fGuess);
+static Lfloat32 fSCURVE__Stop_Distance(Luint8 u8Axis, Lfloat32 fV0);
+static void vSCURVE__Build_Table(Luint8 u8Axis, Luint8 u8Buffer, const SCURVE__PROFILE_T *pProfile, Luint32 u32Steps, Lfloat32 fOffset);
+static void vSCURVE__Plan(void);
+static Luint32 u32SCURVE__Next_Interval(Luint8 u8Axis);
+static void vSCURVE__Pulse(Luint8 u8Axis, Luint8 u8Level);
+static void vSCURVE__Direction(Luint8 u8Axis, Lint32 s32Direction);
+
+
+/***************************************************************************//**
+ * @brief
+ * Init the planner, after the stepper params are loaded so the scale hooks
+ * have something to return
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.001
+ */
+void vSCURVE__Init(void)
+{
+	Luint8 u8Axis;
+	Luint8 u8Buffer;
+
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		for(u8Buffer = 0U; u8Buffer < 2U; u8Buffer++)
+		{
+			sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseStart = 0U;
+			sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseSteps = 0U;
+			sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseTicks_Q16 = 0U;
+			sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseAcc0_Q16 = 0U;
+			sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32TotalSteps = 0U;
+			sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].s32Direction = 1;
+			sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].s32StartPos = 0;
+			sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].fOffset = 0.0F;
+		}
+
+		sSCURVE.sAxis[u8Axis].u8Active = 0U;
+		sSCURVE.sAxis[u8Axis].u32Step = 0U;
+		sSCURVE.sAxis[u8Axis].u32Countdown = 0U;
+		sSCURVE.sAxis[u8Axis].u32CruiseAcc_Q16 = 0U;
+		sSCURVE.sAxis[u8Axis].u8PulseHigh = 0U;
+		sSCURVE.sAxis[u8Axis].s32Position = 0;
+		sSCURVE.sAxis[u8Axis].u8Running = 0U;
+		sSCURVE.sAxis[u8Axis].u8SwapPending = 0U;
+		sSCURVE.sAxis[u8Axis].u32SwapStep = 0U;
+		sSCURVE.sAxis[u8Axis].u32ArriveTick = 0U;
+		sSCURVE.sAxis[u8Axis].s32Target = 0;
+
+		//no limits until the upper layer gives us some, also gets the scale
+		vSCURVE__Set_Limits(u8Axis, 0, 0, 0);
+	}
+
+	sSCURVE.u32Ticks = 0U;
+	sSCURVE.u8SwapArmed = 0U;
+	sSCURVE.u8TargetPending = 0U;
+	sSCURVE.u8StopFirst = 0U;
+	sSCURVE.u8Busy = 0U;
+	sSCURVE.u8Abort = 0U;
+	sSCURVE.u8AbortAxis = 0U;
+	sSCURVE.u32MoveStartTick = 0U;
+	sSCURVE.u32MoveTicks = 0U;
+	sSCURVE.u32TaskID = 0U;
+	sSCURVE.u32Replans = 0U;
+	sSCURVE.u32SyncMisses = 0U;
+	sSCURVE.u32TableLimits = 0U;
+	sSCURVE.u32Aborts = 0U;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Set the limits of an axis
+ *
+ * @note
+ * The steps per rev and the lead screw pitch in microns per rev (the param
+ * index and the ground tool are in microns) come from the localdef hooks, so
+ * call this again if the pitch, steps per rev or microstep resolution change. The veloc is capped to
+ * one step per C_SCURVE__MIN_TICKS timebase ticks.
+ *
+ * @param[in]		s32Jerk_microns_sss		Jerk limit
+ * @param[in]		s32Accel_microns_ss		Accel limit
+ * @param[in]		s32Veloc_microns_s		Veloc limit
+ * @param[in]		u8Axis					The axis
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.002
+ */
+void vSCURVE__Set_Limits(Luint8 u8Axis, Lint32 s32Veloc_microns_s, Lint32 s32Accel_microns_ss, Lint32 s32Jerk_microns_sss)
+{
+	Luint32 u32Steps;
+	Lint32 s32Pitch;
+	Lfloat32 fScale;
+	Lfloat32 fVcap;
+
+	if(u8Axis < C_LOCALDEF__LCCM673__NUM_AXES)
+	{
+		u32Steps = M_LOCALDEF__LCCM673__STEPS_PER_REV(u8Axis);
+		s32Pitch = M_LOCALDEF__LCCM673__MICRONS_PER_REV(u8Axis);
+		if(s32Pitch > 0)
+		{
+			fScale = (Lfloat32)u32Steps / (Lfloat32)s32Pitch;
+		}
+		else
+		{
+			//no pitch, nothing can move
+			fScale = 0.0F;
+		}
+		sSCURVE.sAxis[u8Axis].fStepsPerMicron = fScale;
+
+		sSCURVE.sAxis[u8Axis].fMaxVeloc = 0.0F;
+		sSCURVE.sAxis[u8Axis].fMaxAccel = 0.0F;
+		sSCURVE.sAxis[u8Axis].fMaxJerk = 0.0F;
+		if((s32Veloc_microns_s > 0) && (s32Accel_microns_ss > 0) && (s32Jerk_microns_sss > 0))
+		{
+			sSCURVE.sAxis[u8Axis].fMaxVeloc = (Lfloat32)s32Veloc_microns_s * fScale;
+			sSCURVE.sAxis[u8Axis].fMaxAccel = (Lfloat32)s32Accel_microns_ss * fScale;
+			sSCURVE.sAxis[u8Axis].fMaxJerk = (Lfloat32)s32Jerk_microns_sss * fScale;
+		}
+		else
+		{
+			//leave it stopped
+		}
+
+		//one tick high and one low is as fast as the ISR can step
+		fVcap = 1.0F / ((Lfloat32)C_SCURVE__MIN_TICKS * (Lfloat32)C_LOCALDEF__LCCM673__TICK_PERIOD_S);
+		if(sSCURVE.sAxis[u8Axis].fMaxVeloc > fVcap)
+		{
+			sSCURVE.sAxis[u8Axis].fMaxVeloc = fVcap;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	else
+	{
+		//error
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Move all axes to a new target as one move
+ *
+ * @note
+ * Can be called while a move is running, the running move is replanned from
+ * where it will be a few steps on. The time to position is kept from the
+ * first request of the move. After an abort the move is planned from where
+ * the axes stopped.
+ *
+ * @param[in]		u32TaskID				Task ID for the move
+ * @param[in]		*cps32Target_microns	Target of each axis
+ * @return			0 = planning\n
+ *					-1 = an axis has no limits set
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.003
+ */
+Lint16 s16SCURVE__Move(const Lint32 * cps32Target_microns, Luint32 u32TaskID)
+{
+	Lint16 s16Return;
+	Luint8 u8Axis;
+	Lfloat32 fTarget;
+
+	s16Return = 0;
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		if((sSCURVE.sAxis[u8Axis].fMaxVeloc <= 0.0F) || (sSCURVE.sAxis[u8Axis].fMaxAccel <= 0.0F) || (sSCURVE.sAxis[u8Axis].fMaxJerk <= 0.0F))
+		{
+			s16Return = -1;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	if(s16Return == 0)
+	{
+		if(sSCURVE.u8Abort == 1U)
+		{
+			//a limit stopped us, start again from rest
+			vSCURVE__Clear_Abort();
+		}
+		else
+		{
+			//fall on
+		}
+
+		for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+		{
+			fTarget = (Lfloat32)cps32Target_microns[u8Axis] * sSCURVE.sAxis[u8Axis].fStepsPerMicron;
+			if(fTarget >= 0.0F)
+			{
+				sSCURVE.sAxis[u8Axis].s32Target = (Lint32)(fTarget + 0.5F);
+			}
+			else
+			{
+				sSCURVE.sAxis[u8Axis].s32Target = (Lint32)(fTarget - 0.5F);
+			}
+		}
+
+		if(sSCURVE.u8Busy == 0U)
+		{
+			sSCURVE.u32MoveStartTick = sSCURVE.u32Ticks;
+			sSCURVE.u32MoveTicks = 0U;
+		}
+		else
+		{
+			//a replan, keep the start
+		}
+
+		sSCURVE.u32TaskID = u32TaskID;
+		sSCURVE.u8StopFirst = 0U;
+		sSCURVE.u8TargetPending = 1U;
+		sSCURVE.u8Busy = 1U;
+
+		//plan now if we can, else the process loop will
+		vSCURVE__Plan();
+	}
+	else
+	{
+		//can't move
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Process the planner, call from the main loop
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.004
+ */
+void vSCURVE__Process(void)
+{
+	Luint8 u8Axis;
+	Luint8 u8Running;
+	Luint32 u32Ticks;
+
+	if(sSCURVE.u8Abort == 1U)
+	{
+		//a limit stopped us, clear the move away
+		vSCURVE__Clear_Abort();
+	}
+	else
+	{
+		if(sSCURVE.u8Busy == 1U)
+		{
+			if(sSCURVE.u8TargetPending == 1U)
+			{
+				vSCURVE__Plan();
+			}
+			else
+			{
+				u8Running = sSCURVE.u8SwapArmed;
+				for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+				{
+					u8Running |= sSCURVE.sAxis[u8Axis].u8Running;
+				}
+
+				if(u8Running == 0U)
+				{
+					if(sSCURVE.u8StopFirst == 1U)
+					{
+						//at rest now, go for the real target
+						sSCURVE.u8StopFirst = 0U;
+						sSCURVE.u8TargetPending = 1U;
+						vSCURVE__Plan();
+					}
+					else
+					{
+						//done, time to the last axis in
+						for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+						{
+							u32Ticks = sSCURVE.sAxis[u8Axis].u32ArriveTick - sSCURVE.u32MoveStartTick;
+							if((u32Ticks < 0x80000000U) && (u32Ticks > sSCURVE.u32MoveTicks))
+							{
+								sSCURVE.u32MoveTicks = u32Ticks;
+							}
+							else
+							{
+								//axis did not move this time
+							}
+						}
+						sSCURVE.u8Busy = 0U;
+					}
+				}
+				else
+				{
+					//still moving
+				}
+			}
+		}
+		else
+		{
+			//nothing to do
+		}
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Timebase ISR, every C_LOCALDEF__LCCM673__TICK_PERIOD_S
+ *
+ * @note
+ * Per axis this is a countdown and one table read per step. While an abort is
+ * latched only the pulses are dropped.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.005
+ */
+void vSCURVE__ISR(void)
+{
+	Luint8 u8Axis;
+	Luint8 u8Load;
+	Luint8 u8Pending;
+
+	sSCURVE.u32Ticks++;
+	u8Pending = 0U;
+
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		u8Load = 0U;
+
+		//end of the step pulse
+		if(sSCURVE.sAxis[u8Axis].u8PulseHigh == 1U)
+		{
+			vSCURVE__Pulse(u8Axis, 0U);
+			sSCURVE.sAxis[u8Axis].u8PulseHigh = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+
+		if(sSCURVE.u8Abort == 0U)
+		{
+			if(sSCURVE.sAxis[u8Axis].u8Running == 1U)
+			{
+				sSCURVE.sAxis[u8Axis].u32Countdown--;
+				if(sSCURVE.sAxis[u8Axis].u32Countdown == 0U)
+				{
+					vSCURVE__Pulse(u8Axis, 1U);
+					sSCURVE.sAxis[u8Axis].u8PulseHigh = 1U;
+					sSCURVE.sAxis[u8Axis].s32Position += sSCURVE.sAxis[u8Axis].sPlan[sSCURVE.sAxis[u8Axis].u8Active].s32Direction;
+					sSCURVE.sAxis[u8Axis].u32Step++;
+					u8Load = 1U;
+				}
+				else
+				{
+					//wait
+				}
+			}
+			else
+			{
+				//idle
+			}
+
+			//take over a new plan, if we got here late just start further in
+			if((sSCURVE.u8SwapArmed == 1U) && (sSCURVE.sAxis[u8Axis].u8SwapPending == 1U))
+			{
+				if(sSCURVE.sAxis[u8Axis].u32Step >= sSCURVE.sAxis[u8Axis].u32SwapStep)
+				{
+					sSCURVE.sAxis[u8Axis].u32Step -= sSCURVE.sAxis[u8Axis].u32SwapStep;
+					sSCURVE.sAxis[u8Axis].u8Active ^= 1U;
+					sSCURVE.sAxis[u8Axis].u32CruiseAcc_Q16 = sSCURVE.sAxis[u8Axis].sPlan[sSCURVE.sAxis[u8Axis].u8Active].u32CruiseAcc0_Q16;
+					vSCURVE__Direction(u8Axis, sSCURVE.sAxis[u8Axis].sPlan[sSCURVE.sAxis[u8Axis].u8Active].s32Direction);
+					sSCURVE.sAxis[u8Axis].u8SwapPending = 0U;
+					u8Load = 1U;
+				}
+				else
+				{
+					u8Pending = 1U;
+				}
+			}
+			else
+			{
+				//fall on
+			}
+
+			if(u8Load == 1U)
+			{
+				if(sSCURVE.sAxis[u8Axis].u32Step < sSCURVE.sAxis[u8Axis].sPlan[sSCURVE.sAxis[u8Axis].u8Active].u32TotalSteps)
+				{
+					sSCURVE.sAxis[u8Axis].u32Countdown = u32SCURVE__Next_Interval(u8Axis);
+					sSCURVE.sAxis[u8Axis].u8Running = 1U;
+				}
+				else
+				{
+					if(sSCURVE.sAxis[u8Axis].u8Running == 1U)
+					{
+						sSCURVE.sAxis[u8Axis].u32ArriveTick = sSCURVE.u32Ticks;
+					}
+					else
+					{
+						//swapped onto an empty plan
+					}
+					sSCURVE.sAxis[u8Axis].u8Running = 0U;
+				}
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		else
+		{
+			//stopped by a limit, hold until the main loop clears it
+		}
+	}
+
+	if(u8Pending == 0U)
+	{
+		sSCURVE.u8SwapArmed = 0U;
+	}
+	else
+	{
+		//still waiting on an axis
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Stop every axis now, from a limit switch
+ *
+ * @note
+ * Call from the limit ISR. It must run at the timebase priority or above, the
+ * RM4 IRQs don't nest so the timebase can't get in half way. No step is taken
+ * after this returns and any swap that was armed is dropped. The latch holds
+ * the ISR off until vSCURVE__Process() or s16SCURVE__Move() clears it, so a
+ * plan the abort broke into can't start the screws again.
+ *
+ * @param[in]		u8Axis					The axis that hit the limit
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.006
+ */
+void vSCURVE__Abort(Luint8 u8Axis)
+{
+	Luint8 u8Counter;
+
+	//latch first so nothing else gets loaded
+	sSCURVE.u8Abort = 1U;
+	sSCURVE.u8SwapArmed = 0U;
+
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM673__NUM_AXES; u8Counter++)
+	{
+		sSCURVE.sAxis[u8Counter].u8Running = 0U;
+		sSCURVE.sAxis[u8Counter].u8SwapPending = 0U;
+
+		if(sSCURVE.sAxis[u8Counter].u8PulseHigh == 1U)
+		{
+			vSCURVE__Pulse(u8Counter, 0U);
+			sSCURVE.sAxis[u8Counter].u8PulseHigh = 0U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	if(u8Axis < C_LOCALDEF__LCCM673__NUM_AXES)
+	{
+		sSCURVE.u8AbortAxis = u8Axis;
+	}
+	else
+	{
+		//error
+	}
+
+	sSCURVE.u32Aborts++;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Position of an axis
+ *
+ * @param[in]		u8Axis					The axis
+ * @return			Position in microns
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.007
+ */
+Lint32 s32SCURVE__Get_Position(Luint8 u8Axis)
+{
+	Lint32 s32Return;
+	Lfloat32 fPos;
+
+	s32Return = 0;
+	if(u8Axis < C_LOCALDEF__LCCM673__NUM_AXES)
+	{
+		if(sSCURVE.sAxis[u8Axis].fStepsPerMicron > 0.0F)
+		{
+			fPos = (Lfloat32)sSCURVE.sAxis[u8Axis].s32Position / sSCURVE.sAxis[u8Axis].fStepsPerMicron;
+			if(fPos >= 0.0F)
+			{
+				s32Return = (Lint32)(fPos + 0.5F);
+			}
+			else
+			{
+				s32Return = (Lint32)(fPos - 0.5F);
+			}
+		}
+		else
+		{
+			//no scale
+		}
+	}
+	else
+	{
+		//error
+	}
+
+	return s32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Is a move in progress
+ *
+ * @return			1 = moving or planning
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.008
+ */
+Luint8 u8SCURVE__Get_Busy(void)
+{
+	return sSCURVE.u8Busy;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Time to position of the last move
+ *
+ * @return			Timebase ticks from the move request to the last axis arriving
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.009
+ */
+Luint32 u32SCURVE__Get_MoveTicks(void)
+{
+	return sSCURVE.u32MoveTicks;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Number of aborts since init
+ *
+ * @return			Abort count
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.010
+ */
+Luint32 u32SCURVE__Get_Aborts(void)
+{
+	return sSCURVE.u32Aborts;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Clear a move away after an abort, main loop only
+ *
+ * @note
+ * Each axis is left at rest where it stopped with its target on its position.
+ * The latch is released last, once there is nothing left for the ISR to run.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.011
+ */
+static void vSCURVE__Clear_Abort(void)
+{
+	Luint8 u8Axis;
+
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		sSCURVE.sAxis[u8Axis].u8Running = 0U;
+		sSCURVE.sAxis[u8Axis].u8SwapPending = 0U;
+		sSCURVE.sAxis[u8Axis].u32Step = 0U;
+		sSCURVE.sAxis[u8Axis].s32Target = sSCURVE.sAxis[u8Axis].s32Position;
+	}
+
+	sSCURVE.u8SwapArmed = 0U;
+	sSCURVE.u8TargetPending = 0U;
+	sSCURVE.u8StopFirst = 0U;
+	sSCURVE.u8Busy = 0U;
+	sSCURVE.u32MoveTicks = 0U;
+
+	//let the ISR go again
+	sSCURVE.u8Abort = 0U;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Solve a double S profile from fV0 with no accel to rest fH steps on
+ *
+ * @note
+ * Cruise if the distance allows, else the peak veloc comes down, and if the
+ * accel ramps can't fit the accel limit is backed off until they do.
+ *
+ * @param[in]		fJmax					Jerk limit
+ * @param[in]		fAmax					Accel limit
+ * @param[in]		fVmax					Veloc limit
+ * @param[in]		fV0						Start veloc, >= 0
+ * @param[in]		fH						Distance, > 0
+ * @param[out]		*pProfile				The profile
+ * @return			0 = solved\n
+ *					-1 = can't stop within the distance
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.012
+ */
+static Lint16 s16SCURVE__Solve(SCURVE__PROFILE_T *pProfile, Lfloat32 fH, Lfloat32 fV0, Lfloat32 fVmax, Lfloat32 fAmax, Lfloat32 fJmax)
+{
+	Lint16 s16Return;
+	Luint8 u8Done;
+	Luint32 u32Pass;
+	Lfloat32 fA;
+	Lfloat32 fTj;
+	Lfloat32 fTj1;
+	Lfloat32 fTa;
+	Lfloat32 fTv;
+	Lfloat32 fTj2;
+	Lfloat32 fTd;
+	Lfloat32 fDelta;
+	Lfloat32 fMin;
+
+	//we can't plan a slow down to cruise
+	if(fVmax < fV0)
+	{
+		fVmax = fV0;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//shortest stop from fV0
+	fTj = (Lfloat32)sqrt((Lfloat64)(fV0 / fJmax));
+	if(fTj < (fAmax / fJmax))
+	{
+		fMin = fTj * fV0;
+	}
+	else
+	{
+		fMin = 0.5F * fV0 * ((fAmax / fJmax) + (fV0 / fAmax));
+	}
+
+	fTj1 = 0.0F;
+	fTa = 0.0F;
+	fTv = 0.0F;
+	fTj2 = 0.0F;
+	fTd = 0.0F;
+	u8Done = 0U;
+
+	if(fH > fMin)
+	{
+		fA = fAmax;
+		u32Pass = 0U;
+		while((u8Done == 0U) && (u32Pass < C_SCURVE__MAX_ITERATIONS))
+		{
+			//assume we get to fVmax
+			if(((fVmax - fV0) * fJmax) < (fA * fA))
+			{
+				fTj1 = (Lfloat32)sqrt((Lfloat64)((fVmax - fV0) / fJmax));
+				fTa = 2.0F * fTj1;
+			}
+			else
+			{
+				fTj1 = fA / fJmax;
+				fTa = fTj1 + ((fVmax - fV0) / fA);
+			}
+			if((fVmax * fJmax) < (fA * fA))
+			{
+				fTj2 = (Lfloat32)sqrt((Lfloat64)(fVmax / fJmax));
+				fTd = 2.0F * fTj2;
+			}
+			else
+			{
+				fTj2 = fA / fJmax;
+				fTd = fTj2 + (fVmax / fA);
+			}
+			fTv = (fH / fVmax) - ((fTa * 0.5F) * (1.0F + (fV0 / fVmax))) - (fTd * 0.5F);
+
+			if(fTv > 0.0F)
+			{
+				u8Done = 1U;
+			}
+			else
+			{
+				//no cruise, find the peak veloc
+				fTv = 0.0F;
+				fTj = fA / fJmax;
+				fTj1 = fTj;
+				fTj2 = fTj;
+				fDelta = (((fA * fA) * (fA * fA)) / (fJmax * fJmax)) + (2.0F * fV0 * fV0) + (fA * ((4.0F * fH) - (2.0F * (fA / fJmax) * fV0)));
+				fTa = (((fA * fA) / fJmax) - (2.0F * fV0) + (Lfloat32)sqrt((Lfloat64)fDelta)) / (2.0F * fA);
+				fTd = (((fA * fA) / fJmax) + (Lfloat32)sqrt((Lfloat64)fDelta)) / (2.0F * fA);
+
+				if(fTa < 0.0F)
+				{
+					//coming in too fast to speed up, decel only
+					fTa = 0.0F;
+					fTj1 = 0.0F;
+					fTd = (2.0F * fH) / fV0;
+					fTj2 = ((fJmax * fH) - (Lfloat32)sqrt((Lfloat64)(fJmax * ((fJmax * fH * fH) - (fV0 * fV0 * fV0))))) / (fJmax * fV0);
+					u8Done = 1U;
+				}
+				else if((fTa >= (2.0F * fTj)) && (fTd >= (2.0F * fTj)))
+				{
+					u8Done = 1U;
+				}
+				else
+				{
+					//the accel limit is never reached, back it off
+					fA *= 0.9F;
+				}
+			}
+
+			u32Pass++;
+		}
+	}
+	else
+	{
+		//would overshoot
+	}
+
+	if(u8Done == 1U)
+	{
+		pProfile->fH = fH;
+		pProfile->fV0 = fV0;
+		pProfile->fJmax = fJmax;
+		pProfile->fTj1 = fTj1;
+		pProfile->fTa = fTa;
+		pProfile->fTv = fTv;
+		pProfile->fTj2 = fTj2;
+		pProfile->fTd = fTd;
+		pProfile->fT = fTa + fTv + fTd;
+		pProfile->fAlimA = fJmax * fTj1;
+		pProfile->fAlimD = -fJmax * fTj2;
+		pProfile->fVlim = fV0 + ((fTa - fTj1) * pProfile->fAlimA);
+		s16Return = 0;
+	}
+	else
+	{
+		s16Return = -1;
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Solve a profile for an axis that also fits the table
+ *
+ * @param[in]		fVmax					Veloc limit for this plan
+ * @param[in]		fV0						Start veloc
+ * @param[in]		fH						Distance
+ * @param[out]		*pProfile				The profile
+ * @param[in]		u8Axis					The axis
+ * @return			0 = solved\n
+ *					-1 = no profile
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.013
+ */
+static Lint16 s16SCURVE__Fit(Luint8 u8Axis, SCURVE__PROFILE_T *pProfile, Lfloat32 fH, Lfloat32 fV0, Lfloat32 fVmax)
+{
+	Lint16 s16Return;
+	Luint8 u8Done;
+	Luint32 u32Pass;
+	Lfloat32 fRamp;
+
+	u8Done = 0U;
+	u32Pass = 0U;
+	s16Return = -1;
+	while((u8Done == 0U) && (u32Pass < C_SCURVE__MAX_ITERATIONS))
+	{
+		s16Return = s16SCURVE__Solve(pProfile, fH, fV0, fVmax, sSCURVE.sAxis[u8Axis].fMaxAccel, sSCURVE.sAxis[u8Axis].fMaxJerk);
+		if(s16Return == 0)
+		{
+			//steps that are not cruise, with a bit of room for rounding
+			fRamp = fH - (pProfile->fVlim * pProfile->fTv) + 3.0F;
+			if((fRamp <= (Lfloat32)C_LOCALDEF__LCCM673__TABLE_SIZE) || (fVmax <= fV0))
+			{
+				u8Done = 1U;
+			}
+			else
+			{
+				//shorter ramps
+				sSCURVE.u32TableLimits++;
+				fVmax *= 0.8F;
+			}
+		}
+		else
+		{
+			u8Done = 1U;
+		}
+
+		u32Pass++;
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Position along a profile
+ *
+ * @param[in]		fTime					Time from the start of the profile
+ * @param[in]		*pProfile				The profile
+ * @return			Position in steps
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.014
+ */
+static Lfloat32 fSCURVE__Position(const SCURVE__PROFILE_T *pProfile, Lfloat32 fTime)
+{
+	Lfloat32 fReturn;
+	Lfloat32 fU;
+
+	//time into the decel phase
+	fU = fTime - (pProfile->fT - pProfile->fTd);
+
+	if(fTime <= 0.0F)
+	{
+		fReturn = 0.0F;
+	}
+	else if(fTime >= pProfile->fT)
+	{
+		fReturn = pProfile->fH;
+	}
+	else if(fTime < pProfile->fTj1)
+	{
+		fReturn = (pProfile->fV0 * fTime) + ((pProfile->fJmax * fTime * fTime * fTime) / 6.0F);
+	}
+	else if(fTime < (pProfile->fTa - pProfile->fTj1))
+	{
+		fReturn = (pProfile->fV0 * fTime) + ((pProfile->fAlimA / 6.0F) * ((3.0F * fTime * fTime) - (3.0F * pProfile->fTj1 * fTime) + (pProfile->fTj1 * pProfile->fTj1)));
+	}
+	else if(fTime < pProfile->fTa)
+	{
+		fU = pProfile->fTa - fTime;
+		fReturn = (((pProfile->fVlim + pProfile->fV0) * pProfile->fTa) * 0.5F) - (pProfile->fVlim * fU) + ((pProfile->fJmax * fU * fU * fU) / 6.0F);
+	}
+	else if(fU < 0.0F)
+	{
+		//cruise
+		fReturn = (((pProfile->fVlim + pProfile->fV0) * pProfile->fTa) * 0.5F) + (pProfile->fVlim * (fTime - pProfile->fTa));
+	}
+	else if(fU < pProfile->fTj2)
+	{
+		fReturn = pProfile->fH - ((pProfile->fVlim * pProfile->fTd) * 0.5F) + (pProfile->fVlim * fU) - ((pProfile->fJmax * fU * fU * fU) / 6.0F);
+	}
+	else if(fTime < (pProfile->fT - pProfile->fTj2))
+	{
+		fReturn = pProfile->fH - ((pProfile->fVlim * pProfile->fTd) * 0.5F) + (pProfile->fVlim * fU) + ((pProfile->fAlimD / 6.0F) * ((3.0F * fU * fU) - (3.0F * pProfile->fTj2 * fU) + (pProfile->fTj2 * pProfile->fTj2)));
+	}
+	else
+	{
+		fU = pProfile->fT - fTime;
+		fReturn = pProfile->fH - ((pProfile->fJmax * fU * fU * fU) / 6.0F);
+	}
+
+	return fReturn;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Velocity along a profile
+ *
+ * @param[in]		fTime					Time from the start of the profile
+ * @param[in]		*pProfile				The profile
+ * @return			Veloc in steps/s
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.015
+ */
+static Lfloat32 fSCURVE__Velocity(const SCURVE__PROFILE_T *pProfile, Lfloat32 fTime)
+{
+	Lfloat32 fReturn;
+	Lfloat32 fU;
+
+	fU = fTime - (pProfile->fT - pProfile->fTd);
+
+	if(fTime <= 0.0F)
+	{
+		fReturn = pProfile->fV0;
+	}
+	else if(fTime >= pProfile->fT)
+	{
+		fReturn = 0.0F;
+	}
+	else if(fTime < pProfile->fTj1)
+	{
+		fReturn = pProfile->fV0 + ((pProfile->fJmax * fTime * fTime) * 0.5F);
+	}
+	else if(fTime < (pProfile->fTa - pProfile->fTj1))
+	{
+		fReturn = pProfile->fV0 + (pProfile->fAlimA * (fTime - (pProfile->fTj1 * 0.5F)));
+	}
+	else if(fTime < pProfile->fTa)
+	{
+		fU = pProfile->fTa - fTime;
+		fReturn = pProfile->fVlim - ((pProfile->fJmax * fU * fU) * 0.5F);
+	}
+	else if(fU < 0.0F)
+	{
+		fReturn = pProfile->fVlim;
+	}
+	else if(fU < pProfile->fTj2)
+	{
+		fReturn = pProfile->fVlim - ((pProfile->fJmax * fU * fU) * 0.5F);
+	}
+	else if(fTime < (pProfile->fT - pProfile->fTj2))
+	{
+		fReturn = pProfile->fVlim + (pProfile->fAlimD * (fU - (pProfile->fTj2 * 0.5F)));
+	}
+	else
+	{
+		fU = pProfile->fT - fTime;
+		fReturn = (pProfile->fJmax * fU * fU) * 0.5F;
+	}
+
+	return fReturn;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Time at which a profile gets to a position
+ *
+ * @note
+ * Newton from the guess, kept inside a bracket so it can't run off.
+ *
+ * @param[in]		fGuess					Starting guess, at or before the answer
+ * @param[in]		fPos					Position in steps
+ * @param[in]		*pProfile				The profile
+ * @return			Time from the start of the profile
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.016
+ */
+static Lfloat32 fSCURVE__Time_At(const SCURVE__PROFILE_T *pProfile, Lfloat32 fPos, Lfloat32 fGuess)
+{
+	Lfloat32 fTime;
+	Lfloat32 fLow;
+	Lfloat32 fHigh;
+	Lfloat32 fError;
+	Lfloat32 fVeloc;
+	Lfloat32 fNext;
+	Luint32 u32Pass;
+	Luint8 u8Done;
+
+	fLow = 0.0F;
+	fHigh = pProfile->fT;
+	fTime = fGuess;
+	if((fTime < fLow) || (fTime > fHigh))
+	{
+		fTime = 0.5F * (fLow + fHigh);
+	}
+	else
+	{
+		//fall on
+	}
+
+	u8Done = 0U;
+	u32Pass = 0U;
+	while((u8Done == 0U) && (u32Pass < 16U))
+	{
+		fError = fSCURVE__Position(pProfile, fTime) - fPos;
+		if(fError < 0.0F)
+		{
+			fLow = fTime;
+		}
+		else
+		{
+			fHigh = fTime;
+		}
+
+		if((fError < 0.0001F) && (fError > -0.0001F))
+		{
+			u8Done = 1U;
+		}
+		else
+		{
+			fVeloc = fSCURVE__Velocity(pProfile, fTime);
+			if(fVeloc > 0.0F)
+			{
+				fNext = fTime - (fError / fVeloc);
+			}
+			else
+			{
+				fNext = fLow - 1.0F;
+			}
+
+			//outside the bracket, halve it instead
+			if((fNext <= fLow) || (fNext >= fHigh))
+			{
+				fNext = 0.5F * (fLow + fHigh);
+			}
+			else
+			{
+				//fall on
+			}
+			fTime = fNext;
+		}
+
+		u32Pass++;
+	}
+
+	return fTime;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Shortest distance an axis can stop in
+ *
+ * @param[in]		fV0						Veloc now
+ * @param[in]		u8Axis					The axis
+ * @return			Steps
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.017
+ */
+static Lfloat32 fSCURVE__Stop_Distance(Luint8 u8Axis, Lfloat32 fV0)
+{
+	Lfloat32 fReturn;
+	Lfloat32 fTj;
+	Lfloat32 fA;
+	Lfloat32 fJ;
+
+	fA = sSCURVE.sAxis[u8Axis].fMaxAccel;
+	fJ = sSCURVE.sAxis[u8Axis].fMaxJerk;
+
+	fTj = (Lfloat32)sqrt((Lfloat64)(fV0 / fJ));
+	if(fTj < (fA / fJ))
+	{
+		fReturn = fTj * fV0;
+	}
+	else
+	{
+		fReturn = 0.5F * fV0 * ((fA / fJ) + (fV0 / fA));
+	}
+
+	return fReturn;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Turn a profile into the step table of a plan
+ *
+ * @note
+ * Step n is at profile position n - 0.5 + fOffset. Each step is put on the
+ * nearest tick of its exact time so the rounding never builds up.
+ *
+ * @param[in]		fOffset					0.5 when joining a running plan, else 0
+ * @param[in]		u32Steps				Steps in the plan
+ * @param[in]		*pProfile				The profile
+ * @param[in]		u8Buffer				Plan buffer
+ * @param[in]		u8Axis					The axis
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.018
+ */
+static void vSCURVE__Build_Table(Luint8 u8Axis, Luint8 u8Buffer, const SCURVE__PROFILE_T *pProfile, Luint32 u32Steps, Lfloat32 fOffset)
+{
+	Luint32 u32Step;
+	Luint32 u32Index;
+	Luint32 u32Emitted;
+	Luint32 u32Ticks;
+	Luint32 u32CruiseA;
+	Luint32 u32CruiseB;
+	Luint32 u32Acc;
+	Lint32 s32Ticks;
+	Luint64 u64Acc;
+	Lfloat32 fTick;
+	Lfloat32 fTime;
+	Lfloat32 fQa;
+	Lfloat32 fQb;
+	Lfloat32 fInterval;
+	Lfloat32 fFrac;
+
+	fTick = (Lfloat32)C_LOCALDEF__LCCM673__TICK_PERIOD_S;
+
+	//steps before and up to the end of the cruise
+	fQa = (((pProfile->fVlim + pProfile->fV0) * pProfile->fTa) * 0.5F) + 0.5F - fOffset;
+	fQb = fQa + (pProfile->fVlim * pProfile->fTv);
+	u32CruiseA = (Luint32)fQa;
+	u32CruiseB = (Luint32)fQb;
+	if(u32CruiseB > u32Steps)
+	{
+		u32CruiseB = u32Steps;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//the first cruise step goes in the table to line up the fraction
+	if((pProfile->fTv > 0.0F) && (u32CruiseB > (u32CruiseA + 1U)))
+	{
+		sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseStart = u32CruiseA + 1U;
+		sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseSteps = u32CruiseB - (u32CruiseA + 1U);
+	}
+	else
+	{
+		sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseStart = u32Steps;
+		sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseSteps = 0U;
+	}
+
+	u32Emitted = 0U;
+	u32Index = 0U;
+	fTime = 0.0F;
+	u32Step = 1U;
+	while(u32Step <= u32Steps)
+	{
+		if(u32Step == (sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseStart + 1U))
+		{
+			//cruise starts, set up the 16.16 interval and skip over it
+			fInterval = 1.0F / (pProfile->fVlim * fTick);
+			sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseTicks_Q16 = (Luint32)((fInterval * 65536.0F) + 0.5F);
+
+			fFrac = ((fTime / fTick) - (Lfloat32)u32Emitted) + 0.5F;
+			if(fFrac < 0.0F)
+			{
+				u32Acc = 0U;
+			}
+			else if(fFrac >= 1.0F)
+			{
+				u32Acc = 0xFFFFU;
+			}
+			else
+			{
+				u32Acc = (Luint32)(fFrac * 65536.0F);
+			}
+			sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseAcc0_Q16 = u32Acc;
+
+			//where the ISR will be after the cruise
+			u64Acc = (Luint64)u32Acc + ((Luint64)sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseSteps * (Luint64)sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseTicks_Q16);
+			u32Emitted += (Luint32)(u64Acc >> 16U);
+			fTime += (Lfloat32)sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseSteps / pProfile->fVlim;
+			u32Step += sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseSteps;
+		}
+		else
+		{
+			//fall on
+		}
+
+		if(u32Step <= u32Steps)
+		{
+			fTime = fSCURVE__Time_At(pProfile, ((Lfloat32)u32Step - 0.5F) + fOffset, fTime);
+			s32Ticks = (Lint32)((fTime / fTick) + 0.5F) - (Lint32)u32Emitted;
+			if(s32Ticks < (Lint32)C_SCURVE__MIN_TICKS)
+			{
+				u32Ticks = C_SCURVE__MIN_TICKS;
+			}
+			else if(s32Ticks > 0xFFFF)
+			{
+				u32Ticks = 0xFFFFU;
+			}
+			else
+			{
+				u32Ticks = (Luint32)s32Ticks;
+			}
+
+			if(u32Index < C_LOCALDEF__LCCM673__TABLE_SIZE)
+			{
+				sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u16Table[u32Index] = (Luint16)u32Ticks;
+				u32Index++;
+			}
+			else
+			{
+				//can't happen once the fit has passed, leave the rest at the last rate
+			}
+			u32Emitted += u32Ticks;
+		}
+		else
+		{
+			//cruise ran to the end
+		}
+
+		u32Step++;
+	}
+
+	//anything the table could not hold repeats the last entry
+	if((u32Index > 0U) && (u32Index < C_LOCALDEF__LCCM673__TABLE_SIZE))
+	{
+		u32Ticks = sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u16Table[u32Index - 1U];
+		while(u32Index < C_LOCALDEF__LCCM673__TABLE_SIZE)
+		{
+			sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u16Table[u32Index] = (Luint16)u32Ticks;
+			u32Index++;
+		}
+	}
+	else
+	{
+		//fall on
+	}
+
+	sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32TotalSteps = u32Steps;
+	sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].fOffset = fOffset;
+	sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].sProfile = *pProfile;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Plan the pending target for all axes into the spare buffers
+ *
+ * @note
+ * Leaves the target pending if the last replan has not been taken over yet, or
+ * a running axis is too close to its end to join, Process tries again.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.019
+ */
+static void vSCURVE__Plan(void)
+{
+	SCURVE__PROFILE_T sProfile[C_LOCALDEF__LCCM673__NUM_AXES];
+	Lfloat32 fV0[C_LOCALDEF__LCCM673__NUM_AXES];
+	Lfloat32 fOffset[C_LOCALDEF__LCCM673__NUM_AXES];
+	Lfloat32 fStart[C_LOCALDEF__LCCM673__NUM_AXES];
+	Lint32 s32Steps[C_LOCALDEF__LCCM673__NUM_AXES];
+	Lint32 s32Direction[C_LOCALDEF__LCCM673__NUM_AXES];
+	Lint32 s32SwapPos[C_LOCALDEF__LCCM673__NUM_AXES];
+	Luint32 u32SwapStep[C_LOCALDEF__LCCM673__NUM_AXES];
+	Luint8 u8Was_Running[C_LOCALDEF__LCCM673__NUM_AXES];
+	SCURVE__PROFILE_T sTrial;
+	const SCURVE__PROFILE_T *pOld;
+	Lfloat32 fTick;
+	Lfloat32 fTime;
+	Lfloat32 fEnd;
+	Lfloat32 fWant;
+	Lfloat32 fLow;
+	Lfloat32 fHigh;
+	Lfloat32 fMid;
+	Luint32 u32Step;
+	Luint32 u32Pass;
+	Luint8 u8Axis;
+	Luint8 u8Buffer;
+	Luint8 u8Defer;
+	Luint8 u8Stop;
+	Luint8 u8Armed;
+	Lint32 s32Delta;
+	Lint16 s16Return;
+
+	fTick = (Lfloat32)C_LOCALDEF__LCCM673__TICK_PERIOD_S;
+
+	//the last plan has to be taken over before we can write the spare again
+	u8Defer = sSCURVE.u8SwapArmed;
+	u8Stop = 0U;
+
+	//where each axis will be when the new plan takes over
+	for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+	{
+		u8Buffer = sSCURVE.sAxis[u8Axis].u8Active;
+		u8Was_Running[u8Axis] = sSCURVE.sAxis[u8Axis].u8Running;
+		u32Step = sSCURVE.sAxis[u8Axis].u32Step;
+
+		if(u8Was_Running[u8Axis] == 1U)
+		{
+			if((sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32TotalSteps - u32Step) <= (C_LOCALDEF__LCCM673__REPLAN_LEAD + 1U))
+			{
+				//nearly there, plan from rest
+				u8Defer = 1U;
+			}
+			else
+			{
+				pOld = &sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].sProfile;
+				u32SwapStep[u8Axis] = u32Step + C_LOCALDEF__LCCM673__REPLAN_LEAD;
+				fTime = fSCURVE__Time_At(pOld, ((Lfloat32)u32Step - 0.5F) + sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].fOffset, 0.0F);
+				fStart[u8Axis] = fSCURVE__Time_At(pOld, ((Lfloat32)u32SwapStep[u8Axis] - 0.5F) + sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].fOffset, fTime);
+				fV0[u8Axis] = fSCURVE__Velocity(pOld, fStart[u8Axis]);
+				fStart[u8Axis] -= fTime;
+				fOffset[u8Axis] = 0.5F;
+				s32Direction[u8Axis] = sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].s32Direction;
+				s32SwapPos[u8Axis] = sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].s32StartPos + (s32Direction[u8Axis] * (Lint32)u32SwapStep[u8Axis]);
+
+				//can we get there without reversing or overshooting
+				s32Delta = (sSCURVE.sAxis[u8Axis].s32Target - s32SwapPos[u8Axis]) * s32Direction[u8Axis];
+				if(((Lfloat32)s32Delta + 0.5F) <= fSCURVE__Stop_Distance(u8Axis, fV0[u8Axis]))
+				{
+					u8Stop = 1U;
+				}
+				else
+				{
+					//fall on
+				}
+			}
+		}
+		else
+		{
+			//starts from rest on the next tick
+			u32SwapStep[u8Axis] = u32Step;
+			fStart[u8Axis] = 0.0F;
+			fV0[u8Axis] = 0.0F;
+			fOffset[u8Axis] = 0.0F;
+			s32SwapPos[u8Axis] = sSCURVE.sAxis[u8Axis].s32Position;
+			if(sSCURVE.sAxis[u8Axis].s32Target >= s32SwapPos[u8Axis])
+			{
+				s32Direction[u8Axis] = 1;
+			}
+			else
+			{
+				s32Direction[u8Axis] = -1;
+			}
+		}
+	}
+
+	if(u8Defer == 0U)
+	{
+		//steps and profile for each axis
+		fEnd = 0.0F;
+		for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+		{
+			if(u8Stop == 1U)
+			{
+				//shortest stop for the moving axes, the rest hold
+				if(u8Was_Running[u8Axis] == 1U)
+				{
+					s32Steps[u8Axis] = (Lint32)fSCURVE__Stop_Distance(u8Axis, fV0[u8Axis]) + 1;
+				}
+				else
+				{
+					s32Steps[u8Axis] = 0;
+				}
+			}
+			else
+			{
+				s32Steps[u8Axis] = (sSCURVE.sAxis[u8Axis].s32Target - s32SwapPos[u8Axis]) * s32Direction[u8Axis];
+			}
+
+			if(s32Steps[u8Axis] > 0)
+			{
+				s16Return = s16SCURVE__Fit(u8Axis, &sProfile[u8Axis], (Lfloat32)s32Steps[u8Axis] + fOffset[u8Axis], fV0[u8Axis], sSCURVE.sAxis[u8Axis].fMaxVeloc);
+				if(s16Return == 0)
+				{
+					if(((fStart[u8Axis] + sProfile[u8Axis].fT) > fEnd) && (u8Stop == 0U))
+					{
+						fEnd = fStart[u8Axis] + sProfile[u8Axis].fT;
+					}
+					else
+					{
+						//fall on
+					}
+				}
+				else
+				{
+					//should not happen, hold the axis where the plan takes over
+					s32Steps[u8Axis] = 0;
+				}
+			}
+			else
+			{
+				//not moving
+				s32Steps[u8Axis] = 0;
+			}
+		}
+
+		//stretch the quick axes so everyone arrives together
+		for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+		{
+			fWant = fEnd - fStart[u8Axis];
+			if((s32Steps[u8Axis] > 0) && (u8Stop == 0U) && (sProfile[u8Axis].fT < (fWant - fTick)))
+			{
+				fLow = fV0[u8Axis];
+				if(fLow < (sSCURVE.sAxis[u8Axis].fMaxVeloc * 0.001F))
+				{
+					fLow = sSCURVE.sAxis[u8Axis].fMaxVeloc * 0.001F;
+				}
+				else
+				{
+					//fall on
+				}
+				fHigh = sProfile[u8Axis].fVlim;
+
+				s16Return = s16SCURVE__Fit(u8Axis, &sTrial, sProfile[u8Axis].fH, fV0[u8Axis], fLow);
+				if((s16Return == 0) && (sTrial.fT >= fWant))
+				{
+					for(u32Pass = 0U; u32Pass < C_SCURVE__SYNC_ITERATIONS; u32Pass++)
+					{
+						fMid = 0.5F * (fLow + fHigh);
+						s16Return = s16SCURVE__Fit(u8Axis, &sTrial, sProfile[u8Axis].fH, fV0[u8Axis], fMid);
+						if((s16Return == 0) && (sTrial.fT > fWant))
+						{
+							fLow = fMid;
+						}
+						else
+						{
+							fHigh = fMid;
+						}
+					}
+
+					//just early rather than late
+					s16Return = s16SCURVE__Fit(u8Axis, &sTrial, sProfile[u8Axis].fH, fV0[u8Axis], fHigh);
+					if(s16Return == 0)
+					{
+						sProfile[u8Axis] = sTrial;
+					}
+					else
+					{
+						//keep the fast one
+					}
+				}
+				else
+				{
+					//already going as slow as it can from here
+					sSCURVE.u32SyncMisses++;
+				}
+			}
+			else
+			{
+				//the slowest axis or not moving
+			}
+		}
+
+		//fill the spare buffers, empty plans for axes that hold
+		u8Armed = 0U;
+		for(u8Axis = 0U; u8Axis < C_LOCALDEF__LCCM673__NUM_AXES; u8Axis++)
+		{
+			u8Buffer = sSCURVE.sAxis[u8Axis].u8Active ^ 1U;
+			if(s32Steps[u8Axis] > 0)
+			{
+				vSCURVE__Build_Table(u8Axis, u8Buffer, &sProfile[u8Axis], (Luint32)s32Steps[u8Axis], fOffset[u8Axis]);
+			}
+			else
+			{
+				sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32TotalSteps = 0U;
+				sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseSteps = 0U;
+				sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseStart = 0U;
+			}
+			sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].s32Direction = s32Direction[u8Axis];
+			sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].s32StartPos = s32SwapPos[u8Axis];
+
+			//a running axis always swaps so it stops at the join if it has nothing more to do
+			if((s32Steps[u8Axis] > 0) || (u8Was_Running[u8Axis] == 1U))
+			{
+				sSCURVE.sAxis[u8Axis].u32SwapStep = u32SwapStep[u8Axis];
+				sSCURVE.sAxis[u8Axis].u8SwapPending = 1U;
+				u8Armed = 1U;
+			}
+			else
+			{
+				//stays put
+			}
+
+			if(u8Was_Running[u8Axis] == 1U)
+			{
+				sSCURVE.u32Replans++;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+
+		//one write lets the ISR see every axis at once
+		sSCURVE.u8SwapArmed = u8Armed;
+		sSCURVE.u8StopFirst = u8Stop;
+		sSCURVE.u8TargetPending = 0U;
+	}
+	else
+	{
+		//try again next pass
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Ticks to the next step of an axis, from the ISR
+ *
+ * @param[in]		u8Axis					The axis
+ * @return			Ticks
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.020
+ */
+static Luint32 u32SCURVE__Next_Interval(Luint8 u8Axis)
+{
+	Luint32 u32Return;
+	Luint32 u32Step;
+	Luint8 u8Buffer;
+
+	u8Buffer = sSCURVE.sAxis[u8Axis].u8Active;
+	u32Step = sSCURVE.sAxis[u8Axis].u32Step;
+
+	if(u32Step < sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseStart)
+	{
+		u32Return = (Luint32)sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u16Table[u32Step];
+	}
+	else if(u32Step < (sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseStart + sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseSteps))
+	{
+		sSCURVE.sAxis[u8Axis].u32CruiseAcc_Q16 += sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseTicks_Q16;
+		u32Return = sSCURVE.sAxis[u8Axis].u32CruiseAcc_Q16 >> 16U;
+		sSCURVE.sAxis[u8Axis].u32CruiseAcc_Q16 &= 0x0000FFFFU;
+	}
+	else
+	{
+		u32Return = (Luint32)sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u16Table[u32Step - sSCURVE.sAxis[u8Axis].sPlan[u8Buffer].u32CruiseSteps];
+	}
+
+	//late swap can land us past the end of a short table
+	if(u32Return < C_SCURVE__MIN_TICKS)
+	{
+		u32Return = C_SCURVE__MIN_TICKS;
+	}
+	else
+	{
+		//fall on
+	}
+
+	return u32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Drive the step pin of an axis, through the localdef
+ *
+ * @param[in]		u8Level					1 = high
+ * @param[in]		u8Axis					The axis
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.021
+ */
+static void vSCURVE__Pulse(Luint8 u8Axis, Luint8 u8Level)
+{
+	M_LOCALDEF__LCCM673__PULSE(u8Axis, u8Level);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Set the direction pin of an axis, through the localdef
+ *
+ * @param[in]		s32Direction			+1 or -1
+ * @param[in]		u8Axis					The axis
+ * @st_funcMD5
+ * @st_funcID		LCCM673R0.FILE.000.FUNC.022
+ */
+static void vSCURVE__Direction(Luint8 u8Axis, Lint32 s32Direction)
+{
+	M_LOCALDEF__LCCM673__DIRECTION(u8Axis, s32Direction);
+}
+
+
+#endif //#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
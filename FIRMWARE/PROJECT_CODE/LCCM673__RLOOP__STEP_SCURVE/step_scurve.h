@@ -0,0 +1,231 @@
+/**
+ * @file		STEP_SCURVE.H
+ * @brief		Main header for the jerk limited step planner
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ */
+
+
+#ifndef _STEP_SCURVE_H_
+#define _STEP_SCURVE_H_
+	#include <localdef.h>
+	#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+
+		/*******************************************************************************
+		Defines
+		*******************************************************************************/
+
+		/** Shortest step interval in timebase ticks, one tick high and one low */
+		#define C_SCURVE__MIN_TICKS							(2U)
+
+		/** Limit of passes when the planner has to back off accel or veloc */
+		#define C_SCURVE__MAX_ITERATIONS					(64U)
+
+		/** Bisection passes to stretch an axis to the common arrival time */
+		#define C_SCURVE__SYNC_ITERATIONS					(24U)
+
+
+		/*******************************************************************************
+		Structures
+		*******************************************************************************/
+
+		/** A jerk limited (double S) profile along one axis, in steps.
+		 * Starts at fV0 with no accel, ends at rest fH steps later. */
+		typedef struct
+		{
+			/** Distance in steps, always positive */
+			Lfloat32 fH;
+
+			/** Velocity at the start of the profile */
+			Lfloat32 fV0;
+
+			/** Peak velocity reached */
+			Lfloat32 fVlim;
+
+			/** Peak accel and decel (decel is negative) */
+			Lfloat32 fAlimA;
+			Lfloat32 fAlimD;
+
+			/** Jerk limit */
+			Lfloat32 fJmax;
+
+			/** Jerk time and total time of the accel phase */
+			Lfloat32 fTj1;
+			Lfloat32 fTa;
+
+			/** Cruise time */
+			Lfloat32 fTv;
+
+			/** Jerk time and total time of the decel phase */
+			Lfloat32 fTj2;
+			Lfloat32 fTd;
+
+			/** Total time */
+			Lfloat32 fT;
+
+		}SCURVE__PROFILE_T;
+
+
+		/** Precomputed step timing for all axes.
+		 * The planner fills the spare buffer of each axis in the main loop, the
+		 * timebase ISR only reads the buffer it is running. */
+		struct _strSCURVE
+		{
+			struct
+			{
+				/** Two plans, one running and one being built */
+				struct
+				{
+					/** Ticks between steps, ramp up then ramp down, the cruise is not stored */
+					Luint16 u16Table[C_LOCALDEF__LCCM673__TABLE_SIZE];
+
+					/** Table entries before the cruise */
+					Luint32 u32CruiseStart;
+
+					/** Steps at cruise */
+					Luint32 u32CruiseSteps;
+
+					/** Cruise interval in ticks, 16.16 */
+					Luint32 u32CruiseTicks_Q16;
+
+					/** Start of the cruise fraction so the cruise lands on the right tick */
+					Luint32 u32CruiseAcc0_Q16;
+
+					/** Total steps in the plan */
+					Luint32 u32TotalSteps;
+
+					/** +1 or -1 */
+					Lint32 s32Direction;
+
+					/** Position when the plan takes over */
+					Lint32 s32StartPos;
+
+					/** Half a step when the plan joins a running one, the first step is then a full step on */
+					Lfloat32 fOffset;
+
+					/** The profile behind the table, kept for replanning */
+					SCURVE__PROFILE_T sProfile;
+
+				}sPlan[2];
+
+				/** ISR side, the plan we are running */
+				volatile Luint8 u8Active;
+
+				/** Steps done in the running plan */
+				volatile Luint32 u32Step;
+
+				/** Ticks to the next step */
+				Luint32 u32Countdown;
+
+				/** Cruise fraction */
+				Luint32 u32CruiseAcc_Q16;
+
+				/** Pulse is high, drop it next tick */
+				volatile Luint8 u8PulseHigh;
+
+				/** Position in steps */
+				volatile Lint32 s32Position;
+
+				/** Stepping */
+				volatile Luint8 u8Running;
+
+				/** The spare plan takes over once u32Step reaches u32SwapStep */
+				volatile Luint8 u8SwapPending;
+				volatile Luint32 u32SwapStep;
+
+				/** Tick count of the last step */
+				volatile Luint32 u32ArriveTick;
+
+				/** Limits in steps, s, s^2, s^3 */
+				Lfloat32 fMaxVeloc;
+				Lfloat32 fMaxAccel;
+				Lfloat32 fMaxJerk;
+
+				/** Steps per micron from the lead screw */
+				Lfloat32 fStepsPerMicron;
+
+				/** Where we have been told to go, in steps */
+				Lint32 s32Target;
+
+			}sAxis[C_LOCALDEF__LCCM673__NUM_AXES];
+
+			/** Timebase ticks */
+			volatile Luint32 u32Ticks;
+
+			/** Set once every pending swap is written, the ISR clears it when all are taken */
+			volatile Luint8 u8SwapArmed;
+
+			/** Set by vSCURVE__Abort(), the ISR does nothing but drop pulses until
+			 * the main loop has cleared the move away */
+			volatile Luint8 u8Abort;
+
+			/** Axis that asked for the last abort */
+			volatile Luint8 u8AbortAxis;
+
+			/** A target is waiting to be planned */
+			Luint8 u8TargetPending;
+
+			/** Running a stop before the real target, it gets planned from rest */
+			Luint8 u8StopFirst;
+
+			/** A move is in progress */
+			Luint8 u8Busy;
+
+			/** Move timing, from the move request to the last axis arriving */
+			Luint32 u32MoveStartTick;
+			Luint32 u32MoveTicks;
+
+			Luint32 u32TaskID;
+
+			/** Stats */
+			Luint32 u32Replans;
+			Luint32 u32SyncMisses;
+			Luint32 u32TableLimits;
+			volatile Luint32 u32Aborts;
+
+		};
+
+
+		/*******************************************************************************
+		Function Prototypes
+		*******************************************************************************/
+		void vSCURVE__Init(void);
+		void vSCURVE__Set_Limits(Luint8 u8Axis, Lint32 s32Veloc_microns_s, Lint32 s32Accel_microns_ss, Lint32 s32Jerk_microns_sss);
+		Lint16 s16SCURVE__Move(const Lint32 * cps32Target_microns, Luint32 u32TaskID);
+		void vSCURVE__Process(void);
+		void vSCURVE__ISR(void);
+		void vSCURVE__Abort(Luint8 u8Axis);
+		Lint32 s32SCURVE__Get_Position(Luint8 u8Axis);
+		Luint8 u8SCURVE__Get_Busy(void);
+		Luint32 u32SCURVE__Get_MoveTicks(void);
+		Luint32 u32SCURVE__Get_Aborts(void);
+
+		//testing
+		#if C_LOCALDEF__LCCM673__ENABLE_TEST_SPEC == 1U
+			DLL_DECLARATION void vLCCM673R0_TS_000(void);
+		#endif
+
+		//safetys
+		#ifndef C_LOCALDEF__LCCM673__NUM_AXES
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM673__TICK_PERIOD_S
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM673__TABLE_SIZE
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM673__REPLAN_LEAD
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM673__TABLE_SIZE == 0U
+			#error
+		#endif
+
+	#endif //#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+	//safetys
+	#ifndef C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE
+		#error
+	#endif
+#endif //_STEP_SCURVE_H_
+
@@ -0,0 +1,45 @@
+/**
+ * @file		STEP_SCURVE__LOCALDEF.H
+ * @brief		Localdef template
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM673R0.FILE.001
+ */
+
+#if 0
+
+/*******************************************************************************
+RLOOP - STEP S-CURVE PLANNER
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+
+		/** Number of axes moved together */
+		#define C_LOCALDEF__LCCM673__NUM_AXES								(2U)
+
+		/** Period of the timebase ISR in seconds */
+		#define C_LOCALDEF__LCCM673__TICK_PERIOD_S							(0.000050F)
+
+		/** Step table entries per plan, the ramps only, the cruise is not stored */
+		#define C_LOCALDEF__LCCM673__TABLE_SIZE								(1024U)
+
+		/** Steps ahead of the ISR that a replan joins the running plan */
+		#define C_LOCALDEF__LCCM673__REPLAN_LEAD							(8U)
+
+		/** Scale of an axis, steps per rev including the microsteps, and the
+		lead screw pitch in microns per rev */
+		#define M_LOCALDEF__LCCM673__STEPS_PER_REV(axis)					(u32STEPDRIVE_MEM__Get_StepsPerRevolution(axis) * (Luint32)u8STEPDRIVE_MEM__Get_MicroStepResolution(axis))
+		#define M_LOCALDEF__LCCM673__MICRONS_PER_REV(axis)					s32STEPDRIVE_MEM__Get_PicoMeters_PerRev(axis)
+
+		/** Step and direction pins, level is 1 or 0, direction is +1 or -1 */
+		#define M_LOCALDEF__LCCM673__PULSE(axis,level)						{if((level) == 1U){vSTEPDRIVE_GEKO__Set_PulseHigh(axis);}else{vSTEPDRIVE_GEKO__Set_PulseLow(axis);}}
+		#define M_LOCALDEF__LCCM673__DIRECTION(axis,dir)					{if((dir) > 0){vSTEPDRIVE_GEKO__Set_RotationClockwise(axis);}else{vSTEPDRIVE_GEKO__Set_RotationCounterClockwise(axis);}}
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM673__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM673__RLOOP__STEP_SCURVE/step_scurve.h>
+	#endif //#if C_LOCALDEF__LCCM673__ENABLE_THIS_MODULE == 1U
+
+#endif //#if 0
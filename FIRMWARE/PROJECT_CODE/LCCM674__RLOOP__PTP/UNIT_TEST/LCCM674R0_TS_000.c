@@ -0,0 +1,284 @@
+/**
+ * @file		LCCM674R0_TS_000.C
+ * @brief		Test spec for PTP, slave against the loopback grandmaster
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM674R0.FILE.004
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM674__ENABLE_TEST_SPEC == 1U
+#if C_LOCALDEF__LCCM674__ENABLE_LOOPBACK == 1U
+
+#include <stdio.h>
+#include <math.h>
+
+void vLCCM674R0_TS_000_TCASE_001(void);
+void vLCCM674R0_TS_000_TCASE_002(void);
+static void vTS000__Run(Luint32 u32Time_ms, Luint32 u32Measure_ms);
+static void vTS000__Result(Luint32 u32Fail, const char *pcCase);
+
+/** Process rate of the sim */
+#define C_TS000__LOOP_NS						(1000000U)
+
+/** Wire */
+#define C_TS000__PATH_DELAY_NS					(2000U)
+#define C_TS000__JITTER_NS						(20U)
+
+/** Locked limits against true time */
+#define C_TS000__MAX_OFFSET_NS					(250)
+#define C_TS000__MAX_RMS_NS						(60.0)
+#define C_TS000__MAX_PODTIME_NS					(1000)
+
+extern struct _strPTP sPTP;
+
+//what the sim saw over the measured part of a run
+static struct
+{
+	Luint32 u32LockTime_ms;
+	Lint64 s64MaxOffset;
+	Lfloat64 f64SumSquare;
+	Luint32 u32Samples;
+	Lint64 s64MaxPodTime;
+
+}sTS000;
+
+//Function to call the tests for this test specification
+void vLCCM674R0_TS_000(void)
+{
+	//Call the test cases
+	vLCCM674R0_TS_000_TCASE_001();
+	vLCCM674R0_TS_000_TCASE_002();
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM674R0.TS.000.TCASE.001
+ * @st_test_desc
+ * Cold start 1.5s out with a 40ppm PHY oscillator and a -25ppm local counter.
+ * Must step once or twice, lock, then hold the PHY clock and the pod time to
+ * the grandmaster and get the path delay right.
+ *
+*/
+void vLCCM674R0_TS_000_TCASE_001(void)
+{
+	Luint32 u32Fail;
+	Lint64 s64Delay;
+	char cText[200];
+	Luint8 u8MAC[6] = {0x00U, 0x26U, 0x80U, 0x01U, 0x00U, 0x00U};
+	Luint8 u8IP[4] = {192U, 168U, 0U, 110U};
+
+	DEBUG_PRINT("START:LCCM674R0.TS.000.TCASE.001\r\n");
+	u32Fail = 0U;
+
+	vPTP_LOOPBACK__Init(1500000000LL, 40000, -25000, C_TS000__PATH_DELAY_NS, C_TS000__JITTER_NS);
+	vPTP__Init(&u8MAC[0], &u8IP[0]);
+
+	//a minute, measure the last 20s
+	vTS000__Run(60000U, 20000U);
+
+	sprintf(cText, "INFO:locked at %u ms, %u steps, %u syncs, %u missed stamps, rate %d ppb\r\n",
+				sTS000.u32LockTime_ms, sPTP.sStats.u32Steps, sPTP.sStats.u32Syncs, sPTP.sStats.u32MissedStamps, sPTP.sSlave.s32Rate_ppb);
+	DEBUG_PRINT(cText);
+	sprintf(cText, "INFO:true offset max %d ns, RMS %.1f ns, servo jitter %.1f ns RMS, pod time max error %d ns, path delay %d ns\r\n",
+				(Lint32)sTS000.s64MaxOffset, sqrt(sTS000.f64SumSquare / (Lfloat64)sTS000.u32Samples),
+				(Lfloat64)f32PTP__Get_Jitter_ns(), (Lint32)sTS000.s64MaxPodTime, (Lint32)s64PTP__Get_PathDelay_ns());
+	DEBUG_PRINT(cText);
+
+	if((u8PTP__Is_Locked() != 1U) || (sPTP.sStats.u32Steps == 0U) || (sPTP.sStats.u32Steps > 2U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	if((sTS000.s64MaxOffset > C_TS000__MAX_OFFSET_NS) || (sqrt(sTS000.f64SumSquare / (Lfloat64)sTS000.u32Samples) > C_TS000__MAX_RMS_NS))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	if(sTS000.s64MaxPodTime > C_TS000__MAX_PODTIME_NS)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	s64Delay = s64PTP__Get_PathDelay_ns() - (Lint64)C_TS000__PATH_DELAY_NS;
+	if((s64Delay > 100) || (s64Delay < -100))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM674R0.TS.000.TCASE.001");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM674R0.TS.000.TCASE.002
+ * @st_test_desc
+ * Warm start 15us ahead with a -30ppm PHY oscillator. Inside the step threshold
+ * so it has to be slewed in without a step.
+ *
+*/
+void vLCCM674R0_TS_000_TCASE_002(void)
+{
+	Luint32 u32Fail;
+	char cText[200];
+	Luint8 u8MAC[6] = {0x00U, 0x26U, 0x80U, 0x01U, 0x00U, 0x00U};
+	Luint8 u8IP[4] = {192U, 168U, 0U, 110U};
+
+	DEBUG_PRINT("START:LCCM674R0.TS.000.TCASE.002\r\n");
+	u32Fail = 0U;
+
+	vPTP_LOOPBACK__Init(15000LL, -30000, 10000, C_TS000__PATH_DELAY_NS, C_TS000__JITTER_NS);
+	vPTP__Init(&u8MAC[0], &u8IP[0]);
+
+	vTS000__Run(60000U, 20000U);
+
+	sprintf(cText, "INFO:locked at %u ms, %u steps, true offset max %d ns, RMS %.1f ns, pod time max error %d ns\r\n",
+				sTS000.u32LockTime_ms, sPTP.sStats.u32Steps, (Lint32)sTS000.s64MaxOffset,
+				sqrt(sTS000.f64SumSquare / (Lfloat64)sTS000.u32Samples), (Lint32)sTS000.s64MaxPodTime);
+	DEBUG_PRINT(cText);
+
+	if((u8PTP__Is_Locked() != 1U) || (sPTP.sStats.u32Steps != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	if((sTS000.s64MaxOffset > C_TS000__MAX_OFFSET_NS) || (sTS000.s64MaxPodTime > C_TS000__MAX_PODTIME_NS))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM674R0.TS.000.TCASE.002");
+}
+
+/***************************************************************************//**
+ * @brief
+ * Run the slave against the grandmaster
+ *
+ * @param[in]		u32Measure_ms			Measure over the last of the run
+ * @param[in]		u32Time_ms				Run length
+ */
+static void vTS000__Run(Luint32 u32Time_ms, Luint32 u32Measure_ms)
+{
+	Luint32 u32Counter;
+	Lint64 s64Offset;
+	Lint64 s64PodTime;
+
+	sTS000.u32LockTime_ms = 0U;
+	sTS000.s64MaxOffset = 0;
+	sTS000.f64SumSquare = 0.0;
+	sTS000.u32Samples = 0U;
+	sTS000.s64MaxPodTime = 0;
+
+	for(u32Counter = 0U; u32Counter < u32Time_ms; u32Counter++)
+	{
+		vPTP_LOOPBACK__Advance(C_TS000__LOOP_NS);
+		vPTP__Process();
+
+		if((sTS000.u32LockTime_ms == 0U) && (u8PTP__Is_Locked() == 1U))
+		{
+			sTS000.u32LockTime_ms = u32Counter;
+		}
+		else
+		{
+			//fall on
+		}
+
+		if(u32Counter >= (u32Time_ms - u32Measure_ms))
+		{
+			s64Offset = s64PTP_LOOPBACK__Get_TrueOffset_ns();
+			sTS000.f64SumSquare += (Lfloat64)s64Offset * (Lfloat64)s64Offset;
+			sTS000.u32Samples++;
+			if(s64Offset < 0)
+			{
+				s64Offset = -s64Offset;
+			}
+			else
+			{
+				//fall on
+			}
+			if(s64Offset > sTS000.s64MaxOffset)
+			{
+				sTS000.s64MaxOffset = s64Offset;
+			}
+			else
+			{
+				//fall on
+			}
+
+			s64PodTime = (Lint64)(u64PTP__Get_PodTime_ns() - u64PTP_LOOPBACK__Get_TrueTime_ns());
+			if(s64PodTime < 0)
+			{
+				s64PodTime = -s64PodTime;
+			}
+			else
+			{
+				//fall on
+			}
+			if(s64PodTime > sTS000.s64MaxPodTime)
+			{
+				sTS000.s64MaxPodTime = s64PodTime;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		else
+		{
+			//settling
+		}
+	}
+}
+
+static void vTS000__Result(Luint32 u32Fail, const char *pcCase)
+{
+	char cText[200];
+
+	if(u32Fail == 0U)
+	{
+		sprintf(cText, "PASS:%s\r\n", pcCase);
+	}
+	else
+	{
+		sprintf(cText, "FAIL:%s (%u)\r\n", pcCase, u32Fail);
+	}
+	DEBUG_PRINT(cText);
+
+	sprintf(cText, "END:%s\r\n", pcCase);
+	DEBUG_PRINT(cText);
+
+}
+
+#endif //#if C_LOCALDEF__LCCM674__ENABLE_LOOPBACK == 1U
+#endif //#if C_LOCALDEF__LCCM674__ENABLE_TEST_SPEC == 1U
+#endif //#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE
+	#error
+#endif
@@ -0,0 +1,936 @@
+/**
+ * @file		PTP.C
+ * @brief		IEEE1588 clock sync and pod time
+ *
+ * @note
+ * PTP v2 over UDP, two step, end to end delay, one domain. The PHY does the
+ * stamping so the stamps are at the wire and the software latency drops out:
+ *
+ * Master				Slave
+ * t1 Sync ------------> t2
+ *    Follow_Up(t1) ---->
+ * t4 <------------ Delay_Req t3
+ *    Delay_Resp(t4) --->
+ *
+ * delay = ((t2 - t1) + (t4 - t3)) / 2
+ * offset = (t2 - t1) - delay
+ *
+ * The slave steps its PHY clock onto the master once, then slews it with a PI
+ * servo on the PHY rate register. Every module gets the disciplined time from
+ * u64PTP__Get_PodTime_ns() which extrapolates the PHY clock off the local
+ * tick counter so it can be had from an ISR without going near MDIO.
+ *
+ * The MAC's are not unique across our boards so the port number in the port
+ * identity is taken from the bottom of the IP.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM674R0.FILE.000
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PTP
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PTP__CORE
+ * @ingroup PTP
+ * @{ */
+
+#include "ptp.h"
+#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+
+#include <math.h>
+
+//the structure
+struct _strPTP sPTP;
+
+//locals
+static void vPTP__Collect_TxStamp(void);
+static void vPTP__Send_Event(Luint8 u8Type);
+static void vPTP__Send_FollowUp(Luint16 u16Sequence, Luint64 u64T1);
+static void vPTP__Send_DelayResp(const Luint8 *pu8Request, Luint64 u64T4);
+static Lint16 s16PTP__Transmit(Luint16 u16Length, Luint16 u16Port);
+static void vPTP__Build_Header(Luint8 u8Type, Luint16 u16Length, Luint16 u16Sequence, Luint8 u8Control, Luint8 u8Log, Luint64 u64Time_ns);
+static Lint16 s16PTP__Match_RxStamp(Luint16 u16Sequence, Luint8 u8Type, Luint64 *pu64Time_ns);
+static void vPTP__Servo(Lint64 s64MasterToSlave_ns);
+static void vPTP__Step(Lint64 s64Step_ns);
+static void vPTP__Sample_PodTime(void);
+static Luint64 u64PTP__Read_Time(const Luint8 *pu8Buffer);
+static Lint64 s64PTP__Read_Correction(const Luint8 *pu8Buffer);
+
+
+/***************************************************************************//**
+ * @brief
+ * Init the PTP layer and the PHY clock
+ *
+ * @param[in]		*pu8IP				Our IP
+ * @param[in]		*pu8MAC				Our MAC
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.001
+ */
+void vPTP__Init(const Luint8 * pu8MAC, const Luint8 * pu8IP)
+{
+	Luint32 u32Interval;
+
+	sPTP.u8Master = C_LOCALDEF__LCCM674__MASTER;
+
+	//EUI-64 from the MAC, then the port number
+	sPTP.u8PortIdentity[0] = pu8MAC[0];
+	sPTP.u8PortIdentity[1] = pu8MAC[1];
+	sPTP.u8PortIdentity[2] = pu8MAC[2];
+	sPTP.u8PortIdentity[3] = 0xFFU;
+	sPTP.u8PortIdentity[4] = 0xFEU;
+	sPTP.u8PortIdentity[5] = pu8MAC[3];
+	sPTP.u8PortIdentity[6] = pu8MAC[4];
+	sPTP.u8PortIdentity[7] = pu8MAC[5];
+	sPTP.u8PortIdentity[8] = pu8IP[2];
+	sPTP.u8PortIdentity[9] = pu8IP[3];
+
+	sPTP.u64Interval_Ticks = ((Luint64)C_LOCALDEF__LCCM674__LOCAL_TICKS_PER_SEC * (Luint64)C_LOCALDEF__LCCM674__SYNC_INTERVAL_MS) / 1000U;
+	sPTP.f32PerInterval_ppb = 1000.0F / (Lfloat32)C_LOCALDEF__LCCM674__SYNC_INTERVAL_MS;
+
+	//log2 of the interval, 125ms = -3
+	sPTP.s8LogInterval = 0;
+	u32Interval = C_LOCALDEF__LCCM674__SYNC_INTERVAL_MS;
+	while(u32Interval < 1000U)
+	{
+		u32Interval <<= 1U;
+		sPTP.s8LogInterval--;
+	}
+
+	sPTP.u16SyncSequence = 0U;
+	sPTP.u16DelayReqSequence = 0U;
+	sPTP.u8TxStampPending = 0U;
+	sPTP.u8TxStampWait = 0U;
+	sPTP.sMaster.u64T1 = 0U;
+
+	sPTP.sSlave.u16SyncSequence = 0U;
+	sPTP.sSlave.u8HaveT2 = 0U;
+	sPTP.sSlave.u64T2 = 0U;
+	sPTP.sSlave.s64MasterToSlave_ns = 0;
+	sPTP.sSlave.u8HaveMasterToSlave = 0U;
+	sPTP.sSlave.u16DelayReqSequence = 0U;
+	sPTP.sSlave.u8HaveT3 = 0U;
+	sPTP.sSlave.u64T3 = 0U;
+	sPTP.sSlave.s64MeanPathDelay_ns = 0;
+	sPTP.sSlave.u8HavePathDelay = 0U;
+	sPTP.sSlave.eState = PTP_STATE__UNLOCKED;
+	sPTP.sSlave.u8LockCount = 0U;
+	sPTP.sSlave.f32Integral_ppb = 0.0F;
+	sPTP.sSlave.s32Rate_ppb = 0;
+
+	sPTP.sStats.u32Syncs = 0U;
+	sPTP.sStats.u32DelayResps = 0U;
+	sPTP.sStats.u32Steps = 0U;
+	sPTP.sStats.u32MissedStamps = 0U;
+	sPTP.sStats.u32TxDropped = 0U;
+	sPTP.sStats.s64Offset_ns = 0;
+	sPTP.sStats.f32MeanSquare = 0.0F;
+
+	M_LOCALDEF__LCCM674__PHY_INIT();
+
+	//nominal rate until we have measured it
+	sPTP.sPodTime.u64NsPerTick_Q32 = (1000000000ULL << 32U) / (Luint64)C_LOCALDEF__LCCM674__LOCAL_TICKS_PER_SEC;
+	sPTP.sPodTime.u8Valid = 0U;
+	vPTP__Sample_PodTime();
+
+	sPTP.u64LastTx_Ticks = M_LOCALDEF__LCCM674__LOCAL_TICKS();
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Process, call from the main loop after the ethernet process
+ *
+ * @note
+ * Picks up Tx stamps, and each interval the master sends a Sync and a slave
+ * that has heard a master sends a Delay_Req. The pod time base is refreshed
+ * on the same interval.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.002
+ */
+void vPTP__Process(void)
+{
+	Luint64 u64Now;
+
+	if(sPTP.u8TxStampPending == 1U)
+	{
+		vPTP__Collect_TxStamp();
+	}
+	else
+	{
+		u64Now = M_LOCALDEF__LCCM674__LOCAL_TICKS();
+		if((u64Now - sPTP.u64LastTx_Ticks) >= sPTP.u64Interval_Ticks)
+		{
+			sPTP.u64LastTx_Ticks = u64Now;
+
+			if(sPTP.u8Master == 1U)
+			{
+				vPTP__Send_Event(C_PTP__MSG_SYNC);
+			}
+			else
+			{
+				if(sPTP.sSlave.u8HaveMasterToSlave == 1U)
+				{
+					vPTP__Send_Event(C_PTP__MSG_DELAY_REQ);
+				}
+				else
+				{
+					//no master yet
+				}
+			}
+
+			vPTP__Sample_PodTime();
+		}
+		else
+		{
+			//not yet
+		}
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * PTP message in, from the UDP Rx callback on port 319 or 320
+ *
+ * @param[in]		u16Port				UDP dest port
+ * @param[in]		u16Length			Payload length
+ * @param[in]		*pu8Payload			UDP payload
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.003
+ */
+void vPTP__Input(const Luint8 * pu8Payload, Luint16 u16Length, Luint16 u16Port)
+{
+	Luint8 u8Type;
+	Luint8 u8Counter;
+	Luint8 u8Ours;
+	Luint16 u16Sequence;
+	Luint64 u64Time;
+	Lint64 s64Delay;
+	Lint16 s16Return;
+
+	if((u16Length < C_PTP__SYNC_LENGTH) || ((pu8Payload[1] & 0x0FU) != 2U))
+	{
+		//runt or not v2
+	}
+	else
+	{
+		u8Type = pu8Payload[0] & 0x0FU;
+		u16Sequence = ((Luint16)pu8Payload[30] << 8U) | (Luint16)pu8Payload[31];
+
+		if(sPTP.u8Master == 1U)
+		{
+			if((u8Type == C_PTP__MSG_DELAY_REQ) && (u16Port == C_PTP__PORT_EVENT))
+			{
+				s16Return = s16PTP__Match_RxStamp(u16Sequence, u8Type, &u64Time);
+				if(s16Return >= 0)
+				{
+					vPTP__Send_DelayResp(pu8Payload, u64Time);
+				}
+				else
+				{
+					sPTP.sStats.u32MissedStamps++;
+				}
+			}
+			else
+			{
+				//slaves don't send anything else we need
+			}
+		}
+		else
+		{
+			switch(u8Type)
+			{
+				case C_PTP__MSG_SYNC:
+					//t2
+					s16Return = s16PTP__Match_RxStamp(u16Sequence, u8Type, &u64Time);
+					if(s16Return >= 0)
+					{
+						sPTP.sSlave.u16SyncSequence = u16Sequence;
+						sPTP.sSlave.u64T2 = u64Time;
+						sPTP.sSlave.u8HaveT2 = 1U;
+					}
+					else
+					{
+						sPTP.sSlave.u8HaveT2 = 0U;
+						sPTP.sStats.u32MissedStamps++;
+					}
+					break;
+
+				case C_PTP__MSG_FOLLOW_UP:
+					//t1
+					if((sPTP.sSlave.u8HaveT2 == 1U) && (u16Sequence == sPTP.sSlave.u16SyncSequence))
+					{
+						sPTP.sSlave.u8HaveT2 = 0U;
+						u64Time = u64PTP__Read_Time(&pu8Payload[34]);
+						u64Time += (Luint64)s64PTP__Read_Correction(pu8Payload);
+						sPTP.sStats.u32Syncs++;
+						vPTP__Servo((Lint64)(sPTP.sSlave.u64T2 - u64Time));
+					}
+					else
+					{
+						//lost the Sync
+					}
+					break;
+
+				case C_PTP__MSG_DELAY_RESP:
+					//the answer can beat Process to our t3
+					if(sPTP.u8TxStampPending == 1U)
+					{
+						vPTP__Collect_TxStamp();
+					}
+					else
+					{
+						//fall on
+					}
+
+					//t4, if it is the answer to ours
+					u8Ours = 1U;
+					if(u16Length < C_PTP__DELAY_RESP_LENGTH)
+					{
+						u8Ours = 0U;
+					}
+					else
+					{
+						for(u8Counter = 0U; u8Counter < 10U; u8Counter++)
+						{
+							if(pu8Payload[44U + u8Counter] != sPTP.u8PortIdentity[u8Counter])
+							{
+								u8Ours = 0U;
+							}
+							else
+							{
+								//fall on
+							}
+						}
+					}
+
+					if((u8Ours == 1U) && (sPTP.sSlave.u8HaveT3 == 1U) && (u16Sequence == sPTP.sSlave.u16DelayReqSequence) && (sPTP.sSlave.u8HaveMasterToSlave == 1U))
+					{
+						sPTP.sSlave.u8HaveT3 = 0U;
+						u64Time = u64PTP__Read_Time(&pu8Payload[34]);
+						u64Time -= (Luint64)s64PTP__Read_Correction(pu8Payload);
+
+						//((t2 - t1) + (t4 - t3)) / 2, then a light filter
+						s64Delay = (sPTP.sSlave.s64MasterToSlave_ns + (Lint64)(u64Time - sPTP.sSlave.u64T3)) / 2;
+						if(sPTP.sSlave.u8HavePathDelay == 0U)
+						{
+							sPTP.sSlave.s64MeanPathDelay_ns = s64Delay;
+							sPTP.sSlave.u8HavePathDelay = 1U;
+						}
+						else
+						{
+							sPTP.sSlave.s64MeanPathDelay_ns += (s64Delay - sPTP.sSlave.s64MeanPathDelay_ns) / 8;
+						}
+						sPTP.sStats.u32DelayResps++;
+					}
+					else
+					{
+						//someone else's, or stale
+					}
+					break;
+
+				default:
+					//Delay_Req's from other slaves, announce, etc
+					break;
+
+			}//switch(u8Type)
+		}
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Disciplined pod time
+ *
+ * @note
+ * Extrapolated from the last PHY clock sample on the local ticks, safe to call
+ * from an ISR. On the master it is the grandmaster clock.
+ *
+ * @return			Pod time, ns
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.004
+ */
+Luint64 u64PTP__Get_PodTime_ns(void)
+{
+	Luint64 u64Ticks;
+	Luint64 u64Return;
+
+	u64Ticks = M_LOCALDEF__LCCM674__LOCAL_TICKS() - sPTP.sPodTime.u64Local_Ticks;
+
+	//split the Q32 multiply so it can't wrap
+	u64Return = u64Ticks * (sPTP.sPodTime.u64NsPerTick_Q32 >> 32U);
+	u64Return += (u64Ticks * (sPTP.sPodTime.u64NsPerTick_Q32 & 0xFFFFFFFFULL)) >> 32U;
+	u64Return += sPTP.sPodTime.u64Phy_ns;
+
+	return u64Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Is the slave locked to the master, always 1 on the master
+ *
+ * @return			1 = locked
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.005
+ */
+Luint8 u8PTP__Is_Locked(void)
+{
+	Luint8 u8Return;
+
+	if((sPTP.u8Master == 1U) || (sPTP.sSlave.eState == PTP_STATE__LOCKED))
+	{
+		u8Return = 1U;
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Last offset from the master
+ *
+ * @return			Offset, ns, + = we are ahead
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.006
+ */
+Lint64 s64PTP__Get_Offset_ns(void)
+{
+	return sPTP.sStats.s64Offset_ns;
+}
+
+/***************************************************************************//**
+ * @brief
+ * RMS offset while locked
+ *
+ * @return			Jitter, ns RMS
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.007
+ */
+Lfloat32 f32PTP__Get_Jitter_ns(void)
+{
+	return sqrtf(sPTP.sStats.f32MeanSquare);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Filtered one way path delay to the master
+ *
+ * @return			Delay, ns
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.008
+ */
+Lint64 s64PTP__Get_PathDelay_ns(void)
+{
+	return sPTP.sSlave.s64MeanPathDelay_ns;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Pick up the Tx stamp of the Sync or Delay_Req we sent
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.009
+ */
+static void vPTP__Collect_TxStamp(void)
+{
+	Lint16 s16Return;
+	Luint64 u64Time;
+
+	s16Return = M_LOCALDEF__LCCM674__PHY_TX_STAMP(&u64Time);
+	if(s16Return >= 0)
+	{
+		sPTP.u8TxStampPending = 0U;
+		if(sPTP.u8Master == 1U)
+		{
+			sPTP.sMaster.u64T1 = u64Time;
+			vPTP__Send_FollowUp((Luint16)(sPTP.u16SyncSequence - 1U), u64Time);
+		}
+		else
+		{
+			sPTP.sSlave.u64T3 = u64Time;
+			sPTP.sSlave.u8HaveT3 = 1U;
+		}
+	}
+	else
+	{
+		sPTP.u8TxStampWait++;
+		if(sPTP.u8TxStampWait >= C_PTP__TX_STAMP_TIMEOUT)
+		{
+			//never went, or the PHY lost it
+			sPTP.u8TxStampPending = 0U;
+			sPTP.sStats.u32MissedStamps++;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Send a Sync or Delay_Req and wait on its Tx stamp
+ *
+ * @param[in]		u8Type				C_PTP__MSG_SYNC or C_PTP__MSG_DELAY_REQ
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.010
+ */
+static void vPTP__Send_Event(Luint8 u8Type)
+{
+	Lint16 s16Return;
+
+	if(u8Type == C_PTP__MSG_SYNC)
+	{
+		vPTP__Build_Header(u8Type, C_PTP__SYNC_LENGTH, sPTP.u16SyncSequence, 0x00U, (Luint8)sPTP.s8LogInterval, 0U);
+
+		//two step
+		sPTP.u8TxBuffer[6] = 0x02U;
+		sPTP.u16SyncSequence++;
+	}
+	else
+	{
+		vPTP__Build_Header(u8Type, C_PTP__SYNC_LENGTH, sPTP.u16DelayReqSequence, 0x01U, 0x7FU, 0U);
+		sPTP.sSlave.u16DelayReqSequence = sPTP.u16DelayReqSequence;
+		sPTP.sSlave.u8HaveT3 = 0U;
+		sPTP.u16DelayReqSequence++;
+	}
+
+	s16Return = s16PTP__Transmit(C_PTP__SYNC_LENGTH, C_PTP__PORT_EVENT);
+	if(s16Return >= 0)
+	{
+		sPTP.u8TxStampPending = 1U;
+		sPTP.u8TxStampWait = 0U;
+	}
+	else
+	{
+		//try next interval
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Send the Follow_Up for a Sync
+ *
+ * @param[in]		u64T1				Tx stamp of the Sync
+ * @param[in]		u16Sequence			Sequence of the Sync
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.011
+ */
+static void vPTP__Send_FollowUp(Luint16 u16Sequence, Luint64 u64T1)
+{
+	vPTP__Build_Header(C_PTP__MSG_FOLLOW_UP, C_PTP__SYNC_LENGTH, u16Sequence, 0x02U, (Luint8)sPTP.s8LogInterval, u64T1);
+	(void)s16PTP__Transmit(C_PTP__SYNC_LENGTH, C_PTP__PORT_GENERAL);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Answer a Delay_Req
+ *
+ * @param[in]		u64T4				Rx stamp of the Delay_Req
+ * @param[in]		*pu8Request			The Delay_Req
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.012
+ */
+static void vPTP__Send_DelayResp(const Luint8 *pu8Request, Luint64 u64T4)
+{
+	Luint8 u8Counter;
+	Luint16 u16Sequence;
+
+	u16Sequence = ((Luint16)pu8Request[30] << 8U) | (Luint16)pu8Request[31];
+	vPTP__Build_Header(C_PTP__MSG_DELAY_RESP, C_PTP__DELAY_RESP_LENGTH, u16Sequence, 0x03U, (Luint8)sPTP.s8LogInterval, u64T4);
+
+	//requesting port identity
+	for(u8Counter = 0U; u8Counter < 10U; u8Counter++)
+	{
+		sPTP.u8TxBuffer[44U + u8Counter] = pu8Request[20U + u8Counter];
+	}
+
+	(void)s16PTP__Transmit(C_PTP__DELAY_RESP_LENGTH, C_PTP__PORT_GENERAL);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Send the message in the Tx buffer
+ *
+ * @param[in]		u16Port				319 or 320
+ * @param[in]		u16Length			Message length
+ * @return			-1 = no Tx buffer
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.013
+ */
+static Lint16 s16PTP__Transmit(Luint16 u16Length, Luint16 u16Port)
+{
+	Lint16 s16Return;
+#if C_LOCALDEF__LCCM674__ENABLE_LOOPBACK == 0U
+	Luint8 *pu8Buffer;
+	Luint16 u16Counter;
+
+	//one sync interval, the stamps come from the PHY so queueing costs nothing in accuracy
+	s16Return = M_LOCALDEF__LCCM674__TX_ALLOC(u16Length, C_LOCALDEF__LCCM674__SYNC_INTERVAL_MS * 1000U);
+	if(s16Return >= 0)
+	{
+		pu8Buffer = M_LOCALDEF__LCCM674__TX_BUFFER(s16Return);
+		for(u16Counter = 0U; u16Counter < u16Length; u16Counter++)
+		{
+			pu8Buffer[u16Counter] = sPTP.u8TxBuffer[u16Counter];
+		}
+		M_LOCALDEF__LCCM674__TX_SEND(u16Length, u16Port);
+	}
+	else
+	{
+		sPTP.sStats.u32TxDropped++;
+	}
+#else
+	vPTP_LOOPBACK__Transmit(&sPTP.u8TxBuffer[0], u16Length, u16Port);
+	s16Return = 0;
+#endif
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Put the common header and the 10 byte timestamp in the Tx buffer
+ *
+ * @param[in]		u64Time_ns			Timestamp field
+ * @param[in]		u8Log				logMessageInterval
+ * @param[in]		u8Control			controlField
+ * @param[in]		u16Sequence			sequenceId
+ * @param[in]		u16Length			messageLength
+ * @param[in]		u8Type				messageType
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.014
+ */
+static void vPTP__Build_Header(Luint8 u8Type, Luint16 u16Length, Luint16 u16Sequence, Luint8 u8Control, Luint8 u8Log, Luint64 u64Time_ns)
+{
+	Luint8 u8Counter;
+	Luint64 u64Seconds;
+	Luint32 u32Nanoseconds;
+
+	for(u8Counter = 0U; u8Counter < C_PTP__DELAY_RESP_LENGTH; u8Counter++)
+	{
+		sPTP.u8TxBuffer[u8Counter] = 0U;
+	}
+
+	sPTP.u8TxBuffer[0] = u8Type;
+	sPTP.u8TxBuffer[1] = 2U;
+	sPTP.u8TxBuffer[2] = (Luint8)(u16Length >> 8U);
+	sPTP.u8TxBuffer[3] = (Luint8)u16Length;
+
+	//domain 0, no flags, correction 0
+
+	for(u8Counter = 0U; u8Counter < 10U; u8Counter++)
+	{
+		sPTP.u8TxBuffer[20U + u8Counter] = sPTP.u8PortIdentity[u8Counter];
+	}
+	sPTP.u8TxBuffer[30] = (Luint8)(u16Sequence >> 8U);
+	sPTP.u8TxBuffer[31] = (Luint8)u16Sequence;
+	sPTP.u8TxBuffer[32] = u8Control;
+	sPTP.u8TxBuffer[33] = u8Log;
+
+	//48 bit seconds, 32 bit ns
+	u64Seconds = u64Time_ns / 1000000000ULL;
+	u32Nanoseconds = (Luint32)(u64Time_ns % 1000000000ULL);
+	for(u8Counter = 0U; u8Counter < 6U; u8Counter++)
+	{
+		sPTP.u8TxBuffer[39U - u8Counter] = (Luint8)(u64Seconds >> (8U * u8Counter));
+	}
+	for(u8Counter = 0U; u8Counter < 4U; u8Counter++)
+	{
+		sPTP.u8TxBuffer[43U - u8Counter] = (Luint8)(u32Nanoseconds >> (8U * u8Counter));
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Find the Rx stamp for an event message
+ *
+ * @note
+ * The PHY queues the stamps of every event message it sees, stamps ahead of
+ * ours belong to frames we are not interested in and are dropped.
+ *
+ * @param[out]		*pu64Time_ns		Rx stamp
+ * @param[in]		u8Type				messageType
+ * @param[in]		u16Sequence			sequenceId
+ * @return			0 = found\n
+ *					-1 = not there
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.015
+ */
+static Lint16 s16PTP__Match_RxStamp(Luint16 u16Sequence, Luint8 u8Type, Luint64 *pu64Time_ns)
+{
+	Lint16 s16Return;
+	Lint16 s16Read;
+	Luint8 u8Counter;
+	Luint16 u16StampSequence;
+	Luint8 u8StampType;
+
+	s16Return = -1;
+	s16Read = 0;
+
+	//the DP83640 holds 4
+	for(u8Counter = 0U; (u8Counter < 4U) && (s16Return < 0) && (s16Read >= 0); u8Counter++)
+	{
+		s16Read = M_LOCALDEF__LCCM674__PHY_RX_STAMP(pu64Time_ns, &u16StampSequence, &u8StampType);
+		if((s16Read >= 0) && (u16StampSequence == u16Sequence) && (u8StampType == u8Type))
+		{
+			s16Return = 0;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Slave servo, run on each Sync/Follow_Up pair
+ *
+ * @note
+ * Far out, step. Otherwise PI onto the PHY rate register, the gains are per
+ * interval so f32PerInterval_ppb turns an offset into the rate that would take
+ * it out in one interval.
+ *
+ * @param[in]		s64MasterToSlave_ns		t2 - t1
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.016
+ */
+static void vPTP__Servo(Lint64 s64MasterToSlave_ns)
+{
+	Lint64 s64Offset;
+	Lfloat32 f32Offset;
+	Lfloat32 f32Rate;
+
+	sPTP.sSlave.s64MasterToSlave_ns = s64MasterToSlave_ns;
+	sPTP.sSlave.u8HaveMasterToSlave = 1U;
+
+	s64Offset = s64MasterToSlave_ns - sPTP.sSlave.s64MeanPathDelay_ns;
+	sPTP.sStats.s64Offset_ns = s64Offset;
+
+	if((s64Offset > C_PTP__STEP_THRESHOLD_NS) || (s64Offset < -C_PTP__STEP_THRESHOLD_NS))
+	{
+		//before the path delay is known this is a coarse step and we come back
+		vPTP__Step(-s64Offset);
+	}
+	else if(sPTP.sSlave.u8HavePathDelay == 1U)
+	{
+		f32Offset = (Lfloat32)s64Offset * sPTP.f32PerInterval_ppb;
+
+		sPTP.sSlave.f32Integral_ppb += C_PTP__SERVO_KI * f32Offset;
+		if(sPTP.sSlave.f32Integral_ppb > (Lfloat32)C_PTP__MAX_RATE_PPB)
+		{
+			sPTP.sSlave.f32Integral_ppb = (Lfloat32)C_PTP__MAX_RATE_PPB;
+		}
+		else if(sPTP.sSlave.f32Integral_ppb < -(Lfloat32)C_PTP__MAX_RATE_PPB)
+		{
+			sPTP.sSlave.f32Integral_ppb = -(Lfloat32)C_PTP__MAX_RATE_PPB;
+		}
+		else
+		{
+			//fall on
+		}
+
+		//ahead means slow down
+		f32Rate = -((C_PTP__SERVO_KP * f32Offset) + sPTP.sSlave.f32Integral_ppb);
+		if(f32Rate > (Lfloat32)C_PTP__MAX_RATE_PPB)
+		{
+			f32Rate = (Lfloat32)C_PTP__MAX_RATE_PPB;
+		}
+		else if(f32Rate < -(Lfloat32)C_PTP__MAX_RATE_PPB)
+		{
+			f32Rate = -(Lfloat32)C_PTP__MAX_RATE_PPB;
+		}
+		else
+		{
+			//fall on
+		}
+		sPTP.sSlave.s32Rate_ppb = (Lint32)f32Rate;
+		M_LOCALDEF__LCCM674__PHY_SET_RATE(sPTP.sSlave.s32Rate_ppb);
+
+		if((s64Offset < C_PTP__LOCK_THRESHOLD_NS) && (s64Offset > -C_PTP__LOCK_THRESHOLD_NS))
+		{
+			if(sPTP.sSlave.u8LockCount < C_PTP__LOCK_COUNT)
+			{
+				sPTP.sSlave.u8LockCount++;
+				sPTP.sSlave.eState = PTP_STATE__TRACKING;
+			}
+			else
+			{
+				if(sPTP.sSlave.eState != PTP_STATE__LOCKED)
+				{
+					//start the jitter from here
+					sPTP.sStats.f32MeanSquare = (Lfloat32)s64Offset * (Lfloat32)s64Offset;
+				}
+				else
+				{
+					sPTP.sStats.f32MeanSquare += (((Lfloat32)s64Offset * (Lfloat32)s64Offset) - sPTP.sStats.f32MeanSquare) / 16.0F;
+				}
+				sPTP.sSlave.eState = PTP_STATE__LOCKED;
+			}
+		}
+		else
+		{
+			sPTP.sSlave.u8LockCount = 0U;
+			sPTP.sSlave.eState = PTP_STATE__TRACKING;
+		}
+	}
+	else
+	{
+		//close enough, wait for the path delay
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Step the PHY clock, anything measured across the step is no good
+ *
+ * @param[in]		s64Step_ns			Amount to add
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.017
+ */
+static void vPTP__Step(Lint64 s64Step_ns)
+{
+	M_LOCALDEF__LCCM674__PHY_STEP(s64Step_ns);
+
+	sPTP.sSlave.u8HaveMasterToSlave = 0U;
+	sPTP.sSlave.u8HaveT2 = 0U;
+	sPTP.sSlave.u8HaveT3 = 0U;
+	sPTP.sSlave.u8LockCount = 0U;
+	sPTP.sSlave.eState = PTP_STATE__TRACKING;
+	sPTP.sStats.u32Steps++;
+
+	//new base, keep the rate we had
+	sPTP.sPodTime.u8Valid = 0U;
+	vPTP__Sample_PodTime();
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * New PHY clock / local tick pair for the pod time
+ *
+ * @note
+ * The local ticks either side of the PHY read are averaged to take out the
+ * MDIO time. Consecutive pairs give the ns per tick, lightly filtered.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.018
+ */
+static void vPTP__Sample_PodTime(void)
+{
+	Luint64 u64Before;
+	Luint64 u64Phy;
+	Luint64 u64After;
+	Luint64 u64Ticks;
+	Luint64 u64Delta_ns;
+	Luint64 u64Rate;
+
+	u64Before = M_LOCALDEF__LCCM674__LOCAL_TICKS();
+	u64Phy = M_LOCALDEF__LCCM674__PHY_GET_TIME();
+	u64After = M_LOCALDEF__LCCM674__LOCAL_TICKS();
+	u64Ticks = u64Before + ((u64After - u64Before) / 2U);
+
+	if((sPTP.sPodTime.u8Valid == 1U) && (u64Ticks > sPTP.sPodTime.u64Local_Ticks) && (u64Phy > sPTP.sPodTime.u64Phy_ns))
+	{
+		u64Delta_ns = u64Phy - sPTP.sPodTime.u64Phy_ns;
+		if(u64Delta_ns < 0x100000000ULL)
+		{
+			u64Rate = (u64Delta_ns << 32U) / (u64Ticks - sPTP.sPodTime.u64Local_Ticks);
+			sPTP.sPodTime.u64NsPerTick_Q32 = (Luint64)((Lint64)sPTP.sPodTime.u64NsPerTick_Q32 + (((Lint64)u64Rate - (Lint64)sPTP.sPodTime.u64NsPerTick_Q32) / 8));
+		}
+		else
+		{
+			//too long between samples
+		}
+	}
+	else
+	{
+		//first one
+	}
+
+	sPTP.sPodTime.u64Phy_ns = u64Phy;
+	sPTP.sPodTime.u64Local_Ticks = u64Ticks;
+	sPTP.sPodTime.u8Valid = 1U;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * 48 bit seconds and 32 bit ns to ns
+ *
+ * @param[in]		*pu8Buffer			Start of the 10 byte timestamp
+ * @return			ns
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.019
+ */
+static Luint64 u64PTP__Read_Time(const Luint8 *pu8Buffer)
+{
+	Luint8 u8Counter;
+	Luint64 u64Seconds;
+	Luint32 u32Nanoseconds;
+
+	u64Seconds = 0U;
+	for(u8Counter = 0U; u8Counter < 6U; u8Counter++)
+	{
+		u64Seconds = (u64Seconds << 8U) | (Luint64)pu8Buffer[u8Counter];
+	}
+	u32Nanoseconds = 0U;
+	for(u8Counter = 6U; u8Counter < 10U; u8Counter++)
+	{
+		u32Nanoseconds = (u32Nanoseconds << 8U) | (Luint32)pu8Buffer[u8Counter];
+	}
+
+	return (u64Seconds * 1000000000ULL) + (Luint64)u32Nanoseconds;
+}
+
+/***************************************************************************//**
+ * @brief
+ * correctionField in whole ns
+ *
+ * @param[in]		*pu8Buffer			Start of the message
+ * @return			ns
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.000.FUNC.020
+ */
+static Lint64 s64PTP__Read_Correction(const Luint8 *pu8Buffer)
+{
+	Luint8 u8Counter;
+	Luint64 u64Value;
+
+	u64Value = 0U;
+	for(u8Counter = 8U; u8Counter < 16U; u8Counter++)
+	{
+		u64Value = (u64Value << 8U) | (Luint64)pu8Buffer[u8Counter];
+	}
+
+	//ns * 2^16
+	return (Lint64)u64Value / 65536;
+}
+
+
+#endif //#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
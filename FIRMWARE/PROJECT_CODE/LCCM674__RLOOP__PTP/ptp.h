@@ -0,0 +1,280 @@
+/**
+ * @file		PTP.H
+ * @brief		Main header for IEEE1588 pod time
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ */
+
+
+#ifndef _PTP_H_
+#define _PTP_H_
+	#include <localdef.h>
+	#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+
+		/*******************************************************************************
+		Defines
+		*******************************************************************************/
+		/** UDP ports */
+		#define C_PTP__PORT_EVENT									(319U)
+		#define C_PTP__PORT_GENERAL									(320U)
+
+		/** Message types */
+		#define C_PTP__MSG_SYNC										(0x00U)
+		#define C_PTP__MSG_DELAY_REQ								(0x01U)
+		#define C_PTP__MSG_FOLLOW_UP								(0x08U)
+		#define C_PTP__MSG_DELAY_RESP								(0x09U)
+
+		/** Message sizes, header is 34 bytes */
+		#define C_PTP__HEADER_LENGTH								(34U)
+		#define C_PTP__SYNC_LENGTH									(44U)
+		#define C_PTP__DELAY_RESP_LENGTH							(54U)
+
+		/** Offset above this is stepped, below it is slewed */
+		#define C_PTP__STEP_THRESHOLD_NS							(20000)
+
+		/** Offset inside this for C_PTP__LOCK_COUNT syncs in a row is locked */
+		#define C_PTP__LOCK_THRESHOLD_NS							(1000)
+		#define C_PTP__LOCK_COUNT									(8U)
+
+		/** PI servo gains, per sync interval */
+		#define C_PTP__SERVO_KP										(0.7F)
+		#define C_PTP__SERVO_KI										(0.3F)
+
+		/** Furthest we will trim the PHY clock */
+		#define C_PTP__MAX_RATE_PPB									(500000)
+
+		/** Process calls to wait on a Tx stamp */
+		#define C_PTP__TX_STAMP_TIMEOUT								(10U)
+
+		/** DP83640 IEEE1588 registers, page 4 */
+		#define C_PTP_DP83640__PAGE4__PTP_CTL						(0x14U)
+		#define C_PTP_DP83640__PAGE4__PTP_TDR						(0x15U)
+		#define C_PTP_DP83640__PAGE4__PTP_STS						(0x16U)
+		#define C_PTP_DP83640__PAGE4__PTP_TSTS						(0x17U)
+		#define C_PTP_DP83640__PAGE4__PTP_RATEL						(0x18U)
+		#define C_PTP_DP83640__PAGE4__PTP_RATEH						(0x19U)
+		#define C_PTP_DP83640__PAGE4__PTP_TXTS						(0x1CU)
+		#define C_PTP_DP83640__PAGE4__PTP_RXTS						(0x1DU)
+
+		/** DP83640 IEEE1588 config, page 5 */
+		#define C_PTP_DP83640__PAGE5__PTP_TXCFG0					(0x16U)
+		#define C_PTP_DP83640__PAGE5__PTP_TXCFG1					(0x17U)
+		#define C_PTP_DP83640__PAGE5__PTP_RXCFG0					(0x19U)
+		#define C_PTP_DP83640__PAGE5__PTP_RXCFG1					(0x1AU)
+
+		/** PTP_CTL */
+		#define C_PTP_DP83640__CTL__RESET							(0x0001U)
+		#define C_PTP_DP83640__CTL__DISABLE							(0x0002U)
+		#define C_PTP_DP83640__CTL__ENABLE							(0x0004U)
+		#define C_PTP_DP83640__CTL__STEP_CLK						(0x0008U)
+		#define C_PTP_DP83640__CTL__LOAD_CLK						(0x0010U)
+		#define C_PTP_DP83640__CTL__RD_CLK							(0x0020U)
+
+		/** PTP_STS */
+		#define C_PTP_DP83640__STS__TXTS_RDY						(0x0800U)
+		#define C_PTP_DP83640__STS__RXTS_RDY						(0x0400U)
+
+		/** PTP_RATEH, rate is in 2^-32 ns per 8ns clock */
+		#define C_PTP_DP83640__RATEH__DIR							(0x8000U)
+		#define C_PTP_DP83640__RATEH__MASK							(0x03FFU)
+
+		/** PTP_TXCFG0 / PTP_RXCFG0, version 2 event messages over UDP/IPv4 */
+		#define C_PTP_DP83640__CFG0__TS_EN							(0x0001U)
+		#define C_PTP_DP83640__CFG0__PTP_V2							(0x0004U)
+		#define C_PTP_DP83640__CFG0__IPV4_EN						(0x0020U)
+
+
+		/*******************************************************************************
+		Structures
+		*******************************************************************************/
+		typedef enum
+		{
+			/** No offset yet */
+			PTP_STATE__UNLOCKED = 0U,
+
+			/** Stepped onto the master, slewing in */
+			PTP_STATE__TRACKING,
+
+			/** Inside the lock threshold */
+			PTP_STATE__LOCKED
+
+		}E_PTP__STATE_T;
+
+		struct _strPTP
+		{
+			/** Our port identity, EUI-64 of the MAC then a port number */
+			Luint8 u8PortIdentity[10];
+
+			/** Master or slave */
+			Luint8 u8Master;
+
+			/** Local ticks between Sync's (master) or Delay_Req's (slave) */
+			Luint64 u64Interval_Ticks;
+			Luint64 u64LastTx_Ticks;
+
+			/** 1e9 / sync interval in ns, servo gain to ppb */
+			Lfloat32 f32PerInterval_ppb;
+
+			/** log2 of the sync interval in seconds, for the headers */
+			Lint8 s8LogInterval;
+
+			/** Message being built */
+			Luint8 u8TxBuffer[C_PTP__DELAY_RESP_LENGTH];
+
+			/** Next sequence ID's out */
+			Luint16 u16SyncSequence;
+			Luint16 u16DelayReqSequence;
+
+			/** Event message sent, waiting on its Tx stamp */
+			Luint8 u8TxStampPending;
+			Luint8 u8TxStampWait;
+
+			/** Master side */
+			struct
+			{
+				/** t1 of the last Sync, goes out in the Follow_Up */
+				Luint64 u64T1;
+
+			}sMaster;
+
+			/** Slave side */
+			struct
+			{
+				/** Sync being measured */
+				Luint16 u16SyncSequence;
+				Luint8 u8HaveT2;
+				Luint64 u64T2;
+
+				/** t2 - t1 of the last complete Sync */
+				Lint64 s64MasterToSlave_ns;
+				Luint8 u8HaveMasterToSlave;
+
+				/** Delay_Req out */
+				Luint16 u16DelayReqSequence;
+				Luint8 u8HaveT3;
+				Luint64 u64T3;
+
+				/** Filtered one way delay */
+				Lint64 s64MeanPathDelay_ns;
+				Luint8 u8HavePathDelay;
+
+				/** Servo */
+				E_PTP__STATE_T eState;
+				Luint8 u8LockCount;
+				Lfloat32 f32Integral_ppb;
+				Lint32 s32Rate_ppb;
+
+			}sSlave;
+
+			/** PHY clock against the local ticks, so pod time can be had without MDIO */
+			struct
+			{
+				Luint64 u64Phy_ns;
+				Luint64 u64Local_Ticks;
+
+				/** ns per local tick, Q32 */
+				Luint64 u64NsPerTick_Q32;
+
+				/** Base taken since the last step */
+				Luint8 u8Valid;
+
+			}sPodTime;
+
+			/** Stats */
+			struct
+			{
+				Luint32 u32Syncs;
+				Luint32 u32DelayResps;
+				Luint32 u32Steps;
+				Luint32 u32MissedStamps;
+				Luint32 u32TxDropped;
+
+				/** Last offset from master */
+				Lint64 s64Offset_ns;
+
+				/** Mean square offset once locked, ns^2 */
+				Lfloat32 f32MeanSquare;
+
+			}sStats;
+
+		};
+
+
+		/*******************************************************************************
+		Function Prototypes
+		*******************************************************************************/
+		void vPTP__Init(const Luint8 * pu8MAC, const Luint8 * pu8IP);
+		void vPTP__Process(void);
+		void vPTP__Input(const Luint8 * pu8Payload, Luint16 u16Length, Luint16 u16Port);
+		Luint64 u64PTP__Get_PodTime_ns(void);
+		Luint8 u8PTP__Is_Locked(void);
+		Lint64 s64PTP__Get_Offset_ns(void);
+		Lfloat32 f32PTP__Get_Jitter_ns(void);
+		Lint64 s64PTP__Get_PathDelay_ns(void);
+
+		#if C_LOCALDEF__LCCM674__ENABLE_LOOPBACK == 0U
+			//DP83640 clock and timestamp units
+			void vPTP_DP83640__Init(Luint32 u32PhyIndex);
+			Luint64 u64PTP_DP83640__Get_Time(Luint32 u32PhyIndex);
+			void vPTP_DP83640__Set_Time(Luint32 u32PhyIndex, Luint64 u64Time_ns);
+			void vPTP_DP83640__Step(Luint32 u32PhyIndex, Lint64 s64Step_ns);
+			void vPTP_DP83640__Set_Rate(Luint32 u32PhyIndex, Lint32 s32Rate_ppb);
+			Lint16 s16PTP_DP83640__Get_TxTimestamp(Luint32 u32PhyIndex, Luint64 *pu64Time_ns);
+			Lint16 s16PTP_DP83640__Get_RxTimestamp(Luint32 u32PhyIndex, Luint64 *pu64Time_ns, Luint16 *pu16SequenceID, Luint8 *pu8MessageType);
+		#else
+			//software PHY and grandmaster
+			void vPTP_LOOPBACK__Init(Lint64 s64PhyOffset_ns, Lint32 s32PhyDrift_ppb, Lint32 s32TickDrift_ppb, Luint32 u32PathDelay_ns, Luint32 u32Jitter_ns);
+			void vPTP_LOOPBACK__Advance(Luint32 u32Time_ns);
+			void vPTP_LOOPBACK__Transmit(const Luint8 * pu8Payload, Luint16 u16Length, Luint16 u16Port);
+			Lint64 s64PTP_LOOPBACK__Get_TrueOffset_ns(void);
+			Luint64 u64PTP_LOOPBACK__Get_TrueTime_ns(void);
+			Luint64 u64PTP_LOOPBACK__Get_Time(void);
+			void vPTP_LOOPBACK__Step(Lint64 s64Step_ns);
+			void vPTP_LOOPBACK__Set_Rate(Lint32 s32Rate_ppb);
+			Lint16 s16PTP_LOOPBACK__Get_TxTimestamp(Luint64 *pu64Time_ns);
+			Lint16 s16PTP_LOOPBACK__Get_RxTimestamp(Luint64 *pu64Time_ns, Luint16 *pu16SequenceID, Luint8 *pu8MessageType);
+			Luint64 u64PTP_LOOPBACK__Get_LocalTicks(void);
+		#endif
+
+		//testing
+		#if C_LOCALDEF__LCCM674__ENABLE_TEST_SPEC == 1U
+			#if C_LOCALDEF__LCCM674__ENABLE_LOOPBACK == 1U
+				DLL_DECLARATION void vLCCM674R0_TS_000(void);
+			#endif
+		#endif
+
+		//safetys
+		#ifndef C_LOCALDEF__LCCM674__MASTER
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM674__SYNC_INTERVAL_MS
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM674__LOCAL_TICKS_PER_SEC
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM674__ENABLE_LOOPBACK
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM674__SYNC_INTERVAL_MS == 0U
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM674__ENABLE_LOOPBACK == 0U
+			#ifndef M_LOCALDEF__LCCM674__TX_ALLOC
+				#error
+			#endif
+			#ifndef M_LOCALDEF__LCCM674__TX_BUFFER
+				#error
+			#endif
+			#ifndef M_LOCALDEF__LCCM674__TX_SEND
+				#error
+			#endif
+		#endif
+
+	#endif //#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+	//safetys
+	#ifndef C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE
+		#error
+	#endif
+#endif //_PTP_H_
+
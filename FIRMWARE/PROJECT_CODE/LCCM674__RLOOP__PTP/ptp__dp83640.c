@@ -0,0 +1,343 @@
+/**
+ * @file		PTP__DP83640.C
+ * @brief		IEEE1588 clock and packet timestamp units
+ *
+ * @note
+ * The PHY keeps its own 1588 clock off the 25MHz reference, 8ns a tick, with a
+ * fine rate adjust and a one shot step. With TS_EN set it stamps PTP v2 event
+ * messages over UDP/IPv4 as their SFD crosses the pins, so there is no EMAC or
+ * software latency in the stamps. Tx stamps queue in the PHY in send order, Rx
+ * stamps carry the sequence ID and message type so they can be matched later.
+ *
+ * Times here are nanoseconds since the PHY clock's epoch in a Luint64.
+ *
+ * Everything is over MDIO on page 4 and 5 through the LCCM515 page select and
+ * register calls, each call leaves the PHY on page 0.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM674R0.FILE.001
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PTP
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PTP__DP83640
+ * @ingroup PTP
+ * @{ */
+
+#include "ptp.h"
+#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM674__ENABLE_LOOPBACK == 0U
+
+//locals
+static void vPTP_DP83640__Write_Time(Luint32 u32PhyIndex, Luint32 u32Seconds, Luint32 u32Nanoseconds, Luint16 u16Command);
+static Luint64 u64PTP_DP83640__Read_Stamp(Luint32 u32PhyIndex, Luint32 u32Register);
+
+
+/***************************************************************************//**
+ * @brief
+ * Start the 1588 clock from 0 and switch on Tx and Rx timestamping
+ *
+ * @param[in]		u32PhyIndex				PHY address
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.001.FUNC.001
+ */
+void vPTP_DP83640__Init(Luint32 u32PhyIndex)
+{
+	Luint16 u16Config;
+
+	vDP83640__Page_Select(u32PhyIndex, 4U);
+	vDP83640_MDIO__Write_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_CTL, C_PTP_DP83640__CTL__RESET);
+	vDP83640_MDIO__Write_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_CTL, 0U);
+	vDP83640_MDIO__Write_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_RATEH, 0U);
+	vDP83640_MDIO__Write_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_RATEL, 0U);
+	vPTP_DP83640__Write_Time(u32PhyIndex, 0U, 0U, C_PTP_DP83640__CTL__LOAD_CLK);
+
+	//v2 event messages over UDP/IPv4, both ways
+	u16Config = C_PTP_DP83640__CFG0__TS_EN | C_PTP_DP83640__CFG0__PTP_V2 | C_PTP_DP83640__CFG0__IPV4_EN;
+	vDP83640__Page_Select(u32PhyIndex, 5U);
+	vDP83640_MDIO__Write_Register(u32PhyIndex, C_PTP_DP83640__PAGE5__PTP_TXCFG0, u16Config);
+	vDP83640_MDIO__Write_Register(u32PhyIndex, C_PTP_DP83640__PAGE5__PTP_RXCFG0, u16Config);
+
+	vDP83640__Page_Select(u32PhyIndex, 4U);
+	vDP83640_MDIO__Write_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_CTL, C_PTP_DP83640__CTL__ENABLE);
+	vDP83640__Page_Select(u32PhyIndex, 0U);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Read the 1588 clock
+ *
+ * @param[in]		u32PhyIndex				PHY address
+ * @return			Clock, ns
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.001.FUNC.002
+ */
+Luint64 u64PTP_DP83640__Get_Time(Luint32 u32PhyIndex)
+{
+	Luint16 u16Word[4];
+	Luint8 u8Counter;
+	Luint64 u64Return;
+
+	vDP83640__Page_Select(u32PhyIndex, 4U);
+
+	//latch the clock then read ns low, ns high, sec low, sec high
+	vDP83640_MDIO__Write_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_CTL, C_PTP_DP83640__CTL__RD_CLK);
+	for(u8Counter = 0U; u8Counter < 4U; u8Counter++)
+	{
+		u16Word[u8Counter] = 0U;
+		(void)s16DP83640_MDIO__Read_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_TDR, &u16Word[u8Counter]);
+	}
+	vDP83640__Page_Select(u32PhyIndex, 0U);
+
+	u64Return = (((Luint64)u16Word[3] << 16U) | (Luint64)u16Word[2]) * 1000000000ULL;
+	u64Return += ((Luint64)u16Word[1] << 16U) | (Luint64)u16Word[0];
+
+	return u64Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Load the 1588 clock
+ *
+ * @param[in]		u64Time_ns				New time, ns
+ * @param[in]		u32PhyIndex				PHY address
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.001.FUNC.003
+ */
+void vPTP_DP83640__Set_Time(Luint32 u32PhyIndex, Luint64 u64Time_ns)
+{
+	vDP83640__Page_Select(u32PhyIndex, 4U);
+	vPTP_DP83640__Write_Time(u32PhyIndex, (Luint32)(u64Time_ns / 1000000000ULL), (Luint32)(u64Time_ns % 1000000000ULL), C_PTP_DP83640__CTL__LOAD_CLK);
+	vDP83640__Page_Select(u32PhyIndex, 0U);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Step the 1588 clock
+ *
+ * @note
+ * The PHY adds the step in one clock, the ns part must be 0 to 999999999 so
+ * a negative step is whole seconds back and some ns forward.
+ *
+ * @param[in]		s64Step_ns				Amount to add, ns
+ * @param[in]		u32PhyIndex				PHY address
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.001.FUNC.004
+ */
+void vPTP_DP83640__Step(Luint32 u32PhyIndex, Lint64 s64Step_ns)
+{
+	Lint64 s64Seconds;
+	Lint64 s64Nanoseconds;
+
+	s64Seconds = s64Step_ns / 1000000000LL;
+	s64Nanoseconds = s64Step_ns - (s64Seconds * 1000000000LL);
+	if(s64Nanoseconds < 0)
+	{
+		s64Seconds -= 1;
+		s64Nanoseconds += 1000000000LL;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vDP83640__Page_Select(u32PhyIndex, 4U);
+	vPTP_DP83640__Write_Time(u32PhyIndex, (Luint32)s64Seconds, (Luint32)s64Nanoseconds, C_PTP_DP83640__CTL__STEP_CLK);
+	vDP83640__Page_Select(u32PhyIndex, 0U);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Trim the 1588 clock rate
+ *
+ * @note
+ * Each 8ns tick has rate * 2^-32 ns added or taken off, so 1ppb is
+ * 8 * 2^32 / 1e9 = 34.36 counts. Stays until changed.
+ *
+ * @param[in]		s32Rate_ppb				Rate, + = faster
+ * @param[in]		u32PhyIndex				PHY address
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.001.FUNC.005
+ */
+void vPTP_DP83640__Set_Rate(Luint32 u32PhyIndex, Lint32 s32Rate_ppb)
+{
+	Luint64 u64Rate;
+	Luint16 u16High;
+
+	if(s32Rate_ppb < 0)
+	{
+		u64Rate = (Luint64)(-(Lint64)s32Rate_ppb);
+	}
+	else
+	{
+		u64Rate = (Luint64)s32Rate_ppb;
+	}
+
+	u64Rate = (u64Rate * 34359738368ULL) / 1000000000ULL;
+	if(u64Rate > 0x03FFFFFFULL)
+	{
+		u64Rate = 0x03FFFFFFULL;
+	}
+	else
+	{
+		//fall on
+	}
+
+	u16High = (Luint16)((u64Rate >> 16U) & C_PTP_DP83640__RATEH__MASK);
+	if(s32Rate_ppb < 0)
+	{
+		u16High |= C_PTP_DP83640__RATEH__DIR;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//high first, the rate takes effect on the low write
+	vDP83640__Page_Select(u32PhyIndex, 4U);
+	vDP83640_MDIO__Write_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_RATEH, u16High);
+	vDP83640_MDIO__Write_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_RATEL, (Luint16)(u64Rate & 0xFFFFU));
+	vDP83640__Page_Select(u32PhyIndex, 0U);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Oldest Tx timestamp, in send order
+ *
+ * @param[out]		*pu64Time_ns			Time the frame left, ns
+ * @param[in]		u32PhyIndex				PHY address
+ * @return			0 = got one\n
+ *					-1 = none waiting
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.001.FUNC.006
+ */
+Lint16 s16PTP_DP83640__Get_TxTimestamp(Luint32 u32PhyIndex, Luint64 *pu64Time_ns)
+{
+	Lint16 s16Return;
+	Luint16 u16Status;
+
+	vDP83640__Page_Select(u32PhyIndex, 4U);
+	u16Status = 0U;
+	(void)s16DP83640_MDIO__Read_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_STS, &u16Status);
+	if((u16Status & C_PTP_DP83640__STS__TXTS_RDY) != 0U)
+	{
+		*pu64Time_ns = u64PTP_DP83640__Read_Stamp(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_TXTS);
+		s16Return = 0;
+	}
+	else
+	{
+		s16Return = -1;
+	}
+	vDP83640__Page_Select(u32PhyIndex, 0U);
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Oldest Rx timestamp
+ *
+ * @param[out]		*pu8MessageType			PTP message type of the frame
+ * @param[out]		*pu16SequenceID			PTP sequence ID of the frame
+ * @param[out]		*pu64Time_ns			Time the frame arrived, ns
+ * @param[in]		u32PhyIndex				PHY address
+ * @return			0 = got one\n
+ *					-1 = none waiting
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.001.FUNC.007
+ */
+Lint16 s16PTP_DP83640__Get_RxTimestamp(Luint32 u32PhyIndex, Luint64 *pu64Time_ns, Luint16 *pu16SequenceID, Luint8 *pu8MessageType)
+{
+	Lint16 s16Return;
+	Luint16 u16Status;
+	Luint16 u16Type;
+
+	vDP83640__Page_Select(u32PhyIndex, 4U);
+	u16Status = 0U;
+	(void)s16DP83640_MDIO__Read_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_STS, &u16Status);
+	if((u16Status & C_PTP_DP83640__STS__RXTS_RDY) != 0U)
+	{
+		*pu64Time_ns = u64PTP_DP83640__Read_Stamp(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_RXTS);
+
+		//then the sequence ID, then message type and source hash
+		*pu16SequenceID = 0U;
+		(void)s16DP83640_MDIO__Read_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_RXTS, pu16SequenceID);
+		u16Type = 0U;
+		(void)s16DP83640_MDIO__Read_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_RXTS, &u16Type);
+		*pu8MessageType = (Luint8)((u16Type >> 12U) & 0x000FU);
+		s16Return = 0;
+	}
+	else
+	{
+		s16Return = -1;
+	}
+	vDP83640__Page_Select(u32PhyIndex, 0U);
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Put a time in the TDR and run a clock command, page 4 must be selected
+ *
+ * @param[in]		u16Command				PTP_CTL command bit
+ * @param[in]		u32Nanoseconds			0 to 999999999
+ * @param[in]		u32Seconds				Seconds
+ * @param[in]		u32PhyIndex				PHY address
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.001.FUNC.008
+ */
+static void vPTP_DP83640__Write_Time(Luint32 u32PhyIndex, Luint32 u32Seconds, Luint32 u32Nanoseconds, Luint16 u16Command)
+{
+	vDP83640_MDIO__Write_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_TDR, (Luint16)(u32Nanoseconds & 0xFFFFU));
+	vDP83640_MDIO__Write_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_TDR, (Luint16)(u32Nanoseconds >> 16U));
+	vDP83640_MDIO__Write_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_TDR, (Luint16)(u32Seconds & 0xFFFFU));
+	vDP83640_MDIO__Write_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_TDR, (Luint16)(u32Seconds >> 16U));
+	vDP83640_MDIO__Write_Register(u32PhyIndex, C_PTP_DP83640__PAGE4__PTP_CTL, u16Command);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Read the 4 time words of a Tx or Rx stamp, page 4 must be selected
+ *
+ * @param[in]		u32Register				PTP_TXTS or PTP_RXTS
+ * @param[in]		u32PhyIndex				PHY address
+ * @return			Stamp, ns
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.001.FUNC.009
+ */
+static Luint64 u64PTP_DP83640__Read_Stamp(Luint32 u32PhyIndex, Luint32 u32Register)
+{
+	Luint16 u16Word[4];
+	Luint8 u8Counter;
+	Luint64 u64Return;
+
+	for(u8Counter = 0U; u8Counter < 4U; u8Counter++)
+	{
+		u16Word[u8Counter] = 0U;
+		(void)s16DP83640_MDIO__Read_Register(u32PhyIndex, u32Register, &u16Word[u8Counter]);
+	}
+
+	//top 2 bits of the ns high word are an overflow count, not time
+	u64Return = (((Luint64)u16Word[3] << 16U) | (Luint64)u16Word[2]) * 1000000000ULL;
+	u64Return += ((Luint64)(u16Word[1] & 0x3FFFU) << 16U) | (Luint64)u16Word[0];
+
+	return u64Return;
+}
+
+
+#endif //#if C_LOCALDEF__LCCM674__ENABLE_LOOPBACK == 0U
+#endif //#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
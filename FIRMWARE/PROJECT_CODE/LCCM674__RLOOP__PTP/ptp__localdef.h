@@ -0,0 +1,51 @@
+/**
+ * @file		PTP__LOCALDEF.H
+ * @brief		Localdef template
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM674R0.FILE.003
+ */
+
+#if 0
+
+/*******************************************************************************
+RLOOP - IEEE1588 POD TIME
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+
+		/** 1 = grandmaster, 0 = slave */
+		#define C_LOCALDEF__LCCM674__MASTER									(0U)
+
+		/** Sync and Delay_Req interval */
+		#define C_LOCALDEF__LCCM674__SYNC_INTERVAL_MS						(125U)
+
+		/** Free running counter that pod time is extrapolated on */
+		#define C_LOCALDEF__LCCM674__LOCAL_TICKS_PER_SEC					(C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC)
+		#define M_LOCALDEF__LCCM674__LOCAL_TICKS()							u64RM4_RTI__Get_Counter1()
+
+		/** Software PHY and grandmaster instead of the wire, for host runs */
+		#define C_LOCALDEF__LCCM674__ENABLE_LOOPBACK						(0U)
+
+		/** PHY clock and timestamp units, the DP83640 on MDIO address 1 */
+		#define M_LOCALDEF__LCCM674__PHY_INIT()								vPTP_DP83640__Init(1U)
+		#define M_LOCALDEF__LCCM674__PHY_GET_TIME()							u64PTP_DP83640__Get_Time(1U)
+		#define M_LOCALDEF__LCCM674__PHY_STEP(ns)							vPTP_DP83640__Step(1U, ns)
+		#define M_LOCALDEF__LCCM674__PHY_SET_RATE(ppb)						vPTP_DP83640__Set_Rate(1U, ppb)
+		#define M_LOCALDEF__LCCM674__PHY_TX_STAMP(pt)						s16PTP_DP83640__Get_TxTimestamp(1U, pt)
+		#define M_LOCALDEF__LCCM674__PHY_RX_STAMP(pt,ps,pm)					s16PTP_DP83640__Get_RxTimestamp(1U, pt, ps, pm)
+
+		/** Transport, get a Tx buffer (index or -1) with a deadline, its payload
+		pointer, then send it as UDP with source and dest on the PTP port */
+		#define M_LOCALDEF__LCCM674__TX_ALLOC(length,deadline_us)			s16ETH_FIFO__Push(length)
+		#define M_LOCALDEF__LCCM674__TX_BUFFER(index)						((Luint8 *)u32ETH_BUFFERDESC__Get_TxBufferPointer((Luint8)(index)))
+		#define M_LOCALDEF__LCCM674__TX_SEND(length,port)					vETH_UDP__Transmit(length, port, port)
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM674__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM674__RLOOP__PTP/ptp.h>
+	#endif //#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+
+#endif //#if 0
@@ -0,0 +1,702 @@
+/**
+ * @file		PTP__LOOPBACK.C
+ * @brief		Software PHY clock and grandmaster for running PTP on a host
+ *
+ * @note
+ * Stands in for the timestamping PHY and the wire. There is a true time, a
+ * grandmaster that runs on it, and our PHY clock and local ticks which drift
+ * off it by a set ppb. Frames take the path delay each way and every stamp
+ * gets uniform jitter and the PHY's 8ns resolution. The grandmaster sends a
+ * Sync/Follow_Up each interval and answers Delay_Req's.
+ *
+ * Map the M_LOCALDEF__LCCM674__xxx macros onto the functions here and
+ * drive it with vPTP_LOOPBACK__Advance() between vPTP__Process() calls.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM674R0.FILE.002
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PTP
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup PTP__LOOPBACK
+ * @ingroup PTP
+ * @{ */
+
+#include "ptp.h"
+#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM674__ENABLE_LOOPBACK == 1U
+
+/** Grandmaster time at the start, 1000s */
+#define C_PTP_LB__EPOCH_NS											(1000000000000ULL)
+
+/** Grandmaster turn around for a Follow_Up or Delay_Resp */
+#define C_PTP_LB__TURNAROUND_NS										(50000U)
+
+/** Frames on the wire at once */
+#define C_PTP_LB__MAX_FRAMES										(8U)
+
+/** Stamp FIFO depth, as the DP83640 */
+#define C_PTP_LB__STAMP_DEPTH										(4U)
+
+struct _strPTP_LB_Stamp
+{
+	Luint64 u64Time_ns;
+	Luint16 u16Sequence;
+	Luint8 u8Type;
+};
+
+struct _strPTP_LB_StampFIFO
+{
+	struct _strPTP_LB_Stamp sStamp[C_PTP_LB__STAMP_DEPTH];
+	Luint8 u8Read;
+	Luint8 u8Count;
+};
+
+static struct
+{
+	/** True time, also the grandmaster clock */
+	Luint64 u64True_ns;
+
+	/** Our PHY clock */
+	Luint64 u64Phy_ns;
+	Lint32 s32PhyDrift_ppb;
+	Lint32 s32PhyRate_ppb;
+	Lint64 s64PhyFraction;
+
+	/** Our local counter, kept as ns of a drifting oscillator */
+	Luint64 u64Local_ns;
+	Lint32 s32TickDrift_ppb;
+	Lint64 s64LocalFraction;
+
+	/** Wire */
+	Luint32 u32PathDelay_ns;
+	Luint32 u32Jitter_ns;
+	Luint32 u32Random;
+
+	/** Frames in flight */
+	struct
+	{
+		Luint8 u8Used;
+		Luint8 u8ToUs;
+		Luint64 u64Arrive_ns;
+		Luint16 u16Port;
+		Luint16 u16Length;
+		Luint8 u8Data[C_PTP__DELAY_RESP_LENGTH];
+
+	}sFrame[C_PTP_LB__MAX_FRAMES];
+
+	/** Our PHY's stamps */
+	struct _strPTP_LB_StampFIFO sTx;
+	struct _strPTP_LB_StampFIFO sRx;
+
+	/** Grandmaster */
+	Luint64 u64NextSync_ns;
+	Luint16 u16SyncSequence;
+
+}sPTP_LB;
+
+//locals
+static void vPTP_LB__Run(Luint64 u64Time_ns);
+static Luint64 u64PTP_LB__Drift(Luint64 u64Time_ns, Lint32 s32Drift_ppb, Lint64 *ps64Fraction);
+static Luint64 u64PTP_LB__Stamp(Luint64 u64Time_ns);
+static void vPTP_LB__Queue(Luint8 u8ToUs, Luint64 u64Arrive_ns, const Luint8 *pu8Data, Luint16 u16Length, Luint16 u16Port);
+static void vPTP_LB__Deliver(Luint8 u8Index);
+static void vPTP_LB__Master_Send(Luint8 u8Type, Luint16 u16Sequence, Luint64 u64Time_ns, const Luint8 *pu8Request, Luint64 u64Arrive_ns);
+static void vPTP_LB__Push_Stamp(struct _strPTP_LB_StampFIFO *pFIFO, Luint64 u64Time_ns, const Luint8 *pu8Data);
+static Lint16 s16PTP_LB__Pop_Stamp(struct _strPTP_LB_StampFIFO *pFIFO, struct _strPTP_LB_Stamp *pStamp);
+
+
+/***************************************************************************//**
+ * @brief
+ * Set up the wire and clocks, call before vPTP__Init
+ *
+ * @param[in]		u32Jitter_ns			Stamp jitter, +/-
+ * @param[in]		u32PathDelay_ns			One way delay
+ * @param[in]		s32TickDrift_ppb		Local counter error
+ * @param[in]		s32PhyDrift_ppb			PHY oscillator error
+ * @param[in]		s64PhyOffset_ns			PHY clock less the grandmaster at the start
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.001
+ */
+void vPTP_LOOPBACK__Init(Lint64 s64PhyOffset_ns, Lint32 s32PhyDrift_ppb, Lint32 s32TickDrift_ppb, Luint32 u32PathDelay_ns, Luint32 u32Jitter_ns)
+{
+	Luint8 u8Counter;
+
+	sPTP_LB.u64True_ns = C_PTP_LB__EPOCH_NS;
+	sPTP_LB.u64Phy_ns = (Luint64)((Lint64)C_PTP_LB__EPOCH_NS + s64PhyOffset_ns);
+	sPTP_LB.s32PhyDrift_ppb = s32PhyDrift_ppb;
+	sPTP_LB.s32PhyRate_ppb = 0;
+	sPTP_LB.s64PhyFraction = 0;
+	sPTP_LB.u64Local_ns = 0U;
+	sPTP_LB.s32TickDrift_ppb = s32TickDrift_ppb;
+	sPTP_LB.s64LocalFraction = 0;
+	sPTP_LB.u32PathDelay_ns = u32PathDelay_ns;
+	sPTP_LB.u32Jitter_ns = u32Jitter_ns;
+	sPTP_LB.u32Random = 0x1234567U;
+
+	for(u8Counter = 0U; u8Counter < C_PTP_LB__MAX_FRAMES; u8Counter++)
+	{
+		sPTP_LB.sFrame[u8Counter].u8Used = 0U;
+	}
+	sPTP_LB.sTx.u8Read = 0U;
+	sPTP_LB.sTx.u8Count = 0U;
+	sPTP_LB.sRx.u8Read = 0U;
+	sPTP_LB.sRx.u8Count = 0U;
+
+	sPTP_LB.u64NextSync_ns = C_PTP_LB__EPOCH_NS + ((Luint64)C_LOCALDEF__LCCM674__SYNC_INTERVAL_MS * 1000000ULL);
+	sPTP_LB.u16SyncSequence = 0U;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Move true time on, delivering frames as they arrive
+ *
+ * @param[in]		u32Time_ns				How far
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.002
+ */
+void vPTP_LOOPBACK__Advance(Luint32 u32Time_ns)
+{
+	Luint64 u64End;
+	Luint64 u64Next;
+	Luint8 u8Counter;
+	Luint8 u8Due;
+
+	u64End = sPTP_LB.u64True_ns + (Luint64)u32Time_ns;
+	while(sPTP_LB.u64True_ns < u64End)
+	{
+		//next thing to happen
+		u64Next = u64End;
+		if(sPTP_LB.u64NextSync_ns < u64Next)
+		{
+			u64Next = sPTP_LB.u64NextSync_ns;
+		}
+		else
+		{
+			//fall on
+		}
+		for(u8Counter = 0U; u8Counter < C_PTP_LB__MAX_FRAMES; u8Counter++)
+		{
+			if((sPTP_LB.sFrame[u8Counter].u8Used == 1U) && (sPTP_LB.sFrame[u8Counter].u64Arrive_ns < u64Next))
+			{
+				u64Next = sPTP_LB.sFrame[u8Counter].u64Arrive_ns;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+
+		vPTP_LB__Run(u64Next - sPTP_LB.u64True_ns);
+
+		//grandmaster Sync, two step
+		if(sPTP_LB.u64True_ns >= sPTP_LB.u64NextSync_ns)
+		{
+			vPTP_LB__Master_Send(C_PTP__MSG_SYNC, sPTP_LB.u16SyncSequence, 0U, 0, sPTP_LB.u64True_ns + sPTP_LB.u32PathDelay_ns);
+			vPTP_LB__Master_Send(C_PTP__MSG_FOLLOW_UP, sPTP_LB.u16SyncSequence, u64PTP_LB__Stamp(sPTP_LB.u64True_ns), 0,
+										sPTP_LB.u64True_ns + C_PTP_LB__TURNAROUND_NS + sPTP_LB.u32PathDelay_ns);
+			sPTP_LB.u16SyncSequence++;
+			sPTP_LB.u64NextSync_ns += (Luint64)C_LOCALDEF__LCCM674__SYNC_INTERVAL_MS * 1000000ULL;
+		}
+		else
+		{
+			//fall on
+		}
+
+		//frames, in arrival order
+		u8Due = 1U;
+		while(u8Due == 1U)
+		{
+			u8Due = 0U;
+			for(u8Counter = 0U; u8Counter < C_PTP_LB__MAX_FRAMES; u8Counter++)
+			{
+				if((u8Due == 0U) && (sPTP_LB.sFrame[u8Counter].u8Used == 1U) && (sPTP_LB.sFrame[u8Counter].u64Arrive_ns <= sPTP_LB.u64True_ns))
+				{
+					vPTP_LB__Deliver(u8Counter);
+					u8Due = 1U;
+				}
+				else
+				{
+					//fall on
+				}
+			}
+		}
+	}
+
+}
+
+/***************************************************************************//**
+ * @brief
+ * Our frame onto the wire, stands in for the FIFO and UDP layer
+ *
+ * @param[in]		u16Port					UDP port
+ * @param[in]		u16Length				Message length
+ * @param[in]		*pu8Payload				Message
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.003
+ */
+void vPTP_LOOPBACK__Transmit(const Luint8 * pu8Payload, Luint16 u16Length, Luint16 u16Port)
+{
+	if(u16Port == C_PTP__PORT_EVENT)
+	{
+		vPTP_LB__Push_Stamp(&sPTP_LB.sTx, u64PTP_LB__Stamp(sPTP_LB.u64Phy_ns), pu8Payload);
+	}
+	else
+	{
+		//no stamp on general messages
+	}
+	vPTP_LB__Queue(0U, sPTP_LB.u64True_ns + sPTP_LB.u32PathDelay_ns, pu8Payload, u16Length, u16Port);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Our PHY clock less the grandmaster right now
+ *
+ * @return			ns
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.004
+ */
+Lint64 s64PTP_LOOPBACK__Get_TrueOffset_ns(void)
+{
+	return (Lint64)(sPTP_LB.u64Phy_ns - sPTP_LB.u64True_ns);
+}
+
+/***************************************************************************//**
+ * @brief
+ * The grandmaster clock
+ *
+ * @return			ns
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.005
+ */
+Luint64 u64PTP_LOOPBACK__Get_TrueTime_ns(void)
+{
+	return sPTP_LB.u64True_ns;
+}
+
+/***************************************************************************//**
+ * @brief
+ * PHY: read the clock
+ *
+ * @return			ns
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.006
+ */
+Luint64 u64PTP_LOOPBACK__Get_Time(void)
+{
+	return sPTP_LB.u64Phy_ns;
+}
+
+/***************************************************************************//**
+ * @brief
+ * PHY: step the clock
+ *
+ * @param[in]		s64Step_ns				Amount to add
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.007
+ */
+void vPTP_LOOPBACK__Step(Lint64 s64Step_ns)
+{
+	sPTP_LB.u64Phy_ns = (Luint64)((Lint64)sPTP_LB.u64Phy_ns + s64Step_ns);
+}
+
+/***************************************************************************//**
+ * @brief
+ * PHY: trim the clock
+ *
+ * @param[in]		s32Rate_ppb				Rate, + = faster
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.008
+ */
+void vPTP_LOOPBACK__Set_Rate(Lint32 s32Rate_ppb)
+{
+	sPTP_LB.s32PhyRate_ppb = s32Rate_ppb;
+}
+
+/***************************************************************************//**
+ * @brief
+ * PHY: oldest Tx stamp
+ *
+ * @param[out]		*pu64Time_ns			Stamp
+ * @return			-1 = none
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.009
+ */
+Lint16 s16PTP_LOOPBACK__Get_TxTimestamp(Luint64 *pu64Time_ns)
+{
+	Lint16 s16Return;
+	struct _strPTP_LB_Stamp sStamp;
+
+	s16Return = s16PTP_LB__Pop_Stamp(&sPTP_LB.sTx, &sStamp);
+	if(s16Return >= 0)
+	{
+		*pu64Time_ns = sStamp.u64Time_ns;
+	}
+	else
+	{
+		//fall on
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * PHY: oldest Rx stamp
+ *
+ * @param[out]		*pu8MessageType			Message type
+ * @param[out]		*pu16SequenceID			Sequence ID
+ * @param[out]		*pu64Time_ns			Stamp
+ * @return			-1 = none
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.010
+ */
+Lint16 s16PTP_LOOPBACK__Get_RxTimestamp(Luint64 *pu64Time_ns, Luint16 *pu16SequenceID, Luint8 *pu8MessageType)
+{
+	Lint16 s16Return;
+	struct _strPTP_LB_Stamp sStamp;
+
+	s16Return = s16PTP_LB__Pop_Stamp(&sPTP_LB.sRx, &sStamp);
+	if(s16Return >= 0)
+	{
+		*pu64Time_ns = sStamp.u64Time_ns;
+		*pu16SequenceID = sStamp.u16Sequence;
+		*pu8MessageType = sStamp.u8Type;
+	}
+	else
+	{
+		//fall on
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Our local counter
+ *
+ * @return			Ticks at C_LOCALDEF__LCCM674__LOCAL_TICKS_PER_SEC
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.011
+ */
+Luint64 u64PTP_LOOPBACK__Get_LocalTicks(void)
+{
+	Luint64 u64Sec;
+	Luint64 u64Ns;
+
+	//whole seconds apart so a fast counter can't overflow the product
+	u64Sec = sPTP_LB.u64Local_ns / 1000000000ULL;
+	u64Ns = sPTP_LB.u64Local_ns % 1000000000ULL;
+
+	return (u64Sec * (Luint64)C_LOCALDEF__LCCM674__LOCAL_TICKS_PER_SEC) + ((u64Ns * (Luint64)C_LOCALDEF__LCCM674__LOCAL_TICKS_PER_SEC) / 1000000000ULL);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Run all the clocks on
+ *
+ * @param[in]		u64Time_ns				True ns
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.012
+ */
+static void vPTP_LB__Run(Luint64 u64Time_ns)
+{
+	sPTP_LB.u64True_ns += u64Time_ns;
+	sPTP_LB.u64Phy_ns += u64PTP_LB__Drift(u64Time_ns, sPTP_LB.s32PhyDrift_ppb + sPTP_LB.s32PhyRate_ppb, &sPTP_LB.s64PhyFraction);
+	sPTP_LB.u64Local_ns += u64PTP_LB__Drift(u64Time_ns, sPTP_LB.s32TickDrift_ppb, &sPTP_LB.s64LocalFraction);
+}
+
+/***************************************************************************//**
+ * @brief
+ * How far a clock off by some ppb moves in a time, carrying the part ns
+ *
+ * @param[in,out]	*ps64Fraction			Carried ns * 1e9
+ * @param[in]		s32Drift_ppb			Clock error
+ * @param[in]		u64Time_ns				True ns
+ * @return			Clock ns
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.013
+ */
+static Luint64 u64PTP_LB__Drift(Luint64 u64Time_ns, Lint32 s32Drift_ppb, Lint64 *ps64Fraction)
+{
+	Lint64 s64Whole;
+
+	*ps64Fraction += (Lint64)u64Time_ns * (Lint64)s32Drift_ppb;
+	s64Whole = *ps64Fraction / 1000000000LL;
+	*ps64Fraction -= s64Whole * 1000000000LL;
+
+	return (Luint64)((Lint64)u64Time_ns + s64Whole);
+}
+
+/***************************************************************************//**
+ * @brief
+ * A clock reading as a PHY stamp, jittered and down to 8ns
+ *
+ * @param[in]		u64Time_ns				Clock
+ * @return			Stamp
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.014
+ */
+static Luint64 u64PTP_LB__Stamp(Luint64 u64Time_ns)
+{
+	Lint64 s64Jitter;
+
+	sPTP_LB.u32Random = (sPTP_LB.u32Random * 1664525U) + 1013904223U;
+	if(sPTP_LB.u32Jitter_ns > 0U)
+	{
+		s64Jitter = (Lint64)((sPTP_LB.u32Random >> 8U) % ((2U * sPTP_LB.u32Jitter_ns) + 1U)) - (Lint64)sPTP_LB.u32Jitter_ns;
+	}
+	else
+	{
+		s64Jitter = 0;
+	}
+
+	return (Luint64)((Lint64)u64Time_ns + s64Jitter) & ~7ULL;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Put a frame on the wire
+ *
+ * @param[in]		u16Port					UDP port
+ * @param[in]		u16Length				Length
+ * @param[in]		*pu8Data				Frame
+ * @param[in]		u64Arrive_ns			True time it lands
+ * @param[in]		u8ToUs					1 = from the grandmaster
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.015
+ */
+static void vPTP_LB__Queue(Luint8 u8ToUs, Luint64 u64Arrive_ns, const Luint8 *pu8Data, Luint16 u16Length, Luint16 u16Port)
+{
+	Luint8 u8Counter;
+	Luint8 u8Index;
+	Luint16 u16Byte;
+
+	u8Index = C_PTP_LB__MAX_FRAMES;
+	for(u8Counter = 0U; u8Counter < C_PTP_LB__MAX_FRAMES; u8Counter++)
+	{
+		if((u8Index == C_PTP_LB__MAX_FRAMES) && (sPTP_LB.sFrame[u8Counter].u8Used == 0U))
+		{
+			u8Index = u8Counter;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	if((u8Index < C_PTP_LB__MAX_FRAMES) && (u16Length <= C_PTP__DELAY_RESP_LENGTH))
+	{
+		sPTP_LB.sFrame[u8Index].u8Used = 1U;
+		sPTP_LB.sFrame[u8Index].u8ToUs = u8ToUs;
+		sPTP_LB.sFrame[u8Index].u64Arrive_ns = u64Arrive_ns;
+		sPTP_LB.sFrame[u8Index].u16Port = u16Port;
+		sPTP_LB.sFrame[u8Index].u16Length = u16Length;
+		for(u16Byte = 0U; u16Byte < u16Length; u16Byte++)
+		{
+			sPTP_LB.sFrame[u8Index].u8Data[u16Byte] = pu8Data[u16Byte];
+		}
+	}
+	else
+	{
+		//lost on the wire
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * A frame has landed
+ *
+ * @param[in]		u8Index					Frame
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.016
+ */
+static void vPTP_LB__Deliver(Luint8 u8Index)
+{
+	Luint8 *pu8Data;
+	Luint16 u16Sequence;
+
+	sPTP_LB.sFrame[u8Index].u8Used = 0U;
+	pu8Data = &sPTP_LB.sFrame[u8Index].u8Data[0];
+
+	if(sPTP_LB.sFrame[u8Index].u8ToUs == 1U)
+	{
+		if(sPTP_LB.sFrame[u8Index].u16Port == C_PTP__PORT_EVENT)
+		{
+			vPTP_LB__Push_Stamp(&sPTP_LB.sRx, u64PTP_LB__Stamp(sPTP_LB.u64Phy_ns), pu8Data);
+		}
+		else
+		{
+			//fall on
+		}
+		vPTP__Input(pu8Data, sPTP_LB.sFrame[u8Index].u16Length, sPTP_LB.sFrame[u8Index].u16Port);
+	}
+	else
+	{
+		//grandmaster only has to answer Delay_Req's
+		if((pu8Data[0] & 0x0FU) == C_PTP__MSG_DELAY_REQ)
+		{
+			u16Sequence = ((Luint16)pu8Data[30] << 8U) | (Luint16)pu8Data[31];
+			vPTP_LB__Master_Send(C_PTP__MSG_DELAY_RESP, u16Sequence, u64PTP_LB__Stamp(sPTP_LB.u64True_ns), pu8Data,
+										sPTP_LB.u64True_ns + C_PTP_LB__TURNAROUND_NS + sPTP_LB.u32PathDelay_ns);
+		}
+		else
+		{
+			//fall on
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Grandmaster message to us
+ *
+ * @param[in]		u64Arrive_ns			True time it lands
+ * @param[in]		*pu8Request				Delay_Req being answered, or 0
+ * @param[in]		u64Time_ns				Timestamp field
+ * @param[in]		u16Sequence				Sequence
+ * @param[in]		u8Type					Message type
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.017
+ */
+static void vPTP_LB__Master_Send(Luint8 u8Type, Luint16 u16Sequence, Luint64 u64Time_ns, const Luint8 *pu8Request, Luint64 u64Arrive_ns)
+{
+	Luint8 u8Message[C_PTP__DELAY_RESP_LENGTH];
+	Luint8 u8Counter;
+	Luint16 u16Length;
+	Luint16 u16Port;
+	Luint64 u64Seconds;
+	Luint32 u32Nanoseconds;
+
+	for(u8Counter = 0U; u8Counter < C_PTP__DELAY_RESP_LENGTH; u8Counter++)
+	{
+		u8Message[u8Counter] = 0U;
+	}
+
+	if(u8Type == C_PTP__MSG_DELAY_RESP)
+	{
+		u16Length = C_PTP__DELAY_RESP_LENGTH;
+		for(u8Counter = 0U; u8Counter < 10U; u8Counter++)
+		{
+			u8Message[44U + u8Counter] = pu8Request[20U + u8Counter];
+		}
+	}
+	else
+	{
+		u16Length = C_PTP__SYNC_LENGTH;
+	}
+
+	if(u8Type == C_PTP__MSG_SYNC)
+	{
+		u16Port = C_PTP__PORT_EVENT;
+		u8Message[6] = 0x02U;
+	}
+	else
+	{
+		u16Port = C_PTP__PORT_GENERAL;
+	}
+
+	u8Message[0] = u8Type;
+	u8Message[1] = 2U;
+	u8Message[2] = (Luint8)(u16Length >> 8U);
+	u8Message[3] = (Luint8)u16Length;
+
+	//grandmaster identity, as the FCU
+	u8Message[20] = 0x00U;
+	u8Message[21] = 0x26U;
+	u8Message[22] = 0x80U;
+	u8Message[23] = 0xFFU;
+	u8Message[24] = 0xFEU;
+	u8Message[25] = 0x01U;
+	u8Message[29] = 100U;
+
+	u8Message[30] = (Luint8)(u16Sequence >> 8U);
+	u8Message[31] = (Luint8)u16Sequence;
+
+	u64Seconds = u64Time_ns / 1000000000ULL;
+	u32Nanoseconds = (Luint32)(u64Time_ns % 1000000000ULL);
+	for(u8Counter = 0U; u8Counter < 6U; u8Counter++)
+	{
+		u8Message[39U - u8Counter] = (Luint8)(u64Seconds >> (8U * u8Counter));
+	}
+	for(u8Counter = 0U; u8Counter < 4U; u8Counter++)
+	{
+		u8Message[43U - u8Counter] = (Luint8)(u32Nanoseconds >> (8U * u8Counter));
+	}
+
+	vPTP_LB__Queue(1U, u64Arrive_ns, &u8Message[0], u16Length, u16Port);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Stamp an event message into a PHY FIFO, full drops it like the PHY
+ *
+ * @param[in]		*pu8Data				Message
+ * @param[in]		u64Time_ns				Stamp
+ * @param[in]		*pFIFO					Tx or Rx
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.018
+ */
+static void vPTP_LB__Push_Stamp(struct _strPTP_LB_StampFIFO *pFIFO, Luint64 u64Time_ns, const Luint8 *pu8Data)
+{
+	Luint8 u8Index;
+
+	if(pFIFO->u8Count < C_PTP_LB__STAMP_DEPTH)
+	{
+		u8Index = (pFIFO->u8Read + pFIFO->u8Count) % C_PTP_LB__STAMP_DEPTH;
+		pFIFO->sStamp[u8Index].u64Time_ns = u64Time_ns;
+		pFIFO->sStamp[u8Index].u16Sequence = ((Luint16)pu8Data[30] << 8U) | (Luint16)pu8Data[31];
+		pFIFO->sStamp[u8Index].u8Type = pu8Data[0] & 0x0FU;
+		pFIFO->u8Count++;
+	}
+	else
+	{
+		//overrun
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Oldest stamp out of a PHY FIFO
+ *
+ * @param[out]		*pStamp					Stamp
+ * @param[in]		*pFIFO					Tx or Rx
+ * @return			-1 = empty
+ * @st_funcMD5
+ * @st_funcID		LCCM674R0.FILE.002.FUNC.019
+ */
+static Lint16 s16PTP_LB__Pop_Stamp(struct _strPTP_LB_StampFIFO *pFIFO, struct _strPTP_LB_Stamp *pStamp)
+{
+	Lint16 s16Return;
+
+	if(pFIFO->u8Count > 0U)
+	{
+		*pStamp = pFIFO->sStamp[pFIFO->u8Read];
+		pFIFO->u8Read = (pFIFO->u8Read + 1U) % C_PTP_LB__STAMP_DEPTH;
+		pFIFO->u8Count--;
+		s16Return = 0;
+	}
+	else
+	{
+		s16Return = -1;
+	}
+
+	return s16Return;
+}
+
+
+#endif //#if C_LOCALDEF__LCCM674__ENABLE_LOOPBACK == 1U
+#endif //#if C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM674__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
@@ -0,0 +1,517 @@
+/**
+ * @file		LCCM675R0_TS_000.C
+ * @brief		Test spec for the Tx class scheduler against a sim wire
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM675R0.FILE.002
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM675__ENABLE_TEST_SPEC == 1U
+
+#include <stdio.h>
+
+void vLCCM675R0_TS_000_TCASE_001(void);
+void vLCCM675R0_TS_000_TCASE_002(void);
+void vLCCM675R0_TS_000_TCASE_003(void);
+static void vTS000__Reset(void);
+static void vTS000__Advance_us(Luint32 u32Time_us);
+static void vTS000__Result(Luint32 u32Fail, const char *pcCase);
+
+/** Sim wire, time one packet takes to go */
+#define C_TS000__WIRE_US						(700U)
+
+/** Sim length */
+#define C_TS000__RUN_US							(10000000U)
+
+/** Requests the sim sends, the class is the hundreds */
+#define C_TS000__REQ__TELEMETRY					(1U)
+#define C_TS000__REQ__STREAM_A					(101U)
+#define C_TS000__REQ__STREAM_B					(102U)
+#define C_TS000__REQ__BULK						(201U)
+#define C_TS000__REQ__HOUSEKEEPING				(301U)
+
+/** Sends remembered in order */
+#define C_TS000__LOG_SIZE						(16U)
+
+extern struct _strTXCLASS sTXCLASS;
+
+//the sim
+static struct
+{
+	/** The localdef points the scheduler clock here */
+	Luint32 u32Ticks;
+
+	/** Time left on the wire */
+	Luint32 u32WireBusy_us;
+
+	/** Have the send refuse, as if there was no Tx buffer */
+	Luint8 u8Refuse;
+
+	/** Sends take no wire time */
+	Luint8 u8NoWire;
+
+	/** What went out */
+	Luint16 u16Log[C_TS000__LOG_SIZE];
+	Luint32 u32LogParam[C_TS000__LOG_SIZE];
+	Luint8 u8LogCount;
+
+}sTS000;
+
+//Function to call the tests for this test specification
+void vLCCM675R0_TS_000(void)
+{
+	//Call the test cases
+	vLCCM675R0_TS_000_TCASE_001();
+	vLCCM675R0_TS_000_TCASE_002();
+	vLCCM675R0_TS_000_TCASE_003();
+}
+
+/***************************************************************************//**
+ * @brief
+ * Scheduler clock for the test
+ *
+ * @return			Ticks
+ */
+Luint32 u32LCCM675R0_TS_000__Ticks(void)
+{
+	return sTS000.u32Ticks;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Sim wire is idle
+ *
+ * @return			1 = ready
+ */
+Luint8 u8LCCM675R0_TS_000__Lower_Ready(void)
+{
+	Luint8 u8Return;
+
+	if(sTS000.u32WireBusy_us == 0U)
+	{
+		u8Return = 1U;
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Sim send, puts the request on the wire
+ *
+ * @param[in]		u32Param				Param
+ * @param[in]		u16Request				Request ID
+ * @return			-1 = refused\n
+ *					0 = sent
+ */
+Lint16 s16LCCM675R0_TS_000__Send(Luint16 u16Request, Luint32 u32Param)
+{
+	Lint16 s16Return;
+
+	if(sTS000.u8Refuse == 1U)
+	{
+		s16Return = -1;
+	}
+	else
+	{
+		if(sTS000.u8LogCount < C_TS000__LOG_SIZE)
+		{
+			sTS000.u16Log[sTS000.u8LogCount] = u16Request;
+			sTS000.u32LogParam[sTS000.u8LogCount] = u32Param;
+			sTS000.u8LogCount++;
+		}
+		else
+		{
+			//only the first few are looked at
+		}
+
+		if(sTS000.u8NoWire == 0U)
+		{
+			sTS000.u32WireBusy_us = C_TS000__WIRE_US;
+		}
+		else
+		{
+			//fall on
+		}
+		s16Return = 0;
+	}
+
+	return s16Return;
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM675R0.TS.000.TCASE.001
+ * @st_test_desc
+ * A repeat request is not queued twice, a full class refuses. Earliest deadline
+ * goes first across classes whatever the class, and a deadline tie goes to the
+ * lower class. Nothing goes while the wire is busy.
+ *
+*/
+void vLCCM675R0_TS_000_TCASE_001(void)
+{
+	Luint32 u32Fail;
+	Lint16 s16Return;
+	Luint8 u8Counter;
+
+	DEBUG_PRINT("START:LCCM675R0.TS.000.TCASE.001\r\n");
+	u32Fail = 0U;
+
+	vTS000__Reset();
+
+	//same request and param twice is one entry, another param is another
+	s16Return = s16TXCLASS__Request(TXCLASS__PERIODIC, 0U, C_TS000__REQ__STREAM_A, 7U);
+	if(s16Return != 0)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	s16Return = s16TXCLASS__Request(TXCLASS__PERIODIC, 0U, C_TS000__REQ__STREAM_A, 7U);
+	if((s16Return != 1) || (u8TXCLASS__Get_Pending(TXCLASS__PERIODIC) != 1U) || (sTXCLASS.sClass[TXCLASS__PERIODIC].sStats.u32Coalesced != 1U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//fill bulk to the top
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM675__CLASS_DEPTH; u8Counter++)
+	{
+		(void)s16TXCLASS__Request(TXCLASS__BULK, 0U, C_TS000__REQ__BULK, (Luint32)u8Counter);
+	}
+	s16Return = s16TXCLASS__Request(TXCLASS__BULK, 0U, C_TS000__REQ__BULK, 1000U);
+	if((s16Return != -1) || (sTXCLASS.sClass[TXCLASS__BULK].sStats.u32Rejected != 1U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//housekeeping with a tight deadline beats the periodic default, telemetry
+	//on the same deadline is the lower class so goes ahead of it
+	(void)s16TXCLASS__Request(TXCLASS__HOUSEKEEPING, 2000U, C_TS000__REQ__HOUSEKEEPING, 0U);
+	(void)s16TXCLASS__Request(TXCLASS__TELEMETRY, 2000U, C_TS000__REQ__TELEMETRY, 0U);
+
+	//busy wire holds it all back
+	sTS000.u32WireBusy_us = 100U;
+	vTXCLASS__Process();
+	if(sTS000.u8LogCount != 0U)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//run it all out
+	for(u8Counter = 0U; u8Counter < 20U; u8Counter++)
+	{
+		vTS000__Advance_us(C_TS000__WIRE_US);
+		vTXCLASS__Process();
+	}
+
+	if((sTS000.u8LogCount != (3U + C_LOCALDEF__LCCM675__CLASS_DEPTH)) ||
+		(sTS000.u16Log[0] != C_TS000__REQ__TELEMETRY) ||
+		(sTS000.u16Log[1] != C_TS000__REQ__HOUSEKEEPING) ||
+		(sTS000.u16Log[2] != C_TS000__REQ__STREAM_A) ||
+		(sTS000.u16Log[3] != C_TS000__REQ__BULK) || (sTS000.u32LogParam[3] != 0U) ||
+		(sTS000.u16Log[4] != C_TS000__REQ__BULK) || (sTS000.u32LogParam[4] != 1U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	for(u8Counter = 0U; u8Counter < (Luint8)TXCLASS__COUNT; u8Counter++)
+	{
+		if(u8TXCLASS__Get_Pending((E_TXCLASS__CLASS_T)u8Counter) != 0U)
+		{
+			u32Fail++;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	vTS000__Result(u32Fail, "LCCM675R0.TS.000.TCASE.001");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM675R0.TS.000.TCASE.002
+ * @st_test_desc
+ * Every class is soft, a telemetry request that is already late drops behind
+ * a stream that can still make it and its miss is counted. A refused send
+ * keeps the request at the head. A process call sends no more than
+ * C_LOCALDEF__LCCM675__MAX_PER_PROCESS.
+ *
+*/
+void vLCCM675R0_TS_000_TCASE_002(void)
+{
+	Luint32 u32Fail;
+	Luint8 u8Counter;
+
+	DEBUG_PRINT("START:LCCM675R0.TS.000.TCASE.002\r\n");
+	u32Fail = 0U;
+
+	vTS000__Reset();
+
+	//telemetry sits past its deadline
+	(void)s16TXCLASS__Request(TXCLASS__TELEMETRY, 0U, C_TS000__REQ__TELEMETRY, 0U);
+	vTS000__Advance_us(C_TXCLASS__DEADLINE_US__TELEMETRY + 1000U);
+	(void)s16TXCLASS__Request(TXCLASS__PERIODIC, 0U, C_TS000__REQ__STREAM_A, 0U);
+
+	//no Tx buffer, nothing moves
+	sTS000.u8Refuse = 1U;
+	vTXCLASS__Process();
+	if((sTXCLASS.u32LowerRefused != 1U) || (u8TXCLASS__Get_Pending(TXCLASS__TELEMETRY) != 1U) || (u8TXCLASS__Get_Pending(TXCLASS__PERIODIC) != 1U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	sTS000.u8Refuse = 0U;
+	vTXCLASS__Process();
+	vTS000__Advance_us(C_TS000__WIRE_US);
+	vTXCLASS__Process();
+	if((sTS000.u8LogCount != 2U) || (sTS000.u16Log[0] != C_TS000__REQ__STREAM_A) || (sTS000.u16Log[1] != C_TS000__REQ__TELEMETRY))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	if((u32TXCLASS__Get_DeadlineMisses(TXCLASS__TELEMETRY) != 1U) || (u32TXCLASS__Get_DeadlineMisses(TXCLASS__PERIODIC) != 0U) ||
+		(u32TXCLASS__Get_MaxLatency_us(TXCLASS__TELEMETRY) != (C_TXCLASS__DEADLINE_US__TELEMETRY + 1000U + C_TS000__WIRE_US)))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//a lower layer that is always ready still only gets so many a call
+	vTS000__Reset();
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM675__CLASS_DEPTH; u8Counter++)
+	{
+		(void)s16TXCLASS__Request(TXCLASS__HOUSEKEEPING, 0U, C_TS000__REQ__HOUSEKEEPING, (Luint32)u8Counter);
+	}
+	sTS000.u8NoWire = 1U;
+	vTXCLASS__Process();
+	if((sTS000.u8LogCount != C_LOCALDEF__LCCM675__MAX_PER_PROCESS) ||
+		(u8TXCLASS__Get_Pending(TXCLASS__HOUSEKEEPING) != (C_LOCALDEF__LCCM675__CLASS_DEPTH - C_LOCALDEF__LCCM675__MAX_PER_PROCESS)))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM675R0.TS.000.TCASE.002");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM675R0.TS.000.TCASE.003
+ * @st_test_desc
+ * 10s of a saturated link. Bulk asks whenever it can, two 10ms streams and the
+ * 100ms telemetry packet, one packet goes every 700us. No telemetry or stream
+ * request may be refused or late.
+ *
+*/
+void vLCCM675R0_TS_000_TCASE_003(void)
+{
+	Luint32 u32Fail;
+	Luint32 u32Time;
+	Luint32 u32Dropped;
+	Luint32 u32Bulk;
+	Lint16 s16Return;
+	char cText[200];
+
+	DEBUG_PRINT("START:LCCM675R0.TS.000.TCASE.003\r\n");
+	u32Fail = 0U;
+
+	vTS000__Reset();
+
+	u32Dropped = 0U;
+	u32Bulk = 0U;
+	for(u32Time = 0U; u32Time < C_TS000__RUN_US; u32Time += 100U)
+	{
+		if((u32Time % 100000U) == 0U)
+		{
+			s16Return = s16TXCLASS__Request(TXCLASS__TELEMETRY, 5000U, C_TS000__REQ__TELEMETRY, 0U);
+			if(s16Return != 0)
+			{
+				u32Dropped++;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		else
+		{
+			//fall on
+		}
+
+		if((u32Time % 10000U) == 0U)
+		{
+			s16Return = s16TXCLASS__Request(TXCLASS__PERIODIC, 10000U, C_TS000__REQ__STREAM_A, 0U);
+			if(s16Return != 0)
+			{
+				u32Dropped++;
+			}
+			else
+			{
+				//fall on
+			}
+
+			s16Return = s16TXCLASS__Request(TXCLASS__PERIODIC, 10000U, C_TS000__REQ__STREAM_B, 0U);
+			if(s16Return != 0)
+			{
+				u32Dropped++;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		else
+		{
+			//fall on
+		}
+
+		//bulk takes anything it is allowed
+		s16Return = s16TXCLASS__Request(TXCLASS__BULK, 0U, C_TS000__REQ__BULK, u32Bulk);
+		if(s16Return == 0)
+		{
+			u32Bulk++;
+		}
+		else
+		{
+			//full
+		}
+
+		vTXCLASS__Process();
+		vTS000__Advance_us(100U);
+	}
+
+	sprintf(cText, "INFO:telemetry sent %u max %u us mean %.0f us misses %u, periodic sent %u max %u us misses %u, bulk sent %u rejected %u misses %u\r\n",
+				sTXCLASS.sClass[TXCLASS__TELEMETRY].sStats.u32Sent, u32TXCLASS__Get_MaxLatency_us(TXCLASS__TELEMETRY),
+				(Lfloat64)f32TXCLASS__Get_MeanLatency_us(TXCLASS__TELEMETRY), u32TXCLASS__Get_DeadlineMisses(TXCLASS__TELEMETRY),
+				sTXCLASS.sClass[TXCLASS__PERIODIC].sStats.u32Sent, u32TXCLASS__Get_MaxLatency_us(TXCLASS__PERIODIC),
+				u32TXCLASS__Get_DeadlineMisses(TXCLASS__PERIODIC), sTXCLASS.sClass[TXCLASS__BULK].sStats.u32Sent,
+				sTXCLASS.sClass[TXCLASS__BULK].sStats.u32Rejected, u32TXCLASS__Get_DeadlineMisses(TXCLASS__BULK));
+	DEBUG_PRINT(cText);
+
+	if((u32Dropped != 0U) || (u32TXCLASS__Get_DeadlineMisses(TXCLASS__TELEMETRY) != 0U) || (u32TXCLASS__Get_DeadlineMisses(TXCLASS__PERIODIC) != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	if((sTXCLASS.sClass[TXCLASS__TELEMETRY].sStats.u32Sent != (C_TS000__RUN_US / 100000U)) ||
+		(sTXCLASS.sClass[TXCLASS__PERIODIC].sStats.u32Sent != ((C_TS000__RUN_US / 10000U) * 2U)) ||
+		(sTXCLASS.sClass[TXCLASS__BULK].sStats.u32Sent == 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM675R0.TS.000.TCASE.003");
+}
+
+/***************************************************************************//**
+ * @brief
+ * Empty the scheduler and the sim
+ */
+static void vTS000__Reset(void)
+{
+	sTS000.u32Ticks = 0U;
+	sTS000.u32WireBusy_us = 0U;
+	sTS000.u8Refuse = 0U;
+	sTS000.u8NoWire = 0U;
+	sTS000.u8LogCount = 0U;
+	vTXCLASS__Init();
+}
+
+/***************************************************************************//**
+ * @brief
+ * Move the scheduler clock and the wire on
+ *
+ * @param[in]		u32Time_us				Time
+ */
+static void vTS000__Advance_us(Luint32 u32Time_us)
+{
+	sTS000.u32Ticks += (Luint32)(((Luint64)u32Time_us * (Luint64)C_LOCALDEF__LCCM675__TICKS_PER_MS) / 1000U);
+
+	if(sTS000.u32WireBusy_us > u32Time_us)
+	{
+		sTS000.u32WireBusy_us -= u32Time_us;
+	}
+	else
+	{
+		sTS000.u32WireBusy_us = 0U;
+	}
+}
+
+static void vTS000__Result(Luint32 u32Fail, const char *pcCase)
+{
+	char cText[200];
+
+	if(u32Fail == 0U)
+	{
+		sprintf(cText, "PASS:%s\r\n", pcCase);
+	}
+	else
+	{
+		sprintf(cText, "FAIL:%s (%u)\r\n", pcCase, u32Fail);
+	}
+	DEBUG_PRINT(cText);
+
+	sprintf(cText, "END:%s\r\n", pcCase);
+	DEBUG_PRINT(cText);
+
+}
+
+#endif //#if C_LOCALDEF__LCCM675__ENABLE_TEST_SPEC == 1U
+#endif //#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE
+	#error
+#endif
+
@@ -0,0 +1,480 @@
+/**
+ * @file		TX_CLASS.C
+ * @brief		Earliest deadline first scheduling of Ethernet Tx by class
+ *
+ * @note
+ * Sits above the Ethernet FIFO and leaves it alone. A module asks for a packet
+ * with s16TXCLASS__Request(), giving a class, a deadline and a request ID. The
+ * packet is not built then, the request waits in its class ring until the
+ * lower layer is ready and vTXCLASS__Process() picks the class head with the
+ * earliest deadline and has the send hook build it straight into a Tx buffer.
+ * The data is then as fresh as it can be and nothing is copied.
+ *
+ * Every class is soft. A head that has missed its deadline drops behind every
+ * head that can still make theirs, so one late packet can not make the rest
+ * late as well. A tie goes to the lower class.
+ *
+ * Asking again for a request that is still queued does not queue it twice,
+ * the send builds from the latest data anyway.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM675R0.FILE.000
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup TXCLASS
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup TXCLASS__CORE
+ * @ingroup TXCLASS
+ * @{ */
+
+#include "tx_class.h"
+#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+
+//the structure
+struct _strTXCLASS sTXCLASS;
+
+//locals
+static Lint16 s16TXCLASS__Select(Luint32 u32Now);
+static Luint8 u8TXCLASS__Position(Luint8 u8Class, Luint8 u8Offset);
+static Luint32 u32TXCLASS__Ticks_To_us(Luint32 u32Ticks);
+
+//default deadlines
+static const Luint32 u32TXCLASS__Deadline_us[TXCLASS__COUNT] =
+{
+	C_TXCLASS__DEADLINE_US__TELEMETRY,
+	C_TXCLASS__DEADLINE_US__PERIODIC,
+	C_TXCLASS__DEADLINE_US__BULK,
+	C_TXCLASS__DEADLINE_US__HOUSEKEEPING
+};
+
+
+/***************************************************************************//**
+ * @brief
+ * Empty every class and clear the stats
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM675R0.FILE.000.FUNC.001
+ */
+void vTXCLASS__Init(void)
+{
+	Luint8 u8Class;
+
+	for(u8Class = 0U; u8Class < (Luint8)TXCLASS__COUNT; u8Class++)
+	{
+		sTXCLASS.sClass[u8Class].u8ReadPosition = 0U;
+		sTXCLASS.sClass[u8Class].u8Count = 0U;
+	}
+
+	vTXCLASS__Clear_Stats();
+}
+
+/***************************************************************************//**
+ * @brief
+ * Send what the lower layer has room for, earliest deadline first
+ *
+ * @note
+ * Stops when the lower layer is not ready, the send hook has no buffer, every
+ * class is empty or C_LOCALDEF__LCCM675__MAX_PER_PROCESS have gone.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM675R0.FILE.000.FUNC.002
+ */
+void vTXCLASS__Process(void)
+{
+	Lint16 s16Class;
+	Lint16 s16Return;
+	Luint8 u8Sent;
+	Luint8 u8Stop;
+	Luint8 u8Pos;
+	Luint32 u32Now;
+	Luint32 u32Latency;
+	Lint32 s32Late;
+
+	u8Sent = 0U;
+	u8Stop = 0U;
+	while(u8Stop == 0U)
+	{
+		if(u8Sent >= C_LOCALDEF__LCCM675__MAX_PER_PROCESS)
+		{
+			//rest next time
+			u8Stop = 1U;
+		}
+		else if(M_LOCALDEF__LCCM675__LOWER_READY() == 0U)
+		{
+			//still busy with the last one
+			u8Stop = 1U;
+		}
+		else
+		{
+			u32Now = M_LOCALDEF__LCCM675__TICKS();
+			s16Class = s16TXCLASS__Select(u32Now);
+			if(s16Class >= 0)
+			{
+				u8Pos = sTXCLASS.sClass[s16Class].u8ReadPosition;
+
+				s16Return = M_LOCALDEF__LCCM675__SEND(sTXCLASS.sClass[s16Class].u16Request[u8Pos], sTXCLASS.sClass[s16Class].u32Param[u8Pos]);
+				if(s16Return >= 0)
+				{
+					//request to send
+					u32Latency = u32TXCLASS__Ticks_To_us(u32Now - sTXCLASS.sClass[s16Class].u32Request_Ticks[u8Pos]);
+					sTXCLASS.sClass[s16Class].sStats.u64SumLatency_us += (Luint64)u32Latency;
+					if(u32Latency > sTXCLASS.sClass[s16Class].sStats.u32MaxLatency_us)
+					{
+						sTXCLASS.sClass[s16Class].sStats.u32MaxLatency_us = u32Latency;
+					}
+					else
+					{
+						//fall on
+					}
+
+					//and did it make it
+					s32Late = (Lint32)(u32Now - sTXCLASS.sClass[s16Class].u32Deadline_Ticks[u8Pos]);
+					if(s32Late > 0)
+					{
+						sTXCLASS.sClass[s16Class].sStats.u32DeadlineMisses++;
+						u32Latency = u32TXCLASS__Ticks_To_us((Luint32)s32Late);
+						if(u32Latency > sTXCLASS.sClass[s16Class].sStats.u32WorstLate_us)
+						{
+							sTXCLASS.sClass[s16Class].sStats.u32WorstLate_us = u32Latency;
+						}
+						else
+						{
+							//fall on
+						}
+					}
+					else
+					{
+						//in time
+					}
+
+					sTXCLASS.sClass[s16Class].sStats.u32Sent++;
+
+					//out of the class
+					sTXCLASS.sClass[s16Class].u8ReadPosition = u8TXCLASS__Position((Luint8)s16Class, 1U);
+					sTXCLASS.sClass[s16Class].u8Count--;
+
+					u8Sent++;
+				}
+				else
+				{
+					//no buffer, it stays at the head
+					sTXCLASS.u32LowerRefused++;
+					u8Stop = 1U;
+				}
+			}
+			else
+			{
+				//all gone
+				u8Stop = 1U;
+			}
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Ask for a packet to be sent
+ *
+ * @param[in]		u32Param				Passed to the send hook with the request
+ * @param[in]		u16Request				Request ID, the send hook knows what to build
+ * @param[in]		u32Deadline_us			Must be sent within this, 0 = class default
+ * @param[in]		eClass					Traffic class
+ * @return			-1 = class full\n
+ *					0 = queued\n
+ *					1 = already queued
+ * @st_funcMD5
+ * @st_funcID		LCCM675R0.FILE.000.FUNC.003
+ */
+Lint16 s16TXCLASS__Request(E_TXCLASS__CLASS_T eClass, Luint32 u32Deadline_us, Luint16 u16Request, Luint32 u32Param)
+{
+	Lint16 s16Return;
+	Luint8 u8Counter;
+	Luint8 u8Pos;
+	Luint32 u32Now;
+
+	if((Luint8)eClass >= (Luint8)TXCLASS__COUNT)
+	{
+		eClass = TXCLASS__HOUSEKEEPING;
+	}
+	else
+	{
+		//fall on
+	}
+
+	sTXCLASS.sClass[eClass].sStats.u32Requested++;
+
+	//already waiting
+	s16Return = -1;
+	for(u8Counter = 0U; u8Counter < sTXCLASS.sClass[eClass].u8Count; u8Counter++)
+	{
+		u8Pos = u8TXCLASS__Position((Luint8)eClass, u8Counter);
+		if((sTXCLASS.sClass[eClass].u16Request[u8Pos] == u16Request) && (sTXCLASS.sClass[eClass].u32Param[u8Pos] == u32Param))
+		{
+			s16Return = 1;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+
+	if(s16Return == 1)
+	{
+		//the one queued keeps its place and deadline
+		sTXCLASS.sClass[eClass].sStats.u32Coalesced++;
+	}
+	else if(sTXCLASS.sClass[eClass].u8Count >= C_LOCALDEF__LCCM675__CLASS_DEPTH)
+	{
+		sTXCLASS.sClass[eClass].sStats.u32Rejected++;
+	}
+	else
+	{
+		if(u32Deadline_us == 0U)
+		{
+			u32Deadline_us = u32TXCLASS__Deadline_us[eClass];
+		}
+		else
+		{
+			//fall on
+		}
+
+		u32Now = M_LOCALDEF__LCCM675__TICKS();
+
+		u8Pos = u8TXCLASS__Position((Luint8)eClass, sTXCLASS.sClass[eClass].u8Count);
+		sTXCLASS.sClass[eClass].u16Request[u8Pos] = u16Request;
+		sTXCLASS.sClass[eClass].u32Param[u8Pos] = u32Param;
+		sTXCLASS.sClass[eClass].u32Request_Ticks[u8Pos] = u32Now;
+		sTXCLASS.sClass[eClass].u32Deadline_Ticks[u8Pos] = u32Now + (Luint32)(((Luint64)u32Deadline_us * (Luint64)C_LOCALDEF__LCCM675__TICKS_PER_MS) / 1000U);
+		sTXCLASS.sClass[eClass].u8Count++;
+
+		s16Return = 0;
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Requests waiting in a class
+ *
+ * @param[in]		eClass					Traffic class
+ * @return			Count
+ * @st_funcMD5
+ * @st_funcID		LCCM675R0.FILE.000.FUNC.004
+ */
+Luint8 u8TXCLASS__Get_Pending(E_TXCLASS__CLASS_T eClass)
+{
+	return sTXCLASS.sClass[eClass].u8Count;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Deadline misses for a class since the stats were cleared
+ *
+ * @param[in]		eClass					Traffic class
+ * @return			Misses
+ * @st_funcMD5
+ * @st_funcID		LCCM675R0.FILE.000.FUNC.005
+ */
+Luint32 u32TXCLASS__Get_DeadlineMisses(E_TXCLASS__CLASS_T eClass)
+{
+	return sTXCLASS.sClass[eClass].sStats.u32DeadlineMisses;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Worst request to send time for a class
+ *
+ * @param[in]		eClass					Traffic class
+ * @return			us
+ * @st_funcMD5
+ * @st_funcID		LCCM675R0.FILE.000.FUNC.006
+ */
+Luint32 u32TXCLASS__Get_MaxLatency_us(E_TXCLASS__CLASS_T eClass)
+{
+	return sTXCLASS.sClass[eClass].sStats.u32MaxLatency_us;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Mean request to send time for a class
+ *
+ * @param[in]		eClass					Traffic class
+ * @return			us, 0 if nothing has been sent
+ * @st_funcMD5
+ * @st_funcID		LCCM675R0.FILE.000.FUNC.007
+ */
+Lfloat32 f32TXCLASS__Get_MeanLatency_us(E_TXCLASS__CLASS_T eClass)
+{
+	Lfloat32 f32Return;
+
+	if(sTXCLASS.sClass[eClass].sStats.u32Sent > 0U)
+	{
+		f32Return = (Lfloat32)sTXCLASS.sClass[eClass].sStats.u64SumLatency_us / (Lfloat32)sTXCLASS.sClass[eClass].sStats.u32Sent;
+	}
+	else
+	{
+		f32Return = 0.0F;
+	}
+
+	return f32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Clear the stats of every class
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM675R0.FILE.000.FUNC.008
+ */
+void vTXCLASS__Clear_Stats(void)
+{
+	Luint8 u8Class;
+
+	for(u8Class = 0U; u8Class < (Luint8)TXCLASS__COUNT; u8Class++)
+	{
+		sTXCLASS.sClass[u8Class].sStats.u32Requested = 0U;
+		sTXCLASS.sClass[u8Class].sStats.u32Sent = 0U;
+		sTXCLASS.sClass[u8Class].sStats.u32Coalesced = 0U;
+		sTXCLASS.sClass[u8Class].sStats.u32Rejected = 0U;
+		sTXCLASS.sClass[u8Class].sStats.u32DeadlineMisses = 0U;
+		sTXCLASS.sClass[u8Class].sStats.u32WorstLate_us = 0U;
+		sTXCLASS.sClass[u8Class].sStats.u32MaxLatency_us = 0U;
+		sTXCLASS.sClass[u8Class].sStats.u64SumLatency_us = 0U;
+	}
+	sTXCLASS.u32LowerRefused = 0U;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Pick the class whose head goes next
+ *
+ * @note
+ * Earliest deadline first over the class heads, a head that is already late
+ * is only taken when nothing on time is waiting.
+ *
+ * @param[in]		u32Now					Ticks now
+ * @return			-1 = nothing queued\n
+ *					else the class
+ * @st_funcMD5
+ * @st_funcID		LCCM675R0.FILE.000.FUNC.009
+ */
+static Lint16 s16TXCLASS__Select(Luint32 u32Now)
+{
+	Lint16 s16Return;
+	Luint8 u8Class;
+	Luint8 u8Pos;
+	Luint8 u8Late;
+	Luint8 u8BestLate;
+	Lint32 s32Slack;
+	Lint32 s32BestSlack;
+
+	s16Return = -1;
+	u8BestLate = 1U;
+	s32BestSlack = 0;
+
+	//lower classes first so a tie stays with them
+	for(u8Class = 0U; u8Class < (Luint8)TXCLASS__COUNT; u8Class++)
+	{
+		if(sTXCLASS.sClass[u8Class].u8Count > 0U)
+		{
+			u8Pos = sTXCLASS.sClass[u8Class].u8ReadPosition;
+
+			s32Slack = (Lint32)(sTXCLASS.sClass[u8Class].u32Deadline_Ticks[u8Pos] - u32Now);
+			if(s32Slack < 0)
+			{
+				u8Late = 1U;
+			}
+			else
+			{
+				u8Late = 0U;
+			}
+
+			if(s16Return < 0)
+			{
+				s16Return = (Lint16)u8Class;
+				u8BestLate = u8Late;
+				s32BestSlack = s32Slack;
+			}
+			else if(u8Late < u8BestLate)
+			{
+				s16Return = (Lint16)u8Class;
+				u8BestLate = u8Late;
+				s32BestSlack = s32Slack;
+			}
+			else if((u8Late == u8BestLate) && (s32Slack < s32BestSlack))
+			{
+				s16Return = (Lint16)u8Class;
+				s32BestSlack = s32Slack;
+			}
+			else
+			{
+				//keep what we have
+			}
+		}
+		else
+		{
+			//nothing in this class
+		}
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Ring position an offset on from a class head
+ *
+ * @param[in]		u8Offset				Entries on from the head
+ * @param[in]		u8Class					Traffic class
+ * @return			Position
+ * @st_funcMD5
+ * @st_funcID		LCCM675R0.FILE.000.FUNC.010
+ */
+static Luint8 u8TXCLASS__Position(Luint8 u8Class, Luint8 u8Offset)
+{
+	Luint16 u16Pos;
+
+	u16Pos = (Luint16)sTXCLASS.sClass[u8Class].u8ReadPosition + (Luint16)u8Offset;
+	if(u16Pos >= C_LOCALDEF__LCCM675__CLASS_DEPTH)
+	{
+		u16Pos -= C_LOCALDEF__LCCM675__CLASS_DEPTH;
+	}
+	else
+	{
+		//fall on
+	}
+
+	return (Luint8)u16Pos;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Ticks to us
+ *
+ * @param[in]		u32Ticks				Ticks
+ * @return			us
+ * @st_funcMD5
+ * @st_funcID		LCCM675R0.FILE.000.FUNC.011
+ */
+static Luint32 u32TXCLASS__Ticks_To_us(Luint32 u32Ticks)
+{
+	return (Luint32)(((Luint64)u32Ticks * 1000U) / (Luint64)C_LOCALDEF__LCCM675__TICKS_PER_MS);
+}
+
+
+#endif //#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
+
@@ -0,0 +1,142 @@
+/**
+ * @file		TX_CLASS.H
+ * @brief		Main header for the Ethernet Tx class scheduler
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ */
+
+
+#ifndef _TX_CLASS_H_
+#define _TX_CLASS_H_
+	#include <localdef.h>
+	#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+
+		/*******************************************************************************
+		Defines
+		*******************************************************************************/
+		/** Deadline after the request when the caller passes 0 */
+		#define C_TXCLASS__DEADLINE_US__TELEMETRY					(5000U)
+		#define C_TXCLASS__DEADLINE_US__PERIODIC					(20000U)
+		#define C_TXCLASS__DEADLINE_US__BULK						(500000U)
+		#define C_TXCLASS__DEADLINE_US__HOUSEKEEPING				(250000U)
+
+
+		/*******************************************************************************
+		Structures
+		*******************************************************************************/
+		/** Traffic classes, lower wins a deadline tie */
+		typedef enum
+		{
+			/** Fixed rate telemetry off the pod, e.g. the SpaceX packet */
+			TXCLASS__TELEMETRY = 0U,
+
+			/** Streams to the ground station */
+			TXCLASS__PERIODIC,
+
+			/** Bulk and DAQ */
+			TXCLASS__BULK,
+
+			/** Anything else */
+			TXCLASS__HOUSEKEEPING,
+
+			TXCLASS__COUNT
+
+		}E_TXCLASS__CLASS_T;
+
+		struct _strTXCLASS
+		{
+			/** A ring of requests per class, the scheduler looks at the heads */
+			struct
+			{
+				/** What the send hook is asked to build */
+				Luint16 u16Request[C_LOCALDEF__LCCM675__CLASS_DEPTH];
+				Luint32 u32Param[C_LOCALDEF__LCCM675__CLASS_DEPTH];
+
+				Luint32 u32Request_Ticks[C_LOCALDEF__LCCM675__CLASS_DEPTH];
+				Luint32 u32Deadline_Ticks[C_LOCALDEF__LCCM675__CLASS_DEPTH];
+
+				Luint8 u8ReadPosition;
+				Luint8 u8Count;
+
+				struct
+				{
+					Luint32 u32Requested;
+					Luint32 u32Sent;
+
+					/** Already queued, the one request covers both */
+					Luint32 u32Coalesced;
+
+					/** Class ring full */
+					Luint32 u32Rejected;
+
+					/** Went out after its deadline */
+					Luint32 u32DeadlineMisses;
+					Luint32 u32WorstLate_us;
+
+					/** Request to send */
+					Luint32 u32MaxLatency_us;
+					Luint64 u64SumLatency_us;
+
+				}sStats;
+
+			}sClass[TXCLASS__COUNT];
+
+			/** The send hook had no buffer, the request was kept */
+			Luint32 u32LowerRefused;
+
+		};
+
+
+		/*******************************************************************************
+		Function Prototypes
+		*******************************************************************************/
+		void vTXCLASS__Init(void);
+		void vTXCLASS__Process(void);
+		Lint16 s16TXCLASS__Request(E_TXCLASS__CLASS_T eClass, Luint32 u32Deadline_us, Luint16 u16Request, Luint32 u32Param);
+		Luint8 u8TXCLASS__Get_Pending(E_TXCLASS__CLASS_T eClass);
+		Luint32 u32TXCLASS__Get_DeadlineMisses(E_TXCLASS__CLASS_T eClass);
+		Luint32 u32TXCLASS__Get_MaxLatency_us(E_TXCLASS__CLASS_T eClass);
+		Lfloat32 f32TXCLASS__Get_MeanLatency_us(E_TXCLASS__CLASS_T eClass);
+		void vTXCLASS__Clear_Stats(void);
+
+		//testing
+		#if C_LOCALDEF__LCCM675__ENABLE_TEST_SPEC == 1U
+			DLL_DECLARATION void vLCCM675R0_TS_000(void);
+			Luint32 u32LCCM675R0_TS_000__Ticks(void);
+			Luint8 u8LCCM675R0_TS_000__Lower_Ready(void);
+			Lint16 s16LCCM675R0_TS_000__Send(Luint16 u16Request, Luint32 u32Param);
+		#endif
+
+		//safetys
+		#ifndef C_LOCALDEF__LCCM675__CLASS_DEPTH
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM675__MAX_PER_PROCESS
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM675__TICKS_PER_MS
+			#error
+		#endif
+		#ifndef M_LOCALDEF__LCCM675__TICKS
+			#error
+		#endif
+		#ifndef M_LOCALDEF__LCCM675__LOWER_READY
+			#error
+		#endif
+		#ifndef M_LOCALDEF__LCCM675__SEND
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM675__CLASS_DEPTH == 0U
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM675__CLASS_DEPTH > 255U
+			#error
+		#endif
+
+	#endif //#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+	//safetys
+	#ifndef C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE
+		#error
+	#endif
+#endif //_TX_CLASS_H_
+
@@ -0,0 +1,42 @@
+/**
+ * @file		TX_CLASS__LOCALDEF.H
+ * @brief		Localdef template
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM675R0.FILE.001
+ */
+
+#if 0
+
+/*******************************************************************************
+RLOOP - ETHERNET TX CLASSES
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+
+		/** Requests each class can hold */
+		#define C_LOCALDEF__LCCM675__CLASS_DEPTH							(8U)
+
+		/** Most packets sent each process call */
+		#define C_LOCALDEF__LCCM675__MAX_PER_PROCESS						(4U)
+
+		/** Free running counter the deadlines are kept in, 32 bits of it */
+		#define C_LOCALDEF__LCCM675__TICKS_PER_MS							(C_LOCALDEF__LCCM124__RTI_COUNTER1_TICKS_PER_SEC / 1000U)
+		#define M_LOCALDEF__LCCM675__TICKS()								((Luint32)u64RM4_RTI__Get_Counter1())
+
+		/** 1 when the lower layer can take a packet, the Ethernet FIFO is a plain
+		 * FIFO so only hand it one when it has drained */
+		#define M_LOCALDEF__LCCM675__LOWER_READY()							u8ETH_FIFO__Is_Empty()
+
+		/** Build and send a request (request, param), -1 = no buffer, try later */
+		#define M_LOCALDEF__LCCM675__SEND(request,param)					s16FCU_NET_TX__Send_Request(request, param)
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM675__ENABLE_TEST_SPEC						(0U)
+
+		/** Main include file */
+		#include <LCCM675__RLOOP__TX_CLASS/tx_class.h>
+	#endif //#if C_LOCALDEF__LCCM675__ENABLE_THIS_MODULE == 1U
+
+#endif //#if 0
+
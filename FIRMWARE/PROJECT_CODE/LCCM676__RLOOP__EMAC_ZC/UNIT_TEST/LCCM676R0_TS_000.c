@@ -0,0 +1,755 @@
+/**
+ * @file		LCCM676R0_TS_000.C
+ * @brief		Test spec for the zero copy rings, run against the software EMAC
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM676R0.FILE.004
+ */
+#include <localdef.h>
+
+#ifndef C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE
+	#error
+#endif
+
+#if C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM676__ENABLE_TEST_SPEC == 1U
+#if C_LOCALDEF__LCCM676__ENABLE_MOCK == 1U
+
+#include <stdio.h>
+#include <time.h>
+
+void vLCCM676R0_TS_000_TCASE_001(void);
+void vLCCM676R0_TS_000_TCASE_002(void);
+void vLCCM676R0_TS_000_TCASE_003(void);
+void vLCCM676R0_TS_000_TCASE_004(void);
+static void vTS000__Fill(Luint8 *pu8Buffer, Luint16 u16Length, Luint8 u8Seed);
+static void vTS000__Drain(void);
+static Luint32 u32TS000__Compare(const Luint8 *pu8Header, Luint16 u16HeaderLength, const Luint8 *pu8Payload, Luint16 u16PayloadLength);
+static void vTS000__Result(Luint32 u32Fail, const char *pcCase);
+
+/** Eth, IPv4 and UDP */
+#define C_TS000__HEADER_LENGTH					(42U)
+
+/** Large UDP payload */
+#define C_TS000__PAYLOAD_LENGTH					(1000U)
+
+/** Frames per path in the copy test */
+#define C_TS000__FRAMES							(200U)
+
+/** Tx interrupt latency */
+#define C_TS000__ISR_STEP_NS					(20000U)
+
+/** Interrupt pacing in the sustained run, a few frames go out per interrupt */
+#define C_TS000__PACED_STEP_NS					(250000U)
+
+/** Sustained run, 1 second */
+#define C_TS000__RUN_NS							(1000000000U)
+
+extern struct _strEMACZC sEMACZC;
+extern struct _strEMACZC_MOCK sEMACZC_MOCK;
+
+//the app's payload, stays put while it is on the wire
+static Luint8 u8TS000__Payload[C_TS000__PAYLOAD_LENGTH];
+static Luint8 u8TS000__Header[C_TS000__HEADER_LENGTH];
+
+//what came up the Rx side
+static struct
+{
+	Luint32 u32Count;
+	Luint32 u32Bad;
+	Luint8 u8Keep;
+	Luint8 u8Kept[C_LOCALDEF__LCCM676__POOL_BUFFERS];
+	Luint8 u8KeptCount;
+	Luint8 u8Expect[C_EMACZC__POOL_BUFFER_SIZE];
+	Luint16 u16ExpectLength;
+
+}sTS000__Rx;
+
+//Function to call the tests for this test specification
+void vLCCM676R0_TS_000(void)
+{
+	//Call the test cases
+	vLCCM676R0_TS_000_TCASE_001();
+	vLCCM676R0_TS_000_TCASE_002();
+	vLCCM676R0_TS_000_TCASE_003();
+	vLCCM676R0_TS_000_TCASE_004();
+}
+
+/***************************************************************************//**
+ * @brief
+ * Rx hook for the test, checks the frame in place and keeps it if asked
+ *
+ * @param[in]		u8PoolIndex				Buffer
+ * @param[in]		u16Length				Frame length
+ * @param[in]		pu8Buffer				Frame
+ */
+void vLCCM676R0_TS_000__Rx(Luint8 *pu8Buffer, Luint16 u16Length, Luint8 u8PoolIndex)
+{
+	Luint16 u16Counter;
+	Luint8 u8Match;
+
+	u8Match = 1U;
+	if(u16Length != sTS000__Rx.u16ExpectLength)
+	{
+		u8Match = 0U;
+	}
+	else
+	{
+		for(u16Counter = 0U; u16Counter < u16Length; u16Counter++)
+		{
+			if(pu8Buffer[u16Counter] != sTS000__Rx.u8Expect[u16Counter])
+			{
+				u8Match = 0U;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+	}
+	if(u8Match == 0U)
+	{
+		sTS000__Rx.u32Bad++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(sTS000__Rx.u8Keep == 1U)
+	{
+		if(u8EMACZC__Rx_Keep() == 1U)
+		{
+			sTS000__Rx.u8Kept[sTS000__Rx.u8KeptCount] = u8PoolIndex;
+			sTS000__Rx.u8KeptCount++;
+		}
+		else
+		{
+			//pool empty
+		}
+	}
+	else
+	{
+		//recycled
+	}
+	sTS000__Rx.u32Count++;
+}
+
+//Individual Test Cases can be found below
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM676R0.TS.000.TCASE.001
+ * @st_test_desc
+ * The same UDP frames sent by copying the payload into a pool buffer and by
+ * chaining it on. Each frame on the wire must match byte for byte, the copy
+ * path must move the payload once and the chained path never. A short chained
+ * frame must come out padded to the minimum.
+ *
+*/
+void vLCCM676R0_TS_000_TCASE_001(void)
+{
+	Luint32 u32Fail;
+	Luint32 u32Counter;
+	Luint32 u32Copied;
+	Luint16 u16Byte;
+	Lint16 s16Index;
+	Lint16 s16Return;
+	Luint8 *pu8Buffer;
+	Luint64 u64Pool;
+	Luint64 u64InPlace;
+	Luint8 u8Expect;
+
+	DEBUG_PRINT("START:LCCM676R0.TS.000.TCASE.001\r\n");
+	u32Fail = 0U;
+
+	vEMACZC_MOCK__Init();
+	vEMACZC__Init();
+
+	//copy path
+	u32Copied = 0U;
+	for(u32Counter = 0U; u32Counter < C_TS000__FRAMES; u32Counter++)
+	{
+		vTS000__Fill(&u8TS000__Header[0], C_TS000__HEADER_LENGTH, (Luint8)u32Counter);
+		vTS000__Fill(&u8TS000__Payload[0], C_TS000__PAYLOAD_LENGTH, (Luint8)(u32Counter + 77U));
+
+		s16Index = s16EMACZC_POOL__Alloc();
+		if(s16Index >= 0)
+		{
+			pu8Buffer = (Luint8 *)u32EMACZC_POOL__Get_Pointer((Luint8)s16Index);
+			for(u16Byte = 0U; u16Byte < C_TS000__HEADER_LENGTH; u16Byte++)
+			{
+				pu8Buffer[u16Byte] = u8TS000__Header[u16Byte];
+			}
+			for(u16Byte = 0U; u16Byte < C_TS000__PAYLOAD_LENGTH; u16Byte++)
+			{
+				pu8Buffer[C_TS000__HEADER_LENGTH + u16Byte] = u8TS000__Payload[u16Byte];
+			}
+			u32Copied += C_TS000__PAYLOAD_LENGTH;
+
+			s16Return = s16EMACZC__Tx_Packet((Luint8)s16Index, C_TS000__HEADER_LENGTH + C_TS000__PAYLOAD_LENGTH);
+			if(s16Return < 0)
+			{
+				u32Fail++;
+			}
+			else
+			{
+				vTS000__Drain();
+				u32Fail += u32TS000__Compare(&u8TS000__Header[0], C_TS000__HEADER_LENGTH, &u8TS000__Payload[0], C_TS000__PAYLOAD_LENGTH);
+			}
+		}
+		else
+		{
+			u32Fail++;
+		}
+	}
+	u64Pool = sEMACZC_MOCK.sStats.u64PoolBytes;
+	u64InPlace = sEMACZC_MOCK.sStats.u64InPlaceBytes;
+	printf("INFO: copy path %u payload bytes copied per packet\r\n", (unsigned int)(u32Copied / C_TS000__FRAMES));
+	if((u64InPlace != 0U) || (u64Pool != ((Luint64)C_TS000__FRAMES * (C_TS000__HEADER_LENGTH + C_TS000__PAYLOAD_LENGTH))))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//chained path, the payload is never touched
+	for(u32Counter = 0U; u32Counter < C_TS000__FRAMES; u32Counter++)
+	{
+		vTS000__Fill(&u8TS000__Header[0], C_TS000__HEADER_LENGTH, (Luint8)(u32Counter + 3U));
+		vTS000__Fill(&u8TS000__Payload[0], C_TS000__PAYLOAD_LENGTH, (Luint8)(u32Counter + 19U));
+
+		s16Index = s16EMACZC_POOL__Alloc();
+		if(s16Index >= 0)
+		{
+			pu8Buffer = (Luint8 *)u32EMACZC_POOL__Get_Pointer((Luint8)s16Index);
+			for(u16Byte = 0U; u16Byte < C_TS000__HEADER_LENGTH; u16Byte++)
+			{
+				pu8Buffer[u16Byte] = u8TS000__Header[u16Byte];
+			}
+
+			s16Return = s16EMACZC__Tx_Chain((Luint8)s16Index, C_TS000__HEADER_LENGTH, (Luint32)&u8TS000__Payload[0], C_TS000__PAYLOAD_LENGTH);
+			if(s16Return < 0)
+			{
+				u32Fail++;
+			}
+			else
+			{
+				vTS000__Drain();
+				u32Fail += u32TS000__Compare(&u8TS000__Header[0], C_TS000__HEADER_LENGTH, &u8TS000__Payload[0], C_TS000__PAYLOAD_LENGTH);
+			}
+		}
+		else
+		{
+			u32Fail++;
+		}
+	}
+	u64Pool = sEMACZC_MOCK.sStats.u64PoolBytes - u64Pool;
+	u64InPlace = sEMACZC_MOCK.sStats.u64InPlaceBytes - u64InPlace;
+	printf("INFO: chained path %u payload bytes copied per packet\r\n", (unsigned int)((u64Pool / C_TS000__FRAMES) - C_TS000__HEADER_LENGTH));
+	if((u64Pool != ((Luint64)C_TS000__FRAMES * C_TS000__HEADER_LENGTH)) || (u64InPlace != ((Luint64)C_TS000__FRAMES * C_TS000__PAYLOAD_LENGTH)))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//short chained frame, header and pad fragment
+	s16Index = s16EMACZC_POOL__Alloc();
+	pu8Buffer = (Luint8 *)u32EMACZC_POOL__Get_Pointer((Luint8)s16Index);
+	for(u16Byte = 0U; u16Byte < C_TS000__HEADER_LENGTH; u16Byte++)
+	{
+		pu8Buffer[u16Byte] = u8TS000__Header[u16Byte];
+	}
+	s16Return = s16EMACZC__Tx_Chain((Luint8)s16Index, C_TS000__HEADER_LENGTH, (Luint32)&u8TS000__Payload[0], 4U);
+	vTS000__Drain();
+	if((s16Return < 0) || (sEMACZC_MOCK.u16FrameLength != C_EMACZC__MIN_FRAME_LENGTH))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		for(u16Byte = 0U; u16Byte < C_EMACZC__MIN_FRAME_LENGTH; u16Byte++)
+		{
+			if(u16Byte < C_TS000__HEADER_LENGTH)
+			{
+				u8Expect = u8TS000__Header[u16Byte];
+			}
+			else if(u16Byte < (C_TS000__HEADER_LENGTH + 4U))
+			{
+				u8Expect = u8TS000__Payload[u16Byte - C_TS000__HEADER_LENGTH];
+			}
+			else
+			{
+				//padding
+				u8Expect = 0U;
+			}
+
+			if(sEMACZC_MOCK.u8Frame[u16Byte] != u8Expect)
+			{
+				u32Fail++;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+	}
+
+	//everything back, nothing torn
+	if((u8EMACZC_POOL__Get_Free() != (C_LOCALDEF__LCCM676__POOL_BUFFERS - C_LOCALDEF__LCCM676__RX_DESCRIPTORS)) ||
+		(u8EMACZC__Tx_Get_InFlight() != 0U) || (sEMACZC_MOCK.sStats.u32Malformed != 0U) || (sEMACZC_MOCK.sStats.u32BadHDP != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM676R0.TS.000.TCASE.001");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM676R0.TS.000.TCASE.002
+ * @st_test_desc
+ * Keep the ring topped up with chained 1000 byte frames for a second with the
+ * Tx interrupt paced at 250us. The wire must stay within 1% of 100Mbit line rate,
+ * the reclaim must batch and the pool must come back whole.
+ *
+*/
+void vLCCM676R0_TS_000_TCASE_002(void)
+{
+	Luint32 u32Fail;
+	Luint64 u64Time_ns;
+	Luint32 u32Queued;
+	Luint32 u32Theory;
+	Luint32 u32Frames;
+	Lint16 s16Index;
+	Lint16 s16Return;
+	Luint8 u8Full;
+	clock_t tStart;
+	clock_t tEnd;
+
+	DEBUG_PRINT("START:LCCM676R0.TS.000.TCASE.002\r\n");
+	u32Fail = 0U;
+
+	vEMACZC_MOCK__Init();
+	vEMACZC__Init();
+
+	u32Queued = 0U;
+	u64Time_ns = 0U;
+	tStart = clock();
+	while(u64Time_ns < C_TS000__RUN_NS)
+	{
+		//top up
+		u8Full = 0U;
+		while(u8Full == 0U)
+		{
+			s16Index = s16EMACZC_POOL__Alloc();
+			if(s16Index >= 0)
+			{
+				s16Return = s16EMACZC__Tx_Chain((Luint8)s16Index, C_TS000__HEADER_LENGTH, (Luint32)&u8TS000__Payload[0], C_TS000__PAYLOAD_LENGTH);
+				if(s16Return < 0)
+				{
+					vEMACZC_POOL__Release((Luint8)s16Index);
+					u8Full = 1U;
+				}
+				else
+				{
+					u32Queued++;
+				}
+			}
+			else
+			{
+				u8Full = 1U;
+			}
+		}
+
+		vEMACZC_MOCK__Advance(C_TS000__PACED_STEP_NS);
+		u64Time_ns += C_TS000__PACED_STEP_NS;
+	}
+	tEnd = clock();
+	u32Frames = sEMACZC_MOCK.sStats.u32TxFrames;
+	vTS000__Drain();
+
+	u32Theory = C_TS000__RUN_NS / ((C_TS000__HEADER_LENGTH + C_TS000__PAYLOAD_LENGTH + 24U) * 80U);
+	printf("INFO: %u pps sustained, line rate %u pps, %u frames per Tx interrupt at most, %u Tx interrupts\r\n",
+		(unsigned int)u32Frames, (unsigned int)u32Theory, (unsigned int)sEMACZC.sTx.sStats.u8MaxBatch, (unsigned int)sEMACZC.sTx.sStats.u32Batches);
+	printf("INFO: host %.3f us of CPU per packet\r\n", ((Lfloat64)(tEnd - tStart) * 1000000.0) / ((Lfloat64)CLOCKS_PER_SEC * (Lfloat64)u32Queued));
+
+	if(((Luint64)u32Frames * 100U) < ((Luint64)u32Theory * 99U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	if((sEMACZC_MOCK.sStats.u32TxFrames != u32Queued) || (sEMACZC.sTx.sStats.u32Batches >= u32Queued))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	if((u8EMACZC_POOL__Get_Free() != (C_LOCALDEF__LCCM676__POOL_BUFFERS - C_LOCALDEF__LCCM676__RX_DESCRIPTORS)) ||
+		(sEMACZC_MOCK.sStats.u32Malformed != 0U) || (sEMACZC_MOCK.sStats.u32BadHDP != 0U) || (sEMACZC_MOCK.sStats.u32TxCP != sEMACZC.sTx.sStats.u32Batches))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM676R0.TS.000.TCASE.002");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM676R0.TS.000.TCASE.003
+ * @st_test_desc
+ * A buffer the app takes a second reference on must outlive its transmit and
+ * go back to the pool on the last release. Tx with the ring full must leave
+ * the buffer with the caller.
+ *
+*/
+void vLCCM676R0_TS_000_TCASE_003(void)
+{
+	Luint32 u32Fail;
+	Lint16 s16Index;
+	Lint16 s16Spare;
+	Lint16 s16Return;
+	Luint8 u8Free;
+	Luint8 u8Counter;
+	Luint8 u8Stop;
+
+	DEBUG_PRINT("START:LCCM676R0.TS.000.TCASE.003\r\n");
+	u32Fail = 0U;
+
+	vEMACZC_MOCK__Init();
+	vEMACZC__Init();
+	u8Free = u8EMACZC_POOL__Get_Free();
+
+	s16Index = s16EMACZC_POOL__Alloc();
+	vEMACZC_POOL__Ref((Luint8)s16Index);
+	s16Return = s16EMACZC__Tx_Packet((Luint8)s16Index, 100U);
+	vTS000__Drain();
+
+	//ring let go, the app still has it
+	if((s16Return < 0) || (u8EMACZC_POOL__Get_Ref((Luint8)s16Index) != 1U) || (u8EMACZC_POOL__Get_Free() != (u8Free - 1U)))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//send it again off the same reference
+	vEMACZC_POOL__Ref((Luint8)s16Index);
+	s16Return = s16EMACZC__Tx_Packet((Luint8)s16Index, 100U);
+	vTS000__Drain();
+	vEMACZC_POOL__Release((Luint8)s16Index);
+	if((s16Return < 0) || (u8EMACZC_POOL__Get_Ref((Luint8)s16Index) != 0U) || (u8EMACZC_POOL__Get_Free() != u8Free))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//double release leaves it free
+	vEMACZC_POOL__Release((Luint8)s16Index);
+	if(u8EMACZC_POOL__Get_Free() != u8Free)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//fill the ring with the wire stopped, the one that does not fit stays ours
+	s16Spare = s16EMACZC_POOL__Alloc();
+	u8Stop = 0U;
+	for(u8Counter = 0U; (u8Counter < (C_LOCALDEF__LCCM676__TX_DESCRIPTORS + 1U)) && (u8Stop == 0U); u8Counter++)
+	{
+		vEMACZC_POOL__Ref((Luint8)s16Spare);
+		s16Return = s16EMACZC__Tx_Packet((Luint8)s16Spare, 100U);
+		if(s16Return < 0)
+		{
+			u8Stop = 1U;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	if((u8Stop != 1U) || (u8Counter != (C_LOCALDEF__LCCM676__TX_DESCRIPTORS + 1U)) || (u8EMACZC_POOL__Get_Ref((Luint8)s16Spare) != (C_LOCALDEF__LCCM676__TX_DESCRIPTORS + 2U)))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+	vEMACZC_POOL__Release((Luint8)s16Spare);
+	vTS000__Drain();
+	vEMACZC_POOL__Release((Luint8)s16Spare);
+	if((u8EMACZC_POOL__Get_Free() != u8Free) || (sEMACZC.sTx.sStats.u32RingFull != 1U) || (sEMACZC_MOCK.sStats.u32BadHDP != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM676R0.TS.000.TCASE.003");
+}
+
+/***************************************************************************//**
+ * @st_test_case_id
+ * LCCM676R0.TS.000.TCASE.004
+ * @st_test_desc
+ * Frames on the Rx side are handed up in place and the descriptors go back in
+ * one chain. Kept frames swap in a fresh buffer. A burst bigger than the ring
+ * drops the excess, stops the receiver and it must restart.
+ *
+*/
+void vLCCM676R0_TS_000_TCASE_004(void)
+{
+	Luint32 u32Fail;
+	Luint8 u8Free;
+	Luint8 u8Counter;
+
+	DEBUG_PRINT("START:LCCM676R0.TS.000.TCASE.004\r\n");
+	u32Fail = 0U;
+
+	vEMACZC_MOCK__Init();
+	vEMACZC__Init();
+	u8Free = u8EMACZC_POOL__Get_Free();
+
+	sTS000__Rx.u32Count = 0U;
+	sTS000__Rx.u32Bad = 0U;
+	sTS000__Rx.u8Keep = 0U;
+	sTS000__Rx.u8KeptCount = 0U;
+	sTS000__Rx.u16ExpectLength = 512U;
+	vTS000__Fill(&sTS000__Rx.u8Expect[0], sTS000__Rx.u16ExpectLength, 5U);
+
+	//a burst of 5 under one interrupt
+	for(u8Counter = 0U; u8Counter < 5U; u8Counter++)
+	{
+		vEMACZC_MOCK__Inject(&sTS000__Rx.u8Expect[0], sTS000__Rx.u16ExpectLength);
+	}
+	vEMACZC_MOCK__Advance(0U);
+	if((sTS000__Rx.u32Count != 5U) || (sTS000__Rx.u32Bad != 0U) || (sEMACZC.sRx.sStats.u8MaxBatch != 5U) ||
+		(u8EMACZC_POOL__Get_Free() != u8Free))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//round the ring a few times one at a time
+	for(u8Counter = 0U; u8Counter < (C_LOCALDEF__LCCM676__RX_DESCRIPTORS * 3U); u8Counter++)
+	{
+		vEMACZC_MOCK__Inject(&sTS000__Rx.u8Expect[0], sTS000__Rx.u16ExpectLength);
+		vEMACZC_MOCK__Advance(0U);
+	}
+	if((sTS000__Rx.u32Count != (5U + (C_LOCALDEF__LCCM676__RX_DESCRIPTORS * 3U))) || (sTS000__Rx.u32Bad != 0U) ||
+		(sEMACZC_MOCK.sStats.u32RxDropped != 0U) || (sEMACZC.sRx.sStats.u32Restarts != 0U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//keep three, the pool gives three in their place
+	sTS000__Rx.u8Keep = 1U;
+	for(u8Counter = 0U; u8Counter < 3U; u8Counter++)
+	{
+		vEMACZC_MOCK__Inject(&sTS000__Rx.u8Expect[0], sTS000__Rx.u16ExpectLength);
+	}
+	vEMACZC_MOCK__Advance(0U);
+	sTS000__Rx.u8Keep = 0U;
+	if((sTS000__Rx.u8KeptCount != 3U) || (u8EMACZC_POOL__Get_Free() != (u8Free - 3U)))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//the kept frames are still intact after more traffic
+		vTS000__Fill(&sTS000__Rx.u8Expect[0], sTS000__Rx.u16ExpectLength, 9U);
+		for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM676__RX_DESCRIPTORS; u8Counter++)
+		{
+			vEMACZC_MOCK__Inject(&sTS000__Rx.u8Expect[0], sTS000__Rx.u16ExpectLength);
+			vEMACZC_MOCK__Advance(0U);
+		}
+		vTS000__Fill(&sTS000__Rx.u8Expect[0], sTS000__Rx.u16ExpectLength, 5U);
+		for(u8Counter = 0U; u8Counter < 3U; u8Counter++)
+		{
+			if(((Luint8 *)u32EMACZC_POOL__Get_Pointer(sTS000__Rx.u8Kept[u8Counter]))[100] != sTS000__Rx.u8Expect[100])
+			{
+				u32Fail++;
+			}
+			else
+			{
+				//fall on
+			}
+			vEMACZC_POOL__Release(sTS000__Rx.u8Kept[u8Counter]);
+		}
+	}
+	if(u8EMACZC_POOL__Get_Free() != u8Free)
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//overrun the ring, the receiver stops on the last one
+	sTS000__Rx.u32Count = 0U;
+	for(u8Counter = 0U; u8Counter < (C_LOCALDEF__LCCM676__RX_DESCRIPTORS + 3U); u8Counter++)
+	{
+		vEMACZC_MOCK__Inject(&sTS000__Rx.u8Expect[0], sTS000__Rx.u16ExpectLength);
+	}
+	vEMACZC_MOCK__Advance(0U);
+	if((sTS000__Rx.u32Count != C_LOCALDEF__LCCM676__RX_DESCRIPTORS) || (sEMACZC_MOCK.sStats.u32RxDropped != 3U) ||
+		(sEMACZC.sRx.sStats.u32Restarts != 1U))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	//and runs again
+	vEMACZC_MOCK__Inject(&sTS000__Rx.u8Expect[0], sTS000__Rx.u16ExpectLength);
+	vEMACZC_MOCK__Advance(0U);
+	if((sTS000__Rx.u32Count != (C_LOCALDEF__LCCM676__RX_DESCRIPTORS + 1U)) || (sTS000__Rx.u32Bad != 0U) ||
+		(sEMACZC_MOCK.sStats.u32BadHDP != 0U) || (u8EMACZC_POOL__Get_Free() != u8Free))
+	{
+		u32Fail++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	vTS000__Result(u32Fail, "LCCM676R0.TS.000.TCASE.004");
+}
+
+/***************************************************************************//**
+ * @brief
+ * Something to tell the frames apart
+ */
+static void vTS000__Fill(Luint8 *pu8Buffer, Luint16 u16Length, Luint8 u8Seed)
+{
+	Luint16 u16Counter;
+
+	for(u16Counter = 0U; u16Counter < u16Length; u16Counter++)
+	{
+		pu8Buffer[u16Counter] = (Luint8)((u16Counter * 7U) + u8Seed);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Run the wire until the ring is empty
+ */
+static void vTS000__Drain(void)
+{
+	Luint32 u32Guard;
+
+	u32Guard = 0U;
+	while((u8EMACZC__Tx_Get_InFlight() != 0U) && (u32Guard < 100000U))
+	{
+		vEMACZC_MOCK__Advance(C_TS000__ISR_STEP_NS);
+		u32Guard++;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Check the last frame on the wire
+ *
+ * @return			0 = match
+ */
+static Luint32 u32TS000__Compare(const Luint8 *pu8Header, Luint16 u16HeaderLength, const Luint8 *pu8Payload, Luint16 u16PayloadLength)
+{
+	Luint32 u32Return;
+	Luint16 u16Counter;
+
+	u32Return = 0U;
+	if(sEMACZC_MOCK.u16FrameLength != (u16HeaderLength + u16PayloadLength))
+	{
+		u32Return = 1U;
+	}
+	else
+	{
+		for(u16Counter = 0U; u16Counter < u16HeaderLength; u16Counter++)
+		{
+			if(sEMACZC_MOCK.u8Frame[u16Counter] != pu8Header[u16Counter])
+			{
+				u32Return = 1U;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		for(u16Counter = 0U; u16Counter < u16PayloadLength; u16Counter++)
+		{
+			if(sEMACZC_MOCK.u8Frame[u16HeaderLength + u16Counter] != pu8Payload[u16Counter])
+			{
+				u32Return = 1U;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+	}
+
+	return u32Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Print the result line
+ */
+static void vTS000__Result(Luint32 u32Fail, const char *pcCase)
+{
+	if(u32Fail == 0U)
+	{
+		printf("PASS:%s\r\n", pcCase);
+	}
+	else
+	{
+		printf("FAIL:%s (%u)\r\n", pcCase, (unsigned int)u32Fail);
+	}
+	DEBUG_PRINT("END\r\n");
+}
+
+#endif //#if C_LOCALDEF__LCCM676__ENABLE_MOCK == 1U
+#endif //#if C_LOCALDEF__LCCM676__ENABLE_TEST_SPEC == 1U
+#endif //#if C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE
+	#error
+#endif
@@ -0,0 +1,292 @@
+/**
+ * @file		EMAC_ZC.H
+ * @brief		Main header for the zero copy EMAC rings
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ */
+
+
+#ifndef _EMAC_ZC_H_
+#define _EMAC_ZC_H_
+	#include <localdef.h>
+	#if C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE == 1U
+
+		/*******************************************************************************
+		Defines
+		*******************************************************************************/
+		/** Size of a pool buffer, a whole frame fits */
+		#define C_EMACZC__POOL_BUFFER_SIZE				(1536U)
+
+		/** Pool index for memory that is not in the pool, e.g. a chained payload */
+		#define C_EMACZC__POOL_NONE						(0xFFU)
+
+		/** Header, payload and a pad up to the minimum frame */
+		#define C_EMACZC__TX_MAX_FRAGMENTS				(3U)
+
+		/** Shortest frame the EMAC may be given, less the CRC */
+		#define C_EMACZC__MIN_FRAME_LENGTH				(60U)
+
+		/** Descriptor flags */
+		#define C_EMACZC__FLAG_SOP						(0x80000000U)
+		#define C_EMACZC__FLAG_EOP						(0x40000000U)
+		#define C_EMACZC__FLAG_OWNER					(0x20000000U)
+		#define C_EMACZC__FLAG_EOQ						(0x10000000U)
+		#define C_EMACZC__FLAG_JABBER					(0x02000000U)
+		#define C_EMACZC__FLAG_OVERSIZE					(0x01000000U)
+		#define C_EMACZC__FLAG_FRAGMENT					(0x00800000U)
+		#define C_EMACZC__FLAG_UNDERSIZED				(0x00400000U)
+		#define C_EMACZC__FLAG_CONTROL					(0x00200000U)
+		#define C_EMACZC__FLAG_OVERRUN					(0x00100000U)
+		#define C_EMACZC__FLAG_CODEERROR				(0x00080000U)
+		#define C_EMACZC__FLAG_ALIGNERROR				(0x00040000U)
+		#define C_EMACZC__FLAG_CRCERROR					(0x00020000U)
+
+
+		/*******************************************************************************
+		Structures
+		*******************************************************************************/
+		/** CPPI descriptor, the same four words the EMAC DMA walks for Tx and Rx */
+		struct _strEMACZC__DESC
+		{
+			/** Next descriptor, 0 = end of the list */
+			volatile struct _strEMACZC__DESC * pNext;
+
+			/** Buffer address */
+			volatile Luint32 u32Buffer;
+
+			/** Offset into the buffer (top 16) and bytes in it (bottom 16) */
+			volatile Luint32 u32Offset_Length;
+
+			/** Flags (top 16) and packet length on the SOP descriptor (bottom 16) */
+			volatile Luint32 u32Flags_Length;
+
+		};
+
+		struct _strEMACZC
+		{
+			/** Packet buffers shared with the stack */
+			struct
+			{
+				/** References held, 0 = free */
+				Luint8 u8Ref[C_LOCALDEF__LCCM676__POOL_BUFFERS];
+
+				/** Where the next alloc starts looking */
+				Luint8 u8Cursor;
+
+				Luint8 u8Free;
+
+				struct
+				{
+					Luint32 u32Allocs;
+					Luint32 u32AllocFails;
+					Luint8 u8LowWater;
+
+				}sStats;
+
+			}sPool;
+
+			/** Transmit ring, only the ISR reclaims and only the main loop fills */
+			struct
+			{
+				/** Pool buffer behind each descriptor */
+				Luint8 u8PoolIndex[C_LOCALDEF__LCCM676__TX_DESCRIPTORS];
+
+				/** Descriptors in the packet, on its SOP descriptor */
+				Luint8 u8Fragments[C_LOCALDEF__LCCM676__TX_DESCRIPTORS];
+
+				/** Next to fill and next to reclaim */
+				Luint8 u8Head;
+				Luint8 u8Tail;
+
+				/** Running counts, each has one writer */
+				volatile Luint32 u32Queued;
+				volatile Luint32 u32Reclaimed;
+
+				/** Last descriptor handed over, new packets link on here */
+				volatile struct _strEMACZC__DESC * pLast;
+
+				struct
+				{
+					Luint32 u32Packets;
+					Luint32 u32RingFull;
+
+					/** EMAC had stopped, the head pointer was written again */
+					Luint32 u32Restarts;
+
+					/** Completion interrupts that found work and the most in one */
+					Luint32 u32Batches;
+					Luint8 u8MaxBatch;
+
+				}sStats;
+
+			}sTx;
+
+			/** Receive ring */
+			struct
+			{
+				Luint8 u8PoolIndex[C_LOCALDEF__LCCM676__RX_DESCRIPTORS];
+
+				/** Next descriptor the EMAC will fill */
+				Luint8 u8Next;
+
+				/** Descriptor being handed up, for the keep */
+				Luint8 u8Current;
+
+				/** Last descriptor on the free chain */
+				volatile struct _strEMACZC__DESC * pTail;
+
+				struct
+				{
+					Luint32 u32Packets;
+					Luint32 u32Errors;
+
+					/** Stack kept the buffer, one from the pool went in its place */
+					Luint32 u32Kept;
+					Luint32 u32KeepRefused;
+
+					Luint32 u32Restarts;
+					Luint32 u32Batches;
+					Luint8 u8MaxBatch;
+
+				}sStats;
+
+			}sRx;
+
+		};
+
+		//software EMAC
+		#if C_LOCALDEF__LCCM676__ENABLE_MOCK == 1U
+		/** What the mock saw */
+		struct _strEMACZC_MOCK
+		{
+			/** CPPI RAM */
+			Luint32 u32CPPI[2048];
+
+			/** Where the DMA is, 0 = stopped */
+			Luint32 u32TxActive;
+			Luint32 u32RxActive;
+
+			/** Wire time left on the frame going out */
+			Luint32 u32TxBusy_ns;
+
+			Luint8 u8TxInt;
+			Luint8 u8RxInt;
+
+			/** Last frame out */
+			Luint8 u8Frame[C_EMACZC__POOL_BUFFER_SIZE];
+			Luint16 u16FrameLength;
+
+			struct
+			{
+				Luint64 u64Time_ns;
+				Luint32 u32TxFrames;
+				Luint64 u64TxBytes;
+
+				/** Bytes that came out of pool buffers and from elsewhere */
+				Luint64 u64PoolBytes;
+				Luint64 u64InPlaceBytes;
+
+				/** Packet length did not match the fragments */
+				Luint32 u32Malformed;
+
+				/** Head pointer written while the channel was running */
+				Luint32 u32BadHDP;
+
+				Luint32 u32TxCP;
+				Luint32 u32RxFrames;
+				Luint32 u32RxDropped;
+
+			}sStats;
+
+		};
+		#endif //#if C_LOCALDEF__LCCM676__ENABLE_MOCK == 1U
+
+
+		/*******************************************************************************
+		Function Prototypes
+		*******************************************************************************/
+		void vEMACZC_POOL__Init(void);
+		Lint16 s16EMACZC_POOL__Alloc(void);
+		Lint16 s16EMACZC_POOL__Alloc_FromISR(void);
+		void vEMACZC_POOL__Ref(Luint8 u8Index);
+		void vEMACZC_POOL__Release(Luint8 u8Index);
+		void vEMACZC_POOL__Release_FromISR(Luint8 u8Index);
+		Luint8 u8EMACZC_POOL__Get_Ref(Luint8 u8Index);
+		Luint8 u8EMACZC_POOL__Get_Free(void);
+		Luint32 u32EMACZC_POOL__Get_Pointer(Luint8 u8Index);
+
+		void vEMACZC__Init(void);
+		Lint16 s16EMACZC__Tx_Packet(Luint8 u8PoolIndex, Luint16 u16Length);
+		Lint16 s16EMACZC__Tx_Chain(Luint8 u8PoolIndex, Luint16 u16HeaderLength, Luint32 u32PayloadAddx, Luint16 u16PayloadLength);
+		void vEMACZC__TxISR(void);
+		void vEMACZC__RxISR(void);
+		Luint8 u8EMACZC__Rx_Keep(void);
+		Luint8 u8EMACZC__Tx_Get_InFlight(void);
+
+		#if C_LOCALDEF__LCCM676__ENABLE_MOCK == 1U
+			void vEMACZC_MOCK__Init(void);
+			void vEMACZC_MOCK__Advance(Luint32 u32Time_ns);
+			void vEMACZC_MOCK__Inject(const Luint8 *pu8Frame, Luint16 u16Length);
+			void vEMACZC_MOCK__Write_TxHDP(Luint32 u32Addx);
+			void vEMACZC_MOCK__Write_TxCP(Luint32 u32Addx);
+			void vEMACZC_MOCK__Write_RxHDP(Luint32 u32Addx);
+			void vEMACZC_MOCK__Write_RxCP(Luint32 u32Addx);
+			Luint32 u32EMACZC_MOCK__Get_CPPI(void);
+		#endif
+
+		//testing
+		#if C_LOCALDEF__LCCM676__ENABLE_TEST_SPEC == 1U
+			#if C_LOCALDEF__LCCM676__ENABLE_MOCK == 1U
+				DLL_DECLARATION void vLCCM676R0_TS_000(void);
+				void vLCCM676R0_TS_000__Rx(Luint8 *pu8Buffer, Luint16 u16Length, Luint8 u8PoolIndex);
+			#endif
+		#endif
+
+		//safetys
+		#ifndef C_LOCALDEF__LCCM676__POOL_BUFFERS
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM676__TX_DESCRIPTORS
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM676__RX_DESCRIPTORS
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM676__DESC_BASE
+			#error
+		#endif
+		#ifndef M_LOCALDEF__LCCM676__TX_HDP
+			#error
+		#endif
+		#ifndef M_LOCALDEF__LCCM676__TX_CP
+			#error
+		#endif
+		#ifndef M_LOCALDEF__LCCM676__RX_HDP
+			#error
+		#endif
+		#ifndef M_LOCALDEF__LCCM676__RX_CP
+			#error
+		#endif
+		#ifndef M_LOCALDEF__LCCM676__RX_PACKET
+			#error
+		#endif
+		#ifndef M_LOCALDEF__LCCM676__LOCK
+			#error
+		#endif
+		#ifndef M_LOCALDEF__LCCM676__UNLOCK
+			#error
+		#endif
+		#ifndef C_LOCALDEF__LCCM676__ENABLE_MOCK
+			#error
+		#endif
+		#if C_LOCALDEF__LCCM676__ENABLE_MOCK != 1U
+			#error "Host only, nothing calls the ring ISR's from the EMAC interrupts yet"
+		#endif
+
+	#endif //#if C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE == 1U
+	//safetys
+	#ifndef C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE
+		#error
+	#endif
+#endif //_EMAC_ZC_H_
+
@@ -0,0 +1,49 @@
+/**
+ * @file		EMAC_ZC__LOCALDEF.H
+ * @brief		Localdef template
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM676R0.FILE.003
+ */
+
+#if 0
+
+/*******************************************************************************
+RLOOP - ZERO COPY EMAC RINGS
+*******************************************************************************/
+	#define C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE							(1U)
+	#if C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE == 1U
+
+		/** Pool buffers shared with the stack, more than the Rx descriptors */
+		#define C_LOCALDEF__LCCM676__POOL_BUFFERS							(20U)
+		#define C_LOCALDEF__LCCM676__TX_DESCRIPTORS							(32U)
+		#define C_LOCALDEF__LCCM676__RX_DESCRIPTORS							(8U)
+
+		/** Where the descriptors live, Tx then Rx, the mock's CPPI RAM */
+		#define C_LOCALDEF__LCCM676__DESC_BASE								(u32EMACZC_MOCK__Get_CPPI())
+
+		/** Channel 0 head and completion pointers */
+		#define M_LOCALDEF__LCCM676__TX_HDP(addx)							vEMACZC_MOCK__Write_TxHDP(addx)
+		#define M_LOCALDEF__LCCM676__TX_CP(addx)							vEMACZC_MOCK__Write_TxCP(addx)
+		#define M_LOCALDEF__LCCM676__RX_HDP(addx)							vEMACZC_MOCK__Write_RxHDP(addx)
+		#define M_LOCALDEF__LCCM676__RX_CP(addx)							vEMACZC_MOCK__Write_RxCP(addx)
+
+		/** Frame up to the stack from the Rx ISR, call u8EMACZC__Rx_Keep() to hold on to it */
+		#define M_LOCALDEF__LCCM676__RX_PACKET(buffer,length,index)			vLCCM676R0_TS_000__Rx(buffer, length, index)
+
+		/** Keeps the Tx and Rx ISR's off the pool, nothing to do on the host */
+		#define M_LOCALDEF__LCCM676__LOCK()
+		#define M_LOCALDEF__LCCM676__UNLOCK()
+
+		/** Software EMAC, host only, must be on */
+		#define C_LOCALDEF__LCCM676__ENABLE_MOCK							(1U)
+
+		/** Testing Options */
+		#define C_LOCALDEF__LCCM676__ENABLE_TEST_SPEC						(1U)
+
+		/** Main include file */
+		#include <LCCM676__RLOOP__EMAC_ZC/emac_zc.h>
+	#endif //#if C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE == 1U
+
+#endif //#if 0
+
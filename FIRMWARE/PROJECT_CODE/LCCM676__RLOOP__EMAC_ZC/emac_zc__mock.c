@@ -0,0 +1,375 @@
+/**
+ * @file		EMAC_ZC__MOCK.C
+ * @brief		Software EMAC for running the zero copy rings on a host
+ *
+ * @note
+ * Walks the Tx descriptor list like the EMAC DMA does, one frame at a time at
+ * 100Mbit with the preamble and gap, clears the owner flag, sets EOQ when it
+ * runs off the end and raises the Tx interrupt. Frames injected on the Rx side
+ * are put into the free descriptors the same way.
+ *
+ * The interrupt is taken at the end of each advance, so the advance step is the
+ * interrupt latency and several frames can finish under one interrupt.
+ *
+ * Each frame on the wire is gathered up so a test can check it, and the bytes
+ * are split by where they came from: a pool buffer (the stack had to put them
+ * there) or straight from the caller's memory (zero copy).
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM676R0.FILE.002
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup EMACZC
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup EMACZC__MOCK
+ * @ingroup EMACZC
+ * @{ */
+
+#include "emac_zc.h"
+#if C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE == 1U
+#if C_LOCALDEF__LCCM676__ENABLE_MOCK == 1U
+
+/** Wire time of a byte at 100Mbit */
+#define C_EMACZC_MOCK__NS_PER_BYTE		(80U)
+
+/** Preamble, SFD, CRC and the inter frame gap */
+#define C_EMACZC_MOCK__OVERHEAD_BYTES		(24U)
+
+struct _strEMACZC_MOCK sEMACZC_MOCK;
+
+//locals
+static void vEMACZC_MOCK__Tx_Complete(void);
+
+
+/***************************************************************************//**
+ * @brief
+ * Stopped, nothing on the wire
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.002.FUNC.001
+ */
+void vEMACZC_MOCK__Init(void)
+{
+	sEMACZC_MOCK.u32TxActive = 0U;
+	sEMACZC_MOCK.u32RxActive = 0U;
+	sEMACZC_MOCK.u32TxBusy_ns = 0U;
+	sEMACZC_MOCK.u8TxInt = 0U;
+	sEMACZC_MOCK.u8RxInt = 0U;
+	sEMACZC_MOCK.u16FrameLength = 0U;
+	sEMACZC_MOCK.sStats.u64Time_ns = 0U;
+	sEMACZC_MOCK.sStats.u32TxFrames = 0U;
+	sEMACZC_MOCK.sStats.u64TxBytes = 0U;
+	sEMACZC_MOCK.sStats.u64PoolBytes = 0U;
+	sEMACZC_MOCK.sStats.u64InPlaceBytes = 0U;
+	sEMACZC_MOCK.sStats.u32Malformed = 0U;
+	sEMACZC_MOCK.sStats.u32BadHDP = 0U;
+	sEMACZC_MOCK.sStats.u32TxCP = 0U;
+	sEMACZC_MOCK.sStats.u32RxFrames = 0U;
+	sEMACZC_MOCK.sStats.u32RxDropped = 0U;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Run the wire, then take any interrupt that came up
+ *
+ * @param[in]		u32Time_ns				Time to run
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.002.FUNC.002
+ */
+void vEMACZC_MOCK__Advance(Luint32 u32Time_ns)
+{
+	volatile struct _strEMACZC__DESC *pDesc;
+	Luint32 u32Step;
+
+	while((u32Time_ns > 0U) && (sEMACZC_MOCK.u32TxActive != 0U))
+	{
+		if(sEMACZC_MOCK.u32TxBusy_ns == 0U)
+		{
+			//start the next frame
+			pDesc = (volatile struct _strEMACZC__DESC *)sEMACZC_MOCK.u32TxActive;
+			sEMACZC_MOCK.u32TxBusy_ns = ((pDesc->u32Flags_Length & 0x0000FFFFU) + C_EMACZC_MOCK__OVERHEAD_BYTES) * C_EMACZC_MOCK__NS_PER_BYTE;
+		}
+		else
+		{
+			//fall on
+		}
+
+		u32Step = sEMACZC_MOCK.u32TxBusy_ns;
+		if(u32Step > u32Time_ns)
+		{
+			u32Step = u32Time_ns;
+		}
+		else
+		{
+			//fall on
+		}
+		sEMACZC_MOCK.u32TxBusy_ns -= u32Step;
+		u32Time_ns -= u32Step;
+		sEMACZC_MOCK.sStats.u64Time_ns += u32Step;
+
+		if(sEMACZC_MOCK.u32TxBusy_ns == 0U)
+		{
+			vEMACZC_MOCK__Tx_Complete();
+		}
+		else
+		{
+			//still going
+		}
+	}
+	sEMACZC_MOCK.sStats.u64Time_ns += u32Time_ns;
+
+	if(sEMACZC_MOCK.u8TxInt == 1U)
+	{
+		sEMACZC_MOCK.u8TxInt = 0U;
+		vEMACZC__TxISR();
+	}
+	else
+	{
+		//fall on
+	}
+
+	if(sEMACZC_MOCK.u8RxInt == 1U)
+	{
+		sEMACZC_MOCK.u8RxInt = 0U;
+		vEMACZC__RxISR();
+	}
+	else
+	{
+		//fall on
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * A frame arrives
+ *
+ * @param[in]		u16Length				Length less the CRC
+ * @param[in]		pu8Frame				Frame
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.002.FUNC.003
+ */
+void vEMACZC_MOCK__Inject(const Luint8 *pu8Frame, Luint16 u16Length)
+{
+	volatile struct _strEMACZC__DESC *pDesc;
+	Luint8 *pu8Buffer;
+	Luint16 u16Counter;
+	Luint32 u32Flags;
+
+	if(sEMACZC_MOCK.u32RxActive != 0U)
+	{
+		pDesc = (volatile struct _strEMACZC__DESC *)sEMACZC_MOCK.u32RxActive;
+
+		//the DMA, not the CPU
+		pu8Buffer = (Luint8 *)pDesc->u32Buffer;
+		for(u16Counter = 0U; u16Counter < u16Length; u16Counter++)
+		{
+			pu8Buffer[u16Counter] = pu8Frame[u16Counter];
+		}
+
+		pDesc->u32Offset_Length = u16Length;
+		u32Flags = C_EMACZC__FLAG_SOP | C_EMACZC__FLAG_EOP | (Luint32)u16Length;
+		if(pDesc->pNext == 0)
+		{
+			u32Flags |= C_EMACZC__FLAG_EOQ;
+			sEMACZC_MOCK.u32RxActive = 0U;
+		}
+		else
+		{
+			sEMACZC_MOCK.u32RxActive = (Luint32)pDesc->pNext;
+		}
+		pDesc->u32Flags_Length = u32Flags;
+
+		sEMACZC_MOCK.sStats.u32RxFrames++;
+		sEMACZC_MOCK.u8RxInt = 1U;
+	}
+	else
+	{
+		//no free descriptor
+		sEMACZC_MOCK.sStats.u32RxDropped++;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Tx head descriptor pointer
+ *
+ * @param[in]		u32Addx					First descriptor
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.002.FUNC.004
+ */
+void vEMACZC_MOCK__Write_TxHDP(Luint32 u32Addx)
+{
+	if(sEMACZC_MOCK.u32TxActive != 0U)
+	{
+		sEMACZC_MOCK.sStats.u32BadHDP++;
+	}
+	else
+	{
+		sEMACZC_MOCK.u32TxActive = u32Addx;
+		sEMACZC_MOCK.u32TxBusy_ns = 0U;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Tx completion pointer
+ *
+ * @param[in]		u32Addx					Last descriptor processed
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.002.FUNC.005
+ */
+void vEMACZC_MOCK__Write_TxCP(Luint32 u32Addx)
+{
+	sEMACZC_MOCK.sStats.u32TxCP++;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Rx head descriptor pointer
+ *
+ * @param[in]		u32Addx					First free descriptor
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.002.FUNC.006
+ */
+void vEMACZC_MOCK__Write_RxHDP(Luint32 u32Addx)
+{
+	if(sEMACZC_MOCK.u32RxActive != 0U)
+	{
+		sEMACZC_MOCK.sStats.u32BadHDP++;
+	}
+	else
+	{
+		sEMACZC_MOCK.u32RxActive = u32Addx;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Rx completion pointer
+ *
+ * @param[in]		u32Addx					Last descriptor processed
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.002.FUNC.007
+ */
+void vEMACZC_MOCK__Write_RxCP(Luint32 u32Addx)
+{
+	//nothing to do
+}
+
+/***************************************************************************//**
+ * @brief
+ * Where the descriptors go
+ *
+ * @return			CPPI RAM
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.002.FUNC.008
+ */
+Luint32 u32EMACZC_MOCK__Get_CPPI(void)
+{
+	return (Luint32)&sEMACZC_MOCK.u32CPPI[0];
+}
+
+/***************************************************************************//**
+ * @brief
+ * The frame on the wire is done, gather it up and hand the descriptors back
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.002.FUNC.009
+ */
+static void vEMACZC_MOCK__Tx_Complete(void)
+{
+	volatile struct _strEMACZC__DESC *pSOP;
+	volatile struct _strEMACZC__DESC *pDesc;
+	Luint8 *pu8Buffer;
+	Luint32 u32PoolStart;
+	Luint32 u32PoolEnd;
+	Luint32 u32Length;
+	Luint32 u32Total;
+	Luint32 u32Counter;
+	Luint8 u8Stop;
+
+	u32PoolStart = u32EMACZC_POOL__Get_Pointer(0U);
+	u32PoolEnd = u32PoolStart + (C_LOCALDEF__LCCM676__POOL_BUFFERS * C_EMACZC__POOL_BUFFER_SIZE);
+
+	pSOP = (volatile struct _strEMACZC__DESC *)sEMACZC_MOCK.u32TxActive;
+	pDesc = pSOP;
+	u32Total = 0U;
+	u8Stop = 0U;
+	while(u8Stop == 0U)
+	{
+		u32Length = pDesc->u32Offset_Length & 0x0000FFFFU;
+		pu8Buffer = (Luint8 *)(pDesc->u32Buffer + (pDesc->u32Offset_Length >> 16U));
+		for(u32Counter = 0U; (u32Counter < u32Length) && ((u32Total + u32Counter) < C_EMACZC__POOL_BUFFER_SIZE); u32Counter++)
+		{
+			sEMACZC_MOCK.u8Frame[u32Total + u32Counter] = pu8Buffer[u32Counter];
+		}
+
+		if((pDesc->u32Buffer >= u32PoolStart) && (pDesc->u32Buffer < u32PoolEnd))
+		{
+			sEMACZC_MOCK.sStats.u64PoolBytes += u32Length;
+		}
+		else
+		{
+			sEMACZC_MOCK.sStats.u64InPlaceBytes += u32Length;
+		}
+		u32Total += u32Length;
+
+		if((pDesc->u32Flags_Length & C_EMACZC__FLAG_EOP) != 0U)
+		{
+			u8Stop = 1U;
+		}
+		else if(pDesc->pNext == 0)
+		{
+			//no EOP
+			sEMACZC_MOCK.sStats.u32Malformed++;
+			u8Stop = 1U;
+		}
+		else
+		{
+			pDesc = pDesc->pNext;
+		}
+	}
+
+	if(u32Total != (pSOP->u32Flags_Length & 0x0000FFFFU))
+	{
+		sEMACZC_MOCK.sStats.u32Malformed++;
+	}
+	else
+	{
+		//fall on
+	}
+	sEMACZC_MOCK.u16FrameLength = (Luint16)u32Total;
+	sEMACZC_MOCK.sStats.u32TxFrames++;
+	sEMACZC_MOCK.sStats.u64TxBytes += u32Total;
+
+	//run on or stop
+	if(pDesc->pNext == 0)
+	{
+		pDesc->u32Flags_Length |= C_EMACZC__FLAG_EOQ;
+		sEMACZC_MOCK.u32TxActive = 0U;
+	}
+	else
+	{
+		sEMACZC_MOCK.u32TxActive = (Luint32)pDesc->pNext;
+	}
+	pSOP->u32Flags_Length &= ~C_EMACZC__FLAG_OWNER;
+
+	sEMACZC_MOCK.u8TxInt = 1U;
+}
+
+
+#endif //#if C_LOCALDEF__LCCM676__ENABLE_MOCK == 1U
+#endif //#if C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
@@ -0,0 +1,293 @@
+/**
+ * @file		EMAC_ZC__POOL.C
+ * @brief		Packet buffer pool shared by the EMAC and the stack
+ *
+ * @note
+ * Every buffer holds a whole frame. A buffer has a reference count, the alloc
+ * gives the caller one reference and the buffer goes back to the pool when the
+ * last one is released. The Tx ring takes over the reference of a buffer it is
+ * given and releases it when the EMAC is done with it, anything else that wants
+ * to keep the buffer (a retransmit, a second destination) takes its own.
+ *
+ * The main loop versions lock out the EMAC ISR's, the _FromISR versions are for
+ * use inside them.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM676R0.FILE.000
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup EMACZC
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup EMACZC__POOL
+ * @ingroup EMACZC
+ * @{ */
+
+#include "emac_zc.h"
+#if C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE == 1U
+
+//the structure
+struct _strEMACZC sEMACZC;
+
+//the buffers, words so the EMAC gets them aligned
+static Luint32 u32EMACZC_POOL__Memory[C_LOCALDEF__LCCM676__POOL_BUFFERS][C_EMACZC__POOL_BUFFER_SIZE / 4U];
+
+
+/***************************************************************************//**
+ * @brief
+ * Every buffer free
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.000.FUNC.001
+ */
+void vEMACZC_POOL__Init(void)
+{
+	Luint8 u8Counter;
+
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM676__POOL_BUFFERS; u8Counter++)
+	{
+		sEMACZC.sPool.u8Ref[u8Counter] = 0U;
+	}
+	sEMACZC.sPool.u8Cursor = 0U;
+	sEMACZC.sPool.u8Free = C_LOCALDEF__LCCM676__POOL_BUFFERS;
+	sEMACZC.sPool.sStats.u32Allocs = 0U;
+	sEMACZC.sPool.sStats.u32AllocFails = 0U;
+	sEMACZC.sPool.sStats.u8LowWater = C_LOCALDEF__LCCM676__POOL_BUFFERS;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Take a buffer from the main loop
+ *
+ * @return			-1 = pool empty\n
+ *					else the buffer index, holding one reference
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.000.FUNC.002
+ */
+Lint16 s16EMACZC_POOL__Alloc(void)
+{
+	Lint16 s16Return;
+
+	M_LOCALDEF__LCCM676__LOCK();
+	s16Return = s16EMACZC_POOL__Alloc_FromISR();
+	M_LOCALDEF__LCCM676__UNLOCK();
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Take a buffer, interrupts already locked out
+ *
+ * @return			-1 = pool empty\n
+ *					else the buffer index, holding one reference
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.000.FUNC.003
+ */
+Lint16 s16EMACZC_POOL__Alloc_FromISR(void)
+{
+	Lint16 s16Return;
+	Luint8 u8Counter;
+	Luint8 u8Index;
+
+	s16Return = -1;
+	if(sEMACZC.sPool.u8Free > 0U)
+	{
+		//carry on from the last one so the buffers wear evenly and a freed
+		//buffer is not handed straight back out
+		u8Index = sEMACZC.sPool.u8Cursor;
+		for(u8Counter = 0U; (u8Counter < C_LOCALDEF__LCCM676__POOL_BUFFERS) && (s16Return < 0); u8Counter++)
+		{
+			if(sEMACZC.sPool.u8Ref[u8Index] == 0U)
+			{
+				sEMACZC.sPool.u8Ref[u8Index] = 1U;
+				s16Return = (Lint16)u8Index;
+			}
+			else
+			{
+				//in use
+			}
+
+			u8Index++;
+			if(u8Index >= C_LOCALDEF__LCCM676__POOL_BUFFERS)
+			{
+				u8Index = 0U;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		sEMACZC.sPool.u8Cursor = u8Index;
+	}
+	else
+	{
+		//empty
+	}
+
+	if(s16Return >= 0)
+	{
+		sEMACZC.sPool.u8Free--;
+		sEMACZC.sPool.sStats.u32Allocs++;
+		if(sEMACZC.sPool.u8Free < sEMACZC.sPool.sStats.u8LowWater)
+		{
+			sEMACZC.sPool.sStats.u8LowWater = sEMACZC.sPool.u8Free;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	else
+	{
+		sEMACZC.sPool.sStats.u32AllocFails++;
+	}
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Take another reference on a buffer already held
+ *
+ * @param[in]		u8Index					Buffer
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.000.FUNC.004
+ */
+void vEMACZC_POOL__Ref(Luint8 u8Index)
+{
+	if(u8Index < C_LOCALDEF__LCCM676__POOL_BUFFERS)
+	{
+		M_LOCALDEF__LCCM676__LOCK();
+		if(sEMACZC.sPool.u8Ref[u8Index] > 0U)
+		{
+			sEMACZC.sPool.u8Ref[u8Index]++;
+		}
+		else
+		{
+			//not held, can't be ref'd
+		}
+		M_LOCALDEF__LCCM676__UNLOCK();
+	}
+	else
+	{
+		//not pool memory
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Drop a reference from the main loop
+ *
+ * @param[in]		u8Index					Buffer, C_EMACZC__POOL_NONE is ignored
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.000.FUNC.005
+ */
+void vEMACZC_POOL__Release(Luint8 u8Index)
+{
+	M_LOCALDEF__LCCM676__LOCK();
+	vEMACZC_POOL__Release_FromISR(u8Index);
+	M_LOCALDEF__LCCM676__UNLOCK();
+}
+
+/***************************************************************************//**
+ * @brief
+ * Drop a reference, interrupts already locked out
+ *
+ * @param[in]		u8Index					Buffer, C_EMACZC__POOL_NONE is ignored
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.000.FUNC.006
+ */
+void vEMACZC_POOL__Release_FromISR(Luint8 u8Index)
+{
+	if(u8Index < C_LOCALDEF__LCCM676__POOL_BUFFERS)
+	{
+		if(sEMACZC.sPool.u8Ref[u8Index] > 0U)
+		{
+			sEMACZC.sPool.u8Ref[u8Index]--;
+			if(sEMACZC.sPool.u8Ref[u8Index] == 0U)
+			{
+				sEMACZC.sPool.u8Free++;
+			}
+			else
+			{
+				//still held
+			}
+		}
+		else
+		{
+			//double release, leave it free
+		}
+	}
+	else
+	{
+		//not pool memory
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * References held on a buffer
+ *
+ * @param[in]		u8Index					Buffer
+ * @return			0 = free
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.000.FUNC.007
+ */
+Luint8 u8EMACZC_POOL__Get_Ref(Luint8 u8Index)
+{
+	Luint8 u8Return;
+
+	if(u8Index < C_LOCALDEF__LCCM676__POOL_BUFFERS)
+	{
+		u8Return = sEMACZC.sPool.u8Ref[u8Index];
+	}
+	else
+	{
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Buffers left in the pool
+ *
+ * @return			Free buffers
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.000.FUNC.008
+ */
+Luint8 u8EMACZC_POOL__Get_Free(void)
+{
+	return sEMACZC.sPool.u8Free;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Where a buffer is
+ *
+ * @param[in]		u8Index					Buffer
+ * @return			Address of the first byte
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.000.FUNC.009
+ */
+Luint32 u32EMACZC_POOL__Get_Pointer(Luint8 u8Index)
+{
+	return (Luint32)&u32EMACZC_POOL__Memory[u8Index][0];
+}
+
+
+#endif //#if C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
@@ -0,0 +1,636 @@
+/**
+ * @file		EMAC_ZC__RING.C
+ * @brief		Zero copy Tx and Rx descriptor rings over the packet pool
+ *
+ * @note
+ * Tx: the stack builds the frame in a pool buffer and hands the buffer over,
+ * a payload that lives somewhere else is chained on as a second descriptor so
+ * it is never copied. Packets are linked onto the end of the active list, if
+ * the EMAC had already stopped the head pointer is written again. The Tx
+ * interrupt walks every packet the EMAC has finished, hands the buffers back
+ * to the pool and writes the completion pointer once for the lot.
+ *
+ * Rx: every descriptor has a pool buffer. The Rx interrupt hands each frame up
+ * in place, then gives all the descriptors it took back to the EMAC as one
+ * chain. If the stack wants to hold on to a frame it calls
+ * u8EMACZC__Rx_Keep() and the descriptor gets a fresh buffer instead.
+ *
+ * Only the main loop fills the Tx ring and only the Tx interrupt reclaims it,
+ * each keeps its own count so neither has to lock the other out.
+ *
+ * Host only for now. The LCCM254 EMAC driver sources are not in this tree, so
+ * there is no interrupt handler to call vEMACZC__TxISR() / vEMACZC__RxISR()
+ * from and no buffer init for vEMACZC__Init() to replace. The rings only run
+ * against the software EMAC (emac_zc__mock.c) and no board links the module.
+ *
+ * @author		Lachlan Grogan
+ * @copyright	rLoop Inc.
+ * @st_fileID	LCCM676R0.FILE.001
+ */
+/**
+ * @addtogroup RLOOP
+ * @{ */
+/**
+ * @addtogroup EMACZC
+ * @ingroup RLOOP
+ * @{ */
+/**
+ * @addtogroup EMACZC__RING
+ * @ingroup EMACZC
+ * @{ */
+
+#include "emac_zc.h"
+#if C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE == 1U
+
+extern struct _strEMACZC sEMACZC;
+
+//locals
+static Lint16 s16EMACZC__Tx_Queue(const Luint32 *pu32Addx, const Luint16 *pu16Length, const Luint8 *pu8PoolIndex, Luint8 u8Count);
+
+/** Rx flags that mean the frame is no good */
+#define C_EMACZC__RX_ERROR_FLAGS		(C_EMACZC__FLAG_JABBER | C_EMACZC__FLAG_OVERSIZE | C_EMACZC__FLAG_FRAGMENT | C_EMACZC__FLAG_UNDERSIZED | \
+											C_EMACZC__FLAG_CONTROL | C_EMACZC__FLAG_OVERRUN | C_EMACZC__FLAG_CODEERROR | C_EMACZC__FLAG_ALIGNERROR | \
+											C_EMACZC__FLAG_CRCERROR)
+
+/** Descriptors, Tx first then Rx */
+#define M_EMACZC__TX_BD(x)				(&((volatile struct _strEMACZC__DESC *)C_LOCALDEF__LCCM676__DESC_BASE)[x])
+#define M_EMACZC__RX_BD(x)				(&((volatile struct _strEMACZC__DESC *)(C_LOCALDEF__LCCM676__DESC_BASE + (C_LOCALDEF__LCCM676__TX_DESCRIPTORS * sizeof(struct _strEMACZC__DESC))))[x])
+
+//what short chained frames are padded out with
+static const Luint8 u8EMACZC__Pad[C_EMACZC__MIN_FRAME_LENGTH] = {0U};
+
+
+/***************************************************************************//**
+ * @brief
+ * Set up the pool and both rings, start the receiver. Call once the EMAC is
+ * set up, in place of the fixed buffer descriptor init.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.001.FUNC.001
+ */
+void vEMACZC__Init(void)
+{
+	Luint8 u8Counter;
+	Lint16 s16Index;
+	volatile struct _strEMACZC__DESC *pRx;
+
+	vEMACZC_POOL__Init();
+
+	//Tx, nothing on it
+	sEMACZC.sTx.u8Head = 0U;
+	sEMACZC.sTx.u8Tail = 0U;
+	sEMACZC.sTx.u32Queued = 0U;
+	sEMACZC.sTx.u32Reclaimed = 0U;
+	sEMACZC.sTx.pLast = 0;
+	sEMACZC.sTx.sStats.u32Packets = 0U;
+	sEMACZC.sTx.sStats.u32RingFull = 0U;
+	sEMACZC.sTx.sStats.u32Restarts = 0U;
+	sEMACZC.sTx.sStats.u32Batches = 0U;
+	sEMACZC.sTx.sStats.u8MaxBatch = 0U;
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM676__TX_DESCRIPTORS; u8Counter++)
+	{
+		sEMACZC.sTx.u8PoolIndex[u8Counter] = C_EMACZC__POOL_NONE;
+		sEMACZC.sTx.u8Fragments[u8Counter] = 0U;
+	}
+
+	//Rx, a buffer on every descriptor and one long chain
+	for(u8Counter = 0U; u8Counter < C_LOCALDEF__LCCM676__RX_DESCRIPTORS; u8Counter++)
+	{
+		s16Index = s16EMACZC_POOL__Alloc_FromISR();
+		sEMACZC.sRx.u8PoolIndex[u8Counter] = (Luint8)s16Index;
+
+		pRx = M_EMACZC__RX_BD(u8Counter);
+		if(u8Counter < (C_LOCALDEF__LCCM676__RX_DESCRIPTORS - 1U))
+		{
+			pRx->pNext = M_EMACZC__RX_BD(u8Counter + 1U);
+		}
+		else
+		{
+			pRx->pNext = 0;
+		}
+		pRx->u32Buffer = u32EMACZC_POOL__Get_Pointer((Luint8)s16Index);
+		pRx->u32Offset_Length = C_EMACZC__POOL_BUFFER_SIZE;
+		pRx->u32Flags_Length = C_EMACZC__FLAG_OWNER;
+	}
+	sEMACZC.sRx.u8Next = 0U;
+	sEMACZC.sRx.u8Current = 0U;
+	sEMACZC.sRx.pTail = M_EMACZC__RX_BD(C_LOCALDEF__LCCM676__RX_DESCRIPTORS - 1U);
+	sEMACZC.sRx.sStats.u32Packets = 0U;
+	sEMACZC.sRx.sStats.u32Errors = 0U;
+	sEMACZC.sRx.sStats.u32Kept = 0U;
+	sEMACZC.sRx.sStats.u32KeepRefused = 0U;
+	sEMACZC.sRx.sStats.u32Restarts = 0U;
+	sEMACZC.sRx.sStats.u32Batches = 0U;
+	sEMACZC.sRx.sStats.u8MaxBatch = 0U;
+
+	M_LOCALDEF__LCCM676__RX_HDP((Luint32)M_EMACZC__RX_BD(0U));
+}
+
+/***************************************************************************//**
+ * @brief
+ * Send a frame built in a pool buffer. On success the ring owns the caller's
+ * reference and releases it once the frame is out.
+ *
+ * @param[in]		u16Length				Frame length less the CRC
+ * @param[in]		u8PoolIndex				Pool buffer
+ * @return			-1 = ring full, the caller still holds the buffer\n
+ *					0 = queued
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.001.FUNC.002
+ */
+Lint16 s16EMACZC__Tx_Packet(Luint8 u8PoolIndex, Luint16 u16Length)
+{
+	Lint16 s16Return;
+	Luint32 u32Addx[1];
+	Luint16 u16Lengths[1];
+	Luint8 u8Pool[1];
+
+	//pool buffers are big enough to pad in place
+	if(u16Length < C_EMACZC__MIN_FRAME_LENGTH)
+	{
+		u16Length = C_EMACZC__MIN_FRAME_LENGTH;
+	}
+	else
+	{
+		//fall on
+	}
+
+	u32Addx[0] = u32EMACZC_POOL__Get_Pointer(u8PoolIndex);
+	u16Lengths[0] = u16Length;
+	u8Pool[0] = u8PoolIndex;
+
+	s16Return = s16EMACZC__Tx_Queue(&u32Addx[0], &u16Lengths[0], &u8Pool[0], 1U);
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Send the headers in a pool buffer with a payload chained on from where it
+ * sits. The payload must stay put until the frame is out, see
+ * u8EMACZC__Tx_Get_InFlight().
+ *
+ * @param[in]		u16PayloadLength		Payload length
+ * @param[in]		u32PayloadAddx			Payload, any alignment
+ * @param[in]		u16HeaderLength			Bytes in the pool buffer
+ * @param[in]		u8PoolIndex				Pool buffer with the headers
+ * @return			-1 = ring full, the caller still holds the buffer\n
+ *					0 = queued
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.001.FUNC.003
+ */
+Lint16 s16EMACZC__Tx_Chain(Luint8 u8PoolIndex, Luint16 u16HeaderLength, Luint32 u32PayloadAddx, Luint16 u16PayloadLength)
+{
+	Lint16 s16Return;
+	Luint32 u32Addx[C_EMACZC__TX_MAX_FRAGMENTS];
+	Luint16 u16Lengths[C_EMACZC__TX_MAX_FRAGMENTS];
+	Luint8 u8Pool[C_EMACZC__TX_MAX_FRAGMENTS];
+	Luint8 u8Count;
+	Luint16 u16Total;
+
+	u32Addx[0] = u32EMACZC_POOL__Get_Pointer(u8PoolIndex);
+	u16Lengths[0] = u16HeaderLength;
+	u8Pool[0] = u8PoolIndex;
+	u8Count = 1U;
+
+	if(u16PayloadLength > 0U)
+	{
+		u32Addx[1] = u32PayloadAddx;
+		u16Lengths[1] = u16PayloadLength;
+		u8Pool[1] = C_EMACZC__POOL_NONE;
+		u8Count = 2U;
+	}
+	else
+	{
+		//headers only
+	}
+
+	//we can't pad on the end of someone else's memory
+	u16Total = u16HeaderLength + u16PayloadLength;
+	if(u16Total < C_EMACZC__MIN_FRAME_LENGTH)
+	{
+		u32Addx[u8Count] = (Luint32)&u8EMACZC__Pad[0];
+		u16Lengths[u8Count] = C_EMACZC__MIN_FRAME_LENGTH - u16Total;
+		u8Pool[u8Count] = C_EMACZC__POOL_NONE;
+		u8Count++;
+	}
+	else
+	{
+		//fall on
+	}
+
+	s16Return = s16EMACZC__Tx_Queue(&u32Addx[0], &u16Lengths[0], &u8Pool[0], u8Count);
+
+	return s16Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Tx completion interrupt. Reclaims every packet the EMAC has finished and
+ * acks the lot with one completion pointer write.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.001.FUNC.004
+ */
+void vEMACZC__TxISR(void)
+{
+	volatile struct _strEMACZC__DESC *pDesc;
+	volatile struct _strEMACZC__DESC *pDone;
+	Luint8 u8Stop;
+	Luint8 u8Batch;
+	Luint8 u8Counter;
+	Luint8 u8Fragments;
+	Luint8 u8Tail;
+	Luint32 u32Reclaimed;
+
+	pDone = 0;
+	u8Stop = 0U;
+	u8Batch = 0U;
+	u8Tail = sEMACZC.sTx.u8Tail;
+	u32Reclaimed = sEMACZC.sTx.u32Reclaimed;
+
+	while((u8Stop == 0U) && (u32Reclaimed != sEMACZC.sTx.u32Queued))
+	{
+		pDesc = M_EMACZC__TX_BD(u8Tail);
+		if((pDesc->u32Flags_Length & C_EMACZC__FLAG_OWNER) == 0U)
+		{
+			//the whole packet is back
+			u8Fragments = sEMACZC.sTx.u8Fragments[u8Tail];
+			for(u8Counter = 0U; u8Counter < u8Fragments; u8Counter++)
+			{
+				vEMACZC_POOL__Release_FromISR(sEMACZC.sTx.u8PoolIndex[u8Tail]);
+				sEMACZC.sTx.u8PoolIndex[u8Tail] = C_EMACZC__POOL_NONE;
+				pDone = M_EMACZC__TX_BD(u8Tail);
+
+				u8Tail++;
+				if(u8Tail >= C_LOCALDEF__LCCM676__TX_DESCRIPTORS)
+				{
+					u8Tail = 0U;
+				}
+				else
+				{
+					//fall on
+				}
+			}
+			u32Reclaimed += u8Fragments;
+			u8Batch++;
+		}
+		else
+		{
+			//EMAC still has it
+			u8Stop = 1U;
+		}
+	}
+
+	sEMACZC.sTx.u8Tail = u8Tail;
+	sEMACZC.sTx.u32Reclaimed = u32Reclaimed;
+
+	if(u8Batch > 0U)
+	{
+		M_LOCALDEF__LCCM676__TX_CP((Luint32)pDone);
+
+		sEMACZC.sTx.sStats.u32Batches++;
+		if(u8Batch > sEMACZC.sTx.sStats.u8MaxBatch)
+		{
+			sEMACZC.sTx.sStats.u8MaxBatch = u8Batch;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	else
+	{
+		//nothing finished
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * Rx interrupt. Hands every waiting frame up then gives the descriptors back
+ * to the EMAC as one chain.
+ *
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.001.FUNC.005
+ */
+void vEMACZC__RxISR(void)
+{
+	volatile struct _strEMACZC__DESC *pDesc;
+	volatile struct _strEMACZC__DESC *pPrev;
+	Luint8 u8First;
+	Luint8 u8Pos;
+	Luint8 u8Count;
+	Luint8 u8Counter;
+	Luint8 u8Stop;
+	Luint8 u8Halted;
+	Luint32 u32Flags;
+	Luint32 u32Addx;
+
+	u8First = sEMACZC.sRx.u8Next;
+	u8Pos = u8First;
+	u8Count = 0U;
+	u8Stop = 0U;
+	u8Halted = 0U;
+	pDesc = 0;
+
+	while((u8Stop == 0U) && (u8Count < C_LOCALDEF__LCCM676__RX_DESCRIPTORS))
+	{
+		pDesc = M_EMACZC__RX_BD(u8Pos);
+		u32Flags = pDesc->u32Flags_Length;
+		if((u32Flags & C_EMACZC__FLAG_OWNER) == 0U)
+		{
+			//frames always fit in one buffer
+			if(((u32Flags & (C_EMACZC__FLAG_SOP | C_EMACZC__FLAG_EOP)) == (C_EMACZC__FLAG_SOP | C_EMACZC__FLAG_EOP)) &&
+				((u32Flags & C_EMACZC__RX_ERROR_FLAGS) == 0U))
+			{
+				sEMACZC.sRx.u8Current = u8Pos;
+				u32Addx = pDesc->u32Buffer + (pDesc->u32Offset_Length >> 16U);
+				M_LOCALDEF__LCCM676__RX_PACKET((Luint8 *)u32Addx, (Luint16)(u32Flags & 0x0000FFFFU), sEMACZC.sRx.u8PoolIndex[u8Pos]);
+				sEMACZC.sRx.sStats.u32Packets++;
+			}
+			else
+			{
+				sEMACZC.sRx.sStats.u32Errors++;
+			}
+
+			//it ran off the end of the free list
+			if((u32Flags & C_EMACZC__FLAG_EOQ) != 0U)
+			{
+				u8Halted = 1U;
+			}
+			else
+			{
+				//fall on
+			}
+
+			u8Count++;
+			u8Pos++;
+			if(u8Pos >= C_LOCALDEF__LCCM676__RX_DESCRIPTORS)
+			{
+				u8Pos = 0U;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+		else
+		{
+			//nothing more
+			u8Stop = 1U;
+		}
+	}
+	sEMACZC.sRx.u8Next = u8Pos;
+
+	if(u8Count > 0U)
+	{
+		//ack the last one we took
+		M_LOCALDEF__LCCM676__RX_CP((Luint32)pDesc);
+
+		//rebuild them as a chain
+		u8Pos = u8First;
+		for(u8Counter = 0U; u8Counter < u8Count; u8Counter++)
+		{
+			pDesc = M_EMACZC__RX_BD(u8Pos);
+			pDesc->u32Buffer = u32EMACZC_POOL__Get_Pointer(sEMACZC.sRx.u8PoolIndex[u8Pos]);
+			pDesc->u32Offset_Length = C_EMACZC__POOL_BUFFER_SIZE;
+			pDesc->u32Flags_Length = C_EMACZC__FLAG_OWNER;
+
+			u8Pos++;
+			if(u8Pos >= C_LOCALDEF__LCCM676__RX_DESCRIPTORS)
+			{
+				u8Pos = 0U;
+			}
+			else
+			{
+				//fall on
+			}
+
+			if(u8Counter < (u8Count - 1U))
+			{
+				pDesc->pNext = M_EMACZC__RX_BD(u8Pos);
+			}
+			else
+			{
+				pDesc->pNext = 0;
+			}
+		}
+
+		//and put the chain back in one go
+		pPrev = sEMACZC.sRx.pTail;
+		sEMACZC.sRx.pTail = pDesc;
+		if(u8Halted == 1U)
+		{
+			//the old tail was one of ours, the receiver is stopped
+			M_LOCALDEF__LCCM676__RX_HDP((Luint32)M_EMACZC__RX_BD(u8First));
+			sEMACZC.sRx.sStats.u32Restarts++;
+		}
+		else
+		{
+			pPrev->pNext = M_EMACZC__RX_BD(u8First);
+			if((pPrev->u32Flags_Length & C_EMACZC__FLAG_EOQ) != 0U)
+			{
+				//stopped on the old tail before it saw the link
+				M_LOCALDEF__LCCM676__RX_HDP((Luint32)M_EMACZC__RX_BD(u8First));
+				sEMACZC.sRx.sStats.u32Restarts++;
+			}
+			else
+			{
+				//fall on
+			}
+		}
+
+		sEMACZC.sRx.sStats.u32Batches++;
+		if(u8Count > sEMACZC.sRx.sStats.u8MaxBatch)
+		{
+			sEMACZC.sRx.sStats.u8MaxBatch = u8Count;
+		}
+		else
+		{
+			//fall on
+		}
+	}
+	else
+	{
+		//spurious
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ * From inside the Rx callback, keep the frame's buffer. The descriptor gets a
+ * fresh one from the pool and the caller owns the reference on the old one,
+ * release it with vEMACZC_POOL__Release() when done.
+ *
+ * @return			0 = pool empty, the frame must be used inside the callback\n
+ *					1 = kept
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.001.FUNC.006
+ */
+Luint8 u8EMACZC__Rx_Keep(void)
+{
+	Luint8 u8Return;
+	Lint16 s16Index;
+
+	s16Index = s16EMACZC_POOL__Alloc_FromISR();
+	if(s16Index >= 0)
+	{
+		sEMACZC.sRx.u8PoolIndex[sEMACZC.sRx.u8Current] = (Luint8)s16Index;
+		sEMACZC.sRx.sStats.u32Kept++;
+		u8Return = 1U;
+	}
+	else
+	{
+		sEMACZC.sRx.sStats.u32KeepRefused++;
+		u8Return = 0U;
+	}
+
+	return u8Return;
+}
+
+/***************************************************************************//**
+ * @brief
+ * Descriptors the EMAC has not given back yet
+ *
+ * @return			0 = nothing on the wire, chained payloads are free
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.001.FUNC.007
+ */
+Luint8 u8EMACZC__Tx_Get_InFlight(void)
+{
+	return (Luint8)(sEMACZC.sTx.u32Queued - sEMACZC.sTx.u32Reclaimed);
+}
+
+/***************************************************************************//**
+ * @brief
+ * Fill descriptors for one packet and link it onto the active list
+ *
+ * @param[in]		u8Count					Fragments
+ * @param[in]		pu8PoolIndex			Pool buffer of each, C_EMACZC__POOL_NONE for caller memory
+ * @param[in]		pu16Length				Length of each
+ * @param[in]		pu32Addx				Address of each
+ * @return			-1 = ring full\n
+ *					0 = queued
+ * @st_funcMD5
+ * @st_funcID		LCCM676R0.FILE.001.FUNC.008
+ */
+static Lint16 s16EMACZC__Tx_Queue(const Luint32 *pu32Addx, const Luint16 *pu16Length, const Luint8 *pu8PoolIndex, Luint8 u8Count)
+{
+	Lint16 s16Return;
+	volatile struct _strEMACZC__DESC *pDesc;
+	volatile struct _strEMACZC__DESC *pFirst;
+	volatile struct _strEMACZC__DESC *pPrev;
+	Luint8 u8Counter;
+	Luint8 u8Pos;
+	Luint8 u8Start;
+	Luint32 u32Total;
+	Luint32 u32Free;
+
+	u32Free = C_LOCALDEF__LCCM676__TX_DESCRIPTORS - (sEMACZC.sTx.u32Queued - sEMACZC.sTx.u32Reclaimed);
+	if(u32Free >= (Luint32)u8Count)
+	{
+		u32Total = 0U;
+		for(u8Counter = 0U; u8Counter < u8Count; u8Counter++)
+		{
+			u32Total += pu16Length[u8Counter];
+		}
+
+		u8Start = sEMACZC.sTx.u8Head;
+		u8Pos = u8Start;
+		pFirst = M_EMACZC__TX_BD(u8Start);
+		pDesc = pFirst;
+		for(u8Counter = 0U; u8Counter < u8Count; u8Counter++)
+		{
+			pDesc = M_EMACZC__TX_BD(u8Pos);
+			pDesc->pNext = 0;
+			pDesc->u32Buffer = pu32Addx[u8Counter];
+			pDesc->u32Offset_Length = (Luint32)pu16Length[u8Counter];
+			if(u8Counter == 0U)
+			{
+				pDesc->u32Flags_Length = C_EMACZC__FLAG_SOP | C_EMACZC__FLAG_OWNER | u32Total;
+			}
+			else
+			{
+				pDesc->u32Flags_Length = 0U;
+			}
+			sEMACZC.sTx.u8PoolIndex[u8Pos] = pu8PoolIndex[u8Counter];
+			sEMACZC.sTx.u8Fragments[u8Pos] = 0U;
+
+			u8Pos++;
+			if(u8Pos >= C_LOCALDEF__LCCM676__TX_DESCRIPTORS)
+			{
+				u8Pos = 0U;
+			}
+			else
+			{
+				//fall on
+			}
+
+			if(u8Counter < (u8Count - 1U))
+			{
+				pDesc->pNext = M_EMACZC__TX_BD(u8Pos);
+			}
+			else
+			{
+				pDesc->u32Flags_Length |= C_EMACZC__FLAG_EOP;
+			}
+		}
+		sEMACZC.sTx.u8Fragments[u8Start] = u8Count;
+		sEMACZC.sTx.u8Head = u8Pos;
+
+		//visible to the ISR only once it is all there
+		pPrev = sEMACZC.sTx.pLast;
+		sEMACZC.sTx.pLast = pDesc;
+		sEMACZC.sTx.u32Queued += u8Count;
+
+		if(pPrev == 0)
+		{
+			//first ever
+			M_LOCALDEF__LCCM676__TX_HDP((Luint32)pFirst);
+		}
+		else
+		{
+			pPrev->pNext = pFirst;
+			if((pPrev->u32Flags_Length & C_EMACZC__FLAG_EOQ) != 0U)
+			{
+				//the EMAC had stopped on the last packet before it saw the link
+				M_LOCALDEF__LCCM676__TX_HDP((Luint32)pFirst);
+				sEMACZC.sTx.sStats.u32Restarts++;
+			}
+			else
+			{
+				//it will run on into this one
+			}
+		}
+
+		sEMACZC.sTx.sStats.u32Packets++;
+		s16Return = 0;
+	}
+	else
+	{
+		sEMACZC.sTx.sStats.u32RingFull++;
+		s16Return = -1;
+	}
+
+	return s16Return;
+}
+
+//safetys
+#if C_LOCALDEF__LCCM676__POOL_BUFFERS <= C_LOCALDEF__LCCM676__RX_DESCRIPTORS
+	#error
+#endif
+#if C_LOCALDEF__LCCM676__POOL_BUFFERS >= 255U
+	#error
+#endif
+#if C_LOCALDEF__LCCM676__TX_DESCRIPTORS > 255U
+	#error
+#endif
+
+#endif //#if C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE == 1U
+//safetys
+#ifndef C_LOCALDEF__LCCM676__ENABLE_THIS_MODULE
+	#error
+#endif
+/** @} */
+/** @} */
+/** @} */
@@ -118,6 +118,13 @@ DS18B20 - 1-Wire Temperature Sensor
 		 */
 		#define C_LOCALDEF__LCCM644__MAX_1WIRE_CHANNELS						(C_LOCALDEF__LCCM641__NUM_DEVICS)
 
+		/** Upper limit on the number of scheduler steps per call to vDS18B20__Process() */
+		#define C_LOCALDEF__LCCM644__SCHED_STEPS_PER_PROCESS				(32U)
+
+		/** Keep the device table in the EEPROM params so a warm boot can skip the search */
+		#define C_LOCALDEF__LCCM644__ENABLE_ROM_CACHE						(0U)
+		#define C_LOCALDEF__LCCM644__ROM_CACHE__EEPROM_INDEX				(0U)
+
 		/** Testing Options */
 		#define C_LOCALDEF__LCCM644__ENABLE_TEST_SPEC						(0U)
 
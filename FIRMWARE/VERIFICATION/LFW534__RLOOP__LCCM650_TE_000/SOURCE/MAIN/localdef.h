@@ -83,6 +83,18 @@ ATA6870N - BATTERY MANAGEMENT DEVICE
 		#define M_LOCALDEF__LCCM650__NCS_LATCH(val)							{vRM4_GIO__Set_Bit(gioPORTB, 4U, val);}
 		#define M_LOCALDEF__LCCM650__SPI_TX_U8(x)							u8RM4_MIBSPI135__Tx_U8(MIBSPI135_CHANNEL__1, MIBSPI135_DATA_FORMAT__0, MIBSPI135_CS__NONE, x)
 
+		/** Whole frame SPI transfer for the acquisition engine. START must not
+		 * wait for the frame (MibSPI transfer group + DMA), BUSY is non zero until
+		 * it has been clocked. Without DMA use the byte at a time transfer. */
+		#define M_LOCALDEF__LCCM650__SPI_XFER_START(ptx, prx, len)			vATA6870_ENGINE__Xfer_Polled(ptx, prx, len)
+		#define M_LOCALDEF__LCCM650__SPI_XFER_BUSY()						(0U)
+
+		/** Cell balancing stays off until the pack NTCs and their divider have
+		 * been calibrated, the balancer thermal cutoff depends on them. Cell
+		 * stats still run. With it on, M_LOCALDEF__LCCM650__NTC_TO_DEGC(v) must
+		 * convert volts at the NTC input to DegC. */
+		#define C_LOCALDEF__LCCM650__ENABLE_BALANCING						(0U)
+
 		#define M_LOCALDEF__LCCM650__POWER_ENABLE_TRIS(x)					{if(x == 0U) vRM4_GIO__Set_BitDirection(gioPORTB, 2U, GIO_DIRECTION__OUTPUT); else vRM4_GIO__Set_BitDirection(gioPORTB, 2U, GIO_DIRECTION__INPUT); }
 		#define M_LOCALDEF__LCCM650__POWER_ENABLE_LATCH(x)					{vRM4_GIO__Set_Bit(gioPORTB, 2U, x); }
 